@@ -0,0 +1,427 @@
+#include "common/flight_recorder_reader.hpp"
+#include "common/utils.hpp"
+#include "libpldmresponder/base.hpp"
+#include "libpldmresponder/platform.hpp"
+#include "pldmd/invoker.hpp"
+#include "pldmd/rx_msg.hpp"
+#include "requester/handler.hpp"
+#include "requester/request.hpp"
+#include "test/test_instance_id.hpp"
+
+#include <libpldm/base.h>
+#include <libpldm/pdr.h>
+
+#include <sdeventplus/event.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <new>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+using namespace pldm;
+using namespace pldm::responder;
+using pldm::flightrecorder::CapturedMessage;
+
+/* Allocations of the process, read before and after each handled message */
+static std::atomic<uint64_t> allocations{0};
+static std::atomic<uint64_t> allocatedBytes{0};
+
+void* operator new(size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (auto ptr = std::malloc(size ? size : 1))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+/** @brief Request of the replay, the transport is mocked: the request is
+ *  not sent, its response is the one of the capture
+ */
+class ReplayRequest final : public requester::RequestRetryTimer
+{
+  public:
+    ReplayRequest(PldmTransport* /*pldmTransport*/, mctp_eid_t /*eid*/,
+                  sdeventplus::Event& event, pldm::Request&& /*requestMsg*/,
+                  uint8_t numRetries, std::chrono::milliseconds responseTimeOut,
+                  bool /*verbose*/) :
+        RequestRetryTimer(event, numRetries, responseTimeOut)
+    {}
+
+  private:
+    int send() const override
+    {
+        return PLDM_SUCCESS;
+    }
+};
+
+/** @brief pldmd without a firmware update manager, the FWUP requests get
+ *  the unsupported command response
+ */
+struct NoFwManager
+{
+    Response handleRequest(mctp_eid_t, uint8_t, const pldm_msg*, size_t)
+    {
+        return {};
+    }
+};
+
+/** @brief Timing of the sequence replay */
+enum class ReplayTiming
+{
+    Accelerated, //!< Back to back messages
+    Recorded,    //!< Messages spaced as recorded, the event loop runs between
+};
+
+/** @brief Message of the capture handled by the replay
+ *
+ *  @details A response from a terminus comes with the request the BMC sent
+ *  for it, which is registered with the requester handler first.
+ */
+struct ReplayedMessage
+{
+    const CapturedMessage* message;
+    const CapturedMessage* request; //!< Tx request of a response, else null
+    pldm_header_info header;
+};
+
+/** @brief Responders and requester handler fed by the replay */
+class Replay
+{
+  public:
+    Replay() :
+        event(sdeventplus::Event::get_default()), repo(pldm_pdr_init()),
+        reqHandler(nullptr, event, instanceIdDb, false)
+    {
+        invoker.registerHandler(
+            PLDM_BASE, std::make_unique<base::Handler>(1, instanceIdDb, event,
+                                                       nullptr, nullptr));
+        /* No PDR JSON is generated, the repository only holds the terminus
+         * locator */
+        invoker.registerHandler(
+            PLDM_PLATFORM, std::make_unique<platform::Handler>(
+                               &dBusHandler, "./no_pdr_jsons", repo, nullptr,
+                               nullptr, nullptr, nullptr, event));
+    }
+
+    ~Replay()
+    {
+        pldm_pdr_destroy(repo);
+    }
+
+    Replay(const Replay&) = delete;
+    Replay& operator=(const Replay&) = delete;
+
+    /** @brief Handle a message, the time and the allocations of the handling
+     *         are added to the totals
+     */
+    void handle(const ReplayedMessage& replayed)
+    {
+        if (replayed.request)
+        {
+            const auto& data = replayed.request->data;
+            reqHandler.registerRequest(
+                replayed.message->eid, replayed.header.instance,
+                replayed.header.pldm_type, replayed.header.command,
+                pldm::Request(data.begin(), data.end()),
+                [](mctp_eid_t, const pldm_msg*, size_t) {});
+        }
+
+        auto allocs = allocations.load(std::memory_order_relaxed);
+        auto bytes = allocatedBytes.load(std::memory_order_relaxed);
+        auto start = std::chrono::steady_clock::now();
+        auto response = processRxMsg(
+            replayed.message->data, invoker, reqHandler,
+            static_cast<NoFwManager*>(nullptr), replayed.message->eid,
+            [](Response&& deferred) {
+                benchmark::DoNotOptimize(deferred.data());
+            });
+        benchmark::DoNotOptimize(response);
+        /* The deferred handlers and the requests released by the response
+         * run from the event loop */
+        while (sd_event_run(event.get(), 0) > 0)
+        {}
+        elapsed += std::chrono::steady_clock::now() - start;
+        allocCount += allocations.load(std::memory_order_relaxed) - allocs;
+        allocBytes += allocatedBytes.load(std::memory_order_relaxed) - bytes;
+    }
+
+    /** @brief Run the event loop until a deadline, between two messages
+     *         recorded apart
+     */
+    void idleUntil(std::chrono::steady_clock::time_point deadline)
+    {
+        for (auto now = std::chrono::steady_clock::now(); now < deadline;
+             now = std::chrono::steady_clock::now())
+        {
+            auto wait = std::chrono::duration_cast<std::chrono::microseconds>(
+                deadline - now);
+            sd_event_run(event.get(), wait.count());
+        }
+    }
+
+    /** @brief Report the totals of a benchmark */
+    void report(benchmark::State& state, size_t messages) const
+    {
+        auto handled = static_cast<double>(messages * state.iterations());
+        state.counters["msgs"] =
+            benchmark::Counter(handled, benchmark::Counter::kIsRate);
+        state.counters["allocs_per_msg"] =
+            handled ? static_cast<double>(allocCount) / handled : 0;
+        state.counters["alloc_bytes_per_msg"] =
+            handled ? static_cast<double>(allocBytes) / handled : 0;
+    }
+
+    std::chrono::steady_clock::duration elapsed{};
+    uint64_t allocCount = 0;
+    uint64_t allocBytes = 0;
+
+  private:
+    sdeventplus::Event event;
+    TestInstanceIdDb instanceIdDb;
+    pldm::utils::DBusHandler dBusHandler;
+    pldm_pdr* repo;
+    Invoker invoker;
+    requester::Handler<ReplayRequest> reqHandler;
+};
+
+/** @brief Messages of the capture handled by the replay, in capture order
+ *
+ *  @details The Tx responses are the ones of the replay, they are not
+ *  replayed. A Tx request is replayed only with its response, a request
+ *  left unanswered would hold its endpoint queue. Truncated messages are
+ *  skipped.
+ */
+static std::vector<ReplayedMessage>
+    replayedMessages(const std::vector<CapturedMessage>& capture,
+                     size_t& skipped)
+{
+    using Key = std::tuple<uint8_t, uint8_t, uint8_t, uint8_t>;
+    std::map<Key, const CapturedMessage*> pending;
+    std::vector<ReplayedMessage> replayed;
+    skipped = 0;
+    for (const auto& message : capture)
+    {
+        pldm_header_info header{};
+        if (!message.complete() || message.data.size() < sizeof(pldm_msg_hdr) ||
+            unpack_pldm_header(
+                reinterpret_cast<const pldm_msg_hdr*>(message.data.data()),
+                &header) != PLDM_SUCCESS)
+        {
+            skipped++;
+            continue;
+        }
+        Key key{message.eid, header.instance, header.pldm_type,
+                header.command};
+        if (message.isTx)
+        {
+            if (header.msg_type != PLDM_RESPONSE)
+            {
+                pending[key] = &message;
+            }
+            continue;
+        }
+        const CapturedMessage* request = nullptr;
+        if (header.msg_type == PLDM_RESPONSE)
+        {
+            auto it = pending.find(key);
+            if (it == pending.end())
+            {
+                skipped++;
+                continue;
+            }
+            request = it->second;
+            pending.erase(it);
+        }
+        replayed.push_back({&message, request, header});
+    }
+    return replayed;
+}
+
+/** @brief Name of the benchmark of a command */
+static std::string commandName(const pldm_header_info& header)
+{
+    char name[48];
+    std::snprintf(name, sizeof(name), "Replay/0x%02x/0x%02x/%s",
+                  header.pldm_type, header.command,
+                  header.msg_type == PLDM_RESPONSE ? "Response" : "Request");
+    return name;
+}
+
+/** @brief Handle the messages of a command in turn */
+static void replayCommand(benchmark::State& state,
+                          std::vector<ReplayedMessage> messages)
+{
+    Replay replay;
+    for (auto _ : state)
+    {
+        replay.elapsed = {};
+        for (const auto& message : messages)
+        {
+            replay.handle(message);
+        }
+        state.SetIterationTime(
+            std::chrono::duration<double>(replay.elapsed).count());
+    }
+    replay.report(state, messages.size());
+}
+
+/** @brief Handle the whole capture in order, as recorded or back to back */
+static void replaySequence(benchmark::State& state,
+                           const std::vector<ReplayedMessage>& messages,
+                           ReplayTiming timing)
+{
+    Replay replay;
+    for (auto _ : state)
+    {
+        replay.elapsed = {};
+        auto start = std::chrono::steady_clock::now();
+        auto firstUs = messages.front().message->timeUs;
+        for (const auto& message : messages)
+        {
+            if (timing == ReplayTiming::Recorded)
+            {
+                replay.idleUntil(start + std::chrono::microseconds(
+                                             message.message->timeUs - firstUs));
+            }
+            replay.handle(message);
+        }
+        state.SetIterationTime(
+            std::chrono::duration<double>(replay.elapsed).count());
+    }
+    replay.report(state, messages.size());
+}
+
+/** @brief Replay a flight recorder dump or a pcapng capture through the
+ *  dispatch of pldmd
+ *
+ *  @details The capture is given with --replay=<path> or the
+ *  PLDM_REPLAY_CAPTURE environment variable, --replay_timing=recorded spaces
+ *  the messages of the sequence as captured. One benchmark per command and
+ *  direction, plus the whole sequence, report the handling time and the
+ *  allocations per message. Without a capture nothing is run.
+ */
+int main(int argc, char** argv)
+{
+    std::optional<std::string> path;
+    if (auto env = std::getenv("PLDM_REPLAY_CAPTURE"))
+    {
+        path = env;
+    }
+    auto timing = ReplayTiming::Accelerated;
+
+    int kept = 1;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string_view arg(argv[i]);
+        if (arg.starts_with("--replay="))
+        {
+            path = std::string(arg.substr(sizeof("--replay=") - 1));
+        }
+        else if (arg == "--replay_timing=recorded")
+        {
+            timing = ReplayTiming::Recorded;
+        }
+        else if (arg == "--replay_timing=accelerated")
+        {
+            timing = ReplayTiming::Accelerated;
+        }
+        else
+        {
+            argv[kept++] = argv[i];
+        }
+    }
+    argc = kept;
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+    if (!path)
+    {
+        std::fprintf(stderr, "No capture, pass --replay=<path> or set "
+                             "PLDM_REPLAY_CAPTURE\n");
+        return 0;
+    }
+
+    std::ifstream input(*path, std::ios::binary);
+    if (!input)
+    {
+        std::fprintf(stderr, "Cannot open %s\n", path->c_str());
+        return 1;
+    }
+    auto capture = pldm::flightrecorder::readCapture(input);
+    size_t skipped = 0;
+    auto messages = replayedMessages(capture, skipped);
+    std::fprintf(stderr, "%zu messages replayed, %zu skipped\n",
+                 messages.size(), skipped);
+    if (messages.empty())
+    {
+        return 0;
+    }
+
+    std::map<std::string, std::vector<ReplayedMessage>> commands;
+    for (const auto& message : messages)
+    {
+        commands[commandName(message.header)].push_back(message);
+    }
+    for (auto& [name, commandMessages] : commands)
+    {
+        benchmark::RegisterBenchmark(name.c_str(), replayCommand,
+                                     commandMessages)
+            ->UseManualTime();
+    }
+    auto sequence = benchmark::RegisterBenchmark(
+        timing == ReplayTiming::Recorded ? "Replay/Sequence/Recorded"
+                                         : "Replay/Sequence/Accelerated",
+        replaySequence, messages, timing);
+    sequence->UseManualTime();
+    if (timing == ReplayTiming::Recorded)
+    {
+        /* An iteration lasts as long as the capture */
+        sequence->Iterations(1);
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,187 @@
+#include "common/flight_recorder.hpp"
+#include "common/utils.hpp"
+#include "requester/cper.hpp"
+#include "requester/event_hander_interface.hpp"
+#include "test/test_instance_id.hpp"
+
+#include <endian.h>
+
+#include <sdbusplus/test/sdbus_mock.hpp>
+#include <sdeventplus/event.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+using ::testing::NiceMock;
+
+/** @brief Feeds the PollForPlatformEventMessage responses to the event
+ *  handler as the requester callback does
+ */
+class EventReassemblyBench
+{
+  public:
+    static void receive(pldm::EventHandlerInterface& handler,
+                        const std::vector<uint8_t>& responseMsg)
+    {
+        handler.processResponseMsg(
+            0, reinterpret_cast<const pldm_msg*>(responseMsg.data()),
+            responseMsg.size() - sizeof(pldm_msg_hdr));
+    }
+};
+
+/** @brief Event class of the reassembled events */
+constexpr uint8_t benchEventClass = 0xfa;
+
+/** @brief Encode a PollForPlatformEventMessage response carrying one part
+ *  of an event
+ */
+static std::vector<uint8_t> pollResponse(uint8_t transferFlag,
+                                         uint32_t nextHandle,
+                                         std::span<const uint8_t> part,
+                                         uint32_t checksum)
+{
+    std::vector<uint8_t> msg(sizeof(pldm_msg_hdr));
+    auto append = [&msg](auto value) {
+        auto bytes = reinterpret_cast<const uint8_t*>(&value);
+        msg.insert(msg.end(), bytes, bytes + sizeof(value));
+    };
+    append(uint8_t{PLDM_SUCCESS});
+    append(uint8_t{1});              // TID
+    append(htole16(uint16_t{0x10})); // event ID
+    append(htole32(nextHandle));
+    append(transferFlag);
+    append(benchEventClass);
+    append(htole32(static_cast<uint32_t>(part.size())));
+    msg.insert(msg.end(), part.begin(), part.end());
+    if (transferFlag == PLDM_END)
+    {
+        append(htole32(checksum));
+    }
+    return msg;
+}
+
+/** @brief Reassemble events of state.range(0) bytes from parts of
+ *  state.range(1) bytes
+ */
+static void BM_EventReassembly(benchmark::State& state)
+{
+    NiceMock<sdbusplus::SdBusMock> sdbusMock;
+    auto bus = sdbusplus::get_mocked_new(&sdbusMock);
+    auto event = sdeventplus::Event::get_default();
+    TestInstanceIdDb instanceIdDb;
+    pldm::EventHandlerInterface handler(1, event, bus, instanceIdDb, nullptr);
+    /* Only the responses below are processed, no poll is sent */
+    handler.stopEventSignalPolling();
+
+    size_t events = 0;
+    handler.registerEventHandler(
+        benchEventClass,
+        [&events](uint8_t, uint8_t, uint16_t, std::vector<uint8_t>&& data) {
+        benchmark::DoNotOptimize(data.data());
+        events++;
+        return 0;
+    });
+
+    std::vector<uint8_t> eventData(state.range(0));
+    for (size_t i = 0; i < eventData.size(); i++)
+    {
+        eventData[i] = static_cast<uint8_t>(i);
+    }
+    std::span<const uint8_t> remaining(eventData);
+    size_t partSize = state.range(1);
+    pldm::utils::Crc32 crc;
+    std::vector<std::vector<uint8_t>> responses;
+    for (uint32_t handle = 1; !remaining.empty(); handle++)
+    {
+        auto part = remaining.first(std::min(partSize, remaining.size()));
+        remaining = remaining.subspan(part.size());
+        crc.update(part);
+        uint8_t flag = responses.empty()
+                           ? (remaining.empty() ? PLDM_START_AND_END
+                                                : PLDM_START)
+                           : (remaining.empty() ? PLDM_END : PLDM_MIDDLE);
+        responses.emplace_back(pollResponse(
+            flag, remaining.empty() ? 0 : handle, part, crc.value()));
+    }
+
+    for (auto _ : state)
+    {
+        for (const auto& response : responses)
+        {
+            EventReassemblyBench::receive(handler, response);
+        }
+    }
+
+    if (events != static_cast<size_t>(state.iterations()))
+    {
+        state.SkipWithError("Events were not reassembled");
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EventReassembly)
+    ->Args({256, 256})
+    ->Args({4096, 1024})
+    ->Args({65536, 1024});
+
+/** @brief Decode a CPER record of an Ampere specific and a platform memory
+ *  section
+ */
+static void BM_DecodeCperRecord(benchmark::State& state)
+{
+    /* Section types of cper.cpp */
+    constexpr Guid ampereSpecific = {
+        0x2826cc9f, 0x448c, 0x4c2b,
+        {0x86, 0xb6, 0xa9, 0x53, 0x94, 0xb7, 0xef, 0x33}};
+    constexpr Guid platformMemory = {
+        0xa5bc1114, 0x6f64, 0x4ede,
+        {0xb8, 0x63, 0x3e, 0x83, 0xed, 0x7c, 0x83, 0xb1}};
+    constexpr size_t ampereLength = sizeof(AmpereSpecData) + 64;
+
+    std::vector<uint8_t> record(sizeof(CPERRecodHeader) +
+                                2 * sizeof(CPERSectionDescriptor));
+    CPERRecodHeader header{};
+    header.SectionCount = 2;
+
+    CPERSectionDescriptor sections[2]{};
+    sections[0].SectionOffset = record.size();
+    sections[0].SectionLength = ampereLength;
+    sections[0].SectionType = ampereSpecific;
+    sections[1].SectionOffset = record.size() + ampereLength;
+    sections[1].SectionLength = sizeof(CPERSecMemErr);
+    sections[1].SectionType = platformMemory;
+    record.resize(record.size() + ampereLength + sizeof(CPERSecMemErr));
+    header.RecordLength = record.size();
+
+    std::memcpy(record.data(), &header, sizeof(header));
+    std::memcpy(record.data() + sizeof(header), sections, sizeof(sections));
+
+    CperRecordView view;
+    for (auto _ : state)
+    {
+        AmpereSpecData ampSpecHdr{};
+        decodeCperRecord(record, &ampSpecHdr, view);
+        benchmark::DoNotOptimize(ampSpecHdr);
+        benchmark::DoNotOptimize(view.pieces.data());
+    }
+    state.SetBytesProcessed(state.iterations() * record.size());
+}
+BENCHMARK(BM_DecodeCperRecord);
+
+/** @brief Save messages of state.range(0) bytes to the flight recorder */
+static void BM_FlightRecorderSaveRecord(benchmark::State& state)
+{
+    std::vector<uint8_t> msg(state.range(0), 0x5a);
+    auto& recorder = pldm::flightrecorder::FlightRecorder::GetInstance();
+    bool isRequest = true;
+    for (auto _ : state)
+    {
+        recorder.saveRecord(msg, isRequest, 1);
+        isRequest = !isRequest;
+    }
+}
+BENCHMARK(BM_FlightRecorderSaveRecord)->Arg(16)->Arg(256)->Arg(1024);
+
+BENCHMARK_MAIN();
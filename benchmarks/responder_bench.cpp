@@ -0,0 +1,151 @@
+#include "common/utils.hpp"
+#include "libpldmresponder/base.hpp"
+#include "libpldmresponder/bios_table.hpp"
+#include "libpldmresponder/platform.hpp"
+#include "pldmd/invoker.hpp"
+#include "test/test_instance_id.hpp"
+
+#include <libpldm/base.h>
+#include <libpldm/pdr.h>
+#include <libpldm/platform.h>
+
+#include <sdeventplus/event.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace pldm::responder;
+
+/** @brief Dispatch of a request as pldmd does it on reception: unpack the
+ *  header, then the asynchronous and the synchronous handler lookup
+ */
+static void BM_InvokerDispatch(benchmark::State& state)
+{
+    auto event = sdeventplus::Event::get_default();
+    TestInstanceIdDb instanceIdDb;
+    Invoker invoker;
+    invoker.registerHandler(PLDM_BASE, std::make_unique<base::Handler>(
+                                           1, instanceIdDb, event, nullptr,
+                                           nullptr));
+
+    std::array<uint8_t, sizeof(pldm_msg_hdr)> requestMsg{};
+    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+    encode_get_types_req(0, request);
+
+    for (auto _ : state)
+    {
+        pldm_header_info hdrFields{};
+        unpack_pldm_header(&request->hdr, &hdrFields);
+        if (!invoker.handleAsync(hdrFields.pldm_type, hdrFields.command,
+                                 request, 0, [](pldm::Response&&) {}))
+        {
+            auto response = invoker.handle(hdrFields.pldm_type,
+                                           hdrFields.command, request, 0);
+            benchmark::DoNotOptimize(response.data());
+        }
+    }
+}
+BENCHMARK(BM_InvokerDispatch);
+
+/** @brief GetPDR of each record in turn, in a repository of state.range(0)
+ *  PDRs
+ */
+static void BM_GetPDR(benchmark::State& state)
+{
+    auto repo = pldm_pdr_init();
+    auto event = sdeventplus::Event::get_default();
+    pldm::utils::DBusHandler dBusHandler;
+    /* No PDR JSON is generated, the repository only holds the terminus
+     * locator and the records added below */
+    platform::Handler handler(&dBusHandler, "./no_pdr_jsons", repo, nullptr,
+                              nullptr, nullptr, nullptr, event);
+
+    std::vector<uint8_t> pdr(sizeof(pldm_state_sensor_pdr));
+    auto hdr = reinterpret_cast<pldm_pdr_hdr*>(pdr.data());
+    hdr->version = 1;
+    hdr->type = PLDM_STATE_SENSOR_PDR;
+    hdr->length = pdr.size() - sizeof(pldm_pdr_hdr);
+    for (int64_t i = 0; i < state.range(0); i++)
+    {
+        uint32_t handle = 0;
+        pldm_pdr_add_check(repo, pdr.data(), pdr.size(), false, 1, &handle);
+    }
+    auto records = pldm_pdr_get_record_count(repo);
+
+    std::array<uint8_t, sizeof(pldm_msg_hdr) + PLDM_GET_PDR_REQ_BYTES>
+        requestMsg{};
+    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+    auto req = reinterpret_cast<pldm_get_pdr_req*>(request->payload);
+    req->request_count = UINT16_MAX;
+
+    uint32_t recordHandle = 0;
+    for (auto _ : state)
+    {
+        req->record_handle = recordHandle + 1;
+        recordHandle = (recordHandle + 1) % records;
+        auto response = handler.getPDR(request, PLDM_GET_PDR_REQ_BYTES);
+        benchmark::DoNotOptimize(response.data());
+    }
+
+    pldm_pdr_destroy(repo);
+}
+BENCHMARK(BM_GetPDR)->Arg(100)->Arg(1000)->Arg(10000);
+
+/** @brief Strings of a BIOS string table of the given size */
+static std::vector<std::string> biosStrings(int64_t count)
+{
+    std::vector<std::string> strings;
+    strings.reserve(count);
+    for (int64_t i = 0; i < count; i++)
+    {
+        strings.emplace_back("Attribute" + std::to_string(i));
+    }
+    return strings;
+}
+
+/** @brief Build a BIOS string table of state.range(0) strings */
+static void BM_BIOSStringTableBuild(benchmark::State& state)
+{
+    auto strings = biosStrings(state.range(0));
+    for (auto _ : state)
+    {
+        bios::Table table;
+        for (const auto& str : strings)
+        {
+            bios::table::string::constructEntry(table, str);
+        }
+        bios::table::appendPadAndChecksum(table);
+        benchmark::DoNotOptimize(table.data());
+    }
+}
+BENCHMARK(BM_BIOSStringTableBuild)->Arg(64)->Arg(512);
+
+/** @brief Look the strings of a BIOS string table of state.range(0)
+ *  strings up by name and by handle
+ */
+static void BM_BIOSStringTableLookup(benchmark::State& state)
+{
+    auto strings = biosStrings(state.range(0));
+    bios::Table table;
+    for (const auto& str : strings)
+    {
+        bios::table::string::constructEntry(table, str);
+    }
+    bios::table::appendPadAndChecksum(table);
+    bios::BIOSStringTable stringTable(table);
+
+    size_t index = 0;
+    for (auto _ : state)
+    {
+        auto handle = stringTable.findHandle(strings[index]);
+        benchmark::DoNotOptimize(stringTable.findString(handle));
+        index = (index + 1) % strings.size();
+    }
+}
+BENCHMARK(BM_BIOSStringTableLookup)->Arg(64)->Arg(512);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,45 @@
+#include "sensors/pldm_sensor.hpp"
+
+#include <libpldm/platform.h>
+
+#include <sdbusplus/test/sdbus_mock.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+
+using namespace pldm::sensor;
+using ::testing::NiceMock;
+
+/** @brief Update the value of a sensor with warning and critical
+ *  thresholds, the raw readings cross the thresholds and state.range(0)
+ *  selects whether the value is only published when the deadband allows it
+ */
+static void BM_PldmSensorUpdateValue(benchmark::State& state)
+{
+    NiceMock<sdbusplus::SdBusMock> sdbusMock;
+    auto bus = sdbusplus::get_mocked_new(&sdbusMock);
+    PldmSensor sensor(bus, "bench_temp", PLDM_SENSOR_UNIT_DEGRESS_C, 0, 0, 1,
+                      80, 5, 95, 0);
+    if (!sensor.createSensor())
+    {
+        state.SkipWithError("Failed to create the sensor");
+        return;
+    }
+    if (state.range(0))
+    {
+        sensor.setPublishFilter({.deadband = 2});
+    }
+
+    constexpr std::array<SensorValueType, 8> readings{40, 41, 82, 97,
+                                                      96, 81, 3, 40};
+    size_t index = 0;
+    for (auto _ : state)
+    {
+        sensor.updateValue(readings[index]);
+        index = (index + 1) % readings.size();
+    }
+}
+BENCHMARK(BM_PldmSensorUpdateValue)->Arg(0)->Arg(1);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,48 @@
+#include "common/dbus_counters.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+namespace pldm
+{
+namespace utils
+{
+
+DBusCounters::DBusCounters(sdbusplus::bus::bus& bus, const std::string& path,
+                           const std::string& interface,
+                           const std::vector<std::string>& names) :
+    path(path),
+    interface(interface), names(names), values(names.size(), 0)
+{
+    /* The vtable keeps pointers to the names, they live in this object */
+    vtable.emplace_back(sdbusplus::vtable::start());
+    for (const auto& name : this->names)
+    {
+        vtable.emplace_back(sdbusplus::vtable::property(
+            name.c_str(), "t", &DBusCounters::getProperty));
+    }
+    vtable.emplace_back(sdbusplus::vtable::end());
+
+    object = std::make_unique<sdbusplus::server::interface::interface>(
+        bus, this->path.c_str(), this->interface.c_str(), vtable.data(),
+        this);
+}
+
+int DBusCounters::getProperty(sd_bus* /*bus*/, const char* /*path*/,
+                              const char* /*interface*/, const char* property,
+                              sd_bus_message* reply, void* context,
+                              sd_bus_error* /*error*/)
+{
+    auto counters = static_cast<DBusCounters*>(context);
+    for (size_t i = 0; i < counters->names.size(); i++)
+    {
+        if (!std::strcmp(counters->names[i].c_str(), property))
+        {
+            return sd_bus_message_append(reply, "t", counters->values[i]);
+        }
+    }
+    return -EINVAL;
+}
+
+} // namespace utils
+} // namespace pldm
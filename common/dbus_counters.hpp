@@ -0,0 +1,73 @@
+#pragma once
+
+#include <systemd/sd-bus.h>
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/server/interface.hpp>
+#include <sdbusplus/vtable.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace pldm
+{
+namespace utils
+{
+
+/** @class DBusCounters
+ *
+ *  Read-only uint64 properties on a D-Bus interface, used to export the
+ *  counters of the daemon. The values are read when a client gets the
+ *  properties, no PropertiesChanged signal is emitted so a counter
+ *  updated on every event costs no D-Bus traffic.
+ */
+class DBusCounters
+{
+  public:
+    DBusCounters() = delete;
+    DBusCounters(const DBusCounters&) = delete;
+    DBusCounters& operator=(const DBusCounters&) = delete;
+
+    /** @brief Put the counters on the bus
+     *
+     *  @param[in] bus - D-Bus connection
+     *  @param[in] path - object path
+     *  @param[in] interface - interface name
+     *  @param[in] names - property names, set() takes their index
+     */
+    DBusCounters(sdbusplus::bus::bus& bus, const std::string& path,
+                 const std::string& interface,
+                 const std::vector<std::string>& names);
+
+    /** @brief Set a counter
+     *
+     *  @param[in] index - index of the property name
+     *  @param[in] value - value
+     */
+    void set(size_t index, uint64_t value)
+    {
+        if (index < values.size())
+        {
+            values[index] = value;
+        }
+    }
+
+  private:
+    /** @brief sd-bus getter of the properties */
+    static int getProperty(sd_bus* bus, const char* path,
+                           const char* interface, const char* property,
+                           sd_bus_message* reply, void* context,
+                           sd_bus_error* error);
+
+    std::string path;
+    std::string interface;
+    std::vector<std::string> names;
+    std::vector<uint64_t> values;
+    std::vector<sdbusplus::vtable::vtable_t> vtable;
+    std::unique_ptr<sdbusplus::server::interface::interface> object;
+};
+
+} // namespace utils
+} // namespace pldm
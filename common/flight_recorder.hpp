@@ -1,11 +1,22 @@
 #pragma once
 
+#include <common/memory_accounting.hpp>
+#include <common/pcap_writer.hpp>
 #include <common/utils.hpp>
 #include <phosphor-logging/lg2.hpp>
 
+#include <time.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <ctime>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <memory>
+#include <span>
+#include <sstream>
 #include <vector>
 
 PHOSPHOR_LOG2_USING;
@@ -15,18 +26,34 @@ namespace pldm
 namespace flightrecorder
 {
 using ReqOrResponse = bool;
-using FlightRecorderData = std::vector<uint8_t>;
-using FlightRecorderTimeStamp = std::string;
-using FlightRecorderRecord =
-    std::tuple<FlightRecorderTimeStamp, ReqOrResponse, FlightRecorderData>;
-using FlightRecorderCassette = std::vector<FlightRecorderRecord>;
 static constexpr auto flightRecorderDumpPath = "/tmp/pldm_flight_recorder";
+/** @brief Bytes of a PLDM message kept in a record, the rest is truncated */
+static constexpr size_t flightRecorderMaxPayload = FLIGHT_RECORDER_MAX_PAYLOAD;
+
+/** @struct FlightRecorderRecord
+ *
+ *  One preallocated slot of the flight recorder ring
+ */
+struct FlightRecorderRecord
+{
+    uint64_t timeStamp;   //!< CLOCK_MONOTONIC time in ns, 0 if unused
+    uint32_t length;      //!< Length of the original message
+    uint16_t savedLength; //!< Number of bytes saved in data
+    ReqOrResponse isRequest;
+    std::array<uint8_t, flightRecorderMaxPayload> data;
+};
+
+using FlightRecorderCassette =
+    std::array<FlightRecorderRecord, FLIGHT_RECORDER_MAX_ENTRIES>;
 
 /** @class FlightRecorder
  *
  *  The class for implementing the PLDM flight recorder logic. This class
  *  handles the insertion of the data into the recorder and also provides
  *  API's to dump the flight recorder into a file.
+ *  The records live in a fixed ring allocated once, saving a message only
+ *  takes a monotonic time stamp and a bounded copy of the payload. The time
+ *  stamps are formatted when the recorder is dumped.
  */
 
 class FlightRecorder
@@ -35,16 +62,48 @@ class FlightRecorder
     FlightRecorder() : index(0)
     {
         flightRecorderPolicy = FLIGHT_RECORDER_MAX_ENTRIES ? true : false;
-        if (flightRecorderPolicy)
-        {
-            tapeRecorder = FlightRecorderCassette(FLIGHT_RECORDER_MAX_ENTRIES);
-        }
+        pldm::metrics::memoryAccount("flight_recorder")
+            .allocated(sizeof(tapeRecorder));
+#ifdef FLIGHT_RECORDER_PCAP_PATH
+        pcapWriter = std::make_unique<PcapWriter>(
+            FLIGHT_RECORDER_PCAP_PATH, FLIGHT_RECORDER_PCAP_MAX_SIZE * 1024);
+#endif
     }
 
   protected:
-    int index;
-    FlightRecorderCassette tapeRecorder;
+    std::atomic<uint32_t> index;
+    FlightRecorderCassette tapeRecorder{};
     bool flightRecorderPolicy;
+    /** @brief Optional stream of all the records into a capture file */
+    std::unique_ptr<PcapWriter> pcapWriter;
+
+    /** @brief Get the CLOCK_MONOTONIC time in nanoseconds
+     *
+     *  @return time in nanoseconds
+     */
+    static uint64_t getMonotonicTime()
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return static_cast<uint64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+    }
+
+    /** @brief Format a monotonic time stamp as the local system time
+     *
+     *  @param[in] timeStamp - CLOCK_MONOTONIC time in nanoseconds
+     *  @param[in] offset - system time minus monotonic time in nanoseconds
+     *
+     *  @return formatted time
+     */
+    static std::string formatTimeStamp(uint64_t timeStamp, int64_t offset)
+    {
+        auto ns = static_cast<int64_t>(timeStamp) + offset;
+        std::time_t tt = ns / 1000000000;
+        std::stringstream ss;
+        ss << std::put_time(std::localtime(&tt), "%F %Z %T.")
+           << std::to_string((ns % 1000000000) / 1000);
+        return ss.str();
+    }
 
   public:
     FlightRecorder(const FlightRecorder&) = delete;
@@ -64,21 +123,32 @@ class FlightRecorder
      *  @param[in] buffer  - The request/respose byte buffer
      *  @param[in] isRequest - bool that captures if it is a request message or
      *                         a response message
+     *  @param[in] eid - EID of the remote endpoint, used by the capture file
      *
      *  @return void
      */
-    void saveRecord(const FlightRecorderData& buffer, ReqOrResponse isRequest)
+    void saveRecord(std::span<const uint8_t> buffer, ReqOrResponse isRequest,
+                    uint8_t eid = 0)
     {
+        if (pcapWriter)
+        {
+            pcapWriter->write(buffer, isRequest, eid);
+        }
+
         // if the flight recorder policy is enabled, then only insert the
         // messages into the flight recorder, if not this function will be just
         // a no-op
         if (flightRecorderPolicy)
         {
-            int currentIndex = index++;
-            tapeRecorder[currentIndex] = std::make_tuple(
-                pldm::utils::getCurrentSystemTime(), isRequest, buffer);
-            index = (currentIndex == FLIGHT_RECORDER_MAX_ENTRIES - 1) ? 0
-                                                                      : index;
+            auto currentIndex = index.fetch_add(1, std::memory_order_relaxed) %
+                                FLIGHT_RECORDER_MAX_ENTRIES;
+            auto& record = tapeRecorder[currentIndex];
+            record.timeStamp = getMonotonicTime();
+            record.length = buffer.size();
+            record.savedLength = std::min(buffer.size(), record.data.size());
+            record.isRequest = isRequest;
+            std::copy_n(buffer.begin(), record.savedLength,
+                        record.data.begin());
         }
     }
 
@@ -94,11 +164,24 @@ class FlightRecorder
             std::ofstream recorderOutputFile(flightRecorderDumpPath);
             info("Dumping the flight recorder into : {DUMP_PATH}", "DUMP_PATH",
                  flightRecorderDumpPath);
-            for (const auto& message : tapeRecorder)
+            struct timespec ts;
+            clock_gettime(CLOCK_REALTIME, &ts);
+            int64_t offset = static_cast<int64_t>(ts.tv_sec) * 1000000000 +
+                             ts.tv_nsec -
+                             static_cast<int64_t>(getMonotonicTime());
+            // oldest record first
+            auto start = index.load(std::memory_order_relaxed);
+            for (size_t i = 0; i < tapeRecorder.size(); i++)
             {
-                recorderOutputFile << std::get<FlightRecorderTimeStamp>(message)
-                                   << " : ";
-                if (std::get<ReqOrResponse>(message))
+                const auto& message =
+                    tapeRecorder[(start + i) % tapeRecorder.size()];
+                if (!message.timeStamp)
+                {
+                    continue;
+                }
+                recorderOutputFile
+                    << formatTimeStamp(message.timeStamp, offset) << " : ";
+                if (message.isRequest)
                 {
                     recorderOutputFile << "Tx : \n";
                 }
@@ -106,10 +189,16 @@ class FlightRecorder
                 {
                     recorderOutputFile << "Rx : \n";
                 }
-                for (const auto& word : std::get<FlightRecorderData>(message))
+                for (size_t j = 0; j < message.savedLength; j++)
                 {
                     recorderOutputFile << std::setfill('0') << std::setw(2)
-                                       << std::hex << (unsigned)word << " ";
+                                       << std::hex
+                                       << (unsigned)message.data[j] << " ";
+                }
+                if (message.length > message.savedLength)
+                {
+                    recorderOutputFile << "... (" << std::dec << message.length
+                                       << " bytes)";
                 }
                 recorderOutputFile << std::endl;
             }
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <istream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace pldm
+{
+namespace flightrecorder
+{
+
+/** @struct CapturedMessage
+ *  @brief PLDM message read back from a flight recorder dump or capture
+ */
+struct CapturedMessage
+{
+    uint64_t timeUs;       //!< Time of the message in microseconds
+    bool isTx;             //!< Sent by the BMC
+    uint8_t eid;           //!< Remote endpoint, 0 if the dump has none
+    uint32_t length;       //!< Length of the original message
+    std::vector<uint8_t> data;
+
+    /** @brief Whether the whole message was saved */
+    bool complete() const
+    {
+        return data.size() == length;
+    }
+};
+
+/** @brief Days from 1970-01-01 of a civil date */
+inline int64_t daysFromCivil(int64_t y, unsigned m, unsigned d)
+{
+    y -= m <= 2;
+    const int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int64_t>(doe) - 719468;
+}
+
+/** @brief Parse the text dump of FlightRecorder::playRecorder
+ *
+ *  @details Each record is a "<date> <zone> <time>.<us> : Tx :" line then a
+ *  line of hex bytes, ending with "... (<length> bytes)" when the message
+ *  was truncated. The time zone is ignored, only the intervals between the
+ *  records matter to a replay. A malformed record is skipped.
+ *
+ *  @param[in] dump - text of the dump
+ *
+ *  @return - the messages, oldest first
+ */
+inline std::vector<CapturedMessage> parseFlightRecorderDump(std::istream& dump)
+{
+    std::vector<CapturedMessage> messages;
+    std::string header;
+    std::string bytes;
+    while (std::getline(dump, header))
+    {
+        if (header.empty())
+        {
+            continue;
+        }
+        if (!std::getline(dump, bytes))
+        {
+            break;
+        }
+
+        int year = 0;
+        unsigned month = 0, day = 0, hour = 0, minute = 0, second = 0;
+        unsigned long micro = 0;
+        char zone[16]{};
+        char direction[3]{};
+        if (std::sscanf(header.c_str(), "%d-%u-%u %15s %u:%u:%u.%lu : %2s",
+                        &year, &month, &day, zone, &hour, &minute, &second,
+                        &micro, direction) != 9)
+        {
+            continue;
+        }
+
+        CapturedMessage message{};
+        auto secs = daysFromCivil(year, month, day) * 86400 + hour * 3600 +
+                    minute * 60 + second;
+        message.timeUs = static_cast<uint64_t>(secs) * 1000000 + micro;
+        message.isTx = std::strcmp(direction, "Tx") == 0;
+
+        std::istringstream hex(bytes);
+        std::string token;
+        while (hex >> token)
+        {
+            if (token == "...")
+            {
+                std::string total;
+                hex >> total;
+                message.length = std::stoul(total.substr(total.find('(') + 1));
+                break;
+            }
+            message.data.emplace_back(std::stoul(token, nullptr, 16));
+        }
+        if (!message.length)
+        {
+            message.length = message.data.size();
+        }
+        messages.emplace_back(std::move(message));
+    }
+    return messages;
+}
+
+/** @brief Parse a pcapng capture of the PcapWriter
+ *
+ *  @details The enhanced packet blocks hold an MCTP transport header, the
+ *  MCTP message type and the PLDM message. The BMC has EID 0 in the
+ *  synthesized headers, a message from EID 0 is sent by the BMC. The other
+ *  blocks are skipped, the capture is read until its first truncated block.
+ *
+ *  @param[in] capture - bytes of the capture
+ *
+ *  @return - the messages, oldest first
+ */
+inline std::vector<CapturedMessage>
+    parsePcapng(const std::vector<uint8_t>& capture)
+{
+    constexpr uint32_t enhancedPacketBlock = 0x00000006;
+    constexpr size_t mctpHeaderSize = 5;
+    auto read32 = [&capture](size_t offset) {
+        uint32_t value = 0;
+        std::memcpy(&value, capture.data() + offset, sizeof(value));
+        return value;
+    };
+
+    std::vector<CapturedMessage> messages;
+    size_t offset = 0;
+    while (offset + 12 <= capture.size())
+    {
+        auto type = read32(offset);
+        auto blockLength = read32(offset + 4);
+        if (blockLength < 12 || offset + blockLength > capture.size())
+        {
+            break;
+        }
+        if (type == enhancedPacketBlock && blockLength >= 32)
+        {
+            auto timeUs = (static_cast<uint64_t>(read32(offset + 12)) << 32) |
+                          read32(offset + 16);
+            auto captured = read32(offset + 20);
+            auto length = read32(offset + 24);
+            auto packet = offset + 28;
+            if (captured >= mctpHeaderSize && captured <= blockLength - 32 &&
+                length >= mctpHeaderSize)
+            {
+                CapturedMessage message{};
+                message.timeUs = timeUs;
+                uint8_t destination = capture[packet + 1];
+                uint8_t source = capture[packet + 2];
+                message.isTx = source == 0;
+                message.eid = message.isTx ? destination : source;
+                message.length = length - mctpHeaderSize;
+                message.data.assign(capture.begin() + packet + mctpHeaderSize,
+                                    capture.begin() + packet + captured);
+                messages.emplace_back(std::move(message));
+            }
+        }
+        offset += blockLength;
+    }
+    return messages;
+}
+
+/** @brief Read a flight recorder text dump or a pcapng capture, told apart
+ *         by the magic of the pcapng section header
+ *
+ *  @param[in] input - the dump or the capture
+ *
+ *  @return - the messages, oldest first
+ */
+inline std::vector<CapturedMessage> readCapture(std::istream& input)
+{
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(input)),
+                               std::istreambuf_iterator<char>());
+    constexpr uint8_t pcapngMagic[] = {0x0a, 0x0d, 0x0d, 0x0a};
+    if (bytes.size() >= sizeof(pcapngMagic) &&
+        std::memcmp(bytes.data(), pcapngMagic, sizeof(pcapngMagic)) == 0)
+    {
+        return parsePcapng(bytes);
+    }
+    std::istringstream text(std::string(bytes.begin(), bytes.end()));
+    return parseFlightRecorderDump(text);
+}
+
+} // namespace flightrecorder
+} // namespace pldm
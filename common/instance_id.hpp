@@ -2,11 +2,15 @@
 
 #include "libpldm/instance-id.h"
 
+#include <bitset>
 #include <cerrno>
 #include <cstdint>
+#include <deque>
 #include <exception>
+#include <stdexcept>
 #include <string>
 #include <system_error>
+#include <unordered_map>
 
 namespace pldm
 {
@@ -52,25 +56,26 @@ class InstanceIdDb
     }
 
     /** @brief Allocate an instance ID for the given terminus
+     *
+     *  The IDs are leased from the database in blocks and handed out from
+     *  the lease, a freed ID goes back to the end of the lease so the IDs
+     *  are still used in turn.
+     *
      *  @param[in] tid - the terminus ID the instance ID is associated with
      *  @return - PLDM instance id or -EAGAIN if there are no available instance
      *            IDs
      */
     uint8_t next(uint8_t tid)
     {
-        uint8_t id;
-        int rc = pldm_instance_id_alloc(pldmInstanceIdDb, tid, &id);
-
-        if (rc == -EAGAIN)
+        auto& lease = leases[tid];
+        if (lease.available.empty())
         {
-            throw std::runtime_error("No free instance ids");
-        }
-
-        if (rc)
-        {
-            throw std::system_category().default_error_condition(rc);
+            renew(tid, lease);
         }
 
+        auto id = lease.available.front();
+        lease.available.pop_front();
+        lease.inUse.set(id);
         return id;
     }
 
@@ -80,6 +85,27 @@ class InstanceIdDb
      */
     void free(uint8_t tid, uint8_t instanceId)
     {
+        auto it = leases.find(tid);
+        if (it != leases.end() && instanceId < maxInstanceIds &&
+            it->second.leased.test(instanceId))
+        {
+            auto& lease = it->second;
+            if (!lease.inUse.test(instanceId))
+            {
+                throw std::runtime_error(
+                    "Instance ID " + std::to_string(instanceId) + " for TID " +
+                    std::to_string(tid) + " was not previously allocated");
+            }
+            lease.inUse.reset(instanceId);
+            if (lease.available.size() < INSTANCE_ID_LEASE_SIZE)
+            {
+                lease.available.push_back(instanceId);
+                return;
+            }
+            /* The lease is full, give the ID back to the other processes */
+            lease.leased.reset(instanceId);
+        }
+
         int rc = pldm_instance_id_free(pldmInstanceIdDb, tid, instanceId);
         if (rc == -EINVAL)
         {
@@ -94,7 +120,55 @@ class InstanceIdDb
     }
 
   private:
+    /** @brief Number of instance IDs of a terminus, as per DSP0240 */
+    static constexpr uint8_t maxInstanceIds = 32;
+
+    /** @struct Lease
+     *
+     *  Instance IDs of a terminus allocated from the database
+     */
+    struct Lease
+    {
+        std::deque<uint8_t> available;        //!< IDs to hand out, in turn
+        std::bitset<maxInstanceIds> leased{}; //!< IDs held from the database
+        std::bitset<maxInstanceIds> inUse{};  //!< IDs handed out
+    };
+
+    /** @brief Allocate the next block of instance IDs from the database,
+     *         when other processes hold the rest of the IDs fewer IDs are
+     *         leased
+     *
+     *  @param[in] tid - the terminus ID the instance IDs are associated with
+     *  @param[in] lease - lease of the terminus
+     */
+    void renew(uint8_t tid, Lease& lease)
+    {
+        for (size_t i = 0; i < INSTANCE_ID_LEASE_SIZE; i++)
+        {
+            uint8_t id;
+            int rc = pldm_instance_id_alloc(pldmInstanceIdDb, tid, &id);
+            if (rc && !lease.available.empty())
+            {
+                break;
+            }
+
+            if (rc == -EAGAIN)
+            {
+                throw std::runtime_error("No free instance ids");
+            }
+
+            if (rc)
+            {
+                throw std::system_category().default_error_condition(rc);
+            }
+
+            lease.leased.set(id);
+            lease.available.push_back(id);
+        }
+    }
+
     pldm_instance_db* pldmInstanceIdDb = nullptr;
+    std::unordered_map<uint8_t, Lease> leases;
 };
 
 } // namespace pldm
@@ -0,0 +1,206 @@
+#include "common/log_sink.hpp"
+
+#include "common/utils.hpp"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <exception>
+#include <system_error>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace utils
+{
+
+namespace
+{
+
+/** @brief Number of calls to the logging services in flight */
+constexpr size_t maxInFlight = 8;
+
+constexpr auto selBusName = "xyz.openbmc_project.Logging.IPMI";
+constexpr auto selPath = "/xyz/openbmc_project/Logging/IPMI";
+constexpr auto selIntf = "xyz.openbmc_project.Logging.IPMI";
+constexpr auto faultLogBusName = "xyz.openbmc_project.Dump.Manager";
+constexpr auto faultLogPath = "/xyz/openbmc_project/dump/faultlog";
+constexpr auto faultLogIntf = "xyz.openbmc_project.Dump.Create";
+constexpr auto propertiesIntf = "org.freedesktop.DBus.Properties";
+
+} // namespace
+
+sdbusplus::message::message makeLogCall(sdbusplus::bus::bus& bus,
+                                        const LogRecord& record)
+{
+    if (auto sel = std::get_if<SelRecord>(&record))
+    {
+        auto method = bus.new_method_call(selBusName, selPath, selIntf,
+                                          "IpmiSelAddOem");
+        method.append(sel->message, sel->data, sel->recordType);
+        return method;
+    }
+    if (auto faultLog = std::get_if<FaultLogRecord>(&record))
+    {
+        std::map<std::string, std::variant<std::string, uint64_t>> params;
+        params["Type"] = faultLog->type;
+        params["PrimaryLogId"] = faultLog->primaryLogId;
+        auto method = bus.new_method_call(faultLogBusName, faultLogPath,
+                                          faultLogIntf, "CreateDump");
+        method.append(params);
+        return method;
+    }
+    const auto& property = std::get<PropertyRecord>(record);
+    auto method = bus.new_method_call(property.service.c_str(),
+                                      property.path.c_str(), propertiesIntf,
+                                      "Set");
+    method.append(property.interface, property.property,
+                  std::variant<std::string>(property.value));
+    return method;
+}
+
+void postLogRecord(LogRecord&& record)
+{
+    if (auto sink = LogSink::get())
+    {
+        sink->post(std::move(record));
+        return;
+    }
+
+    /* No sink in this process, make a blocking call */
+    auto& bus = DBusHandler::getBus();
+    try
+    {
+        auto method = makeLogCall(bus, record);
+        bus.call_noreply(method, dbusTimeout);
+    }
+    catch (const std::exception& e)
+    {
+        error("Failed to make the log call, error={ERROR}", "ERROR",
+              e.what());
+    }
+}
+
+LogSink::LogSink(sdeventplus::Event& event, sdbusplus::bus::bus& bus,
+                 size_t capacity) :
+    bus(bus),
+    capacity(capacity)
+{
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeFd < 0)
+    {
+        throw std::system_error(errno, std::generic_category(),
+                                "Failed to create the log sink event fd");
+    }
+    wakeSource = std::make_unique<sdeventplus::source::IO>(
+        event, wakeFd, EPOLLIN,
+        [this](sdeventplus::source::IO&, int, uint32_t) { flush(); });
+    instance = this;
+}
+
+LogSink::~LogSink()
+{
+    if (instance == this)
+    {
+        instance = nullptr;
+    }
+    wakeSource.reset();
+    close(wakeFd);
+}
+
+bool LogSink::post(LogRecord&& record)
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (records.size() >= capacity / 2 &&
+            std::find(records.begin(), records.end(), record) !=
+                records.end())
+        {
+            merged++;
+            return true;
+        }
+        if (records.size() >= capacity)
+        {
+            dropped++;
+            return false;
+        }
+        records.emplace_back(std::move(record));
+    }
+    wake();
+    return true;
+}
+
+void LogSink::wake()
+{
+    uint64_t value = 1;
+    if (::write(wakeFd, &value, sizeof(value)) < 0 && errno != EAGAIN)
+    {
+        error("Failed to wake up the log sink, errno={ERRNO}", "ERRNO",
+              errno);
+    }
+}
+
+void LogSink::flush()
+{
+    uint64_t value = 0;
+    while (::read(wakeFd, &value, sizeof(value)) > 0)
+    {}
+
+    for (auto id : finished)
+    {
+        inFlight.erase(id);
+    }
+    finished.clear();
+
+    uint64_t drops = dropped;
+    if (drops > reportedDrops)
+    {
+        error("Dropped {NUM} log records, the logging services are behind",
+              "NUM", drops - reportedDrops);
+        reportedDrops = drops;
+    }
+
+    std::vector<LogRecord> batch;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        while (inFlight.size() + batch.size() < maxInFlight &&
+               !records.empty())
+        {
+            batch.emplace_back(std::move(records.front()));
+            records.pop_front();
+        }
+    }
+
+    for (const auto& record : batch)
+    {
+        auto id = nextCallId++;
+        try
+        {
+            auto method = makeLogCall(bus, record);
+            inFlight.emplace(
+                id, bus.call_async(method, [this, id](auto&& reply) {
+                    if (reply.is_method_error())
+                    {
+                        error("Log call failed, errno={ERRNO}", "ERRNO",
+                              reply.get_errno());
+                    }
+                    finished.push_back(id);
+                    wake();
+                }));
+        }
+        catch (const std::exception& e)
+        {
+            error("Failed to send the log call, error={ERROR}", "ERROR",
+                  e.what());
+        }
+    }
+}
+
+} // namespace utils
+} // namespace pldm
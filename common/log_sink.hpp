@@ -0,0 +1,168 @@
+#pragma once
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/slot.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/io.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace pldm
+{
+namespace utils
+{
+
+/** @struct SelRecord
+ *  @brief OEM SEL entry added by IpmiSelAddOem
+ */
+struct SelRecord
+{
+    std::string message;
+    std::vector<uint8_t> data;
+    uint8_t recordType;
+
+    bool operator==(const SelRecord&) const = default;
+};
+
+/** @struct FaultLogRecord
+ *  @brief Redfish fault log entry added by CreateDump
+ */
+struct FaultLogRecord
+{
+    std::string primaryLogId;
+    std::string type;
+
+    bool operator==(const FaultLogRecord&) const = default;
+};
+
+/** @struct PropertyRecord
+ *  @brief String property set on a logging service, e.g. a crash capture
+ *  trigger
+ */
+struct PropertyRecord
+{
+    std::string service;
+    std::string path;
+    std::string interface;
+    std::string property;
+    std::string value;
+
+    bool operator==(const PropertyRecord&) const = default;
+};
+
+using LogRecord = std::variant<SelRecord, FaultLogRecord, PropertyRecord>;
+
+/** @brief Make the D-Bus call of a log record
+ *
+ *  @param[in] bus - D-Bus connection
+ *  @param[in] record - log record
+ *
+ *  @return - the method call
+ */
+sdbusplus::message::message makeLogCall(sdbusplus::bus::bus& bus,
+                                        const LogRecord& record);
+
+/** @brief Queue a log record on the sink of the process, or make a blocking
+ *  call if there is no sink
+ *
+ *  @param[in] record - log record
+ */
+void postLogRecord(LogRecord&& record);
+
+/** @class LogSink
+ *
+ *  Delivers the log records to the logging services with asynchronous
+ *  D-Bus calls, so a slow logging daemon does not add latency to the PLDM
+ *  message handling. post() may be called from any thread, the records are
+ *  queued and sent from the event loop with a bounded number of calls in
+ *  flight. Once the queue is half full a record identical to a queued one
+ *  is merged into it, once the queue is full the record is dropped.
+ */
+class LogSink
+{
+  public:
+    LogSink() = delete;
+    LogSink(const LogSink&) = delete;
+    LogSink& operator=(const LogSink&) = delete;
+
+    /** @brief Create the sink, it is the one used by post() until destroyed
+     *
+     *  @param[in] event - event loop the calls are made from
+     *  @param[in] bus - D-Bus connection attached to the event loop
+     *  @param[in] capacity - number of records which can wait to be sent
+     */
+    LogSink(sdeventplus::Event& event, sdbusplus::bus::bus& bus,
+            size_t capacity);
+
+    ~LogSink();
+
+    /** @brief Get the sink of the process
+     *
+     *  @return - the sink, nullptr if there is none
+     */
+    static LogSink* get()
+    {
+        return instance;
+    }
+
+    /** @brief Queue a log record, thread safe
+     *
+     *  @param[in] record - log record
+     *
+     *  @return - false if the record is dropped
+     */
+    bool post(LogRecord&& record);
+
+    /** @brief Number of records dropped because the queue was full */
+    uint64_t getDropped() const
+    {
+        return dropped;
+    }
+
+    /** @brief Number of records merged into an identical queued record */
+    uint64_t getMerged() const
+    {
+        return merged;
+    }
+
+  private:
+    /** @brief Send the queued records, runs on the event loop */
+    void flush();
+
+    /** @brief Wake up the event loop to flush the queue */
+    void wake();
+
+    sdbusplus::bus::bus& bus;
+    size_t capacity;
+
+    std::mutex lock;
+    std::deque<LogRecord> records;
+    std::atomic<uint64_t> dropped = 0;
+    std::atomic<uint64_t> merged = 0;
+
+    /** @brief Event fd which wakes up the event loop */
+    int wakeFd = -1;
+    std::unique_ptr<sdeventplus::source::IO> wakeSource;
+
+    /** @brief Pending calls, used on the event loop only */
+    std::map<uint64_t, sdbusplus::slot::slot> inFlight;
+    /** @brief Calls replied since the last flush, their slots are released
+     *  outside of the reply callbacks */
+    std::vector<uint64_t> finished;
+    uint64_t nextCallId = 0;
+    /** @brief Drops already reported to the journal */
+    uint64_t reportedDrops = 0;
+
+    static inline LogSink* instance = nullptr;
+};
+
+} // namespace utils
+} // namespace pldm
@@ -0,0 +1,249 @@
+#include "loop_monitor.hpp"
+
+#include "common/rate_limited_log.hpp"
+
+#include <systemd/sd-daemon.h>
+#include <systemd/sd-event.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <ctime>
+#include <string_view>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace metrics
+{
+
+LoopMonitor* LoopMonitor::current = nullptr;
+
+LoopMonitor::LoopMonitor(sdeventplus::Event& event, sdbusplus::bus::bus& bus,
+                         Registry& registry,
+                         std::chrono::microseconds probeInterval,
+                         std::chrono::microseconds slowCallback,
+                         std::chrono::microseconds watchdogMaxLag) :
+    event(event),
+    registry(registry), probeInterval(probeInterval),
+    slowCallback(slowCallback), watchdogMaxLag(watchdogMaxLag),
+    lagHistogram(registry.histogram(
+        "pldm_event_loop_lag_seconds",
+        "Delay of the event loop probe timer past its schedule")),
+    callbackHistogram(registry.histogram(
+        "pldm_event_loop_callback_seconds",
+        "Time spent in one callback of the event loop")),
+    maxLagGauge(registry.gauge("pldm_event_loop_max_lag_microseconds",
+                               "Largest delay of the event loop probe timer")),
+    probeTimer(
+        event, [this](auto&) { probe(); }, probeInterval,
+        std::chrono::microseconds{1})
+{
+    current = this;
+    probeTimer.restart(probeInterval);
+    sd_bus_add_filter(bus.get(), &filterSlot, &LoopMonitor::busFilter, this);
+
+    uint64_t usec = 0;
+    sd_event_now(event.get(), CLOCK_MONOTONIC, &usec);
+    probeDueUs = usec + probeInterval.count();
+
+    if (watchdogMaxLag.count() && sd_watchdog_enabled(0, &usec) > 0)
+    {
+        /* Fed twice per period, so one late window is not fatal */
+        watchdogPeriod = std::chrono::microseconds(usec / 2);
+        watchdogWindowStart = Clock::now();
+        sd_notify(0, "WATCHDOG=1");
+        info("Feed the watchdog every {PERIOD}us while the event loop lag "
+             "is under {LAG}us",
+             "PERIOD", watchdogPeriod.count(), "LAG", watchdogMaxLag.count());
+    }
+}
+
+LoopMonitor::~LoopMonitor()
+{
+    sd_bus_slot_unref(filterSlot);
+    if (current == this)
+    {
+        current = nullptr;
+    }
+}
+
+int LoopMonitor::run()
+{
+    auto loop = event.get();
+    int state;
+    while ((state = sd_event_get_state(loop)) != SD_EVENT_FINISHED)
+    {
+        if (state < 0)
+        {
+            return state;
+        }
+        auto rc = sd_event_prepare(loop);
+        if (rc == 0)
+        {
+            rc = sd_event_wait(loop, UINT64_MAX);
+        }
+        if (rc <= 0)
+        {
+            if (rc < 0)
+            {
+                return rc;
+            }
+            continue;
+        }
+
+        sourceName.clear();
+        auto start = Clock::now();
+        rc = sd_event_dispatch(loop);
+        auto duration = Clock::now() - start;
+        callbackHistogram.observe(duration);
+        if (duration >= slowCallback)
+        {
+            recordSlow(duration);
+        }
+        if (rc < 0)
+        {
+            return rc;
+        }
+    }
+
+    int code = 0;
+    sd_event_get_exit_code(loop, &code);
+    return code;
+}
+
+void LoopMonitor::probe()
+{
+    setSource("timer:loop-probe");
+
+    timespec ts{};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    uint64_t now = uint64_t(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+    auto lag = std::chrono::microseconds(now > probeDueUs ? now - probeDueUs
+                                                          : 0);
+    lagHistogram.observe(lag);
+    if (lag.count() > maxLagGauge.value())
+    {
+        maxLagGauge.set(lag.count());
+    }
+
+    /* The timer is rearmed from the wakeup time of this iteration */
+    uint64_t wakeup = 0;
+    sd_event_now(event.get(), CLOCK_MONOTONIC, &wakeup);
+    probeDueUs = wakeup + probeInterval.count();
+
+    if (watchdogPeriod.count())
+    {
+        watchdogWindowMaxLag = std::max<Clock::duration>(watchdogWindowMaxLag,
+                                                         lag);
+        feedWatchdog(Clock::now());
+    }
+}
+
+void LoopMonitor::feedWatchdog(Clock::time_point now)
+{
+    if (now - watchdogWindowStart < watchdogPeriod)
+    {
+        return;
+    }
+
+    if (watchdogWindowMaxLag < watchdogMaxLag)
+    {
+        sd_notify(0, "WATCHDOG=1");
+    }
+    else
+    {
+        PLDM_LOG_RATE_LIMITED(
+            error, "Do not feed the watchdog, the event loop lagged {LAG}us",
+            "LAG",
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                watchdogWindowMaxLag)
+                .count());
+    }
+    watchdogWindowStart = now;
+    watchdogWindowMaxLag = Clock::duration{0};
+}
+
+void LoopMonitor::recordSlow(std::chrono::nanoseconds duration)
+{
+    auto name = sourceName.empty() ? std::string_view("unknown")
+                                   : std::string_view(sourceName);
+    auto it = slowSources.find(name);
+    if (it == slowSources.end())
+    {
+        if (slowSources.size() >= maxSources)
+        {
+            name = "other";
+            it = slowSources.find(name);
+        }
+        if (it == slowSources.end())
+        {
+            Labels labels{{"source", std::string(name)}};
+            it = slowSources
+                     .emplace(name,
+                              SlowSource{
+                                  &registry.counter(
+                                      "pldm_event_loop_slow_callbacks",
+                                      "Callbacks of the event loop slower "
+                                      "than the slow callback threshold",
+                                      labels),
+                                  &registry.gauge(
+                                      "pldm_event_loop_slowest_callback_"
+                                      "microseconds",
+                                      "Longest callback of the event loop "
+                                      "by source",
+                                      labels)})
+                     .first;
+        }
+    }
+
+    auto us =
+        std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+    it->second.count->inc();
+    if (us > it->second.maxUs->value())
+    {
+        it->second.maxUs->set(us);
+    }
+    PLDM_LOG_RATE_LIMITED(warning,
+                          "Slow event loop callback {SOURCE} took {TIME}us",
+                          "SOURCE", std::string(name), "TIME", us);
+}
+
+int LoopMonitor::busFilter(sd_bus_message* msg, void* context, sd_bus_error*)
+{
+    auto monitor = static_cast<LoopMonitor*>(context);
+    if (!monitor->sourceName.empty())
+    {
+        return 0;
+    }
+
+    const char* member = sd_bus_message_get_member(msg);
+    uint8_t type = 0;
+    sd_bus_message_get_type(msg, &type);
+    switch (type)
+    {
+        case SD_BUS_MESSAGE_SIGNAL:
+        {
+            const char* interface = sd_bus_message_get_interface(msg);
+            monitor->sourceName.append("match:")
+                .append(interface ? interface : "")
+                .append(".")
+                .append(member ? member : "");
+            break;
+        }
+        case SD_BUS_MESSAGE_METHOD_CALL:
+            monitor->sourceName.append("method:").append(member ? member
+                                                                : "");
+            break;
+        default:
+            monitor->sourceName = "bus:reply";
+            break;
+    }
+
+    /* Let the message be dispatched */
+    return 0;
+}
+
+} // namespace metrics
+} // namespace pldm
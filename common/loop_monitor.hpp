@@ -0,0 +1,136 @@
+#pragma once
+
+#include "common/metrics.hpp"
+
+#include <systemd/sd-bus.h>
+
+#include <sdbusplus/bus.hpp>
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/utility/timer.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+
+namespace pldm
+{
+namespace metrics
+{
+
+/** @class LoopMonitor
+ *
+ *  Instruments the event loop of the daemon. A probe timer measures how late
+ *  the loop wakes up against its schedule, which is the time a ready source
+ *  waits behind the callback being dispatched. The loop is run by the
+ *  monitor, sd-event dispatches one source per iteration so every callback
+ *  is timed. The slow callbacks are counted by the name of their source:
+ *  the D-Bus signals and method calls are named by a bus filter, e.g.
+ *  "match:<interface>.<member>" or "method:<member>", the other sources by
+ *  setSource(), the unnamed ones, e.g. the replies of the asynchronous
+ *  D-Bus calls, are "unknown".
+ *
+ *  When a maximum lag is given and the service has a watchdog, the watchdog
+ *  is fed only while the lag of the loop stays under it.
+ */
+class LoopMonitor
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /** @brief Sources counted apart, the slow callbacks of the other ones
+     *  are counted as "other"
+     */
+    static constexpr size_t maxSources = 32;
+
+    LoopMonitor() = delete;
+    LoopMonitor(const LoopMonitor&) = delete;
+    LoopMonitor& operator=(const LoopMonitor&) = delete;
+
+    /** @brief Constructor
+     *
+     *  @param[in] event - PLDM daemon's main event loop
+     *  @param[in] bus - D-Bus connection attached to the event loop
+     *  @param[in] registry - registry of the lag and callback metrics
+     *  @param[in] probeInterval - period of the probe timer
+     *  @param[in] slowCallback - duration of a callback counted as slow
+     *  @param[in] watchdogMaxLag - lag above which the watchdog is not fed,
+     *                              0 to leave the watchdog alone
+     */
+    LoopMonitor(sdeventplus::Event& event, sdbusplus::bus::bus& bus,
+                Registry& registry, std::chrono::microseconds probeInterval,
+                std::chrono::microseconds slowCallback,
+                std::chrono::microseconds watchdogMaxLag = {});
+
+    ~LoopMonitor();
+
+    /** @brief Run the event loop until it exits
+     *
+     *  @return - exit code of the loop, a negative errno on failure
+     */
+    int run();
+
+    /** @brief Name the source of the callback being dispatched, e.g.
+     *         "timer:sensor-poll", the first name of a dispatch is kept
+     *
+     *  @param[in] name - name of the source, a literal
+     */
+    static void setSource(const char* name)
+    {
+        if (current && current->sourceName.empty())
+        {
+            current->sourceName = name;
+        }
+    }
+
+  private:
+    /** @brief Metrics of the slow callbacks of a source */
+    struct SlowSource
+    {
+        Counter* count;
+        Gauge* maxUs;
+    };
+
+    /** @brief Probe timer callback, records the lag */
+    void probe();
+
+    /** @brief Feed the watchdog once per half period if the lag stayed
+     *         under watchdogMaxLag
+     */
+    void feedWatchdog(Clock::time_point now);
+
+    /** @brief Count a slow callback of the current source */
+    void recordSlow(std::chrono::nanoseconds duration);
+
+    /** @brief sd-bus filter naming the source of the dispatched message */
+    static int busFilter(sd_bus_message* msg, void* context,
+                         sd_bus_error* error);
+
+    /** @brief Monitor of the running loop */
+    static LoopMonitor* current;
+
+    sdeventplus::Event& event;
+    Registry& registry;
+    std::chrono::microseconds probeInterval;
+    std::chrono::microseconds slowCallback;
+    std::chrono::microseconds watchdogMaxLag;
+    Histogram& lagHistogram;
+    Histogram& callbackHistogram;
+    Gauge& maxLagGauge;
+    /** @brief Name of the source of the current dispatch */
+    std::string sourceName;
+    std::map<std::string, SlowSource, std::less<>> slowSources;
+    sd_bus_slot* filterSlot = nullptr;
+    /** @brief Time the probe is due, from the wakeup of its last dispatch */
+    uint64_t probeDueUs = 0;
+    /** @brief Period of the watchdog feeding, 0 when it is not fed */
+    std::chrono::microseconds watchdogPeriod{0};
+    Clock::time_point watchdogWindowStart;
+    Clock::duration watchdogWindowMaxLag{0};
+    sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> probeTimer;
+};
+
+} // namespace metrics
+} // namespace pldm
@@ -0,0 +1,123 @@
+#include "common/memory_accounting.hpp"
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace pldm
+{
+namespace metrics
+{
+
+namespace
+{
+
+/** @brief Registry the accounts are exported by */
+Registry& accountRegistry()
+{
+#ifdef MEMORY_ACCOUNTING
+    return Registry::get();
+#else
+    /* Counted but never rendered */
+    static Registry unexported;
+    return unexported;
+#endif
+}
+
+struct Accounts
+{
+    std::mutex lock;
+    std::map<std::string, std::unique_ptr<MemoryAccount>> accounts;
+    std::map<std::string, std::unique_ptr<AccountedResource>> resources;
+};
+
+Accounts& accounts()
+{
+    static Accounts all;
+    return all;
+}
+
+MemoryAccount& accountLocked(Accounts& all, const std::string& subsystem)
+{
+    auto& account = all.accounts[subsystem];
+    if (!account)
+    {
+        account = std::make_unique<MemoryAccount>(accountRegistry(),
+                                                  subsystem);
+    }
+    return *account;
+}
+
+} // namespace
+
+MemoryAccount::MemoryAccount(Registry& registry,
+                             const std::string& subsystem) :
+    liveGauge(registry.gauge("pldm_memory_live_bytes",
+                             "Bytes allocated by a subsystem",
+                             {{"subsystem", subsystem}})),
+    peakGauge(registry.gauge("pldm_memory_peak_bytes",
+                             "Largest number of bytes allocated by a subsystem",
+                             {{"subsystem", subsystem}})),
+    allocationCount(registry.counter("pldm_memory_allocations",
+                                     "Allocations of a subsystem",
+                                     {{"subsystem", subsystem}}))
+{}
+
+void MemoryAccount::allocated(size_t bytes)
+{
+    allocationCount.inc();
+    adjust(static_cast<int64_t>(bytes));
+}
+
+void MemoryAccount::released(size_t bytes)
+{
+    adjust(-static_cast<int64_t>(bytes));
+}
+
+void MemoryAccount::resized(size_t from, size_t to)
+{
+    adjust(static_cast<int64_t>(to) - static_cast<int64_t>(from));
+}
+
+void MemoryAccount::adjust(int64_t delta)
+{
+    auto now = live.fetch_add(delta, std::memory_order_relaxed) + delta;
+    liveGauge.set(now);
+
+    auto highest = peak.load(std::memory_order_relaxed);
+    while (now > highest &&
+           !peak.compare_exchange_weak(highest, now, std::memory_order_relaxed))
+    {}
+    if (now > highest)
+    {
+        peakGauge.set(peak.load(std::memory_order_relaxed));
+    }
+}
+
+MemoryAccount& memoryAccount(const std::string& subsystem)
+{
+    auto& all = accounts();
+    std::lock_guard<std::mutex> guard(all.lock);
+    return accountLocked(all, subsystem);
+}
+
+std::pmr::memory_resource*
+    memoryResource([[maybe_unused]] const std::string& subsystem)
+{
+#ifdef MEMORY_ACCOUNTING
+    auto& all = accounts();
+    std::lock_guard<std::mutex> guard(all.lock);
+    auto& resource = all.resources[subsystem];
+    if (!resource)
+    {
+        resource = std::make_unique<AccountedResource>(
+            accountLocked(all, subsystem));
+    }
+    return resource.get();
+#else
+    return std::pmr::new_delete_resource();
+#endif
+}
+
+} // namespace metrics
+} // namespace pldm
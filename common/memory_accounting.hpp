@@ -0,0 +1,129 @@
+#pragma once
+
+#include "common/metrics.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+
+namespace pldm
+{
+namespace metrics
+{
+
+/** @class MemoryAccount
+ *
+ *  Memory of one subsystem of the daemon, exported with a subsystem label
+ *  as pldm_memory_live_bytes, pldm_memory_peak_bytes and
+ *  pldm_memory_allocations_total. The subsystems allocating through a
+ *  std::pmr container take memoryResource(), the others, e.g. a fixed
+ *  buffer or a table cache, report their own sizes. The accounts are
+ *  updated from any thread.
+ */
+class MemoryAccount
+{
+  public:
+    MemoryAccount() = delete;
+    MemoryAccount(const MemoryAccount&) = delete;
+    MemoryAccount& operator=(const MemoryAccount&) = delete;
+
+    /** @brief Constructor
+     *
+     *  @param[in] registry - registry the account is exported by
+     *  @param[in] subsystem - label of the account
+     */
+    MemoryAccount(Registry& registry, const std::string& subsystem);
+
+    /** @brief Count an allocation of bytes */
+    void allocated(size_t bytes);
+
+    /** @brief Count the release of bytes */
+    void released(size_t bytes);
+
+    /** @brief Count a block changing size, e.g. a cache being refilled,
+     *         which is not counted as an allocation
+     */
+    void resized(size_t from, size_t to);
+
+    int64_t liveBytes() const
+    {
+        return live.load(std::memory_order_relaxed);
+    }
+
+    int64_t peakBytes() const
+    {
+        return peak.load(std::memory_order_relaxed);
+    }
+
+    uint64_t allocations() const
+    {
+        return allocationCount.value();
+    }
+
+  private:
+    /** @brief Add delta to the live bytes and raise the peak */
+    void adjust(int64_t delta);
+
+    std::atomic<int64_t> live{0};
+    std::atomic<int64_t> peak{0};
+    Gauge& liveGauge;
+    Gauge& peakGauge;
+    Counter& allocationCount;
+};
+
+/** @class AccountedResource
+ *
+ *  Memory resource counting what goes through it into a MemoryAccount.
+ */
+class AccountedResource : public std::pmr::memory_resource
+{
+  public:
+    AccountedResource(MemoryAccount& account,
+                      std::pmr::memory_resource* upstream =
+                          std::pmr::new_delete_resource()) :
+        account(account), upstream(upstream)
+    {}
+
+  private:
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+        auto p = upstream->allocate(bytes, alignment);
+        account.allocated(bytes);
+        return p;
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override
+    {
+        upstream->deallocate(p, bytes, alignment);
+        account.released(bytes);
+    }
+
+    bool do_is_equal(const memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    MemoryAccount& account;
+    std::pmr::memory_resource* upstream;
+};
+
+/** @brief Account of a subsystem, created on first use
+ *
+ *  Without MEMORY_ACCOUNTING the accounts are not exported.
+ *
+ *  @param[in] subsystem - label of the account, e.g. "bios_tables"
+ */
+MemoryAccount& memoryAccount(const std::string& subsystem);
+
+/** @brief Memory resource of a subsystem, counting into its account
+ *
+ *  Without MEMORY_ACCOUNTING this is the new/delete resource.
+ *
+ *  @param[in] subsystem - label of the account
+ */
+std::pmr::memory_resource* memoryResource(const std::string& subsystem);
+
+} // namespace metrics
+} // namespace pldm
@@ -0,0 +1,92 @@
+#include "common/message_arena.hpp"
+
+#include "common/memory_accounting.hpp"
+
+#include <array>
+
+namespace pldm
+{
+namespace utils
+{
+
+namespace
+{
+
+/** @brief Heap resource counting the overflow of the block */
+class OverflowResource : public std::pmr::memory_resource
+{
+  public:
+    uint64_t allocated = 0;
+
+  private:
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+        allocated += bytes;
+        return upstream->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override
+    {
+        upstream->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource* upstream =
+        pldm::metrics::memoryResource("message_arena");
+};
+
+struct ArenaState
+{
+    alignas(std::max_align_t) std::array<std::byte, MessageArena::blockSize>
+        block;
+    OverflowResource overflow;
+    std::pmr::monotonic_buffer_resource arena{block.data(), block.size(),
+                                              &overflow};
+    /** @brief Number of the nested scopes */
+    unsigned depth = 0;
+};
+
+ArenaState& state()
+{
+    thread_local ArenaState arenaState;
+    return arenaState;
+}
+
+} // namespace
+
+MessageArena::Scope::Scope()
+{
+    state().depth++;
+}
+
+MessageArena::Scope::~Scope()
+{
+    auto& arenaState = state();
+    if (--arenaState.depth == 0)
+    {
+        /* The arena starts again at the beginning of the block */
+        arenaState.arena.release();
+    }
+}
+
+std::pmr::memory_resource* MessageArena::resource()
+{
+    auto& arenaState = state();
+    if (!arenaState.depth)
+    {
+        return std::pmr::get_default_resource();
+    }
+    return &arenaState.arena;
+}
+
+uint64_t MessageArena::overflowBytes()
+{
+    return state().overflow.allocated;
+}
+
+} // namespace utils
+} // namespace pldm
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+namespace pldm
+{
+namespace utils
+{
+
+/** @class MessageArena
+ *
+ *  Monotonic arena of the PLDM message being dispatched by pldmd, so the
+ *  temporaries of a handler, e.g. the strings built for a log or a script,
+ *  are bump allocated and all dropped at once after the response is sent.
+ *  The arena starts in a block reused by every dispatch of the thread and
+ *  only goes to the heap for the overflow, which is freed at the end of the
+ *  dispatch. Out of a dispatch resource() is the default resource, so a
+ *  helper can use it whether or not it runs for a message. Memory from the
+ *  arena must not outlive the dispatch, e.g. in a deferred response.
+ */
+class MessageArena
+{
+  public:
+    /** @brief Size of the block reused by the dispatches */
+    static constexpr size_t blockSize = 4096;
+
+    /** @class Scope
+     *
+     *  Dispatch of one message, the arena is reset when the outermost scope
+     *  of the thread ends.
+     */
+    class Scope
+    {
+      public:
+        Scope();
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    /** @brief Memory resource of the message being dispatched, the default
+     *         resource out of a dispatch
+     */
+    static std::pmr::memory_resource* resource();
+
+    /** @brief Bytes taken from the heap by the dispatches of the thread
+     *         which did not fit the block
+     */
+    static uint64_t overflowBytes();
+};
+
+} // namespace utils
+} // namespace pldm
@@ -0,0 +1,233 @@
+#include "common/metrics.hpp"
+
+#include <bit>
+#include <cstdio>
+#include <stdexcept>
+
+namespace pldm
+{
+namespace metrics
+{
+
+void Histogram::observe(std::chrono::nanoseconds duration)
+{
+    auto us = duration.count() > 0
+                  ? static_cast<uint64_t>(duration.count()) / 1000
+                  : 0;
+    buckets[bucketIndex(us)].fetch_add(1, std::memory_order_relaxed);
+    total.fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(us, std::memory_order_relaxed);
+}
+
+size_t Histogram::bucketIndex(uint64_t us)
+{
+    if (us < (uint64_t(1) << minShift))
+    {
+        return 0;
+    }
+    unsigned shift = std::bit_width(us) - 1;
+    if (shift >= maxShift)
+    {
+        return numBuckets;
+    }
+    /* The two bits below the leading one select the sub-bucket */
+    auto sub = (us >> (shift - 2)) & (subBuckets - 1);
+    return 1 + (shift - minShift) * subBuckets + sub;
+}
+
+uint64_t Histogram::upperBound(size_t bucket)
+{
+    if (!bucket)
+    {
+        return uint64_t(1) << minShift;
+    }
+    unsigned shift = minShift + (bucket - 1) / subBuckets;
+    uint64_t sub = (bucket - 1) % subBuckets;
+    return (uint64_t(1) << shift) + ((sub + 1) << (shift - 2));
+}
+
+Registry& Registry::get()
+{
+    static Registry registry;
+    return registry;
+}
+
+Registry::Family& Registry::family(const std::string& name, Type type,
+                                   const std::string& help)
+{
+    auto [it, inserted] = families.try_emplace(name);
+    if (inserted)
+    {
+        it->second.type = type;
+        it->second.help = help;
+    }
+    else if (it->second.type != type)
+    {
+        throw std::invalid_argument("Metric " + name +
+                                    " registered with another type");
+    }
+    return it->second;
+}
+
+Counter& Registry::counter(const std::string& name, const std::string& help,
+                           const Labels& labels)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    auto& series = family(name, Type::Counter, help).counters;
+    auto& metric = series[formatLabels(labels)];
+    if (!metric)
+    {
+        metric = std::make_unique<Counter>();
+    }
+    return *metric;
+}
+
+Gauge& Registry::gauge(const std::string& name, const std::string& help,
+                       const Labels& labels)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    auto& series = family(name, Type::Gauge, help).gauges;
+    auto& metric = series[formatLabels(labels)];
+    if (!metric)
+    {
+        metric = std::make_unique<Gauge>();
+    }
+    return *metric;
+}
+
+Histogram& Registry::histogram(const std::string& name,
+                               const std::string& help, const Labels& labels)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    auto& series = family(name, Type::Histogram, help).histograms;
+    auto& metric = series[formatLabels(labels)];
+    if (!metric)
+    {
+        metric = std::make_unique<Histogram>();
+    }
+    return *metric;
+}
+
+std::string formatLabels(const Labels& labels)
+{
+    std::string out;
+    for (const auto& [key, value] : labels)
+    {
+        if (!out.empty())
+        {
+            out += ',';
+        }
+        out += key;
+        out += "=\"";
+        for (auto c : value)
+        {
+            switch (c)
+            {
+                case '\\':
+                    out += "\\\\";
+                    break;
+                case '"':
+                    out += "\\\"";
+                    break;
+                case '\n':
+                    out += "\\n";
+                    break;
+                default:
+                    out += c;
+            }
+        }
+        out += '"';
+    }
+    return out;
+}
+
+namespace
+{
+
+/** @brief Series name with its labels and an optional extra label */
+std::string seriesName(const std::string& name, const std::string& labels,
+                       const std::string& extra = {})
+{
+    if (labels.empty() && extra.empty())
+    {
+        return name;
+    }
+    std::string out = name + '{' + labels;
+    if (!labels.empty() && !extra.empty())
+    {
+        out += ',';
+    }
+    out += extra + '}';
+    return out;
+}
+
+/** @brief Microseconds as seconds in the text format */
+std::string formatSeconds(uint64_t us)
+{
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.6g", static_cast<double>(us) / 1e6);
+    return buf;
+}
+
+} // namespace
+
+std::string Registry::render() const
+{
+    std::lock_guard<std::mutex> guard(lock);
+    std::string out;
+    for (const auto& [name, family] : families)
+    {
+        switch (family.type)
+        {
+            case Type::Counter:
+                out += "# TYPE " + name + " counter\n";
+                break;
+            case Type::Gauge:
+                out += "# TYPE " + name + " gauge\n";
+                break;
+            case Type::Histogram:
+                out += "# TYPE " + name + " histogram\n";
+                break;
+        }
+        out += "# HELP " + name + ' ' + family.help + '\n';
+
+        for (const auto& [labels, counter] : family.counters)
+        {
+            out += seriesName(name + "_total", labels) + ' ' +
+                   std::to_string(counter->value()) + '\n';
+        }
+        for (const auto& [labels, gauge] : family.gauges)
+        {
+            out += seriesName(name, labels) + ' ' +
+                   std::to_string(gauge->value()) + '\n';
+        }
+        for (const auto& [labels, histogram] : family.histograms)
+        {
+            /* The count is the sum of the buckets read here so that the
+             * exported series stays consistent while it is updated */
+            uint64_t cumulative = 0;
+            for (size_t i = 0; i < Histogram::numBuckets; i++)
+            {
+                cumulative += histogram->bucketCount(i);
+                out += seriesName(name + "_bucket", labels,
+                                  "le=\"" +
+                                      formatSeconds(Histogram::upperBound(i)) +
+                                      '"') +
+                       ' ' + std::to_string(cumulative) + '\n';
+            }
+            cumulative += histogram->bucketCount(Histogram::numBuckets);
+            out += seriesName(name + "_bucket", labels, "le=\"+Inf\"") + ' ' +
+                   std::to_string(cumulative) + '\n';
+            out += seriesName(name + "_count", labels) + ' ' +
+                   std::to_string(cumulative) + '\n';
+            out += seriesName(name + "_sum", labels) + ' ' +
+                   std::to_string(static_cast<double>(histogram->sumUs()) / 1e6) +
+                   '\n';
+        }
+    }
+    out += "# EOF\n";
+    return out;
+}
+
+} // namespace metrics
+} // namespace pldm
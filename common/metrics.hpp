@@ -0,0 +1,185 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace pldm
+{
+namespace metrics
+{
+
+/** @brief Label names and values of one series, e.g. {{"eid", "20"}} */
+using Labels = std::vector<std::pair<std::string, std::string>>;
+
+/** @class Counter
+ *
+ *  Monotonic counter of the number of times something happened.
+ */
+class Counter
+{
+  public:
+    void inc(uint64_t n = 1)
+    {
+        count.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    uint64_t value() const
+    {
+        return count.load(std::memory_order_relaxed);
+    }
+
+  private:
+    std::atomic<uint64_t> count{0};
+};
+
+/** @class Gauge
+ *
+ *  Value which goes up and down, e.g. a queue depth.
+ */
+class Gauge
+{
+  public:
+    void set(int64_t v)
+    {
+        val.store(v, std::memory_order_relaxed);
+    }
+
+    int64_t value() const
+    {
+        return val.load(std::memory_order_relaxed);
+    }
+
+  private:
+    std::atomic<int64_t> val{0};
+};
+
+/** @class Histogram
+ *
+ *  Latency histogram with HDR-style log-linear buckets: every power of two
+ *  of microseconds from 16us to ~33s is split into four linear sub-buckets,
+ *  which bounds the error of a quantile to 25% of the value. Recording is
+ *  a few atomic increments, the buckets are summed up on export.
+ */
+class Histogram
+{
+  public:
+    /** @brief Sub-buckets per power of two */
+    static constexpr unsigned subBuckets = 4;
+    /** @brief Log2 of the upper bound of the first bucket in microseconds */
+    static constexpr unsigned minShift = 4;
+    /** @brief Log2 of the upper bound of the last finite bucket */
+    static constexpr unsigned maxShift = 25;
+    /** @brief Finite buckets, the first one holds everything below 16us */
+    static constexpr size_t numBuckets =
+        1 + (maxShift - minShift) * subBuckets;
+
+    /** @brief Record one duration */
+    void observe(std::chrono::nanoseconds duration);
+
+    /** @brief Upper bound of a finite bucket in microseconds */
+    static uint64_t upperBound(size_t bucket);
+
+    /** @brief Bucket index of a duration in microseconds, numBuckets for
+     *         the values beyond the last finite bucket
+     */
+    static size_t bucketIndex(uint64_t us);
+
+    /** @brief Observations of one bucket, not cumulative */
+    uint64_t bucketCount(size_t bucket) const
+    {
+        return buckets[bucket].load(std::memory_order_relaxed);
+    }
+
+    uint64_t count() const
+    {
+        return total.load(std::memory_order_relaxed);
+    }
+
+    /** @brief Sum of the observations in microseconds */
+    uint64_t sumUs() const
+    {
+        return sum.load(std::memory_order_relaxed);
+    }
+
+  private:
+    std::array<std::atomic<uint64_t>, numBuckets + 1> buckets{};
+    std::atomic<uint64_t> total{0};
+    std::atomic<uint64_t> sum{0};
+};
+
+/** @class Registry
+ *
+ *  Owns the metrics of the daemon. A metric is created on first use and
+ *  lives as long as the registry, so the callers on hot paths look it up
+ *  once and keep the reference. The metrics are incremented from any
+ *  thread, the lookup and the export take a lock.
+ */
+class Registry
+{
+  public:
+    Registry() = default;
+    Registry(const Registry&) = delete;
+    Registry& operator=(const Registry&) = delete;
+
+    /** @brief Registry of the daemon */
+    static Registry& get();
+
+    /** @brief Counter series of a family, "_total" is appended on export
+     *
+     *  @param[in] name - family name
+     *  @param[in] help - description of the family
+     *  @param[in] labels - labels of the series
+     */
+    Counter& counter(const std::string& name, const std::string& help,
+                     const Labels& labels = {});
+
+    /** @brief Gauge series of a family */
+    Gauge& gauge(const std::string& name, const std::string& help,
+                 const Labels& labels = {});
+
+    /** @brief Histogram series of a family, exported in seconds */
+    Histogram& histogram(const std::string& name, const std::string& help,
+                         const Labels& labels = {});
+
+    /** @brief Render all the metrics in the OpenMetrics text format */
+    std::string render() const;
+
+  private:
+    enum class Type
+    {
+        Counter,
+        Gauge,
+        Histogram,
+    };
+
+    struct Family
+    {
+        Type type;
+        std::string help;
+        /** @brief Series keyed by their rendered label set */
+        std::map<std::string, std::unique_ptr<Counter>> counters;
+        std::map<std::string, std::unique_ptr<Gauge>> gauges;
+        std::map<std::string, std::unique_ptr<Histogram>> histograms;
+    };
+
+    /** @brief Family of a name, created with the type on first use */
+    Family& family(const std::string& name, Type type,
+                   const std::string& help);
+
+    mutable std::mutex lock;
+    std::map<std::string, Family> families;
+};
+
+/** @brief Render a label set as 'a="1",b="2"' with the values escaped */
+std::string formatLabels(const Labels& labels);
+
+} // namespace metrics
+} // namespace pldm
@@ -0,0 +1,183 @@
+#include "common/pcap_writer.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <chrono>
+#include <cstring>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace flightrecorder
+{
+
+namespace
+{
+
+constexpr uint32_t pcapngSectionHeaderBlock = 0x0A0D0D0A;
+constexpr uint32_t pcapngInterfaceBlock = 0x00000001;
+constexpr uint32_t pcapngEnhancedPacketBlock = 0x00000006;
+constexpr uint32_t pcapngByteOrderMagic = 0x1A2B3C4D;
+/** @brief Flush early once the active buffer holds this many bytes */
+constexpr size_t flushThreshold = 64 * 1024;
+/** @brief Drop the records once the active buffer holds this many bytes */
+constexpr size_t bufferLimit = 1024 * 1024;
+/** @brief EID used for the BMC side in the synthesized MCTP header */
+constexpr uint8_t localEid = 0;
+/** @brief MCTP message type of PLDM */
+constexpr uint8_t mctpMsgTypePldm = 0x01;
+
+template <typename T>
+void append(std::vector<uint8_t>& buffer, T value)
+{
+    auto bytes = reinterpret_cast<const uint8_t*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(value));
+}
+
+} // namespace
+
+PcapWriter::PcapWriter(const std::filesystem::path& path, size_t maxFileSize) :
+    path(path), maxFileSize(maxFileSize)
+{
+    openFile();
+    activeBuffer.reserve(flushThreshold);
+    writer = std::thread(&PcapWriter::run, this);
+}
+
+PcapWriter::~PcapWriter()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stop = true;
+    }
+    cv.notify_one();
+    if (writer.joinable())
+    {
+        writer.join();
+    }
+}
+
+void PcapWriter::openFile()
+{
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        error("Failed to open the PLDM capture file {PATH}", "PATH",
+              path.string());
+        return;
+    }
+
+    std::vector<uint8_t> header;
+    // Section header block
+    append<uint32_t>(header, pcapngSectionHeaderBlock);
+    append<uint32_t>(header, 28);
+    append<uint32_t>(header, pcapngByteOrderMagic);
+    append<uint16_t>(header, 1);
+    append<uint16_t>(header, 0);
+    append<int64_t>(header, -1);
+    append<uint32_t>(header, 28);
+    // Interface description block
+    append<uint32_t>(header, pcapngInterfaceBlock);
+    append<uint32_t>(header, 20);
+    append<uint16_t>(header, pcapLinkTypeMctp);
+    append<uint16_t>(header, 0);
+    append<uint32_t>(header, 0);
+    append<uint32_t>(header, 20);
+
+    file.write(reinterpret_cast<const char*>(header.data()), header.size());
+    fileSize = header.size();
+}
+
+void PcapWriter::write(std::span<const uint8_t> buffer, bool isTx, uint8_t eid)
+{
+    using namespace std::chrono;
+    uint64_t ts = duration_cast<microseconds>(
+                      system_clock::now().time_since_epoch())
+                      .count();
+    // MCTP transport header and message type precede the PLDM message
+    uint32_t length = buffer.size() + 5;
+    uint32_t padded = (length + 3) & ~3u;
+    uint32_t blockLength = 32 + padded;
+    bool isRequest = !buffer.empty() && (buffer[0] & 0x80);
+
+    bool notify = false;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (activeBuffer.size() + blockLength > bufferLimit)
+        {
+            dropped++;
+            return;
+        }
+        append<uint32_t>(activeBuffer, pcapngEnhancedPacketBlock);
+        append<uint32_t>(activeBuffer, blockLength);
+        append<uint32_t>(activeBuffer, 0);
+        append<uint32_t>(activeBuffer, ts >> 32);
+        append<uint32_t>(activeBuffer, ts & 0xffffffff);
+        append<uint32_t>(activeBuffer, length);
+        append<uint32_t>(activeBuffer, length);
+        // version 1, destination, source, SOM | EOM | TO
+        activeBuffer.push_back(0x01);
+        activeBuffer.push_back(isTx ? eid : localEid);
+        activeBuffer.push_back(isTx ? localEid : eid);
+        activeBuffer.push_back(0xc0 | (isRequest ? 0x08 : 0x00));
+        activeBuffer.push_back(mctpMsgTypePldm);
+        activeBuffer.insert(activeBuffer.end(), buffer.begin(), buffer.end());
+        activeBuffer.insert(activeBuffer.end(), padded - length, 0);
+        append<uint32_t>(activeBuffer, blockLength);
+        notify = activeBuffer.size() >= flushThreshold;
+    }
+    if (notify)
+    {
+        cv.notify_one();
+    }
+}
+
+void PcapWriter::run()
+{
+    std::unique_lock<std::mutex> guard(lock);
+    while (true)
+    {
+        cv.wait_for(guard, std::chrono::seconds(1), [this] {
+            return stop || activeBuffer.size() >= flushThreshold;
+        });
+        bool stopping = stop;
+        std::swap(activeBuffer, flushBuffer);
+        auto droppedRecords = dropped;
+        dropped = 0;
+        guard.unlock();
+
+        if (droppedRecords)
+        {
+            error("Dropped {NUM} PLDM capture records", "NUM", droppedRecords);
+        }
+        if (!flushBuffer.empty() && file)
+        {
+            if (fileSize + flushBuffer.size() > maxFileSize)
+            {
+                file.close();
+                auto rotated = path;
+                rotated += ".1";
+                std::error_code ec;
+                std::filesystem::rename(path, rotated, ec);
+                openFile();
+            }
+            file.write(reinterpret_cast<const char*>(flushBuffer.data()),
+                       flushBuffer.size());
+            file.flush();
+            fileSize += flushBuffer.size();
+        }
+        flushBuffer.clear();
+
+        if (stopping)
+        {
+            return;
+        }
+        guard.lock();
+    }
+}
+
+} // namespace flightrecorder
+} // namespace pldm
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace pldm
+{
+namespace flightrecorder
+{
+
+/** @brief LINKTYPE_MCTP, the packets start with the MCTP transport header */
+constexpr uint16_t pcapLinkTypeMctp = 291;
+
+/** @class PcapWriter
+ *
+ *  Streams the PLDM messages into a pcapng file that Wireshark decodes as
+ *  MCTP/PLDM. The messages are appended to an in-memory buffer on the caller
+ *  thread and written by a background thread, which swaps the buffers so the
+ *  callers never wait on the file. The file is rotated to "<path>.1" once it
+ *  reaches the configured size.
+ */
+class PcapWriter
+{
+  public:
+    PcapWriter() = delete;
+    PcapWriter(const PcapWriter&) = delete;
+    PcapWriter& operator=(const PcapWriter&) = delete;
+
+    /** @brief Open the capture file and start the writer thread
+     *
+     *  @param[in] path - path of the capture file
+     *  @param[in] maxFileSize - size in bytes at which the file is rotated
+     */
+    PcapWriter(const std::filesystem::path& path, size_t maxFileSize);
+
+    /** @brief Flush the pending records and stop the writer thread */
+    ~PcapWriter();
+
+    /** @brief Queue one PLDM message for the capture file
+     *
+     *  @param[in] buffer - PLDM message
+     *  @param[in] isTx - true if the message is sent by the BMC
+     *  @param[in] eid - EID of the remote endpoint
+     *
+     *  @return void
+     */
+    void write(std::span<const uint8_t> buffer, bool isTx, uint8_t eid);
+
+  private:
+    /** @brief Writer thread loop */
+    void run();
+
+    /** @brief Open a new capture file with the section and interface
+     *  headers
+     */
+    void openFile();
+
+    std::filesystem::path path;
+    size_t maxFileSize;
+    size_t fileSize = 0;
+    std::ofstream file;
+
+    std::mutex lock;
+    std::condition_variable cv;
+    /** @brief Buffer filled by the callers */
+    std::vector<uint8_t> activeBuffer;
+    /** @brief Buffer being written by the writer thread */
+    std::vector<uint8_t> flushBuffer;
+    /** @brief Number of records dropped because the writer fell behind */
+    uint64_t dropped = 0;
+    bool stop = false;
+    std::thread writer;
+};
+
+} // namespace flightrecorder
+} // namespace pldm
@@ -0,0 +1,285 @@
+#include "common/pdr_index.hpp"
+
+#include "common/memory_accounting.hpp"
+
+#include <libpldm/pdr.h>
+#include <libpldm/platform.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace pldm
+{
+namespace utils
+{
+
+namespace
+{
+uint64_t pdrRepoGeneration = 1;
+
+/** @brief Bytes of the PDRs of each repository as of the last rebuild of
+ *  one of its indexes, a repository indexed twice is accounted once
+ */
+std::map<const pldm_pdr*, size_t> repoBytes;
+
+void accountRepo(const pldm_pdr* repo, size_t bytes)
+{
+    static auto& account = pldm::metrics::memoryAccount("pdr_repo");
+    auto& accounted = repoBytes[repo];
+    account.resized(accounted, bytes);
+    accounted = bytes;
+}
+} // namespace
+
+void notifyPdrRepoChanged()
+{
+    pdrRepoGeneration++;
+}
+
+uint64_t getPdrRepoGeneration()
+{
+    return pdrRepoGeneration;
+}
+
+void PdrIndex::update()
+{
+    if (valid && generation == pdrRepoGeneration)
+    {
+        return;
+    }
+
+    entries.clear();
+    handleIndex.clear();
+    effecterStateSets.clear();
+    sensorStateSets.clear();
+    effecterIds.clear();
+    sensorIds.clear();
+    idIndex.clear();
+
+    uint8_t* data = nullptr;
+    uint32_t size{};
+    uint32_t nextRecordHandle{};
+    size_t bytes = 0;
+    auto record = pldm_pdr_find_record(repo, 0, &data, &size,
+                                       &nextRecordHandle);
+    while (record)
+    {
+        bytes += size;
+        entries.emplace_back(record, data, size, nextRecordHandle);
+        handleIndex.emplace(pldm_pdr_get_record_handle(repo, record),
+                            entries.size() - 1);
+        addStatePdr(entries.size() - 1);
+        record = pldm_pdr_get_next_record(repo, record, &data, &size,
+                                          &nextRecordHandle);
+    }
+
+    accountRepo(repo, bytes);
+    generation = pdrRepoGeneration;
+    valid = true;
+}
+
+void PdrIndex::addStatePdr(size_t entryIdx)
+{
+    const auto& entry = entries[entryIdx];
+    if (entry.size < sizeof(pldm_pdr_hdr))
+    {
+        return;
+    }
+    auto hdr = reinterpret_cast<const pldm_pdr_hdr*>(entry.data);
+    bool isRemote = pldm_pdr_record_is_remote(entry.record);
+    std::vector<uint16_t> setIds;
+
+    if (hdr->type == PLDM_STATE_EFFECTER_PDR &&
+        entry.size >= sizeof(pldm_state_effecter_pdr))
+    {
+        auto pdr = reinterpret_cast<const pldm_state_effecter_pdr*>(entry.data);
+        idIndex.emplace(IdKey{PLDM_STATE_EFFECTER_PDR, pdr->terminus_handle,
+                              pdr->effecter_id},
+                        entryIdx);
+        auto possibleStatesStart = pdr->possible_states;
+        for (auto effecters = 0x00; effecters < pdr->composite_effecter_count;
+             effecters++)
+        {
+            auto possibleStates =
+                reinterpret_cast<const state_effecter_possible_states*>(
+                    possibleStatesStart);
+            auto setId = possibleStates->state_set_id;
+            /* A PDR is listed once per state set, as the linear search
+             * stops at its first matching composite effecter */
+            if (std::ranges::find(setIds, setId) == setIds.end())
+            {
+                setIds.emplace_back(setId);
+                effecterStateSets.emplace(StateSetKey{pdr->entity_type, setId},
+                                          entryIdx);
+            }
+            effecterIds.emplace(
+                std::make_tuple(EntityKey{pdr->entity_type,
+                                          pdr->entity_instance,
+                                          pdr->container_id, setId},
+                                isRemote),
+                pdr->effecter_id);
+            possibleStatesStart += possibleStates->possible_states_size +
+                                   sizeof(setId) +
+                                   sizeof(possibleStates->possible_states_size);
+        }
+    }
+    else if (hdr->type == PLDM_STATE_SENSOR_PDR &&
+             entry.size >= sizeof(pldm_state_sensor_pdr))
+    {
+        auto pdr = reinterpret_cast<const pldm_state_sensor_pdr*>(entry.data);
+        idIndex.emplace(
+            IdKey{PLDM_STATE_SENSOR_PDR, pdr->terminus_handle, pdr->sensor_id},
+            entryIdx);
+        auto possibleStatesStart = pdr->possible_states;
+        for (auto sensors = 0x00; sensors < pdr->composite_sensor_count;
+             sensors++)
+        {
+            auto possibleStates =
+                reinterpret_cast<const state_sensor_possible_states*>(
+                    possibleStatesStart);
+            auto setId = possibleStates->state_set_id;
+            if (std::ranges::find(setIds, setId) == setIds.end())
+            {
+                setIds.emplace_back(setId);
+                sensorStateSets.emplace(StateSetKey{pdr->entity_type, setId},
+                                        entryIdx);
+            }
+            sensorIds.emplace(EntityKey{pdr->entity_type, pdr->entity_instance,
+                                        pdr->container_id, setId},
+                              pdr->sensor_id);
+            possibleStatesStart += possibleStates->possible_states_size +
+                                   sizeof(setId) +
+                                   sizeof(possibleStates->possible_states_size);
+        }
+    }
+}
+
+const PdrIndexEntry* PdrIndex::getRecordByHandle(uint32_t recordHandle)
+{
+    update();
+    if (entries.empty())
+    {
+        return nullptr;
+    }
+    if (!recordHandle)
+    {
+        return &entries.front();
+    }
+    auto it = handleIndex.find(recordHandle);
+    if (it == handleIndex.end())
+    {
+        return nullptr;
+    }
+    return &entries[it->second];
+}
+
+std::vector<std::vector<uint8_t>>
+    PdrIndex::findStateEffecterPDR(uint16_t entityType, uint16_t stateSetId)
+{
+    update();
+    std::vector<std::vector<uint8_t>> pdrs;
+    auto [begin, end] =
+        effecterStateSets.equal_range(StateSetKey{entityType, stateSetId});
+    for (auto it = begin; it != end; ++it)
+    {
+        const auto& entry = entries[it->second];
+        pdrs.emplace_back(entry.data, entry.data + entry.size);
+    }
+    return pdrs;
+}
+
+std::vector<std::vector<uint8_t>>
+    PdrIndex::findStateSensorPDR(uint16_t entityType, uint16_t stateSetId)
+{
+    update();
+    std::vector<std::vector<uint8_t>> pdrs;
+    auto [begin, end] =
+        sensorStateSets.equal_range(StateSetKey{entityType, stateSetId});
+    for (auto it = begin; it != end; ++it)
+    {
+        const auto& entry = entries[it->second];
+        pdrs.emplace_back(entry.data, entry.data + entry.size);
+    }
+    return pdrs;
+}
+
+uint16_t PdrIndex::findStateEffecterId(uint16_t entityType,
+                                       uint16_t entityInstance,
+                                       uint16_t containerId,
+                                       uint16_t stateSetId, bool localOrRemote)
+{
+    update();
+    /* localOrRemote is true for the local records */
+    auto it = effecterIds.find(std::make_tuple(
+        EntityKey{entityType, entityInstance, containerId, stateSetId},
+        !localOrRemote));
+    if (it == effecterIds.end())
+    {
+        return PLDM_INVALID_EFFECTER_ID;
+    }
+    return it->second;
+}
+
+uint16_t PdrIndex::findStateSensorId(uint16_t entityType,
+                                     uint16_t entityInstance,
+                                     uint16_t containerId, uint16_t stateSetId)
+{
+    update();
+    auto it = sensorIds.find(
+        EntityKey{entityType, entityInstance, containerId, stateSetId});
+    if (it == sensorIds.end())
+    {
+        return PLDM_INVALID_EFFECTER_ID;
+    }
+    return it->second;
+}
+
+const PdrIndexEntry* PdrIndex::findById(uint8_t pdrType,
+                                        uint16_t terminusHandle, uint16_t id)
+{
+    update();
+    auto it = idIndex.find(IdKey{pdrType, terminusHandle, id});
+    if (it == idIndex.end())
+    {
+        return nullptr;
+    }
+    return &entries[it->second];
+}
+
+std::vector<uint8_t> PdrIndex::exportRecords()
+{
+    update();
+
+    size_t offset = sizeof(PdrExportHeader) +
+                    entries.size() * sizeof(PdrExportEntry);
+    size_t totalSize = offset;
+    for (const auto& entry : entries)
+    {
+        totalSize += entry.size;
+    }
+
+    std::vector<uint8_t> data(totalSize);
+    PdrExportHeader header{};
+    header.magic = pdrExportMagic;
+    header.version = pdrExportVersion;
+    header.entrySize = sizeof(PdrExportEntry);
+    header.recordCount = static_cast<uint32_t>(entries.size());
+    header.generation = generation;
+    std::memcpy(data.data(), &header, sizeof(header));
+
+    auto indexEntry = data.data() + sizeof(header);
+    for (const auto& entry : entries)
+    {
+        PdrExportEntry exportEntry{
+            pldm_pdr_get_record_handle(repo, entry.record),
+            static_cast<uint32_t>(offset), entry.size};
+        std::memcpy(indexEntry, &exportEntry, sizeof(exportEntry));
+        indexEntry += sizeof(exportEntry);
+        std::memcpy(data.data() + offset, entry.data, entry.size);
+        offset += entry.size;
+    }
+    return data;
+}
+
+} // namespace utils
+} // namespace pldm
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <libpldm/pdr.h>
+#include <libpldm/platform.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace pldm
+{
+namespace utils
+{
+
+/** @brief Signal that a PDR repository changed
+ *  @details Every code path that adds, removes or updates records of a
+ *  pldm_pdr repository calls this, so that the PdrIndex objects rebuild
+ *  before their next lookup.
+ */
+void notifyPdrRepoChanged();
+
+/** @brief Get the change generation of the PDR repositories
+ *
+ *  @return generation, incremented by notifyPdrRepoChanged
+ */
+uint64_t getPdrRepoGeneration();
+
+/** @struct PdrIndexEntry
+ *  @brief A record of the PDR repository as seen by the index
+ */
+struct PdrIndexEntry
+{
+    const pldm_pdr_record* record; //!< opaque record of the repository
+    const uint8_t* data;           //!< PDR data, owned by the repository
+    uint32_t size;                 //!< PDR size
+    uint32_t nextRecordHandle;     //!< handle of the next record, 0 if last
+};
+
+/** @brief Magic number of a PDR export, "PPDX" */
+constexpr uint32_t pdrExportMagic = 0x58445050;
+/** @brief Layout version of a PDR export */
+constexpr uint16_t pdrExportVersion = 1;
+
+/** @struct PdrExportHeader
+ *  @brief Header at offset 0 of a PDR export. It is followed by recordCount
+ *  PdrExportEntry and the PDRs, all the fields are little-endian.
+ */
+struct PdrExportHeader
+{
+    uint32_t magic;       //!< pdrExportMagic
+    uint16_t version;     //!< pdrExportVersion
+    uint16_t entrySize;   //!< sizeof(PdrExportEntry)
+    uint32_t recordCount; //!< Number of PDRs
+    uint32_t reserved;    //!< Reserved, zero
+    uint64_t generation;  //!< Generation of the exported repository
+};
+static_assert(sizeof(PdrExportHeader) == 24);
+
+/** @struct PdrExportEntry
+ *  @brief Index entry of a PDR of an export, in repository order
+ */
+struct PdrExportEntry
+{
+    uint32_t recordHandle; //!< Record handle of the PDR
+    uint32_t offset;       //!< Offset of the PDR from the start of the export
+    uint32_t size;         //!< Size of the PDR
+};
+static_assert(sizeof(PdrExportEntry) == 12);
+
+/** @class PdrIndex
+ *  @brief Secondary lookup tables over a pldm_pdr repository
+ *  @details libpldm keeps the records in a linked list, so every lookup walks
+ *  the whole repository. The index walks it once and keeps the records by
+ *  record handle, by the entity and state set of the state sensor/effecter
+ *  PDRs and by terminus handle and sensor/effecter ID. The tables are rebuilt
+ *  lazily after notifyPdrRepoChanged.
+ */
+class PdrIndex
+{
+  public:
+    PdrIndex() = delete;
+
+    /** @brief Constructor
+     *
+     *  @param[in] repo - PDR repository to index
+     */
+    explicit PdrIndex(const pldm_pdr* repo) : repo(repo) {}
+
+    /** @brief Find a record by its record handle
+     *
+     *  @param[in] recordHandle - record handle, 0 for the first record
+     *
+     *  @return pointer to the entry, nullptr if not found
+     */
+    const PdrIndexEntry* getRecordByHandle(uint32_t recordHandle);
+
+    /** @brief Find State Effecter PDRs by entity type and state set
+     *  @param[in] entityType - entity that can be associated with the state
+     *                          set.
+     *  @param[in] stateSetId - value that identifies PLDM State set.
+     *  @return array[array[uint8_t]] - StateEffecterPDRs in repository order
+     */
+    std::vector<std::vector<uint8_t>>
+        findStateEffecterPDR(uint16_t entityType, uint16_t stateSetId);
+
+    /** @brief Find State Sensor PDRs by entity type and state set
+     *  @param[in] entityType - entity that can be associated with the state
+     *                          set.
+     *  @param[in] stateSetId - value that identifies PLDM State set.
+     *  @return array[array[uint8_t]] - StateSensorPDRs in repository order
+     */
+    std::vector<std::vector<uint8_t>>
+        findStateSensorPDR(uint16_t entityType, uint16_t stateSetId);
+
+    /** @brief Find effecter id from a state effecter pdr
+     *  @param[in] entityType - entity type
+     *  @param[in] entityInstance - entity instance number
+     *  @param[in] containerId - container id
+     *  @param[in] stateSetId - state set id
+     *  @param[in] localOrRemote - true for checking local repo and false for
+     *                             remote repo
+     *
+     *  @return uint16_t - the effecter id
+     */
+    uint16_t findStateEffecterId(uint16_t entityType, uint16_t entityInstance,
+                                 uint16_t containerId, uint16_t stateSetId,
+                                 bool localOrRemote);
+
+    /** @brief Find sensor id from a state sensor PDR
+     *  @param[in] entityType - entity type
+     *  @param[in] entityInstance - entity instance number
+     *  @param[in] containerId - container id
+     *  @param[in] stateSetId - state set id
+     *
+     *  @return uint16_t - the sensor id
+     */
+    uint16_t findStateSensorId(uint16_t entityType, uint16_t entityInstance,
+                               uint16_t containerId, uint16_t stateSetId);
+
+    /** @brief Find a state sensor/effecter PDR by terminus handle and ID
+     *  @param[in] pdrType - PLDM_STATE_SENSOR_PDR or PLDM_STATE_EFFECTER_PDR
+     *  @param[in] terminusHandle - terminus handle of the PDR
+     *  @param[in] id - sensor or effecter ID
+     *
+     *  @return pointer to the entry, nullptr if not found
+     */
+    const PdrIndexEntry* findById(uint8_t pdrType, uint16_t terminusHandle,
+                                  uint16_t id);
+
+    /** @brief Serialize all the records with an index
+     *
+     *  @return - PdrExportHeader, one PdrExportEntry per record and the
+     *            records
+     */
+    std::vector<uint8_t> exportRecords();
+
+  private:
+    /** @brief entity type, state set */
+    using StateSetKey = std::tuple<uint16_t, uint16_t>;
+    /** @brief entity type, entity instance, container id, state set */
+    using EntityKey = std::tuple<uint16_t, uint16_t, uint16_t, uint16_t>;
+    /** @brief PDR type, terminus handle, sensor/effecter ID */
+    using IdKey = std::tuple<uint8_t, uint16_t, uint16_t>;
+
+    /** @brief Rebuild the tables if the repository changed */
+    void update();
+
+    /** @brief Add one state sensor/effecter PDR to the tables */
+    void addStatePdr(size_t entryIdx);
+
+    const pldm_pdr* repo;
+    /** @brief Generation of the repository the tables were built from */
+    uint64_t generation = 0;
+    bool valid = false;
+
+    std::vector<PdrIndexEntry> entries;
+    std::unordered_map<uint32_t, size_t> handleIndex;
+    std::multimap<StateSetKey, size_t> effecterStateSets;
+    std::multimap<StateSetKey, size_t> sensorStateSets;
+    /** @brief first local and remote match of each state effecter */
+    std::map<std::tuple<EntityKey, bool>, uint16_t> effecterIds;
+    std::map<EntityKey, uint16_t> sensorIds;
+    std::map<IdKey, size_t> idIndex;
+};
+
+} // namespace utils
+} // namespace pldm
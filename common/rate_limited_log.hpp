@@ -0,0 +1,115 @@
+#pragma once
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+namespace pldm
+{
+namespace utils
+{
+
+/** @brief Messages a call site logs in a burst before it is rate limited */
+constexpr unsigned logRateLimitBurst = 10;
+/** @brief Time to earn back one message once the burst is used */
+constexpr std::chrono::seconds logRateLimitRefill{6};
+
+/** @class LogRateLimiter
+ *
+ *  Token bucket of one logging call site. Each message takes a token, the
+ *  tokens refill at a fixed rate up to the burst size. The messages without
+ *  a token are counted and the count is reported with the next message
+ *  which gets through.
+ */
+class LogRateLimiter
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /** @brief Constructor
+     *
+     *  @param[in] burst - number of tokens of a full bucket
+     *  @param[in] refill - time to earn one token
+     */
+    explicit LogRateLimiter(unsigned burst = logRateLimitBurst,
+                            Clock::duration refill = logRateLimitRefill) :
+        burst(std::max(burst, 1u)),
+        refill(refill), tokens(this->burst)
+    {}
+
+    /** @brief Take a token for one message
+     *
+     *  @param[out] suppressed - messages suppressed since the last one which
+     *                           got through, set when returning true
+     *  @param[in] now - current time
+     *
+     *  @return - true if the message is logged
+     */
+    bool allow(uint64_t& suppressed, Clock::time_point now = Clock::now())
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (!started)
+        {
+            lastRefill = now;
+            started = true;
+        }
+        if (tokens < burst && refill.count() > 0)
+        {
+            auto earned = (now - lastRefill) / refill;
+            if (earned > 0)
+            {
+                tokens = std::min<uint64_t>(burst, tokens + earned);
+                lastRefill += earned * refill;
+            }
+        }
+        if (tokens == burst)
+        {
+            /* A full bucket does not bank time */
+            lastRefill = now;
+        }
+        if (!tokens)
+        {
+            dropped++;
+            return false;
+        }
+        tokens--;
+        suppressed = dropped;
+        dropped = 0;
+        return true;
+    }
+
+  private:
+    unsigned burst;
+    Clock::duration refill;
+    uint64_t tokens;
+    uint64_t dropped = 0;
+    bool started = false;
+    Clock::time_point lastRefill{};
+    std::mutex lock;
+};
+
+} // namespace utils
+} // namespace pldm
+
+/** @brief Log with lg2 at the given level through the token bucket of the
+ *  call site, e.g. PLDM_LOG_RATE_LIMITED(error, "Failed {RC}", "RC", rc).
+ *  A summary of the suppressed messages precedes the next logged one.
+ */
+#define PLDM_LOG_RATE_LIMITED(level, ...)                                      \
+    do                                                                         \
+    {                                                                          \
+        static pldm::utils::LogRateLimiter pldmLogLimiter;                     \
+        uint64_t pldmLogSuppressed = 0;                                        \
+        if (pldmLogLimiter.allow(pldmLogSuppressed))                           \
+        {                                                                      \
+            if (pldmLogSuppressed)                                             \
+            {                                                                  \
+                lg2::level("Suppressed {COUNT} messages of the next call site", \
+                           "COUNT", pldmLogSuppressed);                        \
+            }                                                                  \
+            lg2::level(__VA_ARGS__);                                           \
+        }                                                                      \
+    } while (0)
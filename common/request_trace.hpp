@@ -0,0 +1,200 @@
+#pragma once
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <time.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace requesttrace
+{
+static constexpr auto requestTraceDumpPath = "/tmp/pldm_request_trace.json";
+
+/** @brief Points of the lifecycle of a request */
+enum class TracePoint : uint8_t
+{
+    Enqueue,  //!< queued in the endpoint message queue
+    Send,     //!< sent for the first time
+    Retry,    //!< sent again after the response timeout
+    Response, //!< response received, before the response handler
+    Complete, //!< response handler returned
+    Expire,   //!< instance ID expired without a response
+};
+
+/** @struct RequestTraceRecord
+ *
+ *  One preallocated slot of the request trace ring
+ */
+struct RequestTraceRecord
+{
+    uint64_t timeStamp; //!< CLOCK_MONOTONIC time in ns, 0 if unused
+    uint8_t eid;
+    uint8_t instanceId;
+    uint8_t type;
+    uint8_t command;
+    TracePoint point;
+};
+
+using RequestTraceRing =
+    std::array<RequestTraceRecord, REQUEST_TRACE_MAX_ENTRIES>;
+
+/** @class RequestTrace
+ *
+ *  Records a time stamp at each point of the lifecycle of the PLDM
+ *  requests into a fixed ring, so where the time of a slow response went
+ *  (queueing, retries or the terminus) can be read from the data. Tracing
+ *  is toggled at run time, a record is only a time stamp and five bytes.
+ *  The ring is dumped in the Trace Event JSON format which the Perfetto UI
+ *  and chrome://tracing load, one track per EID.
+ */
+class RequestTrace
+{
+  private:
+    RequestTrace() : index(0)
+    {
+#ifdef REQUEST_TRACE_ENABLED
+        enabled = true;
+#endif
+    }
+
+  protected:
+    std::atomic<uint32_t> index;
+    std::atomic<bool> enabled = false;
+    RequestTraceRing ring{};
+
+    /** @brief Get the CLOCK_MONOTONIC time in nanoseconds
+     *
+     *  @return time in nanoseconds
+     */
+    static uint64_t getMonotonicTime()
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return static_cast<uint64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+    }
+
+    static const char* pointName(TracePoint point)
+    {
+        switch (point)
+        {
+            case TracePoint::Enqueue:
+                return "enqueue";
+            case TracePoint::Send:
+                return "send";
+            case TracePoint::Retry:
+                return "retry";
+            case TracePoint::Response:
+                return "response";
+            case TracePoint::Complete:
+                return "complete";
+            case TracePoint::Expire:
+                return "expire";
+        }
+        return "unknown";
+    }
+
+  public:
+    RequestTrace(const RequestTrace&) = delete;
+    RequestTrace(RequestTrace&&) = delete;
+    RequestTrace& operator=(const RequestTrace&) = delete;
+    RequestTrace& operator=(RequestTrace&&) = delete;
+    ~RequestTrace() = default;
+
+    static RequestTrace& GetInstance()
+    {
+        static RequestTrace requestTrace;
+        return requestTrace;
+    }
+
+    /** @brief Check whether the requests are traced */
+    bool isEnabled() const
+    {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    /** @brief Start or stop tracing, the records are kept */
+    void setEnabled(bool enable)
+    {
+        enabled.store(enable, std::memory_order_relaxed);
+    }
+
+    /** @brief Record one point of the lifecycle of a request
+     *
+     *  @param[in] point - lifecycle point
+     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
+     *  @param[in] instanceId - PLDM instance ID of the request
+     *  @param[in] type - PLDM type
+     *  @param[in] command - PLDM command
+     */
+    void record(TracePoint point, uint8_t eid, uint8_t instanceId,
+                uint8_t type, uint8_t command)
+    {
+        if (!isEnabled())
+        {
+            return;
+        }
+        auto currentIndex = index.fetch_add(1, std::memory_order_relaxed) %
+                            REQUEST_TRACE_MAX_ENTRIES;
+        ring[currentIndex] = {getMonotonicTime(), eid,  instanceId,
+                              type,               command, point};
+    }
+
+    /** @brief Dump the ring into requestTraceDumpPath
+     *
+     *  @details Each request is an async slice from its enqueue to its
+     *  completion or expiry, named "<type>/<command>", with its send,
+     *  retries and response as instant events. The time stamps are
+     *  CLOCK_MONOTONIC microseconds.
+     */
+    void dump()
+    {
+        std::ofstream file(requestTraceDumpPath);
+        info("Dumping the request trace into : {DUMP_PATH}", "DUMP_PATH",
+             requestTraceDumpPath);
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        bool first = true;
+        // oldest record first
+        auto start = index.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < ring.size(); i++)
+        {
+            const auto& record = ring[(start + i) % ring.size()];
+            if (!record.timeStamp)
+            {
+                continue;
+            }
+            char phase = 'n';
+            if (record.point == TracePoint::Enqueue)
+            {
+                phase = 'b';
+            }
+            else if (record.point == TracePoint::Complete ||
+                     record.point == TracePoint::Expire)
+            {
+                phase = 'e';
+            }
+            file << (first ? "" : ",") << "\n{\"name\":\""
+                 << unsigned(record.type) << '/' << unsigned(record.command)
+                 << "\",\"cat\":\"pldm\",\"ph\":\"" << phase
+                 << "\",\"id\":"
+                 << ((unsigned(record.eid) << 8) | record.instanceId)
+                 << ",\"pid\":" << unsigned(record.eid)
+                 << ",\"tid\":" << unsigned(record.eid)
+                 << ",\"ts\":" << record.timeStamp / 1000 << '.'
+                 << (record.timeStamp % 1000) / 100
+                 << ",\"args\":{\"point\":\"" << pointName(record.point)
+                 << "\"}}";
+            first = false;
+        }
+        file << "\n]}\n";
+    }
+};
+
+} // namespace requesttrace
+} // namespace pldm
@@ -0,0 +1,101 @@
+#include "common/startup_profile.hpp"
+
+#include <time.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <vector>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace utils
+{
+
+namespace
+{
+
+constexpr auto startupTimesIntf = "com.ampere.PLDM.StartupTimes";
+
+/** @brief Index of the start time, after the phases */
+constexpr size_t startIndex =
+    static_cast<size_t>(StartupProfile::Phase::Count);
+
+constexpr std::array<const char*, startIndex> phaseNames = {
+    "Transport",          "DBusSetup",
+    "PdrRepo",            "EntityTrees",
+    "ResponderReady",     "HostEffecterParser",
+    "BiosHandler",        "FruHandler",
+    "TerminusManager",    "PlatformHandler",
+    "MctpDiscovery",      "NameAcquired",
+    "FirstTerminusDiscovered", "FirstSensorPublished"};
+
+} // namespace
+
+StartupProfile::StartupProfile() : start(Clock::now())
+{
+    timespec ts{};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    startMonotonic = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec));
+}
+
+StartupProfile& StartupProfile::get()
+{
+    static StartupProfile profile;
+    return profile;
+}
+
+const char* StartupProfile::name(Phase phase)
+{
+    return phaseNames[static_cast<size_t>(phase)];
+}
+
+void StartupProfile::record(Phase phase)
+{
+    auto index = static_cast<size_t>(phase);
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(
+        Clock::now() - start);
+    stamps[index] = us;
+    if (counters)
+    {
+        counters->set(index, us.count());
+    }
+    info("Startup phase {PHASE} reached after {TIME_US} us", "PHASE",
+         name(phase), "TIME_US", us.count());
+}
+
+void StartupProfile::exportOnBus(sdbusplus::bus::bus& bus,
+                                 const std::string& path)
+{
+    std::vector<std::string> names;
+    for (const auto& phaseName : phaseNames)
+    {
+        names.emplace_back(std::string(phaseName) + "Us");
+    }
+    names.emplace_back("StartMonotonicUs");
+
+    try
+    {
+        counters = std::make_unique<DBusCounters>(bus, path, startupTimesIntf,
+                                                  names);
+    }
+    catch (const std::exception& e)
+    {
+        error("Failed to export the startup times, error={ERROR}", "ERROR",
+              e.what());
+        return;
+    }
+    for (size_t i = 0; i < stamps.size(); i++)
+    {
+        if (stamps[i])
+        {
+            counters->set(i, stamps[i]->count());
+        }
+    }
+    counters->set(startIndex, startMonotonic.count());
+}
+
+} // namespace utils
+} // namespace pldm
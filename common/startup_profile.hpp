@@ -0,0 +1,109 @@
+#pragma once
+
+#include "common/dbus_counters.hpp"
+
+#include <sdbusplus/bus.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace pldm
+{
+namespace utils
+{
+
+/** @class StartupProfile
+ *
+ *  Monotonic stamps of the initialization phases of the daemon, from the
+ *  construction of the profile at the start of main to the first sensor
+ *  value published. Each phase is stamped once, when it is first reached,
+ *  and logged to the journal. The stamps are exported as read-only D-Bus
+ *  properties in microseconds since the start, 0 until the phase is
+ *  reached, next to the CLOCK_MONOTONIC time of the start so that the
+ *  phases can be placed on the boot timeline.
+ */
+class StartupProfile
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /** @brief Phases, in the order the daemon reaches them */
+    enum class Phase : size_t
+    {
+        Transport,
+        DBusSetup,
+        PdrRepo,
+        EntityTrees,
+        ResponderReady,
+        HostEffecterParser,
+        BiosHandler,
+        FruHandler,
+        TerminusManager,
+        PlatformHandler,
+        MctpDiscovery,
+        NameAcquired,
+        FirstTerminusDiscovered,
+        FirstSensorPublished,
+        Count
+    };
+
+    StartupProfile();
+    StartupProfile(const StartupProfile&) = delete;
+    StartupProfile& operator=(const StartupProfile&) = delete;
+
+    /** @brief Profile of the daemon, started on the first call */
+    static StartupProfile& get();
+
+    /** @brief Stamp a phase, only its first time is kept
+     *
+     *  @param[in] phase - phase reached
+     */
+    void mark(Phase phase)
+    {
+        if (!stamps[static_cast<size_t>(phase)])
+        {
+            record(phase);
+        }
+    }
+
+    /** @brief Time from the start to a phase
+     *
+     *  @param[in] phase - phase
+     *
+     *  @return - elapsed time, std::nullopt until the phase is reached
+     */
+    std::optional<std::chrono::microseconds> elapsed(Phase phase) const
+    {
+        return stamps[static_cast<size_t>(phase)];
+    }
+
+    /** @brief Export the stamps as D-Bus properties, failures are logged
+     *
+     *  @param[in] bus - D-Bus connection
+     *  @param[in] path - object path
+     */
+    void exportOnBus(sdbusplus::bus::bus& bus, const std::string& path);
+
+    /** @brief Name of a phase */
+    static const char* name(Phase phase);
+
+  private:
+    /** @brief Stamp a phase reached for the first time */
+    void record(Phase phase);
+
+    Clock::time_point start;
+    /** @brief CLOCK_MONOTONIC time of the start */
+    std::chrono::microseconds startMonotonic;
+    std::array<std::optional<std::chrono::microseconds>,
+               static_cast<size_t>(Phase::Count)>
+        stamps{};
+    std::unique_ptr<DBusCounters> counters;
+};
+
+} // namespace utils
+} // namespace pldm
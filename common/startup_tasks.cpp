@@ -0,0 +1,203 @@
+#include "common/startup_tasks.hpp"
+
+#include "common/utils.hpp"
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <cerrno>
+#include <exception>
+#include <optional>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace utils
+{
+
+StartupTasks::StartupTasks(sdeventplus::Event& event, size_t threads) :
+    threads(threads)
+{
+    eventFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (eventFd < 0)
+    {
+        error("Failed to create the startup tasks eventfd, ERROR={ERR}",
+              "ERR", errno);
+        return;
+    }
+    completion = std::make_unique<sdeventplus::source::IO>(
+        event, eventFd, EPOLLIN,
+        [this](sdeventplus::source::IO&, int, uint32_t) { complete(); });
+}
+
+StartupTasks::~StartupTasks()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stop = true;
+        queue.clear();
+    }
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    completion.reset();
+    if (eventFd >= 0)
+    {
+        close(eventFd);
+    }
+}
+
+void StartupTasks::submit(Work&& work)
+{
+    if (!completion || !threads)
+    {
+        try
+        {
+            if (auto done = work())
+            {
+                done();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error("Startup task failed, ERROR={ERR_EXCEP}", "ERR_EXCEP",
+                  e.what());
+        }
+        return;
+    }
+
+    unfinished++;
+    std::lock_guard<std::mutex> guard(lock);
+    queue.emplace_back(std::move(work));
+    if (running < threads && running < queue.size())
+    {
+        running++;
+        workers.emplace_back(&StartupTasks::run, this);
+    }
+}
+
+void StartupTasks::onIdle(std::function<void()>&& idle)
+{
+    if (!unfinished)
+    {
+        idle();
+        return;
+    }
+    this->idle = std::move(idle);
+}
+
+void StartupTasks::run()
+{
+    std::unique_lock<std::mutex> guard(lock);
+    while (!stop && !queue.empty())
+    {
+        auto work = std::move(queue.front());
+        queue.pop_front();
+        guard.unlock();
+
+        Done done;
+        try
+        {
+            done = work();
+        }
+        catch (const std::exception& e)
+        {
+            /* The task is finished, without a result to hand over */
+            error("Startup task failed, ERROR={ERR_EXCEP}", "ERR_EXCEP",
+                  e.what());
+        }
+
+        guard.lock();
+        finished.emplace_back(std::move(done));
+        uint64_t count = 1;
+        if (::write(eventFd, &count, sizeof(count)) < 0)
+        {
+            error("Failed to signal the startup task completion, ERROR={ERR}",
+                  "ERR", errno);
+        }
+    }
+    running--;
+}
+
+void StartupTasks::complete()
+{
+    uint64_t count = 0;
+    if (::read(eventFd, &count, sizeof(count)) < 0 && errno != EAGAIN)
+    {
+        error("Failed to read the startup task completion, ERROR={ERR}",
+              "ERR", errno);
+    }
+
+    std::deque<Done> results;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        results.swap(finished);
+    }
+    for (auto& done : results)
+    {
+        unfinished--;
+        if (!done)
+        {
+            continue;
+        }
+        try
+        {
+            done();
+        }
+        catch (const std::exception& e)
+        {
+            error("Failed to hand a startup task result over, "
+                  "ERROR={ERR_EXCEP}",
+                  "ERR_EXCEP", e.what());
+        }
+    }
+    if (!unfinished && idle)
+    {
+        auto callback = std::move(idle);
+        idle = nullptr;
+        callback();
+    }
+}
+
+void preloadJson(StartupTasks& tasks, const std::filesystem::path& path)
+{
+    std::error_code ec;
+    std::vector<std::filesystem::path> files;
+    if (std::filesystem::is_directory(path, ec))
+    {
+        for (const auto& entry : std::filesystem::directory_iterator(path, ec))
+        {
+            if (entry.is_regular_file(ec) &&
+                entry.path().extension() == ".json")
+            {
+                files.emplace_back(entry.path());
+            }
+        }
+    }
+    else if (std::filesystem::is_regular_file(path, ec))
+    {
+        files.emplace_back(path);
+    }
+
+    for (auto& file : files)
+    {
+        tasks.submit([file = std::move(file)]() -> StartupTasks::Done {
+            auto parsed = JsonCache::parse(file);
+            if (!parsed)
+            {
+                return nullptr;
+            }
+            return [file, entry = std::make_shared<JsonCache::Entry>(
+                              std::move(*parsed))]() {
+                JsonCache::get().insert(file, std::move(*entry));
+            };
+        });
+    }
+}
+
+} // namespace utils
+} // namespace pldm
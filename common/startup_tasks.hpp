@@ -0,0 +1,105 @@
+#pragma once
+
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/io.hpp>
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pldm
+{
+namespace utils
+{
+
+/** @class StartupTasks
+ *
+ *  Short-lived pool of threads running the independent work of the startup
+ *  of the daemon, e.g. parsing the JSON configurations, on the other cores
+ *  while the event loop answers the requests. A task returns the function
+ *  handing its result over, which is called from the event loop once the
+ *  loop is woken through an eventfd. The threads exit when no task is
+ *  left, the tasks not started when the pool is destroyed are dropped.
+ */
+class StartupTasks
+{
+  public:
+    /** @brief Hands the result of a task over, called from the event loop */
+    using Done = std::function<void()>;
+    /** @brief Work of a task, run on one of the threads */
+    using Work = std::function<Done()>;
+
+    StartupTasks() = delete;
+    StartupTasks(const StartupTasks&) = delete;
+    StartupTasks& operator=(const StartupTasks&) = delete;
+
+    /** @brief Set up the pool, the threads are started by submit()
+     *
+     *  @param[in] event - event loop the results are handed to
+     *  @param[in] threads - number of threads running the tasks at most
+     */
+    StartupTasks(sdeventplus::Event& event, size_t threads);
+
+    /** @brief Drop the tasks not started and wait for the running ones */
+    ~StartupTasks();
+
+    /** @brief Queue a task, it is run in place if the pool could not be set
+     *         up
+     *
+     *  @param[in] work - work of the task
+     */
+    void submit(Work&& work);
+
+    /** @brief Call a function from the event loop once the result of every
+     *         task submitted was handed over, now if there is none left
+     *
+     *  @param[in] idle - function to call
+     */
+    void onIdle(std::function<void()>&& idle);
+
+    /** @brief Number of tasks whose result was not handed over yet */
+    size_t pending() const
+    {
+        return unfinished;
+    }
+
+  private:
+    /** @brief Thread loop, exits when the queue is empty */
+    void run();
+
+    /** @brief Hand the results of the finished tasks over */
+    void complete();
+
+    size_t threads;
+    /** @brief Tasks submitted whose result was not handed over */
+    size_t unfinished = 0;
+    std::function<void()> idle;
+
+    std::mutex lock;
+    std::deque<Work> queue;
+    std::deque<Done> finished;
+    /** @brief Threads running the tasks */
+    size_t running = 0;
+    bool stop = false;
+
+    int eventFd = -1;
+    std::unique_ptr<sdeventplus::source::IO> completion;
+    std::vector<std::thread> workers;
+};
+
+/** @brief Parse the JSON files of a directory, or a JSON file, on the
+ *         startup threads and add them to the JsonCache from the event loop
+ *
+ *  @param[in] tasks - startup tasks
+ *  @param[in] path - JSON file, or directory of the JSON files
+ */
+void preloadJson(StartupTasks& tasks, const std::filesystem::path& path);
+
+} // namespace utils
+} // namespace pldm
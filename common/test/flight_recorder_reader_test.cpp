@@ -0,0 +1,102 @@
+#include "common/flight_recorder_reader.hpp"
+
+#include <sstream>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::flightrecorder;
+
+namespace
+{
+
+template <typename T>
+void append(std::vector<uint8_t>& buffer, T value)
+{
+    auto bytes = reinterpret_cast<const uint8_t*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(value));
+}
+
+/** @brief Enhanced packet block as the PcapWriter writes it */
+void appendPacket(std::vector<uint8_t>& capture, uint64_t timeUs,
+                  uint8_t destination, uint8_t source,
+                  const std::vector<uint8_t>& msg)
+{
+    uint32_t length = msg.size() + 5;
+    uint32_t padded = (length + 3) & ~3u;
+    uint32_t blockLength = 32 + padded;
+    append<uint32_t>(capture, 6);
+    append<uint32_t>(capture, blockLength);
+    append<uint32_t>(capture, 0);
+    append<uint32_t>(capture, timeUs >> 32);
+    append<uint32_t>(capture, timeUs & 0xffffffff);
+    append<uint32_t>(capture, length);
+    append<uint32_t>(capture, length);
+    capture.insert(capture.end(), {0x01, destination, source, 0xc8, 0x01});
+    capture.insert(capture.end(), msg.begin(), msg.end());
+    capture.insert(capture.end(), padded - length, 0);
+    append<uint32_t>(capture, blockLength);
+}
+
+} // namespace
+
+TEST(FlightRecorderReader, ParsesTheTextDump)
+{
+    std::istringstream dump(
+        "2026-10-14 UTC 12:00:01.5 : Tx : \n"
+        "80 00 04 \n"
+        "2026-10-14 UTC 12:00:01.250000 : Rx : \n"
+        "00 00 04 00 ... (40 bytes)\n"
+        "garbage\n"
+        "\n");
+    auto messages = readCapture(dump);
+    ASSERT_EQ(messages.size(), 2);
+
+    EXPECT_TRUE(messages[0].isTx);
+    EXPECT_EQ(messages[0].data, (std::vector<uint8_t>{0x80, 0x00, 0x04}));
+    EXPECT_TRUE(messages[0].complete());
+    EXPECT_EQ(messages[0].eid, 0);
+
+    EXPECT_FALSE(messages[1].isTx);
+    EXPECT_EQ(messages[1].data.size(), 4);
+    EXPECT_EQ(messages[1].length, 40);
+    EXPECT_FALSE(messages[1].complete());
+    EXPECT_EQ(messages[1].timeUs - messages[0].timeUs, 249995);
+}
+
+TEST(FlightRecorderReader, ParsesThePcapngCapture)
+{
+    std::vector<uint8_t> capture;
+    // Section header and interface description blocks
+    append<uint32_t>(capture, 0x0A0D0D0A);
+    append<uint32_t>(capture, 28);
+    append<uint32_t>(capture, 0x1A2B3C4D);
+    append<uint16_t>(capture, 1);
+    append<uint16_t>(capture, 0);
+    append<int64_t>(capture, -1);
+    append<uint32_t>(capture, 28);
+    append<uint32_t>(capture, 1);
+    append<uint32_t>(capture, 20);
+    append<uint16_t>(capture, 291);
+    append<uint16_t>(capture, 0);
+    append<uint32_t>(capture, 0);
+    append<uint32_t>(capture, 20);
+    appendPacket(capture, 0x100000005, 20, 0, {0x81, 0x02, 0x11});
+    appendPacket(capture, 0x100000105, 0, 20, {0x01, 0x02, 0x11, 0x00, 0x01});
+    // A block cut by the rotation of the file is ignored
+    capture.insert(capture.end(), {0x06, 0x00, 0x00, 0x00, 0x40});
+
+    std::istringstream input(std::string(capture.begin(), capture.end()));
+    auto messages = readCapture(input);
+    ASSERT_EQ(messages.size(), 2);
+
+    EXPECT_TRUE(messages[0].isTx);
+    EXPECT_EQ(messages[0].eid, 20);
+    EXPECT_EQ(messages[0].timeUs, 0x100000005);
+    EXPECT_EQ(messages[0].data, (std::vector<uint8_t>{0x81, 0x02, 0x11}));
+
+    EXPECT_FALSE(messages[1].isTx);
+    EXPECT_EQ(messages[1].eid, 20);
+    EXPECT_EQ(messages[1].data.size(), 5);
+    EXPECT_TRUE(messages[1].complete());
+}
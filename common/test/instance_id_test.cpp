@@ -0,0 +1,49 @@
+#include "common/instance_id.hpp"
+#include "test/test_instance_id.hpp"
+
+#include <set>
+
+#include <gtest/gtest.h>
+
+TEST(InstanceIdDb, leasedIdsInTurn)
+{
+    TestInstanceIdDb db;
+    constexpr uint8_t tid = 9;
+
+    auto first = db.next(tid);
+    auto second = db.next(tid);
+    EXPECT_EQ(first, 0);
+    EXPECT_EQ(second, 1);
+
+    /* A freed ID is handed out again after the rest of the lease */
+    db.free(tid, first);
+    for (size_t i = 2; i < INSTANCE_ID_LEASE_SIZE; i++)
+    {
+        EXPECT_EQ(db.next(tid), i);
+    }
+    EXPECT_EQ(db.next(tid), first);
+
+    EXPECT_THROW(db.free(tid, 31), std::exception);
+    db.free(tid, second);
+    EXPECT_THROW(db.free(tid, second), std::exception);
+}
+
+TEST(InstanceIdDb, allIdsOfATerminus)
+{
+    TestInstanceIdDb db;
+    constexpr uint8_t tid = 9;
+
+    std::set<uint8_t> ids;
+    for (size_t i = 0; i < 32; i++)
+    {
+        ids.insert(db.next(tid));
+    }
+    EXPECT_EQ(ids.size(), 32u);
+    EXPECT_THROW(db.next(tid), std::runtime_error);
+
+    /* The other terminus IDs are not affected */
+    EXPECT_EQ(db.next(tid + 1), 0);
+
+    db.free(tid, 5);
+    EXPECT_EQ(db.next(tid), 5);
+}
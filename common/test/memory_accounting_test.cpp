@@ -0,0 +1,48 @@
+#include "common/memory_accounting.hpp"
+
+#include <memory_resource>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::metrics;
+
+TEST(MemoryAccount, LiveBytesAndPeak)
+{
+    Registry registry;
+    MemoryAccount account(registry, "test");
+
+    account.allocated(100);
+    account.allocated(50);
+    account.released(100);
+    EXPECT_EQ(account.liveBytes(), 50);
+    EXPECT_EQ(account.peakBytes(), 150);
+    EXPECT_EQ(account.allocations(), 2);
+
+    /* A resize moves the live bytes only */
+    account.resized(50, 200);
+    EXPECT_EQ(account.liveBytes(), 200);
+    EXPECT_EQ(account.peakBytes(), 200);
+    EXPECT_EQ(account.allocations(), 2);
+
+    auto text = registry.render();
+    EXPECT_NE(text.find("pldm_memory_live_bytes{subsystem=\"test\"} 200"),
+              std::string::npos);
+    EXPECT_NE(text.find("pldm_memory_peak_bytes{subsystem=\"test\"} 200"),
+              std::string::npos);
+}
+
+TEST(MemoryAccount, CountsThroughTheResource)
+{
+    Registry registry;
+    MemoryAccount account(registry, "test");
+    AccountedResource resource(account);
+    {
+        std::pmr::vector<uint64_t> values(&resource);
+        values.reserve(16);
+        EXPECT_EQ(account.liveBytes(), 16 * sizeof(uint64_t));
+        EXPECT_EQ(account.allocations(), 1);
+    }
+    EXPECT_EQ(account.liveBytes(), 0);
+    EXPECT_EQ(account.peakBytes(), 16 * sizeof(uint64_t));
+}
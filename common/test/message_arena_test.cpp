@@ -0,0 +1,60 @@
+#include "common/message_arena.hpp"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::utils;
+
+TEST(MessageArena, DefaultResourceOutOfDispatch)
+{
+    EXPECT_EQ(MessageArena::resource(), std::pmr::get_default_resource());
+    {
+        MessageArena::Scope scope;
+        EXPECT_NE(MessageArena::resource(), std::pmr::get_default_resource());
+    }
+    EXPECT_EQ(MessageArena::resource(), std::pmr::get_default_resource());
+}
+
+TEST(MessageArena, BlockReusedByDispatches)
+{
+    const void* first = nullptr;
+    for (int i = 0; i < 3; i++)
+    {
+        MessageArena::Scope scope;
+        std::pmr::string text("a string longer than the small buffer",
+                              MessageArena::resource());
+        if (!first)
+        {
+            first = text.data();
+        }
+        /* The arena is reset at the end of each dispatch */
+        EXPECT_EQ(text.data(), first);
+    }
+}
+
+TEST(MessageArena, NestedScopes)
+{
+    MessageArena::Scope outer;
+    std::pmr::vector<int> values({1, 2, 3}, MessageArena::resource());
+    {
+        MessageArena::Scope inner;
+    }
+    /* Only the outermost scope resets the arena */
+    std::pmr::vector<int> next({4, 5, 6}, MessageArena::resource());
+    EXPECT_NE(values.data(), next.data());
+    EXPECT_EQ(values[2], 3);
+}
+
+TEST(MessageArena, OverflowGoesToTheHeap)
+{
+    auto before = MessageArena::overflowBytes();
+    {
+        MessageArena::Scope scope;
+        std::pmr::vector<uint8_t> large(2 * MessageArena::blockSize,
+                                        MessageArena::resource());
+        large.back() = 1;
+    }
+    EXPECT_GT(MessageArena::overflowBytes(), before);
+}
@@ -0,0 +1,87 @@
+#include "common/metrics.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace pldm::metrics;
+using namespace std::chrono_literals;
+
+TEST(Histogram, Buckets)
+{
+    EXPECT_EQ(Histogram::bucketIndex(0), 0);
+    EXPECT_EQ(Histogram::bucketIndex(15), 0);
+    EXPECT_EQ(Histogram::bucketIndex(16), 1);
+    EXPECT_EQ(Histogram::bucketIndex(19), 1);
+    EXPECT_EQ(Histogram::bucketIndex(20), 2);
+    EXPECT_EQ(Histogram::bucketIndex(31), 4);
+    EXPECT_EQ(Histogram::bucketIndex(32), 5);
+    EXPECT_EQ(Histogram::bucketIndex(uint64_t(1) << 25),
+              Histogram::numBuckets);
+
+    EXPECT_EQ(Histogram::upperBound(0), 16);
+    EXPECT_EQ(Histogram::upperBound(1), 20);
+    EXPECT_EQ(Histogram::upperBound(4), 32);
+    EXPECT_EQ(Histogram::upperBound(Histogram::numBuckets - 1),
+              uint64_t(1) << 25);
+
+    /* Every value lands below the upper bound of its bucket */
+    for (uint64_t us = 1; us < (uint64_t(1) << 25); us = us * 3 / 2 + 1)
+    {
+        auto bucket = Histogram::bucketIndex(us);
+        EXPECT_LT(us, Histogram::upperBound(bucket));
+        if (bucket)
+        {
+            EXPECT_GE(us, Histogram::upperBound(bucket - 1));
+        }
+    }
+}
+
+TEST(Histogram, Observe)
+{
+    Histogram histogram;
+    histogram.observe(10us);
+    histogram.observe(25ms);
+    histogram.observe(100s);
+    EXPECT_EQ(histogram.count(), 3);
+    EXPECT_EQ(histogram.sumUs(), 10 + 25000 + 100000000);
+    EXPECT_EQ(histogram.bucketCount(0), 1);
+    EXPECT_EQ(histogram.bucketCount(Histogram::bucketIndex(25000)), 1);
+    EXPECT_EQ(histogram.bucketCount(Histogram::numBuckets), 1);
+}
+
+TEST(Registry, SameSeries)
+{
+    Registry registry;
+    auto& a = registry.counter("pldm_test", "Test", {{"eid", "1"}});
+    auto& b = registry.counter("pldm_test", "Test", {{"eid", "1"}});
+    auto& c = registry.counter("pldm_test", "Test", {{"eid", "2"}});
+    EXPECT_EQ(&a, &b);
+    EXPECT_NE(&a, &c);
+    EXPECT_THROW(registry.gauge("pldm_test", "Test"), std::invalid_argument);
+}
+
+TEST(Registry, Render)
+{
+    Registry registry;
+    registry.counter("pldm_retries", "Retries").inc(3);
+    registry.gauge("pldm_depth", "Depth", {{"eid", "8"}}).set(2);
+    registry.histogram("pldm_rtt_seconds", "RTT", {{"eid", "8"}})
+        .observe(1ms);
+
+    auto text = registry.render();
+    EXPECT_NE(text.find("# TYPE pldm_retries counter\n"), std::string::npos);
+    EXPECT_NE(text.find("pldm_retries_total 3\n"), std::string::npos);
+    EXPECT_NE(text.find("pldm_depth{eid=\"8\"} 2\n"), std::string::npos);
+    EXPECT_NE(text.find("pldm_rtt_seconds_bucket{eid=\"8\",le=\"0.001024\"}"),
+              std::string::npos);
+    EXPECT_NE(text.find("pldm_rtt_seconds_bucket{eid=\"8\",le=\"+Inf\"} 1\n"),
+              std::string::npos);
+    EXPECT_NE(text.find("pldm_rtt_seconds_count{eid=\"8\"} 1\n"),
+              std::string::npos);
+    EXPECT_EQ(text.substr(text.size() - 6), "# EOF\n");
+}
+
+TEST(Registry, EscapeLabels)
+{
+    EXPECT_EQ(formatLabels({{"a", "x\"y"}, {"b", "1\\2"}}),
+              "a=\"x\\\"y\",b=\"1\\\\2\"");
+}
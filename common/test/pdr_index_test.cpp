@@ -0,0 +1,143 @@
+#include "common/pdr_index.hpp"
+
+#include <libpldm/pdr.h>
+#include <libpldm/platform.h>
+
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::utils;
+
+static std::vector<uint8_t> makeStateEffecterPdr(uint16_t effecterId,
+                                                 uint16_t entityType,
+                                                 uint16_t entityInstance,
+                                                 uint16_t stateSetId)
+{
+    std::vector<uint8_t> pdr(sizeof(struct pldm_state_effecter_pdr) -
+                             sizeof(uint8_t) +
+                             sizeof(struct state_effecter_possible_states));
+
+    auto rec = reinterpret_cast<pldm_state_effecter_pdr*>(pdr.data());
+    auto state =
+        reinterpret_cast<state_effecter_possible_states*>(rec->possible_states);
+
+    rec->hdr.type = PLDM_STATE_EFFECTER_PDR;
+    rec->terminus_handle = 1;
+    rec->effecter_id = effecterId;
+    rec->entity_type = entityType;
+    rec->entity_instance = entityInstance;
+    rec->container_id = 0;
+    rec->composite_effecter_count = 1;
+    state->state_set_id = stateSetId;
+    state->possible_states_size = 1;
+
+    return pdr;
+}
+
+TEST(PdrIndex, findStateEffecter)
+{
+    auto repo = pldm_pdr_init();
+    auto first = makeStateEffecterPdr(10, 33, 0, 196);
+    auto second = makeStateEffecterPdr(11, 33, 1, 196);
+
+    uint32_t handle = 0;
+    ASSERT_EQ(pldm_pdr_add_check(repo, first.data(), first.size(), false, 1,
+                                 &handle),
+              0);
+    handle = 0;
+    ASSERT_EQ(pldm_pdr_add_check(repo, second.data(), second.size(), false, 1,
+                                 &handle),
+              0);
+    notifyPdrRepoChanged();
+
+    PdrIndex index(repo);
+    auto pdrs = index.findStateEffecterPDR(33, 196);
+    ASSERT_EQ(pdrs.size(), 2);
+    EXPECT_EQ(pdrs[0], first);
+    EXPECT_EQ(pdrs[1], second);
+    EXPECT_TRUE(index.findStateEffecterPDR(44, 196).empty());
+
+    EXPECT_EQ(index.findStateEffecterId(33, 1, 0, 196, true), 11);
+    EXPECT_EQ(index.findStateEffecterId(33, 1, 0, 196, false),
+              PLDM_INVALID_EFFECTER_ID);
+
+    auto entry = index.findById(PLDM_STATE_EFFECTER_PDR, 1, 10);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->size, first.size());
+
+    auto byHandle = index.getRecordByHandle(handle);
+    ASSERT_NE(byHandle, nullptr);
+    EXPECT_EQ(byHandle->nextRecordHandle, 0);
+
+    pldm_pdr_destroy(repo);
+}
+
+TEST(PdrIndex, rebuildAfterChange)
+{
+    auto repo = pldm_pdr_init();
+    PdrIndex index(repo);
+    EXPECT_EQ(index.getRecordByHandle(0), nullptr);
+
+    auto pdr = makeStateEffecterPdr(10, 33, 0, 196);
+    uint32_t handle = 0;
+    ASSERT_EQ(
+        pldm_pdr_add_check(repo, pdr.data(), pdr.size(), false, 1, &handle), 0);
+    notifyPdrRepoChanged();
+
+    EXPECT_NE(index.getRecordByHandle(0), nullptr);
+    EXPECT_EQ(index.findStateEffecterId(33, 0, 0, 196, true), 10);
+
+    pldm_pdr_destroy(repo);
+}
+
+TEST(PdrIndex, exportRecords)
+{
+    auto repo = pldm_pdr_init();
+    auto first = makeStateEffecterPdr(10, 33, 0, 196);
+    auto second = makeStateEffecterPdr(11, 33, 1, 196);
+    second.resize(second.size() + 3, 0xab);
+
+    uint32_t firstHandle = 0;
+    ASSERT_EQ(pldm_pdr_add_check(repo, first.data(), first.size(), false, 1,
+                                 &firstHandle),
+              0);
+    uint32_t secondHandle = 0;
+    ASSERT_EQ(pldm_pdr_add_check(repo, second.data(), second.size(), false, 1,
+                                 &secondHandle),
+              0);
+    notifyPdrRepoChanged();
+
+    PdrIndex index(repo);
+    auto data = index.exportRecords();
+    ASSERT_GE(data.size(),
+              sizeof(PdrExportHeader) + 2 * sizeof(PdrExportEntry));
+
+    PdrExportHeader header{};
+    std::memcpy(&header, data.data(), sizeof(header));
+    EXPECT_EQ(header.magic, pdrExportMagic);
+    EXPECT_EQ(header.version, pdrExportVersion);
+    EXPECT_EQ(header.entrySize, sizeof(PdrExportEntry));
+    ASSERT_EQ(header.recordCount, 2);
+    EXPECT_EQ(header.generation, getPdrRepoGeneration());
+
+    PdrExportEntry entries[2]{};
+    std::memcpy(entries, data.data() + sizeof(header), sizeof(entries));
+    EXPECT_EQ(entries[0].recordHandle, firstHandle);
+    EXPECT_EQ(entries[1].recordHandle, secondHandle);
+    EXPECT_EQ(entries[0].offset, sizeof(header) + sizeof(entries));
+    EXPECT_EQ(entries[1].offset, entries[0].offset + first.size());
+    EXPECT_EQ(entries[1].offset + entries[1].size, data.size());
+
+    uint8_t* pdrData = nullptr;
+    uint32_t pdrSize = 0;
+    uint32_t nextRecordHandle = 0;
+    pldm_pdr_find_record(repo, secondHandle, &pdrData, &pdrSize,
+                         &nextRecordHandle);
+    ASSERT_EQ(entries[1].size, pdrSize);
+    EXPECT_EQ(std::memcmp(data.data() + entries[1].offset, pdrData, pdrSize),
+              0);
+
+    pldm_pdr_destroy(repo);
+}
@@ -2,6 +2,9 @@
 
 #include <libpldm/platform.h>
 
+#include <filesystem>
+#include <fstream>
+
 #include <gtest/gtest.h>
 
 using namespace pldm::utils;
@@ -1012,3 +1015,194 @@ TEST(Split, allTestCases)
     auto results5 = split(s5, "\\");
     EXPECT_EQ(results5[0], "aa");
 }
+
+TEST(Crc32, incrementalMatchesWholeBuffer)
+{
+    std::vector<uint8_t> data(1000);
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = static_cast<uint8_t>(i * 7 + 3);
+    }
+
+    Crc32 crc;
+    crc.update(std::span(data).subspan(0, 1));
+    crc.update(std::span(data).subspan(1, 499));
+    crc.update(std::span(data).subspan(500));
+    EXPECT_EQ(crc.value(), crc32(data.data(), data.size()));
+
+    const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    crc.reset();
+    crc.update(check);
+    EXPECT_EQ(crc.value(), 0xcbf43926);
+
+    crc.reset();
+    EXPECT_EQ(crc.value(), 0u);
+}
+
+TEST(Crc32, unalignedTails)
+{
+    std::vector<uint8_t> data(64);
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = static_cast<uint8_t>(i * 31 + 5);
+    }
+
+    /* Every length around the 8 byte steps, split at every offset */
+    for (size_t len = 0; len <= 17; len++)
+    {
+        for (size_t split = 0; split <= len; split++)
+        {
+            Crc32 crc;
+            crc.update(std::span(data).subspan(3, split));
+            crc.update(std::span(data).subspan(3 + split, len - split));
+            EXPECT_EQ(crc.value(), crc32(data.data() + 3, len));
+        }
+    }
+}
+
+TEST(Crc32, wholeBufferAtEveryAlignment)
+{
+    std::vector<uint8_t> data(4096 + 16);
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = static_cast<uint8_t>(i * 13 + 11);
+    }
+
+    for (size_t start = 0; start < 16; start++)
+    {
+        auto part = std::span(data).subspan(start, 4096);
+        EXPECT_EQ(Crc32::of(part), crc32(part.data(), part.size()));
+    }
+    EXPECT_EQ(Crc32::of({}), 0u);
+}
+
+TEST(ServiceCache, insertFindErase)
+{
+    ServiceCache& cache = ServiceCache::get();
+    EXPECT_FALSE(cache.enabled());
+
+    cache.insert("/xyz/a", "xyz.If1", "xyz.Service1");
+    cache.insert("/xyz/a", "", "xyz.Service1");
+    cache.insert("/xyz/b", "xyz.If1", "xyz.Service2");
+    EXPECT_EQ(cache.find("/xyz/a", "xyz.If1"), "xyz.Service1");
+    EXPECT_EQ(cache.find("/xyz/a", ""), "xyz.Service1");
+    EXPECT_EQ(cache.find("/xyz/a", "xyz.If2"), std::nullopt);
+    EXPECT_EQ(cache.find("/xyz/c", "xyz.If1"), std::nullopt);
+
+    cache.eraseService("xyz.Service1");
+    EXPECT_EQ(cache.find("/xyz/a", "xyz.If1"), std::nullopt);
+    EXPECT_EQ(cache.find("/xyz/a", ""), std::nullopt);
+    EXPECT_EQ(cache.find("/xyz/b", "xyz.If1"), "xyz.Service2");
+
+    cache.erasePath("/xyz/b");
+    EXPECT_EQ(cache.find("/xyz/b", "xyz.If1"), std::nullopt);
+}
+
+TEST(PropertyCache, watchUpdateErase)
+{
+    PropertyCache& cache = PropertyCache::get();
+    EXPECT_FALSE(cache.enabled());
+
+    DBusMapping mapping{"/xyz/sensor", "xyz.Value", "Value", "double"};
+    DBusMapping other{"/xyz/sensor", "xyz.Other", "Value", "double"};
+    cache.watch(mapping);
+    EXPECT_EQ(cache.find(mapping), std::nullopt);
+
+    cache.update("/xyz/sensor", "xyz.Value", {{"Value", 1.5}});
+    cache.update("/xyz/sensor", "xyz.Other", {{"Value", 2.5}});
+    EXPECT_EQ(cache.find(mapping), PropertyValue{1.5});
+    EXPECT_EQ(cache.find(other), std::nullopt);
+
+    cache.update("/xyz/sensor", "xyz.Value", {{"Value", 3.0}});
+    EXPECT_EQ(cache.find(mapping), PropertyValue{3.0});
+
+    cache.erasePath("/xyz/sensor");
+    EXPECT_EQ(cache.find(mapping), std::nullopt);
+}
+
+TEST(PropertiesChangedDispatcher, commonNamespace)
+{
+    using Dispatcher = PropertiesChangedDispatcher;
+    EXPECT_EQ(Dispatcher::commonNamespace("/xyz/a/b", "/xyz/a/c"), "/xyz/a");
+    EXPECT_EQ(Dispatcher::commonNamespace("/xyz/a/b", "/xyz/a/b"),
+              "/xyz/a/b");
+    EXPECT_EQ(Dispatcher::commonNamespace("/xyz/a", "/xyz/a/b"), "/xyz/a");
+    EXPECT_EQ(Dispatcher::commonNamespace("/xyz/a/b", "/xyz/a"), "/xyz/a");
+    /* A partial path element is not a namespace */
+    EXPECT_EQ(Dispatcher::commonNamespace("/xyz/ab", "/xyz/ac"), "/xyz");
+    EXPECT_EQ(Dispatcher::commonNamespace("/xyz/a", "/xyz/ab"), "/xyz");
+    EXPECT_EQ(Dispatcher::commonNamespace("/xyz", "/abc"), "/");
+    EXPECT_EQ(Dispatcher::commonNamespace("/", "/xyz"), "/");
+}
+
+TEST(ServiceCache, insertSubtree)
+{
+    ServiceCache& cache = ServiceCache::get();
+    GetSubTreeResponse subtree{
+        {"/xyz/d",
+         {{"xyz.Service1", {"xyz.If1", "xyz.If2"}},
+          {"xyz.Service2", {"xyz.If2", "xyz.If3"}}}},
+        {"/xyz/e", {{"xyz.Service2", {"xyz.If1"}}}}};
+    cache.insertSubtree(subtree);
+
+    EXPECT_EQ(cache.find("/xyz/d", "xyz.If1"), "xyz.Service1");
+    EXPECT_EQ(cache.find("/xyz/d", "xyz.If2"), "xyz.Service1");
+    EXPECT_EQ(cache.find("/xyz/d", "xyz.If3"), "xyz.Service2");
+    EXPECT_EQ(cache.find("/xyz/e", "xyz.If1"), "xyz.Service2");
+    /* A lookup of any interface is not known from the subtree */
+    EXPECT_EQ(cache.find("/xyz/d", ""), std::nullopt);
+
+    cache.erasePath("/xyz/d");
+    cache.erasePath("/xyz/e");
+}
+
+TEST(JsonCache, load)
+{
+    auto path =
+        std::filesystem::temp_directory_path() / "json_cache_test.json";
+    auto write = [&path](const std::string& content) {
+        std::ofstream file(path, std::ios::trunc);
+        file << content;
+    };
+    JsonCache& cache = JsonCache::get();
+
+    write(R"({"entries": [1, 2]})");
+    const auto& json = cache.load(path);
+    ASSERT_FALSE(json.is_discarded());
+    EXPECT_EQ(json["entries"].size(), 2u);
+    /* The second load returns the parsed file */
+    EXPECT_EQ(&cache.load(path), &json);
+
+    /* A file of another size is parsed again */
+    write(R"({"entries": [1, 2, 3]})");
+    EXPECT_EQ(cache.load(path)["entries"].size(), 3u);
+
+    write(R"({"entries": [1, 2)");
+    EXPECT_TRUE(cache.load(path).is_discarded());
+
+    std::filesystem::remove(path);
+    EXPECT_TRUE(cache.load(path).is_discarded());
+}
+
+TEST(RequestPool, reuseBuffers)
+{
+    auto buffer = RequestPool::acquire(20);
+    ASSERT_EQ(buffer.size(), 20u);
+    EXPECT_GE(buffer.capacity(), 64u);
+    buffer[3] = 0xAA;
+    auto data = buffer.data();
+    RequestPool::release(std::move(buffer));
+
+    /* The buffer of the same size class is handed out again, zeroed */
+    auto next = RequestPool::acquire(40);
+    EXPECT_EQ(next.data(), data);
+    ASSERT_EQ(next.size(), 40u);
+    EXPECT_EQ(next[3], 0);
+
+    /* A larger request gets a buffer of another class */
+    auto large = RequestPool::acquire(200);
+    EXPECT_NE(large.data(), data);
+    EXPECT_GE(large.capacity(), 200u);
+    RequestPool::release(std::move(next));
+    RequestPool::release(std::move(large));
+}
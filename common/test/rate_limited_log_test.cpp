@@ -0,0 +1,42 @@
+#include "common/rate_limited_log.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace pldm::utils;
+using namespace std::chrono_literals;
+
+TEST(LogRateLimiter, BurstThenSuppress)
+{
+    LogRateLimiter limiter(3, 1s);
+    auto now = LogRateLimiter::Clock::time_point{} + 100s;
+    uint64_t suppressed = 0;
+    for (int i = 0; i < 3; i++)
+    {
+        EXPECT_TRUE(limiter.allow(suppressed, now));
+        EXPECT_EQ(suppressed, 0);
+    }
+    EXPECT_FALSE(limiter.allow(suppressed, now));
+    EXPECT_FALSE(limiter.allow(suppressed, now + 500ms));
+
+    EXPECT_TRUE(limiter.allow(suppressed, now + 1s));
+    EXPECT_EQ(suppressed, 2);
+    EXPECT_FALSE(limiter.allow(suppressed, now + 1500ms));
+}
+
+TEST(LogRateLimiter, RefillUpToBurst)
+{
+    LogRateLimiter limiter(2, 1s);
+    auto now = LogRateLimiter::Clock::time_point{} + 100s;
+    uint64_t suppressed = 0;
+    EXPECT_TRUE(limiter.allow(suppressed, now));
+    EXPECT_TRUE(limiter.allow(suppressed, now));
+    EXPECT_FALSE(limiter.allow(suppressed, now));
+
+    /* A long quiet period refills the bucket but not beyond the burst */
+    now += 60s;
+    EXPECT_TRUE(limiter.allow(suppressed, now));
+    EXPECT_EQ(suppressed, 1);
+    EXPECT_TRUE(limiter.allow(suppressed, now));
+    EXPECT_EQ(suppressed, 0);
+    EXPECT_FALSE(limiter.allow(suppressed, now));
+}
@@ -0,0 +1,30 @@
+#include "common/startup_profile.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace pldm::utils;
+using Phase = StartupProfile::Phase;
+
+TEST(StartupProfile, FirstMarkIsKept)
+{
+    StartupProfile profile;
+    EXPECT_FALSE(profile.elapsed(Phase::Transport));
+
+    profile.mark(Phase::Transport);
+    auto first = profile.elapsed(Phase::Transport);
+    ASSERT_TRUE(first);
+
+    profile.mark(Phase::NameAcquired);
+    profile.mark(Phase::Transport);
+    EXPECT_EQ(profile.elapsed(Phase::Transport), first);
+    ASSERT_TRUE(profile.elapsed(Phase::NameAcquired));
+    EXPECT_GE(*profile.elapsed(Phase::NameAcquired), *first);
+    EXPECT_FALSE(profile.elapsed(Phase::FirstSensorPublished));
+}
+
+TEST(StartupProfile, Names)
+{
+    EXPECT_STREQ(StartupProfile::name(Phase::Transport), "Transport");
+    EXPECT_STREQ(StartupProfile::name(Phase::FirstSensorPublished),
+                 "FirstSensorPublished");
+}
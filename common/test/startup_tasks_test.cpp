@@ -0,0 +1,88 @@
+#include "common/startup_tasks.hpp"
+#include "common/utils.hpp"
+
+#include <stdlib.h>
+
+#include <sdeventplus/event.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::utils;
+using namespace std::chrono_literals;
+
+TEST(StartupTasks, HandsTheResultsToTheEventLoop)
+{
+    auto event = sdeventplus::Event::get_new();
+    StartupTasks tasks(event, 2);
+    auto loopThread = std::this_thread::get_id();
+
+    std::vector<int> results;
+    for (int i = 0; i < 4; i++)
+    {
+        tasks.submit([i, loopThread, &results]() -> StartupTasks::Done {
+            EXPECT_NE(std::this_thread::get_id(), loopThread);
+            return [i, loopThread, &results]() {
+                EXPECT_EQ(std::this_thread::get_id(), loopThread);
+                results.push_back(i);
+            };
+        });
+    }
+    tasks.submit([]() -> StartupTasks::Done {
+        throw std::runtime_error("failed task");
+    });
+    EXPECT_EQ(tasks.pending(), 5);
+
+    bool idle = false;
+    tasks.onIdle([&idle]() { idle = true; });
+    for (int i = 0; i < 100 && !idle; i++)
+    {
+        event.run(10ms);
+    }
+    EXPECT_TRUE(idle);
+    EXPECT_EQ(tasks.pending(), 0);
+    std::sort(results.begin(), results.end());
+    EXPECT_EQ(results, (std::vector<int>{0, 1, 2, 3}));
+
+    /* Nothing left, called now */
+    bool again = false;
+    tasks.onIdle([&again]() { again = true; });
+    EXPECT_TRUE(again);
+}
+
+TEST(StartupTasks, PreloadsTheJsonFiles)
+{
+    char tmpl[] = "/tmp/startup_tasks.XXXXXX";
+    ASSERT_NE(mkdtemp(tmpl), nullptr);
+    std::filesystem::path dir(tmpl);
+    std::ofstream(dir / "valid.json") << R"({"entries": [1, 2]})";
+    std::ofstream(dir / "invalid.json") << "{";
+    std::ofstream(dir / "notes.txt") << "{}";
+
+    EXPECT_FALSE(JsonCache::parse(dir / "missing.json"));
+    auto invalid = JsonCache::parse(dir / "invalid.json");
+    ASSERT_TRUE(invalid);
+    EXPECT_TRUE(invalid->json.is_discarded());
+
+    auto event = sdeventplus::Event::get_new();
+    StartupTasks tasks(event, 2);
+    preloadJson(tasks, dir);
+    EXPECT_EQ(tasks.pending(), 2);
+    for (int i = 0; i < 100 && tasks.pending(); i++)
+    {
+        event.run(10ms);
+    }
+    EXPECT_EQ(tasks.pending(), 0);
+    EXPECT_EQ(JsonCache::get().load(dir / "valid.json").at("entries").size(),
+              2);
+    EXPECT_TRUE(JsonCache::get().load(dir / "invalid.json").is_discarded());
+
+    std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,93 @@
+#include "common/transfer_size.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace pldm::transfer;
+
+TEST(TransferSizes, PartSize)
+{
+    auto& sizes = TransferSizes::get();
+    EXPECT_FALSE(sizes.contains(9));
+    EXPECT_EQ(sizes.partSize(9, 1024), 1024);
+
+    sizes.set(9, 512);
+    EXPECT_TRUE(sizes.contains(9));
+    EXPECT_EQ(sizes.partSize(9, 1024), 512);
+    EXPECT_EQ(sizes.partSize(10, 1024), 1024);
+
+    sizes.setRequester(9);
+    EXPECT_EQ(sizes.requesterPartSize(1024), 512);
+    sizes.setRequester(10);
+    EXPECT_EQ(sizes.requesterPartSize(1024), 1024);
+
+    sizes.erase(9);
+    EXPECT_FALSE(sizes.contains(9));
+    EXPECT_EQ(sizes.partSize(9, 1024), 1024);
+}
+
+TEST(TransferSizes, NegotiateRequest)
+{
+    ProtocolSupport protocols{};
+    addProtocol(protocols, PLDM_PLATFORM);
+    addProtocol(protocols, PLDM_FRU);
+    auto msg = encodeNegotiateReq(3, 0x1234, protocols);
+    ASSERT_EQ(msg.size(), sizeof(pldm_msg_hdr) + negotiateReqBytes);
+
+    auto request = reinterpret_cast<const pldm_msg*>(msg.data());
+    EXPECT_EQ(request->hdr.request, 1);
+    EXPECT_EQ(request->hdr.instance_id, 3);
+    EXPECT_EQ(request->hdr.type, PLDM_BASE);
+    EXPECT_EQ(request->hdr.command, negotiateTransferParameters);
+    EXPECT_EQ(request->payload[0], 0x34);
+    EXPECT_EQ(request->payload[1], 0x12);
+    EXPECT_EQ(request->payload[2], 0x14);
+
+    uint16_t partSize = 0;
+    ProtocolSupport decoded{};
+    std::span<const uint8_t> payload(msg.data() + sizeof(pldm_msg_hdr),
+                                     negotiateReqBytes);
+    ASSERT_EQ(decodeNegotiateReq(payload, partSize, decoded), PLDM_SUCCESS);
+    EXPECT_EQ(partSize, 0x1234);
+    EXPECT_EQ(decoded, protocols);
+
+    EXPECT_EQ(decodeNegotiateReq(payload.first(negotiateReqBytes - 1),
+                                 partSize, decoded),
+              PLDM_ERROR_INVALID_LENGTH);
+}
+
+TEST(TransferSizes, NegotiateResponse)
+{
+    ProtocolSupport protocols{};
+    addProtocol(protocols, PLDM_BIOS);
+    auto msg = encodeNegotiateResp(5, 2048, protocols);
+    ASSERT_EQ(msg.size(), sizeof(pldm_msg_hdr) + negotiateRespBytes);
+    auto response = reinterpret_cast<const pldm_msg*>(msg.data());
+    EXPECT_EQ(response->hdr.request, 0);
+    EXPECT_EQ(response->hdr.instance_id, 5);
+
+    uint16_t partSize = 0;
+    ProtocolSupport decoded{};
+    std::span<const uint8_t> payload(msg.data() + sizeof(pldm_msg_hdr),
+                                     negotiateRespBytes);
+    ASSERT_EQ(decodeNegotiateResp(payload, partSize, decoded), PLDM_SUCCESS);
+    EXPECT_EQ(partSize, 2048);
+    EXPECT_EQ(decoded, protocols);
+
+    const uint8_t unsupported[] = {PLDM_ERROR_UNSUPPORTED_PLDM_CMD};
+    EXPECT_EQ(decodeNegotiateResp(unsupported, partSize, decoded),
+              PLDM_ERROR_UNSUPPORTED_PLDM_CMD);
+}
+
+TEST(TransferSizes, Intersect)
+{
+    ProtocolSupport lhs{};
+    ProtocolSupport rhs{};
+    addProtocol(lhs, PLDM_PLATFORM);
+    addProtocol(lhs, PLDM_BIOS);
+    addProtocol(rhs, PLDM_BIOS);
+    addProtocol(rhs, PLDM_FRU);
+
+    ProtocolSupport both{};
+    addProtocol(both, PLDM_BIOS);
+    EXPECT_EQ(intersect(lhs, rhs), both);
+}
@@ -0,0 +1,100 @@
+#include "common/write_behind.hpp"
+
+#include <stdlib.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::utils;
+using namespace std::chrono_literals;
+
+class WriteBehindTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        char tmpl[] = "/tmp/write_behind.XXXXXX";
+        ASSERT_NE(mkdtemp(tmpl), nullptr);
+        dir = tmpl;
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(dir);
+    }
+
+    static std::vector<uint8_t> bytes(const std::string& text)
+    {
+        return {text.begin(), text.end()};
+    }
+
+    static std::string contents(const std::filesystem::path& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        return {std::istreambuf_iterator<char>(file),
+                std::istreambuf_iterator<char>()};
+    }
+
+    std::filesystem::path dir;
+};
+
+TEST_F(WriteBehindTest, WritesNowWithoutWriteBehind)
+{
+    auto path = dir / "sub" / "table";
+    ASSERT_EQ(WriteBehind::get(), nullptr);
+    EXPECT_TRUE(persistFile(path, bytes("now"), Durability::Fsync));
+    EXPECT_EQ(contents(path), "now");
+    EXPECT_FALSE(std::filesystem::exists(dir / "sub" / "table.tmp"));
+
+    removePersistedFile(path);
+    EXPECT_FALSE(std::filesystem::exists(path));
+}
+
+TEST_F(WriteBehindTest, CoalescesTheUpdatesOfAFile)
+{
+    auto path = dir / "table";
+    WriteBehind writeBehind(1h, 1h, 1024);
+    EXPECT_EQ(WriteBehind::get(), &writeBehind);
+
+    EXPECT_TRUE(persistFile(path, bytes("first")));
+    EXPECT_TRUE(persistFile(path, bytes("second")));
+    EXPECT_TRUE(persistFile(path, bytes("last")));
+    EXPECT_FALSE(std::filesystem::exists(path));
+    EXPECT_EQ(writeBehind.getCoalesced(), 2);
+
+    writeBehind.flush();
+    EXPECT_EQ(contents(path), "last");
+}
+
+TEST_F(WriteBehindTest, WritesWithoutWaitingOverTheBudget)
+{
+    auto path = dir / "table";
+    WriteBehind writeBehind(1h, 1h, 4);
+    EXPECT_TRUE(persistFile(path, bytes("over the budget")));
+    for (int i = 0; i < 100 && !std::filesystem::exists(path); i++)
+    {
+        std::this_thread::sleep_for(10ms);
+    }
+    EXPECT_EQ(contents(path), "over the budget");
+}
+
+TEST_F(WriteBehindTest, WritesThePendingFilesOnDestruction)
+{
+    auto kept = dir / "kept";
+    auto removed = dir / "removed";
+    {
+        WriteBehind writeBehind(1h, 1h, 1024);
+        EXPECT_TRUE(persistFile(kept, bytes("kept")));
+        EXPECT_TRUE(persistFile(removed, bytes("removed")));
+        removePersistedFile(removed);
+    }
+    EXPECT_EQ(WriteBehind::get(), nullptr);
+    EXPECT_EQ(contents(kept), "kept");
+    EXPECT_FALSE(std::filesystem::exists(removed));
+}
@@ -0,0 +1,92 @@
+#include "transfer_size.hpp"
+
+#include <endian.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace pldm
+{
+namespace transfer
+{
+
+namespace
+{
+
+std::vector<uint8_t> encodeHeader(uint8_t instanceId, MessageType msgType,
+                                  size_t payloadLength)
+{
+    std::vector<uint8_t> msg(sizeof(pldm_msg_hdr) + payloadLength, 0);
+    pldm_header_info header{};
+    header.msg_type = msgType;
+    header.instance = instanceId;
+    header.pldm_type = PLDM_BASE;
+    header.command = negotiateTransferParameters;
+    pack_pldm_header(&header, reinterpret_cast<pldm_msg_hdr*>(msg.data()));
+    return msg;
+}
+
+} // namespace
+
+std::vector<uint8_t> encodeNegotiateReq(uint8_t instanceId, uint16_t partSize,
+                                        const ProtocolSupport& protocols)
+{
+    auto msg = encodeHeader(instanceId, PLDM_REQUEST, negotiateReqBytes);
+    auto payload = msg.data() + sizeof(pldm_msg_hdr);
+    partSize = htole16(partSize);
+    std::memcpy(payload, &partSize, sizeof(partSize));
+    std::ranges::copy(protocols, payload + sizeof(partSize));
+    return msg;
+}
+
+int decodeNegotiateReq(std::span<const uint8_t> payload, uint16_t& partSize,
+                       ProtocolSupport& protocols)
+{
+    if (payload.size() != negotiateReqBytes)
+    {
+        return PLDM_ERROR_INVALID_LENGTH;
+    }
+    std::memcpy(&partSize, payload.data(), sizeof(partSize));
+    partSize = le16toh(partSize);
+    std::copy_n(payload.begin() + sizeof(partSize), protocols.size(),
+                protocols.begin());
+    return PLDM_SUCCESS;
+}
+
+std::vector<uint8_t> encodeNegotiateResp(uint8_t instanceId, uint16_t partSize,
+                                         const ProtocolSupport& protocols)
+{
+    auto msg = encodeHeader(instanceId, PLDM_RESPONSE, negotiateRespBytes);
+    auto payload = msg.data() + sizeof(pldm_msg_hdr);
+    payload[0] = PLDM_SUCCESS;
+    partSize = htole16(partSize);
+    std::memcpy(payload + 1, &partSize, sizeof(partSize));
+    /* 4 reserved bytes follow the part size */
+    std::ranges::copy(protocols, payload + 1 + sizeof(partSize) + 4);
+    return msg;
+}
+
+int decodeNegotiateResp(std::span<const uint8_t> payload, uint16_t& partSize,
+                        ProtocolSupport& protocols)
+{
+    if (payload.empty())
+    {
+        return PLDM_ERROR_INVALID_LENGTH;
+    }
+    if (payload[0] != PLDM_SUCCESS)
+    {
+        return payload[0];
+    }
+    if (payload.size() != negotiateRespBytes)
+    {
+        return PLDM_ERROR_INVALID_LENGTH;
+    }
+    std::memcpy(&partSize, payload.data() + 1, sizeof(partSize));
+    partSize = le16toh(partSize);
+    std::copy_n(payload.begin() + 1 + sizeof(partSize) + 4, protocols.size(),
+                protocols.begin());
+    return PLDM_SUCCESS;
+}
+
+} // namespace transfer
+} // namespace pldm
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <libpldm/base.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace pldm
+{
+namespace transfer
+{
+
+/** @brief NegotiateTransferParameters of DSP0240, encoded here since the
+ *  libpldm of the tree has no stable API for it
+ */
+constexpr uint8_t negotiateTransferParameters = 0x07;
+
+/** @brief Smallest part size of DSP0240, the peers support it without
+ *  negotiation
+ */
+constexpr uint16_t baselinePartSize = 256;
+
+/** @brief Smallest part asked for when probing a peer which did not
+ *  negotiate
+ */
+constexpr uint16_t minProbePartSize = 64;
+
+/** @brief Bitfield of the PLDM types, bit N of byte N / 8 is type N */
+using ProtocolSupport = std::array<uint8_t, 8>;
+
+constexpr size_t negotiateReqBytes = 10;
+constexpr size_t negotiateRespBytes = 15;
+
+/** @class TransferSizes
+ *
+ *  Part sizes of the multipart transfers with the MCTP endpoints, e.g.
+ *  GetPDR, GetBIOSTable and GetFRURecordTable. A size is recorded when a
+ *  peer negotiates it with NegotiateTransferParameters, either way, or when
+ *  it is found by probing a peer which does not support the command. The
+ *  responders look up the size of the endpoint of the request being
+ *  handled, which pldmd sets before dispatching it.
+ */
+class TransferSizes
+{
+  public:
+    static TransferSizes& get()
+    {
+        static TransferSizes sizes;
+        return sizes;
+    }
+
+    /** @brief Record the part size of an endpoint */
+    void set(uint8_t eid, uint16_t partSize)
+    {
+        sizes[eid] = partSize;
+    }
+
+    /** @brief Forget the part size of an endpoint, e.g. when it is removed */
+    void erase(uint8_t eid)
+    {
+        sizes[eid] = 0;
+    }
+
+    /** @brief Whether a part size is known for an endpoint */
+    bool contains(uint8_t eid) const
+    {
+        return sizes[eid] != 0;
+    }
+
+    /** @brief Part size of the transfers with an endpoint
+     *
+     *  @param[in] eid - MCTP endpoint ID
+     *  @param[in] fallback - size used when none is known
+     *
+     *  @return - the recorded size, or fallback
+     */
+    uint16_t partSize(uint8_t eid, uint16_t fallback) const
+    {
+        return sizes[eid] ? sizes[eid] : fallback;
+    }
+
+    /** @brief Part size of the transfers with the endpoint of the request
+     *         being handled
+     */
+    uint16_t requesterPartSize(uint16_t fallback) const
+    {
+        return partSize(currentRequester, fallback);
+    }
+
+    /** @brief Set the endpoint of the request being handled */
+    void setRequester(uint8_t eid)
+    {
+        currentRequester = eid;
+    }
+
+    uint8_t requester() const
+    {
+        return currentRequester;
+    }
+
+  private:
+    TransferSizes() = default;
+
+    /** @brief Part size by EID, 0 when unknown */
+    std::array<uint16_t, 256> sizes{};
+    uint8_t currentRequester = 0;
+};
+
+/** @brief Encode a NegotiateTransferParameters request
+ *
+ *  @param[in] instanceId - instance ID of the request
+ *  @param[in] partSize - largest part the requester supports
+ *  @param[in] protocols - types whose transfers use the part size
+ *
+ *  @return - the request message
+ */
+std::vector<uint8_t> encodeNegotiateReq(uint8_t instanceId, uint16_t partSize,
+                                        const ProtocolSupport& protocols);
+
+/** @brief Decode a NegotiateTransferParameters request
+ *
+ *  @return - PLDM_SUCCESS or PLDM_ERROR_INVALID_LENGTH
+ */
+int decodeNegotiateReq(std::span<const uint8_t> payload, uint16_t& partSize,
+                       ProtocolSupport& protocols);
+
+/** @brief Encode a NegotiateTransferParameters response
+ *
+ *  @param[in] instanceId - instance ID of the request
+ *  @param[in] partSize - part size agreed by the responder
+ *  @param[in] protocols - types whose transfers use the part size
+ *
+ *  @return - the response message
+ */
+std::vector<uint8_t> encodeNegotiateResp(uint8_t instanceId, uint16_t partSize,
+                                         const ProtocolSupport& protocols);
+
+/** @brief Decode a NegotiateTransferParameters response
+ *
+ *  @return - PLDM_SUCCESS, PLDM_ERROR_INVALID_LENGTH or the completion code
+ *            of the response
+ */
+int decodeNegotiateResp(std::span<const uint8_t> payload, uint16_t& partSize,
+                        ProtocolSupport& protocols);
+
+/** @brief Set the bit of a type */
+inline void addProtocol(ProtocolSupport& protocols, uint8_t type)
+{
+    if (type / 8 < protocols.size())
+    {
+        protocols[type / 8] |= 1 << (type % 8);
+    }
+}
+
+/** @brief Types of both bitfields */
+inline ProtocolSupport intersect(const ProtocolSupport& lhs,
+                                 const ProtocolSupport& rhs)
+{
+    ProtocolSupport both{};
+    for (size_t i = 0; i < both.size(); i++)
+    {
+        both[i] = lhs[i] & rhs[i];
+    }
+    return both;
+}
+
+} // namespace transfer
+} // namespace pldm
@@ -4,10 +4,31 @@
 #include <libpldm/transport/af-mctp.h>
 #include <libpldm/transport/mctp-demux.h>
 
+#ifdef PLDM_TRANSPORT_WITH_AF_MCTP_SOCKETS
+#include <linux/mctp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#ifdef PLDM_TRANSPORT_WITH_IO_URING
+#include <liburing.h>
+#include <sys/eventfd.h>
+#endif
+
 #include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <memory>
 #include <ranges>
 #include <system_error>
 
+#ifndef AF_MCTP
+#define AF_MCTP 45
+#endif
+
 struct pldm_transport* transport_impl_init(TransportImpl& impl, pollfd& pollfd);
 void transport_impl_destroy(TransportImpl& impl);
 
@@ -100,6 +121,662 @@ static constexpr uint8_t MCTP_EID_VALID_MAX = 255;
     return pldmTransport;
 }
 
+#ifdef PLDM_TRANSPORT_WITH_AF_MCTP_SOCKETS
+
+/*
+ * The af-mctp-sockets implementation talks to the kernel MCTP stack without
+ * libpldm. The requests of the termini are received by a socket bound to the
+ * PLDM message type. Each terminus which a request is sent to gets its own
+ * unbound socket: the kernel allocates the tag of an outgoing request for the
+ * socket sending it and delivers the response on that socket only, so the
+ * responses are filtered per EID before they reach the daemon. As with the
+ * other implementations TID == EID.
+ */
+
+static constexpr uint8_t mctpMsgTypePldm = 1;
+
+/* The receive slots are as large as the largest PLDM message exchanged, the
+ * pages of the unused part of a slot are not touched */
+static constexpr size_t rxSlotSize = 64 * 1024;
+static constexpr size_t rxBatchSize = 16;
+
+/* Same upper bound on an exchange as pldm_transport_send_recv_msg() */
+static constexpr std::chrono::milliseconds sendRecvTimeout(4800);
+
+#ifdef PLDM_TRANSPORT_WITH_IO_URING
+/* The sends of a dispatch of the event loop are batched in the submission
+ * queue, it is submitted early if they do not fit */
+static constexpr unsigned ringEntries = 256;
+/* Buffers the multishot receives pick from, a power of 2 */
+static constexpr unsigned ringBuffers = 32;
+static constexpr int ringBufferGroup = 0;
+/* The user data of an operation has its kind in the upper half, the socket
+ * of a receive or the slot of a send in the lower half */
+static constexpr uint64_t ringRecvOp = uint64_t{1} << 32;
+static constexpr uint64_t ringSendOp = uint64_t{2} << 32;
+static constexpr uint64_t ringOpMask = ~uint64_t{0xffffffff};
+#endif
+
+static sockaddr_mctp mctpAddr(pldm_tid_t tid, uint8_t tag)
+{
+    sockaddr_mctp addr{};
+    addr.smctp_family = AF_MCTP;
+    addr.smctp_network = MCTP_NET_ANY;
+    addr.smctp_addr.s_addr = tid;
+    addr.smctp_type = mctpMsgTypePldm;
+    addr.smctp_tag = tag;
+    return addr;
+}
+
+static void addToEpoll(int epollFd, int fd)
+{
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+}
+
+#ifdef PLDM_TRANSPORT_WITH_IO_URING
+
+/** @struct PldmTransport::Ring
+ *  @brief io_uring of the sockets and its buffer ring
+ */
+struct PldmTransport::Ring
+{
+    /** @brief A send in flight, the kernel reads it until its completion */
+    struct Send
+    {
+        sockaddr_mctp addr;
+        iovec iov;
+        msghdr hdr;
+        std::vector<uint8_t> data;
+    };
+
+    Ring() = default;
+    Ring(const Ring&) = delete;
+    Ring& operator=(const Ring&) = delete;
+
+    ~Ring()
+    {
+        if (bufRing)
+        {
+            io_uring_free_buf_ring(&uring, bufRing, ringBuffers,
+                                   ringBufferGroup);
+        }
+        if (initialized)
+        {
+            io_uring_queue_exit(&uring);
+        }
+        if (eventFd >= 0)
+        {
+            close(eventFd);
+        }
+    }
+
+    /** @brief Get a submission queue entry, submitting the queue if full */
+    io_uring_sqe* sqe()
+    {
+        auto entry = io_uring_get_sqe(&uring);
+        if (!entry)
+        {
+            io_uring_submit(&uring);
+            entry = io_uring_get_sqe(&uring);
+        }
+        if (entry)
+        {
+            unsubmitted = true;
+        }
+        return entry;
+    }
+
+    /** @brief Give a receive buffer back to the buffer ring */
+    void recycle(unsigned bid)
+    {
+        io_uring_buf_ring_add(bufRing, buffers.get() + bid * rxSlotSize,
+                              rxSlotSize, bid,
+                              io_uring_buf_ring_mask(ringBuffers), 0);
+        io_uring_buf_ring_advance(bufRing, 1);
+    }
+
+    io_uring uring{};
+    bool initialized = false;
+    io_uring_buf_ring* bufRing = nullptr;
+    /** @brief ringBuffers receive slots, the pages of the unused part of a
+     *  slot are not touched */
+    std::unique_ptr<uint8_t[]> buffers;
+    /** @brief Signaled by the kernel on each completion */
+    int eventFd = -1;
+    /** @brief Layout of the multishot receives, with room for the source
+     *  address */
+    msghdr recvHdr{};
+    /** @brief The sends in flight by slot */
+    std::map<uint32_t, Send> sends;
+    uint32_t nextSend = 0;
+    /** @brief Entries are queued since the last submit */
+    bool unsubmitted = false;
+};
+
+bool PldmTransport::enableRing()
+{
+    if (ring)
+    {
+        return true;
+    }
+
+    auto newRing = std::make_unique<Ring>();
+    if (io_uring_queue_init(ringEntries, &newRing->uring, 0) < 0)
+    {
+        return false;
+    }
+    newRing->initialized = true;
+
+    newRing->eventFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (newRing->eventFd < 0 ||
+        io_uring_register_eventfd(&newRing->uring, newRing->eventFd) < 0)
+    {
+        return false;
+    }
+
+    int err = 0;
+    newRing->bufRing = io_uring_setup_buf_ring(
+        &newRing->uring, ringBuffers, ringBufferGroup, 0, &err);
+    if (!newRing->bufRing)
+    {
+        return false;
+    }
+    newRing->buffers.reset(new uint8_t[ringBuffers * rxSlotSize]);
+    for (unsigned bid = 0; bid < ringBuffers; bid++)
+    {
+        io_uring_buf_ring_add(newRing->bufRing,
+                              newRing->buffers.get() + bid * rxSlotSize,
+                              rxSlotSize, bid,
+                              io_uring_buf_ring_mask(ringBuffers), bid);
+    }
+    io_uring_buf_ring_advance(newRing->bufRing, ringBuffers);
+    newRing->recvHdr.msg_namelen = sizeof(sockaddr_mctp);
+
+    ring = std::move(newRing);
+    if (listenSocket >= 0)
+    {
+        armRecv(listenSocket);
+    }
+    for (const auto& [tid, fd] : requesterSockets)
+    {
+        armRecv(fd);
+    }
+    flush();
+    return true;
+}
+
+void PldmTransport::flush()
+{
+    if (ring && ring->unsubmitted)
+    {
+        ring->unsubmitted = false;
+        io_uring_submit(&ring->uring);
+    }
+}
+
+void PldmTransport::armRecv(int fd)
+{
+    auto sqe = ring->sqe();
+    if (!sqe)
+    {
+        return;
+    }
+    io_uring_prep_recvmsg_multishot(sqe, fd, &ring->recvHdr, 0);
+    sqe->flags |= IOSQE_BUFFER_SELECT;
+    sqe->buf_group = ringBufferGroup;
+    io_uring_sqe_set_data64(sqe, ringRecvOp | static_cast<uint32_t>(fd));
+}
+
+pldm_requester_rc_t PldmTransport::recvRingMsgs(size_t maxMsgs,
+                                                const RxHandler& handler)
+{
+    eventfd_t signaled = 0;
+    eventfd_read(ring->eventFd, &signaled);
+
+    auto rc = PLDM_REQUESTER_SUCCESS;
+    size_t received = 0;
+    io_uring_cqe* cqe = nullptr;
+    while (received < maxMsgs && !io_uring_peek_cqe(&ring->uring, &cqe))
+    {
+        auto op = io_uring_cqe_get_data64(cqe);
+        auto res = cqe->res;
+        auto flags = cqe->flags;
+        io_uring_cqe_seen(&ring->uring, cqe);
+
+        if ((op & ringOpMask) == ringSendOp)
+        {
+            /* A failed send is seen as a lost message by the requester */
+            ring->sends.erase(static_cast<uint32_t>(op));
+            continue;
+        }
+
+        auto fd = static_cast<int>(static_cast<uint32_t>(op));
+        if (flags & IORING_CQE_F_BUFFER)
+        {
+            auto bid = flags >> IORING_CQE_BUFFER_SHIFT;
+            auto buf = ring->buffers.get() + bid * rxSlotSize;
+            auto out = res > 0 ? io_uring_recvmsg_validate(buf, res,
+                                                           &ring->recvHdr)
+                               : nullptr;
+            /* A truncated or short message can't be decoded */
+            if (out && !(out->flags & MSG_TRUNC) &&
+                out->namelen >= sizeof(sockaddr_mctp))
+            {
+                sockaddr_mctp addr{};
+                std::memcpy(&addr, io_uring_recvmsg_name(out), sizeof(addr));
+                auto len = io_uring_recvmsg_payload_length(out, res,
+                                                           &ring->recvHdr);
+                if (len >= sizeof(pldm_msg_hdr) &&
+                    addr.smctp_type == mctpMsgTypePldm)
+                {
+                    pldm_tid_t tid = addr.smctp_addr.s_addr;
+                    rxTag(tid, addr.smctp_tag);
+                    handler(tid,
+                            io_uring_recvmsg_payload(out, &ring->recvHdr),
+                            len);
+                    received++;
+                }
+            }
+            ring->recycle(bid);
+        }
+
+        if (!(flags & IORING_CQE_F_MORE))
+        {
+            /* The kernel ends a multishot receive once it runs out of
+             * buffers, the others are errors of the socket */
+            if (res >= 0 || res == -ENOBUFS || res == -EINTR)
+            {
+                armRecv(fd);
+            }
+            else
+            {
+                rc = PLDM_REQUESTER_RECV_FAIL;
+            }
+        }
+    }
+
+    /* The eventfd is drained, keep it signaled for the completions left
+     * over by the budget */
+    if (io_uring_cq_ready(&ring->uring))
+    {
+        eventfd_write(ring->eventFd, 1);
+    }
+    flush();
+    return rc;
+}
+
+#endif
+
+PldmTransport::PldmTransport() : pfd{-1, POLLIN, 0}, impl{}, transport(nullptr)
+{
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0)
+    {
+        throw std::system_error(errno, std::generic_category());
+    }
+    pfd.fd = epollFd;
+
+    listenSocket = socket(AF_MCTP, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (listenSocket < 0)
+    {
+        auto err = errno;
+        close(epollFd);
+        throw std::system_error(err, std::generic_category());
+    }
+
+    /* Listen for requests on any network. Another process may already
+     * listen for them, the responses to the requests of this one are still
+     * received on the requester sockets */
+    auto addr = mctpAddr(MCTP_ADDR_ANY, 0);
+    if (bind(listenSocket, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)))
+    {
+        auto err = errno;
+        close(listenSocket);
+        listenSocket = -1;
+        if (err != EADDRINUSE)
+        {
+            close(epollFd);
+            throw std::system_error(err, std::generic_category());
+        }
+        return;
+    }
+    addToEpoll(epollFd, listenSocket);
+}
+
+PldmTransport::~PldmTransport()
+{
+#ifdef PLDM_TRANSPORT_WITH_IO_URING
+    ring.reset();
+#endif
+    for (const auto& [tid, fd] : requesterSockets)
+    {
+        close(fd);
+    }
+    if (listenSocket >= 0)
+    {
+        close(listenSocket);
+    }
+    close(epollFd);
+}
+
+std::vector<int> PldmTransport::getEventSources() const
+{
+#ifdef PLDM_TRANSPORT_WITH_IO_URING
+    if (ring)
+    {
+        return {ring->eventFd};
+    }
+#endif
+    std::vector<int> fds;
+    if (listenSocket >= 0)
+    {
+        fds.emplace_back(listenSocket);
+    }
+    for (const auto& [tid, fd] : requesterSockets)
+    {
+        fds.emplace_back(fd);
+    }
+    return fds;
+}
+
+void PldmTransport::onSocketAdded(SocketHandler handler)
+{
+    socketAdded = std::move(handler);
+}
+
+int PldmTransport::getRequesterSocket(pldm_tid_t tid)
+{
+    auto it = requesterSockets.find(tid);
+    if (it != requesterSockets.end())
+    {
+        return it->second;
+    }
+
+    int fd = socket(AF_MCTP, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        return -1;
+    }
+    requesterSockets[tid] = fd;
+    addToEpoll(epollFd, fd);
+#ifdef PLDM_TRANSPORT_WITH_IO_URING
+    /* The responses are completed on the eventfd of the ring */
+    if (ring)
+    {
+        armRecv(fd);
+        return fd;
+    }
+#endif
+    if (socketAdded)
+    {
+        socketAdded(fd);
+    }
+    return fd;
+}
+
+void PldmTransport::rxTag(pldm_tid_t tid, uint8_t tag)
+{
+    if (tag & MCTP_TAG_OWNER)
+    {
+        requestTags[tid] = tag & MCTP_TAG_MASK;
+    }
+}
+
+pldm_requester_rc_t PldmTransport::sendMsg(pldm_tid_t tid, const void* tx,
+                                           size_t len)
+{
+    if (len < sizeof(pldm_msg_hdr))
+    {
+        return PLDM_REQUESTER_NOT_PLDM_MSG;
+    }
+
+    int fd = -1;
+    uint8_t tag = MCTP_TAG_OWNER;
+    if (static_cast<const pldm_msg_hdr*>(tx)->request)
+    {
+        fd = getRequesterSocket(tid);
+    }
+    else
+    {
+        /* A response goes back with the tag of the request */
+        auto it = requestTags.find(tid);
+        if (it == requestTags.end())
+        {
+            return PLDM_REQUESTER_SEND_FAIL;
+        }
+        fd = listenSocket;
+        tag = it->second;
+    }
+    if (fd < 0)
+    {
+        return PLDM_REQUESTER_SEND_FAIL;
+    }
+
+    auto addr = mctpAddr(tid, tag);
+#ifdef PLDM_TRANSPORT_WITH_IO_URING
+    if (ring)
+    {
+        auto sqe = ring->sqe();
+        if (!sqe)
+        {
+            return PLDM_REQUESTER_SEND_FAIL;
+        }
+        auto slot = ring->nextSend++;
+        auto& send = ring->sends[slot];
+        auto data = static_cast<const uint8_t*>(tx);
+        send.addr = addr;
+        send.data.assign(data, data + len);
+        send.iov = {send.data.data(), len};
+        send.hdr = {};
+        send.hdr.msg_name = &send.addr;
+        send.hdr.msg_namelen = sizeof(send.addr);
+        send.hdr.msg_iov = &send.iov;
+        send.hdr.msg_iovlen = 1;
+        io_uring_prep_sendmsg(sqe, fd, &send.hdr, 0);
+        io_uring_sqe_set_data64(sqe, ringSendOp | slot);
+        return PLDM_REQUESTER_SUCCESS;
+    }
+#endif
+    auto rc = sendto(fd, tx, len, 0, reinterpret_cast<sockaddr*>(&addr),
+                     sizeof(addr));
+    if (rc < 0 || static_cast<size_t>(rc) != len)
+    {
+        return PLDM_REQUESTER_SEND_FAIL;
+    }
+    return PLDM_REQUESTER_SUCCESS;
+}
+
+pldm_requester_rc_t PldmTransport::recvSocketMsg(int fd, pldm_tid_t& tid,
+                                                 void*& rx, size_t& len)
+{
+    auto size = recv(fd, nullptr, 0, MSG_PEEK | MSG_TRUNC | MSG_DONTWAIT);
+    if (size < 0)
+    {
+        return PLDM_REQUESTER_RECV_FAIL;
+    }
+    if (static_cast<size_t>(size) < sizeof(pldm_msg_hdr))
+    {
+        /* Drop the message */
+        recv(fd, nullptr, 0, MSG_DONTWAIT);
+        return PLDM_REQUESTER_INVALID_RECV_LEN;
+    }
+
+    auto buf = malloc(size);
+    if (!buf)
+    {
+        return PLDM_REQUESTER_RECV_FAIL;
+    }
+    sockaddr_mctp addr{};
+    socklen_t addrLen = sizeof(addr);
+    auto rc = recvfrom(fd, buf, size, MSG_DONTWAIT,
+                       reinterpret_cast<sockaddr*>(&addr), &addrLen);
+    if (rc != size)
+    {
+        free(buf);
+        return PLDM_REQUESTER_RECV_FAIL;
+    }
+    if (addr.smctp_type != mctpMsgTypePldm)
+    {
+        free(buf);
+        return PLDM_REQUESTER_NOT_PLDM_MSG;
+    }
+
+    tid = addr.smctp_addr.s_addr;
+    rxTag(tid, addr.smctp_tag);
+    rx = buf;
+    len = size;
+    return PLDM_REQUESTER_SUCCESS;
+}
+
+pldm_requester_rc_t PldmTransport::recvMsg(pldm_tid_t& tid, void*& rx,
+                                           size_t& len)
+{
+#ifdef PLDM_TRANSPORT_WITH_IO_URING
+    if (ring)
+    {
+        return PLDM_REQUESTER_RECV_FAIL;
+    }
+#endif
+    epoll_event event{};
+    if (epoll_wait(epollFd, &event, 1, 0) <= 0)
+    {
+        return PLDM_REQUESTER_RECV_FAIL;
+    }
+    return recvSocketMsg(event.data.fd, tid, rx, len);
+}
+
+pldm_requester_rc_t PldmTransport::recvMsgs(int fd, size_t maxMsgs,
+                                            const RxHandler& handler)
+{
+#ifdef PLDM_TRANSPORT_WITH_IO_URING
+    if (ring)
+    {
+        return recvRingMsgs(maxMsgs, handler);
+    }
+#endif
+    if (!rxBuffers)
+    {
+        rxBuffers.reset(new uint8_t[rxBatchSize * rxSlotSize]);
+    }
+
+    std::array<mmsghdr, rxBatchSize> msgs{};
+    std::array<iovec, rxBatchSize> iovs{};
+    std::array<sockaddr_mctp, rxBatchSize> addrs{};
+    size_t received = 0;
+    while (received < maxMsgs)
+    {
+        auto batch = std::min(maxMsgs - received, rxBatchSize);
+        for (size_t i = 0; i < batch; i++)
+        {
+            iovs[i] = {rxBuffers.get() + i * rxSlotSize, rxSlotSize};
+            msgs[i].msg_hdr = {};
+            msgs[i].msg_hdr.msg_iov = &iovs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+            msgs[i].msg_hdr.msg_name = &addrs[i];
+            msgs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+        }
+
+        auto count = recvmmsg(fd, msgs.data(), batch, MSG_DONTWAIT, nullptr);
+        if (count < 0)
+        {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+            {
+                break;
+            }
+            return PLDM_REQUESTER_RECV_FAIL;
+        }
+
+        for (int i = 0; i < count; i++)
+        {
+            /* A truncated or short message can't be decoded */
+            if ((msgs[i].msg_hdr.msg_flags & MSG_TRUNC) ||
+                msgs[i].msg_len < sizeof(pldm_msg_hdr) ||
+                addrs[i].smctp_type != mctpMsgTypePldm)
+            {
+                continue;
+            }
+            pldm_tid_t tid = addrs[i].smctp_addr.s_addr;
+            rxTag(tid, addrs[i].smctp_tag);
+            handler(tid, iovs[i].iov_base, msgs[i].msg_len);
+        }
+
+        received += count;
+        if (static_cast<size_t>(count) < batch)
+        {
+            break;
+        }
+    }
+    return PLDM_REQUESTER_SUCCESS;
+}
+
+pldm_requester_rc_t PldmTransport::sendRecvMsg(pldm_tid_t tid, const void* tx,
+                                               size_t txLen, void*& rx,
+                                               size_t& rxLen)
+{
+    if (txLen < sizeof(pldm_msg_hdr) ||
+        !static_cast<const pldm_msg_hdr*>(tx)->request)
+    {
+        return PLDM_REQUESTER_NOT_REQ_MSG;
+    }
+#ifdef PLDM_TRANSPORT_WITH_IO_URING
+    /* The responses are completed on the ring */
+    if (ring)
+    {
+        return PLDM_REQUESTER_RECV_FAIL;
+    }
+#endif
+    auto rc = sendMsg(tid, tx, txLen);
+    if (rc != PLDM_REQUESTER_SUCCESS)
+    {
+        return rc;
+    }
+
+    auto instanceId = static_cast<const pldm_msg_hdr*>(tx)->instance_id;
+    pollfd rxPfd = {requesterSockets.at(tid), POLLIN, 0};
+    auto deadline = std::chrono::steady_clock::now() + sendRecvTimeout;
+    while (true)
+    {
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now());
+        if (left.count() <= 0)
+        {
+            return PLDM_REQUESTER_RECV_FAIL;
+        }
+        auto ready = poll(&rxPfd, 1, left.count());
+        if (ready < 0)
+        {
+            return PLDM_REQUESTER_POLL_FAIL;
+        }
+        if (!ready)
+        {
+            continue;
+        }
+
+        pldm_tid_t rxTid = 0;
+        rc = recvSocketMsg(rxPfd.fd, rxTid, rx, rxLen);
+        if (rc == PLDM_REQUESTER_RECV_FAIL)
+        {
+            return rc;
+        }
+        if (rc != PLDM_REQUESTER_SUCCESS)
+        {
+            continue;
+        }
+        auto hdr = static_cast<const pldm_msg_hdr*>(rx);
+        if (rxTid == tid && !hdr->request && hdr->instance_id == instanceId)
+        {
+            return PLDM_REQUESTER_SUCCESS;
+        }
+        free(rx);
+        rx = nullptr;
+    }
+}
+
+#else
+
 struct pldm_transport* transport_impl_init(TransportImpl& impl, pollfd& pollfd)
 {
 #if defined(PLDM_TRANSPORT_WITH_MCTP_DEMUX)
@@ -134,9 +811,35 @@ PldmTransport::~PldmTransport()
     transport_impl_destroy(impl);
 }
 
-int PldmTransport::getEventSource() const
+std::vector<int> PldmTransport::getEventSources() const
 {
-    return pfd.fd;
+    return {pfd.fd};
+}
+
+void PldmTransport::onSocketAdded(SocketHandler /*handler*/) {}
+
+pldm_requester_rc_t PldmTransport::recvMsgs(int /*fd*/, size_t maxMsgs,
+                                            const RxHandler& handler)
+{
+    for (size_t rxCount = 0; rxCount < maxMsgs; rxCount++)
+    {
+        if (rxCount && !hasPendingMsg())
+        {
+            break;
+        }
+
+        pldm_tid_t tid = 0;
+        void* rx = nullptr;
+        size_t len = 0;
+        auto rc = recvMsg(tid, rx, len);
+        if (rc != PLDM_REQUESTER_SUCCESS)
+        {
+            return rc;
+        }
+        std::unique_ptr<void, decltype(&free)> rxPtr(rx, free);
+        handler(tid, rx, len);
+    }
+    return PLDM_REQUESTER_SUCCESS;
 }
 
 pldm_requester_rc_t PldmTransport::sendMsg(pldm_tid_t tid, const void* tx,
@@ -157,3 +860,16 @@ pldm_requester_rc_t PldmTransport::sendRecvMsg(pldm_tid_t tid, const void* tx,
 {
     return pldm_transport_send_recv_msg(transport, tid, tx, txLen, &rx, &rxLen);
 }
+
+#endif
+
+int PldmTransport::getEventSource() const
+{
+    return pfd.fd;
+}
+
+bool PldmTransport::hasPendingMsg()
+{
+    pollfd rxPfd = {pfd.fd, POLLIN, 0};
+    return poll(&rxPfd, 1, 0) > 0 && (rxPfd.revents & POLLIN);
+}
@@ -5,6 +5,11 @@
 #include <poll.h>
 #include <stddef.h>
 
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
 struct pldm_transport_mctp_demux;
 struct pldm_transport_af_mctp;
 
@@ -18,6 +23,15 @@ union TransportImpl
 class PldmTransport
 {
   public:
+    /** @brief Handler of a received message, the buffer is only valid during
+     *         the call
+     */
+    using RxHandler =
+        std::function<void(pldm_tid_t tid, const void* rx, size_t len)>;
+
+    /** @brief Handler of a socket opened after the construction */
+    using SocketHandler = std::function<void(int fd)>;
+
     PldmTransport();
     PldmTransport(const PldmTransport& other) = delete;
     PldmTransport(const PldmTransport&& other) = delete;
@@ -34,6 +48,46 @@ class PldmTransport
      */
     int getEventSource() const;
 
+    /** @brief Check without blocking if another message is queued on the
+     * event source
+     *
+     * @return true if recvMsg() will immediately yield a message
+     */
+    bool hasPendingMsg();
+
+    /** @brief Provides the file descriptors which can be polled separately,
+     *         each is drained by recvMsgs()
+     *
+     * With the af-mctp-sockets implementation these are the socket receiving
+     * the requests of the termini and one socket per terminus which pldmd
+     * sent requests to, so that the kernel delivers the responses of each
+     * terminus on its own socket. The other implementations have a single
+     * event source.
+     *
+     * @return The file descriptors.
+     */
+    std::vector<int> getEventSources() const;
+
+    /** @brief Set the handler of the sockets opened later, e.g. on the first
+     *         request to a terminus
+     *
+     * @param[in] handler - called with the file descriptor of the new socket
+     */
+    void onSocketAdded(SocketHandler handler);
+
+    /** @brief Receive the messages queued on one of the event sources
+     *
+     * @param[in] fd - The event source, from getEventSources()
+     * @param[in] maxMsgs - The max number of messages received
+     * @param[in] handler - Called for each received message
+     *
+     * @return PLDM_REQUESTER_SUCCESS once the queue is empty or maxMsgs are
+     *         received, otherwise the PLDM_REQUESTER_* error code of the
+     *         failed receive.
+     */
+    pldm_requester_rc_t recvMsgs(int fd, size_t maxMsgs,
+                                 const RxHandler& handler);
+
     /** @brief Asynchronously send a PLDM message to the specified terminus
      *
      * The message may be either a request or a response.
@@ -87,7 +141,106 @@ class PldmTransport
     pldm_requester_rc_t sendRecvMsg(pldm_tid_t tid, const void* tx,
                                     size_t txLen, void*& rx, size_t& rxLen);
 
+#ifdef PLDM_TRANSPORT_WITH_IO_URING
+    /** @brief Move the sends and receives of the sockets to an io_uring
+     *
+     * The sockets are received by multishot receives into the buffers of a
+     * registered buffer ring, and the single event source becomes the
+     * eventfd of the ring. sendMsg() copies the message to an entry of the
+     * submission queue, which is submitted by the next flush(). Once the
+     * ring is enabled, the messages are only received by recvMsgs().
+     *
+     * @return true if the ring is enabled, false if the kernel does not
+     *         support it and the socket calls are kept
+     */
+    bool enableRing();
+
+    /** @brief Submit the sends and receives queued on the ring since the
+     *         last call, in one system call
+     */
+    void flush();
+#endif
+
   private:
+#ifdef PLDM_TRANSPORT_WITH_AF_MCTP_SOCKETS
+    /** @brief Socket to send a request from, opened on the first request to
+     *         the terminus
+     *
+     * @param[in] tid - The terminus ID of the message destination
+     *
+     * @return The file descriptor, -1 on failure.
+     */
+    int getRequesterSocket(pldm_tid_t tid);
+
+    /** @brief Receive one message from a socket with a buffer of its size
+     *
+     * @param[in] fd - The socket
+     * @param[out] tid - The terminus ID of the message source
+     * @param[out] rx - The received message, to be freed by the caller
+     * @param[out] len - The length of the message
+     *
+     * @return PLDM_REQUESTER_SUCCESS on success, otherwise an appropriate
+     *         PLDM_REQUESTER_* error code.
+     */
+    pldm_requester_rc_t recvSocketMsg(int fd, pldm_tid_t& tid, void*& rx,
+                                      size_t& len);
+
+    /** @brief Note the tag of a received request for its response
+     *
+     * @param[in] tid - The terminus ID of the message source
+     * @param[in] tag - The MCTP tag of the message
+     */
+    void rxTag(pldm_tid_t tid, uint8_t tag);
+
+    /** @brief Socket bound to the PLDM message type, receives the requests
+     *         of the termini and sends the responses to them
+     */
+    int listenSocket = -1;
+
+    /** @brief Epoll set of all the sockets, the single event source of the
+     *         users which do not poll the sockets separately
+     */
+    int epollFd = -1;
+
+    /** @brief The sockets sending the requests and receiving the responses of
+     *         each terminus
+     */
+    std::map<pldm_tid_t, int> requesterSockets;
+
+    /** @brief MCTP tag of the last request of each terminus, the response has
+     *         to be sent with it
+     */
+    std::map<pldm_tid_t, uint8_t> requestTags;
+
+    /** @brief Handler of the sockets opened later */
+    SocketHandler socketAdded;
+
+    /** @brief Receive buffers of recvMsgs(), allocated on the first call */
+    std::unique_ptr<uint8_t[]> rxBuffers;
+
+#ifdef PLDM_TRANSPORT_WITH_IO_URING
+    /** @brief Queue the multishot receive of a socket on the ring
+     *
+     * @param[in] fd - The socket
+     */
+    void armRecv(int fd);
+
+    /** @brief Receive the messages completed on the ring
+     *
+     * @param[in] maxMsgs - The max number of messages received
+     * @param[in] handler - Called for each received message
+     *
+     * @return PLDM_REQUESTER_SUCCESS unless a receive of the ring failed
+     */
+    pldm_requester_rc_t recvRingMsgs(size_t maxMsgs,
+                                     const RxHandler& handler);
+
+    /** @brief io_uring of the sockets, set by enableRing() */
+    struct Ring;
+    std::unique_ptr<Ring> ring;
+#endif
+#endif
+
     /** @brief A pollfd object for holding a file descriptor from the libpldm
      *         transport implementation
      */
@@ -95,6 +95,12 @@ using ComponentImageInfo =
                CompSize, CompVersion>;
 using ComponentImageInfos = std::vector<ComponentImageInfo>;
 
+// Active component versions of the FD from GetFirmwareParameters
+using ActiveCompVersion = std::tuple<CompComparisonStamp, CompVersion>;
+using ActiveComponentVersions = std::map<CompKey, ActiveCompVersion>;
+using ActiveComponentVersionMap =
+    std::unordered_map<eid, ActiveComponentVersions>;
+
 enum class ComponentImageInfoPos : size_t
 {
     CompClassificationPos = 0,
@@ -1,20 +1,33 @@
 #include "utils.hpp"
 
+#include "log_sink.hpp"
+
 #include <libpldm/pdr.h>
 #include <libpldm/pldm_types.h>
 
+#if defined(__aarch64__) || defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#include <endian.h>
+#endif
+#if defined(__aarch64__) && !defined(__ARM_FEATURE_CRC32)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+
 #include <phosphor-logging/lg2.hpp>
 #include <xyz/openbmc_project/Common/error.hpp>
 
 #include <algorithm>
 #include <array>
 #include <cctype>
+#include <cstring>
 #include <ctime>
 #include <fstream>
 #include <iostream>
 #include <map>
 #include <stdexcept>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 PHOSPHOR_LOG2_USING;
@@ -26,61 +39,28 @@ namespace utils
 constexpr auto mapperBusName = "xyz.openbmc_project.ObjectMapper";
 constexpr auto mapperPath = "/xyz/openbmc_project/object_mapper";
 constexpr auto mapperInterface = "xyz.openbmc_project.ObjectMapper";
-constexpr auto faultLogBusName = "xyz.openbmc_project.Dump.Manager";
-constexpr auto faultLogPath = "/xyz/openbmc_project/dump/faultlog";
-constexpr auto faultLogIntf = "xyz.openbmc_project.Dump.Create";
-constexpr auto logBusName = "xyz.openbmc_project.Logging.IPMI";
-constexpr auto logPath = "/xyz/openbmc_project/Logging/IPMI";
-constexpr auto logIntf = "xyz.openbmc_project.Logging.IPMI";
 static time_t prevTs = 0;
 static int indexId = 0;
 
-Entities getParentEntites(const EntityAssociations& entityAssoc)
+namespace
 {
-    Entities parents{};
-    for (const auto& et : entityAssoc)
-    {
-        parents.push_back(et[0]);
-    }
-
-    bool found = false;
-    for (auto it = parents.begin(); it != parents.end();
-         it = found ? parents.erase(it) : std::next(it))
-    {
-        uint16_t parent_contained_id =
-            pldm_entity_node_get_remote_container_id(*it);
-        found = false;
-        for (const auto& evs : entityAssoc)
-        {
-            for (size_t i = 1; i < evs.size() && !found; i++)
-            {
-                uint16_t node_contained_id =
-                    pldm_entity_node_get_remote_container_id(evs[i]);
-
-                pldm_entity parent_entity = pldm_entity_extract(*it);
-                pldm_entity node_entity = pldm_entity_extract(evs[i]);
-
-                if (node_entity.entity_type == parent_entity.entity_type &&
-                    node_entity.entity_instance_num ==
-                        parent_entity.entity_instance_num &&
-                    node_contained_id == parent_contained_id)
-                {
-                    found = true;
-                }
-            }
-            if (found)
-            {
-                break;
-            }
-        }
-    }
-
-    return parents;
+/** @brief Key of an entity node, its type, instance number and remote
+ *         container ID packed
+ */
+uint64_t entityNodeKey(pldm_entity_node* node)
+{
+    pldm_entity entity = pldm_entity_extract(node);
+    return (static_cast<uint64_t>(entity.entity_type) << 32) |
+           (static_cast<uint64_t>(entity.entity_instance_num) << 16) |
+           pldm_entity_node_get_remote_container_id(node);
 }
 
-void addObjectPathEntityAssociations(const EntityAssociations& entityAssoc,
+/** @brief Entity associations, by the entityNodeKey() of their container */
+using AssociationIndex = std::unordered_multimap<uint64_t, const Entities*>;
+
+void addObjectPathEntityAssociations(const AssociationIndex& index,
                                      pldm_entity_node* entity,
-                                     const fs::path& path,
+                                     const std::string& path,
                                      ObjectPathMaps& objPathMap)
 {
     if (entity == nullptr)
@@ -88,9 +68,9 @@ void addObjectPathEntityAssociations(const EntityAssociations& entityAssoc,
         return;
     }
 
-    bool found = false;
     pldm_entity node_entity = pldm_entity_extract(entity);
-    if (!entityMaps.contains(node_entity.entity_type))
+    auto name = entityMaps.find(node_entity.entity_type);
+    if (name == entityMaps.end())
     {
         lg2::info(
             "{ENTITY_TYPE} Entity fetched from remote PLDM terminal does not exist.",
@@ -98,83 +78,93 @@ void addObjectPathEntityAssociations(const EntityAssociations& entityAssoc,
         return;
     }
 
-    std::string entityName = entityMaps.at(node_entity.entity_type);
-    for (const auto& ev : entityAssoc)
+    /* The path of the entity is built once, its children extend it */
+    std::string entity_path = path + "/" + name->second +
+                              std::to_string(node_entity.entity_instance_num);
+    auto [first, last] = index.equal_range(entityNodeKey(entity));
+    if (first == last)
     {
-        pldm_entity ev_entity = pldm_entity_extract(ev[0]);
-        if (ev_entity.entity_instance_num == node_entity.entity_instance_num &&
-            ev_entity.entity_type == node_entity.entity_type)
+        try
         {
-            uint16_t node_contained_id =
-                pldm_entity_node_get_remote_container_id(ev[0]);
-            uint16_t entity_contained_id =
-                pldm_entity_node_get_remote_container_id(entity);
+            pldm::utils::DBusHandler().getService(entity_path.c_str(),
+                                                  nullptr);
+        }
+        catch (const std::exception& e)
+        {
+            objPathMap[entity_path] = entity;
+        }
+        return;
+    }
 
-            if (node_contained_id != entity_contained_id)
+    for (auto it = first; it != last; ++it)
+    {
+        // If the entity obtained from the remote PLDM terminal is not in
+        // the MAP, or there is no auxiliary name PDR, add it directly.
+        // Otherwise, check whether the DBus service of entity_path exists,
+        // and overwrite the entity if it does not exist.
+        auto [mapped, added] = objPathMap.try_emplace(entity_path, entity);
+        if (!added)
+        {
+            try
             {
-                continue;
+                pldm::utils::DBusHandler().getService(entity_path.c_str(),
+                                                      nullptr);
             }
-
-            fs::path p = path / fs::path{entityName +
-                                         std::to_string(
-                                             node_entity.entity_instance_num)};
-            std::string entity_path = p.string();
-            // If the entity obtained from the remote PLDM terminal is not in
-            // the MAP, or there is no auxiliary name PDR, add it directly.
-            // Otherwise, check whether the DBus service of entity_path exists,
-            // and overwrite the entity if it does not exist.
-            if (!objPathMap.contains(entity_path))
+            catch (const std::exception& e)
             {
-                objPathMap[entity_path] = entity;
-            }
-            else
-            {
-                try
-                {
-                    pldm::utils::DBusHandler().getService(entity_path.c_str(),
-                                                          nullptr);
-                }
-                catch (const std::exception& e)
-                {
-                    objPathMap[entity_path] = entity;
-                }
+                mapped->second = entity;
             }
+        }
 
-            for (size_t i = 1; i < ev.size(); i++)
-            {
-                addObjectPathEntityAssociations(entityAssoc, ev[i], p,
-                                                objPathMap);
-            }
-            found = true;
+        const auto& ev = *it->second;
+        for (size_t i = 1; i < ev.size(); i++)
+        {
+            addObjectPathEntityAssociations(index, ev[i], entity_path,
+                                            objPathMap);
         }
     }
+}
+} // namespace
 
-    if (!found)
+Entities getParentEntites(const EntityAssociations& entityAssoc)
+{
+    /* The containers which are not contained in another association */
+    std::unordered_set<uint64_t> children;
+    for (const auto& evs : entityAssoc)
     {
-        std::string dbusPath =
-            path / fs::path{entityName +
-                            std::to_string(node_entity.entity_instance_num)};
-
-        try
+        for (size_t i = 1; i < evs.size(); i++)
         {
-            pldm::utils::DBusHandler().getService(dbusPath.c_str(), nullptr);
+            children.insert(entityNodeKey(evs[i]));
         }
-        catch (const std::exception& e)
+    }
+
+    Entities parents{};
+    for (const auto& et : entityAssoc)
+    {
+        if (!children.contains(entityNodeKey(et[0])))
         {
-            objPathMap[dbusPath] = entity;
+            parents.push_back(et[0]);
         }
     }
+    return parents;
 }
 
 void updateEntityAssociation(const EntityAssociations& entityAssoc,
                              pldm_entity_association_tree* entityTree,
                              ObjectPathMaps& objPathMap)
 {
+    AssociationIndex index;
+    index.reserve(entityAssoc.size());
+    for (const auto& ev : entityAssoc)
+    {
+        index.emplace(entityNodeKey(ev[0]), &ev);
+    }
+
     std::vector<pldm_entity_node*> parentsEntity =
         getParentEntites(entityAssoc);
     for (const auto& entity : parentsEntity)
     {
-        fs::path path{"/xyz/openbmc_project/inventory"};
+        std::string path{"/xyz/openbmc_project/inventory"};
         std::deque<std::string> paths{};
         pldm_entity node_entity = pldm_entity_extract(entity);
         auto node = pldm_entity_association_tree_find_with_locality(
@@ -219,11 +209,11 @@ void updateEntityAssociation(const EntityAssociations& entityAssoc,
 
         while (!paths.empty())
         {
-            path = path / fs::path{paths.back()};
+            path += "/" + paths.back();
             paths.pop_back();
         }
 
-        addObjectPathEntityAssociations(entityAssoc, entity, path, objPathMap);
+        addObjectPathEntityAssociations(index, entity, path, objPathMap);
     }
 }
 
@@ -337,28 +327,36 @@ std::vector<std::vector<uint8_t>> findStateSensorPDR(uint8_t /*tid*/,
 
 uint8_t readHostEID()
 {
-    uint8_t eid{};
+    auto eids = readHostEIDs();
+    return eids.empty() ? 0 : eids.front();
+}
+
+std::vector<uint8_t> readHostEIDs()
+{
+    std::vector<uint8_t> eids;
     std::ifstream eidFile{HOST_EID_PATH};
     if (!eidFile.good())
     {
         error("Could not open host EID file: {HOST_PATH}", "HOST_PATH",
               static_cast<std::string>(HOST_EID_PATH));
+        return eids;
     }
-    else
+
+    std::string eidStr;
+    while (eidFile >> eidStr)
     {
-        std::string eidStr;
-        eidFile >> eidStr;
-        if (!eidStr.empty())
+        uint8_t eid = atoi(eidStr.c_str());
+        if (eid && std::find(eids.begin(), eids.end(), eid) == eids.end())
         {
-            eid = atoi(eidStr.c_str());
-        }
-        else
-        {
-            error("Host EID file was empty");
+            eids.emplace_back(eid);
         }
     }
+    if (eids.empty())
+    {
+        error("Host EID file was empty");
+    }
 
-    return eid;
+    return eids;
 }
 
 uint8_t getNumPadBytes(uint32_t data)
@@ -415,6 +413,417 @@ std::optional<std::vector<set_effecter_state_field>>
     return std::make_optional(std::move(stateField));
 }
 
+ServiceCache& ServiceCache::get()
+{
+    static ServiceCache cache;
+    return cache;
+}
+
+void ServiceCache::enable(sdbusplus::bus_t& bus)
+{
+    if (enabled())
+    {
+        return;
+    }
+    using namespace sdbusplus::bus::match::rules;
+    auto objectChanged = [this](sdbusplus::message_t& msg) {
+        sdbusplus::message::object_path path;
+        msg.read(path);
+        erasePath(path.str);
+    };
+    matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+        bus, interfacesAdded(), objectChanged));
+    matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+        bus, interfacesRemoved(), objectChanged));
+    matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+        bus, nameOwnerChanged(), [this](sdbusplus::message_t& msg) {
+        std::string name;
+        std::string oldOwner;
+        std::string newOwner;
+        msg.read(name, oldOwner, newOwner);
+        eraseService(name);
+        if (!oldOwner.empty())
+        {
+            eraseService(oldOwner);
+        }
+    }));
+}
+
+std::optional<std::string>
+    ServiceCache::find(const std::string& path,
+                       const std::string& interface) const
+{
+    auto it = services.find(path);
+    if (it == services.end())
+    {
+        return std::nullopt;
+    }
+    auto service = it->second.find(interface);
+    if (service == it->second.end())
+    {
+        return std::nullopt;
+    }
+    return service->second;
+}
+
+void ServiceCache::insert(const std::string& path,
+                          const std::string& interface,
+                          const std::string& service)
+{
+    services[path].insert_or_assign(interface, service);
+}
+
+void ServiceCache::insertSubtree(const GetSubTreeResponse& subtree)
+{
+    for (const auto& [path, serviceMap] : subtree)
+    {
+        auto& interfaces = services[path];
+        for (const auto& [service, serviceInterfaces] : serviceMap)
+        {
+            for (const auto& interface : serviceInterfaces)
+            {
+                interfaces.try_emplace(interface, service);
+            }
+        }
+    }
+}
+
+void ServiceCache::erasePath(const std::string& path)
+{
+    services.erase(path);
+}
+
+void ServiceCache::eraseService(const std::string& service)
+{
+    for (auto it = services.begin(); it != services.end();)
+    {
+        std::erase_if(it->second, [&service](const auto& entry) {
+            return entry.second == service;
+        });
+        it = it->second.empty() ? services.erase(it) : std::next(it);
+    }
+}
+
+void AsyncCalls::call(sdbusplus::bus_t& bus, sdbusplus::message_t& method,
+                      Callback&& callback)
+{
+    for (auto id : finished)
+    {
+        calls.erase(id);
+    }
+    finished.clear();
+
+    auto id = nextCallId++;
+    auto onReply = [this, id,
+                    callback = std::move(callback)](auto&& reply) {
+        finished.push_back(id);
+        callback(reply);
+    };
+    calls.emplace(id, bus.call_async(method, std::move(onReply), dbusTimeout));
+}
+
+std::array<std::vector<Request>, RequestPool::sizeClasses.size()>&
+    RequestPool::freeLists()
+{
+    thread_local std::array<std::vector<Request>, sizeClasses.size()> lists;
+    return lists;
+}
+
+Request RequestPool::acquire(size_t size)
+{
+    for (size_t i = 0; i < sizeClasses.size(); i++)
+    {
+        if (size > sizeClasses[i])
+        {
+            continue;
+        }
+        auto& list = freeLists()[i];
+        Request buffer;
+        if (!list.empty())
+        {
+            buffer = std::move(list.back());
+            list.pop_back();
+        }
+        else
+        {
+            buffer.reserve(sizeClasses[i]);
+        }
+        buffer.assign(size, 0);
+        return buffer;
+    }
+    return Request(size);
+}
+
+void RequestPool::release(Request&& buffer)
+{
+    auto capacity = buffer.capacity();
+    if (capacity > 2 * sizeClasses.back())
+    {
+        return;
+    }
+    /* The largest class the buffer can hold */
+    for (size_t i = sizeClasses.size(); i-- > 0;)
+    {
+        if (capacity < sizeClasses[i])
+        {
+            continue;
+        }
+        auto& list = freeLists()[i];
+        if (list.size() < maxFreeBuffers)
+        {
+            buffer.clear();
+            list.emplace_back(std::move(buffer));
+        }
+        return;
+    }
+}
+
+JsonCache& JsonCache::get()
+{
+    static JsonCache cache;
+    return cache;
+}
+
+std::optional<JsonCache::Entry>
+    JsonCache::parse(const std::filesystem::path& path)
+{
+    std::error_code ec;
+    auto mtime = std::filesystem::last_write_time(path, ec);
+    if (ec)
+    {
+        return std::nullopt;
+    }
+    auto size = std::filesystem::file_size(path, ec);
+    if (ec)
+    {
+        return std::nullopt;
+    }
+
+    // Parsing from a contiguous buffer is much faster than from the stream
+    std::ifstream jsonFile(path, std::ios::binary);
+    std::string content(size, '\0');
+    if (!jsonFile.read(content.data(), content.size()))
+    {
+        return std::nullopt;
+    }
+    return Entry{mtime, size, Json::parse(content, nullptr, false)};
+}
+
+const Json& JsonCache::load(const std::filesystem::path& path)
+{
+    static const Json discarded(Json::value_t::discarded);
+
+    std::error_code ec;
+    auto mtime = std::filesystem::last_write_time(path, ec);
+    if (ec)
+    {
+        return discarded;
+    }
+    auto size = std::filesystem::file_size(path, ec);
+    if (ec)
+    {
+        return discarded;
+    }
+
+    auto it = files.find(path.string());
+    if (it != files.end() && it->second.mtime == mtime &&
+        it->second.size == size)
+    {
+        return it->second.json;
+    }
+
+    auto entry = parse(path);
+    if (!entry)
+    {
+        return discarded;
+    }
+    auto& cached = files[path.string()];
+    cached = std::move(*entry);
+    return cached.json;
+}
+
+std::string PropertiesChangedDispatcher::commonNamespace(const std::string& ns,
+                                                     const std::string& path)
+{
+    size_t common = 0;
+    size_t i = 0;
+    for (; i < ns.size() && i < path.size() && ns[i] == path[i]; i++)
+    {
+        if (ns[i] == '/')
+        {
+            common = i;
+        }
+    }
+    /* A whole element matched when both end or reach a separator */
+    if ((i == ns.size() || ns[i] == '/') && (i == path.size() || path[i] == '/'))
+    {
+        common = i;
+    }
+    return common ? ns.substr(0, common) : "/";
+}
+
+void PropertiesChangedDispatcher::watch(sdbusplus::bus_t& bus,
+                                        const std::string& path,
+                                        const std::string& interface,
+                                        Callback&& callback)
+{
+    auto [it, added] = interfaces.try_emplace(interface);
+    auto& watched = it->second;
+    watched.callbacks[path].emplace_back(std::move(callback));
+
+    auto pathNamespace =
+        added ? path : commonNamespace(watched.pathNamespace, path);
+    if (watched.match && pathNamespace == watched.pathNamespace)
+    {
+        return;
+    }
+    watched.pathNamespace = std::move(pathNamespace);
+    subscribe(bus, interface, watched);
+}
+
+void PropertiesChangedDispatcher::subscribe(sdbusplus::bus_t& bus,
+                                            const std::string& interface,
+                                            Interface& watched)
+{
+    namespace rules = sdbusplus::bus::match::rules;
+    auto rule = rules::type::signal() + rules::member("PropertiesChanged") +
+                rules::interface(dbusProperties) + rules::argN(0, interface);
+    if (watched.pathNamespace != "/")
+    {
+        rule += rules::path_namespace(watched.pathNamespace);
+    }
+    /* The wider match is added before the old one goes, so no signal is
+     * missed in between */
+    watched.match = std::make_unique<sdbusplus::bus::match_t>(
+        bus, rule, [this, &watched](sdbusplus::message_t& msg) {
+        dispatch(watched, msg);
+    });
+}
+
+void PropertiesChangedDispatcher::dispatch(const Interface& watched,
+                                           sdbusplus::message_t& msg)
+{
+    auto it = watched.callbacks.find(msg.get_path());
+    if (it == watched.callbacks.end())
+    {
+        return;
+    }
+
+    std::string interface;
+    DbusChangedProps properties;
+    std::vector<std::string> invalidated;
+    bool decoded = true;
+    try
+    {
+        msg.read(interface, properties, invalidated);
+    }
+    catch (const std::exception& e)
+    {
+        decoded = false;
+    }
+    for (const auto& callback : it->second)
+    {
+        callback(decoded ? &properties : nullptr, invalidated);
+    }
+}
+
+PropertyCache& PropertyCache::get()
+{
+    static PropertyCache cache;
+    return cache;
+}
+
+void PropertyCache::enable(sdbusplus::bus_t& bus)
+{
+    if (enabled())
+    {
+        return;
+    }
+    this->bus = &bus;
+    using namespace sdbusplus::bus::match::rules;
+    auto objectChanged = [this](sdbusplus::message_t& msg) {
+        sdbusplus::message::object_path path;
+        msg.read(path);
+        erasePath(path.str);
+    };
+    matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+        bus, interfacesAdded(), objectChanged));
+    matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+        bus, interfacesRemoved(), objectChanged));
+}
+
+void PropertyCache::watch(const DBusMapping& dbusMapping)
+{
+    auto [it, added] = objects.try_emplace(
+        {dbusMapping.objectPath, dbusMapping.interface});
+    if (!added || !bus)
+    {
+        return;
+    }
+    dispatcher.watch(
+        *bus, dbusMapping.objectPath, dbusMapping.interface,
+        [this, path = dbusMapping.objectPath,
+         interface = dbusMapping.interface](
+            const DbusChangedProps* properties,
+            const std::vector<std::string>& invalidated) {
+        if (!properties)
+        {
+            /* A property of a type no mapping uses, read them again */
+            erasePath(path);
+            return;
+        }
+        update(path, interface, *properties);
+        auto it = objects.find({path, interface});
+        if (it != objects.end())
+        {
+            for (const auto& property : invalidated)
+            {
+                it->second.values.erase(property);
+            }
+        }
+    });
+}
+
+std::optional<PropertyValue>
+    PropertyCache::find(const DBusMapping& dbusMapping) const
+{
+    auto it = objects.find({dbusMapping.objectPath, dbusMapping.interface});
+    if (it == objects.end())
+    {
+        return std::nullopt;
+    }
+    auto value = it->second.values.find(dbusMapping.propertyName);
+    if (value == it->second.values.end())
+    {
+        return std::nullopt;
+    }
+    return value->second;
+}
+
+void PropertyCache::update(const std::string& path,
+                           const std::string& interface,
+                           const DbusChangedProps& properties)
+{
+    auto it = objects.find({path, interface});
+    if (it == objects.end())
+    {
+        return;
+    }
+    for (const auto& [property, value] : properties)
+    {
+        it->second.values.insert_or_assign(property, value);
+    }
+}
+
+void PropertyCache::erasePath(const std::string& path)
+{
+    for (auto it = objects.lower_bound({path, ""});
+         it != objects.end() && it->first.first == path; ++it)
+    {
+        it->second.values.clear();
+    }
+}
+
 std::string DBusHandler::getService(const char* path,
                                     const char* interface) const
 {
@@ -422,6 +831,16 @@ std::string DBusHandler::getService(const char* path,
     std::map<std::string, std::vector<std::string>> mapperResponse;
     auto& bus = DBusHandler::getBus();
 
+    auto& cache = ServiceCache::get();
+    if (cache.enabled())
+    {
+        auto service = cache.find(path, interface ? interface : "");
+        if (service)
+        {
+            return *service;
+        }
+    }
+
     auto mapper = bus.new_method_call(mapperBusName, mapperPath,
                                       mapperInterface, "GetObject");
 
@@ -436,6 +855,11 @@ std::string DBusHandler::getService(const char* path,
 
     auto mapperResponseMsg = bus.call(mapper, dbusTimeout);
     mapperResponseMsg.read(mapperResponse);
+    if (cache.enabled())
+    {
+        cache.insert(path, interface ? interface : "",
+                     mapperResponse.begin()->first);
+    }
     return mapperResponse.begin()->first;
 }
 
@@ -484,6 +908,14 @@ void reportError(const char* errorMsg)
 
 void DBusHandler::setDbusProperty(const DBusMapping& dBusMap,
                                   const PropertyValue& value) const
+{
+    auto method = newSetPropertyCall(dBusMap, value);
+    getBus().call_noreply(method, dbusTimeout);
+}
+
+sdbusplus::message_t
+    DBusHandler::newSetPropertyCall(const DBusMapping& dBusMap,
+                                    const PropertyValue& value) const
 {
     auto setDbusValue = [&dBusMap, this](const auto& variant) {
         auto& bus = getBus();
@@ -493,58 +925,58 @@ void DBusHandler::setDbusProperty(const DBusMapping& dBusMap,
             service.c_str(), dBusMap.objectPath.c_str(), dbusProperties, "Set");
         method.append(dBusMap.interface.c_str(), dBusMap.propertyName.c_str(),
                       variant);
-        bus.call_noreply(method, dbusTimeout);
+        return method;
     };
 
     if (dBusMap.propertyType == "uint8_t")
     {
         std::variant<uint8_t> v = std::get<uint8_t>(value);
-        setDbusValue(v);
+        return setDbusValue(v);
     }
     else if (dBusMap.propertyType == "bool")
     {
         std::variant<bool> v = std::get<bool>(value);
-        setDbusValue(v);
+        return setDbusValue(v);
     }
     else if (dBusMap.propertyType == "int16_t")
     {
         std::variant<int16_t> v = std::get<int16_t>(value);
-        setDbusValue(v);
+        return setDbusValue(v);
     }
     else if (dBusMap.propertyType == "uint16_t")
     {
         std::variant<uint16_t> v = std::get<uint16_t>(value);
-        setDbusValue(v);
+        return setDbusValue(v);
     }
     else if (dBusMap.propertyType == "int32_t")
     {
         std::variant<int32_t> v = std::get<int32_t>(value);
-        setDbusValue(v);
+        return setDbusValue(v);
     }
     else if (dBusMap.propertyType == "uint32_t")
     {
         std::variant<uint32_t> v = std::get<uint32_t>(value);
-        setDbusValue(v);
+        return setDbusValue(v);
     }
     else if (dBusMap.propertyType == "int64_t")
     {
         std::variant<int64_t> v = std::get<int64_t>(value);
-        setDbusValue(v);
+        return setDbusValue(v);
     }
     else if (dBusMap.propertyType == "uint64_t")
     {
         std::variant<uint64_t> v = std::get<uint64_t>(value);
-        setDbusValue(v);
+        return setDbusValue(v);
     }
     else if (dBusMap.propertyType == "double")
     {
         std::variant<double> v = std::get<double>(value);
-        setDbusValue(v);
+        return setDbusValue(v);
     }
     else if (dBusMap.propertyType == "string")
     {
         std::variant<std::string> v = std::get<std::string>(value);
-        setDbusValue(v);
+        return setDbusValue(v);
     }
     else
     {
@@ -715,7 +1147,116 @@ uint16_t findStateSensorId(const pldm_pdr* pdrRepo, uint8_t tid,
     return PLDM_INVALID_EFFECTER_ID;
 }
 
-void printBuffer(bool isTx, const std::vector<uint8_t>& buffer)
+/** @brief Slicing-by-8 CRC-32 of the reflected IEEE polynomial, the
+ *  pre and post inversions are left to the caller
+ */
+static uint32_t crc32Sliced(uint32_t crc, const uint8_t* p, size_t size)
+{
+    /* tables[k][i] is the CRC of byte i followed by k zero bytes, so eight
+     * bytes are folded per step with independent lookups */
+    static constexpr auto tables = [] {
+        std::array<std::array<uint32_t, 256>, 8> tables{};
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; bit++)
+            {
+                crc = (crc & 1) ? (crc >> 1) ^ 0xedb88320 : crc >> 1;
+            }
+            tables[0][i] = crc;
+        }
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            for (size_t k = 1; k < tables.size(); k++)
+            {
+                auto prev = tables[k - 1][i];
+                tables[k][i] = (prev >> 8) ^ tables[0][prev & 0xff];
+            }
+        }
+        return tables;
+    }();
+
+    while (size >= 8)
+    {
+        uint32_t lo = crc ^ (uint32_t(p[0]) | (uint32_t(p[1]) << 8) |
+                             (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24));
+        uint32_t hi = uint32_t(p[4]) | (uint32_t(p[5]) << 8) |
+                      (uint32_t(p[6]) << 16) | (uint32_t(p[7]) << 24);
+        crc = tables[7][lo & 0xff] ^ tables[6][(lo >> 8) & 0xff] ^
+              tables[5][(lo >> 16) & 0xff] ^ tables[4][lo >> 24] ^
+              tables[3][hi & 0xff] ^ tables[2][(hi >> 8) & 0xff] ^
+              tables[1][(hi >> 16) & 0xff] ^ tables[0][hi >> 24];
+        p += 8;
+        size -= 8;
+    }
+    while (size--)
+    {
+        crc = tables[0][(crc ^ *p++) & 0xff] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+#if defined(__aarch64__) || defined(__ARM_FEATURE_CRC32)
+/** @brief CRC-32 with the ARMv8 CRC32 instructions, of the same polynomial.
+ *  On AArch64 the function is built for the CRC extension whatever the
+ *  target, it is only called when the CPU reports the extension.
+ */
+#ifdef __aarch64__
+__attribute__((target("+crc")))
+#endif
+static uint32_t crc32Arm(uint32_t crc, const uint8_t* p, size_t size)
+{
+    for (; size && reinterpret_cast<uintptr_t>(p) % 8; size--)
+    {
+        crc = __crc32b(crc, *p++);
+    }
+#ifdef __aarch64__
+    for (; size >= 8; size -= 8, p += 8)
+    {
+        uint64_t word;
+        std::memcpy(&word, p, sizeof(word));
+        crc = __crc32d(crc, le64toh(word));
+    }
+#else
+    for (; size >= 4; size -= 4, p += 4)
+    {
+        uint32_t word;
+        std::memcpy(&word, p, sizeof(word));
+        crc = __crc32w(crc, le32toh(word));
+    }
+#endif
+    while (size--)
+    {
+        crc = __crc32b(crc, *p++);
+    }
+    return crc;
+}
+
+/** @brief Whether the CRC32 instructions can be used */
+static bool hasArmCrc32()
+{
+#ifdef __ARM_FEATURE_CRC32
+    return true;
+#else
+    static const bool has = getauxval(AT_HWCAP) & HWCAP_CRC32;
+    return has;
+#endif
+}
+#endif
+
+void Crc32::update(std::span<const uint8_t> data)
+{
+#if defined(__aarch64__) || defined(__ARM_FEATURE_CRC32)
+    if (hasArmCrc32())
+    {
+        crc = crc32Arm(crc, data.data(), data.size());
+        return;
+    }
+#endif
+    crc = crc32Sliced(crc, data.data(), data.size());
+}
+
+void printBuffer(bool isTx, std::span<const uint8_t> buffer)
 {
     if (!buffer.empty())
     {
@@ -847,52 +1388,13 @@ std::string getUniqueEntryID(std::string &prefix)
 
 void addFaultLogToRedfish(std::string &primaryLogId, std::string &type)
 {
-    auto& bus = pldm::utils::DBusHandler::getBus();
-    std::map<std::string, std::variant<std::string, uint64_t>> params;
-
-    params["Type"] = type;
-    params["PrimaryLogId"] = primaryLogId;
-    try
-    {
-        auto method = bus.new_method_call(faultLogBusName,
-                                          faultLogPath,
-                                          faultLogIntf,
-                                          "CreateDump");
-        method.append(params);
-
-        auto response = bus.call(method);
-        if (response.is_method_error())
-        {
-            std::cerr << "createDump error\n";
-        }
-    }
-    catch (const std::exception& e)
-    {
-        std::cerr << "call createDump error: " << e.what() << "\n" ;
-    }
-
+    postLogRecord(FaultLogRecord{primaryLogId, type});
 }
 
 void addOEMSelLog(std::string &msg, std::vector<uint8_t> &evtData,
                   uint8_t recordType)
 {
-    auto& bus = pldm::utils::DBusHandler::getBus();
-    try
-    {
-        auto method = bus.new_method_call(logBusName, logPath,
-                                          logIntf, "IpmiSelAddOem");
-        method.append(msg, evtData , recordType);
-
-        auto selReply = bus.call(method);
-        if (selReply.is_method_error())
-        {
-            std::cerr << "add SEL log error\n";
-        }
-    }
-    catch (const std::exception& e)
-    {
-        std::cerr << "call SEL log error: " << e.what() << "\n" ;
-    }
+    postLogRecord(SelRecord{msg, evtData, recordType});
 }
 
 } // namespace utils
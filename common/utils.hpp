@@ -16,12 +16,18 @@
 #include <sdbusplus/server.hpp>
 #include <xyz/openbmc_project/Logging/Entry/server.hpp>
 
+#include <array>
 #include <deque>
 #include <exception>
 #include <filesystem>
+#include <functional>
 #include <iostream>
 #include <map>
+#include <memory>
+#include <optional>
+#include <span>
 #include <string>
+#include <unordered_map>
 #include <variant>
 #include <vector>
 
@@ -44,7 +50,7 @@ using EntityType = uint16_t;
 
 using Entities = std::vector<pldm_entity_node*>;
 using EntityAssociations = std::vector<Entities>;
-using ObjectPathMaps = std::map<fs::path, pldm_entity_node*>;
+using ObjectPathMaps = std::unordered_map<std::string, pldm_entity_node*>;
 
 const std::map<EntityType, EntityName> entityMaps = {
     {PLDM_ENTITY_SYSTEM_CHASSIS, "chassis"},
@@ -215,6 +221,372 @@ class DBusHandlerInterface
                                const char* dbusInterface) const = 0;
 };
 
+/** @class ServiceCache
+ *
+ *  Process wide cache of the services the mapper returned for an object path
+ *  and interface. The cache is used once enabled, from then on the entries of
+ *  an object path are dropped on its InterfacesAdded and InterfacesRemoved
+ *  signals, and the entries of a service when its bus name changes owner.
+ */
+class ServiceCache
+{
+  public:
+    /** @brief Get the cache of the process */
+    static ServiceCache& get();
+
+    /** @brief Subscribe for the signals invalidating the entries and start
+     *         using the cache
+     *
+     *  @param[in] bus - bus connection processed by the event loop
+     */
+    void enable(sdbusplus::bus_t& bus);
+
+    /** @brief Whether the cache is used */
+    bool enabled() const
+    {
+        return !matches.empty();
+    }
+
+    /** @brief Find the service of an object path and interface
+     *
+     *  @param[in] path - D-Bus object path
+     *  @param[in] interface - D-Bus interface, empty for any
+     *
+     *  @return the service name if cached
+     */
+    std::optional<std::string> find(const std::string& path,
+                                    const std::string& interface) const;
+
+    /** @brief Add the service of an object path and interface */
+    void insert(const std::string& path, const std::string& interface,
+                const std::string& service);
+
+    /** @brief Add the services of a mapper subtree, the first service of an
+     *         object path implementing an interface is kept like GetObject
+     *         does
+     *
+     *  @param[in] subtree - GetSubTree response of the mapper
+     */
+    void insertSubtree(const GetSubTreeResponse& subtree);
+
+    /** @brief Drop the entries of an object path */
+    void erasePath(const std::string& path);
+
+    /** @brief Drop the entries of a service */
+    void eraseService(const std::string& service);
+
+  private:
+    /** @brief Services of each object path, by interface */
+    std::unordered_map<std::string, std::map<std::string, std::string>>
+        services;
+    std::vector<std::unique_ptr<sdbusplus::bus::match_t>> matches;
+};
+
+/** @class PropertiesChangedDispatcher
+ *
+ *  PropertiesChanged signals of many object paths through one match per
+ *  interface. The match covers the path namespace shared by the watched
+ *  objects of the interface and filters on the interface name, a signal is
+ *  then dispatched to the callbacks of its object path through a hash
+ *  lookup. dbus-broker checks each signal against one rule per interface
+ *  instead of one rule per object, and the signals of the other objects of
+ *  the namespace are dropped before they are decoded.
+ */
+class PropertiesChangedDispatcher
+{
+  public:
+    /** @brief Callback of a watched object
+     *
+     *  @param[in] properties - changed properties, nullptr when the signal
+     *                          has a property of a type PropertyValue does
+     *                          not hold
+     *  @param[in] invalidated - invalidated properties
+     */
+    using Callback = std::function<void(
+        const DbusChangedProps* properties,
+        const std::vector<std::string>& invalidated)>;
+
+    /** @brief Call a callback on the PropertiesChanged signals of an object
+     *         path and interface, the match of the interface is widened
+     *         when the path is out of its namespace
+     *
+     *  @param[in] bus - bus connection processed by the event loop
+     *  @param[in] path - D-Bus object path
+     *  @param[in] interface - D-Bus interface
+     *  @param[in] callback - called for each signal
+     */
+    void watch(sdbusplus::bus_t& bus, const std::string& path,
+               const std::string& interface, Callback&& callback);
+
+    /** @brief Number of the matches added to the bus */
+    size_t matches() const
+    {
+        return interfaces.size();
+    }
+
+    /** @brief Deepest path namespace holding two object paths
+     *
+     *  @param[in] ns - path namespace
+     *  @param[in] path - D-Bus object path
+     *
+     *  @return - "/" when they share no path element
+     */
+    static std::string commonNamespace(const std::string& ns,
+                                       const std::string& path);
+
+  private:
+    /** @brief Watched objects of an interface */
+    struct Interface
+    {
+        std::string pathNamespace;
+        std::unique_ptr<sdbusplus::bus::match_t> match;
+        std::unordered_map<std::string, std::vector<Callback>> callbacks;
+    };
+
+    /** @brief Add the match of an interface on its path namespace */
+    void subscribe(sdbusplus::bus_t& bus, const std::string& interface,
+                   Interface& watched);
+
+    /** @brief Call the callbacks of the object path of a signal */
+    void dispatch(const Interface& watched, sdbusplus::message_t& msg);
+
+    std::unordered_map<std::string, Interface> interfaces;
+};
+
+/** @class PropertyCache
+ *
+ *  Process wide cache of the D-Bus properties mapped to the PLDM sensors and
+ *  effecters of the BMC. The PropertiesChanged signals of the watched object
+ *  paths come through one PropertiesChangedDispatcher, a property is read
+ *  from D-Bus the first time it is requested and then follows the signals. The values of an object
+ *  path are dropped on its InterfacesAdded and InterfacesRemoved signals.
+ */
+class PropertyCache
+{
+  public:
+    /** @brief Get the cache of the process */
+    static PropertyCache& get();
+
+    /** @brief Start using the cache, the watched objects are subscribed for
+     *         on this bus
+     *
+     *  @param[in] bus - bus connection processed by the event loop
+     */
+    void enable(sdbusplus::bus_t& bus);
+
+    /** @brief Whether the cache is used */
+    bool enabled() const
+    {
+        return bus != nullptr;
+    }
+
+    /** @brief Cache the properties of the object and interface of a mapping
+     *
+     *  @param[in] dbusMapping - D-Bus mapping of a sensor or an effecter
+     */
+    void watch(const DBusMapping& dbusMapping);
+
+    /** @brief Find the cached value of the property of a mapping
+     *
+     *  @param[in] dbusMapping - D-Bus mapping of a sensor or an effecter
+     *
+     *  @return the value if cached
+     */
+    std::optional<PropertyValue> find(const DBusMapping& dbusMapping) const;
+
+    /** @brief Update the cached properties of a watched object and interface
+     *
+     *  @param[in] path - D-Bus object path
+     *  @param[in] interface - D-Bus interface
+     *  @param[in] properties - new property values
+     */
+    void update(const std::string& path, const std::string& interface,
+                const DbusChangedProps& properties);
+
+    /** @brief Drop the cached values of an object path */
+    void erasePath(const std::string& path);
+
+    /** @brief Get the property of a mapping, from the cache when the mapping
+     *         is watched
+     *
+     *  @tparam[in] DBusInterface - DBus interface type
+     *  @param[in] dBusIntf - reads the property on a cache miss
+     *  @param[in] dbusMapping - D-Bus mapping of a sensor or an effecter
+     *
+     *  @return the value of the property
+     *
+     *  @throw sdbusplus::exception_t when the D-Bus read fails
+     */
+    template <class DBusInterface>
+    PropertyValue getDbusPropertyVariant(const DBusInterface& dBusIntf,
+                                         const DBusMapping& dbusMapping)
+    {
+        auto it = objects.end();
+        if (enabled())
+        {
+            it = objects.find({dbusMapping.objectPath, dbusMapping.interface});
+        }
+        if (it == objects.end())
+        {
+            return dBusIntf.getDbusPropertyVariant(
+                dbusMapping.objectPath.c_str(),
+                dbusMapping.propertyName.c_str(),
+                dbusMapping.interface.c_str());
+        }
+        auto value = it->second.values.find(dbusMapping.propertyName);
+        if (value != it->second.values.end())
+        {
+            return value->second;
+        }
+        auto propertyValue = dBusIntf.getDbusPropertyVariant(
+            dbusMapping.objectPath.c_str(), dbusMapping.propertyName.c_str(),
+            dbusMapping.interface.c_str());
+        it->second.values.emplace(dbusMapping.propertyName, propertyValue);
+        return propertyValue;
+    }
+
+  private:
+    /** @brief Cached properties of an object path and interface */
+    struct Object
+    {
+        std::map<std::string, PropertyValue> values;
+    };
+
+    sdbusplus::bus_t* bus = nullptr;
+    std::map<std::pair<std::string, std::string>, Object> objects;
+    PropertiesChangedDispatcher dispatcher;
+    std::vector<std::unique_ptr<sdbusplus::bus::match_t>> matches;
+};
+
+/** @class AsyncCalls
+ *
+ *  D-Bus method calls made without blocking the event loop. The slot of a
+ *  call is kept until the reply, or the timeout, is handled and released on
+ *  the next call since it can't be destroyed from its own callback.
+ */
+class AsyncCalls
+{
+  public:
+    /** @brief Callback with the reply, or the error, of a call */
+    using Callback = std::function<void(sdbusplus::message_t& reply)>;
+
+    /** @brief Send a method call
+     *
+     *  @param[in] bus - bus connection processed by the event loop
+     *  @param[in] method - method call message
+     *  @param[in] callback - invoked once with the reply, check
+     *                        is_method_error() for an error or a timeout
+     *
+     *  @throw sdbusplus::exception_t when the call can't be sent
+     */
+    void call(sdbusplus::bus_t& bus, sdbusplus::message_t& method,
+              Callback&& callback);
+
+    /** @brief Number of the calls waiting for their reply */
+    size_t pending() const
+    {
+        return calls.size() - finished.size();
+    }
+
+  private:
+    std::map<uint64_t, sdbusplus::slot_t> calls;
+    std::vector<uint64_t> finished;
+    uint64_t nextCallId = 0;
+};
+
+/** @class RequestPool
+ *
+ *  Per thread free lists of request message buffers by size class, so the
+ *  requests sent in a loop reuse the buffers of the completed ones. The
+ *  buffers are plain pldm::Request vectors, which keep their capacity while
+ *  they are moved through the requester. The responses of pldmd come from
+ *  the same lists and are given back once they are sent.
+ */
+class RequestPool
+{
+  public:
+    /** @brief Get a zeroed request buffer
+     *
+     *  @param[in] size - size of the request message
+     *
+     *  @return the buffer, from the free list of its size class if any
+     */
+    static Request acquire(size_t size);
+
+    /** @brief Give back the buffer of a completed request
+     *
+     *  @param[in] buffer - request message, larger buffers than the size
+     *                      classes are freed
+     */
+    static void release(Request&& buffer);
+
+    /** @brief Largest message whose buffer comes from a free list */
+    static constexpr size_t maxPooledSize = 1024;
+
+  private:
+    /** @brief Capacity of the buffers of each size class */
+    static constexpr std::array<size_t, 3> sizeClasses{64, 256,
+                                                       maxPooledSize};
+    /** @brief Buffers kept in the free list of a size class */
+    static constexpr size_t maxFreeBuffers = 32;
+
+    /** @brief Free lists of the calling thread */
+    static std::array<std::vector<Request>, sizeClasses.size()>& freeLists();
+};
+
+/** @class JsonCache
+ *
+ *  Process wide cache of the parsed JSON configuration files, so a file read
+ *  by several consumers, or several times while the PDRs are built, is parsed
+ *  once. A file is parsed again when its modification time or size changes.
+ */
+class JsonCache
+{
+  public:
+    /** @brief Get the cache of the process */
+    static JsonCache& get();
+
+    /** @brief Get the parsed content of a JSON file
+     *
+     *  @param[in] path - path of the JSON file
+     *
+     *  @return the JSON value, discarded if the file can't be read or parsed
+     */
+    const Json& load(const std::filesystem::path& path);
+
+    /** @struct Entry
+     *  @brief Parsed content of a file, with the stamps of the file parsed
+     */
+    struct Entry
+    {
+        std::filesystem::file_time_type mtime;
+        uintmax_t size;
+        Json json;
+    };
+
+    /** @brief Parse a JSON file without caching it, from any thread
+     *
+     *  @param[in] path - path of the JSON file
+     *
+     *  @return the parsed file, its JSON value is discarded if it can't be
+     *          parsed, std::nullopt if it can't be read
+     */
+    static std::optional<Entry> parse(const std::filesystem::path& path);
+
+    /** @brief Cache a file parsed by parse(), e.g. on a startup thread
+     *
+     *  @param[in] path - path of the JSON file
+     *  @param[in] entry - parsed file
+     */
+    void insert(const std::filesystem::path& path, Entry&& entry)
+    {
+        files.insert_or_assign(path.string(), std::move(entry));
+    }
+
+  private:
+    std::unordered_map<std::string, Entry> files;
+};
+
 /**
  *  @class DBusHandler
  *
@@ -235,7 +607,8 @@ class DBusHandler : public DBusHandlerInterface
     }
 
     /**
-     *  @brief Get the DBUS Service name for the input dbus path
+     *  @brief Get the DBUS Service name for the input dbus path, from the
+     *         ServiceCache once it is enabled
      *
      *  @param[in] path - DBUS object path
      *  @param[in] interface - DBUS Interface
@@ -311,6 +684,21 @@ class DBusHandler : public DBusHandlerInterface
      */
     void setDbusProperty(const DBusMapping& dBusMap,
                          const PropertyValue& value) const override;
+
+    /** @brief Create the method call setting a Dbus property, for a call
+     *         made without blocking
+     *
+     *  @param[in] dBusMap - Object path, property name, interface and property
+     *                       type for the D-Bus object
+     *  @param[in] value - The value to be set
+     *
+     *  @return the Properties.Set method call
+     *
+     *  @throw std::invalid_argument for an unsupported property type, or
+     *         sdbusplus::exception_t when the service can't be found
+     */
+    sdbusplus::message_t newSetPropertyCall(const DBusMapping& dBusMap,
+                                            const PropertyValue& value) const;
 };
 
 /** @brief Fetch parent D-Bus object based on pathname
@@ -327,10 +715,19 @@ inline std::string findParent(const std::string& dbusObj)
 
 /** @brief Read (static) MCTP EID of host firmware from a file
  *
- *  @return uint8_t - MCTP EID
+ *  @return uint8_t - MCTP EID of the first host, 0 if none
  */
 uint8_t readHostEID();
 
+/** @brief Read the MCTP EIDs of the host firmwares of a multi-host system
+ *
+ *  @details The file lists the EIDs separated by white space, e.g. one per
+ *  line. EID 0 and the EIDs already listed are skipped.
+ *
+ *  @return std::vector<uint8_t> - MCTP EIDs in the order of the file
+ */
+std::vector<uint8_t> readHostEIDs();
+
 /** @brief Convert a value in the JSON to a D-Bus property value
  *
  *  @param[in] type - type of the D-Bus property
@@ -418,7 +815,59 @@ int emitStateSensorEventSignal(uint8_t tid, uint16_t sensorId,
  *
  *  @return - None
  */
-void printBuffer(bool isTx, const std::vector<uint8_t>& buffer);
+void printBuffer(bool isTx, std::span<const uint8_t> buffer);
+
+/** @class Crc32
+ *  @brief CRC-32 computed over the parts of a buffer as they arrive. The
+ *  value is the crc32() of libpldm over the concatenated parts. The ARMv8
+ *  CRC32 instructions are used when the CPU has them, slicing-by-8 tables
+ *  otherwise.
+ */
+class Crc32
+{
+  public:
+    /** @brief Get the CRC-32 of a whole buffer
+     *
+     *  @param[in] data - buffer
+     *
+     *  @return - CRC-32 value
+     */
+    static uint32_t of(std::span<const uint8_t> data)
+    {
+        Crc32 crc;
+        crc.update(data);
+        return crc.value();
+    }
+
+    /** @brief Add the next part of the buffer
+     *
+     *  @param[in] data - next part of the buffer
+     *
+     *  @return - None
+     */
+    void update(std::span<const uint8_t> data);
+
+    /** @brief Get the CRC-32 of the parts added since the last reset
+     *
+     *  @return - CRC-32 value
+     */
+    uint32_t value() const
+    {
+        return crc ^ 0xffffffff;
+    }
+
+    /** @brief Restart the computation for a new buffer
+     *
+     *  @return - None
+     */
+    void reset()
+    {
+        crc = 0xffffffff;
+    }
+
+  private:
+    uint32_t crc = 0xffffffff;
+};
 
 /** @brief Convert the buffer to std::string
  *
@@ -473,7 +922,7 @@ bool checkIfLogicalBitSet(const uint16_t& containerId);
  */
 std::string getUniqueEntryID(std::string &prefix);
 
-/** @brief Log Redfish for FaultLog
+/** @brief Log Redfish for FaultLog, the entry is queued on the log sink
  *
  *  @param[in] primaryLogId - unique name
  *  @param[in] type - Crashdump or CPER
@@ -482,7 +931,7 @@ std::string getUniqueEntryID(std::string &prefix);
  */
 void addFaultLogToRedfish(std::string &primaryLogId, std::string &type);
 
-/** @brief Log OEM SEL for FaultLog
+/** @brief Log OEM SEL for FaultLog, the entry is queued on the log sink
  *
  *  @param[in] msg - message string
  *  @param[in] evtData - event Data
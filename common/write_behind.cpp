@@ -0,0 +1,253 @@
+#include "common/write_behind.hpp"
+
+#include "common/metrics.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <iterator>
+#include <system_error>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace utils
+{
+
+bool writeFileAtomic(const std::filesystem::path& path,
+                     const std::vector<uint8_t>& contents,
+                     Durability durability)
+{
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+
+    /* Write a temporary file and rename it, a crash while writing leaves the
+     * previous file or no file but never a partial one */
+    auto tmpPath = path;
+    tmpPath += ".tmp";
+    int fd = open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                  0644);
+    if (fd < 0)
+    {
+        error("Failed to create {PATH}, errno={ERRNO}", "PATH",
+              tmpPath.string(), "ERRNO", errno);
+        return false;
+    }
+
+    bool written = true;
+    auto data = contents.data();
+    auto size = contents.size();
+    while (size)
+    {
+        auto n = ::write(fd, data, size);
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            written = false;
+            break;
+        }
+        data += n;
+        size -= n;
+    }
+    if (written && durability == Durability::Fsync && fsync(fd) < 0)
+    {
+        written = false;
+    }
+    if (close(fd) < 0)
+    {
+        written = false;
+    }
+    if (!written)
+    {
+        error("Failed to write {PATH}, errno={ERRNO}", "PATH",
+              tmpPath.string(), "ERRNO", errno);
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec)
+    {
+        error("Failed to rename {PATH}, ERROR={ERROR}", "PATH",
+              tmpPath.string(), "ERROR", ec.message());
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+
+    if (durability == Durability::Fsync)
+    {
+        /* The rename is durable once the directory is synced */
+        int dirFd = open(path.parent_path().c_str(),
+                         O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (dirFd >= 0)
+        {
+            fsync(dirFd);
+            close(dirFd);
+        }
+    }
+    return true;
+}
+
+bool persistFile(const std::filesystem::path& path,
+                 std::vector<uint8_t>&& contents, Durability durability)
+{
+    if (auto writeBehind = WriteBehind::get())
+    {
+        writeBehind->write(path, std::move(contents), durability);
+        return true;
+    }
+    return writeFileAtomic(path, contents, durability);
+}
+
+void removePersistedFile(const std::filesystem::path& path)
+{
+    if (auto writeBehind = WriteBehind::get())
+    {
+        writeBehind->discard(path);
+    }
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+}
+
+WriteBehind::WriteBehind(std::chrono::milliseconds window,
+                         std::chrono::milliseconds deadline, size_t budget) :
+    window(window),
+    deadline(deadline), budget(budget)
+{
+    worker = std::thread(&WriteBehind::run, this);
+    instance = this;
+}
+
+WriteBehind::~WriteBehind()
+{
+    instance = nullptr;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stop = true;
+    }
+    cv.notify_one();
+    if (worker.joinable())
+    {
+        worker.join();
+    }
+}
+
+void WriteBehind::write(const std::filesystem::path& path,
+                        std::vector<uint8_t>&& contents,
+                        Durability durability)
+{
+    auto now = Clock::now();
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        auto [it, inserted] = files.try_emplace(path);
+        auto& file = it->second;
+        if (inserted)
+        {
+            file.first = now;
+        }
+        else
+        {
+            pendingBytes -= file.contents.size();
+            coalesced++;
+            pldm::metrics::Registry::get()
+                .counter("pldm_write_behind_coalesced",
+                         "Updates of a persisted file replaced by a later "
+                         "one before written")
+                .inc();
+        }
+        file.contents = std::move(contents);
+        file.durability = durability;
+        file.last = now;
+        pendingBytes += file.contents.size();
+    }
+    cv.notify_one();
+}
+
+void WriteBehind::discard(const std::filesystem::path& path)
+{
+    std::unique_lock<std::mutex> guard(lock);
+    if (auto it = files.find(path); it != files.end())
+    {
+        pendingBytes -= it->second.contents.size();
+        files.erase(it);
+    }
+    idle.wait(guard, [this, &path] { return writing != path; });
+}
+
+void WriteBehind::flush()
+{
+    std::unique_lock<std::mutex> guard(lock);
+    flushing = true;
+    cv.notify_one();
+    idle.wait(guard, [this] { return files.empty() && !writing; });
+    flushing = false;
+}
+
+WriteBehind::Clock::time_point WriteBehind::due(const Pending& file) const
+{
+    /* Once due the oldest file is written first */
+    if (stop || flushing || pendingBytes > budget)
+    {
+        return file.first;
+    }
+    return std::min(file.last + window, file.first + deadline);
+}
+
+void WriteBehind::run()
+{
+    std::unique_lock<std::mutex> guard(lock);
+    while (true)
+    {
+        if (files.empty())
+        {
+            idle.notify_all();
+            if (stop)
+            {
+                return;
+            }
+            cv.wait(guard, [this] { return stop || !files.empty(); });
+            continue;
+        }
+
+        auto next = files.begin();
+        auto nextDue = due(next->second);
+        for (auto it = std::next(files.begin()); it != files.end(); ++it)
+        {
+            if (auto fileDue = due(it->second); fileDue < nextDue)
+            {
+                next = it;
+                nextDue = fileDue;
+            }
+        }
+        if (nextDue > Clock::now())
+        {
+            /* Woken up earlier by an update, a flush or the stop */
+            cv.wait_until(guard, nextDue);
+            continue;
+        }
+
+        auto path = next->first;
+        auto file = std::move(next->second);
+        files.erase(next);
+        pendingBytes -= file.contents.size();
+        writing = path;
+        guard.unlock();
+
+        writeFileAtomic(path, file.contents, file.durability);
+
+        guard.lock();
+        writing.reset();
+        idle.notify_all();
+    }
+}
+
+} // namespace utils
+} // namespace pldm
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace pldm
+{
+namespace utils
+{
+
+/** @brief How durable a persisted file is once written */
+enum class Durability : uint8_t
+{
+    Rename, //!< Written to a temporary file and renamed, never partial
+    Fsync,  //!< Renamed, the file and its directory synced too
+};
+
+/** @brief Write a whole file now, as a temporary file renamed over it
+ *
+ *  @param[in] path - path of the file, its directory is created if missing
+ *  @param[in] contents - bytes of the file
+ *  @param[in] durability - sync policy
+ *
+ *  @return - false if the file was not replaced
+ */
+bool writeFileAtomic(const std::filesystem::path& path,
+                     const std::vector<uint8_t>& contents,
+                     Durability durability);
+
+/** @brief Persist a whole file, behind on the write-behind of the process,
+ *  or now if there is none
+ *
+ *  @param[in] path - path of the file
+ *  @param[in] contents - bytes of the file
+ *  @param[in] durability - sync policy
+ *
+ *  @return - false if the file could not be written now, a write behind
+ *            always returns true
+ */
+bool persistFile(const std::filesystem::path& path,
+                 std::vector<uint8_t>&& contents,
+                 Durability durability = Durability::Rename);
+
+/** @brief Remove a persisted file and its pending write */
+void removePersistedFile(const std::filesystem::path& path);
+
+/** @class WriteBehind
+ *
+ *  Writes the persisted files of pldmd, e.g. the BIOS tables, the caches
+ *  and the tuned knobs, from a worker thread so no write to the flash is
+ *  made on the event loop. The updates of a file are coalesced: a file is
+ *  written once it was not updated for the coalescing window, with its last
+ *  contents, and at latest the flush deadline after its first pending
+ *  update. While the pending contents are over the memory budget the
+ *  oldest files are written without waiting. A file is always replaced
+ *  atomically and the pending files are written when the write-behind is
+ *  destroyed.
+ */
+class WriteBehind
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    WriteBehind() = delete;
+    WriteBehind(const WriteBehind&) = delete;
+    WriteBehind& operator=(const WriteBehind&) = delete;
+
+    /** @brief Start the worker, it is the write-behind used by
+     *         persistFile() until destroyed
+     *
+     *  @param[in] window - coalescing window of the updates of a file
+     *  @param[in] deadline - longest delay of the first pending update
+     *  @param[in] budget - bytes of the pending contents before the files
+     *                      are written without waiting
+     */
+    WriteBehind(std::chrono::milliseconds window,
+                std::chrono::milliseconds deadline, size_t budget);
+
+    /** @brief Write the pending files and stop the worker */
+    ~WriteBehind();
+
+    /** @brief Get the write-behind of the process
+     *
+     *  @return - the write-behind, nullptr if there is none
+     */
+    static WriteBehind* get()
+    {
+        return instance;
+    }
+
+    /** @brief Queue the contents of a file, replacing the pending ones,
+     *         thread safe
+     */
+    void write(const std::filesystem::path& path,
+               std::vector<uint8_t>&& contents, Durability durability);
+
+    /** @brief Drop the pending contents of a file, waiting for a write of
+     *         the file in progress
+     */
+    void discard(const std::filesystem::path& path);
+
+    /** @brief Write all the pending files and wait for them */
+    void flush();
+
+    /** @brief Number of updates replaced by a later one before written */
+    uint64_t getCoalesced() const
+    {
+        return coalesced;
+    }
+
+  private:
+    /** @struct Pending
+     *  @brief Contents of a file waiting to be written
+     */
+    struct Pending
+    {
+        std::vector<uint8_t> contents;
+        Durability durability;
+        Clock::time_point first;
+        Clock::time_point last;
+    };
+
+    /** @brief Worker thread loop */
+    void run();
+
+    /** @brief Time a pending file is due, now if over the budget or
+     *         flushing
+     */
+    Clock::time_point due(const Pending& file) const;
+
+    std::chrono::milliseconds window;
+    std::chrono::milliseconds deadline;
+    size_t budget;
+
+    std::mutex lock;
+    std::condition_variable cv;
+    std::condition_variable idle;
+    std::map<std::filesystem::path, Pending> files;
+    size_t pendingBytes = 0;
+    /** @brief File written by the worker, std::nullopt if none */
+    std::optional<std::filesystem::path> writing;
+    bool flushing = false;
+    bool stop = false;
+    std::atomic<uint64_t> coalesced = 0;
+    std::thread worker;
+
+    static inline WriteBehind* instance = nullptr;
+};
+
+} // namespace utils
+} // namespace pldm
@@ -7,6 +7,8 @@
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
+#include <cstring>
 #include <functional>
 
 PHOSPHOR_LOG2_USING;
@@ -17,12 +19,64 @@ namespace pldm
 namespace fw_update
 {
 
+size_t DeviceUpdater::skipCurrentComponents(
+    const ActiveComponentVersions& activeVersions)
+{
+    size_t skipped = 0;
+    std::erase_if(components, [&](size_t index) {
+        const auto& comp = compImageInfos[index];
+        auto key = std::make_pair(
+            std::get<static_cast<size_t>(
+                ComponentImageInfoPos::CompClassificationPos)>(comp),
+            std::get<static_cast<size_t>(
+                ComponentImageInfoPos::CompIdentifierPos)>(comp));
+        auto search = activeVersions.find(key);
+        if (search == activeVersions.end())
+        {
+            return false;
+        }
+
+        const auto& [activeStamp, activeVersion] = search->second;
+        auto stamp = std::get<static_cast<size_t>(
+            ComponentImageInfoPos::CompComparisonStampPos)>(comp);
+        const auto& version = std::get<static_cast<size_t>(
+            ComponentImageInfoPos::CompVersionPos)>(comp);
+        /* 0xFFFFFFFF means the package doesn't use the comparison stamp for
+         * this component, the version strings are compared only */
+        if (version == activeVersion &&
+            (stamp == 0xFFFFFFFF || stamp == activeStamp))
+        {
+            info(
+                "Component is already at the package version, skipped, EID={EID}, COMPONENT_VERSION={COMP_VERS}",
+                "EID", unsigned(eid), "COMP_VERS", version);
+            skipped++;
+            return true;
+        }
+        return false;
+    });
+    return skipped;
+}
+
+void DeviceUpdater::skipFwUpdate()
+{
+    pldmRequest.reset();
+    updateManager->updateDeviceCompletion(eid, true);
+}
+
 void DeviceUpdater::startFwUpdateFlow()
 {
+    if (components.empty())
+    {
+        /* Every component is current, the FD isn't put in update mode */
+        pldmRequest = std::make_unique<sdeventplus::source::Defer>(
+            updateManager->event,
+            std::bind(&DeviceUpdater::skipFwUpdate, this));
+        return;
+    }
+
     auto instanceId = updateManager->instanceIdDb.next(eid);
     // NumberOfComponents
-    const auto& applicableComponents =
-        std::get<ApplicableComponents>(fwDeviceIDRecord);
+    const auto& applicableComponents = components;
     // PackageDataLength
     const auto& fwDevicePkgData =
         std::get<FirmwareDevicePackageData>(fwDeviceIDRecord);
@@ -56,7 +110,8 @@ void DeviceUpdater::startFwUpdateFlow()
 
     rc = updateManager->handler.registerRequest(
         eid, instanceId, PLDM_FWUP, PLDM_REQUEST_UPDATE, std::move(request),
-        std::move(std::bind_front(&DeviceUpdater::requestUpdate, this)));
+        std::move(std::bind_front(&DeviceUpdater::requestUpdate, this)),
+        pldm::requester::RequestPriority::Bulk);
     if (rc)
     {
         error("Failed to send RequestUpdate request, EID = {EID}, RC = {RC}",
@@ -73,6 +128,7 @@ void DeviceUpdater::requestUpdate(mctp_eid_t eid, const pldm_msg* response,
         // Handle error scenario
         error("No response received for RequestUpdate, EID = {EID}", "EID",
               unsigned(eid));
+        updateManager->updateDeviceCompletion(eid, false);
         return;
     }
 
@@ -86,6 +142,7 @@ void DeviceUpdater::requestUpdate(mctp_eid_t eid, const pldm_msg* response,
     {
         error("Decoding RequestUpdate response failed, EID = {EID}, RC = {RC}",
               "EID", unsigned(eid), "RC", rc);
+        updateManager->updateDeviceCompletion(eid, false);
         return;
     }
     if (completionCode)
@@ -93,6 +150,7 @@ void DeviceUpdater::requestUpdate(mctp_eid_t eid, const pldm_msg* response,
         error(
             "RequestUpdate response failed with error completion code, EID = {EID}, CC = {CC}",
             "EID", unsigned(eid), "CC", unsigned(completionCode));
+        updateManager->updateDeviceCompletion(eid, false);
         return;
     }
 
@@ -109,8 +167,7 @@ void DeviceUpdater::sendPassCompTableRequest(size_t offset)
 
     auto instanceId = updateManager->instanceIdDb.next(eid);
     // TransferFlag
-    const auto& applicableComponents =
-        std::get<ApplicableComponents>(fwDeviceIDRecord);
+    const auto& applicableComponents = components;
     uint8_t transferFlag = 0;
     if (applicableComponents.size() == 1)
     {
@@ -179,7 +236,8 @@ void DeviceUpdater::sendPassCompTableRequest(size_t offset)
     rc = updateManager->handler.registerRequest(
         eid, instanceId, PLDM_FWUP, PLDM_PASS_COMPONENT_TABLE,
         std::move(request),
-        std::move(std::bind_front(&DeviceUpdater::passCompTable, this)));
+        std::move(std::bind_front(&DeviceUpdater::passCompTable, this)),
+        pldm::requester::RequestPriority::Bulk);
     if (rc)
     {
         error(
@@ -197,6 +255,7 @@ void DeviceUpdater::passCompTable(mctp_eid_t eid, const pldm_msg* response,
         // Handle error scenario
         error("No response received for PassComponentTable, EID = {EID}", "EID",
               unsigned(eid));
+        updateManager->updateDeviceCompletion(eid, false);
         return;
     }
 
@@ -213,6 +272,7 @@ void DeviceUpdater::passCompTable(mctp_eid_t eid, const pldm_msg* response,
         error(
             "Decoding PassComponentTable response failed, EID={EID}, RC = {RC}",
             "EID", unsigned(eid), "RC", rc);
+        updateManager->updateDeviceCompletion(eid, false);
         return;
     }
     if (completionCode)
@@ -221,12 +281,12 @@ void DeviceUpdater::passCompTable(mctp_eid_t eid, const pldm_msg* response,
         error(
             "PassComponentTable response failed with error completion code, EID = {EID}, CC = {CC}",
             "EID", unsigned(eid), "CC", unsigned(completionCode));
+        updateManager->updateDeviceCompletion(eid, false);
         return;
     }
     // Handle ComponentResponseCode
 
-    const auto& applicableComponents =
-        std::get<ApplicableComponents>(fwDeviceIDRecord);
+    const auto& applicableComponents = components;
     if (componentIndex == applicableComponents.size() - 1)
     {
         componentIndex = 0;
@@ -250,8 +310,7 @@ void DeviceUpdater::sendUpdateComponentRequest(size_t offset)
     pldmRequest.reset();
 
     auto instanceId = updateManager->instanceIdDb.next(eid);
-    const auto& applicableComponents =
-        std::get<ApplicableComponents>(fwDeviceIDRecord);
+    const auto& applicableComponents = components;
     const auto& comp = compImageInfos[applicableComponents[offset]];
     // ComponentClassification
     CompClassification compClassification = std::get<static_cast<size_t>(
@@ -305,7 +364,8 @@ void DeviceUpdater::sendUpdateComponentRequest(size_t offset)
 
     rc = updateManager->handler.registerRequest(
         eid, instanceId, PLDM_FWUP, PLDM_UPDATE_COMPONENT, std::move(request),
-        std::move(std::bind_front(&DeviceUpdater::updateComponent, this)));
+        std::move(std::bind_front(&DeviceUpdater::updateComponent, this)),
+        pldm::requester::RequestPriority::Bulk);
     if (rc)
     {
         error("Failed to send UpdateComponent request, EID={EID}, RC = {RC}",
@@ -319,9 +379,12 @@ void DeviceUpdater::updateComponent(mctp_eid_t eid, const pldm_msg* response,
 {
     if (response == nullptr || !respMsgLen)
     {
-        // Handle error scenario
         error("No response received for updateComponent, EID={EID}", "EID",
               unsigned(eid));
+        if (!resumeComponent())
+        {
+            updateManager->updateDeviceCompletion(eid, false);
+        }
         return;
     }
 
@@ -339,6 +402,7 @@ void DeviceUpdater::updateComponent(mctp_eid_t eid, const pldm_msg* response,
     {
         error("Decoding UpdateComponent response failed, EID={EID}, RC = {RC}",
               "EID", unsigned(eid), "RC", rc);
+        updateManager->updateDeviceCompletion(eid, false);
         return;
     }
     if (completionCode)
@@ -346,6 +410,7 @@ void DeviceUpdater::updateComponent(mctp_eid_t eid, const pldm_msg* response,
         error(
             "UpdateComponent response failed with error completion code, EID = {EID}, CC = {CC}",
             "EID", unsigned(eid), "CC", unsigned(completionCode));
+        updateManager->updateDeviceCompletion(eid, false);
         return;
     }
 }
@@ -377,13 +442,10 @@ Response DeviceUpdater::requestFwData(const pldm_msg* request,
         return response;
     }
 
-    const auto& applicableComponents =
-        std::get<ApplicableComponents>(fwDeviceIDRecord);
+    const auto& applicableComponents = components;
     const auto& comp = compImageInfos[applicableComponents[componentIndex]];
     auto compOffset = std::get<5>(comp);
     auto compSize = std::get<6>(comp);
-    error("offset = {OFFSET}, length = {LEN}", "OFFSET", unsigned(offset),
-          "LEN", unsigned(length));
     if (length < PLDM_FWUP_BASELINE_TRANSFER_SIZE || length > maxTransferSize)
     {
         rc = encode_request_firmware_data_resp(
@@ -418,13 +480,58 @@ Response DeviceUpdater::requestFwData(const pldm_msg* request,
         padBytes = offset + length - compSize;
     }
 
+    /* The pad bytes beyond the component image stay zero */
+    size_t dataSize = padBytes < length ? length - padBytes : 0;
+    size_t dataOffset = static_cast<size_t>(compOffset) + offset;
+    if (dataSize && dataOffset + dataSize > package.size())
+    {
+        error(
+            "Component image is beyond the end of the package, EID={EID}, OFFSET={OFFSET}, LENGTH={LEN}",
+            "EID", unsigned(eid), "OFFSET", dataOffset, "LEN", dataSize);
+        rc = encode_request_firmware_data_resp(
+            request->hdr.instance_id, PLDM_FWUP_DATA_OUT_OF_RANGE, responseMsg,
+            sizeof(completionCode));
+        if (rc)
+        {
+            error(
+                "Encoding RequestFirmwareData response failed, EID={EID}, RC = {RC}",
+                "EID", unsigned(eid), "RC", rc);
+        }
+        return response;
+    }
+
     response.resize(sizeof(pldm_msg_hdr) + sizeof(completionCode) + length);
     responseMsg = reinterpret_cast<pldm_msg*>(response.data());
-    package.seekg(compOffset + offset);
-    package.read(reinterpret_cast<char*>(response.data() +
-                                         sizeof(pldm_msg_hdr) +
-                                         sizeof(completionCode)),
-                 length - padBytes);
+    if (dataSize)
+    {
+        std::memcpy(response.data() + sizeof(pldm_msg_hdr) +
+                        sizeof(completionCode),
+                    package.data() + dataOffset, dataSize);
+    }
+    if (resuming)
+    {
+        /* The FD which picks up where the interrupted transfer stopped
+         * skips the bytes below its first request */
+        resuming = false;
+        if (offset)
+        {
+            resumedTransfers++;
+            resumedBytes += std::min(offset, resumeOffset);
+            info(
+                "Component transfer resumed, EID={EID}, OFFSET={OFFSET}, ACKED_OFFSET={ACKED}",
+                "EID", unsigned(eid), "OFFSET", offset, "ACKED", resumeOffset);
+        }
+    }
+    ackedOffset = std::max(ackedOffset, offset);
+    fwDataRequests++;
+    fwDataBytes += dataSize;
+    if (updateManager && compSize)
+    {
+        updateManager->updateTransferProgress(
+            eid, static_cast<uint8_t>(
+                     (100 * std::min<uint64_t>(offset + dataSize, compSize)) /
+                     compSize));
+    }
     rc = encode_request_firmware_data_resp(request->hdr.instance_id,
                                            completionCode, responseMsg,
                                            sizeof(completionCode));
@@ -465,24 +572,31 @@ Response DeviceUpdater::transferComplete(const pldm_msg* request,
         return response;
     }
 
-    const auto& applicableComponents =
-        std::get<ApplicableComponents>(fwDeviceIDRecord);
+    const auto& applicableComponents = components;
     const auto& comp = compImageInfos[applicableComponents[componentIndex]];
     const auto& compVersion = std::get<7>(comp);
 
+    bool transferFailed = false;
     if (transferResult == PLDM_FWUP_TRANSFER_SUCCESS)
     {
         info(
-            "Component Transfer complete, EID = {EID}, COMPONENT_VERSION = {COMP_VERS}",
-            "EID", unsigned(eid), "COMP_VERS", compVersion);
+            "Component Transfer complete, EID = {EID}, COMPONENT_VERSION = {COMP_VERS}, REQUESTS = {REQUESTS}, BYTES = {BYTES}",
+            "EID", unsigned(eid), "COMP_VERS", compVersion, "REQUESTS",
+            fwDataRequests, "BYTES", fwDataBytes);
+        ackedOffset = 0;
+        resumeAttempts = 0;
     }
     else
     {
         error(
-            "Transfer of the component failed, EID={EID}, COMPONENT_VERSION = {COMP_VERS}, TRANSFER_RESULT = {TRANS_RES}",
+            "Transfer of the component failed, EID={EID}, COMPONENT_VERSION = {COMP_VERS}, TRANSFER_RESULT = {TRANS_RES}, REQUESTS = {REQUESTS}, BYTES = {BYTES}",
             "EID", unsigned(eid), "COMP_VERS", compVersion, "TRANS_RES",
-            unsigned(transferResult));
+            unsigned(transferResult), "REQUESTS", fwDataRequests, "BYTES",
+            fwDataBytes);
+        transferFailed = true;
     }
+    fwDataRequests = 0;
+    fwDataBytes = 0;
 
     rc = encode_transfer_complete_resp(request->hdr.instance_id, completionCode,
                                        responseMsg, sizeof(completionCode));
@@ -493,9 +607,34 @@ Response DeviceUpdater::transferComplete(const pldm_msg* request,
         return response;
     }
 
+    /* The FD is back in READY XFER, the component is offered again */
+    if (transferFailed && updateManager && !resumeComponent())
+    {
+        updateManager->updateDeviceCompletion(eid, false);
+    }
+
     return response;
 }
 
+bool DeviceUpdater::resumeComponent()
+{
+    if (resumeAttempts >= FW_UPDATE_RESUME_ATTEMPTS)
+    {
+        return false;
+    }
+    resumeAttempts++;
+    resuming = true;
+    resumeOffset = ackedOffset;
+    info(
+        "Resuming the component transfer, EID={EID}, ATTEMPT={ATTEMPT}, ACKED_OFFSET={ACKED}",
+        "EID", unsigned(eid), "ATTEMPT", resumeAttempts, "ACKED", ackedOffset);
+    pldmRequest = std::make_unique<sdeventplus::source::Defer>(
+        updateManager->event,
+        std::bind(&DeviceUpdater::sendUpdateComponentRequest, this,
+                  componentIndex));
+    return true;
+}
+
 Response DeviceUpdater::verifyComplete(const pldm_msg* request,
                                        size_t payloadLength)
 {
@@ -521,8 +660,7 @@ Response DeviceUpdater::verifyComplete(const pldm_msg* request,
         return response;
     }
 
-    const auto& applicableComponents =
-        std::get<ApplicableComponents>(fwDeviceIDRecord);
+    const auto& applicableComponents = components;
     const auto& comp = compImageInfos[applicableComponents[componentIndex]];
     const auto& compVersion = std::get<7>(comp);
 
@@ -579,8 +717,7 @@ Response DeviceUpdater::applyComplete(const pldm_msg* request,
         return response;
     }
 
-    const auto& applicableComponents =
-        std::get<ApplicableComponents>(fwDeviceIDRecord);
+    const auto& applicableComponents = components;
     const auto& comp = compImageInfos[applicableComponents[componentIndex]];
     const auto& compVersion = std::get<7>(comp);
 
@@ -590,7 +727,7 @@ Response DeviceUpdater::applyComplete(const pldm_msg* request,
         info(
             "Component apply complete, EID = {EID}, COMPONENT_VERSION = {COMP_VERS}",
             "EID", unsigned(eid), "COMP_VERS", compVersion);
-        updateManager->updateActivationProgress();
+        updateManager->updateActivationProgress(eid);
     }
     else
     {
@@ -648,7 +785,8 @@ void DeviceUpdater::sendActivateFirmwareRequest()
 
     rc = updateManager->handler.registerRequest(
         eid, instanceId, PLDM_FWUP, PLDM_ACTIVATE_FIRMWARE, std::move(request),
-        std::move(std::bind_front(&DeviceUpdater::activateFirmware, this)));
+        std::move(std::bind_front(&DeviceUpdater::activateFirmware, this)),
+        pldm::requester::RequestPriority::Bulk);
     if (rc)
     {
         error("Failed to send ActivateFirmware request, EID={EID}, RC = {RC}",
@@ -664,6 +802,7 @@ void DeviceUpdater::activateFirmware(mctp_eid_t eid, const pldm_msg* response,
         // Handle error scenario
         error("No response received for ActivateFirmware, EID={EID}", "EID",
               unsigned(eid));
+        updateManager->updateDeviceCompletion(eid, false);
         return;
     }
 
@@ -677,6 +816,7 @@ void DeviceUpdater::activateFirmware(mctp_eid_t eid, const pldm_msg* response,
         // Handle error scenario
         error("Decoding ActivateFirmware response failed, EID={EID}, RC = {RC}",
               "EID", unsigned(eid), "RC", rc);
+        updateManager->updateDeviceCompletion(eid, false);
         return;
     }
     if (completionCode)
@@ -685,6 +825,7 @@ void DeviceUpdater::activateFirmware(mctp_eid_t eid, const pldm_msg* response,
         error(
             "ActivateFirmware response failed with error completion code, EID = {EID}, CC = {CC}",
             "EID", unsigned(eid), "CC", unsigned(completionCode));
+        updateManager->updateDeviceCompletion(eid, false);
         return;
     }
 
@@ -7,7 +7,7 @@
 #include <sdeventplus/event.hpp>
 #include <sdeventplus/source/event.hpp>
 
-#include <fstream>
+#include <span>
 
 namespace pldm
 {
@@ -35,7 +35,7 @@ class DeviceUpdater
     /** @brief Constructor
      *
      *  @param[in] eid - Endpoint ID of the firmware device
-     *  @param[in] package - File stream for firmware update package
+     *  @param[in] package - Firmware update package mapped in memory
      *  @param[in] fwDeviceIDRecord - FirmwareDeviceIDRecord in the fw update
      *                                package that matches this firmware device
      *  @param[in] compImageInfos - Component image information for all the
@@ -47,7 +47,7 @@ class DeviceUpdater
      *  @param[in] updateManager - To update the status of fw update of the
      *                             device
      */
-    explicit DeviceUpdater(mctp_eid_t eid, std::ifstream& package,
+    explicit DeviceUpdater(mctp_eid_t eid, std::span<const uint8_t> package,
                            const FirmwareDeviceIDRecord& fwDeviceIDRecord,
                            const ComponentImageInfos& compImageInfos,
                            const ComponentInfo& compInfo,
@@ -56,9 +56,28 @@ class DeviceUpdater
         eid(eid),
         package(package), fwDeviceIDRecord(fwDeviceIDRecord),
         compImageInfos(compImageInfos), compInfo(compInfo),
-        maxTransferSize(maxTransferSize), updateManager(updateManager)
+        maxTransferSize(maxTransferSize), updateManager(updateManager),
+        components(std::get<ApplicableComponents>(fwDeviceIDRecord))
     {}
 
+    /** @brief Drop the components the FD already runs
+     *
+     *  A component is current when its active version string, and its
+     *  active comparison stamp unless the package doesn't use the stamp,
+     *  match the component image in the package.
+     *
+     *  @param[in] activeVersions - active component versions of the FD
+     *
+     *  @return number of components dropped
+     */
+    size_t skipCurrentComponents(const ActiveComponentVersions& activeVersions);
+
+    /** @brief Number of components to update */
+    size_t numComponents() const
+    {
+        return components.size();
+    }
+
     /** @brief Start the firmware update flow for the FD
      *
      *  To start the update flow RequestUpdate command is sent to the FD.
@@ -154,6 +173,18 @@ class DeviceUpdater
     void activateFirmware(mctp_eid_t eid, const pldm_msg* response,
                           size_t respMsgLen);
 
+    /** @brief Number of component transfers the FD resumed */
+    size_t getResumedTransfers() const
+    {
+        return resumedTransfers;
+    }
+
+    /** @brief Number of bytes the resumed transfers did not send again */
+    uint64_t getResumedBytes() const
+    {
+        return resumedBytes;
+    }
+
   private:
     /** @brief Send PassComponentTable command request
      *
@@ -170,11 +201,22 @@ class DeviceUpdater
     /** @brief Send ActivateFirmware command request */
     void sendActivateFirmwareRequest();
 
+    /** @brief Complete the update of a FD with no component to update */
+    void skipFwUpdate();
+
+    /** @brief Offer the current component again after its transfer was
+     *         interrupted, a cooperating FD requests the remaining data only
+     *
+     *  @return true if UpdateComponent is sent again, false once the
+     *          FW_UPDATE_RESUME_ATTEMPTS of the component are used
+     */
+    bool resumeComponent();
+
     /** @brief Endpoint ID of the firmware device */
     mctp_eid_t eid;
 
-    /** @brief File stream for firmware update package */
-    std::ifstream& package;
+    /** @brief Firmware update package mapped in memory */
+    std::span<const uint8_t> package;
 
     /** @brief FirmwareDeviceIDRecord in the fw update package that matches this
      *         firmware device
@@ -199,6 +241,39 @@ class DeviceUpdater
     /** @brief To update the status of fw update of the FD */
     UpdateManager* updateManager;
 
+    /** @brief Indexes in compImageInfos of the components to update, the
+     *         applicable components of the FD minus the current ones
+     */
+    ApplicableComponents components;
+
+    /** @brief Number of RequestFirmwareData served for the component */
+    size_t fwDataRequests = 0;
+
+    /** @brief Number of bytes of the component sent */
+    size_t fwDataBytes = 0;
+
+    /** @brief Highest offset of the component requested by the FD, the data
+     *         below it was received
+     */
+    uint32_t ackedOffset = 0;
+
+    /** @brief Resumes of the current component */
+    size_t resumeAttempts = 0;
+
+    /** @brief UpdateComponent was sent again, the next RequestFirmwareData
+     *         tells where the FD resumes from
+     */
+    bool resuming = false;
+
+    /** @brief ackedOffset when the transfer was resumed */
+    uint32_t resumeOffset = 0;
+
+    /** @brief Transfers the FD resumed past offset 0 */
+    size_t resumedTransfers = 0;
+
+    /** @brief Bytes not sent again thanks to the resumed transfers */
+    uint64_t resumedBytes = 0;
+
     /** @brief Component index is used to track the current component being
      *         updated if multiple components are applicable for the FD.
      *         It is also used to keep track of the next component in
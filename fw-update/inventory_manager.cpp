@@ -8,6 +8,7 @@
 #include <phosphor-logging/lg2.hpp>
 
 #include <functional>
+#include <optional>
 
 PHOSPHOR_LOG2_USING;
 
@@ -19,44 +20,96 @@ void InventoryManager::discoverFDs(const std::vector<mctp_eid_t>& eids)
 {
     for (const auto& eid : eids)
     {
-        auto instanceId = instanceIdDb.next(eid);
-        Request requestMsg(sizeof(pldm_msg_hdr) +
-                           PLDM_QUERY_DEVICE_IDENTIFIERS_REQ_BYTES);
-        auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
-        auto rc = encode_query_device_identifiers_req(
-            instanceId, PLDM_QUERY_DEVICE_IDENTIFIERS_REQ_BYTES, request);
-        if (rc)
+        if (pendingFDs.contains(eid))
         {
-            instanceIdDb.free(eid, instanceId);
-            error(
-                "encode_query_device_identifiers_req failed, EID={EID}, RC = {RC}",
-                "EID", unsigned(eid), "RC", rc);
             continue;
         }
 
-        rc = handler.registerRequest(
-            eid, instanceId, PLDM_FWUP, PLDM_QUERY_DEVICE_IDENTIFIERS,
-            std::move(requestMsg),
-            std::move(std::bind_front(&InventoryManager::queryDeviceIdentifiers,
-                                      this)));
-        if (rc)
+        /* Both inventory commands are queued at once, the handler sends
+         * them in turn to each FD and the FDs are queried side by side */
+        auto& fd = pendingFDs[eid];
+        if (!sendQueryDeviceIdentifiersRequest(eid))
         {
-            error(
-                "Failed to send QueryDeviceIdentifiers request, EID={EID}, RC = {RC}",
-                "EID", unsigned(eid), "RC", rc);
+            fd.responses++;
+        }
+        if (!sendGetFirmwareParametersRequest(eid))
+        {
+            fd.responses++;
+        }
+    }
+
+    /* The FDs which could not be queried at all */
+    for (const auto& eid : eids)
+    {
+        auto it = pendingFDs.find(eid);
+        if (it != pendingFDs.end() && it->second.responses == 2)
+        {
+            fdResponse(it);
         }
     }
 }
 
+bool InventoryManager::sendQueryDeviceIdentifiersRequest(mctp_eid_t eid)
+{
+    auto instanceId = instanceIdDb.next(eid);
+    Request requestMsg(sizeof(pldm_msg_hdr) +
+                       PLDM_QUERY_DEVICE_IDENTIFIERS_REQ_BYTES);
+    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+    auto rc = encode_query_device_identifiers_req(
+        instanceId, PLDM_QUERY_DEVICE_IDENTIFIERS_REQ_BYTES, request);
+    if (rc)
+    {
+        instanceIdDb.free(eid, instanceId);
+        error(
+            "encode_query_device_identifiers_req failed, EID={EID}, RC = {RC}",
+            "EID", unsigned(eid), "RC", rc);
+        return false;
+    }
+
+    rc = handler.registerRequest(
+        eid, instanceId, PLDM_FWUP, PLDM_QUERY_DEVICE_IDENTIFIERS,
+        std::move(requestMsg),
+        std::move(
+            std::bind_front(&InventoryManager::queryDeviceIdentifiers, this)));
+    if (rc)
+    {
+        error(
+            "Failed to send QueryDeviceIdentifiers request, EID={EID}, RC = {RC}",
+            "EID", unsigned(eid), "RC", rc);
+        return false;
+    }
+    return true;
+}
+
 void InventoryManager::queryDeviceIdentifiers(mctp_eid_t eid,
                                               const pldm_msg* response,
                                               size_t respMsgLen)
+{
+    auto descriptors = decodeDeviceIdentifiers(eid, response, respMsgLen);
+    auto it = pendingFDs.find(eid);
+    if (it == pendingFDs.end())
+    {
+        /* Not part of a discovery batch, applied as is */
+        if (descriptors)
+        {
+            descriptorMap.emplace(eid, std::move(*descriptors));
+        }
+        return;
+    }
+
+    it->second.descriptors = std::move(descriptors);
+    it->second.responses++;
+    fdResponse(it);
+}
+
+std::optional<Descriptors> InventoryManager::decodeDeviceIdentifiers(
+    mctp_eid_t eid, const pldm_msg* response, size_t respMsgLen)
 {
     if (response == nullptr || !respMsgLen)
     {
         error("No response received for QueryDeviceIdentifiers, EID={EID}",
               "EID", unsigned(eid));
-        return;
+        return std::nullopt;
     }
 
     uint8_t completionCode = PLDM_SUCCESS;
@@ -72,7 +125,7 @@ void InventoryManager::queryDeviceIdentifiers(mctp_eid_t eid,
         error(
             "Decoding QueryDeviceIdentifiers response failed, EID={EID}, RC = {RC}",
             "EID", unsigned(eid), "RC", rc);
-        return;
+        return std::nullopt;
     }
 
     if (completionCode)
@@ -80,7 +133,7 @@ void InventoryManager::queryDeviceIdentifiers(mctp_eid_t eid,
         error(
             "QueryDeviceIdentifiers response failed with error completion code, EID={EID}, CC = {CC}",
             "EID", unsigned(eid), "CC", unsigned(completionCode));
-        return;
+        return std::nullopt;
     }
 
     Descriptors descriptors{};
@@ -97,7 +150,7 @@ void InventoryManager::queryDeviceIdentifiers(mctp_eid_t eid,
             error(
                 "Decoding descriptor type, length and value failed, EID={EID}, RC = {RC}",
                 "EID", unsigned(eid), "RC", rc);
-            return;
+            return std::nullopt;
         }
 
         if (descriptorType != PLDM_FWUP_VENDOR_DEFINED)
@@ -121,7 +174,7 @@ void InventoryManager::queryDeviceIdentifiers(mctp_eid_t eid,
                 error(
                     "Decoding Vendor-defined descriptor value failed, EID={EID}, RC = {RC}",
                     "EID", unsigned(eid), "RC", rc);
-                return;
+                return std::nullopt;
             }
 
             auto vendorDefinedDescriptorTitleStr =
@@ -142,13 +195,10 @@ void InventoryManager::queryDeviceIdentifiers(mctp_eid_t eid,
         deviceIdentifiersLen -= nextDescriptorOffset;
     }
 
-    descriptorMap.emplace(eid, std::move(descriptors));
-
-    // Send GetFirmwareParameters request
-    sendGetFirmwareParametersRequest(eid);
+    return descriptors;
 }
 
-void InventoryManager::sendGetFirmwareParametersRequest(mctp_eid_t eid)
+bool InventoryManager::sendGetFirmwareParametersRequest(mctp_eid_t eid)
 {
     auto instanceId = instanceIdDb.next(eid);
     Request requestMsg(sizeof(pldm_msg_hdr) +
@@ -161,7 +211,7 @@ void InventoryManager::sendGetFirmwareParametersRequest(mctp_eid_t eid)
         instanceIdDb.free(eid, instanceId);
         error("encode_get_firmware_parameters_req failed, EID={EID}, RC = {RC}",
               "EID", unsigned(eid), "RC", rc);
-        return;
+        return false;
     }
 
     rc = handler.registerRequest(
@@ -174,19 +224,49 @@ void InventoryManager::sendGetFirmwareParametersRequest(mctp_eid_t eid)
         error(
             "Failed to send GetFirmwareParameters request, EID={EID}, RC = {RC}",
             "EID", unsigned(eid), "RC", rc);
+        return false;
     }
+    return true;
 }
 
 void InventoryManager::getFirmwareParameters(mctp_eid_t eid,
                                              const pldm_msg* response,
                                              size_t respMsgLen)
+{
+    ActiveComponentVersions versions;
+    auto componentInfo =
+        decodeFirmwareParameters(eid, response, respMsgLen, versions);
+    auto it = pendingFDs.find(eid);
+    if (it == pendingFDs.end())
+    {
+        /* Not part of a discovery batch, applied as is */
+        if (componentInfo)
+        {
+            componentInfoMap.emplace(eid, std::move(*componentInfo));
+            activeVersionMap.insert_or_assign(eid, std::move(versions));
+        }
+        else if (response == nullptr || !respMsgLen)
+        {
+            descriptorMap.erase(eid);
+        }
+        return;
+    }
+
+    it->second.componentInfo = std::move(componentInfo);
+    it->second.versions = std::move(versions);
+    it->second.responses++;
+    fdResponse(it);
+}
+
+std::optional<ComponentInfo> InventoryManager::decodeFirmwareParameters(
+    mctp_eid_t eid, const pldm_msg* response, size_t respMsgLen,
+    ActiveComponentVersions& versions)
 {
     if (response == nullptr || !respMsgLen)
     {
         error("No response received for GetFirmwareParameters, EID={EID}",
               "EID", unsigned(eid));
-        descriptorMap.erase(eid);
-        return;
+        return std::nullopt;
     }
 
     pldm_get_firmware_parameters_resp fwParams{};
@@ -202,7 +282,7 @@ void InventoryManager::getFirmwareParameters(mctp_eid_t eid,
         error(
             "Decoding GetFirmwareParameters response failed, EID={EID}, RC = {RC}",
             "EID", unsigned(eid), "RC", rc);
-        return;
+        return std::nullopt;
     }
 
     if (fwParams.completion_code)
@@ -210,7 +290,7 @@ void InventoryManager::getFirmwareParameters(mctp_eid_t eid,
         error(
             "GetFirmwareParameters response failed with error completion code, EID={EID}, CC = {CC}",
             "EID", unsigned(eid), "CC", unsigned(fwParams.completion_code));
-        return;
+        return std::nullopt;
     }
 
     auto compParamPtr = compParamTable.ptr;
@@ -230,7 +310,7 @@ void InventoryManager::getFirmwareParameters(mctp_eid_t eid,
             error(
                 "Decoding component parameter table entry failed, EID={EID}, RC = {RC}",
                 "EID", unsigned(eid), "RC", rc);
-            return;
+            return std::nullopt;
         }
 
         auto compClassification = compEntry.comp_classification;
@@ -238,12 +318,45 @@ void InventoryManager::getFirmwareParameters(mctp_eid_t eid,
         componentInfo.emplace(
             std::make_pair(compClassification, compIdentifier),
             compEntry.comp_classification_index);
+        versions.emplace(std::make_pair(compClassification, compIdentifier),
+                         std::make_tuple(compEntry.active_comp_comparison_stamp,
+                                         utils::toString(activeCompVerStr)));
         compParamPtr += sizeof(pldm_component_parameter_entry) +
                         activeCompVerStr.length + pendingCompVerStr.length;
         compParamTableLen -= sizeof(pldm_component_parameter_entry) +
                              activeCompVerStr.length + pendingCompVerStr.length;
     }
-    componentInfoMap.emplace(eid, std::move(componentInfo));
+    return componentInfo;
+}
+
+void InventoryManager::fdResponse(PendingFDs::iterator it)
+{
+    if (it->second.responses < 2)
+    {
+        return;
+    }
+
+    auto eid = it->first;
+    auto& fd = it->second;
+    /* The descriptors and the component info of a FD are published
+     * together, an update never sees one without the other */
+    if (fd.descriptors && fd.componentInfo)
+    {
+        descriptorMap.emplace(eid, std::move(*fd.descriptors));
+        componentInfoMap.emplace(eid, std::move(*fd.componentInfo));
+        activeVersionMap.insert_or_assign(eid, std::move(fd.versions));
+    }
+    else
+    {
+        error("Firmware inventory of the FD is incomplete, EID={EID}", "EID",
+              unsigned(eid));
+    }
+    pendingFDs.erase(it);
+
+    if (inventoryCallback)
+    {
+        inventoryCallback(pendingFDs.empty());
+    }
 }
 
 } // namespace fw_update
@@ -4,6 +4,10 @@
 #include "common/types.hpp"
 #include "requester/handler.hpp"
 
+#include <functional>
+#include <optional>
+#include <unordered_map>
+
 namespace pldm
 {
 
@@ -21,6 +25,11 @@ namespace fw_update
 class InventoryManager
 {
   public:
+    /** @brief Callback when the inventory of a FD of a discovery batch is
+     *         complete, with true once no FD is left to be discovered
+     */
+    using InventoryCallback = std::function<void(bool)>;
+
     InventoryManager() = delete;
     InventoryManager(const InventoryManager&) = delete;
     InventoryManager(InventoryManager&&) = delete;
@@ -36,31 +45,50 @@ class InventoryManager
      *                              FDs managed by the BMC.
      *  @param[out] componentInfoMap - Populate the component info for the FDs
      *                                 managed by the BMC.
+     *  @param[in] inventoryCallback - Invoked when the inventory of a FD is
+     *                                 complete
      */
     explicit InventoryManager(
         pldm::requester::Handler<pldm::requester::Request>& handler,
         InstanceIdDb& instanceIdDb, DescriptorMap& descriptorMap,
-        ComponentInfoMap& componentInfoMap) :
+        ComponentInfoMap& componentInfoMap,
+        InventoryCallback&& inventoryCallback = {}) :
         handler(handler),
         instanceIdDb(instanceIdDb), descriptorMap(descriptorMap),
-        componentInfoMap(componentInfoMap)
+        componentInfoMap(componentInfoMap),
+        inventoryCallback(std::move(inventoryCallback))
     {}
 
     /** @brief Discover the firmware identifiers and component details of FDs
      *
      *  Inventory commands QueryDeviceIdentifiers and GetFirmwareParmeters
-     *  commands are sent to every FD and the response is used to populate
-     *  the firmware identifiers and component details of the FDs.
+     *  commands are sent to every FD at once and the responses are used to
+     *  populate the firmware identifiers and component details of the FDs.
+     *  Both are added to the maps together once the two responses of a FD
+     *  are in.
      *
      *  @param[in] eids - MCTP endpoint ID of the FDs
      */
     void discoverFDs(const std::vector<mctp_eid_t>& eids);
 
+    /** @brief Active versions of the components of the discovered FDs,
+     *         refreshed at each discovery
+     */
+    ActiveComponentVersionMap& getActiveVersionMap()
+    {
+        return activeVersionMap;
+    }
+
+    /** @brief Whether some FDs are still being discovered */
+    bool discoveryInProgress() const
+    {
+        return !pendingFDs.empty();
+    }
+
     /** @brief Handler for QueryDeviceIdentifiers command response
      *
      *  The response of the QueryDeviceIdentifiers is processed and firmware
-     *  identifiers of the FD is updated. GetFirmwareParameters command request
-     *  is sent to the FD.
+     *  identifiers of the FD is updated.
      *
      *  @param[in] eid - Remote MCTP endpoint
      *  @param[in] response - PLDM response message
@@ -82,11 +110,54 @@ class InventoryManager
                                size_t respMsgLen);
 
   private:
+    /** @brief Inventory of a FD being discovered */
+    struct FDInventory
+    {
+        std::optional<Descriptors> descriptors;
+        std::optional<ComponentInfo> componentInfo;
+        ActiveComponentVersions versions;
+        uint8_t responses = 0; //!< responses received or never expected
+    };
+    using PendingFDs = std::unordered_map<mctp_eid_t, FDInventory>;
+
+    /** @brief Send QueryDeviceIdentifiers command request
+     *
+     *  @param[in] eid - Remote MCTP endpoint
+     *
+     *  @return true if the request is sent
+     */
+    bool sendQueryDeviceIdentifiersRequest(mctp_eid_t eid);
+
     /** @brief Send GetFirmwareParameters command request
      *
      *  @param[in] eid - Remote MCTP endpoint
+     *
+     *  @return true if the request is sent
      */
-    void sendGetFirmwareParametersRequest(mctp_eid_t eid);
+    bool sendGetFirmwareParametersRequest(mctp_eid_t eid);
+
+    /** @brief Decode the firmware identifiers of a FD
+     *
+     *  @return the descriptors, nullopt on error
+     */
+    std::optional<Descriptors> decodeDeviceIdentifiers(
+        mctp_eid_t eid, const pldm_msg* response, size_t respMsgLen);
+
+    /** @brief Decode the component details of a FD
+     *
+     *  @param[out] versions - active versions of the components
+     *
+     *  @return the component info, nullopt on error
+     */
+    std::optional<ComponentInfo> decodeFirmwareParameters(
+        mctp_eid_t eid, const pldm_msg* response, size_t respMsgLen,
+        ActiveComponentVersions& versions);
+
+    /** @brief Publish the inventory of a FD once both responses are in
+     *
+     *  @param[in] it - FD in pendingFDs
+     */
+    void fdResponse(PendingFDs::iterator it);
 
     /** @brief PLDM request handler */
     pldm::requester::Handler<pldm::requester::Request>& handler;
@@ -99,6 +170,15 @@ class InventoryManager
 
     /** @brief Component information needed for the update of the managed FDs */
     ComponentInfoMap& componentInfoMap;
+
+    /** @brief Invoked when the inventory of a FD is complete */
+    InventoryCallback inventoryCallback;
+
+    /** @brief Active versions of the components of the discovered FDs */
+    ActiveComponentVersionMap activeVersionMap;
+
+    /** @brief FDs of the discovery batches waiting for responses */
+    PendingFDs pendingFDs;
 };
 
 } // namespace fw_update
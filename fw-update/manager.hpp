@@ -8,6 +8,7 @@
 #include "requester/handler.hpp"
 #include "update_manager.hpp"
 
+#include <functional>
 #include <unordered_map>
 #include <vector>
 
@@ -39,9 +40,11 @@ class Manager
     explicit Manager(Event& event,
                      requester::Handler<requester::Request>& handler,
                      pldm::InstanceIdDb& instanceIdDb) :
-        inventoryMgr(handler, instanceIdDb, descriptorMap, componentInfoMap),
+        inventoryMgr(handler, instanceIdDb, descriptorMap, componentInfoMap,
+                     std::bind_front(&UpdateManager::inventoryUpdated,
+                                     &updateManager)),
         updateManager(event, handler, instanceIdDb, descriptorMap,
-                      componentInfoMap)
+                      componentInfoMap, inventoryMgr.getActiveVersionMap())
     {}
 
     /** @brief Discover MCTP endpoints that support the PLDM firmware update
@@ -54,6 +57,10 @@ class Manager
     void handleMCTPEndpoints(const std::vector<mctp_eid_t>& eids)
     {
         inventoryMgr.discoverFDs(eids);
+        if (inventoryMgr.discoveryInProgress())
+        {
+            updateManager.inventoryUpdated(false);
+        }
     }
 
     /** @brief Handle PLDM request for the commands in the FW update
@@ -71,6 +78,18 @@ class Manager
         return updateManager.handleRequest(eid, command, request, reqMsgLen);
     }
 
+    /** @brief Process a firmware update package received in a file
+     *         descriptor
+     *
+     *  @param[in] fd - file descriptor of the package, owned by the call
+     *
+     *  @return 0 if the package was processed, -1 otherwise
+     */
+    int processPackage(int fd)
+    {
+        return updateManager.processPackage(fd);
+    }
+
   private:
     /** Descriptor information of all the discovered MCTP endpoints */
     DescriptorMap descriptorMap;
@@ -0,0 +1,296 @@
+#include "package_intake.hpp"
+
+#include <fcntl.h>
+#include <libpldm/firmware_update.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <cerrno>
+#include <exception>
+#include <span>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+
+namespace fw_update
+{
+
+namespace
+{
+constexpr auto firmwarePackageIntf = "com.ampere.PLDM.FirmwarePackage";
+/** @brief Bytes the package header information can span, with the longest
+ *         package version string
+ */
+constexpr size_t maxPkgHeaderInfoSize =
+    sizeof(pldm_package_header_information) + UINT8_MAX;
+/** @brief Seals which keep the contents of a file from changing */
+constexpr int contentSeals = F_SEAL_WRITE | F_SEAL_SHRINK;
+
+/** @brief Whether the package can be mapped from the file as it is */
+bool sealedFile(int fd)
+{
+    struct stat st{};
+    if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode))
+    {
+        return false;
+    }
+    auto seals = fcntl(fd, F_GET_SEALS);
+    return seals >= 0 && (seals & contentSeals) == contentSeals;
+}
+} // namespace
+
+PackageIntake::PackageIntake(sdeventplus::Event& event, sdbusplus::bus_t& bus,
+                             const std::string& path, Process&& process) :
+    event(event),
+    process(std::move(process))
+{
+    vtable.emplace_back(sdbusplus::vtable::start());
+    vtable.emplace_back(sdbusplus::vtable::method(
+        "Upload", "h", "", &PackageIntake::upload, 0));
+    vtable.emplace_back(sdbusplus::vtable::end());
+    object = std::make_unique<sdbusplus::server::interface::interface>(
+        bus, path.c_str(), firmwarePackageIntf, vtable.data(), this);
+}
+
+PackageIntake::~PackageIntake()
+{
+    io.reset();
+    step.reset();
+    if (source >= 0)
+    {
+        close(source);
+    }
+    if (memfd >= 0)
+    {
+        close(memfd);
+    }
+    if (msg)
+    {
+        sd_bus_message_unref(msg);
+    }
+}
+
+int PackageIntake::upload(sd_bus_message* msg, void* context,
+                          sd_bus_error* /*error*/)
+{
+    int fd = -1;
+    auto rc = sd_bus_message_read(msg, "h", &fd);
+    if (rc < 0)
+    {
+        return rc;
+    }
+
+    auto intake = static_cast<PackageIntake*>(context);
+    if (intake->busy())
+    {
+        return -EBUSY;
+    }
+
+    /* The descriptor belongs to the message */
+    fd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        return -errno;
+    }
+
+    if (sealedFile(fd))
+    {
+        info("PLDM FW update package received in a sealed file");
+        if (intake->process(fd))
+        {
+            return -EINVAL;
+        }
+        return sd_bus_reply_method_return(msg, "");
+    }
+
+    rc = intake->receive(fd);
+    if (rc > 0)
+    {
+        /* The call is kept until the package is received */
+        intake->msg = sd_bus_message_ref(msg);
+    }
+    return rc;
+}
+
+int PackageIntake::receive(int fd)
+{
+    memfd = memfd_create("pldm-fw-package", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (memfd < 0)
+    {
+        auto err = errno;
+        close(fd);
+        return -err;
+    }
+    source = fd;
+    received = 0;
+    header.clear();
+    parser.reset();
+    headerParsed = false;
+    buffer.resize(chunkSize);
+
+    try
+    {
+        io = std::make_unique<sdeventplus::source::IO>(
+            event, source, EPOLLIN,
+            [this](sdeventplus::source::IO&, int, uint32_t) { readChunk(); });
+    }
+    catch (const std::exception& e)
+    {
+        /* Regular files can't be polled, they are read one chunk per
+         * event loop iteration instead */
+        step = std::make_unique<sdeventplus::source::Defer>(
+            event, [this](sdeventplus::source::EventBase&) { readChunk(); });
+    }
+    return 1;
+}
+
+void PackageIntake::readChunk()
+{
+    auto length = read(source, buffer.data(), buffer.size());
+    if (length < 0)
+    {
+        if (errno == EINTR || errno == EAGAIN)
+        {
+            return;
+        }
+        auto err = errno;
+        error("Reading the PLDM FW update package failed, ERR={ERR}", "ERR",
+              unsigned(err));
+        finish(-err);
+        return;
+    }
+    if (!length)
+    {
+        auto rc = inspect(true);
+        finish(rc ? rc : complete());
+        return;
+    }
+
+    size_t written = 0;
+    while (written < static_cast<size_t>(length))
+    {
+        auto rc = write(memfd, buffer.data() + written, length - written);
+        if (rc < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (rc < 0)
+        {
+            auto err = errno;
+            error("Storing the PLDM FW update package failed, ERR={ERR}",
+                  "ERR", unsigned(err));
+            finish(-err);
+            return;
+        }
+        written += rc;
+    }
+    received += length;
+    if (!headerParsed)
+    {
+        header.insert(header.end(), buffer.data(), buffer.data() + length);
+    }
+
+    auto rc = inspect(false);
+    if (rc)
+    {
+        finish(rc);
+    }
+}
+
+int PackageIntake::inspect(bool eof)
+{
+    if (!parser && (header.size() >= maxPkgHeaderInfoSize ||
+                    (eof && header.size() >=
+                                sizeof(pldm_package_header_information))))
+    {
+        parser = parsePkgHeader(header);
+        if (!parser)
+        {
+            error("Invalid PLDM package header information");
+            return -EINVAL;
+        }
+    }
+
+    if (parser && !headerParsed && header.size() >= parser->pkgHeaderSize)
+    {
+        try
+        {
+            parser->parseHeader(
+                std::span<const uint8_t>(header).first(parser->pkgHeaderSize));
+        }
+        catch (const std::exception& e)
+        {
+            error("Invalid PLDM package header");
+            return -EINVAL;
+        }
+        headerParsed = true;
+        header.clear();
+        header.shrink_to_fit();
+    }
+
+    if (headerParsed && received > parser->getPkgSize())
+    {
+        error(
+            "PLDM FW update package is longer than its header describes, PKG_SIZE={PKG_SIZE}",
+            "PKG_SIZE", parser->getPkgSize());
+        return -EFBIG;
+    }
+    if (eof && (!headerParsed || received != parser->getPkgSize()))
+    {
+        error(
+            "PLDM FW update package is shorter than its header describes, RECEIVED={RECEIVED}",
+            "RECEIVED", received);
+        return -EINVAL;
+    }
+    return 0;
+}
+
+int PackageIntake::complete()
+{
+    if (fcntl(memfd, F_ADD_SEALS,
+              F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) < 0)
+    {
+        return -errno;
+    }
+    info("PLDM FW update package received, SIZE={SIZE}", "SIZE", received);
+    auto fd = memfd;
+    memfd = -1;
+    return process(fd) ? -EINVAL : 0;
+}
+
+void PackageIntake::finish(int rc)
+{
+    io.reset();
+    step.reset();
+    close(source);
+    source = -1;
+    if (memfd >= 0)
+    {
+        close(memfd);
+        memfd = -1;
+    }
+    header.clear();
+    parser.reset();
+    buffer.clear();
+    buffer.shrink_to_fit();
+
+    auto call = msg;
+    msg = nullptr;
+    auto replyRc = rc ? sd_bus_reply_method_errno(call, -rc, nullptr)
+                      : sd_bus_reply_method_return(call, "");
+    if (replyRc < 0)
+    {
+        error("Failed to reply to the package upload, ERRNO={ERRNO}", "ERRNO",
+              -replyRc);
+    }
+    sd_bus_message_unref(call);
+}
+
+} // namespace fw_update
+
+} // namespace pldm
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "package_parser.hpp"
+
+#include <systemd/sd-bus.h>
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/server/interface.hpp>
+#include <sdbusplus/vtable.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/event.hpp>
+#include <sdeventplus/source/io.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace pldm
+{
+
+namespace fw_update
+{
+
+/** @class PackageIntake
+ *
+ *  Implements com.ampere.PLDM.FirmwarePackage, which takes a firmware update
+ *  package from a file descriptor instead of a copy in /tmp/images.
+ *  Upload(h package) processes a sealed memfd, or any regular file sealed
+ *  against writes and shrinking, in place: the package is mapped from it
+ *  without a copy. Any other descriptor, e.g. a pipe or an unsealed file,
+ *  is streamed once into a memfd of pldmd, one chunk per event loop
+ *  iteration, while the package header is parsed from the first bytes, so
+ *  an invalid header or a package longer than its header describes is
+ *  rejected before the rest is read. The method replies once the package
+ *  was processed, one package is received at a time.
+ */
+class PackageIntake
+{
+  public:
+    /** @brief Process a package, owns the file descriptor
+     *
+     *  @return 0 if the package was processed, -1 otherwise
+     */
+    using Process = std::function<int(int fd)>;
+
+    /** @brief Bytes read per event loop iteration */
+    static constexpr size_t chunkSize = 64 * 1024;
+
+    PackageIntake() = delete;
+    PackageIntake(const PackageIntake&) = delete;
+    PackageIntake& operator=(const PackageIntake&) = delete;
+    ~PackageIntake();
+
+    /** @brief Constructor to put the interface onto bus at a dbus path.
+     *
+     *  @param[in] event - event loop streaming the packages
+     *  @param[in] bus - Bus to attach to
+     *  @param[in] path - Path to attach at
+     *  @param[in] process - processes the packages received
+     */
+    PackageIntake(sdeventplus::Event& event, sdbusplus::bus_t& bus,
+                  const std::string& path, Process&& process);
+
+    /** @brief Whether a package is being received */
+    bool busy() const
+    {
+        return msg != nullptr;
+    }
+
+  private:
+    /** @brief sd-bus handler of FirmwarePackage.Upload */
+    static int upload(sd_bus_message* msg, void* context,
+                      sd_bus_error* error);
+
+    /** @brief Start receiving a package
+     *
+     *  @param[in] fd - file descriptor of the package, owned by the call
+     *
+     *  @return - 1 if the call is replied later, else -errno
+     */
+    int receive(int fd);
+
+    /** @brief Read the next chunk of the package */
+    void readChunk();
+
+    /** @brief Parse the package header as soon as its bytes are received
+     *
+     *  @param[in] eof - no more bytes will be received
+     *
+     *  @return 0 if the package can still be valid, else -errno
+     */
+    int inspect(bool eof);
+
+    /** @brief Seal and process the package received */
+    int complete();
+
+    /** @brief End the reception and reply to the call
+     *
+     *  @param[in] rc - 0 on success, else -errno
+     */
+    void finish(int rc);
+
+    sdeventplus::Event& event;
+    Process process;
+    std::vector<sdbusplus::vtable::vtable_t> vtable;
+    std::unique_ptr<sdbusplus::server::interface::interface> object;
+
+    /** @brief Method call replied once the package was received */
+    sd_bus_message* msg = nullptr;
+    /** @brief Descriptor the package is read from */
+    int source = -1;
+    /** @brief memfd the package is received into */
+    int memfd = -1;
+    uint64_t received = 0;
+    /** @brief Bytes received until the package header is parsed */
+    std::vector<uint8_t> header;
+    std::unique_ptr<PackageParser> parser;
+    bool headerParsed = false;
+    std::vector<uint8_t> buffer;
+    std::unique_ptr<sdeventplus::source::IO> io;
+    std::unique_ptr<sdeventplus::source::Defer> step;
+};
+
+} // namespace fw_update
+
+} // namespace pldm
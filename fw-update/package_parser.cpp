@@ -3,7 +3,6 @@
 #include "common/utils.hpp"
 
 #include <libpldm/firmware_update.h>
-#include <libpldm/utils.h>
 
 #include <phosphor-logging/lg2.hpp>
 #include <xyz/openbmc_project/Common/error.hpp>
@@ -23,7 +22,7 @@ using InternalFailure =
     sdbusplus::xyz::openbmc_project::Common::Error::InternalFailure;
 
 size_t PackageParser::parseFDIdentificationArea(
-    DeviceIDRecordCount deviceIdRecCount, const std::vector<uint8_t>& pkgHdr,
+    DeviceIDRecordCount deviceIdRecCount, std::span<const uint8_t> pkgHdr,
     size_t offset)
 {
     size_t pkgHdrRemainingSize = pkgHdr.size() - offset;
@@ -139,7 +138,7 @@ size_t PackageParser::parseFDIdentificationArea(
 }
 
 size_t PackageParser::parseCompImageInfoArea(ComponentImageCount compImageCount,
-                                             const std::vector<uint8_t>& pkgHdr,
+                                             std::span<const uint8_t> pkgHdr,
                                              size_t offset)
 {
     size_t pkgHdrRemainingSize = pkgHdr.size() - offset;
@@ -217,8 +216,18 @@ void PackageParser::validatePkgTotalSize(uintmax_t pkgSize)
     }
 }
 
-void PackageParserV1::parse(const std::vector<uint8_t>& pkgHdr,
-                            uintmax_t pkgSize)
+uintmax_t PackageParser::getPkgSize() const
+{
+    uintmax_t pkgSize = pkgHeaderSize;
+    for (const auto& componentImageInfo : componentImageInfos)
+    {
+        pkgSize += std::get<static_cast<size_t>(
+            ComponentImageInfoPos::CompSizePos)>(componentImageInfo);
+    }
+    return pkgSize;
+}
+
+void PackageParserV1::parseHeader(std::span<const uint8_t> pkgHdr)
 {
     if (pkgHeaderSize != pkgHdr.size())
     {
@@ -273,7 +282,8 @@ void PackageParserV1::parse(const std::vector<uint8_t>& pkgHdr,
         throw InternalFailure();
     }
 
-    auto calcChecksum = crc32(pkgHdr.data(), offset);
+    auto calcChecksum = pldm::utils::Crc32::of(
+        std::span<const uint8_t>(pkgHdr.data(), offset));
     auto checksum = static_cast<PackageHeaderChecksum>(
         le32toh(pkgHdr[offset] | (pkgHdr[offset + 1] << 8) |
                 (pkgHdr[offset + 2] << 16) | (pkgHdr[offset + 3] << 24)));
@@ -284,11 +294,9 @@ void PackageParserV1::parse(const std::vector<uint8_t>& pkgHdr,
             "CHK_SUM", calcChecksum, "PKG_HDR_CHK_SUM", checksum);
         throw InternalFailure();
     }
-
-    validatePkgTotalSize(pkgSize);
 }
 
-std::unique_ptr<PackageParser> parsePkgHeader(std::vector<uint8_t>& pkgData)
+std::unique_ptr<PackageParser> parsePkgHeader(std::span<const uint8_t> pkgData)
 {
     constexpr std::array<uint8_t, PLDM_FWUP_UUID_LENGTH> hdrIdentifierv1{
         0xF0, 0x18, 0x87, 0x8C, 0xCB, 0x7D, 0x49, 0x43,
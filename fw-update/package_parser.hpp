@@ -7,6 +7,7 @@
 #include <array>
 #include <cstdint>
 #include <memory>
+#include <span>
 #include <tuple>
 #include <vector>
 
@@ -54,13 +55,32 @@ class PackageParser
 
     /** @brief Parse the firmware update package header
      *
-     *  @param[in] pkgHdr - Package header
+     *  @param[in] pkgHdr - Package header, a view of the package which has
+     *                     to outlive the call only
      *  @param[in] pkgSize - Size of the firmware update package
      *
      *  @note Throws exception is parsing fails
      */
-    virtual void parse(const std::vector<uint8_t>& pkgHdr,
-                       uintmax_t pkgSize) = 0;
+    void parse(std::span<const uint8_t> pkgHdr, uintmax_t pkgSize)
+    {
+        parseHeader(pkgHdr);
+        validatePkgTotalSize(pkgSize);
+    }
+
+    /** @brief Parse the firmware update package header alone, e.g. while
+     *         the rest of the package is still received
+     *
+     *  @param[in] pkgHdr - Package header, a view of the package which has
+     *                     to outlive the call only
+     *
+     *  @note Throws exception is parsing fails
+     */
+    virtual void parseHeader(std::span<const uint8_t> pkgHdr) = 0;
+
+    /** @brief Get the size of the package described by the parsed header,
+     *         the header and the component images
+     */
+    uintmax_t getPkgSize() const;
 
     /** @brief Get firmware device ID records from the package
      *
@@ -100,7 +120,7 @@ class PackageParser
      *          device identification area, on error throw exception.
      */
     size_t parseFDIdentificationArea(DeviceIDRecordCount deviceIdRecCount,
-                                     const std::vector<uint8_t>& pkgHdr,
+                                     std::span<const uint8_t> pkgHdr,
                                      size_t offset);
 
     /** @brief Parse the component image information area
@@ -114,7 +134,7 @@ class PackageParser
      *          image information area, on error throw exception.
      */
     size_t parseCompImageInfoArea(ComponentImageCount compImageCount,
-                                  const std::vector<uint8_t>& pkgHdr,
+                                  std::span<const uint8_t> pkgHdr,
                                   size_t offset);
 
     /** @brief Validate the total size of the package
@@ -171,17 +191,19 @@ class PackageParserV1 final : public PackageParser
         PackageParser(pkgHeaderSize, pkgVersion, componentBitmapBitLength)
     {}
 
-    virtual void parse(const std::vector<uint8_t>& pkgHdr, uintmax_t pkgSize);
+    void parseHeader(std::span<const uint8_t> pkgHdr) override;
 };
 
 /** @brief Parse the package header information
  *
- *  @param[in] pkgHdrInfo - package header information section in the package
+ *  @param[in] pkgHdrInfo - package header information section in the package,
+ *                          trailing package data is ignored
  *
  *  @return On success return the PackageParser for the header format version
  *          on failure return nullptr
  */
-std::unique_ptr<PackageParser> parsePkgHeader(std::vector<uint8_t>& pkgHdrInfo);
+std::unique_ptr<PackageParser>
+    parsePkgHeader(std::span<const uint8_t> pkgHdrInfo);
 
 } // namespace fw_update
 
@@ -0,0 +1,142 @@
+#include "package_verifier.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <cerrno>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+
+namespace fw_update
+{
+
+namespace
+{
+/** @brief Open the package, the failure is logged */
+int openPackage(const std::filesystem::path& packageFilePath)
+{
+    int fd = open(packageFilePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        error(
+            "Opening the PLDM FW update package for verification failed, ERR={ERR}, PACKAGEFILE={PKG_FILE}",
+            "ERR", unsigned(errno), "PKG_FILE", packageFilePath.c_str());
+    }
+    return fd;
+}
+} // namespace
+
+PackageVerifier::PackageVerifier(sdeventplus::Event& event,
+                                 const std::filesystem::path& packageFilePath,
+                                 const ComponentImageInfos& compImageInfos,
+                                 Callback&& callback) :
+    PackageVerifier(event, openPackage(packageFilePath), compImageInfos,
+                    std::move(callback))
+{}
+
+PackageVerifier::PackageVerifier(sdeventplus::Event& event, int fd,
+                                 const ComponentImageInfos& compImageInfos,
+                                 Callback&& callback) :
+    compImageInfos(compImageInfos),
+    callback(std::move(callback)), fd(fd)
+{
+    if (fd >= 0)
+    {
+        posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    }
+    buffer.resize(chunkSize);
+    checksums.reserve(compImageInfos.size());
+
+    /* The failure to open is reported from the event loop as well, the
+     * callback is never invoked from the constructor */
+    step = std::make_unique<sdeventplus::source::Defer>(
+        event, [this](sdeventplus::source::EventBase&) { verifyChunk(); });
+}
+
+PackageVerifier::~PackageVerifier()
+{
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+}
+
+void PackageVerifier::verifyChunk()
+{
+    if (fd < 0)
+    {
+        finish(false);
+        return;
+    }
+    if (compIndex == compImageInfos.size())
+    {
+        finish(true);
+        return;
+    }
+
+    const auto& compImageInfo = compImageInfos[compIndex];
+    auto location = std::get<static_cast<size_t>(
+        ComponentImageInfoPos::CompLocationOffsetPos)>(compImageInfo);
+    auto size = std::get<static_cast<size_t>(
+        ComponentImageInfoPos::CompSizePos)>(compImageInfo);
+
+    auto length = static_cast<size_t>(
+        std::min<uint64_t>(size - compOffset, buffer.size()));
+    if (length)
+    {
+        auto rc = pread(fd, buffer.data(), length, location + compOffset);
+        if (rc != static_cast<ssize_t>(length))
+        {
+            const auto& version = std::get<static_cast<size_t>(
+                ComponentImageInfoPos::CompVersionPos)>(compImageInfo);
+            error(
+                "Reading the component image failed, COMP_VERSION={COMP_VERS}, OFFSET={OFFSET}, RC={RC}, ERR={ERR}",
+                "COMP_VERS", version, "OFFSET", compOffset, "RC", rc, "ERR",
+                unsigned(errno));
+            finish(false);
+            return;
+        }
+        crc.update({buffer.data(), length});
+        compOffset += length;
+    }
+
+    if (compOffset == size)
+    {
+        const auto& version = std::get<static_cast<size_t>(
+            ComponentImageInfoPos::CompVersionPos)>(compImageInfo);
+        info(
+            "Component image verified, COMP_VERSION={COMP_VERS}, SIZE={SIZE}, CRC32={CRC}",
+            "COMP_VERS", version, "SIZE", size, "CRC", lg2::hex, crc.value());
+        checksums.push_back(crc.value());
+        crc.reset();
+        compOffset = 0;
+        compIndex++;
+    }
+}
+
+void PackageVerifier::finish(bool status)
+{
+    result = status;
+    step.reset();
+    if (fd >= 0)
+    {
+        close(fd);
+        fd = -1;
+    }
+    buffer.clear();
+    buffer.shrink_to_fit();
+
+    /* The callback may destroy the verifier */
+    auto cb = std::move(callback);
+    cb(status);
+}
+
+} // namespace fw_update
+
+} // namespace pldm
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "common/types.hpp"
+#include "common/utils.hpp"
+
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/event.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace pldm
+{
+
+namespace fw_update
+{
+
+/** @class PackageVerifier
+ *
+ *  Reads back the component images of a firmware update package from the
+ *  file in the background and computes their CRC-32, one chunk per event
+ *  loop iteration, so a package which can't be read in full is rejected
+ *  before any FD is updated. The file is read with pread(), an I/O error
+ *  or a package truncated after it was mapped fails the verification
+ *  instead of faulting the mapping in the middle of a transfer.
+ */
+class PackageVerifier
+{
+  public:
+    /** @brief Callback with the result of the verification */
+    using Callback = std::function<void(bool)>;
+
+    /** @brief Bytes read per event loop iteration */
+    static constexpr size_t chunkSize = 64 * 1024;
+
+    PackageVerifier() = delete;
+    PackageVerifier(const PackageVerifier&) = delete;
+    PackageVerifier(PackageVerifier&&) = delete;
+    PackageVerifier& operator=(const PackageVerifier&) = delete;
+    PackageVerifier& operator=(PackageVerifier&&) = delete;
+    ~PackageVerifier();
+
+    /** @brief Constructor, the verification starts at the next event loop
+     *         iteration
+     *
+     *  @param[in] event - event loop running the verification
+     *  @param[in] packageFilePath - path of the package
+     *  @param[in] compImageInfos - component images of the package
+     *  @param[in] callback - invoked once with true if all the component
+     *                        images were read, the verifier may be
+     *                        destroyed from it
+     */
+    PackageVerifier(sdeventplus::Event& event,
+                    const std::filesystem::path& packageFilePath,
+                    const ComponentImageInfos& compImageInfos,
+                    Callback&& callback);
+
+    /** @brief Constructor reading the package from a file descriptor, e.g.
+     *         a memfd
+     *
+     *  @param[in] event - event loop running the verification
+     *  @param[in] fd - file descriptor of the package, owned by the
+     *                  verifier, the verification fails if it is negative
+     *  @param[in] compImageInfos - component images of the package
+     *  @param[in] callback - invoked once with true if all the component
+     *                        images were read
+     */
+    PackageVerifier(sdeventplus::Event& event, int fd,
+                    const ComponentImageInfos& compImageInfos,
+                    Callback&& callback);
+
+    /** @brief Whether the verification is over */
+    bool done() const
+    {
+        return !step;
+    }
+
+    /** @brief Whether all the component images were read */
+    bool passed() const
+    {
+        return done() && result;
+    }
+
+    /** @brief CRC-32 of the component images verified so far */
+    const std::vector<uint32_t>& getChecksums() const
+    {
+        return checksums;
+    }
+
+  private:
+    /** @brief Read the next chunk of the current component image */
+    void verifyChunk();
+
+    /** @brief End the verification and report the result */
+    void finish(bool status);
+
+    const ComponentImageInfos compImageInfos;
+    Callback callback;
+    int fd = -1;
+    /** @brief Component image being read, and the offset within it */
+    size_t compIndex = 0;
+    uint64_t compOffset = 0;
+    pldm::utils::Crc32 crc;
+    std::vector<uint8_t> buffer;
+    std::vector<uint32_t> checksums;
+    bool result = false;
+    std::unique_ptr<sdeventplus::source::Defer> step;
+};
+
+} // namespace fw_update
+
+} // namespace pldm
@@ -6,6 +6,9 @@
 
 #include <libpldm/firmware_update.h>
 
+#include <fstream>
+#include <iterator>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -30,10 +33,15 @@ class DeviceUpdaterTest : public testing::Test
         compImageInfos = {
             {10, 100, 0xFFFFFFFF, 0, 0, 139, 1024, "VersionString3"}};
         compInfo = {{std::make_pair(10, 100), 1}};
+
+        std::ifstream packageFile("./test_pkg", std::ios::binary);
+        packageData.assign(std::istreambuf_iterator<char>(packageFile),
+                           std::istreambuf_iterator<char>());
     }
 
     int fd = -1;
     std::ifstream package;
+    std::vector<uint8_t> packageData;
     FirmwareDeviceIDRecord fwDeviceIDRecord;
     ComponentImageInfos compImageInfos;
     ComponentInfo compInfo;
@@ -81,8 +89,8 @@ TEST_F(DeviceUpdaterTest, validatePackage)
 
 TEST_F(DeviceUpdaterTest, ReadPackage512B)
 {
-    DeviceUpdater deviceUpdater(0, package, fwDeviceIDRecord, compImageInfos,
-                                compInfo, 512, nullptr);
+    DeviceUpdater deviceUpdater(0, packageData, fwDeviceIDRecord,
+                                compImageInfos, compInfo, 512, nullptr);
 
     constexpr std::array<uint8_t, sizeof(pldm_msg_hdr) +
                                       sizeof(pldm_request_firmware_data_req)>
@@ -150,3 +158,64 @@ TEST_F(DeviceUpdaterTest, ReadPackage512B)
         0xA2, 0x72, 0x33, 0x00, 0x3C, 0x7E, 0x28, 0x36, 0x10, 0x90, 0x38, 0xFB};
     EXPECT_EQ(response, compFirst512B);
 }
+
+TEST_F(DeviceUpdaterTest, ReadTruncatedPackage)
+{
+    /* The component image ends beyond the end of the package */
+    packageData.resize(600);
+    DeviceUpdater deviceUpdater(0, packageData, fwDeviceIDRecord,
+                                compImageInfos, compInfo, 512, nullptr);
+
+    constexpr std::array<uint8_t, sizeof(pldm_msg_hdr) +
+                                      sizeof(pldm_request_firmware_data_req)>
+        reqFwDataReq{0x8A, 0x05, 0x15, 0x00, 0x00, 0x00,
+                     0x00, 0x00, 0x02, 0x00, 0x00};
+    auto requestMsg = reinterpret_cast<const pldm_msg*>(reqFwDataReq.data());
+    auto response = deviceUpdater.requestFwData(
+        requestMsg, sizeof(pldm_request_firmware_data_req));
+
+    EXPECT_EQ(response.size(), sizeof(pldm_msg_hdr) + sizeof(uint8_t));
+    EXPECT_EQ(response[sizeof(pldm_msg_hdr)], PLDM_FWUP_DATA_OUT_OF_RANGE);
+}
+
+TEST_F(DeviceUpdaterTest, SkipCurrentComponents)
+{
+    DeviceUpdater deviceUpdater(0, packageData, fwDeviceIDRecord,
+                                compImageInfos, compInfo, 512, nullptr);
+    EXPECT_EQ(deviceUpdater.numComponents(), 1u);
+
+    /* The package doesn't use the comparison stamp, only the version
+     * strings are compared */
+    ActiveComponentVersions older{
+        {std::make_pair(10, 100), std::make_tuple(0, "VersionString2")}};
+    EXPECT_EQ(deviceUpdater.skipCurrentComponents(older), 0u);
+    EXPECT_EQ(deviceUpdater.numComponents(), 1u);
+
+    ActiveComponentVersions otherComponent{
+        {std::make_pair(10, 101), std::make_tuple(0, "VersionString3")}};
+    EXPECT_EQ(deviceUpdater.skipCurrentComponents(otherComponent), 0u);
+    EXPECT_EQ(deviceUpdater.numComponents(), 1u);
+
+    ActiveComponentVersions current{
+        {std::make_pair(10, 100), std::make_tuple(0, "VersionString3")}};
+    EXPECT_EQ(deviceUpdater.skipCurrentComponents(current), 1u);
+    EXPECT_EQ(deviceUpdater.numComponents(), 0u);
+}
+
+TEST_F(DeviceUpdaterTest, SkipCurrentComponentsComparisonStamp)
+{
+    ComponentImageInfos stampedImageInfos{
+        {10, 100, 0x20, 0, 0, 139, 1024, "VersionString3"}};
+    DeviceUpdater deviceUpdater(0, packageData, fwDeviceIDRecord,
+                                stampedImageInfos, compInfo, 512, nullptr);
+
+    /* Same version string but another build */
+    ActiveComponentVersions otherStamp{
+        {std::make_pair(10, 100), std::make_tuple(0x1F, "VersionString3")}};
+    EXPECT_EQ(deviceUpdater.skipCurrentComponents(otherStamp), 0u);
+
+    ActiveComponentVersions current{
+        {std::make_pair(10, 100), std::make_tuple(0x20, "VersionString3")}};
+    EXPECT_EQ(deviceUpdater.skipCurrentComponents(current), 1u);
+    EXPECT_EQ(deviceUpdater.numComponents(), 0u);
+}
@@ -0,0 +1,326 @@
+/** @file fw_update_bench.cpp
+ *
+ *  Throughput benchmark of the firmware data path. Simulated FDs request the
+ *  image of one component from a DeviceUpdater each, all the updaters read
+ *  the same package, and the run reports the throughput, the latency
+ *  percentiles of RequestFirmwareData and the CPU time used.
+ *
+ *  Usage: fw_update_bench [--size BYTES] [--chunk BYTES] [--fds N]
+ *                         [--latency USEC] [--package FILE]
+ */
+
+#include "fw-update/device_updater.hpp"
+
+#include <fcntl.h>
+#include <getopt.h>
+#include <libpldm/firmware_update.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/utility/timer.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+using namespace pldm;
+using namespace pldm::fw_update;
+using Clock = std::chrono::steady_clock;
+using Timer = sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>;
+
+namespace
+{
+
+struct Options
+{
+    size_t size = 64 * 1024 * 1024;
+    uint32_t chunk = 4096;
+    size_t fds = 1;
+    std::chrono::microseconds latency{0};
+    const char* package = nullptr;
+};
+
+/** @brief FD which requests the whole component, one chunk at a time */
+class SimulatedFD
+{
+  public:
+    SimulatedFD(sdeventplus::Event& event, DeviceUpdater& updater,
+                const Options& options, uint32_t compSize,
+                std::vector<double>& latencies) :
+        updater(updater),
+        options(options), compSize(compSize), latencies(latencies)
+    {
+        if (options.latency.count())
+        {
+            timer.emplace(event, [this](Timer&) { requestChunk(); });
+        }
+    }
+
+    /** @brief Request the chunks until the component is received
+     *
+     *  @return false on an error response
+     */
+    bool run()
+    {
+        if (timer)
+        {
+            /* The next chunks are requested as the timer expires */
+            requestChunk();
+            return !failed;
+        }
+        while (!finished())
+        {
+            requestChunk();
+        }
+        return !failed;
+    }
+
+    bool finished() const
+    {
+        return done || failed;
+    }
+
+    bool ok() const
+    {
+        return !failed;
+    }
+
+    size_t bytes = 0;
+
+  private:
+    void requestChunk()
+    {
+        if (finished())
+        {
+            return;
+        }
+        std::array<uint8_t, sizeof(pldm_msg_hdr) +
+                                sizeof(pldm_request_firmware_data_req)>
+            request{};
+        auto requestMsg = reinterpret_cast<pldm_msg*>(request.data());
+        /* The last request covers the rest of the image, padded up to the
+         * baseline transfer size */
+        uint32_t length = std::min<uint32_t>(
+            options.chunk, std::max<uint32_t>(compSize - offset,
+                                              PLDM_FWUP_BASELINE_TRANSFER_SIZE));
+        if (encode_request_firmware_data_req(
+                0, offset, length, requestMsg,
+                sizeof(pldm_request_firmware_data_req)))
+        {
+            failed = true;
+            return;
+        }
+
+        auto start = Clock::now();
+        auto response = updater.requestFwData(
+            requestMsg, sizeof(pldm_request_firmware_data_req));
+        latencies.push_back(
+            std::chrono::duration<double, std::micro>(Clock::now() - start)
+                .count());
+
+        if (response.size() <= sizeof(pldm_msg_hdr) ||
+            response[sizeof(pldm_msg_hdr)] != PLDM_SUCCESS)
+        {
+            failed = true;
+            return;
+        }
+        bytes += std::min(length, compSize - offset);
+        offset += length;
+        done = offset >= compSize;
+        if (timer && !finished())
+        {
+            timer->restartOnce(options.latency);
+        }
+    }
+
+    DeviceUpdater& updater;
+    const Options& options;
+    uint32_t compSize;
+    std::vector<double>& latencies;
+    std::optional<Timer> timer;
+    uint32_t offset = 0;
+    bool done = false;
+    bool failed = false;
+};
+
+void usage()
+{
+    fprintf(stderr,
+            "Usage: fw_update_bench [--size BYTES] [--chunk BYTES] [--fds N] "
+            "[--latency USEC] [--package FILE]\n");
+}
+
+double percentile(const std::vector<double>& sorted, double p)
+{
+    if (sorted.empty())
+    {
+        return 0;
+    }
+    auto index = static_cast<size_t>(p * (sorted.size() - 1));
+    return sorted[index];
+}
+
+double cpuSeconds()
+{
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+           (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    static struct option longOptions[] = {
+        {"size", required_argument, 0, 's'},
+        {"chunk", required_argument, 0, 'c'},
+        {"fds", required_argument, 0, 'f'},
+        {"latency", required_argument, 0, 'l'},
+        {"package", required_argument, 0, 'p'},
+        {0, 0, 0, 0}};
+
+    int opt = 0;
+    while ((opt = getopt_long(argc, argv, "s:c:f:l:p:", longOptions,
+                              nullptr)) != -1)
+    {
+        switch (opt)
+        {
+            case 's':
+                options.size = strtoull(optarg, nullptr, 0);
+                break;
+            case 'c':
+                options.chunk = strtoul(optarg, nullptr, 0);
+                break;
+            case 'f':
+                options.fds = std::max<size_t>(strtoul(optarg, nullptr, 0), 1);
+                break;
+            case 'l':
+                options.latency =
+                    std::chrono::microseconds(strtoul(optarg, nullptr, 0));
+                break;
+            case 'p':
+                options.package = optarg;
+                break;
+            default:
+                usage();
+                return EXIT_FAILURE;
+        }
+    }
+    if (options.chunk < PLDM_FWUP_BASELINE_TRANSFER_SIZE)
+    {
+        fprintf(stderr, "The chunk size is at least %d bytes\n",
+                PLDM_FWUP_BASELINE_TRANSFER_SIZE);
+        return EXIT_FAILURE;
+    }
+
+    /* The package is either a file mapped the way UpdateManager maps it,
+     * or a buffer in memory holding a single component image */
+    std::vector<uint8_t> buffer;
+    std::span<const uint8_t> package;
+    if (options.package)
+    {
+        int fd = open(options.package, O_RDONLY | O_CLOEXEC);
+        struct stat st;
+        if (fd < 0 || fstat(fd, &st) || !st.st_size)
+        {
+            perror(options.package);
+            return EXIT_FAILURE;
+        }
+        auto data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED)
+        {
+            perror("mmap");
+            return EXIT_FAILURE;
+        }
+        madvise(data, st.st_size, MADV_SEQUENTIAL);
+        package = {static_cast<const uint8_t*>(data),
+                   static_cast<size_t>(st.st_size)};
+    }
+    else
+    {
+        buffer.resize(options.size);
+        for (size_t i = 0; i < buffer.size(); i++)
+        {
+            buffer[i] = static_cast<uint8_t>(i * 7);
+        }
+        package = buffer;
+    }
+    auto compSize = static_cast<uint32_t>(
+        std::min<size_t>(package.size(), UINT32_MAX));
+
+    FirmwareDeviceIDRecord fwDeviceIDRecord{1, {0}, "Bench", {}, {}};
+    ComponentImageInfos compImageInfos{
+        {10, 100, 0xFFFFFFFF, 0, 0, 0, compSize, "BenchImage"}};
+    ComponentInfo compInfo{{std::make_pair(10, 100), 1}};
+
+    auto event = sdeventplus::Event::get_default();
+    std::vector<std::unique_ptr<DeviceUpdater>> updaters;
+    std::vector<std::vector<double>> latencies(options.fds);
+    std::vector<std::unique_ptr<SimulatedFD>> fds;
+    for (size_t i = 0; i < options.fds; i++)
+    {
+        updaters.emplace_back(std::make_unique<DeviceUpdater>(
+            static_cast<mctp_eid_t>(i + 8), package, fwDeviceIDRecord,
+            compImageInfos, compInfo, options.chunk, nullptr));
+        latencies[i].reserve(compSize / options.chunk + 1);
+        fds.emplace_back(std::make_unique<SimulatedFD>(
+            event, *updaters.back(), options, compSize, latencies[i]));
+    }
+
+    auto cpuStart = cpuSeconds();
+    auto start = Clock::now();
+    bool ok = true;
+    for (auto& fd : fds)
+    {
+        ok &= fd->run();
+    }
+    /* With a latency the FDs interleave on the event loop */
+    while (ok && std::any_of(fds.begin(), fds.end(),
+                             [](const auto& fd) { return !fd->finished(); }))
+    {
+        event.run(std::nullopt);
+    }
+    auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    auto cpu = cpuSeconds() - cpuStart;
+
+    size_t bytes = 0;
+    std::vector<double> all;
+    for (size_t i = 0; i < fds.size(); i++)
+    {
+        ok &= fds[i]->ok();
+        bytes += fds[i]->bytes;
+        all.insert(all.end(), latencies[i].begin(), latencies[i].end());
+    }
+    std::sort(all.begin(), all.end());
+
+    printf("fds %zu, image %u bytes, chunk %u bytes, latency %lldus\n",
+           options.fds, compSize, options.chunk,
+           static_cast<long long>(options.latency.count()));
+    printf("transferred %zu bytes in %.3fs: %.2f MB/s\n", bytes, elapsed,
+           elapsed > 0 ? bytes / elapsed / 1e6 : 0);
+    printf("RequestFirmwareData %zu: p50 %.2fus p90 %.2fus p99 %.2fus "
+           "max %.2fus\n",
+           all.size(), percentile(all, 0.5), percentile(all, 0.9),
+           percentile(all, 0.99), all.empty() ? 0 : all.back());
+    printf("cpu %.3fs (%.1f%% of the run)\n", cpu,
+           elapsed > 0 ? 100 * cpu / elapsed : 0);
+
+    if (options.package)
+    {
+        munmap(const_cast<uint8_t*>(package.data()), package.size());
+    }
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -1,5 +1,6 @@
 #include "fw-update/package_parser.hpp"
 
+#include <span>
 #include <typeinfo>
 
 #include <gmock/gmock.h>
@@ -181,3 +182,69 @@ TEST(PackageParser, InvalidPkgBadChecksum)
     EXPECT_EQ(parser->pkgVersion, pkgVersion);
     EXPECT_THROW(parser->parse(fwPkgHdr, pkgSize), std::exception);
 }
+
+TEST(PackageParser, ValidPkgParsedInPlace)
+{
+    std::vector<uint8_t> package{
+        0xF0, 0x18, 0x87, 0x8C, 0xCB, 0x7D, 0x49, 0x43, 0x98, 0x00, 0xA0, 0x2F,
+        0x05, 0x9A, 0xCA, 0x02, 0x01, 0x8B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x19, 0x0C, 0xE5, 0x07, 0x00, 0x08, 0x00, 0x01, 0x0E,
+        0x56, 0x65, 0x72, 0x73, 0x69, 0x6F, 0x6E, 0x53, 0x74, 0x72, 0x69, 0x6E,
+        0x67, 0x31, 0x01, 0x2E, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x01, 0x0E,
+        0x00, 0x00, 0x01, 0x56, 0x65, 0x72, 0x73, 0x69, 0x6F, 0x6E, 0x53, 0x74,
+        0x72, 0x69, 0x6E, 0x67, 0x32, 0x02, 0x00, 0x10, 0x00, 0x16, 0x20, 0x23,
+        0xC9, 0x3E, 0xC5, 0x41, 0x15, 0x95, 0xF4, 0x48, 0x70, 0x1D, 0x49, 0xD6,
+        0x75, 0x01, 0x00, 0x0A, 0x00, 0x64, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0x00,
+        0x00, 0x00, 0x00, 0x8B, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x01,
+        0x0E, 0x56, 0x65, 0x72, 0x73, 0x69, 0x6F, 0x6E, 0x53, 0x74, 0x72, 0x69,
+        0x6E, 0x67, 0x33, 0x4F, 0x96, 0xAE, 0x56};
+    constexpr size_t pkgHdrSize = 139;
+    constexpr uintmax_t pkgSize = 166;
+    package.resize(pkgSize, 0xAA);
+
+    /* The header is parsed from a view of the whole package */
+    std::span<const uint8_t> view{package};
+    auto parser = parsePkgHeader(view);
+    ASSERT_NE(parser, nullptr);
+    EXPECT_EQ(parser->pkgHeaderSize, pkgHdrSize);
+
+    parser->parse(view.first(parser->pkgHeaderSize), pkgSize);
+    ASSERT_EQ(parser->getFwDeviceIDRecords().size(), 1u);
+    ASSERT_EQ(parser->getComponentImageInfos().size(), 1u);
+    EXPECT_EQ(std::get<2>(parser->getFwDeviceIDRecords()[0]),
+              "VersionString2");
+
+    /* Parsing the whole package as the header fails */
+    EXPECT_THROW(parser->parse(view, pkgSize), std::exception);
+}
+
+TEST(PackageParser, HeaderParsedBeforeThePackageSize)
+{
+    std::vector<uint8_t> fwPkgHdr{
+        0xF0, 0x18, 0x87, 0x8C, 0xCB, 0x7D, 0x49, 0x43, 0x98, 0x00, 0xA0, 0x2F,
+        0x05, 0x9A, 0xCA, 0x02, 0x01, 0x8B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x19, 0x0C, 0xE5, 0x07, 0x00, 0x08, 0x00, 0x01, 0x0E,
+        0x56, 0x65, 0x72, 0x73, 0x69, 0x6F, 0x6E, 0x53, 0x74, 0x72, 0x69, 0x6E,
+        0x67, 0x31, 0x01, 0x2E, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x01, 0x0E,
+        0x00, 0x00, 0x01, 0x56, 0x65, 0x72, 0x73, 0x69, 0x6F, 0x6E, 0x53, 0x74,
+        0x72, 0x69, 0x6E, 0x67, 0x32, 0x02, 0x00, 0x10, 0x00, 0x16, 0x20, 0x23,
+        0xC9, 0x3E, 0xC5, 0x41, 0x15, 0x95, 0xF4, 0x48, 0x70, 0x1D, 0x49, 0xD6,
+        0x75, 0x01, 0x00, 0x0A, 0x00, 0x64, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0x00,
+        0x00, 0x00, 0x00, 0x8B, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x01,
+        0x0E, 0x56, 0x65, 0x72, 0x73, 0x69, 0x6F, 0x6E, 0x53, 0x74, 0x72, 0x69,
+        0x6E, 0x67, 0x33, 0x4F, 0x96, 0xAE, 0x56};
+
+    /* The size of the package is known from its header alone */
+    auto parser = parsePkgHeader(fwPkgHdr);
+    ASSERT_NE(parser, nullptr);
+    parser->parseHeader(fwPkgHdr);
+    EXPECT_EQ(parser->getPkgSize(), 166u);
+    EXPECT_EQ(parser->getComponentImageInfos().size(), 1u);
+
+    /* A truncated header fails */
+    auto truncated = parsePkgHeader(fwPkgHdr);
+    ASSERT_NE(truncated, nullptr);
+    EXPECT_THROW(truncated->parseHeader(std::span<const uint8_t>(fwPkgHdr).first(
+                     fwPkgHdr.size() - 8)),
+                 std::exception);
+}
@@ -0,0 +1,74 @@
+#include "fw-update/package_verifier.hpp"
+
+#include <libpldm/utils.h>
+
+#include <sdeventplus/event.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::fw_update;
+
+class PackageVerifierTest : public testing::Test
+{
+  protected:
+    PackageVerifierTest() : event(sdeventplus::Event::get_default())
+    {
+        compImageInfos = {
+            {10, 100, 0xFFFFFFFF, 0, 0, 139, 1024, "VersionString3"}};
+
+        std::ifstream packageFile("./test_pkg", std::ios::binary);
+        packageData.assign(std::istreambuf_iterator<char>(packageFile),
+                           std::istreambuf_iterator<char>());
+    }
+
+    /** @brief Run the event loop until the verification ends */
+    std::optional<bool> verify(const std::filesystem::path& path)
+    {
+        std::optional<bool> result;
+        PackageVerifier verifier(event, path, compImageInfos,
+                                 [&result](bool status) { result = status; });
+        EXPECT_FALSE(result.has_value());
+        while (!verifier.done())
+        {
+            sd_event_run(event.get(), 100000);
+        }
+        checksums = verifier.getChecksums();
+        return result;
+    }
+
+    sdeventplus::Event event;
+    ComponentImageInfos compImageInfos;
+    std::vector<uint8_t> packageData;
+    std::vector<uint32_t> checksums;
+};
+
+TEST_F(PackageVerifierTest, VerifyComponentImages)
+{
+    ASSERT_EQ(packageData.size(), 1163u);
+    EXPECT_EQ(verify("./test_pkg"), true);
+    ASSERT_EQ(checksums.size(), 1u);
+    EXPECT_EQ(checksums[0], crc32(packageData.data() + 139, 1024));
+}
+
+TEST_F(PackageVerifierTest, TruncatedPackage)
+{
+    auto path = std::filesystem::temp_directory_path() /
+                "package_verifier_test_pkg";
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(packageData.data()), 600);
+    }
+    EXPECT_EQ(verify(path), false);
+    EXPECT_TRUE(checksums.empty());
+    std::filesystem::remove(path);
+}
+
+TEST_F(PackageVerifierTest, MissingPackage)
+{
+    EXPECT_EQ(verify("./no_such_pkg"), false);
+}
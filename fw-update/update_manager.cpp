@@ -3,14 +3,21 @@
 #include "activation.hpp"
 #include "common/utils.hpp"
 #include "package_parser.hpp"
+#include "package_verifier.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
 #include <cassert>
-#include <cmath>
 #include <filesystem>
-#include <fstream>
+#include <stdexcept>
 #include <string>
+#include <utility>
 
 PHOSPHOR_LOG2_USING;
 
@@ -25,9 +32,33 @@ namespace software = sdbusplus::xyz::openbmc_project::Software::server;
 
 int UpdateManager::processPackage(const std::filesystem::path& packageFilePath)
 {
-    // If no devices discovered, take no action on the package.
+    int fd = open(packageFilePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        error(
+            "Opening the PLDM FW update package failed, ERR={ERR}, PACKAGEFILE={PKG_FILE}",
+            "ERR", unsigned(errno), "PKG_FILE", packageFilePath.c_str());
+        std::filesystem::remove(packageFilePath);
+        return -1;
+    }
+    return processPackage(fd, packageFilePath);
+}
+
+int UpdateManager::processPackage(int fd,
+                                  const std::filesystem::path& packageFilePath)
+{
+    // If no devices discovered, take no action on the package until the
+    // devices being discovered are known.
     if (!descriptorMap.size())
     {
+        if (discoveryPending)
+        {
+            deferPackage(fd, packageFilePath);
+        }
+        else
+        {
+            close(fd);
+        }
         return 0;
     }
 
@@ -42,7 +73,7 @@ int UpdateManager::processPackage(const std::filesystem::path& packageFilePath)
             error(
                 "Activation of PLDM FW update package already in progress, PACKAGE_VERSION={PKG_VERS}",
                 "PKG_VERS", parser->pkgVersion);
-            std::filesystem::remove(packageFilePath);
+            discardPackage(fd, packageFilePath);
             return -1;
         }
         else
@@ -51,51 +82,30 @@ int UpdateManager::processPackage(const std::filesystem::path& packageFilePath)
         }
     }
 
-    package.open(packageFilePath,
-                 std::ios::binary | std::ios::in | std::ios::ate);
-    if (!package.good())
+    if (!mapPackage(fd))
     {
-        error(
-            "Opening the PLDM FW update package failed, ERR={ERR}, PACKAGEFILE={PKG_FILE}",
-            "ERR", unsigned(errno), "PKG_FILE", packageFilePath.c_str());
-        package.close();
-        std::filesystem::remove(packageFilePath);
+        discardPackage(fd, packageFilePath);
         return -1;
     }
 
-    uintmax_t packageSize = package.tellg();
+    uintmax_t packageSize = package.size();
     if (packageSize < sizeof(pldm_package_header_information))
     {
         error(
             "PLDM FW update package length less than the length of the package header information, PACKAGESIZE={PKG_SIZE}",
             "PKG_SIZE", packageSize);
-        package.close();
-        std::filesystem::remove(packageFilePath);
+        unmapPackage();
+        discardPackage(fd, packageFilePath);
         return -1;
     }
 
-    package.seekg(0);
-    std::vector<uint8_t> packageHeader(sizeof(pldm_package_header_information));
-    package.read(reinterpret_cast<char*>(packageHeader.data()),
-                 sizeof(pldm_package_header_information));
-
-    auto pkgHeaderInfo =
-        reinterpret_cast<const pldm_package_header_information*>(
-            packageHeader.data());
-    auto pkgHeaderInfoSize = sizeof(pldm_package_header_information) +
-                             pkgHeaderInfo->package_version_string_length;
-    packageHeader.clear();
-    packageHeader.resize(pkgHeaderInfoSize);
-    package.seekg(0);
-    package.read(reinterpret_cast<char*>(packageHeader.data()),
-                 pkgHeaderInfoSize);
-
-    parser = parsePkgHeader(packageHeader);
+    /* The header is parsed in place from the mapping of the package */
+    parser = parsePkgHeader(package);
     if (parser == nullptr)
     {
         error("Invalid PLDM package header information");
-        package.close();
-        std::filesystem::remove(packageFilePath);
+        unmapPackage();
+        discardPackage(fd, packageFilePath);
         return -1;
     }
 
@@ -103,13 +113,16 @@ int UpdateManager::processPackage(const std::filesystem::path& packageFilePath)
     size_t versionHash = std::hash<std::string>{}(parser->pkgVersion);
     objPath = swRootPath + std::to_string(versionHash);
 
-    package.seekg(0);
-    packageHeader.resize(parser->pkgHeaderSize);
-    package.read(reinterpret_cast<char*>(packageHeader.data()),
-                 parser->pkgHeaderSize);
     try
     {
-        parser->parse(packageHeader, packageSize);
+        if (parser->pkgHeaderSize > packageSize)
+        {
+            error(
+                "PLDM FW update package is shorter than its header, PKG_HDR_SIZE={PKG_HDR_SIZE}, PKG_SIZE={PKG_SIZE}",
+                "PKG_HDR_SIZE", parser->pkgHeaderSize, "PKG_SIZE", packageSize);
+            throw std::out_of_range("package header");
+        }
+        parser->parse(package.first(parser->pkgHeaderSize), packageSize);
     }
     catch (const std::exception& e)
     {
@@ -117,14 +130,27 @@ int UpdateManager::processPackage(const std::filesystem::path& packageFilePath)
         activation = std::make_unique<Activation>(
             pldm::utils::DBusHandler::getBus(), objPath,
             software::Activation::Activations::Invalid, this);
-        package.close();
+        unmapPackage();
         parser.reset();
+        close(fd);
         return -1;
     }
 
     auto deviceUpdaterInfos =
         associatePkgToDevices(parser->getFwDeviceIDRecords(), descriptorMap,
                               totalNumComponentUpdates);
+    if (discoveryPending &&
+        !allRecordsMatched(deviceUpdaterInfos,
+                           parser->getFwDeviceIDRecords().size()))
+    {
+        /* Retried as more FDs are discovered */
+        unmapPackage();
+        parser.reset();
+        objPath.clear();
+        totalNumComponentUpdates = 0;
+        deferPackage(fd, packageFilePath);
+        return 0;
+    }
     if (!deviceUpdaterInfos.size())
     {
         error(
@@ -132,11 +158,23 @@ int UpdateManager::processPackage(const std::filesystem::path& packageFilePath)
         activation = std::make_unique<Activation>(
             pldm::utils::DBusHandler::getBus(), objPath,
             software::Activation::Activations::Invalid, this);
-        package.close();
+        unmapPackage();
         parser.reset();
+        close(fd);
         return 0;
     }
 
+#ifdef FW_UPDATE_VERIFY_PACKAGE
+    /* Read back the component images while the package waits for the
+     * activation request, the verifier owns the descriptor */
+    verifier = std::make_unique<PackageVerifier>(
+        event, fd, parser->getComponentImageInfos(),
+        std::bind_front(&UpdateManager::packageVerified, this));
+#else
+    /* The mapping keeps the package */
+    close(fd);
+#endif
+
     const auto& fwDeviceIDRecords = parser->getFwDeviceIDRecords();
     const auto& compImageInfos = parser->getComponentImageInfos();
 
@@ -145,11 +183,19 @@ int UpdateManager::processPackage(const std::filesystem::path& packageFilePath)
         const auto& fwDeviceIDRecord =
             fwDeviceIDRecords[deviceUpdaterInfo.second];
         auto search = componentInfoMap.find(deviceUpdaterInfo.first);
-        deviceUpdaterMap.emplace(
-            deviceUpdaterInfo.first,
-            std::make_unique<DeviceUpdater>(
-                deviceUpdaterInfo.first, package, fwDeviceIDRecord,
-                compImageInfos, search->second, MAXIMUM_TRANSFER_SIZE, this));
+        auto deviceUpdater = std::make_unique<DeviceUpdater>(
+            deviceUpdaterInfo.first, package, fwDeviceIDRecord, compImageInfos,
+            search->second, MAXIMUM_TRANSFER_SIZE, this);
+#ifdef FW_UPDATE_SKIP_CURRENT
+        auto versions = activeVersionMap.find(deviceUpdaterInfo.first);
+        if (versions != activeVersionMap.end())
+        {
+            totalNumComponentUpdates -=
+                deviceUpdater->skipCurrentComponents(versions->second);
+        }
+#endif
+        deviceUpdaterMap.emplace(deviceUpdaterInfo.first,
+                                 std::move(deviceUpdater));
     }
 
     fwPackageFilePath = packageFilePath;
@@ -188,11 +234,78 @@ DeviceUpdaterInfos UpdateManager::associatePkgToDevices(
     return deviceUpdaterInfos;
 }
 
+bool UpdateManager::allRecordsMatched(const DeviceUpdaterInfos& infos,
+                                      size_t numRecords)
+{
+    std::vector<bool> matched(numRecords, false);
+    for (const auto& [eid, index] : infos)
+    {
+        matched[index] = true;
+    }
+    return std::find(matched.begin(), matched.end(), false) == matched.end();
+}
+
+void UpdateManager::deferPackage(int fd,
+                                 const std::filesystem::path& packageFilePath)
+{
+    if (pendingPackageFd >= 0)
+    {
+        /* The file of the same path is the one kept */
+        discardPackage(pendingPackageFd,
+                       pendingPackageFilePath != packageFilePath
+                           ? pendingPackageFilePath
+                           : std::filesystem::path{});
+    }
+    info(
+        "PLDM FW update package waits for the FD discovery, PACKAGEFILE={PKG_FILE}",
+        "PKG_FILE", packageFilePath.c_str());
+    pendingPackageFd = fd;
+    pendingPackageFilePath = packageFilePath;
+}
+
+void UpdateManager::discardPackage(int fd,
+                                   const std::filesystem::path& packageFilePath)
+{
+    close(fd);
+    if (!packageFilePath.empty())
+    {
+        std::filesystem::remove(packageFilePath);
+    }
+}
+
+void UpdateManager::inventoryUpdated(bool discoveryDone)
+{
+    discoveryPending = !discoveryDone;
+    if (pendingPackageFd < 0)
+    {
+        return;
+    }
+
+    /* Processed again with the FDs known so far, and for good once the
+     * discovery is over */
+    auto fd = std::exchange(pendingPackageFd, -1);
+    auto packageFilePath = std::exchange(pendingPackageFilePath, {});
+    processPackage(fd, packageFilePath);
+}
+
 void UpdateManager::updateDeviceCompletion(mctp_eid_t eid, bool status)
 {
-    deviceUpdateCompletionMap.emplace(eid, status);
+    if (!deviceUpdateCompletionMap.emplace(eid, status).second)
+    {
+        return;
+    }
+    if (status)
+    {
+        /* Known again once the FD is discovered with the new firmware */
+        activeVersionMap.erase(eid);
+    }
+    deviceTransferProgress.erase(eid);
+    startNextDeviceUpdate();
+
     if (deviceUpdateCompletionMap.size() == deviceUpdaterMap.size())
     {
+        /* The progress held back is published before the end state */
+        emitActivationProgress();
         for (const auto& [eid, status] : deviceUpdateCompletionMap)
         {
             if (!status)
@@ -207,7 +320,18 @@ void UpdateManager::updateDeviceCompletion(mctp_eid_t eid, bool status)
         auto dur =
             std::chrono::duration<double, std::milli>(endTime - startTime)
                 .count();
-        error("Firmware update time: {DURATION}ms", "DURATION", dur);
+        size_t resumedTransfers = 0;
+        uint64_t resumedBytes = 0;
+        for (const auto& [eid, deviceUpdaterPtr] : deviceUpdaterMap)
+        {
+            resumedTransfers += deviceUpdaterPtr->getResumedTransfers();
+            resumedBytes += deviceUpdaterPtr->getResumedBytes();
+        }
+        error(
+            "Firmware update time: {DURATION}ms, RESUMED_TRANSFERS={RESUMED}, RESUMED_BYTES={BYTES}",
+            "DURATION", dur, "RESUMED", resumedTransfers, "BYTES",
+            resumedBytes);
+        activationProgress->progress(100);
         activation->activation(software::Activation::Activations::Active);
     }
     return;
@@ -259,34 +383,193 @@ Response UpdateManager::handleRequest(mctp_eid_t eid, uint8_t command,
 
 void UpdateManager::activatePackage()
 {
+    if (verifier && !verifier->done())
+    {
+        /* Started once the component images are verified */
+        activationPending = true;
+        return;
+    }
+
     startTime = std::chrono::steady_clock::now();
+    pendingDeviceUpdates.clear();
     for (const auto& [eid, deviceUpdaterPtr] : deviceUpdaterMap)
     {
-        deviceUpdaterPtr->startFwUpdateFlow();
+        pendingDeviceUpdates.push_back(eid);
+    }
+
+    /* The FDs read the shared read-only mapping of the package, so the
+     * updates run side by side up to the configured limit */
+    size_t slots = FW_UPDATE_CONCURRENCY ? FW_UPDATE_CONCURRENCY
+                                         : pendingDeviceUpdates.size();
+    for (size_t i = 0; i < slots && !pendingDeviceUpdates.empty(); i++)
+    {
+        startNextDeviceUpdate();
+    }
+}
+
+void UpdateManager::packageVerified(bool status)
+{
+    if (!status)
+    {
+        error(
+            "Verification of the PLDM FW update package failed, PACKAGE_VERSION={PKG_VERS}",
+            "PKG_VERS", parser->pkgVersion);
+        activation->activation(
+            activationPending ? software::Activation::Activations::Failed
+                              : software::Activation::Activations::Invalid);
+        activationPending = false;
+        return;
+    }
+
+    if (activationPending)
+    {
+        activationPending = false;
+        activatePackage();
+    }
+}
+
+void UpdateManager::startNextDeviceUpdate()
+{
+    if (pendingDeviceUpdates.empty())
+    {
+        return;
     }
+    auto eid = pendingDeviceUpdates.front();
+    pendingDeviceUpdates.pop_front();
+    deviceUpdaterMap.at(eid)->startFwUpdateFlow();
 }
 
 void UpdateManager::clearActivationInfo()
 {
+    verifier.reset();
+    activationPending = false;
     activation.reset();
     activationProgress.reset();
+    progressTimer.setEnabled(false);
+    pendingProgress = 0;
     objPath.clear();
 
     deviceUpdaterMap.clear();
     deviceUpdateCompletionMap.clear();
+    pendingDeviceUpdates.clear();
+    deviceTransferProgress.clear();
     parser.reset();
-    package.close();
-    std::filesystem::remove(fwPackageFilePath);
+    unmapPackage();
+    if (!fwPackageFilePath.empty())
+    {
+        std::filesystem::remove(fwPackageFilePath);
+        fwPackageFilePath.clear();
+    }
     totalNumComponentUpdates = 0;
     compUpdateCompletedCount = 0;
 }
 
-void UpdateManager::updateActivationProgress()
+bool UpdateManager::mapPackage(int fd)
+{
+    unmapPackage();
+
+    struct stat st;
+    if (fstat(fd, &st) || !st.st_size)
+    {
+        error(
+            "Reading the size of the PLDM FW update package failed, ERR={ERR}, FD={FD}",
+            "ERR", unsigned(errno), "FD", fd);
+        return false;
+    }
+
+    auto data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED)
+    {
+        error(
+            "Mapping the PLDM FW update package failed, ERR={ERR}, FD={FD}",
+            "ERR", unsigned(errno), "FD", fd);
+        return false;
+    }
+
+    // The FDs read the component images from start to end
+    madvise(data, st.st_size, MADV_SEQUENTIAL);
+    madvise(data, st.st_size, MADV_WILLNEED);
+    package = std::span<const uint8_t>(static_cast<const uint8_t*>(data),
+                                       st.st_size);
+    return true;
+}
+
+void UpdateManager::unmapPackage()
+{
+    if (!package.empty())
+    {
+        munmap(const_cast<uint8_t*>(package.data()), package.size());
+        package = {};
+    }
+}
+
+void UpdateManager::updateActivationProgress(mctp_eid_t eid)
 {
     compUpdateCompletedCount++;
-    auto progressPercent = static_cast<uint8_t>(std::floor(
-        (100 * compUpdateCompletedCount) / totalNumComponentUpdates));
-    activationProgress->progress(progressPercent);
+    deviceTransferProgress.erase(eid);
+    publishActivationProgress();
+}
+
+void UpdateManager::updateTransferProgress(mctp_eid_t eid, uint8_t percent)
+{
+    auto& progress = deviceTransferProgress[eid];
+    if (percent <= progress)
+    {
+        return;
+    }
+    progress = percent;
+    publishActivationProgress();
+}
+
+void UpdateManager::publishActivationProgress()
+{
+    if (!activationProgress || !totalNumComponentUpdates)
+    {
+        return;
+    }
+
+    /* An applied component counts 100, the transfer of the current
+     * component of each FD counts its percentage */
+    size_t total = 100 * compUpdateCompletedCount;
+    for (const auto& [eid, percent] : deviceTransferProgress)
+    {
+        total += percent;
+    }
+    auto progressPercent = static_cast<uint8_t>(
+        std::min<size_t>(total / totalNumComponentUpdates, 100));
+    if (progressPercent <= std::max(pendingProgress,
+                                    activationProgress->progress()))
+    {
+        return;
+    }
+    pendingProgress = progressPercent;
+
+    /* The property changes are coalesced so the transfers of the FDs never
+     * wait on the signals, the last one is sent when the interval ends */
+    constexpr std::chrono::milliseconds interval{FW_UPDATE_PROGRESS_INTERVAL};
+    auto elapsed = std::chrono::steady_clock::now() - lastProgressEmit;
+    if (elapsed >= interval)
+    {
+        emitActivationProgress();
+    }
+    else if (!progressTimer.isEnabled())
+    {
+        progressTimer.restartOnce(
+            std::chrono::duration_cast<std::chrono::microseconds>(interval -
+                                                                  elapsed));
+    }
+}
+
+void UpdateManager::emitActivationProgress()
+{
+    progressTimer.setEnabled(false);
+    if (!activationProgress ||
+        pendingProgress <= activationProgress->progress())
+    {
+        return;
+    }
+    lastProgressEmit = std::chrono::steady_clock::now();
+    activationProgress->progress(pendingProgress);
 }
 
 } // namespace fw_update
@@ -4,14 +4,20 @@
 #include "common/types.hpp"
 #include "device_updater.hpp"
 #include "package_parser.hpp"
+#include "package_verifier.hpp"
 #include "requester/handler.hpp"
 #include "watch.hpp"
 
 #include <libpldm/base.h>
+#include <unistd.h>
+
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/utility/timer.hpp>
 
 #include <chrono>
+#include <deque>
 #include <filesystem>
-#include <fstream>
+#include <span>
 #include <tuple>
 #include <unordered_map>
 
@@ -41,19 +47,33 @@ class UpdateManager
     UpdateManager(UpdateManager&&) = delete;
     UpdateManager& operator=(const UpdateManager&) = delete;
     UpdateManager& operator=(UpdateManager&&) = delete;
-    ~UpdateManager() = default;
+    ~UpdateManager()
+    {
+        unmapPackage();
+        if (pendingPackageFd >= 0)
+        {
+            close(pendingPackageFd);
+        }
+    }
 
     explicit UpdateManager(
         Event& event,
         pldm::requester::Handler<pldm::requester::Request>& handler,
         InstanceIdDb& instanceIdDb, const DescriptorMap& descriptorMap,
-        const ComponentInfoMap& componentInfoMap) :
+        const ComponentInfoMap& componentInfoMap,
+        ActiveComponentVersionMap& activeVersionMap) :
         event(event),
         handler(handler), instanceIdDb(instanceIdDb),
         descriptorMap(descriptorMap), componentInfoMap(componentInfoMap),
+        activeVersionMap(activeVersionMap),
         watch(event.get(),
-              std::bind_front(&UpdateManager::processPackage, this))
-    {}
+              [this](std::string& packageFilePath) {
+        return processPackage(packageFilePath);
+    }),
+        progressTimer(event, [this](auto&) { emitActivationProgress(); })
+    {
+        progressTimer.setEnabled(false);
+    }
 
     /** @brief Handle PLDM request for the commands in the FW update
      *         specification
@@ -68,11 +88,55 @@ class UpdateManager
     Response handleRequest(mctp_eid_t eid, uint8_t command,
                            const pldm_msg* request, size_t reqMsgLen);
 
+    /** @brief Process the firmware update package at a path, the file is
+     *         removed once the package is not used anymore
+     *
+     *  @param[in] packageFilePath - path of the package
+     *
+     *  @return 0 if the package was processed, -1 otherwise
+     */
     int processPackage(const std::filesystem::path& packageFilePath);
 
+    /** @brief Process the firmware update package read from a file
+     *         descriptor, e.g. a sealed memfd, the package is mapped from
+     *         it
+     *
+     *  @param[in] fd - file descriptor of the package, owned by the call
+     *  @param[in] packageFilePath - path of the package removed with it,
+     *                               none for an anonymous file
+     *
+     *  @return 0 if the package was processed, -1 otherwise
+     */
+    int processPackage(int fd,
+                       const std::filesystem::path& packageFilePath = {});
+
+    /** @brief Record the end of the update of a FD and start the next
+     *         pending one
+     *
+     *  @param[in] eid - MCTP endpoint ID of the FD
+     *  @param[in] status - true if the FD was updated
+     */
     void updateDeviceCompletion(mctp_eid_t eid, bool status);
 
-    void updateActivationProgress();
+    /** @brief A component of a FD is applied
+     *
+     *  @param[in] eid - MCTP endpoint ID of the FD
+     */
+    void updateActivationProgress(mctp_eid_t eid);
+
+    /** @brief Part of the current component of a FD is transferred
+     *
+     *  @param[in] eid - MCTP endpoint ID of the FD
+     *  @param[in] percent - percentage of the component transferred
+     */
+    void updateTransferProgress(mctp_eid_t eid, uint8_t percent);
+
+    /** @brief The inventory of a FD is complete, a package waiting for the
+     *         FDs is processed again
+     *
+     *  @param[in] discoveryDone - true if no FD is being discovered
+     */
+    void inventoryUpdated(bool discoveryDone);
 
     /** @brief Callback function that will be invoked when the
      *         RequestedActivation will be set to active in the Activation
@@ -101,6 +165,10 @@ class UpdateManager
     const DescriptorMap& descriptorMap;
     /** @brief Component information needed for the update of the managed FDs */
     const ComponentInfoMap& componentInfoMap;
+    /** @brief Active component versions of the managed FDs, an entry is
+     *         dropped once its FD is updated
+     */
+    ActiveComponentVersionMap& activeVersionMap;
     Watch watch;
 
     std::unique_ptr<Activation> activation;
@@ -109,11 +177,88 @@ class UpdateManager
 
     std::filesystem::path fwPackageFilePath;
     std::unique_ptr<PackageParser> parser;
-    std::ifstream package;
+    /** @brief Read-only mapping of the firmware update package */
+    std::span<const uint8_t> package;
+
+    /** @brief Map the firmware update package read-only
+     *
+     *  @param[in] fd - file descriptor of the package
+     *
+     *  @return true if the package is mapped
+     */
+    bool mapPackage(int fd);
+
+    /** @brief Close a package not processed and remove its file
+     *
+     *  @param[in] fd - file descriptor of the package
+     *  @param[in] packageFilePath - path of the package, if any
+     */
+    static void discardPackage(int fd,
+                               const std::filesystem::path& packageFilePath);
+
+    /** @brief Unmap the firmware update package */
+    void unmapPackage();
 
     std::unordered_map<mctp_eid_t, std::unique_ptr<DeviceUpdater>>
         deviceUpdaterMap;
     std::unordered_map<mctp_eid_t, bool> deviceUpdateCompletionMap;
+    /** @brief FDs waiting for one of the FW_UPDATE_CONCURRENCY update slots
+     */
+    std::deque<mctp_eid_t> pendingDeviceUpdates;
+    /** @brief Percentage of the current component transferred, per FD */
+    std::unordered_map<mctp_eid_t, uint8_t> deviceTransferProgress;
+
+    /** @brief Background verification of the component images, only with
+     *         the fw-update-verify-package option
+     */
+    std::unique_ptr<PackageVerifier> verifier;
+    /** @brief The activation was requested before the verification ended */
+    bool activationPending = false;
+
+    /** @brief Result of the verification of the component images
+     *
+     *  @param[in] status - true if all the component images were read
+     */
+    void packageVerified(bool status);
+
+    /** @brief Package received while the FDs it targets are discovered */
+    int pendingPackageFd = -1;
+    std::filesystem::path pendingPackageFilePath;
+    /** @brief Some FDs are being discovered */
+    bool discoveryPending = false;
+
+    /** @brief Keep a package until more FDs are discovered
+     *
+     *  @param[in] fd - file descriptor of the package, kept
+     *  @param[in] packageFilePath - path of the package, if any
+     */
+    void deferPackage(int fd, const std::filesystem::path& packageFilePath);
+
+    /** @brief Whether every FD record of the package matched a FD
+     *
+     *  @param[in] infos - FDs matched with the package
+     *  @param[in] numRecords - number of FD records in the package
+     */
+    static bool allRecordsMatched(const DeviceUpdaterInfos& infos,
+                                  size_t numRecords);
+
+    /** @brief Start the update of the next pending FD */
+    void startNextDeviceUpdate();
+
+    /** @brief Publish the progress aggregated over the FDs, at most once per
+     *         FW_UPDATE_PROGRESS_INTERVAL milliseconds
+     */
+    void publishActivationProgress();
+
+    /** @brief Set the ActivationProgress property to the pending progress */
+    void emitActivationProgress();
+
+    /** @brief Progress aggregated over the FDs, not published yet */
+    uint8_t pendingProgress = 0;
+    /** @brief When the ActivationProgress property was last set */
+    std::chrono::steady_clock::time_point lastProgressEmit{};
+    /** @brief Publishes the progress held back by the rate limit */
+    sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> progressTimer;
 
     /** @brief Total number of component updates to calculate the progress of
      *         the Firmware activation
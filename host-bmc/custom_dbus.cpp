@@ -4,28 +4,70 @@ namespace pldm
 {
 namespace dbus
 {
-void CustomDBus::setLocationCode(const std::string& path, std::string value)
+void CustomDBus::setLocationCode(std::string_view path, std::string value)
 {
-    if (!location.contains(path))
+    auto it = location.find(path);
+    if (it == location.end())
     {
-        location.emplace(path,
-                         std::make_unique<LocationIntf>(
-                             pldm::utils::DBusHandler::getBus(), path.c_str()));
+        auto action = staging ? LocationIntf::action::defer_emit
+                              : LocationIntf::action::emit_object_added;
+        it = location.emplace(ObjectPath(path), LocationObject{}).first;
+        it->second.intf = std::make_unique<LocationIntf>(
+            pldm::utils::DBusHandler::getBus(), it->first.c_str(), action);
+        it->second.announced = !staging;
+        if (staging)
+        {
+            staged.push_back(&it->second);
+        }
     }
 
-    location.at(path)->locationCode(value);
+    // An object which isn't announced yet doesn't signal its changes
+    it->second.intf->locationCode(value, !it->second.announced);
+}
+
+void CustomDBus::setLocationCodes(const LocationCodes& codes)
+{
+    // A caller already staging publishes the objects itself
+    bool publishAfter = !staging;
+    stage();
+    location.reserve(location.size() + codes.size());
+    for (const auto& [path, value] : codes)
+    {
+        setLocationCode(path, value);
+    }
+    if (publishAfter)
+    {
+        publish();
+    }
 }
 
 std::optional<std::string>
-    CustomDBus::getLocationCode(const std::string& path) const
+    CustomDBus::getLocationCode(std::string_view path) const
 {
-    if (location.contains(path))
+    auto it = location.find(path);
+    if (it != location.end())
     {
-        return location.at(path)->locationCode();
+        return it->second.intf->locationCode();
     }
 
     return std::nullopt;
 }
 
+void CustomDBus::stage()
+{
+    staging = true;
+}
+
+void CustomDBus::publish()
+{
+    for (auto object : staged)
+    {
+        object->intf->emit_object_added();
+        object->announced = true;
+    }
+    staged.clear();
+    staging = false;
+}
+
 } // namespace dbus
 } // namespace pldm
@@ -5,10 +5,14 @@
 #include <sdbusplus/server.hpp>
 #include <xyz/openbmc_project/Inventory/Decorator/LocationCode/server.hpp>
 
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace pldm
 {
@@ -20,6 +24,9 @@ using LocationIntf =
     sdbusplus::server::object_t<sdbusplus::xyz::openbmc_project::Inventory::
                                     Decorator::server::LocationCode>;
 
+/** @brief Object paths and their LocationCode values */
+using LocationCodes = std::vector<std::pair<ObjectPath, std::string>>;
+
 /** @class CustomDBus
  *  @brief This is a custom D-Bus object, used to add D-Bus interface and update
  *         the corresponding properties value.
@@ -49,7 +56,14 @@ class CustomDBus
      *
      *  @param[in] value - The value of the LocationCode property
      */
-    void setLocationCode(const std::string& path, std::string value);
+    void setLocationCode(std::string_view path, std::string value);
+
+    /** @brief Set the LocationCode property of many objects, the new objects
+     *         are announced together once all the values are set
+     *
+     *  @param[in] codes - The object paths and LocationCode values
+     */
+    void setLocationCodes(const LocationCodes& codes);
 
     /** @brief Get the LocationCode property
      *
@@ -58,10 +72,48 @@ class CustomDBus
      *  @return std::optional<std::string> - The value of the LocationCode
      *          property
      */
-    std::optional<std::string> getLocationCode(const std::string& path) const;
+    std::optional<std::string> getLocationCode(std::string_view path) const;
+
+    /** @brief Stage the objects created from now on
+     *
+     *  The staged objects are created without being announced and their
+     *  properties are set without signals, publish() then emits their
+     *  InterfacesAdded in one burst with the final values.
+     */
+    void stage();
+
+    /** @brief Announce the staged objects and stop staging */
+    void publish();
 
   private:
-    std::unordered_map<ObjectPath, std::unique_ptr<LocationIntf>> location;
+    /** @brief Hash of the paths, looked up without a string copy */
+    struct PathHash
+    {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view path) const
+        {
+            return std::hash<std::string_view>{}(path);
+        }
+    };
+
+    /** @brief LocationCode object of a path */
+    struct LocationObject
+    {
+        std::unique_ptr<LocationIntf> intf;
+        /** @brief Whether its InterfacesAdded is emitted */
+        bool announced;
+    };
+
+    /** @brief The path of each object is only stored as its key */
+    std::unordered_map<ObjectPath, LocationObject, PathHash, std::equal_to<>>
+        location;
+
+    /** @brief Whether the new objects are staged */
+    bool staging = false;
+
+    /** @brief Objects created while staging */
+    std::vector<LocationObject*> staged;
 };
 
 } // namespace dbus
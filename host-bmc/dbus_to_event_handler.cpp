@@ -4,6 +4,8 @@
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <chrono>
+
 PHOSPHOR_LOG2_USING;
 
 namespace pldm
@@ -12,7 +14,6 @@ using namespace pldm::responder;
 using namespace pldm::responder::pdr;
 using namespace pldm::responder::pdr_utils;
 using namespace pldm::utils;
-using namespace sdbusplus::bus::match::rules;
 
 namespace state_sensor
 {
@@ -20,12 +21,59 @@ const std::vector<uint8_t> pdrTypes{PLDM_STATE_SENSOR_PDR};
 
 DbusToPLDMEvent::DbusToPLDMEvent(
     int mctp_fd, uint8_t mctp_eid, pldm::InstanceIdDb& instanceIdDb,
-    pldm::requester::Handler<pldm::requester::Request>* handler) :
+    pldm::requester::Handler<pldm::requester::Request>* handler,
+    sdeventplus::Event& event) :
     mctp_fd(mctp_fd),
-    mctp_eid(mctp_eid), instanceIdDb(instanceIdDb), handler(handler)
+    mctp_eid(mctp_eid), instanceIdDb(instanceIdDb), handler(handler),
+    batchTimer(event, std::bind(&DbusToPLDMEvent::sendQueuedEvents, this))
 {}
 
-void DbusToPLDMEvent::sendEventMsg(uint8_t eventType,
+void DbusToPLDMEvent::queueStateSensorEvent(
+    const std::vector<uint8_t>& eventDataVec)
+{
+    auto eventData = reinterpret_cast<const struct pldm_sensor_event_data*>(
+        eventDataVec.data());
+    SensorOffset key{eventData->sensor_id, eventData->event_class[0]};
+    auto queued = queuedEvents.find(key);
+    if (queued != queuedEvents.end())
+    {
+        /* Only the latest state of the offset is sent, the previous state
+         * stays the one of the first change */
+        auto queuedData = reinterpret_cast<struct pldm_sensor_event_data*>(
+            queued->second.data());
+        queuedData->event_class[1] = eventData->event_class[1];
+        return;
+    }
+    queuedEvents.emplace(key, eventDataVec);
+    eventQueue.push_back(key);
+
+    if (!HOST_SENSOR_EVENT_BATCH_WINDOW_MS)
+    {
+        sendQueuedEvents();
+    }
+    else if (!batchTimer.isEnabled())
+    {
+        batchTimer.restartOnce(
+            std::chrono::milliseconds(HOST_SENSOR_EVENT_BATCH_WINDOW_MS));
+    }
+}
+
+void DbusToPLDMEvent::sendQueuedEvents()
+{
+    while (!eventQueue.empty() &&
+           eventsInFlight < HOST_SENSOR_EVENTS_IN_FLIGHT)
+    {
+        auto key = eventQueue.front();
+        eventQueue.pop_front();
+        auto node = queuedEvents.extract(key);
+        if (sendEventMsg(PLDM_SENSOR_EVENT, node.mapped()))
+        {
+            eventsInFlight++;
+        }
+    }
+}
+
+bool DbusToPLDMEvent::sendEventMsg(uint8_t eventType,
                                    const std::vector<uint8_t>& eventDataVec)
 {
     auto instanceId = instanceIdDb.next(mctp_eid);
@@ -43,11 +91,16 @@ void DbusToPLDMEvent::sendEventMsg(uint8_t eventType,
         instanceIdDb.free(mctp_eid, instanceId);
         error("Failed to encode_platform_event_message_req, rc = {RC}", "RC",
               rc);
-        return;
+        return false;
     }
 
     auto platformEventMessageResponseHandler =
-        [](mctp_eid_t /*eid*/, const pldm_msg* response, size_t respMsgLen) {
+        [this](mctp_eid_t /*eid*/, const pldm_msg* response,
+               size_t respMsgLen) {
+        /* The window has room for the next queued event */
+        eventsInFlight--;
+        sendQueuedEvents();
+
         if (response == nullptr || !respMsgLen)
         {
             error("Failed to receive response for platform event message");
@@ -70,8 +123,11 @@ void DbusToPLDMEvent::sendEventMsg(uint8_t eventType,
         std::move(requestMsg), std::move(platformEventMessageResponseHandler));
     if (rc)
     {
+        instanceIdDb.free(mctp_eid, instanceId);
         error("Failed to send the platform event message");
+        return false;
     }
+    return true;
 }
 
 void DbusToPLDMEvent::sendStateSensorEvent(SensorId sensorId,
@@ -105,19 +161,17 @@ void DbusToPLDMEvent::sendStateSensorEvent(SensorId sensorId,
 
         const auto& dbusMapping = dbusMappings[offset];
         const auto& dbusValueMapping = dbusValMaps[offset];
-        auto stateSensorMatch = std::make_unique<sdbusplus::bus::match_t>(
-            pldm::utils::DBusHandler::getBus(),
-            propertiesChanged(dbusMapping.objectPath.c_str(),
-                              dbusMapping.interface.c_str()),
+        stateSensorMatchs.watch(
+            pldm::utils::DBusHandler::getBus(), dbusMapping.objectPath,
+            dbusMapping.interface,
             [this, sensorEventDataVec, dbusValueMapping,
-             dbusMapping](auto& msg) mutable {
-            DbusChangedProps props{};
-            std::string intf;
-            msg.read(intf, props);
-            if (!props.contains(dbusMapping.propertyName))
+             dbusMapping](const DbusChangedProps* changed,
+                          const std::vector<std::string>&) mutable {
+            if (!changed || !changed->contains(dbusMapping.propertyName))
             {
                 return;
             }
+            const auto& props = *changed;
             for (const auto& itr : dbusValueMapping)
             {
                 bool findValue = false;
@@ -151,12 +205,11 @@ void DbusToPLDMEvent::sendStateSensorEvent(SensorId sensorId,
                             sensorEventDataVec.data());
                     eventData->event_class[1] = itr.first;
                     eventData->event_class[2] = itr.first;
-                    this->sendEventMsg(PLDM_SENSOR_EVENT, sensorEventDataVec);
+                    this->queueStateSensorEvent(sensorEventDataVec);
                     break;
                 }
             }
         });
-        stateSensorMatchs.emplace_back(std::move(stateSensorMatch));
     }
 }
 
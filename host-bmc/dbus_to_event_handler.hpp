@@ -6,7 +6,12 @@
 
 #include <libpldm/platform.h>
 
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/utility/timer.hpp>
+
+#include <deque>
 #include <map>
+#include <utility>
 
 namespace pldm
 {
@@ -23,6 +28,11 @@ namespace state_sensor
 /** @class DbusToPLDMEvent
  *  @brief This class can listen to the state sensor PDRs and send PLDM event
  *         msg when a D-Bus property changes
+ *
+ *  The changes are queued for a short window before they are sent, the
+ *  changes of a sensor offset still queued are merged into one event with
+ *  the latest state. At most a window of events is in flight to the host,
+ *  the next one is sent when one of them gets its response.
  */
 class DbusToPLDMEvent
 {
@@ -39,10 +49,12 @@ class DbusToPLDMEvent
      *  @param[in] mctp_eid - MCTP EID of host firmware
      *  @param[in] requester - reference to Requester object
      *  @param[in] handler - PLDM request handler
+     *  @param[in] event - PLDM daemon's main event loop
      */
     explicit DbusToPLDMEvent(
         int mctp_fd, uint8_t mctp_eid, pldm::InstanceIdDb& instanceIdDb,
-        pldm::requester::Handler<pldm::requester::Request>* handler);
+        pldm::requester::Handler<pldm::requester::Request>* handler,
+        sdeventplus::Event& event);
 
   public:
     /** @brief Listen all of the state sensor PDRs
@@ -58,11 +70,21 @@ class DbusToPLDMEvent
      */
     void sendStateSensorEvent(SensorId sensorId, const DbusObjMaps& dbusMaps);
 
+    /** @brief Queue the state change of a sensor offset, merged with the
+     *         change of the same offset still queued
+     *  @param[in] eventDataVec - state sensor event data
+     */
+    void queueStateSensorEvent(const std::vector<uint8_t>& eventDataVec);
+
+    /** @brief Send the queued events, within the in-flight window */
+    void sendQueuedEvents();
+
     /** @brief Send all of sensor event
      *  @param[in] eventType - PLDM Event types
      *  @param[in] eventDataVec - std::vector, contains send event data
+     *  @return true if the event is sent, its response is then pending
      */
-    void sendEventMsg(uint8_t eventType,
+    bool sendEventMsg(uint8_t eventType,
                       const std::vector<uint8_t>& eventDataVec);
 
     /** @brief fd of MCTP communications socket */
@@ -76,11 +98,26 @@ class DbusToPLDMEvent
      */
     pldm::InstanceIdDb& instanceIdDb;
 
-    /** @brief D-Bus property changed signal match */
-    std::vector<std::unique_ptr<sdbusplus::bus::match_t>> stateSensorMatchs;
+    /** @brief D-Bus property changed signal matches, one per interface */
+    pldm::utils::PropertiesChangedDispatcher stateSensorMatchs;
 
     /** @brief PLDM request handler */
     pldm::requester::Handler<pldm::requester::Request>* handler;
+
+    /** @brief Sensor ID and offset of a state change */
+    using SensorOffset = std::pair<SensorId, uint8_t>;
+
+    /** @brief Queued sensor offsets, in the order of their first change */
+    std::deque<SensorOffset> eventQueue;
+
+    /** @brief Event data of the queued sensor offsets */
+    std::map<SensorOffset, std::vector<uint8_t>> queuedEvents;
+
+    /** @brief Number of events waiting for their response */
+    size_t eventsInFlight = 0;
+
+    /** @brief Ends the window the changes are queued for */
+    sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> batchTimer;
 };
 
 } // namespace state_sensor
@@ -7,7 +7,6 @@
 #include <xyz/openbmc_project/Common/error.hpp>
 #include <xyz/openbmc_project/State/OperatingSystem/Status/server.hpp>
 
-#include <fstream>
 #include <iostream>
 
 PHOSPHOR_LOG2_USING;
@@ -53,8 +52,7 @@ void HostEffecterParser::parseEffecterJson(const std::string& jsonPath)
         throw InternalFailure();
     }
 
-    std::ifstream jsonFile(jsonFilePath);
-    auto data = Json::parse(jsonFile, nullptr, false);
+    const auto& data = JsonCache::get().load(jsonFilePath);
     if (data.is_discarded())
     {
         error("Parsing json file failed, FILE = {JSON_PATH}", "JSON_PATH",
@@ -114,11 +112,10 @@ void HostEffecterParser::parseEffecterJson(const std::string& jsonPath)
 
                 dbusInfo.propertyValue =
                     std::numeric_limits<double>::quiet_NaN();
-                auto effecterInfoIndex = hostEffecterInfo.size();
-                auto dbusInfoIndex = effecterInfo.dbusInfo.size();
-                createHostEffecterMatch(
-                    dbusInfo.dbusMap.objectPath, dbusInfo.dbusMap.interface,
-                    effecterInfoIndex, dbusInfoIndex, effecterId);
+                addEffecterProperty(
+                    dbusInfo.dbusMap,
+                    {hostEffecterInfo.size(),
+                     effecterInfo.dbusNumericEffecterInfo.size(), effecterId});
                 effecterInfo.dbusNumericEffecterInfo.emplace_back(
                     std::move(dbusInfo));
             }
@@ -158,39 +155,122 @@ void HostEffecterParser::parseEffecterJson(const std::string& jsonPath)
                 dbusInfo.state.states.emplace_back(s);
             }
 
-            auto effecterInfoIndex = hostEffecterInfo.size();
-            auto dbusInfoIndex = effecterInfo.dbusInfo.size();
-            createHostEffecterMatch(
-                dbusInfo.dbusMap.objectPath, dbusInfo.dbusMap.interface,
-                effecterInfoIndex, dbusInfoIndex, effecterId);
+            addEffecterProperty(dbusInfo.dbusMap,
+                                {hostEffecterInfo.size(),
+                                 effecterInfo.dbusInfo.size(), effecterId});
             effecterInfo.dbusInfo.emplace_back(std::move(dbusInfo));
         }
         hostEffecterInfo.emplace_back(std::move(effecterInfo));
     }
 }
 
+void HostEffecterParser::addEffecterProperty(
+    const pldm::utils::DBusMapping& dbusMap, const EffecterRef& effecterRef)
+{
+    propertyEffecters[{dbusMap.objectPath, dbusMap.propertyName}].push_back(
+        effecterRef);
+    if (watchedInterfaces.emplace(dbusMap.objectPath, dbusMap.interface)
+            .second)
+    {
+        createHostEffecterMatch(dbusMap.objectPath, dbusMap.interface);
+    }
+}
+
+void HostEffecterParser::processPropertiesChanged(
+    const std::string& objectPath, const std::string& interface,
+    const DbusChgHostEffecterProps& chProperties)
+{
+    for (const auto& [property, value] : chProperties)
+    {
+        auto it = propertyEffecters.find({objectPath, property});
+        if (it == propertyEffecters.end())
+        {
+            continue;
+        }
+        for (const auto& ref : it->second)
+        {
+            const auto& effecterInfo = hostEffecterInfo[ref.effecterInfoIndex];
+            const auto& dbusMap =
+                effecterInfo.effecterPdrType == PLDM_NUMERIC_EFFECTER_PDR
+                    ? effecterInfo.dbusNumericEffecterInfo[ref.dbusInfoIndex]
+                          .dbusMap
+                    : effecterInfo.dbusInfo[ref.dbusInfoIndex].dbusMap;
+            if (dbusMap.interface != interface)
+            {
+                continue;
+            }
+            processHostEffecterChangeNotification(
+                chProperties, ref.effecterInfoIndex, ref.dbusInfoIndex,
+                ref.effecterId);
+        }
+    }
+}
+
+const std::vector<EffecterRef>*
+    HostEffecterParser::findEffecters(const std::string& objectPath,
+                                      const std::string& property) const
+{
+    auto it = propertyEffecters.find({objectPath, property});
+    return it == propertyEffecters.end() ? nullptr : &it->second;
+}
+
+bool HostEffecterParser::isHostUpState(const std::string& bootProgress)
+{
+    return bootProgress == "xyz.openbmc_project.State.Boot.Progress."
+                           "ProgressStages.SystemInitComplete" ||
+           bootProgress == "xyz.openbmc_project.State.Boot.Progress."
+                           "ProgressStages.OSRunning" ||
+           bootProgress == "xyz.openbmc_project.State.Boot.Progress."
+                           "ProgressStages.SystemSetup" ||
+           bootProgress == "xyz.openbmc_project.State.Boot.Progress."
+                           "ProgressStages.OEM";
+}
+
 bool HostEffecterParser::isHostOn(void)
 {
     constexpr auto bootProgressInterface =
         "xyz.openbmc_project.State.Boot.Progress";
     constexpr auto hostStatePath = "/xyz/openbmc_project/state/host0";
+    if (hostOn)
+    {
+        return *hostOn;
+    }
+
+    /* Subscribe before the read so no change is missed in between, the
+     * cached state is then kept up to date by the signal */
+    if (!hostStateMatch)
+    {
+        using namespace sdbusplus::bus::match::rules;
+        hostStateMatch = std::make_unique<sdbusplus::bus::match_t>(
+            pldm::utils::DBusHandler::getBus(),
+            propertiesChanged(hostStatePath, bootProgressInterface),
+            [this](sdbusplus::message_t& msg) {
+            DbusChgHostEffecterProps props;
+            std::string iface;
+            msg.read(iface, props);
+            auto it = props.find("BootProgress");
+            if (it == props.end())
+            {
+                return;
+            }
+            const auto* bootProgress = std::get_if<std::string>(&it->second);
+            if (bootProgress)
+            {
+                hostOn = isHostUpState(*bootProgress);
+            }
+        });
+    }
+
     try
     {
         auto propVal = dbusHandler->getDbusPropertyVariant(
             hostStatePath, "BootProgress", bootProgressInterface);
         const auto& currHostState = std::get<std::string>(propVal);
-        if ((currHostState != "xyz.openbmc_project.State.Boot.Progress."
-                              "ProgressStages.SystemInitComplete") &&
-            (currHostState != "xyz.openbmc_project.State.Boot.Progress."
-                              "ProgressStages.OSRunning") &&
-            (currHostState != "xyz.openbmc_project.State.Boot.Progress."
-                              "ProgressStages.SystemSetup") &&
-            (currHostState != "xyz.openbmc_project.State.Boot.Progress."
-                              "ProgressStages.OEM"))
+        hostOn = isHostUpState(currHostState);
+        if (!*hostOn)
         {
             info("Host is not up. Current host state: {CUR_HOST_STATE}",
                  "CUR_HOST_STATE", currHostState.c_str());
-            return false;
         }
     }
     catch (const sdbusplus::exception_t& e)
@@ -198,10 +278,12 @@ bool HostEffecterParser::isHostOn(void)
         error(
             "Error in getting current host state. Will still continue to set the host effecter - {ERR_EXCEP}",
             "ERR_EXCEP", e.what());
+        /* Read again on the next change until the state is known */
+        hostOn.reset();
         return false;
     }
 
-    return true;
+    return *hostOn;
 }
 
 void HostEffecterParser::processHostEffecterChangeNotification(
@@ -229,8 +311,8 @@ void HostEffecterParser::processHostEffecterChangeNotification(
     if (effecterId == PLDM_INVALID_EFFECTER_ID)
     {
         constexpr auto localOrRemote = false;
-        effecterId = findStateEffecterId(
-            pdrRepo, hostEffecterInfo[effecterInfoIndex].entityType,
+        effecterId = pdrIndex.findStateEffecterId(
+            hostEffecterInfo[effecterInfoIndex].entityType,
             hostEffecterInfo[effecterInfoIndex].entityInstance,
             hostEffecterInfo[effecterInfoIndex].containerId,
             hostEffecterInfo[effecterInfoIndex]
@@ -398,8 +480,28 @@ int HostEffecterParser::setTerminusNumericEffecter(size_t effecterInfoIndex,
                                                    uint16_t effecterId,
                                                    uint8_t dataSize,
                                                    double rawValue)
+{
+    EffecterWriteKey key{hostEffecterInfo[effecterInfoIndex].mctpEid,
+                         effecterId};
+    auto& write = effecterWrites[key];
+    if (write.pendingRaw)
+    {
+        write.coalesced++;
+    }
+    write.effecterInfoIndex = effecterInfoIndex;
+    write.dataSize = dataSize;
+    write.pendingRaw = rawValue;
+    flushEffecterWrite(key);
+    return PLDM_SUCCESS;
+}
+
+int HostEffecterParser::sendTerminusNumericEffecter(const EffecterWriteKey& key,
+                                                    size_t effecterInfoIndex,
+                                                    uint8_t dataSize,
+                                                    double rawValue)
 {
     uint8_t& mctpEid = hostEffecterInfo[effecterInfoIndex].mctpEid;
+    auto effecterId = key.second;
     auto instanceId = instanceIdDb->next(mctpEid);
     int rc = PLDM_ERROR;
     std::vector<uint8_t> requestMsg;
@@ -469,13 +571,14 @@ int HostEffecterParser::setTerminusNumericEffecter(size_t effecterInfoIndex,
         return rc;
     }
 
-    auto setNumericEffecterRespHandler = [](mctp_eid_t /*eid*/,
-                                            const pldm_msg* response,
-                                            size_t respMsgLen) {
+    auto setNumericEffecterRespHandler =
+        [this, key](mctp_eid_t /*eid*/, const pldm_msg* response,
+                    size_t respMsgLen) {
         if (response == nullptr || !respMsgLen)
         {
             std::cerr << "Failed to receive response for "
                       << "setNumericEffecterValue command \n";
+            effecterWriteDone(key, false);
             return;
         }
         uint8_t completionCode{};
@@ -493,11 +596,13 @@ int HostEffecterParser::setTerminusNumericEffecter(size_t effecterInfoIndex,
                       << ", cc=" << static_cast<unsigned>(completionCode)
                       << "\n";
         }
+        effecterWriteDone(key, !rc && completionCode == PLDM_SUCCESS);
     };
 
     rc = handler->registerRequest(
         mctpEid, instanceId, PLDM_PLATFORM, PLDM_SET_NUMERIC_EFFECTER_VALUE,
-        std::move(requestMsg), std::move(setNumericEffecterRespHandler));
+        std::move(requestMsg), std::move(setNumericEffecterRespHandler),
+        pldm::requester::RequestPriority::Control);
     if (rc)
     {
         std::cerr << "Failed to send request to set an effecter on Host \n";
@@ -508,8 +613,39 @@ int HostEffecterParser::setTerminusNumericEffecter(size_t effecterInfoIndex,
 int HostEffecterParser::setHostStateEffecter(
     size_t effecterInfoIndex, std::vector<set_effecter_state_field>& stateField,
     uint16_t effecterId)
+{
+    EffecterWriteKey key{hostEffecterInfo[effecterInfoIndex].mctpEid,
+                         effecterId};
+    auto& write = effecterWrites[key];
+    write.effecterInfoIndex = effecterInfoIndex;
+    if (!write.pendingStates ||
+        write.pendingStates->size() != stateField.size())
+    {
+        write.pendingStates = stateField;
+    }
+    else
+    {
+        /* The sub-effecters set by the latest write take its states, the
+         * others keep the states of the writes before it */
+        write.coalesced++;
+        for (size_t i = 0; i < stateField.size(); i++)
+        {
+            if (stateField[i].set_request == PLDM_REQUEST_SET)
+            {
+                (*write.pendingStates)[i] = stateField[i];
+            }
+        }
+    }
+    flushEffecterWrite(key);
+    return PLDM_SUCCESS;
+}
+
+int HostEffecterParser::sendHostStateEffecter(
+    const EffecterWriteKey& key, size_t effecterInfoIndex,
+    std::vector<set_effecter_state_field>& stateField)
 {
     uint8_t& mctpEid = hostEffecterInfo[effecterInfoIndex].mctpEid;
+    auto effecterId = key.second;
     uint8_t& compEffCnt = hostEffecterInfo[effecterInfoIndex].compEffecterCnt;
     auto instanceId = instanceIdDb->next(mctpEid);
 
@@ -530,11 +666,13 @@ int HostEffecterParser::setHostStateEffecter(
     }
 
     auto setStateEffecterStatesRespHandler =
-        [](mctp_eid_t /*eid*/, const pldm_msg* response, size_t respMsgLen) {
+        [this, key](mctp_eid_t /*eid*/, const pldm_msg* response,
+                    size_t respMsgLen) {
         if (response == nullptr || !respMsgLen)
         {
             error(
                 "Failed to receive response for setStateEffecterStates command");
+            effecterWriteDone(key, false);
             return;
         }
         uint8_t completionCode{};
@@ -554,11 +692,13 @@ int HostEffecterParser::setHostStateEffecter(
             pldm::utils::reportError(
                 "xyz.openbmc_project.bmc.pldm.SetHostEffecterFailed");
         }
+        effecterWriteDone(key, !rc && completionCode == PLDM_SUCCESS);
     };
 
     rc = handler->registerRequest(
         mctpEid, instanceId, PLDM_PLATFORM, PLDM_SET_STATE_EFFECTER_STATES,
-        std::move(requestMsg), std::move(setStateEffecterStatesRespHandler));
+        std::move(requestMsg), std::move(setStateEffecterStatesRespHandler),
+        pldm::requester::RequestPriority::Control);
     if (rc)
     {
         error("Failed to send request to set an effecter on Host");
@@ -566,24 +706,132 @@ int HostEffecterParser::setHostStateEffecter(
     return rc;
 }
 
+void HostEffecterParser::flushEffecterWrite(const EffecterWriteKey& key)
+{
+    auto& write = effecterWrites[key];
+    if (write.outstanding || (!write.pendingStates && !write.pendingRaw))
+    {
+        return;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    auto next = write.lastWrite +
+                std::chrono::milliseconds(HOST_EFFECTER_WRITE_INTERVAL);
+    if (now < next)
+    {
+        if (!write.timer)
+        {
+            write.timer = std::make_unique<
+                sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>>(
+                sdeventplus::Event::get_default(),
+                [this, key](auto&) { flushEffecterWrite(key); });
+        }
+        if (!write.timer->isEnabled())
+        {
+            write.timer->restartOnce(
+                std::chrono::duration_cast<std::chrono::microseconds>(next -
+                                                                      now));
+        }
+        return;
+    }
+
+    int rc{};
+    write.lastWrite = now;
+    write.outstanding = true;
+    try
+    {
+        if (write.pendingStates)
+        {
+            write.sentStates = std::move(*write.pendingStates);
+            write.pendingStates.reset();
+            rc = sendHostStateEffecter(key, write.effecterInfoIndex,
+                                       write.sentStates);
+        }
+        else
+        {
+            write.sentRaw = *write.pendingRaw;
+            write.pendingRaw.reset();
+            rc = sendTerminusNumericEffecter(key, write.effecterInfoIndex,
+                                             write.dataSize, write.sentRaw);
+        }
+    }
+    catch (const std::runtime_error& e)
+    {
+        error("Failed to allocate an instance id, ERROR={ERR_EXCEP}",
+              "ERR_EXCEP", e.what());
+        rc = PLDM_ERROR;
+    }
+    if (rc != PLDM_SUCCESS)
+    {
+        error(
+            "Failed to write the host effecter, EID={EID}, EFFECTER_ID={EFFECTER_ID}, RC={RC}",
+            "EID", key.first, "EFFECTER_ID", key.second, "RC", rc);
+        write.outstanding = false;
+        write.sentStates.clear();
+    }
+}
+
+void HostEffecterParser::effecterWriteDone(const EffecterWriteKey& key,
+                                           bool applied)
+{
+    auto& write = effecterWrites[key];
+    write.outstanding = false;
+
+    if (!write.sentStates.empty())
+    {
+        std::string states;
+        for (const auto& field : write.sentStates)
+        {
+            states += (states.empty() ? "" : " ");
+            states += field.set_request == PLDM_REQUEST_SET
+                          ? std::to_string(field.effecter_state)
+                          : "-";
+        }
+        if (applied)
+        {
+            debug(
+                "Host state effecter set, EID={EID}, EFFECTER_ID={EFFECTER_ID}, STATES={STATES}, COALESCED={COALESCED}",
+                "EID", key.first, "EFFECTER_ID", key.second, "STATES", states,
+                "COALESCED", write.coalesced);
+        }
+        else
+        {
+            error(
+                "Host state effecter not set, EID={EID}, EFFECTER_ID={EFFECTER_ID}, STATES={STATES}",
+                "EID", key.first, "EFFECTER_ID", key.second, "STATES", states);
+        }
+        write.sentStates.clear();
+    }
+    else if (applied)
+    {
+        debug(
+            "Host numeric effecter set, EID={EID}, EFFECTER_ID={EFFECTER_ID}, VALUE={VALUE}, COALESCED={COALESCED}",
+            "EID", key.first, "EFFECTER_ID", key.second, "VALUE",
+            write.sentRaw, "COALESCED", write.coalesced);
+    }
+    else
+    {
+        error(
+            "Host numeric effecter not set, EID={EID}, EFFECTER_ID={EFFECTER_ID}, VALUE={VALUE}",
+            "EID", key.first, "EFFECTER_ID", key.second, "VALUE",
+            write.sentRaw);
+    }
+
+    flushEffecterWrite(key);
+}
+
 void HostEffecterParser::createHostEffecterMatch(const std::string& objectPath,
-                                                 const std::string& interface,
-                                                 size_t effecterInfoIndex,
-                                                 size_t dbusInfoIndex,
-                                                 uint16_t effecterId)
+                                                 const std::string& interface)
 {
-    using namespace sdbusplus::bus::match::rules;
-    effecterInfoMatch.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
-        pldm::utils::DBusHandler::getBus(),
-        propertiesChanged(objectPath, interface),
-        [this, effecterInfoIndex, dbusInfoIndex,
-         effecterId](sdbusplus::message_t& msg) {
-        DbusChgHostEffecterProps props;
-        std::string iface;
-        msg.read(iface, props);
-        processHostEffecterChangeNotification(props, effecterInfoIndex,
-                                              dbusInfoIndex, effecterId);
-    }));
+    effecterInfoMatch.watch(
+        pldm::utils::DBusHandler::getBus(), objectPath, interface,
+        [this, objectPath, interface](const DbusChgHostEffecterProps* props,
+                                      const std::vector<std::string>&) {
+        if (props)
+        {
+            processPropertiesChanged(objectPath, interface, *props);
+        }
+    });
 }
 
 } // namespace host_effecters
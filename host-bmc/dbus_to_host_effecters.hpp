@@ -1,13 +1,22 @@
 #pragma once
 
 #include "common/instance_id.hpp"
+#include "common/pdr_index.hpp"
 #include "common/types.hpp"
 #include "common/utils.hpp"
 #include "requester/handler.hpp"
 
 #include <phosphor-logging/lg2.hpp>
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/utility/timer.hpp>
 
+#include <chrono>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -74,6 +83,62 @@ struct EffecterInfo
         dbusNumericEffecterInfo; //!< D-Bus information for the effecter id
 };
 
+/** @struct EffecterRef
+ *  Locates the effecter mapped to a D-Bus property
+ */
+struct EffecterRef
+{
+    size_t effecterInfoIndex; //!< Index of effecterInfo in hostEffecterInfo
+    size_t dbusInfoIndex;     //!< Index of the D-Bus info within effecterInfo
+    uint16_t effecterId;      //!< Effecter id from the json, may be invalid
+};
+
+/** @brief D-Bus object path and property name */
+using PropertyKey = std::pair<std::string, std::string>;
+
+/** @struct PropertyKeyHasher
+ *  Hash function of the object path and property name pair
+ */
+struct PropertyKeyHasher
+{
+    std::size_t operator()(const PropertyKey& key) const
+    {
+        return std::hash<std::string>{}(key.first) ^
+               (std::hash<std::string>{}(key.second) << 1);
+    }
+};
+
+/** @brief Key of an effecter write, the host mctp eid and the effecter id */
+using EffecterWriteKey = std::pair<uint8_t, uint16_t>;
+
+/** @struct EffecterWrite
+ *  Contains the write state of an effecter. At most one request is
+ *  outstanding per effecter, the values set meanwhile replace each other and
+ *  only the latest one is sent once the response is received and the
+ *  minimum interval between two writes has passed.
+ */
+struct EffecterWrite
+{
+    size_t effecterInfoIndex = 0; //!< Index of the effecter in hostEffecterInfo
+    uint8_t dataSize = 0;         //!< Numeric effecter data size
+    std::optional<std::vector<set_effecter_state_field>>
+        pendingStates;                //!< State fields waiting to be sent
+    std::optional<double> pendingRaw; //!< Numeric value waiting to be sent
+    std::vector<set_effecter_state_field>
+        sentStates;         //!< State fields of the request
+    double sentRaw = 0;     //!< Numeric value of the request
+    uint32_t coalesced = 0; //!< Values replaced before being sent
+    bool outstanding = false; //!< Request waiting for its response
+    std::chrono::steady_clock::time_point lastWrite{}; //!< Last request time
+    std::unique_ptr<
+        sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>>
+        timer; //!< Delays the pending write to the minimum interval
+}; //!< Last request time
+    std::unique_ptr<
+        sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>>
+        timer; //!< Delays the pending write to the minimum interval
+};
+
 /** @class HostEffecterParser
  *
  *  @brief This class parses the Host Effecter json file and monitors for the
@@ -104,7 +169,8 @@ class HostEffecterParser
         const std::string& jsonPath,
         pldm::requester::Handler<pldm::requester::Request>* handler) :
         instanceIdDb(instanceIdDb),
-        sockFd(fd), pdrRepo(repo), dbusHandler(dbusHandler), handler(handler)
+        sockFd(fd), pdrRepo(repo), pdrIndex(repo), dbusHandler(dbusHandler),
+        handler(handler)
     {
         try
         {
@@ -163,7 +229,8 @@ class HostEffecterParser
         std::vector<pldm::utils::PropertyValue>& propertyValues,
         const std::string& propertyType);
 
-    /* @brief Set a host state effecter
+    /* @brief Set a host state effecter, the fields requested to be set
+     *        replace the ones of a write which is not sent yet
      *
      * @param[in] effecterInfoIndex - index of effecterInfo pointer in
      *                                hostEffecterInfo
@@ -177,7 +244,8 @@ class HostEffecterParser
                              std::vector<set_effecter_state_field>& stateField,
                              uint16_t effecterId);
 
-    /* @brief Set a terminus numeric effecter
+    /* @brief Set a terminus numeric effecter, the value replaces the one of
+     *        a write which is not sent yet
      *
      * @param[in] effecterInfoIndex - index of effecterInfo pointer in
      *                                hostEffecterInfo
@@ -201,20 +269,34 @@ class HostEffecterParser
                               const pldm::utils::PropertyValue& propertyValue);
 
     /* @brief Subscribes for D-Bus property change signal on the specified
-     *        object
+     *        object, the objects of an interface share one match
      *
      * @param[in] objectPath - D-Bus object path to look for
      * @param[in] interface - D-Bus interface
-     * @param[in] effecterInfoIndex - index of effecterInfo pointer in
-     *                                hostEffecterInfo
-     * @param[in] dbusInfoIndex - index of dbusInfo within effecterInfo
-     * @param[in] effecterId - host effecter id
      */
     virtual void createHostEffecterMatch(const std::string& objectPath,
-                                         const std::string& interface,
-                                         size_t effecterInfoIndex,
-                                         size_t dbusInfoIndex,
-                                         uint16_t effecterId);
+                                         const std::string& interface);
+
+    /* @brief Dispatch the changed properties of an object to the effecters
+     *        mapped to them
+     *
+     * @param[in] objectPath - D-Bus object path
+     * @param[in] interface - D-Bus interface of the properties
+     * @param[in] chProperties - list of properties which have changed
+     */
+    void processPropertiesChanged(const std::string& objectPath,
+                                  const std::string& interface,
+                                  const DbusChgHostEffecterProps& chProperties);
+
+    /* @brief Find the effecters mapped to a D-Bus property
+     *
+     * @param[in] objectPath - D-Bus object path
+     * @param[in] property - D-Bus property name
+     * @return - the effecters, nullptr if the property is not mapped
+     */
+    const std::vector<EffecterRef>*
+        findEffecters(const std::string& objectPath,
+                      const std::string& property) const;
 
   private:
     /* @brief Adjust the nummeric effecter value base on the effecter
@@ -229,24 +311,95 @@ class HostEffecterParser
      */
     double adjustValue(double value, double offset, double resolution,
                        int8_t modify);
-    /* @brief Verify host On state before configure the host effecters
+    /* @brief Verify host On state before configure the host effecters, the
+     *        state is read once and then follows the BootProgress signals
      *
      * @return - true if host is on and false for others cases
      */
     bool isHostOn(void);
 
+    /* @brief Whether a BootProgress value means the host is up
+     *
+     * @param[in] bootProgress - BootProgress property value
+     * @return - true if the host is up
+     */
+    static bool isHostUpState(const std::string& bootProgress);
+
+    /* @brief Index the D-Bus property of an effecter and subscribe for the
+     *        changes of its interface unless already done
+     *
+     * @param[in] dbusMap - D-Bus mapping of the effecter
+     * @param[in] effecterRef - location of the effecter
+     */
+    void addEffecterProperty(const pldm::utils::DBusMapping& dbusMap,
+                             const EffecterRef& effecterRef);
+
+    /* @brief Send the pending write of an effecter unless a request is
+     *        outstanding or the minimum interval has not passed yet
+     *
+     * @param[in] key - effecter write key
+     */
+    void flushEffecterWrite(const EffecterWriteKey& key);
+
   protected:
+    /* @brief Encode and send the SetStateEffecterStates request
+     *
+     * @param[in] key - effecter write key
+     * @param[in] effecterInfoIndex - index of effecterInfo pointer in
+     *                                hostEffecterInfo
+     * @param[in] stateField - state fields to set
+     * @return - PLDM status code
+     */
+    virtual int
+        sendHostStateEffecter(const EffecterWriteKey& key,
+                              size_t effecterInfoIndex,
+                              std::vector<set_effecter_state_field>& stateField);
+
+    /* @brief Encode and send the SetNumericEffecterValue request
+     *
+     * @param[in] key - effecter write key
+     * @param[in] effecterInfoIndex - index of effecterInfo pointer in
+     *                                hostEffecterInfo
+     * @param[in] dataSize - data size
+     * @param[in] rawValue - raw value
+     * @return - PLDM status code
+     */
+    virtual int sendTerminusNumericEffecter(const EffecterWriteKey& key,
+                                            size_t effecterInfoIndex,
+                                            uint8_t dataSize, double rawValue);
+
+    /* @brief Handle the end of the outstanding request of an effecter and
+     *        send the write which came meanwhile
+     *
+     * @param[in] key - effecter write key
+     * @param[in] applied - true if the host applied the value
+     */
+    void effecterWriteDone(const EffecterWriteKey& key, bool applied);
+
     pldm::InstanceIdDb* instanceIdDb; //!< Reference to the InstanceIdDb object
                                       //!< to obtain instance id
     int sockFd;                       //!< Socket fd to send message to host
     const pldm_pdr* pdrRepo;          //!< Reference to PDR repo
+    pldm::utils::PdrIndex pdrIndex;   //!< Lookup index of the PDR repo
     std::vector<EffecterInfo> hostEffecterInfo; //!< Parsed effecter information
-    std::vector<std::unique_ptr<sdbusplus::bus::match_t>>
-        effecterInfoMatch; //!< vector to catch the D-Bus property change
-                           //!< signals for the effecters
+    pldm::utils::PropertiesChangedDispatcher
+        effecterInfoMatch; //!< catches the D-Bus property change signals
+                           //!< for the effecters, one match per interface
     const pldm::utils::DBusHandler* dbusHandler; //!< D-bus Handler
     /** @brief PLDM request handler */
     pldm::requester::Handler<pldm::requester::Request>* handler;
+    /** @brief Effecters of each D-Bus object path and property */
+    std::unordered_map<PropertyKey, std::vector<EffecterRef>,
+                       PropertyKeyHasher>
+        propertyEffecters;
+    /** @brief Object paths and interfaces with a property change match */
+    std::set<std::pair<std::string, std::string>> watchedInterfaces;
+    /** @brief Cached host state, unset until read */
+    std::optional<bool> hostOn;
+    /** @brief Keeps the cached host state up to date */
+    std::unique_ptr<sdbusplus::bus::match_t> hostStateMatch;
+    /** @brief Write state of the effecters set since the start */
+    std::map<EffecterWriteKey, EffecterWrite> effecterWrites;
 };
 
 } // namespace host_effecters
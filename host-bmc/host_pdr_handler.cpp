@@ -4,6 +4,7 @@
 #ifdef OEM_IBM
 #include "libpldm/fru_oem_ibm.h"
 #endif
+#include "common/pdr_index.hpp"
 #include "custom_dbus.hpp"
 
 #include <assert.h>
@@ -53,14 +54,9 @@ uint16_t extractTerminusHandle(std::vector<uint8_t>& pdr)
 }
 
 template <typename T>
-void updateContainerId(pldm_entity_association_tree* entityTree,
-                       std::vector<uint8_t>& pdr)
+void updateContainerId(HostPDRHandler& pdrHandler, std::vector<uint8_t>& pdr)
 {
     T* t = nullptr;
-    if (entityTree == nullptr)
-    {
-        return;
-    }
     if (std::is_same<T, pldm_pdr_fru_record_set>::value)
     {
         t = (T*)(pdr.data() + sizeof(pldm_pdr_hdr));
@@ -75,12 +71,9 @@ void updateContainerId(pldm_entity_association_tree* entityTree,
     }
 
     pldm_entity entity{t->entity_type, t->entity_instance, t->container_id};
-    auto node = pldm_entity_association_tree_find_with_locality(entityTree,
-                                                                &entity, true);
-    if (node)
+    if (pdrHandler.findEntity(entity, true))
     {
-        pldm_entity e = pldm_entity_extract(node);
-        t->container_id = e.entity_container_id;
+        t->container_id = entity.entity_container_id;
     }
 }
 
@@ -90,13 +83,18 @@ HostPDRHandler::HostPDRHandler(
     pldm_entity_association_tree* bmcEntityTree,
     pldm::InstanceIdDb& instanceIdDb,
     pldm::requester::Handler<pldm::requester::Request>* handler,
-    pldm::responder::oem_platform::Handler* oemPlatformHandler) :
+    pldm::responder::oem_platform::Handler* oemPlatformHandler,
+    uint8_t hostIndex, uint8_t hostCount) :
     mctp_fd(mctp_fd),
-    mctp_eid(mctp_eid), event(event), repo(repo),
+    mctp_eid(mctp_eid), hostEID(mctp_eid), hostCount(hostCount),
+    terminusHandleBase(hostIndex * hostTerminusHandleRange), event(event),
+    repo(repo),
     stateSensorHandler(eventsJsonsDir), entityTree(entityTree),
     bmcEntityTree(bmcEntityTree), instanceIdDb(instanceIdDb), handler(handler),
-    oemPlatformHandler(oemPlatformHandler)
+    oemPlatformHandler(oemPlatformHandler),
+    repoChgTimer(event, [this](auto&) { flushPDRRepositoryChgEvent(); })
 {
+    repoChgTimer.setEnabled(false);
     mergedHostParents = false;
     fs::path hostFruJson(fs::path(HOST_JSONS_DIR) / fruJson);
     if (fs::exists(hostFruJson))
@@ -134,9 +132,10 @@ HostPDRHandler::HostPDRHandler(
 
     hostOffMatch = std::make_unique<sdbusplus::bus::match_t>(
         pldm::utils::DBusHandler::getBus(),
-        propertiesChanged("/xyz/openbmc_project/state/host0",
+        propertiesChanged("/xyz/openbmc_project/state/host" +
+                              std::to_string(hostIndex),
                           "xyz.openbmc_project.State.Host"),
-        [this, repo, entityTree, bmcEntityTree](sdbusplus::message_t& msg) {
+        [this](sdbusplus::message_t& msg) {
         DbusChangedProps props{};
         std::string intf;
         msg.read(intf, props);
@@ -147,15 +146,9 @@ HostPDRHandler::HostPDRHandler(
             auto propVal = std::get<std::string>(value);
             if (propVal == "xyz.openbmc_project.State.Host.HostState.Off")
             {
-                // Delete all the remote terminus information
-                std::erase_if(tlPDRInfo, [](const auto& item) {
-                    auto const& [key, value] = item;
-                    return key != TERMINUS_HANDLE;
-                });
-                pldm_pdr_remove_remote_pdrs(repo);
-                pldm_entity_association_tree_destroy_root(entityTree);
-                pldm_entity_association_tree_copy_root(bmcEntityTree,
-                                                       entityTree);
+                removeHostPDRs();
+                this->remoteEntityIndex.clear();
+                this->mergedAssociations.clear();
                 this->sensorMap.clear();
                 this->responseReceived = false;
                 this->mergedHostParents = false;
@@ -188,15 +181,128 @@ void HostPDRHandler::fetchPDR(PDRRecordHandles&& recordHandles)
 
 void HostPDRHandler::_fetchPDR(sdeventplus::source::EventBase& /*source*/)
 {
+    // The FRU responses of a PDR exchange still in progress are dropped, the
+    // objects are created from the responses of this one
+    pdrSyncId++;
+
+    // The PDRs of a known list of record handles are fetched ahead
+    auto& recordHandles =
+        isHostPdrModified ? modifiedPDRRecordHandles : pdrRecordHandles;
+    if (!recordHandles.empty())
+    {
+        pdrFetchEvent.reset();
+        prefetchQueue = std::move(recordHandles);
+        recordHandles.clear();
+        prefetchedPDRs.clear();
+        pdrPrefetchesInFlight = 0;
+        lastPrefetchedNextHandle = std::nullopt;
+        prefetchHostPDRs();
+        return;
+    }
     getHostPDR();
 }
 
+void HostPDRHandler::prefetchHostPDRs()
+{
+    while (!prefetchQueue.empty() && pdrPrefetchesInFlight < pdrPrefetchWindow)
+    {
+        auto recordHandle = prefetchQueue.front();
+        prefetchQueue.pop_front();
+        auto prefetched = std::make_shared<PrefetchedPDR>();
+        prefetchedPDRs.push_back(prefetched);
+
+        auto requestMsg = pldm::utils::RequestPool::acquire(
+            sizeof(pldm_msg_hdr) + PLDM_GET_PDR_REQ_BYTES);
+        auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+        auto instanceId = instanceIdDb.next(mctp_eid);
+        auto rc = encode_get_pdr_req(instanceId, recordHandle, 0,
+                                     PLDM_GET_FIRSTPART, UINT16_MAX, 0,
+                                     request, PLDM_GET_PDR_REQ_BYTES);
+        if (rc != PLDM_SUCCESS)
+        {
+            instanceIdDb.free(mctp_eid, instanceId);
+            error("Failed to encode_get_pdr_req, rc = {RC}", "RC", rc);
+            prefetched->received = true;
+            continue;
+        }
+
+        auto getPDRRespHandler = [this, prefetched, syncId = pdrSyncId](
+                                     mctp_eid_t /*eid*/,
+                                     const pldm_msg* response,
+                                     size_t respMsgLen) {
+            if (syncId != pdrSyncId)
+            {
+                return;
+            }
+            pdrPrefetchesInFlight--;
+            prefetched->received = true;
+            if (response == nullptr || !respMsgLen)
+            {
+                error("Failed to receive response for the GetPDR command");
+            }
+            else
+            {
+                auto responsePtr = reinterpret_cast<const uint8_t*>(response);
+                prefetched->response.assign(responsePtr,
+                                            responsePtr + sizeof(pldm_msg_hdr) +
+                                                respMsgLen);
+            }
+            prefetchHostPDRs();
+        };
+
+        pdrPrefetchesInFlight++;
+        rc = handler->registerRequest(mctp_eid, instanceId, PLDM_PLATFORM,
+                                      PLDM_GET_PDR, std::move(requestMsg),
+                                      std::move(getPDRRespHandler));
+        if (rc)
+        {
+            pdrPrefetchesInFlight--;
+            prefetched->received = true;
+            error("Failed to send the GetPDR request to Host");
+        }
+    }
+
+    processPrefetchedPDRs();
+}
+
+void HostPDRHandler::processPrefetchedPDRs()
+{
+    // The PDRs are added in the order of the record handles, a response
+    // waits for the ones of the handles before it
+    bool processed = false;
+    while (!prefetchedPDRs.empty() && prefetchedPDRs.front()->received)
+    {
+        auto prefetched = std::move(prefetchedPDRs.front());
+        prefetchedPDRs.pop_front();
+        processed = true;
+        if (prefetched->response.empty())
+        {
+            lastPrefetchedNextHandle = std::nullopt;
+            continue;
+        }
+        lastPrefetchedNextHandle = addHostPDR(
+            reinterpret_cast<const pldm_msg*>(prefetched->response.data()),
+            prefetched->response.size() - sizeof(pldm_msg_hdr));
+    }
+
+    if (!processed || !prefetchedPDRs.empty() || !prefetchQueue.empty())
+    {
+        return;
+    }
+    // The exchange goes on from the last PDR of the list, as when the handles
+    // are fetched one at a time
+    if (lastPrefetchedNextHandle && *lastPrefetchedNextHandle)
+    {
+        continueHostPDRs(*lastPrefetchedNextHandle);
+    }
+}
+
 void HostPDRHandler::getHostPDR(uint32_t nextRecordHandle)
 {
     pdrFetchEvent.reset();
 
-    std::vector<uint8_t> requestMsg(sizeof(pldm_msg_hdr) +
-                                    PLDM_GET_PDR_REQ_BYTES);
+    auto requestMsg = pldm::utils::RequestPool::acquire(sizeof(pldm_msg_hdr) +
+                                                        PLDM_GET_PDR_REQ_BYTES);
     auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
     uint32_t recordHandle{};
     if (!nextRecordHandle && (!modifiedPDRRecordHandles.empty()) &&
@@ -264,6 +370,7 @@ void HostPDRHandler::mergeEntityAssociations(
         // Adding the remote range PDRs to the repo before merging it
         uint32_t handle = record_handle;
         pldm_pdr_add_check(repo, pdr.data(), size, true, 0xFFFF, &handle);
+        pldm::utils::notifyPdrRepoChanged();
     }
 
     pldm_entity_association_pdr_extract(pdr.data(), pdr.size(), &numEntities,
@@ -278,11 +385,11 @@ void HostPDRHandler::mergeEntityAssociations(
         }
         else
         {
-            pNode = pldm_entity_association_tree_find_with_locality(
-                entityTree, &entities[0], true);
+            pNode = findEntity(entities[0], true);
         }
         if (!pNode)
         {
+            free(entities);
             return;
         }
 
@@ -312,48 +419,83 @@ void HostPDRHandler::mergeEntityAssociations(
         if (merged)
         {
             entityAssociations.push_back(entityAssoc);
+            // The association PDRs of the parent are regenerated once the
+            // whole repository of the host is merged
+            mergedAssociations.push_back(
+                {pNode, std::vector<pldm_entity>(entities,
+                                                 entities + numEntities)});
         }
     }
+    free(entities);
+}
+
+pldm_entity_node* HostPDRHandler::findEntity(pldm_entity& entity,
+                                             bool isRemote)
+{
+    if (entityTree == nullptr)
+    {
+        return nullptr;
+    }
+    if (!isRemote)
+    {
+        return pldm_entity_association_tree_find_with_locality(
+            entityTree, &entity, false);
+    }
 
-    if (merged)
+    auto key = (static_cast<uint64_t>(entity.entity_type) << 32) |
+               (static_cast<uint64_t>(entity.entity_instance_num) << 16) |
+               entity.entity_container_id;
+    auto it = remoteEntityIndex.find(key);
+    if (it == remoteEntityIndex.end())
     {
-        // Update our PDR repo with the merged entity association PDRs
-        pldm_entity_node* node = nullptr;
-        pldm_find_entity_ref_in_tree(entityTree, entities[0], &node);
-        if (node == nullptr)
+        auto node = pldm_entity_association_tree_find_with_locality(
+            entityTree, &entity, true);
+        if (!node)
         {
-            error("could not find referrence of the entity in the tree");
+            return nullptr;
         }
-        else
+        it = remoteEntityIndex.emplace(key, node).first;
+    }
+    entity.entity_container_id =
+        pldm_entity_extract(it->second).entity_container_id;
+    return it->second;
+}
+
+void HostPDRHandler::addMergedAssociationPDRs()
+{
+    for (auto& [node, entities] : mergedAssociations)
+    {
+        auto entityList = entities.data();
+        int rc = 0;
+        if (oemPlatformHandler)
         {
-            int rc = 0;
-            if (oemPlatformHandler)
-            {
-                auto record = oemPlatformHandler->fetchLastBMCRecord(repo);
+            auto record = oemPlatformHandler->fetchLastBMCRecord(repo);
 
-                uint32_t record_handle = pldm_pdr_get_record_handle(repo,
-                                                                    record);
+            uint32_t record_handle = pldm_pdr_get_record_handle(repo, record);
 
-                rc =
-                    pldm_entity_association_pdr_add_from_node_with_record_handle(
-                        node, repo, &entities, numEntities, true,
-                        TERMINUS_HANDLE, (record_handle + 1));
-            }
-            else
-            {
-                rc = pldm_entity_association_pdr_add_from_node_check(
-                    node, repo, &entities, numEntities, true, TERMINUS_HANDLE);
-            }
+            rc = pldm_entity_association_pdr_add_from_node_with_record_handle(
+                node, repo, &entityList, entities.size(), true,
+                TERMINUS_HANDLE, (record_handle + 1));
+        }
+        else
+        {
+            rc = pldm_entity_association_pdr_add_from_node_check(
+                node, repo, &entityList, entities.size(), true,
+                TERMINUS_HANDLE);
+        }
 
-            if (rc)
-            {
-                error(
-                    "Failed to add entity association PDR from node: {LIBPLDM_ERROR}",
-                    "LIBPLDM_ERROR", rc);
-            }
+        if (rc)
+        {
+            error(
+                "Failed to add entity association PDR from node: {LIBPLDM_ERROR}",
+                "LIBPLDM_ERROR", rc);
         }
     }
-    free(entities);
+    if (!mergedAssociations.empty())
+    {
+        pldm::utils::notifyPdrRepoChanged();
+    }
+    mergedAssociations.clear();
 }
 
 void HostPDRHandler::sendPDRRepositoryChgEvent(std::vector<uint8_t>&& pdrTypes,
@@ -361,12 +503,27 @@ void HostPDRHandler::sendPDRRepositoryChgEvent(std::vector<uint8_t>&& pdrTypes,
 {
     assert(eventDataFormat == FORMAT_IS_PDR_HANDLES);
 
+    pendingChgPdrTypes.insert(pdrTypes.begin(), pdrTypes.end());
+    if (!PDR_REPO_CHG_EVENT_WINDOW)
+    {
+        flushPDRRepositoryChgEvent();
+    }
+    else if (!repoChgTimer.isEnabled())
+    {
+        repoChgTimer.restartOnce(
+            std::chrono::milliseconds(PDR_REPO_CHG_EVENT_WINDOW));
+    }
+}
+
+void HostPDRHandler::flushPDRRepositoryChgEvent()
+{
+    uint8_t eventDataFormat = FORMAT_IS_PDR_HANDLES;
+    auto pdrTypes = std::move(pendingChgPdrTypes);
+    pendingChgPdrTypes.clear();
+
     // Extract from the PDR repo record handles of PDRs we want the host
-    // to pull up.
-    std::vector<uint8_t> eventDataOps{PLDM_RECORDS_ADDED};
-    std::vector<uint8_t> numsOfChangeEntries(1);
-    std::vector<std::vector<ChangeEntry>> changeEntries(
-        numsOfChangeEntries.size());
+    // to pull up, a handle is listed once however many types changed.
+    std::set<ChangeEntry> handles;
     for (auto pdrType : pdrTypes)
     {
         const pldm_pdr_record* record{};
@@ -376,31 +533,51 @@ void HostPDRHandler::sendPDRRepositoryChgEvent(std::vector<uint8_t>&& pdrTypes,
                                                   nullptr, nullptr);
             if (record && pldm_pdr_record_is_remote(record))
             {
-                changeEntries[0].push_back(
-                    pldm_pdr_get_record_handle(repo, record));
+                handles.insert(pldm_pdr_get_record_handle(repo, record));
             }
         } while (record);
     }
-    if (changeEntries.empty())
+    if (handles.empty())
     {
         return;
     }
-    numsOfChangeEntries[0] = changeEntries[0].size();
+
+    // A change record holds at most UINT8_MAX change entries, the handles
+    // are split over as many records of the same operation as needed.
+    std::vector<std::vector<ChangeEntry>> changeEntries;
+    for (auto handle : handles)
+    {
+        if (changeEntries.empty() || changeEntries.back().size() == UINT8_MAX)
+        {
+            changeEntries.emplace_back();
+        }
+        changeEntries.back().push_back(handle);
+    }
+    std::vector<uint8_t> eventDataOps(changeEntries.size(),
+                                      PLDM_RECORDS_ADDED);
+    std::vector<uint8_t> numsOfChangeEntries;
+    std::vector<ChangeEntry*> entries;
+    for (auto& changeRecord : changeEntries)
+    {
+        numsOfChangeEntries.push_back(changeRecord.size());
+        entries.push_back(changeRecord.data());
+    }
 
     // Encode PLDM platform event msg to indicate a PDR repo change.
     size_t maxSize = PLDM_PDR_REPOSITORY_CHG_EVENT_MIN_LENGTH +
-                     PLDM_PDR_REPOSITORY_CHANGE_RECORD_MIN_LENGTH +
-                     changeEntries[0].size() * sizeof(uint32_t);
+                     changeEntries.size() *
+                         PLDM_PDR_REPOSITORY_CHANGE_RECORD_MIN_LENGTH +
+                     handles.size() * sizeof(uint32_t);
     std::vector<uint8_t> eventDataVec{};
     eventDataVec.resize(maxSize);
     auto eventData =
         reinterpret_cast<struct pldm_pdr_repository_chg_event_data*>(
             eventDataVec.data());
     size_t actualSize{};
-    auto firstEntry = changeEntries[0].data();
     auto rc = encode_pldm_pdr_repository_chg_event_data(
-        eventDataFormat, 1, eventDataOps.data(), numsOfChangeEntries.data(),
-        &firstEntry, eventData, &actualSize, maxSize);
+        eventDataFormat, changeEntries.size(), eventDataOps.data(),
+        numsOfChangeEntries.data(), entries.data(), eventData, &actualSize,
+        maxSize);
     if (rc != PLDM_SUCCESS)
     {
         error("Failed to encode_pldm_pdr_repository_chg_event_data, rc = {RC}",
@@ -481,9 +658,45 @@ void HostPDRHandler::processHostPDRs(mctp_eid_t /*eid*/,
                                      const pldm_msg* response,
                                      size_t respMsgLen)
 {
-    static bool merged = false;
-    static PDRList stateSensorPDRs{};
-    static PDRList fruRecordSetPDRs{};
+    auto nextRecordHandle = addHostPDR(response, respMsgLen);
+    if (nextRecordHandle && *nextRecordHandle)
+    {
+        continueHostPDRs(*nextRecordHandle);
+    }
+}
+
+void HostPDRHandler::removeHostPDRs()
+{
+    // Delete all the remote terminus information
+    std::erase_if(tlPDRInfo, [](const auto& item) {
+        auto const& [key, value] = item;
+        return key != TERMINUS_HANDLE;
+    });
+    if (hostCount <= 1)
+    {
+        pldm_pdr_remove_remote_pdrs(repo);
+        pldm_entity_association_tree_destroy_root(entityTree);
+        pldm_entity_association_tree_copy_root(bmcEntityTree, entityTree);
+    }
+    else
+    {
+        // The other hosts keep their PDRs and the entities they merged into
+        // the shared tree
+        for (auto terminusHandle : repoTerminusHandles)
+        {
+            pldm_pdr_remove_pdrs_by_terminus_handle(repo, terminusHandle);
+        }
+    }
+    repoTerminusHandles.clear();
+    pldm::utils::notifyPdrRepoChanged();
+}
+
+std::optional<uint32_t> HostPDRHandler::addHostPDR(const pldm_msg* response,
+                                                   size_t respMsgLen)
+{
+    auto& merged = mergedInExchange;
+    auto& stateSensorPDRs = exchangeStateSensorPDRs;
+    auto& fruRecordSetPDRs = exchangeFruRecordSetPDRs;
     uint32_t nextRecordHandle{};
     uint8_t tlEid = 0;
     bool tlValid = true;
@@ -500,7 +713,7 @@ void HostPDRHandler::processHostPDRs(mctp_eid_t /*eid*/,
     if (response == nullptr || !respMsgLen)
     {
         error("Failed to receive response for the GetPDR command");
-        return;
+        return std::nullopt;
     }
 
     auto rc = decode_get_pdr_resp(
@@ -513,7 +726,7 @@ void HostPDRHandler::processHostPDRs(mctp_eid_t /*eid*/,
     if (rc != PLDM_SUCCESS)
     {
         error("Failed to decode_get_pdr_resp, rc = {RC}", "RC", rc);
-        return;
+        return std::nullopt;
     }
     else
     {
@@ -526,7 +739,7 @@ void HostPDRHandler::processHostPDRs(mctp_eid_t /*eid*/,
         {
             error("Failed to decode_get_pdr_resp: rc = {RC}, cc = {CC}", "RC",
                   rc, "CC", static_cast<unsigned>(completionCode));
-            return;
+            return std::nullopt;
         }
         else
         {
@@ -585,7 +798,7 @@ void HostPDRHandler::processHostPDRs(mctp_eid_t /*eid*/,
                         {
                             // TL PDR already present with same validity don't
                             // add the PDR to the repo just return
-                            return;
+                            return std::nullopt;
                         }
                     }
                     tlPDRInfo.insert_or_assign(
@@ -596,21 +809,21 @@ void HostPDRHandler::processHostPDRs(mctp_eid_t /*eid*/,
                 {
                     pdrTerminusHandle =
                         extractTerminusHandle<pldm_state_sensor_pdr>(pdr);
-                    updateContainerId<pldm_state_sensor_pdr>(entityTree, pdr);
+                    updateContainerId<pldm_state_sensor_pdr>(*this, pdr);
                     stateSensorPDRs.emplace_back(pdr);
                 }
                 else if (pdrHdr->type == PLDM_PDR_FRU_RECORD_SET)
                 {
                     pdrTerminusHandle =
                         extractTerminusHandle<pldm_pdr_fru_record_set>(pdr);
-                    updateContainerId<pldm_pdr_fru_record_set>(entityTree, pdr);
+                    updateContainerId<pldm_pdr_fru_record_set>(*this, pdr);
                     fruRecordSetPDRs.emplace_back(pdr);
                 }
                 else if (pdrHdr->type == PLDM_STATE_EFFECTER_PDR)
                 {
                     pdrTerminusHandle =
                         extractTerminusHandle<pldm_state_effecter_pdr>(pdr);
-                    updateContainerId<pldm_state_effecter_pdr>(entityTree, pdr);
+                    updateContainerId<pldm_state_effecter_pdr>(*this, pdr);
                 }
                 else if (pdrHdr->type == PLDM_NUMERIC_EFFECTER_PDR)
                 {
@@ -618,13 +831,14 @@ void HostPDRHandler::processHostPDRs(mctp_eid_t /*eid*/,
                         extractTerminusHandle<pldm_numeric_effecter_value_pdr>(
                             pdr);
                     updateContainerId<pldm_numeric_effecter_value_pdr>(
-                        entityTree, pdr);
+                        *this, pdr);
                 }
                 // if the TLPDR is invalid update the repo accordingly
                 if (!tlValid)
                 {
                     pldm_pdr_update_TL_pdr(repo, terminusHandle, tid, tlEid,
                                            tlValid);
+                    pldm::utils::notifyPdrRepoChanged();
 
                     if (!isHostUp())
                     {
@@ -636,19 +850,23 @@ void HostPDRHandler::processHostPDRs(mctp_eid_t /*eid*/,
                 }
                 else
                 {
+                    pdrTerminusHandle = toRepoTerminusHandle(pdrTerminusHandle);
                     rc = pldm_pdr_add_check(repo, pdr.data(), respCount, true,
                                             pdrTerminusHandle, &rh);
+                    repoTerminusHandles.insert(pdrTerminusHandle);
                     if (rc)
                     {
                         // pldm_pdr_add() assert()ed on failure to add a PDR.
                         throw std::runtime_error("Failed to add PDR");
                     }
+                    pldm::utils::notifyPdrRepoChanged();
                 }
             }
         }
     }
     if (!nextRecordHandle)
     {
+        addMergedAssociationPDRs();
         updateEntityAssociation(entityAssociations, entityTree, objPathMap);
 
         /*received last record*/
@@ -673,21 +891,21 @@ void HostPDRHandler::processHostPDRs(mctp_eid_t /*eid*/,
                         this, std::placeholders::_1));
         }
     }
+    return nextRecordHandle;
+}
+
+void HostPDRHandler::continueHostPDRs(uint32_t nextRecordHandle)
+{
+    if (modifiedPDRRecordHandles.empty() && isHostPdrModified)
+    {
+        isHostPdrModified = false;
+    }
     else
     {
-        if (modifiedPDRRecordHandles.empty() && isHostPdrModified)
-        {
-            isHostPdrModified = false;
-        }
-        else
-        {
-            deferredFetchPDREvent =
-                std::make_unique<sdeventplus::source::Defer>(
-                    event,
-                    std::bind(
-                        std::mem_fn((&HostPDRHandler::_processFetchPDREvent)),
-                        this, nextRecordHandle, std::placeholders::_1));
-        }
+        deferredFetchPDREvent = std::make_unique<sdeventplus::source::Defer>(
+            event,
+            std::bind(std::mem_fn((&HostPDRHandler::_processFetchPDREvent)),
+                      this, nextRecordHandle, std::placeholders::_1));
     }
 }
 
@@ -764,6 +982,12 @@ bool HostPDRHandler::isHostUp()
 
 void HostPDRHandler::setHostSensorState(const PDRList& stateSensorPDRs)
 {
+    // A new PDR exchange supersedes the readings still in flight
+    sensorReadQueue.clear();
+    sensorReadings.clear();
+    sensorReadsInFlight = 0;
+    sensorReadSyncId++;
+
     for (const auto& stateSensorPDR : stateSensorPDRs)
     {
         auto pdr = reinterpret_cast<const pldm_state_sensor_pdr*>(
@@ -777,8 +1001,6 @@ void HostPDRHandler::setHostSensorState(const PDRList& stateSensorPDRs)
             return;
         }
 
-        uint16_t sensorId = pdr->sensor_id;
-
         for (const auto& [terminusHandle, terminusInfo] : tlPDRInfo)
         {
             if (terminusHandle == pdr->terminus_handle)
@@ -787,131 +1009,161 @@ void HostPDRHandler::setHostSensorState(const PDRList& stateSensorPDRs)
                 {
                     mctp_eid = std::get<1>(terminusInfo);
                 }
+                sensorReadQueue.push_back(
+                    {mctp_eid, std::get<0>(terminusInfo), pdr->sensor_id, 0,
+                     {}});
+            }
+        }
+    }
 
-                bitfield8_t sensorRearm;
-                sensorRearm.byte = 0;
-                uint8_t tid = std::get<0>(terminusInfo);
+    sendSensorReads();
+}
+
+void HostPDRHandler::sendSensorReads()
+{
+    while (!sensorReadQueue.empty() && sensorReadsInFlight < sensorReadWindow)
+    {
+        auto reading = std::move(sensorReadQueue.front());
+        sensorReadQueue.pop_front();
+
+        bitfield8_t sensorRearm;
+        sensorRearm.byte = 0;
+        auto instanceId = instanceIdDb.next(reading.eid);
+        std::vector<uint8_t> requestMsg(
+            sizeof(pldm_msg_hdr) + PLDM_GET_STATE_SENSOR_READINGS_REQ_BYTES);
+        auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+        auto rc = encode_get_state_sensor_readings_req(
+            instanceId, reading.sensorId, sensorRearm, 0, request);
+
+        if (rc != PLDM_SUCCESS)
+        {
+            instanceIdDb.free(reading.eid, instanceId);
+            error("Failed to encode_get_state_sensor_readings_req, rc = {RC}",
+                  "RC", rc);
+            pldm::utils::reportError(
+                "xyz.openbmc_project.bmc.pldm.InternalFailure");
+            continue;
+        }
 
-                auto instanceId = instanceIdDb.next(mctp_eid);
-                std::vector<uint8_t> requestMsg(
-                    sizeof(pldm_msg_hdr) +
-                    PLDM_GET_STATE_SENSOR_READINGS_REQ_BYTES);
-                auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
-                auto rc = encode_get_state_sensor_readings_req(
-                    instanceId, sensorId, sensorRearm, 0, request);
+        auto eid = reading.eid;
+        auto getStateSensorReadingRespHandler =
+            [this, reading = std::move(reading), syncId = sensorReadSyncId](
+                mctp_eid_t /*eid*/, const pldm_msg* response,
+                size_t respMsgLen) mutable {
+            if (syncId != sensorReadSyncId)
+            {
+                return;
+            }
+            sensorReadsInFlight--;
 
-                if (rc != PLDM_SUCCESS)
+            if (response == nullptr || !respMsgLen)
+            {
+                error(
+                    "Failed to receive response for getStateSensorReading command");
+            }
+            else
+            {
+                uint8_t completionCode = 0;
+                auto rc = decode_get_state_sensor_readings_resp(
+                    response, respMsgLen, &completionCode,
+                    &reading.compSensorCount, reading.stateField.data());
+                if (rc != PLDM_SUCCESS || completionCode != PLDM_SUCCESS)
                 {
-                    instanceIdDb.free(mctp_eid, instanceId);
                     error(
-                        "Failed to encode_get_state_sensor_readings_req, rc = {RC}",
-                        "RC", rc);
+                        "Failed to decode_get_state_sensor_readings_resp, rc = {RC} cc = {CC}",
+                        "RC", rc, "CC", static_cast<unsigned>(completionCode));
                     pldm::utils::reportError(
                         "xyz.openbmc_project.bmc.pldm.InternalFailure");
-                    return;
                 }
+                else
+                {
+                    sensorReadings.push_back(std::move(reading));
+                }
+            }
 
-                auto getStateSensorReadingRespHandler =
-                    [=, this](mctp_eid_t /*eid*/, const pldm_msg* response,
-                              size_t respMsgLen) {
-                    if (response == nullptr || !respMsgLen)
-                    {
-                        error(
-                            "Failed to receive response for getStateSensorReading command");
-                        return;
-                    }
-                    std::array<get_sensor_state_field, 8> stateField{};
-                    uint8_t completionCode = 0;
-                    uint8_t comp_sensor_count = 0;
-
-                    auto rc = decode_get_state_sensor_readings_resp(
-                        response, respMsgLen, &completionCode,
-                        &comp_sensor_count, stateField.data());
+            sendSensorReads();
+        };
 
-                    if (rc != PLDM_SUCCESS || completionCode != PLDM_SUCCESS)
-                    {
-                        error(
-                            "Failed to decode_get_state_sensor_readings_resp, rc = {RC} cc = {CC}",
-                            "RC", rc, "CC",
-                            static_cast<unsigned>(completionCode));
-                        pldm::utils::reportError(
-                            "xyz.openbmc_project.bmc.pldm.InternalFailure");
-                    }
+        sensorReadsInFlight++;
+        rc = handler->registerRequest(
+            eid, instanceId, PLDM_PLATFORM, PLDM_GET_STATE_SENSOR_READINGS,
+            std::move(requestMsg), std::move(getStateSensorReadingRespHandler));
 
-                    uint8_t eventState;
-                    uint8_t previousEventState;
+        if (rc != PLDM_SUCCESS)
+        {
+            sensorReadsInFlight--;
+            error("Failed to send request to get State sensor reading on Host");
+        }
+    }
 
-                    for (uint8_t sensorOffset = 0;
-                         sensorOffset < comp_sensor_count; sensorOffset++)
-                    {
-                        eventState = stateField[sensorOffset].present_state;
-                        previousEventState =
-                            stateField[sensorOffset].previous_state;
+    if (sensorReadQueue.empty() && !sensorReadsInFlight &&
+        !sensorReadings.empty())
+    {
+        // All the readings are in, apply them in one pass
+        auto readings = std::move(sensorReadings);
+        sensorReadings.clear();
+        for (const auto& reading : readings)
+        {
+            applySensorReading(reading);
+        }
+    }
+}
 
-                        emitStateSensorEventSignal(tid, sensorId, sensorOffset,
-                                                   eventState,
-                                                   previousEventState);
+void HostPDRHandler::applySensorReading(const SensorReading& reading)
+{
+    auto tid = reading.tid;
+    auto sensorId = reading.sensorId;
 
-                        SensorEntry sensorEntry{tid, sensorId};
+    for (uint8_t sensorOffset = 0; sensorOffset < reading.compSensorCount;
+         sensorOffset++)
+    {
+        uint8_t eventState = reading.stateField[sensorOffset].present_state;
+        uint8_t previousEventState =
+            reading.stateField[sensorOffset].previous_state;
 
-                        pldm::pdr::EntityInfo entityInfo{};
-                        pldm::pdr::CompositeSensorStates
-                            compositeSensorStates{};
+        emitStateSensorEventSignal(tid, sensorId, sensorOffset, eventState,
+                                   previousEventState);
 
-                        try
-                        {
-                            std::tie(entityInfo, compositeSensorStates) =
-                                lookupSensorInfo(sensorEntry);
-                        }
-                        catch (const std::out_of_range& e)
-                        {
-                            try
-                            {
-                                sensorEntry.terminusID = PLDM_TID_RESERVED;
-                                std::tie(entityInfo, compositeSensorStates) =
-                                    lookupSensorInfo(sensorEntry);
-                            }
-                            catch (const std::out_of_range& e)
-                            {
-                                error("No mapping for the events");
-                            }
-                        }
+        SensorEntry sensorEntry{tid, sensorId};
 
-                        if (sensorOffset > compositeSensorStates.size())
-                        {
-                            error("Error Invalid data, Invalid sensor offset");
-                            return;
-                        }
+        pldm::pdr::EntityInfo entityInfo{};
+        pldm::pdr::CompositeSensorStates compositeSensorStates{};
 
-                        const auto& possibleStates =
-                            compositeSensorStates[sensorOffset];
-                        if (possibleStates.find(eventState) ==
-                            possibleStates.end())
-                        {
-                            error("Error invalid_data, Invalid event state");
-                            return;
-                        }
-                        const auto& [containerId, entityType,
-                                     entityInstance] = entityInfo;
-                        pldm::responder::events::StateSensorEntry
-                            stateSensorEntry{containerId, entityType,
-                                             entityInstance, sensorOffset};
-                        handleStateSensorEvent(stateSensorEntry, eventState);
-                    }
-                };
+        try
+        {
+            std::tie(entityInfo, compositeSensorStates) =
+                lookupSensorInfo(sensorEntry);
+        }
+        catch (const std::out_of_range& e)
+        {
+            try
+            {
+                sensorEntry.terminusID = PLDM_TID_RESERVED;
+                std::tie(entityInfo, compositeSensorStates) =
+                    lookupSensorInfo(sensorEntry);
+            }
+            catch (const std::out_of_range& e)
+            {
+                error("No mapping for the events");
+            }
+        }
 
-                rc = handler->registerRequest(
-                    mctp_eid, instanceId, PLDM_PLATFORM,
-                    PLDM_GET_STATE_SENSOR_READINGS, std::move(requestMsg),
-                    std::move(getStateSensorReadingRespHandler));
+        if (sensorOffset > compositeSensorStates.size())
+        {
+            error("Error Invalid data, Invalid sensor offset");
+            return;
+        }
 
-                if (rc != PLDM_SUCCESS)
-                {
-                    error(
-                        "Failed to send request to get State sensor reading on Host");
-                }
-            }
+        const auto& possibleStates = compositeSensorStates[sensorOffset];
+        if (possibleStates.find(eventState) == possibleStates.end())
+        {
+            error("Error invalid_data, Invalid event state");
+            return;
         }
+        const auto& [containerId, entityType, entityInstance] = entityInfo;
+        pldm::responder::events::StateSensorEntry stateSensorEntry{
+            containerId, entityType, entityInstance, sensorOffset};
+        handleStateSensorEvent(stateSensorEntry, eventState);
     }
 }
 
@@ -936,8 +1188,12 @@ void HostPDRHandler::getFRURecordTableMetadataByRemote(
     }
 
     auto getFruRecordTableMetadataResponseHandler =
-        [this, fruRecordSetPDRs](mctp_eid_t /*eid*/, const pldm_msg* response,
-                                 size_t respMsgLen) {
+        [this, fruRecordSetPDRs, syncId = pdrSyncId](
+            mctp_eid_t /*eid*/, const pldm_msg* response, size_t respMsgLen) {
+        if (syncId != pdrSyncId)
+        {
+            return;
+        }
         if (response == nullptr || !respMsgLen)
         {
             lg2::error(
@@ -1010,8 +1266,12 @@ void HostPDRHandler::getFRURecordTableByRemote(const PDRList& fruRecordSetPDRs,
     }
 
     auto getFruRecordTableResponseHandler =
-        [totalTableRecords, this, fruRecordSetPDRs](
+        [totalTableRecords, this, fruRecordSetPDRs, syncId = pdrSyncId](
             mctp_eid_t /*eid*/, const pldm_msg* response, size_t respMsgLen) {
+        if (syncId != pdrSyncId)
+        {
+            return;
+        }
         if (response == nullptr || !respMsgLen)
         {
             lg2::error(
@@ -1087,6 +1347,9 @@ void HostPDRHandler::setFRUDataOnDBus(
         responder::pdr_utils::FruRecordDataFormat>& fruRecordData)
 {
 #ifdef OEM_IBM
+    // The new objects are announced together once all the FRU records are
+    // applied
+    pldm::dbus::LocationCodes locationCodes;
     for (const auto& entity : objPathMap)
     {
         pldm_entity node = pldm_entity_extract(entity.second);
@@ -1106,7 +1369,7 @@ void HostPDRHandler::setFRUDataOnDBus(
                     if (tlv.fruFieldType ==
                         PLDM_OEM_FRU_FIELD_TYPE_LOCATION_CODE)
                     {
-                        CustomDBus::getCustomDBus().setLocationCode(
+                        locationCodes.emplace_back(
                             entity.first,
                             std::string(reinterpret_cast<const char*>(
                                             tlv.fruFieldValue.data()),
@@ -1116,6 +1379,7 @@ void HostPDRHandler::setFRUDataOnDBus(
             }
         }
     }
+    CustomDBus::getCustomDBus().setLocationCodes(locationCodes);
 #endif
 }
 void HostPDRHandler::createDbusObjects(const PDRList& fruRecordSetPDRs)
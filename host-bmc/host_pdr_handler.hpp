@@ -13,11 +13,16 @@
 
 #include <sdeventplus/event.hpp>
 #include <sdeventplus/source/event.hpp>
+#include <sdeventplus/utility/timer.hpp>
 
+#include <array>
 #include <deque>
 #include <filesystem>
 #include <map>
 #include <memory>
+#include <optional>
+#include <set>
+#include <unordered_map>
 #include <vector>
 
 namespace pldm
@@ -54,6 +59,11 @@ struct SensorEntry
 using HostStateSensorMap = std::map<SensorEntry, pdr::SensorInfo>;
 using PDRList = std::vector<std::vector<uint8_t>>;
 
+/** @brief Terminus handles of the repo given to each host of a multi-host
+ *  system, the handle h of host i is stored as i * range + h
+ */
+constexpr uint16_t hostTerminusHandleRange = 0x1000;
+
 /** @class HostPDRHandler
  *  @brief This class can fetch and process PDRs from host firmware
  *  @details Provides an API to fetch PDRs from the host firmware. Upon
@@ -87,6 +97,11 @@ class HostPDRHandler
      *  @param[in] bmcEntityTree - pointer to BMC's entity association tree
      *  @param[in] instanceIdDb - reference to an InstanceIdDb object
      *  @param[in] handler - PLDM request handler
+     *  @param[in] oemPlatformHandler - OEM platform handler
+     *  @param[in] hostIndex - index of the host, the host state of
+     *                         /xyz/openbmc_project/state/host<index> is
+     *                         followed
+     *  @param[in] hostCount - number of hosts sharing the PDR repo
      */
     explicit HostPDRHandler(
         int mctp_fd, uint8_t mctp_eid, sdeventplus::Event& event,
@@ -95,7 +110,23 @@ class HostPDRHandler
         pldm_entity_association_tree* bmcEntityTree,
         pldm::InstanceIdDb& instanceIdDb,
         pldm::requester::Handler<pldm::requester::Request>* handler,
-        pldm::responder::oem_platform::Handler* oemPlatformHandler);
+        pldm::responder::oem_platform::Handler* oemPlatformHandler,
+        uint8_t hostIndex = 0, uint8_t hostCount = 1);
+
+    /** @brief MCTP EID of the host firmware */
+    uint8_t getHostEID() const
+    {
+        return hostEID;
+    }
+
+    /** @brief Terminus handle of the repo of a terminus handle of the host
+     *  @param[in] terminusHandle - terminus handle in the PDRs of the host
+     *  @return the handle in this host's range
+     */
+    uint16_t toRepoTerminusHandle(uint16_t terminusHandle) const
+    {
+        return terminusHandleBase + terminusHandle;
+    }
 
     /** @brief fetch PDRs from host firmware. See @class.
      *  @param[in] recordHandles - list of record handles pointing to host's
@@ -106,6 +137,10 @@ class HostPDRHandler
 
     /** @brief Send a PLDM event to host firmware containing a list of record
      *  handles of PDRs that the host firmware has to fetch.
+     *  @details The changes are coalesced for PDR_REPO_CHG_EVENT_WINDOW
+     *  milliseconds from the first one, the host then gets a single event
+     *  with the record handles of all the PDR types changed, looked up once
+     *  the window closes.
      *  @param[in] pdrTypes - list of PDR types that need to be looked up in the
      *                        BMC repo
      *  @param[in] eventDataFormat - format for PDRRepositoryChgEvent in DSP0248
@@ -125,6 +160,19 @@ class HostPDRHandler
         return sensorMap.at(entry);
     }
 
+    /** @brief Find host sensor info corresponding to requested SensorEntry
+     *
+     *  @param[in] entry - TerminusID and SensorID
+     *
+     *  @return SensorInfo corresponding to the input parameter SensorEntry,
+     *          nullptr if not found
+     */
+    const pdr::SensorInfo* findSensorInfo(const SensorEntry& entry) const
+    {
+        auto it = sensorMap.find(entry);
+        return it == sensorMap.end() ? nullptr : &it->second;
+    }
+
     /** @brief Handles state sensor event
      *
      *  @param[in] entry - state sensor entry
@@ -170,6 +218,18 @@ class HostPDRHandler
      */
     bool isHostUp();
 
+    /** @brief Find an entity in the BMC and Host entity association tree
+     *  @details Same match as pldm_entity_association_tree_find_with_locality,
+     *  the container ID of the entity is updated to the one of the node. The
+     *  nodes found by the container ID of the host are kept in an index until
+     *  the host powers off, the PDRs of a PDR exchange mostly refer to the
+     *  same entities.
+     *  @param[in,out] entity - the entity to find
+     *  @param[in] isRemote - match the container ID assigned by the host
+     *  @return the node, nullptr if not found
+     */
+    pldm_entity_node* findEntity(pldm_entity& entity, bool isRemote);
+
     /** @brief map that captures various terminus information **/
     TLPDRMap tlPDRInfo;
 
@@ -180,6 +240,16 @@ class HostPDRHandler
      */
     void _fetchPDR(sdeventplus::source::EventBase& source);
 
+    /** @brief Send the GetPDR requests of the known record handles while the
+     *         prefetch window allows
+     */
+    void prefetchHostPDRs();
+
+    /** @brief Add the prefetched PDRs received, in the order of their record
+     *         handles
+     */
+    void processPrefetchedPDRs();
+
     /** @brief Merge host firmware's entity association PDRs into BMC's
      *  @details A merge operation involves adding a pldm_entity under the
      *  appropriate parent, and updating container ids.
@@ -192,6 +262,34 @@ class HostPDRHandler
                                 [[maybe_unused]] const uint32_t& size,
                                 [[maybe_unused]] const uint32_t& record_handle);
 
+    /** @struct SensorReading
+     *  @brief GetStateSensorReadings request of a host state sensor and its
+     *         result
+     */
+    struct SensorReading
+    {
+        mctp_eid_t eid;
+        pdr::TerminusID tid;
+        pdr::SensorID sensorId;
+        uint8_t compSensorCount;
+        std::array<get_sensor_state_field, 8> stateField;
+    };
+
+    /** @brief Send the queued GetStateSensorReadings requests while the
+     *         window allows, the readings are applied once all are in
+     */
+    void sendSensorReads();
+
+    /** @brief Signal and handle the states of a host state sensor
+     *  @param[in] reading - the reading of the composite sensor
+     */
+    void applySensorReading(const SensorReading& reading);
+
+    /** @brief Add the entity association PDRs of the host associations
+     *  merged during the PDR exchange to the repo
+     */
+    void addMergedAssociationPDRs();
+
     /** @brief process the Host's PDR and add to BMC's PDR repo
      *  @param[in] eid - MCTP id of Host
      *  @param[in] response - response from Host for GetPDR
@@ -200,11 +298,29 @@ class HostPDRHandler
     void processHostPDRs(mctp_eid_t eid, const pldm_msg* response,
                          size_t respMsgLen);
 
+    /** @brief Add the PDR of a GetPDR response to BMC's PDR repo, the PDR
+     *         exchange is completed with the last record
+     *  @param[in] response - response from Host for GetPDR
+     *  @param[in] respMsgLen - response message length
+     *  @return the next record handle, std::nullopt if the exchange stops
+     */
+    std::optional<uint32_t> addHostPDR(const pldm_msg* response,
+                                       size_t respMsgLen);
+
+    /** @brief Fetch the PDR after a PDR added, unless the modified PDRs are
+     *         all fetched
+     *  @param[in] nextRecordHandle - next record handle sent by Host
+     */
+    void continueHostPDRs(uint32_t nextRecordHandle);
+
     /** @brief send PDR Repo change after merging Host's PDR to BMC PDR repo
      *  @param[in] source - sdeventplus event source
      */
     void _processPDRRepoChgEvent(sdeventplus::source::EventBase& source);
 
+    /** @brief Send the repository change event of the PDR types coalesced */
+    void flushPDRRepositoryChgEvent();
+
     /** @brief fetch the next PDR based on the record handle sent by Host
      *  @param[in] nextRecordHandle - next record handle
      *  @param[in] source - sdeventplus event source
@@ -254,10 +370,31 @@ class HostPDRHandler
     std::optional<uint16_t> getRSI(const PDRList& fruRecordSetPDRs,
                                    const pldm_entity& entity);
 
+    /** @brief Remove the PDRs of the host from the repo once it is off */
+    void removeHostPDRs();
+
     /** @brief fd of MCTP communications socket */
     int mctp_fd;
     /** @brief MCTP EID of host firmware */
     uint8_t mctp_eid;
+    /** @brief MCTP EID of the host, mctp_eid follows the terminus locator
+     *  of the last sensor read
+     */
+    const uint8_t hostEID;
+    /** @brief Number of hosts sharing the PDR repo */
+    const uint8_t hostCount;
+    /** @brief First terminus handle of the repo given to this host */
+    const uint16_t terminusHandleBase;
+    /** @brief Terminus handles of the repo of the PDRs added by the host */
+    std::set<uint16_t> repoTerminusHandles;
+    /** @brief Whether an entity association was merged during the PDR
+     *  exchange
+     */
+    bool mergedInExchange = false;
+    /** @brief State sensor PDRs received during the PDR exchange */
+    PDRList exchangeStateSensorPDRs;
+    /** @brief FRU record set PDRs received during the PDR exchange */
+    PDRList exchangeFruRecordSetPDRs;
     /** @brief reference of main event loop of pldmd, primarily used to schedule
      *  work.
      */
@@ -327,6 +464,76 @@ class HostPDRHandler
      */
     utils::EntityAssociations entityAssociations;
 
+    /** @struct MergedAssociation
+     *  @brief Parent node of a merged host entity association and the
+     *         entities of its PDR
+     */
+    struct MergedAssociation
+    {
+        pldm_entity_node* node;
+        std::vector<pldm_entity> entities;
+    };
+
+    /** @brief host entity associations whose PDRs are added to the repo at
+     *         the end of the PDR exchange
+     */
+    std::vector<MergedAssociation> mergedAssociations;
+
+    /** @brief GetStateSensorReadings requests in flight while reading the
+     *         initial states of the host sensors, bounded so the instance IDs
+     *         of the host aren't exhausted
+     */
+    static constexpr size_t sensorReadWindow = 8;
+
+    /** @brief host state sensors to read */
+    std::deque<SensorReading> sensorReadQueue;
+
+    /** @brief readings received, applied once all are in */
+    std::vector<SensorReading> sensorReadings;
+
+    /** @brief GetStateSensorReadings requests waiting for their response */
+    size_t sensorReadsInFlight = 0;
+
+    /** @brief Sequence number of the round of sensor readings, the responses
+     *         of a superseded round are dropped
+     */
+    uint32_t sensorReadSyncId = 0;
+
+    /** @brief Sequence number of the PDR exchange, the responses of an
+     *         exchange superseded by a repository change are dropped
+     */
+    uint32_t pdrSyncId = 0;
+
+    /** @brief GetPDR requests in flight while fetching a known list of
+     *         record handles
+     */
+    static constexpr size_t pdrPrefetchWindow = 8;
+
+    /** @brief GetPDR response of a prefetched record handle */
+    struct PrefetchedPDR
+    {
+        bool received = false;
+        /** @brief the response message, empty if the request failed */
+        std::vector<uint8_t> response;
+    };
+
+    /** @brief record handles to prefetch */
+    PDRRecordHandles prefetchQueue;
+
+    /** @brief prefetched PDRs not added yet, in the order of their handles */
+    std::deque<std::shared_ptr<PrefetchedPDR>> prefetchedPDRs;
+
+    /** @brief GetPDR requests of the prefetch waiting for their response */
+    size_t pdrPrefetchesInFlight = 0;
+
+    /** @brief next record handle sent with the last prefetched PDR added */
+    std::optional<uint32_t> lastPrefetchedNextHandle;
+
+    /** @brief nodes of the tree by entity type, instance number and the
+     *         container ID assigned by the host
+     */
+    std::unordered_map<uint64_t, pldm_entity_node*> remoteEntityIndex;
+
     /** @brief the vector of FRU Record Data Format
      */
     std::vector<responder::pdr_utils::FruRecordDataFormat> fruRecordData;
@@ -337,6 +544,12 @@ class HostPDRHandler
     /** @brief Object path and entity association and is only loaded once
      */
     bool objPathEntityAssociation;
+
+    /** @brief PDR types of the repository change event being coalesced */
+    std::set<uint8_t> pendingChgPdrTypes;
+
+    /** @brief Closes the coalescing window of the repository change event */
+    sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> repoChgTimer;
 };
 
 } // namespace pldm
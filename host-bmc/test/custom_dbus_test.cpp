@@ -14,3 +14,34 @@ TEST(CustomDBus, LocationCode)
     EXPECT_NE(retLocationCode, std::nullopt);
     EXPECT_EQ(locationCode, retLocationCode);
 }
+
+TEST(CustomDBus, StagedLocationCode)
+{
+    std::string tmpPath = "/abc/staged";
+    auto& customDBus = CustomDBus::getCustomDBus();
+
+    customDBus.stage();
+    customDBus.setLocationCode(tmpPath, "first");
+    customDBus.setLocationCode(tmpPath, "second");
+    EXPECT_EQ(customDBus.getLocationCode(tmpPath), "second");
+    customDBus.publish();
+
+    customDBus.setLocationCode(tmpPath, "third");
+    EXPECT_EQ(customDBus.getLocationCode(tmpPath), "third");
+}
+
+TEST(CustomDBus, BulkLocationCodes)
+{
+    auto& customDBus = CustomDBus::getCustomDBus();
+    LocationCodes codes{{"/abc/bulk0", "code0"},
+                        {"/abc/bulk1", "code1"},
+                        {"/abc/bulk0", "code2"}};
+
+    customDBus.setLocationCodes(codes);
+    EXPECT_EQ(customDBus.getLocationCode("/abc/bulk0"), "code2");
+    EXPECT_EQ(customDBus.getLocationCode("/abc/bulk1"), "code1");
+    EXPECT_EQ(customDBus.getLocationCode("/abc/bulk2"), std::nullopt);
+
+    customDBus.setLocationCode("/abc/bulk1", "code3");
+    EXPECT_EQ(customDBus.getLocationCode("/abc/bulk1"), "code3");
+}
@@ -3,6 +3,7 @@
 #include "host-bmc/dbus_to_host_effecters.hpp"
 
 #include <nlohmann/json.hpp>
+#include <sdeventplus/event.hpp>
 
 #include <iostream>
 
@@ -10,6 +11,8 @@
 
 using namespace pldm::host_effecters;
 using namespace pldm::utils;
+using ::testing::_;
+using ::testing::Invoke;
 
 class MockHostEffecterParser : public HostEffecterParser
 {
@@ -25,9 +28,7 @@ class MockHostEffecterParser : public HostEffecterParser
                 (override));
 
     MOCK_METHOD(void, createHostEffecterMatch,
-                (const std::string&, const std::string&, size_t, size_t,
-                 uint16_t),
-                (override));
+                (const std::string&, const std::string&), (override));
 
     const std::vector<EffecterInfo>& gethostEffecterInfo()
     {
@@ -58,6 +59,36 @@ TEST(HostEffecterParser, parseEffecterJsonGoodPath)
     ASSERT_EQ(temp.dbusMap.propertyType == dbusInfo.dbusMap.propertyType, true);
 }
 
+TEST(HostEffecterParser, findEffecters)
+{
+    MockdBusHandler dbusHandler;
+    int sockfd{};
+    MockHostEffecterParser hostEffecterParser(sockfd, nullptr, &dbusHandler,
+                                              "./host_effecter_jsons/good");
+
+    auto effecters = hostEffecterParser.findEffecters(
+        "/xyz/openbmc_project/control/host0/boot", "BootMode");
+    ASSERT_NE(effecters, nullptr);
+    ASSERT_EQ(effecters->size(), 1);
+    EXPECT_EQ((*effecters)[0].effecterInfoIndex, 0);
+    EXPECT_EQ((*effecters)[0].dbusInfoIndex, 0);
+    EXPECT_EQ((*effecters)[0].effecterId, 4);
+
+    EXPECT_EQ(hostEffecterParser.findEffecters(
+                  "/xyz/openbmc_project/control/host0/boot", "BootType"),
+              nullptr);
+    EXPECT_EQ(hostEffecterParser.findEffecters(
+                  "/xyz/openbmc_project/control/host0", "BootMode"),
+              nullptr);
+
+    /* A change of a property which is not mapped sends no request */
+    EXPECT_CALL(hostEffecterParser, setHostStateEffecter(_, _, _)).Times(0);
+    hostEffecterParser.processPropertiesChanged(
+        "/xyz/openbmc_project/control/host0/boot",
+        "xyz.openbmc_project.Control.Boot.Mode",
+        {{"BootType", PropertyValue{std::string("EFI")}}});
+}
+
 TEST(HostEffecterParser, parseEffecterJsonBadPath)
 {
     MockdBusHandler dbusHandler;
@@ -89,3 +120,63 @@ TEST(HostEffecterParser, findNewStateValue)
     ASSERT_THROW(hostEffecterParser.findNewStateValue(0, 0, val2),
                  std::exception);
 }
+
+class MockEffecterWriter : public HostEffecterParser
+{
+  public:
+    MockEffecterWriter(DBusHandler* const dbusHandler,
+                       const std::string& jsonPath) :
+        HostEffecterParser(nullptr, 0, nullptr, dbusHandler, jsonPath, nullptr)
+    {}
+
+    MOCK_METHOD(int, sendHostStateEffecter,
+                (const EffecterWriteKey&, size_t,
+                 std::vector<set_effecter_state_field>&),
+                (override));
+
+    MOCK_METHOD(void, createHostEffecterMatch,
+                (const std::string&, const std::string&), (override));
+
+    void writeDone(const EffecterWriteKey& key, bool applied)
+    {
+        effecterWriteDone(key, applied);
+    }
+};
+
+TEST(HostEffecterParser, coalesceStateEffecterWrites)
+{
+    MockdBusHandler dbusHandler;
+    MockEffecterWriter writer(&dbusHandler, "./host_effecter_jsons/good");
+    auto event = sdeventplus::Event::get_default();
+
+    std::vector<uint8_t> sent;
+    EXPECT_CALL(writer, sendHostStateEffecter(_, 0, _))
+        .Times(2)
+        .WillRepeatedly(
+            Invoke([&sent](const EffecterWriteKey&, size_t,
+                           std::vector<set_effecter_state_field>& stateField) {
+        sent.push_back(stateField[0].effecter_state);
+        return PLDM_SUCCESS;
+    }));
+
+    std::vector<set_effecter_state_field> stateField{{PLDM_REQUEST_SET, 2}};
+    ASSERT_EQ(writer.setHostStateEffecter(0, stateField, 4), PLDM_SUCCESS);
+    ASSERT_EQ(sent, std::vector<uint8_t>{2});
+
+    /* The writes made while the request is outstanding are coalesced */
+    stateField[0].effecter_state = 3;
+    writer.setHostStateEffecter(0, stateField, 4);
+    stateField[0].effecter_state = 4;
+    writer.setHostStateEffecter(0, stateField, 4);
+    ASSERT_EQ(sent.size(), 1);
+
+    /* The latest value is sent once the minimum interval has passed */
+    EffecterWriteKey key{9, 4};
+    writer.writeDone(key, true);
+    for (int i = 0; i < 100 && sent.size() < 2; i++)
+    {
+        sd_event_run(event.get(), 10000);
+    }
+    ASSERT_EQ(sent, (std::vector<uint8_t>{2, 4}));
+    writer.writeDone(key, true);
+}
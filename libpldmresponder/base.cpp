@@ -1,5 +1,6 @@
 #include "base.hpp"
 
+#include "common/transfer_size.hpp"
 #include "common/utils.hpp"
 #include "libpldmresponder/pdr.hpp"
 
@@ -10,6 +11,7 @@
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
 #include <array>
 #include <cstring>
 #include <iostream>
@@ -35,7 +37,7 @@ using Cmd = std::vector<uint8_t>;
 static const std::map<Type, Cmd> capabilities{
     {PLDM_BASE,
      {PLDM_GET_TID, PLDM_GET_PLDM_VERSION, PLDM_GET_PLDM_TYPES,
-      PLDM_GET_PLDM_COMMANDS}},
+      PLDM_GET_PLDM_COMMANDS, transfer::negotiateTransferParameters}},
     {PLDM_PLATFORM,
      {PLDM_GET_PDR, PLDM_SET_STATE_EFFECTER_STATES, PLDM_SET_EVENT_RECEIVER,
       PLDM_GET_SENSOR_READING, PLDM_GET_STATE_SENSOR_READINGS,
@@ -83,7 +85,7 @@ Response Handler::getPLDMTypes(const pldm_msg* request,
         types[index].byte |= 1 << bit;
     }
 
-    Response response(sizeof(pldm_msg_hdr) + PLDM_GET_TYPES_RESP_BYTES, 0);
+    auto response = responseBuffer<PLDM_GET_TYPES_RESP_BYTES>();
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
     auto rc = encode_get_types_resp(request->hdr.instance_id, PLDM_SUCCESS,
                                     types.data(), responsePtr);
@@ -100,7 +102,7 @@ Response Handler::getPLDMCommands(const pldm_msg* request, size_t payloadLength)
     ver32_t version{};
     Type type;
 
-    Response response(sizeof(pldm_msg_hdr) + PLDM_GET_COMMANDS_RESP_BYTES, 0);
+    auto response = responseBuffer<PLDM_GET_COMMANDS_RESP_BYTES>();
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     auto rc = decode_get_commands_req(request, payloadLength, &type, &version);
@@ -142,7 +144,7 @@ Response Handler::getPLDMVersion(const pldm_msg* request, size_t payloadLength)
     Type type;
     uint8_t transferFlag;
 
-    Response response(sizeof(pldm_msg_hdr) + PLDM_GET_VERSION_RESP_BYTES, 0);
+    auto response = responseBuffer<PLDM_GET_VERSION_RESP_BYTES>();
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     uint8_t rc = decode_get_version_req(request, payloadLength, &transferHandle,
@@ -237,7 +239,7 @@ void Handler::processSetEventReceiver(
 
 Response Handler::getTID(const pldm_msg* request, size_t /*payloadLength*/)
 {
-    Response response(sizeof(pldm_msg_hdr) + PLDM_GET_TID_RESP_BYTES, 0);
+    auto response = responseBuffer<PLDM_GET_TID_RESP_BYTES>();
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
     auto rc = encode_get_tid_resp(request->hdr.instance_id, PLDM_SUCCESS,
                                   TERMINUS_ID, responsePtr);
@@ -252,6 +254,40 @@ Response Handler::getTID(const pldm_msg* request, size_t /*payloadLength*/)
     return response;
 }
 
+Response Handler::negotiateTransferParameters(const pldm_msg* request,
+                                              size_t payloadLength)
+{
+    uint16_t requesterPartSize = 0;
+    transfer::ProtocolSupport requesterProtocols{};
+    auto rc = transfer::decodeNegotiateReq({request->payload, payloadLength},
+                                           requesterPartSize,
+                                           requesterProtocols);
+    if (rc != PLDM_SUCCESS)
+    {
+        return ccOnlyResponse(request, rc);
+    }
+    if (requesterPartSize < transfer::baselinePartSize)
+    {
+        return ccOnlyResponse(request, PLDM_ERROR_INVALID_DATA);
+    }
+
+    // The types whose multipart transfers follow the negotiated part size
+    transfer::ProtocolSupport protocols{};
+    transfer::addProtocol(protocols, PLDM_PLATFORM);
+    transfer::addProtocol(protocols, PLDM_BIOS);
+    transfer::addProtocol(protocols, PLDM_FRU);
+    protocols = transfer::intersect(protocols, requesterProtocols);
+
+    auto partSize = std::min<uint16_t>(requesterPartSize, TRANSFER_PART_SIZE);
+    auto& sizes = transfer::TransferSizes::get();
+    sizes.set(sizes.requester(), partSize);
+    info("Negotiated the part size {SIZE} with EID {EID}", "SIZE", partSize,
+         "EID", sizes.requester());
+
+    return transfer::encodeNegotiateResp(request->hdr.instance_id, partSize,
+                                         protocols);
+}
+
 } // namespace base
 } // namespace responder
 } // namespace pldm
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "common/transfer_size.hpp"
 #include "libpldmresponder/platform.hpp"
 #include "pldmd/handler.hpp"
 #include "requester/handler.hpp"
@@ -30,22 +31,32 @@ class Handler : public CmdHandler
         instanceIdDb(instanceIdDb), event(event),
         oemPlatformHandler(oemPlatformHandler), handler(handler)
     {
+        /* The capabilities and versions are constant, those responses are
+         * encoded once per request payload. GetTID also schedules the
+         * SetEventReceiver to the host, it runs each time. */
         handlers.emplace(PLDM_GET_PLDM_TYPES,
                          [this](const pldm_msg* request, size_t payloadLength) {
             return this->getPLDMTypes(request, payloadLength);
-        });
+        },
+                         true);
         handlers.emplace(PLDM_GET_PLDM_COMMANDS,
                          [this](const pldm_msg* request, size_t payloadLength) {
             return this->getPLDMCommands(request, payloadLength);
-        });
+        },
+                         true);
         handlers.emplace(PLDM_GET_PLDM_VERSION,
                          [this](const pldm_msg* request, size_t payloadLength) {
             return this->getPLDMVersion(request, payloadLength);
-        });
+        },
+                         true);
         handlers.emplace(PLDM_GET_TID,
                          [this](const pldm_msg* request, size_t payloadLength) {
             return this->getTID(request, payloadLength);
         });
+        handlers.emplace(transfer::negotiateTransferParameters,
+                         [this](const pldm_msg* request, size_t payloadLength) {
+            return this->negotiateTransferParameters(request, payloadLength);
+        });
     }
 
     /** @brief Handler for getPLDMTypes
@@ -88,6 +99,17 @@ class Handler : public CmdHandler
      */
     Response getTID(const pldm_msg* request, size_t payloadLength);
 
+    /** @brief Handler for NegotiateTransferParameters, the part size of the
+     *  requester is capped by TRANSFER_PART_SIZE and kept for the multipart
+     *  responses of the platform, BIOS and FRU handlers to it
+     *
+     *  @param[in] request - Request message payload
+     *  @param[in] payload_length - Request message payload length
+     *  @param[return] Response - PLDM Response message
+     */
+    Response negotiateTransferParameters(const pldm_msg* request,
+                                         size_t payloadLength);
+
   private:
     /** @brief MCTP EID of host firmware */
     uint8_t eid;
@@ -1,11 +1,13 @@
 #include "bios.hpp"
 
+#include "common/transfer_size.hpp"
 #include "common/utils.hpp"
 
 #include <time.h>
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
 #include <array>
 #include <chrono>
 #include <ctime>
@@ -86,6 +88,16 @@ Handler::Handler(int fd, uint8_t eid, pldm::InstanceIdDb* instanceIdDb,
                      [this](const pldm_msg* request, size_t payloadLength) {
         return this->getDateTime(request, payloadLength);
     });
+    asyncHandlers.emplace(PLDM_SET_DATE_TIME,
+                          [this](const pldm_msg* request, size_t payloadLength,
+                                 ResponseSender&& respond) {
+        this->setDateTimeAsync(request, payloadLength, std::move(respond));
+    });
+    asyncHandlers.emplace(PLDM_GET_DATE_TIME,
+                          [this](const pldm_msg* request, size_t payloadLength,
+                                 ResponseSender&& respond) {
+        this->getDateTimeAsync(request, payloadLength, std::move(respond));
+    });
     handlers.emplace(PLDM_GET_BIOS_TABLE,
                      [this](const pldm_msg* request, size_t payloadLength) {
         return this->getBIOSTable(request, payloadLength);
@@ -105,7 +117,16 @@ Handler::Handler(int fd, uint8_t eid, pldm::InstanceIdDb* instanceIdDb,
     });
 }
 
-Response Handler::getDateTime(const pldm_msg* request, size_t /*payloadLength*/)
+constexpr auto timeInterface = "xyz.openbmc_project.Time.EpochTime";
+constexpr auto bmcTimePath = "/xyz/openbmc_project/time/bmc";
+constexpr auto timeSyncPath = "/xyz/openbmc_project/time/sync_method";
+constexpr auto timeSyncInterface = "xyz.openbmc_project.Time.Synchronization";
+constexpr auto timeSyncProperty = "TimeSyncMethod";
+constexpr auto timeSyncNTP =
+    "xyz.openbmc_project.Time.Synchronization.Method.NTP";
+
+Response Handler::getDateTimeResponse(const pldm_msg* request,
+                                      uint64_t timeUsec)
 {
     uint8_t seconds = 0;
     uint8_t minutes = 0;
@@ -114,10 +135,29 @@ Response Handler::getDateTime(const pldm_msg* request, size_t /*payloadLength*/)
     uint8_t month = 0;
     uint16_t year = 0;
 
-    constexpr auto timeInterface = "xyz.openbmc_project.Time.EpochTime";
-    constexpr auto bmcTimePath = "/xyz/openbmc_project/time/bmc";
-    Response response(sizeof(pldm_msg_hdr) + PLDM_GET_DATE_TIME_RESP_BYTES, 0);
+    auto response = responseBuffer<PLDM_GET_DATE_TIME_RESP_BYTES>();
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+
+    uint64_t timeSec = std::chrono::duration_cast<std::chrono::seconds>(
+                           std::chrono::microseconds(timeUsec))
+                           .count();
+
+    pldm::responder::utils::epochToBCDTime(timeSec, seconds, minutes, hours,
+                                           day, month, year);
+
+    auto rc = encode_get_date_time_resp(request->hdr.instance_id, PLDM_SUCCESS,
+                                        seconds, minutes, hours, day, month,
+                                        year, responsePtr);
+    if (rc != PLDM_SUCCESS)
+    {
+        return ccOnlyResponse(request, rc);
+    }
+
+    return response;
+}
+
+Response Handler::getDateTime(const pldm_msg* request, size_t /*payloadLength*/)
+{
     EpochTimeUS timeUsec;
 
     try
@@ -134,25 +174,62 @@ Response Handler::getDateTime(const pldm_msg* request, size_t /*payloadLength*/)
         return CmdHandler::ccOnlyResponse(request, PLDM_ERROR);
     }
 
-    uint64_t timeSec = std::chrono::duration_cast<std::chrono::seconds>(
-                           std::chrono::microseconds(timeUsec))
-                           .count();
-
-    pldm::responder::utils::epochToBCDTime(timeSec, seconds, minutes, hours,
-                                           day, month, year);
+    return getDateTimeResponse(request, timeUsec);
+}
 
-    auto rc = encode_get_date_time_resp(request->hdr.instance_id, PLDM_SUCCESS,
-                                        seconds, minutes, hours, day, month,
-                                        year, responsePtr);
-    if (rc != PLDM_SUCCESS)
+void Handler::getDateTimeAsync(const pldm_msg* request,
+                               size_t /*payloadLength*/,
+                               ResponseSender&& respond)
+{
+    /* Only the header of the request is used to encode the response */
+    Response requestHdr(reinterpret_cast<const uint8_t*>(request),
+                        reinterpret_cast<const uint8_t*>(request) +
+                            sizeof(pldm_msg_hdr));
+    try
     {
-        return ccOnlyResponse(request, rc);
+        auto& bus = DBusHandler::getBus();
+        auto service = DBusHandler().getService(bmcTimePath, timeInterface);
+        auto method = bus.new_method_call(service.c_str(), bmcTimePath,
+                                          dbusProperties, "Get");
+        method.append(timeInterface, "Elapsed");
+        dbusCalls.call(bus, method,
+                       [this, requestHdr,
+                        respond](sdbusplus::message_t& reply) {
+            auto request = reinterpret_cast<const pldm_msg*>(
+                requestHdr.data());
+            try
+            {
+                if (reply.is_method_error())
+                {
+                    throw std::runtime_error("Get Elapsed failed");
+                }
+                std::variant<EpochTimeUS> timeUsec;
+                reply.read(timeUsec);
+                respond(getDateTimeResponse(request,
+                                            std::get<EpochTimeUS>(timeUsec)));
+            }
+            catch (const std::exception& e)
+            {
+                error(
+                    "Error getting time, PATH={BMC_TIME_PATH} TIME INTERACE={TIME_INTERFACE} ERROR={ERR_EXCEP}",
+                    "BMC_TIME_PATH", bmcTimePath, "TIME_INTERFACE",
+                    timeInterface, "ERR_EXCEP", e.what());
+                respond(ccOnlyResponse(request, PLDM_ERROR));
+            }
+        });
+    }
+    catch (const std::exception& e)
+    {
+        error(
+            "Error getting time, PATH={BMC_TIME_PATH} TIME INTERACE={TIME_INTERFACE} ERROR={ERR_EXCEP}",
+            "BMC_TIME_PATH", bmcTimePath, "TIME_INTERFACE", timeInterface,
+            "ERR_EXCEP", e.what());
+        respond(ccOnlyResponse(request, PLDM_ERROR));
     }
-
-    return response;
 }
 
-Response Handler::setDateTime(const pldm_msg* request, size_t payloadLength)
+int Handler::decodeDateTime(const pldm_msg* request, size_t payloadLength,
+                            uint64_t& timeUsec)
 {
     uint8_t seconds = 0;
     uint8_t minutes = 0;
@@ -160,13 +237,23 @@ Response Handler::setDateTime(const pldm_msg* request, size_t payloadLength)
     uint8_t day = 0;
     uint8_t month = 0;
     uint16_t year = 0;
-    std::time_t timeSec;
 
-    constexpr auto timeSyncPath = "/xyz/openbmc_project/time/sync_method";
-    constexpr auto timeSyncInterface =
-        "xyz.openbmc_project.Time.Synchronization";
-    constexpr auto timeSyncProperty = "TimeSyncMethod";
+    auto rc = decode_set_date_time_req(request, payloadLength, &seconds,
+                                       &minutes, &hours, &day, &month, &year);
+    if (rc != PLDM_SUCCESS)
+    {
+        return rc;
+    }
+    std::time_t timeSec = pldm::responder::utils::timeToEpoch(
+        seconds, minutes, hours, day, month, year);
+    timeUsec = std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::seconds(timeSec))
+                   .count();
+    return PLDM_SUCCESS;
+}
 
+Response Handler::setDateTime(const pldm_msg* request, size_t payloadLength)
+{
     // The time is correct on BMC when in NTP mode, so we do not want to
     // try and set the time again and cause potential time drifts.
     try
@@ -175,7 +262,7 @@ Response Handler::setDateTime(const pldm_msg* request, size_t payloadLength)
             timeSyncPath, timeSyncProperty, timeSyncInterface);
         const auto& mode = std::get<std::string>(propVal);
 
-        if (mode == "xyz.openbmc_project.Time.Synchronization.Method.NTP")
+        if (mode == timeSyncNTP)
         {
             return ccOnlyResponse(request, PLDM_SUCCESS);
         }
@@ -188,25 +275,18 @@ Response Handler::setDateTime(const pldm_msg* request, size_t payloadLength)
             "SYNC_PROP", timeSyncProperty, "ERR_EXCEP", e.what());
     }
 
-    constexpr auto setTimeInterface = "xyz.openbmc_project.Time.EpochTime";
-    constexpr auto setTimePath = "/xyz/openbmc_project/time/bmc";
     constexpr auto timeSetPro = "Elapsed";
 
-    auto rc = decode_set_date_time_req(request, payloadLength, &seconds,
-                                       &minutes, &hours, &day, &month, &year);
+    uint64_t timeUsec = 0;
+    auto rc = decodeDateTime(request, payloadLength, timeUsec);
     if (rc != PLDM_SUCCESS)
     {
         return ccOnlyResponse(request, rc);
     }
-    timeSec = pldm::responder::utils::timeToEpoch(seconds, minutes, hours, day,
-                                                  month, year);
-    uint64_t timeUsec = std::chrono::duration_cast<std::chrono::microseconds>(
-                            std::chrono::seconds(timeSec))
-                            .count();
     PropertyValue value{timeUsec};
     try
     {
-        DBusMapping dbusMapping{setTimePath, setTimeInterface, timeSetPro,
+        DBusMapping dbusMapping{bmcTimePath, timeInterface, timeSetPro,
                                 "uint64_t"};
         pldm::utils::DBusHandler().setDbusProperty(dbusMapping, value);
     }
@@ -214,7 +294,7 @@ Response Handler::setDateTime(const pldm_msg* request, size_t payloadLength)
     {
         error(
             "Error Setting time,PATH={SET_TIME_PATH} TIME INTERFACE={TIME_INTERFACE} ERROR={ERR_EXCEP}",
-            "SET_TIME_PATH", setTimePath, "TIME_INTERFACE", setTimeInterface,
+            "SET_TIME_PATH", bmcTimePath, "TIME_INTERFACE", timeInterface,
             "ERR_EXCEP", e.what());
         return ccOnlyResponse(request, PLDM_ERROR);
     }
@@ -222,6 +302,112 @@ Response Handler::setDateTime(const pldm_msg* request, size_t payloadLength)
     return ccOnlyResponse(request, PLDM_SUCCESS);
 }
 
+void Handler::setDateTimeAsync(const pldm_msg* request, size_t payloadLength,
+                               ResponseSender&& respond)
+{
+    /* The request is decoded once the time sync method is known */
+    Response requestMsg(reinterpret_cast<const uint8_t*>(request),
+                        reinterpret_cast<const uint8_t*>(request) +
+                            sizeof(pldm_msg_hdr) + payloadLength);
+    try
+    {
+        auto& bus = DBusHandler::getBus();
+        auto service = DBusHandler().getService(timeSyncPath,
+                                                timeSyncInterface);
+        auto method = bus.new_method_call(service.c_str(), timeSyncPath,
+                                          dbusProperties, "Get");
+        method.append(timeSyncInterface, timeSyncProperty);
+        dbusCalls.call(bus, method,
+                       [this, requestMsg, payloadLength,
+                        respond](sdbusplus::message_t& reply) mutable {
+            try
+            {
+                if (reply.is_method_error())
+                {
+                    throw std::runtime_error("Get TimeSyncMethod failed");
+                }
+                std::variant<std::string> mode;
+                reply.read(mode);
+                // The time is correct on BMC when in NTP mode, so we do not
+                // want to try and set the time again and cause potential time
+                // drifts.
+                if (std::get<std::string>(mode) == timeSyncNTP)
+                {
+                    respond(ccOnlyResponse(
+                        reinterpret_cast<const pldm_msg*>(requestMsg.data()),
+                        PLDM_SUCCESS));
+                    return;
+                }
+            }
+            catch (const std::exception& e)
+            {
+                error(
+                    "Error getting the time sync property, PATH={TIME_SYNC_PATH} INTERFACE={SYNC_INTERFACE} PROPERTY={SYNC_PROP} ERROR={ERR_EXCEP}",
+                    "TIME_SYNC_PATH", timeSyncPath, "SYNC_INTERFACE",
+                    timeSyncInterface, "SYNC_PROP", timeSyncProperty,
+                    "ERR_EXCEP", e.what());
+            }
+            setTimeAsync(requestMsg, payloadLength, std::move(respond));
+        });
+    }
+    catch (const std::exception& e)
+    {
+        error(
+            "Error getting the time sync property, PATH={TIME_SYNC_PATH} INTERFACE={SYNC_INTERFACE} PROPERTY={SYNC_PROP} ERROR={ERR_EXCEP}",
+            "TIME_SYNC_PATH", timeSyncPath, "SYNC_INTERFACE", timeSyncInterface,
+            "SYNC_PROP", timeSyncProperty, "ERR_EXCEP", e.what());
+        setTimeAsync(requestMsg, payloadLength, std::move(respond));
+    }
+}
+
+void Handler::setTimeAsync(const Response& requestMsg, size_t payloadLength,
+                           ResponseSender&& respond)
+{
+    auto request = reinterpret_cast<const pldm_msg*>(requestMsg.data());
+    uint64_t timeUsec = 0;
+    auto rc = decodeDateTime(request, payloadLength, timeUsec);
+    if (rc != PLDM_SUCCESS)
+    {
+        respond(ccOnlyResponse(request, rc));
+        return;
+    }
+
+    try
+    {
+        auto& bus = DBusHandler::getBus();
+        auto service = DBusHandler().getService(bmcTimePath, timeInterface);
+        auto method = bus.new_method_call(service.c_str(), bmcTimePath,
+                                          dbusProperties, "Set");
+        method.append(timeInterface, "Elapsed",
+                      std::variant<uint64_t>(timeUsec));
+        Response requestHdr(requestMsg.begin(),
+                            requestMsg.begin() + sizeof(pldm_msg_hdr));
+        dbusCalls.call(bus, method,
+                       [requestHdr, respond](sdbusplus::message_t& reply) {
+            auto request = reinterpret_cast<const pldm_msg*>(
+                requestHdr.data());
+            if (reply.is_method_error())
+            {
+                error(
+                    "Error Setting time,PATH={SET_TIME_PATH} TIME INTERFACE={TIME_INTERFACE} ERRNO={ERRNO}",
+                    "SET_TIME_PATH", bmcTimePath, "TIME_INTERFACE",
+                    timeInterface, "ERRNO", reply.get_errno());
+                respond(ccOnlyResponse(request, PLDM_ERROR));
+                return;
+            }
+            respond(ccOnlyResponse(request, PLDM_SUCCESS));
+        });
+    }
+    catch (const std::exception& e)
+    {
+        error(
+            "Error Setting time,PATH={SET_TIME_PATH} TIME INTERFACE={TIME_INTERFACE} ERROR={ERR_EXCEP}",
+            "SET_TIME_PATH", bmcTimePath, "TIME_INTERFACE", timeInterface,
+            "ERR_EXCEP", e.what());
+        respond(ccOnlyResponse(request, PLDM_ERROR));
+    }
+}
+
 Response Handler::getBIOSTable(const pldm_msg* request, size_t payloadLength)
 {
     uint32_t transferHandle{};
@@ -235,20 +421,47 @@ Response Handler::getBIOSTable(const pldm_msg* request, size_t payloadLength)
         return ccOnlyResponse(request, rc);
     }
 
-    auto table =
+    const auto& table =
         biosConfig.getBIOSTable(static_cast<pldm_bios_table_types>(tableType));
     if (!table)
     {
         return ccOnlyResponse(request, PLDM_BIOS_TABLE_UNAVAILABLE);
     }
 
-    Response response(sizeof(pldm_msg_hdr) +
-                      PLDM_GET_BIOS_TABLE_MIN_RESP_BYTES + table->size());
+    // The transfer handle is the offset of the part in the table
+    size_t offset = 0;
+    if (transferOpFlag == PLDM_GET_NEXTPART)
+    {
+        if (!transferHandle || transferHandle >= table->size())
+        {
+            return ccOnlyResponse(request, PLDM_ERROR_INVALID_DATA);
+        }
+        offset = transferHandle;
+    }
+    else if (transferOpFlag != PLDM_GET_FIRSTPART)
+    {
+        return ccOnlyResponse(request, PLDM_INVALID_TRANSFER_OPERATION_FLAG);
+    }
+
+    // The parts are as large as negotiated with the requester
+    auto partSize = std::min<size_t>(
+        table->size() - offset,
+        transfer::TransferSizes::get().requesterPartSize(BIOS_TABLE_TRANSFER_SIZE));
+    auto nextOffset = offset + partSize;
+    bool morePart = nextOffset < table->size();
+    uint8_t transferFlag = offset ? (morePart ? PLDM_MIDDLE : PLDM_END)
+                                  : (morePart ? PLDM_START
+                                              : PLDM_START_AND_END);
+    uint32_t nxtTransferHandle = morePart ? static_cast<uint32_t>(nextOffset)
+                                          : 0;
+
+    auto response = responseBuffer(PLDM_GET_BIOS_TABLE_MIN_RESP_BYTES +
+                                   partSize);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     rc = encode_get_bios_table_resp(
-        request->hdr.instance_id, PLDM_SUCCESS, 0 /* nxtTransferHandle */,
-        PLDM_START_AND_END, table->data(), response.size(), responsePtr);
+        request->hdr.instance_id, PLDM_SUCCESS, nxtTransferHandle,
+        transferFlag, table->data() + offset, response.size(), responsePtr);
     if (rc != PLDM_SUCCESS)
     {
         return ccOnlyResponse(request, rc);
@@ -278,7 +491,7 @@ Response Handler::setBIOSTable(const pldm_msg* request, size_t payloadLength)
         return ccOnlyResponse(request, rc);
     }
 
-    Response response(sizeof(pldm_msg_hdr) + PLDM_SET_BIOS_TABLE_RESP_BYTES);
+    auto response = responseBuffer<PLDM_SET_BIOS_TABLE_RESP_BYTES>();
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     rc = encode_set_bios_table_resp(request->hdr.instance_id, PLDM_SUCCESS,
@@ -306,7 +519,7 @@ Response Handler::getBIOSAttributeCurrentValueByHandle(const pldm_msg* request,
         return ccOnlyResponse(request, rc);
     }
 
-    auto table = biosConfig.getBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE);
+    const auto& table = biosConfig.getBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE);
     if (!table)
     {
         return ccOnlyResponse(request, PLDM_BIOS_TABLE_UNAVAILABLE);
@@ -320,10 +533,8 @@ Response Handler::getBIOSAttributeCurrentValueByHandle(const pldm_msg* request,
     }
 
     auto entryLength = pldm_bios_table_attr_value_entry_length(entry);
-    Response response(sizeof(pldm_msg_hdr) +
-                          PLDM_GET_BIOS_ATTR_CURR_VAL_BY_HANDLE_MIN_RESP_BYTES +
-                          entryLength,
-                      0);
+    auto response = responseBuffer(
+        PLDM_GET_BIOS_ATTR_CURR_VAL_BY_HANDLE_MIN_RESP_BYTES + entryLength);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
     rc = encode_get_bios_current_value_by_handle_resp(
         request->hdr.instance_id, PLDM_SUCCESS, 0, PLDM_START_AND_END,
@@ -354,8 +565,7 @@ Response Handler::setBIOSAttributeCurrentValue(const pldm_msg* request,
     rc = biosConfig.setAttrValue(attributeField.ptr, attributeField.length,
                                  false);
 
-    Response response(
-        sizeof(pldm_msg_hdr) + PLDM_SET_BIOS_ATTR_CURR_VAL_RESP_BYTES, 0);
+    auto response = responseBuffer<PLDM_SET_BIOS_ATTR_CURR_VAL_RESP_BYTES>();
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     encode_set_bios_attribute_current_value_resp(request->hdr.instance_id, rc,
@@ -3,6 +3,7 @@
 #include "bios_config.hpp"
 #include "bios_table.hpp"
 #include "common/instance_id.hpp"
+#include "common/utils.hpp"
 #include "pldmd/handler.hpp"
 #include "requester/handler.hpp"
 
@@ -46,6 +47,16 @@ class Handler : public CmdHandler
      */
     Response getDateTime(const pldm_msg* request, size_t payloadLength);
 
+    /** @brief Deferred handler for GetDateTime, the time is read without
+     *         blocking the event loop
+     *
+     *  @param[in] request - Request message
+     *  @param[in] payloadLength - Request message payload length
+     *  @param[in] respond - sends the PLDM Response message
+     */
+    void getDateTimeAsync(const pldm_msg* request, size_t payloadLength,
+                          ResponseSender&& respond);
+
     /** @brief Handler for GetBIOSTable
      *
      *  @param[in] request - Request message
@@ -79,6 +90,16 @@ class Handler : public CmdHandler
      */
     Response setDateTime(const pldm_msg* request, size_t payloadLength);
 
+    /** @brief Deferred handler for SetDateTime, the time sync method is read
+     *         and the time is set without blocking the event loop
+     *
+     *  @param[in] request - Request message
+     *  @param[in] payloadLength - Request message payload length
+     *  @param[in] respond - sends the PLDM Response message
+     */
+    void setDateTimeAsync(const pldm_msg* request, size_t payloadLength,
+                          ResponseSender&& respond);
+
     /** @brief Handler for setBIOSAttributeCurrentValue
      *
      *  @param[in] request - Request message
@@ -89,7 +110,31 @@ class Handler : public CmdHandler
                                           size_t payloadLength);
 
   private:
+    /** @brief Encode the GetDateTime response
+     *
+     *  @param[in] request - Request message
+     *  @param[in] timeUsec - BMC time in microseconds since the epoch
+     *  @return Response - PLDM Response message
+     */
+    Response getDateTimeResponse(const pldm_msg* request, uint64_t timeUsec);
+
+    /** @brief Decode the SetDateTime request
+     *
+     *  @param[in] request - Request message
+     *  @param[in] payloadLength - Request message payload length
+     *  @param[out] timeUsec - requested time in microseconds since the epoch
+     *  @return PLDM completion code
+     */
+    int decodeDateTime(const pldm_msg* request, size_t payloadLength,
+                       uint64_t& timeUsec);
+
+    /** @brief Set the BMC time on the deferred SetDateTime path */
+    void setTimeAsync(const Response& request, size_t payloadLength,
+                      ResponseSender&& respond);
+
     BIOSConfig biosConfig;
+    /** @brief D-Bus calls of the deferred handlers */
+    pldm::utils::AsyncCalls dbusCalls;
 };
 
 } // namespace bios
@@ -50,6 +50,19 @@ std::optional<DBusMapping> BIOSAttribute::getDBusMap()
     return dBusMap;
 }
 
+PropertyValue BIOSAttribute::readDbusValue()
+{
+    if (prefetchedValue)
+    {
+        auto value = std::move(*prefetchedValue);
+        prefetchedValue.reset();
+        return value;
+    }
+    return dbusHandler->getDbusPropertyVariant(dBusMap->objectPath.c_str(),
+                                               dBusMap->propertyName.c_str(),
+                                               dBusMap->interface.c_str());
+}
+
 } // namespace bios
 } // namespace responder
 } // namespace pldm
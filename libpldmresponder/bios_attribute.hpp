@@ -89,6 +89,15 @@ class BIOSAttribute
     /** @brief Method to return the D-Bus map */
     std::optional<pldm::utils::DBusMapping> getDBusMap();
 
+    /** @brief Set the value of the D-Bus property read ahead, e.g. with the
+     *         properties of all the attributes, it serves the next read
+     *  @param[in] value - The D-Bus property value, nullopt to drop it
+     */
+    void setPrefetchedValue(std::optional<pldm::utils::PropertyValue> value)
+    {
+        prefetchedValue = std::move(value);
+    }
+
     /** @brief Name of this attribute */
     const std::string name;
 
@@ -100,9 +109,19 @@ class BIOSAttribute
     const std::string helpText;
 
   protected:
+    /** @brief Read the D-Bus property of the attribute, the prefetched value
+     *         if there is one
+     *  @return The D-Bus property value
+     *  @throw sdbusplus::exception_t when the D-Bus read fails
+     */
+    pldm::utils::PropertyValue readDbusValue();
+
     /** @brief dbus backend, nullopt if this attribute is read-only*/
     std::optional<pldm::utils::DBusMapping> dBusMap;
 
+    /** @brief Value read ahead for the next readDbusValue() */
+    std::optional<pldm::utils::PropertyValue> prefetchedValue;
+
     /** @brief dbus handler */
     pldm::utils::DBusHandler* const dbusHandler;
 };
@@ -5,12 +5,22 @@
 #include "bios_string_attribute.hpp"
 #include "bios_table.hpp"
 #include "common/bios_utils.hpp"
+#include "common/memory_accounting.hpp"
+#include "common/utils.hpp"
+#include "common/write_behind.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include <phosphor-logging/lg2.hpp>
 #include <xyz/openbmc_project/BIOSConfig/Manager/server.hpp>
 
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <stdexcept>
 
 #ifdef OEM_IBM
 #include "oem/ibm/libpldmresponder/platform_oem_ibm.hpp"
@@ -39,6 +49,122 @@ constexpr auto stringTableFile = "stringTable";
 constexpr auto attrTableFile = "attributeTable";
 constexpr auto attrValueTableFile = "attributeValueTable";
 
+#ifdef BIOS_COMPILED_JSON
+constexpr uint32_t compiledJsonMagic = 0x434a4250; // "PBJC"
+constexpr uint16_t compiledJsonVersion = 1;
+
+/** @struct CompiledJsonHeader
+ *
+ *  Header of the CBOR image of a BIOS JSON config file, the image is used
+ *  while the JSON file keeps the size and modification time it was compiled
+ *  from.
+ */
+struct CompiledJsonHeader
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    uint64_t sourceSize;  //!< size of the compiled JSON file
+    int64_t sourceMtime;  //!< modification time of the compiled JSON file
+    uint32_t payloadSize; //!< size of the CBOR payload after the header
+    uint32_t checksum;    //!< CRC-32 of the CBOR payload
+};
+
+/** @brief Load the CBOR image of a JSON config file
+ *
+ *  @param[in] imagePath - path of the image
+ *  @param[in] sourceSize - size of the JSON file
+ *  @param[in] sourceMtime - modification time of the JSON file
+ *
+ *  @return the config, std::nullopt if the image is missing or stale
+ */
+std::optional<Json> loadCompiledJson(const fs::path& imagePath,
+                                     uint64_t sourceSize, int64_t sourceMtime)
+{
+    int fd = open(imagePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return std::nullopt;
+    }
+    struct stat st;
+    if (fstat(fd, &st) ||
+        static_cast<size_t>(st.st_size) < sizeof(CompiledJsonHeader))
+    {
+        close(fd);
+        return std::nullopt;
+    }
+    auto data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        return std::nullopt;
+    }
+
+    std::optional<Json> json;
+    CompiledJsonHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    auto payload = static_cast<const uint8_t*>(data) + sizeof(header);
+    if (header.magic == compiledJsonMagic &&
+        header.version == compiledJsonVersion &&
+        header.sourceSize == sourceSize && header.sourceMtime == sourceMtime &&
+        header.payloadSize == st.st_size - sizeof(header) &&
+        header.checksum == pldm::utils::Crc32::of(
+                               std::span(payload, header.payloadSize)))
+    {
+        try
+        {
+            json = Json::from_cbor(payload, payload + header.payloadSize);
+        }
+        catch (const Json::exception& e)
+        {
+            error("Failed to decode the compiled BIOS config {PATH}: {ERROR}",
+                  "PATH", imagePath.c_str(), "ERROR", e.what());
+        }
+    }
+    munmap(data, st.st_size);
+    return json;
+}
+
+/** @brief Store the CBOR image of a JSON config file
+ *
+ *  @param[in] imagePath - path of the image
+ *  @param[in] json - the parsed config
+ *  @param[in] sourceSize - size of the JSON file
+ *  @param[in] sourceMtime - modification time of the JSON file
+ */
+void storeCompiledJson(const fs::path& imagePath, const Json& json,
+                       uint64_t sourceSize, int64_t sourceMtime)
+{
+    auto payload = Json::to_cbor(json);
+    CompiledJsonHeader header{compiledJsonMagic,
+                              compiledJsonVersion,
+                              0,
+                              sourceSize,
+                              sourceMtime,
+                              static_cast<uint32_t>(payload.size()),
+                              pldm::utils::Crc32::of(payload)};
+
+    // A partially written image is never used, it is renamed once complete
+    auto tmpPath = imagePath;
+    tmpPath += ".tmp";
+    std::ofstream stream(tmpPath, std::ios::out | std::ios::binary);
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    stream.write(reinterpret_cast<const char*>(payload.data()),
+                 payload.size());
+    stream.close();
+
+    std::error_code ec;
+    if (!stream)
+    {
+        error("Failed to store the compiled BIOS config {PATH}", "PATH",
+              imagePath.c_str());
+        fs::remove(tmpPath, ec);
+        return;
+    }
+    fs::rename(tmpPath, imagePath, ec);
+}
+#endif
+
 } // namespace
 
 BIOSConfig::BIOSConfig(
@@ -73,7 +199,8 @@ void BIOSConfig::buildTables()
     }
 }
 
-std::optional<Table> BIOSConfig::getBIOSTable(pldm_bios_table_types tableType)
+const std::optional<Table>&
+    BIOSConfig::getBIOSTable(pldm_bios_table_types tableType)
 {
     fs::path tablePath;
     switch (tableType)
@@ -109,8 +236,7 @@ int BIOSConfig::setBIOSTable(uint8_t tableType, const Table& table,
     }
     else if (tableType == PLDM_BIOS_ATTR_TABLE)
     {
-        BIOSTable biosStringTable(stringTablePath.c_str());
-        if (biosStringTable.isEmpty())
+        if (!loadTable(stringTablePath))
         {
             return PLDM_INVALID_BIOS_TABLE_TYPE;
         }
@@ -125,9 +251,7 @@ int BIOSConfig::setBIOSTable(uint8_t tableType, const Table& table,
     }
     else if (tableType == PLDM_BIOS_ATTR_VAL_TABLE)
     {
-        BIOSTable biosStringTable(stringTablePath.c_str());
-        BIOSTable biosStringValueTable(attrTablePath.c_str());
-        if (biosStringTable.isEmpty() || biosStringValueTable.isEmpty())
+        if (!loadTable(stringTablePath) || !loadTable(attrTablePath))
         {
             return PLDM_INVALID_BIOS_TABLE_TYPE;
         }
@@ -156,7 +280,7 @@ int BIOSConfig::setBIOSTable(uint8_t tableType, const Table& table,
 int BIOSConfig::checkAttributeTable(const Table& table)
 {
     using namespace pldm::bios::utils;
-    auto stringTable = getBIOSTable(PLDM_BIOS_STRING_TABLE);
+    const auto& stringTable = getBIOSTable(PLDM_BIOS_STRING_TABLE);
     for (auto entry :
          BIOSTableIter<PLDM_BIOS_ATTR_TABLE>(table.data(), table.size()))
     {
@@ -233,217 +357,256 @@ int BIOSConfig::checkAttributeTable(const Table& table)
 int BIOSConfig::checkAttributeValueTable(const Table& table)
 {
     using namespace pldm::bios::utils;
-    auto stringTable = getBIOSTable(PLDM_BIOS_STRING_TABLE);
-    auto attrTable = getBIOSTable(PLDM_BIOS_ATTR_TABLE);
-
-    baseBIOSTableMaps.clear();
+    const auto& stringTable = getBIOSTable(PLDM_BIOS_STRING_TABLE);
+    const auto& attrTable = getBIOSTable(PLDM_BIOS_ATTR_TABLE);
 
+    BaseBIOSTable decoded;
     for (auto tableEntry :
          BIOSTableIter<PLDM_BIOS_ATTR_VAL_TABLE>(table.data(), table.size()))
     {
-        AttributeName attributeName{};
-        AttributeType attributeType{};
-        ReadonlyStatus readonlyStatus{};
-        DisplayName displayName{};
-        Description description{};
-        MenuPath menuPath{};
-        CurrentValue currentValue{};
-        DefaultValue defaultValue{};
-        Option options{};
-
-        auto attrValueHandle =
-            pldm_bios_table_attr_value_entry_decode_attribute_handle(
-                tableEntry);
-        auto attrType = static_cast<pldm_bios_attribute_type>(
-            pldm_bios_table_attr_value_entry_decode_attribute_type(tableEntry));
-
-        auto attrEntry = pldm_bios_table_attr_find_by_handle(
-            attrTable->data(), attrTable->size(), attrValueHandle);
-        if (attrEntry == nullptr)
+        auto rc = decodeBaseBIOSTableEntry(tableEntry, *attrTable,
+                                           *stringTable, decoded);
+        if (rc != PLDM_SUCCESS)
         {
-            return PLDM_INVALID_BIOS_ATTR_HANDLE;
+            return rc;
         }
-        auto attrHandle =
-            pldm_bios_table_attr_entry_decode_attribute_handle(attrEntry);
-        auto attrNameHandle =
-            pldm_bios_table_attr_entry_decode_string_handle(attrEntry);
+    }
 
-        auto stringEntry = pldm_bios_table_string_find_by_handle(
-            stringTable->data(), stringTable->size(), attrNameHandle);
-        if (stringEntry == nullptr)
+    // Track the attributes added, changed or removed by the new table
+    for (const auto& [name, entry] : decoded)
+    {
+        auto it = baseBIOSTableMaps.find(name);
+        if (it == baseBIOSTableMaps.end() || it->second != entry)
         {
-            return PLDM_INVALID_BIOS_ATTR_HANDLE;
+            changedAttributes.insert(name);
         }
-        auto strLength =
-            pldm_bios_table_string_entry_decode_string_length(stringEntry);
-        std::vector<char> buffer(strLength + 1 /* sizeof '\0' */);
-        // Preconditions are upheld therefore no error check necessary
-        pldm_bios_table_string_entry_decode_string_check(
-            stringEntry, buffer.data(), buffer.size());
-
-        attributeName = std::string(buffer.data(), buffer.data() + strLength);
-
-        if (!biosAttributes.empty())
+    }
+    for (const auto& [name, entry] : baseBIOSTableMaps)
+    {
+        if (!decoded.contains(name))
         {
-            readonlyStatus =
-                biosAttributes[attrHandle % biosAttributes.size()]->readOnly;
-            description =
-                biosAttributes[attrHandle % biosAttributes.size()]->helpText;
-            displayName =
-                biosAttributes[attrHandle % biosAttributes.size()]->displayName;
+            changedAttributes.insert(name);
         }
+    }
+    baseBIOSTableMaps = std::move(decoded);
 
-        switch (attrType)
-        {
-            case PLDM_BIOS_ENUMERATION:
-            case PLDM_BIOS_ENUMERATION_READ_ONLY:
-            {
-                auto getValue = [](uint16_t handle,
-                                   const Table& table) -> std::string {
-                    auto stringEntry = pldm_bios_table_string_find_by_handle(
-                        table.data(), table.size(), handle);
-
-                    auto strLength =
-                        pldm_bios_table_string_entry_decode_string_length(
-                            stringEntry);
-                    std::vector<char> buffer(strLength + 1 /* sizeof '\0' */);
-                    // Preconditions are upheld therefore no error check
-                    // necessary
-                    pldm_bios_table_string_entry_decode_string_check(
-                        stringEntry, buffer.data(), buffer.size());
-
-                    return std::string(buffer.data(),
-                                       buffer.data() + strLength);
-                };
-
-                attributeType = "xyz.openbmc_project.BIOSConfig.Manager."
-                                "AttributeType.Enumeration";
-
-                uint8_t pvNum;
-                // Preconditions are upheld therefore no error check necessary
-                pldm_bios_table_attr_entry_enum_decode_pv_num_check(attrEntry,
-                                                                    &pvNum);
-                std::vector<uint16_t> pvHandls(pvNum);
-                // Preconditions are upheld therefore no error check necessary
-                pldm_bios_table_attr_entry_enum_decode_pv_hdls_check(
-                    attrEntry, pvHandls.data(), pvHandls.size());
+    return PLDM_SUCCESS;
+}
 
-                // get possible_value
-                for (size_t i = 0; i < pvHandls.size(); i++)
-                {
-                    options.push_back(
-                        std::make_tuple("xyz.openbmc_project.BIOSConfig."
-                                        "Manager.BoundType.OneOf",
-                                        getValue(pvHandls[i], *stringTable)));
-                }
+int BIOSConfig::decodeBaseBIOSTableEntry(
+    const pldm_bios_attr_val_table_entry* tableEntry, const Table& attrTable,
+    const Table& stringTable, BaseBIOSTable& baseBIOSTable,
+    std::set<AttributeName>* changes)
+{
+    AttributeName attributeName{};
+    AttributeType attributeType{};
+    ReadonlyStatus readonlyStatus{};
+    DisplayName displayName{};
+    Description description{};
+    MenuPath menuPath{};
+    CurrentValue currentValue{};
+    DefaultValue defaultValue{};
+    Option options{};
+
+    auto attrValueHandle =
+        pldm_bios_table_attr_value_entry_decode_attribute_handle(tableEntry);
+    auto attrType = static_cast<pldm_bios_attribute_type>(
+        pldm_bios_table_attr_value_entry_decode_attribute_type(tableEntry));
 
-                auto count =
-                    pldm_bios_table_attr_value_entry_enum_decode_number(
-                        tableEntry);
-                std::vector<uint8_t> handles(count);
-                pldm_bios_table_attr_value_entry_enum_decode_handles(
-                    tableEntry, handles.data(), handles.size());
+    auto attrEntry = pldm_bios_table_attr_find_by_handle(
+        attrTable.data(), attrTable.size(), attrValueHandle);
+    if (attrEntry == nullptr)
+    {
+        return PLDM_INVALID_BIOS_ATTR_HANDLE;
+    }
+    auto attrHandle =
+        pldm_bios_table_attr_entry_decode_attribute_handle(attrEntry);
+    auto attrNameHandle =
+        pldm_bios_table_attr_entry_decode_string_handle(attrEntry);
 
-                // get current_value
-                for (size_t i = 0; i < handles.size(); i++)
-                {
-                    currentValue = getValue(pvHandls[handles[i]], *stringTable);
-                }
+    auto stringEntry = pldm_bios_table_string_find_by_handle(
+        stringTable.data(), stringTable.size(), attrNameHandle);
+    if (stringEntry == nullptr)
+    {
+        return PLDM_INVALID_BIOS_ATTR_HANDLE;
+    }
+    auto strLength =
+        pldm_bios_table_string_entry_decode_string_length(stringEntry);
+    std::vector<char> buffer(strLength + 1 /* sizeof '\0' */);
+    // Preconditions are upheld therefore no error check necessary
+    pldm_bios_table_string_entry_decode_string_check(
+        stringEntry, buffer.data(), buffer.size());
 
-                uint8_t defNum;
-                // Preconditions are upheld therefore no error check necessary
-                pldm_bios_table_attr_entry_enum_decode_def_num_check(attrEntry,
-                                                                     &defNum);
-                std::vector<uint8_t> defIndices(defNum);
-                pldm_bios_table_attr_entry_enum_decode_def_indices(
-                    attrEntry, defIndices.data(), defIndices.size());
+    attributeName = std::string(buffer.data(), buffer.data() + strLength);
 
-                // get default_value
-                for (size_t i = 0; i < defIndices.size(); i++)
-                {
-                    defaultValue = getValue(pvHandls[defIndices[i]],
-                                            *stringTable);
-                }
+    if (!biosAttributes.empty())
+    {
+        readonlyStatus =
+            biosAttributes[attrHandle % biosAttributes.size()]->readOnly;
+        description =
+            biosAttributes[attrHandle % biosAttributes.size()]->helpText;
+        displayName =
+            biosAttributes[attrHandle % biosAttributes.size()]->displayName;
+    }
 
-                break;
-            }
-            case PLDM_BIOS_INTEGER:
-            case PLDM_BIOS_INTEGER_READ_ONLY:
+    switch (attrType)
+    {
+        case PLDM_BIOS_ENUMERATION:
+        case PLDM_BIOS_ENUMERATION_READ_ONLY:
+        {
+            auto getValue = [](uint16_t handle,
+                               const Table& table) -> std::string {
+                auto stringEntry = pldm_bios_table_string_find_by_handle(
+                    table.data(), table.size(), handle);
+
+                auto strLength =
+                    pldm_bios_table_string_entry_decode_string_length(
+                        stringEntry);
+                std::vector<char> buffer(strLength + 1 /* sizeof '\0' */);
+                // Preconditions are upheld therefore no error check
+                // necessary
+                pldm_bios_table_string_entry_decode_string_check(
+                    stringEntry, buffer.data(), buffer.size());
+
+                return std::string(buffer.data(),
+                                   buffer.data() + strLength);
+            };
+
+            attributeType = "xyz.openbmc_project.BIOSConfig.Manager."
+                            "AttributeType.Enumeration";
+
+            uint8_t pvNum;
+            // Preconditions are upheld therefore no error check necessary
+            pldm_bios_table_attr_entry_enum_decode_pv_num_check(attrEntry,
+                                                                &pvNum);
+            std::vector<uint16_t> pvHandls(pvNum);
+            // Preconditions are upheld therefore no error check necessary
+            pldm_bios_table_attr_entry_enum_decode_pv_hdls_check(
+                attrEntry, pvHandls.data(), pvHandls.size());
+
+            // get possible_value
+            for (size_t i = 0; i < pvHandls.size(); i++)
             {
-                attributeType = "xyz.openbmc_project.BIOSConfig.Manager."
-                                "AttributeType.Integer";
-                currentValue = static_cast<int64_t>(
-                    pldm_bios_table_attr_value_entry_integer_decode_cv(
-                        tableEntry));
-
-                uint64_t lower, upper, def;
-                uint32_t scalar;
-                pldm_bios_table_attr_entry_integer_decode(
-                    attrEntry, &lower, &upper, &scalar, &def);
                 options.push_back(
-                    std::make_tuple("xyz.openbmc_project.BIOSConfig.Manager."
-                                    "BoundType.LowerBound",
-                                    static_cast<int64_t>(lower)));
-                options.push_back(
-                    std::make_tuple("xyz.openbmc_project.BIOSConfig.Manager."
-                                    "BoundType.UpperBound",
-                                    static_cast<int64_t>(upper)));
-                options.push_back(
-                    std::make_tuple("xyz.openbmc_project.BIOSConfig.Manager."
-                                    "BoundType.ScalarIncrement",
-                                    static_cast<int64_t>(scalar)));
-                defaultValue = static_cast<int64_t>(def);
-                break;
+                    std::make_tuple("xyz.openbmc_project.BIOSConfig."
+                                    "Manager.BoundType.OneOf",
+                                    getValue(pvHandls[i], stringTable)));
             }
-            case PLDM_BIOS_STRING:
-            case PLDM_BIOS_STRING_READ_ONLY:
+
+            auto count =
+                pldm_bios_table_attr_value_entry_enum_decode_number(
+                    tableEntry);
+            std::vector<uint8_t> handles(count);
+            pldm_bios_table_attr_value_entry_enum_decode_handles(
+                tableEntry, handles.data(), handles.size());
+
+            // get current_value
+            for (size_t i = 0; i < handles.size(); i++)
             {
-                attributeType = "xyz.openbmc_project.BIOSConfig.Manager."
-                                "AttributeType.String";
-                variable_field currentString;
-                pldm_bios_table_attr_value_entry_string_decode_string(
-                    tableEntry, &currentString);
-                currentValue = std::string(
-                    reinterpret_cast<const char*>(currentString.ptr),
-                    currentString.length);
-                auto min = pldm_bios_table_attr_entry_string_decode_min_length(
-                    attrEntry);
-                auto max = pldm_bios_table_attr_entry_string_decode_max_length(
-                    attrEntry);
-                uint16_t def;
-                // Preconditions are upheld therefore no error check necessary
-                pldm_bios_table_attr_entry_string_decode_def_string_length_check(
-                    attrEntry, &def);
-                std::vector<char> defString(def + 1);
-                pldm_bios_table_attr_entry_string_decode_def_string(
-                    attrEntry, defString.data(), defString.size());
-                options.push_back(
-                    std::make_tuple("xyz.openbmc_project.BIOSConfig.Manager."
-                                    "BoundType.MinStringLength",
-                                    static_cast<int64_t>(min)));
-                options.push_back(
-                    std::make_tuple("xyz.openbmc_project.BIOSConfig.Manager."
-                                    "BoundType.MaxStringLength",
-                                    static_cast<int64_t>(max)));
-                defaultValue = defString.data();
-                break;
+                currentValue = getValue(pvHandls[handles[i]], stringTable);
             }
-            case PLDM_BIOS_PASSWORD:
-            case PLDM_BIOS_PASSWORD_READ_ONLY:
+
+            uint8_t defNum;
+            // Preconditions are upheld therefore no error check necessary
+            pldm_bios_table_attr_entry_enum_decode_def_num_check(attrEntry,
+                                                                 &defNum);
+            std::vector<uint8_t> defIndices(defNum);
+            pldm_bios_table_attr_entry_enum_decode_def_indices(
+                attrEntry, defIndices.data(), defIndices.size());
+
+            // get default_value
+            for (size_t i = 0; i < defIndices.size(); i++)
             {
-                attributeType = "xyz.openbmc_project.BIOSConfig.Manager."
-                                "AttributeType.Password";
-                break;
+                defaultValue = getValue(pvHandls[defIndices[i]],
+                                        stringTable);
             }
-            default:
-                return PLDM_INVALID_BIOS_ATTR_HANDLE;
+
+            break;
+        }
+        case PLDM_BIOS_INTEGER:
+        case PLDM_BIOS_INTEGER_READ_ONLY:
+        {
+            attributeType = "xyz.openbmc_project.BIOSConfig.Manager."
+                            "AttributeType.Integer";
+            currentValue = static_cast<int64_t>(
+                pldm_bios_table_attr_value_entry_integer_decode_cv(
+                    tableEntry));
+
+            uint64_t lower, upper, def;
+            uint32_t scalar;
+            pldm_bios_table_attr_entry_integer_decode(
+                attrEntry, &lower, &upper, &scalar, &def);
+            options.push_back(
+                std::make_tuple("xyz.openbmc_project.BIOSConfig.Manager."
+                                "BoundType.LowerBound",
+                                static_cast<int64_t>(lower)));
+            options.push_back(
+                std::make_tuple("xyz.openbmc_project.BIOSConfig.Manager."
+                                "BoundType.UpperBound",
+                                static_cast<int64_t>(upper)));
+            options.push_back(
+                std::make_tuple("xyz.openbmc_project.BIOSConfig.Manager."
+                                "BoundType.ScalarIncrement",
+                                static_cast<int64_t>(scalar)));
+            defaultValue = static_cast<int64_t>(def);
+            break;
+        }
+        case PLDM_BIOS_STRING:
+        case PLDM_BIOS_STRING_READ_ONLY:
+        {
+            attributeType = "xyz.openbmc_project.BIOSConfig.Manager."
+                            "AttributeType.String";
+            variable_field currentString;
+            pldm_bios_table_attr_value_entry_string_decode_string(
+                tableEntry, &currentString);
+            currentValue = std::string(
+                reinterpret_cast<const char*>(currentString.ptr),
+                currentString.length);
+            auto min = pldm_bios_table_attr_entry_string_decode_min_length(
+                attrEntry);
+            auto max = pldm_bios_table_attr_entry_string_decode_max_length(
+                attrEntry);
+            uint16_t def;
+            // Preconditions are upheld therefore no error check necessary
+            pldm_bios_table_attr_entry_string_decode_def_string_length_check(
+                attrEntry, &def);
+            std::vector<char> defString(def + 1);
+            pldm_bios_table_attr_entry_string_decode_def_string(
+                attrEntry, defString.data(), defString.size());
+            options.push_back(
+                std::make_tuple("xyz.openbmc_project.BIOSConfig.Manager."
+                                "BoundType.MinStringLength",
+                                static_cast<int64_t>(min)));
+            options.push_back(
+                std::make_tuple("xyz.openbmc_project.BIOSConfig.Manager."
+                                "BoundType.MaxStringLength",
+                                static_cast<int64_t>(max)));
+            defaultValue = defString.data();
+            break;
+        }
+        case PLDM_BIOS_PASSWORD:
+        case PLDM_BIOS_PASSWORD_READ_ONLY:
+        {
+            attributeType = "xyz.openbmc_project.BIOSConfig.Manager."
+                            "AttributeType.Password";
+            break;
         }
-        baseBIOSTableMaps.emplace(
-            std::move(attributeName),
-            std::make_tuple(attributeType, readonlyStatus, displayName,
-                            description, menuPath, currentValue, defaultValue,
-                            std::move(options)));
+        default:
+            return PLDM_INVALID_BIOS_ATTR_HANDLE;
+    }
+    auto entry = std::make_tuple(attributeType, readonlyStatus, displayName,
+                                 description, menuPath, currentValue,
+                                 defaultValue, std::move(options));
+    auto it = baseBIOSTable.find(attributeName);
+    if (it != baseBIOSTable.end() && it->second == entry)
+    {
+        return PLDM_SUCCESS;
+    }
+    if (changes)
+    {
+        changes->insert(attributeName);
     }
+    baseBIOSTable.insert_or_assign(std::move(attributeName), std::move(entry));
 
     return PLDM_SUCCESS;
 }
@@ -457,11 +620,16 @@ void BIOSConfig::updateBaseBIOSTableProperty()
     constexpr static auto biosConfigPropertyName = "BaseBIOSTable";
     constexpr static auto dbusProperties = "org.freedesktop.DBus.Properties";
 
-    if (baseBIOSTableMaps.empty())
+    // The subscribers fetch the whole table on each update, none is sent
+    // when no attribute changed
+    if (baseBIOSTableMaps.empty() || changedAttributes.empty())
     {
         return;
     }
 
+    // The table is moved into the variant for the append and moved back,
+    // instead of copying every attribute
+    std::variant<BaseBIOSTable> value(std::move(baseBIOSTableMaps));
     try
     {
         auto& bus = dbusHandler->getBus();
@@ -469,15 +637,18 @@ void BIOSConfig::updateBaseBIOSTableProperty()
                                                biosConfigInterface);
         auto method = bus.new_method_call(service.c_str(), biosConfigPath,
                                           dbusProperties, "Set");
-        std::variant<BaseBIOSTable> value = baseBIOSTableMaps;
         method.append(biosConfigInterface, biosConfigPropertyName, value);
         bus.call_noreply(method, dbusTimeout);
+        debug("Updated BaseBIOSTable, {CHANGED} attributes changed",
+              "CHANGED", changedAttributes.size());
+        changedAttributes.clear();
     }
     catch (const std::exception& e)
     {
         error("failed to update BaseBIOSTable property, ERROR={ERR_EXCEP}",
               "ERR_EXCEP", e.what());
     }
+    baseBIOSTableMaps = std::move(std::get<BaseBIOSTable>(value));
 }
 
 void BIOSConfig::constructAttributes()
@@ -528,6 +699,8 @@ void BIOSConfig::buildAndStoreAttrTables(const Table& stringTable)
               "ERR_EXCEP", e.what());
     }
 
+    prefetchAttrValues(biosTable);
+
     Table attrTable, attrValueTable;
 
     for (auto& attr : biosAttributes)
@@ -555,12 +728,109 @@ void BIOSConfig::buildAndStoreAttrTables(const Table& stringTable)
         }
     }
 
+    // A value not used by a failed entry is not served to a later read
+    for (auto& attr : biosAttributes)
+    {
+        attr->setPrefetchedValue(std::nullopt);
+    }
+
     table::appendPadAndChecksum(attrTable);
     table::appendPadAndChecksum(attrValueTable);
     setBIOSTable(PLDM_BIOS_ATTR_TABLE, attrTable);
     setBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE, attrValueTable);
 }
 
+void BIOSConfig::prefetchAttrValues(const BaseBIOSTable& biosTable)
+{
+    std::map<std::pair<std::string, std::string>, std::vector<BIOSAttribute*>>
+        objects;
+    for (auto& attr : biosAttributes)
+    {
+        auto dBusMap = attr->getDBusMap();
+        if (dBusMap && !biosTable.contains(attr->name))
+        {
+            objects[{dBusMap->objectPath, dBusMap->interface}].push_back(
+                attr.get());
+        }
+    }
+    if (objects.empty())
+    {
+        return;
+    }
+
+    size_t pending = 0;
+    size_t fetched = 0;
+    std::vector<sdbusplus::slot_t> calls;
+    try
+    {
+        auto& bus = dbusHandler->getBus();
+        for (const auto& [object, attrs] : objects)
+        {
+            const auto& [path, interface] = object;
+            try
+            {
+                auto service = dbusHandler->getService(path.c_str(),
+                                                       interface.c_str());
+                auto method = bus.new_method_call(service.c_str(),
+                                                  path.c_str(), dbusProperties,
+                                                  "GetAll");
+                method.append(interface);
+                calls.emplace_back(bus.call_async(
+                    method,
+                    [&pending, &fetched,
+                     &attrs = attrs](sdbusplus::message_t& reply) {
+                    pending--;
+                    if (reply.is_method_error())
+                    {
+                        return;
+                    }
+                    DbusChangedProps properties;
+                    try
+                    {
+                        reply.read(properties);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        return;
+                    }
+                    for (auto* attr : attrs)
+                    {
+                        auto it =
+                            properties.find(attr->getDBusMap()->propertyName);
+                        if (it != properties.end())
+                        {
+                            attr->setPrefetchedValue(std::move(it->second));
+                            fetched++;
+                        }
+                    }
+                }, dbusTimeout));
+                pending++;
+            }
+            catch (const std::exception& e)
+            {
+                // The attributes of the object are read one by one
+            }
+        }
+
+        // A call which gets no reply ends with a timeout error reply
+        while (pending)
+        {
+            if (!bus.process_discard())
+            {
+                bus.wait(sdbusplus::SdBusDuration(dbusTimeout));
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        error("Failed to read the BIOS attribute values, ERROR={ERR_EXCEP}",
+              "ERR_EXCEP", e.what());
+    }
+
+    info("Read {FETCHED} BIOS attribute values of {OBJECTS} objects",
+         "FETCHED", fetched, "OBJECTS", objects.size());
+}
+
 std::optional<Table> BIOSConfig::buildAndStoreStringTable()
 {
     std::set<std::string> strings;
@@ -597,33 +867,55 @@ std::optional<Table> BIOSConfig::buildAndStoreStringTable()
 
 void BIOSConfig::storeTable(const fs::path& path, const Table& table)
 {
-    BIOSTable biosTable(path.c_str());
-    biosTable.store(table);
+    /* The tables are served from the cache, the file is written behind */
+    tableCache[path] = table;
+    accountTables();
+    pldm::utils::persistFile(path, Table(table),
+                             pldm::utils::Durability::Fsync);
 }
 
-std::optional<Table> BIOSConfig::loadTable(const fs::path& path)
+void BIOSConfig::accountTables()
 {
-    BIOSTable biosTable(path.c_str());
-    if (biosTable.isEmpty())
+    static auto& account = pldm::metrics::memoryAccount("bios_tables");
+    size_t bytes = 0;
+    for (const auto& [path, table] : tableCache)
     {
-        return std::nullopt;
+        if (table)
+        {
+            bytes += table->capacity();
+        }
     }
+    account.resized(tableBytes, bytes);
+    tableBytes = bytes;
+}
 
-    Table table;
-    biosTable.load(table);
-    return table;
+const std::optional<Table>& BIOSConfig::loadTable(const fs::path& path)
+{
+    auto it = tableCache.find(path);
+    if (it != tableCache.end())
+    {
+        return it->second;
+    }
+
+    auto& cached = tableCache[path];
+    BIOSTable biosTable(path.c_str());
+    if (!biosTable.isEmpty())
+    {
+        cached.emplace();
+        biosTable.load(*cached);
+        accountTables();
+    }
+    return cached;
 }
 
 void BIOSConfig::load(const fs::path& filePath, ParseHandler handler)
 {
-    std::ifstream file;
     Json jsonConf;
     if (fs::exists(filePath))
     {
         try
         {
-            file.open(filePath);
-            jsonConf = Json::parse(file);
+            jsonConf = parseJsonConfig(filePath);
             auto entries = jsonConf.at("entries");
             for (auto& entry : entries)
             {
@@ -647,6 +939,38 @@ void BIOSConfig::load(const fs::path& filePath, ParseHandler handler)
     }
 }
 
+Json BIOSConfig::parseJsonConfig(const fs::path& filePath)
+{
+#ifdef BIOS_COMPILED_JSON
+    auto sourceSize = fs::file_size(filePath);
+    auto sourceMtime =
+        fs::last_write_time(filePath).time_since_epoch().count();
+    auto imagePath = tableDir / ((sysType.empty() ? "" : sysType + "_") +
+                                 filePath.filename().string() + ".cbor");
+    auto compiled = loadCompiledJson(imagePath, sourceSize, sourceMtime);
+    if (compiled)
+    {
+        return std::move(*compiled);
+    }
+#endif
+
+#ifdef BIOS_COMPILED_JSON
+    std::ifstream file(filePath);
+    auto jsonConf = Json::parse(file);
+    storeCompiledJson(imagePath, jsonConf, sourceSize, sourceMtime);
+    return jsonConf;
+#else
+    /* Parsed once for the attributes and the string table, the startup
+     * threads may have parsed it already */
+    const auto& jsonConf = JsonCache::get().load(filePath);
+    if (jsonConf.is_discarded())
+    {
+        throw std::invalid_argument("Failed parsing " + filePath.string());
+    }
+    return jsonConf;
+#endif
+}
+
 std::string BIOSConfig::decodeStringFromStringEntry(
     const pldm_bios_string_table_entry* stringEntry)
 {
@@ -697,8 +1021,8 @@ void BIOSConfig::traceBIOSUpdate(
     const pldm_bios_attr_val_table_entry* attrValueEntry,
     const pldm_bios_attr_table_entry* attrEntry, bool isBMC)
 {
-    auto stringTable = getBIOSTable(PLDM_BIOS_STRING_TABLE);
-    auto attrTable = getBIOSTable(PLDM_BIOS_ATTR_TABLE);
+    const auto& stringTable = getBIOSTable(PLDM_BIOS_STRING_TABLE);
+    const auto& attrTable = getBIOSTable(PLDM_BIOS_ATTR_TABLE);
 
     auto [attrHandle,
           attrType] = table::attribute_value::decodeHeader(attrValueEntry);
@@ -827,9 +1151,9 @@ int BIOSConfig::checkAttrValueToUpdate(
 int BIOSConfig::setAttrValue(const void* entry, size_t size, bool isBMC,
                              bool updateDBus, bool updateBaseBIOSTable)
 {
-    auto attrValueTable = getBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE);
-    auto attrTable = getBIOSTable(PLDM_BIOS_ATTR_TABLE);
-    auto stringTable = getBIOSTable(PLDM_BIOS_STRING_TABLE);
+    const auto& attrValueTable = getBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE);
+    const auto& attrTable = getBIOSTable(PLDM_BIOS_ATTR_TABLE);
+    const auto& stringTable = getBIOSTable(PLDM_BIOS_STRING_TABLE);
     if (!attrValueTable || !attrTable || !stringTable)
     {
         return PLDM_BIOS_TABLE_UNAVAILABLE;
@@ -853,12 +1177,20 @@ int BIOSConfig::setAttrValue(const void* entry, size_t size, bool isBMC,
         return rc;
     }
 
-    auto destTable = table::attribute_value::updateTable(*attrValueTable, entry,
-                                                         size);
-
-    if (!destTable)
+    // A value of the same length, the integers and most enumerations, is
+    // overwritten in place, the table is rebuilt for the others
+    std::optional<Table> destTable;
+    auto offset = table::attribute_value::findSameSizeEntry(*attrValueTable,
+                                                            entry, size);
+    if (!offset || baseBIOSTableMaps.empty())
     {
-        return PLDM_ERROR;
+        offset.reset();
+        destTable = table::attribute_value::updateTable(*attrValueTable, entry,
+                                                        size);
+        if (!destTable)
+        {
+            return PLDM_ERROR;
+        }
     }
 
     try
@@ -887,20 +1219,202 @@ int BIOSConfig::setAttrValue(const void* entry, size_t size, bool isBMC,
         return PLDM_ERROR;
     }
 
-    setBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE, *destTable, updateBaseBIOSTable);
+    if (offset)
+    {
+        updateAttrValueInPlace(*offset, attrValueEntry, size,
+                               updateBaseBIOSTable);
+    }
+    else if (baseBIOSTableMaps.empty())
+    {
+        setBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE, *destTable, updateBaseBIOSTable);
+    }
+    else
+    {
+        storeAttrValueTable(*destTable, {attrValueEntry}, updateBaseBIOSTable);
+    }
 
     traceBIOSUpdate(attrValueEntry, attrEntry, isBMC);
 
     return PLDM_SUCCESS;
 }
 
+int BIOSConfig::setAttrValues(const std::vector<Table>& entries, bool isBMC)
+{
+    const auto& attrValueTable = getBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE);
+    const auto& attrTable = getBIOSTable(PLDM_BIOS_ATTR_TABLE);
+    const auto& stringTable = getBIOSTable(PLDM_BIOS_STRING_TABLE);
+    if (!attrValueTable || !attrTable || !stringTable)
+    {
+        return PLDM_BIOS_TABLE_UNAVAILABLE;
+    }
+
+    std::vector<const pldm_bios_attr_table_entry*> attrEntries;
+    attrEntries.reserve(entries.size());
+    for (const auto& entry : entries)
+    {
+        auto attrValueEntry =
+            reinterpret_cast<const pldm_bios_attr_val_table_entry*>(
+                entry.data());
+        auto attrValHeader =
+            table::attribute_value::decodeHeader(attrValueEntry);
+        auto attrEntry = table::attribute::findByHandle(
+            *attrTable, attrValHeader.attrHandle);
+        if (!attrEntry)
+        {
+            return PLDM_ERROR;
+        }
+        auto rc = checkAttrValueToUpdate(attrValueEntry, attrEntry,
+                                         *stringTable);
+        if (rc != PLDM_SUCCESS)
+        {
+            return rc;
+        }
+        attrEntries.push_back(attrEntry);
+    }
+
+    Table destTable(*attrValueTable);
+    for (const auto& entry : entries)
+    {
+        auto offset = table::attribute_value::findSameSizeEntry(
+            destTable, entry.data(), entry.size());
+        if (offset)
+        {
+            table::attribute_value::updateEntryInPlace(
+                destTable, *offset, entry.data(), entry.size());
+            continue;
+        }
+        auto updatedTable = table::attribute_value::updateTable(
+            destTable, entry.data(), entry.size());
+        if (!updatedTable)
+        {
+            return PLDM_ERROR;
+        }
+        destTable = std::move(*updatedTable);
+    }
+
+    try
+    {
+        BIOSStringTable biosStringTable(*stringTable);
+        for (size_t i = 0; i < entries.size(); i++)
+        {
+            auto attrHeader = table::attribute::decodeHeader(attrEntries[i]);
+            auto attrName = biosStringTable.findString(attrHeader.stringHandle);
+            auto iter = std::find_if(biosAttributes.begin(),
+                                     biosAttributes.end(),
+                                     [&attrName](const auto& attr) {
+                return attr->name == attrName;
+            });
+            if (iter == biosAttributes.end())
+            {
+                return PLDM_ERROR;
+            }
+            (*iter)->setAttrValueOnDbus(
+                reinterpret_cast<const pldm_bios_attr_val_table_entry*>(
+                    entries[i].data()),
+                attrEntries[i], biosStringTable);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        error("Set attribute value error: {ERR_EXCEP}", "ERR_EXCEP", e.what());
+        return PLDM_ERROR;
+    }
+
+    if (baseBIOSTableMaps.empty())
+    {
+        auto rc = setBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE, destTable);
+        if (rc != PLDM_SUCCESS)
+        {
+            return rc;
+        }
+    }
+    else
+    {
+        std::vector<const pldm_bios_attr_val_table_entry*> attrValueEntries;
+        attrValueEntries.reserve(entries.size());
+        for (const auto& entry : entries)
+        {
+            attrValueEntries.push_back(
+                reinterpret_cast<const pldm_bios_attr_val_table_entry*>(
+                    entry.data()));
+        }
+        storeAttrValueTable(destTable, attrValueEntries, true);
+    }
+
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        traceBIOSUpdate(reinterpret_cast<const pldm_bios_attr_val_table_entry*>(
+                            entries[i].data()),
+                        attrEntries[i], isBMC);
+    }
+
+    return PLDM_SUCCESS;
+}
+
+void BIOSConfig::updateAttrValueInPlace(
+    size_t offset, const pldm_bios_attr_val_table_entry* entry, size_t size,
+    bool updateBaseBIOSTable)
+{
+    auto path = tableDir / attrValueTableFile;
+    auto& table = *tableCache[path];
+    table::attribute_value::updateEntryInPlace(table, offset, entry, size);
+
+    // Write back the entry and the checksum only, a table written behind
+    // is written whole once its updates are coalesced
+    if (pldm::utils::WriteBehind::get())
+    {
+        pldm::utils::persistFile(path, Table(table),
+                                 pldm::utils::Durability::Fsync);
+    }
+    else
+    {
+        BIOSTable biosTable(path.c_str());
+        biosTable.storeRange(table, offset, size);
+        biosTable.storeRange(table, table.size() - sizeof(uint32_t),
+                             sizeof(uint32_t));
+    }
+
+    const auto& attrTable = getBIOSTable(PLDM_BIOS_ATTR_TABLE);
+    const auto& stringTable = getBIOSTable(PLDM_BIOS_STRING_TABLE);
+    auto rc = decodeBaseBIOSTableEntry(entry, *attrTable, *stringTable,
+                                       baseBIOSTableMaps, &changedAttributes);
+    if (rc == PLDM_SUCCESS && updateBaseBIOSTable)
+    {
+        updateBaseBIOSTableProperty();
+    }
+}
+
+void BIOSConfig::storeAttrValueTable(
+    const Table& table,
+    const std::vector<const pldm_bios_attr_val_table_entry*>& entries,
+    bool updateBaseBIOSTable)
+{
+    storeTable(tableDir / attrValueTableFile, table);
+
+    // The entries were checked against the attribute table, only they are
+    // decoded again
+    const auto& attrTable = getBIOSTable(PLDM_BIOS_ATTR_TABLE);
+    const auto& stringTable = getBIOSTable(PLDM_BIOS_STRING_TABLE);
+    for (const auto* entry : entries)
+    {
+        decodeBaseBIOSTableEntry(entry, *attrTable, *stringTable,
+                                 baseBIOSTableMaps, &changedAttributes);
+    }
+    if (updateBaseBIOSTable)
+    {
+        updateBaseBIOSTableProperty();
+    }
+}
+
 void BIOSConfig::removeTables()
 {
     try
     {
-        fs::remove(tableDir / stringTableFile);
-        fs::remove(tableDir / attrTableFile);
-        fs::remove(tableDir / attrValueTableFile);
+        tableCache.clear();
+        accountTables();
+        pldm::utils::removePersistedFile(tableDir / stringTableFile);
+        pldm::utils::removePersistedFile(tableDir / attrTableFile);
+        pldm::utils::removePersistedFile(tableDir / attrValueTableFile);
     }
     catch (const std::exception& e)
     {
@@ -995,8 +1509,8 @@ void BIOSConfig::processBiosAttrChangeNotification(
 
 uint16_t BIOSConfig::findAttrHandle(const std::string& attrName)
 {
-    auto stringTable = getBIOSTable(PLDM_BIOS_STRING_TABLE);
-    auto attrTable = getBIOSTable(PLDM_BIOS_ATTR_TABLE);
+    const auto& stringTable = getBIOSTable(PLDM_BIOS_STRING_TABLE);
+    const auto& attrTable = getBIOSTable(PLDM_BIOS_ATTR_TABLE);
 
     BIOSStringTable biosStringTable(*stringTable);
     pldm::bios::utils::BIOSTableIter<PLDM_BIOS_ATTR_TABLE> attrTableIter(
@@ -1020,6 +1534,7 @@ void BIOSConfig::constructPendingAttribute(
     const PendingAttributes& pendingAttributes)
 {
     std::vector<uint16_t> listOfHandles{};
+    std::vector<Table> attrValueEntries{};
 
     for (auto& attribute : pendingAttributes)
     {
@@ -1069,7 +1584,21 @@ void BIOSConfig::constructPendingAttribute(
 
         (*iter)->generateAttributeEntry(attributevalue, attrValueEntry);
 
-        setAttrValue(attrValueEntry.data(), attrValueEntry.size(), true);
+        attrValueEntries.emplace_back(std::move(attrValueEntry));
+    }
+
+    if (attrValueEntries.empty())
+    {
+        return;
+    }
+
+    auto rc = setAttrValues(attrValueEntries, true);
+    if (rc != PLDM_SUCCESS)
+    {
+        error(
+            "Failed to set the pending attributes, none is applied, rc = {RC}",
+            "RC", rc);
+        return;
     }
 
     if (listOfHandles.size())
@@ -13,6 +13,7 @@
 
 #include <functional>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <optional>
 #include <set>
@@ -67,7 +68,11 @@ class BIOSConfig
     BIOSConfig(BIOSConfig&&) = delete;
     BIOSConfig& operator=(const BIOSConfig&) = delete;
     BIOSConfig& operator=(BIOSConfig&&) = delete;
-    ~BIOSConfig() = default;
+    ~BIOSConfig()
+    {
+        tableCache.clear();
+        accountTables();
+    }
 
     /** @brief Construct BIOSConfig
      *  @param[in] jsonDir - The directory where json file exists
@@ -107,9 +112,10 @@ class BIOSConfig
 
     /** @brief Get BIOS table of specified type
      *  @param[in] tableType - The table type
-     *  @return The bios table, std::nullopt if the table is unaviliable
+     *  @return The bios table, std::nullopt if the table is unaviliable. The
+     *          reference is valid until the table is stored again.
      */
-    std::optional<Table> getBIOSTable(pldm_bios_table_types tableType);
+    const std::optional<Table>& getBIOSTable(pldm_bios_table_types tableType);
 
     /** @brief set BIOS table
      *  @param[in] tableType - Indicates what table is being transferred
@@ -140,8 +146,19 @@ class BIOSConfig
 
     const fs::path jsonDir;
     const fs::path tableDir;
+
+    /** @brief The persistent tables loaded in ram, keyed by their path, so
+     *         they are only read from flash once and after each store
+     */
+    std::map<fs::path, std::optional<Table>> tableCache;
+    /** @brief Bytes of tableCache in the "bios_tables" memory account */
+    size_t tableBytes = 0;
     pldm::utils::DBusHandler* const dbusHandler;
     BaseBIOSTable baseBIOSTableMaps;
+    /** @brief Attributes of baseBIOSTableMaps added, changed or removed
+     *         since the last BaseBIOSTable property update
+     */
+    std::set<AttributeName> changedAttributes;
 
     /** @brief socket descriptor to communicate to host */
     int fd;
@@ -251,6 +268,13 @@ class BIOSConfig
      */
     void load(const fs::path& filePath, ParseHandler handler);
 
+    /** @brief Parse a json config file, from its compiled CBOR image in
+     *         tableDir when it is up to date, the image is written otherwise
+     *  @param[in] filePath - Path of json file
+     *  @return The parsed config
+     */
+    Json parseJsonConfig(const fs::path& filePath);
+
     /** @brief Build String Table and persist it
      *  @return The built string table, std::nullopt if it fails.
      */
@@ -264,17 +288,33 @@ class BIOSConfig
      */
     void buildAndStoreAttrTables(const Table& stringTable);
 
+    /** @brief Read the D-Bus properties of the attributes whose value is not
+     *         in the BaseBIOSTable, with one GetAll per object path and
+     *         interface, all of them in flight at once
+     *
+     *  @details An attribute whose property was not read falls back to its
+     *  own Get when its entry is constructed.
+     *
+     *  @param[in] biosTable - The BaseBIOSTable read from D-Bus
+     */
+    void prefetchAttrValues(const BaseBIOSTable& biosTable);
+
     /** @brief Persist the table
      *  @param[in] path - Path to persist the table
      *  @param[in] table - The table
      */
     void storeTable(const fs::path& path, const Table& table);
 
-    /** @brief Load bios table to ram
+    /** @brief Update the "bios_tables" memory account after tableCache
+     *         changed
+     */
+    void accountTables();
+
+    /** @brief Load bios table to ram, the cached copy if already loaded
      *  @param[in] path - Path of the table
      *  @return The table, std::nullopt if loading fails
      */
-    std::optional<Table> loadTable(const fs::path& path);
+    const std::optional<Table>& loadTable(const fs::path& path);
 
     /** @brief Method to decode the attribute name from the string handle
      *
@@ -330,7 +370,48 @@ class BIOSConfig
      */
     int checkAttributeValueTable(const Table& table);
 
-    /** @brief Update the BaseBIOSTable property of the D-Bus interface
+    /** @brief Decode an attribute value entry into a BaseBIOSTable
+     *  @param[in] tableEntry - The attribute value entry
+     *  @param[in] attrTable - The attribute table
+     *  @param[in] stringTable - The string table
+     *  @param[in,out] baseBIOSTable - The entry is added or replaced there
+     *  @param[in,out] changes - The attribute name is added there when the
+     *                           entry is new or differs, may be nullptr
+     *  @return pldm_completion_codes
+     */
+    int decodeBaseBIOSTableEntry(
+        const pldm_bios_attr_val_table_entry* tableEntry,
+        const Table& attrTable, const Table& stringTable,
+        BaseBIOSTable& baseBIOSTable,
+        std::set<AttributeName>* changes = nullptr);
+
+    /** @brief Overwrite an entry of the cached attribute value table and
+     *         write back only the changed bytes
+     *  @param[in] offset - Offset of the entry of the same size in the table
+     *  @param[in] entry - The new attribute value entry
+     *  @param[in] size - Size of the entry
+     *  @param[in] updateBaseBIOSTable - update BaseBIOSTable D-Bus property
+     *                                   if this is set to true
+     */
+    void updateAttrValueInPlace(size_t offset,
+                                const pldm_bios_attr_val_table_entry* entry,
+                                size_t size, bool updateBaseBIOSTable);
+
+    /** @brief Store a rebuilt attribute value table and decode only the
+     *         entries which were set into the BaseBIOSTable
+     *  @param[in] table - The attribute value table
+     *  @param[in] entries - The attribute value entries set in the table,
+     *                       already checked
+     *  @param[in] updateBaseBIOSTable - update BaseBIOSTable D-Bus property
+     *                                   if this is set to true
+     */
+    void storeAttrValueTable(
+        const Table& table,
+        const std::vector<const pldm_bios_attr_val_table_entry*>& entries,
+        bool updateBaseBIOSTable);
+
+    /** @brief Update the BaseBIOSTable property of the D-Bus interface,
+     *         unless no attribute changed since the last update
      */
     void updateBaseBIOSTableProperty();
 
@@ -350,6 +431,18 @@ class BIOSConfig
      *  @param[in] msg - Data associated with subscribed signal
      */
     void constructPendingAttribute(const PendingAttributes& pendingAttributes);
+
+    /** @brief Set a batch of attribute values, all of them or none
+     *
+     *  @details The whole batch is validated first, then applied to one copy
+     *  of the attribute value table which is persisted once, with a single
+     *  BaseBIOSTable property update.
+     *
+     *  @param[in] entries - attribute value entries
+     *  @param[in] isBMC - indicates if the attributes are set by BMC
+     *  @return pldm_completion_codes
+     */
+    int setAttrValues(const std::vector<Table>& entries, bool isBMC);
 };
 
 } // namespace bios
@@ -35,6 +35,14 @@ BIOSEnumAttribute::BIOSEnumAttribute(const Json& entry,
     }
     assert(defaultValues.size() == 1);
     defaultValue = defaultValues[0];
+    if (possibleValues.size() > flatIndexLimit)
+    {
+        valueIndexes.reserve(possibleValues.size());
+        for (size_t i = 0; i < possibleValues.size(); ++i)
+        {
+            valueIndexes.try_emplace(possibleValues[i], i);
+        }
+    }
     if (dBusMap.has_value())
     {
         auto dbusValues = entry.at("dbus").at("property_values");
@@ -42,16 +50,25 @@ BIOSEnumAttribute::BIOSEnumAttribute(const Json& entry,
     }
 }
 
-uint8_t BIOSEnumAttribute::getValueIndex(const std::string& value,
-                                         const std::vector<std::string>& pVs)
+uint8_t BIOSEnumAttribute::getValueIndex(const std::string& value) const
 {
-    auto iter = std::find_if(pVs.begin(), pVs.end(),
-                             [&value](const auto& v) { return v == value; });
-    if (iter == pVs.end())
+    if (!valueIndexes.empty())
+    {
+        auto index = valueIndexes.find(value);
+        if (index == valueIndexes.end())
+        {
+            throw std::invalid_argument("value must be one of possible value");
+        }
+        return index->second;
+    }
+
+    auto iter = std::find(possibleValues.begin(), possibleValues.end(),
+                          value);
+    if (iter == possibleValues.end())
     {
         throw std::invalid_argument("value must be one of possible value");
     }
-    return iter - pVs.begin();
+    return iter - possibleValues.begin();
 }
 
 std::vector<uint16_t> BIOSEnumAttribute::getPossibleValuesHandle(
@@ -121,11 +138,16 @@ void BIOSEnumAttribute::buildValMap(const Json& dbusVals)
         }
         valMap.emplace(value, possibleValues[pos]);
     }
+
+    for (const auto& [dbusValue, pldmValue] : valMap)
+    {
+        dbusValues.try_emplace(pldmValue, dbusValue);
+    }
 }
 
 uint8_t BIOSEnumAttribute::getAttrValueIndex()
 {
-    auto defaultValueIndex = getValueIndex(defaultValue, possibleValues);
+    auto defaultValueIndex = getValueIndex(defaultValue);
     if (!dBusMap.has_value())
     {
         return defaultValueIndex;
@@ -133,16 +155,14 @@ uint8_t BIOSEnumAttribute::getAttrValueIndex()
 
     try
     {
-        auto propValue = dbusHandler->getDbusPropertyVariant(
-            dBusMap->objectPath.c_str(), dBusMap->propertyName.c_str(),
-            dBusMap->interface.c_str());
+        auto propValue = readDbusValue();
         auto iter = valMap.find(propValue);
         if (iter == valMap.end())
         {
             return defaultValueIndex;
         }
         auto currentValue = iter->second;
-        return getValueIndex(currentValue, possibleValues);
+        return getValueIndex(currentValue);
     }
     catch (const std::exception& e)
     {
@@ -154,11 +174,11 @@ uint8_t BIOSEnumAttribute::getAttrValueIndex(const PropertyValue& propValue)
 {
     try
     {
-        return getValueIndex(std::get<std::string>(propValue), possibleValues);
+        return getValueIndex(std::get<std::string>(propValue));
     }
     catch (const std::exception& e)
     {
-        return getValueIndex(defaultValue, possibleValues);
+        return getValueIndex(defaultValue);
     }
 }
 
@@ -177,16 +197,13 @@ void BIOSEnumAttribute::setAttrValueOnDbus(
     assert(currHdls.size() == 1);
     auto valueString = stringTable.findString(pvHdls[currHdls[0]]);
 
-    auto it = std::find_if(valMap.begin(), valMap.end(),
-                           [&valueString](const auto& typePair) {
-        return typePair.second == valueString;
-    });
-    if (it == valMap.end())
+    auto it = dbusValues.find(valueString);
+    if (it == dbusValues.end())
     {
         return;
     }
 
-    dbusHandler->setDbusProperty(*dBusMap, it->first);
+    dbusHandler->setDbusProperty(*dBusMap, it->second);
 }
 
 void BIOSEnumAttribute::constructEntry(
@@ -196,7 +213,7 @@ void BIOSEnumAttribute::constructEntry(
     auto possibleValuesHandle = getPossibleValuesHandle(stringTable,
                                                         possibleValues);
     std::vector<uint8_t> defaultIndices(1, 0);
-    defaultIndices[0] = getValueIndex(defaultValue, possibleValues);
+    defaultIndices[0] = getValueIndex(defaultValue);
 
     pldm_bios_table_attr_entry_enum_info info = {
         stringTable.findHandle(name),         readOnly,
@@ -217,7 +234,7 @@ void BIOSEnumAttribute::constructEntry(
         if (attributeValue.index() == 1)
         {
             auto currValue = std::get<std::string>(attributeValue);
-            currValueIndices[0] = getValueIndex(currValue, possibleValues);
+            currValueIndices[0] = getValueIndex(currValue);
         }
         else
         {
@@ -246,7 +263,7 @@ int BIOSEnumAttribute::updateAttrVal(Table& newValue, uint16_t attrHdl,
     }
     auto currentValue = iter->second;
     std::vector<uint8_t> handleIndices{
-        getValueIndex(currentValue, possibleValues)};
+        getValueIndex(currentValue)};
     table::attribute_value::constructEnumEntry(newValue, attrHdl, attrType,
                                                handleIndices);
     return PLDM_SUCCESS;
@@ -5,6 +5,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <variant>
 
 class TestBIOSEnumAttribute;
@@ -71,13 +72,21 @@ class BIOSEnumAttribute : public BIOSAttribute
     std::vector<std::string> possibleValues;
     std::string defaultValue;
 
+    /** @brief Enums with at most this many possible values are searched in
+     *         place, larger ones through valueIndexes
+     */
+    static constexpr size_t flatIndexLimit = 8;
+
+    /** @brief Index of each possible value, for the enums with more than
+     *         flatIndexLimit possible values
+     */
+    std::unordered_map<std::string, uint8_t> valueIndexes;
+
     /** @brief Get index of the given value in possible values
      *  @param[in] value - The given value
-     *  @param[in] pVs - The possible values
      *  @return Index of the given value in possible values
      */
-    uint8_t getValueIndex(const std::string& value,
-                          const std::vector<std::string>& pVs);
+    uint8_t getValueIndex(const std::string& value) const;
 
     /** @brief Get handles of possible values
      *  @param[in] stringTable - The bios string table
@@ -93,6 +102,11 @@ class BIOSEnumAttribute : public BIOSAttribute
     /** @brief Map of value on dbus and pldm */
     ValMap valMap;
 
+    /** @brief Value on dbus of each pldm enum value, the first one of valMap
+     *         if several map to it
+     */
+    std::unordered_map<std::string, pldm::utils::PropertyValue> dbusValues;
+
     /** @brief Build the map of dbus value to pldm enum value
      *  @param[in] dbusVals - The dbus values in the json's dbus section
      */
@@ -193,9 +193,7 @@ uint64_t BIOSIntegerAttribute::getAttrValue()
 
     try
     {
-        auto propertyValue = dbusHandler->getDbusPropertyVariant(
-            dBusMap->objectPath.c_str(), dBusMap->propertyName.c_str(),
-            dBusMap->interface.c_str());
+        auto propertyValue = readDbusValue();
 
         return getAttrValue(propertyValue);
     }
@@ -83,9 +83,7 @@ std::string BIOSStringAttribute::getAttrValue()
     }
     try
     {
-        return dbusHandler->getDbusProperty<std::string>(
-            dBusMap->objectPath.c_str(), dBusMap->propertyName.c_str(),
-            dBusMap->interface.c_str());
+        return std::get<std::string>(readDbusValue());
     }
     catch (const std::exception& e)
     {
@@ -1,11 +1,15 @@
 #include "bios_table.hpp"
 
+#include "common/bios_utils.hpp"
+#include "common/utils.hpp"
+
 #include <libpldm/base.h>
 #include <libpldm/bios_table.h>
-#include <libpldm/utils.h>
+#include <endian.h>
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <cstring>
 #include <fstream>
 
 namespace pldm
@@ -36,6 +40,21 @@ void BIOSTable::store(const Table& table)
     stream.write(reinterpret_cast<const char*>(table.data()), table.size());
 }
 
+void BIOSTable::storeRange(const Table& table, size_t offset, size_t length)
+{
+    std::error_code ec;
+    if (fs::file_size(filePath, ec) != table.size() || ec ||
+        offset + length > table.size())
+    {
+        store(table);
+        return;
+    }
+    std::fstream stream(filePath.string(),
+                        std::ios::in | std::ios::out | std::ios::binary);
+    stream.seekp(offset);
+    stream.write(reinterpret_cast<const char*>(table.data() + offset), length);
+}
+
 void BIOSTable::load(Response& response) const
 {
     auto currSize = response.size();
@@ -54,27 +73,66 @@ BIOSStringTable::BIOSStringTable(const BIOSTable& biosTable)
     biosTable.load(stringTable);
 }
 
+BIOSStringTable::BIOSStringTable(const BIOSStringTable& other) :
+    stringTable(other.stringTable)
+{}
+
+BIOSStringTable& BIOSStringTable::operator=(const BIOSStringTable& other)
+{
+    if (this != &other)
+    {
+        stringTable = other.stringTable;
+        indexed = false;
+        handleByName.clear();
+        offsetByHandle.clear();
+    }
+    return *this;
+}
+
+void BIOSStringTable::buildIndex() const
+{
+    if (indexed)
+    {
+        return;
+    }
+    for (auto entry : pldm::bios::utils::BIOSTableIter<PLDM_BIOS_STRING_TABLE>(
+             stringTable.data(), stringTable.size()))
+    {
+        auto handle = table::string::decodeHandle(entry);
+        std::string_view name(
+            entry->name,
+            pldm_bios_table_string_entry_decode_string_length(entry));
+        // The first entry wins, as with the scan of libpldm
+        handleByName.emplace(name, handle);
+        offsetByHandle.emplace(handle, reinterpret_cast<const uint8_t*>(entry) -
+                                           stringTable.data());
+    }
+    indexed = true;
+}
+
 std::string BIOSStringTable::findString(uint16_t handle) const
 {
-    auto stringEntry = pldm_bios_table_string_find_by_handle(
-        stringTable.data(), stringTable.size(), handle);
-    if (stringEntry == nullptr)
+    buildIndex();
+    auto it = offsetByHandle.find(handle);
+    if (it == offsetByHandle.end())
     {
         throw std::invalid_argument("Invalid String Handle");
     }
-    return table::string::decodeString(stringEntry);
+    return table::string::decodeString(
+        reinterpret_cast<const pldm_bios_string_table_entry*>(
+            stringTable.data() + it->second));
 }
 
 uint16_t BIOSStringTable::findHandle(const std::string& name) const
 {
-    auto stringEntry = pldm_bios_table_string_find_by_string(
-        stringTable.data(), stringTable.size(), name.c_str());
-    if (stringEntry == nullptr)
+    buildIndex();
+    auto it = handleByName.find(name);
+    if (it == handleByName.end())
     {
         throw std::invalid_argument("Invalid String Name");
     }
 
-    return table::string::decodeHandle(stringEntry);
+    return it->second;
 }
 
 namespace table
@@ -83,9 +141,12 @@ void appendPadAndChecksum(Table& table)
 {
     size_t payloadSize = table.size();
     table.resize(payloadSize + pldm_bios_table_pad_checksum_size(payloadSize));
-    // No validation of return value as preconditions are satisfied
-    pldm_bios_table_append_pad_checksum_check(table.data(), table.size(),
-                                              &payloadSize);
+
+    // The pad is zeroed by the resize, the checksum covers it
+    auto checksumOffset = table.size() - sizeof(uint32_t);
+    uint32_t checksum = htole32(pldm::utils::Crc32::of(
+        std::span<const uint8_t>(table.data(), checksumOffset)));
+    std::memcpy(table.data() + checksumOffset, &checksum, sizeof(checksum));
 }
 
 namespace string
@@ -391,6 +452,36 @@ std::optional<Table> updateTable(const Table& table, const void* entry,
     return destTable;
 }
 
+std::optional<size_t> findSameSizeEntry(const Table& table, const void* entry,
+                                        size_t size)
+{
+    auto newEntry = reinterpret_cast<const pldm_bios_attr_val_table_entry*>(
+        entry);
+    auto [handle, type] = decodeHeader(newEntry);
+    auto oldEntry = pldm_bios_table_attr_value_find_by_handle(
+        table.data(), table.size(), handle);
+    if (oldEntry == nullptr ||
+        pldm_bios_table_attr_value_entry_decode_attribute_type(oldEntry) !=
+            type ||
+        pldm_bios_table_attr_value_entry_length(oldEntry) != size)
+    {
+        return std::nullopt;
+    }
+    return reinterpret_cast<const uint8_t*>(oldEntry) - table.data();
+}
+
+void updateEntryInPlace(Table& table, size_t offset, const void* entry,
+                        size_t size)
+{
+    std::memcpy(table.data() + offset, entry, size);
+
+    // The checksum covers the entries and the pad before it
+    auto checksumOffset = table.size() - sizeof(uint32_t);
+    uint32_t checksum = htole32(pldm::utils::Crc32::of(
+        std::span<const uint8_t>(table.data(), checksumOffset)));
+    std::memcpy(table.data() + checksumOffset, &checksum, sizeof(checksum));
+}
+
 } // namespace attribute_value
 
 } // namespace table
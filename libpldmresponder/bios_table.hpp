@@ -7,6 +7,8 @@
 #include <filesystem>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace pldm
@@ -61,6 +63,15 @@ class BIOSTable
      */
     void store(const Table& table);
 
+    /** @brief Write back a range of the table over the persistent store,
+     *         the whole table if the file size does not match
+     *
+     *  @param[in] table - BIOS table
+     *  @param[in] offset - start of the range
+     *  @param[in] length - length of the range
+     */
+    void storeRange(const Table& table, size_t offset, size_t length);
+
     /** @brief Load BIOS table from persistent store to memory
      *
      *  @param[in,out] response - PLDM response message to GetBIOSTable
@@ -114,6 +125,10 @@ class BIOSStringTable : public BIOSStringTableInterface
      */
     BIOSStringTable(const BIOSTable& biosTable);
 
+    /** @brief The index points into the own table, a copy builds its own */
+    BIOSStringTable(const BIOSStringTable& other);
+    BIOSStringTable& operator=(const BIOSStringTable& other);
+
     /** @brief Find the string name from the BIOS string table for a string
      * handle
      *  @param[in] handle - string handle
@@ -131,7 +146,19 @@ class BIOSStringTable : public BIOSStringTableInterface
     uint16_t findHandle(const std::string& name) const override;
 
   private:
+    /** @brief Build the index on the first lookup */
+    void buildIndex() const;
+
     Table stringTable;
+
+    /** @brief Lazily built index of the table, the lookups of libpldm scan
+     *         the whole table
+     */
+    mutable bool indexed = false;
+    mutable std::unordered_map<std::string_view, uint16_t>
+        handleByName;  //!< string -> handle
+    mutable std::unordered_map<uint16_t, size_t>
+        offsetByHandle; //!< handle -> entry offset in the table
 };
 
 namespace table
@@ -369,6 +396,26 @@ const pldm_bios_attr_val_table_entry*
 std::optional<Table> updateTable(const Table& table, const void* entry,
                                  size_t size);
 
+/** @brief Find the entry which a new entry of the same size can overwrite
+ *  @param[in] table - the attribute value table
+ *  @param[in] entry - the new attribute value entry
+ *  @param[in] size - size of the new entry
+ *  @return offset of the entry with the same handle, type and size,
+ *          std::nullopt if the table has to be rebuilt
+ */
+std::optional<size_t> findSameSizeEntry(const Table& table, const void* entry,
+                                        size_t size);
+
+/** @brief Overwrite an entry found by findSameSizeEntry and update the
+ *         checksum of the table
+ *  @param[in,out] table - the attribute value table
+ *  @param[in] offset - offset of the entry
+ *  @param[in] entry - the new attribute value entry
+ *  @param[in] size - size of the new entry
+ */
+void updateEntryInPlace(Table& table, size_t offset, const void* entry,
+                        size_t size);
+
 } // namespace attribute_value
 
 } // namespace table
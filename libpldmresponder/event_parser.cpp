@@ -4,7 +4,6 @@
 #include <xyz/openbmc_project/Common/error.hpp>
 
 #include <filesystem>
-#include <fstream>
 #include <iostream>
 #include <set>
 
@@ -35,9 +34,7 @@ StateSensorHandler::StateSensorHandler(const std::string& dirPath)
 
     for (auto& file : fs::directory_iterator(dirPath))
     {
-        std::ifstream jsonFile(file.path());
-
-        auto data = Json::parse(jsonFile, nullptr, false);
+        const auto& data = pldm::utils::JsonCache::get().load(file.path());
         if (data.is_discarded())
         {
             error(
@@ -94,7 +91,7 @@ StateSensorHandler::StateSensorHandler(const std::string& dirPath)
             auto eventStateMap = mapStateToDBusVal(eventStates, propertyValues,
                                                    dbusInfo.propertyType);
             eventMap.emplace(
-                stateSensorEntry,
+                stateSensorEntry.key(),
                 std::make_tuple(std::move(dbusInfo), std::move(eventStateMap)));
         }
     }
@@ -119,39 +116,34 @@ StateToDBusValue StateSensorHandler::mapStateToDBusVal(
 int StateSensorHandler::eventAction(const StateSensorEntry& entry,
                                     pdr::EventState state)
 {
-    try
+    auto it = eventMap.find(entry.key());
+    if (it == eventMap.end())
     {
-        const auto& [dbusMapping, eventStateMap] = eventMap.at(entry);
-        utils::PropertyValue propValue{};
-        try
-        {
-            propValue = eventStateMap.at(state);
-        }
-        catch (const std::out_of_range& e)
-        {
-            error("Invalid event state {EVENT_STATE}", "EVENT_STATE",
-                  static_cast<unsigned>(state));
-            return PLDM_ERROR_INVALID_DATA;
-        }
+        // There is no BMC action for this PLDM event
+        return PLDM_SUCCESS;
+    }
 
-        try
-        {
-            pldm::utils::DBusHandler().setDbusProperty(dbusMapping, propValue);
-        }
-        catch (const std::exception& e)
-        {
-            error(
-                "Error setting property, ERROR={ERR_EXCEP} PROPERTY={DBUS_PROP} INTERFACE={DBUS_INTF} PATH = {DBUS_OBJ_PATH}",
-                "ERR_EXCEP", e.what(), "DBUS_PROP", dbusMapping.propertyName,
-                "DBUS_INTF", dbusMapping.interface, "DBUS_OBJ_PATH",
-                dbusMapping.objectPath.c_str());
-            return PLDM_ERROR;
-        }
+    const auto& [dbusMapping, eventStateMap] = it->second;
+    auto propValue = eventStateMap.find(state);
+    if (propValue == nullptr)
+    {
+        error("Invalid event state {EVENT_STATE}", "EVENT_STATE",
+              static_cast<unsigned>(state));
+        return PLDM_ERROR_INVALID_DATA;
+    }
+
+    try
+    {
+        pldm::utils::DBusHandler().setDbusProperty(dbusMapping, *propValue);
     }
-    catch (const std::out_of_range& e)
+    catch (const std::exception& e)
     {
-        // There is no BMC action for this PLDM event
-        return PLDM_SUCCESS;
+        error(
+            "Error setting property, ERROR={ERR_EXCEP} PROPERTY={DBUS_PROP} INTERFACE={DBUS_INTF} PATH = {DBUS_OBJ_PATH}",
+            "ERR_EXCEP", e.what(), "DBUS_PROP", dbusMapping.propertyName,
+            "DBUS_INTF", dbusMapping.interface, "DBUS_OBJ_PATH",
+            dbusMapping.objectPath.c_str());
+        return PLDM_ERROR;
     }
     return PLDM_SUCCESS;
 }
@@ -6,9 +6,11 @@
 #include <nlohmann/json.hpp>
 
 #include <filesystem>
-#include <map>
+#include <optional>
+#include <stdexcept>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 namespace pldm::responder::events
@@ -18,8 +20,8 @@ namespace pldm::responder::events
  *
  *  StateSensorEntry is a key to uniquely identify a state sensor, so that a
  *  D-Bus action can be defined for PlatformEventMessage command with
- *  sensorEvent type. This struct is used as a key in a std::map so implemented
- *  operator== and operator<.
+ *  sensorEvent type. The fields are packed in a 64-bit key to look up the
+ *  entry in a hash table.
  */
 struct StateSensorEntry
 {
@@ -38,20 +40,75 @@ struct StateSensorEntry
 
     bool operator<(const StateSensorEntry& e) const
     {
-        return (
-            (containerId < e.containerId) ||
-            ((containerId == e.containerId) && (entityType < e.entityType)) ||
-            ((containerId == e.containerId) && (entityType == e.entityType) &&
-             (entityInstance < e.entityInstance)) ||
-            ((containerId == e.containerId) && (entityType == e.entityType) &&
-             (entityInstance == e.entityInstance) &&
-             (sensorOffset < e.sensorOffset)));
+        return key() < e.key();
     }
+
+    /** @brief Packed lookup key of the entry */
+    uint64_t key() const
+    {
+        return (static_cast<uint64_t>(containerId) << 48) |
+               (static_cast<uint64_t>(entityType) << 32) |
+               (static_cast<uint64_t>(entityInstance) << 16) | sensorOffset;
+    }
+};
+
+/** @class StateToDBusValue
+ *
+ *  D-Bus property values of the event states of a sensor, in an array
+ *  indexed by the event state.
+ */
+class StateToDBusValue
+{
+  public:
+    /** @brief Set the property value of an event state, the first value of
+     *         a state is kept
+     */
+    void emplace(pdr::EventState state, pldm::utils::PropertyValue&& value)
+    {
+        if (state >= values.size())
+        {
+            values.resize(state + 1);
+        }
+        if (!values[state])
+        {
+            values[state] = std::move(value);
+        }
+    }
+
+    /** @brief Find the property value of an event state
+     *
+     *  @return the value, nullptr when the state has no value
+     */
+    const pldm::utils::PropertyValue* find(pdr::EventState state) const
+    {
+        if (state >= values.size() || !values[state])
+        {
+            return nullptr;
+        }
+        return &*values[state];
+    }
+
+    /** @brief Get the property value of an event state
+     *
+     *  @throw std::out_of_range when the state has no value
+     */
+    const pldm::utils::PropertyValue& at(pdr::EventState state) const
+    {
+        auto value = find(state);
+        if (value == nullptr)
+        {
+            throw std::out_of_range("Invalid event state");
+        }
+        return *value;
+    }
+
+  private:
+    std::vector<std::optional<pldm::utils::PropertyValue>> values;
 };
 
-using StateToDBusValue = std::map<pdr::EventState, pldm::utils::PropertyValue>;
 using EventDBusInfo = std::tuple<pldm::utils::DBusMapping, StateToDBusValue>;
-using EventMap = std::map<StateSensorEntry, EventDBusInfo>;
+/** @brief D-Bus information of the state sensors by StateSensorEntry::key */
+using EventMap = std::unordered_map<uint64_t, EventDBusInfo>;
 using Json = nlohmann::json;
 
 /** @class StateSensorHandler
@@ -97,7 +154,7 @@ class StateSensorHandler
      */
     const EventDBusInfo& getEventInfo(const StateSensorEntry& entry) const
     {
-        return eventMap.at(entry);
+        return eventMap.at(entry.key());
     }
 
   private:
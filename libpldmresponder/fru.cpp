@@ -1,9 +1,10 @@
 #include "fru.hpp"
 
+#include "common/pdr_index.hpp"
+#include "common/transfer_size.hpp"
 #include "common/utils.hpp"
 
 #include <libpldm/entity.h>
-#include <libpldm/utils.h>
 #include <systemd/sd-journal.h>
 
 #include <phosphor-logging/lg2.hpp>
@@ -22,6 +23,7 @@ namespace responder
 {
 
 constexpr auto root = "/xyz/openbmc_project/inventory/";
+constexpr auto itemInterface = "xyz.openbmc_project.Inventory.Item";
 
 std::optional<pldm_entity>
     FruImpl::getEntityByObjectPath(const dbus::InterfaceMap& intfMaps)
@@ -145,7 +147,6 @@ void FruImpl::buildFRUTable()
         return;
     }
 
-    fru_parser::DBusLookupInfo dbusInfo;
     // Read the all the inventory D-Bus objects
     auto& bus = pldm::utils::DBusHandler::getBus();
     dbus::ObjectValueTree objects;
@@ -166,52 +167,62 @@ void FruImpl::buildFRUTable()
         return;
     }
 
-    auto itemIntfsLookup = std::get<2>(dbusInfo);
+    buildFromObjects(std::move(objects));
+}
 
-    for (const auto& object : objects)
+void FruImpl::buildFRUTableAsync()
+{
+    if (isBuilt || buildCall)
     {
-        const auto& interfaces = object.second;
-        bool isPresent = pldm::utils::checkForFruPresence(object.first.str);
-        // Do not create fru record if fru is not present.
-        // Pick up the next available fru.
-        if (!isPresent)
-        {
-            continue;
-        }
-        for (const auto& interface : interfaces)
-        {
-            if (itemIntfsLookup.find(interface.first) != itemIntfsLookup.end())
-            {
-                // An exception will be thrown by getRecordInfo, if the item
-                // D-Bus interface name specified in FRU_Master.json does
-                // not have corresponding config jsons
-                try
-                {
-                    updateAssociationTree(objects, object.first.str);
-                    pldm_entity entity{};
-                    if (objToEntityNode.contains(object.first.str))
-                    {
-                        pldm_entity_node* node =
-                            objToEntityNode.at(object.first.str);
-
-                        entity = pldm_entity_extract(node);
-                    }
-
-                    auto recordInfos = parser.getRecordInfo(interface.first);
-                    populateRecords(interfaces, recordInfos, entity);
+        return;
+    }
 
-                    associatedEntityMap.emplace(object.first, entity);
-                    break;
-                }
-                catch (const std::exception& e)
+    auto& bus = pldm::utils::DBusHandler::getBus();
+    try
+    {
+        dbusInfo = parser.inventoryLookup();
+        auto method = bus.new_method_call(
+            std::get<0>(dbusInfo).c_str(), std::get<1>(dbusInfo).c_str(),
+            "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
+        buildCall = bus.call_async(method, [this](auto&& reply) {
+            // A FRU or Get PDR command may have built it in the meantime
+            if (isBuilt)
+            {
+                return;
+            }
+            dbus::ObjectValueTree objects;
+            try
+            {
+                if (reply.is_method_error())
                 {
-                    error(
-                        "Config JSONs missing for the item interface type, interface = {INTF}",
-                        "INTF", interface.first);
-                    break;
+                    throw std::runtime_error(reply.get_error()->name);
                 }
+                reply.read(objects);
             }
-        }
+            catch (const std::exception& e)
+            {
+                error(
+                    "Look up of inventory objects failed, FRU table is built on the first request, ERROR={ERR_EXCEP}",
+                    "ERR_EXCEP", e.what());
+                return;
+            }
+            buildFromObjects(std::move(objects));
+        });
+    }
+    catch (const std::exception& e)
+    {
+        error("Failed to request the inventory objects, ERROR={ERR_EXCEP}",
+              "ERR_EXCEP", e.what());
+    }
+}
+
+void FruImpl::buildFromObjects(dbus::ObjectValueTree&& objects)
+{
+    inventory = std::move(objects);
+
+    for (const auto& object : inventory)
+    {
+        updateRecordSet(object.first);
     }
 
     int rc = pldm_entity_association_pdr_add_check(entityTree, pdrRepo, false,
@@ -223,20 +234,235 @@ void FruImpl::buildFRUTable()
               "LIBPLDM_ERROR", rc);
         throw std::runtime_error("Failed to add PLDM entity association PDR");
     }
+    pldm::utils::notifyPdrRepoChanged();
 
     // save a copy of bmc's entity association tree
     pldm_entity_association_tree_copy_root(entityTree, bmcEntityTree);
 
+    assembleTable();
+    isBuilt = true;
+
+    watchInventory();
+}
+
+void FruImpl::updateRecordSet(const sdbusplus::message::object_path& path)
+{
+    auto object = inventory.find(path);
+    bool isPresent = false;
+    if (object != inventory.end())
+    {
+        // The Item interface comes with the managed objects, no need to ask
+        // the inventory for each FRU
+        auto item = object->second.find(itemInterface);
+        if (item != object->second.end())
+        {
+            auto present = item->second.find("Present");
+            isPresent = present != item->second.end() &&
+                        std::holds_alternative<bool>(present->second) &&
+                        std::get<bool>(present->second);
+        }
+    }
+
+    // Do not create fru record if fru is not present, the record set keeps
+    // its identifier in case the FRU comes back
+    if (!isPresent)
+    {
+        auto recordSet = recordSets.find(path.str);
+        if (recordSet != recordSets.end())
+        {
+            recordSet->second.records.clear();
+            recordSet->second.numRecords = 0;
+        }
+        return;
+    }
+
+    const auto& itemIntfsLookup = std::get<2>(dbusInfo);
+    const auto& interfaces = object->second;
+    for (const auto& interface : interfaces)
+    {
+        if (itemIntfsLookup.find(interface.first) != itemIntfsLookup.end())
+        {
+            // An exception will be thrown by getRecordInfo, if the item
+            // D-Bus interface name specified in FRU_Master.json does
+            // not have corresponding config jsons
+            try
+            {
+                updateAssociationTree(inventory, path.str);
+                pldm_entity entity{};
+                if (objToEntityNode.contains(path.str))
+                {
+                    pldm_entity_node* node = objToEntityNode.at(path.str);
+
+                    entity = pldm_entity_extract(node);
+                }
+
+                auto recordInfos = parser.getRecordInfo(interface.first);
+                populateRecords(interfaces, recordInfos, entity,
+                                recordSets[path.str]);
+
+                associatedEntityMap.emplace(path.str, entity);
+                break;
+            }
+            catch (const std::exception& e)
+            {
+                error(
+                    "Config JSONs missing for the item interface type, interface = {INTF}",
+                    "INTF", interface.first);
+                break;
+            }
+        }
+    }
+}
+
+void FruImpl::assembleTable()
+{
+    table.clear();
+    recordIndex.clear();
+    numRecs = 0;
+    padBytes = 0;
+    checksum = 0;
+
+    for (const auto& [path, recordSet] : recordSets)
+    {
+        auto base = table.size();
+        const auto& offsets = recordSet.recordOffsets;
+        for (size_t i = 0; i < offsets.size(); i++)
+        {
+            auto end = i + 1 < offsets.size() ? offsets[i + 1].second
+                                              : recordSet.records.size();
+            recordIndex[{recordSet.rsi, offsets[i].first}].emplace_back(
+                base + offsets[i].second, end - offsets[i].second);
+        }
+        table.insert(table.end(), recordSet.records.begin(),
+                     recordSet.records.end());
+        numRecs += recordSet.numRecords;
+    }
+
     if (table.size())
     {
         padBytes = pldm::utils::getNumPadBytes(table.size());
         table.resize(table.size() + padBytes, 0);
 
         // Calculate the checksum
-        checksum = crc32(table.data(), table.size());
+        checksum = pldm::utils::Crc32::of(table);
     }
-    isBuilt = true;
 }
+
+void FruImpl::watchInventory()
+{
+    namespace rules = sdbusplus::bus::match::rules;
+    auto& bus = pldm::utils::DBusHandler::getBus();
+    const auto& objectManager = std::get<1>(dbusInfo);
+    std::string inventoryRoot(root);
+    inventoryRoot.pop_back();
+
+    try
+    {
+        inventoryMatches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            bus, rules::interfacesAdded(objectManager),
+            [this](auto& msg) { interfacesAdded(msg); }));
+        inventoryMatches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            bus, rules::interfacesRemoved(objectManager),
+            [this](auto& msg) { interfacesRemoved(msg); }));
+        inventoryMatches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+            bus,
+            rules::type::signal() + rules::member("PropertiesChanged") +
+                rules::interface(pldm::utils::dbusProperties) +
+                rules::path_namespace(inventoryRoot),
+            [this](auto& msg) { propertiesChanged(msg); }));
+    }
+    catch (const std::exception& e)
+    {
+        error("Failed to watch the inventory, FRU table is not updated, "
+              "ERROR={ERR_EXCEP}",
+              "ERR_EXCEP", e.what());
+    }
+}
+
+void FruImpl::interfacesAdded(sdbusplus::message_t& msg)
+{
+    sdbusplus::message::object_path path;
+    dbus::InterfaceMap interfaces;
+    try
+    {
+        msg.read(path, interfaces);
+    }
+    catch (const std::exception& e)
+    {
+        error("Failed to read the InterfacesAdded signal, ERROR={ERR_EXCEP}",
+              "ERR_EXCEP", e.what());
+        return;
+    }
+
+    auto& object = inventory[path];
+    for (auto& [intf, properties] : interfaces)
+    {
+        object[intf] = std::move(properties);
+    }
+    updateRecordSet(path);
+    assembleTable();
+}
+
+void FruImpl::interfacesRemoved(sdbusplus::message_t& msg)
+{
+    sdbusplus::message::object_path path;
+    std::vector<std::string> interfaces;
+    try
+    {
+        msg.read(path, interfaces);
+    }
+    catch (const std::exception& e)
+    {
+        error("Failed to read the InterfacesRemoved signal, ERROR={ERR_EXCEP}",
+              "ERR_EXCEP", e.what());
+        return;
+    }
+
+    auto object = inventory.find(path);
+    if (object == inventory.end())
+    {
+        return;
+    }
+    for (const auto& intf : interfaces)
+    {
+        object->second.erase(intf);
+    }
+    if (object->second.empty())
+    {
+        inventory.erase(object);
+    }
+    updateRecordSet(path);
+    assembleTable();
+}
+
+void FruImpl::propertiesChanged(sdbusplus::message_t& msg)
+{
+    std::string intf;
+    dbus::PropertyMap properties;
+    try
+    {
+        msg.read(intf, properties);
+    }
+    catch (const std::exception& e)
+    {
+        // Properties of types not used in the FRU records
+        return;
+    }
+
+    auto object = inventory.find(sdbusplus::message::object_path(msg.get_path()));
+    if (object == inventory.end())
+    {
+        return;
+    }
+    auto& current = object->second[intf];
+    for (auto& [prop, value] : properties)
+    {
+        current[prop] = std::move(value);
+    }
+    updateRecordSet(object->first);
+    assembleTable();
+}
+
 std::string FruImpl::populatefwVersion()
 {
     static constexpr auto fwFunctionalObjPath =
@@ -268,14 +494,15 @@ std::string FruImpl::populatefwVersion()
 }
 void FruImpl::populateRecords(
     const pldm::responder::dbus::InterfaceMap& interfaces,
-    const fru_parser::FruRecordInfos& recordInfos, const pldm_entity& entity)
+    const fru_parser::FruRecordInfos& recordInfos, const pldm_entity& entity,
+    RecordSet& recordSet)
 {
-    // recordSetIdentifier for the FRU will be set when the first record gets
-    // added for the FRU
-    uint16_t recordSetIdentifier = 0;
-    auto numRecsCount = numRecs;
     static uint32_t bmc_record_handle = 0;
 
+    recordSet.records.clear();
+    recordSet.numRecords = 0;
+    recordSet.recordOffsets.clear();
+
     for (const auto& [recType, encType, fieldInfos] : recordInfos)
     {
         std::vector<uint8_t> tlvs;
@@ -333,12 +560,14 @@ void FruImpl::populateRecords(
 
         if (tlvs.size())
         {
-            if (numRecs == numRecsCount)
+            // recordSetIdentifier for the FRU is set when the first record
+            // gets added for the FRU, along with its FRU record set PDR
+            if (!recordSet.rsi)
             {
-                recordSetIdentifier = nextRSI();
+                recordSet.rsi = nextRSI();
                 bmc_record_handle = nextRecordHandle();
                 int rc = pldm_pdr_add_fru_record_set_check(
-                    pdrRepo, TERMINUS_HANDLE, recordSetIdentifier,
+                    pdrRepo, TERMINUS_HANDLE, recordSet.rsi,
                     entity.entity_type, entity.entity_instance_num,
                     entity.entity_container_id, &bmc_record_handle);
                 if (rc)
@@ -347,28 +576,38 @@ void FruImpl::populateRecords(
                     throw std::runtime_error(
                         "Failed to add PDR FRU record set");
                 }
+                pldm::utils::notifyPdrRepoChanged();
             }
-            auto curSize = table.size();
-            table.resize(curSize + recHeaderSize + tlvs.size());
-            encode_fru_record(table.data(), table.size(), &curSize,
-                              recordSetIdentifier, recType, numFRUFields,
-                              encType, tlvs.data(), tlvs.size());
-            numRecs++;
+            auto curSize = recordSet.records.size();
+            recordSet.recordOffsets.emplace_back(recType, curSize);
+            recordSet.records.resize(curSize + recHeaderSize + tlvs.size());
+            encode_fru_record(recordSet.records.data(),
+                              recordSet.records.size(), &curSize,
+                              recordSet.rsi, recType, numFRUFields, encType,
+                              tlvs.data(), tlvs.size());
+            recordSet.numRecords++;
         }
     }
 }
 
-void FruImpl::getFRUTable(Response& response)
+void FruImpl::getFRUTable(Response& response, size_t offset, size_t length)
 {
     auto hdrSize = response.size();
+    length = std::min(length, transferSize() - std::min(offset, transferSize()));
+    response.resize(hdrSize + length, 0);
 
-    response.resize(hdrSize + table.size() + sizeof(checksum), 0);
-    std::copy(table.begin(), table.end(), response.begin() + hdrSize);
-
-    // Copy the checksum to response data
-    auto iter = response.begin() + hdrSize + table.size();
-    std::copy_n(reinterpret_cast<const uint8_t*>(&checksum), sizeof(checksum),
-                iter);
+    // The checksum follows the table in the transferred data
+    auto iter = response.begin() + hdrSize;
+    if (offset < table.size())
+    {
+        auto tableLength = std::min(length, table.size() - offset);
+        iter = std::copy_n(table.begin() + offset, tableLength, iter);
+        offset += tableLength;
+        length -= tableLength;
+    }
+    std::copy_n(reinterpret_cast<const uint8_t*>(&checksum) +
+                    (offset - table.size()),
+                length, iter);
 }
 
 int FruImpl::getFRURecordByOption(std::vector<uint8_t>& fruData,
@@ -383,27 +622,62 @@ int FruImpl::getFRURecordByOption(std::vector<uint8_t>& fruData,
 
     /* 7 is sizeof(checksum,4) + padBytesMax(3)
      * We can not know size of the record table got by options in advance, but
-     * it must be less than the source table. So it's safe to use sizeof the
-     * source table + 7 as the buffer length
+     * it must be less than the source records. So it's safe to use sizeof the
+     * source records + 7 as the buffer length
      */
-    size_t recordTableSize = table.size() - padBytes + 7;
-    fruData.resize(recordTableSize, 0);
+    size_t recordTableSize = 0;
+    auto records = recordIndex.find({recordSetIdentifer, recordType});
+    if (records != recordIndex.end())
+    {
+        // Only the indexed records are filtered by the field type
+        size_t length = 0;
+        for (const auto& record : records->second)
+        {
+            length += record.second;
+        }
+        fruData.resize(length + 7, 0);
 
-    int rc = get_fru_record_by_option_check(
-        table.data(), table.size() - padBytes, fruData.data(), &recordTableSize,
-        recordSetIdentifer, recordType, fieldType);
+        for (const auto& [offset, recordLength] : records->second)
+        {
+            size_t partSize = fruData.size() - recordTableSize;
+            int rc = get_fru_record_by_option_check(
+                table.data() + offset, recordLength,
+                fruData.data() + recordTableSize, &partSize,
+                recordSetIdentifer, recordType, fieldType);
+            if (rc != PLDM_SUCCESS)
+            {
+                return PLDM_FRU_DATA_STRUCTURE_TABLE_UNAVAILABLE;
+            }
+            recordTableSize += partSize;
+        }
+    }
+    else if (!recordSetIdentifer || !recordType)
+    {
+        // Not indexed, let libpldm go through the whole table
+        recordTableSize = table.size() - padBytes + 7;
+        fruData.resize(recordTableSize, 0);
+
+        int rc = get_fru_record_by_option_check(
+            table.data(), table.size() - padBytes, fruData.data(),
+            &recordTableSize, recordSetIdentifer, recordType, fieldType);
+        if (rc != PLDM_SUCCESS)
+        {
+            return PLDM_FRU_DATA_STRUCTURE_TABLE_UNAVAILABLE;
+        }
+    }
 
-    if (rc != PLDM_SUCCESS || recordTableSize == 0)
+    if (recordTableSize == 0)
     {
         return PLDM_FRU_DATA_STRUCTURE_TABLE_UNAVAILABLE;
     }
 
     auto pads = pldm::utils::getNumPadBytes(recordTableSize);
-    crc32(fruData.data(), recordTableSize + pads);
+    sum recordsChecksum = pldm::utils::Crc32::of(
+        std::span<const uint8_t>(fruData.data(), recordTableSize + pads));
 
     auto iter = fruData.begin() + recordTableSize + pads;
-    std::copy_n(reinterpret_cast<const uint8_t*>(&checksum), sizeof(checksum),
-                iter);
+    std::copy_n(reinterpret_cast<const uint8_t*>(&recordsChecksum),
+                sizeof(recordsChecksum), iter);
     fruData.resize(recordTableSize + pads + sizeof(sum));
 
     return PLDM_SUCCESS;
@@ -421,9 +695,8 @@ Response Handler::getFRURecordTableMetadata(const pldm_msg* request,
     constexpr uint8_t minor = 0x00;
     constexpr uint32_t maxSize = 0xFFFFFFFF;
 
-    Response response(sizeof(pldm_msg_hdr) +
-                          PLDM_GET_FRU_RECORD_TABLE_METADATA_RESP_BYTES,
-                      0);
+    auto response =
+        responseBuffer<PLDM_GET_FRU_RECORD_TABLE_METADATA_RESP_BYTES>();
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     auto rc = encode_get_fru_record_table_metadata_resp(
@@ -449,19 +722,62 @@ Response Handler::getFRURecordTable(const pldm_msg* request,
         return ccOnlyResponse(request, PLDM_ERROR_INVALID_LENGTH);
     }
 
-    Response response(
-        sizeof(pldm_msg_hdr) + PLDM_GET_FRU_RECORD_TABLE_MIN_RESP_BYTES, 0);
+    uint32_t transferHandle{};
+    uint8_t transferOpFlag{};
+    auto rc = decode_get_fru_record_table_req(request, payloadLength,
+                                              &transferHandle, &transferOpFlag);
+    if (rc != PLDM_SUCCESS)
+    {
+        return ccOnlyResponse(request, rc);
+    }
+
+    // The transfer handle is the offset of the part in the table, which ends
+    // with the pad bytes and the checksum
+    auto tableSize = impl.transferSize();
+    size_t offset = 0;
+    if (transferOpFlag == PLDM_GET_NEXTPART)
+    {
+        if (!transferHandle || transferHandle >= tableSize)
+        {
+            return ccOnlyResponse(request,
+                                  PLDM_FRU_INVALID_DATA_TRANSFER_HANDLE);
+        }
+        offset = transferHandle;
+    }
+    else if (transferOpFlag != PLDM_GET_FIRSTPART)
+    {
+        return ccOnlyResponse(request, PLDM_FRU_INVALID_TRANSFER_FLAG);
+    }
+
+    // The parts are as large as negotiated with the requester
+    auto partSize = std::min<size_t>(
+        tableSize - offset,
+        transfer::TransferSizes::get().requesterPartSize(FRU_TABLE_TRANSFER_SIZE));
+    auto nextOffset = offset + partSize;
+    bool morePart = nextOffset < tableSize;
+    uint8_t transferFlag = offset ? (morePart ? PLDM_MIDDLE : PLDM_END)
+                                  : (morePart ? PLDM_START
+                                              : PLDM_START_AND_END);
+    uint32_t nxtTransferHandle = morePart ? static_cast<uint32_t>(nextOffset)
+                                          : 0;
+
+    /* The buffer is taken for the whole part, the table is appended after
+     * the fixed fields */
+    auto response = responseBuffer(PLDM_GET_FRU_RECORD_TABLE_MIN_RESP_BYTES +
+                                   partSize);
+    response.resize(sizeof(pldm_msg_hdr) +
+                    PLDM_GET_FRU_RECORD_TABLE_MIN_RESP_BYTES);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
-    auto rc = encode_get_fru_record_table_resp(request->hdr.instance_id,
-                                               PLDM_SUCCESS, 0,
-                                               PLDM_START_AND_END, responsePtr);
+    rc = encode_get_fru_record_table_resp(request->hdr.instance_id,
+                                          PLDM_SUCCESS, nxtTransferHandle,
+                                          transferFlag, responsePtr);
     if (rc != PLDM_SUCCESS)
     {
         return ccOnlyResponse(request, rc);
     }
 
-    impl.getFRUTable(response);
+    impl.getFRUTable(response, offset, partSize);
 
     return response;
 }
@@ -502,7 +818,7 @@ Response Handler::getFRURecordByOption(const pldm_msg* request,
 
     auto respPayloadLength = PLDM_GET_FRU_RECORD_BY_OPTION_MIN_RESP_BYTES +
                              fruData.size();
-    Response response(sizeof(pldm_msg_hdr) + respPayloadLength, 0);
+    auto response = responseBuffer(respPayloadLength);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     rc = encode_get_fru_record_by_option_resp(
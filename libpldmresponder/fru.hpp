@@ -6,10 +6,15 @@
 #include <libpldm/fru.h>
 #include <libpldm/pdr.h>
 
+#include <sdbusplus/bus/match.hpp>
 #include <sdbusplus/message.hpp>
+#include <sdbusplus/slot.hpp>
 
 #include <map>
+#include <memory>
+#include <optional>
 #include <string>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -105,11 +110,23 @@ class FruImpl
         return numRecs;
     }
 
-    /** @brief Get the FRU table
+    /** @brief Size of the FRU table as transferred, with the pad bytes and
+     *         the checksum
      *
-     *  @param[out] - Populate response with the FRU table
+     *  @return transfer size of the FRU table
      */
-    void getFRUTable(Response& response);
+    size_t transferSize() const
+    {
+        return table.size() + sizeof(checksum);
+    }
+
+    /** @brief Get a part of the FRU table
+     *
+     *  @param[out] response - Populate response with the FRU table part
+     *  @param[in] offset - offset of the part in the transferred table
+     *  @param[in] length - length of the part
+     */
+    void getFRUTable(Response& response, size_t offset, size_t length);
 
     /** @brief Get FRU Record Table By Option
      *  @param[out] response - Populate response with the FRU table got by
@@ -129,6 +146,12 @@ class FruImpl
      */
     void buildFRUTable();
 
+    /** @brief Ask for the D-Bus inventory without waiting, the FRU table is
+     *         built when the reply comes unless a FRU or Get PDR command
+     *         built it first
+     */
+    void buildFRUTableAsync();
+
     /** @brief Get std::map associated with the entity
      *         key: object path
      *         value: pldm_entity
@@ -178,6 +201,20 @@ class FruImpl
     std::string populatefwVersion();
 
   private:
+    /** @struct RecordSet
+     *
+     *  The encoded FRU records of one inventory object, the FRU table is the
+     *  concatenation of the record sets
+     */
+    struct RecordSet
+    {
+        uint16_t rsi = 0; //!< record set identifier, 0 until the first record
+        std::vector<uint8_t> records; //!< encoded FRU records
+        uint16_t numRecords = 0;      //!< number of FRU records
+        /** @brief Record type and offset of each record */
+        std::vector<std::pair<uint8_t, size_t>> recordOffsets;
+    };
+
     uint16_t nextRSI()
     {
         return ++rsi;
@@ -203,17 +240,66 @@ class FruImpl
 
     std::map<dbus::ObjectPath, pldm_entity_node*> objToEntityNode{};
 
+    /** @brief D-Bus lookup info of the inventory */
+    fru_parser::DBusLookupInfo dbusInfo;
+
+    /** @brief Inventory objects, kept up to date by the D-Bus signals */
+    dbus::ObjectValueTree inventory;
+
+    /** @brief Record set of each inventory object which has FRU records */
+    std::map<dbus::ObjectPath, RecordSet> recordSets;
+
+    /** @brief Offset and length in the FRU table of the records of a record
+     *         set identifier and record type
+     */
+    std::map<std::pair<uint16_t, uint8_t>,
+             std::vector<std::pair<size_t, size_t>>>
+        recordIndex;
+
+    /** @brief Pending GetManagedObjects call of buildFRUTableAsync */
+    std::optional<sdbusplus::slot_t> buildCall;
+
+    /** @brief Matches of the inventory changes */
+    std::vector<std::unique_ptr<sdbusplus::bus::match_t>> inventoryMatches;
+
     /** @brief populateRecord builds the FRU records for an instance of FRU and
-     *         updates the FRU table with the FRU records.
+     *         replaces the records of its record set.
      *
      *  @param[in] interfaces - D-Bus interfaces and the associated property
      *                          values for the FRU
      *  @param[in] recordInfos - FRU record info to build the FRU records
-     *  @param[in/out] entity - PLDM entity corresponding to FRU instance
+     *  @param[in] entity - PLDM entity corresponding to FRU instance
+     *  @param[in,out] recordSet - record set of the FRU
      */
     void populateRecords(const dbus::InterfaceMap& interfaces,
                          const fru_parser::FruRecordInfos& recordInfos,
-                         const pldm_entity& entity);
+                         const pldm_entity& entity, RecordSet& recordSet);
+
+    /** @brief Build the FRU table from the inventory objects
+     *
+     *  @param[in] objects - the managed objects of the inventory
+     */
+    void buildFromObjects(dbus::ObjectValueTree&& objects);
+
+    /** @brief Encode again the record set of one inventory object, the
+     *         records are dropped if the FRU is not present any more
+     *
+     *  @param[in] path - object path of the FRU
+     */
+    void updateRecordSet(const sdbusplus::message::object_path& path);
+
+    /** @brief Concatenate the record sets into the FRU table, with the pad
+     *         bytes and the checksum, and index the records
+     */
+    void assembleTable();
+
+    /** @brief Watch the inventory to update the FRU table incrementally */
+    void watchInventory();
+
+    /** @brief Handlers of the inventory signals */
+    void interfacesAdded(sdbusplus::message_t& msg);
+    void interfacesRemoved(sdbusplus::message_t& msg);
+    void propertiesChanged(sdbusplus::message_t& msg);
 
     /** @brief Associate sensor/effecter to FRU entity
      */
@@ -274,6 +360,14 @@ class Handler : public CmdHandler
         impl.buildFRUTable();
     }
 
+    /** @brief Start building the FRU table without blocking
+     *
+     */
+    void buildFRUTableAsync()
+    {
+        impl.buildFRUTableAsync();
+    }
+
     /** @brief Get std::map associated with the entity
      *         key: object path
      *         value: pldm_entity
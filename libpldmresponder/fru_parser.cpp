@@ -1,11 +1,12 @@
 #include "fru_parser.hpp"
 
+#include "common/utils.hpp"
+
 #include <nlohmann/json.hpp>
 #include <phosphor-logging/lg2.hpp>
 #include <xyz/openbmc_project/Common/error.hpp>
 
 #include <filesystem>
-#include <fstream>
 #include <iostream>
 
 PHOSPHOR_LOG2_USING;
@@ -45,8 +46,7 @@ void FruParser::setupDefaultDBusLookup(const fs::path& masterJsonPath)
 {
     constexpr auto service = "xyz.openbmc_project.Inventory.Manager";
     constexpr auto rootPath = "/xyz/openbmc_project/inventory";
-    std::ifstream jsonFile(masterJsonPath);
-    auto data = Json::parse(jsonFile, nullptr, false);
+    const auto& data = pldm::utils::JsonCache::get().load(masterJsonPath);
     if (data.is_discarded())
     {
         error(
@@ -114,8 +114,7 @@ void FruParser::setupFruRecordMap(const std::string& dirPath)
     for (auto& file : fs::directory_iterator(dirPath))
     {
         auto fileName = file.path().filename().string();
-        std::ifstream jsonFile(file.path());
-        auto data = Json::parse(jsonFile, nullptr, false);
+        const auto& data = pldm::utils::JsonCache::get().load(file.path());
         if (data.is_discarded())
         {
             error("Parsing FRU config file failed, FILE={FILE_PATH}",
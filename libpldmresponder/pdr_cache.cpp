@@ -0,0 +1,181 @@
+#include "pdr_cache.hpp"
+
+#include "common/write_behind.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <limits>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+
+namespace responder
+{
+
+namespace pdr
+{
+
+namespace
+{
+
+/** @struct CacheHeader
+ *  @brief Header at offset 0 of the BMC PDR cache file. It is followed by
+ *  the PDRs as (length, data).
+ */
+struct CacheHeader
+{
+    uint32_t magic;          //!< pdrCacheMagic
+    uint16_t version;        //!< pdrCacheVersion
+    uint16_t reserved;       //!< Reserved, zero
+    uint64_t key;            //!< Key of the inputs of the generation
+    uint32_t recordCount;    //!< Number of PDRs
+    uint16_t nextSensorId;   //!< Next sensor ID after the generation
+    uint16_t nextEffecterId; //!< Next effecter ID after the generation
+};
+static_assert(sizeof(CacheHeader) == 24);
+
+template <typename T>
+void appendValue(std::vector<uint8_t>& data, const T& value)
+{
+    auto bytes = reinterpret_cast<const uint8_t*>(&value);
+    data.insert(data.end(), bytes, bytes + sizeof(T));
+}
+
+} // namespace
+
+PdrCache::~PdrCache()
+{
+    unmap();
+}
+
+void PdrCache::unmap()
+{
+    if (data)
+    {
+        munmap(const_cast<uint8_t*>(data), size);
+    }
+    data = nullptr;
+    size = 0;
+    records.clear();
+}
+
+bool PdrCache::load(const std::filesystem::path& path, uint64_t key)
+{
+    unmap();
+
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat st{};
+    if (fstat(fd, &st) < 0 ||
+        static_cast<size_t>(st.st_size) < sizeof(CacheHeader))
+    {
+        close(fd);
+        error("Ignore the invalid BMC PDR cache, PATH={PATH}", "PATH",
+              path.string());
+        return false;
+    }
+    auto mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED)
+    {
+        error("Failed to map the BMC PDR cache, PATH={PATH} ERROR={ERRNO}",
+              "PATH", path.string(), "ERRNO", strerror(errno));
+        return false;
+    }
+    data = static_cast<const uint8_t*>(mapped);
+    size = st.st_size;
+
+    CacheHeader header{};
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != pdrCacheMagic || header.version != pdrCacheVersion)
+    {
+        error("Ignore the invalid BMC PDR cache, PATH={PATH}", "PATH",
+              path.string());
+        unmap();
+        return false;
+    }
+    if (header.key != key)
+    {
+        info("Ignore the stale BMC PDR cache, PATH={PATH}", "PATH",
+             path.string());
+        unmap();
+        return false;
+    }
+
+    size_t offset = sizeof(header);
+    records.reserve(header.recordCount);
+    for (uint32_t i = 0; i < header.recordCount; i++)
+    {
+        uint32_t recordSize = 0;
+        if (size - offset < sizeof(recordSize))
+        {
+            break;
+        }
+        std::memcpy(&recordSize, data + offset, sizeof(recordSize));
+        offset += sizeof(recordSize);
+        if (size - offset < recordSize)
+        {
+            break;
+        }
+        records.emplace_back(data + offset, recordSize);
+        offset += recordSize;
+    }
+    if (records.size() != header.recordCount || offset != size)
+    {
+        error("Ignore the truncated BMC PDR cache, PATH={PATH}", "PATH",
+              path.string());
+        unmap();
+        return false;
+    }
+
+    ids = {header.nextSensorId, header.nextEffecterId};
+    return true;
+}
+
+bool PdrCache::save(const std::filesystem::path& path, uint64_t key,
+                    PdrCacheIds ids,
+                    const std::vector<std::span<const uint8_t>>& records)
+{
+    if (records.size() > std::numeric_limits<uint32_t>::max())
+    {
+        return false;
+    }
+
+    CacheHeader header{};
+    header.magic = pdrCacheMagic;
+    header.version = pdrCacheVersion;
+    header.key = key;
+    header.recordCount = static_cast<uint32_t>(records.size());
+    header.nextSensorId = ids.nextSensorId;
+    header.nextEffecterId = ids.nextEffecterId;
+
+    std::vector<uint8_t> data;
+    appendValue(data, header);
+    for (const auto& record : records)
+    {
+        appendValue(data, static_cast<uint32_t>(record.size()));
+        data.insert(data.end(), record.begin(), record.end());
+    }
+
+    /* Written behind as a temporary file renamed, a crash while saving
+     * leaves the previous cache or no cache but never a partial one */
+    return pldm::utils::persistFile(path, std::move(data));
+}
+
+} // namespace pdr
+
+} // namespace responder
+
+} // namespace pldm
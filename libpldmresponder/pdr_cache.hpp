@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace pldm
+{
+
+namespace responder
+{
+
+namespace pdr
+{
+
+/** @brief Magic number of the BMC PDR cache file, "PBPC" */
+constexpr uint32_t pdrCacheMagic = 0x43504250;
+/** @brief Layout version of the BMC PDR cache file, part of the key so a
+ *  change of the generators can bump it to drop the old files */
+constexpr uint16_t pdrCacheVersion = 1;
+
+/** @class PdrCacheKey
+ *  @brief 64-bit FNV-1a hash of the inputs of the PDR generation
+ */
+class PdrCacheKey
+{
+  public:
+    void add(const void* data, size_t size)
+    {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; i++)
+        {
+            hash = (hash ^ bytes[i]) * 0x100000001b3;
+        }
+    }
+
+    /** @brief Add a string with its length, so the concatenation of two
+     *  strings does not hash like their concatenation */
+    void add(std::string_view str)
+    {
+        addValue(str.size());
+        add(str.data(), str.size());
+    }
+
+    template <typename T>
+    void addValue(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        add(&value, sizeof(T));
+    }
+
+    uint64_t value() const
+    {
+        return hash;
+    }
+
+  private:
+    uint64_t hash = 0xcbf29ce484222325;
+};
+
+/** @struct PdrCacheIds
+ *  @brief Next sensor and effecter IDs of the platform handler
+ */
+struct PdrCacheIds
+{
+    uint16_t nextSensorId;
+    uint16_t nextEffecterId;
+};
+
+/** @class PdrCache
+ *
+ *  PDRs generated from the PDR JSONs kept on disk, so a restart of pldmd
+ *  adds them to the repository without parsing the JSONs or resolving the
+ *  D-Bus mappings. The file is mapped read-only when it is loaded and the
+ *  records point into the mapping, they are valid while the PdrCache lives.
+ */
+class PdrCache
+{
+  public:
+    PdrCache() = default;
+    PdrCache(const PdrCache&) = delete;
+    PdrCache& operator=(const PdrCache&) = delete;
+    ~PdrCache();
+
+    /** @brief Map the cache file
+     *
+     *  @param[in] path - path of the cache file
+     *  @param[in] key - key of the current inputs of the generation
+     *
+     *  @return - true if the file exists, is well formed and has the key
+     */
+    bool load(const std::filesystem::path& path, uint64_t key);
+
+    /** @brief PDRs of the loaded file, in the order of the generation */
+    const std::vector<std::span<const uint8_t>>& getRecords() const
+    {
+        return records;
+    }
+
+    /** @brief Sensor and effecter IDs after the generation */
+    PdrCacheIds getIds() const
+    {
+        return ids;
+    }
+
+    /** @brief Save a cache file, replacing the previous one atomically, on
+     *         the write-behind of the process if there is one
+     *
+     *  @param[in] path - path of the cache file
+     *  @param[in] key - key of the inputs of the generation
+     *  @param[in] ids - sensor and effecter IDs after the generation
+     *  @param[in] records - generated PDRs
+     *
+     *  @return - true on success or once queued to be written behind
+     */
+    static bool save(const std::filesystem::path& path, uint64_t key,
+                     PdrCacheIds ids,
+                     const std::vector<std::span<const uint8_t>>& records);
+
+  private:
+    void unmap();
+
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    std::vector<std::span<const uint8_t>> records;
+    PdrCacheIds ids{};
+};
+
+} // namespace pdr
+
+} // namespace responder
+
+} // namespace pldm
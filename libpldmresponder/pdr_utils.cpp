@@ -42,6 +42,7 @@ RecordHandle Repo::addRecord(const PdrEntry& pdrEntry)
         // pldm_pdr_add() assert()ed on failure to add PDR
         throw std::runtime_error("Failed to add PDR");
     }
+    pldm::utils::notifyPdrRepoChanged();
     return handle;
 }
 
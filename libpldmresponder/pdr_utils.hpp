@@ -1,5 +1,6 @@
 #pragma once
 
+#include "common/pdr_index.hpp"
 #include "common/types.hpp"
 #include "common/utils.hpp"
 
@@ -14,6 +15,7 @@
 #include <fstream>
 #include <functional>
 #include <iostream>
+#include <stdexcept>
 #include <string>
 
 PHOSPHOR_LOG2_USING;
@@ -80,13 +82,14 @@ using StatestoDbusVal = std::map<State, pldm::utils::PropertyValue>;
 using DbusMappings = std::vector<pldm::utils::DBusMapping>;
 using DbusValMaps = std::vector<StatestoDbusVal>;
 
-/** @brief Parse PDR JSON file and output Json object
+/** @brief Parse PDR JSON file and output Json object, the parsed files are
+ *         cached
  *
  *  @param[in] path - path of PDR JSON file
  *
  *  @return Json - Json object
  */
-inline Json readJson(const std::string& path)
+inline const Json& readJson(const std::string& path)
 {
     fs::path dir(path);
     if (!fs::exists(dir) || fs::is_empty(dir))
@@ -94,15 +97,14 @@ inline Json readJson(const std::string& path)
         throw InternalFailure();
     }
 
-    std::ifstream jsonFile(path);
-    if (!jsonFile.is_open())
+    const auto& json = pldm::utils::JsonCache::get().load(path);
+    if (json.is_discarded())
     {
-        error("Error opening PDR JSON file, PATH={JSON_PATH}", "JSON_PATH",
+        error("Error reading PDR JSON file, PATH={JSON_PATH}", "JSON_PATH",
               path);
-        return {};
+        throw std::runtime_error("Failed parsing " + path);
     }
-
-    return Json::parse(jsonFile);
+    return json;
 }
 
 /** @brief Populate the mapping between D-Bus property stateId and attribute
@@ -200,7 +202,7 @@ class RepoInterface
 class Repo : public RepoInterface
 {
   public:
-    Repo(pldm_pdr* repo) : RepoInterface(repo) {}
+    Repo(pldm_pdr* repo) : RepoInterface(repo), index(repo) {}
 
     pldm_pdr* getPdr() const override;
 
@@ -216,6 +218,19 @@ class Repo : public RepoInterface
     uint32_t getRecordCount() override;
 
     bool empty() override;
+
+    /** @brief Get the lookup index of the PDR repository
+     *
+     *  @return PdrIndex - index by record handle, entity and sensor/effecter ID
+     */
+    pldm::utils::PdrIndex& getIndex()
+    {
+        return index;
+    }
+
+  private:
+    /** @brief Lookup index of the repository */
+    pldm::utils::PdrIndex index;
 };
 
 /** @brief Parse the State Sensor PDR and return the parsed sensor info which
@@ -1,6 +1,7 @@
 #include "platform.hpp"
 
 #include "common/types.hpp"
+#include "common/transfer_size.hpp"
 #include "common/utils.hpp"
 #include "event_parser.hpp"
 #include "pdr.hpp"
@@ -16,9 +17,17 @@
 #include <filesystem>
 #include <libpldm/entity.h>
 #include <libpldm/state_set.h>
+#include <libpldm/utils.h>
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
+#include <fstream>
+#include <memory_resource>
+#include <set>
+#include <string>
+#include <vector>
+
 PHOSPHOR_LOG2_USING;
 
 using namespace pldm::utils;
@@ -41,6 +50,15 @@ void Handler::addDbusObjMaps(
     std::tuple<pdr_utils::DbusMappings, pdr_utils::DbusValMaps> dbusObj,
     TypeId typeId)
 {
+    auto& propertyCache = pldm::utils::PropertyCache::get();
+    if (propertyCache.enabled())
+    {
+        for (const auto& dbusMapping : std::get<0>(dbusObj))
+        {
+            propertyCache.watch(dbusMapping);
+        }
+    }
+
     if (typeId == TypeId::PLDM_SENSOR_ID)
     {
         sensorDbusObjMaps.emplace(id, dbusObj);
@@ -52,8 +70,9 @@ void Handler::addDbusObjMaps(
 }
 
 const std::tuple<pdr_utils::DbusMappings, pdr_utils::DbusValMaps>&
-    Handler::getDbusObjMaps(uint16_t id, TypeId typeId) const
+    Handler::getDbusObjMaps(uint16_t id, TypeId typeId)
 {
+    buildDbusObjMaps();
     if (typeId == TypeId::PLDM_SENSOR_ID)
     {
         return sensorDbusObjMaps.at(id);
@@ -64,14 +83,267 @@ const std::tuple<pdr_utils::DbusMappings, pdr_utils::DbusValMaps>&
     }
 }
 
+/** @brief Collect the interfaces of the "dbus" sections of a PDR JSON */
+static void collectInterfaces(const Json& json,
+                              std::set<std::string>& interfaces)
+{
+    if (json.is_object())
+    {
+        for (const auto& [key, value] : json.items())
+        {
+            if (key == "dbus" && value.is_object())
+            {
+                auto interface = value.value("interface", "");
+                if (!interface.empty())
+                {
+                    interfaces.emplace(std::move(interface));
+                }
+                continue;
+            }
+            collectInterfaces(value, interfaces);
+        }
+    }
+    else if (json.is_array())
+    {
+        for (const auto& value : json)
+        {
+            collectInterfaces(value, interfaces);
+        }
+    }
+}
+
+void Handler::prefetchServices(const pldm::utils::DBusHandler& dBusIntf,
+                               const std::string& dir)
+{
+    std::set<std::string> interfaces;
+    for (const auto& dirEntry : fs::directory_iterator(dir))
+    {
+        try
+        {
+            collectInterfaces(readJson(dirEntry.path().string()), interfaces);
+        }
+        catch (const std::exception& e)
+        {
+            /* Reported by generate() when it parses the file */
+        }
+    }
+    if (interfaces.empty())
+    {
+        return;
+    }
+
+    try
+    {
+        auto subtree = dBusIntf.getSubtree(
+            "/", 0,
+            std::vector<std::string>(interfaces.begin(), interfaces.end()));
+        ServiceCache::get().insertSubtree(subtree);
+#ifdef BMC_PDR_CACHE_DIR
+        PdrCacheKey key;
+        for (const auto& [path, services] : subtree)
+        {
+            key.add(path);
+            for (const auto& [service, serviceInterfaces] : services)
+            {
+                for (const auto& interface : serviceInterfaces)
+                {
+                    key.add(interface);
+                }
+            }
+        }
+        inventoryKey = key.value();
+#endif
+        info(
+            "Resolved the services of the PDR mappings, INTERFACES={NUM_INTF} OBJECTS={NUM_OBJ}",
+            "NUM_INTF", interfaces.size(), "NUM_OBJ", subtree.size());
+    }
+    catch (const std::exception& e)
+    {
+        error(
+            "Failed to get the mapper subtree of the PDR mappings, ERROR={ERR_EXCEP}",
+            "ERR_EXCEP", e.what());
+    }
+}
+
 void Handler::generate(const pldm::utils::DBusHandler& dBusIntf,
-                       const std::string& dir, Repo& repo)
+                       const std::string& dir, Repo& repo,
+                       std::optional<Type> onlyType)
 {
     if (!fs::exists(dir))
     {
         return;
     }
 
+    /* The generators look up the service of every mapping, with the cache
+     * in use they are answered from a single mapper call. A build by PDR
+     * type prefetches them with the first type. */
+    if (ServiceCache::get().enabled() &&
+        (!onlyType || *onlyType == PLDM_STATE_SENSOR_PDR))
+    {
+        prefetchServices(dBusIntf, dir);
+    }
+
+#ifdef BMC_PDR_CACHE_DIR
+    /* The same inputs generate the same PDRs, they are added from the cache
+     * file and the generation is replayed only for the D-Bus object maps */
+    auto key = pdrCacheKey(dir, onlyType);
+    auto path = fs::path(BMC_PDR_CACHE_DIR) /
+                ("bmc_pdrs_" +
+                 (onlyType ? std::to_string(*onlyType) : std::string("all")));
+    if (key && loadCachedPDRs(path, *key, dBusIntf, dir, repo, onlyType))
+    {
+        return;
+    }
+    auto first = repo.getRecordCount();
+#endif
+
+    [[maybe_unused]] auto generated = generatePDRs(dBusIntf, dir, repo,
+                                                   onlyType);
+
+#ifdef BMC_PDR_CACHE_DIR
+    /* A failed PDR may be a transient D-Bus error, it is not cached */
+    if (key && generated)
+    {
+        saveCachedPDRs(path, *key, repo, first);
+    }
+#endif
+}
+
+#ifdef BMC_PDR_CACHE_DIR
+std::optional<uint64_t> Handler::pdrCacheKey(const std::string& dir,
+                                             std::optional<Type> onlyType)
+{
+    if (!inventoryKey)
+    {
+        return std::nullopt;
+    }
+
+    PdrCacheKey key;
+    key.addValue(pdrCacheVersion);
+    key.addValue(onlyType.has_value());
+    key.addValue(onlyType.value_or(0));
+    key.addValue(nextSensorId);
+    key.addValue(nextEffecterId);
+    key.addValue<uint16_t>(TERMINUS_HANDLE);
+    key.addValue(*inventoryKey);
+
+    std::vector<fs::path> files;
+    for (const auto& dirEntry : fs::directory_iterator(dir))
+    {
+        files.emplace_back(dirEntry.path());
+    }
+    std::sort(files.begin(), files.end());
+    for (const auto& file : files)
+    {
+        std::ifstream jsonFile(file, std::ios::binary);
+        std::string contents((std::istreambuf_iterator<char>(jsonFile)),
+                             std::istreambuf_iterator<char>());
+        key.add(file.filename().string());
+        key.add(contents);
+    }
+
+    try
+    {
+        for (const auto& [objectPath, entity] : getAssociateEntityMap())
+        {
+            key.add(objectPath);
+            key.addValue(entity.entity_type);
+            key.addValue(entity.entity_instance_num);
+            key.addValue(entity.entity_container_id);
+        }
+    }
+    catch (const std::exception&)
+    {
+        /* No FRU handler, the PDRs have no FRU entities */
+    }
+
+    return key.value();
+}
+
+bool Handler::loadCachedPDRs(const fs::path& path, uint64_t key,
+                             const DBusHandler& dBusIntf,
+                             const std::string& dir, Repo& repo,
+                             std::optional<Type> onlyType)
+{
+    PdrCache cache;
+    if (!cache.load(path, key))
+    {
+        return false;
+    }
+
+    for (const auto& record : cache.getRecords())
+    {
+        /* libpldm copies the record and assigns the next handles in order,
+         * the same handles as the generation */
+        PdrEntry pdrEntry{};
+        pdrEntry.data = const_cast<uint8_t*>(record.data());
+        pdrEntry.size = record.size();
+        pdrEntry.handle.recordHandle = 0;
+        repo.addRecord(pdrEntry);
+    }
+
+    cachedGenerations.push_back(
+        {&dBusIntf, dir, onlyType, PdrCacheIds{nextSensorId, nextEffecterId}});
+    nextSensorId = cache.getIds().nextSensorId;
+    nextEffecterId = cache.getIds().nextEffecterId;
+    info("Loaded the BMC PDRs from the cache, PATH={PATH} RECORDS={RECORDS}",
+         "PATH", path.string(), "RECORDS", cache.getRecords().size());
+    return true;
+}
+
+void Handler::saveCachedPDRs(const fs::path& path, uint64_t key, Repo& repo,
+                             uint32_t first)
+{
+    std::vector<std::span<const uint8_t>> records;
+    PdrEntry pdrEntry{};
+    uint32_t index = 0;
+    for (auto record = repo.getFirstRecord(pdrEntry); record;
+         record = repo.getNextRecord(record, pdrEntry), index++)
+    {
+        if (index >= first)
+        {
+            records.emplace_back(pdrEntry.data, pdrEntry.size);
+        }
+    }
+    PdrCache::save(path, key, {nextSensorId, nextEffecterId}, records);
+}
+#endif
+
+void Handler::buildDbusObjMaps()
+{
+#ifdef BMC_PDR_CACHE_DIR
+    if (cachedGenerations.empty())
+    {
+        return;
+    }
+
+    /* Replay the generations into a scratch repository from the same IDs,
+     * the PDRs are dropped and only the D-Bus object maps are kept */
+    auto generations = std::move(cachedGenerations);
+    cachedGenerations.clear();
+    auto sensorId = nextSensorId;
+    auto effecterId = nextEffecterId;
+    std::unique_ptr<pldm_pdr, decltype(&pldm_pdr_destroy)> scratchPdr(
+        pldm_pdr_init(), pldm_pdr_destroy);
+    Repo scratch(scratchPdr.get());
+    for (const auto& generation : generations)
+    {
+        nextSensorId = generation.ids.nextSensorId;
+        nextEffecterId = generation.ids.nextEffecterId;
+        generatePDRs(*generation.dBusIntf, generation.dir, scratch,
+                     generation.onlyType);
+    }
+    nextSensorId = sensorId;
+    nextEffecterId = effecterId;
+    info("Built the D-Bus object maps of the cached BMC PDRs, SENSORS={SENSORS} EFFECTERS={EFFECTERS}",
+         "SENSORS", sensorDbusObjMaps.size(), "EFFECTERS",
+         effecterDbusObjMaps.size());
+#endif
+}
+
+bool Handler::generatePDRs(const DBusHandler& dBusIntf, const std::string& dir,
+                           Repo& repo, std::optional<Type> onlyType)
+{
     // A map of PDR type to a lambda that handles creation of that PDR type.
     // The lambda essentially would parse the platform specific PDR JSONs to
     // generate the PDR structures. This function iterates through the map to
@@ -98,18 +370,23 @@ void Handler::generate(const pldm::utils::DBusHandler& dBusIntf,
                                                           repo);
     }}};
 
+    bool generated = true;
     Type pdrType{};
     for (const auto& dirEntry : fs::directory_iterator(dir))
     {
         try
         {
-            auto json = readJson(dirEntry.path().string());
+            const auto& json = readJson(dirEntry.path().string());
             if (!json.empty())
             {
                 auto effecterPDRs = json.value("effecterPDRs", empty);
                 for (const auto& effecter : effecterPDRs)
                 {
                     pdrType = effecter.value("pdrType", 0);
+                    if (onlyType && pdrType != *onlyType)
+                    {
+                        continue;
+                    }
                     generateHandlers.at(pdrType)(dBusIntf, effecter, repo);
                 }
 
@@ -117,6 +394,10 @@ void Handler::generate(const pldm::utils::DBusHandler& dBusIntf,
                 for (const auto& sensor : sensorPDRs)
                 {
                     pdrType = sensor.value("pdrType", 0);
+                    if (onlyType && pdrType != *onlyType)
+                    {
+                        continue;
+                    }
                     generateHandlers.at(pdrType)(dBusIntf, sensor, repo);
                 }
             }
@@ -135,6 +416,7 @@ void Handler::generate(const pldm::utils::DBusHandler& dBusIntf,
                 "PDR_TYPE", pdrType, "ERR_EXCEP", e.what());
             pldm::utils::reportError(
                 "xyz.openbmc_project.bmc.pldm.InternalFailure");
+            generated = false;
         }
         catch (const std::exception& e)
         {
@@ -143,8 +425,10 @@ void Handler::generate(const pldm::utils::DBusHandler& dBusIntf,
                 "PDR_TYPE", pdrType, "ERR_EXCEP", e.what());
             pldm::utils::reportError(
                 "xyz.openbmc_project.bmc.pldm.InternalFailure");
+            generated = false;
         }
     }
+    return generated;
 }
 
 Response Handler::getPDR(const pldm_msg* request, size_t payloadLength)
@@ -161,35 +445,7 @@ Response Handler::getPDR(const pldm_msg* request, size_t payloadLength)
         }
     }
 
-    // Build FRU table if not built, since entity association PDR's
-    // are built when the FRU table is constructed.
-    if (fruHandler)
-    {
-        fruHandler->buildFRUTable();
-    }
-
-    if (!pdrCreated)
-    {
-        generateTerminusLocatorPDR(pdrRepo);
-        generate(*dBusIntf, pdrJsonsDir, pdrRepo);
-        if (oemPlatformHandler != nullptr)
-        {
-            oemPlatformHandler->buildOEMPDR(pdrRepo);
-        }
-
-        pdrCreated = true;
-
-        if (dbusToPLDMEventHandler)
-        {
-            deferredGetPDREvent = std::make_unique<sdeventplus::source::Defer>(
-                event,
-                std::bind(std::mem_fn(&pldm::responder::platform::Handler::
-                                          _processPostGetPDRActions),
-                          this, std::placeholders::_1));
-        }
-    }
-
-    Response response(sizeof(pldm_msg_hdr) + PLDM_GET_PDR_MIN_RESP_BYTES, 0);
+    Response response;
 
     if (payloadLength != PLDM_GET_PDR_REQ_BYTES)
     {
@@ -210,38 +466,106 @@ Response Handler::getPDR(const pldm_msg* request, size_t payloadLength)
         return CmdHandler::ccOnlyResponse(request, rc);
     }
 
-    uint16_t respSizeBytes{};
-    uint8_t* recordData = nullptr;
+    // An early GetPDR only waits for the PDRs up to the requested record
+    buildPDRsUntil(recordHandle);
+
+    // Build FRU table if not built, since entity association PDR's
+    // are built when the FRU table is constructed.
+    if (fruHandler)
+    {
+        fruHandler->buildFRUTable();
+    }
+
+    // The cached responses are dropped on any PDR repository change,
+    // including the ones from the PDRRepositoryChgEvent handling
+    if (pdrResponseCacheGeneration != pldm::utils::getPdrRepoGeneration())
+    {
+        pdrResponseCache.clear();
+        pdrResponseCacheGeneration = pldm::utils::getPdrRepoGeneration();
+    }
+    // A record larger than the part is sent in parts, the data transfer
+    // handle is the offset of the part in the record
+    auto partLimit = std::min(
+        reqSizeBytes,
+        transfer::TransferSizes::get().requesterPartSize(UINT16_MAX));
+    if (transferOpFlag == PLDM_GET_FIRSTPART)
+    {
+        auto cached = pdrResponseCache.find({recordHandle, partLimit});
+        if (cached != pdrResponseCache.end())
+        {
+            response = responseCopy(cached->second);
+            auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+            responsePtr->hdr.instance_id = request->hdr.instance_id;
+            return response;
+        }
+    }
+    else if (transferOpFlag != PLDM_GET_NEXTPART)
+    {
+        return CmdHandler::ccOnlyResponse(
+            request, PLDM_PLATFORM_INVALID_TRANSFER_OPERATION_FLAG);
+    }
+
     try
     {
-        pdr_utils::PdrEntry e;
-        auto record = pdr::getRecordByHandle(pdrRepo, recordHandle, e);
-        if (record == NULL)
+        auto entry = pdrRepo.getIndex().getRecordByHandle(recordHandle);
+        if (entry == nullptr)
         {
             return CmdHandler::ccOnlyResponse(
                 request, PLDM_PLATFORM_INVALID_RECORD_HANDLE);
         }
 
-        if (reqSizeBytes)
+        size_t offset = 0;
+        if (transferOpFlag == PLDM_GET_NEXTPART)
+        {
+            if (!dataTransferHandle || dataTransferHandle >= entry->size)
+            {
+                return CmdHandler::ccOnlyResponse(
+                    request, PLDM_PLATFORM_INVALID_DATA_TRANSFER_HANDLE);
+            }
+            offset = dataTransferHandle;
+        }
+
+        uint16_t respSizeBytes = 0;
+        const uint8_t* recordData = nullptr;
+        uint8_t transferFlag = PLDM_START_AND_END;
+        uint32_t nextDataTransferHandle = 0;
+        uint8_t transferCRC = 0;
+        if (partLimit)
         {
-            respSizeBytes = e.size;
-            if (respSizeBytes > reqSizeBytes)
+            respSizeBytes = static_cast<uint16_t>(
+                std::min<size_t>(entry->size - offset, partLimit));
+            recordData = entry->data + offset;
+            auto nextOffset = offset + respSizeBytes;
+            bool morePart = nextOffset < entry->size;
+            transferFlag = offset ? (morePart ? PLDM_MIDDLE : PLDM_END)
+                                  : (morePart ? PLDM_START
+                                              : PLDM_START_AND_END);
+            nextDataTransferHandle = morePart
+                                         ? static_cast<uint32_t>(nextOffset)
+                                         : 0;
+            if (transferFlag == PLDM_END)
             {
-                respSizeBytes = reqSizeBytes;
+                transferCRC = crc8(entry->data, entry->size);
             }
-            recordData = e.data;
         }
-        response.resize(sizeof(pldm_msg_hdr) + PLDM_GET_PDR_MIN_RESP_BYTES +
-                            respSizeBytes,
-                        0);
+        response = responseBuffer(
+            PLDM_GET_PDR_MIN_RESP_BYTES + respSizeBytes +
+            (transferFlag == PLDM_END ? sizeof(transferCRC) : 0));
         auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
-        rc = encode_get_pdr_resp(
-            request->hdr.instance_id, PLDM_SUCCESS, e.handle.nextRecordHandle,
-            0, PLDM_START_AND_END, respSizeBytes, recordData, 0, responsePtr);
+        rc = encode_get_pdr_resp(request->hdr.instance_id, PLDM_SUCCESS,
+                                 entry->nextRecordHandle,
+                                 nextDataTransferHandle, transferFlag,
+                                 respSizeBytes, recordData, transferCRC,
+                                 responsePtr);
         if (rc != PLDM_SUCCESS)
         {
             return ccOnlyResponse(request, rc);
         }
+        if (!offset)
+        {
+            pdrResponseCache.emplace(std::make_pair(recordHandle, partLimit),
+                                     response);
+        }
     }
     catch (const std::exception& e)
     {
@@ -252,40 +576,55 @@ Response Handler::getPDR(const pldm_msg* request, size_t payloadLength)
     return response;
 }
 
-Response Handler::setStateEffecterStates(const pldm_msg* request,
-                                         size_t payloadLength)
+int Handler::decodeSetStateEffecterStates(
+    const pldm_msg* request, size_t payloadLength, uint16_t& effecterId,
+    std::vector<set_effecter_state_field>& stateField)
 {
-    Response response(
-        sizeof(pldm_msg_hdr) + PLDM_SET_STATE_EFFECTER_STATES_RESP_BYTES, 0);
-    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
-    uint16_t effecterId;
     uint8_t compEffecterCnt;
     constexpr auto maxCompositeEffecterCnt = 8;
-    std::vector<set_effecter_state_field> stateField(maxCompositeEffecterCnt,
-                                                     {0, 0});
+    stateField.assign(maxCompositeEffecterCnt, {0, 0});
 
     if ((payloadLength > PLDM_SET_STATE_EFFECTER_STATES_REQ_BYTES) ||
         (payloadLength < sizeof(effecterId) + sizeof(compEffecterCnt) +
                              sizeof(set_effecter_state_field)))
     {
-        return CmdHandler::ccOnlyResponse(request, PLDM_ERROR_INVALID_LENGTH);
+        return PLDM_ERROR_INVALID_LENGTH;
     }
 
     int rc = decode_set_state_effecter_states_req(request, payloadLength,
                                                   &effecterId, &compEffecterCnt,
                                                   stateField.data());
+    if (rc != PLDM_SUCCESS)
+    {
+        return rc;
+    }
+
+    stateField.resize(compEffecterCnt);
+    return PLDM_SUCCESS;
+}
+
+Response Handler::setStateEffecterStates(const pldm_msg* request,
+                                         size_t payloadLength)
+{
+    auto response = responseBuffer<PLDM_SET_STATE_EFFECTER_STATES_RESP_BYTES>();
+    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+    uint16_t effecterId{};
+    std::vector<set_effecter_state_field> stateField;
 
+    int rc = decodeSetStateEffecterStates(request, payloadLength, effecterId,
+                                          stateField);
     if (rc != PLDM_SUCCESS)
     {
         return CmdHandler::ccOnlyResponse(request, rc);
     }
 
-    stateField.resize(compEffecterCnt);
+    uint8_t compEffecterCnt = stateField.size();
     const pldm::utils::DBusHandler dBusIntf;
     uint16_t entityType{};
     uint16_t entityInstance{};
     uint16_t stateSetId{};
 
+    buildDbusObjMaps();
     if (isOemStateEffecter(*this, effecterId, compEffecterCnt, entityType,
                            entityInstance, stateSetId) &&
         oemPlatformHandler != nullptr &&
@@ -316,6 +655,109 @@ Response Handler::setStateEffecterStates(const pldm_msg* request,
     return response;
 }
 
+void Handler::setStateEffecterStatesAsync(const pldm_msg* request,
+                                          size_t payloadLength,
+                                          ResponseSender&& respond)
+{
+    uint16_t effecterId{};
+    std::vector<set_effecter_state_field> stateField;
+    int rc = decodeSetStateEffecterStates(request, payloadLength, effecterId,
+                                          stateField);
+    if (rc != PLDM_SUCCESS)
+    {
+        respond(CmdHandler::ccOnlyResponse(request, rc));
+        return;
+    }
+
+    uint16_t entityType{};
+    uint16_t entityInstance{};
+    uint16_t stateSetId{};
+    buildDbusObjMaps();
+    if (isOemStateEffecter(*this, effecterId, stateField.size(), entityType,
+                           entityInstance, stateSetId) &&
+        oemPlatformHandler != nullptr &&
+        !effecterDbusObjMaps.contains(effecterId))
+    {
+        respond(setStateEffecterStates(request, payloadLength));
+        return;
+    }
+
+    std::vector<platform_state_effecter::PropertySet> sets;
+    rc = platform_state_effecter::getStateEffecterSets(*this, effecterId,
+                                                       stateField, sets);
+    if (rc != PLDM_SUCCESS)
+    {
+        respond(CmdHandler::ccOnlyResponse(request, rc));
+        return;
+    }
+    platform_state_effecter::deduplicateSets(sets);
+
+    /* The sets are sent together and the response waits for all of them */
+    struct Batch
+    {
+        Response requestHdr;
+        ResponseSender respond;
+        size_t pending = 0;
+        int rc = PLDM_SUCCESS;
+    };
+    auto batch = std::make_shared<Batch>();
+    batch->requestHdr.assign(reinterpret_cast<const uint8_t*>(request),
+                             reinterpret_cast<const uint8_t*>(request) +
+                                 sizeof(pldm_msg_hdr));
+    batch->respond = std::move(respond);
+    auto finish = [](Batch& batch) {
+        batch.respond(CmdHandler::ccOnlyResponse(
+            reinterpret_cast<const pldm_msg*>(batch.requestHdr.data()),
+            batch.rc));
+    };
+
+    auto& bus = DBusHandler::getBus();
+    const DBusHandler dBusIntf;
+    for (const auto& set : sets)
+    {
+        const auto& dbusMapping = set.first;
+        try
+        {
+            auto method = dBusIntf.newSetPropertyCall(dbusMapping, set.second);
+            batch->pending++;
+            dbusCalls.call(bus, method,
+                           [batch, finish,
+                            dbusMapping](sdbusplus::message_t& reply) {
+                if (reply.is_method_error())
+                {
+                    error(
+                        "Error setting property, ERRNO={ERRNO} PROPERTY={DBUS_PROP} INTERFACE={DBUS_INTF} PATH={DBUS_OBJ_PATH}",
+                        "ERRNO", reply.get_errno(), "DBUS_PROP",
+                        dbusMapping.propertyName, "DBUS_INTF",
+                        dbusMapping.interface, "DBUS_OBJ_PATH",
+                        dbusMapping.objectPath.c_str());
+                    batch->rc = PLDM_ERROR;
+                }
+                if (--batch->pending == 0)
+                {
+                    finish(*batch);
+                }
+            });
+        }
+        catch (const std::exception& e)
+        {
+            error(
+                "Error setting property, ERROR={ERR_EXCEP} PROPERTY={DBUS_PROP} INTERFACE={DBUS_INTF} PATH={DBUS_OBJ_PATH}",
+                "ERR_EXCEP", e.what(), "DBUS_PROP", dbusMapping.propertyName,
+                "DBUS_INTF", dbusMapping.interface, "DBUS_OBJ_PATH",
+                dbusMapping.objectPath.c_str());
+            batch->pending--;
+            batch->rc = PLDM_ERROR;
+            break;
+        }
+    }
+
+    if (batch->pending == 0)
+    {
+        finish(*batch);
+    }
+}
+
 Response Handler::platformEventMessage(const pldm_msg* request,
                                        size_t payloadLength)
 {
@@ -338,34 +780,37 @@ Response Handler::platformEventMessage(const pldm_msg* request,
         {
             oemPlatformHandler->resetWatchDogTimer();
         }
+        /* The heartbeat of a terminus refreshes its liveness, the event is
+         * acknowledged whatever the handlers return */
+        for (const auto& handler :
+             eventHandlers[PLDM_HEARTBEAT_TIMER_ELAPSED_EVENT])
+        {
+            handler(request, payloadLength, formatVersion, tid, offset);
+        }
     }
     else
     {
-        try
+        const auto& handlers = eventHandlers[eventClass];
+        if (handlers.empty())
         {
-            const auto& handlers = eventHandlers.at(eventClass);
-            bool handled = false;
-            for (const auto& handler : handlers)
-            {
-                auto rc = handler(request, payloadLength, formatVersion, tid,
-                                  offset);
-                if (rc == PLDM_SUCCESS)
-                {
-                    handled = true;
-                }
-            }
-            if (handled == false)
+            return CmdHandler::ccOnlyResponse(request, PLDM_ERROR_INVALID_DATA);
+        }
+        bool handled = false;
+        for (const auto& handler : handlers)
+        {
+            auto rc = handler(request, payloadLength, formatVersion, tid,
+                              offset);
+            if (rc == PLDM_SUCCESS)
             {
-                return CmdHandler::ccOnlyResponse(request, rc);
+                handled = true;
             }
         }
-        catch (const std::out_of_range& e)
+        if (handled == false)
         {
-            return CmdHandler::ccOnlyResponse(request, PLDM_ERROR_INVALID_DATA);
+            return CmdHandler::ccOnlyResponse(request, rc);
         }
     }
-    Response response(
-        sizeof(pldm_msg_hdr) + PLDM_PLATFORM_EVENT_MESSAGE_RESP_BYTES, 0);
+    auto response = responseBuffer<PLDM_PLATFORM_EVENT_MESSAGE_RESP_BYTES>();
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     rc = encode_platform_event_message_resp(request->hdr.instance_id, rc,
@@ -416,7 +861,7 @@ int Handler::sensorEvent(const pldm_msg* request, size_t payloadLength,
         }
 
 #ifdef AMPERE
-        std::string ampere_scripts = AMPERE_PLDM_EVENT_HANDLER;
+        std::pmr::string ampere_scripts(AMPERE_PLDM_EVENT_HANDLER, arena());
         if (std::filesystem::exists(ampere_scripts))
         {
             ampere_scripts += " " + std::to_string(PLDM_SENSOR_EVENT);
@@ -438,7 +883,8 @@ int Handler::sensorEvent(const pldm_msg* request, size_t payloadLength,
                                    previousEventState);
 
         // If there are no HOST PDR's, there is no further action
-        if (hostPDRHandler == NULL)
+        auto hostHandler = hostPDRHandlerOf(tid);
+        if (hostHandler == NULL)
         {
             return PLDM_SUCCESS;
         }
@@ -446,31 +892,21 @@ int Handler::sensorEvent(const pldm_msg* request, size_t payloadLength,
         // Handle PLDM events for which PDR is available
         SensorEntry sensorEntry{tid, sensorId};
 
-        pldm::pdr::EntityInfo entityInfo{};
-        pldm::pdr::CompositeSensorStates compositeSensorStates{};
-
-        try
-        {
-            std::tie(entityInfo, compositeSensorStates) =
-                hostPDRHandler->lookupSensorInfo(sensorEntry);
-        }
-        catch (const std::out_of_range& e)
+        auto sensorInfo = hostHandler->findSensorInfo(sensorEntry);
+        if (sensorInfo == nullptr)
         {
             // If there is no mapping for tid, sensorId combination, try
             // PLDM_TID_RESERVED, sensorId for terminus that is yet to
             // implement TL PDR.
-            try
-            {
-                sensorEntry.terminusID = PLDM_TID_RESERVED;
-                std::tie(entityInfo, compositeSensorStates) =
-                    hostPDRHandler->lookupSensorInfo(sensorEntry);
-            }
-            // If there is no mapping for events return PLDM_SUCCESS
-            catch (const std::out_of_range& e)
-            {
-                return PLDM_SUCCESS;
-            }
+            sensorEntry.terminusID = PLDM_TID_RESERVED;
+            sensorInfo = hostHandler->findSensorInfo(sensorEntry);
         }
+        // If there is no mapping for events return PLDM_SUCCESS
+        if (sensorInfo == nullptr)
+        {
+            return PLDM_SUCCESS;
+        }
+        const auto& [entityInfo, compositeSensorStates] = *sensorInfo;
 
         if (sensorOffset >= compositeSensorStates.size())
         {
@@ -486,7 +922,7 @@ int Handler::sensorEvent(const pldm_msg* request, size_t payloadLength,
         const auto& [containerId, entityType, entityInstance] = entityInfo;
         events::StateSensorEntry stateSensorEntry{containerId, entityType,
                                                   entityInstance, sensorOffset};
-        return hostPDRHandler->handleStateSensorEvent(stateSensorEntry,
+        return hostHandler->handleStateSensorEvent(stateSensorEntry,
                                                       eventState);
     }
     else if (eventClass == PLDM_NUMERIC_SENSOR_STATE)
@@ -506,7 +942,7 @@ int Handler::sensorEvent(const pldm_msg* request, size_t payloadLength,
         }
 
 #ifdef AMPERE
-        std::string ampere_scripts = AMPERE_PLDM_EVENT_HANDLER;
+        std::pmr::string ampere_scripts(AMPERE_PLDM_EVENT_HANDLER, arena());
         if (std::filesystem::exists(ampere_scripts))
         {
             ampere_scripts += " " + std::to_string(PLDM_SENSOR_EVENT);
@@ -529,7 +965,7 @@ int Handler::sensorEvent(const pldm_msg* request, size_t payloadLength,
     {
 
 #ifdef AMPERE
-        std::string ampere_scripts = AMPERE_PLDM_EVENT_HANDLER;
+        std::pmr::string ampere_scripts(AMPERE_PLDM_EVENT_HANDLER, arena());
         if (std::filesystem::exists(ampere_scripts))
         {
             ampere_scripts += " " + std::to_string(PLDM_SENSOR_EVENT);
@@ -575,7 +1011,7 @@ int Handler::pldmMsgPollEvent(const pldm_msg* request, size_t payloadLength,
     }
 
 #ifdef AMPERE
-        std::string ampere_scripts = AMPERE_PLDM_EVENT_HANDLER;
+        std::pmr::string ampere_scripts(AMPERE_PLDM_EVENT_HANDLER, arena());
         if (std::filesystem::exists(ampere_scripts))
         {
             ampere_scripts += " " + std::to_string(PLDM_MESSAGE_POLL_EVENT);
@@ -616,6 +1052,7 @@ int Handler::pldmPDRRepositoryChgEvent(const pldm_msg* request,
     }
 
     PDRRecordHandles pdrRecordHandles;
+    auto hostHandler = hostPDRHandlerOf(tid);
 
     if (eventDataFormat == FORMAT_IS_PDR_TYPES)
     {
@@ -644,9 +1081,10 @@ int Handler::pldmPDRRepositoryChgEvent(const pldm_msg* request,
             if (eventDataOperation == PLDM_RECORDS_ADDED ||
                 eventDataOperation == PLDM_RECORDS_MODIFIED)
             {
-                if (eventDataOperation == PLDM_RECORDS_MODIFIED)
+                if (eventDataOperation == PLDM_RECORDS_MODIFIED &&
+                    hostHandler)
                 {
-                    hostPDRHandler->isHostPdrModified = true;
+                    hostHandler->isHostPdrModified = true;
                 }
 
                 rc = getPDRRecordHandles(
@@ -668,7 +1106,7 @@ int Handler::pldmPDRRepositoryChgEvent(const pldm_msg* request,
                 dataOffset + (numberOfChangeEntries * sizeof(ChangeEntry));
         }
     }
-    if (hostPDRHandler)
+    if (hostHandler)
     {
         // if we get a Repository change event with the eventDataFormat
         // as REFRESH_ENTIRE_REPOSITORY, then delete all the PDR's that
@@ -678,14 +1116,20 @@ int Handler::pldmPDRRepositoryChgEvent(const pldm_msg* request,
             // We cannot get the Repo change event from the Terminus
             // that is not already added to the BMC repository
 
-            for (auto it = hostPDRHandler->tlPDRInfo.cbegin();
-                 it != hostPDRHandler->tlPDRInfo.cend();)
+            for (auto it = hostHandler->tlPDRInfo.cbegin();
+                 it != hostHandler->tlPDRInfo.cend();)
             {
                 if (std::get<0>(it->second) == tid)
                 {
+                    // The PDRs of each host have their own terminus handles
+                    auto terminusHandle =
+                        it->first == TERMINUS_HANDLE
+                            ? it->first
+                            : hostHandler->toRepoTerminusHandle(it->first);
                     pldm_pdr_remove_pdrs_by_terminus_handle(pdrRepo.getPdr(),
-                                                            it->first);
-                    hostPDRHandler->tlPDRInfo.erase(it++);
+                                                            terminusHandle);
+                    pldm::utils::notifyPdrRepoChanged();
+                    hostHandler->tlPDRInfo.erase(it++);
                 }
                 else
                 {
@@ -693,7 +1137,7 @@ int Handler::pldmPDRRepositoryChgEvent(const pldm_msg* request,
                 }
             }
         }
-        hostPDRHandler->fetchPDR(std::move(pdrRecordHandles));
+        hostHandler->fetchPDR(std::move(pdrRecordHandles));
     }
 
     return PLDM_SUCCESS;
@@ -759,7 +1203,7 @@ Response Handler::getNumericEffecterValue(const pldm_msg* request,
                                    getEffecterDataSize(effecterDataSize) +
                                    getEffecterDataSize(effecterDataSize);
 
-    Response response(responsePayloadLength + sizeof(pldm_msg_hdr));
+    auto response = responseBuffer(responsePayloadLength);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     rc = platform_numeric_effecter::getNumericEffecterValueHandler(
@@ -779,8 +1223,7 @@ Response Handler::getNumericEffecterValue(const pldm_msg* request,
 Response Handler::setNumericEffecterValue(const pldm_msg* request,
                                           size_t payloadLength)
 {
-    Response response(sizeof(pldm_msg_hdr) +
-                      PLDM_SET_NUMERIC_EFFECTER_VALUE_RESP_BYTES);
+    auto response = responseBuffer<PLDM_SET_NUMERIC_EFFECTER_VALUE_RESP_BYTES>();
     uint16_t effecterId{};
     uint8_t effecterDataSize{};
     uint8_t effecterValue[4] = {};
@@ -839,6 +1282,73 @@ void Handler::generateTerminusLocatorPDR(Repo& repo)
             pdr->terminus_handle,
             std::make_tuple(pdr->tid, locatorValue->eid, pdr->validity));
     }
+    for (auto otherHost : otherHostPDRHandlers)
+    {
+        otherHost->tlPDRInfo.insert_or_assign(
+            pdr->terminus_handle,
+            std::make_tuple(pdr->tid, locatorValue->eid, pdr->validity));
+    }
+}
+
+void Handler::addHost(
+    HostPDRHandler* otherHostPDRHandler,
+    pldm::state_sensor::DbusToPLDMEvent* otherDbusToPLDMEventHandler)
+{
+    if (otherHostPDRHandler)
+    {
+        // The terminus locator PDR of the BMC may be built already
+        if (hostPDRHandler)
+        {
+            auto bmc = hostPDRHandler->tlPDRInfo.find(TERMINUS_HANDLE);
+            if (bmc != hostPDRHandler->tlPDRInfo.end())
+            {
+                otherHostPDRHandler->tlPDRInfo.insert_or_assign(bmc->first,
+                                                                bmc->second);
+            }
+        }
+        otherHostPDRHandlers.emplace_back(otherHostPDRHandler);
+    }
+    if (otherDbusToPLDMEventHandler)
+    {
+        otherDbusToPLDMEventHandlers.emplace_back(otherDbusToPLDMEventHandler);
+    }
+}
+
+HostPDRHandler* Handler::hostPDRHandlerOf(uint8_t tid) const
+{
+    if (otherHostPDRHandlers.empty())
+    {
+        return hostPDRHandler;
+    }
+    std::vector<HostPDRHandler*> hosts;
+    if (hostPDRHandler)
+    {
+        hosts.emplace_back(hostPDRHandler);
+    }
+    hosts.insert(hosts.end(), otherHostPDRHandlers.begin(),
+                 otherHostPDRHandlers.end());
+    for (auto host : hosts)
+    {
+        auto hasTerminus = std::any_of(host->tlPDRInfo.begin(),
+                                       host->tlPDRInfo.end(),
+                                       [tid](const auto& terminus) {
+            return terminus.first != TERMINUS_HANDLE &&
+                   std::get<0>(terminus.second) == tid;
+        });
+        if (hasTerminus)
+        {
+            return host;
+        }
+    }
+    // TID = EID of the host firmware until it sent its terminus locators
+    for (auto host : hosts)
+    {
+        if (host->getHostEID() == tid)
+        {
+            return host;
+        }
+    }
+    return hosts.front();
 }
 
 Response Handler::getStateSensorReadings(const pldm_msg* request,
@@ -871,6 +1381,7 @@ Response Handler::getStateSensorReadings(const pldm_msg* request,
     uint16_t entityInstance{};
     uint16_t stateSetId{};
 
+    buildDbusObjMaps();
     if (isOemStateSensor(*this, sensorId, sensorRearmCount, comSensorCnt,
                          entityType, entityInstance, stateSetId) &&
         oemPlatformHandler != nullptr && !sensorDbusObjMaps.contains(sensorId))
@@ -891,9 +1402,9 @@ Response Handler::getStateSensorReadings(const pldm_msg* request,
         return ccOnlyResponse(request, rc);
     }
 
-    Response response(sizeof(pldm_msg_hdr) +
-                      PLDM_GET_STATE_SENSOR_READINGS_MIN_RESP_BYTES +
-                      sizeof(get_sensor_state_field) * comSensorCnt);
+    auto response = responseBuffer(
+        PLDM_GET_STATE_SENSOR_READINGS_MIN_RESP_BYTES +
+        sizeof(get_sensor_state_field) * comSensorCnt);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
     rc = encode_get_state_sensor_readings_resp(request->hdr.instance_id, rc,
                                                comSensorCnt, stateField.data(),
@@ -910,7 +1421,88 @@ void Handler::_processPostGetPDRActions(sdeventplus::source::EventBase&
                                         /*source */)
 {
     deferredGetPDREvent.reset();
-    dbusToPLDMEventHandler->listenSensorEvent(pdrRepo, sensorDbusObjMaps);
+    buildDbusObjMaps();
+    if (dbusToPLDMEventHandler)
+    {
+        dbusToPLDMEventHandler->listenSensorEvent(pdrRepo, sensorDbusObjMaps);
+    }
+    for (auto otherHost : otherDbusToPLDMEventHandlers)
+    {
+        otherHost->listenSensorEvent(pdrRepo, sensorDbusObjMaps);
+    }
+}
+
+bool Handler::buildNextPDRs()
+{
+    switch (pdrBuildStep++)
+    {
+        case 0:
+            generateTerminusLocatorPDR(pdrRepo);
+            break;
+        case 1:
+            if (fruHandler)
+            {
+                fruHandler->buildFRUTable();
+            }
+            break;
+        case 2:
+            generate(*dBusIntf, pdrJsonsDir, pdrRepo, PLDM_STATE_SENSOR_PDR);
+            break;
+        case 3:
+            generate(*dBusIntf, pdrJsonsDir, pdrRepo, PLDM_STATE_EFFECTER_PDR);
+            break;
+        case 4:
+            generate(*dBusIntf, pdrJsonsDir, pdrRepo,
+                     PLDM_NUMERIC_EFFECTER_PDR);
+            break;
+        case 5:
+            if (oemPlatformHandler != nullptr)
+            {
+                oemPlatformHandler->buildOEMPDR(pdrRepo);
+            }
+            break;
+        default:
+            pdrCreated = true;
+            pdrBuildEvent.reset();
+            // Build the record handle index once for the GetPDR sweep
+            pdrRepo.getIndex().getRecordByHandle(0);
+            info("Built the BMC PDRs, RECORDS={RECORDS}", "RECORDS",
+                 pdrRepo.getRecordCount());
+
+            if (dbusToPLDMEventHandler ||
+                !otherDbusToPLDMEventHandlers.empty())
+            {
+                deferredGetPDREvent =
+                    std::make_unique<sdeventplus::source::Defer>(
+                        event,
+                        std::bind(std::mem_fn(
+                                      &Handler::_processPostGetPDRActions),
+                                  this, std::placeholders::_1));
+            }
+            return false;
+    }
+    return true;
+}
+
+void Handler::buildPDRsUntil(uint32_t recordHandle)
+{
+    while (!pdrCreated)
+    {
+        // The last record has no next record handle until the next one is
+        // added, a missing record may still be built
+        auto entry = pdrRepo.getIndex().getRecordByHandle(recordHandle);
+        if (entry != nullptr && entry->nextRecordHandle != 0)
+        {
+            return;
+        }
+        buildNextPDRs();
+    }
+}
+
+void Handler::buildPDRsInBackground(sdeventplus::source::EventBase& /*source*/)
+{
+    // Destroys the event source once the last step is done
+    buildNextPDRs();
 }
 
 bool isOemStateSensor(Handler& handler, uint16_t sensorId,
@@ -6,6 +6,7 @@
 #include "host-bmc/dbus_to_event_handler.hpp"
 #include "host-bmc/host_pdr_handler.hpp"
 #include "libpldmresponder/pdr.hpp"
+#include "libpldmresponder/pdr_cache.hpp"
 #include "libpldmresponder/pdr_utils.hpp"
 #include "oem_handler.hpp"
 #include "pldmd/handler.hpp"
@@ -14,9 +15,11 @@
 #include <libpldm/platform.h>
 #include <libpldm/states.h>
 #include <stdint.h>
+#include <systemd/sd-event.h>
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <array>
 #include <map>
 
 PHOSPHOR_LOG2_USING;
@@ -68,6 +71,15 @@ class Handler : public CmdHandler
             generate(*dBusIntf, pdrJsonsDir, pdrRepo);
             pdrCreated = true;
         }
+#ifdef PDR_BACKGROUND_BUILD
+        else
+        {
+            pdrBuildEvent = std::make_unique<sdeventplus::source::Defer>(
+                event, std::bind(std::mem_fn(&Handler::buildPDRsInBackground),
+                                 this, std::placeholders::_1));
+            pdrBuildEvent->set_priority(SD_EVENT_PRIORITY_IDLE);
+        }
+#endif
 
         handlers.emplace(PLDM_GET_PDR,
                          [this](const pldm_msg* request, size_t payloadLength) {
@@ -85,6 +97,13 @@ class Handler : public CmdHandler
                          [this](const pldm_msg* request, size_t payloadLength) {
             return this->setStateEffecterStates(request, payloadLength);
         });
+        asyncHandlers.emplace(PLDM_SET_STATE_EFFECTER_STATES,
+                              [this](const pldm_msg* request,
+                                     size_t payloadLength,
+                                     ResponseSender&& respond) {
+            this->setStateEffecterStatesAsync(request, payloadLength,
+                                              std::move(respond));
+        });
         handlers.emplace(PLDM_PLATFORM_EVENT_MESSAGE,
                          [this](const pldm_msg* request, size_t payloadLength) {
             return this->platformEventMessage(request, payloadLength);
@@ -120,21 +139,12 @@ class Handler : public CmdHandler
         // standard handlers
         if (addOnHandlersMap)
         {
-            auto addOnHandlers = addOnHandlersMap.value();
-            for (EventMap::iterator iter = addOnHandlers.begin();
-                 iter != addOnHandlers.end(); ++iter)
+            for (const auto& [eventClass, addOnHandlers] : *addOnHandlersMap)
             {
-                auto search = eventHandlers.find(iter->first);
-                if (search != eventHandlers.end())
-                {
-                    search->second.insert(std::end(search->second),
-                                          std::begin(iter->second),
-                                          std::end(iter->second));
-                }
-                else
-                {
-                    eventHandlers.emplace(iter->first, iter->second);
-                }
+                auto& classHandlers = eventHandlers[eventClass];
+                classHandlers.insert(std::end(classHandlers),
+                                     std::begin(addOnHandlers),
+                                     std::end(addOnHandlers));
             }
         }
     }
@@ -159,7 +169,8 @@ class Handler : public CmdHandler
         pldm::responder::pdr_utils::TypeId typeId =
             pldm::responder::pdr_utils::TypeId::PLDM_EFFECTER_ID);
 
-    /** @brief Retrieve an id -> D-Bus objects mapping
+    /** @brief Retrieve an id -> D-Bus objects mapping, the maps of the PDRs
+     *         loaded from the cache are built on the first call
      *
      *  @param[in] Id - id
      *  @param[in] typeId - the type id of enum
@@ -172,7 +183,7 @@ class Handler : public CmdHandler
         getDbusObjMaps(
             uint16_t id,
             pldm::responder::pdr_utils::TypeId typeId =
-                pldm::responder::pdr_utils::TypeId::PLDM_EFFECTER_ID) const;
+                pldm::responder::pdr_utils::TypeId::PLDM_EFFECTER_ID);
 
     uint16_t getNextEffecterId()
     {
@@ -189,10 +200,28 @@ class Handler : public CmdHandler
      *  @param[in] dBusIntf - The interface object
      *  @param[in] dir - directory housing platform specific PDR JSON files
      *  @param[in] repo - instance of concrete implementation of Repo
+     *  @param[in] onlyType - build only the PDRs of this type
      */
     void generate(const pldm::utils::DBusHandler& dBusIntf,
                   const std::string& dir,
-                  pldm::responder::pdr_utils::Repo& repo);
+                  pldm::responder::pdr_utils::Repo& repo,
+                  std::optional<pldm::responder::pdr_utils::Type> onlyType =
+                      std::nullopt);
+
+    /** @brief Build the D-Bus object maps of the PDRs loaded from the cache,
+     *         no-op once they are built
+     */
+    void buildDbusObjMaps();
+
+    /** @brief Resolve the services of all the D-Bus interfaces mapped by the
+     *         PDR JSONs with one mapper GetSubTree call, so the generators
+     *         find them in the service cache
+     *
+     *  @param[in] dBusIntf - The interface object
+     *  @param[in] dir - directory housing platform specific PDR JSON files
+     */
+    void prefetchServices(const pldm::utils::DBusHandler& dBusIntf,
+                          const std::string& dir);
 
     /** @brief Parse PDR JSONs and build state effecter PDR repository
      *
@@ -202,10 +231,11 @@ class Handler : public CmdHandler
     void generateStateEffecterRepo(const pldm::utils::Json& json,
                                    pldm::responder::pdr_utils::Repo& repo);
 
-    /** @brief map of PLDM event type to EventHandlers
-     *
+    /** @brief EventHandlers of each PLDM event class, indexed by the class
+     *         so a PlatformEventMessage finds its handlers without a lookup,
+     *         the classes without a handler are empty
      */
-    EventMap eventHandlers;
+    std::array<EventHandlers, UINT8_MAX + 1> eventHandlers;
 
     /** @brief Handler for GetPDR
      *
@@ -251,6 +281,30 @@ class Handler : public CmdHandler
     Response setStateEffecterStates(const pldm_msg* request,
                                     size_t payloadLength);
 
+    /** @brief Handler for setStateEffecterStates which sets the D-Bus
+     *         properties of the fields in parallel, without blocking. The
+     *         response is sent once all the sets are done.
+     *
+     *  @param[in] request - Request message
+     *  @param[in] payloadLength - Request payload length
+     *  @param[in] respond - sends the response
+     */
+    void setStateEffecterStatesAsync(const pldm_msg* request,
+                                     size_t payloadLength,
+                                     ResponseSender&& respond);
+
+    /** @brief Decode a setStateEffecterStates request
+     *
+     *  @param[in] request - Request message
+     *  @param[in] payloadLength - Request payload length
+     *  @param[out] effecterId - Effecter ID of the request
+     *  @param[out] stateField - state fields of the request
+     *  @return PLDM completion code
+     */
+    static int decodeSetStateEffecterStates(
+        const pldm_msg* request, size_t payloadLength, uint16_t& effecterId,
+        std::vector<set_effecter_state_field>& stateField);
+
     /** @brief Handler for PlatformEventMessage
      *
      *  @param[in] request - Request message
@@ -385,6 +439,7 @@ class Handler : public CmdHandler
         }
 
         int rc = PLDM_SUCCESS;
+        buildDbusObjMaps();
         try
         {
             const auto& [dbusMappings,
@@ -480,7 +535,104 @@ class Handler : public CmdHandler
      */
     void _processPostGetPDRActions(sdeventplus::source::EventBase& source);
 
+    /** @brief Run the next step of the lazy PDR build
+     *
+     *  The PDRs are built in steps, the terminus locator PDR first, then the
+     *  FRU table with the entity association PDRs, the PDRs of the JSONs one
+     *  PDR type at a time with the state sensors first, and the OEM PDRs.
+     *
+     *  @return false once all the PDRs are built
+     */
+    bool buildNextPDRs();
+
+    /** @brief Build the PDRs until a record and the one after it exist, so
+     *         the next record handle of its GetPDR response is final
+     *
+     *  @param[in] recordHandle - record handle of the GetPDR request
+     */
+    void buildPDRsUntil(uint32_t recordHandle);
+
+    /** @brief Build one step of the PDRs from the idle event source
+     *  @param[in] source - sdeventplus event source
+     */
+    void buildPDRsInBackground(sdeventplus::source::EventBase& source);
+
+    /** @brief Add another host of a multi-host system, the host of the
+     *         constructor is the first one
+     *
+     *  @param[in] hostPDRHandler - PDR exchange with the host
+     *  @param[in] dbusToPLDMEventHandler - state sensor events to the host
+     */
+    void addHost(HostPDRHandler* hostPDRHandler,
+                 pldm::state_sensor::DbusToPLDMEvent* dbusToPLDMEventHandler);
+
   private:
+    /** @brief Host PDR handler of the terminus of an event
+     *
+     *  @details The host whose terminus locator PDRs have the TID, else the
+     *  host of the EID equal to the TID, else the first host.
+     *
+     *  @param[in] tid - TID of the terminus
+     *
+     *  @return - the handler, nullptr if there is no host
+     */
+    HostPDRHandler* hostPDRHandlerOf(uint8_t tid) const;
+
+    /** @brief Parse PDR JSONs and build PDR repository, see generate()
+     *
+     *  @return - false if a JSON or one of its PDRs failed
+     */
+    bool generatePDRs(const pldm::utils::DBusHandler& dBusIntf,
+                      const std::string& dir,
+                      pldm::responder::pdr_utils::Repo& repo,
+                      std::optional<pldm::responder::pdr_utils::Type> onlyType);
+
+#ifdef BMC_PDR_CACHE_DIR
+    /** @brief Key of the inputs of a generation: the PDR JSONs, the mapper
+     *         subtree of their mappings, the FRU entities and the next IDs
+     *
+     *  @return - the key, unset while the mapper subtree is unknown
+     */
+    std::optional<uint64_t>
+        pdrCacheKey(const std::string& dir,
+                    std::optional<pldm::responder::pdr_utils::Type> onlyType);
+
+    /** @brief Add the PDRs of a generation from the cache file
+     *
+     *  @return - true if the cache file has the PDRs of the key
+     */
+    bool loadCachedPDRs(const std::filesystem::path& path, uint64_t key,
+                        const pldm::utils::DBusHandler& dBusIntf,
+                        const std::string& dir,
+                        pldm::responder::pdr_utils::Repo& repo,
+                        std::optional<pldm::responder::pdr_utils::Type>
+                            onlyType);
+
+    /** @brief Save the PDRs of a generation, from the record index first
+     *         of the repository, to the cache file
+     */
+    void saveCachedPDRs(const std::filesystem::path& path, uint64_t key,
+                        pldm::responder::pdr_utils::Repo& repo,
+                        uint32_t first);
+
+    /** @struct CachedGeneration
+     *  @brief Generation loaded from the cache, replayed to build its D-Bus
+     *  object maps
+     */
+    struct CachedGeneration
+    {
+        const pldm::utils::DBusHandler* dBusIntf;
+        std::string dir;
+        std::optional<pldm::responder::pdr_utils::Type> onlyType;
+        pdr::PdrCacheIds ids; //!< Next IDs before the generation
+    };
+
+    /** @brief Hash of the mapper subtree of the PDR mappings */
+    std::optional<uint64_t> inventoryKey;
+    /** @brief Generations whose D-Bus object maps are not built yet */
+    std::vector<CachedGeneration> cachedGenerations;
+#endif
+
     pdr_utils::Repo pdrRepo;
     uint16_t nextEffecterId{};
     uint16_t nextSensorId{};
@@ -488,6 +640,10 @@ class Handler : public CmdHandler
     DbusObjMaps sensorDbusObjMaps{};
     HostPDRHandler* hostPDRHandler;
     pldm::state_sensor::DbusToPLDMEvent* dbusToPLDMEventHandler;
+    /** @brief Hosts added after the first one */
+    std::vector<HostPDRHandler*> otherHostPDRHandlers;
+    std::vector<pldm::state_sensor::DbusToPLDMEvent*>
+        otherDbusToPLDMEventHandlers;
     fru::Handler* fruHandler;
     const pldm::utils::DBusHandler* dBusIntf;
     pldm::responder::oem_platform::Handler* oemPlatformHandler;
@@ -495,6 +651,18 @@ class Handler : public CmdHandler
     std::string pdrJsonsDir;
     bool pdrCreated;
     std::unique_ptr<sdeventplus::source::Defer> deferredGetPDREvent;
+    /** @brief Next step of the lazy PDR build */
+    size_t pdrBuildStep = 0;
+    /** @brief Idle event source running the lazy PDR build */
+    std::unique_ptr<sdeventplus::source::Defer> pdrBuildEvent;
+    /** @brief Encoded GetPDR responses by record handle and response size,
+     *  only the instance ID is patched when one is reused
+     */
+    std::map<std::pair<uint32_t, uint16_t>, Response> pdrResponseCache;
+    /** @brief PDR repository generation of the cached responses */
+    uint64_t pdrResponseCacheGeneration = 0;
+    /** @brief D-Bus calls of the requests answered asynchronously */
+    pldm::utils::AsyncCalls dbusCalls;
 };
 
 /** @brief Function to check if a sensor falls in OEM range
@@ -545,10 +545,9 @@ int getNumericEffecterData(const DBusInterface& dBusIntf, Handler& handler,
                 dbusMappings[0].objectPath, dbusMappings[0].interface,
                 dbusMappings[0].propertyName, dbusMappings[0].propertyType};
 
-            propertyValue = dBusIntf.getDbusPropertyVariant(
-                dbusMapping.objectPath.c_str(),
-                dbusMapping.propertyName.c_str(),
-                dbusMapping.interface.c_str());
+            propertyValue =
+                pldm::utils::PropertyCache::get().getDbusPropertyVariant(
+                    dBusIntf, dbusMapping);
             propertyType = dbusMappings[0].propertyType;
         }
     }
@@ -11,7 +11,13 @@
 #include <phosphor-logging/lg2.hpp>
 
 #include <cstdint>
+#include <iterator>
 #include <map>
+#include <set>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 PHOSPHOR_LOG2_USING;
 
@@ -21,27 +27,30 @@ namespace responder
 {
 namespace platform_state_effecter
 {
-/** @brief Function to set the effecter requested by pldm requester
+/** @brief D-Bus property and value set for a field of a state effecter */
+using PropertySet =
+    std::pair<pldm::utils::DBusMapping, pldm::utils::PropertyValue>;
+
+/** @brief Function to validate the state fields requested by pldm requester
+ *         and get the D-Bus properties to set for them
  *
- *  @tparam[in] DBusInterface - DBus interface type
  *  @tparam[in] Handler - pldm::responder::platform::Handler
- *  @param[in] dBusIntf - The interface object of DBusInterface
  *  @param[in] handler - The interface object of
  *             pldm::responder::platform::Handler
  *  @param[in] effecterId - Effecter ID sent by the requester to act on
  *  @param[in] stateField - The state field data for each of the states,
  * equal to composite effecter count in number
- *  @return - Success or failure in setting the states. Returns failure in
- * terms of PLDM completion codes if atleast one state fails to be set
+ *  @param[out] sets - D-Bus properties and values, in the order of the fields
+ *  @return - PLDM completion code, nothing is to be set on a failure
  */
-template <class DBusInterface, class Handler>
-int setStateEffecterStatesHandler(
-    const DBusInterface& dBusIntf, Handler& handler, uint16_t effecterId,
-    const std::vector<set_effecter_state_field>& stateField)
+template <class Handler>
+int getStateEffecterSets(
+    Handler& handler, uint16_t effecterId,
+    const std::vector<set_effecter_state_field>& stateField,
+    std::vector<PropertySet>& sets)
 {
     using namespace pldm::responder::pdr;
     using namespace pldm::utils;
-    using StateSetNum = uint8_t;
 
     state_effecter_possible_states* states = nullptr;
     pldm_state_effecter_pdr* pdr = nullptr;
@@ -93,14 +102,12 @@ int setStateEffecterStatesHandler(
         return PLDM_PLATFORM_INVALID_EFFECTER_ID;
     }
 
-    int rc = PLDM_SUCCESS;
     try
     {
         const auto& [dbusMappings,
                      dbusValMaps] = handler.getDbusObjMaps(effecterId);
         for (uint8_t currState = 0; currState < compEffecterCnt; ++currState)
         {
-            std::vector<StateSetNum> allowed{};
             // computation is based on table 79 from DSP0248 v1.1.1
             uint8_t bitfieldIndex = stateField[currState].effecter_state / 8;
             uint8_t bit = stateField[currState].effecter_state -
@@ -114,8 +121,7 @@ int setStateEffecterStatesHandler(
                     stateField[currState].effecter_state, "CURR_STATE",
                     currState, "DBUS_OBJ_PATH",
                     dbusMappings[currState].objectPath.c_str());
-                rc = PLDM_PLATFORM_SET_EFFECTER_UNSUPPORTED_SENSORSTATE;
-                break;
+                return PLDM_PLATFORM_SET_EFFECTER_UNSUPPORTED_SENSORSTATE;
             }
             const DBusMapping& dbusMapping = dbusMappings[currState];
             const pldm::responder::pdr_utils::StatestoDbusVal& dbusValToMap =
@@ -123,22 +129,19 @@ int setStateEffecterStatesHandler(
 
             if (stateField[currState].set_request == PLDM_REQUEST_SET)
             {
-                try
-                {
-                    dBusIntf.setDbusProperty(
-                        dbusMapping,
-                        dbusValToMap.at(stateField[currState].effecter_state));
-                }
-                catch (const std::exception& e)
+                auto value =
+                    dbusValToMap.find(stateField[currState].effecter_state);
+                if (value == dbusValToMap.end())
                 {
                     error(
-                        "Error setting property, ERROR={ERR_EXCEP} PROPERTY={DBUS_PROP} INTERFACE={DBUS_INTF} PATH={DBUS_OBJ_PATH}",
-                        "ERR_EXCEP", e.what(), "DBUS_PROP",
-                        dbusMapping.propertyName, "DBUS_INTF",
+                        "No property value for the state, EFFECTER_STATE={EFFECTER_STATE} PROPERTY={DBUS_PROP} INTERFACE={DBUS_INTF} PATH={DBUS_OBJ_PATH}",
+                        "EFFECTER_STATE", stateField[currState].effecter_state,
+                        "DBUS_PROP", dbusMapping.propertyName, "DBUS_INTF",
                         dbusMapping.interface, "DBUS_OBJ_PATH",
                         dbusMapping.objectPath.c_str());
                     return PLDM_ERROR;
                 }
+                sets.emplace_back(dbusMapping, value->second);
             }
             uint8_t* nextState =
                 reinterpret_cast<uint8_t*>(states) +
@@ -156,7 +159,76 @@ int setStateEffecterStatesHandler(
         return PLDM_ERROR;
     }
 
-    return rc;
+    return PLDM_SUCCESS;
+}
+
+/** @brief Keep the last value set for each D-Bus property, the fields of a
+ *         composite effecter may map to the same property
+ *
+ *  @param[in,out] sets - D-Bus properties and values in the order of the
+ *                        fields
+ */
+inline void deduplicateSets(std::vector<PropertySet>& sets)
+{
+    std::set<std::tuple<std::string, std::string, std::string>> seen;
+    std::vector<PropertySet> unique;
+    for (auto it = sets.rbegin(); it != sets.rend(); ++it)
+    {
+        const auto& mapping = it->first;
+        if (seen.emplace(mapping.objectPath, mapping.interface,
+                         mapping.propertyName)
+                .second)
+        {
+            unique.emplace_back(std::move(*it));
+        }
+    }
+    sets.assign(std::make_move_iterator(unique.rbegin()),
+                std::make_move_iterator(unique.rend()));
+}
+
+/** @brief Function to set the effecter requested by pldm requester
+ *
+ *  @tparam[in] DBusInterface - DBus interface type
+ *  @tparam[in] Handler - pldm::responder::platform::Handler
+ *  @param[in] dBusIntf - The interface object of DBusInterface
+ *  @param[in] handler - The interface object of
+ *             pldm::responder::platform::Handler
+ *  @param[in] effecterId - Effecter ID sent by the requester to act on
+ *  @param[in] stateField - The state field data for each of the states,
+ * equal to composite effecter count in number
+ *  @return - Success or failure in setting the states. Returns failure in
+ * terms of PLDM completion codes if atleast one state fails to be set
+ */
+template <class DBusInterface, class Handler>
+int setStateEffecterStatesHandler(
+    const DBusInterface& dBusIntf, Handler& handler, uint16_t effecterId,
+    const std::vector<set_effecter_state_field>& stateField)
+{
+    std::vector<PropertySet> sets;
+    auto rc = getStateEffecterSets(handler, effecterId, stateField, sets);
+    if (rc != PLDM_SUCCESS)
+    {
+        return rc;
+    }
+
+    for (const auto& [dbusMapping, value] : sets)
+    {
+        try
+        {
+            dBusIntf.setDbusProperty(dbusMapping, value);
+        }
+        catch (const std::exception& e)
+        {
+            error(
+                "Error setting property, ERROR={ERR_EXCEP} PROPERTY={DBUS_PROP} INTERFACE={DBUS_INTF} PATH={DBUS_OBJ_PATH}",
+                "ERR_EXCEP", e.what(), "DBUS_PROP", dbusMapping.propertyName,
+                "DBUS_INTF", dbusMapping.interface, "DBUS_OBJ_PATH",
+                dbusMapping.objectPath.c_str());
+            return PLDM_ERROR;
+        }
+    }
+
+    return PLDM_SUCCESS;
 }
 
 } // namespace platform_state_effecter
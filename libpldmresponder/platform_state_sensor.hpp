@@ -39,9 +39,9 @@ uint8_t getStateSensorEventState(
 {
     try
     {
-        auto propertyValue = dBusIntf.getDbusPropertyVariant(
-            dbusMapping.objectPath.c_str(), dbusMapping.propertyName.c_str(),
-            dbusMapping.interface.c_str());
+        auto propertyValue =
+            pldm::utils::PropertyCache::get().getDbusPropertyVariant(
+                dBusIntf, dbusMapping);
 
         for (const auto& stateValue : stateToDbusValue)
         {
@@ -1,4 +1,5 @@
 #include "common/instance_id.hpp"
+#include "common/transfer_size.hpp"
 #include "common/utils.hpp"
 #include "libpldmresponder/base.hpp"
 #include "test/test_instance_id.hpp"
@@ -54,7 +55,7 @@ TEST_F(TestBaseCommands, testGetPLDMCommandsGoodRequest)
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
     uint8_t* payload_ptr = responsePtr->payload;
     ASSERT_EQ(payload_ptr[0], 0);
-    ASSERT_EQ(payload_ptr[1], 60); // 60 = 0b111100
+    ASSERT_EQ(payload_ptr[1], 188); // 188 = 0b10111100
     ASSERT_EQ(payload_ptr[2], 0);
 }
 
@@ -156,3 +157,67 @@ TEST_F(TestBaseCommands, testGetTIDGoodRequest)
     ASSERT_EQ(payload[0], 0);
     ASSERT_EQ(payload[1], 1);
 }
+
+TEST_F(TestBaseCommands, testNegotiateTransferParameters)
+{
+    using namespace pldm::transfer;
+    ProtocolSupport protocols{};
+    addProtocol(protocols, PLDM_BASE);
+    addProtocol(protocols, PLDM_BIOS);
+    auto requestMsg = encodeNegotiateReq(0, UINT16_MAX, protocols);
+    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+
+    auto& sizes = TransferSizes::get();
+    sizes.setRequester(20);
+    base::Handler handler(mctpEid, instanceIdDb, event, nullptr, nullptr);
+    auto response = handler.negotiateTransferParameters(
+        request, requestMsg.size() - sizeof(pldm_msg_hdr));
+
+    uint16_t partSize = 0;
+    ProtocolSupport agreed{};
+    ASSERT_EQ(decodeNegotiateResp(
+                  {response.data() + sizeof(pldm_msg_hdr),
+                   response.size() - sizeof(pldm_msg_hdr)},
+                  partSize, agreed),
+              PLDM_SUCCESS);
+    EXPECT_EQ(partSize, TRANSFER_PART_SIZE);
+    ProtocolSupport bios{};
+    addProtocol(bios, PLDM_BIOS);
+    EXPECT_EQ(agreed, bios);
+    EXPECT_EQ(sizes.partSize(20, 0), TRANSFER_PART_SIZE);
+    sizes.erase(20);
+
+    /* A part size under the baseline is refused */
+    requestMsg = encodeNegotiateReq(0, baselinePartSize - 1, protocols);
+    request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+    response = handler.negotiateTransferParameters(
+        request, requestMsg.size() - sizeof(pldm_msg_hdr));
+    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+    EXPECT_EQ(responsePtr->payload[0], PLDM_ERROR_INVALID_DATA);
+    EXPECT_FALSE(sizes.contains(20));
+}
+
+TEST(ResponseBuffer, reusePooledBuffers)
+{
+    auto response = CmdHandler::ccOnlyResponse(
+        reinterpret_cast<const pldm_msg*>(
+            std::array<uint8_t, sizeof(pldm_msg_hdr)>{0x81, PLDM_BASE,
+                                                      PLDM_GET_TID}
+                .data()),
+        PLDM_ERROR);
+    ASSERT_EQ(response.size(), sizeof(pldm_msg_hdr) + 1);
+    EXPECT_EQ(response[sizeof(pldm_msg_hdr)], PLDM_ERROR);
+    auto data = response.data();
+
+    /* The sender gives the buffer back, the next response of the size class
+     * gets it zeroed */
+    pldm::utils::RequestPool::release(std::move(response));
+    auto next = responseBuffer<PLDM_GET_TID_RESP_BYTES>();
+    EXPECT_EQ(next.data(), data);
+    ASSERT_EQ(next.size(), sizeof(pldm_msg_hdr) + PLDM_GET_TID_RESP_BYTES);
+    EXPECT_EQ(next[sizeof(pldm_msg_hdr)], 0);
+
+    auto copy = responseCopy(next);
+    EXPECT_EQ(copy, next);
+    EXPECT_NE(copy.data(), next.data());
+}
@@ -3,6 +3,8 @@
 #include <stdlib.h>
 
 #include <algorithm>
+#include <memory>
+#include <string>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -59,3 +61,84 @@ TEST_F(TestBIOSTable, testLoadOntoExisting)
     ASSERT_EQ(out[0], 99);
     ASSERT_EQ(out[1], 99);
 }
+
+TEST(BIOSStringTable, testFindByIndex)
+{
+    Table table;
+    std::vector<std::string> names{"Allowed", "Disallowed", "CodeUpdate"};
+    std::vector<uint16_t> handles;
+    for (const auto& name : names)
+    {
+        handles.push_back(table::string::decodeHandle(
+            table::string::constructEntry(table, name)));
+    }
+    table::appendPadAndChecksum(table);
+    EXPECT_TRUE(pldm_bios_table_checksum(table.data(), table.size()));
+
+    BIOSStringTable stringTable(table);
+    for (size_t i = 0; i < names.size(); i++)
+    {
+        EXPECT_EQ(stringTable.findHandle(names[i]), handles[i]);
+        EXPECT_EQ(stringTable.findString(handles[i]), names[i]);
+    }
+    EXPECT_THROW(stringTable.findHandle("Allow"), std::invalid_argument);
+    EXPECT_THROW(stringTable.findString(0xffff), std::invalid_argument);
+
+    // The copy indexes its own table
+    auto copy = std::make_unique<BIOSStringTable>(stringTable);
+    BIOSStringTable assigned(table);
+    assigned = *copy;
+    copy.reset();
+    EXPECT_EQ(assigned.findHandle("CodeUpdate"), handles[2]);
+    EXPECT_EQ(assigned.findString(handles[1]), "Disallowed");
+}
+
+TEST(AttrValueTable, testUpdateEntryInPlace)
+{
+    Table attrValueTable;
+    table::attribute_value::constructIntegerEntry(attrValueTable, 1,
+                                                  PLDM_BIOS_INTEGER, 5);
+    table::attribute_value::constructStringEntry(attrValueTable, 2,
+                                                 PLDM_BIOS_STRING, "abc");
+    table::appendPadAndChecksum(attrValueTable);
+
+    Table integerEntry;
+    table::attribute_value::constructIntegerEntry(integerEntry, 1,
+                                                  PLDM_BIOS_INTEGER, 10);
+    auto offset = table::attribute_value::findSameSizeEntry(
+        attrValueTable, integerEntry.data(), integerEntry.size());
+    ASSERT_TRUE(offset.has_value());
+    EXPECT_EQ(*offset, 0);
+
+    // The same bytes as a rebuilt table, checksum included
+    auto rebuilt = table::attribute_value::updateTable(
+        attrValueTable, integerEntry.data(), integerEntry.size());
+    ASSERT_TRUE(rebuilt.has_value());
+    table::attribute_value::updateEntryInPlace(
+        attrValueTable, *offset, integerEntry.data(), integerEntry.size());
+    EXPECT_EQ(attrValueTable, *rebuilt);
+
+    Table stringEntry;
+    table::attribute_value::constructStringEntry(stringEntry, 2,
+                                                 PLDM_BIOS_STRING, "abcd");
+    EXPECT_FALSE(table::attribute_value::findSameSizeEntry(
+                     attrValueTable, stringEntry.data(), stringEntry.size())
+                     .has_value());
+}
+
+TEST_F(TestBIOSTable, testStoreRange)
+{
+    std::vector<uint8_t> table{10, 34, 56, 100, 44, 55, 69, 21, 48, 2, 7, 82};
+    fs::path file(dir / "t1");
+    BIOSTable t(file.string().c_str());
+
+    // No file yet, the whole table is stored
+    t.storeRange(table, 2, 2);
+    table[4] = 0;
+    table[5] = 1;
+    t.storeRange(table, 4, 2);
+
+    std::vector<uint8_t> out{};
+    t.load(out);
+    EXPECT_EQ(out, table);
+}
@@ -0,0 +1,100 @@
+#include "libpldmresponder/pdr_cache.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::responder::pdr;
+
+class PdrCacheTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        char tmpl[] = "/tmp/pdr_cache_test.XXXXXX";
+        dir = mkdtemp(tmpl);
+        path = dir / "bmc_pdrs_all";
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(dir);
+    }
+
+    std::filesystem::path dir;
+    std::filesystem::path path;
+};
+
+TEST_F(PdrCacheTest, saveAndLoad)
+{
+    std::vector<uint8_t> first{0x10, 0x11, 0x12};
+    std::vector<uint8_t> second(300, 0xab);
+    std::vector<std::span<const uint8_t>> records{first, {}, second};
+    ASSERT_TRUE(PdrCache::save(path, 42, {5, 9}, records));
+    EXPECT_FALSE(std::filesystem::exists(path.string() + ".tmp"));
+
+    PdrCache cache;
+    ASSERT_TRUE(cache.load(path, 42));
+    ASSERT_EQ(cache.getRecords().size(), 3);
+    EXPECT_TRUE(std::ranges::equal(cache.getRecords()[0], first));
+    EXPECT_TRUE(cache.getRecords()[1].empty());
+    EXPECT_TRUE(std::ranges::equal(cache.getRecords()[2], second));
+    EXPECT_EQ(cache.getIds().nextSensorId, 5);
+    EXPECT_EQ(cache.getIds().nextEffecterId, 9);
+}
+
+TEST_F(PdrCacheTest, missingFile)
+{
+    PdrCache cache;
+    EXPECT_FALSE(cache.load(path, 42));
+}
+
+TEST_F(PdrCacheTest, staleKey)
+{
+    std::vector<uint8_t> first{0x10, 0x11, 0x12};
+    ASSERT_TRUE(PdrCache::save(path, 42, {1, 1}, {first}));
+
+    PdrCache cache;
+    EXPECT_FALSE(cache.load(path, 43));
+    EXPECT_TRUE(cache.getRecords().empty());
+}
+
+TEST_F(PdrCacheTest, truncatedFile)
+{
+    std::vector<uint8_t> first(64, 0x10);
+    ASSERT_TRUE(PdrCache::save(path, 42, {1, 1}, {first}));
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+
+    PdrCache cache;
+    EXPECT_FALSE(cache.load(path, 42));
+}
+
+TEST_F(PdrCacheTest, trailingData)
+{
+    std::vector<uint8_t> first(64, 0x10);
+    ASSERT_TRUE(PdrCache::save(path, 42, {1, 1}, {first}));
+    std::ofstream(path, std::ios::binary | std::ios::app) << 'x';
+
+    PdrCache cache;
+    EXPECT_FALSE(cache.load(path, 42));
+}
+
+TEST(PdrCacheKey, lengthPrefixedStrings)
+{
+    PdrCacheKey ab;
+    ab.add("ab");
+    ab.add("c");
+    PdrCacheKey a;
+    a.add("a");
+    a.add("bc");
+    EXPECT_NE(ab.value(), a.value());
+
+    PdrCacheKey again;
+    again.add("ab");
+    again.add("c");
+    EXPECT_EQ(ab.value(), again.value());
+}
@@ -156,6 +156,50 @@ TEST(getPDR, testNoNextRecord)
     pldm_pdr_destroy(pdrRepo);
 }
 
+TEST(getPDR, testLazyBuild)
+{
+    std::array<uint8_t, sizeof(pldm_msg_hdr) + PLDM_GET_PDR_REQ_BYTES>
+        requestPayload{};
+    auto req = reinterpret_cast<pldm_msg*>(requestPayload.data());
+    size_t requestPayloadLength = requestPayload.size() - sizeof(pldm_msg_hdr);
+
+    struct pldm_get_pdr_req* request =
+        reinterpret_cast<struct pldm_get_pdr_req*>(req->payload);
+    request->request_count = 100;
+
+    MockdBusHandler mockedUtils;
+    EXPECT_CALL(mockedUtils, getService(StrEq("/foo/bar"), _))
+        .WillRepeatedly(Return("foo.bar"));
+
+    auto pdrRepo = pldm_pdr_init();
+    auto event = sdeventplus::Event::get_default();
+    Handler handler(&mockedUtils, "./pdr_jsons/state_effecter/good", pdrRepo,
+                    nullptr, nullptr, nullptr, nullptr, event, true);
+    Repo repo(pdrRepo);
+    ASSERT_EQ(repo.empty(), true);
+
+    // The first record is the terminus locator PDR, the build stops once
+    // the record after it exists
+    auto response = handler.getPDR(req, requestPayloadLength);
+    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+    struct pldm_get_pdr_resp* resp =
+        reinterpret_cast<struct pldm_get_pdr_resp*>(responsePtr->payload);
+    ASSERT_EQ(PLDM_SUCCESS, resp->completion_code);
+    ASSERT_EQ(2, resp->next_record_handle);
+    pldm_pdr_hdr* hdr = reinterpret_cast<pldm_pdr_hdr*>(resp->record_data);
+    ASSERT_EQ(hdr->type, PLDM_TERMINUS_LOCATOR_PDR);
+    auto partialCount = repo.getRecordCount();
+
+    // A record which is never built completes the build
+    request->record_handle = 0xFFFF;
+    response = handler.getPDR(req, requestPayloadLength);
+    responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+    ASSERT_EQ(responsePtr->payload[0], PLDM_PLATFORM_INVALID_RECORD_HANDLE);
+    ASSERT_GE(repo.getRecordCount(), partialCount);
+
+    pldm_pdr_destroy(pdrRepo);
+}
+
 TEST(getPDR, testFindPDR)
 {
     std::array<uint8_t, sizeof(pldm_msg_hdr) + PLDM_GET_PDR_REQ_BYTES>
@@ -265,6 +309,53 @@ TEST(setStateEffecterStatesHandler, testGoodRequest)
     pldm_pdr_destroy(outPDRRepo);
 }
 
+TEST(setStateEffecterStatesHandler, testBatchedSets)
+{
+    std::array<uint8_t, sizeof(pldm_msg_hdr) + PLDM_GET_PDR_REQ_BYTES>
+        requestPayload{};
+    auto req = reinterpret_cast<pldm_msg*>(requestPayload.data());
+    size_t requestPayloadLength = requestPayload.size() - sizeof(pldm_msg_hdr);
+
+    MockdBusHandler mockedUtils;
+    EXPECT_CALL(mockedUtils, getService(StrEq("/foo/bar"), _))
+        .Times(5)
+        .WillRepeatedly(Return("foo.bar"));
+
+    auto inPDRRepo = pldm_pdr_init();
+    auto event = sdeventplus::Event::get_default();
+    Handler handler(&mockedUtils, "./pdr_jsons/state_effecter/good", inPDRRepo,
+                    nullptr, nullptr, nullptr, nullptr, event);
+    handler.getPDR(req, requestPayloadLength);
+
+    // Both fields of the effecter map to the same property
+    std::vector<set_effecter_state_field> stateField;
+    stateField.push_back({PLDM_REQUEST_SET, 1});
+    stateField.push_back({PLDM_REQUEST_SET, 1});
+    std::vector<platform_state_effecter::PropertySet> sets;
+    auto rc = platform_state_effecter::getStateEffecterSets(handler, 0x1,
+                                                            stateField, sets);
+    ASSERT_EQ(rc, PLDM_SUCCESS);
+    ASSERT_EQ(sets.size(), 2u);
+
+    platform_state_effecter::deduplicateSets(sets);
+    ASSERT_EQ(sets.size(), 1u);
+    DBusMapping dbusMapping{"/foo/bar", "xyz.openbmc_project.Foo.Bar",
+                            "propertyName", "string"};
+    EXPECT_EQ(sets[0].first == dbusMapping, true);
+    EXPECT_EQ(sets[0].second,
+              PropertyValue{std::string("xyz.openbmc_project.Foo.Bar.V1")});
+
+    // Nothing is set when a field has an unsupported state
+    sets.clear();
+    stateField[1].effecter_state = 4;
+    rc = platform_state_effecter::getStateEffecterSets(handler, 0x1,
+                                                       stateField, sets);
+    ASSERT_EQ(rc, PLDM_PLATFORM_SET_EFFECTER_UNSUPPORTED_SENSORSTATE);
+    EXPECT_TRUE(sets.empty());
+
+    pldm_pdr_destroy(inPDRRepo);
+}
+
 TEST(setStateEffecterStatesHandler, testBadRequest)
 {
     std::array<uint8_t, sizeof(pldm_msg_hdr) + PLDM_GET_PDR_REQ_BYTES>
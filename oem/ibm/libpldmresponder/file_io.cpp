@@ -14,10 +14,12 @@
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
 #include <cstring>
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <utility>
 
 PHOSPHOR_LOG2_USING;
 
@@ -48,72 +50,305 @@ struct AspeedXdmaOp
 
 constexpr auto xdmaDev = "/dev/aspeed-xdma";
 
-int DMA::transferHostDataToSocket(int fd, uint32_t length, uint64_t address)
+XdmaSession& XdmaSession::get()
 {
-    static const size_t pageSize = getpagesize();
-    uint32_t numPages = length / pageSize;
-    uint32_t pageAlignedLength = numPages * pageSize;
+    static XdmaSession session;
+    return session;
+}
 
-    if (length > pageAlignedLength)
+XdmaSession::~XdmaSession()
+{
+    reset();
+}
+
+int XdmaSession::open()
+{
+    if (xdmaFd >= 0)
     {
-        pageAlignedLength += pageSize;
+        return 0;
     }
 
-    auto mmapCleanup = [pageAlignedLength](void* vgaMem) {
-        munmap(vgaMem, pageAlignedLength);
-    };
+    static const size_t pageSize = getpagesize();
+    auto size = (maxSize + pageSize - 1) / pageSize * pageSize;
 
-    int dmaFd = -1;
-    int rc = 0;
-    dmaFd = open(xdmaDev, O_RDWR);
+    int dmaFd = ::open(xdmaDev, O_RDWR | O_CLOEXEC);
     if (dmaFd < 0)
     {
-        rc = -errno;
-        error(
-            "transferHostDataToSocket: Failed to open the XDMA device, RC={RC}",
-            "RC", rc);
+        int rc = -errno;
+        error("Failed to open the XDMA device, RC={RC}", "RC", rc);
         return rc;
     }
 
-    pldm::utils::CustomFD xdmaFd(dmaFd);
-
-    void* vgaMem;
-    vgaMem = mmap(nullptr, pageAlignedLength, PROT_READ, MAP_SHARED, xdmaFd(),
-                  0);
+    auto vgaMem = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_POPULATE, dmaFd, 0);
     if (MAP_FAILED == vgaMem)
     {
-        rc = -errno;
-        error(
-            "transferHostDataToSocket : Failed to mmap the XDMA device, RC={RC}",
-            "RC", rc);
+        int rc = -errno;
+        error("Failed to mmap the XDMA device, RC={RC}", "RC", rc);
+        close(dmaFd);
         return rc;
     }
 
-    std::unique_ptr<void, decltype(mmapCleanup)> vgaMemPtr(vgaMem, mmapCleanup);
+    xdmaFd = dmaFd;
+    mem = vgaMem;
+    mappedSize = size;
+    return 0;
+}
+
+void XdmaSession::reset(bool unmap)
+{
+    if (mem && unmap)
+    {
+        munmap(mem, mappedSize);
+    }
+    if (xdmaFd >= 0)
+    {
+        close(xdmaFd);
+    }
+    xdmaFd = -1;
+    mem = nullptr;
+    mappedSize = 0;
+}
+
+FilePipeline& FilePipeline::get()
+{
+    static FilePipeline pipeline;
+    return pipeline;
+}
+
+FilePipeline::FilePipeline()
+{
+    if (stagingBuffers)
+    {
+        worker = std::thread(&FilePipeline::run, this);
+    }
+}
+
+FilePipeline::~FilePipeline()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stop = true;
+    }
+    cv.notify_all();
+    if (worker.joinable())
+    {
+        worker.join();
+    }
+}
+
+FilePipeline::Buffer* FilePipeline::freeBuffer()
+{
+    for (auto& buffer : buffers)
+    {
+        if (buffer.state == Buffer::State::Free)
+        {
+            return &buffer;
+        }
+    }
+    return nullptr;
+}
+
+void FilePipeline::prefetch(int fd, uint32_t offset, uint32_t length)
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        auto buffer = freeBuffer();
+        if (!buffer)
+        {
+            return;
+        }
+        buffer->state = Buffer::State::Queued;
+        buffer->upstream = true;
+        buffer->fd = fd;
+        buffer->offset = offset;
+        buffer->length = length;
+        queue.push_back(buffer);
+    }
+    cv.notify_all();
+}
+
+std::optional<ssize_t> FilePipeline::take(int fd, uint32_t offset,
+                                          uint32_t length,
+                                          std::vector<char>& data)
+{
+    std::unique_lock<std::mutex> guard(lock);
+    for (auto& buffer : buffers)
+    {
+        if (buffer.state == Buffer::State::Free || !buffer.upstream ||
+            buffer.fd != fd || buffer.offset != offset ||
+            buffer.length != length)
+        {
+            continue;
+        }
+        cv.wait(guard, [&buffer] {
+            return buffer.state == Buffer::State::Done;
+        });
+        data.swap(buffer.data);
+        buffer.state = Buffer::State::Free;
+        return buffer.rc;
+    }
+    return std::nullopt;
+}
+
+int FilePipeline::write(int fd, uint32_t offset, const char* data,
+                        uint32_t length)
+{
+    if (!stagingBuffers)
+    {
+        auto rc = pwrite(fd, data, length, offset);
+        if (rc != static_cast<ssize_t>(length))
+        {
+            return rc < 0 ? -errno : -EIO;
+        }
+        return 0;
+    }
+
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        Buffer* buffer = nullptr;
+        cv.wait(guard, [this, &buffer] {
+            buffer = freeBuffer();
+            return buffer || writeError;
+        });
+        if (writeError)
+        {
+            return writeError;
+        }
+        buffer->state = Buffer::State::Queued;
+        buffer->upstream = false;
+        buffer->fd = fd;
+        buffer->offset = offset;
+        buffer->length = length;
+        buffer->data.resize(length);
+        std::memcpy(buffer->data.data(), data, length);
+        queue.push_back(buffer);
+    }
+    cv.notify_all();
+    return 0;
+}
+
+int FilePipeline::flush()
+{
+    std::unique_lock<std::mutex> guard(lock);
+    cv.wait(guard, [this] {
+        return std::all_of(buffers.begin(), buffers.end(),
+                           [](const Buffer& buffer) {
+            return buffer.state != Buffer::State::Queued;
+        });
+    });
+    /* The chunks read ahead for a transfer which failed are dropped */
+    for (auto& buffer : buffers)
+    {
+        buffer.state = Buffer::State::Free;
+    }
+    return std::exchange(writeError, 0);
+}
+
+void FilePipeline::run()
+{
+    std::unique_lock<std::mutex> guard(lock);
+    while (true)
+    {
+        cv.wait(guard, [this] { return stop || !queue.empty(); });
+        if (queue.empty())
+        {
+            return;
+        }
+        auto buffer = queue.front();
+        queue.pop_front();
+        guard.unlock();
+
+        ssize_t rc = 0;
+        if (buffer->upstream)
+        {
+            buffer->data.resize(buffer->length);
+            rc = pread(buffer->fd, buffer->data.data(), buffer->length,
+                       buffer->offset);
+        }
+        else
+        {
+            rc = pwrite(buffer->fd, buffer->data.data(), buffer->length,
+                        buffer->offset);
+        }
+        int err = rc < 0 ? errno : 0;
+
+        guard.lock();
+        buffer->rc = rc;
+        if (buffer->upstream)
+        {
+            buffer->state = Buffer::State::Done;
+        }
+        else
+        {
+            if (rc != static_cast<ssize_t>(buffer->length))
+            {
+                error(
+                    "FilePipeline : file write failed, ERROR={ERR}, LENGTH={LEN}, OFFSET={OFFSET}, COUNT={RC}",
+                    "ERR", err, "LEN", buffer->length, "OFFSET",
+                    buffer->offset, "RC", rc);
+                if (!writeError)
+                {
+                    writeError = err ? -err : -EIO;
+                }
+            }
+            buffer->state = Buffer::State::Free;
+        }
+        cv.notify_all();
+    }
+}
+
+void DMA::prefetch(int fd, uint32_t offset, uint32_t length)
+{
+    FilePipeline::get().prefetch(fd, offset, length);
+}
+
+int DMA::flush()
+{
+    return FilePipeline::get().flush();
+}
+
+int DMA::transferHostDataToSocket(int fd, uint32_t length, uint64_t address)
+{
+    auto& session = XdmaSession::get();
+    int rc = session.open();
+    if (rc < 0)
+    {
+        error("transferHostDataToSocket: XDMA device unavailable, RC={RC}",
+              "RC", rc);
+        return rc;
+    }
+    if (length > session.size())
+    {
+        error("transferHostDataToSocket: Length {LEN} exceeds the DMA size",
+              "LEN", length);
+        return -EINVAL;
+    }
 
     AspeedXdmaOp xdmaOp;
     xdmaOp.upstream = 0;
     xdmaOp.hostAddr = address;
     xdmaOp.len = length;
 
-    rc = write(xdmaFd(), &xdmaOp, sizeof(xdmaOp));
+    rc = write(session.fd(), &xdmaOp, sizeof(xdmaOp));
     if (rc < 0)
     {
         rc = -errno;
         error(
             "transferHostDataToSocket: Failed to execute the DMA operation, RC={RC} ADDRESS={ADDR} LENGTH={LEN}",
             "RC", rc, "ADDR", address, "LEN", length);
+        /* A transfer that was interrupted may still access the memory */
+        session.reset(rc != -EINTR);
         return rc;
     }
 
-    rc = writeToUnixSocket(fd, static_cast<const char*>(vgaMemPtr.get()),
-                           length);
+    rc = spliceToUnixSocket(fd, session.memory(), length);
     if (rc < 0)
     {
         rc = -errno;
-        close(fd);
+        /* The socket is closed by its owner */
         error(
-            "transferHostDataToSocket: Closing socket as writeToUnixSocket faile with RC={RC}",
+            "transferHostDataToSocket: spliceToUnixSocket failed with RC={RC}",
             "RC", rc);
         return rc;
     }
@@ -132,61 +367,48 @@ int DMA::transferDataHost(int fd, uint32_t offset, uint32_t length,
         pageAlignedLength += pageSize;
     }
 
-    int rc = 0;
-    auto mmapCleanup = [pageAlignedLength, &rc](void* vgaMem) {
-        if (rc != -EINTR)
-        {
-            munmap(vgaMem, pageAlignedLength);
-        }
-        else
-        {
-            error(
-                "transferDataHost: Received interrupt during DMA transfer. Skipping Unmap.");
-        }
-    };
-
-    int dmaFd = -1;
-    dmaFd = open(xdmaDev, O_RDWR);
-    if (dmaFd < 0)
+    auto& session = XdmaSession::get();
+    int rc = session.open();
+    if (rc < 0)
     {
-        rc = -errno;
-        error("transferDataHost : Failed to open the XDMA device, RC={RC}",
-              "RC", rc);
+        error("transferDataHost : XDMA device unavailable, RC={RC}", "RC", rc);
         return rc;
     }
-
-    pldm::utils::CustomFD xdmaFd(dmaFd);
-
-    void* vgaMem;
-    vgaMem = mmap(nullptr, pageAlignedLength, upstream ? PROT_WRITE : PROT_READ,
-                  MAP_SHARED, xdmaFd(), 0);
-    if (MAP_FAILED == vgaMem)
+    if (pageAlignedLength > session.size())
     {
-        rc = -errno;
-        error("transferDataHost : Failed to mmap the XDMA device, RC={RC}",
-              "RC", rc);
-        return rc;
+        error("transferDataHost : Length {LEN} exceeds the DMA size", "LEN",
+              length);
+        return -EINVAL;
     }
 
-    std::unique_ptr<void, decltype(mmapCleanup)> vgaMemPtr(vgaMem, mmapCleanup);
-
     if (upstream)
     {
-        rc = lseek(fd, offset, SEEK_SET);
-        if (rc == -1)
-        {
-            error(
-                "transferDataHost upstream : lseek failed, ERROR={ERR}, UPSTREAM={UPSTREAM}, OFFSET={OFFSET}",
-                "ERR", errno, "UPSTREAM", upstream, "OFFSET", offset);
-            return rc;
-        }
-
         // Writing to the VGA memory should be aligned at page boundary,
         // otherwise write data into a buffer aligned at page boundary and
         // then write to the VGA memory.
-        std::vector<char> buffer{};
-        buffer.resize(pageAlignedLength);
-        rc = read(fd, buffer.data(), length);
+        auto& buffer = session.buffer();
+        auto prefetched = FilePipeline::get().take(fd, offset, length, buffer);
+        if (prefetched)
+        {
+            rc = *prefetched;
+        }
+        else
+        {
+            rc = lseek(fd, offset, SEEK_SET);
+            if (rc == -1)
+            {
+                error(
+                    "transferDataHost upstream : lseek failed, ERROR={ERR}, UPSTREAM={UPSTREAM}, OFFSET={OFFSET}",
+                    "ERR", errno, "UPSTREAM", upstream, "OFFSET", offset);
+                return rc;
+            }
+            buffer.resize(session.size());
+            rc = read(fd, buffer.data(), length);
+        }
+        if (buffer.size() < pageAlignedLength)
+        {
+            buffer.resize(session.size());
+        }
         if (rc == -1)
         {
             error(
@@ -202,8 +424,9 @@ int DMA::transferDataHost(int fd, uint32_t offset, uint32_t length,
                 "LEN", length, "RC", rc);
             return -1;
         }
-        memcpy(static_cast<char*>(vgaMemPtr.get()), buffer.data(),
-               pageAlignedLength);
+        // The staging buffer is reused, the rest of the last page is zeroed
+        std::memset(buffer.data() + length, 0, pageAlignedLength - length);
+        memcpy(session.memory(), buffer.data(), pageAlignedLength);
     }
 
     AspeedXdmaOp xdmaOp;
@@ -211,32 +434,31 @@ int DMA::transferDataHost(int fd, uint32_t offset, uint32_t length,
     xdmaOp.hostAddr = address;
     xdmaOp.len = length;
 
-    rc = write(xdmaFd(), &xdmaOp, sizeof(xdmaOp));
+    rc = write(session.fd(), &xdmaOp, sizeof(xdmaOp));
     if (rc < 0)
     {
         rc = -errno;
         error(
             "transferDataHost : Failed to execute the DMA operation, RC={RC} UPSTREAM={UPSTREAM} ADDRESS={ADDR} LENGTH={LEN}",
             "RC", rc, "UPSTREAM", upstream, "ADDR", address, "LEN", length);
+        if (rc == -EINTR)
+        {
+            error(
+                "transferDataHost: Received interrupt during DMA transfer. Skipping Unmap.");
+        }
+        /* A transfer that was interrupted may still access the memory */
+        session.reset(rc != -EINTR);
         return rc;
     }
 
     if (!upstream)
     {
-        rc = lseek(fd, offset, SEEK_SET);
-        if (rc == -1)
-        {
-            error(
-                "transferDataHost downstream : lseek failed, ERROR={ERR}, UPSTREAM={UPSTREAM}, OFFSET={OFFSET}",
-                "ERR", errno, "UPSTREAM", upstream, "OFFSET", offset);
-            return rc;
-        }
-        rc = write(fd, static_cast<const char*>(vgaMemPtr.get()), length);
-        if (rc == -1)
+        rc = FilePipeline::get().write(fd, offset, session.memory(), length);
+        if (rc < 0)
         {
             error(
-                "transferDataHost downstream : file write failed, ERROR={ERR}, UPSTREAM={UPSTREAM}, LENGTH={LEN}, OFFSET={OFFSET}",
-                "ERR", errno, "UPSTREAM", upstream, "LEN", length, "OFFSET",
+                "transferDataHost downstream : file write failed, RC={RC}, UPSTREAM={UPSTREAM}, LENGTH={LEN}, OFFSET={OFFSET}",
+                "RC", rc, "UPSTREAM", upstream, "LEN", length, "OFFSET",
                 offset);
             return rc;
         }
@@ -409,9 +631,12 @@ Response Handler::writeFileFromMemory(const pldm_msg* request,
 
     using namespace dma;
     DMA intf;
-    return transferAll<DMA>(&intf, PLDM_WRITE_FILE_FROM_MEMORY, value.fsPath,
-                            offset, length, address, false,
-                            request->hdr.instance_id);
+    response = transferAll<DMA>(&intf, PLDM_WRITE_FILE_FROM_MEMORY,
+                                value.fsPath, offset, length, address, false,
+                                request->hdr.instance_id);
+    /* A write past the end grows the file */
+    table.updateFileSize(fileHandle);
+    return response;
 }
 
 Response Handler::getFileTable(const pldm_msg* request, size_t payloadLength)
@@ -450,22 +675,46 @@ Response Handler::getFileTable(const pldm_msg* request, size_t payloadLength)
     }
 
     using namespace pldm::filetable;
-    auto table = buildFileTable(FILE_TABLE_JSON);
-    auto attrTable = table();
-    response.resize(response.size() + attrTable.size());
-    responsePtr = reinterpret_cast<pldm_msg*>(response.data());
-
-    if (attrTable.empty())
-    {
-        encode_get_file_table_resp(request->hdr.instance_id,
-                                   PLDM_FILE_TABLE_UNAVAILABLE, 0, 0, nullptr,
-                                   0, responsePtr);
-        return response;
-    }
+    auto& table = buildFileTable(FILE_TABLE_JSON);
+    /* The table is encoded once, the parts are copied from it */
+    table.withTable([&](const Table& attrTable) {
+        if (attrTable.empty())
+        {
+            encode_get_file_table_resp(request->hdr.instance_id,
+                                       PLDM_FILE_TABLE_UNAVAILABLE, 0, 0,
+                                       nullptr, 0, responsePtr);
+            return;
+        }
 
-    encode_get_file_table_resp(request->hdr.instance_id, PLDM_SUCCESS, 0,
-                               PLDM_START_AND_END, attrTable.data(),
-                               attrTable.size(), responsePtr);
+        size_t offset = transferFlag == PLDM_GET_FIRSTPART ? 0
+                                                           : transferHandle;
+        if (offset >= attrTable.size())
+        {
+            error("Invalid file table transfer handle {HANDLE}", "HANDLE",
+                  transferHandle);
+            encode_get_file_table_resp(request->hdr.instance_id,
+                                       PLDM_ERROR_INVALID_DATA, 0, 0,
+                                       nullptr, 0, responsePtr);
+            return;
+        }
+        size_t length = attrTable.size() - offset;
+        if (FILE_TABLE_MAX_TRANSFER_SIZE &&
+            length > FILE_TABLE_MAX_TRANSFER_SIZE)
+        {
+            length = FILE_TABLE_MAX_TRANSFER_SIZE;
+        }
+        bool start = offset == 0;
+        bool end = offset + length == attrTable.size();
+        uint8_t flag = start ? (end ? PLDM_START_AND_END : PLDM_START)
+                             : (end ? PLDM_END : PLDM_MIDDLE);
+        uint32_t nextTransferHandle = end ? 0 : offset + length;
+
+        response.resize(response.size() + length);
+        encode_get_file_table_resp(
+            request->hdr.instance_id, PLDM_SUCCESS, nextTransferHandle, flag,
+            attrTable.data() + offset, length,
+            reinterpret_cast<pldm_msg*>(response.data()));
+    });
     return response;
 }
 
@@ -621,6 +870,9 @@ Response Handler::writeFile(const pldm_msg* request, size_t payloadLength)
                          std::ios::in | std::ios::out | std::ios::binary);
     stream.seekp(offset);
     stream.write(fileDataPos, length);
+    stream.close();
+    /* A write past the end grows the file */
+    table.updateFileSize(fileHandle);
 
     encode_write_file_resp(request->hdr.instance_id, PLDM_SUCCESS, length,
                            responsePtr);
@@ -804,6 +1056,122 @@ Response Handler::readFileByType(const pldm_msg* request, size_t payloadLength)
     return response;
 }
 
+FileIOWorker& Handler::getFileIOWorker()
+{
+    if (!fileIOWorker)
+    {
+        auto event = sdeventplus::Event::get_default();
+        fileIOWorker = std::make_unique<FileIOWorker>(
+            event, FILE_IO_WORKERS, FILE_IO_QUEUE_DEPTH);
+    }
+    return *fileIOWorker;
+}
+
+void Handler::offloadFileIO(const pldm_msg* request, size_t payloadLength,
+                            Response (Handler::*command)(const pldm_msg*,
+                                                         size_t),
+                            ResponseSender&& respond)
+{
+    /* The table is built on the event loop, the workers only look it up */
+    pldm::filetable::buildFileTable(FILE_TABLE_JSON);
+
+    /* The request is only valid until the handler returns */
+    Response requestMsg(reinterpret_cast<const uint8_t*>(request),
+                        reinterpret_cast<const uint8_t*>(request) +
+                            sizeof(pldm_msg_hdr) + payloadLength);
+    auto submitted = getFileIOWorker().submit(
+        [this, command, requestMsg = std::move(requestMsg), payloadLength]() {
+        auto request = reinterpret_cast<const pldm_msg*>(requestMsg.data());
+        try
+        {
+            return (this->*command)(request, payloadLength);
+        }
+        catch (const std::exception& e)
+        {
+            error("File operation failed, ERROR={ERR_EXCEP}", "ERR_EXCEP",
+                  e.what());
+            return ccOnlyResponse(request, PLDM_ERROR);
+        }
+    },
+        ResponseSender(respond));
+    if (!submitted)
+    {
+        respond((this->*command)(request, payloadLength));
+    }
+}
+
+void Handler::rwFileByTypeAsync(uint8_t cmd, const pldm_msg* request,
+                                size_t payloadLength, ResponseSender&& respond)
+{
+    bool write = cmd == PLDM_WRITE_FILE_BY_TYPE;
+    uint16_t fileType{};
+    uint32_t fileHandle{};
+    uint32_t offset{};
+    uint32_t length{};
+    std::shared_ptr<FileHandler> fileHandler;
+
+    bool validLength = write ? payloadLength >= PLDM_RW_FILE_BY_TYPE_REQ_BYTES
+                             : payloadLength == PLDM_RW_FILE_BY_TYPE_REQ_BYTES;
+    if (validLength &&
+        decode_rw_file_by_type_req(request, payloadLength, &fileType,
+                                   &fileHandle, &offset,
+                                   &length) == PLDM_SUCCESS)
+    {
+        try
+        {
+            fileHandler = getHandlerByType(fileType, fileHandle);
+        }
+        catch (const InternalFailure&)
+        {}
+    }
+
+    /* The errors, and the file types which need the event loop, are
+     * handled in place */
+    if (!fileHandler || !fileHandler->prepareOffload(write, oemPlatformHandler))
+    {
+        respond(write ? writeFileByType(request, payloadLength)
+                      : readFileByType(request, payloadLength));
+        return;
+    }
+
+    Response requestMsg(reinterpret_cast<const uint8_t*>(request),
+                        reinterpret_cast<const uint8_t*>(request) +
+                            sizeof(pldm_msg_hdr) + payloadLength);
+    auto submitted = getFileIOWorker().submit(
+        [cmd, write, fileHandler, offset, length,
+         requestMsg = std::move(requestMsg)]() mutable {
+        auto request = reinterpret_cast<const pldm_msg*>(requestMsg.data());
+        Response response(sizeof(pldm_msg_hdr) +
+                          PLDM_RW_FILE_BY_TYPE_RESP_BYTES);
+        int rc = PLDM_ERROR;
+        try
+        {
+            rc = write ? fileHandler->write(
+                             reinterpret_cast<const char*>(
+                                 request->payload +
+                                 PLDM_RW_FILE_BY_TYPE_REQ_BYTES),
+                             offset, length, nullptr)
+                       : fileHandler->read(offset, length, response, nullptr);
+        }
+        catch (const std::exception& e)
+        {
+            error("File operation by type failed, ERROR={ERR_EXCEP}",
+                  "ERR_EXCEP", e.what());
+            length = 0;
+        }
+        encode_rw_file_by_type_resp(request->hdr.instance_id, cmd, rc, length,
+                                    reinterpret_cast<pldm_msg*>(
+                                        response.data()));
+        return response;
+    },
+        ResponseSender(respond));
+    if (!submitted)
+    {
+        respond(write ? writeFileByType(request, payloadLength)
+                      : readFileByType(request, payloadLength));
+    }
+}
+
 Response Handler::fileAck(const pldm_msg* request, size_t payloadLength)
 {
     Response response(sizeof(pldm_msg_hdr) + PLDM_FILE_ACK_RESP_BYTES);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "common/utils.hpp"
+#include "file_io_worker.hpp"
 #include "oem/ibm/requester/dbus_to_file_handler.hpp"
 #include "oem_ibm_handler.hpp"
 #include "pldmd/handler.hpp"
@@ -17,8 +18,15 @@
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <deque>
 #include <filesystem>
 #include <iostream>
+#include <mutex>
+#include <optional>
+#include <thread>
 #include <vector>
 
 PHOSPHOR_LOG2_USING;
@@ -34,8 +42,171 @@ constexpr uint32_t minSize = 16;
 
 constexpr size_t maxSize = DMA_MAXSIZE;
 
+// Number of chunks whose file I/O can overlap the DMA of the next chunk
+constexpr size_t stagingBuffers = DMA_STAGING_BUFFERS;
+
 namespace fs = std::filesystem;
 
+/** @class XdmaSession
+ *
+ *  The XDMA device of the process. The device is opened and a pre-faulted
+ *  mapping of maxSize bytes is made on the first transfer, the following
+ *  transfers of all the file I/O handlers reuse them.
+ */
+class XdmaSession
+{
+  public:
+    XdmaSession(const XdmaSession&) = delete;
+    XdmaSession& operator=(const XdmaSession&) = delete;
+
+    /** @brief Get the session of the process */
+    static XdmaSession& get();
+
+    /** @brief Open and map the device unless they already are
+     *
+     *  @return 0 on success, negative errno on failure
+     */
+    int open();
+
+    /** @brief Close the device, the next transfer opens it again
+     *
+     *  @param[in] unmap - false to leave the memory mapped, when a DMA
+     *                     operation may still access it
+     */
+    void reset(bool unmap = true);
+
+    /** @brief Device file descriptor */
+    int fd() const
+    {
+        return xdmaFd;
+    }
+
+    /** @brief Mapped memory of the device */
+    char* memory() const
+    {
+        return static_cast<char*>(mem);
+    }
+
+    /** @brief Size of the mapping */
+    size_t size() const
+    {
+        return mappedSize;
+    }
+
+    /** @brief Page aligned buffer staging the data sent upstream */
+    std::vector<char>& buffer()
+    {
+        return stagingBuffer;
+    }
+
+  private:
+    XdmaSession() = default;
+    ~XdmaSession();
+
+    int xdmaFd = -1;
+    void* mem = nullptr;
+    size_t mappedSize = 0;
+    std::vector<char> stagingBuffer;
+};
+
+/** @class FilePipeline
+ *
+ *  Runs the file I/O of the DMA transfers on a worker thread. The XDMA
+ *  engine always transfers to or from the start of the mapped memory, so
+ *  the chunks go through staging buffers: a chunk written to the host is
+ *  read ahead from the file while the DMA of the previous chunk runs, and a
+ *  chunk read from the host is copied out of the mapping and written to the
+ *  file while the DMA of the next chunk runs.
+ */
+class FilePipeline
+{
+  public:
+    FilePipeline(const FilePipeline&) = delete;
+    FilePipeline& operator=(const FilePipeline&) = delete;
+
+    /** @brief Get the pipeline of the process */
+    static FilePipeline& get();
+
+    /** @brief Start reading a chunk of a file, if a buffer is free
+     *
+     *  @param[in] fd - file descriptor of the file
+     *  @param[in] offset - offset of the chunk in the file
+     *  @param[in] length - length of the chunk
+     */
+    void prefetch(int fd, uint32_t offset, uint32_t length);
+
+    /** @brief Take a chunk read ahead by prefetch()
+     *
+     *  @param[in] fd - file descriptor of the file
+     *  @param[in] offset - offset of the chunk in the file
+     *  @param[in] length - length of the chunk
+     *  @param[in,out] data - swapped with the buffer holding the chunk
+     *
+     *  @return result of the read, std::nullopt if the chunk wasn't read
+     *          ahead
+     */
+    std::optional<ssize_t> take(int fd, uint32_t offset, uint32_t length,
+                                std::vector<char>& data);
+
+    /** @brief Queue a chunk to be written to a file, the chunk is copied
+     *         first
+     *
+     *  @param[in] fd - file descriptor of the file
+     *  @param[in] offset - offset of the chunk in the file
+     *  @param[in] data - the chunk
+     *  @param[in] length - length of the chunk
+     *
+     *  @return 0 on success, negative errno if a previous write failed
+     */
+    int write(int fd, uint32_t offset, const char* data, uint32_t length);
+
+    /** @brief Wait for the queued writes and drop the chunks read ahead
+     *
+     *  @return 0 on success, negative errno of the first write which failed
+     */
+    int flush();
+
+  private:
+    /** @struct Buffer
+     *  @brief Staging buffer of one chunk
+     */
+    struct Buffer
+    {
+        enum class State
+        {
+            Free,
+            Queued,
+            Done
+        };
+
+        std::vector<char> data;
+        State state = State::Free;
+        bool upstream = false;
+        int fd = -1;
+        uint32_t offset = 0;
+        uint32_t length = 0;
+        ssize_t rc = 0;
+    };
+
+    FilePipeline();
+    ~FilePipeline();
+
+    /** @brief Free buffer, the lock is held */
+    Buffer* freeBuffer();
+
+    /** @brief Worker thread loop */
+    void run();
+
+    std::array<Buffer, stagingBuffers> buffers;
+    std::mutex lock;
+    std::condition_variable cv;
+    std::deque<Buffer*> queue;
+    /** @brief First error of the writes since the last flush() */
+    int writeError = 0;
+    bool stop = false;
+    std::thread worker;
+};
+
 /**
  * @class DMA
  *
@@ -71,13 +242,30 @@ class DMA
      * @return returns 0 on success, negative errno on failure
      */
     int transferHostDataToSocket(int fd, uint32_t length, uint64_t address);
+
+    /** @brief Start reading the next chunk of a transfer to the host while
+     *         the current one is transferred
+     *
+     * @param[in] fd      - file descriptor of the file
+     * @param[in] offset  - offset of the chunk in the file
+     * @param[in] length  - length of the chunk
+     */
+    void prefetch(int fd, uint32_t offset, uint32_t length);
+
+    /** @brief Wait for the file writes of the chunks transferred from the
+     *         host
+     *
+     * @return returns 0 on success, negative errno on failure
+     */
+    int flush();
 };
 
 /** @brief Transfer the data between BMC and host using DMA.
  *
  *  There is a max size for each DMA operation, transferAll API abstracts this
  *  and the requested length is broken down into multiple DMA operations if the
- *  length exceed max size.
+ *  length exceed max size. The file I/O of a chunk overlaps the DMA of the
+ *  next one.
  *
  * @tparam[in] T - DMA interface type
  * @param[in] intf - interface passed to invoke DMA transfer
@@ -125,15 +313,20 @@ Response transferAll(DMAInterface* intf, uint8_t command, fs::path& path,
     }
     pldm::utils::CustomFD fd(file);
 
+    int rc = 0;
     while (length > dma::maxSize)
     {
-        auto rc = intf->transferDataHost(fd(), offset, dma::maxSize, address,
-                                         upstream);
+        if (upstream)
+        {
+            intf->prefetch(fd(), offset + dma::maxSize,
+                           std::min<uint32_t>(length - dma::maxSize,
+                                              dma::maxSize));
+        }
+        rc = intf->transferDataHost(fd(), offset, dma::maxSize, address,
+                                    upstream);
         if (rc < 0)
         {
-            encode_rw_file_memory_resp(instanceId, command, PLDM_ERROR, 0,
-                                       responsePtr);
-            return response;
+            break;
         }
 
         offset += dma::maxSize;
@@ -141,8 +334,13 @@ Response transferAll(DMAInterface* intf, uint8_t command, fs::path& path,
         address += dma::maxSize;
     }
 
-    auto rc = intf->transferDataHost(fd(), offset, length, address, upstream);
-    if (rc < 0)
+    if (rc >= 0)
+    {
+        rc = intf->transferDataHost(fd(), offset, length, address, upstream);
+    }
+    /* The file writes may still be queued, they end before the file closes */
+    auto flushRc = intf->flush();
+    if (rc < 0 || flushRc < 0)
     {
         encode_rw_file_memory_resp(instanceId, command, PLDM_ERROR, 0,
                                    responsePtr);
@@ -210,6 +408,34 @@ class Handler : public CmdHandler
                          [this](const pldm_msg* request, size_t payloadLength) {
             return this->writeFile(request, payloadLength);
         });
+        asyncHandlers.emplace(PLDM_READ_FILE,
+                              [this](const pldm_msg* request,
+                                     size_t payloadLength,
+                                     ResponseSender&& respond) {
+            this->offloadFileIO(request, payloadLength, &Handler::readFile,
+                                std::move(respond));
+        });
+        asyncHandlers.emplace(PLDM_WRITE_FILE,
+                              [this](const pldm_msg* request,
+                                     size_t payloadLength,
+                                     ResponseSender&& respond) {
+            this->offloadFileIO(request, payloadLength, &Handler::writeFile,
+                                std::move(respond));
+        });
+        asyncHandlers.emplace(PLDM_READ_FILE_BY_TYPE,
+                              [this](const pldm_msg* request,
+                                     size_t payloadLength,
+                                     ResponseSender&& respond) {
+            this->rwFileByTypeAsync(PLDM_READ_FILE_BY_TYPE, request,
+                                    payloadLength, std::move(respond));
+        });
+        asyncHandlers.emplace(PLDM_WRITE_FILE_BY_TYPE,
+                              [this](const pldm_msg* request,
+                                     size_t payloadLength,
+                                     ResponseSender&& respond) {
+            this->rwFileByTypeAsync(PLDM_WRITE_FILE_BY_TYPE, request,
+                                    payloadLength, std::move(respond));
+        });
         handlers.emplace(PLDM_FILE_ACK,
                          [this](const pldm_msg* request, size_t payloadLength) {
             return this->fileAck(request, payloadLength);
@@ -403,6 +629,33 @@ class Handler : public CmdHandler
     Response newFileAvailable(const pldm_msg* request, size_t payloadLength);
 
   private:
+    /** @brief Run a file table command on a file I/O worker thread, or in
+     *         place when too many file operations are in flight
+     *
+     *  @param[in] request - PLDM request msg
+     *  @param[in] payloadLength - length of the message payload
+     *  @param[in] command - handler of the command
+     *  @param[in] respond - sends the response
+     */
+    void offloadFileIO(const pldm_msg* request, size_t payloadLength,
+                       Response (Handler::*command)(const pldm_msg*, size_t),
+                       ResponseSender&& respond);
+
+    /** @brief Handler for readFileByType and writeFileByType commands which
+     *         runs the operation on a file I/O worker thread when the file
+     *         handler allows it
+     *
+     *  @param[in] cmd - PLDM_READ_FILE_BY_TYPE or PLDM_WRITE_FILE_BY_TYPE
+     *  @param[in] request - PLDM request msg
+     *  @param[in] payloadLength - length of the message payload
+     *  @param[in] respond - sends the response
+     */
+    void rwFileByTypeAsync(uint8_t cmd, const pldm_msg* request,
+                           size_t payloadLength, ResponseSender&& respond);
+
+    /** @brief Get the file I/O workers, started on the first use */
+    FileIOWorker& getFileIOWorker();
+
     oem_platform::Handler* oemPlatformHandler;
     int hostSockFd;
     uint8_t hostEid;
@@ -422,6 +675,8 @@ class Handler : public CmdHandler
     pldm::requester::Handler<pldm::requester::Request>* handler;
     std::vector<std::unique_ptr<pldm::requester::oem_ibm::DbusToFileHandler>>
         dbusToFileHandlers;
+    /** @brief Threads running the blocking file operations */
+    std::unique_ptr<FileIOWorker> fileIOWorker;
 };
 
 } // namespace oem_ibm
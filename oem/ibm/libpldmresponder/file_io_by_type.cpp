@@ -17,6 +17,7 @@
 #include <phosphor-logging/lg2.hpp>
 #include <xyz/openbmc_project/Logging/Entry/server.hpp>
 
+#include <algorithm>
 #include <exception>
 #include <filesystem>
 #include <fstream>
@@ -35,21 +36,32 @@ int FileHandler::transferFileData(int32_t fd, bool upstream, uint32_t offset,
                                   uint32_t& length, uint64_t address)
 {
     dma::DMA xdmaInterface;
+    int rc = 0;
     while (length > dma::maxSize)
     {
-        auto rc = xdmaInterface.transferDataHost(fd, offset, dma::maxSize,
-                                                 address, upstream);
+        if (upstream)
+        {
+            xdmaInterface.prefetch(fd, offset + dma::maxSize,
+                                   std::min<uint32_t>(length - dma::maxSize,
+                                                      dma::maxSize));
+        }
+        rc = xdmaInterface.transferDataHost(fd, offset, dma::maxSize, address,
+                                            upstream);
         if (rc < 0)
         {
-            return PLDM_ERROR;
+            break;
         }
         offset += dma::maxSize;
         length -= dma::maxSize;
         address += dma::maxSize;
     }
-    auto rc = xdmaInterface.transferDataHost(fd, offset, length, address,
-                                             upstream);
-    return rc < 0 ? PLDM_ERROR : PLDM_SUCCESS;
+    if (rc >= 0)
+    {
+        rc = xdmaInterface.transferDataHost(fd, offset, length, address,
+                                            upstream);
+    }
+    auto flushRc = xdmaInterface.flush();
+    return rc < 0 || flushRc < 0 ? PLDM_ERROR : PLDM_SUCCESS;
 }
 
 int FileHandler::transferFileDataToSocket(int32_t fd, uint32_t& length,
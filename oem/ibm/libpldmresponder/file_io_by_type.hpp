@@ -79,6 +79,23 @@ class FileHandler
      */
     virtual int newFileAvailable(uint64_t length) = 0;
 
+    /** @brief Method to check whether a read() or write() can run on a file
+     *  I/O worker thread. The handler does the part which needs the event
+     *  loop here, the operation is then run without the OEM platform
+     *  handler. The default is to run it on the event loop.
+     *
+     *  @param[in] write - true for write(), false for read()
+     *  @param[in] oemPlatformHandler - oem handler for PLDM platform related
+     *                                  tasks
+     *
+     *  @return true if the operation can run on a worker thread
+     */
+    virtual bool prepareOffload(bool /*write*/,
+                                oem_platform::Handler* /*oemPlatformHandler*/)
+    {
+        return false;
+    }
+
     /** @brief Method to read an oem file type's content into the PLDM response.
      *  @param[in] filePath - file to read from
      *  @param[in] offset - offset to read
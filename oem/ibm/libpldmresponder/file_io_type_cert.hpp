@@ -37,6 +37,13 @@ class CertHandler : public FileHandler
     virtual int read(uint32_t offset, uint32_t& length, Response& response,
                      oem_platform::Handler* /*oemPlatformHandler*/);
 
+    /** @brief The CSR is only read from its file, the writes update D-Bus */
+    virtual bool prepareOffload(bool write,
+                                oem_platform::Handler* /*oemPlatformHandler*/)
+    {
+        return !write;
+    }
+
     virtual int write(const char* buffer, uint32_t offset, uint32_t& length,
                       oem_platform::Handler* /*oemPlatformHandler*/);
 
@@ -39,7 +39,6 @@ static constexpr auto resDumpEntry = "com.ibm.Dump.Entry.Resource";
 // resource dumps.
 static constexpr auto resDumpDirPath = "/var/lib/pldm/resourcedump/1";
 
-int DumpHandler::fd = -1;
 namespace fs = std::filesystem;
 
 std::string DumpHandler::findDumpObjPath(uint32_t fileHandle)
@@ -178,38 +177,78 @@ std::string DumpHandler::getOffloadUri(uint32_t fileHandle)
     return socketInterface;
 }
 
+int DumpHandler::offloadSocket()
+{
+    auto offload = offloads.find(fileHandle);
+    if (offload != offloads.end())
+    {
+        return offload->second;
+    }
+
+    if (offloads.size() >= DUMP_OFFLOAD_SESSIONS)
+    {
+        error(
+            "DumpHandler: {NUM} dumps are already offloaded, FILE_HANDLE={FILE_HANDLE}",
+            "NUM", offloads.size(), "FILE_HANDLE", fileHandle);
+        return -1;
+    }
+
+    auto socketInterface = getOffloadUri(fileHandle);
+    int sock = setupUnixSocket(socketInterface);
+    if (sock < 0)
+    {
+        error("DumpHandler: setupUnixSocket() failed, FILE_HANDLE={FILE_HANDLE}",
+              "FILE_HANDLE", fileHandle);
+        std::remove(socketInterface.c_str());
+        return -1;
+    }
+    offloads.emplace(fileHandle, sock);
+    return sock;
+}
+
+void DumpHandler::closeOffload()
+{
+    auto offload = offloads.find(fileHandle);
+    if (offload == offloads.end())
+    {
+        return;
+    }
+    close(offload->second);
+    offloads.erase(offload);
+    auto socketInterface = getOffloadUri(fileHandle);
+    std::remove(socketInterface.c_str());
+}
+
 int DumpHandler::writeFromMemory(uint32_t, uint32_t length, uint64_t address,
                                  oem_platform::Handler* /*oemPlatformHandler*/)
 {
-    if (DumpHandler::fd == -1)
+    int sock = offloadSocket();
+    if (sock < 0)
     {
-        auto socketInterface = getOffloadUri(fileHandle);
-        int sock = setupUnixSocket(socketInterface);
-        if (sock < 0)
-        {
-            sock = -errno;
-            close(DumpHandler::fd);
-            error("DumpHandler::writeFromMemory: setupUnixSocket() failed");
-            std::remove(socketInterface.c_str());
-            return PLDM_ERROR;
-        }
-
-        DumpHandler::fd = sock;
+        return PLDM_ERROR;
     }
-    return transferFileDataToSocket(DumpHandler::fd, length, address);
+    auto rc = transferFileDataToSocket(sock, length, address);
+    if (rc != PLDM_SUCCESS)
+    {
+        /* The part of the dump already sent can't be resumed */
+        closeOffload();
+    }
+    return rc;
 }
 
 int DumpHandler::write(const char* buffer, uint32_t, uint32_t& length,
                        oem_platform::Handler* /*oemPlatformHandler*/)
 {
-    int rc = writeToUnixSocket(DumpHandler::fd, buffer, length);
+    int sock = offloadSocket();
+    if (sock < 0)
+    {
+        return PLDM_ERROR;
+    }
+    int rc = spliceToUnixSocket(sock, buffer, length);
     if (rc < 0)
     {
-        rc = -errno;
-        close(DumpHandler::fd);
-        auto socketInterface = getOffloadUri(fileHandle);
-        std::remove(socketInterface.c_str());
-        error("DumpHandler::write: writeToUnixSocket() failed");
+        error("DumpHandler::write: spliceToUnixSocket() failed");
+        closeOffload();
         return PLDM_ERROR;
     }
 
@@ -254,6 +293,7 @@ int DumpHandler::fileAck(uint8_t fileStatus)
     {
         if (fileStatus == PLDM_ERROR_FILE_DISCARDED)
         {
+            closeOffload();
             uint32_t val = 0xFFFFFFFF;
             PropertyValue value = static_cast<uint32_t>(val);
             auto dumpIntf = resDumpEntry;
@@ -315,17 +355,13 @@ int DumpHandler::fileAck(uint8_t fileStatus)
                     "FILE_PATH", path.c_str(), "ERR_EXCEP", e.what());
             }
 
-            auto socketInterface = getOffloadUri(fileHandle);
-            std::remove(socketInterface.c_str());
-            if (DumpHandler::fd >= 0)
-            {
-                close(DumpHandler::fd);
-                DumpHandler::fd = -1;
-            }
+            closeOffload();
         }
         return PLDM_SUCCESS;
     }
 
+    /* The dump entry is gone, its offload is over */
+    closeOffload();
     return PLDM_ERROR;
 }
 
@@ -2,6 +2,10 @@
 
 #include "file_io_by_type.hpp"
 
+#include <cstdint>
+#include <map>
+#include <string>
+
 namespace pldm
 {
 namespace responder
@@ -12,6 +16,10 @@ using DumpEntryInterface = std::string;
  *
  *  @brief Inherits and implements FileHandler. This class is used
  *  handle the dump offload/streaming from host to the destination via bmc
+ *
+ *  Each dump is offloaded through its own socket, kept by file handle from
+ *  its first chunk to its file ack, so the host can offload up to
+ *  DUMP_OFFLOAD_SESSIONS dumps side by side.
  */
 class DumpHandler : public FileHandler
 {
@@ -47,8 +55,27 @@ class DumpHandler : public FileHandler
      */
     ~DumpHandler() {}
 
+    /** @brief Number of dumps being offloaded */
+    static size_t offloadsInProgress()
+    {
+        return offloads.size();
+    }
+
   private:
-    static int fd;     //!< fd to manage the dump offload to bmc
+    /** @brief Socket of the offload of the dump, set up on its first chunk
+     *
+     *  @return the socket, -1 if it can't be set up or too many dumps are
+     *          offloaded
+     */
+    int offloadSocket();
+
+    /** @brief Close the socket of the offload of the dump and remove its
+     *         path
+     */
+    void closeOffload();
+
+    /** @brief Sockets of the dumps being offloaded, by file handle */
+    static inline std::map<uint32_t, int> offloads;
     uint16_t dumpType; //!< type of the dump
 };
 
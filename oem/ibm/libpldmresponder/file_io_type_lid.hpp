@@ -1,6 +1,7 @@
 #pragma once
 
 #include "file_io_by_type.hpp"
+#include "lid_map_cache.hpp"
 
 #include <phosphor-logging/lg2.hpp>
 
@@ -136,6 +137,7 @@ class LidHandler : public FileHandler
         close(fd);
 
         rc = transferFileData(lidPath, false, offset, length, address);
+        LidMapCache::get().erase(lidPath);
         if (rc != PLDM_SUCCESS)
         {
             error("writeFileFromMemory failed with rc= {RC}", "RC", rc);
@@ -237,6 +239,7 @@ class LidHandler : public FileHandler
             return PLDM_ERROR;
         }
         rc = ::write(fd, buffer, length);
+        LidMapCache::get().erase(lidPath);
         if (rc == -1)
         {
             error(
@@ -285,11 +288,42 @@ class LidHandler : public FileHandler
     {
         if (constructLIDPath(oemPlatformHandler))
         {
+            /* Each chunk the host streams is copied from the mapping */
+            auto mapping = LidMapCache::get().map(lidPath);
+            if (mapping)
+            {
+                return LidMapCache::read(*mapping, offset, length, response);
+            }
             return readFile(lidPath, offset, length, response);
         }
         return PLDM_ERROR;
     }
 
+    /** @brief The LID path is built from the boot side here, the writes
+     *  which stage a code update or a marker LID stay on the event loop
+     */
+    virtual bool prepareOffload(bool write,
+                                oem_platform::Handler* oemPlatformHandler)
+    {
+        if (!write)
+        {
+            return constructLIDPath(oemPlatformHandler);
+        }
+        if (lidType == PLDM_FILE_TYPE_LID_MARKER)
+        {
+            return false;
+        }
+        if (oemPlatformHandler != nullptr)
+        {
+            auto oemIbmPlatformHandler =
+                dynamic_cast<pldm::responder::oem_ibm_platform::Handler*>(
+                    oemPlatformHandler);
+            return !oemIbmPlatformHandler->codeUpdate
+                        ->isCodeUpdateInProgress();
+        }
+        return true;
+    }
+
     virtual int fileAck(uint8_t /*fileStatus*/)
     {
         return PLDM_ERROR_UNSUPPORTED_PLDM_CMD;
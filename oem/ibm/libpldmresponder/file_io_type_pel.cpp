@@ -11,6 +11,7 @@
 
 #include <org/open_power/Logging/PEL/server.hpp>
 #include <phosphor-logging/lg2.hpp>
+#include <sdeventplus/event.hpp>
 #include <sdbusplus/server.hpp>
 #include <xyz/openbmc_project/Logging/Entry/server.hpp>
 
@@ -212,7 +213,7 @@ int PelHandler::writeFromMemory(uint32_t offset, uint32_t length,
     auto rc = transferFileData(path, false, offset, length, address);
     if (rc == PLDM_SUCCESS)
     {
-        rc = storePel(path.string());
+        rc = queuePel(path.string());
     }
     return rc;
 }
@@ -297,28 +298,33 @@ int PelHandler::fileAck(uint8_t fileStatus)
     return PLDM_SUCCESS;
 }
 
-int PelHandler::storePel(std::string&& pelFileName)
+sdbusplus::message_t PelHandler::newCreateCall(std::string&& pelFileName)
 {
     static constexpr auto logObjPath = "/xyz/openbmc_project/logging";
     static constexpr auto logInterface = "xyz.openbmc_project.Logging.Create";
 
+    auto& bus = pldm::utils::DBusHandler::getBus();
+    auto service = pldm::utils::DBusHandler().getService(logObjPath,
+                                                         logInterface);
+    std::map<std::string, std::string> addlData{};
+    auto severity =
+        sdbusplus::xyz::openbmc_project::Logging::server::convertForMessage(
+            detail::getEntryLevelFromPEL(pelFileName));
+    addlData.emplace("RAWPEL", std::move(pelFileName));
+
+    auto method = bus.new_method_call(service.c_str(), logObjPath,
+                                      logInterface, "Create");
+    method.append("xyz.openbmc_project.Host.Error.Event", severity, addlData);
+    return method;
+}
+
+int PelHandler::storePel(std::string&& pelFileName)
+{
     auto& bus = pldm::utils::DBusHandler::getBus();
 
     try
     {
-        auto service = pldm::utils::DBusHandler().getService(logObjPath,
-                                                             logInterface);
-        using namespace sdbusplus::xyz::openbmc_project::Logging::server;
-        std::map<std::string, std::string> addlData{};
-        auto severity =
-            sdbusplus::xyz::openbmc_project::Logging::server::convertForMessage(
-                detail::getEntryLevelFromPEL(pelFileName));
-        addlData.emplace("RAWPEL", std::move(pelFileName));
-
-        auto method = bus.new_method_call(service.c_str(), logObjPath,
-                                          logInterface, "Create");
-        method.append("xyz.openbmc_project.Host.Error.Event", severity,
-                      addlData);
+        auto method = newCreateCall(std::string(pelFileName));
         bus.call_noreply(method, dbusTimeout);
     }
     catch (const std::exception& e)
@@ -332,6 +338,83 @@ int PelHandler::storePel(std::string&& pelFileName)
     return PLDM_SUCCESS;
 }
 
+int PelHandler::queuePel(std::string&& pelFileName)
+{
+    if (PelQueue::get().push(std::string(pelFileName)))
+    {
+        return PLDM_SUCCESS;
+    }
+    return storePel(std::move(pelFileName));
+}
+
+PelQueue& PelQueue::get()
+{
+    static PelQueue queue;
+    return queue;
+}
+
+bool PelQueue::push(std::string&& pelFileName)
+{
+    if (size() >= PEL_QUEUE_DEPTH)
+    {
+        return false;
+    }
+    pending.push_back(std::move(pelFileName));
+    submit();
+    return true;
+}
+
+void PelQueue::resume()
+{
+    /* The next call releases the slot of the completed one, it is sent from
+     * the event loop rather than from the reply callback */
+    if (!resumeEvent)
+    {
+        resumeEvent = std::make_unique<sdeventplus::source::Defer>(
+            sdeventplus::Event::get_default(),
+            [this](sdeventplus::source::EventBase&) {
+            resumeEvent.reset();
+            submit();
+        });
+    }
+}
+
+void PelQueue::submit()
+{
+    auto& bus = pldm::utils::DBusHandler::getBus();
+
+    while (!pending.empty() && calls.pending() < maxCalls)
+    {
+        auto pelFileName = std::move(pending.front());
+        pending.pop_front();
+        try
+        {
+            auto method = PelHandler::newCreateCall(std::string(pelFileName));
+            calls.call(bus, method,
+                       [this, pelFileName](sdbusplus::message_t& reply) {
+                if (reply.is_method_error())
+                {
+                    error(
+                        "Create D-Bus call to the PEL daemon failed, PEL_FILE_NAME={PEL_FILE_NAME}",
+                        "PEL_FILE_NAME", pelFileName);
+                    std::error_code ec;
+                    fs::remove(pelFileName, ec);
+                }
+                resume();
+            });
+        }
+        catch (const std::exception& e)
+        {
+            /* The PEL daemon never gets the file, nothing else removes it */
+            error(
+                "failed to make a d-bus call to PEL daemon, PEL_FILE_NAME={PEL_FILE_NAME}, ERROR={ERR_EXCEP}",
+                "PEL_FILE_NAME", pelFileName, "ERR_EXCEP", e.what());
+            std::error_code ec;
+            fs::remove(pelFileName, ec);
+        }
+    }
+}
+
 int PelHandler::write(const char* buffer, uint32_t offset, uint32_t& length,
                       oem_platform::Handler* /*oemPlatformHandler*/)
 {
@@ -374,7 +457,7 @@ int PelHandler::write(const char* buffer, uint32_t offset, uint32_t& length,
     if (written == length)
     {
         fs::path path(tmpFile);
-        rc = storePel(path.string());
+        rc = queuePel(path.string());
         if (rc != PLDM_SUCCESS)
         {
             error("save PEL failed, ERROR = {RC} tmpFile = {TMP_FILE}", "RC",
@@ -1,12 +1,67 @@
 #pragma once
 
+#include "common/utils.hpp"
 #include "file_io_by_type.hpp"
 
+#include <sdeventplus/source/event.hpp>
+
+#include <deque>
+#include <memory>
+#include <string>
+
 namespace pldm
 {
 namespace responder
 {
 
+/** @class PelQueue
+ *
+ *  Hands the PELs staged in tempfs to the PEL daemon in the background, so
+ *  the host gets its response once the PEL is written rather than after the
+ *  daemon has parsed and stored it. A few Create calls are kept in flight
+ *  and the next one is sent as a reply comes back.
+ */
+class PelQueue
+{
+  public:
+    PelQueue(const PelQueue&) = delete;
+    PelQueue& operator=(const PelQueue&) = delete;
+
+    /** @brief Get the queue of the process */
+    static PelQueue& get();
+
+    /** @brief Queue a staged PEL for the PEL daemon
+     *
+     *  @param[in] pelFileName - the pel file path
+     *
+     *  @return false if the queue is full, the caller stores the PEL in
+     *          place
+     */
+    bool push(std::string&& pelFileName);
+
+    /** @brief Number of the PELs queued or being stored */
+    size_t size() const
+    {
+        return pending.size() + calls.pending();
+    }
+
+  private:
+    PelQueue() = default;
+
+    /** @brief Send the queued PELs while there are calls available */
+    void submit();
+
+    /** @brief Schedule submit() once a call has completed */
+    void resume();
+
+    /** @brief Number of the Create calls in flight */
+    static constexpr size_t maxCalls = 4;
+
+    std::deque<std::string> pending;
+    pldm::utils::AsyncCalls calls;
+    std::unique_ptr<sdeventplus::source::Defer> resumeEvent;
+};
+
 /** @class PelHandler
  *
  *  @brief Inherits and implements FileHandler. This class is used
@@ -43,6 +98,21 @@ class PelHandler : public FileHandler
      */
     virtual int storePel(std::string&& pelFileName);
 
+    /** @brief Build the Create call passing a pel file to the pel daemon
+     *
+     *  @param[in] pelFileName - the pel file path
+     *
+     *  @throw sdbusplus::exception_t when the logging service isn't found
+     */
+    static sdbusplus::message_t newCreateCall(std::string&& pelFileName);
+
+    /** @brief Queue a staged pel for the pel daemon, it is stored in place
+     *  when the queue is full
+     *
+     *  @param[in] pelFileName - the pel file path
+     */
+    int queuePel(std::string&& pelFileName);
+
     virtual int newFileAvailable(uint64_t /*length*/)
     {
         return PLDM_ERROR_UNSUPPORTED_PLDM_CMD;
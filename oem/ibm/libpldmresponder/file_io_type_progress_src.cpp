@@ -12,8 +12,86 @@ namespace pldm
 namespace responder
 {
 
-int ProgressCodeHandler::setRawBootProperty(
-    const std::tuple<uint64_t, std::vector<uint8_t>>& progressCodeBuffer)
+ProgressCodePublisher::ProgressCodePublisher(sdeventplus::Event& event,
+                                             sdbusplus::bus_t& bus) :
+    bus(bus),
+    timer(event, [this](auto&) { flush(); })
+{
+    timer.setEnabled(false);
+    instance = this;
+}
+
+ProgressCodePublisher::~ProgressCodePublisher()
+{
+    instance = nullptr;
+}
+
+void ProgressCodePublisher::publish(ProgressCode&& progressCode)
+{
+    held.emplace_back(std::move(progressCode));
+    if (held.size() > historySize)
+    {
+        held.pop_front();
+        dropped++;
+    }
+
+    /* The first code of a burst is set now, the others when the interval
+     * ends */
+    if (!timer.isEnabled())
+    {
+        flush();
+    }
+}
+
+void ProgressCodePublisher::flush()
+{
+    if (held.empty())
+    {
+        timer.setEnabled(false);
+        return;
+    }
+    timer.restartOnce(interval);
+    if (calls.pending())
+    {
+        /* Held until the codes in flight are replied */
+        return;
+    }
+
+    if (dropped > reportedDrops)
+    {
+        info("Dropped {NUM} progress codes for the newer ones", "NUM",
+             dropped - reportedDrops);
+        reportedDrops = dropped;
+    }
+    while (!held.empty())
+    {
+        auto progressCode = std::move(held.front());
+        held.pop_front();
+        try
+        {
+            auto method = ProgressCodeHandler::makeRawBootCall(bus,
+                                                               progressCode);
+            calls.call(bus, method, [](sdbusplus::message_t& reply) {
+                if (reply.is_method_error())
+                {
+                    error(
+                        "failed to set the progress code on host-postd, ERRNO={ERRNO}",
+                        "ERRNO", reply.get_errno());
+                }
+            });
+        }
+        catch (const std::exception& e)
+        {
+            error(
+                "failed to make a d-bus call to host-postd daemon, ERROR={ERR_EXCEP}",
+                "ERR_EXCEP", e.what());
+        }
+    }
+}
+
+sdbusplus::message_t
+    ProgressCodeHandler::makeRawBootCall(sdbusplus::bus_t& bus,
+                                         const ProgressCode& progressCodeBuffer)
 {
     static constexpr auto RawObjectPath =
         "/xyz/openbmc_project/state/boot/raw0";
@@ -23,18 +101,24 @@ int ProgressCodeHandler::setRawBootProperty(
     static constexpr auto RawProperty = "Value";
     static constexpr auto SetMethod = "Set";
 
+    /* The service is kept by the ServiceCache once it is enabled */
+    auto service = pldm::utils::DBusHandler().getService(RawObjectPath,
+                                                         RawInterface);
+    auto method = bus.new_method_call(service.c_str(), RawObjectPath,
+                                      FreedesktopInterface, SetMethod);
+    method.append(RawInterface, RawProperty,
+                  std::variant<ProgressCode>(progressCodeBuffer));
+    return method;
+}
+
+int ProgressCodeHandler::setRawBootProperty(
+    const std::tuple<uint64_t, std::vector<uint8_t>>& progressCodeBuffer)
+{
     auto& bus = pldm::utils::DBusHandler::getBus();
 
     try
     {
-        auto service = pldm::utils::DBusHandler().getService(RawObjectPath,
-                                                             RawInterface);
-        auto method = bus.new_method_call(service.c_str(), RawObjectPath,
-                                          FreedesktopInterface, SetMethod);
-        method.append(RawInterface, RawProperty,
-                      std::variant<std::tuple<uint64_t, std::vector<uint8_t>>>(
-                          progressCodeBuffer));
-
+        auto method = makeRawBootCall(bus, progressCodeBuffer);
         bus.call_noreply(method, dbusTimeout);
     }
     catch (const std::exception& e)
@@ -70,6 +154,12 @@ int ProgressCodeHandler::write(const char* buffer, uint32_t /*offset*/,
         for (int i = 0; i < 8; i++)
             primaryCode |= (uint64_t)primaryCodeArray[i] << 8 * i;
 
+        if (auto publisher = ProgressCodePublisher::get())
+        {
+            publisher->publish(
+                std::make_tuple(primaryCode, std::move(secondaryCode)));
+            return PLDM_SUCCESS;
+        }
         return setRawBootProperty(std::make_tuple(primaryCode, secondaryCode));
     }
     return PLDM_ERROR;
@@ -1,13 +1,96 @@
 #pragma once
 
+#include "common/utils.hpp"
 #include "file_io_by_type.hpp"
 
+#include <sdbusplus/bus.hpp>
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/utility/timer.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <tuple>
+#include <vector>
+
 namespace pldm
 {
 
 namespace responder
 {
 
+/** @brief Primary code and SRC buffer of a progress code */
+using ProgressCode = std::tuple<uint64_t, std::vector<uint8_t>>;
+
+/** @class ProgressCodePublisher
+ *
+ *  Coalesces the progress codes the host sends during the IPL. The first
+ *  code of a burst is set to the Raw property of host-postd at once, the
+ *  codes received in the following interval are held and only the latest
+ *  few of them are set when it ends, oldest first. The properties are set
+ *  without waiting for the replies, so a burst never serializes on D-Bus,
+ *  and no code is sent while the previous ones are still in flight. Without
+ *  a publisher the codes are set synchronously, one at a time.
+ */
+class ProgressCodePublisher
+{
+  public:
+    /** @brief Interval the progress codes are coalesced over */
+    static constexpr std::chrono::milliseconds interval{100};
+    /** @brief Progress codes held per interval, the older ones are dropped */
+    static constexpr size_t historySize = 4;
+
+    ProgressCodePublisher() = delete;
+    ProgressCodePublisher(const ProgressCodePublisher&) = delete;
+    ProgressCodePublisher& operator=(const ProgressCodePublisher&) = delete;
+
+    /** @brief Constructor, the publisher of the process
+     *
+     *  @param[in] event - event loop running the interval timer
+     *  @param[in] bus - bus connection processed by the event loop
+     */
+    ProgressCodePublisher(sdeventplus::Event& event, sdbusplus::bus_t& bus);
+
+    /** @brief Destructor, the codes held are dropped */
+    ~ProgressCodePublisher();
+
+    /** @brief Get the publisher of the process
+     *
+     *  @return - the publisher, nullptr if there is none
+     */
+    static ProgressCodePublisher* get()
+    {
+        return instance;
+    }
+
+    /** @brief Queue a progress code for the Raw property
+     *
+     *  @param[in] progressCode - progress code received from the host
+     */
+    void publish(ProgressCode&& progressCode);
+
+    /** @brief Number of the progress codes dropped for newer ones */
+    uint64_t getDropped() const
+    {
+        return dropped;
+    }
+
+  private:
+    /** @brief Set the progress codes held, called when the interval ends */
+    void flush();
+
+    sdbusplus::bus_t& bus;
+    pldm::utils::AsyncCalls calls;
+    /** @brief Progress codes waiting for the end of the interval */
+    std::deque<ProgressCode> held;
+    uint64_t dropped = 0;
+    uint64_t reportedDrops = 0;
+    sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> timer;
+
+    static inline ProgressCodePublisher* instance = nullptr;
+};
+
 /** @class ProgressCodeHandler
  *
  * @brief Inherits and implemented FileHandler. This class is used
@@ -61,6 +144,17 @@ class ProgressCodeHandler : public FileHandler
     virtual int setRawBootProperty(
         const std::tuple<uint64_t, std::vector<uint8_t>>& progressCodeBuffer);
 
+    /** @brief Create the method call setting the Raw property
+     *
+     *  @param[in] bus - bus connection
+     *  @param[in] progressCodeBuffer - the progress Code SRC Buffer
+     *
+     *  @throw std::exception if the service can't be found
+     */
+    static sdbusplus::message_t
+        makeRawBootCall(sdbusplus::bus_t& bus,
+                        const ProgressCode& progressCodeBuffer);
+
     /** @brief ProgressCodeHandler destructor
      */
 
@@ -9,7 +9,8 @@
 
 #include <phosphor-logging/lg2.hpp>
 
-#include <iostream>
+#include <exception>
+#include <variant>
 
 PHOSPHOR_LOG2_USING;
 
@@ -19,27 +20,56 @@ namespace pldm
 {
 namespace responder
 {
-int keywordHandler::read(uint32_t offset, uint32_t& length, Response& response,
-                         oem_platform::Handler* /*oemPlatformHandler*/)
+namespace
+{
+constexpr auto keywrdObjPath =
+    "/xyz/openbmc_project/inventory/system/chassis/motherboard";
+constexpr auto keywrdPropName = "PD_D";
+constexpr auto keywrdInterface = "com.ibm.ipzvpd.PSPD";
+} // namespace
+
+KeywordCache& KeywordCache::get()
+{
+    static KeywordCache cache;
+    return cache;
+}
+
+void KeywordCache::enable(sdbusplus::bus_t& bus)
+{
+    namespace rules = sdbusplus::bus::match::rules;
+    match = std::make_unique<sdbusplus::bus::match_t>(
+        bus, rules::propertiesChanged(keywrdObjPath, keywrdInterface),
+        [this](sdbusplus::message_t&) { invalidate(); });
+}
+
+const std::vector<uint8_t>& KeywordCache::keyword()
 {
-    const char* keywrdObjPath =
-        "/xyz/openbmc_project/inventory/system/chassis/motherboard";
-    const char* keywrdPropName = "PD_D";
-    const char* keywrdInterface = "com.ibm.ipzvpd.PSPD";
+    if (enabled() && value)
+    {
+        return *value;
+    }
 
     std::variant<std::vector<byte>> keywrd;
+    auto& bus = pldm::utils::DBusHandler::getBus();
+    auto service = pldm::utils::DBusHandler().getService(keywrdObjPath,
+                                                         keywrdInterface);
+    auto method = bus.new_method_call(service.c_str(), keywrdObjPath,
+                                      "org.freedesktop.DBus.Properties", "Get");
+    method.append(keywrdInterface, keywrdPropName);
+    auto reply = bus.call(method, dbusTimeout);
+    reply.read(keywrd);
+    value = std::move(std::get<std::vector<byte>>(keywrd));
+    return *value;
+}
 
+int keywordHandler::read(uint32_t offset, uint32_t& length, Response& response,
+                         oem_platform::Handler* /*oemPlatformHandler*/)
+{
+    static const std::vector<uint8_t> noKeyword;
+    const std::vector<uint8_t>* keywrd = &noKeyword;
     try
     {
-        auto& bus = pldm::utils::DBusHandler::getBus();
-        auto service = pldm::utils::DBusHandler().getService(keywrdObjPath,
-                                                             keywrdInterface);
-        auto method = bus.new_method_call(service.c_str(), keywrdObjPath,
-                                          "org.freedesktop.DBus.Properties",
-                                          "Get");
-        method.append(keywrdInterface, keywrdPropName);
-        auto reply = bus.call(method, dbusTimeout);
-        reply.read(keywrd);
+        keywrd = &KeywordCache::get().keyword();
     }
     catch (const std::exception& e)
     {
@@ -48,7 +78,7 @@ int keywordHandler::read(uint32_t offset, uint32_t& length, Response& response,
             "KEYWORD_INTF", keywrdInterface, "ERR_EXCEP", e.what());
     }
 
-    uint32_t keywrdSize = std::get<std::vector<byte>>(keywrd).size();
+    uint32_t keywrdSize = keywrd->size();
     if (length < keywrdSize)
     {
         error(
@@ -57,29 +87,7 @@ int keywordHandler::read(uint32_t offset, uint32_t& length, Response& response,
         return PLDM_ERROR_INVALID_DATA;
     }
 
-    namespace fs = std::filesystem;
-    constexpr auto keywrdDirPath = "/tmp/pldm/";
-    constexpr auto keywrdFilePath = "/tmp/pldm/vpdKeywrd.bin";
-
-    if (!fs::exists(keywrdDirPath))
-    {
-        fs::create_directories(keywrdDirPath);
-        fs::permissions(keywrdDirPath,
-                        fs::perms::others_read | fs::perms::owner_write);
-    }
-
-    std::ofstream keywrdFile(keywrdFilePath);
-    auto fd = open(keywrdFilePath, std::ios::out | std::ofstream::binary);
-    if (!keywrdFile)
-    {
-        error("VPD keyword file open error: {KEYWORD_FILE_PATH} errno: {ERR}",
-              "KEYWORD_FILE_PATH", keywrdFilePath, "ERR", errno);
-        pldm::utils::reportError(
-            "xyz.openbmc_project.PLDM.Error.readKeywordHandler.keywordFileOpenError");
-        return PLDM_ERROR;
-    }
-
-    if (offset > keywrdSize)
+    if (offset >= keywrdSize)
     {
         error("Offset exceeds file size, OFFSET={OFFSET} FILE_SIZE={FILE_SIZE}",
               "OFFSET", offset, "FILE_SIZE", keywrdSize);
@@ -87,35 +95,9 @@ int keywordHandler::read(uint32_t offset, uint32_t& length, Response& response,
     }
 
     // length of keyword data should be same as keyword data size in dbus
-    // object
-    length = static_cast<uint32_t>(keywrdSize) - offset;
-
-    auto returnCode = lseek(fd, offset, SEEK_SET);
-    if (returnCode == -1)
-    {
-        error("Could not find keyword data at given offset. File Seek failed");
-        return PLDM_ERROR;
-    }
-
-    keywrdFile.write((const char*)std::get<std::vector<byte>>(keywrd).data(),
-                     keywrdSize);
-    if (keywrdFile.bad())
-    {
-        error("Error while writing to file: {KEYWORD_FILE_PATH}",
-              "KEYWORD_FILE_PATH", keywrdFilePath);
-    }
-    keywrdFile.close();
-
-    auto rc = readFile(keywrdFilePath, offset, keywrdSize, response);
-    fs::remove(keywrdFilePath);
-    if (rc)
-    {
-        error("Read error for keyword file with size: {KEYWORD_SIZE}",
-              "KEYWORD_SIZE", keywrdSize);
-        pldm::utils::reportError(
-            "xyz.openbmc_project.PLDM.Error.readKeywordHandler.keywordFileReadError");
-        return PLDM_ERROR;
-    }
+    // object, the keyword is copied straight into the response
+    length = keywrdSize - offset;
+    response.insert(response.end(), keywrd->begin() + offset, keywrd->end());
     return PLDM_SUCCESS;
 }
 } // namespace responder
@@ -2,11 +2,64 @@
 
 #include "file_io_by_type.hpp"
 
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/bus/match.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
 namespace pldm
 {
 namespace responder
 {
 using vpdFileType = uint16_t;
+
+/** @class KeywordCache
+ *
+ *  Process wide cache of the #D keyword of the VPD. Once enabled, the
+ *  keyword is read from D-Bus the first time it is requested, and then served
+ *  from memory until a PropertiesChanged signal of its VPD interface drops
+ *  it. Until then, the keyword is read from D-Bus on each request.
+ */
+class KeywordCache
+{
+  public:
+    /** @brief Get the cache of the process */
+    static KeywordCache& get();
+
+    /** @brief Subscribe for the signals invalidating the keyword and start
+     *         using the cache
+     *
+     *  @param[in] bus - bus connection processed by the event loop
+     */
+    void enable(sdbusplus::bus_t& bus);
+
+    /** @brief Whether the cache is used */
+    bool enabled() const
+    {
+        return match != nullptr;
+    }
+
+    /** @brief Get the #D keyword
+     *
+     *  @return the keyword, valid until the next call
+     *
+     *  @throw std::exception when the D-Bus read fails
+     */
+    const std::vector<uint8_t>& keyword();
+
+    /** @brief Drop the cached keyword */
+    void invalidate()
+    {
+        value.reset();
+    }
+
+  private:
+    std::optional<std::vector<uint8_t>> value;
+    std::unique_ptr<sdbusplus::bus::match_t> match;
+};
 /** @class keywordFileHandler
  *
  *  @brief Inherits and implements FileHandler. This class is used
@@ -0,0 +1,135 @@
+#include "file_io_worker.hpp"
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <cerrno>
+#include <exception>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace responder
+{
+
+FileIOWorker::FileIOWorker(sdeventplus::Event& event, size_t threads,
+                           size_t depth) :
+    depth(depth)
+{
+    eventFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (eventFd < 0)
+    {
+        error("Failed to create the file I/O completion eventfd, ERROR={ERR}",
+              "ERR", errno);
+        return;
+    }
+    completion = std::make_unique<sdeventplus::source::IO>(
+        event, eventFd, EPOLLIN,
+        [this](sdeventplus::source::IO&, int, uint32_t) { complete(); });
+
+    workers.reserve(threads);
+    for (size_t i = 0; i < threads; i++)
+    {
+        workers.emplace_back(&FileIOWorker::run, this);
+    }
+}
+
+FileIOWorker::~FileIOWorker()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stop = true;
+    }
+    cv.notify_all();
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    completion.reset();
+    if (eventFd >= 0)
+    {
+        close(eventFd);
+    }
+}
+
+bool FileIOWorker::submit(Work&& work, ResponseSender&& respond)
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (workers.empty() || inFlight >= depth)
+        {
+            return false;
+        }
+        inFlight++;
+        pending.push_back({std::move(work), std::move(respond), {}});
+    }
+    cv.notify_one();
+    return true;
+}
+
+void FileIOWorker::run()
+{
+    std::unique_lock<std::mutex> guard(lock);
+    while (true)
+    {
+        cv.wait(guard, [this] { return stop || !pending.empty(); });
+        if (stop)
+        {
+            return;
+        }
+        auto job = std::move(pending.front());
+        pending.pop_front();
+        guard.unlock();
+
+        try
+        {
+            job.response = job.work();
+        }
+        catch (const std::exception& e)
+        {
+            /* The operations encode their errors, nothing is sent for one
+             * which escaped */
+            error("File I/O operation failed, ERROR={ERR_EXCEP}", "ERR_EXCEP",
+                  e.what());
+        }
+
+        guard.lock();
+        done.push_back(std::move(job));
+        uint64_t count = 1;
+        if (::write(eventFd, &count, sizeof(count)) < 0)
+        {
+            error("Failed to signal the file I/O completion, ERROR={ERR}",
+                  "ERR", errno);
+        }
+    }
+}
+
+void FileIOWorker::complete()
+{
+    uint64_t count = 0;
+    if (::read(eventFd, &count, sizeof(count)) < 0 && errno != EAGAIN)
+    {
+        error("Failed to read the file I/O completion, ERROR={ERR}", "ERR",
+              errno);
+    }
+
+    std::deque<Job> jobs;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        jobs.swap(done);
+        inFlight -= jobs.size();
+    }
+    for (auto& job : jobs)
+    {
+        if (!job.response.empty())
+        {
+            job.respond(std::move(job.response));
+        }
+    }
+}
+
+} // namespace responder
+} // namespace pldm
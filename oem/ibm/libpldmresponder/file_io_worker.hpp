@@ -0,0 +1,93 @@
+#pragma once
+
+#include "pldmd/handler.hpp"
+
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/io.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pldm
+{
+namespace responder
+{
+
+/** @class FileIOWorker
+ *
+ *  Runs the blocking file operations of the file I/O commands on a pool of
+ *  threads, so a large write flushing to the flash doesn't starve the other
+ *  PLDM traffic. The responses are sent from the event loop, which is woken
+ *  through an eventfd as the operations complete. The number of operations
+ *  queued, running or waiting for their response to be sent is bounded.
+ */
+class FileIOWorker
+{
+  public:
+    /** @brief File operation, returns the PLDM response message */
+    using Work = std::function<Response()>;
+
+    FileIOWorker() = delete;
+    FileIOWorker(const FileIOWorker&) = delete;
+    FileIOWorker& operator=(const FileIOWorker&) = delete;
+
+    /** @brief Start the threads
+     *
+     *  @param[in] event - event loop sending the responses
+     *  @param[in] threads - number of threads running the operations
+     *  @param[in] depth - number of operations in flight
+     */
+    FileIOWorker(sdeventplus::Event& event, size_t threads, size_t depth);
+
+    /** @brief Stop the threads, the queued operations are dropped */
+    ~FileIOWorker();
+
+    /** @brief Queue a file operation
+     *
+     *  @param[in] work - the operation, run on one of the threads
+     *  @param[in] respond - sends the response, called from the event loop
+     *
+     *  @return false if too many operations are in flight, the caller runs
+     *          the operation in place
+     */
+    bool submit(Work&& work, ResponseSender&& respond);
+
+  private:
+    /** @struct Job
+     *  @brief One file operation and its response
+     */
+    struct Job
+    {
+        Work work;
+        ResponseSender respond;
+        Response response;
+    };
+
+    /** @brief Thread loop */
+    void run();
+
+    /** @brief Send the responses of the completed operations */
+    void complete();
+
+    size_t depth;
+    /** @brief Operations queued, running or waiting for their response */
+    size_t inFlight = 0;
+
+    std::mutex lock;
+    std::condition_variable cv;
+    std::deque<Job> pending;
+    std::deque<Job> done;
+    bool stop = false;
+
+    int eventFd = -1;
+    std::unique_ptr<sdeventplus::source::IO> completion;
+    std::vector<std::thread> workers;
+};
+
+} // namespace responder
+} // namespace pldm
@@ -1,9 +1,10 @@
 #include "file_table.hpp"
 
-#include <libpldm/utils.h>
+#include "common/utils.hpp"
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 
@@ -35,6 +36,7 @@ FileTable::FileTable(const std::string& fileTableConfigPath)
     uint32_t traits = 0;
     size_t tableSize = 0;
     Handle handle = 0;
+    fileTable.clear();
     auto iter = fileTable.begin();
 
     // Iterate through each JSON object in the config file
@@ -88,6 +90,7 @@ FileTable::FileTable(const std::string& fileTableConfigPath)
                     fileNameLength, iter);
         std::advance(iter, fileNameLength);
 
+        sizeOffsets.emplace(handle, std::distance(fileTable.begin(), iter));
         std::copy_n(reinterpret_cast<uint8_t*>(&fileSize), sizeof(fileSize),
                     iter);
         std::advance(iter, sizeof(fileSize));
@@ -116,17 +119,53 @@ FileTable::FileTable(const std::string& fileTableConfigPath)
     }
 
     // Calculate the checksum
-    checkSum = crc32(fileTable.data(), fileTable.size());
+    fileTable.resize(fileTable.size() + sizeof(checkSum));
+    updateChecksum();
 }
 
-Table FileTable::operator()() const
+void FileTable::updateChecksum()
 {
-    Table table(fileTable);
-    table.resize(fileTable.size() + sizeof(checkSum));
-    auto iter = table.begin() + fileTable.size();
+    auto tableSize = fileTable.size() - sizeof(checkSum);
+    checkSum = pldm::utils::Crc32::of(
+        std::span<const uint8_t>(fileTable.data(), tableSize));
     std::copy_n(reinterpret_cast<const uint8_t*>(&checkSum), sizeof(checkSum),
+                fileTable.begin() + tableSize);
+}
+
+Table FileTable::operator()() const
+{
+    std::lock_guard<std::mutex> guard(*lock);
+    return fileTable;
+}
+
+bool FileTable::updateFileSize(Handle handle)
+{
+    auto entry = tableEntries.find(handle);
+    auto offset = sizeOffsets.find(handle);
+    if (entry == tableEntries.end() || offset == sizeOffsets.end())
+    {
+        return false;
+    }
+
+    std::error_code ec;
+    auto fileSize =
+        static_cast<uint32_t>(fs::file_size(entry->second.fsPath, ec));
+    if (ec)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> guard(*lock);
+    auto iter = fileTable.begin() + offset->second;
+    if (std::equal(iter, iter + sizeof(fileSize),
+                   reinterpret_cast<const uint8_t*>(&fileSize)))
+    {
+        return false;
+    }
+    std::copy_n(reinterpret_cast<const uint8_t*>(&fileSize), sizeof(fileSize),
                 iter);
-    return table;
+    updateChecksum();
+    return true;
 }
 
 FileTable& buildFileTable(const std::string& fileTablePath)
@@ -134,7 +173,7 @@ FileTable& buildFileTable(const std::string& fileTablePath)
     static FileTable table;
     if (table.isEmpty())
     {
-        table = std::move(FileTable(fileTablePath));
+        table = FileTable(fileTablePath);
     }
     return table;
 }
@@ -6,6 +6,9 @@
 #include <nlohmann/json.hpp>
 
 #include <filesystem>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 namespace pldm
@@ -53,8 +56,8 @@ class FileTable
     FileTable(const std::string& fileTableConfigPath);
     FileTable() = default;
     ~FileTable() = default;
-    FileTable(const FileTable&) = default;
-    FileTable& operator=(const FileTable&) = default;
+    FileTable(const FileTable&) = delete;
+    FileTable& operator=(const FileTable&) = delete;
     FileTable(FileTable&&) = default;
     FileTable& operator=(FileTable&&) = default;
 
@@ -64,6 +67,29 @@ class FileTable
      */
     Table operator()() const;
 
+    /** @brief Run a function on the encoded file attribute table, which is
+     *         not updated meanwhile
+     *
+     * @param[in] func - called with the table, including the checksum
+     *
+     * @return the result of the function
+     */
+    template <typename Func>
+    auto withTable(Func&& func) const
+    {
+        std::lock_guard<std::mutex> guard(*lock);
+        return func(static_cast<const Table&>(fileTable));
+    }
+
+    /** @brief Update the size of a file in the file attribute table, after
+     *         it was written
+     *
+     * @param[in] handle - file handle
+     *
+     * @return bool - true if the size changed
+     */
+    bool updateFileSize(Handle handle);
+
     /** @brief Get the FileEntry at the file handle
      *
      * @param[in] handle - file handle
@@ -81,7 +107,7 @@ class FileTable
      */
     bool isEmpty() const
     {
-        return fileTable.empty();
+        return tableEntries.empty();
     }
 
     /** @brief Clear the file table contents
@@ -89,19 +115,28 @@ class FileTable
      */
     void clear()
     {
+        std::lock_guard<std::mutex> guard(*lock);
         tableEntries.clear();
-        fileTable.clear();
+        sizeOffsets.clear();
+        fileTable.assign(sizeof(checkSum), 0);
         padCount = 0;
         checkSum = 0;
     }
 
   private:
+    /** @brief Store the checksum of the file attribute table after it */
+    void updateChecksum();
+
     /** @brief handle to FileEntry mappings for lookups based on file handle */
     std::unordered_map<Handle, FileEntry> tableEntries;
 
-    /** @brief file attribute table including the pad bytes, except the checksum
-     */
-    std::vector<uint8_t> fileTable;
+    /** @brief handle to the offset of the file size in the file attribute
+     *  table, to update it in place */
+    std::unordered_map<Handle, size_t> sizeOffsets;
+
+    /** @brief file attribute table including the pad bytes and the checksum,
+     *  encoded once and updated in place */
+    std::vector<uint8_t> fileTable = std::vector<uint8_t>(sizeof(uint32_t));
 
     /** @brief the pad count of the file attribute table, the number of pad
      * bytes is between 0 and 3 */
@@ -109,6 +144,10 @@ class FileTable
 
     /** @brief the checksum of the file attribute table */
     uint32_t checkSum = 0;
+
+    /** @brief Serializes the updates of the file sizes, which can run on the
+     *  file I/O threads, with the readers of the table */
+    std::unique_ptr<std::mutex> lock = std::make_unique<std::mutex>();
 };
 
 /** @brief Build the file attribute table if not already built using the
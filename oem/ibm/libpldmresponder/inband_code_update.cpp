@@ -5,12 +5,20 @@
 #include "xyz/openbmc_project/Common/error.hpp"
 
 #include <arpa/inet.h>
+#include <fcntl.h>
 #include <libpldm/entity.h>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include <phosphor-logging/lg2.hpp>
 #include <sdbusplus/server.hpp>
 #include <xyz/openbmc_project/Dump/NewDump/server.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
 #include <exception>
 #include <fstream>
 
@@ -30,9 +38,6 @@ auto lidDirPath = fs::path(LID_STAGING_DIR) / "lid";
 /** @brief Directory where the image files are stored as they are built */
 auto imageDirPath = fs::path(LID_STAGING_DIR) / "image";
 
-/** @brief Directory where the code update tarball files are stored */
-auto updateDirPath = fs::path(LID_STAGING_DIR) / "update";
-
 /** @brief The file name of the code update tarball */
 constexpr auto tarImageName = "image.tar";
 
@@ -458,6 +463,198 @@ int executeCmd(const T&... t)
     return 0;
 }
 
+namespace
+{
+
+/** @brief Size of a tar block, the archive is made of headers and data
+ *         padded to it */
+constexpr size_t tarBlockSize = 512;
+
+/** @brief Copy a part of a file to another one in the kernel
+ *
+ *  @param[in] inFd - file to copy from
+ *  @param[in] offset - offset of the part to copy
+ *  @param[in] length - length of the part to copy
+ *  @param[in] outFd - file to append to
+ *
+ *  @return true on success
+ */
+bool copyRange(int inFd, off_t offset, uint64_t length, int outFd)
+{
+    while (length)
+    {
+        auto rc = sendfile(outFd, inFd, &offset, length);
+        if (rc <= 0)
+        {
+            if (rc < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            error("Failed to copy the file data, ERROR={ERR}", "ERR", errno);
+            return false;
+        }
+        length -= rc;
+    }
+    return true;
+}
+
+/** @brief Get the size of the data of a tar entry from its header */
+uint64_t tarEntrySize(const std::array<char, tarBlockSize>& header)
+{
+    constexpr size_t sizeOffset = 124;
+    constexpr size_t sizeLength = 12;
+    uint64_t size = 0;
+    if (header[sizeOffset] & 0x80)
+    {
+        /* base-256 encoding of the large sizes */
+        for (size_t i = sizeOffset + 1; i < sizeOffset + sizeLength; i++)
+        {
+            size = (size << 8) | static_cast<uint8_t>(header[i]);
+        }
+        return size;
+    }
+    for (size_t i = sizeOffset; i < sizeOffset + sizeLength; i++)
+    {
+        if (header[i] < '0' || header[i] > '7')
+        {
+            continue;
+        }
+        size = (size << 3) | (header[i] - '0');
+    }
+    return size;
+}
+
+/** @brief Find where the end-of-archive blocks of a tarball start
+ *
+ *  @return the offset, or -1 on error
+ */
+off_t tarArchiveEnd(int fd)
+{
+    std::array<char, tarBlockSize> header{};
+    off_t offset = 0;
+    while (true)
+    {
+        auto rc = pread(fd, header.data(), header.size(), offset);
+        if (rc == 0)
+        {
+            return offset;
+        }
+        if (rc != static_cast<ssize_t>(header.size()))
+        {
+            return -1;
+        }
+        if (std::all_of(header.begin(), header.end(),
+                        [](char c) { return c == 0; }))
+        {
+            return offset;
+        }
+        auto size = tarEntrySize(header);
+        offset += tarBlockSize +
+                  (size + tarBlockSize - 1) / tarBlockSize * tarBlockSize;
+    }
+}
+
+/** @brief Append a regular file entry to a tarball
+ *
+ *  @param[in] outFd - the tarball
+ *  @param[in] name - name of the entry
+ *  @param[in] path - file holding the data of the entry
+ *
+ *  @return true on success
+ */
+bool appendTarEntry(int outFd, const std::string& name, const fs::path& path)
+{
+    int inFd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (inFd < 0)
+    {
+        error("Failed to open {PATH}, ERROR={ERR}", "PATH", path.c_str(),
+              "ERR", errno);
+        return false;
+    }
+    pldm::utils::CustomFD fd(inFd);
+    struct stat st;
+    if (fstat(fd(), &st) < 0)
+    {
+        return false;
+    }
+    uint64_t size = st.st_size;
+
+    /* ustar header, the fields are NUL terminated octal numbers */
+    std::array<char, tarBlockSize> header{};
+    std::strncpy(header.data(), name.c_str(), 99);
+    std::snprintf(header.data() + 100, 8, "%07o", 0644);
+    std::snprintf(header.data() + 108, 8, "%07o", 0);
+    std::snprintf(header.data() + 116, 8, "%07o", 0);
+    std::snprintf(header.data() + 124, 12, "%011llo",
+                  static_cast<unsigned long long>(size));
+    std::snprintf(header.data() + 136, 12, "%011llo",
+                  static_cast<unsigned long long>(st.st_mtime));
+    header[156] = '0';
+    std::memcpy(header.data() + 257, "ustar", 6);
+    std::memcpy(header.data() + 263, "00", 2);
+    std::memset(header.data() + 148, ' ', 8);
+    unsigned checksum = 0;
+    for (auto c : header)
+    {
+        checksum += static_cast<uint8_t>(c);
+    }
+    std::snprintf(header.data() + 148, 8, "%06o", checksum);
+    header[155] = ' ';
+
+    std::array<char, tarBlockSize> padding{};
+    auto padLength = (tarBlockSize - size % tarBlockSize) % tarBlockSize;
+    return write(outFd, header.data(), header.size()) ==
+               static_cast<ssize_t>(header.size()) &&
+           copyRange(fd(), 0, size, outFd) &&
+           write(outFd, padding.data(), padLength) ==
+               static_cast<ssize_t>(padLength);
+}
+
+} // namespace
+
+int writeUpdateTarball(const fs::path& bmcTarball, const fs::path& hostfwImage,
+                       const fs::path& output)
+{
+    int inFd = open(bmcTarball.c_str(), O_RDONLY | O_CLOEXEC);
+    if (inFd < 0)
+    {
+        error("Failed to open the BMC tarball {PATH}, ERROR={ERR}", "PATH",
+              bmcTarball.c_str(), "ERR", errno);
+        return PLDM_ERROR;
+    }
+    pldm::utils::CustomFD bmcFd(inFd);
+    auto end = tarArchiveEnd(bmcFd());
+    if (end < 0)
+    {
+        error("Truncated BMC tarball {PATH}", "PATH", bmcTarball.c_str());
+        return PLDM_ERROR;
+    }
+
+    int outFd = open(output.c_str(),
+                     O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (outFd < 0)
+    {
+        error("Failed to create the tarball {PATH}, ERROR={ERR}", "PATH",
+              output.c_str(), "ERR", errno);
+        return PLDM_ERROR;
+    }
+    pldm::utils::CustomFD fd(outFd);
+
+    /* The entries of the BMC tarball, the hostfw image, then the two
+     * end-of-archive blocks */
+    std::array<char, 2 * tarBlockSize> archiveEnd{};
+    if (!copyRange(bmcFd(), 0, end, fd()) ||
+        !appendTarEntry(fd(), hostfwImage.filename(), hostfwImage) ||
+        write(fd(), archiveEnd.data(), archiveEnd.size()) !=
+            static_cast<ssize_t>(archiveEnd.size()))
+    {
+        error("Failed to write the tarball {PATH}", "PATH", output.c_str());
+        fs::remove(output);
+        return PLDM_ERROR;
+    }
+    return PLDM_SUCCESS;
+}
+
 int processCodeUpdateLid(const std::string& filePath)
 {
     struct LidHeader
@@ -504,31 +701,50 @@ int processCodeUpdateLid(const std::string& filePath)
     fs::create_directories(imageDirPath);
     fs::create_directories(lidDirPath);
 
+    ifs.close();
+
+    // Skip the header and concatenate the BMC LIDs into a tar file, the
+    // other LIDs are stored without the header. The data is copied in the
+    // kernel.
     constexpr auto bmcClass = 0x2000;
+    int outFd = -1;
     if (htons(header.lidClass) == bmcClass)
     {
-        // Skip the header and concatenate the BMC LIDs into a tar file
-        std::ofstream ofs(tarImagePath,
-                          std::ios::out | std::ios::binary | std::ios::app);
-        ifs.seekg(htonl(header.headerSize));
-        ofs << ifs.rdbuf();
-        ofs.flush();
-        ofs.close();
+        outFd = open(tarImagePath.c_str(),
+                     O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
     }
     else
     {
         std::stringstream lidFileName;
         lidFileName << std::hex << htonl(header.lidNumber) << ".lid";
         auto lidNoHeaderPath = fs::path(lidDirPath) / lidFileName.str();
-        std::ofstream ofs(lidNoHeaderPath,
-                          std::ios::out | std::ios::binary | std::ios::trunc);
-        ifs.seekg(htonl(header.headerSize));
-        ofs << ifs.rdbuf();
-        ofs.flush();
-        ofs.close();
+        outFd = open(lidNoHeaderPath.c_str(),
+                     O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    }
+    int inFd = open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (outFd < 0 || inFd < 0)
+    {
+        error("Failed to open the LID files of {DIR_PATH}, ERROR={ERR}",
+              "DIR_PATH", filePath.c_str(), "ERR", errno);
+        if (outFd >= 0)
+        {
+            close(outFd);
+        }
+        if (inFd >= 0)
+        {
+            close(inFd);
+        }
+        return PLDM_ERROR;
+    }
+    pldm::utils::CustomFD out(outFd);
+    pldm::utils::CustomFD in(inFd);
+    auto headerSize = htonl(header.headerSize);
+    if (!copyRange(in(), headerSize, fs::file_size(filePath) - headerSize,
+                   out()))
+    {
+        return PLDM_ERROR;
     }
 
-    ifs.close();
     fs::remove(filePath);
     return PLDM_SUCCESS;
 }
@@ -558,33 +774,12 @@ int CodeUpdate::assembleCodeUpdateImage()
                 exit(EXIT_FAILURE);
             }
 
-            fs::create_directories(updateDirPath);
-
-            // Extract the BMC tarball content
-            rc = executeCmd("/bin/tar", "-xf", tarImagePath.c_str(), "-C",
-                            updateDirPath);
-            if (rc < 0)
-            {
-                setCodeUpdateProgress(false);
-                auto sensorId = getFirmwareUpdateSensor();
-                sendStateSensorEvent(sensorId, PLDM_STATE_SENSOR_STATE, 0,
-                                     uint8_t(CodeUpdateState::FAIL),
-                                     uint8_t(CodeUpdateState::START));
-                exit(EXIT_FAILURE);
-            }
-
-            // Add the hostfw image to the directory where the contents were
-            // extracted
-            fs::copy_file(hostfwImagePath,
-                          fs::path(updateDirPath) / hostfwImageName,
-                          fs::copy_options::overwrite_existing);
-
-            // Remove the tarball file, then re-generate it with so that the
-            // hostfw image becomes part of the tarball
-            fs::remove(tarImagePath);
-            rc = executeCmd("/bin/tar", "-cf", tarImagePath, ".", "-C",
-                            updateDirPath);
-            if (rc < 0)
+            // Write the tarball expected by the phosphor software manager in
+            // one pass: the BMC tarball content followed by the hostfw image
+            fs::create_directories(updateImagePath.parent_path());
+            rc = writeUpdateTarball(tarImagePath, hostfwImagePath,
+                                    updateImagePath);
+            if (rc != PLDM_SUCCESS)
             {
                 error("Error occurred during the generation of the tarball");
                 setCodeUpdateProgress(false);
@@ -595,13 +790,7 @@ int CodeUpdate::assembleCodeUpdateImage()
                 exit(EXIT_FAILURE);
             }
 
-            // Copy the tarball to the update directory to trigger the phosphor
-            // software manager to create a version interface
-            fs::copy_file(tarImagePath, updateImagePath,
-                          fs::copy_options::overwrite_existing);
-
             // Cleanup
-            fs::remove_all(updateDirPath);
             fs::remove_all(lidDirPath);
             fs::remove_all(imageDirPath);
 
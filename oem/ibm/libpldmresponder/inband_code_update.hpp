@@ -4,6 +4,7 @@
 #include "libpldmresponder/pdr_utils.hpp"
 #include "libpldmresponder/platform.hpp"
 
+#include <filesystem>
 #include <string>
 
 namespace pldm
@@ -233,5 +234,16 @@ int setBootSide(uint16_t entityInstance, uint8_t currState,
  */
 int processCodeUpdateLid(const std::string& filePath);
 
+/* @brief Method to write the code update tarball in a single pass, the
+ *        entries of the BMC tarball followed by the hostfw image
+ * @param[in] bmcTarball - tarball assembled from the BMC LIDs
+ * @param[in] hostfwImage - hostfw image, added under its file name
+ * @param[in] output - path of the tarball to write
+ * @return - PLDM_SUCCESS codes
+ */
+int writeUpdateTarball(const std::filesystem::path& bmcTarball,
+                       const std::filesystem::path& hostfwImage,
+                       const std::filesystem::path& output);
+
 } // namespace responder
 } // namespace pldm
@@ -0,0 +1,137 @@
+#include "lid_map_cache.hpp"
+
+#include <fcntl.h>
+#include <libpldm/base.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <cerrno>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace responder
+{
+
+LidMapCache::Mapping::Mapping(int fd, const struct stat& st) :
+    dev(st.st_dev), ino(st.st_ino), size(st.st_size), mtime(st.st_mtim)
+{
+    auto addr = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED)
+    {
+        error("Failed to map the LID file, ERROR={ERR}", "ERR", errno);
+        return;
+    }
+    /* The host streams the LIDs from start to end */
+    madvise(addr, st.st_size, MADV_SEQUENTIAL);
+    contents = std::span<const uint8_t>(static_cast<const uint8_t*>(addr),
+                                        st.st_size);
+}
+
+LidMapCache::Mapping::~Mapping()
+{
+    if (!contents.empty())
+    {
+        munmap(const_cast<uint8_t*>(contents.data()), contents.size());
+    }
+}
+
+bool LidMapCache::Mapping::current(const struct stat& st) const
+{
+    return st.st_dev == dev && st.st_ino == ino && st.st_size == size &&
+           st.st_mtim.tv_sec == mtime.tv_sec &&
+           st.st_mtim.tv_nsec == mtime.tv_nsec;
+}
+
+LidMapCache& LidMapCache::get()
+{
+    static LidMapCache cache;
+    return cache;
+}
+
+std::shared_ptr<const LidMapCache::Mapping>
+    LidMapCache::map(const std::filesystem::path& path)
+{
+    struct stat st{};
+    if (stat(path.c_str(), &st) < 0 || !S_ISREG(st.st_mode) || !st.st_size)
+    {
+        erase(path);
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> guard(lock);
+    auto it = std::find_if(entries.begin(), entries.end(),
+                           [&path](const auto& entry) {
+        return entry.first == path.native();
+    });
+    if (it != entries.end())
+    {
+        if (it->second->current(st))
+        {
+            entries.splice(entries.begin(), entries, it);
+            return it->second;
+        }
+        /* The readers of the previous mapping keep it until they are done */
+        entries.erase(it);
+    }
+
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return nullptr;
+    }
+    /* The status of the file opened, in case it was replaced since */
+    if (fstat(fd, &st) < 0 || !st.st_size)
+    {
+        close(fd);
+        return nullptr;
+    }
+    auto mapping = std::make_shared<const Mapping>(fd, st);
+    close(fd);
+    if (mapping->data().empty())
+    {
+        return nullptr;
+    }
+
+    entries.emplace_front(path.native(), mapping);
+    if (entries.size() > maxEntries)
+    {
+        entries.pop_back();
+    }
+    return mapping;
+}
+
+void LidMapCache::erase(const std::filesystem::path& path)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    std::erase_if(entries, [&path](const auto& entry) {
+        return entry.first == path.native();
+    });
+}
+
+int LidMapCache::read(const Mapping& mapping, uint32_t offset,
+                      uint32_t& length, Response& response)
+{
+    auto data = mapping.data();
+    if (offset >= data.size())
+    {
+        error("Offset exceeds file size, OFFSET={OFFSET} FILE_SIZE={FILE_SIZE}",
+              "OFFSET", offset, "FILE_SIZE", data.size());
+        return PLDM_DATA_OUT_OF_RANGE;
+    }
+
+    if (static_cast<uint64_t>(offset) + length > data.size())
+    {
+        length = data.size() - offset;
+    }
+    auto chunk = data.subspan(offset, length);
+    response.insert(response.end(), chunk.begin(), chunk.end());
+    return PLDM_SUCCESS;
+}
+
+} // namespace responder
+} // namespace pldm
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "common/types.hpp"
+
+#include <sys/stat.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <utility>
+
+namespace pldm
+{
+namespace responder
+{
+
+/** @class LidMapCache
+ *
+ *  Process wide cache of the read-only mappings of the LID files the host
+ *  reads, so each chunk of a LID streamed with ReadFileByType is one copy
+ *  from the mapping instead of an open, a seek and a read of the file. A
+ *  mapping is checked against the inode, size and modification time of the
+ *  file on each lookup and mapped again once the file changed. The least
+ *  recently used mappings are dropped over maxEntries. The LIDs are written
+ *  in place only while they grow, and are replaced otherwise, so a mapping
+ *  never covers a truncated part of its file. Thread safe, the reads run on
+ *  the file I/O threads.
+ */
+class LidMapCache
+{
+  public:
+    /** @brief Mappings kept at most */
+    static constexpr size_t maxEntries = 8;
+
+    /** @class Mapping
+     *  @brief Read-only mapping of a LID file, unmapped with its last user
+     */
+    class Mapping
+    {
+      public:
+        Mapping(const Mapping&) = delete;
+        Mapping& operator=(const Mapping&) = delete;
+
+        /** @brief Map a file
+         *
+         *  @param[in] fd - file descriptor of the file
+         *  @param[in] st - status of the file
+         */
+        Mapping(int fd, const struct stat& st);
+        ~Mapping();
+
+        /** @brief Contents of the file, empty if it could not be mapped */
+        std::span<const uint8_t> data() const
+        {
+            return contents;
+        }
+
+        /** @brief Whether the mapping is of the file as it is now */
+        bool current(const struct stat& st) const;
+
+      private:
+        std::span<const uint8_t> contents;
+        dev_t dev;
+        ino_t ino;
+        off_t size;
+        struct timespec mtime;
+    };
+
+    /** @brief Get the cache of the process */
+    static LidMapCache& get();
+
+    /** @brief Get the mapping of a LID file, mapped now if needed
+     *
+     *  @param[in] path - path of the LID file
+     *
+     *  @return the mapping, nullptr if the file is empty or can't be mapped
+     */
+    std::shared_ptr<const Mapping> map(const std::filesystem::path& path);
+
+    /** @brief Drop the mapping of a LID file, e.g. once it is written */
+    void erase(const std::filesystem::path& path);
+
+    /** @brief Read part of a LID file into a response, the way
+     *         FileHandler::readFile does
+     *
+     *  @param[in] mapping - mapping of the LID file
+     *  @param[in] offset - offset in the file
+     *  @param[in,out] length - length to read, the length read on return
+     *  @param[in,out] response - the data is appended to it
+     *
+     *  @return PLDM_SUCCESS, or PLDM_DATA_OUT_OF_RANGE if the offset is past
+     *          the end of the file
+     */
+    static int read(const Mapping& mapping, uint32_t offset, uint32_t& length,
+                    Response& response);
+
+  private:
+    std::mutex lock;
+    /** @brief Mappings by path, the most recently used first */
+    std::list<std::pair<std::string, std::shared_ptr<const Mapping>>> entries;
+};
+
+} // namespace responder
+} // namespace pldm
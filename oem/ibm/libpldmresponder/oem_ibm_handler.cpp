@@ -575,24 +575,27 @@ void pldm::responder::oem_ibm_platform::Handler::disableWatchDogTimer()
 }
 int pldm::responder::oem_ibm_platform::Handler::checkBMCState()
 {
-    try
+    if (!bmcState)
     {
-        pldm::utils::PropertyValue propertyValue =
-            pldm::utils::DBusHandler().getDbusPropertyVariant(
-                "/xyz/openbmc_project/state/bmc0", "CurrentBMCState",
-                "xyz.openbmc_project.State.BMC");
-
-        if (std::get<std::string>(propertyValue) ==
-            "xyz.openbmc_project.State.BMC.BMCState.NotReady")
+        try
+        {
+            pldm::utils::PropertyValue propertyValue =
+                pldm::utils::DBusHandler().getDbusPropertyVariant(
+                    "/xyz/openbmc_project/state/bmc0", "CurrentBMCState",
+                    "xyz.openbmc_project.State.BMC");
+            bmcState = std::get<std::string>(propertyValue);
+        }
+        catch (const std::exception& e)
         {
-            error("GetPDR : PLDM stack is not ready for PDR exchange");
-            return PLDM_ERROR_NOT_READY;
+            error("Error getting the current BMC state");
+            return PLDM_ERROR;
         }
     }
-    catch (const std::exception& e)
+
+    if (*bmcState == "xyz.openbmc_project.State.BMC.BMCState.NotReady")
     {
-        error("Error getting the current BMC state");
-        return PLDM_ERROR;
+        error("GetPDR : PLDM stack is not ready for PDR exchange");
+        return PLDM_ERROR_NOT_READY;
     }
     return PLDM_SUCCESS;
 }
@@ -10,6 +10,9 @@
 #include <libpldm/platform.h>
 #include <libpldm/state_set_oem_ibm.h>
 
+#include <optional>
+#include <string>
+
 typedef ibm_oem_pldm_state_set_firmware_update_state_values CodeUpdateState;
 
 namespace pldm
@@ -74,6 +77,22 @@ class Handler : public oem_platform::Handler
                 }
             }
         });
+
+        // The state is read on the first GetPDR, the match keeps it current
+        bmcStateMatch = std::make_unique<sdbusplus::bus::match_t>(
+            pldm::utils::DBusHandler::getBus(),
+            propertiesChanged("/xyz/openbmc_project/state/bmc0",
+                              "xyz.openbmc_project.State.BMC"),
+            [this](sdbusplus::message_t& msg) {
+            pldm::utils::DbusChangedProps props{};
+            std::string intf;
+            msg.read(intf, props);
+            const auto itr = props.find("CurrentBMCState");
+            if (itr != props.end())
+            {
+                bmcState = std::get<std::string>(itr->second);
+            }
+        });
     }
 
     int getOemStateSensorReadingsHandler(
@@ -183,7 +202,7 @@ class Handler : public oem_platform::Handler
     /** @brief To disable to the watchdog timer on host poweron completion*/
     void disableWatchDogTimer();
 
-    /** @brief to check the BMC state*/
+    /** @brief to check the BMC state, from the cached CurrentBMCState */
     int checkBMCState();
 
     /** @brief Method to fetch the last BMC record from the PDR repo
@@ -241,6 +260,12 @@ class Handler : public oem_platform::Handler
     bool hostOff = true;
 
     int setEventReceiverCnt = 0;
+
+    /** @brief D-Bus property changed signal match for CurrentBMCState */
+    std::unique_ptr<sdbusplus::bus::match_t> bmcStateMatch;
+
+    /** @brief CurrentBMCState, until read std::nullopt */
+    std::optional<std::string> bmcState;
 };
 
 /** @brief Method to encode code update event msg
@@ -1,8 +1,13 @@
 #include "utils.hpp"
 
+#include <fcntl.h>
 #include <libpldm/base.h>
+#include <linux/sockios.h>
+#include <sys/ioctl.h>
+#include <sys/select.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <sys/un.h>
 #include <unistd.h>
 
@@ -139,6 +144,114 @@ int writeToUnixSocket(const int sock, const char* buf, const uint64_t blockSize)
     return 0;
 }
 
+int spliceToUnixSocket(const int sock, const char* buf,
+                       const uint64_t blockSize)
+{
+    /* Cleared on the first failure which shows the kernel or the memory
+     * doesn't support splicing, the writes are copied from then on */
+    static bool spliceSupported = true;
+    if (!spliceSupported || blockSize < spliceMinSize)
+    {
+        return writeToUnixSocket(sock, buf, blockSize);
+    }
+
+    int pipeFds[2];
+    if (pipe2(pipeFds, O_CLOEXEC | O_NONBLOCK) == -1)
+    {
+        return writeToUnixSocket(sock, buf, blockSize);
+    }
+    /* A larger pipe moves more pages per splice, the default is used if the
+     * size is above the limit */
+    fcntl(pipeFds[1], F_SETPIPE_SZ, spliceMinSize * 16);
+
+    uint64_t spliced = 0; // bytes moved into the pipe
+    uint64_t sent = 0;    // bytes moved from the pipe into the socket
+    bool fallback = false;
+    while (sent < blockSize)
+    {
+        if (spliced < blockSize)
+        {
+            struct iovec iov = {const_cast<char*>(buf) + spliced,
+                                blockSize - spliced};
+            auto n = vmsplice(pipeFds[1], &iov, 1, SPLICE_F_NONBLOCK);
+            if (n > 0)
+            {
+                spliced += n;
+            }
+            else if (n < 0 && errno != EAGAIN && errno != EINTR)
+            {
+                fallback = !sent;
+                error("spliceToUnixSocket: vmsplice failed {ERR}", "ERR",
+                      errno);
+                break;
+            }
+        }
+        if (spliced == sent)
+        {
+            continue;
+        }
+
+        fd_set wfd;
+        struct timeval tv;
+        tv.tv_sec = 1;
+        tv.tv_usec = 0;
+        FD_ZERO(&wfd);
+        FD_SET(sock, &wfd);
+        int retval = select(sock + 1, NULL, &wfd, NULL, &tv);
+        if (retval < 0)
+        {
+            error("spliceToUnixSocket: select call failed {ERR}", "ERR",
+                  errno);
+            break;
+        }
+        if (retval == 0 || !FD_ISSET(sock, &wfd))
+        {
+            continue;
+        }
+
+        unsigned int flags = SPLICE_F_MOVE | SPLICE_F_NONBLOCK;
+        if (spliced < blockSize)
+        {
+            flags |= SPLICE_F_MORE;
+        }
+        auto n = splice(pipeFds[0], nullptr, sock, nullptr, spliced - sent,
+                        flags);
+        if (n > 0)
+        {
+            sent += n;
+        }
+        else if (n < 0 && errno != EAGAIN && errno != EINTR)
+        {
+            fallback = !sent;
+            error("spliceToUnixSocket: splice failed {ERR}", "ERR", errno);
+            break;
+        }
+    }
+    close(pipeFds[0]);
+    close(pipeFds[1]);
+
+    if (fallback)
+    {
+        spliceSupported = false;
+        info("spliceToUnixSocket: Splicing unsupported, copying the data");
+        return writeToUnixSocket(sock, buf, blockSize);
+    }
+    if (sent < blockSize)
+    {
+        close(sock);
+        return -1;
+    }
+
+    /* The socket references the pages of the buffer until the peer reads
+     * them, the caller may overwrite the buffer once this returns */
+    int pending = 0;
+    while (ioctl(sock, SIOCOUTQ, &pending) == 0 && pending > 0)
+    {
+        usleep(1000);
+    }
+    return 0;
+}
+
 } // namespace utils
 } // namespace responder
 } // namespace pldm
@@ -36,6 +36,24 @@ int setupUnixSocket(const std::string& socketInterface);
 int writeToUnixSocket(const int sock, const char* buf,
                       const uint64_t blockSize);
 
+/** @brief Blocks smaller than this are copied, splicing them costs more */
+constexpr uint64_t spliceMinSize = 64 * 1024;
+
+/** @brief Write data on UNIX socket without copying it
+ *  This function moves the pages of the buffer into the socket through a
+ *  pipe with vmsplice() and splice(), and returns once the peer read them.
+ *  Small blocks, and all the blocks once splicing failed, are written with
+ *  writeToUnixSocket().
+ *
+ *  @param[in] sock - unix socket
+ *  @param[in] buf -  data buffer
+ *  @param[in] blockSize - size of data to write
+ *  @return   on success retruns  0
+ *            on failure returns -1
+ */
+int spliceToUnixSocket(const int sock, const char* buf,
+                       const uint64_t blockSize);
+
 } // namespace utils
 } // namespace responder
 } // namespace pldm
@@ -10,9 +10,11 @@
 
 #include <libpldm/base.h>
 #include <libpldm/file_io.h>
+#include <libpldm/utils.h>
 
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 
@@ -101,6 +103,13 @@ class MockDMA
   public:
     MOCK_METHOD5(transferDataHost, int(int fd, uint32_t offset, uint32_t length,
                                        uint64_t address, bool upstream));
+
+    void prefetch(int /*fd*/, uint32_t /*offset*/, uint32_t /*length*/) {}
+
+    int flush()
+    {
+        return 0;
+    }
 };
 
 } // namespace dma
@@ -203,6 +212,74 @@ TEST(TransferDataHost, BadPath)
     ASSERT_EQ(responsePtr->payload[0], PLDM_ERROR);
 }
 
+TEST(FilePipeline, WriteAndPrefetch)
+{
+    using namespace pldm::responder::dma;
+
+    char tmpfile[] = "/tmp/pldm_fileio_pipeline.XXXXXX";
+    int fd = mkstemp(tmpfile);
+    ASSERT_GE(fd, 0);
+
+    auto& pipeline = FilePipeline::get();
+    std::vector<char> chunk(4096);
+    for (size_t i = 0; i < 4; i++)
+    {
+        std::fill(chunk.begin(), chunk.end(), static_cast<char>('a' + i));
+        EXPECT_EQ(pipeline.write(fd, i * chunk.size(), chunk.data(),
+                                 chunk.size()),
+                  0);
+    }
+    EXPECT_EQ(pipeline.flush(), 0);
+
+    // A chunk which was not read ahead is not taken
+    std::vector<char> data;
+    EXPECT_FALSE(pipeline.take(fd, 0, 4096, data));
+
+    pipeline.prefetch(fd, 8192, 4096);
+    auto rc = pipeline.take(fd, 8192, 4096, data);
+    if (stagingBuffers)
+    {
+        ASSERT_TRUE(rc);
+        EXPECT_EQ(*rc, 4096);
+        ASSERT_EQ(data.size(), 4096u);
+        EXPECT_EQ(data.front(), 'c');
+        EXPECT_EQ(data.back(), 'c');
+    }
+    else
+    {
+        EXPECT_FALSE(rc);
+    }
+    EXPECT_EQ(pipeline.flush(), 0);
+
+    close(fd);
+    remove(tmpfile);
+}
+
+TEST(FileIOWorker, RespondFromEventLoop)
+{
+    auto event = sdeventplus::Event::get_default();
+    FileIOWorker worker(event, 2, 2);
+
+    std::vector<Response> responses;
+    auto respond = [&responses](Response&& response) {
+        responses.emplace_back(std::move(response));
+    };
+    EXPECT_TRUE(worker.submit([] { return Response{1}; }, respond));
+    EXPECT_TRUE(worker.submit([] { return Response{2}; }, respond));
+    // The operations in flight are bounded
+    EXPECT_FALSE(worker.submit([] { return Response{3}; }, respond));
+    EXPECT_TRUE(responses.empty());
+
+    while (responses.size() < 2)
+    {
+        sd_event_run(event.get(), 100000);
+    }
+    std::sort(responses.begin(), responses.end());
+    EXPECT_EQ(responses[0], Response{1});
+    EXPECT_EQ(responses[1], Response{2});
+    EXPECT_TRUE(worker.submit([] { return Response{3}; }, respond));
+}
+
 TEST(ReadFileIntoMemory, BadPath)
 {
     uint32_t fileHandle = 0;
@@ -564,6 +641,38 @@ TEST_F(TestFileTable, GetFileTableCommand)
     table.clear();
 }
 
+TEST_F(TestFileTable, UpdateFileSize)
+{
+    FileTable tableObj(fileTableConfig.c_str());
+    auto before = tableObj();
+    EXPECT_FALSE(tableObj.updateFileSize(1));
+    EXPECT_FALSE(tableObj.updateFileSize(2));
+
+    // Grow the file of handle 1 from 16 to 20 bytes
+    {
+        std::ofstream stream(cksumFile, std::ios::app | std::ios::binary);
+        stream.write("ABCD", 4);
+    }
+    EXPECT_TRUE(tableObj.updateFileSize(1));
+    auto after = tableObj();
+    ASSERT_EQ(before.size(), after.size());
+
+    // Only the file size of handle 1 and the checksum changed
+    constexpr size_t sizeOffset = 48;
+    EXPECT_TRUE(std::equal(before.begin(), before.begin() + sizeOffset,
+                           after.begin()));
+    uint32_t fileSize = 0;
+    memcpy(&fileSize, after.data() + sizeOffset, sizeof(fileSize));
+    EXPECT_EQ(fileSize, 20u);
+    EXPECT_TRUE(std::equal(before.begin() + sizeOffset + sizeof(fileSize),
+                           before.end() - sizeof(uint32_t),
+                           after.begin() + sizeOffset + sizeof(fileSize)));
+    uint32_t checksum = 0;
+    memcpy(&checksum, after.data() + after.size() - sizeof(checksum),
+           sizeof(checksum));
+    EXPECT_EQ(checksum, crc32(after.data(), after.size() - sizeof(checksum)));
+}
+
 TEST_F(TestFileTable, GetFileTableCommandReqLengthMismatch)
 {
     uint8_t host_eid = 0;
@@ -988,3 +1097,38 @@ TEST(readFileByType, testReadFile)
     ASSERT_EQ(response.size(), in.size());
     ASSERT_EQ(std::equal(in.begin(), in.end(), response.begin()), true);
 }
+
+TEST(LidMapCache, ServesTheCurrentFile)
+{
+    char tmplt[] = "/tmp/lid.XXXXXX";
+    auto fd = mkstemp(tmplt);
+    std::vector<uint8_t> in = {100, 10, 56, 78, 34, 56, 79, 235, 111};
+    ASSERT_EQ(write(fd, in.data(), in.size()), static_cast<ssize_t>(in.size()));
+    close(fd);
+
+    auto& cache = LidMapCache::get();
+    auto mapping = cache.map(tmplt);
+    ASSERT_NE(mapping, nullptr);
+    EXPECT_EQ(cache.map(tmplt), mapping);
+
+    Response response;
+    uint32_t length = 4;
+    EXPECT_EQ(LidMapCache::read(*mapping, 6, length, response), PLDM_SUCCESS);
+    EXPECT_EQ(length, 3);
+    EXPECT_EQ(response, std::vector<uint8_t>(in.begin() + 6, in.end()));
+    EXPECT_EQ(LidMapCache::read(*mapping, in.size(), length, response),
+              PLDM_DATA_OUT_OF_RANGE);
+
+    /* A replaced file is mapped again, the old mapping stays readable */
+    std::string replacement = std::string(tmplt) + ".new";
+    std::ofstream(replacement, std::ios::binary) << "replaced";
+    fs::rename(replacement, tmplt);
+    auto remapped = cache.map(tmplt);
+    ASSERT_NE(remapped, nullptr);
+    EXPECT_NE(remapped, mapping);
+    EXPECT_EQ(remapped->data().size(), 8);
+    EXPECT_EQ(mapping->data().size(), in.size());
+
+    fs::remove(tmplt);
+    EXPECT_EQ(cache.map(tmplt), nullptr);
+}
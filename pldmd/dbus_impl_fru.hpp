@@ -35,9 +35,12 @@ class FruReq : public FruIntf
     /** @brief Constructor to put object onto bus at a dbus path.
      *  @param[in] bus - Bus to attach to.
      *  @param[in] path - Path to attach at.
+     *  @param[in] act - whether the object is announced now or later with
+     *                   emit_object_added()
      */
-    FruReq(sdbusplus::bus::bus& bus, const std::string& path) :
-        FruIntf(bus, path.c_str()){};
+    FruReq(sdbusplus::bus::bus& bus, const std::string& path,
+           FruIntf::action act = FruIntf::action::emit_object_added) :
+        FruIntf(bus, path.c_str(), act){};
 
     /** @brief Set value of chassisType */
     std::string chassisType(std::string value);
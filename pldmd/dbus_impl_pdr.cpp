@@ -3,11 +3,19 @@
 #include "common/utils.hpp"
 #include "xyz/openbmc_project/Common/error.hpp"
 
+#include <fcntl.h>
 #include <libpldm/pdr.h>
 #include <libpldm/pldm_types.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
+#include <phosphor-logging/lg2.hpp>
+
+#include <cerrno>
 #include <iostream>
 
+PHOSPHOR_LOG2_USING;
+
 using namespace sdbusplus::xyz::openbmc_project::Common::Error;
 
 namespace pldm
@@ -15,12 +23,109 @@ namespace pldm
 namespace dbus_api
 {
 
-std::vector<std::vector<uint8_t>> Pdr::findStateEffecterPDR(uint8_t tid,
-                                                            uint16_t entityID,
-                                                            uint16_t stateSetId)
+namespace
+{
+constexpr auto pdrExportIntf = "com.ampere.PLDM.PDRExport";
+} // namespace
+
+Pdr::Pdr(sdbusplus::bus_t& bus, const std::string& path,
+         const pldm_pdr* repo) :
+    PdrIntf(bus, path.c_str()),
+    pdrRepo(repo), pdrIndex(repo)
+{
+    exportVtable.emplace_back(sdbusplus::vtable::start());
+    exportVtable.emplace_back(
+        sdbusplus::vtable::method("Export", "", "h", &Pdr::exportPDRs));
+    exportVtable.emplace_back(sdbusplus::vtable::end());
+    exportIntf = std::make_unique<sdbusplus::server::interface::interface>(
+        bus, path.c_str(), pdrExportIntf, exportVtable.data(), this);
+}
+
+Pdr::~Pdr()
+{
+    exportIntf.reset();
+    if (exportFd >= 0)
+    {
+        close(exportFd);
+    }
+}
+
+int Pdr::exportPDRs(sd_bus_message* msg, void* context,
+                    sd_bus_error* /*error*/)
+{
+    auto pdr = static_cast<Pdr*>(context);
+    auto fd = pdr->getExportFd();
+    if (fd < 0)
+    {
+        return fd;
+    }
+    /* sd-bus sends a duplicate, the memfd is kept for the next callers */
+    return sd_bus_reply_method_return(msg, "h", fd);
+}
+
+int Pdr::getExportFd()
+{
+    auto generation = pldm::utils::getPdrRepoGeneration();
+    if (exportFd >= 0 && exportGeneration == generation)
+    {
+        return exportFd;
+    }
+
+    auto data = pdrIndex.exportRecords();
+    int fd = memfd_create("pldm-pdrs", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd < 0)
+    {
+        auto err = errno;
+        error("Failed to create the PDR export memfd, ERRNO={ERRNO}", "ERRNO",
+              err);
+        return -err;
+    }
+
+    size_t written = 0;
+    while (written < data.size())
+    {
+        auto rc = write(fd, data.data() + written, data.size() - written);
+        if (rc < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (rc < 0)
+        {
+            auto err = errno;
+            error("Failed to write the PDR export memfd, ERRNO={ERRNO}",
+                  "ERRNO", err);
+            close(fd);
+            return -err;
+        }
+        written += rc;
+    }
+
+    /* The readers share the memfd, it can never change under them */
+    if (fcntl(fd, F_ADD_SEALS,
+              F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) < 0)
+    {
+        auto err = errno;
+        error("Failed to seal the PDR export memfd, ERRNO={ERRNO}", "ERRNO",
+              err);
+        close(fd);
+        return -err;
+    }
+
+    if (exportFd >= 0)
+    {
+        close(exportFd);
+    }
+    exportFd = fd;
+    exportGeneration = generation;
+    info("Exported the PDR repository, SIZE={SIZE}", "SIZE", data.size());
+    return exportFd;
+}
+
+std::vector<std::vector<uint8_t>>
+    Pdr::findStateEffecterPDR(uint8_t /*tid*/, uint16_t entityID,
+                              uint16_t stateSetId)
 {
-    auto pdrs = pldm::utils::findStateEffecterPDR(tid, entityID, stateSetId,
-                                                  pdrRepo);
+    auto pdrs = pdrIndex.findStateEffecterPDR(entityID, stateSetId);
 
     if (pdrs.empty())
     {
@@ -31,10 +136,10 @@ std::vector<std::vector<uint8_t>> Pdr::findStateEffecterPDR(uint8_t tid,
 }
 
 std::vector<std::vector<uint8_t>>
-    Pdr::findStateSensorPDR(uint8_t tid, uint16_t entityID, uint16_t stateSetId)
+    Pdr::findStateSensorPDR(uint8_t /*tid*/, uint16_t entityID,
+                            uint16_t stateSetId)
 {
-    auto pdrs = pldm::utils::findStateSensorPDR(tid, entityID, stateSetId,
-                                                pdrRepo);
+    auto pdrs = pdrIndex.findStateSensorPDR(entityID, stateSetId);
     if (pdrs.empty())
     {
         throw ResourceNotFound();
@@ -1,13 +1,19 @@
 #pragma once
 
+#include "common/pdr_index.hpp"
 #include "xyz/openbmc_project/PLDM/PDR/server.hpp"
 
 #include <libpldm/pdr.h>
 #include <libpldm/platform.h>
 
+#include <systemd/sd-bus.h>
+
 #include <sdbusplus/bus.hpp>
+#include <sdbusplus/server/interface.hpp>
 #include <sdbusplus/server/object.hpp>
+#include <sdbusplus/vtable.hpp>
 
+#include <memory>
 #include <vector>
 
 namespace pldm
@@ -21,7 +27,10 @@ using PdrIntf = sdbusplus::server::object_t<
 /** @class Pdr
  *  @brief OpenBMC PLDM.PDR Implementation
  *  @details A concrete implementation for the
- *  xyz.openbmc_project.PLDM.PDR DBus APIs.
+ *  xyz.openbmc_project.PLDM.PDR DBus APIs. The object also implements
+ *  com.ampere.PLDM.PDRExport, its Export method returns a sealed memfd with
+ *  the whole repository as laid out by PdrIndex::exportRecords, so a tool
+ *  reads all the PDRs with one call and one mmap.
  */
 class Pdr : public PdrIntf
 {
@@ -31,15 +40,14 @@ class Pdr : public PdrIntf
     Pdr& operator=(const Pdr&) = delete;
     Pdr(Pdr&&) = delete;
     Pdr& operator=(Pdr&&) = delete;
-    virtual ~Pdr() = default;
+    virtual ~Pdr();
 
     /** @brief Constructor to put object onto bus at a dbus path.
      *  @param[in] bus - Bus to attach to.
      *  @param[in] path - Path to attach at.
      *  @param[in] repo - pointer to BMC's primary PDR repo
      */
-    Pdr(sdbusplus::bus_t& bus, const std::string& path, const pldm_pdr* repo) :
-        PdrIntf(bus, path.c_str()), pdrRepo(repo){};
+    Pdr(sdbusplus::bus_t& bus, const std::string& path, const pldm_pdr* repo);
 
     /** @brief Implementation for PdrIntf.FindStateEffecterPDR
      *  @param[in] tid - PLDM terminus ID.
@@ -60,8 +68,27 @@ class Pdr : public PdrIntf
                            uint16_t stateSetId) override;
 
   private:
+    /** @brief sd-bus handler of PDRExport.Export */
+    static int exportPDRs(sd_bus_message* msg, void* context,
+                          sd_bus_error* error);
+
+    /** @brief Get the memfd of the current repository, it is rebuilt only
+     *         after the repository changed
+     *
+     *  @return - the sealed memfd, -errno on failure
+     */
+    int getExportFd();
+
     /** @brief pointer to BMC's primary PDR repo */
     const pldm_pdr* pdrRepo;
+    /** @brief lookup index of BMC's primary PDR repo */
+    pldm::utils::PdrIndex pdrIndex;
+    /** @brief Sealed memfd of the last export, -1 before the first */
+    int exportFd = -1;
+    /** @brief PDR repository generation of exportFd */
+    uint64_t exportGeneration = 0;
+    std::vector<sdbusplus::vtable::vtable_t> exportVtable;
+    std::unique_ptr<sdbusplus::server::interface::interface> exportIntf;
 };
 
 } // namespace dbus_api
@@ -0,0 +1,249 @@
+#include "dbus_impl_send_recv.hpp"
+
+#include <fcntl.h>
+#include <libpldm/base.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <cerrno>
+#include <string>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace dbus_api
+{
+
+namespace
+{
+constexpr auto sendRecvIntf = "com.ampere.PLDM.SendRecv";
+/** @brief Largest request read from the file of SendRecvFd */
+constexpr off_t maxFdRequestSize = 64 * 1024;
+
+/** @brief Unique name of the caller, for the logs */
+std::string senderOf(sd_bus_message* msg)
+{
+    auto sender = sd_bus_message_get_sender(msg);
+    return sender ? sender : "";
+}
+
+/** @brief Write a response to a sealed memfd
+ *
+ *  @return - the memfd, -errno on failure
+ */
+int responseMemfd(const Response& response)
+{
+    int fd = memfd_create("pldm-response", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd < 0)
+    {
+        return -errno;
+    }
+
+    size_t written = 0;
+    while (written < response.size())
+    {
+        auto rc = write(fd, response.data() + written,
+                        response.size() - written);
+        if (rc < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (rc < 0)
+        {
+            auto err = errno;
+            close(fd);
+            return -err;
+        }
+        written += rc;
+    }
+
+    if (fcntl(fd, F_ADD_SEALS,
+              F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) < 0)
+    {
+        auto err = errno;
+        close(fd);
+        return -err;
+    }
+    return fd;
+}
+} // namespace
+
+SendRecv::SendRecv(sdbusplus::bus_t& bus, const std::string& path,
+                   InstanceIdDb& instanceIdDb,
+                   requester::Handler<requester::Request>* handler) :
+    instanceIdDb(instanceIdDb),
+    handler(handler)
+{
+    vtable.emplace_back(sdbusplus::vtable::start());
+    vtable.emplace_back(sdbusplus::vtable::method(
+        "SendRecv", "yay", "ay", &SendRecv::sendRecvArray,
+        SD_BUS_VTABLE_UNPRIVILEGED));
+    vtable.emplace_back(sdbusplus::vtable::method(
+        "SendRecvFd", "yh", "h", &SendRecv::sendRecvFd,
+        SD_BUS_VTABLE_UNPRIVILEGED));
+    vtable.emplace_back(sdbusplus::vtable::end());
+    object = std::make_unique<sdbusplus::server::interface::interface>(
+        bus, path.c_str(), sendRecvIntf, vtable.data(), this);
+}
+
+int SendRecv::sendRecvArray(sd_bus_message* msg, void* context,
+                            sd_bus_error* /*error*/)
+{
+    uint8_t eid = 0;
+    auto rc = sd_bus_message_read(msg, "y", &eid);
+    if (rc < 0)
+    {
+        return rc;
+    }
+    const void* data = nullptr;
+    size_t size = 0;
+    rc = sd_bus_message_read_array(msg, 'y', &data, &size);
+    if (rc < 0)
+    {
+        return rc;
+    }
+
+    auto bytes = static_cast<const uint8_t*>(data);
+    return static_cast<SendRecv*>(context)->submit(
+        msg, eid, Request(bytes, bytes + size), false);
+}
+
+int SendRecv::sendRecvFd(sd_bus_message* msg, void* context,
+                         sd_bus_error* /*error*/)
+{
+    uint8_t eid = 0;
+    int fd = -1;
+    auto rc = sd_bus_message_read(msg, "yh", &eid, &fd);
+    if (rc < 0)
+    {
+        return rc;
+    }
+
+    /* The descriptor belongs to the message, it is only read */
+    struct stat st{};
+    if (fstat(fd, &st) < 0)
+    {
+        return -errno;
+    }
+    if (st.st_size <= 0 || st.st_size > maxFdRequestSize)
+    {
+        return -EMSGSIZE;
+    }
+    Request requestMsg(st.st_size);
+    size_t received = 0;
+    while (received < requestMsg.size())
+    {
+        auto n = pread(fd, requestMsg.data() + received,
+                       requestMsg.size() - received, received);
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n < 0)
+        {
+            return -errno;
+        }
+        if (n == 0)
+        {
+            return -EIO;
+        }
+        received += n;
+    }
+
+    return static_cast<SendRecv*>(context)->submit(msg, eid,
+                                                   std::move(requestMsg), true);
+}
+
+int SendRecv::submit(sd_bus_message* msg, uint8_t eid, Request&& requestMsg,
+                     bool replyFd)
+{
+    if (requestMsg.size() < sizeof(pldm_msg_hdr))
+    {
+        return -EINVAL;
+    }
+    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+    if (request->hdr.request != PLDM_REQUEST)
+    {
+        return -EINVAL;
+    }
+
+    uint8_t instanceId = 0;
+    try
+    {
+        instanceId = instanceIdDb.next(eid);
+    }
+    catch (const std::runtime_error& e)
+    {
+        error("No instance ID for the request of {SENDER} to EID {EID}",
+              "SENDER", senderOf(msg), "EID", unsigned(eid));
+        return -EBUSY;
+    }
+    request->hdr.instance_id = instanceId;
+
+    /* The call is kept until the exchange replies to it */
+    [[maybe_unused]] auto co = exchange(handler, sd_bus_message_ref(msg), eid,
+                                        std::move(requestMsg), replyFd);
+    return 1;
+}
+
+requester::Coroutine
+    SendRecv::exchange(requester::Handler<requester::Request>* handler,
+                       sd_bus_message* msg, uint8_t eid, Request requestMsg,
+                       bool replyFd)
+{
+    Response responseMsg{};
+    auto rc = co_await requester::sendRecvPldmMsg(
+        *handler, eid, requestMsg, responseMsg,
+        requester::RequestPriority::Control);
+
+    int replyRc = 0;
+    if (rc || responseMsg.empty())
+    {
+        replyRc = sd_bus_reply_method_errno(msg, ETIMEDOUT, nullptr);
+    }
+    else if (replyFd)
+    {
+        auto fd = responseMemfd(responseMsg);
+        if (fd < 0)
+        {
+            replyRc = sd_bus_reply_method_errno(msg, -fd, nullptr);
+        }
+        else
+        {
+            /* sd-bus sends a duplicate */
+            replyRc = sd_bus_reply_method_return(msg, "h", fd);
+            close(fd);
+        }
+    }
+    else
+    {
+        sd_bus_message* reply = nullptr;
+        replyRc = sd_bus_message_new_method_return(msg, &reply);
+        if (replyRc >= 0)
+        {
+            replyRc = sd_bus_message_append_array(
+                reply, 'y', responseMsg.data(), responseMsg.size());
+        }
+        if (replyRc >= 0)
+        {
+            replyRc = sd_bus_send(nullptr, reply, nullptr);
+        }
+        sd_bus_message_unref(reply);
+    }
+    if (replyRc < 0)
+    {
+        error("Failed to reply to {SENDER} for EID {EID}, ERRNO={ERRNO}",
+              "SENDER", senderOf(msg), "EID", unsigned(eid),
+              "ERRNO", -replyRc);
+    }
+
+    sd_bus_message_unref(msg);
+    co_return rc;
+}
+
+} // namespace dbus_api
+} // namespace pldm
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "common/instance_id.hpp"
+#include "requester/handler.hpp"
+
+#include <systemd/sd-bus.h>
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/server/interface.hpp>
+#include <sdbusplus/vtable.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace pldm
+{
+namespace dbus_api
+{
+
+/** @class SendRecv
+ *
+ *  Implements com.ampere.PLDM.SendRecv, which lets the other BMC daemons
+ *  send their PLDM requests through pldmd instead of opening their own MCTP
+ *  sockets. SendRecv(y eid, ay request) -> ay response takes a whole request
+ *  message, SendRecvFd(y eid, h request) -> h response takes it in a file,
+ *  e.g. a memfd, and returns the response in a sealed memfd for the large
+ *  payloads. pldmd allocates the instance ID, overwriting the one of the
+ *  request header, and queues the request on the requester handler in the
+ *  Control class, so the link has one owner which paces and retries all the
+ *  requests. The methods reply asynchronously once the response arrived or
+ *  the request expired.
+ */
+class SendRecv
+{
+  public:
+    SendRecv() = delete;
+    SendRecv(const SendRecv&) = delete;
+    SendRecv& operator=(const SendRecv&) = delete;
+
+    /** @brief Constructor to put the interface onto bus at a dbus path.
+     *
+     *  @param[in] bus - Bus to attach to
+     *  @param[in] path - Path to attach at
+     *  @param[in] instanceIdDb - instance ID database
+     *  @param[in] handler - PLDM request handler
+     */
+    SendRecv(sdbusplus::bus_t& bus, const std::string& path,
+             InstanceIdDb& instanceIdDb,
+             requester::Handler<requester::Request>* handler);
+
+  private:
+    /** @brief sd-bus handler of SendRecv.SendRecv */
+    static int sendRecvArray(sd_bus_message* msg, void* context,
+                             sd_bus_error* error);
+
+    /** @brief sd-bus handler of SendRecv.SendRecvFd */
+    static int sendRecvFd(sd_bus_message* msg, void* context,
+                          sd_bus_error* error);
+
+    /** @brief Stamp the request with a new instance ID and send it, the
+     *         method call is replied once the exchange ended
+     *
+     *  @param[in] msg - method call
+     *  @param[in] eid - MCTP endpoint ID of the responder
+     *  @param[in] requestMsg - PLDM request message
+     *  @param[in] replyFd - reply with a memfd instead of a byte array
+     *
+     *  @return - 1 if the call is replied later, else -errno
+     */
+    int submit(sd_bus_message* msg, uint8_t eid, Request&& requestMsg,
+               bool replyFd);
+
+    /** @brief Wait for the response of a request and reply to the call,
+     *         static since it can outlive the server
+     */
+    static requester::Coroutine
+        exchange(requester::Handler<requester::Request>* handler,
+                 sd_bus_message* msg, uint8_t eid, Request requestMsg,
+                 bool replyFd);
+
+    InstanceIdDb& instanceIdDb;
+    requester::Handler<requester::Request>* handler;
+    std::vector<sdbusplus::vtable::vtable_t> vtable;
+    std::unique_ptr<sdbusplus::server::interface::interface> object;
+};
+
+} // namespace dbus_api
+} // namespace pldm
@@ -1,10 +1,20 @@
 #pragma once
 
+#include "common/message_arena.hpp"
+#include "common/utils.hpp"
+
 #include <libpldm/base.h>
 
+#include <algorithm>
+#include <array>
+#include <bitset>
 #include <cassert>
+#include <cstdint>
 #include <functional>
+#include <limits>
 #include <map>
+#include <optional>
+#include <utility>
 #include <vector>
 
 namespace pldm
@@ -19,6 +29,113 @@ using Response = std::vector<uint8_t>;
 class CmdHandler;
 using HandlerFunc =
     std::function<Response(const pldm_msg* request, size_t reqMsgLen)>;
+/** @brief Sends the response of a deferred command */
+using ResponseSender = std::function<void(Response&& response)>;
+/** @brief Handler which sends its response later, through the sender, the
+ *         request is only valid until the handler returns
+ */
+using AsyncHandlerFunc =
+    std::function<void(const pldm_msg* request, size_t reqMsgLen,
+                       ResponseSender&& respond)>;
+
+/** @brief Buffer of a response message, zeroed
+ *
+ *  @details The buffer comes from the free lists of the request pool, the
+ *  sender of pldmd gives it back once the response is sent, so the
+ *  responses up to the largest size class are not allocated in steady
+ *  state.
+ *
+ *  @param[in] payloadLength - length of the response payload
+ *  @return the response buffer
+ */
+inline Response responseBuffer(size_t payloadLength)
+{
+    return pldm::utils::RequestPool::acquire(sizeof(pldm_msg_hdr) +
+                                             payloadLength);
+}
+
+/** @brief Buffer of the response of a fixed size command, the size is
+ *         checked against the pooled size classes at compile time
+ *
+ *  @tparam payloadLength - length of the response payload
+ *  @return the response buffer
+ */
+template <size_t payloadLength>
+Response responseBuffer()
+{
+    static_assert(sizeof(pldm_msg_hdr) + payloadLength <=
+                      pldm::utils::RequestPool::maxPooledSize,
+                  "fixed size responses must fit a pooled buffer");
+    return responseBuffer(payloadLength);
+}
+
+/** @brief Pooled copy of a cached response message
+ *
+ *  @param[in] cached - response message
+ *  @return the copy
+ */
+inline Response responseCopy(const Response& cached)
+{
+    auto response = pldm::utils::RequestPool::acquire(cached.size());
+    std::copy(cached.begin(), cached.end(), response.begin());
+    return response;
+}
+
+/** @class CommandTable
+ *
+ *  Handlers of the commands of a PLDM type, looked up in constant time by
+ *  the command code. The slots of the 256 command codes hold the index of
+ *  the handler, the handlers themselves are stored once.
+ */
+template <typename Func>
+class CommandTable
+{
+  public:
+    /** @brief Register the handler of a command, an existing handler is kept
+     *
+     *  @param[in] command - PLDM command code
+     *  @param[in] func - handler of the command
+     *  @param[in] precomputed - the response only depends on the request
+     *                           payload and the handler has no side effect,
+     *                           it is encoded once and then served from a
+     *                           cache
+     *  @return true if the handler is registered
+     */
+    bool emplace(Command command, Func func, bool precomputed = false)
+    {
+        if (slots[command])
+        {
+            return false;
+        }
+        funcs.emplace_back(std::move(func));
+        slots[command] = funcs.size();
+        precomputedCmds[command] = precomputed;
+        return true;
+    }
+
+    /** @brief Whether the response of a command is served from a cache */
+    bool isPrecomputed(Command command) const
+    {
+        return precomputedCmds[command];
+    }
+
+    /** @brief Handler of a command
+     *
+     *  @param[in] command - PLDM command code
+     *  @return the handler, nullptr if the command has none
+     */
+    const Func* find(Command command) const
+    {
+        auto slot = slots[command];
+        return slot ? &funcs[slot - 1] : nullptr;
+    }
+
+  private:
+    /** @brief Index + 1 of the handler of each command, 0 for none */
+    std::array<uint16_t, std::numeric_limits<Command>::max() + 1> slots{};
+    std::vector<Func> funcs;
+    std::bitset<std::numeric_limits<Command>::max() + 1> precomputedCmds;
+};
 
 class CmdHandler
 {
@@ -30,12 +147,45 @@ class CmdHandler
      *  @param[in] pldmCommand - PLDM command code
      *  @param[in] request - PLDM request message
      *  @param[in] reqMsgLen - PLDM request message size
-     *  @return PLDM response message
+     *  @return PLDM response message, std::nullopt if the command is not
+     *          supported
      */
-    Response handle(Command pldmCommand, const pldm_msg* request,
-                    size_t reqMsgLen)
+    std::optional<Response> handle(Command pldmCommand,
+                                   const pldm_msg* request, size_t reqMsgLen)
     {
-        return handlers.at(pldmCommand)(request, reqMsgLen);
+        auto handler = handlers.find(pldmCommand);
+        if (!handler)
+        {
+            return std::nullopt;
+        }
+        if (handlers.isPrecomputed(pldmCommand))
+        {
+            return precomputedResponse(pldmCommand, *handler, request,
+                                       reqMsgLen);
+        }
+        return (*handler)(request, reqMsgLen);
+    }
+
+    /** @brief Invoke a PLDM command handler which responds later, the
+     *         other messages are handled in the meantime
+     *
+     *  @param[in] pldmCommand - PLDM command code
+     *  @param[in] request - PLDM request message
+     *  @param[in] reqMsgLen - PLDM request message size
+     *  @param[in] respond - called once with the PLDM response message
+     *  @return true if the command has a deferred handler, false if it is
+     *          to be handled by handle()
+     */
+    bool handleAsync(Command pldmCommand, const pldm_msg* request,
+                     size_t reqMsgLen, ResponseSender&& respond)
+    {
+        auto handler = asyncHandlers.find(pldmCommand);
+        if (!handler)
+        {
+            return false;
+        }
+        (*handler)(request, reqMsgLen, std::move(respond));
+        return true;
     }
 
     /** @brief Create a response message containing only cc
@@ -46,7 +196,7 @@ class CmdHandler
      */
     static Response ccOnlyResponse(const pldm_msg* request, uint8_t cc)
     {
-        Response response(sizeof(pldm_msg), 0);
+        auto response = responseBuffer<1>();
         auto ptr = reinterpret_cast<pldm_msg*>(response.data());
         auto rc = encode_cc_only_resp(request->hdr.instance_id,
                                       request->hdr.type, request->hdr.command,
@@ -55,11 +205,77 @@ class CmdHandler
         return response;
     }
 
+    /** @brief Memory resource of the temporaries of a handler, reset once
+     *         the response of the message is sent
+     */
+    static std::pmr::memory_resource* arena()
+    {
+        return pldm::utils::MessageArena::resource();
+    }
+
+    /** @brief Max number of distinct request payloads cached per command */
+    static constexpr size_t maxPrecomputedPayloads = 8;
+
   protected:
-    /** @brief map of PLDM command code to handler - to be populated by derived
-     *         classes.
+    /** @brief table of PLDM command code to handler - to be populated by
+     *         derived classes.
+     */
+    CommandTable<HandlerFunc> handlers;
+
+    /** @brief table of PLDM command code to deferred handler, preferred over
+     *         the handler of the command when the caller can send the
+     *         response later
+     */
+    CommandTable<AsyncHandlerFunc> asyncHandlers;
+
+  private:
+    /** @brief Serve the response of a precomputed command, the handler only
+     *         runs for a request payload not seen before. The cached copy
+     *         gets the instance ID of the request.
+     *
+     *  @param[in] pldmCommand - PLDM command code
+     *  @param[in] handler - handler of the command
+     *  @param[in] request - PLDM request message
+     *  @param[in] reqMsgLen - PLDM request message size
+     *  @return PLDM response message
+     */
+    Response precomputedResponse(Command pldmCommand,
+                                 const HandlerFunc& handler,
+                                 const pldm_msg* request, size_t reqMsgLen)
+    {
+        auto& cached = precomputed[pldmCommand];
+        auto payload = reinterpret_cast<const uint8_t*>(request->payload);
+        auto entry = std::find_if(
+            cached.begin(), cached.end(), [&](const auto& entry) {
+            return std::equal(entry.first.begin(), entry.first.end(), payload,
+                              payload + reqMsgLen);
+        });
+        if (entry != cached.end())
+        {
+            auto response = responseCopy(entry->second);
+            reinterpret_cast<pldm_msg*>(response.data())->hdr.instance_id =
+                request->hdr.instance_id;
+            return response;
+        }
+
+        auto response = handler(request, reqMsgLen);
+        /* Requests flooding distinct payloads are still answered, they are
+         * just not kept */
+        if (cached.size() < maxPrecomputedPayloads &&
+            response.size() >= sizeof(pldm_msg_hdr))
+        {
+            cached.emplace_back(
+                std::vector<uint8_t>(payload, payload + reqMsgLen), response);
+        }
+        return response;
+    }
+
+    /** @brief Encoded responses of the precomputed commands, by request
+     *         payload
      */
-    std::map<Command, HandlerFunc> handlers;
+    std::map<Command,
+             std::vector<std::pair<std::vector<uint8_t>, Response>>>
+        precomputed;
 };
 
 } // namespace responder
@@ -4,8 +4,11 @@
 
 #include <libpldm/base.h>
 
-#include <map>
+#include <array>
+#include <bitset>
+#include <limits>
 #include <memory>
+#include <optional>
 
 namespace pldm
 {
@@ -25,7 +28,34 @@ class Invoker
      */
     void registerHandler(Type pldmType, std::unique_ptr<CmdHandler> handler)
     {
-        handlers.emplace(pldmType, std::move(handler));
+        if (!handlers[pldmType])
+        {
+            handlers[pldmType] = std::move(handler);
+        }
+        notReady.reset(pldmType);
+    }
+
+    /** @brief Set whether the handler of a PLDM type is still being
+     *         constructed, its requests are answered with
+     *         PLDM_ERROR_NOT_READY meanwhile. Registering the handler of
+     *         the type makes it ready.
+     *
+     *  @param[in] pldmType - PLDM type code
+     *  @param[in] ready - false while the handler is being constructed
+     */
+    void setReady(Type pldmType, bool ready)
+    {
+        notReady.set(pldmType, !ready);
+    }
+
+    /** @brief Whether the requests of a PLDM type can be handled yet
+     *
+     *  @param[in] pldmType - PLDM type code
+     *  @return false while the handler of the type is being constructed
+     */
+    bool isReady(Type pldmType) const
+    {
+        return !notReady.test(pldmType);
     }
 
     /** @brief Invoke a PLDM command handler
@@ -34,16 +64,55 @@ class Invoker
      *  @param[in] pldmCommand - PLDM command code
      *  @param[in] request - PLDM request message
      *  @param[in] reqMsgLen - PLDM request message size
-     *  @return PLDM response message
+     *  @return PLDM response message, std::nullopt if the type or the
+     *          command is not supported
      */
-    Response handle(Type pldmType, Command pldmCommand, const pldm_msg* request,
-                    size_t reqMsgLen)
+    std::optional<Response> handle(Type pldmType, Command pldmCommand,
+                                   const pldm_msg* request, size_t reqMsgLen)
     {
-        return handlers.at(pldmType)->handle(pldmCommand, request, reqMsgLen);
+        auto handler = find(pldmType);
+        if (!handler)
+        {
+            return std::nullopt;
+        }
+        return handler->handle(pldmCommand, request, reqMsgLen);
+    }
+
+    /** @brief Invoke the deferred PLDM command handler, if any
+     *
+     *  @param[in] pldmType - PLDM type code
+     *  @param[in] pldmCommand - PLDM command code
+     *  @param[in] request - PLDM request message
+     *  @param[in] reqMsgLen - PLDM request message size
+     *  @param[in] respond - called once with the PLDM response message
+     *  @return true if the command is deferred, false if handle() is to be
+     *          called instead
+     */
+    bool handleAsync(Type pldmType, Command pldmCommand,
+                     const pldm_msg* request, size_t reqMsgLen,
+                     ResponseSender&& respond)
+    {
+        auto handler = find(pldmType);
+        if (!handler)
+        {
+            return false;
+        }
+        return handler->handleAsync(pldmCommand, request, reqMsgLen,
+                                    std::move(respond));
     }
 
   private:
-    std::map<Type, std::unique_ptr<CmdHandler>> handlers;
+    /** @brief Handler of a PLDM type, nullptr if the type has none */
+    CmdHandler* find(Type pldmType) const
+    {
+        return handlers[pldmType].get();
+    }
+
+    /** @brief Handlers indexed by the PLDM type code */
+    std::array<std::unique_ptr<CmdHandler>, std::numeric_limits<Type>::max() + 1>
+        handlers;
+    /** @brief Types whose handler is still being constructed */
+    std::bitset<std::numeric_limits<Type>::max() + 1> notReady;
 };
 
 } // namespace responder
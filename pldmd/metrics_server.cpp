@@ -0,0 +1,192 @@
+#include "metrics_server.hpp"
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace metrics
+{
+
+namespace
+{
+constexpr auto metricsPath = "/xyz/openbmc_project/pldm/metrics";
+constexpr auto metricsInterface = "com.ampere.PLDM.Metrics";
+/** @brief A client which does not drain its socket is given up after this */
+constexpr time_t clientSendTimeoutSec = 1;
+} // namespace
+
+MetricsServer::MetricsServer(sdeventplus::Event& event,
+                             sdbusplus::bus::bus& bus, Registry& registry,
+                             const std::filesystem::path& socketPath) :
+    event(event),
+    registry(registry), socketPath(socketPath)
+{
+    vtable.emplace_back(sdbusplus::vtable::start());
+    vtable.emplace_back(sdbusplus::vtable::property(
+        "OpenMetrics", "s", &MetricsServer::getText));
+    vtable.emplace_back(sdbusplus::vtable::end());
+    object = std::make_unique<sdbusplus::server::interface::interface>(
+        bus, metricsPath, metricsInterface, vtable.data(), this);
+
+    if (!socketPath.empty())
+    {
+        listen();
+    }
+}
+
+MetricsServer::~MetricsServer()
+{
+    clients.clear();
+    listenSource.reset();
+    if (listenFd >= 0)
+    {
+        close(listenFd);
+        std::filesystem::remove(socketPath);
+    }
+}
+
+void MetricsServer::listen()
+{
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (socketPath.native().size() >= sizeof(addr.sun_path))
+    {
+        error("Metrics socket path {PATH} is too long", "PATH",
+              socketPath.native());
+        return;
+    }
+    std::strcpy(addr.sun_path, socketPath.c_str());
+
+    std::error_code ec;
+    std::filesystem::create_directories(socketPath.parent_path(), ec);
+    std::filesystem::remove(socketPath, ec);
+
+    listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd < 0)
+    {
+        error("Failed to create the metrics socket, ERRNO={ERRNO}", "ERRNO",
+              errno);
+        return;
+    }
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) ||
+        ::listen(listenFd, SOMAXCONN))
+    {
+        error("Failed to listen on the metrics socket {PATH}, ERRNO={ERRNO}",
+              "PATH", socketPath.native(), "ERRNO", errno);
+        close(listenFd);
+        listenFd = -1;
+        return;
+    }
+    chmod(socketPath.c_str(), S_IRUSR | S_IWUSR);
+
+    listenSource = std::make_unique<sdeventplus::source::IO>(
+        event, listenFd, EPOLLIN,
+        [this](sdeventplus::source::IO&, int, uint32_t) { acceptClients(); });
+}
+
+void MetricsServer::acceptClients()
+{
+    /* The sources of the answered clients are released here rather than in
+     * their own callbacks */
+    std::erase_if(clients, [](const auto& client) {
+        return client.second->get_enabled() == sdeventplus::source::Enabled::Off;
+    });
+
+    while (true)
+    {
+        int fd = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0)
+        {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+            {
+                error("Failed to accept a metrics client, ERRNO={ERRNO}",
+                      "ERRNO", errno);
+            }
+            if (errno != EINTR)
+            {
+                return;
+            }
+            continue;
+        }
+        timeval timeout{clientSendTimeoutSec, 0};
+        setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+        try
+        {
+            clients.emplace(fd, std::make_unique<sdeventplus::source::IO>(
+                                    event, fd, EPOLLIN,
+                                    [this](sdeventplus::source::IO&, int fd,
+                                           uint32_t) { serveClient(fd); }));
+        }
+        catch (const std::exception& e)
+        {
+            error("Failed to watch a metrics client, ERROR={ERROR}", "ERROR",
+                  e);
+            close(fd);
+        }
+    }
+}
+
+void MetricsServer::serveClient(int fd)
+{
+    auto it = clients.find(fd);
+    if (it == clients.end())
+    {
+        return;
+    }
+    it->second->set_enabled(sdeventplus::source::Enabled::Off);
+
+    /* The request is not parsed, any request or an EOF gets the metrics */
+    char request[1024];
+    while (recv(fd, request, sizeof(request), MSG_DONTWAIT) > 0)
+    {}
+
+    std::string body = registry.render();
+    std::string response =
+        "HTTP/1.0 200 OK\r\n"
+        "Content-Type: application/openmetrics-text; version=1.0.0; "
+        "charset=utf-8\r\n"
+        "Content-Length: " +
+        std::to_string(body.size()) + "\r\n\r\n" + body;
+
+    size_t sent = 0;
+    while (sent < response.size())
+    {
+        auto rc = send(fd, response.data() + sent, response.size() - sent,
+                       MSG_NOSIGNAL);
+        if (rc < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (rc <= 0)
+        {
+            break;
+        }
+        sent += rc;
+    }
+    shutdown(fd, SHUT_WR);
+    close(fd);
+}
+
+int MetricsServer::getText(sd_bus* /*bus*/, const char* /*path*/,
+                           const char* /*interface*/, const char* /*property*/,
+                           sd_bus_message* reply, void* context,
+                           sd_bus_error* /*error*/)
+{
+    auto server = static_cast<MetricsServer*>(context);
+    return sd_bus_message_append(reply, "s", server->registry.render().c_str());
+}
+
+} // namespace metrics
+} // namespace pldm
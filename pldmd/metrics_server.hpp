@@ -0,0 +1,78 @@
+#pragma once
+
+#include "common/metrics.hpp"
+
+#include <systemd/sd-bus.h>
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/server/interface.hpp>
+#include <sdbusplus/vtable.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/io.hpp>
+
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace pldm
+{
+namespace metrics
+{
+
+/** @class MetricsServer
+ *
+ *  Exports the metrics registry. The OpenMetrics text is the value of a
+ *  read-only D-Bus property and, when a socket path is given, is served
+ *  on a Unix stream socket as a HTTP/1.0 response, e.g.
+ *  "curl --unix-socket <path> http://localhost/metrics". The text is
+ *  rendered only when it is read.
+ */
+class MetricsServer
+{
+  public:
+    MetricsServer() = delete;
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+
+    /** @brief Constructor
+     *
+     *  @param[in] event - PLDM daemon's main event loop
+     *  @param[in] bus - D-Bus connection
+     *  @param[in] registry - metrics to export
+     *  @param[in] socketPath - path of the Unix socket, empty for D-Bus only
+     */
+    MetricsServer(sdeventplus::Event& event, sdbusplus::bus::bus& bus,
+                  Registry& registry,
+                  const std::filesystem::path& socketPath = {});
+
+    ~MetricsServer();
+
+  private:
+    /** @brief Bind the listening socket, failures are only logged */
+    void listen();
+
+    /** @brief Accept the pending clients */
+    void acceptClients();
+
+    /** @brief Answer a client once its request arrived */
+    void serveClient(int fd);
+
+    /** @brief sd-bus getter of the OpenMetrics property */
+    static int getText(sd_bus* bus, const char* path, const char* interface,
+                       const char* property, sd_bus_message* reply,
+                       void* context, sd_bus_error* error);
+
+    sdeventplus::Event& event;
+    Registry& registry;
+    std::filesystem::path socketPath;
+    int listenFd = -1;
+    std::unique_ptr<sdeventplus::source::IO> listenSource;
+    /** @brief Clients waiting for their request to be read */
+    std::map<int, std::unique_ptr<sdeventplus::source::IO>> clients;
+    std::vector<sdbusplus::vtable::vtable_t> vtable;
+    std::unique_ptr<sdbusplus::server::interface::interface> object;
+};
+
+} // namespace metrics
+} // namespace pldm
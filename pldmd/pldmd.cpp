@@ -1,14 +1,29 @@
 
 #include "common/flight_recorder.hpp"
 #include "common/instance_id.hpp"
+#include "common/log_sink.hpp"
+#include "common/loop_monitor.hpp"
+#include "common/request_trace.hpp"
+#include "common/startup_profile.hpp"
+#include "common/startup_tasks.hpp"
+#include "common/transfer_size.hpp"
 #include "common/transport.hpp"
 #include "common/utils.hpp"
+#include "common/write_behind.hpp"
 #include "dbus_impl_requester.hpp"
+#include "dbus_impl_send_recv.hpp"
 #include "fw-update/manager.hpp"
+#include "fw-update/package_intake.hpp"
 #include "invoker.hpp"
+#include "metrics_server.hpp"
+#include "rx_msg.hpp"
+#include "sensor_stream_server.hpp"
+#include "staged_startup.hpp"
 #include "requester/handler.hpp"
 #include "requester/mctp_endpoint_discovery.hpp"
 #include "requester/request.hpp"
+#include "requester/request_budgets.hpp"
+#include "requester/sensor_history_server.hpp"
 #include "requester/terminus_manager.hpp"
 #include <err.h>
 #include <getopt.h>
@@ -26,21 +41,28 @@
 
 #include <phosphor-logging/lg2.hpp>
 #include <sdeventplus/event.hpp>
+#include <sdeventplus/source/event.hpp>
 #include <sdeventplus/source/io.hpp>
 #include <sdeventplus/source/signal.hpp>
 #include <stdplus/signal.hpp>
 
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
+#include <deque>
 #include <fstream>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <iterator>
 #include <memory>
+#include <optional>
 #include <ranges>
+#include <span>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 #include "../requester/event_manager.hpp"
 
@@ -63,6 +85,8 @@ PHOSPHOR_LOG2_USING;
 #ifdef OEM_IBM
 #include "libpldmresponder/bios_oem_ibm.hpp"
 #include "libpldmresponder/file_io.hpp"
+#include "libpldmresponder/file_io_type_progress_src.hpp"
+#include "libpldmresponder/file_io_type_vpd.hpp"
 #include "libpldmresponder/oem_ibm_handler.hpp"
 #endif
 
@@ -75,6 +99,7 @@ using namespace pldm::responder;
 using namespace pldm::utils;
 using sdeventplus::source::Signal;
 using namespace pldm::flightrecorder;
+using Phase = pldm::utils::StartupProfile::Phase;
 
 void interruptFlightRecorderCallBack(Signal& /*signal*/,
                                      const struct signalfd_siginfo*)
@@ -84,67 +109,22 @@ void interruptFlightRecorderCallBack(Signal& /*signal*/,
     FlightRecorder::GetInstance().playRecorder();
 }
 
-static std::optional<Response>
-    processRxMsg(const std::vector<uint8_t>& requestMsg, Invoker& invoker,
-                 requester::Handler<requester::Request>& handler,
-                 fw_update::Manager* fwManager, pldm_tid_t tid)
+void toggleRequestTraceCallBack(Signal& /*signal*/,
+                                const struct signalfd_siginfo*)
 {
-    uint8_t eid = tid;
-
-    pldm_header_info hdrFields{};
-    auto hdr = reinterpret_cast<const pldm_msg_hdr*>(requestMsg.data());
-    if (PLDM_SUCCESS != unpack_pldm_header(hdr, &hdrFields))
+    // the first signal starts tracing, the next one dumps the trace and
+    // stops it
+    auto& trace = pldm::requesttrace::RequestTrace::GetInstance();
+    if (trace.isEnabled())
     {
-        error("Empty PLDM request header");
-        return std::nullopt;
+        trace.dump();
+        trace.setEnabled(false);
     }
-
-    if (PLDM_RESPONSE != hdrFields.msg_type)
+    else
     {
-        Response response;
-        auto request = reinterpret_cast<const pldm_msg*>(hdr);
-        size_t requestLen = requestMsg.size() - sizeof(struct pldm_msg_hdr);
-        try
-        {
-            if (hdrFields.pldm_type != PLDM_FWUP)
-            {
-                response = invoker.handle(hdrFields.pldm_type,
-                                          hdrFields.command, request,
-                                          requestLen);
-            }
-            else
-            {
-                response = fwManager->handleRequest(eid, hdrFields.command,
-                                                    request, requestLen);
-            }
-        }
-        catch (const std::out_of_range& e)
-        {
-            uint8_t completion_code = PLDM_ERROR_UNSUPPORTED_PLDM_CMD;
-            response.resize(sizeof(pldm_msg_hdr));
-            auto responseHdr = reinterpret_cast<pldm_msg_hdr*>(response.data());
-            pldm_header_info header{};
-            header.msg_type = PLDM_RESPONSE;
-            header.instance = hdrFields.instance;
-            header.pldm_type = hdrFields.pldm_type;
-            header.command = hdrFields.command;
-            if (PLDM_SUCCESS != pack_pldm_header(&header, responseHdr))
-            {
-                error("Failed adding response header");
-                return std::nullopt;
-            }
-            response.insert(response.end(), completion_code);
-        }
-        return response;
-    }
-    else if (PLDM_RESPONSE == hdrFields.msg_type)
-    {
-        auto response = reinterpret_cast<const pldm_msg*>(hdr);
-        size_t responseLen = requestMsg.size() - sizeof(struct pldm_msg_hdr);
-        handler.handleResponse(eid, hdrFields.instance, hdrFields.pldm_type,
-                               hdrFields.command, response, responseLen);
+        info("Start tracing the PLDM requests");
+        trace.setEnabled(true);
     }
-    return std::nullopt;
 }
 
 void optionUsage(void)
@@ -156,6 +136,7 @@ void optionUsage(void)
 
 int main(int argc, char** argv)
 {
+    auto& startupProfile = pldm::utils::StartupProfile::get();
     bool verbose = false;
     static struct option long_options[] = {{"verbose", no_argument, 0, 'v'},
                                            {0, 0, 0, 0}};
@@ -174,13 +155,37 @@ int main(int argc, char** argv)
     }
 
     // Setup PLDM requester transport
-    auto hostEID = pldm::utils::readHostEID();
-    /* To maintain current behaviour until we have the infrastructure to find
-     * and use the correct TIDs */
-    pldm_tid_t TID = hostEID;
+    /* The first host serves the responder transport and the BIOS, the other
+     * hosts of a multi-host system only exchange their PDRs and events */
+    auto hostEIDs = pldm::utils::readHostEIDs();
+#ifdef LIBPLDMRESPONDER
+    constexpr size_t maxHosts = UINT16_MAX / hostTerminusHandleRange;
+    if (hostEIDs.size() > maxHosts)
+    {
+        error("Only the first {MAX} hosts of {COUNT} are handled", "MAX",
+              maxHosts, "COUNT", hostEIDs.size());
+        hostEIDs.resize(maxHosts);
+    }
+#endif
+    uint8_t hostEID = hostEIDs.empty() ? 0 : hostEIDs.front();
     PldmTransport pldmTransport{};
+    startupProfile.mark(Phase::Transport);
     auto event = Event::get_default();
     auto& bus = pldm::utils::DBusHandler::getBus();
+    startupProfile.exportOnBus(bus, "/xyz/openbmc_project/pldm");
+    /* The bus is processed by the event loop, the mapper lookups and the
+     * properties of the PDRs are cached and follow the D-Bus signals */
+    pldm::utils::ServiceCache::get().enable(bus);
+    pldm::utils::PropertyCache::get().enable(bus);
+    /* SEL and fault log records are sent asynchronously from here on, the
+     * sink outlives the handlers which post to it */
+    pldm::utils::LogSink logSink(event, bus, LOG_SINK_QUEUE_SIZE);
+    /* The persisted files are written behind from here on, by a worker off
+     * the event loop */
+    pldm::utils::WriteBehind writeBehind(
+        std::chrono::milliseconds(WRITE_BEHIND_WINDOW),
+        std::chrono::milliseconds(WRITE_BEHIND_DEADLINE),
+        size_t{WRITE_BEHIND_BUDGET} * 1024);
     sdbusplus::server::manager_t objManager(bus,
                                             "/xyz/openbmc_project/sensors");
 
@@ -189,10 +194,22 @@ int main(int argc, char** argv)
                                     instanceIdDb);
     sdbusplus::server::manager_t inventoryManager(
         bus, "/xyz/openbmc_project/inventory");
+    startupProfile.mark(Phase::DBusSetup);
 
     Invoker invoker{};
     requester::Handler<requester::Request> reqHandler(&pldmTransport, event,
                                                       instanceIdDb, verbose);
+    /* Other daemons send their requests through the handler, which then
+     * owns every instance ID it sees a response for */
+    dbus_api::SendRecv dbusImplSendRecv(bus, "/xyz/openbmc_project/pldm",
+                                        instanceIdDb, &reqHandler);
+    requester::RequestBudgets requestBudgets(
+        bus, "/xyz/openbmc_project/pldm", reqHandler.getGovernor(),
+        [&reqHandler]() { reqHandler.pollEndpointQueues(); });
+    if (!requestBudgets.load(REQUEST_BUDGETS_JSON))
+    {
+        error("Failed to set up the request budgets.");
+    }
 
     std::unique_ptr<pldm_pdr, decltype(&pldm_pdr_destroy)> pdrRepo(
         pldm_pdr_init(), pldm_pdr_destroy);
@@ -200,12 +217,10 @@ int main(int argc, char** argv)
     {
         throw std::runtime_error("Failed to instantiate PDR repository");
     }
+    startupProfile.mark(Phase::PdrRepo);
     DBusHandler dbusHandler;
     std::unique_ptr<pldm::host_effecters::HostEffecterParser>
-        hostEffecterParser =
-            std::make_unique<pldm::host_effecters::HostEffecterParser>(
-                &instanceIdDb, pldmTransport.getEventSource(), pdrRepo.get(),
-                &dbusHandler, HOST_JSONS_DIR, &reqHandler);
+        hostEffecterParser;
     std::unique_ptr<pldm_entity_association_tree,
                     decltype(&pldm_entity_association_tree_destroy)>
         entityTree(pldm_entity_association_tree_init(),
@@ -224,14 +239,44 @@ int main(int argc, char** argv)
         throw std::runtime_error(
             "Failed to instantiate BMC PDR entity association tree");
     }
+    startupProfile.mark(Phase::EntityTrees);
+
+    /* The transport and the Base responder are up before the event loop
+     * starts, the other responders are constructed by the startup stages
+     * and their requests are answered with PLDM_ERROR_NOT_READY meanwhile */
+#ifdef LIBPLDMRESPONDER
+    for (auto type : {PLDM_BIOS, PLDM_PLATFORM, PLDM_FRU})
+    {
+        invoker.setReady(type, false);
+    }
+#endif
+    invoker.setReady(PLDM_FWUP, false);
+    std::unique_ptr<terminus::Manager> devManager;
+    std::unique_ptr<requester::SensorHistoryServer> sensorHistoryServer;
+    std::unique_ptr<EventManager> eventManager;
+#ifdef SENSOR_STREAM_SOCKET_PATH
+    std::unique_ptr<pldm::sensor::SensorStreamServer> sensorStreamServer;
+#endif
+    std::unique_ptr<pldm::metrics::MetricsServer> metricsServer;
+    std::deque<StagedStartup::Stage> stages;
+    /* The JSON configurations are parsed on the other cores meanwhile, the
+     * stages wait for them */
+    auto startupTasks = std::make_unique<pldm::utils::StartupTasks>(
+        event, std::max(1u, std::thread::hardware_concurrency()));
 
 #ifdef LIBPLDMRESPONDER
     using namespace pldm::state_sensor;
     dbus_api::Host dbusImplHost(bus, "/xyz/openbmc_project/pldm");
     std::shared_ptr<HostPDRHandler> hostPDRHandler;
     std::unique_ptr<DbusToPLDMEvent> dbusToPLDMEventHandler;
+    std::vector<std::shared_ptr<HostPDRHandler>> otherHostPDRHandlers;
+    std::vector<std::unique_ptr<DbusToPLDMEvent>> otherDbusToPLDMEventHandlers;
     std::unique_ptr<oem_platform::Handler> oemPlatformHandler{};
     std::unique_ptr<oem_bios::Handler> oemBiosHandler{};
+    fru::Handler* fruHandler = nullptr;
+    std::unique_ptr<dbus_api::Pdr> dbusImplPdr;
+    std::unique_ptr<sdbusplus::xyz::openbmc_project::PLDM::server::Event>
+        dbusImplEvent;
 
 #ifdef OEM_IBM
     std::unique_ptr<pldm::responder::CodeUpdate> codeUpdate =
@@ -241,91 +286,253 @@ int main(int argc, char** argv)
         &dbusHandler, codeUpdate.get(), pldmTransport.getEventSource(), hostEID,
         instanceIdDb, event, &reqHandler);
     codeUpdate->setOemPlatformHandler(oemPlatformHandler.get());
+    /* The progress codes of the IPL are coalesced and set asynchronously */
+    pldm::responder::ProgressCodePublisher progressCodePublisher(event, bus);
+    /* The #D keyword is served from memory until the VPD changes */
+    pldm::responder::KeywordCache::get().enable(bus);
     invoker.registerHandler(PLDM_OEM, std::make_unique<oem_ibm::Handler>(
                                           oemPlatformHandler.get(),
                                           pldmTransport.getEventSource(),
                                           hostEID, &instanceIdDb, &reqHandler));
     oemBiosHandler = std::make_unique<oem::ibm::bios::Handler>(&dbusHandler);
 #endif
-    if (hostEID)
+    invoker.registerHandler(
+        PLDM_BASE,
+        std::make_unique<base::Handler>(hostEID, instanceIdDb, event,
+                                        oemPlatformHandler.get(), &reqHandler));
+    for (const auto& path : {HOST_JSONS_DIR, EVENTS_JSONS_DIR, FRU_JSONS_DIR,
+                             FRU_MASTER_JSON, PDR_JSONS_DIR})
     {
-        hostPDRHandler = std::make_shared<HostPDRHandler>(
-            pldmTransport.getEventSource(), hostEID, event, pdrRepo.get(),
-            EVENTS_JSONS_DIR, entityTree.get(), bmcEntityTree.get(),
-            instanceIdDb, &reqHandler, oemPlatformHandler.get());
-        // HostFirmware interface needs access to hostPDR to know if host
-        // is running
-        dbusImplHost.setHostPdrObj(hostPDRHandler);
+        pldm::utils::preloadJson(*startupTasks, path);
+    }
+#ifndef BIOS_COMPILED_JSON
+    pldm::utils::preloadJson(*startupTasks, BIOS_JSONS_DIR);
+#endif
 
+    stages.emplace_back([&]() {
+        /* Every result was handed over to the JsonCache */
+        startupTasks.reset();
         hostEffecterParser =
             std::make_unique<pldm::host_effecters::HostEffecterParser>(
                 &instanceIdDb, pldmTransport.getEventSource(), pdrRepo.get(),
                 &dbusHandler, HOST_JSONS_DIR, &reqHandler);
-        dbusToPLDMEventHandler = std::make_unique<DbusToPLDMEvent>(
-            pldmTransport.getEventSource(), hostEID, instanceIdDb, &reqHandler);
-    }
-    auto biosHandler = std::make_unique<bios::Handler>(
-        pldmTransport.getEventSource(), hostEID, &instanceIdDb, &reqHandler,
-        oemBiosHandler.get());
-    auto fruHandler = std::make_unique<fru::Handler>(
-        FRU_JSONS_DIR, FRU_MASTER_JSON, pdrRepo.get(), entityTree.get(),
-        bmcEntityTree.get());
-    // FRU table is built lazily when a FRU command or Get PDR command is
-    // handled. To enable building FRU table, the FRU handler is passed to the
-    // Platform handler.
-    std::unique_ptr<terminus::Manager> devManager =
-        std::make_unique<terminus::Manager>(
+        startupProfile.mark(Phase::HostEffecterParser);
+        if (hostEID)
+        {
+            hostPDRHandler = std::make_shared<HostPDRHandler>(
+                pldmTransport.getEventSource(), hostEID, event, pdrRepo.get(),
+                EVENTS_JSONS_DIR, entityTree.get(), bmcEntityTree.get(),
+                instanceIdDb, &reqHandler, oemPlatformHandler.get(), 0,
+                hostEIDs.size());
+            // HostFirmware interface needs access to hostPDR to know if host
+            // is running
+            dbusImplHost.setHostPdrObj(hostPDRHandler);
+
+            dbusToPLDMEventHandler = std::make_unique<DbusToPLDMEvent>(
+                pldmTransport.getEventSource(), hostEID, instanceIdDb,
+                &reqHandler, event);
+        }
+        /* The hosts share the PDR repo, each in its range of terminus
+         * handles, and exchange their PDRs in parallel */
+        for (size_t index = 1; index < hostEIDs.size(); index++)
+        {
+            otherHostPDRHandlers.emplace_back(std::make_shared<HostPDRHandler>(
+                pldmTransport.getEventSource(), hostEIDs[index], event,
+                pdrRepo.get(), EVENTS_JSONS_DIR, entityTree.get(),
+                bmcEntityTree.get(), instanceIdDb, &reqHandler,
+                oemPlatformHandler.get(), index, hostEIDs.size()));
+            otherDbusToPLDMEventHandlers.emplace_back(
+                std::make_unique<DbusToPLDMEvent>(
+                    pldmTransport.getEventSource(), hostEIDs[index],
+                    instanceIdDb, &reqHandler, event));
+        }
+    });
+    stages.emplace_back([&]() {
+        invoker.registerHandler(
+            PLDM_BIOS, std::make_unique<bios::Handler>(
+                           pldmTransport.getEventSource(), hostEID,
+                           &instanceIdDb, &reqHandler, oemBiosHandler.get()));
+        startupProfile.mark(Phase::BiosHandler);
+    });
+    stages.emplace_back([&]() {
+        auto handler = std::make_unique<fru::Handler>(
+            FRU_JSONS_DIR, FRU_MASTER_JSON, pdrRepo.get(), entityTree.get(),
+            bmcEntityTree.get());
+        // FRU table is prebuilt once the inventory answers, a FRU command or
+        // Get PDR command handled before that builds it. To enable building
+        // FRU table, the FRU handler is passed to the Platform handler.
+        handler->buildFRUTableAsync();
+        fruHandler = handler.get();
+        invoker.registerHandler(PLDM_FRU, std::move(handler));
+        startupProfile.mark(Phase::FruHandler);
+    });
+    stages.emplace_back([&]() {
+#ifdef SENSOR_STREAM_SOCKET_PATH
+        /* Serving before the termini create their sensors gives them an ID
+         */
+        sensorStreamServer = std::make_unique<pldm::sensor::SensorStreamServer>(
+            event, SENSOR_STREAM_SOCKET_PATH);
+#endif
+        devManager = std::make_unique<terminus::Manager>(
             bus, event, pdrRepo.get(), entityTree.get(), bmcEntityTree.get(),
             &reqHandler, instanceIdDb);
-    std::unique_ptr<EventManager> eventManager =
-        std::make_unique<EventManager>(devManager.get());
-    pldm::responder::platform::EventMap addOnEventHandlers{
-        {PLDM_MESSAGE_POLL_EVENT,
-         {[&eventManager](const pldm_msg* request, size_t payloadLength,
-                             uint8_t formatVersion, uint8_t tid,
-                             size_t eventDataOffset) {
-             return eventManager->handleMessagePollEvent(
-                 request, payloadLength, formatVersion, tid, eventDataOffset);
-         }}},
-        {PLDM_SENSOR_EVENT,
-         {[&eventManager](const pldm_msg* request, size_t payloadLength,
-                             uint8_t formatVersion, uint8_t tid,
-                             size_t eventDataOffset) {
-             return eventManager->handleSensorEvent(
-                 request, payloadLength, formatVersion, tid, eventDataOffset);
-         }}}};
-
-    auto platformHandler = std::make_unique<platform::Handler>(
-        &dbusHandler, PDR_JSONS_DIR, pdrRepo.get(), hostPDRHandler.get(),
-        dbusToPLDMEventHandler.get(), fruHandler.get(),
-        oemPlatformHandler.get(), event, true, addOnEventHandlers);
+        /* GetFreshness is served even if no reading history is kept */
+        sensorHistoryServer = std::make_unique<requester::SensorHistoryServer>(
+            bus, "/xyz/openbmc_project/pldm",
+            [&devManager](std::string_view path) {
+            return devManager->findSensor(path);
+        });
+        startupProfile.mark(Phase::TerminusManager);
+    });
+    stages.emplace_back([&]() {
+        eventManager = std::make_unique<EventManager>(
+            devManager.get(), event,
+            std::chrono::milliseconds(SENSOR_EVENT_COALESCE_WINDOW));
+        pldm::responder::platform::EventMap addOnEventHandlers{
+            {PLDM_MESSAGE_POLL_EVENT,
+             {[&eventManager](const pldm_msg* request, size_t payloadLength,
+                                 uint8_t formatVersion, uint8_t tid,
+                                 size_t eventDataOffset) {
+                 return eventManager->handleMessagePollEvent(
+                     request, payloadLength, formatVersion, tid,
+                     eventDataOffset);
+             }}},
+            {PLDM_SENSOR_EVENT,
+             {[&eventManager](const pldm_msg* request, size_t payloadLength,
+                                 uint8_t formatVersion, uint8_t tid,
+                                 size_t eventDataOffset) {
+                 return eventManager->handleSensorEvent(
+                     request, payloadLength, formatVersion, tid,
+                     eventDataOffset);
+             }}},
+            {PLDM_PDR_REPOSITORY_CHG_EVENT,
+             {[&eventManager](const pldm_msg* request, size_t payloadLength,
+                                 uint8_t formatVersion, uint8_t tid,
+                                 size_t eventDataOffset) {
+                 return eventManager->handlePDRRepositoryChgEvent(
+                     request, payloadLength, formatVersion, tid,
+                     eventDataOffset);
+             }}},
+            {PLDM_HEARTBEAT_TIMER_ELAPSED_EVENT,
+             {[&eventManager](const pldm_msg* request, size_t payloadLength,
+                                 uint8_t formatVersion, uint8_t tid,
+                                 size_t eventDataOffset) {
+                 return eventManager->handleHeartbeatEvent(
+                     request, payloadLength, formatVersion, tid,
+                     eventDataOffset);
+             }}}};
+
+        auto platformHandler = std::make_unique<platform::Handler>(
+            &dbusHandler, PDR_JSONS_DIR, pdrRepo.get(), hostPDRHandler.get(),
+            dbusToPLDMEventHandler.get(), fruHandler, oemPlatformHandler.get(),
+            event, true, addOnEventHandlers);
+        for (size_t index = 0; index < otherHostPDRHandlers.size(); index++)
+        {
+            platformHandler->addHost(
+                otherHostPDRHandlers[index].get(),
+                otherDbusToPLDMEventHandlers[index].get());
+        }
+        startupProfile.mark(Phase::PlatformHandler);
 #ifdef OEM_IBM
-    pldm::responder::oem_ibm_platform::Handler* oemIbmPlatformHandler =
-        dynamic_cast<pldm::responder::oem_ibm_platform::Handler*>(
-            oemPlatformHandler.get());
-    oemIbmPlatformHandler->setPlatformHandler(platformHandler.get());
+        pldm::responder::oem_ibm_platform::Handler* oemIbmPlatformHandler =
+            dynamic_cast<pldm::responder::oem_ibm_platform::Handler*>(
+                oemPlatformHandler.get());
+        oemIbmPlatformHandler->setPlatformHandler(platformHandler.get());
 #endif
+        invoker.registerHandler(PLDM_PLATFORM, std::move(platformHandler));
+        dbusImplPdr = std::make_unique<dbus_api::Pdr>(
+            bus, "/xyz/openbmc_project/pldm", pdrRepo.get());
+        dbusImplEvent = std::make_unique<
+            sdbusplus::xyz::openbmc_project::PLDM::server::Event>(
+            bus, "/xyz/openbmc_project/pldm");
+    });
 
-    invoker.registerHandler(PLDM_BIOS, std::move(biosHandler));
-    invoker.registerHandler(PLDM_PLATFORM, std::move(platformHandler));
-    invoker.registerHandler(
-        PLDM_BASE,
-        std::make_unique<base::Handler>(hostEID, instanceIdDb, event,
-                                        oemPlatformHandler.get(), &reqHandler));
-    invoker.registerHandler(PLDM_FRU, std::move(fruHandler));
-    dbus_api::Pdr dbusImplPdr(bus, "/xyz/openbmc_project/pldm", pdrRepo.get());
-    sdbusplus::xyz::openbmc_project::PLDM::server::Event dbusImplEvent(
-        bus, "/xyz/openbmc_project/pldm");
+#endif
 
+    std::unique_ptr<fw_update::Manager> fwManager;
+    std::unique_ptr<fw_update::PackageIntake> packageIntake;
+    std::unique_ptr<MctpDiscovery> mctpDiscoveryHandler;
+    stages.emplace_back([&]() {
+        fwManager = std::make_unique<fw_update::Manager>(event, reqHandler,
+                                                         instanceIdDb);
+        invoker.setReady(PLDM_FWUP, true);
+        packageIntake = std::make_unique<fw_update::PackageIntake>(
+            event, bus, "/xyz/openbmc_project/pldm",
+            [&fwManager](int fd) { return fwManager->processPackage(fd); });
+        mctpDiscoveryHandler = std::make_unique<MctpDiscovery>(
+            bus, fwManager.get(), devManager.get());
+        startupProfile.mark(Phase::MctpDiscovery);
+
+        /* The name is requested once every object is on the bus */
+        bus.request_name("xyz.openbmc_project.PLDM");
+        startupProfile.mark(Phase::NameAcquired);
+#ifdef METRICS_SOCKET_PATH
+        metricsServer = std::make_unique<pldm::metrics::MetricsServer>(
+            event, bus, pldm::metrics::Registry::get(), METRICS_SOCKET_PATH);
+#else
+        metricsServer = std::make_unique<pldm::metrics::MetricsServer>(
+            event, bus, pldm::metrics::Registry::get());
+#endif
+#ifdef LIBPLDMRESPONDER
+        if (hostPDRHandler)
+        {
+            hostPDRHandler->setHostFirmwareCondition();
+        }
+        for (auto& otherHost : otherHostPDRHandlers)
+        {
+            otherHost->setHostFirmwareCondition();
+        }
 #endif
+    });
+
+    auto sendResponse = [verbose, &pldmTransport](pldm_tid_t tid,
+                                                  Response&& response) {
+        FlightRecorder::GetInstance().saveRecord(response, true, tid);
+        if (verbose)
+        {
+            printBuffer(Tx, response);
+        }
+
+        auto returnCode = pldmTransport.sendMsg(tid, response.data(),
+                                                response.size());
+        if (returnCode != PLDM_REQUESTER_SUCCESS)
+        {
+            warning("Failed to send PLDM response: {RETURN_CODE}",
+                    "RETURN_CODE", returnCode);
+        }
+        /* The next response reuses the buffer */
+        pldm::utils::RequestPool::release(std::move(response));
+    };
 
-    std::unique_ptr<fw_update::Manager> fwManager =
-        std::make_unique<fw_update::Manager>(event, reqHandler, instanceIdDb);
-    std::unique_ptr<MctpDiscovery> mctpDiscoveryHandler =
-        std::make_unique<MctpDiscovery>(bus, fwManager.get(), devManager.get());
+    // Work on the transport-owned buffer, it is released once the message
+    // is processed
+    PldmTransport::RxHandler handleRxMsg =
+        [verbose, &invoker, &reqHandler, &fwManager,
+         &sendResponse](pldm_tid_t tid, const void* rx, size_t len) {
+        /* The temporaries of the handlers are dropped once the response is
+         * sent */
+        pldm::utils::MessageArena::Scope arena;
+        std::span<const uint8_t> requestMsgView(
+            static_cast<const uint8_t*>(rx), len);
+        FlightRecorder::GetInstance().saveRecord(requestMsgView, false, tid);
+        if (verbose)
+        {
+            printBuffer(Rx, requestMsgView);
+        }
+        // The response goes back to the terminus which sent the request
+        ResponseSender respond = std::bind_front(sendResponse, tid);
+        // process message and send response
+        auto response = processRxMsg(requestMsgView, invoker, reqHandler,
+                                     fwManager.get(), tid, respond);
+        if (response.has_value())
+        {
+            respond(std::move(*response));
+        }
+    };
 
-    auto callback = [verbose, &invoker, &reqHandler, &fwManager, &pldmTransport,
-                     TID](IO& io, int fd, uint32_t revents) mutable {
+    auto callback = [&pldmTransport, &handleRxMsg](IO& io, int fd,
+                                                   uint32_t revents) {
+        pldm::metrics::LoopMonitor::setSource("io:mctp");
         if (!(revents & EPOLLIN))
         {
             return;
@@ -335,53 +542,22 @@ int main(int argc, char** argv)
             return;
         }
 
-        int returnCode = 0;
-        void* requestMsg;
-        size_t recvDataLength;
-        returnCode = pldmTransport.recvMsg(TID, requestMsg, recvDataLength);
-
-        if (returnCode == PLDM_REQUESTER_SUCCESS)
-        {
-            std::vector<uint8_t> requestMsgVec(
-                static_cast<uint8_t*>(requestMsg),
-                static_cast<uint8_t*>(requestMsg) + recvDataLength);
-            FlightRecorder::GetInstance().saveRecord(requestMsgVec, false);
-            if (verbose)
-            {
-                printBuffer(Rx, requestMsgVec);
-            }
-            // process message and send response
-            auto response = processRxMsg(requestMsgVec, invoker, reqHandler,
-                                         fwManager.get(), TID);
-            if (response.has_value())
-            {
-                FlightRecorder::GetInstance().saveRecord(*response, true);
-                if (verbose)
-                {
-                    printBuffer(Tx, *response);
-                }
-
-                returnCode = pldmTransport.sendMsg(TID, (*response).data(),
-                                                   (*response).size());
-                if (returnCode != PLDM_REQUESTER_SUCCESS)
-                {
-                    warning("Failed to send PLDM response: {RETURN_CODE}",
-                            "RETURN_CODE", returnCode);
-                }
-            }
-        }
+        // Drain the queued messages in one wakeup, bounded by the budget so
+        // that a message storm does not starve the other event sources
+        auto returnCode = pldmTransport.recvMsgs(
+            fd, MAX_RX_MESSAGES_PER_WAKEUP, handleRxMsg);
         // TODO check that we get here if mctp-demux dies?
-        else if (returnCode == PLDM_REQUESTER_RECV_FAIL)
+        if (returnCode == PLDM_REQUESTER_RECV_FAIL)
         {
-            // MCTP daemon has closed the socket this daemon is connected to.
-            // This may or may not be an error scenario, in either case the
-            // recovery mechanism for this daemon is to restart, and hence exit
-            // the event loop, that will cause this daemon to exit with a
-            // failure code.
+            // MCTP daemon has closed the socket this daemon is connected
+            // to. This may or may not be an error scenario, in either case
+            // the recovery mechanism for this daemon is to restart, and
+            // hence exit the event loop, that will cause this daemon to
+            // exit with a failure code.
             error("io exiting");
             io.get_event().exit(0);
         }
-        else
+        else if (returnCode != PLDM_REQUESTER_SUCCESS)
         {
             warning("Failed to receive PLDM request: {RETURN_CODE}",
                     "RETURN_CODE", returnCode);
@@ -389,18 +565,66 @@ int main(int argc, char** argv)
     };
 
     bus.attach_event(event.get(), SD_EVENT_PRIORITY_NORMAL);
-    bus.request_name("xyz.openbmc_project.PLDM");
-    IO io(event, pldmTransport.getEventSource(), EPOLLIN, std::move(callback));
-#ifdef LIBPLDMRESPONDER
-    if (hostPDRHandler)
+    // Each socket of the transport is polled on its own, the termini which
+    // get their own socket later are added as they come
+    // The sockets are in the critical RAS lane: the fatal error events and
+    // the responses of the critical polls come in through them
+#ifdef PLDM_TRANSPORT_WITH_IO_URING
+    /* The sockets are sent and received through an io_uring, its eventfd
+     * is then the single event source. The sends queued by a dispatch of
+     * the loop are submitted together after it */
+    std::optional<sdeventplus::source::Post> flushSends;
+    if (pldmTransport.enableRing())
+    {
+        flushSends.emplace(
+            event, [&pldmTransport](sdeventplus::source::EventBase&) {
+            pldmTransport.flush();
+        });
+        flushSends->set_priority(CRITICAL_RAS_PRIORITY);
+    }
+    else
     {
-        hostPDRHandler->setHostFirmwareCondition();
+        warning("io_uring is not available, use the socket calls");
     }
 #endif
+    std::vector<std::unique_ptr<IO>> ios;
+    auto addSocket = [&ios, &event, &callback](int fd) {
+        auto& io = ios.emplace_back(
+            std::make_unique<IO>(event, fd, EPOLLIN, callback));
+        io->set_priority(CRITICAL_RAS_PRIORITY);
+    };
+    for (auto fd : pldmTransport.getEventSources())
+    {
+        addSocket(fd);
+    }
+    pldmTransport.onSocketAdded(addSocket);
+    startupProfile.mark(Phase::ResponderReady);
+    StagedStartup startup(event, std::move(stages));
+    startup.pause();
+    startupTasks->onIdle([&startup]() { startup.resume(); });
+    /* SIGTERM stops the event loop, so the pending files are written */
+    stdplus::signal::block(SIGTERM);
+    sdeventplus::source::Signal sigTerm(
+        event, SIGTERM, [](Signal& signal, const struct signalfd_siginfo*) {
+            signal.get_event().exit(EXIT_SUCCESS);
+        });
     stdplus::signal::block(SIGUSR1);
     sdeventplus::source::Signal sigUsr1(
         event, SIGUSR1, std::bind_front(&interruptFlightRecorderCallBack));
+    stdplus::signal::block(SIGUSR2);
+    sdeventplus::source::Signal sigUsr2(
+        event, SIGUSR2, std::bind_front(&toggleRequestTraceCallBack));
+#ifdef EVENT_LOOP_PROBE_INTERVAL
+    pldm::metrics::LoopMonitor loopMonitor(
+        event, bus, pldm::metrics::Registry::get(),
+        std::chrono::milliseconds(EVENT_LOOP_PROBE_INTERVAL),
+        std::chrono::milliseconds(EVENT_LOOP_SLOW_CALLBACK),
+        std::chrono::milliseconds(EVENT_LOOP_WATCHDOG_MAX_LAG));
+    int returnCode = loopMonitor.run();
+#else
     int returnCode = event.loop();
+#endif
+    writeBehind.flush();
     if (returnCode)
     {
         exit(EXIT_FAILURE);
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "common/transfer_size.hpp"
+#include "common/utils.hpp"
+#include "invoker.hpp"
+
+#include <libpldm/base.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <optional>
+#include <span>
+#include <stdexcept>
+
+namespace pldm
+{
+
+/** @brief Process a PLDM message received by pldmd
+ *
+ *  @details A request is dispatched to the responder of its type, the
+ *  firmware update requests to the firmware update manager, and an
+ *  unsupported command gets a completion code only response. The requests
+ *  of a type whose handler is not constructed yet are answered with
+ *  PLDM_ERROR_NOT_READY. A response is
+ *  passed to the requester handler. The daemon and the replay benchmark
+ *  share this dispatch, the handler and the manager are template parameters
+ *  so the benchmark can stub the transport side.
+ *
+ *  @param[in] requestMsg - PLDM message
+ *  @param[in] invoker - responders by PLDM type
+ *  @param[in] handler - requester handler
+ *  @param[in] fwManager - firmware update manager, nullptr if none
+ *  @param[in] tid - terminus which sent the message
+ *  @param[in] sendResponse - sends the response of a deferred handler
+ *
+ *  @return - the response to send, std::nullopt if none or deferred
+ */
+template <class RequestHandler, class FwManager>
+std::optional<Response>
+    processRxMsg(std::span<const uint8_t> requestMsg,
+                 responder::Invoker& invoker, RequestHandler& handler,
+                 FwManager* fwManager, pldm_tid_t tid,
+                 const responder::ResponseSender& sendResponse)
+{
+    uint8_t eid = tid;
+
+    if (requestMsg.size() < sizeof(struct pldm_msg_hdr))
+    {
+        lg2::error("Short PLDM message, length {LENGTH}", "LENGTH",
+                   requestMsg.size());
+        return std::nullopt;
+    }
+
+    pldm_header_info hdrFields{};
+    auto hdr = reinterpret_cast<const pldm_msg_hdr*>(requestMsg.data());
+    if (PLDM_SUCCESS != unpack_pldm_header(hdr, &hdrFields))
+    {
+        lg2::error("Empty PLDM request header");
+        return std::nullopt;
+    }
+
+    if (PLDM_RESPONSE != hdrFields.msg_type)
+    {
+        std::optional<Response> response;
+        auto request = reinterpret_cast<const pldm_msg*>(hdr);
+        size_t requestLen = requestMsg.size() - sizeof(struct pldm_msg_hdr);
+        /* The multipart responders size the parts for the requester */
+        pldm::transfer::TransferSizes::get().setRequester(eid);
+        try
+        {
+            if (hdrFields.pldm_type != PLDM_FWUP)
+            {
+                /* A deferred handler sends the response once its D-Bus
+                 * calls complete, the next messages are handled meanwhile */
+                if (invoker.handleAsync(
+                        hdrFields.pldm_type, hdrFields.command, request,
+                        requestLen, responder::ResponseSender(sendResponse)))
+                {
+                    return std::nullopt;
+                }
+                response = invoker.handle(hdrFields.pldm_type,
+                                          hdrFields.command, request,
+                                          requestLen);
+            }
+            else if (fwManager)
+            {
+                response = fwManager->handleRequest(eid, hdrFields.command,
+                                                    request, requestLen);
+            }
+        }
+        catch (const std::out_of_range& e)
+        {
+            response.reset();
+        }
+        if (response)
+        {
+            return response;
+        }
+
+        uint8_t completion_code = invoker.isReady(hdrFields.pldm_type)
+                                      ? PLDM_ERROR_UNSUPPORTED_PLDM_CMD
+                                      : PLDM_ERROR_NOT_READY;
+        response.emplace(
+            pldm::utils::RequestPool::acquire(sizeof(pldm_msg_hdr)));
+        auto responseHdr = reinterpret_cast<pldm_msg_hdr*>(response->data());
+        pldm_header_info header{};
+        header.msg_type = PLDM_RESPONSE;
+        header.instance = hdrFields.instance;
+        header.pldm_type = hdrFields.pldm_type;
+        header.command = hdrFields.command;
+        if (PLDM_SUCCESS != pack_pldm_header(&header, responseHdr))
+        {
+            lg2::error("Failed adding response header");
+            return std::nullopt;
+        }
+        response->insert(response->end(), completion_code);
+        return response;
+    }
+    else if (PLDM_RESPONSE == hdrFields.msg_type)
+    {
+        auto response = reinterpret_cast<const pldm_msg*>(hdr);
+        size_t responseLen = requestMsg.size() - sizeof(struct pldm_msg_hdr);
+        handler.handleResponse(eid, hdrFields.instance, hdrFields.pldm_type,
+                               hdrFields.command, response, responseLen);
+    }
+    return std::nullopt;
+}
+
+} // namespace pldm
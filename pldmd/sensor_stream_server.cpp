@@ -0,0 +1,205 @@
+#include "sensor_stream_server.hpp"
+
+#include "common/metrics.hpp"
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace sensor
+{
+
+SensorStreamServer::SensorStreamServer(sdeventplus::Event& event,
+                                       const std::filesystem::path& socketPath,
+                                       SensorStream& stream) :
+    event(event),
+    socketPath(socketPath), stream(stream),
+    flushTimer(event, [this](auto&) { this->stream.flush(); })
+{
+    flushTimer.setEnabled(false);
+    listen();
+    if (listenFd < 0)
+    {
+        return;
+    }
+    stream.start(
+        [this](int fd, std::span<const uint8_t> frame) {
+        return sendFrame(fd, frame);
+    },
+        [this]() { flushTimer.restartOnce(maxDelay); });
+}
+
+SensorStreamServer::~SensorStreamServer()
+{
+    if (listenFd >= 0)
+    {
+        stream.stop();
+    }
+    for (const auto& [fd, source] : clients)
+    {
+        close(fd);
+    }
+    clients.clear();
+    listenSource.reset();
+    if (listenFd >= 0)
+    {
+        close(listenFd);
+        std::filesystem::remove(socketPath);
+    }
+}
+
+void SensorStreamServer::listen()
+{
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (socketPath.native().size() >= sizeof(addr.sun_path))
+    {
+        error("Sensor stream socket path {PATH} is too long", "PATH",
+              socketPath.native());
+        return;
+    }
+    std::strcpy(addr.sun_path, socketPath.c_str());
+
+    std::error_code ec;
+    std::filesystem::create_directories(socketPath.parent_path(), ec);
+    std::filesystem::remove(socketPath, ec);
+
+    listenFd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                      0);
+    if (listenFd < 0)
+    {
+        error("Failed to create the sensor stream socket, ERRNO={ERRNO}",
+              "ERRNO", errno);
+        return;
+    }
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) ||
+        ::listen(listenFd, SOMAXCONN))
+    {
+        error(
+            "Failed to listen on the sensor stream socket {PATH}, ERRNO={ERRNO}",
+            "PATH", socketPath.native(), "ERRNO", errno);
+        close(listenFd);
+        listenFd = -1;
+        return;
+    }
+    chmod(socketPath.c_str(), S_IRUSR | S_IWUSR);
+
+    listenSource = std::make_unique<sdeventplus::source::IO>(
+        event, listenFd, EPOLLIN,
+        [this](sdeventplus::source::IO&, int, uint32_t) { acceptClients(); });
+}
+
+void SensorStreamServer::acceptClients()
+{
+    while (true)
+    {
+        int fd = accept4(listenFd, nullptr, nullptr,
+                         SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0)
+        {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+            {
+                error("Failed to accept a sensor stream client, "
+                      "ERRNO={ERRNO}",
+                      "ERRNO", errno);
+            }
+            if (errno != EINTR)
+            {
+                return;
+            }
+            continue;
+        }
+        try
+        {
+            clients.emplace(fd, std::make_unique<sdeventplus::source::IO>(
+                                    event, fd, EPOLLIN,
+                                    [this](sdeventplus::source::IO&, int fd,
+                                           uint32_t) { readClient(fd); }));
+            stream.addClient(fd);
+        }
+        catch (const std::exception& e)
+        {
+            error("Failed to watch a sensor stream client, ERROR={ERROR}",
+                  "ERROR", e);
+            close(fd);
+        }
+    }
+}
+
+void SensorStreamServer::readClient(int fd)
+{
+    auto it = clients.find(fd);
+    if (it == clients.end())
+    {
+        return;
+    }
+
+    std::array<uint8_t, SensorStream::maxFrameSize> frame;
+    while (true)
+    {
+        auto rc = recv(fd, frame.data(), frame.size(), MSG_DONTWAIT);
+        if (rc < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (rc < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            return;
+        }
+        if (rc <= 0 ||
+            !stream.receive(fd, std::span(frame.data(),
+                                          static_cast<size_t>(rc))))
+        {
+            break;
+        }
+    }
+
+    /* EOF, error or malformed frame */
+    stream.removeClient(fd);
+    clients.erase(it);
+    close(fd);
+}
+
+SensorStream::SendResult
+    SensorStreamServer::sendFrame(int fd, std::span<const uint8_t> frame)
+{
+    static auto& droppedFrames = pldm::metrics::Registry::get().counter(
+        "pldm_sensor_stream_dropped_frames",
+        "Sensor stream frames not sent to a client too slow to read them");
+
+    while (true)
+    {
+        auto rc = send(fd, frame.data(), frame.size(),
+                       MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (rc >= 0)
+        {
+            return SensorStream::SendResult::Sent;
+        }
+        if (errno == EINTR)
+        {
+            continue;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+            droppedFrames.inc();
+            return SensorStream::SendResult::Dropped;
+        }
+        /* The client is closed once its source reports the hangup */
+        shutdown(fd, SHUT_RDWR);
+        return SensorStream::SendResult::Gone;
+    }
+}
+
+} // namespace sensor
+} // namespace pldm
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "sensors/sensor_stream.hpp"
+
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/io.hpp>
+#include <sdeventplus/utility/timer.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <span>
+
+namespace pldm
+{
+namespace sensor
+{
+
+/** @class SensorStreamServer
+ *
+ *  Serves the SensorStream on a Unix SOCK_SEQPACKET socket. The frames are
+ *  sent without blocking, a frame which does not fit in the socket buffer of
+ *  a slow client is dropped and counted, the next Update frame carries the
+ *  newer readings anyway. The readings coalesced outside of a polling round,
+ *  e.g. from sensor events, are sent after at most maxDelay.
+ */
+class SensorStreamServer
+{
+  public:
+    SensorStreamServer() = delete;
+    SensorStreamServer(const SensorStreamServer&) = delete;
+    SensorStreamServer& operator=(const SensorStreamServer&) = delete;
+
+    /** @brief Longest time a coalesced reading waits for a flush */
+    static constexpr std::chrono::milliseconds maxDelay{1000};
+
+    /** @brief Constructor
+     *
+     *  @param[in] event - PLDM daemon's main event loop
+     *  @param[in] socketPath - path of the Unix socket
+     *  @param[in] stream - stream to serve
+     */
+    SensorStreamServer(sdeventplus::Event& event,
+                       const std::filesystem::path& socketPath,
+                       SensorStream& stream = SensorStream::get());
+
+    ~SensorStreamServer();
+
+  private:
+    /** @brief Bind the listening socket, failures are only logged */
+    void listen();
+
+    /** @brief Accept the pending clients */
+    void acceptClients();
+
+    /** @brief Read the frames of a client, remove it on EOF */
+    void readClient(int fd);
+
+    /** @brief Send a frame of the stream to a client */
+    SensorStream::SendResult sendFrame(int fd, std::span<const uint8_t> frame);
+
+    sdeventplus::Event& event;
+    std::filesystem::path socketPath;
+    SensorStream& stream;
+    int listenFd = -1;
+    std::unique_ptr<sdeventplus::source::IO> listenSource;
+    std::map<int, std::unique_ptr<sdeventplus::source::IO>> clients;
+    /** @brief Flushes the readings coalesced outside of a polling round */
+    sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> flushTimer;
+};
+
+} // namespace sensor
+} // namespace pldm
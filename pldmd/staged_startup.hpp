@@ -0,0 +1,99 @@
+#pragma once
+
+#include <systemd/sd-event.h>
+
+#include <phosphor-logging/lg2.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/event.hpp>
+
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <utility>
+
+namespace pldm
+{
+
+/** @class StagedStartup
+ *
+ *  Constructs the rest of the daemon from the event loop once the transport
+ *  and the Base responder are up. One stage runs per iteration of the loop,
+ *  at idle priority, so the requests received during the startup are
+ *  answered between the stages rather than after all of them. A stage
+ *  which throws stops the loop with a failure, as a throw from main would
+ *  have.
+ */
+class StagedStartup
+{
+  public:
+    using Stage = std::function<void()>;
+
+    StagedStartup() = delete;
+    StagedStartup(const StagedStartup&) = delete;
+    StagedStartup& operator=(const StagedStartup&) = delete;
+
+    /** @brief Queue the stages, the first one runs once the loop starts
+     *
+     *  @param[in] event - event loop
+     *  @param[in] stages - stages, in the order they are run
+     */
+    StagedStartup(sdeventplus::Event& event, std::deque<Stage>&& stages) :
+        stages(std::move(stages))
+    {
+        step = std::make_unique<sdeventplus::source::Defer>(
+            event, [this](sdeventplus::source::EventBase& source) {
+            runStage(source);
+        });
+        step->set_priority(SD_EVENT_PRIORITY_IDLE);
+    }
+
+    /** @brief Hold the stages not run yet, e.g. until the results of the
+     *         startup tasks they use are handed over
+     */
+    void pause()
+    {
+        step->set_enabled(sdeventplus::source::Enabled::Off);
+    }
+
+    /** @brief Run the stages held by pause() */
+    void resume()
+    {
+        if (!stages.empty())
+        {
+            step->set_enabled(sdeventplus::source::Enabled::On);
+        }
+    }
+
+  private:
+    /** @brief Run the next stage, disable the source after the last one */
+    void runStage(sdeventplus::source::EventBase& source)
+    {
+        if (!stages.empty())
+        {
+            auto stage = std::move(stages.front());
+            stages.pop_front();
+            try
+            {
+                stage();
+            }
+            catch (const std::exception& e)
+            {
+                lg2::error("Startup stage failed, error={ERROR}", "ERROR",
+                           e.what());
+                stages.clear();
+                source.get_event().exit(EXIT_FAILURE);
+            }
+        }
+        if (stages.empty())
+        {
+            source.set_enabled(sdeventplus::source::Enabled::Off);
+        }
+    }
+
+    std::deque<Stage> stages;
+    std::unique_ptr<sdeventplus::source::Defer> step;
+};
+
+} // namespace pldm
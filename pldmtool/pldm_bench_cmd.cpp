@@ -0,0 +1,207 @@
+#include "pldm_bench_cmd.hpp"
+
+#include "pldm_cmd_helper.hpp"
+
+#include <libpldm/base.h>
+#include <libpldm/platform.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace pldmtool
+{
+
+namespace bench
+{
+
+namespace
+{
+
+using namespace pldmtool::helper;
+using Clock = std::chrono::steady_clock;
+
+std::vector<std::unique_ptr<CommandInterface>> commands;
+
+/** @brief PLDM type and command of the benchmarked commands */
+const std::map<std::string, std::pair<uint8_t, uint8_t>> benchCommands{
+    {"GetTID", {PLDM_BASE, PLDM_GET_TID}},
+    {"GetSensorReading", {PLDM_PLATFORM, PLDM_GET_SENSOR_READING}},
+    {"GetPDR", {PLDM_PLATFORM, PLDM_GET_PDR}},
+};
+
+/** @brief Nearest-rank percentile of sorted values */
+uint64_t percentile(const std::vector<uint64_t>& sorted, double p)
+{
+    if (sorted.empty())
+    {
+        return 0;
+    }
+    auto rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+    return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+class Bench : public CommandInterface
+{
+  public:
+    ~Bench() = default;
+    Bench() = delete;
+    Bench(const Bench&) = delete;
+    Bench(Bench&&) = default;
+    Bench& operator=(const Bench&) = delete;
+    Bench& operator=(Bench&&) = delete;
+
+    explicit Bench(const char* type, const char* name, CLI::App* app) :
+        CommandInterface(type, name, app)
+    {
+        app->add_option("--command", command, "command sent repeatedly")
+            ->check(CLI::IsMember({"GetTID", "GetSensorReading", "GetPDR"}));
+        app->add_option("-i, --sensor_id", sensorId,
+                        "sensor ID of GetSensorReading");
+        app->add_option("-r, --record_handle", recordHandle,
+                        "record handle of GetPDR");
+        app->add_option("-c, --count", count, "number of requests")
+            ->check(CLI::PositiveNumber);
+        app->add_option("-j, --concurrency", concurrency,
+                        "requests in flight at a time")
+            ->check(CLI::Range(1, maxConcurrency));
+        app->add_option("-t, --timeout", timeoutMs,
+                        "time to wait for a response in milliseconds")
+            ->check(CLI::PositiveNumber);
+    }
+
+    std::pair<int, std::vector<uint8_t>> createRequestMsg() override
+    {
+        std::vector<uint8_t> requestMsg(sizeof(pldm_msg_hdr));
+        auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+        int rc = PLDM_ERROR_INVALID_DATA;
+        if (command == "GetTID")
+        {
+            rc = encode_get_tid_req(instanceId, request);
+        }
+        else if (command == "GetSensorReading")
+        {
+            requestMsg.resize(sizeof(pldm_msg_hdr) +
+                              PLDM_GET_SENSOR_READING_REQ_BYTES);
+            request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+            rc = encode_get_sensor_reading_req(instanceId, sensorId, 0,
+                                               request);
+        }
+        else if (command == "GetPDR")
+        {
+            requestMsg.resize(sizeof(pldm_msg_hdr) + PLDM_GET_PDR_REQ_BYTES);
+            request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+            rc = encode_get_pdr_req(instanceId, recordHandle, 0,
+                                    PLDM_GET_FIRSTPART, UINT16_MAX, 0,
+                                    request, PLDM_GET_PDR_REQ_BYTES);
+        }
+        return {rc, requestMsg};
+    }
+
+    void parseResponseMsg(pldm_msg*, size_t) override {}
+
+    /** @brief Keep concurrency requests in flight until count requests got
+     *         a response or timed out, then print the statistics
+     */
+    void exec() override
+    {
+        auto eid = getMCTPEID();
+        auto [msgType, msgCommand] = benchCommands.at(command);
+        std::vector<uint64_t> rttUs;
+        rttUs.reserve(count);
+        uint64_t errors = 0;
+        uint64_t timeouts = 0;
+
+        auto start = Clock::now();
+        pipelineRequests(
+            eid, msgType, msgCommand, count, concurrency,
+            std::chrono::milliseconds(timeoutMs),
+            [this](size_t, uint8_t id, std::vector<uint8_t>& requestMsg) {
+            instanceId = id;
+            int rc = PLDM_SUCCESS;
+            std::tie(rc, requestMsg) = createRequestMsg();
+            return rc;
+        },
+            [&](size_t, PipelineStatus status, const pldm_msg* response,
+                size_t, Clock::duration rtt) {
+            switch (status)
+            {
+                case PipelineStatus::Responded:
+                    rttUs.emplace_back(
+                        std::chrono::duration_cast<std::chrono::microseconds>(
+                            rtt)
+                            .count());
+                    if (response->payload[0] != PLDM_SUCCESS)
+                    {
+                        errors++;
+                    }
+                    break;
+                case PipelineStatus::SendFailed:
+                    errors++;
+                    break;
+                case PipelineStatus::TimedOut:
+                    timeouts++;
+                    break;
+            }
+        });
+        auto elapsed = std::chrono::duration<double>(Clock::now() - start);
+
+        std::ranges::sort(rttUs);
+        uint64_t sumUs = 0;
+        for (auto rtt : rttUs)
+        {
+            sumUs += rtt;
+        }
+        ordered_json rtt;
+        rtt["min"] = rttUs.empty() ? 0 : rttUs.front();
+        rtt["p50"] = percentile(rttUs, 0.5);
+        rtt["p99"] = percentile(rttUs, 0.99);
+        rtt["max"] = rttUs.empty() ? 0 : rttUs.back();
+        rtt["average"] = rttUs.empty() ? 0 : sumUs / rttUs.size();
+
+        ordered_json data;
+        data["command"] = command;
+        data["eid"] = eid;
+        data["requests"] = count;
+        data["concurrency"] = concurrency;
+        data["responses"] = rttUs.size();
+        data["errors"] = errors;
+        data["timeouts"] = timeouts;
+        data["errorRate"] = double(errors) / count;
+        data["timeoutRate"] = double(timeouts) / count;
+        data["elapsedSeconds"] = elapsed.count();
+        data["messagesPerSecond"] =
+            elapsed.count() > 0 ? rttUs.size() / elapsed.count() : 0.0;
+        data["rttMicroseconds"] = rtt;
+        DisplayInJson(data);
+    }
+
+  private:
+    /** @brief The instance IDs of an EID are shared with pldmd */
+    static constexpr int maxConcurrency = 16;
+
+    std::string command = "GetTID";
+    uint16_t sensorId = 0;
+    uint32_t recordHandle = 0;
+    uint64_t count = 100;
+    uint8_t concurrency = 1;
+    uint32_t timeoutMs = 1000;
+};
+
+} // namespace
+
+void registerCommand(CLI::App& app)
+{
+    commands.clear();
+    auto bench = app.add_subcommand(
+        "bench", "send a command repeatedly and print the round trip times");
+    commands.push_back(std::make_unique<Bench>("bench", "bench", bench));
+}
+
+} // namespace bench
+} // namespace pldmtool
@@ -7,8 +7,14 @@
 #include <libpldm/bios_table.h>
 #include <libpldm/utils.h>
 
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
 #include <map>
 #include <optional>
+#include <span>
 
 namespace pldmtool
 {
@@ -171,7 +177,14 @@ class GetBIOSTableHandler : public CommandInterface
 
     using Table = std::vector<uint8_t>;
 
-    using CommandInterface::CommandInterface;
+    explicit GetBIOSTableHandler(const char* type, const char* name,
+                                 CLI::App* app) :
+        CommandInterface(type, name, app)
+    {
+        app->add_flag("--no-cache", noCache,
+                      "fetch the string and attribute tables from the BMC "
+                      "even if they are cached");
+    }
 
     static inline const std::map<pldm_bios_attribute_type, const char*>
         attrTypeMap = {
@@ -193,30 +206,98 @@ class GetBIOSTableHandler : public CommandInterface
 
     void parseResponseMsg(pldm_msg*, size_t) override {}
 
+    /** @brief Get a BIOS table of the endpoint
+     *
+     *  The string and attribute tables only change with the BIOS
+     *  configuration, they are kept in the cache directory of pldmtool.
+     *  A cached table is used if its checksum is still the last 4 bytes of
+     *  the table of the endpoint, which costs one GetBIOSTable of 4 bytes
+     *  instead of the whole transfer.
+     *
+     *  @param[in] tableType - type of the table
+     *
+     *  @return - the table, nullopt on failure
+     */
     std::optional<Table> getBIOSTable(pldm_bios_table_types tableType)
+    {
+        if (noCache || tableType == PLDM_BIOS_ATTR_VAL_TABLE)
+        {
+            return fetchBIOSTable(tableType);
+        }
+
+        auto path = cachePath(tableType);
+        auto table = loadCachedTable(path);
+        if (table && isCachedTableCurrent(tableType, *table))
+        {
+            return table;
+        }
+        table = fetchBIOSTable(tableType);
+        if (table)
+        {
+            saveCachedTable(path, *table);
+        }
+        return table;
+    }
+
+    /** @brief Transfer a BIOS table from the endpoint */
+    std::optional<Table> fetchBIOSTable(pldm_bios_table_types tableType)
+    {
+        Table table;
+        uint32_t transferHandle = 0;
+        uint8_t transferOpFlag = PLDM_GET_FIRSTPART;
+        uint8_t transferFlag = 0;
+        do
+        {
+            if (!getBIOSTablePart(tableType, transferHandle, transferOpFlag,
+                                  table, transferHandle, transferFlag, true))
+            {
+                return std::nullopt;
+            }
+            transferOpFlag = PLDM_GET_NEXTPART;
+        } while ((transferFlag == PLDM_START || transferFlag == PLDM_MIDDLE) &&
+                 transferHandle);
+
+        return table;
+    }
+
+    /** @brief Send one GetBIOSTable and append the part to the table
+     *
+     *  @param[in] tableType - type of the table
+     *  @param[in] transferHandle - handle of the part
+     *  @param[in] transferOpFlag - first or next part
+     *  @param[in,out] table - the part is appended to it
+     *  @param[out] nextTransferHandle - handle of the next part
+     *  @param[out] transferFlag - position of the part in the table
+     *  @param[in] reportErrors - print the failures
+     *
+     *  @return - true on success
+     */
+    bool getBIOSTablePart(pldm_bios_table_types tableType,
+                          uint32_t transferHandle, uint8_t transferOpFlag,
+                          Table& table, uint32_t& nextTransferHandle,
+                          uint8_t& transferFlag, bool reportErrors)
     {
         std::vector<uint8_t> requestMsg(sizeof(pldm_msg_hdr) +
                                         PLDM_GET_BIOS_TABLE_REQ_BYTES);
         auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
 
-        auto rc = encode_get_bios_table_req(instanceId, 0, PLDM_GET_FIRSTPART,
-                                            tableType, request);
+        auto rc = encode_get_bios_table_req(instanceId, transferHandle,
+                                            transferOpFlag, tableType, request);
         if (rc != PLDM_SUCCESS)
         {
-            std::cerr << "Encode GetBIOSTable Error, tableType=," << tableType
-                      << " ,rc=" << rc << std::endl;
-            return std::nullopt;
+            std::cerr << "Encode GetBIOSTable Error, tableType=,"
+                      << tableType << " ,rc=" << rc << std::endl;
+            return false;
         }
         std::vector<uint8_t> responseMsg;
         rc = pldmSendRecv(requestMsg, responseMsg);
         if (rc != PLDM_SUCCESS)
         {
             std::cerr << "PLDM: Communication Error, rc =" << rc << std::endl;
-            return std::nullopt;
+            return false;
         }
 
-        uint8_t cc = 0, transferFlag = 0;
-        uint32_t nextTransferHandle = 0;
+        uint8_t cc = 0;
         size_t bios_table_offset;
         auto responsePtr =
             reinterpret_cast<struct pldm_msg*>(responseMsg.data());
@@ -228,15 +309,20 @@ class GetBIOSTableHandler : public CommandInterface
 
         if (rc != PLDM_SUCCESS || cc != PLDM_SUCCESS)
         {
-            std::cerr << "GetBIOSTable Response Error: tableType=" << tableType
-                      << ", rc=" << rc << ", cc=" << (int)cc << std::endl;
-            return std::nullopt;
+            if (reportErrors)
+            {
+                std::cerr << "GetBIOSTable Response Error: tableType="
+                          << tableType << ", rc=" << rc
+                          << ", cc=" << (int)cc << std::endl;
+            }
+            return false;
         }
-        auto tableData =
-            reinterpret_cast<char*>((responsePtr->payload) + bios_table_offset);
+        auto tableData = reinterpret_cast<char*>((responsePtr->payload) +
+                                                 bios_table_offset);
         auto tableSize = payloadLength - sizeof(nextTransferHandle) -
                          sizeof(transferFlag) - sizeof(cc);
-        return std::make_optional<Table>(tableData, tableData + tableSize);
+        table.insert(table.end(), tableData, tableData + tableSize);
+        return true;
     }
 
     const pldm_bios_attr_table_entry*
@@ -448,6 +534,103 @@ class GetBIOSTableHandler : public CommandInterface
             }
         }
     }
+
+  private:
+    /** @brief Cache file of a table of the endpoint, in $XDG_CACHE_HOME or
+     *         ~/.cache, in /tmp without a home directory
+     */
+    std::filesystem::path cachePath(pldm_bios_table_types tableType)
+    {
+        std::filesystem::path dir;
+        if (auto cacheHome = std::getenv("XDG_CACHE_HOME");
+            cacheHome && *cacheHome)
+        {
+            dir = cacheHome;
+        }
+        else if (auto home = std::getenv("HOME"); home && *home)
+        {
+            dir = std::filesystem::path(home) / ".cache";
+        }
+        else
+        {
+            dir = std::filesystem::temp_directory_path();
+        }
+        return dir / "pldmtool" /
+               ("bios_eid" + std::to_string(getMCTPEID()) + "_type" +
+                std::to_string(tableType));
+    }
+
+    /** @brief Read a cached table, nullopt if it is missing or corrupted */
+    static std::optional<Table>
+        loadCachedTable(const std::filesystem::path& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            return std::nullopt;
+        }
+        Table table{std::istreambuf_iterator<char>(file),
+                    std::istreambuf_iterator<char>()};
+        if (table.size() <= sizeof(uint32_t) ||
+            !pldm_bios_table_checksum(table.data(), table.size()))
+        {
+            return std::nullopt;
+        }
+        return table;
+    }
+
+    /** @brief Write a table to the cache, the failures are not reported
+     *         since the table is fetched again on the next run
+     */
+    static void saveCachedTable(const std::filesystem::path& path,
+                                const Table& table)
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(path.parent_path(), ec);
+        auto tmpPath = path;
+        tmpPath += ".tmp";
+        {
+            std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(table.data()),
+                       table.size());
+            if (!file)
+            {
+                file.close();
+                std::filesystem::remove(tmpPath, ec);
+                return;
+            }
+        }
+        std::filesystem::rename(tmpPath, path, ec);
+        if (ec)
+        {
+            std::filesystem::remove(tmpPath, ec);
+        }
+    }
+
+    /** @brief Check a cached table against the endpoint by its checksum,
+     *         read as the last part of the table. A responder which does not
+     *         take the offset in the table as the transfer handle fails the
+     *         check and the table is fetched.
+     */
+    bool isCachedTableCurrent(pldm_bios_table_types tableType,
+                              const Table& table)
+    {
+        Table tail;
+        uint32_t nextTransferHandle = 0;
+        uint8_t transferFlag = 0;
+        if (!getBIOSTablePart(
+                tableType,
+                static_cast<uint32_t>(table.size() - sizeof(uint32_t)),
+                PLDM_GET_NEXTPART, tail, nextTransferHandle, transferFlag,
+                false))
+        {
+            return false;
+        }
+        return transferFlag == PLDM_END && tail.size() == sizeof(uint32_t) &&
+               std::ranges::equal(tail, std::span(table).last(tail.size()));
+    }
+
+    bool noCache = false;
 };
 
 class GetBIOSTable : public GetBIOSTableHandler
@@ -964,6 +1147,7 @@ class SetBIOSAttributeCurrentValue : public GetBIOSTableHandler
 
 void registerCommand(CLI::App& app)
 {
+    commands.clear();
     auto bios = app.add_subcommand("bios", "bios type command");
     bios->require_subcommand(1);
     auto getDateTime = bios->add_subcommand("GetDateTime", "get date time");
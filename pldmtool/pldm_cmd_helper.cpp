@@ -12,7 +12,11 @@
 #include <sdbusplus/server.hpp>
 #include <xyz/openbmc_project/Logging/Entry/server.hpp>
 
+#include <algorithm>
+#include <cstdlib>
 #include <exception>
+#include <map>
+#include <memory>
 
 using namespace pldm::utils;
 
@@ -21,6 +25,146 @@ namespace pldmtool
 namespace helper
 {
 
+namespace
+{
+bool jsonLinesOutput = false;
+} // namespace
+
+void setJsonLines(bool enable)
+{
+    jsonLinesOutput = enable;
+}
+
+bool jsonLines()
+{
+    return jsonLinesOutput;
+}
+
+PldmTransport& getTransport()
+{
+    static PldmTransport pldmTransport{};
+    return pldmTransport;
+}
+
+pldm::InstanceIdDb& getInstanceIdDb()
+{
+    static pldm::InstanceIdDb instanceIdDb;
+    return instanceIdDb;
+}
+
+void pipelineRequests(uint8_t eid, uint8_t type, uint8_t command, size_t count,
+                      size_t window, std::chrono::milliseconds timeout,
+                      const PipelineEncoder& encode,
+                      const PipelineHandler& handler)
+{
+    using Clock = std::chrono::steady_clock;
+    auto& pldmTransport = getTransport();
+    auto& instanceIdDb = getInstanceIdDb();
+    /* Index and send time of the request of each instance ID in flight */
+    std::map<uint8_t, std::pair<size_t, Clock::time_point>> inFlight;
+    size_t next = 0;
+
+    /* @return - false if no request can be sent now */
+    auto send = [&]() {
+        uint8_t instanceId = 0;
+        try
+        {
+            instanceId = instanceIdDb.next(eid);
+        }
+        catch (const std::exception&)
+        {
+            /* All the instance IDs are taken, wait for a response */
+            if (!inFlight.empty())
+            {
+                return false;
+            }
+            handler(next++, PipelineStatus::SendFailed, nullptr, 0, {});
+            return true;
+        }
+        auto index = next++;
+        std::vector<uint8_t> requestMsg;
+        auto rc = encode(index, instanceId, requestMsg);
+        if (rc == PLDM_SUCCESS)
+        {
+            rc = pldmTransport.sendMsg(eid, requestMsg.data(),
+                                       requestMsg.size());
+        }
+        if (rc != PLDM_SUCCESS)
+        {
+            instanceIdDb.free(eid, instanceId);
+            handler(index, PipelineStatus::SendFailed, nullptr, 0, {});
+            return true;
+        }
+        inFlight.emplace(instanceId, std::make_pair(index, Clock::now()));
+        return true;
+    };
+
+    while (next < count || !inFlight.empty())
+    {
+        while (next < count && inFlight.size() < window && send())
+        {}
+        if (inFlight.empty())
+        {
+            continue;
+        }
+
+        auto now = Clock::now();
+        std::erase_if(inFlight, [&](const auto& entry) {
+            auto& [index, sent] = entry.second;
+            if (now - sent < timeout)
+            {
+                return false;
+            }
+            instanceIdDb.free(eid, entry.first);
+            handler(index, PipelineStatus::TimedOut, nullptr, 0, now - sent);
+            return true;
+        });
+        if (inFlight.empty())
+        {
+            continue;
+        }
+        auto oldest = std::ranges::min_element(
+            inFlight, {}, [](const auto& entry) { return entry.second.second; });
+        auto wait = std::chrono::ceil<std::chrono::milliseconds>(
+            oldest->second.second + timeout - now);
+
+        pollfd pollSet{pldmTransport.getEventSource(), POLLIN, 0};
+        if (poll(&pollSet, 1, static_cast<int>(wait.count())) <= 0)
+        {
+            continue;
+        }
+
+        pldm_tid_t tid{};
+        void* responseMsg = nullptr;
+        size_t responseMsgSize{};
+        if (pldmTransport.recvMsg(tid, responseMsg, responseMsgSize) !=
+            PLDM_REQUESTER_SUCCESS)
+        {
+            continue;
+        }
+        auto received = Clock::now();
+        std::unique_ptr<void, decltype(&free)> responseMsgPtr(responseMsg,
+                                                              free);
+        auto responsePtr = static_cast<const pldm_msg*>(responseMsg);
+        if (tid != eid || responseMsgSize < sizeof(pldm_msg_hdr) + 1 ||
+            responsePtr->hdr.request || responsePtr->hdr.type != type ||
+            responsePtr->hdr.command != command)
+        {
+            continue;
+        }
+        auto entry = inFlight.find(responsePtr->hdr.instance_id);
+        if (entry == inFlight.end())
+        {
+            continue;
+        }
+        auto [index, sent] = entry->second;
+        instanceIdDb.free(eid, entry->first);
+        inFlight.erase(entry);
+        handler(index, PipelineStatus::Responded, responsePtr,
+                responseMsgSize - sizeof(pldm_msg_hdr), received - sent);
+    }
+}
+
 void CommandInterface::exec()
 {
     instanceId = instanceIdDb.next(mctp_eid);
@@ -64,7 +208,7 @@ int CommandInterface::pldmSendRecv(std::vector<uint8_t>& requestMsg,
     }
 
     auto tid = mctp_eid;
-    PldmTransport pldmTransport{};
+    auto& pldmTransport = getTransport();
     uint8_t retry = 0;
     int rc = PLDM_ERROR;
 
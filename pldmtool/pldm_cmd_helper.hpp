@@ -15,10 +15,15 @@
 #include <CLI/CLI.hpp>
 #include <nlohmann/json.hpp>
 
+#include <chrono>
 #include <cstring>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <utility>
+#include <vector>
+
+class PldmTransport;
 
 namespace pldmtool
 {
@@ -49,6 +54,18 @@ void Logger(bool pldmverbose, const char* msg, const T& data)
     }
 }
 
+/** @brief Print the JSON output as JSON lines, one value per line
+ *
+ *  @param[in]  enable - true in batch mode
+ */
+void setJsonLines(bool enable);
+
+/** @brief Is the JSON output printed as JSON lines
+ *
+ *  @return true in batch mode
+ */
+bool jsonLines();
+
 /** @brief Display in JSON format.
  *
  *  @param[in]  data - data to print in json
@@ -57,9 +74,27 @@ void Logger(bool pldmverbose, const char* msg, const T& data)
  */
 static inline void DisplayInJson(const ordered_json& data)
 {
+    if (jsonLines())
+    {
+        std::cout << data.dump() << '\n';
+        return;
+    }
     std::cout << data.dump(4) << std::endl;
 }
 
+/** @brief Transport shared by the commands, the commands of a batch use the
+ *         same connection
+ *
+ *  @return the transport of the process
+ */
+PldmTransport& getTransport();
+
+/** @brief Instance ID database shared by the commands
+ *
+ *  @return the instance ID database of the process
+ */
+pldm::InstanceIdDb& getInstanceIdDb();
+
 /** @brief MCTP socket read/recieve
  *
  *  @param[in]  requestMsg - Request message to compare against loopback
@@ -73,6 +108,46 @@ static inline void DisplayInJson(const ordered_json& data)
 int mctpSockSendRecv(const std::vector<uint8_t>& requestMsg,
                      std::vector<uint8_t>& responseMsg, bool pldmVerbose);
 
+/** @brief Outcome of a request sent by pipelineRequests() */
+enum class PipelineStatus
+{
+    Responded,  //!< The response is handed to the handler
+    SendFailed, //!< The request was not encoded or not sent
+    TimedOut,   //!< No response within the timeout
+};
+
+/** @brief Encode the request of an index with an instance ID */
+using PipelineEncoder = std::function<int(
+    size_t index, uint8_t instanceId, std::vector<uint8_t>& requestMsg)>;
+
+/** @brief Handle the outcome of the request of an index, the response is
+ *         only valid during the call and nullptr unless it responded
+ */
+using PipelineHandler = std::function<void(
+    size_t index, PipelineStatus status, const pldm_msg* response,
+    size_t payloadLength, std::chrono::steady_clock::duration rtt)>;
+
+/** @brief Send count requests to an EID with up to window of them in flight
+ *
+ *  The responses are matched to the requests by instance ID on the shared
+ *  transport. A request which timed out gives back its instance ID, the IDs
+ *  are allocated round robin so a late response is not taken for the
+ *  response of a newer request unless all the IDs were used since.
+ *
+ *  @param[in] eid - MCTP endpoint ID
+ *  @param[in] type - PLDM type of the requests
+ *  @param[in] command - PLDM command of the requests
+ *  @param[in] count - number of requests, indexed from 0
+ *  @param[in] window - requests in flight at a time
+ *  @param[in] timeout - time to wait for a response
+ *  @param[in] encode - encodes the request of an index
+ *  @param[in] handler - called once per index
+ */
+void pipelineRequests(uint8_t eid, uint8_t type, uint8_t command, size_t count,
+                      size_t window, std::chrono::milliseconds timeout,
+                      const PipelineEncoder& encode,
+                      const PipelineHandler& handler);
+
 class CommandInterface
 {
   public:
@@ -80,7 +155,7 @@ class CommandInterface
                               CLI::App* app) :
         pldmType(type),
         commandName(name), mctp_eid(PLDM_ENTITY_ID), pldmVerbose(false),
-        instanceId(0)
+        instanceId(0), instanceIdDb(getInstanceIdDb())
     {
         app->add_option("-m,--mctp_eid", mctp_eid, "MCTP endpoint ID");
         app->add_flag("-v, --verbose", pldmVerbose);
@@ -139,7 +214,7 @@ class CommandInterface
 
   protected:
     uint8_t instanceId;
-    pldm::InstanceIdDb instanceIdDb;
+    pldm::InstanceIdDb& instanceIdDb;
     uint8_t numRetries = 0;
 };
 
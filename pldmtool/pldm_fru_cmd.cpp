@@ -411,6 +411,21 @@ class GetFruRecordTable : public CommandInterface
     GetFruRecordTable& operator=(GetFruRecordTable&&) = delete;
 
     using CommandInterface::CommandInterface;
+
+    void exec() override
+    {
+        // Ask for the next parts until the last one arrives
+        fruRecordTable.clear();
+        transferHandle = 0;
+        transferOpFlag = PLDM_GET_FIRSTPART;
+        do
+        {
+            morePart = false;
+            CommandInterface::exec();
+            transferOpFlag = PLDM_GET_NEXTPART;
+        } while (morePart);
+    }
+
     std::pair<int, std::vector<uint8_t>> createRequestMsg() override
     {
         std::vector<uint8_t> requestMsg(sizeof(pldm_msg_hdr) +
@@ -418,7 +433,7 @@ class GetFruRecordTable : public CommandInterface
         auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
 
         auto rc = encode_get_fru_record_table_req(
-            instanceId, 0, PLDM_GET_FIRSTPART, request,
+            instanceId, transferHandle, transferOpFlag, request,
             requestMsg.size() - sizeof(pldm_msg_hdr));
         return {rc, requestMsg};
     }
@@ -442,14 +457,31 @@ class GetFruRecordTable : public CommandInterface
             return;
         }
 
-        FRUTablePrint tablePrint(fru_record_table_data.data(),
-                                 fru_record_table_length);
+        fruRecordTable.insert(fruRecordTable.end(),
+                              fru_record_table_data.begin(),
+                              fru_record_table_data.begin() +
+                                  fru_record_table_length);
+        if (transfer_flag == PLDM_START || transfer_flag == PLDM_MIDDLE)
+        {
+            transferHandle = next_data_transfer_handle;
+            morePart = true;
+            return;
+        }
+
+        FRUTablePrint tablePrint(fruRecordTable.data(), fruRecordTable.size());
         tablePrint.print();
     }
+
+  private:
+    uint32_t transferHandle = 0;
+    uint8_t transferOpFlag = PLDM_GET_FIRSTPART;
+    bool morePart = false;
+    std::vector<uint8_t> fruRecordTable;
 };
 
 void registerCommand(CLI::App& app)
 {
+    commands.clear();
     auto fru = app.add_subcommand("fru", "FRU type command");
     fru->require_subcommand(1);
     auto getFruRecordTableMetadata = fru->add_subcommand(
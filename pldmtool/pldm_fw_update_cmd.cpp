@@ -613,6 +613,7 @@ void QueryDeviceIdentifiers::parseResponseMsg(pldm_msg* responsePtr,
 
 void registerCommand(CLI::App& app)
 {
+    commands.clear();
     auto fwUpdate = app.add_subcommand("fw_update",
                                        "firmware update type commands");
     fwUpdate->require_subcommand(1);
@@ -1,14 +1,25 @@
+#include "common/transport.hpp"
 #include "common/types.hpp"
 #include "pldm_cmd_helper.hpp"
 
 #include <libpldm/entity.h>
 #include <libpldm/platform.h>
 #include <libpldm/state_set.h>
+#include <poll.h>
 
 #include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
 #include <cstddef>
+#include <cstring>
+#include <fstream>
 #include <map>
+#include <memory>
+#include <optional>
 #include <ranges>
+#include <thread>
+#include <unordered_set>
 
 #ifdef OEM_IBM
 #include "oem/ibm/oem_ibm_state_set.hpp"
@@ -95,6 +106,14 @@ class GetPDR : public CommandInterface
         pdrOptionGroup->add_flag("-a, --all", allPDRs,
                                  "retrieve all PDRs from a PDR repository");
 
+        pdrOptionGroup->add_option(
+            "--dump", dumpFile,
+            "write the raw records of the whole PDR repository to a file,\n"
+            "several records are requested at a time");
+        pdrOptionGroup->add_option("--decode", decodeFile,
+                                   "print the records of a file written by "
+                                   "--dump");
+
         pdrOptionGroup->require_option(1);
     }
 
@@ -110,8 +129,11 @@ class GetPDR : public CommandInterface
 
     void getPDRs()
     {
-        // start the array
-        std::cout << "[";
+        // start the array, the JSON lines have a record per line instead
+        if (!jsonLines())
+        {
+            std::cout << "[";
+        }
 
         recordHandle = 0;
         do
@@ -120,7 +142,10 @@ class GetPDR : public CommandInterface
         } while (recordHandle != 0);
 
         // close the array
-        std::cout << "]\n";
+        if (!jsonLines())
+        {
+            std::cout << "]\n";
+        }
 
         if (handleFound)
         {
@@ -140,7 +165,15 @@ class GetPDR : public CommandInterface
 
     void exec() override
     {
-        if (allPDRs || !pdrRecType.empty())
+        if (!dumpFile.empty())
+        {
+            dumpPDRs();
+        }
+        else if (!decodeFile.empty())
+        {
+            decodePDRs();
+        }
+        else if (allPDRs || !pdrRecType.empty())
         {
             if (!pdrRecType.empty())
             {
@@ -148,8 +181,11 @@ class GetPDR : public CommandInterface
                                pdrRecType.begin(), tolower);
             }
 
-            // start the array
-            std::cout << "[\n";
+            // start the array, the JSON lines have a record per line instead
+            if (!jsonLines())
+            {
+                std::cout << "[\n";
+            }
 
             // Retrieve all PDR records starting from the first
             recordHandle = 0;
@@ -179,7 +215,7 @@ class GetPDR : public CommandInterface
                 }
                 prevRecordHandle = recordHandle;
 
-                if (recordHandle != 0)
+                if (recordHandle != 0 && !jsonLines())
                 {
                     // close the array
                     std::cout << ",";
@@ -187,7 +223,10 @@ class GetPDR : public CommandInterface
             } while (recordHandle != 0);
 
             // close the array
-            std::cout << "]\n";
+            if (!jsonLines())
+            {
+                std::cout << "]\n";
+            }
         }
         else
         {
@@ -195,6 +234,251 @@ class GetPDR : public CommandInterface
         }
     }
 
+    /** @brief Write the raw records of the whole repository to dumpFile
+     *
+     *  The record handles usually follow each other, so the records after the
+     *  next one are requested ahead and several requests are in flight. The
+     *  records are written in the order of the next record handles, a guess
+     *  which misses is dropped and the record is requested with the handle
+     *  from the previous record.
+     */
+    void dumpPDRs()
+    {
+        std::ofstream file(dumpFile, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            std::cerr << "Failed to open " << dumpFile << "\n";
+            return;
+        }
+
+        auto eid = getMCTPEID();
+        auto& pldmTransport = getTransport();
+        /* Record handle requested by each instance ID */
+        std::map<uint8_t, uint32_t> inFlight;
+        /* Next record handle and data of the records received ahead */
+        std::map<uint32_t, std::pair<uint32_t, std::vector<uint8_t>>>
+            received;
+        std::unordered_set<uint32_t> written;
+        uint32_t want = 0;
+        uint32_t ahead = 0;
+        bool done = false;
+
+        auto send = [&](uint32_t handle) {
+            auto id = instanceIdDb.next(eid);
+            std::vector<uint8_t> requestMsg(sizeof(pldm_msg_hdr) +
+                                            PLDM_GET_PDR_REQ_BYTES);
+            auto rc = encode_get_pdr_req(
+                id, handle, 0, PLDM_GET_FIRSTPART, UINT16_MAX, 0,
+                reinterpret_cast<pldm_msg*>(requestMsg.data()),
+                PLDM_GET_PDR_REQ_BYTES);
+            if (rc == PLDM_SUCCESS)
+            {
+                rc = pldmTransport.sendMsg(eid, requestMsg.data(),
+                                           requestMsg.size());
+            }
+            if (rc != PLDM_SUCCESS)
+            {
+                instanceIdDb.free(eid, id);
+                return false;
+            }
+            inFlight.emplace(id, handle);
+            return true;
+        };
+
+        auto refill = [&]() {
+            auto pending = received.contains(want) ||
+                           std::ranges::any_of(inFlight, [want](auto& entry) {
+                return entry.second == want;
+            });
+            if (!pending && !send(want))
+            {
+                std::cerr << "Failed to send the GetPDR request for record "
+                          << want << "\n";
+                return false;
+            }
+            /* The handle of the first record is only known from its
+             * response */
+            if (!want)
+            {
+                return true;
+            }
+            for (auto handle = std::max(want, ahead) + 1;
+                 inFlight.size() < dumpWindow && handle - want < dumpWindow;
+                 handle++)
+            {
+                if (!send(handle))
+                {
+                    break;
+                }
+                ahead = handle;
+            }
+            return true;
+        };
+
+        bool failed = !refill();
+        while (!inFlight.empty())
+        {
+            pollfd pollSet{pldmTransport.getEventSource(), POLLIN, 0};
+            if (poll(&pollSet, 1, dumpTimeoutMs) <= 0)
+            {
+                std::cerr << "Timed out waiting for the GetPDR responses\n";
+                failed = true;
+                break;
+            }
+
+            pldm_tid_t tid{};
+            void* responseMsg = nullptr;
+            size_t responseMsgSize{};
+            if (pldmTransport.recvMsg(tid, responseMsg, responseMsgSize) !=
+                PLDM_REQUESTER_SUCCESS)
+            {
+                continue;
+            }
+            std::unique_ptr<void, decltype(&free)> responseMsgPtr(responseMsg,
+                                                                  free);
+            auto responsePtr = static_cast<pldm_msg*>(responseMsg);
+            if (tid != eid || responseMsgSize < sizeof(pldm_msg_hdr) ||
+                responsePtr->hdr.request ||
+                responsePtr->hdr.type != PLDM_PLATFORM ||
+                responsePtr->hdr.command != PLDM_GET_PDR)
+            {
+                continue;
+            }
+            auto entry = inFlight.find(responsePtr->hdr.instance_id);
+            if (entry == inFlight.end())
+            {
+                continue;
+            }
+            auto handle = entry->second;
+            instanceIdDb.free(eid, entry->first);
+            inFlight.erase(entry);
+            if (done || failed)
+            {
+                continue;
+            }
+
+            uint8_t completionCode = 0;
+            uint32_t nextRecordHndl = 0;
+            uint32_t nextDataTransferHndl = 0;
+            uint8_t transferFlag = 0;
+            uint16_t respCnt = 0;
+            uint8_t transferCRC = 0;
+            std::vector<uint8_t> recordData(UINT16_MAX);
+            auto rc = decode_get_pdr_resp(
+                responsePtr, responseMsgSize - sizeof(pldm_msg_hdr),
+                &completionCode, &nextRecordHndl, &nextDataTransferHndl,
+                &transferFlag, &respCnt, recordData.data(), recordData.size(),
+                &transferCRC);
+            auto complete = transferFlag == PLDM_START_AND_END ||
+                            transferFlag == PLDM_END;
+            if (rc != PLDM_SUCCESS || completionCode != PLDM_SUCCESS ||
+                !complete)
+            {
+                /* A guess past the end of the repository, or at a gap */
+                if (handle == want)
+                {
+                    std::cerr << "GetPDR of record " << handle
+                              << " failed: rc=" << rc
+                              << ",cc=" << (int)completionCode
+                              << (complete ? "" : ", multipart record")
+                              << "\n";
+                    failed = true;
+                }
+                continue;
+            }
+            recordData.resize(respCnt);
+            received.emplace(handle, std::make_pair(nextRecordHndl,
+                                                    std::move(recordData)));
+
+            while (auto node = received.extract(want))
+            {
+                if (!written.insert(want).second)
+                {
+                    std::cerr << "Record handle " << want
+                              << " has multiple references\n";
+                    failed = true;
+                    break;
+                }
+                auto& [next, data] = node.mapped();
+                DumpRecord header{next, static_cast<uint16_t>(data.size())};
+                file.write(reinterpret_cast<const char*>(&header),
+                           sizeof(header));
+                file.write(reinterpret_cast<const char*>(data.data()),
+                           data.size());
+                want = next;
+                if (!want)
+                {
+                    done = true;
+                    break;
+                }
+            }
+            if (!done && !failed)
+            {
+                failed = !refill();
+            }
+        }
+
+        for (const auto& [id, handle] : inFlight)
+        {
+            instanceIdDb.free(eid, id);
+        }
+        if (!file.flush())
+        {
+            std::cerr << "Failed to write " << dumpFile << "\n";
+            failed = true;
+        }
+        ordered_json output;
+        output["file"] = dumpFile;
+        output["records"] = written.size();
+        output["complete"] = done && !failed;
+        DisplayInJson(output);
+    }
+
+    /** @brief Print the records of a file written by dumpPDRs */
+    void decodePDRs()
+    {
+        std::ifstream file(decodeFile, std::ios::binary);
+        if (!file)
+        {
+            std::cerr << "Failed to open " << decodeFile << "\n";
+            return;
+        }
+
+        if (!jsonLines())
+        {
+            std::cout << "[\n";
+        }
+        std::vector<uint8_t> recordData(UINT16_MAX);
+        DumpRecord header{};
+        bool first = true;
+        while (file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+        {
+            std::fill(recordData.begin(), recordData.end(), 0);
+            if (!file.read(reinterpret_cast<char*>(recordData.data()),
+                           header.size))
+            {
+                std::cerr << "Truncated record in " << decodeFile << "\n";
+                break;
+            }
+            if (header.size < sizeof(pldm_pdr_hdr))
+            {
+                continue;
+            }
+            if (!first && !jsonLines())
+            {
+                std::cout << ",";
+            }
+            first = false;
+            uint32_t nextRecordHndl = header.nextRecordHandle;
+            printPDRMsg(nextRecordHndl, header.size, recordData.data(),
+                        std::nullopt);
+        }
+        if (!jsonLines())
+        {
+            std::cout << "]\n";
+        }
+    }
+
     std::pair<int, std::vector<uint8_t>> createRequestMsg() override
     {
         std::vector<uint8_t> requestMsg(sizeof(pldm_msg_hdr) +
@@ -1368,9 +1652,26 @@ class GetPDR : public CommandInterface
     }
 
   private:
+    /** @struct DumpRecord
+     *  @brief Header of a record in the file written by --dump, followed by
+     *         the record data
+     */
+    struct DumpRecord
+    {
+        uint32_t nextRecordHandle;
+        uint16_t size;
+    } __attribute__((packed));
+
+    /** @brief GetPDR requests in flight while dumping the repository */
+    static constexpr size_t dumpWindow = 8;
+    /** @brief Time to wait for the next GetPDR response while dumping */
+    static constexpr int dumpTimeoutMs = 5000;
+
     bool optTIDSet = false;
     uint32_t recordHandle;
     bool allPDRs;
+    std::string dumpFile;
+    std::string decodeFile;
     std::string pdrRecType;
     std::optional<uint8_t> pdrTerminus;
     std::optional<uint16_t> terminusHandle;
@@ -1803,8 +2104,284 @@ class GetNumericEffecterValue : public CommandInterface
     }
 };
 
+/** @class Watch
+ *
+ *  Follows the numeric sensors of a terminus within one process: the
+ *  sensors are resolved from the compact numeric sensor PDRs once, then read
+ *  every interval on the same transport with several GetSensorReading in
+ *  flight. A compact JSON line is printed per round with the sensors whose
+ *  value changed only, null when a sensor is not readable.
+ */
+class Watch : public CommandInterface
+{
+  public:
+    ~Watch() = default;
+    Watch() = delete;
+    Watch(const Watch&) = delete;
+    Watch(Watch&&) = default;
+    Watch& operator=(const Watch&) = delete;
+    Watch& operator=(Watch&&) = delete;
+
+    explicit Watch(const char* type, const char* name, CLI::App* app) :
+        CommandInterface(type, name, app)
+    {
+        app->add_option("-i, --sensor_id", sensorIds,
+                        "sensors to watch, all the numeric sensors of the "
+                        "PDRs by default");
+        app->add_option("--interval", intervalMs,
+                        "time between two readings of a sensor in "
+                        "milliseconds")
+            ->check(CLI::PositiveNumber);
+        app->add_option("-j, --window", window,
+                        "GetSensorReading requests in flight at a time")
+            ->check(CLI::Range(1, 16));
+        app->add_option("-c, --count", rounds,
+                        "number of readings of each sensor, 0 for no end");
+        app->add_option("-t, --timeout", timeoutMs,
+                        "time to wait for a response in milliseconds")
+            ->check(CLI::PositiveNumber);
+    }
+
+    /** @brief GetPDR of recordHandle, the PDRs are walked once */
+    std::pair<int, std::vector<uint8_t>> createRequestMsg() override
+    {
+        std::vector<uint8_t> requestMsg(sizeof(pldm_msg_hdr) +
+                                        PLDM_GET_PDR_REQ_BYTES);
+        auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+        auto rc = encode_get_pdr_req(instanceId, recordHandle, 0,
+                                     PLDM_GET_FIRSTPART, UINT16_MAX, 0, request,
+                                     PLDM_GET_PDR_REQ_BYTES);
+        return {rc, requestMsg};
+    }
+
+    void parseResponseMsg(pldm_msg* responsePtr, size_t payloadLength) override
+    {
+        uint8_t completionCode = 0;
+        uint32_t nextRecordHndl = 0;
+        uint32_t nextDataTransferHndl = 0;
+        uint8_t transferFlag = 0;
+        uint16_t respCnt = 0;
+        uint8_t transferCRC = 0;
+        std::vector<uint8_t> recordData(UINT16_MAX);
+        auto rc = decode_get_pdr_resp(
+            responsePtr, payloadLength, &completionCode, &nextRecordHndl,
+            &nextDataTransferHndl, &transferFlag, &respCnt, recordData.data(),
+            recordData.size(), &transferCRC);
+        if (rc != PLDM_SUCCESS || completionCode != PLDM_SUCCESS)
+        {
+            std::cerr << "Response Message Error: "
+                      << "rc=" << rc << ",cc=" << (int)completionCode
+                      << std::endl;
+            return;
+        }
+        recordHandle = nextRecordHndl;
+
+        if (respCnt < sizeof(pldm_compact_numeric_sensor_pdr) ||
+            reinterpret_cast<pldm_pdr_hdr*>(recordData.data())->type !=
+                PLDM_COMPACT_NUMERIC_SENSOR_PDR)
+        {
+            return;
+        }
+        auto pdr = reinterpret_cast<pldm_compact_numeric_sensor_pdr*>(
+            recordData.data());
+        std::string name;
+        if (pdr->sensor_name_length &&
+            respCnt >= sizeof(pldm_compact_numeric_sensor_pdr) - 1 +
+                           pdr->sensor_name_length)
+        {
+            name.assign(reinterpret_cast<const char*>(pdr->sensor_name),
+                        pdr->sensor_name_length);
+        }
+        addSensor(pdr->sensor_id, std::move(name), pdr->unit_modifier);
+    }
+
+    void exec() override
+    {
+        /* Resolve the sensors from the PDRs */
+        recordHandle = 0;
+        std::unordered_set<uint32_t> recordsSeen;
+        uint32_t prevRecordHandle = 0;
+        do
+        {
+            prevRecordHandle = recordHandle;
+            CommandInterface::exec();
+        } while (recordHandle != 0 && recordHandle != prevRecordHandle &&
+                 recordsSeen.emplace(recordHandle).second);
+
+        if (!sensorIds.empty())
+        {
+            std::unordered_set<uint16_t> wanted(sensorIds.begin(),
+                                                sensorIds.end());
+            std::erase_if(sensors, [&wanted](const Sensor& sensor) {
+                return !wanted.contains(sensor.id);
+            });
+            for (auto id : wanted)
+            {
+                if (std::ranges::none_of(sensors, [id](const Sensor& sensor) {
+                        return sensor.id == id;
+                    }))
+                {
+                    /* Read without its PDR, the raw value is printed */
+                    addSensor(id, {}, 0);
+                }
+            }
+        }
+        if (sensors.empty())
+        {
+            std::cerr << "No numeric sensor to watch\n";
+            return;
+        }
+
+        auto eid = getMCTPEID();
+        auto interval = std::chrono::milliseconds(intervalMs);
+        auto start = std::chrono::steady_clock::now();
+        auto roundStart = start;
+        for (uint64_t round = 0; !rounds || round < rounds; round++)
+        {
+            ordered_json changed = ordered_json::object();
+            pipelineRequests(
+                eid, PLDM_PLATFORM, PLDM_GET_SENSOR_READING, sensors.size(),
+                window, std::chrono::milliseconds(timeoutMs),
+                [this](size_t index, uint8_t id,
+                       std::vector<uint8_t>& requestMsg) {
+                requestMsg.resize(sizeof(pldm_msg_hdr) +
+                                  PLDM_GET_SENSOR_READING_REQ_BYTES);
+                return encode_get_sensor_reading_req(
+                    id, sensors[index].id, 0,
+                    reinterpret_cast<pldm_msg*>(requestMsg.data()));
+            },
+                [&](size_t index, PipelineStatus status,
+                    const pldm_msg* response, size_t payloadLength,
+                    std::chrono::steady_clock::duration) {
+                auto& sensor = sensors[index];
+                std::optional<double> value;
+                if (status == PipelineStatus::Responded)
+                {
+                    value = decodeReading(response, payloadLength,
+                                          sensor.unitModifier);
+                }
+                if (round && value == sensor.value)
+                {
+                    return;
+                }
+                sensor.value = value;
+                if (value)
+                {
+                    changed[sensor.name] = *value;
+                }
+                else
+                {
+                    changed[sensor.name] = nullptr;
+                }
+            });
+
+            if (!changed.empty())
+            {
+                ordered_json line;
+                line["time"] = std::chrono::duration<double>(
+                                   std::chrono::steady_clock::now() - start)
+                                   .count();
+                line["sensors"] = std::move(changed);
+                std::cout << line.dump() << std::endl;
+            }
+
+            roundStart += interval;
+            std::this_thread::sleep_until(roundStart);
+        }
+    }
+
+  private:
+    struct Sensor
+    {
+        uint16_t id;
+        std::string name;
+        int8_t unitModifier;
+        /** @brief Last value, nullopt when it was not readable */
+        std::optional<double> value;
+    };
+
+    void addSensor(uint16_t id, std::string name, int8_t unitModifier)
+    {
+        if (name.empty())
+        {
+            name = "SensorId" + std::to_string(id);
+        }
+        sensors.emplace_back(Sensor{id, std::move(name), unitModifier, {}});
+    }
+
+    /** @brief Value of a GetSensorReading response with the unit modifier,
+     *         nullopt unless the sensor is enabled
+     */
+    static std::optional<double> decodeReading(const pldm_msg* response,
+                                               size_t payloadLength,
+                                               int8_t unitModifier)
+    {
+        uint8_t completionCode = 0;
+        uint8_t dataSize = 0;
+        uint8_t operationalState = 0;
+        uint8_t eventMessageEnable = 0;
+        uint8_t presentState = 0;
+        uint8_t previousState = 0;
+        uint8_t eventState = 0;
+        std::array<uint8_t, sizeof(uint32_t)> reading{};
+        auto rc = decode_get_sensor_reading_resp(
+            response, payloadLength, &completionCode, &dataSize,
+            &operationalState, &eventMessageEnable, &presentState,
+            &previousState, &eventState, reading.data());
+        if (rc != PLDM_SUCCESS || completionCode != PLDM_SUCCESS ||
+            operationalState != PLDM_SENSOR_ENABLED)
+        {
+            return std::nullopt;
+        }
+
+        double raw = 0;
+        switch (dataSize)
+        {
+            case PLDM_SENSOR_DATA_SIZE_UINT8:
+                raw = readAs<uint8_t>(reading);
+                break;
+            case PLDM_SENSOR_DATA_SIZE_SINT8:
+                raw = readAs<int8_t>(reading);
+                break;
+            case PLDM_SENSOR_DATA_SIZE_UINT16:
+                raw = readAs<uint16_t>(reading);
+                break;
+            case PLDM_SENSOR_DATA_SIZE_SINT16:
+                raw = readAs<int16_t>(reading);
+                break;
+            case PLDM_SENSOR_DATA_SIZE_UINT32:
+                raw = readAs<uint32_t>(reading);
+                break;
+            case PLDM_SENSOR_DATA_SIZE_SINT32:
+                raw = readAs<int32_t>(reading);
+                break;
+            default:
+                return std::nullopt;
+        }
+        return raw * std::pow(10, unitModifier);
+    }
+
+    template <typename T>
+    static T readAs(const std::array<uint8_t, sizeof(uint32_t)>& reading)
+    {
+        T value;
+        std::memcpy(&value, reading.data(), sizeof(value));
+        return value;
+    }
+
+    std::vector<uint16_t> sensorIds;
+    uint32_t intervalMs = 1000;
+    uint8_t window = 4;
+    uint64_t rounds = 0;
+    uint32_t timeoutMs = 1000;
+    /** @brief Record handle of the next GetPDR */
+    uint32_t recordHandle = 0;
+    std::vector<Sensor> sensors;
+};
+
 void registerCommand(CLI::App& app)
 {
+    commands.clear();
     auto platform = app.add_subcommand("platform", "platform type command");
     platform->require_subcommand(1);
 
@@ -1831,6 +2408,10 @@ void registerCommand(CLI::App& app)
         "GetNumericEffecterValue", "get the numeric effecter value");
     commands.push_back(std::make_unique<GetNumericEffecterValue>(
         "platform", "getNumericEffecterValue", getNumericEffecterValue));
+
+    auto watch = platform->add_subcommand(
+        "watch", "read numeric sensors periodically and print the changes");
+    commands.push_back(std::make_unique<Watch>("platform", "watch", watch));
 }
 
 void parseGetPDROption()
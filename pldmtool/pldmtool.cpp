@@ -1,4 +1,5 @@
 #include "pldm_base_cmd.hpp"
+#include "pldm_bench_cmd.hpp"
 #include "pldm_bios_cmd.hpp"
 #include "pldm_cmd_helper.hpp"
 #include "pldm_fru_cmd.hpp"
@@ -8,6 +9,10 @@
 
 #include <CLI/CLI.hpp>
 
+#include <fstream>
+#include <iostream>
+#include <string_view>
+
 namespace pldmtool
 {
 
@@ -55,6 +60,7 @@ class RawOp : public CommandInterface
 
 void registerCommand(CLI::App& app)
 {
+    commands.clear();
     auto raw = app.add_subcommand("raw",
                                   "send a raw request and print response");
     commands.push_back(std::make_unique<RawOp>("raw", "raw", raw));
@@ -63,9 +69,12 @@ void registerCommand(CLI::App& app)
 } // namespace raw
 } // namespace pldmtool
 
-int main(int argc, char** argv)
+namespace
+{
+
+/** @brief Register the commands of all the PLDM types */
+void registerCommands(CLI::App& app)
 {
-    CLI::App app{"PLDM requester tool for OpenBMC"};
     app.require_subcommand(1)->ignore_case();
 
     pldmtool::raw::registerCommand(app);
@@ -74,10 +83,87 @@ int main(int argc, char** argv)
     pldmtool::platform::registerCommand(app);
     pldmtool::fru::registerCommand(app);
     pldmtool::fw_update::registerCommand(app);
+    pldmtool::bench::registerCommand(app);
 
 #ifdef OEM_IBM
     pldmtool::oem_ibm::registerCommand(app);
 #endif
+}
+
+/** @brief Run the commands read from a file, or stdin, one per line
+ *
+ *  The commands share the transport and the instance ID database of the
+ *  process and print their output as JSON lines. The commands are
+ *  registered again for each line, so the options of a line don't leak
+ *  into the next one.
+ */
+int runBatch(int argc, char** argv)
+{
+    CLI::App app{"Run the pldmtool commands read from a file or stdin, one "
+                 "per line"};
+    std::string file;
+    app.add_option("-f,--file", file,
+                   "file with the commands, '-' or none for stdin");
+    CLI11_PARSE(app, argc, argv);
+
+    std::ifstream input;
+    if (!file.empty() && file != "-")
+    {
+        input.open(file);
+        if (!input)
+        {
+            std::cerr << "Failed to open " << file << "\n";
+            return EXIT_FAILURE;
+        }
+    }
+    std::istream& commands = input.is_open() ? input : std::cin;
+
+    pldmtool::helper::setJsonLines(true);
+    int rc = EXIT_SUCCESS;
+    std::string line;
+    while (std::getline(commands, line))
+    {
+        auto start = line.find_first_not_of(" \t");
+        if (start == std::string::npos || line[start] == '#')
+        {
+            continue;
+        }
+
+        CLI::App lineApp{"PLDM requester tool for OpenBMC"};
+        registerCommands(lineApp);
+        try
+        {
+            lineApp.parse(line.substr(start), false);
+        }
+        catch (const CLI::ParseError& e)
+        {
+            if (lineApp.exit(e))
+            {
+                rc = EXIT_FAILURE;
+            }
+            continue;
+        }
+        pldmtool::platform::parseGetPDROption();
+        std::cout.flush();
+    }
+    return rc;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc > 1 && std::string_view(argv[1]) == "batch")
+    {
+        return runBatch(argc - 1, argv + 1);
+    }
+
+    CLI::App app{"PLDM requester tool for OpenBMC"};
+    registerCommands(app);
+    // Listed in the help only, main runs the batch before parsing
+    app.add_subcommand("batch",
+                       "run the commands read from a file or stdin, one per "
+                       "line, and print JSON lines");
 
     CLI11_PARSE(app, argc, argv);
     pldmtool::platform::parseGetPDROption();
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace pldm
+{
+
+/** @class ActiveSet
+ *
+ *  Set of small indexes, e.g. the rows of the sensors which are polled.
+ *  The members are kept in a dense vector and the position of each index in
+ *  a vector indexed by it, so that insert, erase and contains are O(1). An
+ *  erase moves the last member into the hole, the iteration order is not
+ *  the insertion order.
+ */
+class ActiveSet
+{
+  public:
+    using const_iterator = std::vector<size_t>::const_iterator;
+
+    /** @brief Add an index, no-op if it is a member
+     *
+     *  @return - true if it was added
+     */
+    bool insert(size_t index)
+    {
+        if (contains(index))
+        {
+            return false;
+        }
+        if (index >= positions.size())
+        {
+            positions.resize(index + 1, npos);
+        }
+        positions[index] = members.size();
+        members.emplace_back(index);
+        return true;
+    }
+
+    /** @brief Remove an index, no-op if it is not a member
+     *
+     *  @return - true if it was removed
+     */
+    bool erase(size_t index)
+    {
+        if (!contains(index))
+        {
+            return false;
+        }
+        auto position = positions[index];
+        auto last = members.back();
+        members[position] = last;
+        positions[last] = position;
+        members.pop_back();
+        positions[index] = npos;
+        return true;
+    }
+
+    bool contains(size_t index) const
+    {
+        return index < positions.size() && positions[index] != npos;
+    }
+
+    size_t size() const
+    {
+        return members.size();
+    }
+
+    bool empty() const
+    {
+        return members.empty();
+    }
+
+    void clear()
+    {
+        members.clear();
+        positions.clear();
+    }
+
+    const_iterator begin() const
+    {
+        return members.begin();
+    }
+
+    const_iterator end() const
+    {
+        return members.end();
+    }
+
+  private:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    /** @brief Members in no particular order */
+    std::vector<size_t> members;
+    /** @brief Position of each index in members, npos if not a member */
+    std::vector<size_t> positions;
+};
+
+} // namespace pldm
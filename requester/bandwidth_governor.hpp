@@ -0,0 +1,209 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace pldm
+{
+namespace requester
+{
+
+/** @class BandwidthGovernor
+ *
+ *  Token bucket of the request bytes of each scheduling class, shared by all
+ *  the endpoints of a Handler. A class with a rate of 0 is not limited, it
+ *  is still accounted for the utilization.
+ *
+ *  A class may send while its bucket is not empty, the request and later its
+ *  response are charged in full so the bucket can go into debt, that lets
+ *  a message larger than the burst through without exceeding the rate on
+ *  average.
+ */
+class BandwidthGovernor
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /** @brief Period the utilization is measured over */
+    static constexpr std::chrono::seconds utilizationWindow{1};
+
+    /** @struct Budget
+     *  @brief Sustained rate and burst of a class
+     */
+    struct Budget
+    {
+        uint64_t rate = 0;  //!< Bytes per second, 0 for no limit
+        uint64_t burst = 0; //!< Bucket size in bytes, 0 for one second
+    };
+
+    /** @brief Constructor
+     *
+     *  @param[in] classes - number of scheduling classes
+     */
+    explicit BandwidthGovernor(size_t classes) : buckets(classes) {}
+
+    size_t classes() const
+    {
+        return buckets.size();
+    }
+
+    /** @brief Set the budget of a class, its bucket starts full
+     *
+     *  @param[in] cls - scheduling class
+     *  @param[in] budget - rate and burst of the class
+     *  @param[in] now - current time
+     */
+    void setBudget(size_t cls, Budget budget,
+                   Clock::time_point now = Clock::now())
+    {
+        auto& bucket = buckets[cls];
+        bucket.budget = budget;
+        bucket.tokens = static_cast<double>(capacity(bucket));
+        bucket.refilledAt = now;
+    }
+
+    const Budget& getBudget(size_t cls) const
+    {
+        return buckets[cls].budget;
+    }
+
+    /** @brief Whether a class may send a request now
+     *
+     *  @param[in] cls - scheduling class
+     *  @param[in] now - current time
+     */
+    bool maySend(size_t cls, Clock::time_point now = Clock::now())
+    {
+        auto& bucket = buckets[cls];
+        if (!bucket.budget.rate)
+        {
+            return true;
+        }
+        refill(bucket, now);
+        return bucket.tokens > 0;
+    }
+
+    /** @brief Charge the bytes of a request or a response to a class
+     *
+     *  @param[in] cls - scheduling class
+     *  @param[in] bytes - size of the message
+     *  @param[in] now - current time
+     */
+    void charge(size_t cls, size_t bytes, Clock::time_point now = Clock::now())
+    {
+        auto& bucket = buckets[cls];
+        if (bucket.budget.rate)
+        {
+            refill(bucket, now);
+            bucket.tokens -= static_cast<double>(bytes);
+        }
+
+        if (now - bucket.windowStart >= utilizationWindow)
+        {
+            bucket.lastWindowBytes =
+                now - bucket.windowStart < 2 * utilizationWindow
+                    ? bucket.windowBytes
+                    : 0;
+            bucket.windowStart = now;
+            bucket.windowBytes = 0;
+        }
+        bucket.windowBytes += bytes;
+        bucket.totalBytes += bytes;
+    }
+
+    /** @brief Record that a request of a class waited for its budget */
+    void deferred(size_t cls)
+    {
+        buckets[cls].deferrals++;
+    }
+
+    /** @brief Time until a class may send again
+     *
+     *  @param[in] cls - scheduling class
+     *  @param[in] now - current time
+     *
+     *  @return - zero if the class may send now
+     */
+    Clock::duration waitTime(size_t cls, Clock::time_point now = Clock::now())
+    {
+        if (maySend(cls, now))
+        {
+            return Clock::duration::zero();
+        }
+        const auto& bucket = buckets[cls];
+        /* One byte of credit is enough to send */
+        std::chrono::duration<double> wait((1.0 - bucket.tokens) /
+                                           bucket.budget.rate);
+        return std::max(
+            Clock::duration(1),
+            std::chrono::duration_cast<Clock::duration>(wait));
+    }
+
+    /** @brief Bytes per second of a class over the last whole window
+     *
+     *  @param[in] cls - scheduling class
+     *  @param[in] now - current time
+     */
+    uint64_t utilization(size_t cls, Clock::time_point now = Clock::now()) const
+    {
+        const auto& bucket = buckets[cls];
+        auto elapsed = now - bucket.windowStart;
+        if (elapsed >= 2 * utilizationWindow)
+        {
+            return 0;
+        }
+        return elapsed >= utilizationWindow ? bucket.windowBytes
+                                            : bucket.lastWindowBytes;
+    }
+
+    /** @brief Bytes of a class since the start */
+    uint64_t totalBytes(size_t cls) const
+    {
+        return buckets[cls].totalBytes;
+    }
+
+    /** @brief Number of times a request of a class waited for its budget */
+    uint64_t deferrals(size_t cls) const
+    {
+        return buckets[cls].deferrals;
+    }
+
+  private:
+    struct Bucket
+    {
+        Budget budget;
+        double tokens = 0;
+        Clock::time_point refilledAt{};
+        Clock::time_point windowStart{};
+        uint64_t windowBytes = 0;
+        uint64_t lastWindowBytes = 0;
+        uint64_t totalBytes = 0;
+        uint64_t deferrals = 0;
+    };
+
+    static uint64_t capacity(const Bucket& bucket)
+    {
+        return bucket.budget.burst ? bucket.budget.burst : bucket.budget.rate;
+    }
+
+    static void refill(Bucket& bucket, Clock::time_point now)
+    {
+        std::chrono::duration<double> elapsed = now - bucket.refilledAt;
+        if (elapsed.count() <= 0)
+        {
+            return;
+        }
+        bucket.refilledAt = now;
+        bucket.tokens = std::min(static_cast<double>(capacity(bucket)),
+                                 bucket.tokens +
+                                     elapsed.count() * bucket.budget.rate);
+    }
+
+    std::vector<Bucket> buckets;
+};
+
+} // namespace requester
+} // namespace pldm
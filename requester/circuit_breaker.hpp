@@ -0,0 +1,89 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+namespace pldm
+{
+
+/** @class CircuitBreaker
+ *
+ *  Tracks the consecutive timeouts of a terminus. The breaker opens once
+ *  the threshold is reached, the caller then stops sending the regular
+ *  requests and probes the terminus until a response closes the breaker.
+ */
+class CircuitBreaker
+{
+  public:
+    /** @brief Constructor
+     *
+     *  @param[in] threshold - consecutive timeouts which open the breaker
+     */
+    explicit CircuitBreaker(unsigned threshold) :
+        threshold(std::max(threshold, 1u))
+    {}
+
+    /** @brief Count a request which got no response
+     *
+     *  @return - true if this timeout opened the breaker
+     */
+    bool failure()
+    {
+        if (open)
+        {
+            return false;
+        }
+        if (++failures >= threshold)
+        {
+            open = true;
+            return true;
+        }
+        return false;
+    }
+
+    /** @brief Open the breaker whatever the count, e.g. once the terminus
+     *         missed its heartbeat
+     *
+     *  @return - true if the breaker was closed
+     */
+    bool trip()
+    {
+        if (open)
+        {
+            return false;
+        }
+        open = true;
+        return true;
+    }
+
+    /** @brief A response closes the breaker and resets the count
+     *
+     *  @return - true if the breaker was open
+     */
+    bool success()
+    {
+        bool wasOpen = open;
+        open = false;
+        failures = 0;
+        return wasOpen;
+    }
+
+    /** @brief Whether the regular requests are paused */
+    bool isOpen() const
+    {
+        return open;
+    }
+
+    /** @brief Consecutive timeouts counted */
+    unsigned getFailures() const
+    {
+        return failures;
+    }
+
+  private:
+    unsigned threshold;
+    unsigned failures = 0;
+    bool open = false;
+};
+
+} // namespace pldm
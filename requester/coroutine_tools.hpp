@@ -0,0 +1,411 @@
+#pragma once
+
+#include "requester/handler.hpp"
+
+#include <libpldm/base.h>
+
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/utility/timer.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+/* Building blocks to run requester::Coroutine tasks concurrently. A
+ * Coroutine starts running when it is called, so the tasks created one after
+ * the other already run concurrently, awaiting them only joins them. */
+
+namespace pldm
+{
+namespace requester
+{
+
+/** @class CancellationToken
+ *
+ *  Observes the cancellation of a CancellationSource. A default constructed
+ *  token is never cancelled.
+ */
+class CancellationToken
+{
+  public:
+    using Callback = std::function<void()>;
+
+    CancellationToken() = default;
+
+    /** @brief Whether the source is cancelled */
+    bool cancelled() const
+    {
+        return state && state->cancelled;
+    }
+
+    /** @brief Register a callback of the cancellation, not called if the
+     *         source is already cancelled
+     *
+     *  @param[in] callback - called once when the source is cancelled
+     *  @return - id of the callback for remove(), 0 if not registered
+     */
+    size_t onCancel(Callback&& callback) const
+    {
+        if (!state || state->cancelled)
+        {
+            return 0;
+        }
+        auto id = ++state->lastId;
+        state->callbacks.emplace(id, std::move(callback));
+        return id;
+    }
+
+    /** @brief Unregister a callback of the cancellation
+     *
+     *  @param[in] id - id returned by onCancel()
+     */
+    void remove(size_t id) const
+    {
+        if (state)
+        {
+            state->callbacks.erase(id);
+        }
+    }
+
+  private:
+    friend class CancellationSource;
+
+    struct State
+    {
+        bool cancelled = false;
+        size_t lastId = 0;
+        std::map<size_t, Callback> callbacks;
+    };
+
+    explicit CancellationToken(std::shared_ptr<State> state) :
+        state(std::move(state))
+    {}
+
+    std::shared_ptr<State> state;
+};
+
+/** @class CancellationSource
+ *
+ *  Cancels the tasks given its tokens, e.g. when the terminus is stopped.
+ *  The tasks check the token between their steps, the sleeps of the tasks
+ *  end early.
+ */
+class CancellationSource
+{
+  public:
+    CancellationSource() : state(std::make_shared<CancellationToken::State>())
+    {}
+
+    CancellationSource(const CancellationSource&) = delete;
+    CancellationSource& operator=(const CancellationSource&) = delete;
+
+    /** @brief Token observing this source */
+    CancellationToken token() const
+    {
+        return CancellationToken(state);
+    }
+
+    /** @brief Whether the source is cancelled */
+    bool cancelled() const
+    {
+        return state->cancelled;
+    }
+
+    /** @brief Cancel the tokens, the callbacks run before it returns */
+    void cancel()
+    {
+        if (state->cancelled)
+        {
+            return;
+        }
+        state->cancelled = true;
+        auto callbacks = std::move(state->callbacks);
+        state->callbacks.clear();
+        for (auto& [id, callback] : callbacks)
+        {
+            callback();
+        }
+    }
+
+    /** @brief Cancel the tokens when a deadline expires, an earlier deadline
+     *         is replaced
+     *
+     *  @param[in] event - event loop of the tasks
+     *  @param[in] timeout - time from now to the deadline
+     */
+    void cancelAfter(sdeventplus::Event& event,
+                     std::chrono::microseconds timeout)
+    {
+        if (state->cancelled)
+        {
+            return;
+        }
+        deadline.emplace(event, [this](Timer&) { cancel(); });
+        deadline->restartOnce(timeout);
+    }
+
+  private:
+    using Timer = sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>;
+
+    std::shared_ptr<CancellationToken::State> state;
+    std::optional<Timer> deadline;
+};
+
+/** @class SleepFor
+ *
+ *  Awaitable timer, `co_await SleepFor(event, timeout, token)` resumes the
+ *  task from the event loop once the timeout expires or, earlier, once the
+ *  token is cancelled.
+ *
+ *  The result is PLDM_SUCCESS when the timeout expired, PLDM_ERROR when the
+ *  token is cancelled.
+ */
+class SleepFor
+{
+  public:
+    SleepFor(sdeventplus::Event& event, std::chrono::microseconds timeout,
+             CancellationToken token = {}) :
+        event(event),
+        timeout(timeout), token(std::move(token))
+    {}
+
+    SleepFor(const SleepFor&) = delete;
+    SleepFor& operator=(const SleepFor&) = delete;
+
+    ~SleepFor()
+    {
+        token.remove(cancelId);
+    }
+
+    bool await_ready() const noexcept
+    {
+        return token.cancelled();
+    }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        timer.emplace(event, [handle](Timer&) { handle.resume(); });
+        timer->restartOnce(timeout);
+        /* The task is still resumed from the event loop, not from
+         * cancel() */
+        cancelId = token.onCancel(
+            [this]() { timer->restartOnce(std::chrono::microseconds(0)); });
+    }
+
+    uint8_t await_resume() noexcept
+    {
+        token.remove(cancelId);
+        cancelId = 0;
+        return token.cancelled() ? PLDM_ERROR : PLDM_SUCCESS;
+    }
+
+  private:
+    using Timer = sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>;
+
+    sdeventplus::Event& event;
+    std::chrono::microseconds timeout;
+    CancellationToken token;
+    std::optional<Timer> timer;
+    size_t cancelId = 0;
+};
+
+/** @brief SleepFor as a task, e.g. the deadline of a WhenAny
+ *
+ *  @param[in] event - event loop of the task
+ *  @param[in] timeout - time to sleep
+ *  @param[in] token - ends the sleep early
+ *  @return - the result of SleepFor
+ */
+inline Coroutine delay(sdeventplus::Event& event,
+                       std::chrono::microseconds timeout,
+                       CancellationToken token = {})
+{
+    co_return co_await SleepFor(event, timeout, std::move(token));
+}
+
+/** @brief Wait for all the tasks
+ *
+ *  @param[in] tasks - running tasks
+ *  @return - PLDM_SUCCESS, or the error of the first task which failed in the
+ *            order of the tasks
+ */
+inline Coroutine whenAll(std::vector<Coroutine> tasks)
+{
+    uint8_t result = PLDM_SUCCESS;
+    for (auto& task : tasks)
+    {
+        auto rc = co_await task;
+        if (rc && result == PLDM_SUCCESS)
+        {
+            result = rc;
+        }
+    }
+    co_return result;
+}
+
+/** @class WhenAny
+ *
+ *  Awaitable of the first of several tasks to complete,
+ *  `co_await WhenAny(std::move(tasks))` gives the index and the result of
+ *  that task. The other tasks keep running to their end, e.g. the task of a
+ *  request still gets its response, their results are dropped.
+ */
+class WhenAny
+{
+  public:
+    /** @brief Index of the first task completed and its result */
+    using Result = std::pair<size_t, uint8_t>;
+
+    explicit WhenAny(std::vector<Coroutine> tasks) :
+        state(std::make_shared<State>())
+    {
+        if (tasks.empty())
+        {
+            state->result = Result{0, PLDM_ERROR_INVALID_DATA};
+            return;
+        }
+        for (size_t index = 0; index < tasks.size(); index++)
+        {
+            watch(tasks[index], index, state);
+        }
+    }
+
+    bool await_ready() const noexcept
+    {
+        return state->result.has_value();
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) noexcept
+    {
+        state->waiter = handle;
+    }
+
+    Result await_resume() const noexcept
+    {
+        return *state->result;
+    }
+
+  private:
+    struct State
+    {
+        std::optional<Result> result;
+        std::coroutine_handle<> waiter;
+    };
+
+    /** @brief Record the result of a task completed first */
+    static Coroutine watch(Coroutine task, size_t index,
+                           std::shared_ptr<State> state)
+    {
+        auto rc = co_await task;
+        if (!state->result)
+        {
+            state->result = Result{index, rc};
+            if (auto waiter = std::exchange(state->waiter, nullptr))
+            {
+                waiter.resume();
+            }
+        }
+        co_return rc;
+    }
+
+    std::shared_ptr<State> state;
+};
+
+/** @brief Send a request and wait for its response, as a task which can be
+ *         joined by whenAll() or WhenAny. The task owns the request and
+ *         shares the response, which stays valid if the caller stops waiting
+ *         for it.
+ *
+ *  @param[in] handler - PLDM request handler
+ *  @param[in] eid - endpoint ID of the terminus
+ *  @param[in] requestMsg - request message, its instance ID is allocated
+ *  @param[in] responseMsg - filled with the response message
+ *  @param[in] priority - scheduling class of the request
+ *  @return - the result of sendRecvPldmMsg
+ */
+inline Coroutine sendRecvTask(Handler<Request>& handler, uint8_t eid,
+                              pldm::Request requestMsg,
+                              std::shared_ptr<pldm::Response> responseMsg,
+                              RequestPriority priority =
+                                  RequestPriority::Discovery)
+{
+    co_return co_await sendRecvPldmMsg(handler, eid, requestMsg, *responseMsg,
+                                       priority);
+}
+
+namespace detail
+{
+
+/** @brief Items and results shared by the workers of forEach() */
+template <typename T, typename Func>
+struct ForEachState
+{
+    std::vector<T> items;
+    Func func;
+    CancellationToken token;
+    size_t next = 0;
+    uint8_t result = PLDM_SUCCESS;
+};
+
+/** @brief Run the tasks of the next items until there is none left */
+template <typename T, typename Func>
+Coroutine forEachWorker(std::shared_ptr<ForEachState<T, Func>> state)
+{
+    while (state->next < state->items.size())
+    {
+        if (state->token.cancelled())
+        {
+            if (state->result == PLDM_SUCCESS)
+            {
+                state->result = PLDM_ERROR;
+            }
+            break;
+        }
+        const auto& item = state->items[state->next++];
+        auto rc = co_await state->func(item);
+        if (rc && state->result == PLDM_SUCCESS)
+        {
+            state->result = rc;
+        }
+    }
+    co_return PLDM_SUCCESS;
+}
+
+} // namespace detail
+
+/** @brief Run a task per item with at most a number of them running at a
+ *         time, the items are started in order
+ *
+ *  @param[in] items - items
+ *  @param[in] limit - max number of tasks running at a time
+ *  @param[in] func - creates the task of an item, Coroutine(const T&)
+ *  @param[in] token - no item is started once it is cancelled
+ *  @return - PLDM_SUCCESS, PLDM_ERROR if cancelled before all the items are
+ *            started, else the first error of a task in its completion order
+ */
+template <typename T, typename Func>
+Coroutine forEach(std::vector<T> items, size_t limit, Func func,
+                  CancellationToken token = {})
+{
+    auto state = std::make_shared<detail::ForEachState<T, Func>>(
+        detail::ForEachState<T, Func>{std::move(items), std::move(func),
+                                      std::move(token)});
+    std::vector<Coroutine> workers;
+    auto count = std::min(std::max<size_t>(limit, 1), state->items.size());
+    for (size_t i = 0; i < count; i++)
+    {
+        workers.emplace_back(detail::forEachWorker(state));
+    }
+    co_await whenAll(std::move(workers));
+    co_return state->result;
+}
+
+} // namespace requester
+} // namespace pldm
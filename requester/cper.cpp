@@ -1,10 +1,15 @@
 #include "cper.hpp"
+#include "common/rate_limited_log.hpp"
 #include "common/utils.hpp"
 #include <string.h>
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <functional>
 #include <iostream>
-#include <map>
+#include <unordered_map>
 #include <vector>
-#include <cstring>
 /*
  * Section type definitions, used in SectionType field in struct
  * cper_section_descriptor
@@ -27,100 +32,197 @@ Guid CPER_SEC_PCIE =  { 0xd995e954, 0xbbc1, 0x430f, \
 Guid CPER_AMPERE_SPECIFIC = { 0x2826cc9f, 0x448c, 0x4c2b, \
                  { 0x86, 0xb6, 0xa9, 0x53, 0x94, 0xb7, 0xef, 0x33 }};
 
-std::map<uint16_t, size_t> armProcCtxMap = {
-        {ARM_CONTEXT_TYPE_AARCH32_GPR, sizeof(ARM_V8_AARCH32_GPR)},
-        {ARM_CONTEXT_TYPE_AARCH32_EL1, sizeof(ARM_AARCH32_EL1_CONTEXT_REGISTERS)},
-        {ARM_CONTEXT_TYPE_AARCH32_EL2, sizeof(ARM_AARCH32_EL2_CONTEXT_REGISTERS)},
-        {ARM_CONTEXT_TYPE_AARCH32_SECURE, sizeof(ARM_AARCH32_SECURE_CONTEXT_REGISTERS)},
-        {ARM_CONTEXT_TYPE_AARCH64_GPR, sizeof(ARM_V8_AARCH64_GPR)},
-        {ARM_CONTEXT_TYPE_AARCH64_EL1, sizeof(ARM_AARCH64_EL1_CONTEXT_REGISTERS)},
-        {ARM_CONTEXT_TYPE_AARCH64_EL2, sizeof(ARM_AARCH64_EL2_CONTEXT_REGISTERS)},
-        {ARM_CONTEXT_TYPE_AARCH64_EL3, sizeof(ARM_AARCH64_EL3_CONTEXT_REGISTERS)},
-        {ARM_CONTEXT_TYPE_MISC, sizeof(ARM_MISC_CONTEXT_REGISTER)},
+/* Size of the register array written for each ARM context type */
+constexpr std::array<size_t, ARM_CONTEXT_TYPE_MISC + 1> armProcCtxSizes = {
+        sizeof(ARM_V8_AARCH32_GPR),
+        sizeof(ARM_AARCH32_EL1_CONTEXT_REGISTERS),
+        sizeof(ARM_AARCH32_EL2_CONTEXT_REGISTERS),
+        sizeof(ARM_AARCH32_SECURE_CONTEXT_REGISTERS),
+        sizeof(ARM_V8_AARCH64_GPR),
+        sizeof(ARM_AARCH64_EL1_CONTEXT_REGISTERS),
+        sizeof(ARM_AARCH64_EL2_CONTEXT_REGISTERS),
+        sizeof(ARM_AARCH64_EL3_CONTEXT_REGISTERS),
+        sizeof(ARM_MISC_CONTEXT_REGISTER),
 };
 
-//Returns one if two EFI GUIDs are equal, zero otherwise.
-static inline bool guidEqual(Guid *a, Guid *b)
+namespace
 {
-    //Check top base 3 components.
-    if (a->Data1 != b->Data1 || a->Data2 != b->Data2 ||
-        a->Data3 != b->Data3) {
-        return false;
+
+enum class CperSectionType
+{
+    Ampere,
+    Arm,
+    Memory,
+    Pcie,
+};
+
+struct GuidHash
+{
+    size_t operator()(const Guid& guid) const
+    {
+        uint64_t low, high;
+        std::memcpy(&low, &guid, sizeof(low));
+        std::memcpy(&high, reinterpret_cast<const uint8_t*>(&guid) +
+                               sizeof(low), sizeof(high));
+        return std::hash<uint64_t>{}(low ^ (high * 0x9e3779b97f4a7c15ull));
     }
+};
 
-    //Check Data4 array for equality.
-    for (int i = 0; i < 8; i++) {
-        if (a->Data4[i] != b->Data4[i])
-            return false;
+struct GuidEqual
+{
+    bool operator()(const Guid& a, const Guid& b) const
+    {
+        return !std::memcmp(&a, &b, sizeof(Guid));
     }
+};
 
+/* Section decoders by section type GUID */
+const std::unordered_map<Guid, CperSectionType, GuidHash, GuidEqual>
+    cperSectionTypes = {
+        {CPER_AMPERE_SPECIFIC, CperSectionType::Ampere},
+        {CPER_SEC_PROC_ARM, CperSectionType::Arm},
+        {CPER_SEC_PLATFORM_MEM, CperSectionType::Memory},
+        {CPER_SEC_PCIE, CperSectionType::Pcie},
+};
+
+/** @brief Read a packed structure at the start of a slice */
+template <typename T>
+bool readStruct(std::span<const uint8_t> data, T& value)
+{
+    if (data.size() < sizeof(T))
+    {
+        return false;
+    }
+    std::memcpy(&value, data.data(), sizeof(T));
     return true;
 }
 
-static void decodeSecAmpere(void *section, uint32_t len,
-                            AmpereSpecData* ampSpecHdr,
-                            std::ofstream &out)
+/** @brief Appends the slices of the decoded record to a view, a slice
+ *  following the previous one in memory extends it */
+class Gather
 {
-    std::memcpy(ampSpecHdr, section, sizeof(AmpereSpecData));
-    out.write((char*)section, len);
+  public:
+    explicit Gather(CperRecordView& view) : view(view)
+    {
+        view.pieces.clear();
+        view.size = 0;
+    }
+
+    void add(std::span<const uint8_t> piece)
+    {
+        if (piece.empty())
+        {
+            return;
+        }
+        view.size += piece.size();
+        if (!view.pieces.empty())
+        {
+            auto& last = view.pieces.back();
+            if (static_cast<const uint8_t*>(last.iov_base) + last.iov_len ==
+                piece.data())
+            {
+                last.iov_len += piece.size();
+                return;
+            }
+        }
+        view.pieces.push_back(
+            {const_cast<uint8_t*>(piece.data()), piece.size()});
+    }
+
+  private:
+    CperRecordView& view;
+};
+
+/** @brief Slice of at most len bytes at an offset, empty if out of data */
+std::span<const uint8_t> slice(std::span<const uint8_t> data, size_t offset,
+                               size_t len)
+{
+    if (offset >= data.size())
+    {
+        return {};
+    }
+    return data.subspan(offset, std::min(len, data.size() - offset));
+}
+
+} // namespace
+
+static void decodeSecAmpere(std::span<const uint8_t> section,
+                            AmpereSpecData* ampSpecHdr, Gather& out)
+{
+    readStruct(section, *ampSpecHdr);
+    out.add(section);
 }
 
-static void decodeSecArm(void *section, AmpereSpecData* ampSpecHdr,
-                         std::ofstream &out)
+static void decodeSecArm(std::span<const uint8_t> section,
+                         AmpereSpecData* ampSpecHdr, Gather& out)
 {
-    int i, len;
-    CPERSecProcArm *proc;
-    CPERArmErrInfo *errInfo;
-    CPERArmCtxInfo *ctxInfo;
-
-    proc = (CPERSecProcArm*) section;
-    out.write((char*)section, sizeof(CPERSecProcArm));
-    errInfo = (CPERArmErrInfo *)(proc + 1);
-    out.write((char*) errInfo, proc->ErrInfoNum * sizeof(CPERArmErrInfo));
-    len = proc->SectionLength - (sizeof(CPERSecProcArm) +
-          proc->ErrInfoNum * (sizeof(CPERArmErrInfo)));
+    CPERSecProcArm proc;
+    if (!readStruct(section, proc))
+    {
+        out.add(section);
+        return;
+    }
+    out.add(section.first(sizeof(CPERSecProcArm)));
+    size_t pos = sizeof(CPERSecProcArm);
+    size_t errInfoLen = proc.ErrInfoNum * sizeof(CPERArmErrInfo);
+    out.add(slice(section, pos, errInfoLen));
+    pos += errInfoLen;
+
+    long len = static_cast<long>(proc.SectionLength) -
+               static_cast<long>(sizeof(CPERSecProcArm) + errInfoLen);
     if (len < 0)
     {
-        std::cerr << "section length is too small : " << proc->SectionLength
-                  << "\n";
+        PLDM_LOG_RATE_LIMITED(error, "CPER section length {LENGTH} is too small",
+                              "LENGTH", proc.SectionLength);
     }
 
-    ctxInfo = (CPERArmCtxInfo *)(errInfo + proc->ErrInfoNum);
-    for (i = 0; i < proc->ContextInfoNum; i++) {
-        out.write((char*) ctxInfo, sizeof(CPERArmCtxInfo));
-        out.write((char*)(ctxInfo + 1), armProcCtxMap[ctxInfo->RegisterContextType]);
-        int size = sizeof(CPERArmCtxInfo) + ctxInfo->RegisterArraySize;
+    for (int i = 0; i < proc.ContextInfoNum; i++)
+    {
+        CPERArmCtxInfo ctxInfo;
+        if (!readStruct(slice(section, pos, sizeof(ctxInfo)), ctxInfo))
+        {
+            break;
+        }
+        out.add(slice(section, pos, sizeof(CPERArmCtxInfo)));
+        auto type = ctxInfo.RegisterContextType;
+        out.add(slice(section, pos + sizeof(CPERArmCtxInfo),
+                      type < armProcCtxSizes.size() ? armProcCtxSizes[type]
+                                                    : 0));
+        size_t size = sizeof(CPERArmCtxInfo) + ctxInfo.RegisterArraySize;
         len -= size;
-        ctxInfo = (CPERArmCtxInfo *)((long)ctxInfo + size);
+        pos += size;
     }
 
-    if (len > 0) {
+    if (len > 0)
+    {
         /* Get Ampere Specific header data */
-        std::memcpy(ampSpecHdr, (void*) ctxInfo, sizeof(AmpereSpecData));
-        out.write((char*) ctxInfo, len);
+        auto rest = slice(section, pos, len);
+        readStruct(rest, *ampSpecHdr);
+        out.add(rest);
     }
 }
 
-static void decodeSecPlatformMemory(void *section, AmpereSpecData* ampSpecHdr,
-                                    std::ofstream &out)
+static void decodeSecPlatformMemory(std::span<const uint8_t> section,
+                                    AmpereSpecData* ampSpecHdr, Gather& out)
 {
-    CPERSecMemErr *mem = (CPERSecMemErr*) section;
-    out.write((char*)section, sizeof(CPERSecMemErr));
-    if (mem->ErrorType == MEM_ERROR_TYPE_PARITY)
+    out.add(slice(section, 0, sizeof(CPERSecMemErr)));
+    CPERSecMemErr mem;
+    if (readStruct(section, mem) && mem.ErrorType == MEM_ERROR_TYPE_PARITY)
     {
         ampSpecHdr->typeId.member.ipType = ERROR_TYPE_ID_MCU;
         ampSpecHdr->subTypeId = SUBTYPE_ID_PARITY;
     }
 }
 
-static void decodeSecPcie(void *section, AmpereSpecData* ampSpecHdr,
-                          std::ofstream &out)
+static void decodeSecPcie(std::span<const uint8_t> section,
+                          AmpereSpecData* ampSpecHdr, Gather& out)
 {
-    CPERSecPcieErr *pcieErr = (CPERSecPcieErr*) section;
-    out.write((char*)section, sizeof(CPERSecPcieErr));
-    if (pcieErr->ValidFields & CPER_PCIE_VALID_PORT_TYPE)
+    out.add(slice(section, 0, sizeof(CPERSecPcieErr)));
+    CPERSecPcieErr pcieErr;
+    if (readStruct(section, pcieErr) &&
+        (pcieErr.ValidFields & CPER_PCIE_VALID_PORT_TYPE))
     {
-        if (pcieErr->PortType == CPER_PCIE_PORT_TYPE_ROOT_PORT)
+        if (pcieErr.PortType == CPER_PCIE_PORT_TYPE_ROOT_PORT)
         {
             ampSpecHdr->subTypeId = ERROR_SUBTYPE_PCIE_AER_ROOT_PORT;
         }
@@ -129,89 +231,150 @@ static void decodeSecPcie(void *section, AmpereSpecData* ampSpecHdr,
             ampSpecHdr->subTypeId = ERROR_SUBTYPE_PCIE_AER_DEVICE;
         }
     }
-
 }
 
-static void decodeCperSection(std::vector<uint8_t> &data, long basePos,
-                              AmpereSpecData* ampSpecHdr,
-                              CPERSectionDescriptor *secDesc,
-                              std::ofstream &out)
+static bool decodeCperSection(std::span<const uint8_t> record,
+                              const CPERSectionDescriptor& secDesc,
+                              AmpereSpecData* ampSpecHdr, Gather& out)
 {
-    long pos;
-
     //Read section as described by the section descriptor.
-    pos = basePos + secDesc->SectionOffset;
-    char *section = new char[secDesc->SectionLength];
-    std::memcpy(section, &data[pos], secDesc->SectionLength);
-    pos += secDesc->SectionLength;
-    Guid *ptr = (Guid *) &secDesc->SectionType;
-    if (guidEqual(ptr, &CPER_AMPERE_SPECIFIC))
+    auto section = slice(record, secDesc.SectionOffset, secDesc.SectionLength);
+    bool complete = section.size() == secDesc.SectionLength;
+    if (!complete)
     {
-        std::cout << "RAS Section Type : Ampere Specific\n";
-        decodeSecAmpere(section, secDesc->SectionLength, ampSpecHdr, out);
+        PLDM_LOG_RATE_LIMITED(error,
+                              "CPER section at {OFFSET} of length {LENGTH} "
+                              "exceeds the record of {SIZE} bytes",
+                              "OFFSET", secDesc.SectionOffset, "LENGTH",
+                              secDesc.SectionLength, "SIZE", record.size());
     }
-    else if (guidEqual(ptr, &CPER_SEC_PROC_ARM))
+
+    auto type = cperSectionTypes.find(secDesc.SectionType);
+    if (type == cperSectionTypes.end())
     {
-        std::cout << "RAS Section Type : ARM\n";
-        decodeSecArm(section, ampSpecHdr, out);
+        const auto& guid = secDesc.SectionType;
+        uint64_t data4;
+        std::memcpy(&data4, guid.Data4, sizeof(data4));
+        PLDM_LOG_RATE_LIMITED(error,
+                              "Unsupported CPER section type "
+                              "{DATA1}-{DATA2}-{DATA3}-{DATA4}",
+                              "DATA1", lg2::hex, guid.Data1, "DATA2", lg2::hex,
+                              guid.Data2, "DATA3", lg2::hex, guid.Data3,
+                              "DATA4", lg2::hex, data4);
+        return complete;
     }
-    else if (guidEqual(ptr, &CPER_SEC_PLATFORM_MEM))
+
+    switch (type->second)
     {
-        std::cout << "RAS Section Type : Memory\n";
-        decodeSecPlatformMemory(section, ampSpecHdr, out);
+        case CperSectionType::Ampere:
+            lg2::debug("RAS section type: {TYPE}", "TYPE", "Ampere Specific");
+            decodeSecAmpere(section, ampSpecHdr, out);
+            break;
+        case CperSectionType::Arm:
+            lg2::debug("RAS section type: {TYPE}", "TYPE", "ARM");
+            decodeSecArm(section, ampSpecHdr, out);
+            break;
+        case CperSectionType::Memory:
+            lg2::debug("RAS section type: {TYPE}", "TYPE", "Memory");
+            decodeSecPlatformMemory(section, ampSpecHdr, out);
+            break;
+        case CperSectionType::Pcie:
+            lg2::debug("RAS section type: {TYPE}", "TYPE", "PCIE");
+            decodeSecPcie(section, ampSpecHdr, out);
+            break;
     }
-    else if (guidEqual(ptr, &CPER_SEC_PCIE))
+    return complete;
+}
+
+bool decodeCperRecord(std::span<const uint8_t> record,
+                      AmpereSpecData* ampSpecHdr, CperRecordView& view)
+{
+    Gather out(view);
+    CPERRecodHeader cperHeader;
+    if (!readStruct(record, cperHeader))
     {
-        std::cout << "RAS Section Type : PCIE\n";
-        decodeSecPcie(section, ampSpecHdr, out);
+        return false;
     }
-    else
+
+    //Revert 4 bytes of SignatureStart
+    std::memcpy(view.signature.data(), &cperHeader.SignatureStart,
+                view.signature.size());
+    std::reverse(view.signature.begin(), view.signature.end());
+    out.add(view.signature);
+    out.add(record.subspan(view.signature.size(),
+                           sizeof(CPERRecodHeader) - view.signature.size()));
+
+    auto descriptors = record.subspan(sizeof(CPERRecodHeader));
+    size_t count = cperHeader.SectionCount;
+    bool complete = true;
+    if (descriptors.size() < count * sizeof(CPERSectionDescriptor))
     {
-        std::cerr << "Section Type: " << std::hex << ptr->Data1 << "-"
-                  << ptr->Data2 << "-" << ptr->Data3 << "-"
-                  << *(uint64_t*)ptr->Data4
-                  << "not support\n";
+        PLDM_LOG_RATE_LIMITED(error,
+                              "CPER record of {SIZE} bytes is too short for "
+                              "{COUNT} sections",
+                              "SIZE", record.size(), "COUNT", count);
+        count = descriptors.size() / sizeof(CPERSectionDescriptor);
+        complete = false;
     }
+    out.add(descriptors.first(count * sizeof(CPERSectionDescriptor)));
 
-    delete[] section;
+    for (size_t i = 0; i < count; i++)
+    {
+        CPERSectionDescriptor secDesc;
+        readStruct(descriptors.subspan(i * sizeof(CPERSectionDescriptor)),
+                   secDesc);
+        complete &= decodeCperSection(record, secDesc, ampSpecHdr, out);
+    }
+    return complete;
 }
 
-void decodeCperRecord(std::vector<uint8_t> &data, long pos,
-                      AmpereSpecData* ampSpecHdr,
-                      std::ofstream &out)
+bool writeCperRecord(int fd, const CperRecordView& view)
 {
-    CPERRecodHeader cperHeader;
-    int i;
-    long basePos = pos;
+    /* Batch of the remaining pieces, the first one may be partly written */
+    std::array<iovec, 64> batch;
+    size_t index = 0;
+    size_t offset = 0;
+    while (index < view.pieces.size())
+    {
+        size_t count = std::min(batch.size(), view.pieces.size() - index);
+        std::copy_n(view.pieces.begin() + index, count, batch.begin());
+        batch[0].iov_base = static_cast<uint8_t*>(batch[0].iov_base) + offset;
+        batch[0].iov_len -= offset;
 
-    std::memcpy(&cperHeader, &data[pos], sizeof(CPERRecodHeader));
-    pos += sizeof(CPERRecodHeader);
+        auto written = writev(fd, batch.data(), count);
+        if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (written <= 0)
+        {
+            return false;
+        }
 
-    //Revert 4 bytes of SignatureStart
-    char *sigStr = (char *) &cperHeader.SignatureStart;
-    char tmp;
-    tmp = sigStr[0];
-    sigStr[0] = sigStr[3];
-    sigStr[3] = tmp;
-    tmp = sigStr[1];
-    sigStr[1] = sigStr[2];
-    sigStr[2] = tmp;
-
-    out.write((char*) &cperHeader, sizeof(CPERRecodHeader));
-
-    CPERSectionDescriptor *secDesc =
-            new CPERSectionDescriptor[cperHeader.SectionCount];
-    for (i = 0; i < cperHeader.SectionCount; i++) {
-        std::memcpy(&secDesc[i], &data[pos], sizeof(CPERSectionDescriptor));
-        pos += sizeof(CPERSectionDescriptor);
-        out.write((char*) &secDesc[i], sizeof(CPERSectionDescriptor));
+        /* Skip the pieces written, keep the offset in a partial one */
+        size_t left = static_cast<size_t>(written) + offset;
+        offset = 0;
+        while (index < view.pieces.size() && left >= view.pieces[index].iov_len)
+        {
+            left -= view.pieces[index].iov_len;
+            index++;
+        }
+        offset = left;
     }
+    return true;
+}
 
-    for (i = 0; i < cperHeader.SectionCount; i++) {
-        decodeCperSection(data, basePos, ampSpecHdr, &secDesc[i], out);
+void decodeCperRecord(std::vector<uint8_t> &data, long pos,
+                      AmpereSpecData* ampSpecHdr,
+                      std::ostream &out)
+{
+    CperRecordView view;
+    decodeCperRecord(std::span<const uint8_t>(data).subspan(pos), ampSpecHdr,
+                     view);
+    for (const auto& piece : view.pieces)
+    {
+        out.write(static_cast<const char*>(piece.iov_base), piece.iov_len);
     }
-
-    delete[] secDesc;
 }
 
 void addCperSELLog(uint8_t TID, uint16_t eventID, AmpereSpecData *p)
@@ -269,22 +432,5 @@ void addCperSELLog(uint8_t TID, uint16_t eventID, AmpereSpecData *p)
     evtData.push_back(0);
     evtData.push_back(0);
     evtData.push_back(0);
-    auto& bus = pldm::utils::DBusHandler::getBus();
-    try
-    {
-        auto method = bus.new_method_call(
-            "xyz.openbmc_project.Logging.IPMI", "/xyz/openbmc_project/Logging/IPMI",
-            "xyz.openbmc_project.Logging.IPMI", "IpmiSelAddOem");
-        method.append(message, evtData , recordType);
-
-        auto selReply =bus.call(method);
-        if (selReply.is_method_error())
-        {
-            std::cerr << "add SEL log error\n";
-        }
-    }
-    catch (const std::exception& e)
-    {
-        std::cerr << "call SEL log error: " << e.what() << "\n" ;
-    }
+    pldm::utils::addOEMSelLog(message, evtData, recordType);
 }
@@ -4,10 +4,12 @@
 #include <stdint.h>
 #include <unistd.h>
 #include <stdio.h>
-#include <fstream>
+#include <sys/uio.h>
+#include <array>
+#include <ostream>
+#include <span>
 #include <vector>
 
-#define CPER_LOG_DIR               "/usr/share/pldm/cper/"
 #define SENSOR_TYPE_OEM            0xF0
 
 typedef struct {
@@ -412,9 +414,50 @@ typedef struct {
 /*                               Common Header                                */
 /*----------------------------------------------------------------------------*/
 
+/** @struct CperRecordView
+ *  @brief Decoded CPER record as a gather list of slices of the record
+ *  @details Only the byte-swapped signature is copied, the other pieces
+ *  point into the record given to decodeCperRecord, which must outlive the
+ *  view. The first piece points to the signature of the view, so the view
+ *  is neither copied nor moved. A view can be reused for the next record,
+ *  its pieces keep their capacity.
+ */
+struct CperRecordView
+{
+    CperRecordView() = default;
+    CperRecordView(const CperRecordView&) = delete;
+    CperRecordView& operator=(const CperRecordView&) = delete;
+
+    std::array<uint8_t, 4> signature{};
+    std::vector<iovec> pieces;
+    /** @brief Total size of the pieces */
+    size_t size = 0;
+};
+
+/** @brief Decode a CPER record in a single pass, without copying it
+ *
+ *  @param[in] record - CPER record, starting at its record header
+ *  @param[out] ampSpecHdr - Ampere specific data of the record
+ *  @param[out] view - decoded record
+ *
+ *  @return - false if the record is truncated, the view then holds the
+ *            pieces which are within the record
+ */
+bool decodeCperRecord(std::span<const uint8_t> record,
+                      AmpereSpecData* ampSpecHdr, CperRecordView& view);
+
+/** @brief Write a decoded CPER record with as few writev calls as possible
+ *
+ *  @param[in] fd - file to write to
+ *  @param[in] view - decoded record
+ *
+ *  @return - false if the write failed
+ */
+bool writeCperRecord(int fd, const CperRecordView& view);
+
 void decodeCperRecord(std::vector<uint8_t> &data, long pos,
                       AmpereSpecData* ampSpecHdr,
-                      std::ofstream &out);
+                      std::ostream &out);
 void addCperSELLog(uint8_t TID, uint16_t eventID, AmpereSpecData *p);
 
 #endif /* PLDM_COMMON_CPER_HPP_ */
@@ -0,0 +1,137 @@
+#include "requester/cper_pipeline.hpp"
+
+#include "common/log_sink.hpp"
+#include "common/rate_limited_log.hpp"
+#include "common/utils.hpp"
+
+#include <cstring>
+
+namespace pldm
+{
+
+CperPipeline::CperPipeline(CperStore& store, size_t depth) :
+    store(store), depth(depth)
+{
+    worker = std::thread(&CperPipeline::run, this);
+}
+
+CperPipeline::~CperPipeline()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stop = true;
+    }
+    cv.notify_one();
+    if (worker.joinable())
+    {
+        worker.join();
+    }
+}
+
+bool CperPipeline::submit(uint8_t tid, uint16_t eventID,
+                          std::string&& primaryLogId,
+                          std::vector<uint8_t>&& data)
+{
+    if (data.size() < sizeof(CommonEventData) + sizeof(CPERRecodHeader))
+    {
+        PLDM_LOG_RATE_LIMITED(error,
+                              "Drop the truncated CPER record of TID {TID}, "
+                              "size={SIZE}",
+                              "TID", unsigned(tid), "SIZE", data.size());
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (jobs.size() >= depth)
+        {
+            PLDM_LOG_RATE_LIMITED(error,
+                                  "CPER pipeline is full, drop event {ID} "
+                                  "of TID {TID}",
+                                  "ID", eventID, "TID", unsigned(tid));
+            return false;
+        }
+        Job job{};
+        job.tid = tid;
+        job.eventID = eventID;
+        job.primaryLogId = std::move(primaryLogId);
+        job.data = std::move(data);
+        jobs.emplace_back(std::move(job));
+    }
+    cv.notify_one();
+    return true;
+}
+
+bool CperPipeline::isFull()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return jobs.size() >= depth;
+}
+
+void CperPipeline::run()
+{
+    /* Reused by the records so its gather list is allocated once */
+    CperRecordView view;
+    std::unique_lock<std::mutex> guard(lock);
+    while (true)
+    {
+        cv.wait(guard, [this] { return stop || !jobs.empty(); });
+        if (jobs.empty())
+        {
+            return;
+        }
+        auto job = std::move(jobs.front());
+        jobs.pop_front();
+        guard.unlock();
+
+        decode(job, view);
+        if (write(job, view))
+        {
+            notify(job);
+        }
+
+        guard.lock();
+    }
+}
+
+void CperPipeline::decode(Job& job, CperRecordView& view)
+{
+    if (!decodeCperRecord(
+            std::span<const uint8_t>(job.data).subspan(sizeof(CommonEventData)),
+            &job.ampHdr, view))
+    {
+        PLDM_LOG_RATE_LIMITED(error,
+                              "CPER record {ID} of TID {TID} is truncated",
+                              "ID", job.eventID, "TID", unsigned(job.tid));
+    }
+}
+
+bool CperPipeline::write(const Job& job, const CperRecordView& view)
+{
+    auto result = store.store(
+        job.tid,
+        std::span<const uint8_t>(job.data).subspan(sizeof(CommonEventData)),
+        view, job.primaryLogId);
+    return result == CperStore::Result::Stored;
+}
+
+void CperPipeline::notify(Job& job)
+{
+    /* The log sink sends the calls from the event loop */
+    std::string type = "CPER";
+    addCperSELLog(job.tid, job.eventID, &job.ampHdr);
+    pldm::utils::addFaultLogToRedfish(job.primaryLogId, type);
+
+#ifdef AMPERE
+    if (job.ampHdr.typeId.member.isBert)
+    {
+        pldm::utils::postLogRecord(pldm::utils::PropertyRecord{
+            "com.ampere.CrashCapture.Trigger",
+            "/com/ampere/crashcapture/trigger",
+            "com.ampere.CrashCapture.Trigger", "TriggerActions",
+            "com.ampere.CrashCapture.Trigger.TriggerAction.Bert"});
+    }
+#endif
+}
+
+} // namespace pldm
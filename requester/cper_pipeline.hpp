@@ -0,0 +1,102 @@
+#pragma once
+
+#include "cper.hpp"
+#include "cper_store.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace pldm
+{
+
+/** @class CperPipeline
+ *
+ *  Processes the CPER records polled from a terminus on a worker thread, so
+ *  an error storm does not stall the sdevent loop. Each record goes through
+ *  three stages: decode the CPER sections, store the decoded record in its
+ *  fault log file and notify the SEL, the Redfish fault log and the crash
+ *  capture service through the log sink. A repeated record counted by the
+ *  store is not notified. The queue is bounded, the caller checks isFull()
+ *  before polling another record.
+ */
+class CperPipeline
+{
+  public:
+    CperPipeline() = delete;
+    CperPipeline(const CperPipeline&) = delete;
+    CperPipeline& operator=(const CperPipeline&) = delete;
+
+    /** @brief Start the worker thread
+     *
+     *  @param[in] store - store of the CPER fault log files
+     *  @param[in] depth - number of records which can wait for the worker
+     */
+    CperPipeline(CperStore& store, size_t depth);
+
+    /** @brief Finish the queued records and stop the worker thread */
+    ~CperPipeline();
+
+    /** @brief Queue one CPER record
+     *
+     *  @param[in] tid - TID of the terminus which reported the record
+     *  @param[in] eventID - event ID of the record
+     *  @param[in] primaryLogId - unique ID of the fault log entry, also the
+     *                            file name of the record
+     *  @param[in] data - event data, CommonEventData followed by the record
+     *
+     *  @return - false if the queue is full or the data is too short
+     */
+    bool submit(uint8_t tid, uint16_t eventID, std::string&& primaryLogId,
+                std::vector<uint8_t>&& data);
+
+    /** @brief Whether the queue is full and no record should be polled */
+    bool isFull();
+
+  private:
+    /** @struct Job
+     *  @brief One CPER record and the state carried between the stages
+     */
+    struct Job
+    {
+        uint8_t tid;
+        uint16_t eventID;
+        std::string primaryLogId;
+        std::vector<uint8_t> data;
+        AmpereSpecData ampHdr{};
+    };
+
+    /** @brief Worker thread loop */
+    void run();
+
+    /** @brief Decode the CPER sections of the record
+     *
+     *  @param[in] job - record to decode
+     *  @param[out] view - decoded record, slices of the data of the job
+     */
+    void decode(Job& job, CperRecordView& view);
+
+    /** @brief Store the decoded record in its fault log file
+     *
+     *  @return - true if a new file was written
+     */
+    bool write(const Job& job, const CperRecordView& view);
+
+    /** @brief Log the record to the SEL and the Redfish fault log */
+    void notify(Job& job);
+
+    CperStore& store;
+    size_t depth;
+
+    std::mutex lock;
+    std::condition_variable cv;
+    std::deque<Job> jobs;
+    bool stop = false;
+    std::thread worker;
+};
+
+} // namespace pldm
@@ -0,0 +1,399 @@
+#include "config.h"
+
+#include "requester/cper_store.hpp"
+
+#include "common/metrics.hpp"
+#include "common/rate_limited_log.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#ifdef CPER_COMPRESSION_ZSTD
+#include <zstd.h>
+#endif
+#ifdef CPER_COMPRESSION_LZ4
+#include <lz4frame.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <fstream>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+namespace pldm
+{
+
+/** @brief Digests tracked at most, the oldest window ends early beyond */
+constexpr size_t maxTrackedDigests = 64;
+
+#if defined(CPER_COMPRESSION_ZSTD) || defined(CPER_COMPRESSION_LZ4)
+/** @brief Write a buffer, retrying the partial writes */
+static bool writeAll(int fd, const uint8_t* data, size_t size)
+{
+    while (size)
+    {
+        auto written = write(fd, data, size);
+        if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (written <= 0)
+        {
+            return false;
+        }
+        data += written;
+        size -= written;
+    }
+    return true;
+}
+#endif
+
+#ifdef CPER_COMPRESSION_ZSTD
+/** @brief Write a decoded record as a zstd frame, piece by piece */
+static bool writeZstd(int fd, const CperRecordView& view)
+{
+    std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> cctx(
+        ZSTD_createCCtx(), ZSTD_freeCCtx);
+    if (!cctx || ZSTD_isError(ZSTD_CCtx_setPledgedSrcSize(cctx.get(),
+                                                          view.size)))
+    {
+        return false;
+    }
+    std::vector<uint8_t> out(ZSTD_CStreamOutSize());
+    for (size_t i = 0; i <= view.pieces.size(); i++)
+    {
+        bool last = i == view.pieces.size();
+        ZSTD_inBuffer in{last ? nullptr : view.pieces[i].iov_base,
+                         last ? 0 : view.pieces[i].iov_len, 0};
+        size_t remaining = 0;
+        do
+        {
+            ZSTD_outBuffer output{out.data(), out.size(), 0};
+            remaining = ZSTD_compressStream2(cctx.get(), &output, &in,
+                                             last ? ZSTD_e_end
+                                                  : ZSTD_e_continue);
+            if (ZSTD_isError(remaining) ||
+                !writeAll(fd, out.data(), output.pos))
+            {
+                return false;
+            }
+        } while (last ? remaining != 0 : in.pos < in.size);
+    }
+    return true;
+}
+#endif
+
+#ifdef CPER_COMPRESSION_LZ4
+/** @brief Write a decoded record as an lz4 frame, piece by piece */
+static bool writeLz4(int fd, const CperRecordView& view)
+{
+    constexpr size_t chunk = 64 * 1024;
+    LZ4F_cctx* ctx = nullptr;
+    if (LZ4F_isError(LZ4F_createCompressionContext(&ctx, LZ4F_VERSION)))
+    {
+        return false;
+    }
+    std::unique_ptr<LZ4F_cctx, decltype(&LZ4F_freeCompressionContext)> cctx(
+        ctx, LZ4F_freeCompressionContext);
+    LZ4F_preferences_t prefs{};
+    prefs.frameInfo.contentSize = view.size;
+    std::vector<uint8_t> out(LZ4F_HEADER_SIZE_MAX +
+                             LZ4F_compressBound(chunk, &prefs));
+
+    auto produced = LZ4F_compressBegin(ctx, out.data(), out.size(), &prefs);
+    if (LZ4F_isError(produced) || !writeAll(fd, out.data(), produced))
+    {
+        return false;
+    }
+    for (const auto& piece : view.pieces)
+    {
+        auto data = static_cast<const uint8_t*>(piece.iov_base);
+        for (size_t offset = 0; offset < piece.iov_len; offset += chunk)
+        {
+            auto size = std::min(chunk, piece.iov_len - offset);
+            produced = LZ4F_compressUpdate(ctx, out.data(), out.size(),
+                                           data + offset, size, nullptr);
+            if (LZ4F_isError(produced) || !writeAll(fd, out.data(), produced))
+            {
+                return false;
+            }
+        }
+    }
+    produced = LZ4F_compressEnd(ctx, out.data(), out.size(), nullptr);
+    return !LZ4F_isError(produced) && writeAll(fd, out.data(), produced);
+}
+#endif
+
+CperStore::CperStore(const std::filesystem::path& dir, uint64_t maxBytes,
+                     Compression compression,
+                     std::chrono::seconds dedupWindow) :
+    dir(dir),
+    maxBytes(maxBytes), codec(compression), dedupWindow(dedupWindow)
+{
+#ifndef CPER_COMPRESSION_ZSTD
+    if (codec == Compression::Zstd)
+    {
+        lg2::warning("zstd is not built in, the CPER files are not "
+                     "compressed");
+        codec = Compression::None;
+    }
+#endif
+#ifndef CPER_COMPRESSION_LZ4
+    if (codec == Compression::Lz4)
+    {
+        lg2::warning("lz4 is not built in, the CPER files are not "
+                     "compressed");
+        codec = Compression::None;
+    }
+#endif
+
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+    std::vector<std::tuple<std::filesystem::file_time_type, std::string,
+                           uint64_t>>
+        existing;
+    for (const auto& entry : std::filesystem::directory_iterator(dir, ec))
+    {
+        if (entry.is_regular_file(ec))
+        {
+            existing.emplace_back(entry.last_write_time(ec),
+                                  entry.path().filename().string(),
+                                  entry.file_size(ec));
+        }
+    }
+    std::sort(existing.begin(), existing.end());
+    for (auto& [time, name, bytes] : existing)
+    {
+        account(name, bytes);
+    }
+    rotate();
+}
+
+CperStore::~CperStore()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    for (const auto& [key, first] : seen)
+    {
+        flushRepeats(first);
+    }
+}
+
+CperStore::Result CperStore::store(uint8_t tid,
+                                   std::span<const uint8_t> record,
+                                   const CperRecordView& view,
+                                   const std::string& primaryLogId,
+                                   Clock::time_point now)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    uint64_t key = 0;
+    if (dedupWindow.count() > 0)
+    {
+        expire(now);
+        key = digest(tid, record);
+        if (auto it = seen.find(key); it != seen.end())
+        {
+            it->second.repeats++;
+            pldm::metrics::Registry::get()
+                .counter("pldm_cper_duplicates",
+                         "CPER records counted against an identical record "
+                         "instead of stored",
+                         {{"tid", std::to_string(tid)}})
+                .inc();
+            return Result::Duplicate;
+        }
+    }
+
+    auto bytes = writeFile(dir / primaryLogId, view);
+    if (!bytes)
+    {
+        return Result::Failed;
+    }
+    account(primaryLogId, bytes);
+    if (dedupWindow.count() > 0)
+    {
+        seen[key] = Seen{primaryLogId, now, 0};
+    }
+    rotate();
+    return Result::Stored;
+}
+
+uint64_t CperStore::size() const
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return total;
+}
+
+uint64_t CperStore::digest(uint8_t tid, std::span<const uint8_t> record)
+{
+    /* FNV-1a of the record without the fields which differ between the
+     * repeats of an error */
+    uint64_t hash = 0xcbf29ce484222325;
+    auto mix = [&hash](std::span<const uint8_t> bytes) {
+        for (auto byte : bytes)
+        {
+            hash = (hash ^ byte) * 0x100000001b3;
+        }
+    };
+    mix(std::span<const uint8_t>(&tid, 1));
+
+    constexpr size_t timeStamp = offsetof(CPERRecodHeader, TimeStamp);
+    constexpr size_t platformId = offsetof(CPERRecodHeader, PlatformID);
+    constexpr size_t recordId = offsetof(CPERRecodHeader, RecordID);
+    constexpr size_t flags = offsetof(CPERRecodHeader, Flags);
+    constexpr size_t persistence = offsetof(CPERRecodHeader, PersistenceInfo);
+    if (record.size() < sizeof(CPERRecodHeader))
+    {
+        mix(record);
+        return hash;
+    }
+    mix(record.subspan(0, timeStamp));
+    mix(record.subspan(platformId, recordId - platformId));
+    mix(record.subspan(flags, persistence - flags));
+    mix(record.subspan(sizeof(CPERRecodHeader)));
+    return hash;
+}
+
+uint64_t CperStore::writeFile(const std::filesystem::path& path,
+                              const CperRecordView& view)
+{
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                  0666);
+    if (fd < 0)
+    {
+        PLDM_LOG_RATE_LIMITED(error, "Failed to create the CPER file {PATH}",
+                              "PATH", path.string());
+        return 0;
+    }
+
+    bool written = false;
+    switch (codec)
+    {
+#ifdef CPER_COMPRESSION_ZSTD
+        case Compression::Zstd:
+            written = writeZstd(fd, view);
+            break;
+#endif
+#ifdef CPER_COMPRESSION_LZ4
+        case Compression::Lz4:
+            written = writeLz4(fd, view);
+            break;
+#endif
+        default:
+            written = writeCperRecord(fd, view);
+            break;
+    }
+    auto end = lseek(fd, 0, SEEK_CUR);
+    if (close(fd) < 0 || end <= 0)
+    {
+        written = false;
+    }
+    if (!written)
+    {
+        PLDM_LOG_RATE_LIMITED(error, "Failed to write the CPER file {PATH}",
+                              "PATH", path.string());
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        return 0;
+    }
+    return static_cast<uint64_t>(end);
+}
+
+void CperStore::flushRepeats(const Seen& first)
+{
+    if (!first.repeats)
+    {
+        return;
+    }
+    auto name = first.primaryLogId + repeatsSuffix;
+    std::ofstream file(dir / name, std::ios::trunc);
+    file << first.repeats << '\n';
+    file.close();
+    if (!file)
+    {
+        PLDM_LOG_RATE_LIMITED(error,
+                              "Failed to write the repeat count of the CPER "
+                              "file {NAME}",
+                              "NAME", first.primaryLogId);
+        return;
+    }
+    std::error_code ec;
+    account(name, std::filesystem::file_size(dir / name, ec));
+}
+
+void CperStore::expire(Clock::time_point now)
+{
+    for (auto it = seen.begin(); it != seen.end();)
+    {
+        if (now - it->second.first >= dedupWindow)
+        {
+            flushRepeats(it->second);
+            it = seen.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    if (seen.size() >= maxTrackedDigests)
+    {
+        auto oldest = std::min_element(
+            seen.begin(), seen.end(), [](const auto& a, const auto& b) {
+                return a.second.first < b.second.first;
+            });
+        flushRepeats(oldest->second);
+        seen.erase(oldest);
+    }
+}
+
+void CperStore::rotate()
+{
+    while (maxBytes && total > maxBytes && files.size() > 1)
+    {
+        auto [name, bytes] = std::move(files.front());
+        files.pop_front();
+        total -= bytes;
+        std::error_code ec;
+        std::filesystem::remove(dir / name, ec);
+
+        /* The repeats of a removed record go with it, a new repeat of the
+         * record is stored again */
+        auto sidecar = name + repeatsSuffix;
+        auto it = std::find_if(files.begin(), files.end(), [&](const auto& f) {
+            return f.first == sidecar;
+        });
+        if (it != files.end())
+        {
+            total -= it->second;
+            std::filesystem::remove(dir / sidecar, ec);
+            files.erase(it);
+        }
+        std::erase_if(seen, [&name](const auto& entry) {
+            return entry.second.primaryLogId == name;
+        });
+    }
+    pldm::metrics::Registry::get()
+        .gauge("pldm_cper_store_bytes", "Bytes of the CPER fault log files")
+        .set(static_cast<int64_t>(total));
+}
+
+void CperStore::account(const std::string& name, uint64_t bytes)
+{
+    /* A file written again under its name replaces the former one */
+    auto it = std::find_if(files.begin(), files.end(), [&name](const auto& f) {
+        return f.first == name;
+    });
+    if (it != files.end())
+    {
+        total -= it->second;
+        files.erase(it);
+    }
+    files.emplace_back(name, bytes);
+    total += bytes;
+}
+
+} // namespace pldm
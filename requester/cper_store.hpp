@@ -0,0 +1,142 @@
+#pragma once
+
+#include "cper.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <span>
+#include <string>
+
+namespace pldm
+{
+
+/** @class CperStore
+ *
+ *  Directory of the CPER fault log files, shared by the CPER pipelines of
+ *  all the termini. Each record is written to the file named after its
+ *  fault log entry, optionally as a zstd or an lz4 frame compressed while
+ *  the decoded pieces are written. A record identical to one stored less
+ *  than the deduplication window ago, but for its timestamp and record ID,
+ *  is counted instead of stored: the count is written to
+ *  "<entry>.repeats" once the window of the first record ends. The oldest
+ *  files are removed when the directory grows over its size cap.
+ */
+class CperStore
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /** @brief Compression of the record files */
+    enum class Compression : uint8_t
+    {
+        None,
+        Zstd, //!< zstd frame, built with -Dcper-compression=zstd
+        Lz4,  //!< lz4 frame, built with -Dcper-compression=lz4
+    };
+
+    /** @brief Outcome of storing a record */
+    enum class Result : uint8_t
+    {
+        Stored,
+        Duplicate, //!< Counted against the first record, nothing written
+        Failed,
+    };
+
+    /** @brief Suffix of the repeat count file of a record */
+    static constexpr auto repeatsSuffix = ".repeats";
+
+    CperStore() = delete;
+    CperStore(const CperStore&) = delete;
+    CperStore& operator=(const CperStore&) = delete;
+
+    /** @brief Open the store, the files already in the directory count
+     *         against the size cap, the oldest first
+     *
+     *  @param[in] dir - directory of the record files
+     *  @param[in] maxBytes - size cap of the directory, 0 if none
+     *  @param[in] compression - compression of the files, None if the one
+     *                           asked for is not built in
+     *  @param[in] dedupWindow - deduplication window, 0 to store every
+     *                           record
+     */
+    CperStore(const std::filesystem::path& dir, uint64_t maxBytes,
+              Compression compression, std::chrono::seconds dedupWindow);
+
+    /** @brief Write the pending repeat counts */
+    ~CperStore();
+
+    /** @brief Store a decoded record
+     *
+     *  @param[in] tid - TID of the terminus which reported the record
+     *  @param[in] record - CPER record, starting at its record header
+     *  @param[in] view - decoded record
+     *  @param[in] primaryLogId - fault log entry, the file name
+     *  @param[in] now - time of the record
+     */
+    Result store(uint8_t tid, std::span<const uint8_t> record,
+                 const CperRecordView& view, const std::string& primaryLogId,
+                 Clock::time_point now = Clock::now());
+
+    /** @brief Bytes of the files of the directory */
+    uint64_t size() const;
+
+    /** @brief Compression of the files */
+    Compression compression() const
+    {
+        return codec;
+    }
+
+    /** @brief Digest of a record, the timestamp, the record ID and the
+     *         persistence information of the record header are left out
+     */
+    static uint64_t digest(uint8_t tid, std::span<const uint8_t> record);
+
+  private:
+    /** @struct Seen
+     *  @brief First record of a digest in the deduplication window
+     */
+    struct Seen
+    {
+        std::string primaryLogId;
+        Clock::time_point first;
+        uint64_t repeats = 0;
+    };
+
+    /** @brief Write a record file, compressed if configured
+     *
+     *  @return - size of the file, 0 on failure
+     */
+    uint64_t writeFile(const std::filesystem::path& path,
+                       const CperRecordView& view);
+
+    /** @brief Write the repeat count of the record of a digest */
+    void flushRepeats(const Seen& seen);
+
+    /** @brief End the windows which ended at a time, and the oldest one to
+     *         keep the number of digests bounded
+     */
+    void expire(Clock::time_point now);
+
+    /** @brief Remove the oldest files while the directory is over its cap */
+    void rotate();
+
+    /** @brief Count a file written to the directory */
+    void account(const std::string& name, uint64_t bytes);
+
+    std::filesystem::path dir;
+    uint64_t maxBytes;
+    Compression codec;
+    std::chrono::seconds dedupWindow;
+
+    mutable std::mutex lock;
+    /** @brief Files of the directory and their size, oldest first */
+    std::deque<std::pair<std::string, uint64_t>> files;
+    uint64_t total = 0;
+    std::map<uint64_t, Seen> seen;
+};
+
+} // namespace pldm
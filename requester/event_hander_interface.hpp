@@ -4,28 +4,43 @@
 #include "libpldm/fru.h"
 #include "libpldm/platform.h"
 
+#include "common/dbus_counters.hpp"
 #include "common/instance_id.hpp"
+#include "common/metrics.hpp"
 #include "common/types.hpp"
 #include "common/utils.hpp"
+#include "requester/event_ring.hpp"
 #include "requester/handler.hpp"
+#include "requester/poll_cadence.hpp"
+#include "requester/poll_phase.hpp"
+#include "requester/priority_timer.hpp"
 
 #include <sdbusplus/timer.hpp>
 #include <sdeventplus/event.hpp>
 #include <sdeventplus/source/event.hpp>
 #include <sdeventplus/utility/timer.hpp>
 
+#include <chrono>
+#include <coroutine>
 #include <deque>
 #include <functional>
 #include <map>
 #include <memory>
+#include <optional>
 #include <queue>
 #include <vector>
 
+class EventReassemblyBench;
+
 namespace pldm
 {
 
+/** @brief Handler of a reassembled event, the event data is moved into it */
 using HandlerFunc =
-    std::function<int(uint8_t, uint8_t, uint16_t, const std::vector<uint8_t>)>;
+    std::function<int(uint8_t, uint8_t, uint16_t, std::vector<uint8_t>&&)>;
+
+/** @brief Callback of the drain of the RAS queues, false at the deadline */
+using DrainCallback = std::function<void(bool drained)>;
 
 class EventHandlerInterface
 {
@@ -38,6 +53,15 @@ class EventHandlerInterface
 
     virtual void normalEventCb();
     virtual void criticalEventCb();
+
+    /** @brief Whether the event handlers are behind and no more event
+     *  should be polled, the periodic poll timers retry later
+     */
+    virtual bool isBackpressured()
+    {
+        return false;
+    }
+
     void registerEventHandler(uint8_t event_class, HandlerFunc func);
     int enqueueCriticalEvent(uint16_t item);
     int enqueueOverflowEvent(uint16_t item);
@@ -58,23 +82,143 @@ class EventHandlerInterface
       return mProRASQueuesAreEmpty;
     }
 
+    /** @brief Whether the BMC and the MPro RAS queues are both empty */
+    bool areRASQueuesDrained()
+    {
+        return areBMCRASQueuesEmpty() && areMProRASQueuesEmpty();
+    }
+
+    /** @brief Call back once the BMC and the MPro RAS queues are both
+     *  empty, or at the deadline. A new notification replaces the pending
+     *  one, which is not called.
+     *
+     *  @param[in] deadline - time to wait for the drain
+     *  @param[in] callback - called once, from the event loop
+     */
+    void notifyWhenDrained(std::chrono::milliseconds deadline,
+                           DrainCallback callback);
+
+    /** @struct QueuesDrained
+     *  @brief Awaitable of the drain of the RAS queues, resumes with false
+     *  at the deadline
+     */
+    struct QueuesDrained
+    {
+        EventHandlerInterface& handler;
+        std::chrono::milliseconds deadline;
+        bool drained = false;
+
+        bool await_ready() noexcept
+        {
+            drained = handler.areRASQueuesDrained();
+            return drained;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle)
+        {
+            handler.notifyWhenDrained(deadline, [this, handle](bool result) {
+                drained = result;
+                handle.resume();
+            });
+        }
+
+        bool await_resume() const noexcept
+        {
+            return drained;
+        }
+    };
+
+    /** @brief co_await the drain of the RAS queues
+     *
+     *  @param[in] deadline - time to wait for the drain
+     */
+    QueuesDrained queuesDrained(std::chrono::milliseconds deadline)
+    {
+        return {*this, deadline};
+    }
+
+    /** @brief Change the base and the maximum interval of the normal RAS
+     *         poll, a running poll adopts them at once
+     *
+     *  @param[in] base - interval while the terminus reports RAS events
+     *  @param[in] max - interval reached after repeated empty polls
+     */
+    void setPollCadence(std::chrono::milliseconds base,
+                        std::chrono::milliseconds max)
+    {
+        pollBase = base;
+        pollMax = max;
+        /* The notifications drive the poll in push mode */
+        if (!pushMode)
+        {
+            applyPollCadence(base, max);
+        }
+    }
+
+    /** @brief Move the periodic RAS polls to the phase of the terminus,
+     *         the normal and the critical polls run a third and two thirds
+     *         of their interval after the phase of the sensor rounds
+     *
+     *  @param[in] phase - phase of the polls of the terminus
+     */
+    void setPollPhase(const PollPhase& phase);
+
+    /** @brief Switch between polling the RAS queues periodically and
+     *         polling them when the terminus sends a message poll event
+     *
+     *  @details In push mode each pldmMessagePollEvent notification starts
+     *  the transfer of its event at once, and the normal RAS poll only runs
+     *  at the safety interval, to catch a lost notification. The drain of
+     *  the MPro queues after a poll found them non-empty is unchanged.
+     *
+     *  @param[in] enable - whether the notifications drive the poll
+     *  @param[in] safetyInterval - interval of the normal RAS poll in push
+     *                              mode
+     */
+    void setPushMode(bool enable, std::chrono::milliseconds safetyInterval)
+    {
+        pushMode = enable;
+        if (enable)
+        {
+            applyPollCadence(safetyInterval, safetyInterval);
+        }
+        else
+        {
+            applyPollCadence(pollBase, pollMax);
+        }
+    }
+
+    bool isPushMode() const
+    {
+        return pushMode;
+    }
+
     void inQuiesceMode(bool input)
     {
       isInQuiesceMode = input;
       if (input)
       {
         mProRASQueuesAreEmpty = false;
+        normEventTimer.setInterval(normEventCadence.busy());
         normEventTimer.setRemaining(std::chrono::milliseconds(10));
       }
     }
 
   private:
-    std::size_t MAX_QUEUE_SIZE = 256;
+    friend class ::EventReassemblyBench;
+
     bool isProcessPolling = false;
     bool isPolling = false;
     bool isCritical = false;
     bool isInQuiesceMode = false;
     bool mProRASQueuesAreEmpty = false;
+    /** @brief Whether the message poll events drive the poll */
+    bool pushMode = false;
+    /** @brief Cadence of the periodic poll, restored out of push mode */
+    std::chrono::milliseconds pollBase{NORMAL_RAS_EVENT_TIMER};
+    std::chrono::milliseconds pollMax{NORMAL_RAS_EVENT_MAX_TIMER};
+    /** @brief Phase of the periodic polls, shared with the sensor rounds */
+    PollPhase pollPhase;
     uint8_t eid;
     sdbusplus::bus::bus& bus;
     sdeventplus::Event& event;
@@ -82,17 +226,38 @@ class EventHandlerInterface
     InstanceIdDb& instanceIdDb;
     pldm::requester::Handler<pldm::requester::Request>* handler;
     sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> normEventTimer;
-    sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> critEventTimer;
-    sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> pollEventReqTimer;
+    /** @brief Interval of normEventTimer, backs off while the terminus has
+     *  no RAS event */
+    PollCadence normEventCadence;
+    /** @brief Critical RAS poll and transfer timers, dispatched ahead of
+     *  the normal sources of the loop at CRITICAL_RAS_PRIORITY */
+    PriorityTimer critEventTimer;
+    PriorityTimer pollEventReqTimer;
 
     void processResponseMsg(mctp_eid_t eid, const pldm_msg* response,
                             size_t respMsgLen);
+    /** @brief Change the cadence of the normal RAS poll, a running poll
+     *         adopts it at once
+     */
+    void applyPollCadence(std::chrono::milliseconds base,
+                          std::chrono::milliseconds max);
     void resetCacheAndFlags();
     void pollReqTimeoutHdl();
     void pollEventReqCb();
     void clearOverflow();
     void startCallback();
     void stopCallback();
+    /** @brief Refresh the event queue counters on D-Bus */
+    void updateQueueCounters();
+    /** @brief Call the drain notification if the queues are drained */
+    void checkDrained();
+    /** @brief Call the drain notification and clear it */
+    void finishDrainNotification(bool drained);
+
+    /** @brief Pending drain notification */
+    DrainCallback drainCallback;
+    /** @brief Deadline of the pending drain notification */
+    sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> drainDeadline;
 
     struct ReqPollInfo
     {
@@ -105,16 +270,33 @@ class EventHandlerInterface
         uint8_t eventClass;
         uint32_t totalSize;
         std::vector<uint8_t> data;
+        /** @brief CRC-32 of the parts received so far */
+        pldm::utils::Crc32 crc;
+        /** @brief Size of the largest event, to reserve the next buffer */
+        size_t largestSize = 0;
     };
 
   protected:
+    /** @brief Capacity of each event queue */
+    static constexpr size_t maxEventQueueSize = 256;
 
     uint8_t instanceId;
     bool responseReceived = false;
     std::unique_ptr<phosphor::Timer> pollReqTimeoutTimer;
     std::map<uint8_t, HandlerFunc> eventHndls;
-    std::deque<uint16_t> critEventQueue;
-    std::deque<uint16_t> overflowEventQueue;
+    /** @brief Message poll events, a new event is dropped once full */
+    EventRing<uint16_t, maxEventQueueSize> critEventQueue{
+        RingFullPolicy::DropNewest, true};
+    /** @brief Overflowed sensor events, a new event evicts the oldest once
+     *  full */
+    EventRing<uint16_t, maxEventQueueSize> overflowEventQueue{
+        RingFullPolicy::DropOldest, true};
+    /** @brief Event queue counters of the terminus on D-Bus */
+    std::unique_ptr<pldm::utils::DBusCounters> queueCounters;
+    /** @brief Time the event queues became non-empty, unset while empty */
+    std::optional<std::chrono::steady_clock::time_point> drainStart;
+    /** @brief Exported times to drain the event queues */
+    pldm::metrics::Histogram& drainHistogram;
     ReqPollInfo reqData;
     RecvPollInfo recvData;
 };
@@ -2,6 +2,8 @@
 #include "libpldm/pldm.h"
 #include "event_hander_interface.hpp"
 
+#include "common/rate_limited_log.hpp"
+
 #include <assert.h>
 #include <systemd/sd-journal.h>
 
@@ -26,6 +28,29 @@ using namespace pldm::utils;
 
 namespace pldm
 {
+
+namespace
+{
+
+/** @brief Interface of the event queue counters of a terminus */
+constexpr auto eventQueuesIntf = "com.ampere.PLDM.EventQueues";
+
+/** @brief Return code of the enqueue functions */
+int pushResultToRc(RingPushResult result)
+{
+    switch (result)
+    {
+        case RingPushResult::Coalesced:
+            return -2;
+        case RingPushResult::Dropped:
+            return -1;
+        default:
+            return 0;
+    }
+}
+
+} // namespace
+
 EventHandlerInterface::EventHandlerInterface(
     uint8_t eid, sdeventplus::Event& event, sdbusplus::bus::bus& bus,
     InstanceIdDb& instanceIdDb,
@@ -33,17 +58,42 @@ EventHandlerInterface::EventHandlerInterface(
     eid(eid), bus(bus), event(event), instanceIdDb(instanceIdDb),
     handler(handler),
     normEventTimer(event, std::bind(&EventHandlerInterface::normalEventCb, this)),
-    critEventTimer(event, std::bind(&EventHandlerInterface::criticalEventCb, this)),
-    pollEventReqTimer(event, std::bind(&EventHandlerInterface::pollEventReqCb, this))
+    normEventCadence(std::chrono::milliseconds(NORMAL_RAS_EVENT_TIMER),
+                     std::chrono::milliseconds(NORMAL_RAS_EVENT_MAX_TIMER)),
+    critEventTimer(event, std::bind(&EventHandlerInterface::criticalEventCb, this),
+                   CRITICAL_RAS_PRIORITY),
+    pollEventReqTimer(event, std::bind(&EventHandlerInterface::pollEventReqCb, this),
+                      CRITICAL_RAS_PRIORITY),
+    drainDeadline(event, std::bind(&EventHandlerInterface::finishDrainNotification,
+                                   this, false)),
+    drainHistogram(pldm::metrics::Registry::get().histogram(
+        "pldm_ras_event_drain_seconds",
+        "Time from an event being queued to the event queues being empty",
+        {{"eid", std::to_string(eid)}}))
 {
     pollReqTimeoutTimer = std::make_unique<phosphor::Timer>(
                                  [&](void) { pollReqTimeoutHdl(); });
+    try
+    {
+        queueCounters = std::make_unique<pldm::utils::DBusCounters>(
+            bus, "/xyz/openbmc_project/pldm/terminus/" + std::to_string(eid),
+            eventQueuesIntf,
+            std::vector<std::string>{
+                "CriticalQueued", "CriticalCoalesced", "CriticalDropped",
+                "CriticalDepth", "OverflowQueued", "OverflowCoalesced",
+                "OverflowDropped", "OverflowDepth"});
+    }
+    catch (const std::exception& e)
+    {
+        error("Failed to export the event queue counters of EID {EID}, "
+              "error={ERROR}", "EID", unsigned(eid), "ERROR", e.what());
+    }
     startCallback();
 }
 
 void EventHandlerInterface::normalEventCb()
 {
-    if (isProcessPolling || isCritical)
+    if (isProcessPolling || isCritical || isBackpressured())
         return;
 
     /* Periodically poll for dummy RAS event data */
@@ -62,11 +112,18 @@ void EventHandlerInterface::criticalEventCb()
 {
     uint16_t eventId = 0;
 
-    if (isProcessPolling)
+    if (isProcessPolling || isBackpressured())
         return;
     if (critEventQueue.empty() && overflowEventQueue.empty())
     {
         isCritical = false;
+        if (drainStart)
+        {
+            drainHistogram.observe(std::chrono::steady_clock::now() -
+                                   *drainStart);
+            drainStart.reset();
+        }
+        checkDrained();
         return;
     }
     if (!overflowEventQueue.empty())
@@ -79,6 +136,7 @@ void EventHandlerInterface::criticalEventCb()
         {
             eventId = critEventQueue.front();
             critEventQueue.pop_front();
+            updateQueueCounters();
         }
     }
     /* Has Critical Event */
@@ -95,52 +153,106 @@ void EventHandlerInterface::criticalEventCb()
 
 int EventHandlerInterface::enqueueCriticalEvent(uint16_t item)
 {
-    if (critEventQueue.size() > MAX_QUEUE_SIZE)
-        return -1;
+    auto rc = pushResultToRc(critEventQueue.push(item));
+    updateQueueCounters();
+    if (!drainStart && !critEventQueue.empty())
+    {
+        drainStart = std::chrono::steady_clock::now();
+    }
+    return rc;
+}
 
-    for (auto& i : critEventQueue)
+int EventHandlerInterface::enqueueOverflowEvent(uint16_t item)
+{
+    auto rc = pushResultToRc(overflowEventQueue.push(item));
+    updateQueueCounters();
+    if (!drainStart && !overflowEventQueue.empty())
     {
-        if (i == item)
-        {
-            return -2;
-        }
+        drainStart = std::chrono::steady_clock::now();
     }
+    return rc;
+}
 
-#ifdef DEBUG
-    std::cout << "\nQUEUING CRIT EVENT_ID " << std::hex << item << "\n";
-#endif
-    // insert to event queue
-    critEventQueue.push_back(item);
+void EventHandlerInterface::clearOverflow()
+{
+    if (!overflowEventQueue.empty())
+    {
+        overflowEventQueue.pop_front();
+        updateQueueCounters();
+    }
+}
 
-    return 0;
+void EventHandlerInterface::updateQueueCounters()
+{
+    if (!queueCounters)
+    {
+        return;
+    }
+    size_t index = 0;
+    for (const auto* queue : {&critEventQueue, &overflowEventQueue})
+    {
+        const auto& counters = queue->getCounters();
+        queueCounters->set(index++, counters.queued);
+        queueCounters->set(index++, counters.coalesced);
+        queueCounters->set(index++, counters.dropped);
+        queueCounters->set(index++, queue->size());
+    }
 }
 
-int EventHandlerInterface::enqueueOverflowEvent(uint16_t item)
+void EventHandlerInterface::notifyWhenDrained(std::chrono::milliseconds deadline,
+                                              DrainCallback callback)
 {
-    if (overflowEventQueue.size() > MAX_QUEUE_SIZE)
-        return -1;
+    drainCallback = std::move(callback);
+    drainDeadline.restartOnce(deadline);
+    checkDrained();
+}
 
-    for (auto& i : overflowEventQueue)
+void EventHandlerInterface::checkDrained()
+{
+    if (drainCallback && areRASQueuesDrained())
     {
-        if (i == item)
-        {
-            return -2;
-        }
+        finishDrainNotification(true);
     }
+}
 
-#ifdef DEBUG
-    std::cout << "\nQUEUING OVERFLOW EVENT_ID " << std::hex << item << "\n";
-#endif
-    // insert to event queue
-    overflowEventQueue.push_back(item);
+void EventHandlerInterface::finishDrainNotification(bool drained)
+{
+    drainDeadline.setEnabled(false);
+    /* The callback may register the next notification */
+    auto callback = std::move(drainCallback);
+    drainCallback = nullptr;
+    if (callback)
+    {
+        callback(drained);
+    }
+}
 
-    return 0;
+void EventHandlerInterface::applyPollCadence(std::chrono::milliseconds base,
+                                             std::chrono::milliseconds max)
+{
+    normEventCadence.reset(base, max);
+    /* The quiesce drain polls at its own pace */
+    if (normEventTimer.isEnabled() && !isInQuiesceMode)
+    {
+        normEventTimer.setInterval(normEventCadence.current());
+        normEventTimer.setRemaining(
+            pollPhase.shifted(1.0 / 3).delay(normEventCadence.current()));
+    }
 }
 
-void EventHandlerInterface::clearOverflow()
+void EventHandlerInterface::setPollPhase(const PollPhase& phase)
 {
-    if (!overflowEventQueue.empty())
-        overflowEventQueue.pop_front();
+    pollPhase = phase;
+    if (normEventTimer.isEnabled() && !isInQuiesceMode)
+    {
+        normEventTimer.setRemaining(
+            pollPhase.shifted(1.0 / 3).delay(normEventCadence.current()));
+    }
+    if (critEventTimer.isEnabled())
+    {
+        critEventTimer.setRemaining(pollPhase.shifted(2.0 / 3).delay(
+            std::chrono::milliseconds(CRITICAL_RAS_EVENT_TIMER)));
+    }
 }
 
 void EventHandlerInterface::pollReqTimeoutHdl()
@@ -171,6 +283,7 @@ void EventHandlerInterface::resetCacheAndFlags()
     recvData.eventClass = 0;
     recvData.totalSize = 0;
     recvData.data.clear();
+    recvData.crc.reset();
     pollEventReqTimer.setEnabled(false);
 }
 
@@ -240,9 +353,15 @@ void EventHandlerInterface::processResponseMsg(mctp_eid_t /*eid*/,
         {
             clearOverflow();
             mProRASQueuesAreEmpty = true;
+            if (!isInQuiesceMode)
+            {
+                normEventTimer.setInterval(normEventCadence.idle());
+            }
+            checkDrained();
         }
         else /* MPro RAS queues are NOT empty */
         {
+            normEventTimer.setInterval(normEventCadence.busy());
             if (isInQuiesceMode)
             {
                 // In quiesce mode, dummy poll all remaining RAS as fast as possible
@@ -259,46 +378,49 @@ void EventHandlerInterface::processResponseMsg(mctp_eid_t /*eid*/,
 
     // found
     mProRASQueuesAreEmpty = false;
+    normEventTimer.setInterval(normEventCadence.busy());
     int flag = static_cast<int>(retTransferFlag);
-    std::vector<uint8_t> retEventData(retEventDataSize, 0);
-    memcpy(retEventData.data(), eventData, retEventDataSize);
+    std::span<const uint8_t> part(eventData, retEventDataSize);
 
-    if (flag == PLDM_START)            /* Start part */
+    if (flag == PLDM_START || flag == PLDM_START_AND_END)
     {
-        recvData.data.insert(recvData.data.begin(),
-                             retEventData.begin(),
-                             retEventData.begin() + retEventDataSize);
-        recvData.totalSize += retEventDataSize;
-        reqData.operationFlag = PLDM_GET_NEXTPART;
-        reqData.dataTransferHandle = retNextDataTransferHandle;
-        reqData.eventIdToAck = 0xffff;
+        recvData.data.clear();
+        recvData.crc.reset();
+        recvData.totalSize = 0;
+        /* A moved-out buffer has no capacity, reserve for the largest event
+         * so far to append the parts without reallocation */
+        recvData.data.reserve(std::max(recvData.largestSize, part.size()));
     }
-    else if (flag == PLDM_MIDDLE)       /* Middle part */
+
+    /* The parts are requested one by one so they arrive in order and are
+     * appended in place, the checksum catches a lost part */
+    recvData.data.insert(recvData.data.end(), part.begin(), part.end());
+    recvData.crc.update(part);
+    recvData.totalSize += retEventDataSize;
+
+    if (flag == PLDM_START || flag == PLDM_MIDDLE)
     {
-        recvData.data.insert(recvData.data.begin() + reqData.dataTransferHandle,
-                             retEventData.begin(),
-                             retEventData.begin() + retEventDataSize);
-        recvData.totalSize += retEventDataSize;
         reqData.operationFlag = PLDM_GET_NEXTPART;
         reqData.dataTransferHandle = retNextDataTransferHandle;
         reqData.eventIdToAck = 0xffff;
     }
     else if ((flag == PLDM_END) || (flag == PLDM_START_AND_END))  /* End part */
     {
-        recvData.data.insert(recvData.data.begin() + reqData.dataTransferHandle,
-                             retEventData.begin(),
-                             retEventData.begin() + retEventDataSize);
-        recvData.totalSize += retEventDataSize;
+        recvData.largestSize =
+            std::max(recvData.largestSize, recvData.data.size());
 
         /* eventDataIntegrityChecksum field is only used for multi-part transfer.
          * If single-part, ignore checksum.
          */
-        uint32_t checksum = crc32(recvData.data.data(), recvData.data.size());
+        uint32_t checksum = recvData.crc.value();
         if ((flag == PLDM_END) && (checksum != retEventDataIntegrityChecksum))
         {
-            std::cerr << "\nchecksum isn't correct chks=" << std::hex << checksum
-                      << " eventDataCRC=" << std::hex
-                      << retEventDataIntegrityChecksum << "\n ";
+            PLDM_LOG_RATE_LIMITED(error,
+                                  "Mismatched checksum of event {ID} from EID "
+                                  "{EID}, computed {CRC} received {EXPECTED}",
+                                  "ID", retEventId, "EID", unsigned(eid),
+                                  "CRC", lg2::hex, checksum, "EXPECTED",
+                                  lg2::hex, retEventDataIntegrityChecksum);
         }
         else
         {
@@ -306,37 +428,28 @@ void EventHandlerInterface::processResponseMsg(mctp_eid_t /*eid*/,
             auto it = eventHndls.find(retEventClass);
             if (it != eventHndls.end())
             {
-                eventHndls.at(retEventClass)(retTid, retEventClass,
-                            retEventId, recvData.data);
+                it->second(retTid, retEventClass, retEventId,
+                           std::move(recvData.data));
             }
         }
+        recvData.data.clear();
 
         reqData.operationFlag = PLDM_ACKNOWLEDGEMENT_ONLY;
         reqData.dataTransferHandle = 0;
         reqData.eventIdToAck = retEventId;
     }
-#ifdef DEBUG
-        std::cout << "\nEVENT_ID:" << retEventId
-                  << " DATA LENGTH:" << recvData.totalSize << "\n ";
-        for (auto it = recvData.data.begin(); it != recvData.data.end(); it++)
-        {
-            std::cout << std::setfill('0') << std::setw(2) << std::hex
-                      << (unsigned)*it << " ";
-        }
-        std::cout << "\n";
-#endif
 
 }
 
 void EventHandlerInterface::pollEventReqCb()
 {
-    std::vector<uint8_t> requestMsg(sizeof(pldm_msg_hdr) +
-                         PLDM_POLL_FOR_PLATFORM_EVENT_MESSAGE_REQ_BYTES);
-    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
-
     if (isPolling)
         return;
 
+    auto requestMsg = pldm::utils::RequestPool::acquire(
+        sizeof(pldm_msg_hdr) + PLDM_POLL_FOR_PLATFORM_EVENT_MESSAGE_REQ_BYTES);
+    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+
 #ifdef DEBUG
     std::cout << "\nREQUEST \n"
               << "TransferoperationFlag: " << std::hex << (unsigned)reqData.operationFlag << "\n"
@@ -353,9 +466,10 @@ void EventHandlerInterface::pollEventReqCb()
     if (rc != PLDM_SUCCESS)
     {
         instanceIdDb.free(eid, instanceId);
-        std::cerr
-            << "ERROR: Failed to encode_poll_for_platform_event_message_req(1), rc = "
-            << rc << std::endl;
+        PLDM_LOG_RATE_LIMITED(error,
+                              "Failed to encode the poll request of EID "
+                              "{EID}, rc={RC}",
+                              "EID", unsigned(eid), "RC", rc);
         return;
     }
 
@@ -363,10 +477,14 @@ void EventHandlerInterface::pollEventReqCb()
         eid, instanceId, PLDM_PLATFORM, PLDM_POLL_FOR_PLATFORM_EVENT_MESSAGE,
         std::move(requestMsg),
         std::move(
-            std::bind_front(&EventHandlerInterface::processResponseMsg, this)));
+            std::bind_front(&EventHandlerInterface::processResponseMsg, this)),
+        pldm::requester::RequestPriority::CriticalRas);
     if (rc)
     {
-        std::cerr << "ERROR: failed to send the poll request\n";
+        PLDM_LOG_RATE_LIMITED(error,
+                              "Failed to send the poll request to EID {EID}, "
+                              "rc={RC}",
+                              "EID", unsigned(eid), "RC", rc);
         return;
     }
 
@@ -387,13 +505,17 @@ void EventHandlerInterface::startCallback()
             std::bind(&EventHandlerInterface::criticalEventCb, this));
     try
     {
-        normEventTimer.restart(std::chrono::milliseconds(NORMAL_RAS_EVENT_TIMER));
+        normEventTimer.restart(normEventCadence.busy());
+        normEventTimer.setRemaining(
+            pollPhase.shifted(1.0 / 3).delay(normEventCadence.current()));
         critEventTimer.restart(std::chrono::milliseconds(CRITICAL_RAS_EVENT_TIMER));
+        critEventTimer.setRemaining(pollPhase.shifted(2.0 / 3).delay(
+            std::chrono::milliseconds(CRITICAL_RAS_EVENT_TIMER)));
     }
     catch (const std::exception& e)
     {
-        std::cerr << "ERROR: cannot start callback for normal"
-                     " and critical event" << std::endl;
+        error("Failed to start the RAS event polling of EID {EID}, "
+              "error={ERROR}", "EID", unsigned(eid), "ERROR", e.what());
         throw;
     }
 }
@@ -407,7 +529,8 @@ void EventHandlerInterface::stopCallback()
     }
     catch (const std::exception& e)
     {
-        std::cerr << "ERROR: cannot stop callback" << std::endl;
+        error("Failed to stop the RAS event polling of EID {EID}, "
+              "error={ERROR}", "EID", unsigned(eid), "ERROR", e.what());
         throw;
     }
 }
@@ -427,12 +550,35 @@ void EventHandlerInterface::addEventMsg(uint8_t eventId, uint8_t eventType,
                                         uint8_t eventClass)
 {
     if (eventType == PLDM_MESSAGE_POLL_EVENT)
+    {
         enqueueCriticalEvent(eventId);
+        if (pushMode)
+        {
+            /* Send the first poll of the event now instead of at the next
+             * tick of the critical timer, a transfer in progress picks the
+             * event from the queue when it is done */
+            if (!isProcessPolling && !isBackpressured() &&
+                critEventTimer.isEnabled())
+            {
+                criticalEventCb();
+                if (isCritical)
+                {
+                    pollEventReqCb();
+                }
+            }
+        }
+        /* The terminus is active again, poll the normal RAS at the base
+         * interval instead of waiting out the backed off one */
+        else if (normEventCadence.isBackedOff() && normEventTimer.isEnabled())
+        {
+            normEventTimer.setInterval(normEventCadence.busy());
+            normEventTimer.setRemaining(normEventCadence.current());
+        }
+    }
     if ((eventType == PLDM_SENSOR_EVENT) &&
         (eventClass == PLDM_NUMERIC_SENSOR_STATE))
     {
         // add the priority
-        std::cerr << "Overflow: " << eventId << "\n";
         enqueueOverflowEvent(eventId);
     }
 #ifdef AMPERE
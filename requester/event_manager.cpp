@@ -1,6 +1,9 @@
 #include "common/types.hpp"
+#include "common/rate_limited_log.hpp"
 #include "common/utils.hpp"
 
+#include <endian.h>
+
 #include <sdeventplus/event.hpp>
 #include <sdeventplus/source/event.hpp>
 #include <phosphor-logging/lg2.hpp>
@@ -11,6 +14,7 @@
 #include <unordered_map>
 #include <libpldm/pldm.h>
 #include <algorithm>
+#include <cstring>
 #include <map>
 #include <string_view>
 #include <vector>
@@ -53,12 +57,29 @@ int EventManager::handleMessagePollEvent(const pldm_msg* request,
     return PLDM_SUCCESS;
 }
 
+int EventManager::handleHeartbeatEvent(const pldm_msg* /* request */,
+                                       size_t /* payloadLength */,
+                                       uint8_t /* formatVersion */,
+                                       uint8_t tid,
+                                       size_t /* eventDataOffset */)
+{
+    if (!devManager || !devManager->refreshLiveness(tid))
+    {
+        return PLDM_ERROR;
+    }
+    return PLDM_SUCCESS;
+}
+
 int EventManager::handleSensorEvent(const pldm_msg* request,
                                           size_t payloadLength,
                                           uint8_t /* formatVersion */,
                                           uint8_t tid,
                                           size_t eventDataOffset)
 {
+    if (devManager)
+    {
+        devManager->refreshLiveness(tid);
+    }
     uint16_t sensorId = 0;
     uint8_t sensorEventClassType = 0;
     size_t eventClassDataOffset = 0;
@@ -95,6 +116,94 @@ int EventManager::handleSensorEvent(const pldm_msg* request,
     return PLDM_SUCCESS;
 }
 
+int EventManager::handlePDRRepositoryChgEvent(const pldm_msg* request,
+                                              size_t payloadLength,
+                                              uint8_t /* formatVersion */,
+                                              uint8_t tid,
+                                              size_t eventDataOffset)
+{
+    if (devManager)
+    {
+        devManager->refreshLiveness(tid);
+    }
+    uint8_t eventDataFormat = 0;
+    uint8_t numberOfChangeRecords = 0;
+    size_t dataOffset = 0;
+    auto eventData = reinterpret_cast<const uint8_t*>(request->payload) +
+                     eventDataOffset;
+    auto eventDataSize = payloadLength - eventDataOffset;
+
+    auto rc = decode_pldm_pdr_repository_chg_event_data(
+        eventData, eventDataSize, &eventDataFormat, &numberOfChangeRecords,
+        &dataOffset);
+    if (rc)
+    {
+        lg2::error("Failed to decode PDR repository change event data, "
+                   "rc={RC}.", "RC", rc);
+        return rc;
+    }
+
+    if (eventDataFormat != FORMAT_IS_PDR_HANDLES)
+    {
+        lg2::info("unhandled PDR repository change event, tid={TID}, "
+                  "format={FORMAT}", "TID", tid, "FORMAT", eventDataFormat);
+        return PLDM_ERROR;
+    }
+
+    std::vector<uint32_t> removedHandles;
+    std::vector<uint32_t> fetchedHandles;
+    auto changeRecordData = eventData + dataOffset;
+    auto changeRecordDataSize = eventDataSize - dataOffset;
+    while (changeRecordDataSize)
+    {
+        uint8_t eventDataOperation = 0;
+        uint8_t numberOfChangeEntries = 0;
+        rc = decode_pldm_pdr_repository_change_record_data(
+            changeRecordData, changeRecordDataSize, &eventDataOperation,
+            &numberOfChangeEntries, &dataOffset);
+        if (rc)
+        {
+            lg2::error("Failed to decode PDR repository change record, "
+                       "rc={RC}.", "RC", rc);
+            return rc;
+        }
+
+        auto entriesSize = numberOfChangeEntries * sizeof(uint32_t);
+        if (changeRecordDataSize - dataOffset < entriesSize)
+        {
+            return PLDM_ERROR_INVALID_DATA;
+        }
+        for (size_t i = 0; i < numberOfChangeEntries; i++)
+        {
+            uint32_t recordHandle = 0;
+            memcpy(&recordHandle,
+                   changeRecordData + dataOffset + i * sizeof(uint32_t),
+                   sizeof(uint32_t));
+            recordHandle = le32toh(recordHandle);
+            if (eventDataOperation == PLDM_RECORDS_DELETED ||
+                eventDataOperation == PLDM_RECORDS_MODIFIED)
+            {
+                removedHandles.push_back(recordHandle);
+            }
+            if (eventDataOperation == PLDM_RECORDS_ADDED ||
+                eventDataOperation == PLDM_RECORDS_MODIFIED)
+            {
+                fetchedHandles.push_back(recordHandle);
+            }
+        }
+
+        changeRecordData += dataOffset + entriesSize;
+        changeRecordDataSize -= dataOffset + entriesSize;
+    }
+
+    if (!devManager ||
+        !devManager->updatePDRs(tid, removedHandles, fetchedHandles))
+    {
+        return PLDM_ERROR;
+    }
+    return PLDM_SUCCESS;
+}
+
 int EventManager::processNumericSensorEvent(uint8_t tid, uint16_t sensorId,
                                             const uint8_t* sensorData,
                                             size_t sensorDataLength)
@@ -125,10 +234,55 @@ int EventManager::processNumericSensorEvent(uint8_t tid, uint16_t sensorId,
     {
         handleMCStateSensorEvent(tid, sensorId, presentReading, eventState);
     }
+    // Event driven compact numeric sensors
+    else if (devManager)
+    {
+        SensorEventCoalescer::Event sensorEvent{tid, sensorId, eventState,
+                                                sensorDataSize, presentReading};
+        if (!coalescer)
+        {
+            updateSensor(sensorEvent);
+        }
+        else if (coalescer->add(sensorEvent,
+                                SensorEventCoalescer::Clock::now()))
+        {
+            updateSensor(sensorEvent);
+            if (!coalesceTimer->isEnabled())
+            {
+                releaseSensorEvents();
+            }
+        }
+    }
 
     return PLDM_SUCCESS;
 }
 
+void EventManager::updateSensor(const SensorEventCoalescer::Event& event)
+{
+    devManager->updateSensorFromEvent(event.tid, event.sensorId,
+                                      event.sensorDataSize,
+                                      event.presentReading);
+}
+
+void EventManager::releaseSensorEvents()
+{
+    auto now = SensorEventCoalescer::Clock::now();
+    for (const auto& event : coalescer->expire(now))
+    {
+        updateSensor(event);
+    }
+
+    auto deadline = coalescer->nextDeadline();
+    if (!deadline)
+    {
+        coalesceTimer->setEnabled(false);
+        return;
+    }
+    coalesceTimer->restartOnce(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::max(*deadline - now, SensorEventCoalescer::Clock::duration{})));
+}
+
 void EventManager::handleMCStateSensorEvent(uint8_t tid,
                 [[maybe_unused]]uint16_t sensorId, uint32_t presentReading, [[maybe_unused]]uint8_t eventState)
 {
@@ -146,7 +300,8 @@ void EventManager::handleMCStateSensorEvent(uint8_t tid,
      * Bit 0       |   Indicates FW update initiated (1 bit)
      */
 
-    std::cerr << "DEBUG: HandleMCStateSensorEvent presentReading is " << unsigned(presentReading) << "\n";
+    PLDM_LOG_RATE_LIMITED(info, "MC state sensor event, present reading {VALUE}",
+                          "VALUE", lg2::hex, presentReading);
 
     uint8_t fwUpdateInitiated = (presentReading & 0x00000001);
     uint8_t fwUpdateComplete = (presentReading & 0x00000004) >> 2;
@@ -1,8 +1,16 @@
 #pragma once
 
+#include "requester/sensor_event_coalescer.hpp"
 #include "requester/terminus_manager.hpp"
 
 #include <sdbusplus/bus/match.hpp>
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/utility/timer.hpp>
+
+#include <chrono>
+#include <functional>
+#include <optional>
 
 namespace pldm
 {
@@ -17,10 +25,23 @@ class EventManager
     EventManager& operator=(EventManager&&) = delete;
     ~EventManager() = default;
 
-    explicit EventManager(terminus::Manager *dev):
+    /** @brief Constructor
+     *
+     *  @param[in] dev - manager of the termini
+     *  @param[in] event - event loop releasing the coalesced sensor events
+     *  @param[in] coalesceWindow - time the numeric sensor events of a
+     *                              sensor are coalesced, 0 handles each one
+     */
+    explicit EventManager(terminus::Manager* dev, sdeventplus::Event& event,
+                          std::chrono::milliseconds coalesceWindow) :
         devManager(dev)
     {
-
+        if (coalesceWindow.count() > 0)
+        {
+            coalescer.emplace(coalesceWindow);
+            coalesceTimer.emplace(
+                event, std::bind(&EventManager::releaseSensorEvents, this));
+        }
     }
 
     int handleMessagePollEvent(const pldm_msg* request,
@@ -31,6 +52,17 @@ class EventManager
                            size_t payloadLength,
                            uint8_t /* formatVersion */, uint8_t tid,
                            size_t eventDataOffset);
+    int handlePDRRepositoryChgEvent(const pldm_msg* request,
+                                    size_t payloadLength,
+                                    uint8_t /* formatVersion */, uint8_t tid,
+                                    size_t eventDataOffset);
+
+    /** @brief Note the heartbeat of a terminus, the events of the other
+     *         classes being heartbeats as well
+     */
+    int handleHeartbeatEvent(const pldm_msg* request, size_t payloadLength,
+                             uint8_t /* formatVersion */, uint8_t tid,
+                             size_t eventDataOffset);
 
   protected:
 
@@ -42,7 +74,21 @@ class EventManager
                 uint32_t presentReading, [[maybe_unused]]uint8_t eventState);
 
 
+    /** @brief Update a sensor from its numeric sensor event */
+    void updateSensor(const SensorEventCoalescer::Event& event);
+
+    /** @brief Handle the coalesced events of the windows which ended and
+     *         arm the timer at the next window end
+     */
+    void releaseSensorEvents();
+
     terminus::Manager *devManager;
+
+    /** @brief Coalescer of the numeric sensor events, unset if disabled */
+    std::optional<SensorEventCoalescer> coalescer;
+    std::optional<
+        sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>>
+        coalesceTimer;
 };
 
 
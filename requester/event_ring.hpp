@@ -0,0 +1,153 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace pldm
+{
+
+/** @brief What an EventRing does with a new event once it is full */
+enum class RingFullPolicy
+{
+    DropNewest, //!< Keep the queued events, drop the new one
+    DropOldest, //!< Evict the oldest queued event for the new one
+};
+
+/** @brief Outcome of EventRing::push */
+enum class RingPushResult
+{
+    Queued,    //!< The event is queued
+    Coalesced, //!< The event is already queued
+    Dropped,   //!< The ring is full and the new event is dropped
+    Evicted,   //!< The ring is full and the oldest event is dropped
+};
+
+/** @struct RingCounters
+ *  @brief Accounting of the events pushed to an EventRing
+ */
+struct RingCounters
+{
+    uint64_t queued = 0;
+    uint64_t coalesced = 0;
+    uint64_t dropped = 0;
+};
+
+/** @class EventRing
+ *
+ *  Fixed capacity FIFO of event IDs. The storage is allocated once, a push
+ *  never allocates. A push of an event which is already queued is coalesced
+ *  into it when enabled, a push to a full ring follows the full policy.
+ */
+template <typename T, size_t N>
+class EventRing
+{
+  public:
+    /** @brief Constructor
+     *
+     *  @param[in] policy - what to do with a new event once the ring is full
+     *  @param[in] coalesce - whether a duplicate of a queued event is
+     *                        coalesced into it
+     */
+    EventRing(RingFullPolicy policy, bool coalesce) :
+        policy(policy), coalesce(coalesce)
+    {}
+
+    static constexpr size_t capacity()
+    {
+        return N;
+    }
+
+    size_t size() const
+    {
+        return count;
+    }
+
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    /** @brief Oldest queued event, the ring must not be empty */
+    const T& front() const
+    {
+        return items[head];
+    }
+
+    /** @brief Remove the oldest queued event, no-op if the ring is empty */
+    void pop_front()
+    {
+        if (count)
+        {
+            head = (head + 1) % N;
+            count--;
+        }
+    }
+
+    void clear()
+    {
+        head = 0;
+        count = 0;
+    }
+
+    /** @brief Whether an event is queued */
+    bool contains(const T& item) const
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            if (items[(head + i) % N] == item)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /** @brief Queue an event
+     *
+     *  @param[in] item - event
+     *
+     *  @return - what happened to the event
+     */
+    RingPushResult push(const T& item)
+    {
+        if (coalesce && contains(item))
+        {
+            counters.coalesced++;
+            return RingPushResult::Coalesced;
+        }
+
+        auto result = RingPushResult::Queued;
+        if (count == N)
+        {
+            counters.dropped++;
+            if (policy == RingFullPolicy::DropNewest)
+            {
+                return RingPushResult::Dropped;
+            }
+            pop_front();
+            result = RingPushResult::Evicted;
+        }
+        items[(head + count) % N] = item;
+        count++;
+        counters.queued++;
+        return result;
+    }
+
+    /** @brief Accounting of the pushed events */
+    const RingCounters& getCounters() const
+    {
+        return counters;
+    }
+
+  private:
+    std::array<T, N> items{};
+    size_t head = 0;
+    size_t count = 0;
+    RingFullPolicy policy;
+    bool coalesce;
+    RingCounters counters;
+};
+
+} // namespace pldm
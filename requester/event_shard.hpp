@@ -0,0 +1,102 @@
+#pragma once
+
+#include <systemd/sd-event.h>
+
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/event.hpp>
+#include <sdeventplus/source/io.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+
+namespace pldm
+{
+namespace requester
+{
+
+/** @class EventShard
+ *
+ *  Event loop of one terminus nested in the main event loop. The timers and
+ *  sources of the terminus are added to the shard, the main loop wakes up
+ *  on the epoll fd of the shard and dispatches at most a budget of its
+ *  callbacks before it gets back to the other sources and shards, so that a
+ *  terminus flooding its loop does not starve the others. The shard is also
+ *  dispatched after each callback of the main loop, that re-arms its timers
+ *  changed from outside of it. Everything still runs on the main thread,
+ *  the D-Bus connection and the requester Handler are shared.
+ */
+class EventShard
+{
+  public:
+    EventShard() = delete;
+    EventShard(const EventShard&) = delete;
+    EventShard& operator=(const EventShard&) = delete;
+
+    /** @brief Constructor
+     *
+     *  @param[in] parent - main event loop
+     *  @param[in] budget - max number of callbacks dispatched per wakeup
+     */
+    EventShard(sdeventplus::Event& parent, size_t budget) :
+        event(sdeventplus::Event::get_new()),
+        budget(std::max<size_t>(budget, 1)),
+        io(parent, sd_event_get_fd(event.get()), EPOLLIN,
+           [this](sdeventplus::source::IO&, int, uint32_t) { dispatch(); }),
+        post(parent,
+             [this](sdeventplus::source::EventBase&) { dispatch(); }),
+        resume(parent,
+               [this](sdeventplus::source::EventBase&) { dispatch(); })
+    {
+        /* Arm the sources added before the main loop runs */
+        resume.set_enabled(sdeventplus::source::Enabled::OneShot);
+    }
+
+    /** @brief Event loop of the shard */
+    sdeventplus::Event& get()
+    {
+        return event;
+    }
+
+    /** @brief Dispatch the pending callbacks of the shard, within the budget
+     *
+     *  @return - number of callbacks dispatched
+     */
+    size_t dispatch()
+    {
+        /* A callback of the shard never runs the main loop, the shard is
+         * not entered twice */
+        if (dispatching)
+        {
+            return 0;
+        }
+        dispatching = true;
+        size_t dispatched = 0;
+        while (dispatched < budget &&
+               event.run(std::chrono::microseconds::zero()) > 0)
+        {
+            dispatched++;
+        }
+        dispatching = false;
+
+        /* The rest waits for the next iteration of the main loop */
+        resume.set_enabled(dispatched < budget
+                               ? sdeventplus::source::Enabled::Off
+                               : sdeventplus::source::Enabled::OneShot);
+        return dispatched;
+    }
+
+  private:
+    sdeventplus::Event event;
+    size_t budget;
+    bool dispatching = false;
+    /** @brief Wakes up the main loop when a source of the shard is ready */
+    sdeventplus::source::IO io;
+    /** @brief Dispatches the shard after each callback of the main loop */
+    sdeventplus::source::Post post;
+    /** @brief Dispatches the rest once the budget is spent */
+    sdeventplus::source::Defer resume;
+};
+
+} // namespace requester
+} // namespace pldm
@@ -0,0 +1,240 @@
+#include "requester/file_reader.hpp"
+
+#include "common/transfer_size.hpp"
+#include "common/utils.hpp"
+#include "requester/file_transfer.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+
+namespace file_transfer
+{
+
+requester::Coroutine FileReader::read(uint16_t fileIdentifier, uint32_t size,
+                                      std::filesystem::path path)
+{
+    Context ctx{eid, instanceIdDb, handler, cancellation.token()};
+
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                    0644);
+    if (fd < 0)
+    {
+        error("Failed to create {PATH}, errno={ERRNO}", "PATH", path.string(),
+              "ERRNO", errno);
+        co_return PLDM_ERROR;
+    }
+
+    uint16_t descriptor = 0;
+    auto rc = co_await open(ctx, fileIdentifier, descriptor);
+    if (rc == PLDM_SUCCESS)
+    {
+        uint32_t sectionLength = transfer::TransferSizes::get().partSize(
+            ctx.eid, transfer::baselinePartSize);
+        std::vector<uint32_t> offsets;
+        offsets.reserve(size / sectionLength + 1);
+        for (uint32_t offset = 0; offset < size; offset += sectionLength)
+        {
+            offsets.push_back(offset);
+        }
+
+        rc = co_await requester::forEach(
+            std::move(offsets), window,
+            [ctx, descriptor, size, sectionLength, fd](uint32_t offset) {
+                return readSection(ctx, descriptor, offset,
+                                   std::min(sectionLength, size - offset), fd);
+            },
+            ctx.token);
+
+        /* The descriptor is released even if the read failed */
+        auto closeRc = co_await close(ctx, descriptor);
+        if (rc == PLDM_SUCCESS)
+        {
+            rc = closeRc;
+        }
+    }
+
+    ::close(fd);
+    if (rc != PLDM_SUCCESS)
+    {
+        error(
+            "Failed to read file {ID} of EID {EID} to {PATH}, rc={RC}", "ID",
+            fileIdentifier, "EID", unsigned(ctx.eid), "PATH", path.string(),
+            "RC", unsigned(rc));
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+    co_return rc;
+}
+
+requester::Coroutine FileReader::open(Context ctx, uint16_t fileIdentifier,
+                                      uint16_t& descriptor)
+{
+    if (ctx.token.cancelled())
+    {
+        co_return PLDM_ERROR;
+    }
+
+    Request requestMsg(sizeof(pldm_msg_hdr) + PLDM_DF_OPEN_REQ_BYTES);
+    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+    auto instanceId = ctx.instanceIdDb.next(ctx.eid);
+    auto rc = encodeDfOpenReq(instanceId, fileIdentifier, 0, request,
+                              PLDM_DF_OPEN_REQ_BYTES);
+    if (rc != PLDM_SUCCESS)
+    {
+        ctx.instanceIdDb.free(ctx.eid, instanceId);
+        co_return rc;
+    }
+
+    Response responseMsg{};
+    rc = co_await requester::sendRecvPldmMsg(*ctx.handler, ctx.eid, requestMsg,
+                                             responseMsg);
+    if (rc)
+    {
+        co_return rc;
+    }
+    if (responseMsg.size() <= sizeof(pldm_msg_hdr))
+    {
+        co_return PLDM_ERROR;
+    }
+
+    uint8_t cc = 0;
+    auto response = reinterpret_cast<const pldm_msg*>(responseMsg.data());
+    rc = decodeDfOpenResp(response, responseMsg.size() - sizeof(pldm_msg_hdr),
+                          cc, descriptor);
+    if (rc != PLDM_SUCCESS)
+    {
+        co_return rc;
+    }
+    co_return cc;
+}
+
+requester::Coroutine FileReader::readSection(Context ctx, uint16_t descriptor,
+                                             uint32_t offset, uint32_t length,
+                                             int fd)
+{
+    auto operation = TransferOperation::FirstPart;
+    uint32_t dataTransferHandle = 0;
+    uint32_t received = 0;
+    pldm::utils::Crc32 crc;
+
+    while (true)
+    {
+        if (ctx.token.cancelled())
+        {
+            co_return PLDM_ERROR;
+        }
+
+        Request requestMsg(sizeof(pldm_msg_hdr) +
+                           PLDM_MULTIPART_RECEIVE_REQ_BYTES);
+        auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+        auto instanceId = ctx.instanceIdDb.next(ctx.eid);
+        auto rc = encodeMultipartReceiveReq(
+            instanceId, operation, descriptor, dataTransferHandle, offset,
+            length, request, PLDM_MULTIPART_RECEIVE_REQ_BYTES);
+        if (rc != PLDM_SUCCESS)
+        {
+            ctx.instanceIdDb.free(ctx.eid, instanceId);
+            co_return rc;
+        }
+
+        Response responseMsg{};
+        rc = co_await requester::sendRecvPldmMsg(*ctx.handler, ctx.eid,
+                                                 requestMsg, responseMsg);
+        if (rc)
+        {
+            co_return rc;
+        }
+        if (responseMsg.size() <= sizeof(pldm_msg_hdr))
+        {
+            co_return PLDM_ERROR;
+        }
+
+        uint8_t cc = 0;
+        MultipartPart part{};
+        auto response = reinterpret_cast<const pldm_msg*>(responseMsg.data());
+        rc = decodeMultipartReceiveResp(
+            response, responseMsg.size() - sizeof(pldm_msg_hdr), cc, part);
+        if (rc != PLDM_SUCCESS)
+        {
+            co_return rc;
+        }
+        if (cc != PLDM_SUCCESS)
+        {
+            co_return cc;
+        }
+        if (part.data.size() > length - received)
+        {
+            error("Section at {OFFSET} of EID {EID} is too long", "OFFSET",
+                  offset, "EID", unsigned(ctx.eid));
+            co_return PLDM_ERROR_INVALID_LENGTH;
+        }
+
+        if (::pwrite(fd, part.data.data(), part.data.size(),
+                     offset + received) !=
+            static_cast<ssize_t>(part.data.size()))
+        {
+            error("Failed to write the section at {OFFSET}, errno={ERRNO}",
+                  "OFFSET", offset, "ERRNO", errno);
+            co_return PLDM_ERROR;
+        }
+        crc.update(part.data);
+        received += part.data.size();
+
+        if (part.transferFlag == PLDM_END ||
+            part.transferFlag == PLDM_START_AND_END)
+        {
+            if (received != length || crc.value() != part.sectionCrc)
+            {
+                error("Bad section at {OFFSET} of EID {EID}, {SIZE} bytes",
+                      "OFFSET", offset, "EID", unsigned(ctx.eid), "SIZE",
+                      received);
+                co_return PLDM_ERROR_INVALID_DATA;
+            }
+            co_return PLDM_SUCCESS;
+        }
+
+        operation = TransferOperation::NextPart;
+        dataTransferHandle = part.nextDataTransferHandle;
+    }
+}
+
+requester::Coroutine FileReader::close(Context ctx, uint16_t descriptor)
+{
+    Request requestMsg(sizeof(pldm_msg_hdr) + PLDM_DF_CLOSE_REQ_BYTES);
+    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+    auto instanceId = ctx.instanceIdDb.next(ctx.eid);
+    auto rc = encodeDfCloseReq(instanceId, descriptor, 0, request,
+                               PLDM_DF_CLOSE_REQ_BYTES);
+    if (rc != PLDM_SUCCESS)
+    {
+        ctx.instanceIdDb.free(ctx.eid, instanceId);
+        co_return rc;
+    }
+
+    Response responseMsg{};
+    rc = co_await requester::sendRecvPldmMsg(*ctx.handler, ctx.eid, requestMsg,
+                                             responseMsg);
+    if (rc)
+    {
+        co_return rc;
+    }
+    if (responseMsg.size() <= sizeof(pldm_msg_hdr))
+    {
+        co_return PLDM_ERROR;
+    }
+    auto response = reinterpret_cast<const pldm_msg*>(responseMsg.data());
+    co_return response->payload[0];
+}
+
+} // namespace file_transfer
+
+} // namespace pldm
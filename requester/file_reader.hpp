@@ -0,0 +1,107 @@
+#pragma once
+
+#include "common/instance_id.hpp"
+#include "requester/coroutine_tools.hpp"
+#include "requester/handler.hpp"
+
+#include <cstdint>
+#include <filesystem>
+
+namespace pldm
+{
+
+namespace file_transfer
+{
+
+/** @class FileReader
+ *
+ *  Reads the files of a terminus with DSP0242 File Transfer: the file is
+ *  opened with DfOpen, its sections are read with MultipartReceive, several
+ *  of them in flight at a time, and written to disk at their offsets as they
+ *  arrive, then the descriptor is closed with DfClose. A section is one part
+ *  of the size negotiated with the terminus, the CRC-32 of each section is
+ *  checked. The reads stop when the reader is destroyed.
+ */
+class FileReader
+{
+  public:
+    FileReader() = delete;
+    FileReader(const FileReader&) = delete;
+    FileReader& operator=(const FileReader&) = delete;
+
+    /** @brief Constructor
+     *
+     *  @param[in] eid - MCTP endpoint ID of the terminus
+     *  @param[in] instanceIdDb - instance ID database
+     *  @param[in] handler - PLDM request handler
+     *  @param[in] window - number of sections in flight at a time
+     */
+    FileReader(uint8_t eid, InstanceIdDb& instanceIdDb,
+               requester::Handler<requester::Request>* handler,
+               size_t window) :
+        eid(eid),
+        instanceIdDb(instanceIdDb), handler(handler), window(window)
+    {}
+
+    ~FileReader()
+    {
+        cancellation.cancel();
+    }
+
+    /** @brief Read a file of the terminus to disk
+     *
+     *  @param[in] fileIdentifier - identifier of the file
+     *  @param[in] size - size of the file in bytes
+     *  @param[in] path - file written, removed if the read fails
+     *
+     *  @return - PLDM_SUCCESS, PLDM_ERROR if cancelled or the file can not be
+     *            written, else the first error of the transfer
+     */
+    requester::Coroutine read(uint16_t fileIdentifier, uint32_t size,
+                              std::filesystem::path path);
+
+    /** @brief Token cancelled when the reader is destroyed, checked by the
+     *         callers of read() before touching their own state
+     */
+    requester::CancellationToken token() const
+    {
+        return cancellation.token();
+    }
+
+  private:
+    /** @struct Context
+     *  @brief State used by the tasks of a read, copied into them since
+     *  they can outlive the reader
+     */
+    struct Context
+    {
+        uint8_t eid;
+        InstanceIdDb& instanceIdDb;
+        requester::Handler<requester::Request>* handler;
+        requester::CancellationToken token;
+    };
+
+    /** @brief Open a file with DfOpen */
+    static requester::Coroutine open(Context ctx, uint16_t fileIdentifier,
+                                     uint16_t& descriptor);
+
+    /** @brief Read one section, following its next parts, and write it at
+     *         its offset of the file
+     */
+    static requester::Coroutine readSection(Context ctx, uint16_t descriptor,
+                                            uint32_t offset, uint32_t length,
+                                            int fd);
+
+    /** @brief Close a descriptor with DfClose */
+    static requester::Coroutine close(Context ctx, uint16_t descriptor);
+
+    uint8_t eid;
+    InstanceIdDb& instanceIdDb;
+    requester::Handler<requester::Request>* handler;
+    size_t window;
+    requester::CancellationSource cancellation;
+};
+
+} // namespace file_transfer
+
+} // namespace pldm
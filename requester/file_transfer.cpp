@@ -0,0 +1,197 @@
+#include "file_transfer.hpp"
+
+#include <endian.h>
+
+#include <cstring>
+
+namespace pldm
+{
+
+namespace file_transfer
+{
+
+namespace
+{
+
+int packHeader(uint8_t instanceId, uint8_t type, uint8_t command,
+               pldm_msg* msg)
+{
+    pldm_header_info header{};
+    header.msg_type = PLDM_REQUEST;
+    header.instance = instanceId;
+    header.pldm_type = type;
+    header.command = command;
+    return pack_pldm_header(&header, &msg->hdr);
+}
+
+uint8_t* put16(uint8_t* dst, uint16_t value)
+{
+    value = htole16(value);
+    std::memcpy(dst, &value, sizeof(value));
+    return dst + sizeof(value);
+}
+
+uint8_t* put32(uint8_t* dst, uint32_t value)
+{
+    value = htole32(value);
+    std::memcpy(dst, &value, sizeof(value));
+    return dst + sizeof(value);
+}
+
+uint16_t get16(const uint8_t* src)
+{
+    uint16_t value;
+    std::memcpy(&value, src, sizeof(value));
+    return le16toh(value);
+}
+
+uint32_t get32(const uint8_t* src)
+{
+    uint32_t value;
+    std::memcpy(&value, src, sizeof(value));
+    return le32toh(value);
+}
+
+} // namespace
+
+int encodeDfOpenReq(uint8_t instanceId, uint16_t fileIdentifier,
+                    uint16_t attributes, pldm_msg* msg, size_t payloadLength)
+{
+    if (msg == nullptr)
+    {
+        return PLDM_ERROR_INVALID_DATA;
+    }
+    if (payloadLength != PLDM_DF_OPEN_REQ_BYTES)
+    {
+        return PLDM_ERROR_INVALID_LENGTH;
+    }
+    auto rc = packHeader(instanceId, PLDM_FILE_TRANSFER, PLDM_DF_OPEN, msg);
+    if (rc != PLDM_SUCCESS)
+    {
+        return rc;
+    }
+
+    auto payload = put16(msg->payload, fileIdentifier);
+    put16(payload, attributes);
+    return PLDM_SUCCESS;
+}
+
+int decodeDfOpenResp(const pldm_msg* msg, size_t payloadLength,
+                     uint8_t& completionCode, uint16_t& descriptor)
+{
+    if (msg == nullptr)
+    {
+        return PLDM_ERROR_INVALID_DATA;
+    }
+    if (payloadLength < sizeof(completionCode))
+    {
+        return PLDM_ERROR_INVALID_LENGTH;
+    }
+    completionCode = msg->payload[0];
+    if (completionCode != PLDM_SUCCESS)
+    {
+        return PLDM_SUCCESS;
+    }
+    if (payloadLength != PLDM_DF_OPEN_RESP_BYTES)
+    {
+        return PLDM_ERROR_INVALID_LENGTH;
+    }
+    descriptor = get16(msg->payload + 1);
+    return PLDM_SUCCESS;
+}
+
+int encodeDfCloseReq(uint8_t instanceId, uint16_t descriptor, uint16_t options,
+                     pldm_msg* msg, size_t payloadLength)
+{
+    if (msg == nullptr)
+    {
+        return PLDM_ERROR_INVALID_DATA;
+    }
+    if (payloadLength != PLDM_DF_CLOSE_REQ_BYTES)
+    {
+        return PLDM_ERROR_INVALID_LENGTH;
+    }
+    auto rc = packHeader(instanceId, PLDM_FILE_TRANSFER, PLDM_DF_CLOSE, msg);
+    if (rc != PLDM_SUCCESS)
+    {
+        return rc;
+    }
+
+    auto payload = put16(msg->payload, descriptor);
+    put16(payload, options);
+    return PLDM_SUCCESS;
+}
+
+int encodeMultipartReceiveReq(uint8_t instanceId, TransferOperation operation,
+                              uint16_t descriptor, uint32_t dataTransferHandle,
+                              uint32_t sectionOffset, uint32_t sectionLength,
+                              pldm_msg* msg, size_t payloadLength)
+{
+    if (msg == nullptr)
+    {
+        return PLDM_ERROR_INVALID_DATA;
+    }
+    if (payloadLength != PLDM_MULTIPART_RECEIVE_REQ_BYTES)
+    {
+        return PLDM_ERROR_INVALID_LENGTH;
+    }
+    auto rc = packHeader(instanceId, PLDM_BASE, PLDM_MULTIPART_RECEIVE, msg);
+    if (rc != PLDM_SUCCESS)
+    {
+        return rc;
+    }
+
+    auto payload = msg->payload;
+    *payload++ = PLDM_FILE_TRANSFER;
+    *payload++ = static_cast<uint8_t>(operation);
+    payload = put32(payload, descriptor);
+    payload = put32(payload, dataTransferHandle);
+    payload = put32(payload, sectionOffset);
+    put32(payload, sectionLength);
+    return PLDM_SUCCESS;
+}
+
+int decodeMultipartReceiveResp(const pldm_msg* msg, size_t payloadLength,
+                               uint8_t& completionCode, MultipartPart& part)
+{
+    if (msg == nullptr)
+    {
+        return PLDM_ERROR_INVALID_DATA;
+    }
+    if (payloadLength < sizeof(completionCode))
+    {
+        return PLDM_ERROR_INVALID_LENGTH;
+    }
+    completionCode = msg->payload[0];
+    if (completionCode != PLDM_SUCCESS)
+    {
+        return PLDM_SUCCESS;
+    }
+    if (payloadLength < PLDM_MULTIPART_RECEIVE_MIN_RESP_BYTES)
+    {
+        return PLDM_ERROR_INVALID_LENGTH;
+    }
+
+    auto payload = msg->payload + 1;
+    part.transferFlag = *payload++;
+    part.nextDataTransferHandle = get32(payload);
+    payload += sizeof(uint32_t);
+    auto length = get32(payload);
+    payload += sizeof(uint32_t);
+
+    bool last = part.transferFlag == PLDM_END ||
+                part.transferFlag == PLDM_START_AND_END;
+    size_t crcBytes = last ? sizeof(uint32_t) : 0;
+    if (payloadLength - PLDM_MULTIPART_RECEIVE_MIN_RESP_BYTES !=
+        length + crcBytes)
+    {
+        return PLDM_ERROR_INVALID_LENGTH;
+    }
+    part.data = std::span<const uint8_t>(payload, length);
+    part.sectionCrc = last ? get32(payload + length) : 0;
+    return PLDM_SUCCESS;
+}
+
+} // namespace file_transfer
+
+} // namespace pldm
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <libpldm/base.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace pldm
+{
+
+namespace file_transfer
+{
+
+/** @brief PLDM type of the File Transfer specification, DSP0242 */
+constexpr uint8_t PLDM_FILE_TRANSFER = 0x07;
+
+/** @brief DfOpen, opens a file of the terminus by its identifier
+ *
+ *  @details Request: file identifier (2 bytes), DfOpen attributes (2 bytes).
+ *  Response: completion code (1 byte), file descriptor (2 bytes).
+ */
+constexpr uint8_t PLDM_DF_OPEN = 0x01;
+constexpr size_t PLDM_DF_OPEN_REQ_BYTES = 4;
+constexpr size_t PLDM_DF_OPEN_RESP_BYTES = 3;
+
+/** @brief DfClose, closes a file descriptor
+ *
+ *  @details Request: file descriptor (2 bytes), DfClose options (2 bytes).
+ *  Response: completion code (1 byte).
+ */
+constexpr uint8_t PLDM_DF_CLOSE = 0x02;
+constexpr size_t PLDM_DF_CLOSE_REQ_BYTES = 4;
+
+/** @brief MultipartReceive of the PLDM base type, reads the file of an open
+ *  descriptor
+ *
+ *  @details Request: PLDM type (1 byte), transfer operation (1 byte),
+ *  transfer context, the file descriptor (4 bytes), data transfer handle (4
+ *  bytes), requested section offset (4 bytes), requested section length (4
+ *  bytes). Response: completion code (1 byte), transfer flag (1 byte), next
+ *  data transfer handle (4 bytes), data length (4 bytes), data, then the
+ *  CRC-32 of the section (4 bytes) in the last part of a section. The
+ *  multi-byte fields are little endian.
+ */
+constexpr uint8_t PLDM_MULTIPART_RECEIVE = 0x09;
+constexpr size_t PLDM_MULTIPART_RECEIVE_REQ_BYTES = 18;
+constexpr size_t PLDM_MULTIPART_RECEIVE_MIN_RESP_BYTES = 10;
+
+/** @brief Transfer operations of MultipartReceive */
+enum class TransferOperation : uint8_t
+{
+    FirstPart = 0,
+    NextPart = 1,
+    Abort = 2,
+    Complete = 3,
+    CurrentPart = 4,
+};
+
+/** @struct MultipartPart
+ *  @brief One part of a MultipartReceive response
+ */
+struct MultipartPart
+{
+    uint8_t transferFlag;
+    uint32_t nextDataTransferHandle;
+    /** @brief Data of the part, a view of the response */
+    std::span<const uint8_t> data;
+    /** @brief CRC-32 of the section, in the last part of a section only */
+    uint32_t sectionCrc;
+};
+
+/** @brief Encode a DfOpen request
+ *
+ *  @param[in] instanceId - instance ID of the request
+ *  @param[in] fileIdentifier - identifier of the file
+ *  @param[in] attributes - DfOpen attributes
+ *  @param[out] msg - request message
+ *  @param[in] payloadLength - length of the request payload
+ *
+ *  @return - PLDM_SUCCESS or PLDM_ERROR_INVALID_LENGTH
+ */
+int encodeDfOpenReq(uint8_t instanceId, uint16_t fileIdentifier,
+                    uint16_t attributes, pldm_msg* msg, size_t payloadLength);
+
+/** @brief Decode a DfOpen response
+ *
+ *  @param[in] msg - response message
+ *  @param[in] payloadLength - length of the response payload
+ *  @param[out] completionCode - completion code of the response
+ *  @param[out] descriptor - file descriptor, set on success
+ *
+ *  @return - PLDM_SUCCESS or PLDM_ERROR_INVALID_LENGTH
+ */
+int decodeDfOpenResp(const pldm_msg* msg, size_t payloadLength,
+                     uint8_t& completionCode, uint16_t& descriptor);
+
+/** @brief Encode a DfClose request
+ *
+ *  @param[in] instanceId - instance ID of the request
+ *  @param[in] descriptor - file descriptor
+ *  @param[in] options - DfClose options
+ *  @param[out] msg - request message
+ *  @param[in] payloadLength - length of the request payload
+ *
+ *  @return - PLDM_SUCCESS or PLDM_ERROR_INVALID_LENGTH
+ */
+int encodeDfCloseReq(uint8_t instanceId, uint16_t descriptor, uint16_t options,
+                     pldm_msg* msg, size_t payloadLength);
+
+/** @brief Encode a MultipartReceive request of a file section
+ *
+ *  @param[in] instanceId - instance ID of the request
+ *  @param[in] operation - transfer operation
+ *  @param[in] descriptor - file descriptor, the transfer context
+ *  @param[in] dataTransferHandle - handle of the part, 0 for the first one
+ *  @param[in] sectionOffset - offset of the section in the file
+ *  @param[in] sectionLength - length of the section
+ *  @param[out] msg - request message
+ *  @param[in] payloadLength - length of the request payload
+ *
+ *  @return - PLDM_SUCCESS or PLDM_ERROR_INVALID_LENGTH
+ */
+int encodeMultipartReceiveReq(uint8_t instanceId, TransferOperation operation,
+                              uint16_t descriptor, uint32_t dataTransferHandle,
+                              uint32_t sectionOffset, uint32_t sectionLength,
+                              pldm_msg* msg, size_t payloadLength);
+
+/** @brief Decode a MultipartReceive response
+ *
+ *  @param[in] msg - response message
+ *  @param[in] payloadLength - length of the response payload
+ *  @param[out] completionCode - completion code of the response
+ *  @param[out] part - part of the response, set on success
+ *
+ *  @return - PLDM_SUCCESS or PLDM_ERROR_INVALID_LENGTH
+ */
+int decodeMultipartReceiveResp(const pldm_msg* msg, size_t payloadLength,
+                               uint8_t& completionCode, MultipartPart& part);
+
+} // namespace file_transfer
+
+} // namespace pldm
@@ -0,0 +1,61 @@
+#include "gpio_monitor.hpp"
+
+#include <chrono>
+#include <stdexcept>
+
+namespace pldm
+{
+
+GpioMonitor::GpioMonitor(sdeventplus::Event& event,
+                         const std::string& lineName, Callback callback) :
+    line(gpiod::find_line(lineName)),
+    callback(std::move(callback))
+{
+    if (!line)
+    {
+        throw std::runtime_error("GPIO line " + lineName + " not found");
+    }
+    line.request({"pldmd", gpiod::line_request::EVENT_BOTH_EDGES, 0});
+
+    io = std::make_unique<sdeventplus::source::IO>(
+        event, line.event_get_fd(), EPOLLIN,
+        [this](sdeventplus::source::IO&, int, uint32_t) { readEvents(); });
+}
+
+GpioMonitor::~GpioMonitor()
+{
+    io.reset();
+    if (line.is_requested())
+    {
+        line.release();
+    }
+}
+
+bool GpioMonitor::getValue()
+{
+    return line.get_value();
+}
+
+void GpioMonitor::stop()
+{
+    /* The source may be the caller, it is only disabled. The line is
+     * released once the source is gone, its fd must not be reused while
+     * it is in the epoll set */
+    if (io)
+    {
+        io->set_enabled(sdeventplus::source::Enabled::Off);
+    }
+}
+
+void GpioMonitor::readEvents()
+{
+    /* Drain the queued edges, the callback gets the value after the last
+     * one */
+    while (line.event_wait(std::chrono::nanoseconds::zero()))
+    {
+        line.event_read();
+    }
+    callback(line.get_value());
+}
+
+} // namespace pldm
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/io.hpp>
+
+#include <gpiod.hpp>
+
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace pldm
+{
+
+/** @class GpioMonitor
+ *
+ *  Watches the edges of a GPIO line on the event loop. The line is
+ *  requested for both edge events and its event fd is added to the loop,
+ *  so nothing runs until the line changes.
+ */
+class GpioMonitor
+{
+  public:
+    /** @brief Callback of a change, with the new value of the line */
+    using Callback = std::function<void(bool value)>;
+
+    GpioMonitor() = delete;
+    GpioMonitor(const GpioMonitor&) = delete;
+    GpioMonitor& operator=(const GpioMonitor&) = delete;
+
+    /** @brief Request the line and watch its edges
+     *
+     *  @param[in] event - PLDM daemon's main event loop
+     *  @param[in] lineName - name of the GPIO line
+     *  @param[in] callback - called on each edge
+     *
+     *  @throw std::runtime_error if the line is not found or busy
+     */
+    GpioMonitor(sdeventplus::Event& event, const std::string& lineName,
+                Callback callback);
+
+    ~GpioMonitor();
+
+    /** @brief Current value of the line */
+    bool getValue();
+
+    /** @brief Stop watching the edges, may be called from the callback.
+     *  The line is released with the monitor.
+     */
+    void stop();
+
+  private:
+    /** @brief Read the pending edge events */
+    void readEvents();
+
+    gpiod::line line;
+    Callback callback;
+    std::unique_ptr<sdeventplus::source::IO> io;
+};
+
+} // namespace pldm
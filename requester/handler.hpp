@@ -1,18 +1,28 @@
 #pragma once
 
 #include "common/instance_id.hpp"
+#include "common/metrics.hpp"
+#include "common/rate_limited_log.hpp"
+#include "common/request_trace.hpp"
 #include "common/transport.hpp"
 #include "common/types.hpp"
+#include "bandwidth_governor.hpp"
 #include "request.hpp"
+#include "rtt_estimator.hpp"
+#include "timer_wheel.hpp"
 
 #include <libpldm/base.h>
+#include <libpldm/fru.h>
+#include <libpldm/platform.h>
 #include <sys/socket.h>
 
 #include <phosphor-logging/lg2.hpp>
-#include <sdbusplus/timer.hpp>
 #include <sdeventplus/event.hpp>
 #include <sdeventplus/source/event.hpp>
 
+#include <algorithm>
+#include <array>
+#include <bitset>
 #include <cassert>
 #include <chrono>
 #include <coroutine>
@@ -20,7 +30,10 @@
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <queue>
+#include <span>
+#include <string_view>
 #include <tuple>
 #include <unordered_map>
 
@@ -67,6 +80,65 @@ struct RequestKeyHasher
 using ResponseHandler = std::function<void(
     mctp_eid_t eid, const pldm_msg* response, size_t respMsgLen)>;
 
+/** @enum RequestPriority
+ *
+ *  The scheduling classes of the request messages to one endpoint. The queued
+ *  request of the lower value class is sent first.
+ */
+enum class RequestPriority : uint8_t
+{
+    CriticalRas = 0, //!< RAS event polling
+    Control,         //!< Effecter writes and other control commands
+    Discovery,       //!< Terminus discovery and PDR/FRU retrieval
+    Telemetry,       //!< Background sensor polling
+    Bulk,            //!< Firmware update transfers
+    Count
+};
+
+constexpr size_t numRequestPriorities =
+    static_cast<size_t>(RequestPriority::Count);
+
+/** @brief Names of the scheduling classes, e.g. in the budget config */
+constexpr std::array<const char*, numRequestPriorities> requestPriorityNames{
+    "CriticalRas", "Control", "Discovery", "Telemetry", "Bulk"};
+
+/** @brief Set of the scheduling classes, bit N for the class of value N */
+using RequestClasses = std::bitset<numRequestPriorities>;
+
+/** @brief Number of requests of the higher classes which can be sent while
+ *         a queued request of a lower class is waiting, before the lower class
+ *         is served once to avoid the starvation.
+ */
+constexpr uint8_t requestStarvationLimit = 8;
+
+/** @brief Check whether a command only reads the state of the terminus, the
+ *         identical requests of such a command in flight share one response
+ *
+ *  @param[in] type - PLDM type
+ *  @param[in] command - PLDM command
+ */
+inline bool isIdempotentCommand(uint8_t type, uint8_t command)
+{
+    switch (type)
+    {
+        case PLDM_BASE:
+            return command == PLDM_GET_TID || command == PLDM_GET_PLDM_VERSION ||
+                   command == PLDM_GET_PLDM_TYPES ||
+                   command == PLDM_GET_PLDM_COMMANDS;
+        case PLDM_PLATFORM:
+            return command == PLDM_GET_SENSOR_READING ||
+                   command == PLDM_GET_STATE_SENSOR_READINGS ||
+                   command == PLDM_GET_NUMERIC_EFFECTER_VALUE ||
+                   command == PLDM_GET_PDR_REPOSITORY_INFO ||
+                   command == PLDM_GET_PDR;
+        case PLDM_FRU:
+            return command == PLDM_GET_FRU_RECORD_TABLE_METADATA ||
+                   command == PLDM_GET_FRU_RECORD_TABLE;
+        default:
+            return false;
+    }
+}
+
 /** @struct RegisteredRequest
  *
  *  This struct is used to store the registered request to one endpoint.
@@ -76,23 +148,132 @@ struct RegisteredRequest
     RequestKey key;                  //!< Responder MCTP endpoint ID
     std::vector<uint8_t> reqMsg;     //!< Request messages queue
     ResponseHandler responseHandler; //!< Waiting for response flag
+    RequestPriority priority =
+        RequestPriority::Discovery;  //!< Scheduling class
 };
 
+/** @brief Consecutive instance ID expiries after which an endpoint is
+ *         considered dead, its requests are then sent once and expire after
+ *         the retry timeout
+ */
+constexpr uint8_t deadEndpointExpiries = 3;
+
+/** @brief Maximum number of instance IDs available for one endpoint, as per
+ *         DSP0240 the instance ID is a 5 bit field.
+ */
+constexpr uint8_t maxInstanceIdsPerEid = 32;
+
 /** @struct EndpointMessageQueue
  *
- *  This struct is used to save the list of request messages of one endpoint and
- *  the existing of the request message to the endpoint with its' EID.
+ *  This struct is used to save the lists of request messages of one endpoint,
+ *  one list per priority class, and the number of request messages to the
+ *  endpoint with its' EID which are waiting for the response.
  */
 struct EndpointMessageQueue
 {
+    using RequestQueue = std::deque<std::shared_ptr<RegisteredRequest>>;
+
     mctp_eid_t eid; //!< Responder MCTP endpoint ID
-    std::deque<std::shared_ptr<RegisteredRequest>> requestQueue; //!< Queue
-    bool activeRequest; //!< Waiting for response flag
+    std::array<RequestQueue, numRequestPriorities>
+        requestQueues;      //!< Queue of each priority class
+    uint8_t activeRequests; //!< Number of requests waiting for response
+    uint8_t maxOutstanding; //!< Window of outstanding requests
+    std::array<uint8_t, numRequestPriorities>
+        skippedCounts{};    //!< Number of times each class was passed over
+    pldm::metrics::Gauge* depthGauge = nullptr; //!< Exported queue depth
+    uint8_t consecutiveExpiries = 0; //!< Expiries since the last response
+    std::optional<uint8_t> numRetries; //!< Retries, unset for the default
 
     bool operator==(const mctp_eid_t& mctpEid) const
     {
         return (eid == mctpEid);
     }
+
+    /** @brief Number of queued requests of all the classes */
+    size_t size() const
+    {
+        size_t count = 0;
+        for (const auto& queue : requestQueues)
+        {
+            count += queue.size();
+        }
+        return count;
+    }
+
+    /** @brief Check whether there is no queued request of any class */
+    bool empty() const
+    {
+        return std::ranges::all_of(requestQueues, [](const auto& queue) {
+            return queue.empty();
+        });
+    }
+
+    /** @brief Check whether a request of the eligible classes is queued */
+    bool hasNext(const RequestClasses& eligible) const
+    {
+        for (size_t i = 0; i < numRequestPriorities; i++)
+        {
+            if (eligible[i] && !requestQueues[i].empty())
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /** @brief Pop the next request to be sent
+     *
+     *  @details The highest priority non-empty class is served, unless one
+     *  lower class has been passed over requestStarvationLimit times, then
+     *  the starving class is served once. The classes which are not
+     *  eligible, e.g. out of budget, are neither served nor passed over.
+     *
+     *  @param[in] eligible - classes which may be served
+     *
+     *  @return the next request, nullptr if the queues are empty
+     */
+    std::shared_ptr<RegisteredRequest>
+        popNext(const RequestClasses& eligible = RequestClasses().set())
+    {
+        std::optional<size_t> selected{};
+        for (size_t i = 0; i < numRequestPriorities; i++)
+        {
+            if (!eligible[i] || requestQueues[i].empty())
+            {
+                continue;
+            }
+            if (!selected)
+            {
+                selected = i;
+            }
+            else if (skippedCounts[i] >= requestStarvationLimit)
+            {
+                selected = i;
+                break;
+            }
+        }
+
+        if (!selected)
+        {
+            return nullptr;
+        }
+
+        for (size_t i = 0; i < numRequestPriorities; i++)
+        {
+            if (i == *selected)
+            {
+                skippedCounts[i] = 0;
+            }
+            else if (eligible[i] && !requestQueues[i].empty())
+            {
+                skippedCounts[i]++;
+            }
+        }
+
+        auto request = requestQueues[*selected].front();
+        requestQueues[*selected].pop_front();
+        return request;
+    }
 };
 
 /** @class Handler
@@ -102,7 +283,9 @@ struct EndpointMessageQueue
  *  waiting for a response. The registered response handlers are invoked with
  *  response once the PLDM responder sends the response. If no response is
  *  received within the instance ID expiration interval or any other failure the
- *  response handler is invoked with the empty response.
+ *  response handler is invoked with the empty response. An idempotent request
+ *  identical to one queued or outstanding, same EID, type, command and
+ *  payload, is not sent: its handler gets the response of that one.
  *
  * @tparam RequestInterface - Request class type
  */
@@ -126,6 +309,11 @@ class Handler
      *  @param[in] instanceIdExpiryInterval - instance ID expiration interval
      *  @param[in] numRetries - number of request retries
      *  @param[in] responseTimeOut - time to wait between each retry
+     *  @param[in] maxOutstandingRequests - default number of requests which
+     *                                      can wait for response on one
+     *                                      endpoint at the same time
+     *  @param[in] minResponseTimeOut - floor of the adaptive retry timeout
+     *  @param[in] maxResponseTimeOut - cap of the adaptive retry timeout
      */
     explicit Handler(
         PldmTransport* pldmTransport, sdeventplus::Event& event,
@@ -134,13 +322,71 @@ class Handler
             std::chrono::seconds(INSTANCE_ID_EXPIRATION_INTERVAL),
         uint8_t numRetries = static_cast<uint8_t>(NUMBER_OF_REQUEST_RETRIES),
         std::chrono::milliseconds responseTimeOut =
-            std::chrono::milliseconds(RESPONSE_TIME_OUT)) :
+            std::chrono::milliseconds(RESPONSE_TIME_OUT),
+        uint8_t maxOutstandingRequests =
+            static_cast<uint8_t>(MAX_OUTSTANDING_REQUESTS_PER_EID),
+        std::chrono::milliseconds minResponseTimeOut =
+            std::chrono::milliseconds(RESPONSE_TIME_OUT_MIN),
+        std::chrono::milliseconds maxResponseTimeOut =
+            std::chrono::milliseconds(RESPONSE_TIME_OUT_MAX)) :
         pldmTransport(pldmTransport),
         event(event), instanceIdDb(instanceIdDb), verbose(verbose),
         instanceIdExpiryInterval(instanceIdExpiryInterval),
-        numRetries(numRetries), responseTimeOut(responseTimeOut)
+        numRetries(numRetries), responseTimeOut(responseTimeOut),
+        maxOutstandingRequests(clampWindow(maxOutstandingRequests)),
+        minResponseTimeOut(std::min(minResponseTimeOut, responseTimeOut)),
+        maxResponseTimeOut(std::max(maxResponseTimeOut, responseTimeOut)),
+        timerWheel(event), governor(numRequestPriorities)
     {}
 
+    /** @brief Byte budgets of the scheduling classes, shared by all the
+     *  endpoints
+     */
+    BandwidthGovernor& getGovernor()
+    {
+        return governor;
+    }
+
+    /** @brief Send the queued requests which the new budgets allow, after a
+     *  budget changed
+     */
+    void pollEndpointQueues()
+    {
+        for (const auto& [eid, endpointQueue] : endpointMessageQueues)
+        {
+            pollEndpointQueue(eid);
+        }
+    }
+
+    /** @brief Set the window of outstanding requests of one endpoint
+     *
+     *  @details The window is bounded by the number of instance IDs of the
+     *  endpoint. The terminus which can't handle concurrent commands should
+     *  keep the default window of 1.
+     *
+     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
+     *  @param[in] window - number of requests which can wait for response
+     */
+    void setMaxOutstandingRequests(mctp_eid_t eid, uint8_t window)
+    {
+        getEndpointQueue(eid)->maxOutstanding = clampWindow(window);
+
+        /* the window can be enlarged, try to send the queued requests */
+        pollEndpointQueue(eid);
+    }
+
+    /** @brief Set the number of retries of the requests to one endpoint
+     *
+     *  @details The requests already sent keep their retries.
+     *
+     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
+     *  @param[in] retries - number of retries, unset for the default
+     */
+    void setEndpointRetries(mctp_eid_t eid, std::optional<uint8_t> retries)
+    {
+        getEndpointQueue(eid)->numRetries = retries;
+    }
+
     void instanceIdExpiryCallBack(RequestKey key)
     {
         auto eid = key.eid;
@@ -152,23 +398,33 @@ class Handler
                   (unsigned)key.eid, "IID", (unsigned)key.instanceId,
                   "CMDTYPE", (unsigned)key.type,
                   "CMDID", (unsigned)key.command);
-            auto& [request, responseHandler,
-                   timerInstance] = this->handlers[key];
-            request->stop();
-            auto rc = timerInstance->stop();
-            if (rc)
+            pldm::metrics::Registry::get()
+                .counter("pldm_instance_id_expiries",
+                         "Requests which got no response before the instance "
+                         "ID expired",
+                         {{"eid", std::to_string(key.eid)}})
+                .inc();
+            sendTimes.erase(key);
+            sentClasses.erase(key);
+            getCommandStats(key).estimator.backoff();
+            auto& endpointQueue = getEndpointQueue(eid);
+            if (endpointQueue->consecutiveExpiries < deadEndpointExpiries)
             {
-                error("Failed to stop the instance ID expiry timer. RC = {RC}",
-                      "RC", static_cast<int>(rc));
+                endpointQueue->consecutiveExpiries++;
             }
+            pldm::requesttrace::RequestTrace::GetInstance().record(
+                pldm::requesttrace::TracePoint::Expire, key.eid,
+                key.instanceId, key.type, key.command);
+            auto node = this->handlers.extract(key);
+            auto& [request, responseHandler, expiryId,
+                   retryId] = node.mapped();
+            request->stop();
+            timerWheel.cancel(retryId);
             // Call response handler with an empty response to indicate no
             // response
             responseHandler(eid, nullptr, 0);
-            this->removeRequestContainer.emplace(
-                key,
-                std::make_unique<sdeventplus::source::Defer>(
-                    event, std::bind(&Handler::removeRequestEntry, this, key)));
-            endpointMessageQueues[eid]->activeRequest = false;
+            instanceIdDb.free(key.eid, key.instanceId);
+            releaseActiveRequest(eid);
 
             /* try to send new request if the endpoint is free */
             pollEndpointQueue(eid);
@@ -183,57 +439,32 @@ class Handler
     }
 
     /** @brief Send the remaining PLDM request messages in endpoint queue
+     *
+     *  @details The requests are sent until the window of outstanding requests
+     *  of the endpoint is full.
      *
      *  @param[in] eid - endpoint ID of the remote MCTP endpoint
      */
     int pollEndpointQueue(mctp_eid_t eid)
     {
-        if (endpointMessageQueues[eid]->activeRequest ||
-            endpointMessageQueues[eid]->requestQueue.empty())
-        {
-            return PLDM_SUCCESS;
-        }
-
-        endpointMessageQueues[eid]->activeRequest = true;
-        auto requestMsg = endpointMessageQueues[eid]->requestQueue.front();
-        endpointMessageQueues[eid]->requestQueue.pop_front();
-
-        auto request = std::make_unique<RequestInterface>(
-            pldmTransport, requestMsg->key.eid, event,
-            std::move(requestMsg->reqMsg), numRetries, responseTimeOut,
-            verbose);
-        auto timer = std::make_unique<phosphor::Timer>(
-            event.get(), std::bind(&Handler::instanceIdExpiryCallBack, this,
-                                   requestMsg->key));
-
-        auto rc = request->start();
-        if (rc)
+        auto& endpointQueue = getEndpointQueue(eid);
+        while (endpointQueue->activeRequests < endpointQueue->maxOutstanding &&
+               !endpointQueue->empty())
         {
-            instanceIdDb.free(requestMsg->key.eid, requestMsg->key.instanceId);
-            error("Failure to send the PLDM request message");
-            endpointMessageQueues[eid]->activeRequest = false;
-            return rc;
-        }
-
-        try
-        {
-            timer->start(duration_cast<std::chrono::microseconds>(
-                instanceIdExpiryInterval));
-        }
-        catch (const std::runtime_error& e)
-        {
-            instanceIdDb.free(requestMsg->key.eid, requestMsg->key.instanceId);
-            error(
-                "Failed to start the instance ID expiry timer. RC = {ERR_EXCEP}",
-                "ERR_EXCEP", e.what());
-            endpointMessageQueues[eid]->activeRequest = false;
-            return PLDM_ERROR;
+            /* The classes out of budget wait, the others go ahead */
+            auto eligible = getEligibleClasses(*endpointQueue);
+            if (eligible.none())
+            {
+                scheduleBudgetRetry();
+                break;
+            }
+            auto rc = sendQueuedRequest(endpointQueue, eligible);
+            if (rc)
+            {
+                return rc;
+            }
         }
 
-        handlers.emplace(requestMsg->key,
-                         std::make_tuple(std::move(request),
-                                         std::move(requestMsg->responseHandler),
-                                         std::move(timer)));
         return PLDM_SUCCESS;
     }
 
@@ -245,12 +476,14 @@ class Handler
      *  @param[in] command - PLDM command
      *  @param[in] requestMsg - PLDM request message
      *  @param[in] responseHandler - Response handler for this request
+     *  @param[in] priority - scheduling class of this request
      *
      *  @return return PLDM_SUCCESS on success and PLDM_ERROR otherwise
      */
-    int registerRequest(mctp_eid_t eid, uint8_t instanceId, uint8_t type,
-                        uint8_t command, pldm::Request&& requestMsg,
-                        ResponseHandler&& responseHandler)
+    int registerRequest(
+        mctp_eid_t eid, uint8_t instanceId, uint8_t type, uint8_t command,
+        pldm::Request&& requestMsg, ResponseHandler&& responseHandler,
+        RequestPriority priority = RequestPriority::Discovery)
     {
         RequestKey key{eid, instanceId, type, command};
 
@@ -261,20 +494,57 @@ class Handler
             return PLDM_ERROR;
         }
 
-        auto inputRequest = std::make_shared<RegisteredRequest>(
-            key, std::move(requestMsg), std::move(responseHandler));
-        if (endpointMessageQueues.contains(eid))
+        /* An idempotent request identical to one in flight waits for the
+         * response of that one, its instance ID is not used */
+        if (isIdempotentCommand(type, command) &&
+            requestMsg.size() >= sizeof(pldm_msg_hdr))
         {
-            endpointMessageQueues[eid]->requestQueue.push_back(inputRequest);
-        }
-        else
-        {
-            std::deque<std::shared_ptr<RegisteredRequest>> reqQueue;
-            reqQueue.push_back(inputRequest);
-            endpointMessageQueues[eid] =
-                std::make_shared<EndpointMessageQueue>(eid, reqQueue, false);
+            std::span<const uint8_t> payload(
+                requestMsg.data() + sizeof(pldm_msg_hdr),
+                requestMsg.size() - sizeof(pldm_msg_hdr));
+            auto digest = std::hash<std::string_view>{}(std::string_view(
+                reinterpret_cast<const char*>(payload.data()), payload.size()));
+            if (auto leader = findInflightRead(digest, key, payload))
+            {
+                inflightReads[*leader].followers.emplace_back(
+                    std::move(responseHandler));
+                instanceIdDb.free(eid, instanceId);
+                pldm::metrics::Registry::get()
+                    .counter("pldm_deduplicated_requests",
+                             "Requests answered by the response of an "
+                             "identical request in flight",
+                             {{"eid", std::to_string(eid)}})
+                    .inc();
+                return PLDM_SUCCESS;
+            }
+
+            inflightReads.emplace(
+                key, InflightRead{digest, {payload.begin(), payload.end()}, {}});
+            inflightDigests.emplace(digest, key);
+            responseHandler = [this, key,
+                               handler = std::move(responseHandler)](
+                                  mctp_eid_t responder,
+                                  const pldm_msg* response,
+                                  size_t respMsgLen) {
+                auto followers = takeFollowers(key);
+                handler(responder, response, respMsgLen);
+                for (auto& follower : followers)
+                {
+                    follower(responder, response, respMsgLen);
+                }
+            };
         }
 
+        auto inputRequest = std::make_shared<RegisteredRequest>(
+            key, std::move(requestMsg), std::move(responseHandler), priority);
+        auto& endpointQueue = getEndpointQueue(eid);
+        endpointQueue->requestQueues[static_cast<size_t>(priority)].push_back(
+            inputRequest);
+        endpointQueue->depthGauge->set(endpointQueue->size());
+        pldm::requesttrace::RequestTrace::GetInstance().record(
+            pldm::requesttrace::TracePoint::Enqueue, eid, instanceId, type,
+            command);
+
         /* try to send new request if the endpoint is free */
         pollEndpointQueue(eid);
 
@@ -297,19 +567,22 @@ class Handler
         RequestKey key{eid, instanceId, type, command};
         if (handlers.contains(key))
         {
-            auto& [request, responseHandler, timerInstance] = handlers[key];
+            auto& [request, responseHandler, expiryId, retryId] = handlers[key];
             request->stop();
-            auto rc = timerInstance->stop();
-            if (rc)
-            {
-                error("Failed to stop the instance ID expiry timer. RC = {RC}",
-                      "RC", static_cast<int>(rc));
-            }
+            timerWheel.cancel(expiryId);
+            timerWheel.cancel(retryId);
+            recordRoundTrip(key, request->getRetriesSent());
+            chargeResponse(key, respMsgLen);
+            auto& trace = pldm::requesttrace::RequestTrace::GetInstance();
+            trace.record(pldm::requesttrace::TracePoint::Response, eid,
+                         instanceId, type, command);
             responseHandler(eid, response, respMsgLen);
+            trace.record(pldm::requesttrace::TracePoint::Complete, eid,
+                         instanceId, type, command);
             instanceIdDb.free(key.eid, key.instanceId);
             handlers.erase(key);
 
-            endpointMessageQueues[eid]->activeRequest = false;
+            releaseActiveRequest(eid);
             /* try to send new request if the endpoint is free */
             pollEndpointQueue(eid);
         }
@@ -333,14 +606,33 @@ class Handler
     uint8_t numRetries;               //!< number of request retries
     std::chrono::milliseconds
         responseTimeOut;              //!< time to wait between each retry
+    uint8_t maxOutstandingRequests;   //!< default outstanding requests window
+    std::chrono::milliseconds
+        minResponseTimeOut;           //!< floor of the adaptive retry timeout
+    std::chrono::milliseconds
+        maxResponseTimeOut;           //!< cap of the adaptive retry timeout
+
+    /** @struct CommandStats
+     *
+     *  Round-trip time statistics of one command of one endpoint
+     */
+    struct CommandStats
+    {
+        pldm::metrics::Histogram* rtt; //!< Exported round-trip times
+        RttEstimator estimator;        //!< Adaptive retry timeout
+    };
 
     /** @brief Container for storing the details of the PLDM request
      *         message, handler for the corresponding PLDM response and the
-     *         timer object for the Instance ID expiration
+     *         timer wheel entries of the Instance ID expiration and of the
+     *         next retry
      */
     using RequestValue =
         std::tuple<std::unique_ptr<RequestInterface>, ResponseHandler,
-                   std::unique_ptr<phosphor::Timer>>;
+                   TimerWheel::Id, TimerWheel::Id>;
+
+    /** @brief Retry and expiry timeouts of all the outstanding requests */
+    TimerWheel timerWheel;
 
     // Manage the requests of responders base on MCTP EID
     std::map<mctp_eid_t, std::shared_ptr<EndpointMessageQueue>>
@@ -349,25 +641,395 @@ class Handler
     /** @brief Container for storing the PLDM request entries */
     std::unordered_map<RequestKey, RequestValue, RequestKeyHasher> handlers;
 
-    /** @brief Container to store information about the request entries to be
-     *         removed after the instance ID timer expires
-     */
-    std::unordered_map<RequestKey, std::unique_ptr<sdeventplus::source::Defer>,
+    /** @brief Time each outstanding request was first sent */
+    std::unordered_map<RequestKey, std::chrono::steady_clock::time_point,
                        RequestKeyHasher>
-        removeRequestContainer;
+        sendTimes;
 
-    /** @brief Remove request entry for which the instance ID expired
+    /** @brief Round-trip time statistics keyed by EID, type and command */
+    std::unordered_map<uint32_t, CommandStats> commandStats;
+
+    /** @brief Byte budgets of the scheduling classes */
+    BandwidthGovernor governor;
+
+    /** @brief Scheduling class of each outstanding request */
+    std::unordered_map<RequestKey, RequestPriority, RequestKeyHasher>
+        sentClasses;
+
+    /** @struct InflightRead
+     *
+     *  Idempotent request queued or waiting for its response, and the
+     *  handlers of the identical requests registered meanwhile
+     */
+    struct InflightRead
+    {
+        size_t digest;                          //!< Hash of the payload
+        std::vector<uint8_t> payload;           //!< Request payload
+        std::vector<ResponseHandler> followers; //!< Handlers sharing it
+    };
+
+    /** @brief Idempotent requests in flight keyed by their own key */
+    std::unordered_map<RequestKey, InflightRead, RequestKeyHasher>
+        inflightReads;
+
+    /** @brief Keys of the idempotent requests in flight by payload hash */
+    std::unordered_multimap<size_t, RequestKey> inflightDigests;
+
+    /** @brief Timer wheel entry resuming the requests waiting for their
+     *  budget, 0 if none
+     */
+    TimerWheel::Id budgetRetryId = 0;
+
+    /** @brief Exported bytes of each scheduling class */
+    std::array<pldm::metrics::Counter*, numRequestPriorities> classBytes{};
+
+    /** @brief Find an idempotent request in flight identical to a new one
+     *
+     *  @param[in] digest - hash of the payload of the new request
+     *  @param[in] key - key of the new request
+     *  @param[in] payload - payload of the new request
+     *
+     *  @return the key of the request in flight, unset if there is none
+     */
+    std::optional<RequestKey> findInflightRead(size_t digest,
+                                               const RequestKey& key,
+                                               std::span<const uint8_t> payload)
+    {
+        auto [begin, end] = inflightDigests.equal_range(digest);
+        for (auto it = begin; it != end; ++it)
+        {
+            const auto& leader = it->second;
+            if (leader.eid == key.eid && leader.type == key.type &&
+                leader.command == key.command &&
+                std::ranges::equal(inflightReads[leader].payload, payload))
+            {
+                return leader;
+            }
+        }
+        return std::nullopt;
+    }
+
+    /** @brief Forget an idempotent request in flight
+     *
+     *  @param[in] key - key of the request
+     *
+     *  @return the handlers of the identical requests waiting for it
+     */
+    std::vector<ResponseHandler> takeFollowers(const RequestKey& key)
+    {
+        auto node = inflightReads.extract(key);
+        if (node.empty())
+        {
+            return {};
+        }
+        auto [begin, end] = inflightDigests.equal_range(node.mapped().digest);
+        for (auto it = begin; it != end; ++it)
+        {
+            if (it->second == key)
+            {
+                inflightDigests.erase(it);
+                break;
+            }
+        }
+        return std::move(node.mapped().followers);
+    }
+
+    /** @brief Bound the outstanding requests window to [1, 32]
+     *
+     *  @param[in] window - requested window
+     *
+     *  @return the usable window
+     */
+    static uint8_t clampWindow(uint8_t window)
+    {
+        return std::clamp<uint8_t>(window, 1, maxInstanceIdsPerEid);
+    }
+
+    /** @brief Get the message queue of an endpoint, create it if missing
+     *
+     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
+     *
+     *  @return the message queue of the endpoint
+     */
+    std::shared_ptr<EndpointMessageQueue>& getEndpointQueue(mctp_eid_t eid)
+    {
+        auto& endpointQueue = endpointMessageQueues[eid];
+        if (!endpointQueue)
+        {
+            endpointQueue = std::make_shared<EndpointMessageQueue>(
+                eid,
+                std::array<EndpointMessageQueue::RequestQueue,
+                           numRequestPriorities>{},
+                0, maxOutstandingRequests);
+            endpointQueue->depthGauge = &pldm::metrics::Registry::get().gauge(
+                "pldm_request_queue_depth",
+                "Requests waiting for a free slot of the endpoint window",
+                {{"eid", std::to_string(eid)}});
+        }
+        return endpointQueue;
+    }
+
+    /** @brief Get the statistics of the command of a request, create them
+     *         on the first request
+     *
+     *  @param[in] key - key of the request
+     *
+     *  @return the statistics of the command
+     */
+    CommandStats& getCommandStats(const RequestKey& key)
+    {
+        auto id = (uint32_t(key.eid) << 16) | (uint32_t(key.type) << 8) |
+                  key.command;
+        auto it = commandStats.find(id);
+        if (it == commandStats.end())
+        {
+            auto& histogram = pldm::metrics::Registry::get().histogram(
+                "pldm_request_rtt_seconds",
+                "Time from sending a request to its response, retries "
+                "included",
+                {{"eid", std::to_string(key.eid)},
+                 {"type", std::to_string(key.type)},
+                 {"command", std::to_string(key.command)}});
+            it = commandStats
+                     .emplace(id, CommandStats{&histogram,
+                                               RttEstimator(responseTimeOut,
+                                                            minResponseTimeOut,
+                                                            maxResponseTimeOut)})
+                     .first;
+        }
+        return it->second;
+    }
+
+    /** @brief Record the round-trip time of a request which got its response
+     *
+     *  @param[in] key - key of the request
+     *  @param[in] retries - number of times the request was sent again
+     */
+    void recordRoundTrip(const RequestKey& key, uint8_t retries)
+    {
+        getEndpointQueue(key.eid)->consecutiveExpiries = 0;
+        auto sent = sendTimes.find(key);
+        if (sent == sendTimes.end())
+        {
+            return;
+        }
+        auto rtt = std::chrono::steady_clock::now() - sent->second;
+        sendTimes.erase(sent);
+
+        auto& stats = getCommandStats(key);
+        stats.rtt->observe(rtt);
+        if (retries)
+        {
+            /* The timeout was too short, and which send was answered is
+             * unknown so the RTT is not sampled */
+            stats.estimator.backoff();
+        }
+        else
+        {
+            stats.estimator.sample(
+                std::chrono::duration_cast<RttEstimator::Duration>(rtt));
+        }
+    }
+
+    /** @brief Get the classes of the queued requests which are within their
+     *         budget
+     *
+     *  @param[in] endpointQueue - message queue of the endpoint
+     *
+     *  @return the classes which may be sent
+     */
+    RequestClasses getEligibleClasses(const EndpointMessageQueue& endpointQueue)
+    {
+        RequestClasses eligible;
+        auto now = BandwidthGovernor::Clock::now();
+        for (size_t i = 0; i < numRequestPriorities; i++)
+        {
+            if (endpointQueue.requestQueues[i].empty())
+            {
+                continue;
+            }
+            if (governor.maySend(i, now))
+            {
+                eligible.set(i);
+            }
+            else
+            {
+                governor.deferred(i);
+            }
+        }
+        return eligible;
+    }
+
+    /** @brief Poll the endpoint queues again once the earliest class out of
+     *         budget may send
+     */
+    void scheduleBudgetRetry()
+    {
+        if (budgetRetryId)
+        {
+            return;
+        }
+        auto now = BandwidthGovernor::Clock::now();
+        std::optional<BandwidthGovernor::Clock::duration> wait;
+        for (size_t i = 0; i < numRequestPriorities; i++)
+        {
+            auto classWait = governor.waitTime(i, now);
+            if (classWait > BandwidthGovernor::Clock::duration::zero())
+            {
+                wait = wait ? std::min(*wait, classWait) : classWait;
+            }
+        }
+        if (!wait)
+        {
+            return;
+        }
+        budgetRetryId = timerWheel.schedule(
+            std::chrono::duration_cast<std::chrono::microseconds>(*wait),
+            [this]() {
+            budgetRetryId = 0;
+            pollEndpointQueues();
+        });
+    }
+
+    /** @brief Charge a message to the budget of its class
+     *
+     *  @param[in] priority - scheduling class of the message
+     *  @param[in] bytes - size of the message
+     */
+    void chargeClass(RequestPriority priority, size_t bytes)
+    {
+        auto cls = static_cast<size_t>(priority);
+        governor.charge(cls, bytes);
+        if (!classBytes[cls])
+        {
+            classBytes[cls] = &pldm::metrics::Registry::get().counter(
+                "pldm_request_class_bytes",
+                "Request and response bytes of each scheduling class",
+                {{"class", requestPriorityNames[cls]}});
+        }
+        classBytes[cls]->inc(bytes);
+    }
+
+    /** @brief Charge a response to the class of its request
+     *
+     *  @param[in] key - key of the request
+     *  @param[in] respMsgLen - length of the response payload
+     */
+    void chargeResponse(const RequestKey& key, size_t respMsgLen)
+    {
+        auto it = sentClasses.find(key);
+        if (it == sentClasses.end())
+        {
+            return;
+        }
+        chargeClass(it->second, sizeof(pldm_msg_hdr) + respMsgLen);
+        sentClasses.erase(it);
+    }
+
+    /** @brief Release one slot of the outstanding requests window
+     *
+     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
+     */
+    void releaseActiveRequest(mctp_eid_t eid)
+    {
+        auto& endpointQueue = endpointMessageQueues[eid];
+        if (endpointQueue && endpointQueue->activeRequests)
+        {
+            endpointQueue->activeRequests--;
+        }
+    }
+
+    /** @brief Send the request message at the head of the endpoint queue
+     *
+     *  @param[in] endpointQueue - message queue of the endpoint
+     *  @param[in] eligible - classes which may be sent
+     *
+     *  @return return PLDM_SUCCESS on success and PLDM_ERROR otherwise
+     */
+    int sendQueuedRequest(std::shared_ptr<EndpointMessageQueue>& endpointQueue,
+                          const RequestClasses& eligible)
+    {
+        endpointQueue->activeRequests++;
+        auto requestMsg = endpointQueue->popNext(eligible);
+        endpointQueue->depthGauge->set(endpointQueue->size());
+
+        /* The retry timeout adapts to the RTT of the command, a dead
+         * endpoint gets a single send which expires after that timeout */
+        auto timeout = std::max(
+            std::chrono::milliseconds(1),
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                getCommandStats(requestMsg->key).estimator.current()));
+        auto isDead = endpointQueue->consecutiveExpiries >=
+                      deadEndpointExpiries;
+        std::chrono::microseconds expiry = instanceIdExpiryInterval;
+        if (isDead)
+        {
+            expiry = std::min<std::chrono::microseconds>(expiry, timeout);
+        }
+
+        auto requestSize = requestMsg->reqMsg.size();
+        auto request = std::make_unique<RequestInterface>(
+            pldmTransport, requestMsg->key.eid, event,
+            std::move(requestMsg->reqMsg),
+            isDead ? uint8_t(0)
+                   : endpointQueue->numRetries.value_or(numRetries),
+            timeout, verbose);
+        auto sentAt = std::chrono::steady_clock::now();
+        pldm::requesttrace::RequestTrace::GetInstance().record(
+            pldm::requesttrace::TracePoint::Send, requestMsg->key.eid,
+            requestMsg->key.instanceId, requestMsg->key.type,
+            requestMsg->key.command);
+        auto rc = request->start(false);
+        if (rc)
+        {
+            instanceIdDb.free(requestMsg->key.eid, requestMsg->key.instanceId);
+            error("Failure to send the PLDM request message");
+            endpointQueue->activeRequests--;
+            for (auto& follower : takeFollowers(requestMsg->key))
+            {
+                follower(requestMsg->key.eid, nullptr, 0);
+            }
+            return rc;
+        }
+
+        auto key = requestMsg->key;
+        chargeClass(requestMsg->priority, requestSize);
+        sentClasses[key] = requestMsg->priority;
+        TimerWheel::Id retryId = 0;
+        if (request->getRetriesLeft())
+        {
+            retryId = timerWheel.schedule(
+                timeout, [this, key]() { retryRequest(key); });
+        }
+        auto expiryId = timerWheel.schedule(
+            expiry, [this, key]() { instanceIdExpiryCallBack(key); });
+
+        handlers.emplace(key, std::make_tuple(
+                                  std::move(request),
+                                  std::move(requestMsg->responseHandler),
+                                  expiryId, retryId));
+        sendTimes[key] = sentAt;
+        return PLDM_SUCCESS;
+    }
+
+    /** @brief Send a request again after the retry timeout, and schedule the
+     *         next retry if any is left
      *
      *  @param[in] key - key for the Request
      */
-    void removeRequestEntry(RequestKey key)
+    void retryRequest(RequestKey key)
     {
-        if (removeRequestContainer.contains(key))
+        auto it = handlers.find(key);
+        if (it == handlers.end())
         {
-            removeRequestContainer[key].reset();
-            instanceIdDb.free(key.eid, key.instanceId);
-            handlers.erase(key);
-            removeRequestContainer.erase(key);
+            return;
+        }
+        auto& [request, responseHandler, expiryId, retryId] = it->second;
+        retryId = 0;
+        if (request->retry() && request->getRetriesLeft())
+        {
+            retryId = timerWheel.schedule(
+                request->getTimeout(), [this, key]() { retryRequest(key); });
         }
     }
 };
@@ -380,6 +1042,7 @@ struct sendRecvPldmMsg
     pldm::Request& requestMsg;
     pldm::Response& responseMsg;
     uint8_t rc;
+    requester::RequestPriority priority;
 
     bool await_ready() noexcept
     {
@@ -394,11 +1057,12 @@ struct sendRecvPldmMsg
         rc = handler.registerRequest(
             eid, request->hdr.instance_id, request->hdr.type,
             request->hdr.command, std::move(requestMsg),
-            std::move(std::bind_front(&sendRecvPldmMsg::HandleResponse, this)));
+            std::move(std::bind_front(&sendRecvPldmMsg::HandleResponse, this)),
+            priority);
         if (rc)
         {
-            std::cerr << "registerRequest failed, rc="
-                      << static_cast<unsigned>(rc) << "\n";
+            PLDM_LOG_RATE_LIMITED(error, "registerRequest failed, rc={RC}",
+                                  "RC", static_cast<unsigned>(rc));
             return false;
         }
         return true;
@@ -409,11 +1073,13 @@ struct sendRecvPldmMsg
         return rc;
     }
 
-    sendRecvPldmMsg(requester::Handler<requester::Request>& handler,
-                    uint8_t eid, pldm::Request& requestMsg,
-                    pldm::Response& responseMsg) :
+    sendRecvPldmMsg(
+        requester::Handler<requester::Request>& handler, uint8_t eid,
+        pldm::Request& requestMsg, pldm::Response& responseMsg,
+        requester::RequestPriority priority = RequestPriority::Discovery) :
         handler(handler),
-        eid(eid), requestMsg(requestMsg), responseMsg(responseMsg)
+        eid(eid), requestMsg(requestMsg), responseMsg(responseMsg),
+        priority(priority)
     {
         rc = PLDM_SUCCESS;
         responseMsg.clear();
@@ -423,7 +1089,8 @@ struct sendRecvPldmMsg
     {
         if (response == nullptr || !length)
         {
-            std::cerr << "No response received, EID=" << unsigned(eid) << "\n";
+            PLDM_LOG_RATE_LIMITED(error, "No response received, EID={EID}",
+                                  "EID", unsigned(eid));
             rc = PLDM_ERROR;
         }
         else
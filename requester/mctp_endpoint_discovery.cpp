@@ -47,80 +47,60 @@ MctpDiscovery::MctpDiscovery(sdbusplus::bus_t& bus,
         return;
     }
 
-    std::vector<mctp_eid_t> eids;
-
+    std::map<mctp_eid_t, std::string> found;
     for (const auto& [objectPath, interfaces] : objects)
     {
-        for (const auto& [intfName, properties] : interfaces)
-        {
-            if (intfName == mctpEndpointIntfName)
-            {
-                if (properties.contains("EID") &&
-                    properties.contains("SupportedMessageTypes"))
-                {
-                    auto eid = std::get<mctp_eid_t>(properties.at("EID"));
-                    auto types = std::get<std::vector<uint8_t>>(
-                        properties.at("SupportedMessageTypes"));
-                    if (std::find(types.begin(), types.end(), mctpTypePLDM) !=
-                        types.end())
-                    {
-                        eids.emplace_back(eid);
-                    }
-                }
-            }
-        }
+        parseEndpoint(interfaces, found);
     }
 
-    /* Initial the listEids with the end points in MCTP D-Bus interface */
-    listEids = eids;
+    /* Initial the endpoints with the end points in MCTP D-Bus interface */
+    addEndpoints(found);
+}
 
-    if (eids.size() && fwManager)
+void MctpDiscovery::parseEndpoint(const dbus::InterfaceMap& interfaces,
+                                  std::map<mctp_eid_t, std::string>& found)
+{
+    auto endpoint = interfaces.find(std::string(mctpEndpointIntfName));
+    if (endpoint == interfaces.end())
     {
-        fwManager->handleMCTPEndpoints(eids);
+        return;
+    }
+    const auto& properties = endpoint->second;
+    if (!properties.contains("EID") ||
+        !properties.contains("SupportedMessageTypes"))
+    {
+        return;
+    }
+    auto eid = std::get<mctp_eid_t>(properties.at("EID"));
+    auto types =
+        std::get<std::vector<uint8_t>>(properties.at("SupportedMessageTypes"));
+    if (std::find(types.begin(), types.end(), mctpTypePLDM) == types.end())
+    {
+        return;
     }
 
-    if (eids.size() && devManager)
+    std::string uuid;
+    auto uuidIntf = interfaces.find(std::string(uuidIntfName));
+    if (uuidIntf != interfaces.end() && uuidIntf->second.contains("UUID"))
     {
-        devManager->addDevices(eids);
+        if (auto value =
+                std::get_if<std::string>(&uuidIntf->second.at("UUID")))
+        {
+            uuid = *value;
+        }
     }
+    found[eid] = uuid;
 }
 
-void MctpDiscovery::dicoverEndpoints(sdbusplus::message_t& msg)
+void MctpDiscovery::addEndpoints(
+    const std::map<mctp_eid_t, std::string>& added)
 {
-    constexpr std::string_view mctpEndpointIntfName{
-        "xyz.openbmc_project.MCTP.Endpoint"};
     std::vector<mctp_eid_t> eids;
-
-    sdbusplus::message::object_path objPath;
-    std::map<std::string, std::map<std::string, dbus::Value>> interfaces;
-    msg.read(objPath, interfaces);
-
-    for (const auto& [intfName, properties] : interfaces)
+    for (const auto& [eid, uuid] : added)
     {
-        if (intfName == mctpEndpointIntfName)
-        {
-            if (properties.contains("EID") &&
-                properties.contains("SupportedMessageTypes"))
-            {
-                auto eid = std::get<mctp_eid_t>(properties.at("EID"));
-                auto types = std::get<std::vector<uint8_t>>(
-                    properties.at("SupportedMessageTypes"));
-                if (std::find(types.begin(), types.end(), mctpTypePLDM) !=
-                    types.end())
-                {
-                    if (std::find(types.begin(), types.end(), mctpTypePLDM) !=
-                        types.end())
-                    {
-                        eids.emplace_back(eid);
-                        /* Add eid to list Endpoints */
-                        if (!std::count(listEids.begin(), listEids.end(), eid))
-                        {
-                            listEids.emplace_back(eid);
-                        }
-                    }
-                }
-            }
-        }
+        eids.emplace_back(eid);
+        /* Add eid to list Endpoints */
+        endpoints[eid] = uuid;
     }
 
     if (eids.size() && fwManager)
@@ -130,10 +110,21 @@ void MctpDiscovery::dicoverEndpoints(sdbusplus::message_t& msg)
 
     if (eids.size() && devManager)
     {
-        devManager->addDevices(eids);
+        devManager->addDevices(eids, added);
     }
 }
 
+void MctpDiscovery::dicoverEndpoints(sdbusplus::message_t& msg)
+{
+    sdbusplus::message::object_path objPath;
+    dbus::InterfaceMap interfaces;
+    msg.read(objPath, interfaces);
+
+    std::map<mctp_eid_t, std::string> found;
+    parseEndpoint(interfaces, found);
+    addEndpoints(found);
+}
+
 void MctpDiscovery::removeEndpoints(sdbusplus::message_t& msg)
 {
     dbus::ObjectValueTree objects;
@@ -144,6 +135,7 @@ void MctpDiscovery::removeEndpoints(sdbusplus::message_t& msg)
      * message. Check the remained EID in the MCTP D-Bus interface and compare
      * with the previous list to find the removed EIDs
      */
+    std::vector<mctp_eid_t> difference;
     try
     {
         auto method = bus.new_method_call(
@@ -154,68 +146,30 @@ void MctpDiscovery::removeEndpoints(sdbusplus::message_t& msg)
     }
     catch (const std::exception& e)
     {
-        if (listEids.size() && devManager)
-        {
-            devManager->removeDevices(listEids);
-        }
-
-        /* Remove all of EID in list when MCTP D-Bus is empty*/
-        listEids = {};
-        return;
+        /* Remove all of EID in list when MCTP D-Bus is not reachable */
+        objects.clear();
     }
 
-    if (!objects.size())
-    {
-        if (listEids.size() && devManager)
-        {
-            devManager->removeDevices(listEids);
-        }
-        /* Remove all of EID in list when MCTP D-Bus is empty*/
-        listEids = {};
-        return;
-    }
-
-    /* All of EIDs in MCTP D-Bus is removed */
-    if (!listEids.size())
+    std::map<mctp_eid_t, std::string> found;
+    for (const auto& [objectPath, interfaces] : objects)
     {
-        return;
+        parseEndpoint(interfaces, found);
     }
 
-    std::vector<mctp_eid_t> eids;
-
-    for (const auto& [objectPath, interfaces] : objects)
+    /* Find the removed EID */
+    for (auto it = endpoints.begin(); it != endpoints.end();)
     {
-        for (const auto& [intfName, properties] : interfaces)
+        if (found.contains(it->first))
         {
-            if (intfName == mctpEndpointIntfName)
-            {
-                if (properties.contains("EID") &&
-                    properties.contains("SupportedMessageTypes"))
-                {
-                    auto eid = std::get<mctp_eid_t>(properties.at("EID"));
-                    auto types = std::get<std::vector<uint8_t>>(
-                        properties.at("SupportedMessageTypes"));
-                    if (std::find(types.begin(), types.end(), mctpTypePLDM) !=
-                        types.end())
-                    {
-                        eids.emplace_back(eid);
-                    }
-                }
-            }
+            ++it;
+            continue;
         }
+        difference.emplace_back(it->first);
+        it = endpoints.erase(it);
     }
 
-    /* Find the removed EID */
-    std::sort(listEids.begin(), listEids.end());
-    std::sort(eids.begin(), eids.end());
-    std::vector<mctp_eid_t> difference;
-    std::set_difference(listEids.begin(), listEids.end(), eids.begin(),
-                        eids.end(), std::back_inserter(difference));
-
-    /* Update the list EIDs with the current endpoints in MCTP D-Bus */
-    listEids = eids;
-    /* ToDo: Do somethings with the removed MCTP endpoints */
-
+    /* The removed terminus are kept for the grace period, in case the
+     * endpoint comes back */
     if (difference.size() && devManager)
     {
         devManager->removeDevices(difference);
@@ -1,10 +1,14 @@
 #pragma once
 
+#include "common/types.hpp"
 #include "fw-update/manager.hpp"
 #include "requester/terminus_manager.hpp"
 
 #include <sdbusplus/bus/match.hpp>
 
+#include <map>
+#include <string>
+
 namespace pldm
 {
 
@@ -44,6 +48,20 @@ class MctpDiscovery
 
     void dicoverEndpoints(sdbusplus::message_t& msg);
 
+    /** @brief Hand the added endpoints to the firmware and device managers
+     *
+     *  @param[in] added - added PLDM endpoints and their UUID
+     */
+    void addEndpoints(const std::map<mctp_eid_t, std::string>& added);
+
+    /** @brief Read the PLDM endpoint of the interfaces of an MCTP object
+     *
+     *  @param[in] interfaces - interfaces of the object
+     *  @param[out] found - the PLDM endpoint and its UUID, empty if unknown
+     */
+    static void parseEndpoint(const dbus::InterfaceMap& interfaces,
+                              std::map<mctp_eid_t, std::string>& found);
+
     void removeEndpoints(sdbusplus::message_t& msg);
 
     static constexpr uint8_t mctpTypePLDM = 1;
@@ -51,8 +69,12 @@ class MctpDiscovery
     static constexpr std::string_view mctpEndpointIntfName{
         "xyz.openbmc_project.MCTP.Endpoint"};
 
-    /* List MCTP endpoint in MCTP D-Bus interface or Static EID table */
-    std::vector<mctp_eid_t> listEids;
+    static constexpr std::string_view uuidIntfName{
+        "xyz.openbmc_project.Common.UUID"};
+
+    /* MCTP endpoints in MCTP D-Bus interface or Static EID table and their
+     * UUID */
+    std::map<mctp_eid_t, std::string> endpoints;
 };
 
 } // namespace pldm
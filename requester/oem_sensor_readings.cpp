@@ -0,0 +1,152 @@
+#include "oem_sensor_readings.hpp"
+
+#include <endian.h>
+
+#include <cstring>
+
+namespace pldm
+{
+
+namespace terminus
+{
+
+int encodeOemGetSensorReadingsReq(uint8_t instanceId,
+                                  std::span<const uint16_t> sensorIds,
+                                  pldm_msg* msg, size_t payloadLength)
+{
+    if (msg == nullptr || sensorIds.empty() ||
+        sensorIds.size() > PLDM_OEM_GET_SENSOR_READINGS_MAX)
+    {
+        return PLDM_ERROR_INVALID_DATA;
+    }
+    if (payloadLength != oemGetSensorReadingsReqBytes(sensorIds.size()))
+    {
+        return PLDM_ERROR_INVALID_LENGTH;
+    }
+
+    pldm_header_info header{};
+    header.msg_type = PLDM_REQUEST;
+    header.instance = instanceId;
+    header.pldm_type = PLDM_OEM;
+    header.command = PLDM_OEM_GET_SENSOR_READINGS;
+    auto rc = pack_pldm_header(&header, &msg->hdr);
+    if (rc != PLDM_SUCCESS)
+    {
+        return rc;
+    }
+
+    auto payload = msg->payload;
+    *payload++ = static_cast<uint8_t>(sensorIds.size());
+    for (auto sensorId : sensorIds)
+    {
+        uint16_t value = htole16(sensorId);
+        std::memcpy(payload, &value, sizeof(value));
+        payload += sizeof(value);
+    }
+
+    return PLDM_SUCCESS;
+}
+
+int decodeOemGetSensorReadingsResp(const pldm_msg* msg, size_t payloadLength,
+                                   uint8_t& completionCode,
+                                   std::vector<OemSensorReading>& readings)
+{
+    readings.clear();
+    if (msg == nullptr)
+    {
+        return PLDM_ERROR_INVALID_DATA;
+    }
+    if (payloadLength < sizeof(completionCode))
+    {
+        return PLDM_ERROR_INVALID_LENGTH;
+    }
+
+    auto payload = msg->payload;
+    auto end = payload + payloadLength;
+    completionCode = *payload++;
+    if (completionCode != PLDM_SUCCESS)
+    {
+        return PLDM_SUCCESS;
+    }
+    if (payload == end)
+    {
+        return PLDM_ERROR_INVALID_LENGTH;
+    }
+
+    auto count = *payload++;
+    if (count > PLDM_OEM_GET_SENSOR_READINGS_MAX)
+    {
+        return PLDM_ERROR_INVALID_DATA;
+    }
+    readings.reserve(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        /* Sensor ID, data size, operational state and event message
+         * enable */
+        constexpr size_t fixedBytes = sizeof(uint16_t) + 3;
+        if (static_cast<size_t>(end - payload) < fixedBytes)
+        {
+            readings.clear();
+            return PLDM_ERROR_INVALID_LENGTH;
+        }
+
+        OemSensorReading reading{};
+        uint16_t sensorId;
+        std::memcpy(&sensorId, payload, sizeof(sensorId));
+        reading.sensorId = le16toh(sensorId);
+        reading.dataSize = payload[2];
+        reading.operationalState = payload[3];
+        reading.eventMessageEnable = payload[4];
+        payload += fixedBytes;
+
+        size_t readingBytes = 0;
+        switch (reading.dataSize)
+        {
+            case PLDM_SENSOR_DATA_SIZE_UINT8:
+            case PLDM_SENSOR_DATA_SIZE_SINT8:
+                readingBytes = sizeof(uint8_t);
+                break;
+            case PLDM_SENSOR_DATA_SIZE_UINT16:
+            case PLDM_SENSOR_DATA_SIZE_SINT16:
+                readingBytes = sizeof(uint16_t);
+                break;
+            case PLDM_SENSOR_DATA_SIZE_UINT32:
+            case PLDM_SENSOR_DATA_SIZE_SINT32:
+                readingBytes = sizeof(uint32_t);
+                break;
+            default:
+                readings.clear();
+                return PLDM_ERROR_INVALID_DATA;
+        }
+        if (static_cast<size_t>(end - payload) < readingBytes)
+        {
+            readings.clear();
+            return PLDM_ERROR_INVALID_LENGTH;
+        }
+
+        if (readingBytes == sizeof(uint8_t))
+        {
+            reading.presentReading.value_u8 = *payload;
+        }
+        else if (readingBytes == sizeof(uint16_t))
+        {
+            uint16_t value;
+            std::memcpy(&value, payload, sizeof(value));
+            reading.presentReading.value_u16 = le16toh(value);
+        }
+        else
+        {
+            uint32_t value;
+            std::memcpy(&value, payload, sizeof(value));
+            reading.presentReading.value_u32 = le32toh(value);
+        }
+        payload += readingBytes;
+        readings.emplace_back(reading);
+    }
+
+    return PLDM_SUCCESS;
+}
+
+} // namespace terminus
+
+} // namespace pldm
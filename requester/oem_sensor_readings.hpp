@@ -0,0 +1,84 @@
+#pragma once
+
+#include <libpldm/base.h>
+#include <libpldm/platform.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace pldm
+{
+
+namespace terminus
+{
+
+/** @brief OEM command reading several compact numeric sensors at once, in
+ *  the PLDM OEM type
+ *
+ *  @details Request: number of sensors (1 byte), then the sensor IDs (2
+ *  bytes each). Response: completion code (1 byte), number of readings (1
+ *  byte), then for each reading the sensor ID (2 bytes), the sensor data
+ *  size, the operational state and the event message enable as in
+ *  GetSensorReading (1 byte each) and the present reading (1, 2 or 4 bytes
+ *  depending on the data size). The multi-byte fields are little endian.
+ */
+constexpr uint8_t PLDM_OEM_GET_SENSOR_READINGS = 0x01;
+
+/** @brief Number of sensors of one OEM GetSensorReadings request */
+constexpr size_t PLDM_OEM_GET_SENSOR_READINGS_MAX = 64;
+
+/** @struct OemSensorReading
+ *  @brief One reading of the OEM GetSensorReadings response
+ */
+struct OemSensorReading
+{
+    uint16_t sensorId;
+    uint8_t dataSize;
+    uint8_t operationalState;
+    uint8_t eventMessageEnable;
+    union_range_field_format presentReading;
+};
+
+/** @brief Payload length of the OEM GetSensorReadings request
+ *
+ *  @param[in] count - number of sensors
+ *
+ *  @return - request payload length
+ */
+constexpr size_t oemGetSensorReadingsReqBytes(size_t count)
+{
+    return sizeof(uint8_t) + count * sizeof(uint16_t);
+}
+
+/** @brief Encode the OEM GetSensorReadings request
+ *
+ *  @param[in] instanceId - instance ID of the request
+ *  @param[in] sensorIds - sensors to read
+ *  @param[out] msg - request message
+ *  @param[in] payloadLength - length of the request payload
+ *
+ *  @return - PLDM_SUCCESS or PLDM_ERROR_INVALID_DATA/LENGTH
+ */
+int encodeOemGetSensorReadingsReq(uint8_t instanceId,
+                                  std::span<const uint16_t> sensorIds,
+                                  pldm_msg* msg, size_t payloadLength);
+
+/** @brief Decode the OEM GetSensorReadings response
+ *
+ *  @param[in] msg - response message
+ *  @param[in] payloadLength - length of the response payload
+ *  @param[out] completionCode - completion code of the response
+ *  @param[out] readings - readings of the response, empty unless the
+ *                         completion code is PLDM_SUCCESS
+ *
+ *  @return - PLDM_SUCCESS or PLDM_ERROR_INVALID_DATA/LENGTH
+ */
+int decodeOemGetSensorReadingsResp(const pldm_msg* msg, size_t payloadLength,
+                                   uint8_t& completionCode,
+                                   std::vector<OemSensorReading>& readings);
+
+} // namespace terminus
+
+} // namespace pldm
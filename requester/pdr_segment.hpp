@@ -0,0 +1,164 @@
+#pragma once
+
+#include "common/memory_accounting.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace pldm
+{
+
+namespace terminus
+{
+
+/** @class PdrSegment
+ *
+ *  PDRs of one terminus kept in a single arena and indexed by their record
+ *  handle in BMC's PDR repo, so the PDRs of the terminus are found without
+ *  walking the whole repo and all dropped at once with the terminus. The
+ *  bytes of an erased PDR stay in the arena until the segment is compacted,
+ *  so the views returned by find() are valid until compact() or clear().
+ */
+class PdrSegment
+{
+  public:
+    /** @brief Size of the first block of the arena */
+    static constexpr size_t initialBlockSize = 4096;
+
+    PdrSegment() :
+        arena(std::make_unique<std::pmr::monotonic_buffer_resource>(
+            initialBlockSize, metrics::memoryResource("terminus_pdrs")))
+    {}
+    PdrSegment(const PdrSegment&) = delete;
+    PdrSegment& operator=(const PdrSegment&) = delete;
+
+    /** @brief Size the index and the first block of the arena before the
+     *         PDRs are added, e.g. from GetPDRRepositoryInfo
+     *
+     *  @param[in] records - number of PDRs expected
+     *  @param[in] bytes - bytes of the PDRs expected
+     */
+    void reserve(size_t records, size_t bytes)
+    {
+        this->records.reserve(records);
+        if (!liveBytes && !deadBytes && bytes > initialBlockSize)
+        {
+            arena = std::make_unique<std::pmr::monotonic_buffer_resource>(
+                bytes, metrics::memoryResource("terminus_pdrs"));
+        }
+    }
+
+    /** @brief Copy a PDR into the arena, replacing the one of the handle
+     *
+     *  @param[in] bmcRecordHandle - record handle in BMC's PDR repo
+     *  @param[in] pdr - PDR data
+     */
+    void add(uint32_t bmcRecordHandle, std::span<const uint8_t> pdr)
+    {
+        erase(bmcRecordHandle);
+        auto data = static_cast<uint8_t*>(
+            arena->allocate(std::max<size_t>(pdr.size(), 1), 1));
+        std::memcpy(data, pdr.data(), pdr.size());
+        records.insert_or_assign(bmcRecordHandle,
+                                 std::span<const uint8_t>(data, pdr.size()));
+        liveBytes += pdr.size();
+        firstHandle = std::min(firstHandle, bmcRecordHandle);
+        lastHandle = std::max(lastHandle, bmcRecordHandle);
+    }
+
+    /** @brief Find a PDR by its record handle in BMC's PDR repo
+     *
+     *  @return - view of the PDR, empty if not in the segment
+     */
+    std::span<const uint8_t> find(uint32_t bmcRecordHandle) const
+    {
+        if (bmcRecordHandle < firstHandle || bmcRecordHandle > lastHandle)
+        {
+            return {};
+        }
+        auto it = records.find(bmcRecordHandle);
+        return it == records.end() ? std::span<const uint8_t>{} : it->second;
+    }
+
+    /** @brief Drop a PDR from the index, its bytes stay in the arena */
+    void erase(uint32_t bmcRecordHandle)
+    {
+        auto it = records.find(bmcRecordHandle);
+        if (it == records.end())
+        {
+            return;
+        }
+        liveBytes -= it->second.size();
+        deadBytes += it->second.size();
+        records.erase(it);
+    }
+
+    /** @brief Copy the PDRs into a new arena once the erased ones take more
+     *         bytes than the others, invalidating the views
+     */
+    void compact()
+    {
+        if (deadBytes <= liveBytes)
+        {
+            return;
+        }
+        auto old = std::exchange(
+            arena, std::make_unique<std::pmr::monotonic_buffer_resource>(
+                       std::max(liveBytes, initialBlockSize),
+                       metrics::memoryResource("terminus_pdrs")));
+        for (auto& [handle, pdr] : records)
+        {
+            auto data = static_cast<uint8_t*>(
+                arena->allocate(std::max<size_t>(pdr.size(), 1), 1));
+            std::memcpy(data, pdr.data(), pdr.size());
+            pdr = std::span<const uint8_t>(data, pdr.size());
+        }
+        deadBytes = 0;
+    }
+
+    /** @brief Drop all the PDRs, releasing the arena in one go */
+    void clear()
+    {
+        records.clear();
+        arena->release();
+        liveBytes = 0;
+        deadBytes = 0;
+        firstHandle = std::numeric_limits<uint32_t>::max();
+        lastHandle = 0;
+    }
+
+    /** @brief Number of PDRs in the segment */
+    size_t size() const
+    {
+        return records.size();
+    }
+
+    /** @brief Bytes of the PDRs in the segment */
+    size_t bytes() const
+    {
+        return liveBytes;
+    }
+
+  private:
+    std::unique_ptr<std::pmr::monotonic_buffer_resource> arena;
+    std::unordered_map<uint32_t, std::span<const uint8_t>> records;
+    size_t liveBytes = 0;
+    size_t deadBytes = 0;
+    /** @brief Range of the record handles added, the records of BMC's own
+     *  PDRs and of the other termini are mostly outside of it */
+    uint32_t firstHandle = std::numeric_limits<uint32_t>::max();
+    uint32_t lastHandle = 0;
+};
+
+} // namespace terminus
+
+} // namespace pldm
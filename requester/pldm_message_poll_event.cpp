@@ -6,6 +6,7 @@
 #include "common/utils.hpp"
 
 #include <assert.h>
+#include <endian.h>
 #include <systemd/sd-journal.h>
 
 #include <nlohmann/json.hpp>
@@ -13,51 +14,79 @@
 #include <sdeventplus/exception.hpp>
 #include <sdeventplus/source/io.hpp>
 #include <sdeventplus/source/time.hpp>
-#ifdef AMPERE
-#include "com/ampere/CrashCapture/Trigger/server.hpp"
-#endif
 
 #include <algorithm>
-#include <chrono>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
-#include <functional>
 #include <iostream>
-#include <thread>
-#include <filesystem>
-#include <cstring>
-#include "cper.hpp"
+#include <limits>
 
 #undef DEBUG
 #define OEM_EVENT               0xFA
 
 #define CPER_FORMAT_TYPE        0
+#define FILE_FORMAT_TYPE        1
+
+/* Event data of a file announcement, after the CommonEventData header: the
+ * file identifier (2 bytes), the file size (4 bytes) and its kind (1 byte),
+ * little endian. The file is read with File Transfer instead of the event
+ * data transfer of the poll. */
+#define FILE_ANNOUNCEMENT_BYTES 7
+
+enum FileKind : uint8_t
+{
+    CPER_FILE = 0,
+    CRASH_DUMP_FILE = 1,
+};
 
 using namespace pldm::utils;
 
 namespace pldm
 {
 
+/** @brief Store of the CPER fault log files, shared by the termini */
+static CperStore& cperStore()
+{
+#if defined(CPER_COMPRESSION_ZSTD)
+    constexpr auto compression = CperStore::Compression::Zstd;
+#elif defined(CPER_COMPRESSION_LZ4)
+    constexpr auto compression = CperStore::Compression::Lz4;
+#else
+    constexpr auto compression = CperStore::Compression::None;
+#endif
+    static CperStore store(CPER_LOG_PATH, uint64_t{CPER_LOG_MAX_SIZE} * 1024,
+                           compression,
+                           std::chrono::seconds(CPER_DEDUP_WINDOW));
+    return store;
+}
+
 PldmMessagePollEvent::PldmMessagePollEvent(
     uint8_t eid, sdeventplus::Event& event, sdbusplus::bus::bus& bus,
     InstanceIdDb& instanceIdDb,
     pldm::requester::Handler<pldm::requester::Request>* handler) :
-    EventHandlerInterface(eid, event, bus, instanceIdDb, handler)
+    EventHandlerInterface(eid, event, bus, instanceIdDb, handler),
+    cperPipeline(cperStore(), CPER_PIPELINE_DEPTH),
+    fileReader(eid, instanceIdDb, handler, FILE_TRANSFER_WINDOW)
 {
     if (!std::filesystem::is_directory(CPER_LOG_PATH))
          std::filesystem::create_directories(CPER_LOG_PATH);
+    if (!std::filesystem::is_directory(CRASH_DUMP_PATH))
+         std::filesystem::create_directories(CRASH_DUMP_PATH);
 
     // register event class handler
     registerEventHandler(PLDM_MESSAGE_POLL_EVENT,
                          [&](uint8_t TID, uint8_t eventClass, uint16_t eventID,
-                             const std::vector<uint8_t> data) {
-                             return pldmPollForEventMessage(TID, eventClass,
-                                                            eventID, data);
+                             std::vector<uint8_t>&& data) {
+                             return pldmPollForEventMessage(
+                                 TID, eventClass, eventID, std::move(data));
                          });
     // TODO: update OEM class handler
     registerEventHandler(OEM_EVENT, [&](uint8_t TID, uint8_t eventClass,
                                         uint16_t eventID,
-                                        const std::vector<uint8_t> data) {
-        return pldmPollForEventMessage(TID, eventClass, eventID, data);
+                                        std::vector<uint8_t>&& data) {
+        return pldmPollForEventMessage(TID, eventClass, eventID,
+                                       std::move(data));
     });
 }
 
@@ -66,69 +95,99 @@ int PldmMessagePollEvent::pldmPollForEventMessage(uint8_t TID,
                                                   uint16_t eventID,
                                                   std::vector<uint8_t> data)
 {
-#ifdef DEBUG
-    std::cout << "\nOUTPUT DATA\n";
-    for (auto it = data.begin(); it != data.end(); it++)
+    if (data.size() == sizeof(CommonEventData) + FILE_ANNOUNCEMENT_BYTES &&
+        reinterpret_cast<const CommonEventData*>(data.data())->formatType ==
+            FILE_FORMAT_TYPE)
     {
-        std::cout << std::hex << (unsigned)*it << " ";
+        auto payload = data.data() + sizeof(CommonEventData);
+        uint16_t fileIdentifier = 0;
+        uint32_t fileSize = 0;
+        std::memcpy(&fileIdentifier, payload, sizeof(fileIdentifier));
+        std::memcpy(&fileSize, payload + sizeof(fileIdentifier),
+                    sizeof(fileSize));
+        auto kind = payload[sizeof(fileIdentifier) + sizeof(fileSize)];
+        [[maybe_unused]] auto co = fetchFile(TID, eventID,
+                                             le16toh(fileIdentifier),
+                                             le32toh(fileSize), kind);
+        return data.size();
     }
-    std::cout << "\n";
-#endif
-    long pos;
-    AmpereSpecData ampHdr;
-    CommonEventData evtData;
-    pos = 0;
-
-    std::memcpy((void*)&evtData, (void*)&data[pos], sizeof(CommonEventData));
-    pos += sizeof(CommonEventData);
-
-    if (!std::filesystem::is_directory(CPER_LOG_DIR))
-         std::filesystem::create_directories(CPER_LOG_DIR);
 
-    std::string cperFile = std::string(CPER_LOG_DIR) + "cper.dump." + std::to_string(TID);
-    std::ofstream out (cperFile.c_str(), std::ofstream::binary);
-    if(!out.is_open())
+    /* The file, the SEL and the fault log are written by the pipeline, the
+     * entry ID is taken here to keep the records in the polled order */
+    std::string prefix = "RAS_CPER_";
+    std::string primaryLogId = pldm::utils::getUniqueEntryID(prefix);
+    auto size = data.size();
+    if (!cperPipeline.submit(TID, eventID, std::move(primaryLogId),
+                             std::move(data)))
     {
-        std::cerr << "Can not open ofstream for CPER binary file\n";
         return -1;
     }
-    decodeCperRecord(data, pos, &ampHdr, out);
-    out.close();
 
-    std::string prefix = "RAS_CPER_";
-    std::string primaryLogId = pldm::utils::getUniqueEntryID(prefix);
-    std::string type = "CPER";
-    std::string faultLogFilePath = std::string(CPER_LOG_PATH) + primaryLogId;
-    std::filesystem::copy(cperFile.c_str(), faultLogFilePath.c_str());
-    std::filesystem::remove(cperFile.c_str());
-
-    addCperSELLog(TID, eventID, &ampHdr);
-    pldm::utils::addFaultLogToRedfish(primaryLogId, type);
+    return size;
+}
 
-#ifdef AMPERE
-    if (ampHdr.typeId.member.isBert)
+requester::Coroutine PldmMessagePollEvent::fetchFile(uint8_t tid,
+                                                     uint16_t eventID,
+                                                     uint16_t fileIdentifier,
+                                                     uint32_t size,
+                                                     uint8_t kind)
+{
+    if (kind == CPER_FILE)
     {
-        constexpr auto rasSrv = "com.ampere.CrashCapture.Trigger";
-        constexpr auto rasPath = "/com/ampere/crashcapture/trigger";
-        constexpr auto rasIntf = "com.ampere.CrashCapture.Trigger";
-        using namespace sdbusplus::xyz::openbmc_project::Logging::server;
-        std::variant<std::string> value("com.ampere.CrashCapture.Trigger.TriggerAction.Bert");
-        try
+        std::string prefix = "RAS_CPER_";
+        std::string primaryLogId = pldm::utils::getUniqueEntryID(prefix);
+        auto path = std::filesystem::path(CPER_LOG_PATH) /
+                    (primaryLogId + ".file");
+        auto token = fileReader.token();
+        auto rc = co_await fileReader.read(fileIdentifier, size, path);
+        if (rc != PLDM_SUCCESS || token.cancelled())
         {
-            auto& bus = pldm::utils::DBusHandler::getBus();
-            auto method = bus.new_method_call(rasSrv,rasPath,
-                dbusProperties, "Set");
-            method.append(rasIntf, "TriggerActions", value);
-            bus.call_noreply(method);
+            co_return rc;
         }
-        catch(const std::exception& e)
+
+        /* The pipeline takes the record as event data, behind the header of
+         * the CPER format */
+        std::vector<uint8_t> record(sizeof(CommonEventData) + size);
+        auto header = reinterpret_cast<CommonEventData*>(record.data());
+        header->formatType = CPER_FORMAT_TYPE;
+        header->length = htole16(static_cast<uint16_t>(
+            std::min<uint32_t>(size, std::numeric_limits<uint16_t>::max())));
+        std::ifstream file(path, std::ios::binary);
+        file.read(reinterpret_cast<char*>(record.data()) +
+                      sizeof(CommonEventData),
+                  size);
+        auto good = file.gcount() == static_cast<std::streamsize>(size);
+        file.close();
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        if (!good || !cperPipeline.submit(tid, eventID,
+                                          std::move(primaryLogId),
+                                          std::move(record)))
         {
-            std::cerr << "call BERT trigger error: " << e.what() << "\n" ;
+            co_return PLDM_ERROR;
         }
+        co_return PLDM_SUCCESS;
+    }
+
+    if (kind == CRASH_DUMP_FILE)
+    {
+        std::string prefix = "RAS_CRASHDUMP_";
+        std::string primaryLogId = pldm::utils::getUniqueEntryID(prefix);
+        auto path = std::filesystem::path(CRASH_DUMP_PATH) / primaryLogId;
+        auto rc = co_await fileReader.read(fileIdentifier, size, path);
+        if (rc != PLDM_SUCCESS)
+        {
+            co_return rc;
+        }
+        std::string type = "Crashdump";
+        pldm::utils::addFaultLogToRedfish(primaryLogId, type);
+        co_return PLDM_SUCCESS;
     }
-#endif
 
-    return data.size();
+    std::cerr << "Unknown kind " << unsigned(kind) << " of file "
+              << fileIdentifier << " announced by TID " << unsigned(tid)
+              << std::endl;
+    co_return PLDM_ERROR_INVALID_DATA;
 }
 
 
@@ -8,6 +8,8 @@
 #include "common/utils.hpp"
 #include "event_hander_interface.hpp"
 #include "libpldmresponder/event_parser.hpp"
+#include "requester/cper_pipeline.hpp"
+#include "requester/file_reader.hpp"
 #include "requester/handler.hpp"
 
 #include <systemd/sd-journal.h>
@@ -32,18 +34,42 @@ class PldmMessagePollEvent : public EventHandlerInterface
     ~PldmMessagePollEvent() = default;
     PldmMessagePollEvent() = delete;
     PldmMessagePollEvent(const PldmMessagePollEvent&) = delete;
-    PldmMessagePollEvent(PldmMessagePollEvent&&) = default;
+    PldmMessagePollEvent(PldmMessagePollEvent&&) = delete;
     PldmMessagePollEvent& operator=(const PldmMessagePollEvent&) = delete;
-    PldmMessagePollEvent& operator=(PldmMessagePollEvent&&) = default;
+    PldmMessagePollEvent& operator=(PldmMessagePollEvent&&) = delete;
 
     explicit PldmMessagePollEvent(
         uint8_t eid, sdeventplus::Event& event, sdbusplus::bus::bus& bus,
         InstanceIdDb& instanceIdDb,
         pldm::requester::Handler<pldm::requester::Request>* handler);
 
+    /** @brief Stop polling while the CPER pipeline is full */
+    bool isBackpressured() override
+    {
+        return cperPipeline.isFull();
+    }
+
   private:
     int pldmPollForEventMessage(uint8_t TID, uint8_t eventClass,
                                 uint16_t eventID, std::vector<uint8_t> data);
+
+    /** @brief Read a file announced by an event and log it
+     *
+     *  @param[in] tid - TID of the terminus
+     *  @param[in] eventID - event ID of the announcement
+     *  @param[in] fileIdentifier - identifier of the file
+     *  @param[in] size - size of the file in bytes
+     *  @param[in] kind - content of the file, FileKind
+     */
+    requester::Coroutine fetchFile(uint8_t tid, uint16_t eventID,
+                                   uint16_t fileIdentifier, uint32_t size,
+                                   uint8_t kind);
+
+    /** @brief Decodes, writes and logs the CPER records off the event loop */
+    CperPipeline cperPipeline;
+
+    /** @brief Reads the CPER and crash dump files of the terminus */
+    file_transfer::FileReader fileReader;
 };
 
 } // namespace pldm
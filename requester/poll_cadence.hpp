@@ -0,0 +1,80 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+
+namespace pldm
+{
+
+/** @class PollCadence
+ *
+ *  Interval of the normal RAS poll. It doubles each time a poll finds the
+ *  RAS queues of the terminus empty, up to the maximum, and snaps back to
+ *  the base interval on activity.
+ */
+class PollCadence
+{
+  public:
+    using Duration = std::chrono::milliseconds;
+
+    /** @brief Constructor
+     *
+     *  @param[in] base - interval while the terminus reports RAS events
+     *  @param[in] max - interval reached after repeated empty polls
+     */
+    PollCadence(Duration base, Duration max) :
+        base(base), max(std::max(base, max)), interval(base)
+    {}
+
+    /** @brief Back off after a poll found the RAS queues empty
+     *
+     *  @return - the new interval
+     */
+    Duration idle()
+    {
+        interval = std::min(interval * 2, max);
+        return interval;
+    }
+
+    /** @brief Snap back to the base interval on activity
+     *
+     *  @return - the new interval
+     */
+    Duration busy()
+    {
+        interval = base;
+        return interval;
+    }
+
+    /** @brief Change the base and the maximum intervals, the interval
+     *         snaps back to the new base
+     *
+     *  @param[in] newBase - interval while the terminus reports RAS events
+     *  @param[in] newMax - interval reached after repeated empty polls
+     */
+    void reset(Duration newBase, Duration newMax)
+    {
+        base = newBase;
+        max = std::max(newBase, newMax);
+        interval = base;
+    }
+
+    /** @brief Whether the interval is above the base interval */
+    bool isBackedOff() const
+    {
+        return interval > base;
+    }
+
+    /** @brief Current interval */
+    Duration current() const
+    {
+        return interval;
+    }
+
+  private:
+    Duration base;
+    Duration max;
+    Duration interval;
+};
+
+} // namespace pldm
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace pldm
+{
+
+/** @struct PollPhase
+ *  @brief Phase of the periodic polls of a terminus
+ *
+ *  @details A poll with this phase fires when the time elapsed since the
+ *  epoch, modulo its interval, is the fraction of the interval. The polls of
+ *  all termini share the epoch, so their phases hold whenever they were
+ *  started or restarted.
+ */
+struct PollPhase
+{
+    using Clock = std::chrono::steady_clock;
+
+    /** @brief Position of the polls in their interval, in [0, 1) */
+    double fraction = 0;
+    Clock::time_point epoch{};
+
+    /** @brief Phase shifted by a part of the interval, e.g. for another
+     *         kind of poll of the same terminus
+     */
+    PollPhase shifted(double part) const
+    {
+        auto shiftedFraction = fraction + part;
+        shiftedFraction -= static_cast<int64_t>(shiftedFraction);
+        return {shiftedFraction, epoch};
+    }
+
+    /** @brief Time to wait for the next poll of an interval
+     *
+     *  @param[in] interval - interval of the poll
+     *  @param[in] now - current time
+     *
+     *  @return - delay in ]0, interval]
+     */
+    std::chrono::milliseconds
+        delay(std::chrono::milliseconds interval,
+              Clock::time_point now = Clock::now()) const
+    {
+        if (interval.count() <= 0)
+        {
+            return interval;
+        }
+        auto elapsed =
+            std::chrono::duration_cast<std::chrono::milliseconds>(now - epoch)
+                .count();
+        auto period = interval.count();
+        auto offset = static_cast<int64_t>(fraction * period);
+        auto wait = (offset - elapsed % period) % period;
+        if (wait <= 0)
+        {
+            wait += period;
+        }
+        return std::chrono::milliseconds(wait);
+    }
+};
+
+/** @class PollPhases
+ *
+ *  Gives each terminus a phase of its polls so the termini started together,
+ *  e.g. at boot or on a polling profile switch, do not poll in lock-step.
+ *  The n-th slot gets the n-th fraction of the base 2 van der Corput
+ *  sequence, 0, 1/2, 1/4, 3/4, 1/8... so the phases of any number of
+ *  termini stay evenly spread. The slot of a removed terminus is reused.
+ */
+class PollPhases
+{
+  public:
+    /** @class Lease
+     *  @brief Slot held by a terminus, released when destroyed
+     */
+    class Lease
+    {
+      public:
+        Lease() = default;
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        Lease(Lease&& other) noexcept :
+            owner(other.owner), slot(other.slot)
+        {
+            other.owner = nullptr;
+        }
+
+        Lease& operator=(Lease&& other) noexcept
+        {
+            if (this != &other)
+            {
+                release();
+                owner = other.owner;
+                slot = other.slot;
+                other.owner = nullptr;
+            }
+            return *this;
+        }
+
+        ~Lease()
+        {
+            release();
+        }
+
+        /** @brief Phase of the slot, 0 from the epoch 0 if none is held */
+        PollPhase phase() const
+        {
+            if (!owner)
+            {
+                return {};
+            }
+            return {fractionOf(slot), owner->epoch};
+        }
+
+        /** @brief Slot held, 0 if none */
+        size_t index() const
+        {
+            return owner ? slot : 0;
+        }
+
+      private:
+        friend class PollPhases;
+
+        Lease(PollPhases* owner, size_t slot) : owner(owner), slot(slot) {}
+
+        void release()
+        {
+            if (owner)
+            {
+                owner->used[slot] = false;
+                owner = nullptr;
+            }
+        }
+
+        PollPhases* owner = nullptr;
+        size_t slot = 0;
+    };
+
+    explicit PollPhases(PollPhase::Clock::time_point epoch =
+                            PollPhase::Clock::now()) :
+        epoch(epoch)
+    {}
+
+    PollPhases(const PollPhases&) = delete;
+    PollPhases& operator=(const PollPhases&) = delete;
+
+    /** @brief Take the lowest free slot */
+    Lease acquire()
+    {
+        size_t slot = 0;
+        while (slot < used.size() && used[slot])
+        {
+            slot++;
+        }
+        if (slot == used.size())
+        {
+            used.emplace_back(false);
+        }
+        used[slot] = true;
+        return {this, slot};
+    }
+
+    /** @brief Fraction of the n-th slot, the base 2 radical inverse of n */
+    static double fractionOf(size_t slot)
+    {
+        double fraction = 0;
+        double weight = 0.5;
+        while (slot)
+        {
+            if (slot & 1)
+            {
+                fraction += weight;
+            }
+            slot >>= 1;
+            weight /= 2;
+        }
+        return fraction;
+    }
+
+  private:
+    PollPhase::Clock::time_point epoch;
+    std::vector<bool> used;
+};
+
+/** @brief Round offset of a slower sensor polling tier
+ *
+ *  @details A tier polled every `rounds` rounds reads its sensors in the
+ *  rounds whose number since the first one is the offset modulo `rounds`.
+ *  Half the tier shifted by the terminus keeps the power of two tiers of a
+ *  terminus out of each other's rounds and spreads the same tier of the
+ *  termini over different rounds.
+ *
+ *  @param[in] rounds - polling interval of the tier in number of rounds
+ *  @param[in] shift - rounds the terminus shifts its tiers by
+ */
+inline uint32_t tierRoundOffset(uint32_t rounds, uint32_t shift)
+{
+    if (rounds <= 1)
+    {
+        return 0;
+    }
+    return (rounds / 2 + shift) % rounds;
+}
+
+} // namespace pldm
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace pldm
+{
+
+/** @brief Polling profile of the termini, selected by the host state */
+enum class PollingProfile : uint8_t
+{
+    Boot,    //!< Host firmware is booting
+    Runtime, //!< Host OS is running
+    Idle,    //!< Host is off, the termini stay on standby power
+    Quiesce, //!< Host is quiesced, e.g. after a fatal error
+};
+
+constexpr size_t pollingProfileCount = 4;
+
+constexpr std::array<std::string_view, pollingProfileCount>
+    pollingProfileNames{"boot", "runtime", "idle", "quiesce"};
+
+/** @struct PollingProfileSettings
+ *  @brief Sensor and RAS polling cadence of a profile, the defaults are the
+ *  cadence configured at build time
+ */
+struct PollingProfileSettings
+{
+    /** @brief Interval of the sensor polling rounds */
+    std::chrono::milliseconds sensorInterval{POLL_SENSOR_TIMER_INTERVAL};
+    /** @brief Pause of the sensor polling after it backed off */
+    std::chrono::milliseconds sleepBetweenReads{
+        SLEEP_BETWEEN_GET_SENSOR_READING};
+    /** @brief Base interval of the normal RAS poll */
+    std::chrono::milliseconds rasInterval{NORMAL_RAS_EVENT_TIMER};
+    /** @brief Interval the normal RAS poll backs off to */
+    std::chrono::milliseconds rasMaxInterval{NORMAL_RAS_EVENT_MAX_TIMER};
+    /** @brief Multiplier of the rounds of the sensors polled in a slower
+     *  tier, the sensors polled every round are not scaled */
+    uint16_t tierScale = 1;
+
+    bool operator==(const PollingProfileSettings&) const = default;
+};
+
+using PollingProfiles =
+    std::array<PollingProfileSettings, pollingProfileCount>;
+
+/** @brief Profile of a name of pollingProfileNames */
+inline std::optional<PollingProfile> toPollingProfile(std::string_view name)
+{
+    for (size_t i = 0; i < pollingProfileNames.size(); i++)
+    {
+        if (pollingProfileNames[i] == name)
+        {
+            return static_cast<PollingProfile>(i);
+        }
+    }
+    return std::nullopt;
+}
+
+/** @brief Select the profile of the host state
+ *
+ *  @param[in] hostState - CurrentHostState of xyz.openbmc_project.State.Host
+ *  @param[in] bootProgress - BootProgress of
+ *                            xyz.openbmc_project.State.Boot.Progress
+ *
+ *  @return - the profile, Runtime while the host state is unknown or the host
+ *            does not report its boot progress
+ */
+inline PollingProfile selectPollingProfile(std::string_view hostState,
+                                           std::string_view bootProgress)
+{
+    constexpr std::string_view statePrefix =
+        "xyz.openbmc_project.State.Host.HostState.";
+    constexpr std::string_view progressPrefix =
+        "xyz.openbmc_project.State.Boot.Progress.ProgressStages.";
+
+    if (hostState.starts_with(statePrefix))
+    {
+        auto state = hostState.substr(statePrefix.size());
+        if (state == "Off" || state == "Standby")
+        {
+            return PollingProfile::Idle;
+        }
+        if (state == "Quiesced" || state == "DiagnosticMode")
+        {
+            return PollingProfile::Quiesce;
+        }
+        if (state != "Running" && state != "TransitioningToRunning")
+        {
+            return PollingProfile::Runtime;
+        }
+    }
+
+    if (!bootProgress.starts_with(progressPrefix))
+    {
+        return PollingProfile::Runtime;
+    }
+    auto stage = bootProgress.substr(progressPrefix.size());
+    if (stage == "Unspecified" || stage == "OSRunning")
+    {
+        return PollingProfile::Runtime;
+    }
+    return PollingProfile::Boot;
+}
+
+} // namespace pldm
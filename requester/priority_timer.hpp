@@ -0,0 +1,109 @@
+#pragma once
+
+#include <systemd/sd-event.h>
+
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/event.hpp>
+#include <sdeventplus/source/time.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <utility>
+
+namespace pldm
+{
+
+/** @class PriorityTimer
+ *
+ *  Monotonic timer of the event loop dispatched at a given sd-event
+ *  priority, with the part of sdeventplus::utility::Timer the RAS polls
+ *  use. When several sources of a saturated loop are pending, the one of
+ *  the lowest priority value is dispatched first, so a timer of the
+ *  critical RAS lane fires ahead of the sensor polls, the D-Bus calls and
+ *  the firmware update queued at the normal priority.
+ */
+class PriorityTimer
+{
+  public:
+    using Clock = sdeventplus::Clock<sdeventplus::ClockId::Monotonic>;
+    using Time = sdeventplus::source::Time<sdeventplus::ClockId::Monotonic>;
+    using Duration = std::chrono::microseconds;
+    using Callback = std::function<void()>;
+
+    PriorityTimer() = delete;
+    PriorityTimer(const PriorityTimer&) = delete;
+    PriorityTimer& operator=(const PriorityTimer&) = delete;
+
+    /** @brief Create a disabled timer
+     *
+     *  @param[in] event - event loop
+     *  @param[in] callback - called at each expiry
+     *  @param[in] priority - sd-event priority of the timer
+     */
+    PriorityTimer(const sdeventplus::Event& event, Callback&& callback,
+                  int64_t priority = SD_EVENT_PRIORITY_NORMAL) :
+        clock(event), callback(std::move(callback)),
+        source(event, clock.now(), std::chrono::milliseconds{1},
+               [this](Time&, Time::TimePoint) { expire(); })
+    {
+        source.set_priority(priority);
+        source.set_enabled(sdeventplus::source::Enabled::Off);
+    }
+
+    bool isEnabled() const
+    {
+        return source.get_enabled() != sdeventplus::source::Enabled::Off;
+    }
+
+    void setEnabled(bool enabled)
+    {
+        source.set_enabled(enabled ? sdeventplus::source::Enabled::On
+                                   : sdeventplus::source::Enabled::Off);
+    }
+
+    /** @brief Expire once in remaining, then at the interval if any */
+    void setRemaining(Duration remaining)
+    {
+        source.set_time(clock.now() + remaining);
+    }
+
+    /** @brief Expire periodically, the first time after one interval */
+    void restart(Duration interval)
+    {
+        this->interval = interval;
+        setRemaining(interval);
+        setEnabled(true);
+    }
+
+    /** @brief Expire once, after delay */
+    void restartOnce(Duration delay)
+    {
+        interval.reset();
+        setRemaining(delay);
+        setEnabled(true);
+    }
+
+  private:
+    void expire()
+    {
+        if (interval)
+        {
+            setRemaining(*interval);
+        }
+        else
+        {
+            setEnabled(false);
+        }
+        callback();
+    }
+
+    Clock clock;
+    Callback callback;
+    std::optional<Duration> interval;
+    Time source;
+};
+
+} // namespace pldm
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "common/flight_recorder.hpp"
+#include "common/metrics.hpp"
+#include "common/request_trace.hpp"
 #include "common/transport.hpp"
 #include "common/types.hpp"
 #include "common/utils.hpp"
@@ -15,6 +17,7 @@
 #include <chrono>
 #include <functional>
 #include <iostream>
+#include <memory>
 
 PHOSPHOR_LOG2_USING;
 
@@ -27,7 +30,9 @@ namespace requester
  *  The abstract base class for implementing the PLDM request retry logic. This
  *  class handles number of times the PLDM request needs to be retried if the
  *  response is not received and the time to wait between each retry. It
- *  provides APIs to start and stop the request flow.
+ *  provides APIs to start and stop the request flow. The retries are timed by
+ *  a timer of the request, or by the caller which then calls retry() on each
+ *  timeout so that no timer is created per request.
  */
 class RequestRetryTimer
 {
@@ -49,15 +54,16 @@ class RequestRetryTimer
                                std::chrono::milliseconds timeout) :
 
         event(event),
-        numRetries(numRetries), timeout(timeout),
-        timer(event.get(), std::bind_front(&RequestRetryTimer::callback, this))
+        numRetries(numRetries), timeout(timeout)
     {}
 
     /** @brief Starts the request flow and arms the timer for request retries
+     *
+     *  @param[in] armTimer - false if the caller times the retries
      *
      *  @return return PLDM_SUCCESS on success and PLDM_ERROR otherwise
      */
-    int start()
+    int start(bool armTimer = true)
     {
         auto rc = send();
         if (rc)
@@ -67,10 +73,13 @@ class RequestRetryTimer
 
         try
         {
-            if (numRetries)
+            if (numRetries && armTimer)
             {
-                timer.start(duration_cast<std::chrono::microseconds>(timeout),
-                            true);
+                timer = std::make_unique<phosphor::Timer>(
+                    event.get(),
+                    std::bind_front(&RequestRetryTimer::callback, this));
+                timer->start(duration_cast<std::chrono::microseconds>(timeout),
+                             true);
             }
         }
         catch (const std::runtime_error& e)
@@ -83,10 +92,53 @@ class RequestRetryTimer
         return PLDM_SUCCESS;
     }
 
+    /** @brief Send one retry if any is left
+     *
+     *  @return true if the request was sent again
+     */
+    bool retry()
+    {
+        if (!numRetries)
+        {
+            return false;
+        }
+        numRetries--;
+        static auto& retries = pldm::metrics::Registry::get().counter(
+            "pldm_request_retries",
+            "Requests sent again after the response timeout");
+        retries.inc();
+        traceRetry();
+        retriesSent++;
+        send();
+        return true;
+    }
+
+    /** @brief Number of retries left */
+    uint8_t getRetriesLeft() const
+    {
+        return numRetries;
+    }
+
+    /** @brief Time to wait between each retry */
+    std::chrono::milliseconds getTimeout() const
+    {
+        return timeout;
+    }
+
+    /** @brief Number of times the request was sent again */
+    uint8_t getRetriesSent() const
+    {
+        return retriesSent;
+    }
+
     /** @brief Stops the timer and no further request retries happen */
     void stop()
     {
-        auto rc = timer.stop();
+        if (!timer)
+        {
+            return;
+        }
+        auto rc = timer->stop();
         if (rc)
         {
             error("Failed to stop the request timer. RC = {RC}", "RC",
@@ -99,7 +151,9 @@ class RequestRetryTimer
     uint8_t numRetries;        //!< number of request retries
     std::chrono::milliseconds
         timeout;           //!< time to wait between each retry in milliseconds
-    phosphor::Timer timer; //!< manages starting timers and handling timeouts
+    std::unique_ptr<phosphor::Timer>
+        timer;               //!< retry timer, unset if the caller times them
+    uint8_t retriesSent = 0; //!< number of retries sent
 
     /** @brief Sends the PLDM request message
      *
@@ -107,14 +161,13 @@ class RequestRetryTimer
      */
     virtual int send() const = 0;
 
+    /** @brief Record a retry in the request trace */
+    virtual void traceRetry() const {}
+
     /** @brief Callback function invoked when the timeout happens */
     void callback()
     {
-        if (numRetries--)
-        {
-            send();
-        }
-        else
+        if (!retry())
         {
             stop();
         }
@@ -138,7 +191,13 @@ class Request final : public RequestRetryTimer
     Request(Request&&) = delete;
     Request& operator=(const Request&) = delete;
     Request& operator=(Request&&) = delete;
-    ~Request() = default;
+
+    /** @brief The message buffer goes back to the pool for the next requests
+     */
+    ~Request()
+    {
+        pldm::utils::RequestPool::release(std::move(requestMsg));
+    }
 
     /** @brief Constructor
      *
@@ -166,6 +225,14 @@ class Request final : public RequestRetryTimer
     pldm::Request requestMsg;     //!< PLDM request message
     bool verbose;                 //!< verbose tracing flag
 
+    void traceRetry() const override
+    {
+        auto hdr = reinterpret_cast<const pldm_msg_hdr*>(requestMsg.data());
+        pldm::requesttrace::RequestTrace::GetInstance().record(
+            pldm::requesttrace::TracePoint::Retry, eid, hdr->instance_id,
+            hdr->type, hdr->command);
+    }
+
     /** @brief Sends the PLDM request message on the socket
      *
      *  @return return PLDM_SUCCESS on success and PLDM_ERROR otherwise
@@ -177,7 +244,7 @@ class Request final : public RequestRetryTimer
             pldm::utils::printBuffer(pldm::utils::Tx, requestMsg);
         }
         pldm::flightrecorder::FlightRecorder::GetInstance().saveRecord(
-            requestMsg, true);
+            requestMsg, true, eid);
         const struct pldm_msg_hdr* hdr =
             (struct pldm_msg_hdr*)(requestMsg.data());
         if (!hdr->request)
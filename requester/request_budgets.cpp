@@ -0,0 +1,180 @@
+#include "requester/request_budgets.hpp"
+
+#include "requester/handler.hpp"
+
+#include <nlohmann/json.hpp>
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace requester
+{
+
+RequestBudgets::RequestBudgets(sdbusplus::bus::bus& bus,
+                               const std::string& path,
+                               BandwidthGovernor& governor,
+                               std::function<void()> changed) :
+    governor(governor),
+    changed(std::move(changed)), path(path)
+{
+    for (size_t cls = 0; cls < numRequestPriorities; cls++)
+    {
+        std::string name = requestPriorityNames[cls];
+        properties.emplace_back(name + "Rate", cls, Field::Rate);
+        properties.emplace_back(name + "Burst", cls, Field::Burst);
+        properties.emplace_back(name + "Utilization", cls, Field::Utilization);
+        properties.emplace_back(name + "Deferrals", cls, Field::Deferrals);
+    }
+
+    /* The vtable keeps pointers to the names, they live in this object */
+    vtable.emplace_back(sdbusplus::vtable::start());
+    for (const auto& property : properties)
+    {
+        if (property.field == Field::Rate || property.field == Field::Burst)
+        {
+            vtable.emplace_back(sdbusplus::vtable::property(
+                property.name.c_str(), "t", &RequestBudgets::getProperty,
+                &RequestBudgets::setProperty));
+        }
+        else
+        {
+            vtable.emplace_back(sdbusplus::vtable::property(
+                property.name.c_str(), "t", &RequestBudgets::getProperty));
+        }
+    }
+    vtable.emplace_back(sdbusplus::vtable::end());
+
+    object = std::make_unique<sdbusplus::server::interface::interface>(
+        bus, this->path.c_str(), requestBudgetsIntf, vtable.data(), this);
+}
+
+bool RequestBudgets::load(const std::filesystem::path& path)
+{
+    if (!std::filesystem::exists(path))
+    {
+        return true;
+    }
+    std::ifstream jsonFile(path);
+    auto data = nlohmann::json::parse(jsonFile, nullptr, false);
+    if (data.is_discarded() || !data.is_object())
+    {
+        error("Parsing request budgets config file failed, FILE={FILE}",
+              "FILE", path);
+        return false;
+    }
+
+    auto budgets = data.value("budgets", nlohmann::json::object());
+    for (const auto& [name, entry] : budgets.items())
+    {
+        auto it = std::find_if(requestPriorityNames.begin(),
+                               requestPriorityNames.end(),
+                               [&name](const char* priorityName) {
+            return name == priorityName;
+        });
+        if (it == requestPriorityNames.end() || !entry.is_object())
+        {
+            error("Unknown request class {CLASS} in {FILE}", "CLASS", name,
+                  "FILE", path);
+            continue;
+        }
+        BandwidthGovernor::Budget budget{entry.value("rate", uint64_t(0)),
+                                         entry.value("burst", uint64_t(0))};
+        auto cls = static_cast<size_t>(it - requestPriorityNames.begin());
+        governor.setBudget(cls, budget);
+        info("Request class {CLASS} budget {RATE} bytes/s, burst {BURST}",
+             "CLASS", name, "RATE", budget.rate, "BURST", budget.burst);
+    }
+    return true;
+}
+
+const RequestBudgets::Property* RequestBudgets::find(const char* name) const
+{
+    for (const auto& property : properties)
+    {
+        if (!std::strcmp(property.name.c_str(), name))
+        {
+            return &property;
+        }
+    }
+    return nullptr;
+}
+
+int RequestBudgets::getProperty(sd_bus* /*bus*/, const char* /*path*/,
+                                const char* /*interface*/,
+                                const char* property, sd_bus_message* reply,
+                                void* context, sd_bus_error* /*error*/)
+{
+    auto budgets = static_cast<RequestBudgets*>(context);
+    auto entry = budgets->find(property);
+    if (!entry)
+    {
+        return -EINVAL;
+    }
+
+    uint64_t value = 0;
+    switch (entry->field)
+    {
+        case Field::Rate:
+            value = budgets->governor.getBudget(entry->cls).rate;
+            break;
+        case Field::Burst:
+            value = budgets->governor.getBudget(entry->cls).burst;
+            break;
+        case Field::Utilization:
+            value = budgets->governor.utilization(entry->cls);
+            break;
+        case Field::Deferrals:
+            value = budgets->governor.deferrals(entry->cls);
+            break;
+    }
+    return sd_bus_message_append(reply, "t", value);
+}
+
+int RequestBudgets::setProperty(sd_bus* /*bus*/, const char* /*path*/,
+                                const char* /*interface*/,
+                                const char* property, sd_bus_message* value,
+                                void* context, sd_bus_error* /*error*/)
+{
+    auto budgets = static_cast<RequestBudgets*>(context);
+    auto entry = budgets->find(property);
+    if (!entry)
+    {
+        return -EINVAL;
+    }
+
+    uint64_t newValue = 0;
+    auto rc = sd_bus_message_read(value, "t", &newValue);
+    if (rc < 0)
+    {
+        return rc;
+    }
+
+    auto budget = budgets->governor.getBudget(entry->cls);
+    if (entry->field == Field::Rate)
+    {
+        budget.rate = newValue;
+    }
+    else
+    {
+        budget.burst = newValue;
+    }
+    budgets->governor.setBudget(entry->cls, budget);
+    info("Request class {CLASS} budget set to {RATE} bytes/s, burst {BURST}",
+         "CLASS", requestPriorityNames[entry->cls], "RATE", budget.rate,
+         "BURST", budget.burst);
+    if (budgets->changed)
+    {
+        budgets->changed();
+    }
+    return 1;
+}
+
+} // namespace requester
+} // namespace pldm
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "requester/bandwidth_governor.hpp"
+
+#include <systemd/sd-bus.h>
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/server/interface.hpp>
+#include <sdbusplus/vtable.hpp>
+
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace pldm
+{
+namespace requester
+{
+
+/** @brief D-Bus interface of the request budgets */
+constexpr auto requestBudgetsIntf = "xyz.openbmc_project.PLDM.RequestBudgets";
+
+/** @class RequestBudgets
+ *
+ *  Configures the byte budgets of the request scheduling classes from a JSON
+ *  file, and puts them on D-Bus. For each class the <Class>Rate and
+ *  <Class>Burst properties are writable and take effect at once, the
+ *  <Class>Utilization property is the bytes per second which the class used
+ *  over the last second and <Class>Deferrals the number of times its
+ *  requests waited for the budget. As for the other counters of the daemon,
+ *  no PropertiesChanged signal is emitted.
+ *
+ *  The JSON file maps the class names to their budget, a missing class or a
+ *  rate of 0 is not limited:
+ *  {"budgets": {"Bulk": {"rate": 16384, "burst": 4096}}}
+ */
+class RequestBudgets
+{
+  public:
+    RequestBudgets() = delete;
+    RequestBudgets(const RequestBudgets&) = delete;
+    RequestBudgets& operator=(const RequestBudgets&) = delete;
+
+    /** @brief Put the budgets on the bus
+     *
+     *  @param[in] bus - D-Bus connection
+     *  @param[in] path - object path
+     *  @param[in] governor - budgets of the requester Handler
+     *  @param[in] changed - called when a budget is set over D-Bus, sends the
+     *                       requests which the new budget allows
+     */
+    RequestBudgets(sdbusplus::bus::bus& bus, const std::string& path,
+                   BandwidthGovernor& governor, std::function<void()> changed);
+
+    /** @brief Load the budgets of the config file
+     *
+     *  @param[in] path - path of the JSON file
+     *
+     *  @return - true if the file is missing or valid
+     */
+    bool load(const std::filesystem::path& path);
+
+  private:
+    /** @brief Field of a class exported as a property */
+    enum class Field
+    {
+        Rate,
+        Burst,
+        Utilization,
+        Deferrals,
+    };
+
+    struct Property
+    {
+        std::string name;
+        size_t cls;
+        Field field;
+    };
+
+    /** @brief Find the property of a name, nullptr if unknown */
+    const Property* find(const char* name) const;
+
+    /** @brief sd-bus getter of the properties */
+    static int getProperty(sd_bus* bus, const char* path,
+                           const char* interface, const char* property,
+                           sd_bus_message* reply, void* context,
+                           sd_bus_error* error);
+
+    /** @brief sd-bus setter of the rates and bursts */
+    static int setProperty(sd_bus* bus, const char* path,
+                           const char* interface, const char* property,
+                           sd_bus_message* value, void* context,
+                           sd_bus_error* error);
+
+    BandwidthGovernor& governor;
+    std::function<void()> changed;
+    std::string path;
+    std::vector<Property> properties;
+    std::vector<sdbusplus::vtable::vtable_t> vtable;
+    std::unique_ptr<sdbusplus::server::interface::interface> object;
+};
+
+} // namespace requester
+} // namespace pldm
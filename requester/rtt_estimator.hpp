@@ -0,0 +1,86 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+
+namespace pldm
+{
+namespace requester
+{
+
+/** @class RttEstimator
+ *
+ *  Retry timeout of one kind of request, estimated from the measured
+ *  round-trip times the Jacobson/Karels way: a smoothed RTT and its mean
+ *  deviation, with the timeout at SRTT + 4 * RTTVAR bounded by a floor and
+ *  a cap. A timeout doubles the retry timeout, and the RTT of a retried
+ *  request is not sampled since it can't tell which send was answered
+ *  (Karn's algorithm).
+ */
+class RttEstimator
+{
+  public:
+    using Duration = std::chrono::microseconds;
+
+    /** @brief Constructor
+     *
+     *  @param[in] initial - timeout before the first sample
+     *  @param[in] floor - lowest timeout
+     *  @param[in] cap - highest timeout
+     */
+    RttEstimator(Duration initial, Duration floor, Duration cap) :
+        floor(floor), cap(std::max(floor, cap)),
+        timeout(std::clamp(initial, floor, this->cap))
+    {}
+
+    /** @brief Update the estimate with the RTT of a request answered on
+     *         its first send
+     *
+     *  @param[in] rtt - measured round-trip time
+     */
+    void sample(Duration rtt)
+    {
+        if (!sampled)
+        {
+            srtt = rtt;
+            rttvar = rtt / 2;
+            sampled = true;
+        }
+        else
+        {
+            auto delta = srtt > rtt ? srtt - rtt : rtt - srtt;
+            rttvar = (rttvar * 3 + delta) / 4;
+            srtt = (srtt * 7 + rtt) / 8;
+        }
+        timeout = std::clamp(srtt + rttvar * 4, floor, cap);
+    }
+
+    /** @brief Double the timeout after a request timed out */
+    void backoff()
+    {
+        timeout = std::min(timeout * 2, cap);
+    }
+
+    /** @brief Current retry timeout */
+    Duration current() const
+    {
+        return timeout;
+    }
+
+    /** @brief Smoothed RTT, zero before the first sample */
+    Duration smoothed() const
+    {
+        return srtt;
+    }
+
+  private:
+    Duration floor;
+    Duration cap;
+    Duration timeout;
+    Duration srtt{0};
+    Duration rttvar{0};
+    bool sampled = false;
+};
+
+} // namespace requester
+} // namespace pldm
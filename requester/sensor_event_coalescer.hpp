@@ -0,0 +1,179 @@
+#pragma once
+
+#include "libpldm/platform.h"
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace pldm
+{
+
+/** @class SensorEventCoalescer
+ *
+ *  Bounds the updates caused by the numeric sensor events of a flapping
+ *  sensor. The first event of a sensor is handled at once and opens a
+ *  window, the events of the sensor received during the window are held.
+ *  When the window ends the latest held event is released, preceded by the
+ *  held event of the highest severity if it crossed a more severe threshold
+ *  than the latest one, and a new window opens. A sensor thus causes at most
+ *  three updates per window however many events it sends.
+ */
+class SensorEventCoalescer
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /** @struct Event
+     *  @brief Numeric sensor event of a terminus
+     */
+    struct Event
+    {
+        uint8_t tid;
+        uint16_t sensorId;
+        uint8_t eventState;
+        uint8_t sensorDataSize;
+        uint32_t presentReading;
+
+        bool operator==(const Event&) const = default;
+    };
+
+    /** @brief Constructor
+     *
+     *  @param[in] window - time the events of a sensor are held after one
+     *                      is handled
+     */
+    explicit SensorEventCoalescer(std::chrono::milliseconds window) :
+        window(window)
+    {}
+
+    /** @brief Add an event
+     *
+     *  @param[in] event - numeric sensor event
+     *  @param[in] now - time the event is received
+     *
+     *  @return - true if the event is handled at once, false if it is held
+     *            until the window of the sensor ends
+     */
+    bool add(const Event& event, Clock::time_point now)
+    {
+        auto& slot = slots[key(event.tid, event.sensorId)];
+        if (slot.windowEnd <= now && !slot.latest)
+        {
+            slot.windowEnd = now + window;
+            return true;
+        }
+
+        coalescedCount++;
+        slot.latest = event;
+        if (!slot.worst || severity(event.eventState) >
+                               severity(slot.worst->eventState))
+        {
+            slot.worst = event;
+        }
+        return false;
+    }
+
+    /** @brief Release the held events of the windows which ended, a sensor
+     *         with no held event is forgotten
+     *
+     *  @param[in] now - current time
+     *
+     *  @return - the events to handle, in order for each sensor
+     */
+    std::vector<Event> expire(Clock::time_point now)
+    {
+        std::vector<Event> released;
+        for (auto it = slots.begin(); it != slots.end();)
+        {
+            auto& slot = it->second;
+            if (slot.windowEnd > now)
+            {
+                ++it;
+                continue;
+            }
+            if (!slot.latest)
+            {
+                it = slots.erase(it);
+                continue;
+            }
+            if (severity(slot.worst->eventState) >
+                severity(slot.latest->eventState))
+            {
+                released.push_back(*slot.worst);
+            }
+            released.push_back(*slot.latest);
+            slot.latest.reset();
+            slot.worst.reset();
+            slot.windowEnd = now + window;
+            ++it;
+        }
+        return released;
+    }
+
+    /** @brief End of the earliest window, unset if there is none */
+    std::optional<Clock::time_point> nextDeadline() const
+    {
+        std::optional<Clock::time_point> deadline;
+        for (const auto& [id, slot] : slots)
+        {
+            if (!deadline || slot.windowEnd < *deadline)
+            {
+                deadline = slot.windowEnd;
+            }
+        }
+        return deadline;
+    }
+
+    /** @brief Number of events which were held */
+    uint64_t coalesced() const
+    {
+        return coalescedCount;
+    }
+
+    /** @brief Severity of a numeric sensor state, higher is more severe */
+    static int severity(uint8_t eventState)
+    {
+        switch (eventState)
+        {
+            case PLDM_SENSOR_WARNING:
+            case PLDM_SENSOR_LOWERWARNING:
+            case PLDM_SENSOR_UPPERWARNING:
+                return 1;
+            case PLDM_SENSOR_CRITICAL:
+            case PLDM_SENSOR_LOWERCRITICAL:
+            case PLDM_SENSOR_UPPERCRITICAL:
+                return 2;
+            case PLDM_SENSOR_FATAL:
+            case PLDM_SENSOR_LOWERFATAL:
+            case PLDM_SENSOR_UPPERFATAL:
+                return 3;
+            default:
+                return 0;
+        }
+    }
+
+  private:
+    /** @struct Slot
+     *  @brief Window and held events of a sensor
+     */
+    struct Slot
+    {
+        Clock::time_point windowEnd{};
+        std::optional<Event> latest;
+        std::optional<Event> worst;
+    };
+
+    static uint32_t key(uint8_t tid, uint16_t sensorId)
+    {
+        return (uint32_t(tid) << 16) | sensorId;
+    }
+
+    std::chrono::milliseconds window;
+    std::unordered_map<uint32_t, Slot> slots;
+    uint64_t coalescedCount = 0;
+};
+
+} // namespace pldm
@@ -0,0 +1,161 @@
+#include "requester/sensor_history_server.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <limits>
+
+namespace pldm
+{
+namespace requester
+{
+
+namespace
+{
+
+constexpr auto notFoundError =
+    "xyz.openbmc_project.Common.Error.ResourceNotFound";
+
+/** @brief Longest window, the window in nanoseconds must not overflow */
+constexpr uint64_t maxWindowMs = 1000ull * 60 * 60 * 24 * 365;
+
+} // namespace
+
+SensorHistoryServer::SensorHistoryServer(sdbusplus::bus::bus& bus,
+                                         const std::string& path,
+                                         Lookup lookup) :
+    lookup(std::move(lookup)),
+    path(path)
+{
+    vtable.emplace_back(sdbusplus::vtable::start());
+    vtable.emplace_back(sdbusplus::vtable::method(
+        "GetAggregate", "ot", "ttdddd", &SensorHistoryServer::getAggregate));
+    vtable.emplace_back(sdbusplus::vtable::method(
+        "GetSamples", "ot", "a(td)", &SensorHistoryServer::getSamples));
+    vtable.emplace_back(sdbusplus::vtable::method(
+        "GetFreshness", "o", "tt", &SensorHistoryServer::getFreshness));
+    vtable.emplace_back(sdbusplus::vtable::end());
+
+    object = std::make_unique<sdbusplus::server::interface::interface>(
+        bus, this->path.c_str(), sensorHistoryIntf, vtable.data(), this);
+}
+
+int SensorHistoryServer::readArgs(
+    sd_bus_message* msg, sensor::PldmSensor*& sensor,
+    sensor::SensorHistory::Clock::duration& window, sd_bus_error* error) const
+{
+    const char* sensorPath = nullptr;
+    uint64_t windowMs = 0;
+    auto rc = sd_bus_message_read(msg, "ot", &sensorPath, &windowMs);
+    if (rc < 0)
+    {
+        return rc;
+    }
+
+    sensor = lookup(sensorPath);
+    if (!sensor || !sensor->hasHistory())
+    {
+        return sd_bus_error_setf(error, notFoundError,
+                                 "No reading history of %s", sensorPath);
+    }
+    window = std::chrono::milliseconds(std::min(windowMs, maxWindowMs));
+    return 0;
+}
+
+int SensorHistoryServer::getAggregate(sd_bus_message* msg, void* context,
+                                      sd_bus_error* error)
+{
+    auto server = static_cast<SensorHistoryServer*>(context);
+    sensor::PldmSensor* sensor = nullptr;
+    sensor::SensorHistory::Clock::duration window{};
+    auto rc = server->readArgs(msg, sensor, window, error);
+    if (rc < 0)
+    {
+        return rc;
+    }
+
+    auto aggregate = *sensor->getHistoryAggregate(window);
+    return sd_bus_reply_method_return(
+        msg, "ttdddd", aggregate.count, aggregate.unavailable, aggregate.min,
+        aggregate.max, aggregate.average, aggregate.latest);
+}
+
+int SensorHistoryServer::getSamples(sd_bus_message* msg, void* context,
+                                    sd_bus_error* error)
+{
+    auto server = static_cast<SensorHistoryServer*>(context);
+    sensor::PldmSensor* sensor = nullptr;
+    sensor::SensorHistory::Clock::duration window{};
+    auto rc = server->readArgs(msg, sensor, window, error);
+    if (rc < 0)
+    {
+        return rc;
+    }
+
+    auto samples = *sensor->getHistorySamples(window);
+    auto steadyNow = sensor::SensorHistory::Clock::now();
+    auto systemNow = std::chrono::system_clock::now();
+
+    sd_bus_message* reply = nullptr;
+    rc = sd_bus_message_new_method_return(msg, &reply);
+    if (rc < 0)
+    {
+        return rc;
+    }
+    rc = sd_bus_message_open_container(reply, 'a', "(td)");
+    for (size_t i = 0; rc >= 0 && i < samples.size(); i++)
+    {
+        auto time = systemNow - (steadyNow - samples[i].time);
+        uint64_t timeMs =
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                time.time_since_epoch())
+                .count();
+        rc = sd_bus_message_append(reply, "(td)", timeMs, samples[i].value);
+    }
+    if (rc >= 0)
+    {
+        rc = sd_bus_message_close_container(reply);
+    }
+    if (rc >= 0)
+    {
+        rc = sd_bus_send(nullptr, reply, nullptr);
+    }
+    sd_bus_message_unref(reply);
+    return rc < 0 ? rc : 1;
+}
+
+int SensorHistoryServer::getFreshness(sd_bus_message* msg, void* context,
+                                      sd_bus_error* error)
+{
+    auto server = static_cast<SensorHistoryServer*>(context);
+    const char* sensorPath = nullptr;
+    auto rc = sd_bus_message_read(msg, "o", &sensorPath);
+    if (rc < 0)
+    {
+        return rc;
+    }
+
+    auto sensor = server->lookup(sensorPath);
+    if (!sensor)
+    {
+        return sd_bus_error_setf(error, notFoundError, "No sensor %s",
+                                 sensorPath);
+    }
+
+    auto lastRead = sensor->lastReadTime();
+    if (lastRead == std::chrono::steady_clock::time_point{})
+    {
+        return sd_bus_reply_method_return(msg, "tt", uint64_t(0),
+                                          std::numeric_limits<uint64_t>::max());
+    }
+    uint64_t timeMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                          sensor->lastReadWallTime().time_since_epoch())
+                          .count();
+    uint64_t ageMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                         std::chrono::steady_clock::now() - lastRead)
+                         .count();
+    return sd_bus_reply_method_return(msg, "tt", timeMs, ageMs);
+}
+
+} // namespace requester
+} // namespace pldm
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "sensors/pldm_sensor.hpp"
+
+#include <systemd/sd-bus.h>
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/server/interface.hpp>
+#include <sdbusplus/vtable.hpp>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace pldm
+{
+namespace requester
+{
+
+/** @brief D-Bus interface of the sensor reading history */
+constexpr auto sensorHistoryIntf = "xyz.openbmc_project.PLDM.SensorHistory";
+
+/** @class SensorHistoryServer
+ *
+ *  Serves the reading history of the terminus sensors on D-Bus, so that the
+ *  telemetry consumers get the aggregates of a window without polling the
+ *  Value of the sensors:
+ *
+ *  GetAggregate(o sensor, t windowMs) -> (t count, t unavailable, d min,
+ *                                         d max, d average, d latest)
+ *  GetSamples(o sensor, t windowMs) -> a(td)
+ *
+ *  GetFreshness(o sensor) -> (t lastReadMs, t ageMs)
+ *
+ *  The samples are the readings of the window, oldest first, with their time
+ *  in milliseconds since the epoch. A sensor without history fails with the
+ *  xyz.openbmc_project.Common.Error.ResourceNotFound error. GetFreshness
+ *  needs no history, it returns the wall clock time of the last successful
+ *  read in milliseconds since the epoch and its age measured on the
+ *  monotonic clock, (0, UINT64_MAX) if the sensor was never read, so a
+ *  consumer tells a current Value from a stale one.
+ */
+class SensorHistoryServer
+{
+  public:
+    /** @brief Find a sensor by its D-Bus path, nullptr if unknown */
+    using Lookup = std::function<sensor::PldmSensor*(std::string_view)>;
+
+    SensorHistoryServer() = delete;
+    SensorHistoryServer(const SensorHistoryServer&) = delete;
+    SensorHistoryServer& operator=(const SensorHistoryServer&) = delete;
+
+    /** @brief Put the history methods on the bus
+     *
+     *  @param[in] bus - D-Bus connection
+     *  @param[in] path - object path
+     *  @param[in] lookup - finds the sensors of the termini
+     */
+    SensorHistoryServer(sdbusplus::bus::bus& bus, const std::string& path,
+                        Lookup lookup);
+
+  private:
+    /** @brief Read the sensor and the window of a method call
+     *
+     *  @param[in] msg - method call
+     *  @param[out] sensor - sensor with a history
+     *  @param[out] window - window of the call
+     *  @param[out] error - set if the sensor has no history
+     *
+     *  @return - negative errno on failure
+     */
+    int readArgs(sd_bus_message* msg, sensor::PldmSensor*& sensor,
+                 sensor::SensorHistory::Clock::duration& window,
+                 sd_bus_error* error) const;
+
+    /** @brief sd-bus handler of GetAggregate */
+    static int getAggregate(sd_bus_message* msg, void* context,
+                            sd_bus_error* error);
+
+    /** @brief sd-bus handler of GetSamples */
+    static int getSamples(sd_bus_message* msg, void* context,
+                          sd_bus_error* error);
+
+    /** @brief sd-bus handler of GetFreshness */
+    static int getFreshness(sd_bus_message* msg, void* context,
+                            sd_bus_error* error);
+
+    Lookup lookup;
+    std::string path;
+    std::vector<sdbusplus::vtable::vtable_t> vtable;
+    std::unique_ptr<sdbusplus::server::interface::interface> object;
+};
+
+} // namespace requester
+} // namespace pldm
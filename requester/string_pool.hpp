@@ -0,0 +1,165 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace pldm
+{
+
+/** @class StringPool
+ *
+ *  Arena of interned strings, e.g. the auxiliary names of the sensors and
+ *  effecters of a terminus. The strings are written once into large chunks
+ *  and handed out as views which stay valid until clear(), a string which is
+ *  already in the pool is not stored again.
+ */
+class StringPool
+{
+  public:
+    static constexpr size_t chunkSize = 4096;
+
+    /** @brief Intern a string
+     *
+     *  @param[in] str - string to intern
+     *
+     *  @return - view of the pooled string
+     */
+    std::string_view intern(std::string_view str)
+    {
+        auto it = strings.find(str);
+        if (it != strings.end())
+        {
+            return *it;
+        }
+        auto tail = reserve(str.size());
+        std::copy(str.begin(), str.end(), tail);
+        return commit(std::string_view(tail, str.size()));
+    }
+
+    /** @brief Intern a NUL terminated UTF-16BE string as UTF-8, e.g. a name
+     *         of an auxiliary name PDR. An unpaired surrogate is replaced
+     *         with U+FFFD.
+     *
+     *  @param[in] data - UTF-16BE code units, the string ends at the first
+     *                    NUL unit or at the end of the data
+     *  @param[out] consumed - bytes of data read, with the NUL unit
+     *
+     *  @return - view of the pooled UTF-8 string
+     */
+    std::string_view internUtf16Be(std::span<const uint8_t> data,
+                                   size_t& consumed)
+    {
+        size_t units = 0;
+        while (units < data.size() / 2 &&
+               (data[units * 2] || data[units * 2 + 1]))
+        {
+            units++;
+        }
+        consumed = std::min(data.size(), (units + 1) * 2);
+
+        /* A unit takes at most 3 bytes of UTF-8, a surrogate pair 4 */
+        auto tail = reserve(units * 3);
+        auto end = tail;
+        for (size_t i = 0; i < units; i++)
+        {
+            uint32_t codePoint = unit(data, i);
+            if (codePoint >= 0xD800 && codePoint <= 0xDBFF && i + 1 < units &&
+                unit(data, i + 1) >= 0xDC00 && unit(data, i + 1) <= 0xDFFF)
+            {
+                codePoint = 0x10000 + ((codePoint - 0xD800) << 10) +
+                            (unit(data, ++i) - 0xDC00);
+            }
+            else if (codePoint >= 0xD800 && codePoint <= 0xDFFF)
+            {
+                codePoint = 0xFFFD;
+            }
+
+            if (codePoint < 0x80)
+            {
+                *end++ = static_cast<char>(codePoint);
+            }
+            else if (codePoint < 0x800)
+            {
+                *end++ = static_cast<char>(0xC0 | (codePoint >> 6));
+                *end++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+            else if (codePoint < 0x10000)
+            {
+                *end++ = static_cast<char>(0xE0 | (codePoint >> 12));
+                *end++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                *end++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+            else
+            {
+                *end++ = static_cast<char>(0xF0 | (codePoint >> 18));
+                *end++ = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+                *end++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                *end++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+        }
+
+        std::string_view str(tail, end - tail);
+        auto it = strings.find(str);
+        if (it != strings.end())
+        {
+            /* The transcoded copy stays unused at the tail */
+            return *it;
+        }
+        return commit(str);
+    }
+
+    /** @brief Drop all the strings, the views handed out are invalid */
+    void clear()
+    {
+        strings.clear();
+        chunks.clear();
+        used = 0;
+        capacity = 0;
+    }
+
+    /** @brief Number of distinct strings */
+    size_t size() const
+    {
+        return strings.size();
+    }
+
+  private:
+    static uint16_t unit(std::span<const uint8_t> data, size_t i)
+    {
+        return static_cast<uint16_t>(data[i * 2] << 8 | data[i * 2 + 1]);
+    }
+
+    /** @brief Room for size bytes at the tail of the last chunk */
+    char* reserve(size_t size)
+    {
+        if (chunks.empty() || capacity - used < size)
+        {
+            capacity = std::max(chunkSize, size);
+            chunks.emplace_back(std::make_unique<char[]>(capacity));
+            used = 0;
+        }
+        return chunks.back().get() + used;
+    }
+
+    /** @brief Keep the string written at the tail */
+    std::string_view commit(std::string_view str)
+    {
+        used += str.size();
+        strings.emplace(str);
+        return str;
+    }
+
+    std::vector<std::unique_ptr<char[]>> chunks;
+    /** @brief Bytes used and size of the last chunk */
+    size_t used = 0;
+    size_t capacity = 0;
+    std::unordered_set<std::string_view> strings;
+};
+
+} // namespace pldm
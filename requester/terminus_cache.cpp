@@ -0,0 +1,169 @@
+#include "requester/terminus_cache.hpp"
+
+#include "common/write_behind.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <limits>
+
+namespace pldm
+{
+
+namespace terminus
+{
+
+namespace
+{
+
+/** @struct CacheHeader
+ *  @brief Header at offset 0 of the terminus cache file. It is followed by
+ *  the PDR signature, the PDRs as (record handle, length, data) and the FRU
+ *  record table.
+ */
+struct CacheHeader
+{
+    uint32_t magic;         //!< terminusCacheMagic
+    uint16_t version;       //!< terminusCacheVersion
+    uint16_t signatureSize; //!< Size of the PDR signature
+    uint32_t pdrCount;      //!< Number of PDRs
+    uint8_t fruValid;       //!< FRU checksum and table are set
+    uint8_t reserved[3];    //!< Reserved, zero
+    uint32_t fruChecksum;   //!< Checksum of the FRU record table
+    uint32_t fruSize;       //!< Size of the FRU record table
+};
+static_assert(sizeof(CacheHeader) == 24);
+
+/** @brief Copy a value out of the file data and advance the offset
+ *
+ *  @return - false if the data is too short
+ */
+template <typename T>
+bool readValue(const std::vector<uint8_t>& data, size_t& offset, T& value)
+{
+    if (data.size() - offset < sizeof(T))
+    {
+        return false;
+    }
+    std::memcpy(&value, data.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return true;
+}
+
+/** @brief Copy size bytes out of the file data and advance the offset
+ *
+ *  @return - false if the data is too short
+ */
+bool readBytes(const std::vector<uint8_t>& data, size_t& offset, size_t size,
+               std::vector<uint8_t>& bytes)
+{
+    if (data.size() - offset < size)
+    {
+        return false;
+    }
+    bytes.assign(data.begin() + offset, data.begin() + offset + size);
+    offset += size;
+    return true;
+}
+
+template <typename T>
+void appendValue(std::vector<uint8_t>& data, const T& value)
+{
+    auto bytes = reinterpret_cast<const uint8_t*>(&value);
+    data.insert(data.end(), bytes, bytes + sizeof(T));
+}
+
+} // namespace
+
+bool TerminusCache::load(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)),
+                              std::istreambuf_iterator<char>());
+
+    size_t offset = 0;
+    CacheHeader header{};
+    if (!readValue(data, offset, header) || header.magic != terminusCacheMagic ||
+        header.version != terminusCacheVersion)
+    {
+        std::cerr << "Ignore the invalid terminus cache " << path << std::endl;
+        return false;
+    }
+
+    TerminusCache cache;
+    if (!readBytes(data, offset, header.signatureSize, cache.pdrSignature))
+    {
+        std::cerr << "Ignore the truncated terminus cache " << path
+                  << std::endl;
+        return false;
+    }
+
+    for (uint32_t i = 0; i < header.pdrCount; i++)
+    {
+        uint32_t recordHandle = 0;
+        uint32_t size = 0;
+        std::vector<uint8_t> pdr;
+        if (!readValue(data, offset, recordHandle) ||
+            !readValue(data, offset, size) ||
+            !readBytes(data, offset, size, pdr))
+        {
+            std::cerr << "Ignore the truncated terminus cache " << path
+                      << std::endl;
+            return false;
+        }
+        cache.pdrs.emplace_back(recordHandle, std::move(pdr));
+    }
+
+    cache.fruValid = header.fruValid;
+    cache.fruChecksum = header.fruChecksum;
+    if (!readBytes(data, offset, header.fruSize, cache.fruTable))
+    {
+        std::cerr << "Ignore the truncated terminus cache " << path
+                  << std::endl;
+        return false;
+    }
+
+    *this = std::move(cache);
+    return true;
+}
+
+bool TerminusCache::save(const std::filesystem::path& path) const
+{
+    if (pdrSignature.size() > std::numeric_limits<uint16_t>::max())
+    {
+        return false;
+    }
+
+    CacheHeader header{};
+    header.magic = terminusCacheMagic;
+    header.version = terminusCacheVersion;
+    header.signatureSize = static_cast<uint16_t>(pdrSignature.size());
+    header.pdrCount = static_cast<uint32_t>(pdrs.size());
+    header.fruValid = fruValid;
+    header.fruChecksum = fruChecksum;
+    header.fruSize = static_cast<uint32_t>(fruTable.size());
+
+    std::vector<uint8_t> data;
+    appendValue(data, header);
+    data.insert(data.end(), pdrSignature.begin(), pdrSignature.end());
+    for (const auto& [recordHandle, pdr] : pdrs)
+    {
+        appendValue(data, recordHandle);
+        appendValue(data, static_cast<uint32_t>(pdr.size()));
+        data.insert(data.end(), pdr.begin(), pdr.end());
+    }
+    data.insert(data.end(), fruTable.begin(), fruTable.end());
+
+    /* Written behind as a temporary file renamed, a crash while saving
+     * leaves the previous cache or no cache but never a partial one */
+    return pldm::utils::persistFile(path, std::move(data));
+}
+
+} // namespace terminus
+
+} // namespace pldm
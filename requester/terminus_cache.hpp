@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <utility>
+#include <vector>
+
+namespace pldm
+{
+
+namespace terminus
+{
+
+/** @brief Magic number of the terminus cache file, "PTRC" */
+constexpr uint32_t terminusCacheMagic = 0x43525450;
+/** @brief Layout version of the terminus cache file */
+constexpr uint16_t terminusCacheVersion = 1;
+
+/** @struct TerminusCache
+ *  @brief PDRs and FRU record table of one terminus kept on disk, so a warm
+ *  start of pldmd skips the GetPDR sweep and GetFRURecordTable.
+ *  @details The PDRs are valid while the signature built from the
+ *  GetPDRRepositoryInfo response is unchanged, the FRU table while the
+ *  checksum of GetFRURecordTableMetadata is unchanged.
+ */
+struct TerminusCache
+{
+    /** @brief Signature of the PDR repository of the terminus */
+    std::vector<uint8_t> pdrSignature;
+    /** @brief BMC record handle and data of each PDR, in the order of the
+     *  terminus repository */
+    std::vector<std::pair<uint32_t, std::vector<uint8_t>>> pdrs;
+    /** @brief Whether fruChecksum and fruTable are set */
+    bool fruValid = false;
+    /** @brief Checksum of the FRU record table */
+    uint32_t fruChecksum = 0;
+    /** @brief FRU record table data */
+    std::vector<uint8_t> fruTable;
+
+    /** @brief Load the cache file
+     *
+     *  @param[in] path - path of the cache file
+     *
+     *  @return - true if the file exists and is well formed
+     */
+    bool load(const std::filesystem::path& path);
+
+    /** @brief Save the cache file, replacing the previous one atomically,
+     *         on the write-behind of the process if there is one
+     *
+     *  @param[in] path - path of the cache file
+     *
+     *  @return - true on success or once queued to be written behind
+     */
+    bool save(const std::filesystem::path& path) const;
+};
+
+} // namespace terminus
+
+} // namespace pldm
@@ -2,9 +2,25 @@
 
 #include "terminus_handler.hpp"
 
+#include "common/loop_monitor.hpp"
+#include "common/pdr_index.hpp"
+#include "common/rate_limited_log.hpp"
+#include "common/startup_profile.hpp"
+#include "common/transfer_size.hpp"
+#include "requester/file_transfer.hpp"
+#include "requester/oem_sensor_readings.hpp"
+
+#include <libpldm/utils.h>
+
 #include <sdeventplus/source/time.hpp>
 
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <cstring>
+#include <format>
+#include <limits>
+#include <numeric>
 
 namespace pldm
 {
@@ -18,20 +34,28 @@ using EpochTimeUS = uint64_t;
 std::string fruPath = "/xyz/openbmc_project/pldm/fru";
 static constexpr uint16_t MCControlEffecterID = 254;
 
-std::string exec(const char *cmd)
+/** @brief Bitset of a bitfield8[N] field of a response, bit i of byte j is
+ *  bit 8 * j + i of the bitset
+ */
+template <size_t N>
+static std::bitset<N> toBitset(const std::vector<bitfield8_t>& fields)
+{
+    std::bitset<N> bits;
+    for (size_t i = 0; i < fields.size() && i < N / 8; i++)
+    {
+        bits |= std::bitset<N>(fields[i].byte) << (8 * i);
+    }
+    return bits;
+}
+
+#ifdef TERMINUS_PDR_CACHE_DIR
+/** @brief Path of the PDR and FRU cache file of the terminus */
+static std::filesystem::path getTerminusCachePath(uint8_t eid)
 {
-	std::array<char, 128> buffer;
-	std::string result;
-	std::unique_ptr<FILE, decltype(&pclose)> pipe(popen(cmd, "r"), pclose);
-	if (!pipe) {
-		std::cerr << "popen() failed!" << std::endl;
-		return "failed";
-	}
-	while (fgets(buffer.data(), buffer.size(), pipe.get()) != nullptr) {
-		result += buffer.data();
-	}
-	return result;
+    return std::filesystem::path(TERMINUS_PDR_CACHE_DIR) /
+           ("terminus_" + std::to_string(unsigned(eid)));
 }
+#endif
 
 TerminusHandler::TerminusHandler(
     uint8_t eid, sdeventplus::Event& event, sdbusplus::bus::bus& bus,
@@ -45,24 +69,38 @@ TerminusHandler::TerminusHandler(
     instanceIdDb(instanceIdDb), _state(),
     _timer(event, std::bind(&TerminusHandler::pollSensors, this)),
     _timer2(event, std::bind(&TerminusHandler::readSensor, this)),
-    _timer3(event, std::bind(&TerminusHandler::waitForRASPollingFinished, this)),
-    _timer4(event, std::bind(&TerminusHandler::waitForMProRecovery, this))
+    _timer4(event, std::bind(&TerminusHandler::mProRecoveryTimeout, this)),
+    _probeTimer(event, std::bind(&TerminusHandler::probeTerminus, this)),
+    _livenessTimer(event, std::bind(&TerminusHandler::livenessExpired, this))
 {}
 
 TerminusHandler::~TerminusHandler()
 {
     continuePollSensor = false;
+    transfer::TransferSizes::get().erase(eid);
     this->frus.clear();
     this->compNumSensorPDRs.clear();
     this->effecterAuxNamePDRs.clear();
     this->effecterPDRs.clear();
     this->_state.clear();
+    this->sensorTable = {};
+    this->sensorRows.clear();
+    /* All the sensors are retracted before any of them is torn down */
+    retractSensors();
     this->_sensorObjects.clear();
+    this->sensorPollRounds.clear();
+    this->eventDrivenSensors.clear();
+    this->sensorSnapshot.reset();
+    this->bmcRecordHandles.clear();
+    this->pdrSegment.clear();
     this->_effecterLists.clear();
     this->eventDataHndl.reset();
     this->_auxNameMaps.clear();
+    this->auxNamePool.clear();
     this->parents.clear();
+    this->entityNodes.clear();
     pldm_pdr_remove_remote_pdrs(repo);
+    pldm::utils::notifyPdrRepoChanged();
     pldm_entity_association_tree_destroy_root(entityTree);
     pldm_entity_association_tree_copy_root(bmcEntityTree, entityTree);
 }
@@ -87,9 +125,13 @@ requester::Coroutine TerminusHandler::discoveryTerminus()
      * 1.4.2 Get FRU Table data via GetFRURecordTable
      *
      * 1.5. If PLDM Platform Type is supported, get PLDM Platform commands
-     * 1.5.1 Prepare to receive event notification SetEventReceiver
-     * 1.5.2 Get all Sensor/Effecter/Association information via GetPDR command
+     * 1.5.1 Get all Sensor/Effecter/Association information via GetPDR command
+     * 1.5.2 Prepare to receive event notification SetEventReceiver
      *
+     * The steps only wait for the steps they depend on: 1.2 and 1.3 start
+     * once the types are known, 1.5.1 once the commands are known and 1.4
+     * once the TID is known. The requests of the concurrent steps share the
+     * window of outstanding requests of the terminus.
      */
     auto rc = co_await getPLDMTypes();
     if (rc)
@@ -100,57 +142,87 @@ requester::Coroutine TerminusHandler::discoveryTerminus()
     /* Received the response, terminus is on */
     this->responseReceived = true;
 
+    loadTerminusCache();
+
+    std::optional<requester::Coroutine> commands;
+    std::optional<requester::Coroutine> tid;
+    std::optional<requester::Coroutine> dateTime;
     if (supportPLDMType(PLDM_BASE))
     {
-        rc = co_await getPLDMCommands();
+        commands.emplace(getPLDMCommands());
+        tid.emplace(getTID());
+    }
+    if (supportPLDMType(PLDM_BIOS))
+    {
+        dateTime.emplace(setDateTime());
+    }
+
+    if (commands)
+    {
+        rc = co_await *commands;
         if (rc)
         {
             std::cerr << "Failed to getPLDMCommands, rc=" << unsigned(rc)
                       << std::endl;
         }
     }
-
-    if (supportPLDMType(PLDM_BASE))
+    /* The PDRs and the FRU table are transferred in parts of the size
+     * negotiated here, or probed by the first GetPDR */
+    transfer::TransferSizes::get().erase(eid);
+    if (supportPLDMCommand(PLDM_BASE, transfer::negotiateTransferParameters))
     {
-        rc = co_await getTID();
+        rc = co_await negotiateTransferParameters();
         if (rc)
         {
-            std::cerr << "Failed to getTID, rc=" << unsigned(rc) << std::endl;
+            std::cerr << "Failed to negotiateTransferParameters, rc="
+                      << unsigned(rc) << std::endl;
         }
     }
+    batchSensorReads =
+        SENSOR_BATCH_READ_SIZE > 0 &&
+        supportPLDMCommand(PLDM_OEM, PLDM_OEM_GET_SENSOR_READINGS);
+    if (batchSensorReads)
+    {
+        info("EID {EID} reads up to {COUNT} sensors per request", "EID",
+             unsigned(eid), "COUNT", SENSOR_BATCH_READ_SIZE);
+    }
 
-    if (supportPLDMType(PLDM_BIOS))
+    std::optional<requester::Coroutine> pdrs;
+    if (supportPLDMType(PLDM_PLATFORM))
     {
-        rc = co_await setDateTime();
+        pdrs.emplace(discoverPDRs());
+    }
+
+    if (tid)
+    {
+        rc = co_await *tid;
         if (rc)
         {
-            std::cerr << "Failed to setDateTime, rc=" << unsigned(rc)
-                      << std::endl;
+            std::cerr << "Failed to getTID, rc=" << unsigned(rc) << std::endl;
         }
     }
 
-    uint16_t totalTableRecords = 0;
+    std::optional<requester::Coroutine> fru;
     if (supportPLDMType(PLDM_FRU))
     {
-        rc = co_await getFRURecordTableMetadata(&totalTableRecords);
-        if (rc)
-        {
-            std::cerr << "Failed to getFRURecordTableMetadata, "
-                      << "rc=" << unsigned(rc) << std::endl;
-        }
-        if (!totalTableRecords)
-        {
-            std::cerr << "Number of record table is not correct." << std::endl;
-        }
+        fru.emplace(discoverFRU());
     }
 
-    if ((totalTableRecords != 0) && supportPLDMType(PLDM_FRU))
+    if (fru)
+    {
+        co_await *fru;
+    }
+    if (pdrs)
+    {
+        co_await *pdrs;
+    }
+    if (dateTime)
     {
-        rc = co_await getFRURecordTable(totalTableRecords);
+        rc = co_await *dateTime;
         if (rc)
         {
-            std::cerr << "Failed to getFRURecordTable, "
-                      << "rc=" << unsigned(rc) << std::endl;
+            std::cerr << "Failed to setDateTime, rc=" << unsigned(rc)
+                      << std::endl;
         }
     }
 
@@ -160,52 +232,12 @@ requester::Coroutine TerminusHandler::discoveryTerminus()
         co_return PLDM_SUCCESS;
     }
 
-    if (supportPLDMType(PLDM_PLATFORM))
-    {
-        if (debugGetPDR)
-        {
-            startTime = std::chrono::system_clock::now();
-            std::cerr << eidToName.second << " Start GetPDR at "
-                      << getCurrentSystemTime() << std::endl;
-        }
-
-        rc = co_await getDevPDR(0);
-        if (rc)
-        {
-            std::cerr << "Failed to setEventReceiver, rc=" << unsigned(rc)
-                      << std::endl;
-        }
-        else
-        {
-            readCount = 0;
-            if (debugGetPDR)
-            {
-                std::chrono::duration<double> elapsed_seconds =
-                    std::chrono::system_clock::now() - startTime;
-                std::cerr << eidToName.second << " Finish get all PDR "
-                          << elapsed_seconds.count() << "s at "
-                          << getCurrentSystemTime() << std::endl;
-            }
-            if (this->compNumSensorPDRs.size() > 0)
-            {
-                this->createCompactNummericSensorIntf(this->compNumSensorPDRs);
-            }
-            if (this->effecterAuxNamePDRs.size() > 0)
-            {
-                this->parseAuxNamePDRs(this->effecterAuxNamePDRs);
-            }
-            if (this->effecterPDRs.size() > 0)
-            {
-                this->createNummericEffecterDBusIntf(this->effecterPDRs);
-            }
-            if (_state.size() > 0)
-            {
-                createdDbusObject = true;
-            }
-            updateSensorKeys();
-        }
-    }
+    saveTerminusCache();
+    pdrSignature = discoveredCache.pdrSignature;
+    loadedCache.reset();
+    discoveredCache = TerminusCache{};
 
+    [[maybe_unused]] bool eventReceiverSet = false;
     if (supportPLDMType(PLDM_PLATFORM))
     {
         rc = co_await setEventReceiver();
@@ -214,39 +246,204 @@ requester::Coroutine TerminusHandler::discoveryTerminus()
             std::cerr << "Failed to setEventReceiver, rc=" << unsigned(rc)
                       << std::endl;
         }
+        eventReceiverSet = rc == PLDM_SUCCESS;
     }
+    heartbeatExpected = eventReceiverSet;
 
     /* Start RAS */
     eventDataHndl = std::make_shared<PldmMessagePollEvent>(eid, event, bus,
                                                            instanceIdDb, handler);
+    eventDataHndl->setPollCadence(pollingProfile.rasInterval,
+                                  pollingProfile.rasMaxInterval);
+    eventDataHndl->setPollPhase(pollPhase.phase());
+#ifdef RAS_EVENT_PUSH_MODE
+    /* The terminus sends the message poll events only once the BMC is its
+     * event receiver, else keep polling periodically */
+    if (eventReceiverSet)
+    {
+        info("EID {EID} polls the RAS events on notification", "EID",
+             unsigned(eid));
+        eventDataHndl->setPushMode(
+            true, std::chrono::milliseconds(RAS_SAFETY_POLL_INTERVAL));
+    }
+#endif
+    pldm::utils::StartupProfile::get().mark(
+        pldm::utils::StartupProfile::Phase::FirstTerminusDiscovered);
 
     co_return PLDM_SUCCESS;
 }
 
-bool TerminusHandler::supportPLDMType(const uint8_t type)
+requester::Coroutine TerminusHandler::discoverFRU()
 {
-    if (devInfo.supportedTypes[type / 8].byte & (1 << (type % 8)))
+    uint16_t totalTableRecords = 0;
+    auto rc = co_await getFRURecordTableMetadata(&totalTableRecords,
+                                                 &discoveredCache.fruChecksum);
+    if (rc)
     {
-        return true;
+        std::cerr << "Failed to getFRURecordTableMetadata, "
+                  << "rc=" << unsigned(rc) << std::endl;
+    }
+    if (!totalTableRecords)
+    {
+        std::cerr << "Number of record table is not correct." << std::endl;
+        co_return PLDM_ERROR;
     }
 
-    return false;
+    if (loadedCache && loadedCache->fruValid &&
+        loadedCache->fruChecksum == discoveredCache.fruChecksum)
+    {
+        std::cerr << "Discovery Terminus: " << unsigned(eid)
+                  << " use the cached FRU record Table." << std::endl;
+        discoveredCache.fruTable = std::move(loadedCache->fruTable);
+        discoveredCache.fruValid = true;
+        size_t fruRecordTableLength = discoveredCache.fruTable.size();
+        parseFruRecordTable(discoveredCache.fruTable.data(),
+                            fruRecordTableLength);
+        co_return PLDM_SUCCESS;
+    }
+
+    rc = co_await getFRURecordTable(totalTableRecords);
+    if (rc)
+    {
+        std::cerr << "Failed to getFRURecordTable, "
+                  << "rc=" << unsigned(rc) << std::endl;
+    }
+
+    co_return rc;
 }
 
-bool TerminusHandler::supportPLDMCommand(const uint8_t type,
-                                         const uint8_t command)
+requester::Coroutine TerminusHandler::discoverPDRs()
 {
-    if (!supportPLDMType(type))
+    /* Check whether the terminus is removed when discoverying */
+    if (stopTerminusPolling)
     {
-        return false;
+        co_return PLDM_SUCCESS;
     }
-    if (devInfo.supportedCmds[type].cmdTypes[command / 8].byte &
-        (1 << (command % 8)))
+
+    if (debugGetPDR)
     {
-        return true;
+        startTime = std::chrono::system_clock::now();
+        std::cerr << eidToName.second << " Start GetPDR at "
+                  << getCurrentSystemTime() << std::endl;
     }
 
-    return false;
+    int rc = PLDM_SUCCESS;
+    if (supportPLDMCommand(PLDM_PLATFORM, PLDM_GET_PDR_REPOSITORY_INFO))
+    {
+        rc = co_await getPDRRepositoryInfo(discoveredCache.pdrSignature);
+        if (rc)
+        {
+            std::cerr << "Failed to getPDRRepositoryInfo, rc=" << unsigned(rc)
+                      << std::endl;
+            discoveredCache.pdrSignature.clear();
+        }
+    }
+    reservePDRCapacity();
+
+    if (!discoveredCache.pdrSignature.empty() && loadedCache &&
+        loadedCache->pdrSignature == discoveredCache.pdrSignature)
+    {
+        std::cerr << "Discovery Terminus: " << unsigned(eid) << " use "
+                  << loadedCache->pdrs.size() << " cached PDRs." << std::endl;
+        for (const auto& [rh, pdr] : loadedCache->pdrs)
+        {
+            processPDR(pdr, rh);
+        }
+        discoveredCache.pdrs = std::move(loadedCache->pdrs);
+        rc = PLDM_SUCCESS;
+    }
+    else
+    {
+        /* The repository changed since the cache was saved, its known
+         * record handles are fetched concurrently. A sweep still follows the
+         * chain when the handles changed too */
+        rc = PLDM_ERROR;
+        if (!discoveredCache.pdrSignature.empty() && loadedCache &&
+            !loadedCache->pdrs.empty())
+        {
+            rc = co_await getKnownPDRs(loadedCache->pdrs);
+        }
+        if (rc)
+        {
+            rc = co_await getDevPDR(0);
+        }
+    }
+    if (rc)
+    {
+        std::cerr << "Failed to getDevPDR, rc=" << unsigned(rc) << std::endl;
+        /* Do not cache a partial PDR set */
+        discoveredCache.pdrSignature.clear();
+        discoveredCache.pdrs.clear();
+        co_return rc;
+    }
+
+    readCount = 0;
+    if (debugGetPDR)
+    {
+        std::chrono::duration<double> elapsed_seconds =
+            std::chrono::system_clock::now() - startTime;
+        std::cerr << eidToName.second << " Finish get all PDR "
+                  << elapsed_seconds.count() << "s at "
+                  << getCurrentSystemTime() << std::endl;
+    }
+    createDiscoveredSensors(true);
+    if (this->effecterAuxNamePDRs.size() > 0)
+    {
+        this->parseAuxNamePDRs(getPDRViews(this->effecterAuxNamePDRs));
+    }
+    if (this->effecterPDRs.size() > 0)
+    {
+        this->createNummericEffecterDBusIntf(getPDRViews(this->effecterPDRs));
+    }
+    if (_state.size() > 0)
+    {
+        createdDbusObject = true;
+    }
+    updateSensorKeys();
+    createSensorSnapshot();
+    info("{NAME}: {COUNT} sensors use about {BYTES} bytes", "NAME",
+         eidToName.second, "COUNT", sensorTable.size(), "BYTES",
+         sensorMemoryGauge->value());
+
+    co_return PLDM_SUCCESS;
+}
+
+void TerminusHandler::createDiscoveredSensors(bool done)
+{
+    PDRViews sensorPDRs;
+    for (const auto& pdr : getPDRViews(compNumSensorPDRs))
+    {
+        auto sensorPdr =
+            reinterpret_cast<const pldm_compact_numeric_sensor_pdr*>(
+                pdr.data());
+        if (discoveredSensorIds.contains(sensorPdr->sensor_id))
+        {
+            continue;
+        }
+        /* The sensor name ends with the TID of its terminus locator PDR */
+        if (!done && eidToName.second.empty() &&
+            !tlPDRInfo.contains(sensorPdr->terminus_handle))
+        {
+            continue;
+        }
+        discoveredSensorIds.insert(sensorPdr->sensor_id);
+        sensorPDRs.emplace_back(pdr);
+    }
+
+    if (!sensorPDRs.empty())
+    {
+        createCompactNummericSensorIntf(sensorPDRs);
+        /* Once done, the caller rebuilds the rows after the effecters are
+         * created too */
+        if (!done)
+        {
+            updateSensorKeys();
+        }
+    }
+    if (done)
+    {
+        discoveredSensorIds.clear();
+    }
 }
 
 std::string TerminusHandler::getCurrentSystemTime()
@@ -316,19 +513,10 @@ requester::Coroutine TerminusHandler::getPLDMTypes()
         std::cerr << "Faile to decode_get_types_resp, Message Error: "
                   << "rc=" << unsigned(rc) << ",cc=" << unsigned(cc)
                   << std::endl;
-        for (int i = 0; i < 8; i++)
-        {
-            devInfo.supportedTypes[i].byte = 0;
-        }
+        devInfo.supportedTypes.reset();
         co_return rc;
     }
-    else
-    {
-        for (int i = 0; i < 8; i++)
-        {
-            devInfo.supportedTypes[i] = types[i];
-        }
-    }
+    devInfo.supportedTypes = toBitset<64>(types);
 
     co_return cc;
 }
@@ -338,16 +526,19 @@ requester::Coroutine TerminusHandler::getPLDMCommands()
     std::cerr << "Discovery Terminus: " << unsigned(eid)
               << " get the supported PLDM Types." << std::endl;
 
-    uint8_t type = PLDM_BASE;
-    while ((type < PLDM_MAX_TYPES) && supportPLDMType(type))
+    /* The supported types are not contiguous, e.g. the OEM type */
+    for (uint8_t type = PLDM_BASE; type < PLDM_MAX_TYPES; type++)
     {
+        if (!supportPLDMType(type))
+        {
+            continue;
+        }
         auto rc = co_await getPLDMCommand(type);
         if (rc)
         {
             std::cerr << "Failed to getPLDMCommand, Type=" << unsigned(type)
                       << " rc =" << unsigned(rc) << std::endl;
         }
-        type++;
     }
     co_return PLDM_SUCCESS;
 }
@@ -404,20 +595,65 @@ requester::Coroutine TerminusHandler::getPLDMCommand(const uint8_t& pldmTypeIdx)
         std::cerr << "Response Message Error: "
                   << "rc=" << unsigned(rc) << ",cc=" << unsigned(cc)
                   << std::endl;
-        for (auto i = 0; i < 32; i++)
+        devInfo.supportedCmds[pldmTypeIdx].reset();
+        co_return rc;
+    }
+    devInfo.supportedCmds[pldmTypeIdx] = toBitset<256>(cmdTypes);
+
+    co_return cc;
+}
+
+requester::Coroutine TerminusHandler::negotiateTransferParameters()
+{
+    transfer::ProtocolSupport protocols{};
+    for (uint8_t type : {uint8_t(PLDM_PLATFORM), uint8_t(PLDM_BIOS),
+                         uint8_t(PLDM_FRU), file_transfer::PLDM_FILE_TRANSFER})
+    {
+        if (supportPLDMType(type))
         {
-            devInfo.supportedCmds[pldmTypeIdx].cmdTypes[i].byte = 0;
+            transfer::addProtocol(protocols, type);
         }
+    }
+
+    auto instanceId = instanceIdDb.next(eid);
+    auto requestMsg = transfer::encodeNegotiateReq(
+        instanceId, TRANSFER_PART_SIZE, protocols);
+    Response responseMsg{};
+    auto rc = co_await requester::sendRecvPldmMsg(*handler, eid, requestMsg,
+                                                  responseMsg);
+    if (rc)
+    {
+        std::cerr << "Failed to send sendRecvPldmMsg, EID=" << unsigned(eid)
+                  << ", instanceId=" << unsigned(instanceId)
+                  << ", type=" << unsigned(PLDM_BASE) << ", cmd= "
+                  << unsigned(transfer::negotiateTransferParameters)
+                  << ", rc=" << unsigned(rc) << std::endl;
         co_return rc;
     }
+    if (responseMsg.size() <= sizeof(pldm_msg_hdr))
+    {
+        co_return PLDM_ERROR;
+    }
 
-    uint8_t i = 0;
-    for (const auto& cmd : cmdTypes)
+    uint16_t partSize = 0;
+    transfer::ProtocolSupport agreed{};
+    rc = transfer::decodeNegotiateResp(
+        {responseMsg.data() + sizeof(pldm_msg_hdr),
+         responseMsg.size() - sizeof(pldm_msg_hdr)},
+        partSize, agreed);
+    if (rc != PLDM_SUCCESS || partSize < transfer::baselinePartSize)
     {
-        devInfo.supportedCmds[pldmTypeIdx].cmdTypes[i++].byte = cmd.byte;
+        std::cerr << "Failed to negotiate the transfer parameters of EID="
+                  << unsigned(eid) << ", rc=" << unsigned(rc)
+                  << ", partSize=" << partSize << std::endl;
+        co_return rc ? rc : PLDM_ERROR_INVALID_DATA;
     }
 
-    co_return cc;
+    partSize = std::min<uint16_t>(partSize, TRANSFER_PART_SIZE);
+    transfer::TransferSizes::get().set(eid, partSize);
+    info("EID {EID} transfers parts of {SIZE} bytes", "EID", unsigned(eid),
+         "SIZE", partSize);
+    co_return PLDM_SUCCESS;
 }
 
 requester::Coroutine TerminusHandler::getTID()
@@ -492,7 +728,7 @@ requester::Coroutine TerminusHandler::setEventReceiver()
     uint8_t transportProtocolType = PLDM_TRANSPORT_PROTOCOL_TYPE_MCTP;
     /* default BMC EID is 8 */
     uint8_t eventReceiverAddressInfo = 0x08;
-    uint16_t heartbeatTimer = 0x78;
+    uint16_t heartbeatTimer = TERMINUS_HEARTBEAT_INTERVAL;
 
     auto instanceId = instanceIdDb.next(eid);
     Request requestMsg(sizeof(pldm_msg_hdr) +
@@ -545,7 +781,7 @@ requester::Coroutine TerminusHandler::setEventReceiver()
         std::cerr << "Faile to decode_set_event_receiver_resp,"
                   << ", rc=" << unsigned(rc) << " cc=" << unsigned(cc)
                   << std::endl;
-        co_return rc;
+        co_return rc ? rc : cc;
     }
 
     co_return cc;
@@ -693,16 +929,24 @@ bool isTableEnd(const uint8_t* table, const uint8_t* p, size_t& tableSize)
     return (tableSize - offset) <= 7;
 }
 
-void TerminusHandler::parseFruRecordTable(const uint8_t* fruData,
-                                          size_t& fruLen)
+std::shared_ptr<pldm::dbus_api::FruReq>
+    TerminusHandler::getFruObject(bool& created)
 {
     std::string tidFRUObjPath;
 
+    created = false;
     if (devInfo.tid == PLDM_TID_RESERVED)
     {
         std::cerr << "Invalid TID " << std::endl;
-        return;
+        return nullptr;
+    }
+
+    auto it = frus.find(devInfo.tid);
+    if (it != frus.end())
+    {
+        return it->second;
     }
+
     if (eidToName.second != "")
     {
         tidFRUObjPath = fruPath + "/" + eidToName.second;
@@ -712,15 +956,59 @@ void TerminusHandler::parseFruRecordTable(const uint8_t* fruData,
         tidFRUObjPath = fruPath + "/" + std::to_string(devInfo.tid);
     }
 
-    auto fruPtr = std::make_shared<pldm::dbus_api::FruReq>(bus, tidFRUObjPath);
+    auto fruPtr = std::make_shared<pldm::dbus_api::FruReq>(
+        bus, tidFRUObjPath, pldm::dbus_api::FruIntf::action::defer_emit);
     frus.emplace(devInfo.tid, fruPtr);
+    created = true;
+    return fruPtr;
+}
+
+void TerminusHandler::parseFruRecordTable(const uint8_t* fruData,
+                                          size_t& fruLen)
+{
+    bool created = false;
+    auto fruPtr = getFruObject(created);
+    if (!fruPtr)
+    {
+        return;
+    }
+
+    parseFruRecords(fruData, fruLen, *fruPtr);
+    if (created)
+    {
+        fruPtr->emit_object_added();
+    }
+}
+
+size_t TerminusHandler::parseFruRecords(const uint8_t* fruData, size_t fruLen,
+                                        pldm::dbus_api::FruReq& fru)
+{
+    constexpr auto recordHeaderSize = sizeof(pldm_fru_record_data_format) -
+                                      sizeof(pldm_fru_record_tlv);
+    constexpr auto tlvHeaderSize = sizeof(pldm_fru_record_tlv) - 1;
 
     auto p = fruData;
     while (!isTableEnd(fruData, p, fruLen))
     {
         auto record = reinterpret_cast<const pldm_fru_record_data_format*>(p);
 
-        p += sizeof(pldm_fru_record_data_format) - sizeof(pldm_fru_record_tlv);
+        // Wait for the part with the end of the record
+        size_t recordSize = recordHeaderSize;
+        for (int i = 0; i < record->num_fru_fields; i++)
+        {
+            size_t tlvOffset = (p - fruData) + recordSize;
+            if (tlvOffset + tlvHeaderSize > fruLen)
+            {
+                return p - fruData;
+            }
+            recordSize += tlvHeaderSize + fruData[tlvOffset + 1];
+        }
+        if (static_cast<size_t>(p - fruData) + recordSize > fruLen)
+        {
+            return p - fruData;
+        }
+
+        p += recordHeaderSize;
 
         for (int i = 0; i < record->num_fru_fields; i++)
         {
@@ -730,73 +1018,69 @@ void TerminusHandler::parseFruRecordTable(const uint8_t* fruData,
                 switch (tlv->type)
                 {
                     case PLDM_FRU_FIELD_TYPE_CHASSIS:
-                        fruPtr->chassisType(
+                        fru.chassisType(
                             fruFieldValuestring(tlv->value, tlv->length));
                         break;
                     case PLDM_FRU_FIELD_TYPE_MODEL:
-                        fruPtr->model(
-                            fruFieldValuestring(tlv->value, tlv->length));
+                        fru.model(fruFieldValuestring(tlv->value, tlv->length));
                         break;
                     case PLDM_FRU_FIELD_TYPE_PN:
-                        fruPtr->pn(
-                            fruFieldValuestring(tlv->value, tlv->length));
+                        fru.pn(fruFieldValuestring(tlv->value, tlv->length));
                         break;
                     case PLDM_FRU_FIELD_TYPE_SN:
-                        fruPtr->sn(
-                            fruFieldValuestring(tlv->value, tlv->length));
+                        fru.sn(fruFieldValuestring(tlv->value, tlv->length));
                         break;
                     case PLDM_FRU_FIELD_TYPE_MANUFAC:
-                        fruPtr->manufacturer(
+                        fru.manufacturer(
                             fruFieldValuestring(tlv->value, tlv->length));
                         break;
                     case PLDM_FRU_FIELD_TYPE_MANUFAC_DATE:
-                        fruPtr->manufacturerDate(
+                        fru.manufacturerDate(
                             fruFieldParserTimestamp(tlv->value, tlv->length));
                         break;
                     case PLDM_FRU_FIELD_TYPE_VENDOR:
-                        fruPtr->vendor(
+                        fru.vendor(
                             fruFieldValuestring(tlv->value, tlv->length));
                         break;
                     case PLDM_FRU_FIELD_TYPE_NAME:
-                        fruPtr->name(
-                            fruFieldValuestring(tlv->value, tlv->length));
+                        fru.name(fruFieldValuestring(tlv->value, tlv->length));
                         break;
                     case PLDM_FRU_FIELD_TYPE_SKU:
-                        fruPtr->sku(
-                            fruFieldValuestring(tlv->value, tlv->length));
+                        fru.sku(fruFieldValuestring(tlv->value, tlv->length));
                         break;
                     case PLDM_FRU_FIELD_TYPE_VERSION:
-                        fruPtr->version(
+                        fru.version(
                             fruFieldValuestring(tlv->value, tlv->length));
                         break;
                     case PLDM_FRU_FIELD_TYPE_ASSET_TAG:
-                        fruPtr->assetTag(
+                        fru.assetTag(
                             fruFieldValuestring(tlv->value, tlv->length));
                         break;
                     case PLDM_FRU_FIELD_TYPE_DESC:
-                        fruPtr->description(
+                        fru.description(
                             fruFieldValuestring(tlv->value, tlv->length));
                         break;
                     case PLDM_FRU_FIELD_TYPE_EC_LVL:
-                        fruPtr->ecLevel(
+                        fru.ecLevel(
                             fruFieldValuestring(tlv->value, tlv->length));
                         break;
                     case PLDM_FRU_FIELD_TYPE_OTHER:
-                        fruPtr->other(
-                            fruFieldValuestring(tlv->value, tlv->length));
+                        fru.other(fruFieldValuestring(tlv->value, tlv->length));
                         break;
                     case PLDM_FRU_FIELD_TYPE_IANA:
-                        fruPtr->iana(
-                            fruFieldParserU32(tlv->value, tlv->length));
+                        fru.iana(fruFieldParserU32(tlv->value, tlv->length));
                         break;
                 }
             }
             p += sizeof(pldm_fru_record_tlv) - 1 + tlv->length;
         }
     }
+
+    return p - fruData;
 }
 
-requester::Coroutine TerminusHandler::getFRURecordTableMetadata(uint16_t* total)
+requester::Coroutine TerminusHandler::getFRURecordTableMetadata(uint16_t* total,
+                                                                uint32_t* checksum)
 {
     std::cerr << "Discovery Terminus: " << unsigned(eid)
               << " get FRU record Table Meta Data." << std::endl;
@@ -845,11 +1129,10 @@ requester::Coroutine TerminusHandler::getFRURecordTableMetadata(uint16_t* total)
     uint8_t fru_data_major_version, fru_data_minor_version;
     uint32_t fru_table_maximum_size, fru_table_length;
     uint16_t total_record_set_identifiers;
-    uint32_t checksum;
     rc = decode_get_fru_record_table_metadata_resp(
         response, respMsgLen, &cc, &fru_data_major_version,
         &fru_data_minor_version, &fru_table_maximum_size, &fru_table_length,
-        &total_record_set_identifiers, total, &checksum);
+        &total_record_set_identifiers, total, checksum);
 
     if (rc != PLDM_SUCCESS || cc != PLDM_SUCCESS)
     {
@@ -874,79 +1157,287 @@ requester::Coroutine
         co_return PLDM_ERROR;
     }
 
-    auto instanceId = instanceIdDb.next(eid);
-    Request requestMsg(sizeof(pldm_msg_hdr) +
-                       PLDM_GET_FRU_RECORD_TABLE_REQ_BYTES);
+    bool created = false;
+    auto fruPtr = getFruObject(created);
+    std::vector<uint8_t> fruTable;
+    size_t parsedLength = 0;
+    uint32_t dataTransferHandle = 0;
+    uint8_t transferOpFlag = PLDM_GET_FIRSTPART;
+    uint8_t transferFlag = 0;
+    uint8_t cc = 0;
+    int rc = PLDM_SUCCESS;
 
-    // send the getFruRecordTable command
-    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
-    auto rc = encode_get_fru_record_table_req(
-        instanceId, 0, PLDM_GET_FIRSTPART, request,
-        requestMsg.size() - sizeof(pldm_msg_hdr));
-    if (rc != PLDM_SUCCESS)
+    do
     {
-        instanceIdDb.free(eid, instanceId);
-        std::cerr << "Failed to encode_get_fru_record_table_req, rc = "
-                  << unsigned(rc) << std::endl;
-        co_return rc;
-    }
+        auto instanceId = instanceIdDb.next(eid);
+        Request requestMsg(sizeof(pldm_msg_hdr) +
+                           PLDM_GET_FRU_RECORD_TABLE_REQ_BYTES);
 
-    Response responseMsg{};
-    rc = co_await requester::sendRecvPldmMsg(*handler, eid, requestMsg,
-                                             responseMsg);
-    if (rc)
-    {
-        std::cerr << "Failed to send sendRecvPldmMsg, EID=" << unsigned(eid)
-                  << ", instanceId=" << unsigned(instanceId)
-                  << ", type=" << unsigned(PLDM_FRU)
-                  << ", cmd= " << unsigned(PLDM_GET_FRU_RECORD_TABLE)
-                  << ", rc=" << unsigned(rc) << std::endl;
-        ;
-        co_return rc;
-    }
+        // send the getFruRecordTable command
+        auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+        rc = encode_get_fru_record_table_req(
+            instanceId, dataTransferHandle, transferOpFlag, request,
+            requestMsg.size() - sizeof(pldm_msg_hdr));
+        if (rc != PLDM_SUCCESS)
+        {
+            instanceIdDb.free(eid, instanceId);
+            std::cerr << "Failed to encode_get_fru_record_table_req, rc = "
+                      << unsigned(rc) << std::endl;
+            break;
+        }
 
-    uint8_t cc = 0;
-    auto respMsgLen = responseMsg.size() - sizeof(struct pldm_msg_hdr);
-    auto response = reinterpret_cast<pldm_msg*>(responseMsg.data());
-    if (response == nullptr || !respMsgLen)
-    {
-        std::cerr << "No response received for sendRecvPldmMsg, EID="
-                  << unsigned(eid) << ", instanceId=" << unsigned(instanceId)
-                  << ", type=" << unsigned(PLDM_FRU)
-                  << ", cmd= " << unsigned(PLDM_GET_FRU_RECORD_TABLE)
-                  << ", rc=" << unsigned(rc) << std::endl;
-        ;
+        Response responseMsg{};
+        rc = co_await requester::sendRecvPldmMsg(*handler, eid, requestMsg,
+                                                 responseMsg);
+        if (rc)
+        {
+            std::cerr << "Failed to send sendRecvPldmMsg, EID="
+                      << unsigned(eid)
+                      << ", instanceId=" << unsigned(instanceId)
+                      << ", type=" << unsigned(PLDM_FRU)
+                      << ", cmd= " << unsigned(PLDM_GET_FRU_RECORD_TABLE)
+                      << ", rc=" << unsigned(rc) << std::endl;
+            break;
+        }
+
+        auto respMsgLen = responseMsg.size() - sizeof(struct pldm_msg_hdr);
+        auto response = reinterpret_cast<pldm_msg*>(responseMsg.data());
+        if (response == nullptr || !respMsgLen)
+        {
+            std::cerr << "No response received for sendRecvPldmMsg, EID="
+                      << unsigned(eid)
+                      << ", instanceId=" << unsigned(instanceId)
+                      << ", type=" << unsigned(PLDM_FRU)
+                      << ", cmd= " << unsigned(PLDM_GET_FRU_RECORD_TABLE)
+                      << ", rc=" << unsigned(rc) << std::endl;
+            rc = PLDM_ERROR;
+            break;
+        }
+
+        uint32_t nextDataTransferHandle = 0;
+        size_t fruRecordTableLength = 0;
+        std::vector<uint8_t> fruRecordTableData(respMsgLen);
+
+        auto responsePtr = reinterpret_cast<const struct pldm_msg*>(response);
+        rc = decode_get_fru_record_table_resp(
+            responsePtr, respMsgLen, &cc, &nextDataTransferHandle,
+            &transferFlag, fruRecordTableData.data(), &fruRecordTableLength);
+
+        if (rc != PLDM_SUCCESS || cc != PLDM_SUCCESS)
+        {
+            std::cerr
+                << "Failed to decode get fru record table resp, Message Error: "
+                << "rc=" << unsigned(rc) << ", cc=" << unsigned(cc)
+                << std::endl;
+            rc = rc ? rc : cc;
+            break;
+        }
+
+        fruTable.insert(fruTable.end(), fruRecordTableData.begin(),
+                        fruRecordTableData.begin() + fruRecordTableLength);
+
+        // The records completed by this part are parsed now, an incomplete
+        // one waits for the next part
+        if (fruPtr)
+        {
+            parsedLength += parseFruRecords(fruTable.data() + parsedLength,
+                                            fruTable.size() - parsedLength,
+                                            *fruPtr);
+        }
+
+        bool morePart = transferFlag == PLDM_START ||
+                        transferFlag == PLDM_MIDDLE;
+        if (morePart && (!nextDataTransferHandle ||
+                         (transferOpFlag == PLDM_GET_NEXTPART &&
+                          nextDataTransferHandle == dataTransferHandle)))
+        {
+            std::cerr << "Invalid next data transfer handle "
+                      << nextDataTransferHandle
+                      << " of the FRU record table, EID=" << unsigned(eid)
+                      << std::endl;
+            rc = PLDM_ERROR;
+            break;
+        }
+        dataTransferHandle = nextDataTransferHandle;
+        transferOpFlag = PLDM_GET_NEXTPART;
+    } while (transferFlag == PLDM_START || transferFlag == PLDM_MIDDLE);
+
+    if (rc)
+    {
+        // A new FRU object is not announced with part of the fields
+        if (created)
+        {
+            frus.erase(devInfo.tid);
+        }
         co_return rc;
     }
 
-    uint32_t nextDataTransferHandle = 0;
-    uint8_t transferFlag = 0;
-    size_t fruRecordTableLength = 0;
-    std::vector<uint8_t> fruRecordTableData(respMsgLen - sizeof(pldm_msg_hdr));
+    if (created)
+    {
+        fruPtr->emit_object_added();
+    }
+    discoveredCache.fruTable = std::move(fruTable);
+    discoveredCache.fruValid = true;
 
-    auto responsePtr = reinterpret_cast<const struct pldm_msg*>(response);
-    rc = decode_get_fru_record_table_resp(
-        responsePtr, respMsgLen - sizeof(pldm_msg_hdr), &cc,
-        &nextDataTransferHandle, &transferFlag, fruRecordTableData.data(),
-        &fruRecordTableLength);
+    co_return cc;
+}
 
-    if (rc != PLDM_SUCCESS || cc != PLDM_SUCCESS)
+requester::Coroutine
+    TerminusHandler::getPDRRepositoryInfo(std::vector<uint8_t>& signature)
+{
+    signature.clear();
+    auto instanceId = instanceIdDb.next(eid);
+    Request requestMsg(sizeof(pldm_msg_hdr));
+    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+    auto rc = encode_pldm_header_only(PLDM_REQUEST, instanceId, PLDM_PLATFORM,
+                                      PLDM_GET_PDR_REPOSITORY_INFO, request);
+    if (rc != PLDM_SUCCESS)
+    {
+        instanceIdDb.free(eid, instanceId);
+        std::cerr << "Failed to encode GetPDRRepositoryInfo request, rc = "
+                  << unsigned(rc) << std::endl;
+        co_return rc;
+    }
+
+    Response responseMsg{};
+    rc = co_await requester::sendRecvPldmMsg(*handler, eid, requestMsg,
+                                             responseMsg);
+    if (rc)
     {
-        std::cerr
-            << "Failed to decode get fru record table resp, Message Error: "
-            << "rc=" << unsigned(rc) << ", cc=" << unsigned(cc) << std::endl;
+        std::cerr << "Failed to send sendRecvPldmMsg, EID=" << unsigned(eid)
+                  << ", instanceId=" << unsigned(instanceId)
+                  << ", type=" << unsigned(PLDM_PLATFORM)
+                  << ", cmd= " << unsigned(PLDM_GET_PDR_REPOSITORY_INFO)
+                  << ", rc=" << unsigned(rc) << std::endl;
         co_return rc;
     }
 
-    parseFruRecordTable(fruRecordTableData.data(), fruRecordTableLength);
+    uint8_t cc = 0;
+    auto respMsgLen = responseMsg.size() - sizeof(struct pldm_msg_hdr);
+    auto response = reinterpret_cast<pldm_msg*>(responseMsg.data());
+    if (response == nullptr || !respMsgLen)
+    {
+        std::cerr << "No response received for sendRecvPldmMsg, EID="
+                  << unsigned(eid) << ", instanceId=" << unsigned(instanceId)
+                  << ", type=" << unsigned(PLDM_PLATFORM)
+                  << ", cmd= " << unsigned(PLDM_GET_PDR_REPOSITORY_INFO)
+                  << std::endl;
+        co_return PLDM_ERROR;
+    }
+
+    uint8_t repositoryState = 0;
+    std::array<uint8_t, PLDM_TIMESTAMP104_SIZE> updateTime{};
+    std::array<uint8_t, PLDM_TIMESTAMP104_SIZE> oemUpdateTime{};
+    uint32_t recordCount = 0;
+    uint32_t repositorySize = 0;
+    uint32_t largestRecordSize = 0;
+    uint8_t dataTransferHandleTimeout = 0;
+    rc = decode_get_pdr_repository_info_resp(
+        response, respMsgLen, &cc, &repositoryState, updateTime.data(),
+        oemUpdateTime.data(), &recordCount, &repositorySize,
+        &largestRecordSize, &dataTransferHandleTimeout);
+    if (rc != PLDM_SUCCESS || cc != PLDM_SUCCESS)
+    {
+        std::cerr << "Failed to decode GetPDRRepositoryInfo response, "
+                  << "rc=" << unsigned(rc) << ", cc=" << unsigned(cc)
+                  << std::endl;
+        co_return rc ? rc : cc;
+    }
+    pdrCapacity.recordCount = recordCount;
+    pdrCapacity.repositorySize = repositorySize;
+
+    /* The counts and sizes alone do not catch an updated PDR of the same
+     * size, the terminus must report when its repository changed */
+    auto isZero = [](const auto& time) {
+        return std::all_of(time.begin(), time.end(),
+                           [](uint8_t byte) { return byte == 0; });
+    };
+    if (repositoryState != PLDM_AVAILABLE ||
+        (isZero(updateTime) && isZero(oemUpdateTime)))
+    {
+        co_return PLDM_SUCCESS;
+    }
+
+    auto append = [&signature](const void* data, size_t size) {
+        auto bytes = static_cast<const uint8_t*>(data);
+        signature.insert(signature.end(), bytes, bytes + size);
+    };
+    append(updateTime.data(), updateTime.size());
+    append(oemUpdateTime.data(), oemUpdateTime.size());
+    append(&recordCount, sizeof(recordCount));
+    append(&repositorySize, sizeof(repositorySize));
+    append(&largestRecordSize, sizeof(largestRecordSize));
 
-    co_return cc;
+    co_return PLDM_SUCCESS;
+}
+
+void TerminusHandler::reservePDRCapacity()
+{
+    /* The reported sizes are not trusted beyond what a terminus repository
+     * sensibly holds */
+    constexpr size_t maxRecords = UINT16_MAX;
+    constexpr size_t maxBytes = 1024 * 1024;
+    auto records = std::min<size_t>(pdrCapacity.recordCount, maxRecords);
+    if (!records)
+    {
+        return;
+    }
+    /* Each list takes 8 bytes per record, the split of the records between
+     * the lists is only known once they are fetched */
+    compNumSensorPDRs.reserve(records);
+    effecterPDRs.reserve(records);
+    effecterAuxNamePDRs.reserve(records);
+    pdrSegment.reserve(records,
+                       std::min<size_t>(pdrCapacity.repositorySize, maxBytes));
+    if (!discoveredCache.pdrSignature.empty())
+    {
+        discoveredCache.pdrs.reserve(records);
+    }
+}
+
+void TerminusHandler::loadTerminusCache()
+{
+    loadedCache.reset();
+    discoveredCache = TerminusCache{};
+#ifdef TERMINUS_PDR_CACHE_DIR
+    TerminusCache cache;
+    if (cache.load(getTerminusCachePath(eid)))
+    {
+        loadedCache = std::move(cache);
+    }
+#endif
+}
+
+void TerminusHandler::saveTerminusCache()
+{
+#ifdef TERMINUS_PDR_CACHE_DIR
+    /* The PDRs of a terminus removed during the discovery are incomplete */
+    if (stopTerminusPolling)
+    {
+        return;
+    }
+    if (discoveredCache.pdrSignature.empty() && !discoveredCache.fruValid)
+    {
+        return;
+    }
+    if (loadedCache && loadedCache->pdrSignature == discoveredCache.pdrSignature &&
+        loadedCache->fruValid == discoveredCache.fruValid &&
+        loadedCache->fruChecksum == discoveredCache.fruChecksum)
+    {
+        /* Nothing changed since the cache was saved */
+        return;
+    }
+
+    discoveredCache.save(getTerminusCachePath(eid));
+#endif
 }
 
 requester::Coroutine TerminusHandler::getDevPDR(uint32_t nextRecordHandle)
 {
     std::cerr << "Discovery Terminus: " << unsigned(eid)
               << " get terminus PDRs." << std::endl;
+    constexpr size_t sensorBatchSize = 16;
+    auto batchStart = compNumSensorPDRs.size();
     do
     {
         /* Check whether the terminus is removed when getting PDRs */
@@ -955,19 +1446,164 @@ requester::Coroutine TerminusHandler::getDevPDR(uint32_t nextRecordHandle)
             co_return PLDM_SUCCESS;
         }
 
-        std::vector<uint8_t> requestMsg(sizeof(pldm_msg_hdr) +
-                                        PLDM_GET_PDR_REQ_BYTES);
-        auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
-        uint32_t recordHandle{};
-        if (nextRecordHandle)
+        auto recordHandle = nextRecordHandle;
+        auto rc = co_await getPDRRecord(recordHandle, &nextRecordHandle);
+        if (rc)
+        {
+            co_return rc;
+        }
+
+        /* The sensors are created and polled as their PDRs arrive, a batch
+         * at a time */
+        if (compNumSensorPDRs.size() >= batchStart + sensorBatchSize)
+        {
+            createDiscoveredSensors(false);
+            batchStart = compNumSensorPDRs.size();
+        }
+    } while (nextRecordHandle != 0);
+
+    co_return PLDM_SUCCESS;
+}
+
+requester::Coroutine TerminusHandler::getKnownPDRs(
+    const std::vector<std::pair<uint32_t, std::vector<uint8_t>>>& cachedPDRs)
+{
+    /* The headers of the cached PDRs hold the record handles of the
+     * terminus, in the order of its repository */
+    std::vector<uint32_t> handles;
+    handles.reserve(cachedPDRs.size());
+    for (const auto& [rh, pdr] : cachedPDRs)
+    {
+        if (pdr.size() < sizeof(pldm_pdr_hdr))
+        {
+            co_return PLDM_ERROR_INVALID_DATA;
+        }
+        handles.emplace_back(
+            reinterpret_cast<const pldm_pdr_hdr*>(pdr.data())->record_handle);
+    }
+
+    std::cerr << "Discovery Terminus: " << unsigned(eid) << " get "
+              << handles.size() << " known PDRs." << std::endl;
+    constexpr size_t pdrFetchWindow = 8;
+    std::vector<std::vector<uint8_t>> pdrs(handles.size());
+    std::vector<uint32_t> nextHandles(handles.size());
+    std::vector<size_t> indexes(handles.size());
+    std::iota(indexes.begin(), indexes.end(), 0);
+    auto rc = co_await requester::forEach(
+        std::move(indexes), pdrFetchWindow,
+        [this, &handles, &pdrs, &nextHandles](const size_t& index) {
+        return fetchPDRRecord(handles[index], pdrs[index],
+                              &nextHandles[index]);
+    },
+        getStopToken());
+    if (rc)
+    {
+        co_return rc;
+    }
+
+    /* Nothing is processed before the PDRs are known to be the whole
+     * repository: each one links to the next known handle, and the
+     * repository did not change while they were fetched */
+    size_t changed = 0;
+    for (size_t index = 0; index < handles.size(); index++)
+    {
+        auto expected = index + 1 < handles.size() ? handles[index + 1] : 0;
+        if (nextHandles[index] != expected ||
+            pdrs[index].size() < sizeof(pldm_pdr_hdr) ||
+            reinterpret_cast<const pldm_pdr_hdr*>(pdrs[index].data())
+                    ->record_handle != handles[index])
+        {
+            std::cerr << "Discovery Terminus: " << unsigned(eid)
+                      << " record handles changed at PDR " << handles[index]
+                      << std::endl;
+            co_return PLDM_ERROR;
+        }
+        if (reinterpret_cast<const pldm_pdr_hdr*>(pdrs[index].data())
+                ->record_change_num !=
+            reinterpret_cast<const pldm_pdr_hdr*>(
+                cachedPDRs[index].second.data())
+                ->record_change_num)
+        {
+            changed++;
+        }
+    }
+
+    std::vector<uint8_t> signature;
+    rc = co_await getPDRRepositoryInfo(signature);
+    if (rc || signature != discoveredCache.pdrSignature)
+    {
+        std::cerr << "Discovery Terminus: " << unsigned(eid)
+                  << " PDR repository changed during GetPDR" << std::endl;
+        co_return PLDM_ERROR;
+    }
+
+    std::cerr << "Discovery Terminus: " << unsigned(eid) << " " << changed
+              << " of " << handles.size() << " PDRs changed." << std::endl;
+    for (size_t index = 0; index < handles.size(); index++)
+    {
+        rc = processDevPDRs(pdrs[index], nextHandles[index]);
+        if (rc)
         {
-            recordHandle = nextRecordHandle;
+            co_return rc;
         }
+    }
+
+    co_return PLDM_SUCCESS;
+}
+
+requester::Coroutine TerminusHandler::getPDRRecord(uint32_t recordHandle,
+                                                   uint32_t* nextRecordHandle)
+{
+    std::vector<uint8_t> pdr;
+    auto rc = co_await fetchPDRRecord(recordHandle, pdr, nextRecordHandle);
+    if (rc)
+    {
+        co_return rc;
+    }
+
+    rc = processDevPDRs(pdr, *nextRecordHandle);
+    if (rc)
+    {
+        std::cerr << "Failed to send processDevPDRs, EID=" << unsigned(eid)
+                  << ", rc=" << unsigned(rc) << std::endl;
+        ;
+        co_return rc;
+    }
+
+    co_return PLDM_SUCCESS;
+}
+
+requester::Coroutine
+    TerminusHandler::fetchPDRRecord(uint32_t recordHandle,
+                                    std::vector<uint8_t>& pdr,
+                                    uint32_t* nextRecordHandle)
+{
+    /* Ask for parts as large as negotiated with the terminus, a PDR which
+     * does not fit in one part is reassembled from the GetNextPart
+     * responses. Without a negotiated size a terminus which fails the first
+     * part is asked for halves of it, the size it accepts is kept for its
+     * next transfers. */
+    auto& sizes = transfer::TransferSizes::get();
+    uint16_t requestCount = sizes.partSize(eid, TRANSFER_PART_SIZE);
+    bool probing = !sizes.contains(eid);
+
+    pdr.clear();
+    uint32_t dataTransferHandle = 0;
+    uint8_t transferOpFlag = PLDM_GET_FIRSTPART;
+    uint16_t recordChangeNumber = 0;
+    uint8_t transferFlag = PLDM_START_AND_END;
+    uint8_t transferCRC = 0;
+    while (true)
+    {
+        auto requestMsg = pldm::utils::RequestPool::acquire(
+            sizeof(pldm_msg_hdr) + PLDM_GET_PDR_REQ_BYTES);
+        auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
         auto instanceId = instanceIdDb.next(eid);
 
-        auto rc =
-            encode_get_pdr_req(instanceId, recordHandle, 0, PLDM_GET_FIRSTPART,
-                               UINT16_MAX, 0, request, PLDM_GET_PDR_REQ_BYTES);
+        auto rc = encode_get_pdr_req(instanceId, recordHandle,
+                                     dataTransferHandle, transferOpFlag,
+                                     requestCount, recordChangeNumber, request,
+                                     PLDM_GET_PDR_REQ_BYTES);
         if (rc != PLDM_SUCCESS)
         {
             instanceIdDb.free(eid, instanceId);
@@ -998,114 +1634,131 @@ requester::Coroutine TerminusHandler::getDevPDR(uint32_t nextRecordHandle)
                       << unsigned(eid) << ", instanceId="
                       << unsigned(instanceId) << ", type="
                       << unsigned(PLDM_PLATFORM) << ", cmd= "
-                      << unsigned(PLDM_GET_PDR) << ", rc="
-                      << unsigned(rc) << std::endl;
+                      << unsigned(PLDM_GET_PDR) << ", rc=" << unsigned(rc)
+                      << std::endl;
             ;
-            co_return rc;
+            co_return PLDM_ERROR;
         }
-        rc = co_await processDevPDRs(eid, response, respMsgLen,
-                                     &nextRecordHandle, recordHandle);
-        if (rc)
+
+        /* The record data is shorter than the response payload */
+        uint8_t completionCode{};
+        uint32_t nextDataTransferHandle{};
+        uint16_t respCount{};
+        /* The part is decoded in place at the end of the record */
+        auto offset = pdr.size();
+        pdr.resize(offset + respMsgLen);
+        rc = decode_get_pdr_resp(response, respMsgLen, &completionCode,
+                                 nextRecordHandle, &nextDataTransferHandle,
+                                 &transferFlag, &respCount,
+                                 pdr.data() + offset, respMsgLen,
+                                 &transferCRC);
+        pdr.resize(rc == PLDM_SUCCESS && completionCode == PLDM_SUCCESS
+                       ? offset + respCount
+                       : offset);
+        if (rc == PLDM_SUCCESS && completionCode != PLDM_SUCCESS &&
+            completionCode != PLDM_PLATFORM_INVALID_RECORD_HANDLE &&
+            probing && transferOpFlag == PLDM_GET_FIRSTPART &&
+            requestCount / 2 >= transfer::minProbePartSize)
         {
-            std::cerr << "Failed to send processDevPDRs, EID=" << unsigned(eid)
-                      << ", rc=" << unsigned(rc) << std::endl;
-            ;
-            co_return rc;
+            requestCount /= 2;
+            std::cerr << "Retry PDR " << recordHandle << " of terminus "
+                      << unsigned(eid) << " with parts of " << requestCount
+                      << " bytes, cc=" << unsigned(completionCode)
+                      << std::endl;
+            continue;
         }
-    } while (nextRecordHandle != 0);
+        if (rc != PLDM_SUCCESS || completionCode != PLDM_SUCCESS)
+        {
+            std::cerr << "Failed to decode_get_pdr_resp: "
+                      << "rc=" << unsigned(rc)
+                      << ", cc=" << unsigned(completionCode) << std::endl;
+            co_return rc ? rc : completionCode;
+        }
+        if (probing && requestCount < TRANSFER_PART_SIZE)
+        {
+            sizes.set(eid, requestCount);
+            probing = false;
+        }
+        if (transferOpFlag == PLDM_GET_FIRSTPART &&
+            pdr.size() >= sizeof(pldm_pdr_hdr))
+        {
+            recordChangeNumber =
+                reinterpret_cast<const pldm_pdr_hdr*>(pdr.data())
+                    ->record_change_num;
+        }
+        if ((transferFlag == PLDM_START || transferFlag == PLDM_MIDDLE) &&
+            (!respCount || pdr.size() > UINT16_MAX))
+        {
+            std::cerr << "Invalid multipart PDR " << recordHandle
+                      << " of terminus " << unsigned(eid) << std::endl;
+            co_return PLDM_ERROR;
+        }
+        dataTransferHandle = nextDataTransferHandle;
+        transferOpFlag = PLDM_GET_NEXTPART;
+        if (transferFlag != PLDM_START && transferFlag != PLDM_MIDDLE)
+        {
+            break;
+        }
+    }
 
-    if (!nextRecordHandle)
+    /* The CRC of the whole record comes with the last part */
+    if (transferFlag == PLDM_END && crc8(pdr.data(), pdr.size()) != transferCRC)
     {
-        co_return PLDM_SUCCESS;
+        std::cerr << "Mismatched CRC of multipart PDR " << recordHandle
+                  << " of terminus " << unsigned(eid) << std::endl;
+        co_return PLDM_ERROR;
     }
 
-    co_return PLDM_ERROR;
+    co_return PLDM_SUCCESS;
 }
 
-requester::Coroutine TerminusHandler::processDevPDRs(mctp_eid_t& /*eid*/,
-                                                     const pldm_msg* response,
-                                                     size_t& respMsgLen,
-                                                     uint32_t* nextRecordHandle,
-                                                     uint32_t recordHandle)
+int TerminusHandler::processDevPDRs(const std::vector<uint8_t>& pdr,
+                                    uint32_t nextRecordHandle)
 {
-    uint8_t tlEid = 0;
-    bool tlValid = true;
-    uint32_t rh = 0;
-    uint8_t tid = 0;
-
-    uint8_t completionCode{};
-    uint32_t nextDataTransferHandle{};
-    uint8_t transferFlag{};
-    uint16_t respCount{};
-    uint8_t transferCRC{};
-    if (response == nullptr || !respMsgLen)
+    if (pdr.size() < sizeof(pldm_pdr_hdr))
     {
-        std::cerr << "Failed to receive response for the GetPDR"
+        std::cerr << "Failed to receive the PDR header for the GetPDR"
                      " command \n";
-        co_return PLDM_ERROR;
+        return PLDM_ERROR;
     }
 
-    auto rc = decode_get_pdr_resp(
-        response, respMsgLen /*- sizeof(pldm_msg_hdr)*/, &completionCode,
-        nextRecordHandle, &nextDataTransferHandle, &transferFlag, &respCount,
-        nullptr, 0, &transferCRC);
-    std::vector<uint8_t> responsePDRMsg;
-    responsePDRMsg.resize(respMsgLen + sizeof(pldm_msg_hdr));
-    memcpy(responsePDRMsg.data(), response, respMsgLen + sizeof(pldm_msg_hdr));
-    if (rc != PLDM_SUCCESS)
+    // when nextRecordHandle is 0, we need the recordHandle of the last
+    // PDR and not 0-1.
+    uint32_t rh = 0;
+    if (nextRecordHandle)
     {
-        std::cerr << "Failed to decode_get_pdr_resp, rc = " << unsigned(rc)
-                  << std::endl;
-        co_return rc;
+        rh = nextRecordHandle - 1;
     }
 
-    std::vector<uint8_t> pdr(respCount, 0);
-    rc = decode_get_pdr_resp(response, respMsgLen, &completionCode,
-                             nextRecordHandle, &nextDataTransferHandle,
-                             &transferFlag, &respCount, pdr.data(), respCount,
-                             &transferCRC);
-
-    if (rc != PLDM_SUCCESS || completionCode != PLDM_SUCCESS)
+    auto pdrHdr = reinterpret_cast<const pldm_pdr_hdr*>(pdr.data());
+    if (!rh)
     {
-        std::cerr << "Failed to decode_get_pdr_resp: "
-                  << "rc=" << unsigned(rc)
-                  << ", cc=" << unsigned(completionCode) << std::endl;
-        co_return rc;
+        rh = pdrHdr->record_handle;
     }
 
-    /*
-     * Temporary: If PDR is multi-part PDR just get the first part then go to
-     * next PDRs
-     * Todo: Support multi-part in getting PDRs.
-     */
-    if ((*nextRecordHandle) && (transferFlag != PLDM_END) &&
-        (transferFlag != PLDM_START_AND_END))
+#ifdef TERMINUS_PDR_CACHE_DIR
+    if (!discoveredCache.pdrSignature.empty())
     {
-        *nextRecordHandle = recordHandle + 1;
+        discoveredCache.pdrs.emplace_back(rh, pdr);
     }
+#endif
+    processPDR(pdr, rh);
 
-    // when nextRecordHandle is 0, we need the recordHandle of the last
-    // PDR and not 0-1.
-    if (!(*nextRecordHandle))
-    {
-        rh = *nextRecordHandle;
-    }
-    else
-    {
-        rh = *nextRecordHandle - 1;
-    }
+    return PLDM_SUCCESS;
+}
 
-    auto pdrHdr = reinterpret_cast<pldm_pdr_hdr*>(pdr.data());
-    if (!rh)
-    {
-        rh = pdrHdr->record_handle;
-    }
+void TerminusHandler::processPDR(const std::vector<uint8_t>& pdr, uint32_t rh)
+{
+    uint8_t tlEid = 0;
+    bool tlValid = true;
+    uint8_t tid = 0;
 
+    auto pdrHdr = reinterpret_cast<const pldm_pdr_hdr*>(pdr.data());
     if (pdrHdr->type == PLDM_PDR_ENTITY_ASSOCIATION)
     {
         /* Temporary remove merge Entity Association feature */
         this->mergeEntityAssociations(pdr);
-        co_return PLDM_SUCCESS;
+        return;
     }
 
     if (pdrHdr->type == PLDM_TERMINUS_LOCATOR_PDR)
@@ -1131,29 +1784,272 @@ requester::Coroutine TerminusHandler::processDevPDRs(mctp_eid_t& /*eid*/,
             tlpdr->terminus_handle,
             std::make_tuple(tlpdr->tid, tlEid, tlpdr->validity));
     }
-    else if (pdrHdr->type == PLDM_COMPACT_NUMERIC_SENSOR_PDR)
+
+    // if the TLPDR is invalid update the repo accordingly
+    if (!tlValid)
     {
-        this->compNumSensorPDRs.emplace_back(pdr);
+        pldm_pdr_update_TL_pdr(repo, terminusHandle, tid, tlEid, tlValid);
     }
-    else if (pdrHdr->type == PLDM_NUMERIC_EFFECTER_PDR)
+    else
     {
-        this->effecterPDRs.emplace_back(pdr);
+        auto terminusRecordHandle = pdrHdr->record_handle;
+        if (!pldm_pdr_add_check(repo, pdr.data(), pdr.size(), true,
+                                terminusHandle, &rh))
+        {
+            bmcRecordHandles[terminusRecordHandle] = rh;
+
+            /* The lists refer to the copy in the repo, the PDR is not kept
+             * twice */
+            TerminusPDR terminusPDR{terminusRecordHandle, rh};
+            if (pdrHdr->type == PLDM_COMPACT_NUMERIC_SENSOR_PDR)
+            {
+                this->compNumSensorPDRs.emplace_back(terminusPDR);
+                pdrSegment.add(rh, pdr);
+            }
+            else if (pdrHdr->type == PLDM_NUMERIC_EFFECTER_PDR)
+            {
+                this->effecterPDRs.emplace_back(terminusPDR);
+                pdrSegment.add(rh, pdr);
+            }
+            else if (pdrHdr->type == PLDM_EFFECTER_AUXILIARY_NAMES_PDR)
+            {
+                this->effecterAuxNamePDRs.emplace_back(terminusPDR);
+                pdrSegment.add(rh, pdr);
+            }
+        }
     }
-    else if (pdrHdr->type == PLDM_EFFECTER_AUXILIARY_NAMES_PDR)
+    pldm::utils::notifyPdrRepoChanged();
+}
+
+TerminusHandler::PDRViews
+    TerminusHandler::findPDRs(std::span<const TerminusPDR> pdrs) const
+{
+    PDRViews views;
+    views.reserve(pdrs.size());
+    for (const auto& pdr : pdrs)
     {
-        this->effecterAuxNamePDRs.emplace_back(pdr);
+        views.emplace_back(pdrSegment.find(pdr.bmcRecordHandle));
     }
+    return views;
+}
 
-    // if the TLPDR is invalid update the repo accordingly
-    if (!tlValid)
+void TerminusHandler::removeBmcRecords(const std::set<uint32_t>& bmcHandles)
+{
+    /* libpldm only removes the records by terminus handle. Keep the other
+     * records of the terminus handle, remove all of them and add back the
+     * kept ones with the same record handles. */
+    std::vector<std::tuple<uint32_t, bool, std::vector<uint8_t>>> keptRecords;
+    uint8_t* data = nullptr;
+    uint32_t size = 0;
+    uint32_t nextRecordHandle = 0;
+    auto record = pldm_pdr_find_record(repo, 0, &data, &size,
+                                       &nextRecordHandle);
+    while (record)
     {
-        pldm_pdr_update_TL_pdr(repo, terminusHandle, tid, tlEid, tlValid);
+        auto recordHandle = pldm_pdr_get_record_handle(repo, record);
+        if (pldm_pdr_get_terminus_handle(repo, record) == terminusHandle &&
+            !bmcHandles.contains(recordHandle))
+        {
+            keptRecords.emplace_back(recordHandle,
+                                     pldm_pdr_record_is_remote(record),
+                                     std::vector<uint8_t>(data, data + size));
+        }
+        record = pldm_pdr_get_next_record(repo, record, &data, &size,
+                                          &nextRecordHandle);
     }
-    else
+
+    pldm_pdr_remove_pdrs_by_terminus_handle(repo, terminusHandle);
+    for (auto& [recordHandle, isRemote, recordData] : keptRecords)
+    {
+        pldm_pdr_add_check(repo, recordData.data(), recordData.size(),
+                           isRemote, terminusHandle, &recordHandle);
+    }
+    for (auto bmcHandle : bmcHandles)
+    {
+        pdrSegment.erase(bmcHandle);
+    }
+    pdrSegment.compact();
+    pldm::utils::notifyPdrRepoChanged();
+}
+
+void TerminusHandler::removeTerminusPDRs(const std::set<uint32_t>& handles,
+                                         TerminusPDRs& renamedEffecterPDRs)
+{
+    auto isRemoved = [&handles](const TerminusPDR& pdr) {
+        return handles.contains(pdr.recordHandle);
+    };
+
+    /* The PDR bytes are read from the segment before the records are
+     * removed from it */
+    std::vector<sensor_key> removedKeys;
+    auto sensorViews = findPDRs(compNumSensorPDRs);
+    for (size_t i = 0; i < sensorViews.size(); i++)
+    {
+        if (!isRemoved(compNumSensorPDRs[i]) || sensorViews[i].empty())
+        {
+            continue;
+        }
+        auto sensorPdr =
+            reinterpret_cast<const pldm_compact_numeric_sensor_pdr*>(
+                sensorViews[i].data());
+        removedKeys.emplace_back(eid, sensorPdr->sensor_id,
+                                 sensorPdr->hdr.type);
+    }
+    std::erase_if(compNumSensorPDRs, isRemoved);
+
+    /* The effecters are named after their auxiliary names */
+    std::set<auxNameKey> renamedKeys;
+    auto auxNameViews = findPDRs(effecterAuxNamePDRs);
+    for (size_t i = 0; i < auxNameViews.size(); i++)
+    {
+        if (!isRemoved(effecterAuxNamePDRs[i]) || auxNameViews[i].empty())
+        {
+            continue;
+        }
+        auto auxPdr = reinterpret_cast<const pldm_sensor_auxiliary_names_pdr*>(
+            auxNameViews[i].data());
+        auxNameKey key(auxPdr->terminus_handle, auxPdr->sensor_id);
+        _auxNameMaps.erase(key);
+        renamedKeys.insert(key);
+    }
+    std::erase_if(effecterAuxNamePDRs, isRemoved);
+
+    auto effecterViews = findPDRs(effecterPDRs);
+    for (size_t i = 0; i < effecterViews.size(); i++)
+    {
+        if (effecterViews[i].empty())
+        {
+            continue;
+        }
+        auto effecterPdr =
+            reinterpret_cast<const pldm_numeric_effecter_value_pdr*>(
+                effecterViews[i].data());
+        auto removed = isRemoved(effecterPDRs[i]);
+        auto renamed = renamedKeys.contains(
+            auxNameKey(effecterPdr->terminus_handle, effecterPdr->effecter_id));
+        if (removed || renamed)
+        {
+            removedKeys.emplace_back(eid, effecterPdr->effecter_id,
+                                     effecterPdr->hdr.type);
+        }
+        if (renamed && !removed)
+        {
+            renamedEffecterPDRs.emplace_back(effecterPDRs[i]);
+        }
+    }
+    std::erase_if(effecterPDRs, isRemoved);
+
+    for (const auto& key : removedKeys)
+    {
+        sensorPollRounds.erase(key);
+        eventDrivenSensors.erase(key);
+        std::erase(_effecterLists, key);
+        std::erase(unavailableSensorKeys, key);
+    }
+    removeUnavailableSensor(removedKeys);
+
+    std::set<uint32_t> bmcHandles;
+    for (auto handle : handles)
+    {
+        auto it = bmcRecordHandles.find(handle);
+        if (it != bmcRecordHandles.end())
+        {
+            bmcHandles.insert(it->second);
+            bmcRecordHandles.erase(it);
+        }
+    }
+    if (!bmcHandles.empty())
+    {
+        removeBmcRecords(bmcHandles);
+    }
+}
+
+void TerminusHandler::updatePDRs(std::vector<uint32_t> removedHandles,
+                                 std::vector<uint32_t> fetchedHandles)
+{
+    pendingRemovedHandles.insert(pendingRemovedHandles.end(),
+                                 removedHandles.begin(), removedHandles.end());
+    pendingFetchedHandles.insert(pendingFetchedHandles.end(),
+                                 fetchedHandles.begin(), fetchedHandles.end());
+    if (updatingPDRs || pdrUpdateEvent)
     {
-        pldm_pdr_add_check(repo, pdr.data(), respCount, true,
-                           terminusHandle, &rh);
+        return;
+    }
+
+    /* Defer the GetPDR requests, so the event message is responded first */
+    pdrUpdateEvent = std::make_unique<sdeventplus::source::Defer>(
+        event, [this](sdeventplus::source::EventBase&) {
+        pdrUpdateEvent.reset();
+        [[maybe_unused]] auto co = applyPDRChanges();
+    });
+}
+
+requester::Coroutine TerminusHandler::applyPDRChanges()
+{
+    if (!createdDbusObject || stopTerminusPolling)
+    {
+        /* The discovery is not done, it gets the current PDRs */
+        pendingRemovedHandles.clear();
+        pendingFetchedHandles.clear();
+        co_return PLDM_SUCCESS;
+    }
+
+    updatingPDRs = true;
+    /* The events received while fetching are applied in the next loop */
+    while (!pendingRemovedHandles.empty() || !pendingFetchedHandles.empty())
+    {
+        auto removedHandles = std::move(pendingRemovedHandles);
+        auto fetchedHandles = std::move(pendingFetchedHandles);
+        pendingRemovedHandles.clear();
+        pendingFetchedHandles.clear();
+
+        std::cerr << "Update terminus " << unsigned(eid) << " PDRs, "
+                  << removedHandles.size() << " removed, "
+                  << fetchedHandles.size() << " fetched." << std::endl;
+
+        TerminusPDRs renamedEffecterPDRs;
+        removeTerminusPDRs(
+            std::set<uint32_t>(removedHandles.begin(), removedHandles.end()),
+            renamedEffecterPDRs);
+
+        auto sensorCount = compNumSensorPDRs.size();
+        auto effecterCount = effecterPDRs.size();
+        auto auxNameCount = effecterAuxNamePDRs.size();
+        for (auto recordHandle : fetchedHandles)
+        {
+            if (stopTerminusPolling)
+            {
+                updatingPDRs = false;
+                co_return PLDM_SUCCESS;
+            }
+            uint32_t nextRecordHandle = 0;
+            auto rc = co_await getPDRRecord(recordHandle, &nextRecordHandle);
+            if (rc)
+            {
+                std::cerr << "Failed to get PDR " << recordHandle
+                          << " of terminus " << unsigned(eid)
+                          << ", rc=" << unsigned(rc) << std::endl;
+            }
+        }
+
+        parseAuxNamePDRs(getPDRViews(
+            std::span(effecterAuxNamePDRs).subspan(auxNameCount)));
+        createCompactNummericSensorIntf(
+            getPDRViews(std::span(compNumSensorPDRs).subspan(sensorCount)));
+        renamedEffecterPDRs.insert(renamedEffecterPDRs.end(),
+                                   effecterPDRs.begin() + effecterCount,
+                                   effecterPDRs.end());
+        createNummericEffecterDBusIntf(getPDRViews(renamedEffecterPDRs));
     }
+    updatingPDRs = false;
+    updateSensorKeys();
+    createSensorSnapshot();
+
+#ifdef TERMINUS_PDR_CACHE_DIR
+    /* The cached PDRs are stale until the next discovery saves them */
+    std::error_code ec;
+    std::filesystem::remove(getTerminusCachePath(eid), ec);
+#endif
 
     co_return PLDM_SUCCESS;
 }
@@ -1173,12 +2069,16 @@ void TerminusHandler::mergeEntityAssociations(const std::vector<uint8_t>& pdr)
         pldm_entity parent{};
         if (getParent(entities[i].entity_type, &parent))
         {
-            auto node = pldm_entity_association_tree_find(entityTree, &parent);
+            auto node = findEntityNode(parent);
             if (node)
             {
-                pldm_entity_association_tree_add(entityTree, &entities[i],
-                                                 0xFFFF, node,
-                                                 entityPdr->association_type);
+                auto added = pldm_entity_association_tree_add(
+                    entityTree, &entities[i], 0xFFFF, node,
+                    entityPdr->association_type);
+                if (added)
+                {
+                    entityNodes.emplace(entityNodeKey(entities[i]), added);
+                }
                 merged = true;
             }
         }
@@ -1188,7 +2088,15 @@ void TerminusHandler::mergeEntityAssociations(const std::vector<uint8_t>& pdr)
     {
         // Update our PDR repo with the merged entity association PDRs
         pldm_entity_node* node = nullptr;
-        pldm_find_entity_ref_in_tree(entityTree, entities[0], &node);
+        auto indexed = entityNodes.find(entityNodeKey(entities[0]));
+        if (indexed != entityNodes.end())
+        {
+            node = indexed->second;
+        }
+        else
+        {
+            pldm_find_entity_ref_in_tree(entityTree, entities[0], &node);
+        }
         if (node == nullptr)
         {
             std::cerr
@@ -1200,11 +2108,29 @@ void TerminusHandler::mergeEntityAssociations(const std::vector<uint8_t>& pdr)
                                                             &entities,
                                                             numEntities, true,
                                                             terminusHandle);
+            pldm::utils::notifyPdrRepoChanged();
         }
     }
     free(entities);
 }
 
+pldm_entity_node* TerminusHandler::findEntityNode(pldm_entity entity)
+{
+    auto key = entityNodeKey(entity);
+    auto found = entityNodes.find(key);
+    if (found != entityNodes.end())
+    {
+        return found->second;
+    }
+    /* The tree is searched once per entity and discovery */
+    auto node = pldm_entity_association_tree_find(entityTree, &entity);
+    if (node)
+    {
+        entityNodes.emplace(key, node);
+    }
+    return node;
+}
+
 bool TerminusHandler::getParent(const EntityType& type, pldm_entity* parent)
 {
     auto found = parents.find(type);
@@ -1218,10 +2144,13 @@ bool TerminusHandler::getParent(const EntityType& type, pldm_entity* parent)
     return false;
 }
 
-void TerminusHandler::createCompactNummericSensorIntf(const PDRList& sensorPDRs)
+void TerminusHandler::createCompactNummericSensorIntf(
+    const PDRViews& sensorPDRs)
 {
     /** @brief Store the added sensor D-Bus object path */
     std::vector<uint16_t> _addedSensorId;
+    /* The sensors are announced together once all of them are created */
+    std::vector<PldmSensor*> created;
     for (const auto& sensorPDR : sensorPDRs)
     {
         auto pdr = reinterpret_cast<const pldm_compact_numeric_sensor_pdr*>(
@@ -1242,6 +2171,7 @@ void TerminusHandler::createCompactNummericSensorIntf(const PDRList& sensorPDRs)
         sensorInfo.entityInstance = pdr->entity_instance;
         sensorInfo.containerId = pdr->container_id;
         sensorInfo.sensorNameLength = pdr->sensor_name_length;
+        std::string pdrName{};
         if (sensorInfo.sensorNameLength == 0)
         {
             sensorInfo.sensorName =
@@ -1258,6 +2188,7 @@ void TerminusHandler::createCompactNummericSensorIntf(const PDRList& sensorPDRs)
             }
             sensorInfo.sensorName = sTemp;
         }
+        pdrName = sensorInfo.sensorName;
 
         sensorInfo.baseUnit = pdr->base_unit;
         sensorInfo.unitModifier = pdr->unit_modifier;
@@ -1334,25 +2265,36 @@ void TerminusHandler::createCompactNummericSensorIntf(const PDRList& sensorPDRs)
             sensorInfo.unitModifier, sensorInfo.offset, sensorInfo.resolution,
             sensorInfo.warningHigh, sensorInfo.warningLow,
             sensorInfo.criticalHigh, sensorInfo.criticalLow);
+        sensorObject->setPublishFilter(getSensorPublishFilter(
+            sensorInfo.sensorName, pdrName, sensorInfo.entityType));
 
-        auto object = sensorObject->createSensor();
+        auto object = sensorObject->createSensor(false);
         if (object)
         {
-            auto value =
-                std::make_tuple(pdr->sensor_id, std::move((*object).second));
             auto key = std::make_tuple(eid, pdr->sensor_id, pdr->hdr.type);
 
+            auto pollRounds = getSensorPollRounds(
+                sensorInfo.sensorName, pdrName, sensorInfo.entityType);
+            if (pollRounds > 1)
+            {
+                sensorPollRounds[key] = pollRounds;
+            }
+            created.emplace_back(sensorObject.get());
             _sensorObjects[key] = std::move(sensorObject);
-            _state[std::move(key)] = std::move(value);
+            _state[std::move(key)] = pdr->sensor_id;
         }
     }
+    announceSensors(created);
 
     return;
 }
 
-void TerminusHandler::createNummericEffecterDBusIntf(const PDRList& sensorPDRs)
+void TerminusHandler::createNummericEffecterDBusIntf(
+    const PDRViews& sensorPDRs)
 {
     std::vector<auxNameKey> _addedEffecter;
+    /* The effecters are announced together once all of them are created */
+    std::vector<PldmSensor*> created;
 
     for (const auto& sensorPDR : sensorPDRs)
     {
@@ -1506,72 +2448,99 @@ void TerminusHandler::createNummericEffecterDBusIntf(const PDRList& sensorPDRs)
 
         sensorObj->initMinMaxValue(sensorInfo.minSetTable,
                                    sensorInfo.maxSetTable);
-        auto object = sensorObj->createSensor();
+        auto object = sensorObj->createSensor(false);
         if (object)
         {
-            auto value =
-                std::make_tuple(pdr->effecter_id, std::move((*object).second));
             auto key = std::make_tuple(eid, pdr->effecter_id, pdr->hdr.type);
 
+            created.emplace_back(sensorObj.get());
             _sensorObjects[key] = std::move(sensorObj);
             _effecterLists.emplace_back(key);
-            _state[std::move(key)] = std::move(value);
+            _state[std::move(key)] = pdr->effecter_id;
         }
     }
+    announceSensors(created);
 
     return;
 }
 
-void TerminusHandler::parseAuxNamePDRs(const PDRList& sensorPDRs)
+void TerminusHandler::announceSensors(const std::vector<PldmSensor*>& sensors)
 {
-    constexpr uint8_t nullTerminator = 0;
-    for (const auto& sensorPDR : sensorPDRs)
+    for (auto sensor : sensors)
     {
-        auto pdr =
-            (struct pldm_sensor_auxiliary_names_pdr*)sensorPDR.data();
+        sensor->announce();
+    }
+    if (!sensors.empty())
+    {
+        bus.flush();
+    }
+}
+
+void TerminusHandler::retractSensors()
+{
+    for (auto& [key, sensor] : _sensorObjects)
+    {
+        sensor->retract();
+    }
+    if (!_sensorObjects.empty())
+    {
+        bus.flush();
+    }
+}
 
-        if (!pdr)
+void TerminusHandler::parseAuxNamePDRs(const PDRViews& sensorPDRs)
+{
+    for (const auto& sensorPDR : sensorPDRs)
+    {
+        if (sensorPDR.size() < offsetof(pldm_sensor_auxiliary_names_pdr, names))
         {
             std::cerr << "Failed to get Aux Name PDR" << std::endl;
             return;
         }
+        auto pdr =
+            (struct pldm_sensor_auxiliary_names_pdr*)sensorPDR.data();
         auxNameKey key((uint16_t)pdr->terminus_handle,
                        (uint16_t)pdr->sensor_id);
         auxNameSensorMapping sensorNameMapping;
 
-        const uint8_t* ptr = pdr->names;
+        /* The names are transcoded straight into the pool of the terminus,
+         * the mapping only keeps views of them */
+        auto names = std::span<const uint8_t>(sensorPDR).subspan(
+            offsetof(pldm_sensor_auxiliary_names_pdr, names));
         for ([[maybe_unused]] auto i :
              std::views::iota(0, (int)pdr->sensor_count))
         {
-            const uint8_t nameStringCount = static_cast<uint8_t>(*ptr);
+            if (names.empty())
+            {
+                break;
+            }
+            const uint8_t nameStringCount = names[0];
+            names = names.subspan(sizeof(uint8_t));
             auxNameList nameLists{};
-            ptr += sizeof(uint8_t);
             for ([[maybe_unused]] auto j :
                  std::views::iota(0, (int)nameStringCount))
             {
-                std::string nameLanguageTag(reinterpret_cast<const char*>(ptr),
-                                            0, PLDM_STR_UTF_8_MAX_LEN);
-                ptr += nameLanguageTag.size() + sizeof(nullTerminator);
-                std::u16string u16NameString(
-                    reinterpret_cast<const char16_t*>(ptr), 0,
-                    PLDM_STR_UTF_16_MAX_LEN);
-                ptr += (u16NameString.size() + sizeof(nullTerminator)) *
-                       sizeof(uint16_t);
-                std::transform(u16NameString.cbegin(), u16NameString.cend(),
-                               u16NameString.begin(),
-                               [](uint16_t utf16) { return be16toh(utf16); });
-                std::string nameString =
-                    std::wstring_convert<std::codecvt_utf8_utf16<char16_t>,
-                                         char16_t>{}
-                        .to_bytes(u16NameString);
-                nameLists.emplace_back(
-                    std::make_tuple(nameLanguageTag, nameString));
+                auto tagEnd = std::find(names.begin(), names.end(), 0);
+                if (tagEnd == names.end())
+                {
+                    names = {};
+                    break;
+                }
+                auto nameLanguageTag = auxNamePool.intern(std::string_view(
+                    reinterpret_cast<const char*>(names.data()),
+                    tagEnd - names.begin()));
+                names = names.subspan(nameLanguageTag.size() + 1);
+
+                size_t consumed = 0;
+                auto nameString = auxNamePool.internUtf16Be(names, consumed);
+                names = names.subspan(consumed);
+                nameLists.emplace_back(nameLanguageTag, nameString);
             }
             if (!nameLists.size())
             {
                 continue;
             }
-            sensorNameMapping.emplace_back(nameLists);
+            sensorNameMapping.emplace_back(std::move(nameLists));
         }
 
         if (!sensorNameMapping.size())
@@ -1586,7 +2555,7 @@ void TerminusHandler::parseAuxNamePDRs(const PDRList& sensorPDRs)
                       << " existed in mapping table." << std::endl;
             continue;
         }
-        _auxNameMaps[key] = sensorNameMapping;
+        _auxNameMaps[key] = std::move(sensorNameMapping);
     }
     return;
 }
@@ -1597,16 +2566,20 @@ void TerminusHandler::startSensorsPolling()
 {
     readCount = 0;
     continuePollSensor = true;
+    /* The round interrupted by stopSensorsPolling is not resumed */
+    pollingSensors = false;
+    nextSensorIdx = 0;
+    sensorBreaker.success();
+    _probeTimer.setEnabled(false);
+    refreshLiveness();
     std::function<void()> pollCallback(
         std::bind(&TerminusHandler::pollSensors, this));
-    std::function<void()> readCallback(
-        std::bind(&TerminusHandler::readSensor, this));
 
     try
     {
-        _timer.restart(std::chrono::milliseconds(POLL_SENSOR_TIMER_INTERVAL));
-        _timer2.restart(
-            std::chrono::milliseconds(SLEEP_BETWEEN_GET_SENSOR_READING));
+        _timer.restart(pollingProfile.sensorInterval);
+        _timer.setRemaining(
+            pollPhase.phase().delay(pollingProfile.sensorInterval));
     }
     catch (const std::exception& e)
     {
@@ -1617,6 +2590,44 @@ void TerminusHandler::startSensorsPolling()
     return;
 }
 
+void TerminusHandler::applyPollingProfile(
+    const PollingProfileSettings& settings)
+{
+    if (settings == pollingProfile)
+    {
+        return;
+    }
+    auto intervalChanged = settings.sensorInterval !=
+                           pollingProfile.sensorInterval;
+    pollingProfile = settings;
+
+    if (intervalChanged && continuePollSensor && _timer.isEnabled())
+    {
+        _timer.restart(pollingProfile.sensorInterval);
+        _timer.setRemaining(
+            pollPhase.phase().delay(pollingProfile.sensorInterval));
+    }
+    if (eventDataHndl)
+    {
+        eventDataHndl->setPollCadence(pollingProfile.rasInterval,
+                                      pollingProfile.rasMaxInterval);
+    }
+}
+
+void TerminusHandler::setPollPhase(PollPhases::Lease&& lease)
+{
+    pollPhase = std::move(lease);
+    if (continuePollSensor && _timer.isEnabled())
+    {
+        _timer.setRemaining(
+            pollPhase.phase().delay(pollingProfile.sensorInterval));
+    }
+    if (eventDataHndl)
+    {
+        eventDataHndl->setPollPhase(pollPhase.phase());
+    }
+}
+
 /** @brief Stop timer to get sensor info
  */
 void TerminusHandler::stopSensorsPolling()
@@ -1624,14 +2635,16 @@ void TerminusHandler::stopSensorsPolling()
     continuePollSensor = false;
     _timer.setEnabled(false);
     _timer2.setEnabled(false);
-    _timer3.setEnabled(false);
+    _probeTimer.setEnabled(false);
+    _livenessTimer.setEnabled(false);
 
     // Set sensors values to Nan and Functional property to false for FANs speeds to be driven max
-    for (auto sensorIt = _sensorObjects.begin(); sensorIt != _sensorObjects.end(); ++sensorIt)
+    for (size_t row = 0; row < sensorTable.size(); row++)
     {
-        auto sensorObj = sensorIt->second.get();
+        auto sensorObj = sensorTable.objects[row];
         sensorObj->setFunctionalStatus(false);
         sensorObj->updateValue(std::numeric_limits<double>::quiet_NaN());
+        updateSensorSnapshot(row);
     }
 }
 
@@ -1640,18 +2653,20 @@ void TerminusHandler::removeUnavailableSensor(
 {
     for (const auto& key : vKeys)
     {
-        if (_state.find(key) != _state.end())
+        _state.erase(key);
+        auto rowIt = sensorRows.find(key);
+        if (rowIt != sensorRows.end())
         {
-            _state.erase(key);
+            removeSensorRow(rowIt->second);
         }
-        if (_sensorObjects.find(key) != _sensorObjects.end())
+        auto it = _sensorObjects.find(key);
+        if (it != _sensorObjects.end())
         {
-            std::unique_ptr<PldmSensor>& sensorObj = _sensorObjects[key];
-            bus.emit_object_removed(sensorObj->getSensorPath().c_str());
-            _sensorObjects.erase(key);
+            bus.emit_object_removed(it->second->getSensorPath().c_str());
+            _sensorObjects.erase(it);
         }
     }
-    updateSensorKeys();
+    createSensorSnapshot();
 
     return;
 }
@@ -1661,20 +2676,80 @@ void TerminusHandler::removeEffecterFromPollingList(
 {
     for (const auto& key : vKeys)
     {
-        if (_state.find(key) != _state.end())
+        _state.erase(key);
+        auto it = sensorRows.find(key);
+        if (it != sensorRows.end())
         {
-            _state.erase(key);
+            pollRows.erase(it->second);
         }
     }
-    updateSensorKeys();
 
     return;
 }
 
+void TerminusHandler::removeSensorRow(size_t row)
+{
+    if (sensorMemoryGauge)
+    {
+        sensorMemoryGauge->set(
+            sensorMemoryGauge->value() -
+            static_cast<int64_t>(sensorTable.objects[row]->memoryUsage() +
+                                 SensorTable::rowBytes));
+    }
+
+    auto last = sensorTable.size() - 1;
+    pollRows.erase(row);
+    sensorRows.erase(sensorTable.keys[row]);
+    if (row != last)
+    {
+        auto lastPolled = pollRows.erase(last);
+        sensorTable.keys[row] = sensorTable.keys[last];
+        sensorTable.sensorIds[row] = sensorTable.sensorIds[last];
+        sensorTable.pdrTypes[row] = sensorTable.pdrTypes[last];
+        sensorTable.pollRounds[row] = sensorTable.pollRounds[last];
+        sensorTable.snapshotSlots[row] = sensorTable.snapshotSlots[last];
+        sensorTable.objects[row] = sensorTable.objects[last];
+        sensorRows[sensorTable.keys[row]] = row;
+        if (lastPolled)
+        {
+            pollRows.insert(row);
+        }
+    }
+    sensorTable.keys.pop_back();
+    sensorTable.sensorIds.pop_back();
+    sensorTable.pdrTypes.pop_back();
+    sensorTable.pollRounds.pop_back();
+    sensorTable.snapshotSlots.pop_back();
+    sensorTable.objects.pop_back();
+
+    /* The rows of the last round are only used while it runs */
+    if (!pollingSensors)
+    {
+        roundSensorRows.clear();
+        return;
+    }
+    size_t index = 0;
+    for (size_t i = 0; i < roundSensorRows.size(); i++)
+    {
+        if (roundSensorRows[i] == row)
+        {
+            if (i < nextSensorIdx)
+            {
+                nextSensorIdx--;
+            }
+            continue;
+        }
+        roundSensorRows[index++] =
+            roundSensorRows[i] == last ? row : roundSensorRows[i];
+    }
+    roundSensorRows.resize(index);
+}
+
 /** @brief Start reading the sensors info process
  */
 void TerminusHandler::pollSensors()
 {
+    pldm::metrics::LoopMonitor::setSource("timer:sensor-poll");
     if (!isTerminusOn())
     {
         return;
@@ -1685,16 +2760,24 @@ void TerminusHandler::pollSensors()
         return;
     }
 
-    if (!createdDbusObject)
+    /* The sensors created so far are polled during the discovery */
+    if (!createdDbusObject && pollRows.empty())
+    {
+        return;
+    }
+
+    /* The terminus is probed until it responds again */
+    if (sensorBreaker.isOpen())
     {
         return;
     }
 
     if (pollingSensors)
     {
-        std::cerr << "[" << readCount << "]"
-                  << " Last sensor polling is not DONE. Retry new round later."
-                  << std::endl;
+        PLDM_LOG_RATE_LIMITED(warning,
+                              "Last sensor polling round {ROUND} of EID {EID} "
+                              "is not done, retry later",
+                              "ROUND", readCount, "EID", unsigned(eid));
         return;
     }
 
@@ -1704,18 +2787,46 @@ void TerminusHandler::pollSensors()
         unavailableSensorKeys.clear();
     }
 
-    this->sensorKey = sensorKeys.begin();
+    nextSensorIdx = 0;
     pollingSensors = true;
     readCount++;
 
+    /* The round reads the sensors in the table order, the consecutive
+     * compact numeric sensors share a batch */
+    roundSensorRows.clear();
+    for (size_t row = 0; row < sensorTable.size(); row++)
+    {
+        if (pollRows.contains(row) && isSensorPollDue(row))
+        {
+            roundSensorRows.emplace_back(row);
+        }
+    }
+
+    pollRoundStart = std::chrono::steady_clock::now();
+    if (debugPollSensor)
+    {
+        startTime = std::chrono::system_clock::now();
+        info("{NAME}: start sensor polling round {ROUND} at {TIME}", "NAME",
+             eidToName.second, "ROUND", readCount, "TIME",
+             getCurrentSystemTime());
+        /* Stop print polling debug after 50 rounds */
+        if (readCount > 50)
+        {
+            debugPollSensor = false;
+        }
+    }
+
+    readSensor();
+
     return;
 }
 
-/** @brief Start reading the sensors info process
+/** @brief Send the GetSensorReading requests until the polling window is full
  */
 void TerminusHandler::readSensor()
 {
-    if (!createdDbusObject)
+    pldm::metrics::LoopMonitor::setSource("timer:sensor-read");
+    if (!createdDbusObject && roundSensorRows.empty())
     {
         return;
     }
@@ -1730,85 +2841,214 @@ void TerminusHandler::readSensor()
         return;
     }
 
-    if (sendingPldmCommand)
+    while (sensorReadingsInFlight < sensorPollWindow &&
+           nextSensorIdx < roundSensorRows.size())
     {
-        return;
-    }
+        auto row = roundSensorRows[nextSensorIdx];
+        /* The sensor was disabled after the round started */
+        if (!pollRows.contains(row))
+        {
+            nextSensorIdx++;
+            continue;
+        }
+        if (batchSensorReads &&
+            sensorTable.pdrTypes[row] == PLDM_COMPACT_NUMERIC_SENSOR_PDR)
+        {
+            /* The consecutive compact numeric sensors of the round share one
+             * request, the effecters are read one by one */
+            std::vector<std::pair<size_t, sensor_key>> batch;
+            while (nextSensorIdx < roundSensorRows.size() &&
+                   batch.size() < SENSOR_BATCH_READ_SIZE)
+            {
+                row = roundSensorRows[nextSensorIdx];
+                if (!pollRows.contains(row))
+                {
+                    nextSensorIdx++;
+                    continue;
+                }
+                if (sensorTable.pdrTypes[row] !=
+                    PLDM_COMPACT_NUMERIC_SENSOR_PDR)
+                {
+                    break;
+                }
+                batch.emplace_back(row, sensorTable.keys[row]);
+                nextSensorIdx++;
+            }
+            if (getSensorReadings(std::move(batch)))
+            {
+                sensorReadingsInFlight++;
+            }
+            continue;
+        }
 
-    if (this->sensorKey == sensorKeys.begin() && debugPollSensor)
-    {
-        startTime = std::chrono::system_clock::now();
-        std::cerr << eidToName.second << ":[" << readCount << "]"
-                  << "Start new pollSensor at " << getCurrentSystemTime()
-                  << std::endl;
-        /* Stop print polling debug after 50 rounds */
-        if (readCount > 50)
+        nextSensorIdx++;
+        if (getSensorReading(row))
         {
-            debugPollSensor = false;
+            sensorReadingsInFlight++;
         }
     }
 
-    if (this->sensorKey != sensorKeys.end())
-    {
-        getSensorReading(get<1>(*(this->sensorKey)),
-                         get<2>(*(this->sensorKey)));
-    }
-    else
+    if (!sensorReadingsInFlight && nextSensorIdx >= roundSensorRows.size())
     {
         pollingSensors = false;
 
+        /* Flush the value changes of the round, one signal per interface */
+        for (auto row : roundSensorRows)
+        {
+            sensorTable.objects[row]->emitPendingChanges();
+        }
+        SensorStream::get().flush();
+
+        if (!pollRoundHistogram)
+        {
+            pollRoundHistogram = &pldm::metrics::Registry::get().histogram(
+                "pldm_sensor_poll_round_seconds",
+                "Time to read all the sensors due in one polling round",
+                {{"eid", std::to_string(eid)}});
+        }
+        pollRoundHistogram->observe(std::chrono::steady_clock::now() -
+                                    pollRoundStart);
+
         if (debugPollSensor)
         {
             std::chrono::duration<double> elapsed_seconds =
                 std::chrono::system_clock::now() - startTime;
-            std::cerr << eidToName.second << ":[" << readCount << "]"
-                      << " Finish one pollsensor round after "
-                      << elapsed_seconds.count() << "s at "
-                      << getCurrentSystemTime()
-                      << std::endl;
+            info("{NAME}: finish sensor polling round {ROUND} after "
+                 "{ELAPSED}s at {TIME}, window {WINDOW}",
+                 "NAME", eidToName.second, "ROUND", readCount, "ELAPSED",
+                 elapsed_seconds.count(), "TIME", getCurrentSystemTime(),
+                 "WINDOW", unsigned(sensorPollWindow));
         }
     }
 
     return;
 }
 
-bool verifySensorFunctionalStatus(const uint8_t& pdrType,
-                                  const uint8_t& operationState)
+void TerminusHandler::updateSensorPollWindow(
+    bool responded, std::chrono::steady_clock::duration responseTime)
 {
-    if (pdrType == PLDM_COMPACT_NUMERIC_SENSOR_PDR)
+    using namespace std::chrono;
+    if (!responded)
     {
-        /* enabled */
-        if (operationState != PLDM_SENSOR_ENABLED)
-        {
-            return false;
-        }
+        /* Multiplicative decrease, then back off before the next request */
+        sensorPollWindow = std::max<uint8_t>(1, sensorPollWindow / 2);
+        windowIncreaseCredit = 0;
+        sensorPollBackOff = true;
+        return;
     }
-    else if (pdrType == PLDM_NUMERIC_EFFECTER_PDR)
+
+    auto rtt = duration_cast<microseconds>(responseTime);
+    if (avgResponseTime.count() == 0)
     {
-        /* enabled-updatePending, enabled-noUpdatePending */
-        if ((operationState != EFFECTER_OPER_STATE_ENABLED_UPDATEPENDING) &&
-            (operationState != EFFECTER_OPER_STATE_ENABLED_NOUPDATEPENDING))
-        {
-            return false;
-        }
+        avgResponseTime = rtt;
     }
-    return true;
-}
+    /* The queueing delay on the link grows the response time, keep the window
+     * when the terminus responds slower than twice of the average.
+     */
+    bool congested = rtt > 2 * avgResponseTime;
+    /* EWMA with weight 1/8 as TCP SRTT */
+    avgResponseTime += (rtt - avgResponseTime) / 8;
 
-bool verifySensorAvailableStatus(const uint8_t& pdrType,
-                                  const uint8_t& operationState)
-{
-    if (pdrType == PLDM_COMPACT_NUMERIC_SENSOR_PDR)
+    if (congested)
     {
-        /* unavailable */
-        if (operationState == PLDM_SENSOR_UNAVAILABLE)
-        {
-            return false;
-        }
+        windowIncreaseCredit = 0;
+        return;
     }
-    else if (pdrType == PLDM_NUMERIC_EFFECTER_PDR)
+
+    /* Additive increase, one slot per window of fast responses */
+    if (++windowIncreaseCredit >= sensorPollWindow &&
+        sensorPollWindow < MAX_SENSOR_READINGS_IN_FLIGHT)
     {
-        /* unavailable */
+        sensorPollWindow++;
+        windowIncreaseCredit = 0;
+    }
+}
+
+void TerminusHandler::completeSensorReading(bool responded,
+                                            std::chrono::steady_clock::time_point
+                                                sendTime)
+{
+    if (sensorReadingsInFlight)
+    {
+        sensorReadingsInFlight--;
+    }
+    updateSensorPollWindow(responded,
+                           std::chrono::steady_clock::now() - sendTime);
+    if (responded)
+    {
+        refreshLiveness();
+    }
+
+    if (sensorPollBackOff && !sensorReadingsInFlight)
+    {
+        sensorPollBackOff = false;
+        _timer2.restartOnce(pollingProfile.sleepBetweenReads);
+        return;
+    }
+
+    if (!sensorPollBackOff)
+    {
+        readSensor();
+    }
+}
+
+/** @brief Convert the reading of one data size to the sensor value type */
+template <typename T>
+static SensorValueType decodeReading(const union_range_field_format& reading)
+{
+    T value;
+    std::memcpy(&value, &reading, sizeof(value));
+    return static_cast<SensorValueType>(value);
+}
+
+static_assert(SENSOR_BATCH_READ_SIZE <= PLDM_OEM_GET_SENSOR_READINGS_MAX);
+
+static_assert(PLDM_SENSOR_DATA_SIZE_UINT8 == 0 &&
+              PLDM_SENSOR_DATA_SIZE_SINT32 == 5);
+/** @brief Reading converters indexed by the PLDM sensor data size */
+static constexpr std::array<
+    SensorValueType (*)(const union_range_field_format&), 6>
+    readingDecoders{decodeReading<uint8_t>,  decodeReading<int8_t>,
+                    decodeReading<uint16_t>, decodeReading<int16_t>,
+                    decodeReading<uint32_t>, decodeReading<int32_t>};
+
+bool verifySensorFunctionalStatus(const uint8_t& pdrType,
+                                  const uint8_t& operationState)
+{
+    if (pdrType == PLDM_COMPACT_NUMERIC_SENSOR_PDR)
+    {
+        /* enabled */
+        if (operationState != PLDM_SENSOR_ENABLED)
+        {
+            return false;
+        }
+    }
+    else if (pdrType == PLDM_NUMERIC_EFFECTER_PDR)
+    {
+        /* enabled-updatePending, enabled-noUpdatePending */
+        if ((operationState != EFFECTER_OPER_STATE_ENABLED_UPDATEPENDING) &&
+            (operationState != EFFECTER_OPER_STATE_ENABLED_NOUPDATEPENDING))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool verifySensorAvailableStatus(const uint8_t& pdrType,
+                                  const uint8_t& operationState)
+{
+    if (pdrType == PLDM_COMPACT_NUMERIC_SENSOR_PDR)
+    {
+        /* unavailable */
+        if (operationState == PLDM_SENSOR_UNAVAILABLE)
+        {
+            return false;
+        }
+    }
+    else if (pdrType == PLDM_NUMERIC_EFFECTER_PDR)
+    {
+        /* unavailable */
         if (operationState == EFFECTER_OPER_STATE_UNAVAILABLE)
         {
             return false;
@@ -1820,30 +3060,34 @@ bool verifySensorAvailableStatus(const uint8_t& pdrType,
 /** @brief Callback function to process the response data after send the
  * getSensorReading request thru PLDM
  */
-void TerminusHandler::processSensorReading(mctp_eid_t, const pldm_msg* response,
-                                           size_t respMsgLen)
+void TerminusHandler::processSensorReading(
+    size_t row, sensor_key key, std::chrono::steady_clock::time_point sendTime,
+    mctp_eid_t, const pldm_msg* response, size_t respMsgLen)
 {
+    /* The table is rebuilt when the sensors change during the request */
+    row = getSensorRow(row, key);
+    auto sensorObj = row != SensorTable::npos ? sensorTable.objects[row]
+                                              : nullptr;
+
     if (response == nullptr || !respMsgLen)
     {
-        auto sid = std::get<1>(*(this->sensorKey));
-        std::cerr << "Failed to receive response for the GetSensorReading"
-                  << " command of eid:sensor " << unsigned(eid) << ":"
-                  << sid << std::endl;
-
-        std::unique_ptr<PldmSensor>& sensorObj =
-        _sensorObjects[*(this->sensorKey)];
-        if (sensorObj)
+        PLDM_LOG_RATE_LIMITED(error,
+                              "No GetSensorReading response from EID {EID} "
+                              "sensor {SENSOR}",
+                              "EID", unsigned(eid), "SENSOR",
+                              std::get<1>(key));
+
+        setSensorNoResponse(row);
+        if (sensorBreaker.failure())
         {
-            sensorObj->updateValue(std::numeric_limits<double>::quiet_NaN());
-            sensorObj->setFunctionalStatus(false);
-            /* Go to next sensor */
-            this->sensorKey++;
+            openSensorCircuit();
         }
     }
     else
     {
+        sensorBreaker.success();
         int rc = PLDM_ERROR;
-        uint8_t pdr_type = std::get<2>(*(this->sensorKey));
+        uint8_t pdr_type = std::get<2>(key);
         union_range_field_format presentReading;
         uint8_t cc = 0;
         uint8_t dataSize = PLDM_SENSOR_DATA_SIZE_SINT32;
@@ -1853,8 +3097,6 @@ void TerminusHandler::processSensorReading(mctp_eid_t, const pldm_msg* response,
         uint8_t previousState;
         uint8_t eventState;
         union_range_field_format pendingValue;
-        SensorValueType sensorValue =
-                std::numeric_limits<double>::quiet_NaN();
 
         if (pdr_type == PLDM_COMPACT_NUMERIC_SENSOR_PDR)
         {
@@ -1870,152 +3112,790 @@ void TerminusHandler::processSensorReading(mctp_eid_t, const pldm_msg* response,
                 reinterpret_cast<uint8_t*>(&pendingValue),
                 reinterpret_cast<uint8_t*>(&presentReading));
         }
+        if (rc == PLDM_SUCCESS && cc == PLDM_SUCCESS &&
+            pdr_type == PLDM_COMPACT_NUMERIC_SENSOR_PDR && sensorObj)
+        {
+            updateEventDrivenSensor(row, eventMessEn);
+        }
         if (rc != PLDM_SUCCESS || cc != PLDM_SUCCESS)
         {
-            auto sid = std::get<1>(*(this->sensorKey));
-            std::cerr << "Failed to decode get sensor value: "
-                    << "rc=" << unsigned(rc) << ",cc=" << unsigned(cc) << " "
-                    << unsigned(eid) << ":" << sid << std::endl;
+            PLDM_LOG_RATE_LIMITED(error,
+                                  "Failed to decode get sensor value of EID "
+                                  "{EID} sensor {SENSOR}, rc={RC}, cc={CC}",
+                                  "EID", unsigned(eid), "SENSOR",
+                                  std::get<1>(key), "RC", rc, "CC",
+                                  unsigned(cc));
+        }
+        applySensorReading(row, key, rc == PLDM_SUCCESS && cc == PLDM_SUCCESS,
+                           dataSize, operationalState, presentReading);
+    }
+
+    completeSensorReading(response != nullptr && respMsgLen, sendTime);
+
+    return;
+}
+
+void TerminusHandler::applySensorReading(
+    size_t row, const sensor_key& key, bool valid, uint8_t dataSize,
+    uint8_t operationalState, const union_range_field_format& presentReading)
+{
+    bool effecter = std::get<2>(key) == PLDM_NUMERIC_EFFECTER_PDR;
+    if (effecter && pendingEffecterWrites.contains(key))
+    {
+        /* The reading may predate the write, it is read again */
+        return;
+    }
+
+    SensorValueType sensorValue = std::numeric_limits<double>::quiet_NaN();
+    if (!valid)
+    {
+        operationalState = PLDM_SENSOR_DISABLED;
+    }
+    else if (dataSize < readingDecoders.size())
+    {
+        sensorValue = readingDecoders[dataSize](presentReading);
+    }
+    bool functional =
+        verifySensorFunctionalStatus(std::get<2>(key), operationalState);
+    bool available =
+        verifySensorAvailableStatus(std::get<2>(key), operationalState);
+    /* the CompactNumericSensor is unavailable */
+    if (!available)
+    {
+        /* It is not read again, its object is removed before the next
+         * round */
+        unavailableSensorKeys.push_back(key);
+        if (row != SensorTable::npos)
+        {
+            pollRows.erase(row);
+        }
+    }
+
+    if (row != SensorTable::npos)
+    {
+        /* unavailable */
+        if (!functional)
+        {
             sensorValue = std::numeric_limits<double>::quiet_NaN();
-            operationalState = PLDM_SENSOR_DISABLED;
         }
-        else
+        sensorTable.objects[row]->setFunctionalStatus(functional, true);
+        sensorTable.objects[row]->updateValue(sensorValue, true);
+        updateSensorSnapshot(row);
+    }
+
+    /* The value of an effecter only changes when it is written, it is read
+     * again only until the terminus applied a pending value
+     */
+    if (effecter && valid && available &&
+        operationalState != EFFECTER_OPER_STATE_ENABLED_UPDATEPENDING)
+    {
+        removeEffecterFromPollingList({key});
+    }
+}
+
+void TerminusHandler::setSensorNoResponse(size_t row)
+{
+    if (row == SensorTable::npos)
+    {
+        return;
+    }
+
+    auto sensorObj = sensorTable.objects[row];
+    sensorObj->updateValue(std::numeric_limits<double>::quiet_NaN(), true);
+    sensorObj->setFunctionalStatus(false, true);
+    updateSensorSnapshot(row);
+}
+
+bool TerminusHandler::getSensorReadings(
+    std::vector<std::pair<size_t, sensor_key>>&& batch)
+{
+    std::vector<uint16_t> sensorIds;
+    sensorIds.reserve(batch.size());
+    for (const auto& [row, key] : batch)
+    {
+        sensorIds.emplace_back(sensorTable.sensorIds[row]);
+    }
+
+    auto payloadLength = oemGetSensorReadingsReqBytes(sensorIds.size());
+    auto requestMsg =
+        pldm::utils::RequestPool::acquire(sizeof(pldm_msg_hdr) + payloadLength);
+    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+    auto instanceId = instanceIdDb.next(eid);
+    auto rc = encodeOemGetSensorReadingsReq(instanceId, sensorIds, request,
+                                            payloadLength);
+    if (rc != PLDM_SUCCESS)
+    {
+        instanceIdDb.free(eid, instanceId);
+        PLDM_LOG_RATE_LIMITED(error,
+                              "Failed to encode the reading of {COUNT} "
+                              "sensors, rc={RC}",
+                              "COUNT", sensorIds.size(), "RC", rc);
+        return false;
+    }
+
+    rc = handler->registerRequest(
+        eid, instanceId, PLDM_OEM, PLDM_OEM_GET_SENSOR_READINGS,
+        std::move(requestMsg),
+        std::bind_front(&TerminusHandler::processSensorReadings, this,
+                        std::move(batch), std::chrono::steady_clock::now()),
+        requester::RequestPriority::Telemetry);
+    if (rc)
+    {
+        PLDM_LOG_RATE_LIMITED(error,
+                              "Failed to send the reading of {COUNT} sensors "
+                              "of EID {EID}, rc={RC}",
+                              "COUNT", sensorIds.size(), "EID", unsigned(eid),
+                              "RC", rc);
+        return false;
+    }
+
+    return true;
+}
+
+void TerminusHandler::processSensorReadings(
+    const std::vector<std::pair<size_t, sensor_key>>& batch,
+    std::chrono::steady_clock::time_point sendTime, mctp_eid_t,
+    const pldm_msg* response, size_t respMsgLen)
+{
+    if (response == nullptr || !respMsgLen)
+    {
+        PLDM_LOG_RATE_LIMITED(error,
+                              "No GetSensorReadings response from EID {EID} "
+                              "for {COUNT} sensors",
+                              "EID", unsigned(eid), "COUNT", batch.size());
+        for (const auto& [row, key] : batch)
         {
-            switch (dataSize)
-            {
-                case PLDM_SENSOR_DATA_SIZE_UINT8:
-                    sensorValue = static_cast<double>(presentReading.value_u8);
-                    break;
-                case PLDM_SENSOR_DATA_SIZE_SINT8:
-                    sensorValue = static_cast<double>(presentReading.value_s8);
-                    break;
-                case PLDM_SENSOR_DATA_SIZE_UINT16:
-                    sensorValue =
-                        static_cast<double>(presentReading.value_u16);
-                    break;
-                case PLDM_SENSOR_DATA_SIZE_SINT16:
-                    sensorValue =
-                        static_cast<double>(presentReading.value_s16);
-                    break;
-                case PLDM_SENSOR_DATA_SIZE_UINT32:
-                    sensorValue =
-                        static_cast<double>(presentReading.value_u32);
-                    break;
-                case PLDM_SENSOR_DATA_SIZE_SINT32:
-                    sensorValue =
-                        static_cast<double>(presentReading.value_s32);
-                    break;
-                default:
-                    sensorValue = std::numeric_limits<double>::quiet_NaN();
-                    break;
-            }
+            setSensorNoResponse(getSensorRow(row, key));
         }
-        std::unique_ptr<PldmSensor>& sensorObj =
-            _sensorObjects[*(this->sensorKey)];
-        bool functional = verifySensorFunctionalStatus(
-            std::get<2>(*(this->sensorKey)), operationalState);
-        bool available = verifySensorAvailableStatus(
-            std::get<2>(*(this->sensorKey)), operationalState);
-        /* the CompactNumericSensor is unavailable */
-        if (!available)
+        if (sensorBreaker.failure())
         {
-            unavailableSensorKeys.push_back(*(this->sensorKey));
+            openSensorCircuit();
         }
+        completeSensorReading(false, sendTime);
+        return;
+    }
+    sensorBreaker.success();
 
-        if (sensorObj)
+    uint8_t cc = PLDM_ERROR;
+    std::vector<OemSensorReading> readings;
+    auto rc = decodeOemGetSensorReadingsResp(response, respMsgLen, cc,
+                                             readings);
+    if (rc != PLDM_SUCCESS || cc != PLDM_SUCCESS)
+    {
+        /* Until the next discovery the sensors are read one by one, starting
+         * with the sensors of this request */
+        error("GetSensorReadings of EID {EID} failed, rc={RC}, cc={CC}, read "
+              "the sensors with GetSensorReading",
+              "EID", unsigned(eid), "RC", rc, "CC", unsigned(cc));
+        batchSensorReads = false;
+        if (pollingSensors)
         {
-            /* unavailable */
-            if (!functional)
+            for (const auto& [row, key] : batch)
             {
-                sensorValue = std::numeric_limits<double>::quiet_NaN();
+                auto current = getSensorRow(row, key);
+                if (current != SensorTable::npos)
+                {
+                    roundSensorRows.emplace_back(current);
+                }
             }
-            sensorObj->setFunctionalStatus(functional);
-            sensorObj->updateValue(sensorValue);
         }
-        this->sensorKey++;
+        completeSensorReading(true, sendTime);
+        return;
+    }
+
+    for (size_t i = 0; i < batch.size(); i++)
+    {
+        const auto& [requestRow, key] = batch[i];
+        auto row = getSensorRow(requestRow, key);
+
+        /* The readings are expected in the order of the request */
+        auto sensorId = std::get<1>(key);
+        auto reading = readings.end();
+        if (i < readings.size() && readings[i].sensorId == sensorId)
+        {
+            reading = readings.begin() + i;
+        }
+        else
+        {
+            reading = std::find_if(readings.begin(), readings.end(),
+                                   [sensorId](const auto& r) {
+                                       return r.sensorId == sensorId;
+                                   });
+        }
+        if (reading == readings.end())
+        {
+            PLDM_LOG_RATE_LIMITED(error,
+                                  "No reading of EID {EID} sensor {SENSOR} "
+                                  "in GetSensorReadings",
+                                  "EID", unsigned(eid), "SENSOR", sensorId);
+            applySensorReading(row, key, false, 0, PLDM_SENSOR_DISABLED, {});
+            continue;
+        }
+
+        if (row != SensorTable::npos)
+        {
+            updateEventDrivenSensor(row, reading->eventMessageEnable);
+        }
+        applySensorReading(row, key, true, reading->dataSize,
+                           reading->operationalState, reading->presentReading);
+    }
+
+    completeSensorReading(true, sendTime);
+}
+
+void TerminusHandler::openSensorCircuit()
+{
+    /* A missed heartbeat opens the breaker before the count is reached */
+    if (sensorBreaker.getFailures() >= SENSOR_CIRCUIT_BREAKER_THRESHOLD)
+    {
+        warning("EID {EID} did not answer {COUNT} sensor readings in a row, "
+                "pause the sensor polling",
+                "EID", unsigned(eid), "COUNT", sensorBreaker.getFailures());
+    }
+
+    /* Drop the rest of the round, the requests in flight still complete */
+    nextSensorIdx = roundSensorRows.size();
+
+    for (size_t row = 0; row < sensorTable.size(); row++)
+    {
+        auto sensorObj = sensorTable.objects[row];
+        sensorObj->updateValue(std::numeric_limits<double>::quiet_NaN(), true);
+        sensorObj->setFunctionalStatus(false, true);
+        sensorObj->emitPendingChanges();
+        updateSensorSnapshot(row);
+    }
+
+    probeInFlight = false;
+    _probeTimer.restart(
+        std::chrono::milliseconds(SENSOR_CIRCUIT_BREAKER_PROBE_INTERVAL));
+}
+
+void TerminusHandler::probeTerminus()
+{
+    if (!sensorBreaker.isOpen())
+    {
+        _probeTimer.setEnabled(false);
+        return;
+    }
+    if (probeInFlight)
+    {
+        return;
+    }
+
+    auto instanceId = instanceIdDb.next(eid);
+    Request requestMsg(sizeof(pldm_msg_hdr));
+    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+    auto rc = encode_get_tid_req(instanceId, request);
+    if (rc)
+    {
+        instanceIdDb.free(eid, instanceId);
+        PLDM_LOG_RATE_LIMITED(error, "Failed to encode the GetTID probe, "
+                                     "rc={RC}",
+                              "RC", rc);
+        return;
+    }
+
+    rc = handler->registerRequest(
+        eid, instanceId, PLDM_BASE, PLDM_GET_TID, std::move(requestMsg),
+        std::bind_front(&TerminusHandler::processProbeResponse, this),
+        requester::RequestPriority::Control);
+    if (rc)
+    {
+        PLDM_LOG_RATE_LIMITED(error,
+                              "Failed to send the GetTID probe to EID {EID}, "
+                              "rc={RC}",
+                              "EID", unsigned(eid), "RC", rc);
+        return;
+    }
+    probeInFlight = true;
+}
+
+void TerminusHandler::processProbeResponse(mctp_eid_t, const pldm_msg* response,
+                                           size_t respMsgLen)
+{
+    probeInFlight = false;
+    if (response == nullptr || !respMsgLen || !sensorBreaker.isOpen())
+    {
+        return;
+    }
+
+    sensorBreaker.success();
+    _probeTimer.setEnabled(false);
+    info("EID {EID} responds again, resume the sensor polling", "EID",
+         unsigned(eid));
+    /* The next round reads all the sensors whatever their polling tier */
+    readCount = 0;
+    refreshLiveness();
+}
+
+void TerminusHandler::refreshLiveness()
+{
+    if (!heartbeatExpected || !TERMINUS_HEARTBEAT_MISSES ||
+        !continuePollSensor)
+    {
+        return;
+    }
+    /* Called for each response, the timer is only moved on expiry */
+    lastHeard = std::chrono::steady_clock::now();
+    if (!_livenessTimer.isEnabled())
+    {
+        _livenessTimer.restartOnce(livenessWindow);
+    }
+}
+
+void TerminusHandler::livenessExpired()
+{
+    if (!continuePollSensor)
+    {
+        return;
+    }
+    auto silent = std::chrono::steady_clock::now() - lastHeard;
+    if (silent < livenessWindow)
+    {
+        _livenessTimer.restartOnce(
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                livenessWindow - silent));
+        return;
+    }
+    if (!sensorBreaker.trip())
+    {
+        return;
+    }
+    warning("EID {EID} missed its heartbeat for {SECONDS} seconds, declare "
+            "it down and pause the sensor polling",
+            "EID", unsigned(eid), "SECONDS", livenessWindow.count());
+    openSensorCircuit();
+}
+
+/** @brief Send the getSensorReading request to get sensor info
+ */
+bool TerminusHandler::getSensorReading(size_t row)
+{
+    auto sensor_id = sensorTable.sensorIds[row];
+    auto pdr_type = sensorTable.pdrTypes[row];
+    uint8_t req_byte = PLDM_GET_SENSOR_READING_REQ_BYTES;
+
+    if (pdr_type == PLDM_COMPACT_NUMERIC_SENSOR_PDR)
+    {
+        req_byte = PLDM_GET_SENSOR_READING_REQ_BYTES;
+    }
+    else if (pdr_type == PLDM_NUMERIC_EFFECTER_PDR)
+    {
+        req_byte = PLDM_GET_NUMERIC_EFFECTER_VALUE_REQ_BYTES;
+    }
+
+    auto requestMsg =
+        pldm::utils::RequestPool::acquire(sizeof(pldm_msg_hdr) + req_byte);
+    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+    uint8_t rearmEventState = 1;
+    auto instanceId = instanceIdDb.next(eid);
+
+    int rc = PLDM_ERROR;
+    if (pdr_type == PLDM_COMPACT_NUMERIC_SENSOR_PDR)
+    {
+        rc = encode_get_sensor_reading_req(instanceId, sensor_id,
+                                           rearmEventState, request);
+    }
+    else if (pdr_type == PLDM_NUMERIC_EFFECTER_PDR)
+    {
+        rc = encode_get_numeric_effecter_value_req(instanceId, sensor_id,
+                                                   request);
+    }
+
+    if (rc != PLDM_SUCCESS)
+    {
+        instanceIdDb.free(eid, instanceId);
+        PLDM_LOG_RATE_LIMITED(error,
+                              "Failed to encode the reading of sensor "
+                              "{SENSOR}, rc={RC}",
+                              "SENSOR", sensor_id, "RC", rc);
+        return false;
+    }
+
+    uint8_t cmd = PLDM_GET_SENSOR_READING;
+    if (pdr_type == PLDM_COMPACT_NUMERIC_SENSOR_PDR)
+    {
+        cmd = PLDM_GET_SENSOR_READING;
+    }
+    else if (pdr_type == PLDM_NUMERIC_EFFECTER_PDR)
+    {
+        cmd = PLDM_GET_NUMERIC_EFFECTER_VALUE;
+    }
+
+    rc = handler->registerRequest(
+        eid, instanceId, PLDM_PLATFORM, cmd,
+        std::move(requestMsg),
+        std::move(std::bind_front(&TerminusHandler::processSensorReading,
+                                  this, row, sensorTable.keys[row],
+                                  std::chrono::steady_clock::now())),
+        requester::RequestPriority::Telemetry);
+    if (rc)
+    {
+        PLDM_LOG_RATE_LIMITED(error,
+                              "Failed to send the reading of EID {EID} "
+                              "sensor {SENSOR}, rc={RC}",
+                              "EID", unsigned(eid), "SENSOR", sensor_id, "RC",
+                              rc);
+        return false;
+    }
+
+    return true;
+}
+
+uint16_t TerminusHandler::getSensorPollRounds(const std::string& sensorName,
+                                              const std::string& pdrName,
+                                              EntityType entityType)
+{
+    for (const auto& name : {sensorName, pdrName})
+    {
+        auto it = pollingTiers.sensorNames.find(name);
+        if (it != pollingTiers.sensorNames.end())
+        {
+            return it->second;
+        }
+    }
+
+    auto it = pollingTiers.entityTypes.find(entityType);
+    if (it != pollingTiers.entityTypes.end())
+    {
+        return it->second;
+    }
+
+    return 1;
+}
+
+SensorPublishFilter
+    TerminusHandler::getSensorPublishFilter(const std::string& sensorName,
+                                            const std::string& pdrName,
+                                            EntityType entityType)
+{
+    for (const auto& name : {sensorName, pdrName})
+    {
+        auto it = pollingTiers.nameFilters.find(name);
+        if (it != pollingTiers.nameFilters.end())
+        {
+            return it->second;
+        }
+    }
+
+    auto it = pollingTiers.entityFilters.find(entityType);
+    if (it != pollingTiers.entityFilters.end())
+    {
+        return it->second;
+    }
+
+    return {};
+}
+
+bool TerminusHandler::isSensorPollDue(size_t row)
+{
+    uint32_t rounds = sensorTable.pollRounds[row];
+    if (rounds <= 1)
+    {
+        return true;
+    }
+    rounds *= pollingProfile.tierScale;
+
+    /* The first round reads all of sensors, then each tier reads in its
+     * own rounds */
+    if (readCount == 1)
+    {
+        return true;
+    }
+    return ((readCount - 1) % rounds) ==
+           tierRoundOffset(rounds, pollPhase.index());
+}
+
+PldmSensor* TerminusHandler::findSensor(std::string_view path) const
+{
+    auto it = std::find_if(sensorTable.objects.begin(),
+                           sensorTable.objects.end(),
+                           [path](PldmSensor* sensorObj) {
+        return sensorObj->getSensorPath() == path;
+    });
+    return it != sensorTable.objects.end() ? *it : nullptr;
+}
+
+size_t TerminusHandler::getSensorRow(size_t row, const sensor_key& key) const
+{
+    if (row < sensorTable.size() && sensorTable.keys[row] == key)
+    {
+        return row;
     }
-    sendingPldmCommand = false;
 
-    return;
+    auto it = sensorRows.find(key);
+    return it != sensorRows.end() ? it->second : SensorTable::npos;
 }
 
-/** @brief Send the getSensorReading request to get sensor info
- */
-void TerminusHandler::getSensorReading(uint16_t sensor_id, uint8_t pdr_type)
+void TerminusHandler::updateEventDrivenSensor(
+    [[maybe_unused]] size_t row, [[maybe_unused]] uint8_t eventMessageEnable)
 {
-    uint8_t req_byte = PLDM_GET_SENSOR_READING_REQ_BYTES;
-
-    sendingPldmCommand = true;
-    if (pdr_type == PLDM_COMPACT_NUMERIC_SENSOR_PDR)
+#ifdef SENSOR_EVENT_DRIVEN_UPDATE
+    const auto& key = sensorTable.keys[row];
+    constexpr uint16_t verifyRounds = std::max(
+        1, SENSOR_EVENT_VERIFY_INTERVAL / POLL_SENSOR_TIMER_INTERVAL);
+    bool eventEnabled = (eventMessageEnable == PLDM_EVENTS_ENABLED) ||
+                        (eventMessageEnable == PLDM_STATE_EVENTS_ONLY_ENABLED);
+    auto it = eventDrivenSensors.find(key);
+    if (eventEnabled && it == eventDrivenSensors.end())
     {
-        req_byte = PLDM_GET_SENSOR_READING_REQ_BYTES;
+        auto rounds = sensorPollRounds.contains(key) ? sensorPollRounds[key]
+                                                     : uint16_t(1);
+        eventDrivenSensors[key] = rounds;
+        sensorPollRounds[key] = std::max(rounds, verifyRounds);
+        sensorTable.pollRounds[row] = sensorPollRounds[key];
     }
-    else if (pdr_type == PLDM_NUMERIC_EFFECTER_PDR)
+    else if (!eventEnabled && it != eventDrivenSensors.end())
     {
-        req_byte = PLDM_GET_NUMERIC_EFFECTER_VALUE_REQ_BYTES;
+        /* The terminus disabled the events, restore the polling interval */
+        sensorPollRounds[key] = it->second;
+        sensorTable.pollRounds[row] = it->second;
+        eventDrivenSensors.erase(it);
     }
+#endif
+}
 
-    std::vector<uint8_t> requestMsg(sizeof(pldm_msg_hdr) + req_byte);
-    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
-    uint8_t rearmEventState = 1;
-    auto instanceId = instanceIdDb.next(eid);
-
-    int rc = PLDM_ERROR;
-    if (pdr_type == PLDM_COMPACT_NUMERIC_SENSOR_PDR)
+bool TerminusHandler::updateSensorFromEvent(uint16_t sensorId,
+                                            uint8_t sensorDataSize,
+                                            uint32_t presentReading)
+{
+    auto key = std::make_tuple(eid, sensorId,
+                               uint8_t(PLDM_COMPACT_NUMERIC_SENSOR_PDR));
+    auto it = sensorRows.find(key);
+    if (it == sensorRows.end())
     {
-        rc = encode_get_sensor_reading_req(instanceId, sensor_id,
-                                           rearmEventState, request);
+        return false;
     }
-    else if (pdr_type == PLDM_NUMERIC_EFFECTER_PDR)
+    auto row = it->second;
+
+    SensorValueType sensorValue = std::numeric_limits<double>::quiet_NaN();
+    switch (sensorDataSize)
     {
-        rc = encode_get_numeric_effecter_value_req(instanceId, sensor_id,
-                                                   request);
+        case PLDM_SENSOR_DATA_SIZE_UINT8:
+            sensorValue = static_cast<double>(static_cast<uint8_t>(
+                presentReading));
+            break;
+        case PLDM_SENSOR_DATA_SIZE_SINT8:
+            sensorValue = static_cast<double>(static_cast<int8_t>(
+                presentReading));
+            break;
+        case PLDM_SENSOR_DATA_SIZE_UINT16:
+            sensorValue = static_cast<double>(static_cast<uint16_t>(
+                presentReading));
+            break;
+        case PLDM_SENSOR_DATA_SIZE_SINT16:
+            sensorValue = static_cast<double>(static_cast<int16_t>(
+                presentReading));
+            break;
+        case PLDM_SENSOR_DATA_SIZE_UINT32:
+            sensorValue = static_cast<double>(presentReading);
+            break;
+        case PLDM_SENSOR_DATA_SIZE_SINT32:
+            sensorValue = static_cast<double>(static_cast<int32_t>(
+                presentReading));
+            break;
+        default:
+            PLDM_LOG_RATE_LIMITED(error,
+                                  "Invalid data size of numeric sensor event, "
+                                  "sensor {SENSOR}",
+                                  "SENSOR", sensorId);
+            return true;
     }
 
-    if (rc != PLDM_SUCCESS)
+    sensorTable.objects[row]->setFunctionalStatus(true);
+    sensorTable.objects[row]->updateValue(sensorValue);
+    updateSensorSnapshot(row);
+
+    return true;
+}
+
+void TerminusHandler::createSensorSnapshot()
+{
+#ifdef SENSOR_SNAPSHOT_DIR
+    /* Drop the old mapping first, it owns the same file */
+    sensorSnapshot.reset();
+    std::fill(sensorTable.snapshotSlots.begin(),
+              sensorTable.snapshotSlots.end(), SensorTable::npos);
+
+    /* The entries are in the order of the rows */
+    std::vector<std::pair<uint16_t, uint8_t>> sensors;
+    for (size_t row = 0; row < sensorTable.size(); row++)
+    {
+        sensors.emplace_back(sensorTable.sensorIds[row],
+                             sensorTable.pdrTypes[row]);
+    }
+    if (sensors.empty())
     {
-        instanceIdDb.free(eid, instanceId);
-        std::cerr << "Failed to reading sensor/effecter, rc = " << rc
-                  << std::endl;
         return;
     }
 
-    uint8_t cmd = PLDM_GET_SENSOR_READING;
-    if (pdr_type == PLDM_COMPACT_NUMERIC_SENSOR_PDR)
+    auto path = std::filesystem::path(SENSOR_SNAPSHOT_DIR) /
+                ("terminus_" + std::to_string(unsigned(eid)));
+    sensorSnapshot = std::make_unique<SensorSnapshot>(path, eid, sensors);
+    if (!sensorSnapshot->isValid())
     {
-        cmd = PLDM_GET_SENSOR_READING;
+        sensorSnapshot.reset();
+        return;
     }
-    else if (pdr_type == PLDM_NUMERIC_EFFECTER_PDR)
+
+    for (size_t row = 0; row < sensorTable.size(); row++)
     {
-        cmd = PLDM_GET_NUMERIC_EFFECTER_VALUE;
+        sensorTable.snapshotSlots[row] = row;
+        updateSensorSnapshot(row);
     }
+#endif
+}
 
-    rc = handler->registerRequest(
-        eid, instanceId, PLDM_PLATFORM, cmd,
-        std::move(requestMsg),
-        std::move(std::bind_front(&TerminusHandler::processSensorReading,
-            this)));
-    if (rc)
+void TerminusHandler::updateSensorSnapshot(size_t row)
+{
+    if (!sensorSnapshot || sensorTable.snapshotSlots[row] == SensorTable::npos)
     {
-        std::cerr << "Failed to send reading sensor/effecter request to Host"
-                  << std::endl;
+        return;
     }
 
-    return;
+    auto sensorObj = sensorTable.objects[row];
+    sensorSnapshot->update(sensorTable.snapshotSlots[row],
+                           sensorObj->getValue(),
+                           sensorObj->getFunctionalStatus());
 }
 
 void TerminusHandler::updateSensorKeys()
 {
-    sensorKeys.clear();
-    for(auto it = _state.begin(); it != _state.end(); ++it) {
-        sensorKeys.push_back(it->first);
+    auto oldTable = std::move(sensorTable);
+    sensorTable = {};
+    sensorRows.clear();
+    pollRows.clear();
+
+    auto count = _sensorObjects.size();
+    size_t memory = 0;
+    if (SENSOR_HISTORY_DEPTH && !sensorHistory)
+    {
+        sensorHistory = std::make_unique<SensorHistory>(SENSOR_HISTORY_DEPTH);
+    }
+    if (!stalenessHistogram)
+    {
+        stalenessHistogram = &pldm::metrics::Registry::get().histogram(
+            "pldm_sensor_reading_age_seconds",
+            "Age of the sensor readings when the next reading replaces them",
+            {{"eid", std::to_string(eid)}});
     }
+    sensorTable.keys.reserve(count);
+    sensorTable.sensorIds.reserve(count);
+    sensorTable.pdrTypes.reserve(count);
+    sensorTable.pollRounds.reserve(count);
+    sensorTable.snapshotSlots.reserve(count);
+    sensorTable.objects.reserve(count);
+    for (const auto& [key, sensorObj] : _sensorObjects)
+    {
+        auto row = sensorTable.size();
+        sensorRows.emplace(key, row);
+        sensorTable.keys.emplace_back(key);
+        sensorTable.sensorIds.emplace_back(std::get<1>(key));
+        sensorTable.pdrTypes.emplace_back(std::get<2>(key));
+        auto roundsIt = sensorPollRounds.find(key);
+        sensorTable.pollRounds.emplace_back(
+            roundsIt != sensorPollRounds.end() ? roundsIt->second : 1);
+        sensorTable.snapshotSlots.emplace_back(SensorTable::npos);
+        sensorTable.objects.emplace_back(sensorObj.get());
+        if (sensorHistory)
+        {
+            sensorObj->attachHistory(*sensorHistory);
+        }
+        sensorObj->setStalenessHistogram(stalenessHistogram);
+        memory += sensorObj->memoryUsage();
+        if (_state.contains(key))
+        {
+            pollRows.insert(row);
+        }
+    }
+
+    /* The snapshot entries are kept until the snapshot is recreated, and
+     * the current polling round goes on with the new rows
+     */
+    for (size_t row = 0; row < oldTable.size(); row++)
+    {
+        auto it = sensorRows.find(oldTable.keys[row]);
+        if (it != sensorRows.end())
+        {
+            sensorTable.snapshotSlots[it->second] = oldTable.snapshotSlots[row];
+        }
+    }
+    std::vector<size_t> roundRows;
+    size_t nextIdx = 0;
+    for (size_t i = 0; i < roundSensorRows.size(); i++)
+    {
+        auto it = sensorRows.find(oldTable.keys[roundSensorRows[i]]);
+        if (it == sensorRows.end())
+        {
+            continue;
+        }
+        if (i < nextSensorIdx)
+        {
+            nextIdx++;
+        }
+        roundRows.emplace_back(it->second);
+    }
+    roundSensorRows = std::move(roundRows);
+    nextSensorIdx = nextIdx;
+
+    /* The sensor objects, the columns of the sensor table and the reading
+     * history */
+    memory += sensorTable.size() * SensorTable::rowBytes;
+    if (sensorHistory)
+    {
+        memory += sensorHistory->memoryUsage();
+    }
+    if (!sensorMemoryGauge)
+    {
+        sensorMemoryGauge = &pldm::metrics::Registry::get().gauge(
+            "pldm_sensor_memory_bytes",
+            "Approximate memory used by the sensors of the terminus",
+            {{"eid", std::to_string(eid)}});
+    }
+    sensorMemoryGauge->set(static_cast<int64_t>(memory));
 }
 
 void TerminusHandler::stopTerminusHandler()
 {
     stopTerminusPolling = true;
     continuePollSensor = false;
+    stopSource.cancel();
+}
+
+void TerminusHandler::suspendTerminusHandler()
+{
+    stopSensorsPolling();
+    if (eventDataHndl)
+    {
+        eventDataHndl->stopEventSignalPolling();
+    }
+}
+
+requester::Coroutine TerminusHandler::resumeTerminusHandler()
+{
+    if (!isDiscovered() || pdrSignature.empty())
+    {
+        co_return PLDM_ERROR;
+    }
+
+    std::vector<uint8_t> signature;
+    auto rc = co_await getPDRRepositoryInfo(signature);
+    if (stopTerminusPolling)
+    {
+        co_return PLDM_ERROR;
+    }
+    if (rc || signature != pdrSignature)
+    {
+        info("The PDR repository of EID {EID} changed, rc={RC}", "EID",
+             unsigned(eid), "RC", rc);
+        co_return PLDM_ERROR;
+    }
+
+    info("Resume the terminus of EID {EID} after its MCTP endpoint came back",
+         "EID", unsigned(eid));
+    startSensorsPolling();
+    eventDataHndl->startEventSignalPolling();
+    co_return PLDM_SUCCESS;
 }
 
 void TerminusHandler::addEventMsg(uint8_t tid, uint8_t eventId,
@@ -2023,6 +3903,7 @@ void TerminusHandler::addEventMsg(uint8_t tid, uint8_t eventId,
 {
     if (tid != devInfo.tid)
         return;
+    refreshLiveness();
 #ifdef AMPERE
     if (eventId == 200)
     {
@@ -2074,9 +3955,21 @@ requester::Coroutine TerminusHandler::setNumericEffecterValue(uint16_t effecterI
         co_return rc;
     }
 
+    /* A reading of the effecter sent before the write completes may report
+     * the previous value
+     */
+    auto key = std::make_tuple(eid, effecterId,
+                               uint8_t(PLDM_NUMERIC_EFFECTER_PDR));
+    pendingEffecterWrites[key]++;
     Response responseMsg{};
-    rc = co_await requester::sendRecvPldmMsg(*handler, eid, requestMsg,
-                                             responseMsg);
+    rc = co_await requester::sendRecvPldmMsg(
+        *handler, eid, requestMsg, responseMsg,
+        requester::RequestPriority::Control);
+    if (auto it = pendingEffecterWrites.find(key);
+        it != pendingEffecterWrites.end() && !--it->second)
+    {
+        pendingEffecterWrites.erase(it);
+    }
     if (rc)
     {
         std::cerr << "Failed to send sendRecvPldmMsg, EID=" << unsigned(eid)
@@ -2112,162 +4005,200 @@ requester::Coroutine TerminusHandler::setNumericEffecterValue(uint16_t effecterI
         co_return cc;
     }
 
+    /* Write through, the effecter keeps the written value unless it is
+     * polled while the terminus applies it
+     */
+    auto it = sensorRows.find(key);
+    if (it != sensorRows.end() && effecterDataSize < readingDecoders.size())
+    {
+        union_range_field_format value{};
+        std::memcpy(&value, effecterValue,
+                    size_t(1) << (effecterDataSize / 2));
+        auto row = it->second;
+        sensorTable.objects[row]->updateValue(
+            readingDecoders[effecterDataSize](value));
+        updateSensorSnapshot(row);
+    }
+
     co_return cc;
 }
 
-/** 
+/** @brief Log an impactless update step of a terminus for Redfish */
+static void logImpactlessUpdate(uint8_t tid, const std::string& step,
+                                const char* redfishMessageId)
+{
+    std::string description = "IMPACTLESS UPDATE: TID " +
+                              std::to_string(unsigned(tid)) + " - " + step;
+    sd_journal_send("MESSAGE=%s", description.c_str(),
+                    "REDFISH_MESSAGE_ID=%s", redfishMessageId,
+                    "REDFISH_MESSAGE_ARGS=%s", description.c_str(), NULL);
+}
+
+/**
  *  @brief Start waiting for MPro recovery from impactless update.
- *  @details MPro's state is read by executing ampere_request_mpro_state script.
- *  If FW_BOOT_OK asserts within 60s, wait for MCTP interface. If MCTP interface
- *  from MPro is ready within 60s, restart sensor and event polling and hang
- *  detection service. Otherwise, do nothing.
+ *  @details The FW_BOOT_OK edges wake the daemon up, nothing runs while
+ *  waiting. The MPro is quiesced with FW_BOOT_OK asserted, it deasserts
+ *  when the MPro resets then asserts when the new firmware booted.
  */
 void TerminusHandler::waitForMProRecovery()
 {
-    std::string socket(&eidToName.second[1], 1);
-    std::string command = "/usr/sbin/ampere_request_mpro_state.sh";
-
-    if (!std::filesystem::exists(command))
+    if (eidToName.second.size() < 2)
     {
-        error("IMPACTLESS UPDATE: Script to wait for MPro recovery does not exist");
+        error("IMPACTLESS UPDATE: No socket for EID {EID}", "EID",
+              unsigned(eid));
         return;
     }
-    command += " " + socket + " ";
-    MProState stateRequest;
-    switch (mProState)
+    auto socket = eidToName.second.substr(1, 1);
+    auto lineName = std::vformat(IMPACTLESS_UPDATE_FW_BOOT_OK_GPIO,
+                                 std::make_format_args(socket));
+
+    fwBootOkMonitor.reset();
+    try
+    {
+        fwBootOkMonitor = std::make_unique<pldm::GpioMonitor>(
+            event, lineName,
+            std::bind_front(&TerminusHandler::fwBootOkChanged, this));
+    }
+    catch (const std::exception& e)
     {
-        case MProState::MProQuiesce: /* MPro is in quiesce mode, wait for FW_BOOT_OK to deassert.
-                                        Request to read FW_BOOT_OK state */
-            stateRequest  = MProState::MProDown;
-            command += "fwboot";
-            break;
-        case MProState::MProDown: /* Request to read FW_BOOT_OK state */
-            stateRequest  = MProState::MProUp;
-            command += "fwboot";
-            break;
-        case MProState::MProUp: /* Request to read MCTP interface state */
-            stateRequest  = MProState::MCTPReady;
-            command += "mctpinf";
-            break;
-        case MProState::MCTPReady: /* Temporarily: MPro has recovered - Return */
-            _timer4.setEnabled(false);
-            return;
-        case MProState::MProReady: /* MPro has recovered - Return */
-            _timer4.setEnabled(false);
-            return;
-        default:
-            error("IMPACTLESS UPDATE: Invalid Mpro State Request");
-            _timer4.setEnabled(false);
-            return;
+        error("IMPACTLESS UPDATE: Failed to watch FW_BOOT_OK GPIO {GPIO}, "
+              "error={ERROR}",
+              "GPIO", lineName, "ERROR", e.what());
+        return;
     }
 
-    std::stringstream strStream;
-    std::string description = "IMPACTLESS UPDATE: ";
+    /* FW_BOOT_OK may have deasserted before the line was requested */
+    if (!fwBootOkMonitor->getValue())
+    {
+        fwBootOkChanged(false);
+    }
+}
 
-    std::string status = exec(command.c_str());
-    if (status.find("0") != std::string::npos) /* MPro's requested status is on */
+void TerminusHandler::fwBootOkChanged(bool asserted)
+{
+    if (mProState == MProState::MProQuiesce && !asserted)
     {
-        if (stateRequest == MProState::MProDown)
-        {
-            if (fwUpdateFailed)
-            {
-                // MC State returns Impactless Update has failed,
-                // resume operation
-                fwUpdateFailed = false;
-                mProState = MProState::MProReady;
-                _timer4.setEnabled(false);
-                restartSensorAndEventPolling();
-                return;
-            }
-            // else: wait for FW_BOOT_OK to deassert
-        }
-        else if (stateRequest == MProState::MProUp)
-        {
-            mProState = stateRequest;
-            countNum = 0;
+        logImpactlessUpdate(devInfo.tid, "FW_BOOT_OK desserted",
+                            "OpenBMC.0.1.AmpereEvent");
+        mProState = MProState::MProDown;
+        _timer4.restartOnce(
+            std::chrono::milliseconds(IMPACTLESS_UPDATE_MPRO_RECOVERY_TIMEOUT_MS));
+    }
+    else if (mProState == MProState::MProDown && asserted)
+    {
+        logImpactlessUpdate(devInfo.tid, "FW_BOOT_OK asserted",
+                            "OpenBMC.0.1.AmpereEvent");
+        mProState = MProState::MProUp;
+        fwBootOkMonitor->stop();
+        _timer4.restartOnce(
+            std::chrono::milliseconds(IMPACTLESS_UPDATE_MPRO_RECOVERY_TIMEOUT_MS));
+        probeMctpInterface();
+    }
+}
 
-            strStream << "TID " << unsigned(devInfo.tid) << " - FW_BOOT_OK asserted";
+void TerminusHandler::notifyFWUpdateFailure()
+{
+    fwUpdateFailed = true;
+    /* The MPro did not reset, MC State returns Impactless Update has
+     * failed, resume operation */
+    if (mProState == MProState::MProQuiesce && fwBootOkMonitor &&
+        fwBootOkMonitor->getValue())
+    {
+        fwUpdateFailed = false;
+        fwBootOkMonitor->stop();
+        mProState = MProState::MProReady;
+        _timer4.setEnabled(false);
+        restartSensorAndEventPolling();
+    }
+}
 
-            description += strStream.str();
-            if (!description.empty())
-            {
-                std::string REDFISH_MESSAGE_ID = "OpenBMC.0.1.AmpereEvent";
+bool TerminusHandler::mctpEndpointAdded()
+{
+    if (mProState != MProState::MProUp)
+    {
+        return false;
+    }
+    mProRecovered();
+    return true;
+}
 
-                sd_journal_send("MESSAGE=%s", description.c_str(),
-                                "REDFISH_MESSAGE_ID=%s",
-                                REDFISH_MESSAGE_ID.c_str(),
-                                "REDFISH_MESSAGE_ARGS=%s",
-                                description.c_str(), NULL);
-            }
-        }
-        else if (stateRequest == MProState::MCTPReady)
-        {
-            // TODO [Chau Ly]: In the future, might wait some seconds
-            // after MTCP interface is ready before resuming actions to MPro.
-            mProState = stateRequest;
-            mProState = MProState::MProReady;
+void TerminusHandler::probeMctpInterface()
+{
+    if (mProState != MProState::MProUp || mctpProbeInFlight)
+    {
+        return;
+    }
 
-            strStream << "TID " << unsigned(devInfo.tid) << " - MPro MCTP Interface is ready";
+    auto instanceId = instanceIdDb.next(eid);
+    Request requestMsg(sizeof(pldm_msg_hdr));
+    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+    auto rc = encode_get_tid_req(instanceId, request);
+    if (rc)
+    {
+        instanceIdDb.free(eid, instanceId);
+        error("IMPACTLESS UPDATE: Failed to encode the GetTID probe, rc={RC}",
+              "RC", rc);
+        return;
+    }
 
-            description += strStream.str();
-            if (!description.empty())
-            {
-                std::string REDFISH_MESSAGE_ID = "OpenBMC.0.1.AmpereEvent";
+    rc = handler->registerRequest(
+        eid, instanceId, PLDM_BASE, PLDM_GET_TID, std::move(requestMsg),
+        std::bind_front(&TerminusHandler::processMctpProbeResponse, this),
+        requester::RequestPriority::Control);
+    if (rc)
+    {
+        error("IMPACTLESS UPDATE: Failed to send the GetTID probe to EID "
+              "{EID}, rc={RC}",
+              "EID", unsigned(eid), "RC", rc);
+        return;
+    }
+    mctpProbeInFlight = true;
+}
 
-                sd_journal_send("MESSAGE=%s", description.c_str(),
-                                "REDFISH_MESSAGE_ID=%s",
-                                REDFISH_MESSAGE_ID.c_str(),
-                                "REDFISH_MESSAGE_ARGS=%s",
-                                description.c_str(), NULL);
-            }
-            _timer4.setEnabled(false);
-            restartSensorAndEventPolling();
-            return;
-        }
+void TerminusHandler::processMctpProbeResponse(mctp_eid_t,
+                                               const pldm_msg* response,
+                                               size_t respMsgLen)
+{
+    mctpProbeInFlight = false;
+    if (mProState != MProState::MProUp)
+    {
+        return;
     }
-    else /* MPro's requested status is not on */
+    /* The request timeout paces the probes until the MPro answers */
+    if (response == nullptr || !respMsgLen)
     {
-        if (stateRequest == MProState::MProDown) /* FW_BOOT_OK has deasserted */
-        {
-            strStream << "TID " << unsigned(devInfo.tid) << " - FW_BOOT_OK desserted";
-            description += strStream.str();
-            if (!description.empty())
-            {
-                std::string REDFISH_MESSAGE_ID = "OpenBMC.0.1.AmpereEvent";
-
-                sd_journal_send("MESSAGE=%s", description.c_str(),
-                                "REDFISH_MESSAGE_ID=%s",
-                                REDFISH_MESSAGE_ID.c_str(),
-                                "REDFISH_MESSAGE_ARGS=%s",
-                                description.c_str(), NULL);
-            }
-            mProState = stateRequest;
-        }
-        else
-        {
-            if (countNum >= (uint16_t)(IMPACTLESS_UPDATE_MPRO_RECOVERY_TIMEOUT_MS/IMPACTLESS_UPDATE_TIMER_INTERVAL_MS))
-            {
-                strStream << "TID " << unsigned(devInfo.tid) << " - Timeout waiting for MPro recovery";
+        probeMctpInterface();
+        return;
+    }
+    mProRecovered();
+}
 
-                description += strStream.str();
-                if (!description.empty())
-                {
-                    std::string REDFISH_MESSAGE_ID = "OpenBMC.0.1.AmpereCritical";
+void TerminusHandler::mProRecovered()
+{
+    // TODO [Chau Ly]: In the future, might wait some seconds
+    // after MTCP interface is ready before resuming actions to MPro.
+    logImpactlessUpdate(devInfo.tid, "MPro MCTP Interface is ready",
+                        "OpenBMC.0.1.AmpereEvent");
+    mProState = MProState::MProReady;
+    _timer4.setEnabled(false);
+    restartSensorAndEventPolling();
+}
 
-                    sd_journal_send("MESSAGE=%s", description.c_str(),
-                                    "REDFISH_MESSAGE_ID=%s",
-                                    REDFISH_MESSAGE_ID.c_str(),
-                                    "REDFISH_MESSAGE_ARGS=%s",
-                                    description.c_str(), NULL);
-                }
-                _timer4.setEnabled(false);
-                return;
-            }
-            countNum++;
-        }
+void TerminusHandler::mProRecoveryTimeout()
+{
+    if (mProState != MProState::MProDown && mProState != MProState::MProUp)
+    {
+        return;
     }
-    _timer4.restartOnce(std::chrono::milliseconds(IMPACTLESS_UPDATE_TIMER_INTERVAL_MS)); //100ms
-    return;
+    logImpactlessUpdate(devInfo.tid, "Timeout waiting for MPro recovery",
+                        "OpenBMC.0.1.AmpereCritical");
+    if (fwBootOkMonitor)
+    {
+        fwBootOkMonitor->stop();
+    }
+    /* Stop waiting, a late probe response or endpoint does not resume the
+     * polling */
+    mProState = MProState::MProReady;
 }
 
 /**
@@ -2315,85 +4246,63 @@ requester::Coroutine TerminusHandler::waitForImpactlessUpdateRecovery()
                         description.c_str(), NULL);
     }
     mProState = MProState::MProQuiesce;
-    _timer4.restartOnce(std::chrono::milliseconds(IMPACTLESS_UPDATE_TIMER_INTERVAL_MS)); //100ms
+    waitForMProRecovery();
     co_return rc;
 }
 
 /**
- * @brief Start waiting for RAS polling completion to:
+ * @brief Enter quiesce mode once all the remaining RAS are polled:
  * 1. Stop sensor polling
  * 2. Stop event polling
  * 3. Write to MC Control Effecter (effecterId = 254) to acknowledge host firmware update
  */
-void TerminusHandler::waitForRASPollingFinished()
+requester::Coroutine TerminusHandler::enterQuiesceMode()
 {
-    if (!eventDataHndl)
-    {
-        return;
-    }
-    if (eventDataHndl->areBMCRASQueuesEmpty() && eventDataHndl->areMProRASQueuesEmpty())
-    {
-        std::cerr << "DEBUG: Polling all remaining RAS is finished after "
-                  << unsigned(countNum*IMPACTLESS_UPDATE_TIMER_INTERVAL_MS/1000) << " seconds \n";
-        stopSensorsPolling();
-        eventDataHndl->stopEventSignalPolling();
-        eventDataHndl->inQuiesceMode(false);
-        countNum = 0;
-
-        // Stop hang dectection service
-        if (system("systemctl stop ampere-sysfw-hang-handler.service"))
-        {
-            error("Failed to call stop hand-detection service");
-        }
+    auto start = std::chrono::steady_clock::now();
+    eventDataHndl->inQuiesceMode(true);
+    auto drained = co_await eventDataHndl->queuesDrained(
+        std::chrono::milliseconds(IMPACTLESS_UPDATE_FINISH_RAS_TIMEOUT_MS));
+    eventDataHndl->inQuiesceMode(false);
 
-        [[maybe_unused]] auto co = waitForImpactlessUpdateRecovery();
-        return;
-    }
-    else
+    if (!drained)
     {
         // Polling RAS is not finished within timeout
-        if (countNum >= (uint16_t)(IMPACTLESS_UPDATE_FINISH_RAS_TIMEOUT_MS/IMPACTLESS_UPDATE_TIMER_INTERVAL_MS))
-        {
-            eventDataHndl->inQuiesceMode(false);
-            countNum = 0;
-            //Log to REDFISH
-            std::stringstream strStream;
-            std::string description = "";
-            description += "IMPACTLESS UPDATE: ";
-
-            strStream << "TID " << unsigned(devInfo.tid) << " - Quiesce mode FAILED, Polling RAS is not done within timer";
-
-            description += strStream.str();
-            if (!description.empty())
-            {
-                std::string REDFISH_MESSAGE_ID = "OpenBMC.0.1.AmpereEvent";
+        logImpactlessUpdate(devInfo.tid,
+                            "Quiesce mode FAILED, Polling RAS is not done "
+                            "within timer",
+                            "OpenBMC.0.1.AmpereEvent");
+        co_return PLDM_ERROR;
+    }
 
-                sd_journal_send("MESSAGE=%s", description.c_str(),
-                                "REDFISH_MESSAGE_ID=%s",
-                                REDFISH_MESSAGE_ID.c_str(),
-                                "REDFISH_MESSAGE_ARGS=%s",
-                                description.c_str(), NULL);
-            }
-            return;
-        }
-        else
-        {
-            countNum++;
-        }
+    info("Polling all remaining RAS of EID {EID} is finished after {TIME_MS} "
+         "ms",
+         "EID", unsigned(eid), "TIME_MS",
+         std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::steady_clock::now() - start)
+             .count());
+    stopSensorsPolling();
+    eventDataHndl->stopEventSignalPolling();
+
+    // Stop hang dectection service
+    if (system("systemctl stop ampere-sysfw-hang-handler.service"))
+    {
+        error("Failed to call stop hand-detection service");
     }
-    _timer3.restartOnce(std::chrono::milliseconds(IMPACTLESS_UPDATE_TIMER_INTERVAL_MS)); //100ms
-    return;
+
+    co_return co_await waitForImpactlessUpdateRecovery();
 }
 
 /** @brief Enter quiesce mode after polling all remaining RAS events
  *  @details Stop hang detection service, sensor and event polling
- *  after finishing polling the remaining RAS events. First, start
- *  a timer to wait for RAS polling completion.
+ *  as soon as the RAS queues are drained.
  */
 void TerminusHandler::startQuiesceMode()
 {
-    eventDataHndl->inQuiesceMode(true);
-    _timer3.restartOnce(std::chrono::milliseconds(IMPACTLESS_UPDATE_TIMER_INTERVAL_MS)); //100ms
+    if (!eventDataHndl)
+    {
+        return;
+    }
+    [[maybe_unused]] auto co = enterQuiesceMode();
 }
 
 /** @brief Restart sensor and event polling
@@ -3,18 +3,37 @@
 #include "libpldm/fru.h"
 
 #include "common/instance_id.hpp"
+#include "common/metrics.hpp"
 #include "common/types.hpp"
 #include "pldmd/dbus_impl_fru.hpp"
+#include "requester/active_set.hpp"
+#include "requester/circuit_breaker.hpp"
+#include "requester/coroutine_tools.hpp"
+#include "requester/gpio_monitor.hpp"
 #include "requester/handler.hpp"
+#include "requester/pdr_segment.hpp"
 #include "requester/pldm_message_poll_event.hpp"
+#include "requester/poll_phase.hpp"
+#include "requester/polling_profile.hpp"
+#include "requester/string_pool.hpp"
+#include "requester/terminus_cache.hpp"
 #include "sensors/pldm_sensor.hpp"
+#include "sensors/sensor_snapshot.hpp"
 
 #include <sdeventplus/event.hpp>
 #include <sdeventplus/source/event.hpp>
 #include <sdeventplus/utility/timer.hpp>
 
 #include <unistd.h>
+
+#include <array>
+#include <bitset>
 #include <map>
+#include <optional>
+#include <set>
+#include <span>
+#include <unordered_map>
+#include <vector>
 
 namespace pldm
 {
@@ -25,7 +44,6 @@ namespace terminus
 using namespace pldm::dbus_api;
 using namespace pldm::sensor;
 
-using BitField8 = bitfield8_t;
 using EntityType = uint16_t;
 using Length8bs = uint8_t;
 using BaseUnit = uint8_t;
@@ -36,14 +54,6 @@ using Name = std::string;
 
 using PDRList = std::vector<std::vector<uint8_t>>;
 
-/** @struct PLDMSupportedCommands
- *  @brief PLDM supported commands
- */
-struct PLDMSupportedCommands
-{
-    BitField8 cmdTypes[32];
-};
-
 /** @struct PldmDeviceInfo
  *  @brief PLDM terminus info
  *  @details Include EID, TID, supported PLDM types, supported PLDM commands of
@@ -53,8 +63,12 @@ struct PldmDeviceInfo
 {
     uint8_t eid;
     uint8_t tid;
-    BitField8 supportedTypes[8];
-    PLDMSupportedCommands supportedCmds[PLDM_MAX_TYPES];
+    /** @brief Bit N is set when the terminus supports PLDM type N */
+    std::bitset<64> supportedTypes;
+    /** @brief Bit N of a type is set when the terminus supports its command
+     *  N
+     */
+    std::array<std::bitset<256>, PLDM_MAX_TYPES> supportedCmds;
 };
 
 /** @struct PldmSensorInfo
@@ -86,6 +100,19 @@ struct PldmSensorInfo
     Name sensorName;
 };
 
+/** @struct SensorPollingTiers
+ *  @brief Polling interval of the sensors in number of sensor polling rounds
+ *  and the publish filters of the sensors, configured by the sensor name or
+ *  by the entity type of the sensor
+ */
+struct SensorPollingTiers
+{
+    std::map<std::string, uint16_t> sensorNames;
+    std::map<EntityType, uint16_t> entityTypes;
+    std::map<std::string, SensorPublishFilter> nameFilters;
+    std::map<EntityType, SensorPublishFilter> entityFilters;
+};
+
 /** @class TerminusHandler
  *  @brief This class can fetch and process PDRs from host firmware
  *  @details Provides an API to fetch PDRs from the host firmware. Upon
@@ -103,6 +130,20 @@ class TerminusHandler
     using TLPDRMap = std::map<pdr::TerminusHandle, TerminusInfo>;
     using PDRList = std::vector<std::vector<uint8_t>>;
 
+    /** @struct TerminusPDR
+     *  @brief A PDR of the terminus, its bytes are kept by BMC's PDR repo
+     *  and the PDR segment of the terminus
+     */
+    struct TerminusPDR
+    {
+        uint32_t recordHandle;    //!< Record handle in the terminus repo
+        uint32_t bmcRecordHandle; //!< Record handle in BMC's PDR repo
+    };
+    using TerminusPDRs = std::vector<TerminusPDR>;
+    /** @brief PDR bytes in the PDR segment of the terminus, valid until
+     *  the records are removed from BMC's PDR repo */
+    using PDRViews = std::vector<std::span<const uint8_t>>;
+
     /** @brief Constructor
      *  @param[in] eid - MCTP EID of host firmware
      *  @param[in] event - reference of main event loop of pldmd
@@ -147,6 +188,43 @@ class TerminusHandler
         return true;
     }
 
+    /** @brief Update the polling rate tiers of the terminus sensors
+     *
+     *  @param[in] tiers - polling interval of the sensors in rounds
+     *
+     *  @return - none
+     *
+     */
+    void updatePollingTiers(const SensorPollingTiers& tiers)
+    {
+        pollingTiers = tiers;
+    }
+
+    /** @brief Give the terminus the phase of its periodic polls, the
+     *         running polls move to it at once
+     *
+     *  @param[in] lease - slot of the terminus in the global poll phases
+     */
+    void setPollPhase(PollPhases::Lease&& lease);
+
+    /** @brief Switch the sensor and RAS polling cadence of the terminus
+     *
+     *  @details The running polling adopts the new intervals at once, a
+     *  polling stopped, e.g. during an impactless update, uses them when it
+     *  restarts.
+     *
+     *  @param[in] settings - cadence of the polling profile
+     */
+    void applyPollingProfile(const PollingProfileSettings& settings);
+
+    /** @brief Find a sensor of the terminus by its D-Bus path
+     *
+     *  @param[in] path - object path of the sensor
+     *
+     *  @return - the sensor, nullptr if the terminus has no such sensor
+     */
+    PldmSensor* findSensor(std::string_view path) const;
+
     /** @brief Discovery new terminus
      *
      * @return - none
@@ -180,6 +258,33 @@ class TerminusHandler
      */
     void stopTerminusHandler();
 
+    /** @brief Token of the tasks of the terminus, cancelled when the
+     *  terminus handler is stopped
+     */
+    requester::CancellationToken getStopToken() const
+    {
+        return stopSource.token();
+    }
+
+    /** @brief The MCTP endpoint of the terminus was removed, pause the
+     *  sensor and event polling until it is added back or removed for good
+     */
+    void suspendTerminusHandler();
+
+    /** @brief The MCTP endpoint of the suspended terminus is added back,
+     *  resume the polling if its PDR repository did not change
+     *
+     *  @return - PLDM_SUCCESS if the polling resumed, an error if the
+     *  terminus must be rediscovered
+     */
+    requester::Coroutine resumeTerminusHandler();
+
+    /** @brief The discovery of the terminus finished */
+    bool isDiscovered() const
+    {
+        return eventDataHndl != nullptr;
+    }
+
     /** @brief Add received event message to terminus handler
      *
      *  @param[in] tid - Terminus ID
@@ -193,10 +298,48 @@ class TerminusHandler
     void addEventMsg(uint8_t tid, uint8_t eventId, uint8_t eventType,
                      uint8_t eventClass);
 
+    /** @brief Note a heartbeat, an event or a response of the terminus
+     *
+     *  @details Once the BMC is the event receiver of the terminus, the
+     *  terminus is declared down when nothing is heard of it for
+     *  terminus-heartbeat-misses heartbeat intervals.
+     *
+     *  @return - none
+     *
+     */
+    void refreshLiveness();
+
+    /** @brief Update the sensor value from a numeric sensor event
+     *
+     *  @param[in] sensorId - sensor ID of the event
+     *  @param[in] sensorDataSize - size of the present reading
+     *  @param[in] presentReading - present reading of the event
+     *
+     *  @return - true if the sensor belongs to the terminus
+     *
+     */
+    bool updateSensorFromEvent(uint16_t sensorId, uint8_t sensorDataSize,
+                               uint32_t presentReading);
+
+    /** @brief Apply the change records of a PDR repository change event
+     *  @details Only the changed PDRs are fetched, and only the sensor and
+     *  effecter D-Bus objects of the changed PDRs are removed or created.
+     *  The changes are applied from the event loop after the event is
+     *  responded.
+     *
+     *  @param[in] removedHandles - record handles of the deleted and
+     *  modified PDRs
+     *  @param[in] fetchedHandles - record handles of the added and modified
+     *  PDRs
+     *
+     *  @return - none
+     */
+    void updatePDRs(std::vector<uint32_t> removedHandles,
+                    std::vector<uint32_t> fetchedHandles);
+
     /** @brief Enter quiesce mode after polling all remaining RAS events
      *  @details Stop hang detection service, sensor and event polling
-     *  after finishing polling the remaining RAS events. First, start
-     *  a timer to wait for RAS polling completion.
+     *  as soon as the remaining RAS events are polled.
      *
      *  @param - none
      *
@@ -225,21 +368,82 @@ class TerminusHandler
         return devInfo.tid;
     }
 
-    void notifyFWUpdateFailure()
+    /** @brief whether terminus support PLDM command type, as reported by
+     *  GetPLDMTypes
+     */
+    bool supportPLDMType(const uint8_t pldmType) const
+    {
+        return pldmType < devInfo.supportedTypes.size() &&
+               devInfo.supportedTypes[pldmType];
+    }
+
+    /** @brief whether terminus support PLDM command of a PLDM type, as
+     *  reported by GetPLDMCommands
+     */
+    bool supportPLDMCommand(const uint8_t type, const uint8_t command) const
     {
-        fwUpdateFailed = true;
+        return supportPLDMType(type) && type < devInfo.supportedCmds.size() &&
+               devInfo.supportedCmds[type][command];
     }
 
+    /** @brief The MPro reported that the impactless update failed, the
+     *  operation resumes if FW_BOOT_OK did not deassert
+     */
+    void notifyFWUpdateFailure();
+
+    /** @brief The MCTP discovery announced the endpoint of the terminus
+     *
+     *  @return - true if the terminus was waiting for the MCTP interface of
+     *  its recovering MPro
+     */
+    bool mctpEndpointAdded();
+
   private:
-    using mapped_type = std::tuple<uint16_t, ObjectInfo>;
+    /* sensor/effecter ID, the D-Bus interfaces are owned by the PldmSensor */
+    using mapped_type = uint16_t;
     /* sensor_key tuple of eid, sensorId, pdr_type */
     using sensor_key = std::tuple<uint8_t, uint16_t, uint8_t>;
     using SensorState = std::map<sensor_key, mapped_type>;
 
+    /** @struct SensorTable
+     *  @brief Sensors of the terminus by row
+     *
+     *  @details The polling round addresses a sensor by its row, the fields
+     *  it reads for every reading are stored column by column instead of
+     *  being looked up by key in the maps. The rows are rebuilt in the
+     *  _sensorObjects order by updateSensorKeys when sensors are added, the
+     *  row of a removed sensor is taken by the last row.
+     */
+    struct SensorTable
+    {
+        std::vector<sensor_key> keys;
+        std::vector<uint16_t> sensorIds;
+        std::vector<uint8_t> pdrTypes;
+        /** @brief Polling interval of the sensor in number of rounds */
+        std::vector<uint16_t> pollRounds;
+        /** @brief Entry of the sensor in the snapshot, npos if none */
+        std::vector<size_t> snapshotSlots;
+        /** @brief D-Bus objects of the sensors, owned by _sensorObjects */
+        std::vector<PldmSensor*> objects;
+
+        static constexpr size_t npos = static_cast<size_t>(-1);
+        /** @brief Memory used by the columns of one row */
+        static constexpr size_t rowBytes =
+            sizeof(sensor_key) + sizeof(uint16_t) + sizeof(uint8_t) +
+            sizeof(uint16_t) + sizeof(size_t) + sizeof(PldmSensor*);
+
+        size_t size() const
+        {
+            return keys.size();
+        }
+    };
+
     /* aux_name_key is pair of handler and sensorId */
     using auxNameKey = std::tuple<uint16_t, uint16_t>;
-    /* names list of one state/effecter sensor */
-    using auxNameList = std::vector<std::tuple<std::string, std::string>>;
+    /* names list of one state/effecter sensor, language tag and name in
+     * auxNamePool */
+    using auxNameList =
+        std::vector<std::tuple<std::string_view, std::string_view>>;
     /* sensor name index map to names list*/
     using auxNameSensorMapping = std::vector<auxNameList>;
     /* auxNameKey to sensor auxNameList */
@@ -259,13 +463,10 @@ class TerminusHandler
     requester::Coroutine getPLDMCommands();
     requester::Coroutine getPLDMCommand(const uint8_t& pldmTypeIdx);
 
-    /** @brief whether terminus support PLDM command type
-     */
-    bool supportPLDMType(const uint8_t pldmType);
-
-    /** @brief whether terminus support PLDM command of a PLDM type
+    /** @brief Negotiate the part size of the multipart transfers with the
+     *  terminus, kept in the TransferSizes of its EID
      */
-    bool supportPLDMCommand(const uint8_t type, const uint8_t command);
+    requester::Coroutine negotiateTransferParameters();
 
     /** @brief Get current system time in milliseconds
      */
@@ -279,14 +480,67 @@ class TerminusHandler
      */
     requester::Coroutine setDateTime();
 
+    /** @brief Get the FRU record table, from the cache when its checksum
+     *  did not change
+     */
+    requester::Coroutine discoverFRU();
+
+    /** @brief Get the PDRs, from the cache when the repository signature did
+     *  not change, and create the sensor and effecter D-Bus objects
+     */
+    requester::Coroutine discoverPDRs();
+
+    /** @brief Create the sensor D-Bus objects of the compact numeric sensor
+     *  PDRs received so far
+     *  @details The sensors are polled as soon as they are created. Before
+     *  the last PDR, a sensor named after the TID of a terminus locator PDR
+     *  not received yet waits for the next call.
+     *  @param[in] done - true once all the PDRs are received
+     */
+    void createDiscoveredSensors(bool done);
+
     /** @brief Get FRU Record Table from remote MCTP Endpoint
+     *  @details The table is read in as many parts as the terminus sends,
+     *  the records are parsed as soon as their part arrives.
      *  @param[in] total - Total number of record in table
      */
     requester::Coroutine getFRURecordTable(const uint16_t& total);
 
     /** @brief Get FRU Record Table Metadata from remote MCTP Endpoint
+     *  @param[out] total - Total number of record in table
+     *  @param[out] checksum - Checksum of the FRU record table
+     */
+    requester::Coroutine getFRURecordTableMetadata(uint16_t* total,
+                                                   uint32_t* checksum);
+
+    /** @brief Get the signature of the terminus PDR repository from
+     *  GetPDRRepositoryInfo
+     *  @details The signature is built from the update times, the record
+     *  count and the repository sizes. It is empty when the repository is not
+     *  available or the terminus does not report the update times. The
+     *  record count and the repository size are kept in pdrCapacity.
+     *  @param[out] signature - signature of the PDR repository
+     */
+    requester::Coroutine getPDRRepositoryInfo(std::vector<uint8_t>& signature);
+
+    /** @brief Reserve the PDR lists, the PDR segment and the PDR cache of the
+     *  terminus for the records reported by GetPDRRepositoryInfo, so they
+     *  are not grown PDR by PDR during the discovery
      */
-    requester::Coroutine getFRURecordTableMetadata(uint16_t* total);
+    void reservePDRCapacity();
+
+    /** @brief Load the PDRs and FRU table of the terminus from the cache file
+     *
+     *  @return - none
+     */
+    void loadTerminusCache();
+
+    /** @brief Save the PDRs and FRU table collected during the discovery to
+     *  the cache file
+     *
+     *  @return - none
+     */
+    void saveTerminusCache();
 
     /** @brief Parse record data from FRU table
      *  @param[in] fruData - pointer to FRU record table
@@ -294,6 +548,27 @@ class TerminusHandler
      */
     void parseFruRecordTable(const uint8_t* fruData, size_t& fruLen);
 
+    /** @brief Get the FRU D-Bus object of the terminus
+     *  @details A new object is only announced on D-Bus by
+     *  emit_object_added() once its fields are set, an existing one is
+     *  reused so only the changed fields are signalled.
+     *  @param[out] created - true if the object is new
+     *
+     *  @return - the FRU object, nullptr if the terminus has no TID
+     */
+    std::shared_ptr<pldm::dbus_api::FruReq> getFruObject(bool& created);
+
+    /** @brief Parse the complete records at the start of FRU table data
+     *  @param[in] fruData - pointer to FRU record table data
+     *  @param[in] fruLen - length of the data
+     *  @param[in] fru - FRU object to update with the record fields
+     *
+     *  @return - length of the parsed records, the rest is an incomplete
+     *  record or the pad bytes and checksum
+     */
+    size_t parseFruRecords(const uint8_t* fruData, size_t fruLen,
+                           pldm::dbus_api::FruReq& fru);
+
     /** @brief this function sends a GetPDR request to Host firmware.
      *  And processes the PDRs based on type
      *
@@ -316,16 +591,95 @@ class TerminusHandler
      */
     bool getParent(const EntityType& type, pldm_entity* parent);
 
-    /** @brief process the Host's PDR and add to BMC's PDR repo
-     *  @param[in] eid - MCTP id of Host
-     *  @param[in] response - response from Host for GetPDR
-     *  @param[in] respMsgLen - response message length
+    /** @brief Key of an entity in entityNodes
+     *  @param[in] entity - PLDM entity
+     *  @return - entity type, instance number and container ID packed
      */
-    requester::Coroutine processDevPDRs(mctp_eid_t& eid,
-                                        const pldm_msg* response,
-                                        size_t& respMsgLen,
-                                        uint32_t* nextRecordHandle,
-                                        uint32_t recordHandle);
+    static uint64_t entityNodeKey(const pldm_entity& entity)
+    {
+        return (static_cast<uint64_t>(entity.entity_type) << 32) |
+               (static_cast<uint64_t>(entity.entity_instance_num) << 16) |
+               entity.entity_container_id;
+    }
+
+    /** @brief Find the node of an entity in the entity association tree
+     *  @param[in] entity - PLDM entity
+     *  @return - node of the entity, nullptr if it is not in the tree
+     */
+    pldm_entity_node* findEntityNode(pldm_entity entity);
+
+    /** @brief process the terminus PDR and add to BMC's PDR repo
+     *  @param[in] pdr - PDR data reassembled from the GetPDR responses
+     *  @param[in] nextRecordHandle - record handle of the next PDR
+     *  @return - PLDM completion code
+     */
+    int processDevPDRs(const std::vector<uint8_t>& pdr,
+                       uint32_t nextRecordHandle);
+
+    /** @brief Get one PDR of the terminus and process it
+     *  @param[in] recordHandle - record handle of the PDR, 0 for the first
+     *  @param[out] nextRecordHandle - record handle of the next PDR
+     */
+    requester::Coroutine getPDRRecord(uint32_t recordHandle,
+                                      uint32_t* nextRecordHandle);
+
+    /** @brief Get one PDR of the terminus without processing it
+     *  @param[in] recordHandle - record handle of the PDR, 0 for the first
+     *  @param[out] pdr - PDR data reassembled from the GetPDR responses
+     *  @param[out] nextRecordHandle - record handle of the next PDR
+     */
+    requester::Coroutine fetchPDRRecord(uint32_t recordHandle,
+                                        std::vector<uint8_t>& pdr,
+                                        uint32_t* nextRecordHandle);
+
+    /** @brief Get the PDRs of the record handles known from the cache
+     *  concurrently and process them once the set is verified unchanged
+     *  @param[in] cachedPDRs - PDRs of the terminus cache
+     *  @return - PLDM_SUCCESS, else nothing is processed and the PDRs are
+     *            swept by getDevPDR
+     */
+    requester::Coroutine getKnownPDRs(
+        const std::vector<std::pair<uint32_t, std::vector<uint8_t>>>&
+            cachedPDRs);
+
+    /** @brief Apply the pending PDR changes of updatePDRs */
+    requester::Coroutine applyPDRChanges();
+
+    /** @brief Remove the PDRs of the terminus and their sensor and effecter
+     *  D-Bus objects
+     *  @param[in] handles - terminus record handles of the PDRs
+     *  @param[out] renamedEffecterPDRs - PDRs of the effecters removed
+     *  because their auxiliary names PDR is removed, to create them again
+     */
+    void removeTerminusPDRs(const std::set<uint32_t>& handles,
+                            TerminusPDRs& renamedEffecterPDRs);
+
+    /** @brief Remove records from BMC's PDR repo
+     *  @param[in] bmcHandles - BMC record handles of the records
+     */
+    void removeBmcRecords(const std::set<uint32_t>& bmcHandles);
+
+    /** @brief Sort one terminus PDR by type and add it to BMC's PDR repo
+     *  @param[in] pdr - PDR data
+     *  @param[in] rh - record handle of the PDR in BMC's PDR repo
+     */
+    void processPDR(const std::vector<uint8_t>& pdr, uint32_t rh);
+
+    /** @brief Find the bytes of PDRs of the terminus in its PDR segment
+     *
+     *  @param[in] pdrs - PDRs of the terminus
+     *
+     *  @return - view of each PDR, empty if the record is not in the repo
+     */
+    PDRViews findPDRs(std::span<const TerminusPDR> pdrs) const;
+
+    /** @brief Same as findPDRs without the PDRs missing from the repo */
+    PDRViews getPDRViews(std::span<const TerminusPDR> pdrs) const
+    {
+        auto views = findPDRs(pdrs);
+        std::erase_if(views, [](const auto& view) { return view.empty(); });
+        return views;
+    }
 
     /** @brief Parse comback numeric sensor PDRs and create the sensor D-Bus
      *  objects
@@ -333,7 +687,7 @@ class TerminusHandler
      *  @param[in] effecterPDRs - device effecter PDRs
      *
      */
-    void createCompactNummericSensorIntf(const PDRList& sensorPDRs);
+    void createCompactNummericSensorIntf(const PDRViews& sensorPDRs);
 
     /** @brief Parse numeric effecter PDRs and create the effecter sensor D-Bus
      *  objects
@@ -341,7 +695,19 @@ class TerminusHandler
      *  @param[in] effecterPDRs - device effecter PDRs
      *
      */
-    void createNummericEffecterDBusIntf(const PDRList& effecterPDRs);
+    void createNummericEffecterDBusIntf(const PDRViews& effecterPDRs);
+
+    /** @brief Emit InterfacesAdded for the sensors created by one pass, in
+     *         one burst once the pass is done
+     *
+     *  @param[in] sensors - sensors created with deferred emission
+     */
+    void announceSensors(const std::vector<PldmSensor*>& sensors);
+
+    /** @brief Emit InterfacesRemoved for all the sensors of the terminus in
+     *         one burst, before they are destroyed
+     */
+    void retractSensors();
 
     /** @brief Parse aux name PDRs and populate the aux name mapping
      *         lookup data structure
@@ -349,7 +715,7 @@ class TerminusHandler
      *  @param[in] auxNamePDRs - device effecter aux name PDRs
      *
      */
-    void parseAuxNamePDRs(const PDRList& auxNamePDRs);
+    void parseAuxNamePDRs(const PDRViews& auxNamePDRs);
 
     /** @brief Start reading the sensors info process
      *
@@ -360,7 +726,8 @@ class TerminusHandler
      */
     void pollSensors();
 
-    /** @brief Start reading the sensors info process
+    /** @brief Send the GetSensorReading requests of the polling round until
+     *  the window of in-flight requests is full
      *
      *  @param - none
      *
@@ -371,25 +738,150 @@ class TerminusHandler
 
     /** @brief Send the getSensorReading request to get sensor info
      *
-     *  @param[in] sensor_id - Sensor ID
-     *  @param[in] pdr_type - PDR type
+     *  @param[in] row - row of the sensor/effecter in the sensor table
      *
-     *  @return - none
+     *  @return - true if the request is registered
      *
      */
-    void getSensorReading(uint16_t sensor_id, uint8_t pdr_type);
+    bool getSensorReading(size_t row);
 
     /** @brief Process response data from the getSensorReading request
      *
+     *  @param[in] row - row of the sensor when the request is sent
+     *  @param[in] key - sensor key of the request
+     *  @param[in] sendTime - the time the request is registered
+     *  @param[in] response - response message
+     *  @param[in] respMsgLen - response message length
+     *
+     *  @return - none
+     *
+     */
+    void processSensorReading(size_t row, sensor_key key,
+                              std::chrono::steady_clock::time_point sendTime,
+                              mctp_eid_t, const pldm_msg* response,
+                              size_t respMsgLen);
+
+    /** @brief Update the sensor from its reading
+     *
+     *  @param[in] row - row of the sensor, SensorTable::npos if it is removed
+     *  @param[in] key - sensor key
+     *  @param[in] valid - whether the reading is decoded successfully
+     *  @param[in] dataSize - sensor data size of the reading
+     *  @param[in] operationalState - operational state of the sensor
+     *  @param[in] presentReading - present reading of the sensor
+     *
+     *  @return - none
+     *
+     */
+    void applySensorReading(size_t row, const sensor_key& key, bool valid,
+                            uint8_t dataSize, uint8_t operationalState,
+                            const union_range_field_format& presentReading);
+
+    /** @brief Mark the sensor non-functional after the terminus did not
+     *  respond to its reading
+     *
+     *  @param[in] row - row of the sensor, SensorTable::npos if it is removed
+     *
+     *  @return - none
+     *
+     */
+    void setSensorNoResponse(size_t row);
+
+    /** @brief Send the OEM GetSensorReadings request reading several compact
+     *  numeric sensors
+     *
+     *  @param[in] batch - rows and keys of the sensors
+     *
+     *  @return - true if the request is registered
+     *
+     */
+    bool getSensorReadings(std::vector<std::pair<size_t, sensor_key>>&& batch);
+
+    /** @brief Process response data from the OEM GetSensorReadings request
+     *
+     *  @details The sensors are read one by one from then on when the
+     *  terminus fails the request.
+     *
+     *  @param[in] batch - rows and keys of the sensors of the request
+     *  @param[in] sendTime - the time the request is registered
+     *  @param[in] response - response message
+     *  @param[in] respMsgLen - response message length
+     *
+     *  @return - none
+     *
+     */
+    void processSensorReadings(
+        const std::vector<std::pair<size_t, sensor_key>>& batch,
+        std::chrono::steady_clock::time_point sendTime, mctp_eid_t,
+        const pldm_msg* response, size_t respMsgLen);
+
+    /** @brief Release the in-flight slot of a completed GetSensorReading and
+     *  send the next requests of the polling round
+     *
+     *  @param[in] responded - whether the terminus responded to the request
+     *  @param[in] sendTime - the time the request is registered
+     *
+     *  @return - none
+     *
+     */
+    void completeSensorReading(bool responded,
+                               std::chrono::steady_clock::time_point sendTime);
+
+    /** @brief Pause the sensor polling once the terminus stopped responding
+     *
+     *  @details All the sensors are marked non-functional in one batch and
+     *  the terminus is probed with GetTID until it responds.
+     *
+     *  @return - none
+     *
+     */
+    void openSensorCircuit();
+
+    /** @brief Send one GetTID probe while the sensor polling is paused
+     *
+     *  @return - none
+     *
+     */
+    void probeTerminus();
+
+    /** @brief Resume the sensor polling once the probe is answered
+     *
+     *  @param[in] eid - Remote MCTP endpoint
      *  @param[in] response - response message
      *  @param[in] respMsgLen - response message length
      *
      *  @return - none
      *
      */
-    void processSensorReading(mctp_eid_t, const pldm_msg* response,
+    void processProbeResponse(mctp_eid_t eid, const pldm_msg* response,
                               size_t respMsgLen);
 
+    /** @brief Declare the terminus down once it missed its heartbeats
+     *
+     *  @details The sensor circuit breaker is opened, so the sensors are
+     *  marked non-functional and the terminus is probed until it responds.
+     *
+     *  @return - none
+     *
+     */
+    void livenessExpired();
+
+    /** @brief Adapt the window of in-flight GetSensorReading requests
+     *
+     *  @details The window grows by one for each window of responses which
+     *  are not slower than twice of the average response time, and is halved
+     *  when the terminus does not respond.
+     *
+     *  @param[in] responded - whether the terminus responded to the request
+     *  @param[in] responseTime - measured response time of the request
+     *
+     *  @return - none
+     *
+     */
+    void updateSensorPollWindow(bool responded,
+                                std::chrono::steady_clock::duration
+                                    responseTime);
+
     /** @brief Remove the sensor which response OperationState as not enabled
      *  in GetSensorReading command
      *
@@ -400,11 +892,13 @@ class TerminusHandler
      */
     void removeUnavailableSensor(const std::vector<sensor_key>& vKeys);
 
-    /** @brief Remove the effecter from polling list after first reading
+    /** @brief Remove the effecter from polling list once its value settled
      *
      *  @details Because the effecter is not changed after power on the
      *  terminus. It can only changed by user thru updating the value property
-     *  of effecter D-Bus interface. This actions is covered in those PLDM code 
+     *  of effecter D-Bus interface, setNumericEffecterValue writes the value
+     *  through to the effecter object. An effecter reporting
+     *  EFFECTER_OPER_STATE_ENABLED_UPDATEPENDING is polled until it settles.
      *
      *  @param[in] vKeys - List of sensor keys
      *
@@ -413,7 +907,93 @@ class TerminusHandler
      */
     void removeEffecterFromPollingList(const std::vector<sensor_key>& vKeys);
 
-    /** @brief Create/Update list of sensor keys which will be polling
+    /** @brief Remove a row of the sensor table, the last row moves into it
+     *
+     *  @details The poll set, the row index and the rows of the current
+     *  polling round follow the moved row. The sensor object is still owned
+     *  by _sensorObjects.
+     *
+     *  @param[in] row - row of the sensor in the sensor table
+     *
+     *  @return - none
+     *
+     */
+    void removeSensorRow(size_t row);
+
+    /** @brief Get the polling interval of a sensor from the polling tiers
+     *
+     *  @param[in] sensorName - D-Bus name of the sensor
+     *  @param[in] pdrName - sensor name in the PDR
+     *  @param[in] entityType - entity type of the sensor
+     *
+     *  @return - polling interval in number of rounds
+     *
+     */
+    uint16_t getSensorPollRounds(const std::string& sensorName,
+                                 const std::string& pdrName,
+                                 EntityType entityType);
+
+    /** @brief Check whether the sensor has to be read in this polling round
+     *
+     *  @param[in] row - row of the sensor in the sensor table
+     *
+     *  @return - true if the reading of the sensor is due
+     *
+     */
+    bool isSensorPollDue(size_t row);
+
+    /** @brief Get the current row of a sensor
+     *
+     *  @param[in] row - row of the sensor when it was last looked up
+     *  @param[in] key - sensor key
+     *
+     *  @return - row of the sensor, SensorTable::npos if it is removed
+     *
+     */
+    size_t getSensorRow(size_t row, const sensor_key& key) const;
+
+    /** @brief Get the configured publish filter of the sensor
+     *
+     *  @param[in] sensorName - D-Bus name of the sensor
+     *  @param[in] pdrName - sensor name from the PDR or the aux name
+     *  @param[in] entityType - entity type of the sensor
+     *
+     *  @return - publish filter, no filtering when not configured
+     */
+    SensorPublishFilter getSensorPublishFilter(const std::string& sensorName,
+                                               const std::string& pdrName,
+                                               EntityType entityType);
+
+    /** @brief Move the sensor which reports its changes by the numeric sensor
+     *  events to the low verification rate
+     *
+     *  @param[in] row - row of the sensor in the sensor table
+     *  @param[in] eventMessageEnable - event message enable of the sensor
+     *
+     *  @return - none
+     *
+     */
+    void updateEventDrivenSensor(size_t row, uint8_t eventMessageEnable);
+
+    /** @brief Create the memory-mapped snapshot of the terminus sensors in
+     *  the _sensorObjects order
+     *
+     *  @return - none
+     *
+     */
+    void createSensorSnapshot();
+
+    /** @brief Write the current value of the sensor to the snapshot
+     *
+     *  @param[in] row - row of the sensor in the sensor table
+     *
+     *  @return - none
+     *
+     */
+    void updateSensorSnapshot(size_t row);
+
+    /** @brief Rebuild the sensor table and the list of sensors which will be
+     *  polling
      *
      *  @param[in] none
      *
@@ -423,18 +1003,37 @@ class TerminusHandler
     void updateSensorKeys();
 
     /** @brief Start waiting for MPro recovery from impactless update.
-    *
-    *   @details MPro's state is read by executing ampere_request_mpro_state script.
-    *   If FW_BOOT_OK asserts within 60s, wait for MCTP interface. If MCTP interface
-    *   from MPro is ready within 60s, restart sensor and event polling and hang
-    *   detection service. Otherwise, do nothing.
-    *
-    *   @param[in] none
-    *
-    *   @return - none
-    */
+     *
+     *  @details The edges of the FW_BOOT_OK GPIO of the MPro are watched on
+     *  the event loop. Once FW_BOOT_OK deasserts then asserts again, the
+     *  MCTP interface is ready when the MCTP discovery announces the
+     *  endpoint or when the terminus answers GetTID. Sensor and event
+     *  polling then restart. Each of the two waits times out after
+     *  IMPACTLESS_UPDATE_MPRO_RECOVERY_TIMEOUT_MS.
+     */
     void waitForMProRecovery();
 
+    /** @brief Handle an edge of FW_BOOT_OK during the MPro recovery
+     *
+     *  @param[in] asserted - new state of FW_BOOT_OK
+     */
+    void fwBootOkChanged(bool asserted);
+
+    /** @brief Probe the MCTP interface of the recovering MPro with GetTID,
+     *  the next probe is sent once the previous one completes
+     */
+    void probeMctpInterface();
+
+    /** @brief Handle the response of the MCTP interface probe */
+    void processMctpProbeResponse(mctp_eid_t eid, const pldm_msg* response,
+                                  size_t respMsgLen);
+
+    /** @brief The MPro recovered, restart the polling */
+    void mProRecovered();
+
+    /** @brief The MPro did not recover in time */
+    void mProRecoveryTimeout();
+
     /** @brief Wait to retrieve normal operation after impactless update.
      *
      *  @details Acknowledge impactless firmware update to MPro by
@@ -448,16 +1047,17 @@ class TerminusHandler
      */
     requester::Coroutine waitForImpactlessUpdateRecovery();
 
-    /** @brief Start waiting for RAS polling completion:
+    /** @brief Wait for the RAS queues to drain, then:
      *  1. Stop sensor polling
      *  2. Stop event polling
      *  3. Write to MC Control Effecter (effecterId = 254) to acknowledge host firmware update
      *
-     *  @param[in] none
+     *  @details The quiesce fails when the queues are not drained within
+     *  IMPACTLESS_UPDATE_FINISH_RAS_TIMEOUT_MS.
      *
-     *  @return - none
+     *  @return - PLDM_SUCCESS, PLDM_ERROR when the quiesce failed
      */
-    void waitForRASPollingFinished();
+    requester::Coroutine enterQuiesceMode();
 
     /** @brief Set Numeric Effecter Value
      *
@@ -525,66 +1125,188 @@ class TerminusHandler
     /** @brief maps an entity type to parent pldm_entity from the BMC's entity
      *  association tree
      */
-    std::map<EntityType, pldm_entity> parents;
+    std::unordered_map<EntityType, pldm_entity> parents;
+
+    /** @brief Nodes of the entity association tree found or added by the
+     *  merges of this discovery, by entityNodeKey(). The nodes live as long
+     *  as the tree, both are reset with the terminus
+     */
+    std::unordered_map<uint64_t, pldm_entity_node*> entityNodes;
 
     /** @brief List of compack numeric sensor PDRs */
-    PDRList compNumSensorPDRs{};
+    TerminusPDRs compNumSensorPDRs{};
     /** @brief List of numeric effecter AUX Name PDRs */
-    PDRList effecterAuxNamePDRs{};
+    TerminusPDRs effecterAuxNamePDRs{};
     /** @brief List of numeric effecter PDRs */
-    PDRList effecterPDRs{};
+    TerminusPDRs effecterPDRs{};
 
     /** @brief Terminus handle */
     uint16_t terminusHandle = 0;
     /** @brief List of mapping form effecter key to effecter name */
     auxNameMapping _auxNameMaps;
+    /** @brief Language tags and names of _auxNameMaps */
+    StringPool auxNamePool;
     /** @brief DBus object state. */
     SensorState _state;
 
+    /** @brief Last readings of the sensors, outlives _sensorObjects which
+     *  record in it, nullptr if SENSOR_HISTORY_DEPTH is 0
+     */
+    std::unique_ptr<SensorHistory> sensorHistory;
     /** @brief Store the specifications of sensor objects */
     std::map<sensor_key, std::unique_ptr<PldmSensor>> _sensorObjects;
     /** @brief List of numeric effecter keys */
     std::vector<sensor_key> _effecterLists;
     /** @brief Identify the D-Bus interface for the sensors is created */
     bool createdDbusObject = false;
-    /* The point to the reading sensors */
-    std::vector<sensor_key>::iterator sensorKey;
-    std::vector<sensor_key> sensorKeys;
+    /** @brief Sensors created while the discovery gets the PDRs */
+    std::set<uint16_t> discoveredSensorIds;
+    /** @brief Sensors of the terminus by row */
+    SensorTable sensorTable;
+    /** @brief Row of the sensors in the sensor table, by sensor key */
+    std::map<sensor_key, size_t> sensorRows;
+    /* Index of the next sensor to be read in the polling round */
+    size_t nextSensorIdx = 0;
+    /** @brief Rows of the sensors which are polled, a row is enabled or
+     *  disabled in O(1) even during a polling round
+     */
+    ActiveSet pollRows;
+    /** @brief Rows of the sensors which are due in the current polling
+     *  round
+     */
+    std::vector<size_t> roundSensorRows;
+    /** @brief Polling rate tiers of the terminus sensors */
+    SensorPollingTiers pollingTiers;
+
+    /** @brief Sensor and RAS polling cadence of the current profile */
+    PollingProfileSettings pollingProfile;
+    /** @brief Slot of the terminus in the global poll phases, it sets when
+     *  the sensor rounds and the RAS polls fire in their interval and which
+     *  rounds read the slower tiers
+     */
+    PollPhases::Lease pollPhase;
+    /** @brief Polling interval of the sensors in number of rounds, the
+     *  sensors which are not in the map are polled every round. The table
+     *  copies it in its pollRounds column.
+     */
+    std::map<sensor_key, uint16_t> sensorPollRounds;
+    /** @brief Sensors updated from the numeric sensor events, mapped to their
+     *  configured polling interval in rounds
+     */
+    std::map<sensor_key, uint16_t> eventDrivenSensors;
+    /** @brief Memory-mapped snapshot of the sensor values */
+    std::unique_ptr<SensorSnapshot> sensorSnapshot;
+    /** @brief BMC record handle of the terminus PDRs added to BMC's PDR
+     *  repo, by terminus record handle
+     */
+    std::map<uint32_t, uint32_t> bmcRecordHandles;
+    /** @brief Sensor, effecter and auxiliary names PDRs of the terminus,
+     *  by their record handle in BMC's PDR repo */
+    PdrSegment pdrSegment;
+    /** @brief Record handles of the deleted and modified PDRs to apply */
+    std::vector<uint32_t> pendingRemovedHandles;
+    /** @brief Record handles of the added and modified PDRs to fetch */
+    std::vector<uint32_t> pendingFetchedHandles;
+    /** @brief applyPDRChanges is running */
+    bool updatingPDRs = false;
+    /** @brief Deferred start of applyPDRChanges */
+    std::unique_ptr<sdeventplus::source::Defer> pdrUpdateEvent;
+    /** @struct PDRCapacity
+     *  @brief Size of the terminus PDR repository from GetPDRRepositoryInfo,
+     *  zero if unknown
+     */
+    struct PDRCapacity
+    {
+        uint32_t recordCount = 0;
+        uint32_t repositorySize = 0;
+    };
+    PDRCapacity pdrCapacity{};
+    /** @brief PDRs and FRU table loaded from the terminus cache file */
+    std::optional<TerminusCache> loadedCache;
+    /** @brief PDRs and FRU table collected during the discovery */
+    TerminusCache discoveredCache;
+    /** @brief PDR repository signature of the last discovery, empty if the
+     *  terminus does not report one
+     */
+    std::vector<uint8_t> pdrSignature;
     std::vector<sensor_key> unavailableSensorKeys;
+    /** @brief Number of SetNumericEffecterValue in flight by effecter, the
+     *  readings of those effecters are dropped
+     */
+    std::map<sensor_key, uint8_t> pendingEffecterWrites;
     /** @brief Poll sensor timer. Reset after each poll-sensor-timer-interval
      *  milliseconds. poll-sensor-timer-interval is package configuration.
      */
     sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> _timer;
 
-    /** @brief Sleep timer between PLDM GetSensorReading commands.
-     *  @details Because the performance and the responding time for
-     *  GetSensorReading of terminus can be different. The sleep interval
-     *  between GetSensorReading commands will be added. This value can be
-     *  configured thru sleep-between-get-sensor-reading option. The option is
-     *  milliseconds. The default value is 10 milliseconds
+    /** @brief Back-off timer of the sensor polling.
+     *  @details When the terminus does not respond to GetSensorReading, the
+     *  polling window is halved and the remaining requests of the round are
+     *  sent after sleep-between-get-sensor-reading milliseconds. The default
+     *  value is 10 milliseconds
      */
     sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> _timer2;
 
-    /** @brief Timer to wait for all RAS polling completion in impactless
-     *  update quiesce mode.
-     */
-    sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> _timer3;
-
     /** @brief Timer to wait for MPro recovery after impactless update.
      */
     sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> _timer4;
+
+    /** @brief Timer to probe the terminus while the sensor polling is
+     *  paused by the circuit breaker
+     */
+    sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> _probeTimer;
+    /** @brief Opens after consecutive GetSensorReading timeouts */
+    CircuitBreaker sensorBreaker{SENSOR_CIRCUIT_BREAKER_THRESHOLD};
+    /** @brief A GetTID probe is waiting for its response */
+    bool probeInFlight = false;
+    /** @brief Expires when the terminus missed its heartbeats */
+    sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>
+        _livenessTimer;
+    /** @brief The terminus accepted the BMC as its event receiver with
+     *  heartbeats
+     */
+    bool heartbeatExpected = false;
+    /** @brief Last heartbeat, event or response of the terminus */
+    std::chrono::steady_clock::time_point lastHeard{};
+    /** @brief Silence after which the terminus is declared down */
+    static constexpr std::chrono::seconds livenessWindow{
+        TERMINUS_HEARTBEAT_INTERVAL * TERMINUS_HEARTBEAT_MISSES};
+    /** @brief FW_BOOT_OK of the MPro, watched during its recovery */
+    std::unique_ptr<pldm::GpioMonitor> fwBootOkMonitor;
+    /** @brief A GetTID probe of the recovering MPro is in flight */
+    bool mctpProbeInFlight = false;
     /** @brief Polling sensor flag. True when pldmd is polling sensor values */
     bool pollingSensors = false;
     /** @brief Enable the measurement in polling sensors */
     bool debugPollSensor = true;
-    /** @brief whether response received for getsensorreading pldm command  */
-    bool sendingPldmCommand = false;
+    /** @brief Start of the current sensor polling round */
+    std::chrono::steady_clock::time_point pollRoundStart{};
+    /** @brief Exported durations of the sensor polling rounds */
+    pldm::metrics::Histogram* pollRoundHistogram = nullptr;
+    /** @brief Exported memory used by the terminus sensors */
+    pldm::metrics::Gauge* sensorMemoryGauge = nullptr;
+    /** @brief Age of the sensor readings when they are replaced */
+    pldm::metrics::Histogram* stalenessHistogram = nullptr;
+    /** @brief Number of GetSensorReading requests waiting for response */
+    uint8_t sensorReadingsInFlight = 0;
+    /** @brief Window of GetSensorReading requests in flight, adapted to the
+     *  measured response time between 1 and max-sensor-readings-in-flight
+     */
+    uint8_t sensorPollWindow = 1;
+    /** @brief Fast responses counted towards growing the window */
+    uint8_t windowIncreaseCredit = 0;
+    /** @brief Smoothed response time of GetSensorReading */
+    std::chrono::microseconds avgResponseTime{0};
+    /** @brief The terminus supports the OEM GetSensorReadings command */
+    bool batchSensorReads = false;
+    /** @brief Back off the polling after the terminus did not respond */
+    bool sensorPollBackOff = false;
     bool continuePollSensor = false;
     std::shared_ptr<PldmMessagePollEvent> eventDataHndl;
     /** @brief the flag to stop polling or discoverying */
     bool stopTerminusPolling = false;
-    /** @brief counter to wait for RAS polling completion */
-    uint16_t countNum = 0;
+    /** @brief Cancelled by stopTerminusHandler */
+    requester::CancellationSource stopSource;
     /** @brief Flag to indicate Impactless Update Failure */
     bool fwUpdateFailed = false;
 
@@ -2,16 +2,29 @@
 
 #include "pldmd/dbus_impl_requester.hpp"
 #include "common/instance_id.hpp"
+#include "requester/event_shard.hpp"
 #include "requester/handler.hpp"
+#include "requester/polling_profile.hpp"
 #include "requester/request.hpp"
 #include "requester/terminus_handler.hpp"
+#include "requester/tuning.hpp"
 
 #include <nlohmann/json.hpp>
+#include <sdbusplus/bus/match.hpp>
 #include <sdeventplus/event.hpp>
+#include <sdeventplus/utility/timer.hpp>
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <deque>
 #include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <map>
+#include <optional>
+#include <string>
+#include <string_view>
 #include <vector>
 
 namespace pldm
@@ -53,71 +66,109 @@ class Manager
         bus(bus),
         event(event), repo(repo), entityTree(entityTree),
         bmcEntityTree(bmcEntityTree), handler(handler),
-        instanceIdDb(instanceIdDb)
+        instanceIdDb(instanceIdDb),
+        graceTimer(event, std::bind(&Manager::expireDepartedDevices, this))
     {
         if (!setupEIDtoTeminusName(EID_TO_NAME_JSON))
         {
             std::cerr << "Failed to set up EID To TerminusName." << std::endl;
         }
+        if (!setupSensorPollingTiers(SENSOR_POLLING_TIERS_JSON))
+        {
+            std::cerr << "Failed to set up sensor polling tiers." << std::endl;
+        }
+        if (!setupPollingProfiles(POLLING_PROFILES_JSON))
+        {
+            std::cerr << "Failed to set up polling profiles." << std::endl;
+        }
+        tuning = std::make_unique<pldm::requester::Tuning>(
+            bus, "/xyz/openbmc_project/pldm", TUNING_PERSIST_PATH,
+            [this](uint8_t eid) { applyTuning(eid); });
+        watchHostState();
     }
 
     /** @brief Add the discovered MCTP endpoints to the managed devices list
+     *
+     *  @details An endpoint removed less than MCTP_ENDPOINT_GRACE_PERIOD_MS
+     *  ago reuses its terminus when its UUID did not change, the terminus
+     *  resumes if its PDR repository did not change either. An endpoint
+     *  already managed with the same UUID is left as is.
      *
      *  @param[in] eids - Array of MCTP endpoints
+     *  @param[in] uuids - UUID of the endpoints, empty if unknown
      *
      *  @return None
      */
-    void addDevices(const std::vector<mctp_eid_t>& eids)
+    void addDevices(const std::vector<mctp_eid_t>& eids,
+                    const std::map<mctp_eid_t, std::string>& uuids = {})
     {
         for (const auto& it : eids)
         {
-            std::cerr << "Adding terminus EID : " << unsigned(it) << std::endl;
+            auto uuidIt = uuids.find(it);
+            auto uuid = uuidIt != uuids.end() ? uuidIt->second : "";
 
-            auto dev = std::make_unique<TerminusHandler>(
-                it, event, bus, repo, entityTree, bmcEntityTree,
-                handler, instanceIdDb);
-            std::pair<bool, std::string> eidMap = std::make_pair(true, "");
-            if (eidToNameMaps.count(it))
+            auto departed = departedDevices.find(it);
+            if (departed != departedDevices.end())
             {
-                eidMap = eidToNameMaps[it];
+                auto dev = std::move(departed->second.dev);
+                auto sameUuid = departed->second.uuid == uuid;
+                departedDevices.erase(departed);
+                if (sameUuid)
+                {
+                    std::cerr << "Reattaching terminus EID : " << unsigned(it)
+                              << std::endl;
+                    applyCadence(it, *dev);
+                    mDevices[it] = std::move(dev);
+                    deviceUuids[it] = uuid;
+                    indexTerminus(it);
+                    if (!mDevices[it]->mctpEndpointAdded())
+                    {
+                        [[maybe_unused]] auto co = reattachDevice(it);
+                    }
+                    continue;
+                }
+                dev->stopTerminusHandler();
             }
-            dev->udpateEidMapping(eidMap);
-            [[maybe_unused]] auto co = dev->discoveryTerminus();
-            dev->startSensorsPolling();
-            mDevices[it] = std::move(dev);
+
+            auto existing = mDevices.find(it);
+            if (existing != mDevices.end())
+            {
+                /* The endpoint of an MPro recovering from an impactless
+                 * update is announced again once its MCTP interface is
+                 * ready */
+                if (existing->second->mctpEndpointAdded() ||
+                    deviceUuids[it] == uuid)
+                {
+                    continue;
+                }
+                existing->second->stopTerminusHandler();
+            }
+            createDevice(it, uuid);
         }
+        scheduleDiscoveries();
         return;
     }
 
     void startQuiesceMode(const uint8_t& tid)
     {
-        for (auto devIt = mDevices.begin(); devIt != mDevices.end(); ++devIt)
+        if (auto dev = findTerminus(tid))
         {
-            auto dev = devIt->second.get();
-            if (tid != dev->getTid())
-            {
-                continue;
-            }
             dev->startQuiesceMode();
-            break;
         }
     }
 
     void notifyFWUpdateFailure(const uint8_t& tid)
     {
-        for (auto devIt = mDevices.begin(); devIt != mDevices.end(); ++devIt)
+        if (auto dev = findTerminus(tid))
         {
-            auto dev = devIt->second.get();
-            if (tid != dev->getTid())
-            {
-                continue;
-            }
             dev->notifyFWUpdateFailure();
-            break;
         }
     }
 
     /** @brief Remove the MCTP devices from the managed devices list
+     *
+     *  @details The discovered termini are suspended and kept for
+     *  MCTP_ENDPOINT_GRACE_PERIOD_MS in case their endpoint comes back.
      *
      *  @param[in] eids - Array of MCTP endpoints
      *
@@ -128,28 +179,328 @@ class Manager
         for (const auto& it : eids)
         {
             std::cerr << "Removing Device EID : " << unsigned(it) << std::endl;
-            if (!mDevices.count(it))
+            auto devIt = mDevices.find(it);
+            if (devIt == mDevices.end())
             {
                 continue;
             }
-            std::unique_ptr<TerminusHandler>& dev = mDevices[it];
-            dev->stopTerminusHandler();
-            mDevices.erase(it);
+            auto dev = std::move(devIt->second);
+            mDevices.erase(devIt);
+            unindexTerminus(it);
+            pendingDiscoveries.erase(std::remove(pendingDiscoveries.begin(),
+                                                 pendingDiscoveries.end(), it),
+                                     pendingDiscoveries.end());
+            /* Release the discovery slot of the removed terminus */
+            activeDiscoveries.erase(it);
+
+            if (MCTP_ENDPOINT_GRACE_PERIOD_MS && dev->isDiscovered())
+            {
+                dev->suspendTerminusHandler();
+                departedDevices[it] = {std::move(dev), deviceUuids[it],
+                                       std::chrono::steady_clock::now()};
+            }
+            else
+            {
+                dev->stopTerminusHandler();
+            }
+            deviceUuids.erase(it);
+        }
+        if (!departedDevices.empty() && !graceTimer.isEnabled())
+        {
+            graceTimer.restartOnce(
+                std::chrono::milliseconds(MCTP_ENDPOINT_GRACE_PERIOD_MS));
         }
+        scheduleDiscoveries();
         return;
     }
 
+    /** @brief Update the terminus sensor from the numeric sensor event
+     *
+     *  @param[in] tid - Terminus ID of the event
+     *  @param[in] sensorId - sensor ID of the event
+     *  @param[in] sensorDataSize - size of the present reading
+     *  @param[in] presentReading - present reading of the event
+     *
+     *  @return - true if the sensor is found
+     */
+    bool updateSensorFromEvent(uint8_t tid, uint16_t sensorId,
+                               uint8_t sensorDataSize, uint32_t presentReading)
+    {
+        auto dev = findTerminus(tid);
+        return dev && dev->updateSensorFromEvent(sensorId, sensorDataSize,
+                                                 presentReading);
+    }
+
+    /** @brief Apply the PDR repository change event of a terminus
+     *
+     *  @param[in] tid - Terminus ID of the event
+     *  @param[in] removedHandles - record handles of the deleted and
+     *  modified PDRs
+     *  @param[in] fetchedHandles - record handles of the added and modified
+     *  PDRs
+     *
+     *  @return - true if the terminus is found
+     */
+    bool updatePDRs(uint8_t tid, const std::vector<uint32_t>& removedHandles,
+                    const std::vector<uint32_t>& fetchedHandles)
+    {
+        auto dev = findTerminus(tid);
+        if (!dev)
+        {
+            return false;
+        }
+        dev->updatePDRs(removedHandles, fetchedHandles);
+        return true;
+    }
+
+    /** @brief Note a heartbeat or an event of a terminus
+     *
+     *  @param[in] tid - Terminus ID of the event
+     *
+     *  @return - true if the terminus is found
+     */
+    bool refreshLiveness(uint8_t tid)
+    {
+        auto dev = findTerminus(tid);
+        if (!dev)
+        {
+            return false;
+        }
+        dev->refreshLiveness();
+        return true;
+    }
+
     void addEventMsg(uint8_t tid, uint8_t eventId, uint8_t eventType,
                      uint8_t eventClass)
     {
-        for (auto it = mDevices.begin(); it != mDevices.end(); ++it)
+        if (auto dev = findTerminus(tid))
         {
-            auto secondPtr = it->second.get();
-            secondPtr->addEventMsg(tid, eventId, eventType, eventClass);
+            dev->addEventMsg(tid, eventId, eventType, eventClass);
         }
     }
 
+    /** @brief Find a sensor of the managed termini by its D-Bus path
+     *
+     *  @param[in] path - object path of the sensor
+     *
+     *  @return - the sensor, nullptr if no terminus has it
+     */
+    PldmSensor* findSensor(std::string_view path) const
+    {
+        for (const auto& [eid, dev] : mDevices)
+        {
+            if (auto sensor = dev->findSensor(path))
+            {
+                return sensor;
+            }
+        }
+        return nullptr;
+    }
+
   private:
+    /** @brief Get the terminus of a TID from the TID index
+     *
+     *  @param[in] tid - Terminus ID
+     *
+     *  @return - the terminus, nullptr if no managed terminus has the TID
+     */
+    TerminusHandler* findTerminus(uint8_t tid)
+    {
+        const auto& eid = tidToEid[tid];
+        if (!eid)
+        {
+            return nullptr;
+        }
+        /* The terminus of the endpoint may be replaced and not discovered
+         * yet */
+        auto devIt = mDevices.find(*eid);
+        if (devIt == mDevices.end() || devIt->second->getTid() != tid)
+        {
+            return nullptr;
+        }
+        return devIt->second.get();
+    }
+
+    /** @brief Index the TID of a terminus, once its discovery got it
+     *
+     *  @param[in] eid - MCTP endpoint of the terminus
+     */
+    void indexTerminus(mctp_eid_t eid)
+    {
+        auto devIt = mDevices.find(eid);
+        if (devIt == mDevices.end())
+        {
+            return;
+        }
+        unindexTerminus(eid);
+        tidToEid[devIt->second->getTid()] = eid;
+    }
+
+    /** @brief Drop the TID index entry of an endpoint
+     *
+     *  @param[in] eid - MCTP endpoint of the terminus
+     */
+    void unindexTerminus(mctp_eid_t eid)
+    {
+        for (auto& entry : tidToEid)
+        {
+            if (entry == eid)
+            {
+                entry.reset();
+            }
+        }
+    }
+
+    /** @brief Create the terminus of an endpoint and queue its discovery
+     *
+     *  @param[in] eid - MCTP endpoint of the terminus
+     *  @param[in] uuid - UUID of the endpoint, empty if unknown
+     */
+    void createDevice(mctp_eid_t eid, const std::string& uuid)
+    {
+        std::cerr << "Adding terminus EID : " << unsigned(eid) << std::endl;
+
+        auto dev = std::make_unique<TerminusHandler>(
+            eid, getTerminusEvent(eid), bus, repo, entityTree, bmcEntityTree,
+            handler, instanceIdDb);
+        std::pair<bool, std::string> eidMap = std::make_pair(true, "");
+        if (eidToNameMaps.count(eid))
+        {
+            eidMap = eidToNameMaps[eid];
+        }
+        dev->udpateEidMapping(eidMap);
+        dev->updatePollingTiers(pollingTiers);
+        dev->setPollPhase(pollPhases.acquire());
+        applyCadence(eid, *dev);
+        dev->startSensorsPolling();
+        mDevices[eid] = std::move(dev);
+        /* Indexed again once the new terminus got its TID */
+        unindexTerminus(eid);
+        deviceUuids[eid] = uuid;
+        pendingDiscoveries.push_back(eid);
+    }
+
+    /** @brief Event loop of the terminus of an endpoint, its shard when
+     *         the termini run on their own event loop
+     *
+     *  @param[in] eid - MCTP endpoint of the terminus
+     */
+    sdeventplus::Event& getTerminusEvent(mctp_eid_t eid)
+    {
+        if (!TERMINUS_EVENT_BUDGET)
+        {
+            return event;
+        }
+        auto& shard = shards[eid];
+        if (!shard)
+        {
+            shard = std::make_unique<requester::EventShard>(
+                event, TERMINUS_EVENT_BUDGET);
+        }
+        return shard->get();
+    }
+
+    /** @brief Resume a reattached terminus, rediscover it if its PDR
+     *         repository changed
+     *
+     *  @param[in] eid - MCTP endpoint of the terminus
+     */
+    requester::Coroutine reattachDevice(mctp_eid_t eid)
+    {
+        auto dev = mDevices[eid].get();
+        auto rc = co_await dev->resumeTerminusHandler();
+
+        /* The terminus was removed or replaced while it was resumed */
+        auto it = mDevices.find(eid);
+        if (!rc || it == mDevices.end() || it->second.get() != dev)
+        {
+            co_return rc;
+        }
+
+        std::cerr << "Rediscovering terminus EID " << unsigned(eid)
+                  << std::endl;
+        it->second->stopTerminusHandler();
+        createDevice(eid, deviceUuids[eid]);
+        scheduleDiscoveries();
+        co_return rc;
+    }
+
+    /** @brief Drop the termini removed for longer than the grace period */
+    void expireDepartedDevices()
+    {
+        auto now = std::chrono::steady_clock::now();
+        std::chrono::milliseconds gracePeriod(MCTP_ENDPOINT_GRACE_PERIOD_MS);
+        std::optional<std::chrono::steady_clock::duration> next;
+        for (auto it = departedDevices.begin(); it != departedDevices.end();)
+        {
+            auto left = it->second.removedAt + gracePeriod - now;
+            if (left <= std::chrono::steady_clock::duration::zero())
+            {
+                std::cerr << "Dropping terminus EID : " << unsigned(it->first)
+                          << std::endl;
+                it->second.dev->stopTerminusHandler();
+                it = departedDevices.erase(it);
+                continue;
+            }
+            next = next ? std::min(*next, left) : left;
+            ++it;
+        }
+        if (next)
+        {
+            graceTimer.restartOnce(
+                std::chrono::duration_cast<std::chrono::microseconds>(*next));
+        }
+    }
+
+    /** @brief Start the discovery of the queued termini while the number of
+     *         running discoveries is below MAX_CONCURRENT_DISCOVERIES
+     */
+    void scheduleDiscoveries()
+    {
+        while (!pendingDiscoveries.empty() &&
+               activeDiscoveries.size() <
+                   static_cast<size_t>(MAX_CONCURRENT_DISCOVERIES))
+        {
+            auto eid = pendingDiscoveries.front();
+            pendingDiscoveries.pop_front();
+            if (!mDevices.count(eid))
+            {
+                continue;
+            }
+            activeDiscoveries[eid] = std::chrono::steady_clock::now();
+            [[maybe_unused]] auto co = runDiscovery(eid);
+        }
+    }
+
+    /** @brief Discover one terminus, report its discovery time and hand its
+     *         slot to the next queued terminus
+     *
+     *  @param[in] eid - MCTP endpoint of the terminus
+     */
+    requester::Coroutine runDiscovery(mctp_eid_t eid)
+    {
+        auto startTime = activeDiscoveries[eid];
+        auto rc = co_await mDevices[eid]->discoveryTerminus();
+
+        /* The terminus was removed while it was being discovered */
+        auto it = activeDiscoveries.find(eid);
+        if (it == activeDiscoveries.end() || it->second != startTime)
+        {
+            co_return rc;
+        }
+
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - startTime;
+        std::cerr << "Discovery of terminus EID " << unsigned(eid)
+                  << " finished in " << elapsed.count()
+                  << "s, rc=" << unsigned(rc) << std::endl;
+        activeDiscoveries.erase(it);
+        indexTerminus(eid);
+        scheduleDiscoveries();
+
+        co_return rc;
+    }
+
     /** @brief reference of main D-bus interface of pldmd devices */
     sdbusplus::bus::bus& bus;
 
@@ -173,13 +524,269 @@ class Manager
     /** @brief Instance ID database for managing instance ID*/
     InstanceIdDb& instanceIdDb;
 
+    /** @brief Event loops of the termini, kept for the later termini of the
+     *  same endpoint and destroyed after them
+     */
+    std::map<mctp_eid_t, std::unique_ptr<requester::EventShard>> shards;
+
+    /** @brief Phases of the polls of the termini, destroyed after them */
+    PollPhases pollPhases;
+
     std::map<mctp_eid_t, std::unique_ptr<TerminusHandler>> mDevices;
 
+    /** @brief Endpoint of the discovered termini by TID, the events of a
+     *  terminus are dispatched only to it
+     */
+    std::array<std::optional<mctp_eid_t>, 256> tidToEid{};
+
+    /** @brief UUID of the managed endpoints, empty if unknown */
+    std::map<mctp_eid_t, std::string> deviceUuids;
+
+    /** @brief Suspended terminus of a removed endpoint */
+    struct DepartedDevice
+    {
+        std::unique_ptr<TerminusHandler> dev;
+        std::string uuid;
+        std::chrono::steady_clock::time_point removedAt;
+    };
+
+    /** @brief Termini of the endpoints removed within the grace period */
+    std::map<mctp_eid_t, DepartedDevice> departedDevices;
+
+    /** @brief Timer to drop the termini at the end of the grace period */
+    sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> graceTimer;
+
+    /** @brief Termini waiting for a free discovery slot */
+    std::deque<mctp_eid_t> pendingDiscoveries;
+
+    /** @brief Termini being discovered and the start time of the discovery */
+    std::map<mctp_eid_t, std::chrono::steady_clock::time_point>
+        activeDiscoveries;
+
     /*
      * Mapping from "TIDx" in sensor name to prefix/subfix "ABCD"
      */
     std::map<uint8_t, std::pair<bool, std::string>> eidToNameMaps;
 
+    /** @brief Polling interval of the sensors in rounds */
+    SensorPollingTiers pollingTiers;
+
+    /** @brief Polling cadence of each profile */
+    PollingProfiles pollingProfiles{};
+
+    /** @brief Knobs tuned per terminus at runtime */
+    std::unique_ptr<pldm::requester::Tuning> tuning;
+
+    /** @brief Profile of the current host state */
+    PollingProfile pollingProfile = PollingProfile::Runtime;
+
+    /** @brief Last CurrentHostState and BootProgress of the host */
+    std::string hostState;
+    std::string bootProgress;
+
+    std::unique_ptr<sdbusplus::bus::match_t> hostStateMatch;
+    std::unique_ptr<sdbusplus::bus::match_t> bootProgressMatch;
+
+    /** @brief Follow the host state and switch the polling profile of the
+     *         termini when it changes
+     */
+    void watchHostState()
+    {
+        constexpr auto hostPath = "/xyz/openbmc_project/state/host0";
+        constexpr auto hostInterface = "xyz.openbmc_project.State.Host";
+        constexpr auto progressInterface =
+            "xyz.openbmc_project.State.Boot.Progress";
+
+        /* Nothing to switch to, the host state is not followed */
+        if (std::all_of(pollingProfiles.begin(), pollingProfiles.end(),
+                        [this](const auto& settings) {
+            return settings == pollingProfiles.front();
+        }))
+        {
+            return;
+        }
+
+        /* Subscribe before the read so no change is missed in between */
+        using namespace sdbusplus::bus::match::rules;
+        hostStateMatch = std::make_unique<sdbusplus::bus::match_t>(
+            bus, propertiesChanged(hostPath, hostInterface),
+            [this](sdbusplus::message_t& msg) {
+            onHostPropertiesChanged(msg, "CurrentHostState", hostState);
+        });
+        bootProgressMatch = std::make_unique<sdbusplus::bus::match_t>(
+            bus, propertiesChanged(hostPath, progressInterface),
+            [this](sdbusplus::message_t& msg) {
+            onHostPropertiesChanged(msg, "BootProgress", bootProgress);
+        });
+
+        try
+        {
+            pldm::utils::DBusHandler dbusHandler;
+            hostState = std::get<std::string>(
+                dbusHandler.getDbusPropertyVariant(
+                    hostPath, "CurrentHostState", hostInterface));
+            bootProgress = std::get<std::string>(
+                dbusHandler.getDbusPropertyVariant(hostPath, "BootProgress",
+                                                   progressInterface));
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Failed to get the host state, polling profile "
+                      << pollingProfileNames[static_cast<size_t>(
+                             pollingProfile)]
+                      << " until it changes, ERROR=" << e.what() << std::endl;
+            return;
+        }
+        updatePollingProfile();
+    }
+
+    /** @brief Record a changed host property and update the profile
+     *
+     *  @param[in] msg - PropertiesChanged signal
+     *  @param[in] property - name of the followed property
+     *  @param[out] value - last value of the property
+     */
+    void onHostPropertiesChanged(sdbusplus::message_t& msg,
+                                 const std::string& property,
+                                 std::string& value)
+    {
+        std::string iface;
+        pldm::utils::DbusChangedProps props;
+        msg.read(iface, props);
+        auto it = props.find(property);
+        if (it == props.end())
+        {
+            return;
+        }
+        if (const auto* newValue = std::get_if<std::string>(&it->second))
+        {
+            value = *newValue;
+            updatePollingProfile();
+        }
+    }
+
+    /** @brief Select the profile of the host state, apply it to the termini
+     *         when it changed
+     */
+    void updatePollingProfile()
+    {
+        auto profile = selectPollingProfile(hostState, bootProgress);
+        if (profile == pollingProfile)
+        {
+            return;
+        }
+        std::cerr << "Switching the polling profile from "
+                  << pollingProfileNames[static_cast<size_t>(pollingProfile)]
+                  << " to " << pollingProfileNames[static_cast<size_t>(profile)]
+                  << std::endl;
+        pollingProfile = profile;
+        for (auto& [eid, dev] : mDevices)
+        {
+            applyCadence(eid, *dev);
+        }
+    }
+
+    /** @brief Apply the current polling profile to a terminus, overridden by
+     *         the knobs tuned for it
+     *
+     *  @param[in] eid - MCTP endpoint of the terminus
+     *  @param[in] dev - terminus
+     */
+    void applyCadence(mctp_eid_t eid, TerminusHandler& dev)
+    {
+        const auto& knobs = tuning->get(eid);
+        dev.applyPollingProfile(
+            knobs.apply(pollingProfiles[static_cast<size_t>(pollingProfile)]));
+        handler->setEndpointRetries(eid, knobs.retries());
+    }
+
+    /** @brief Apply the knobs of a terminus after they were tuned */
+    void applyTuning(mctp_eid_t eid)
+    {
+        auto it = mDevices.find(eid);
+        if (it != mDevices.end())
+        {
+            applyCadence(eid, *it->second);
+            return;
+        }
+        handler->setEndpointRetries(eid, tuning->get(eid).retries());
+    }
+
+    /** @brief Parse the polling profiles configuration
+     *
+     *  @details Each profile may set the interval of the sensor polling
+     *  rounds, the pause of the backed off sensor polling, the base and the
+     *  maximum interval of the normal RAS poll and a multiplier of the
+     *  slower sensor polling tiers. A setting not
+     *  configured keeps its build time default.
+     *
+     *  @param[in] path - path of the configuration file
+     *
+     *  @return - false if the configuration file is malformed
+     */
+    bool setupPollingProfiles(const fs::path& path)
+    {
+        if (!fs::exists(path))
+        {
+            return true;
+        }
+        std::ifstream jsonFile(path);
+        auto datas = Json::parse(jsonFile, nullptr, false);
+        if (datas.is_discarded())
+        {
+            std::cerr << "Parsing polling profiles config file failed, "
+                      << "FILE=" << path << std::endl;
+            return false;
+        }
+
+        auto profiles = datas.value("profiles", Json::object());
+        for (const auto& [name, entry] : profiles.items())
+        {
+            auto profile = toPollingProfile(name);
+            if (!profile || !entry.is_object())
+            {
+                std::cerr << "Unknown polling profile \"" << name << "\""
+                          << std::endl;
+                continue;
+            }
+            try
+            {
+                PollingProfileSettings settings;
+                settings.sensorInterval = std::chrono::milliseconds(
+                    entry.value("sensor_interval_ms",
+                                settings.sensorInterval.count()));
+                settings.rasInterval = std::chrono::milliseconds(entry.value(
+                    "ras_interval_ms", settings.rasInterval.count()));
+                settings.rasMaxInterval = std::chrono::milliseconds(
+                    entry.value("ras_max_interval_ms",
+                                settings.rasMaxInterval.count()));
+                settings.sleepBetweenReads = std::chrono::milliseconds(
+                    entry.value("sleep_between_reads_ms",
+                                settings.sleepBetweenReads.count()));
+                auto tierScale = entry.value("tier_scale", 1);
+                if (settings.sensorInterval.count() <= 0 ||
+                    settings.rasInterval.count() <= 0 ||
+                    settings.rasMaxInterval.count() <= 0 ||
+                    settings.sleepBetweenReads.count() <= 0 || tierScale < 1 ||
+                    tierScale > UINT8_MAX)
+                {
+                    std::cerr << "Invalid polling profile \"" << name << "\""
+                              << std::endl;
+                    continue;
+                }
+                settings.tierScale = static_cast<uint16_t>(tierScale);
+                pollingProfiles[static_cast<size_t>(*profile)] = settings;
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "Polling profiles format error\n";
+                continue;
+            }
+        }
+
+        return true;
+    }
+
     bool setupEIDtoTeminusName(const fs::path& path)
     {
         const Json emptyJson{};
@@ -226,6 +833,118 @@ class Manager
 
         return true;
     }
+
+    /** @brief Parse the sensor polling tiers configuration
+     *
+     *  @details The tiers are defined by their polling interval in
+     *  milliseconds, which is rounded to a number of poll-sensor-timer-interval
+     *  rounds. Each sensor entry selects the tier by the sensor name or by the
+     *  entity type of the sensor. The sensors without entry are polled every
+     *  round.
+     *
+     *  @param[in] path - path of the configuration file
+     *
+     *  @return - false if the configuration file is malformed
+     */
+    bool setupSensorPollingTiers(const fs::path& path)
+    {
+        const Json emptyJson{};
+        if (!fs::exists(path))
+        {
+            return true;
+        }
+        std::ifstream jsonFile(path);
+        auto datas = Json::parse(jsonFile, nullptr, false);
+        if (datas.is_discarded())
+        {
+            std::cerr << "Parsing sensor polling tiers config file failed, "
+                      << "FILE=" << path << std::endl;
+            return false;
+        }
+
+        std::map<std::string, uint16_t> tierRounds;
+        auto tiers = datas.value("tiers", emptyJson);
+        for (const auto& tier : tiers)
+        {
+            auto name = tier.value("tier", "");
+            auto interval = tier.value("interval_ms", 0);
+            if (name == "" || interval <= 0)
+            {
+                std::cerr << "Invalid sensor polling tier configuration"
+                          << std::endl;
+                continue;
+            }
+            tierRounds[name] = static_cast<uint16_t>(std::clamp(
+                interval / POLL_SENSOR_TIMER_INTERVAL, 1, UINT16_MAX));
+        }
+
+        auto entries = datas.value("sensors", emptyJson);
+        for (const auto& entry : entries)
+        {
+            try
+            {
+                auto tier = entry.value("tier", "");
+                if (!tierRounds.contains(tier))
+                {
+                    std::cerr << "Unknown sensor polling tier \"" << tier
+                              << "\"" << std::endl;
+                    continue;
+                }
+                if (entry.contains("name"))
+                {
+                    pollingTiers.sensorNames[entry.value("name", "")] =
+                        tierRounds[tier];
+                }
+                else if (entry.contains("entity_type"))
+                {
+                    pollingTiers.entityTypes[entry.value("entity_type", 0)] =
+                        tierRounds[tier];
+                }
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "Sensor polling tiers format error\n";
+                continue;
+            }
+        }
+
+        auto filters = datas.value("filters", emptyJson);
+        for (const auto& entry : filters)
+        {
+            try
+            {
+                SensorPublishFilter filter;
+                filter.deadband = entry.value("deadband", 0.0);
+                filter.relativeDeadband =
+                    entry.value("deadband_percent", 0.0) / 100;
+                filter.minInterval = std::chrono::milliseconds(
+                    entry.value("min_publish_interval_ms", 0));
+                if (filter.deadband < 0 || filter.relativeDeadband < 0 ||
+                    filter.minInterval.count() < 0)
+                {
+                    std::cerr << "Invalid sensor publish filter configuration"
+                              << std::endl;
+                    continue;
+                }
+                if (entry.contains("name"))
+                {
+                    pollingTiers.nameFilters[entry.value("name", "")] = filter;
+                }
+                else if (entry.contains("entity_type"))
+                {
+                    pollingTiers.entityFilters[entry.value("entity_type", 0)] =
+                        filter;
+                }
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "Sensor publish filters format error\n";
+                continue;
+            }
+        }
+
+        return true;
+    }
 };
 
 }; // namespace terminus
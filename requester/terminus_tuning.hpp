@@ -0,0 +1,120 @@
+#pragma once
+
+#include "requester/polling_profile.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace pldm
+{
+
+/** @brief Performance knob of a terminus which can be tuned at runtime */
+enum class TuningKnob : uint8_t
+{
+    SensorInterval,    //!< Interval of the sensor polling rounds, ms
+    SleepBetweenReads, //!< Pause after a backed off sensor read, ms
+    RasInterval,       //!< Base interval of the normal RAS poll, ms
+    RasMaxInterval,    //!< Interval the normal RAS poll backs off to, ms
+    Retries,           //!< Number of retries of the requests to the terminus
+};
+
+constexpr size_t tuningKnobCount = 5;
+
+/** @brief Names of the knobs on D-Bus and in the persisted settings */
+constexpr std::array<std::string_view, tuningKnobCount> tuningKnobNames{
+    "SensorIntervalMs", "SleepBetweenReadsMs", "RasIntervalMs",
+    "RasMaxIntervalMs", "Retries"};
+
+/** @brief Knob of a name of tuningKnobNames */
+inline std::optional<TuningKnob> toTuningKnob(std::string_view name)
+{
+    for (size_t i = 0; i < tuningKnobNames.size(); i++)
+    {
+        if (tuningKnobNames[i] == name)
+        {
+            return static_cast<TuningKnob>(i);
+        }
+    }
+    return std::nullopt;
+}
+
+/** @brief Check whether a value can be set to a knob, the intervals are
+ *         between 1 ms and one hour, the retries fit the request counter
+ */
+inline bool isValidTuning(TuningKnob knob, uint64_t value)
+{
+    constexpr uint64_t maxIntervalMs = 3600 * 1000;
+    if (knob == TuningKnob::Retries)
+    {
+        return value <= UINT8_MAX;
+    }
+    return value > 0 && value <= maxIntervalMs;
+}
+
+/** @struct TerminusTuning
+ *  @brief Knobs set for one terminus, the knobs not set keep the value of the
+ *  polling profile or of the build time configuration
+ */
+struct TerminusTuning
+{
+    std::array<std::optional<uint64_t>, tuningKnobCount> values{};
+
+    /** @brief Value set to a knob, unset if the knob is not tuned */
+    std::optional<uint64_t> get(TuningKnob knob) const
+    {
+        return values[static_cast<size_t>(knob)];
+    }
+
+    /** @brief Set or reset a knob */
+    void set(TuningKnob knob, std::optional<uint64_t> value)
+    {
+        values[static_cast<size_t>(knob)] = value;
+    }
+
+    /** @brief Check whether no knob is set */
+    bool empty() const
+    {
+        for (const auto& value : values)
+        {
+            if (value)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /** @brief Polling cadence of a profile with the tuned knobs applied */
+    PollingProfileSettings apply(PollingProfileSettings settings) const
+    {
+        auto tune = [this](TuningKnob knob, std::chrono::milliseconds& ms) {
+            if (auto value = get(knob))
+            {
+                ms = std::chrono::milliseconds(*value);
+            }
+        };
+        tune(TuningKnob::SensorInterval, settings.sensorInterval);
+        tune(TuningKnob::SleepBetweenReads, settings.sleepBetweenReads);
+        tune(TuningKnob::RasInterval, settings.rasInterval);
+        tune(TuningKnob::RasMaxInterval, settings.rasMaxInterval);
+        return settings;
+    }
+
+    /** @brief Retries of the requests, unset to keep the default */
+    std::optional<uint8_t> retries() const
+    {
+        if (auto value = get(TuningKnob::Retries))
+        {
+            return static_cast<uint8_t>(*value);
+        }
+        return std::nullopt;
+    }
+
+    bool operator==(const TerminusTuning&) const = default;
+};
+
+} // namespace pldm
@@ -0,0 +1,65 @@
+#include "requester/active_set.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm;
+
+static std::vector<size_t> sorted(const ActiveSet& set)
+{
+    std::vector<size_t> members(set.begin(), set.end());
+    std::sort(members.begin(), members.end());
+    return members;
+}
+
+TEST(ActiveSet, InsertAndErase)
+{
+    ActiveSet set;
+    EXPECT_TRUE(set.empty());
+    EXPECT_TRUE(set.insert(3));
+    EXPECT_TRUE(set.insert(0));
+    EXPECT_TRUE(set.insert(7));
+    EXPECT_FALSE(set.insert(3));
+    EXPECT_EQ(set.size(), 3);
+    EXPECT_TRUE(set.contains(7));
+    EXPECT_FALSE(set.contains(5));
+    EXPECT_FALSE(set.contains(100));
+
+    /* The last member fills the hole of the first one */
+    EXPECT_TRUE(set.erase(3));
+    EXPECT_FALSE(set.erase(3));
+    EXPECT_FALSE(set.erase(100));
+    EXPECT_FALSE(set.contains(3));
+    EXPECT_EQ(sorted(set), (std::vector<size_t>{0, 7}));
+    EXPECT_EQ(*set.begin(), 7);
+
+    EXPECT_TRUE(set.erase(7));
+    EXPECT_TRUE(set.erase(0));
+    EXPECT_TRUE(set.empty());
+    EXPECT_TRUE(set.insert(7));
+    EXPECT_EQ(sorted(set), (std::vector<size_t>{7}));
+}
+
+TEST(ActiveSet, Clear)
+{
+    ActiveSet set;
+    for (size_t index = 0; index < 16; index++)
+    {
+        set.insert(index);
+    }
+    for (size_t index = 0; index < 16; index += 2)
+    {
+        set.erase(index);
+    }
+    EXPECT_EQ(set.size(), 8);
+    for (auto index : set)
+    {
+        EXPECT_EQ(index % 2, 1);
+    }
+
+    set.clear();
+    EXPECT_TRUE(set.empty());
+    EXPECT_FALSE(set.contains(1));
+}
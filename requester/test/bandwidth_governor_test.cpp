@@ -0,0 +1,58 @@
+#include "requester/bandwidth_governor.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace pldm::requester;
+using namespace std::chrono_literals;
+
+TEST(BandwidthGovernor, UnlimitedByDefault)
+{
+    BandwidthGovernor governor(2);
+    auto now = BandwidthGovernor::Clock::now();
+    governor.charge(0, 1 << 20, now);
+    EXPECT_TRUE(governor.maySend(0, now));
+    EXPECT_EQ(governor.waitTime(0, now), BandwidthGovernor::Clock::duration(0));
+    EXPECT_EQ(governor.totalBytes(0), 1 << 20);
+}
+
+TEST(BandwidthGovernor, TokenBucket)
+{
+    BandwidthGovernor governor(2);
+    auto now = BandwidthGovernor::Clock::now();
+    governor.setBudget(1, {1000, 100}, now);
+    EXPECT_TRUE(governor.maySend(1, now));
+
+    /* A message larger than the burst goes through and leaves a debt */
+    governor.charge(1, 300, now);
+    EXPECT_FALSE(governor.maySend(1, now));
+    auto wait = governor.waitTime(1, now);
+    EXPECT_GT(wait, 200ms);
+    EXPECT_LE(wait, 201ms);
+    EXPECT_FALSE(governor.maySend(1, now + 150ms));
+    EXPECT_TRUE(governor.maySend(1, now + wait));
+
+    /* The other class is not affected */
+    EXPECT_TRUE(governor.maySend(0, now));
+
+    /* The bucket refills up to the burst only */
+    EXPECT_TRUE(governor.maySend(1, now + 10s));
+    governor.charge(1, 100, now + 10s);
+    EXPECT_FALSE(governor.maySend(1, now + 10s));
+}
+
+TEST(BandwidthGovernor, Utilization)
+{
+    BandwidthGovernor governor(1);
+    auto now = BandwidthGovernor::Clock::now();
+    governor.charge(0, 10, now);
+    governor.charge(0, 20, now + 500ms);
+    /* The first window is still running */
+    EXPECT_EQ(governor.utilization(0, now + 900ms), 0);
+    EXPECT_EQ(governor.utilization(0, now + 1100ms), 30);
+
+    governor.charge(0, 5, now + 1100ms);
+    EXPECT_EQ(governor.utilization(0, now + 1500ms), 30);
+    EXPECT_EQ(governor.utilization(0, now + 2200ms), 5);
+    /* Idle for a whole window */
+    EXPECT_EQ(governor.utilization(0, now + 3200ms), 0);
+}
@@ -0,0 +1,49 @@
+#include "requester/circuit_breaker.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace pldm;
+
+TEST(CircuitBreaker, OpensAfterThreshold)
+{
+    CircuitBreaker breaker(3);
+    EXPECT_FALSE(breaker.failure());
+    EXPECT_FALSE(breaker.failure());
+    EXPECT_FALSE(breaker.isOpen());
+    EXPECT_TRUE(breaker.failure());
+    EXPECT_TRUE(breaker.isOpen());
+
+    /* Only the timeout which opens the breaker reports it */
+    EXPECT_FALSE(breaker.failure());
+    EXPECT_TRUE(breaker.isOpen());
+}
+
+TEST(CircuitBreaker, ResponseResetsCount)
+{
+    CircuitBreaker breaker(2);
+    EXPECT_FALSE(breaker.failure());
+    EXPECT_FALSE(breaker.success());
+    EXPECT_EQ(breaker.getFailures(), 0);
+    EXPECT_FALSE(breaker.failure());
+    EXPECT_FALSE(breaker.isOpen());
+}
+
+TEST(CircuitBreaker, ResponseCloses)
+{
+    CircuitBreaker breaker(1);
+    EXPECT_TRUE(breaker.failure());
+    EXPECT_TRUE(breaker.success());
+    EXPECT_FALSE(breaker.isOpen());
+    EXPECT_TRUE(breaker.failure());
+}
+
+TEST(CircuitBreaker, TripOpens)
+{
+    CircuitBreaker breaker(5);
+    EXPECT_TRUE(breaker.trip());
+    EXPECT_TRUE(breaker.isOpen());
+    EXPECT_FALSE(breaker.trip());
+    EXPECT_FALSE(breaker.failure());
+    EXPECT_TRUE(breaker.success());
+    EXPECT_FALSE(breaker.isOpen());
+}
@@ -0,0 +1,225 @@
+#include "requester/coroutine_tools.hpp"
+
+#include <libpldm/base.h>
+
+#include <sdeventplus/event.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <coroutine>
+#include <vector>
+
+using namespace pldm::requester;
+using namespace std::chrono_literals;
+
+/** @brief Awaitable opened by the test, stands for a pending response */
+class Gate
+{
+  public:
+    bool await_ready() const noexcept
+    {
+        return isOpen;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) noexcept
+    {
+        waiter = handle;
+    }
+
+    void await_resume() const noexcept {}
+
+    void open()
+    {
+        isOpen = true;
+        if (auto handle = std::exchange(waiter, nullptr))
+        {
+            handle.resume();
+        }
+    }
+
+  private:
+    bool isOpen = false;
+    std::coroutine_handle<> waiter;
+};
+
+static Coroutine waitGate(Gate& gate, uint8_t rc)
+{
+    co_await gate;
+    co_return rc;
+}
+
+/** @brief Task counting the tasks running at the same time */
+static Coroutine countedTask(Gate& gate, size_t& running, size_t& maxRunning,
+                             uint8_t rc)
+{
+    running++;
+    maxRunning = std::max(maxRunning, running);
+    co_await gate;
+    running--;
+    co_return rc;
+}
+
+static Coroutine sleepTask(sdeventplus::Event& event, CancellationToken token,
+                           uint8_t& result)
+{
+    result = co_await SleepFor(event, 1h, std::move(token));
+    co_return result;
+}
+
+static Coroutine joinAll(std::vector<Coroutine> tasks, uint8_t& result,
+                         bool& done)
+{
+    result = co_await whenAll(std::move(tasks));
+    done = true;
+    co_return result;
+}
+
+static Coroutine joinAny(std::vector<Coroutine> tasks, WhenAny::Result& result,
+                         bool& done)
+{
+    result = co_await WhenAny(std::move(tasks));
+    done = true;
+    co_return PLDM_SUCCESS;
+}
+
+TEST(CoroutineTools, WhenAllWaitsForEveryTask)
+{
+    Gate first;
+    Gate second;
+    uint8_t result = PLDM_SUCCESS;
+    bool done = false;
+    std::vector<Coroutine> tasks;
+    tasks.emplace_back(waitGate(first, PLDM_SUCCESS));
+    tasks.emplace_back(waitGate(second, PLDM_ERROR_INVALID_DATA));
+    joinAll(std::move(tasks), result, done);
+
+    /* The tasks complete out of order */
+    second.open();
+    EXPECT_FALSE(done);
+    first.open();
+    EXPECT_TRUE(done);
+    EXPECT_EQ(result, PLDM_ERROR_INVALID_DATA);
+}
+
+TEST(CoroutineTools, WhenAnyResumesOnTheFirstTask)
+{
+    Gate gates[3];
+    WhenAny::Result result{};
+    bool done = false;
+    std::vector<Coroutine> tasks;
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        tasks.emplace_back(waitGate(gates[i], i));
+    }
+    joinAny(std::move(tasks), result, done);
+    EXPECT_FALSE(done);
+
+    gates[1].open();
+    EXPECT_TRUE(done);
+    EXPECT_EQ(result.first, 1);
+    EXPECT_EQ(result.second, 1);
+
+    /* The others still complete, without resuming the waiter again */
+    gates[0].open();
+    gates[2].open();
+    EXPECT_EQ(result.first, 1);
+}
+
+TEST(CoroutineTools, ForEachBoundsTheRunningTasks)
+{
+    std::vector<Gate> gates(5);
+    size_t running = 0;
+    size_t maxRunning = 0;
+    auto task = [&](const size_t& index) {
+        return countedTask(gates[index], running, maxRunning,
+                           index == 3 ? PLDM_ERROR : PLDM_SUCCESS);
+    };
+
+    uint8_t result = PLDM_SUCCESS;
+    bool done = false;
+    std::vector<Coroutine> tasks;
+    tasks.emplace_back(forEach(std::vector<size_t>{0, 1, 2, 3, 4}, 2, task));
+    joinAll(std::move(tasks), result, done);
+    EXPECT_EQ(running, 2);
+
+    for (auto& gate : gates)
+    {
+        gate.open();
+    }
+    EXPECT_TRUE(done);
+    EXPECT_EQ(maxRunning, 2);
+    EXPECT_EQ(result, PLDM_ERROR);
+}
+
+TEST(CoroutineTools, ForEachStopsWhenCancelled)
+{
+    std::vector<Gate> gates(3);
+    size_t running = 0;
+    size_t maxRunning = 0;
+    auto task = [&](const size_t& index) {
+        return countedTask(gates[index], running, maxRunning, PLDM_SUCCESS);
+    };
+
+    CancellationSource source;
+    uint8_t result = PLDM_SUCCESS;
+    bool done = false;
+    std::vector<Coroutine> tasks;
+    tasks.emplace_back(
+        forEach(std::vector<size_t>{0, 1, 2}, 1, task, source.token()));
+    joinAll(std::move(tasks), result, done);
+
+    source.cancel();
+    gates[0].open();
+    EXPECT_TRUE(done);
+    EXPECT_EQ(maxRunning, 1);
+    EXPECT_EQ(result, PLDM_ERROR);
+}
+
+TEST(CoroutineTools, SleepEndsOnTimeoutOrCancel)
+{
+    auto event = sdeventplus::Event::get_new();
+    CancellationSource source;
+    uint8_t slept = PLDM_ERROR;
+    uint8_t cancelled = PLDM_SUCCESS;
+    bool done = false;
+    std::vector<Coroutine> tasks;
+    tasks.emplace_back(delay(event, 1ms));
+    tasks.emplace_back(delay(event, 1h, source.token()));
+    joinAll(std::move(tasks), slept, done);
+
+    source.cancel();
+    /* The cancelled sleep is resumed from the event loop */
+    EXPECT_FALSE(done);
+    for (int i = 0; i < 100 && !done; i++)
+    {
+        event.run(10ms);
+    }
+    EXPECT_TRUE(done);
+    EXPECT_EQ(slept, PLDM_ERROR);
+
+    /* A cancelled token does not sleep */
+    sleepTask(event, source.token(), cancelled);
+    EXPECT_EQ(cancelled, PLDM_ERROR);
+}
+
+TEST(CoroutineTools, DeadlineCancelsTheToken)
+{
+    auto event = sdeventplus::Event::get_new();
+    CancellationSource source;
+    source.cancelAfter(event, 1ms);
+    WhenAny::Result result{};
+    bool done = false;
+    std::vector<Coroutine> tasks;
+    tasks.emplace_back(delay(event, 1h, source.token()));
+    joinAny(std::move(tasks), result, done);
+
+    for (int i = 0; i < 100 && !done; i++)
+    {
+        event.run(10ms);
+    }
+    EXPECT_TRUE(done);
+    EXPECT_TRUE(source.cancelled());
+    EXPECT_EQ(result.second, PLDM_ERROR);
+}
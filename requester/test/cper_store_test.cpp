@@ -0,0 +1,129 @@
+#include "requester/cper_store.hpp"
+
+#include <stdlib.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm;
+using namespace std::chrono_literals;
+
+class CperStoreTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        char tmpl[] = "/tmp/cper_store.XXXXXX";
+        ASSERT_NE(mkdtemp(tmpl), nullptr);
+        dir = tmpl;
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(dir);
+    }
+
+    /** @brief CPER record without section, of the given record ID */
+    static std::vector<uint8_t> record(uint64_t recordId,
+                                       uint32_t severity = 1)
+    {
+        std::vector<uint8_t> data(sizeof(CPERRecodHeader) + 32, 0x5a);
+        CPERRecodHeader header{};
+        header.SignatureStart = 0x52455043;
+        header.ErrorSeverity = severity;
+        header.RecordLength = data.size();
+        header.TimeStamp.Seconds = static_cast<uint8_t>(recordId);
+        header.RecordID = recordId;
+        std::memcpy(data.data(), &header, sizeof(header));
+        return data;
+    }
+
+    CperStore::Result store(CperStore& cperStore,
+                            const std::vector<uint8_t>& data,
+                            const std::string& id,
+                            CperStore::Clock::time_point now)
+    {
+        AmpereSpecData ampHdr{};
+        decodeCperRecord(data, &ampHdr, view);
+        return cperStore.store(1, data, view, id, now);
+    }
+
+    std::filesystem::path dir;
+    CperRecordView view;
+    CperStore::Clock::time_point start{};
+};
+
+TEST_F(CperStoreTest, WritesTheDecodedRecord)
+{
+    CperStore cperStore(dir, 0, CperStore::Compression::None, 0s);
+    auto data = record(1);
+    EXPECT_EQ(store(cperStore, data, "RAS_CPER_1", start),
+              CperStore::Result::Stored);
+
+    std::ifstream file(dir / "RAS_CPER_1", std::ios::binary);
+    std::vector<uint8_t> written((std::istreambuf_iterator<char>(file)),
+                                 std::istreambuf_iterator<char>());
+    ASSERT_EQ(written.size(), view.size);
+    EXPECT_EQ(cperStore.size(), view.size);
+    /* The signature is byte swapped, the rest is as reported */
+    EXPECT_EQ(written[0], data[3]);
+    EXPECT_TRUE(std::equal(written.begin() + 4, written.end(),
+                           data.begin() + 4));
+}
+
+TEST_F(CperStoreTest, CountsTheRepeatsOfTheWindow)
+{
+    CperStore cperStore(dir, 0, CperStore::Compression::None, 60s);
+    EXPECT_EQ(store(cperStore, record(1), "RAS_CPER_1", start),
+              CperStore::Result::Stored);
+    /* Same error, another timestamp and record ID */
+    EXPECT_EQ(store(cperStore, record(2), "RAS_CPER_2", start + 1s),
+              CperStore::Result::Duplicate);
+    EXPECT_EQ(store(cperStore, record(3), "RAS_CPER_3", start + 2s),
+              CperStore::Result::Duplicate);
+    /* Another error */
+    EXPECT_EQ(store(cperStore, record(4, 2), "RAS_CPER_4", start + 3s),
+              CperStore::Result::Stored);
+    EXPECT_FALSE(std::filesystem::exists(dir / "RAS_CPER_2"));
+    EXPECT_FALSE(std::filesystem::exists(dir / "RAS_CPER_3"));
+
+    /* The window of the first record ended, its count is written */
+    EXPECT_EQ(store(cperStore, record(5), "RAS_CPER_5", start + 61s),
+              CperStore::Result::Stored);
+    std::ifstream repeats(dir / "RAS_CPER_1.repeats");
+    uint64_t count = 0;
+    repeats >> count;
+    EXPECT_EQ(count, 2);
+    EXPECT_FALSE(std::filesystem::exists(dir / "RAS_CPER_4.repeats"));
+}
+
+TEST_F(CperStoreTest, RemovesTheOldestFilesOverTheCap)
+{
+    auto data = record(1);
+    {
+        CperStore cperStore(dir, 0, CperStore::Compression::None, 0s);
+        EXPECT_EQ(store(cperStore, data, "RAS_CPER_1", start),
+                  CperStore::Result::Stored);
+    }
+    auto fileSize = std::filesystem::file_size(dir / "RAS_CPER_1");
+
+    /* The file of the former run counts against the cap */
+    CperStore cperStore(dir, fileSize * 5 / 2, CperStore::Compression::None,
+                        0s);
+    EXPECT_EQ(cperStore.size(), fileSize);
+    for (auto id : {"RAS_CPER_2", "RAS_CPER_3", "RAS_CPER_4"})
+    {
+        EXPECT_EQ(store(cperStore, data, id, start),
+                  CperStore::Result::Stored);
+    }
+    EXPECT_EQ(cperStore.size(), 2 * fileSize);
+    EXPECT_FALSE(std::filesystem::exists(dir / "RAS_CPER_1"));
+    EXPECT_FALSE(std::filesystem::exists(dir / "RAS_CPER_2"));
+    EXPECT_TRUE(std::filesystem::exists(dir / "RAS_CPER_3"));
+    EXPECT_TRUE(std::filesystem::exists(dir / "RAS_CPER_4"));
+}
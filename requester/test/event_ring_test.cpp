@@ -0,0 +1,59 @@
+#include "requester/event_ring.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace pldm;
+
+TEST(EventRing, Fifo)
+{
+    EventRing<uint16_t, 4> ring(RingFullPolicy::DropNewest, false);
+    EXPECT_TRUE(ring.empty());
+    EXPECT_EQ(ring.push(1), RingPushResult::Queued);
+    EXPECT_EQ(ring.push(2), RingPushResult::Queued);
+    EXPECT_EQ(ring.push(2), RingPushResult::Queued);
+    EXPECT_EQ(ring.size(), 3);
+    EXPECT_EQ(ring.front(), 1);
+    ring.pop_front();
+    EXPECT_EQ(ring.front(), 2);
+    ring.pop_front();
+    ring.pop_front();
+    EXPECT_TRUE(ring.empty());
+    ring.pop_front();
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(EventRing, Coalesce)
+{
+    EventRing<uint16_t, 4> ring(RingFullPolicy::DropNewest, true);
+    EXPECT_EQ(ring.push(7), RingPushResult::Queued);
+    EXPECT_EQ(ring.push(7), RingPushResult::Coalesced);
+    EXPECT_EQ(ring.size(), 1);
+    EXPECT_EQ(ring.getCounters().queued, 1);
+    EXPECT_EQ(ring.getCounters().coalesced, 1);
+}
+
+TEST(EventRing, DropNewest)
+{
+    EventRing<uint16_t, 2> ring(RingFullPolicy::DropNewest, true);
+    ring.push(1);
+    ring.push(2);
+    EXPECT_EQ(ring.push(3), RingPushResult::Dropped);
+    EXPECT_EQ(ring.front(), 1);
+    EXPECT_FALSE(ring.contains(3));
+    EXPECT_EQ(ring.getCounters().dropped, 1);
+}
+
+TEST(EventRing, DropOldestWraps)
+{
+    EventRing<uint16_t, 3> ring(RingFullPolicy::DropOldest, true);
+    for (uint16_t i = 1; i <= 5; i++)
+    {
+        ring.push(i);
+    }
+    EXPECT_EQ(ring.size(), 3);
+    EXPECT_EQ(ring.front(), 3);
+    EXPECT_TRUE(ring.contains(5));
+    EXPECT_FALSE(ring.contains(2));
+    EXPECT_EQ(ring.getCounters().queued, 5);
+    EXPECT_EQ(ring.getCounters().dropped, 2);
+}
@@ -0,0 +1,75 @@
+#include "requester/event_shard.hpp"
+
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/event.hpp>
+#include <sdeventplus/utility/timer.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+using namespace pldm::requester;
+using namespace std::chrono_literals;
+
+class EventShardTest : public testing::Test
+{
+  protected:
+    EventShardTest() : parent(sdeventplus::Event::get_new()), shard(parent, 2)
+    {}
+
+    /** @brief Queue one-shot callbacks on the shard */
+    void queue(size_t count, int& fired)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            auto source = std::make_unique<sdeventplus::source::Defer>(
+                shard.get(),
+                [&fired](sdeventplus::source::EventBase&) { fired++; });
+            source->set_enabled(sdeventplus::source::Enabled::OneShot);
+            sources.emplace_back(std::move(source));
+        }
+    }
+
+    sdeventplus::Event parent;
+    EventShard shard;
+    std::vector<std::unique_ptr<sdeventplus::source::Defer>> sources;
+};
+
+TEST_F(EventShardTest, DispatchIsBounded)
+{
+    int fired = 0;
+    queue(5, fired);
+    EXPECT_EQ(shard.dispatch(), 2);
+    EXPECT_EQ(fired, 2);
+    EXPECT_EQ(shard.dispatch(), 2);
+    EXPECT_EQ(shard.dispatch(), 1);
+    EXPECT_EQ(fired, 5);
+    EXPECT_EQ(shard.dispatch(), 0);
+}
+
+TEST_F(EventShardTest, ParentRunsShardTimer)
+{
+    int fired = 0;
+    sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> timer(
+        shard.get(), [&fired] { fired++; });
+    timer.restartOnce(1ms);
+
+    for (int i = 0; i < 50 && !fired; i++)
+    {
+        parent.run(std::chrono::microseconds(10ms));
+    }
+    EXPECT_EQ(fired, 1);
+}
+
+TEST_F(EventShardTest, ParentRunsRestOfBudget)
+{
+    int fired = 0;
+    queue(5, fired);
+    for (int i = 0; i < 10 && fired < 5; i++)
+    {
+        parent.run(std::chrono::microseconds(10ms));
+    }
+    EXPECT_EQ(fired, 5);
+}
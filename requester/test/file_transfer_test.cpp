@@ -0,0 +1,105 @@
+#include "requester/file_transfer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::file_transfer;
+
+TEST(FileTransfer, EncodeDfOpenRequest)
+{
+    std::vector<uint8_t> requestMsg(sizeof(pldm_msg_hdr) +
+                                    PLDM_DF_OPEN_REQ_BYTES);
+    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+
+    ASSERT_EQ(encodeDfOpenReq(2, 0x0102, 0, request, PLDM_DF_OPEN_REQ_BYTES),
+              PLDM_SUCCESS);
+    EXPECT_EQ(request->hdr.request, 1);
+    EXPECT_EQ(request->hdr.instance_id, 2);
+    EXPECT_EQ(request->hdr.type, PLDM_FILE_TRANSFER);
+    EXPECT_EQ(request->hdr.command, PLDM_DF_OPEN);
+    EXPECT_EQ(request->payload[0], 0x02);
+    EXPECT_EQ(request->payload[1], 0x01);
+
+    EXPECT_EQ(encodeDfOpenReq(2, 0x0102, 0, request, 3),
+              PLDM_ERROR_INVALID_LENGTH);
+    EXPECT_EQ(encodeDfOpenReq(2, 0x0102, 0, nullptr, PLDM_DF_OPEN_REQ_BYTES),
+              PLDM_ERROR_INVALID_DATA);
+}
+
+TEST(FileTransfer, DecodeDfOpenResponse)
+{
+    std::vector<uint8_t> responseMsg{0, 0, 0, PLDM_SUCCESS, 0x34, 0x12};
+    auto response = reinterpret_cast<const pldm_msg*>(responseMsg.data());
+    uint8_t cc = 0xff;
+    uint16_t descriptor = 0;
+
+    ASSERT_EQ(decodeDfOpenResp(response, PLDM_DF_OPEN_RESP_BYTES, cc,
+                               descriptor),
+              PLDM_SUCCESS);
+    EXPECT_EQ(cc, PLDM_SUCCESS);
+    EXPECT_EQ(descriptor, 0x1234);
+
+    responseMsg[sizeof(pldm_msg_hdr)] = PLDM_ERROR;
+    descriptor = 0;
+    ASSERT_EQ(decodeDfOpenResp(response, 1, cc, descriptor), PLDM_SUCCESS);
+    EXPECT_EQ(cc, PLDM_ERROR);
+    EXPECT_EQ(descriptor, 0);
+}
+
+TEST(FileTransfer, EncodeMultipartReceiveRequest)
+{
+    std::vector<uint8_t> requestMsg(sizeof(pldm_msg_hdr) +
+                                    PLDM_MULTIPART_RECEIVE_REQ_BYTES);
+    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+
+    ASSERT_EQ(encodeMultipartReceiveReq(
+                  4, TransferOperation::NextPart, 0x0a0b, 0x11223344, 0x400,
+                  0x100, request, PLDM_MULTIPART_RECEIVE_REQ_BYTES),
+              PLDM_SUCCESS);
+    EXPECT_EQ(request->hdr.type, PLDM_BASE);
+    EXPECT_EQ(request->hdr.command, PLDM_MULTIPART_RECEIVE);
+
+    const std::array<uint8_t, PLDM_MULTIPART_RECEIVE_REQ_BYTES> expected{
+        PLDM_FILE_TRANSFER, 1, 0x0b, 0x0a, 0, 0, 0x44, 0x33, 0x22,
+        0x11, 0, 0x04, 0, 0, 0, 0x01, 0, 0};
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), request->payload));
+}
+
+TEST(FileTransfer, DecodeMultipartReceiveResponse)
+{
+    /* A last part of 3 bytes with the CRC-32 of the section */
+    std::vector<uint8_t> responseMsg{0,    0,    0,    PLDM_SUCCESS,
+                                     PLDM_START_AND_END,
+                                     0,    0,    0,    0,
+                                     3,    0,    0,    0,
+                                     0xaa, 0xbb, 0xcc,
+                                     0x78, 0x56, 0x34, 0x12};
+    auto response = reinterpret_cast<const pldm_msg*>(responseMsg.data());
+    auto payloadLength = responseMsg.size() - sizeof(pldm_msg_hdr);
+    uint8_t cc = 0xff;
+    MultipartPart part{};
+
+    ASSERT_EQ(decodeMultipartReceiveResp(response, payloadLength, cc, part),
+              PLDM_SUCCESS);
+    EXPECT_EQ(cc, PLDM_SUCCESS);
+    EXPECT_EQ(part.transferFlag, PLDM_START_AND_END);
+    ASSERT_EQ(part.data.size(), 3);
+    EXPECT_EQ(part.data[0], 0xaa);
+    EXPECT_EQ(part.data[2], 0xcc);
+    EXPECT_EQ(part.sectionCrc, 0x12345678);
+
+    /* A data length which does not match the payload */
+    EXPECT_EQ(decodeMultipartReceiveResp(response, payloadLength - 1, cc, part),
+              PLDM_ERROR_INVALID_LENGTH);
+
+    /* A first part has no CRC */
+    responseMsg[sizeof(pldm_msg_hdr) + 1] = PLDM_START;
+    responseMsg[sizeof(pldm_msg_hdr) + 2] = 0x05;
+    EXPECT_EQ(decodeMultipartReceiveResp(response, payloadLength - 4, cc, part),
+              PLDM_SUCCESS);
+    EXPECT_EQ(part.nextDataTransferHandle, 5);
+    EXPECT_EQ(part.data.size(), 3);
+}
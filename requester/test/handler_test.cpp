@@ -150,3 +150,169 @@ TEST_F(HandlerTest, multipleRequestResponseScenario)
     EXPECT_EQ(validResponse, true);
     EXPECT_EQ(callbackCount, 2);
 }
+
+TEST_F(HandlerTest, multipleOutstandingRequestsScenario)
+{
+    Handler<NiceMock<MockRequest>> reqHandler(
+        pldmTransport, event, instanceIdDb, false, seconds(2), 2,
+        milliseconds(100), 2);
+    std::vector<uint8_t> instanceIds;
+    for (auto i = 0; i < 3; i++)
+    {
+        pldm::Request request{};
+        auto instanceId = instanceIdDb.next(eid);
+        instanceIds.emplace_back(instanceId);
+        auto rc = reqHandler.registerRequest(
+            eid, instanceId, 0, 0, std::move(request),
+            std::move(
+                std::bind_front(&HandlerTest::pldmResponseCallBack, this)));
+        EXPECT_EQ(rc, PLDM_SUCCESS);
+    }
+
+    pldm::Response response(sizeof(pldm_msg_hdr) + sizeof(uint8_t));
+    auto responsePtr = reinterpret_cast<const pldm_msg*>(response.data());
+
+    // The second request is in the window, its response can be handled out
+    // of order before the first one
+    reqHandler.handleResponse(eid, instanceIds[1], 0, 0, responsePtr,
+                              sizeof(response));
+    EXPECT_EQ(callbackCount, 1);
+
+    // The third request is sent after the slot of the second one is released
+    reqHandler.handleResponse(eid, instanceIds[2], 0, 0, responsePtr,
+                              sizeof(response));
+    EXPECT_EQ(callbackCount, 2);
+
+    reqHandler.handleResponse(eid, instanceIds[0], 0, 0, responsePtr,
+                              sizeof(response));
+    EXPECT_EQ(validResponse, true);
+    EXPECT_EQ(nullResponse, false);
+    EXPECT_EQ(callbackCount, 3);
+}
+
+TEST_F(HandlerTest, priorityRequestScenario)
+{
+    Handler<NiceMock<MockRequest>> reqHandler(pldmTransport, event,
+                                              instanceIdDb, false, seconds(2),
+                                              2, milliseconds(100));
+    std::vector<uint8_t> responseOrder;
+    auto registerRequest = [&](uint8_t instanceId, RequestPriority priority) {
+        pldm::Request request{};
+        return reqHandler.registerRequest(
+            eid, instanceId, 0, 0, std::move(request),
+            [&responseOrder, instanceId](mctp_eid_t, const pldm_msg*, size_t) {
+                responseOrder.emplace_back(instanceId);
+            },
+            priority);
+    };
+
+    // The first request is sent immediately, the others are queued
+    auto telemetryId = instanceIdDb.next(eid);
+    EXPECT_EQ(registerRequest(telemetryId, RequestPriority::Telemetry),
+              PLDM_SUCCESS);
+    auto telemetryIdNxt = instanceIdDb.next(eid);
+    EXPECT_EQ(registerRequest(telemetryIdNxt, RequestPriority::Telemetry),
+              PLDM_SUCCESS);
+    auto rasId = instanceIdDb.next(eid);
+    EXPECT_EQ(registerRequest(rasId, RequestPriority::CriticalRas),
+              PLDM_SUCCESS);
+
+    pldm::Response response(sizeof(pldm_msg_hdr) + sizeof(uint8_t));
+    auto responsePtr = reinterpret_cast<const pldm_msg*>(response.data());
+    reqHandler.handleResponse(eid, telemetryId, 0, 0, responsePtr,
+                              sizeof(response));
+    // The RAS request pre-empts the queued telemetry request
+    reqHandler.handleResponse(eid, rasId, 0, 0, responsePtr, sizeof(response));
+    reqHandler.handleResponse(eid, telemetryIdNxt, 0, 0, responsePtr,
+                              sizeof(response));
+
+    EXPECT_EQ(responseOrder,
+              (std::vector<uint8_t>{telemetryId, rasId, telemetryIdNxt}));
+}
+
+TEST(EndpointMessageQueueTest, starvationGuard)
+{
+    EndpointMessageQueue endpointQueue{};
+    auto telemetry = static_cast<size_t>(RequestPriority::Telemetry);
+    auto ras = static_cast<size_t>(RequestPriority::CriticalRas);
+    endpointQueue.requestQueues[telemetry].emplace_back(
+        std::make_shared<RegisteredRequest>());
+    for (auto i = 0; i <= requestStarvationLimit; i++)
+    {
+        endpointQueue.requestQueues[ras].emplace_back(
+            std::make_shared<RegisteredRequest>());
+    }
+
+    for (auto i = 0; i < requestStarvationLimit; i++)
+    {
+        endpointQueue.popNext();
+        EXPECT_EQ(endpointQueue.requestQueues[telemetry].size(), 1);
+    }
+    // The telemetry request is served once after being passed over
+    endpointQueue.popNext();
+    EXPECT_EQ(endpointQueue.requestQueues[telemetry].size(), 0);
+    EXPECT_EQ(endpointQueue.requestQueues[ras].size(), 1);
+}
+
+TEST(EndpointMessageQueueTest, ineligibleClassWaits)
+{
+    EndpointMessageQueue endpointQueue{};
+    auto bulk = static_cast<size_t>(RequestPriority::Bulk);
+    auto telemetry = static_cast<size_t>(RequestPriority::Telemetry);
+    endpointQueue.requestQueues[bulk].emplace_back(
+        std::make_shared<RegisteredRequest>());
+    endpointQueue.requestQueues[telemetry].emplace_back(
+        std::make_shared<RegisteredRequest>());
+
+    // The higher class out of budget is neither served nor passed over
+    RequestClasses eligible;
+    eligible.set(bulk);
+    endpointQueue.popNext(eligible);
+    EXPECT_EQ(endpointQueue.requestQueues[bulk].size(), 0);
+    EXPECT_EQ(endpointQueue.requestQueues[telemetry].size(), 1);
+    EXPECT_EQ(endpointQueue.skippedCounts[telemetry], 0);
+
+    eligible.reset();
+    EXPECT_FALSE(endpointQueue.hasNext(eligible));
+    EXPECT_EQ(endpointQueue.popNext(eligible), nullptr);
+    eligible.set(telemetry);
+    EXPECT_TRUE(endpointQueue.hasNext(eligible));
+}
+
+TEST_F(HandlerTest, identicalReadsShareOneResponse)
+{
+    Handler<NiceMock<MockRequest>> reqHandler(pldmTransport, event,
+                                              instanceIdDb, false, seconds(2),
+                                              2, milliseconds(100), 2);
+    auto registerRead = [&](uint8_t instanceId, uint8_t sensorId) {
+        pldm::Request request(sizeof(pldm_msg_hdr) + 3);
+        request[sizeof(pldm_msg_hdr)] = sensorId;
+        return reqHandler.registerRequest(
+            eid, instanceId, PLDM_PLATFORM, PLDM_GET_SENSOR_READING,
+            std::move(request),
+            std::move(
+                std::bind_front(&HandlerTest::pldmResponseCallBack, this)));
+    };
+
+    auto instanceId = instanceIdDb.next(eid);
+    EXPECT_EQ(registerRead(instanceId, 1), PLDM_SUCCESS);
+    // The identical read waits for the first one, its instance ID is freed
+    auto instanceIdDup = instanceIdDb.next(eid);
+    EXPECT_EQ(registerRead(instanceIdDup, 1), PLDM_SUCCESS);
+    // A read of another sensor is sent on its own
+    auto instanceIdOther = instanceIdDb.next(eid);
+    EXPECT_EQ(registerRead(instanceIdOther, 2), PLDM_SUCCESS);
+
+    pldm::Response response(sizeof(pldm_msg_hdr) + sizeof(uint8_t));
+    auto responsePtr = reinterpret_cast<const pldm_msg*>(response.data());
+    reqHandler.handleResponse(eid, instanceId, PLDM_PLATFORM,
+                              PLDM_GET_SENSOR_READING, responsePtr,
+                              sizeof(response));
+    EXPECT_EQ(callbackCount, 2);
+
+    reqHandler.handleResponse(eid, instanceIdOther, PLDM_PLATFORM,
+                              PLDM_GET_SENSOR_READING, responsePtr,
+                              sizeof(response));
+    EXPECT_EQ(callbackCount, 3);
+    EXPECT_EQ(nullResponse, false);
+}
@@ -0,0 +1,121 @@
+#include "requester/oem_sensor_readings.hpp"
+
+#include <array>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::terminus;
+
+TEST(OemSensorReadings, EncodeRequest)
+{
+    std::array<uint16_t, 3> sensorIds{0x0102, 0x0304, 0x0506};
+    std::vector<uint8_t> requestMsg(sizeof(pldm_msg_hdr) +
+                                    oemGetSensorReadingsReqBytes(3));
+    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+
+    ASSERT_EQ(encodeOemGetSensorReadingsReq(5, sensorIds, request,
+                                            oemGetSensorReadingsReqBytes(3)),
+              PLDM_SUCCESS);
+    EXPECT_EQ(request->hdr.instance_id, 5);
+    EXPECT_EQ(request->hdr.type, PLDM_OEM);
+    EXPECT_EQ(request->hdr.command, PLDM_OEM_GET_SENSOR_READINGS);
+    std::vector<uint8_t> payload(request->payload,
+                                 request->payload +
+                                     oemGetSensorReadingsReqBytes(3));
+    EXPECT_EQ(payload, (std::vector<uint8_t>{3, 0x02, 0x01, 0x04, 0x03, 0x06,
+                                             0x05}));
+}
+
+TEST(OemSensorReadings, EncodeRequestBadArguments)
+{
+    std::vector<uint16_t> sensorIds(PLDM_OEM_GET_SENSOR_READINGS_MAX + 1);
+    std::vector<uint8_t> requestMsg(
+        sizeof(pldm_msg_hdr) + oemGetSensorReadingsReqBytes(sensorIds.size()));
+    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+
+    EXPECT_EQ(encodeOemGetSensorReadingsReq(
+                  0, {}, request, oemGetSensorReadingsReqBytes(0)),
+              PLDM_ERROR_INVALID_DATA);
+    EXPECT_EQ(encodeOemGetSensorReadingsReq(
+                  0, sensorIds, request,
+                  oemGetSensorReadingsReqBytes(sensorIds.size())),
+              PLDM_ERROR_INVALID_DATA);
+    EXPECT_EQ(encodeOemGetSensorReadingsReq(
+                  0, std::span(sensorIds).first(2), request,
+                  oemGetSensorReadingsReqBytes(3)),
+              PLDM_ERROR_INVALID_LENGTH);
+}
+
+TEST(OemSensorReadings, DecodeResponse)
+{
+    std::vector<uint8_t> responseMsg(sizeof(pldm_msg_hdr));
+    std::vector<uint8_t> payload{
+        PLDM_SUCCESS, 3,
+        /* sensor 1, uint8 */
+        0x01, 0x00, PLDM_SENSOR_DATA_SIZE_UINT8, PLDM_SENSOR_ENABLED, 0, 0x2a,
+        /* sensor 0x0102, sint16 */
+        0x02, 0x01, PLDM_SENSOR_DATA_SIZE_SINT16, PLDM_SENSOR_ENABLED, 1, 0xfe,
+        0xff,
+        /* sensor 3, uint32 */
+        0x03, 0x00, PLDM_SENSOR_DATA_SIZE_UINT32, PLDM_SENSOR_DISABLED, 0,
+        0x78, 0x56, 0x34, 0x12};
+    responseMsg.insert(responseMsg.end(), payload.begin(), payload.end());
+    auto response = reinterpret_cast<const pldm_msg*>(responseMsg.data());
+
+    uint8_t cc = 0xff;
+    std::vector<OemSensorReading> readings;
+    ASSERT_EQ(decodeOemGetSensorReadingsResp(response, payload.size(), cc,
+                                             readings),
+              PLDM_SUCCESS);
+    EXPECT_EQ(cc, PLDM_SUCCESS);
+    ASSERT_EQ(readings.size(), 3u);
+    EXPECT_EQ(readings[0].sensorId, 1);
+    EXPECT_EQ(readings[0].presentReading.value_u8, 0x2a);
+    EXPECT_EQ(readings[1].sensorId, 0x0102);
+    EXPECT_EQ(readings[1].eventMessageEnable, 1);
+    EXPECT_EQ(readings[1].presentReading.value_s16, -2);
+    EXPECT_EQ(readings[2].operationalState, PLDM_SENSOR_DISABLED);
+    EXPECT_EQ(readings[2].presentReading.value_u32, 0x12345678u);
+}
+
+TEST(OemSensorReadings, DecodeErrorResponse)
+{
+    std::vector<uint8_t> responseMsg(sizeof(pldm_msg_hdr));
+    responseMsg.push_back(PLDM_ERROR_UNSUPPORTED_PLDM_CMD);
+    auto response = reinterpret_cast<const pldm_msg*>(responseMsg.data());
+
+    uint8_t cc = 0;
+    std::vector<OemSensorReading> readings;
+    EXPECT_EQ(decodeOemGetSensorReadingsResp(response, 1, cc, readings),
+              PLDM_SUCCESS);
+    EXPECT_EQ(cc, PLDM_ERROR_UNSUPPORTED_PLDM_CMD);
+    EXPECT_TRUE(readings.empty());
+}
+
+TEST(OemSensorReadings, DecodeTruncatedResponse)
+{
+    std::vector<uint8_t> responseMsg(sizeof(pldm_msg_hdr));
+    std::vector<uint8_t> payload{PLDM_SUCCESS, 2,
+                                 0x01, 0x00, PLDM_SENSOR_DATA_SIZE_UINT8,
+                                 PLDM_SENSOR_ENABLED, 0, 0x2a,
+                                 0x02, 0x00, PLDM_SENSOR_DATA_SIZE_UINT32,
+                                 PLDM_SENSOR_ENABLED, 0, 0x01, 0x02};
+    responseMsg.insert(responseMsg.end(), payload.begin(), payload.end());
+    auto response = reinterpret_cast<const pldm_msg*>(responseMsg.data());
+
+    uint8_t cc = 0xff;
+    std::vector<OemSensorReading> readings;
+    EXPECT_EQ(decodeOemGetSensorReadingsResp(response, payload.size(), cc,
+                                             readings),
+              PLDM_ERROR_INVALID_LENGTH);
+    EXPECT_TRUE(readings.empty());
+
+    payload[4] = 0x40;
+    responseMsg.resize(sizeof(pldm_msg_hdr));
+    responseMsg.insert(responseMsg.end(), payload.begin(), payload.end());
+    response = reinterpret_cast<const pldm_msg*>(responseMsg.data());
+    EXPECT_EQ(decodeOemGetSensorReadingsResp(response, payload.size(), cc,
+                                             readings),
+              PLDM_ERROR_INVALID_DATA);
+}
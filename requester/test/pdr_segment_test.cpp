@@ -0,0 +1,75 @@
+#include "requester/pdr_segment.hpp"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::terminus;
+
+TEST(PdrSegment, FindsByBmcRecordHandle)
+{
+    PdrSegment segment;
+    std::vector<uint8_t> first{1, 2, 3};
+    std::vector<uint8_t> second(300, 0xab);
+    segment.add(10, first);
+    segment.add(11, second);
+
+    auto view = segment.find(10);
+    EXPECT_EQ(std::vector<uint8_t>(view.begin(), view.end()), first);
+    EXPECT_EQ(segment.find(11).size(), second.size());
+    EXPECT_TRUE(segment.find(9).empty());
+    EXPECT_TRUE(segment.find(12).empty());
+    EXPECT_EQ(segment.size(), 2);
+    EXPECT_EQ(segment.bytes(), first.size() + second.size());
+}
+
+TEST(PdrSegment, EraseKeepsTheOtherViews)
+{
+    PdrSegment segment;
+    std::vector<uint8_t> first{1, 2, 3};
+    std::vector<uint8_t> second{4, 5};
+    segment.add(1, first);
+    segment.add(2, second);
+    auto view = segment.find(2);
+
+    segment.erase(1);
+    EXPECT_TRUE(segment.find(1).empty());
+    EXPECT_EQ(segment.find(2).data(), view.data());
+    EXPECT_EQ(segment.bytes(), second.size());
+
+    /* The erased bytes now outweigh the others, the PDRs are moved */
+    segment.compact();
+    auto moved = segment.find(2);
+    EXPECT_EQ(std::vector<uint8_t>(moved.begin(), moved.end()), second);
+}
+
+TEST(PdrSegment, AddReplacesAndClearDropsAll)
+{
+    PdrSegment segment;
+    segment.add(5, std::vector<uint8_t>{1});
+    segment.add(5, std::vector<uint8_t>{2, 3});
+    EXPECT_EQ(segment.size(), 1);
+    EXPECT_EQ(segment.find(5).size(), 2);
+    EXPECT_EQ(segment.bytes(), 2);
+
+    segment.clear();
+    EXPECT_EQ(segment.size(), 0);
+    EXPECT_EQ(segment.bytes(), 0);
+    EXPECT_TRUE(segment.find(5).empty());
+
+    segment.add(7, std::vector<uint8_t>{9});
+    EXPECT_EQ(segment.find(7)[0], 9);
+}
+
+TEST(PdrSegment, ReservedUpFront)
+{
+    PdrSegment segment;
+    segment.reserve(64, 64 * 100);
+    for (uint32_t handle = 1; handle <= 64; handle++)
+    {
+        segment.add(handle, std::vector<uint8_t>(100, handle));
+    }
+    EXPECT_EQ(segment.size(), 64);
+    EXPECT_EQ(segment.bytes(), 64 * 100);
+    EXPECT_EQ(segment.find(64)[99], 64);
+}
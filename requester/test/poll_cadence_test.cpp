@@ -0,0 +1,48 @@
+#include "requester/poll_cadence.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace pldm;
+using namespace std::chrono_literals;
+
+TEST(PollCadence, BackOffToMax)
+{
+    PollCadence cadence(5000ms, 60000ms);
+    EXPECT_EQ(cadence.current(), 5000ms);
+    EXPECT_FALSE(cadence.isBackedOff());
+
+    EXPECT_EQ(cadence.idle(), 10000ms);
+    EXPECT_EQ(cadence.idle(), 20000ms);
+    EXPECT_EQ(cadence.idle(), 40000ms);
+    EXPECT_EQ(cadence.idle(), 60000ms);
+    EXPECT_EQ(cadence.idle(), 60000ms);
+    EXPECT_TRUE(cadence.isBackedOff());
+}
+
+TEST(PollCadence, SnapBackOnActivity)
+{
+    PollCadence cadence(5000ms, 60000ms);
+    cadence.idle();
+    cadence.idle();
+    EXPECT_EQ(cadence.busy(), 5000ms);
+    EXPECT_FALSE(cadence.isBackedOff());
+    EXPECT_EQ(cadence.idle(), 10000ms);
+}
+
+TEST(PollCadence, MaxBelowBase)
+{
+    PollCadence cadence(5000ms, 2000ms);
+    EXPECT_EQ(cadence.idle(), 5000ms);
+    EXPECT_FALSE(cadence.isBackedOff());
+}
+
+TEST(PollCadence, ResetToNewBase)
+{
+    PollCadence cadence(5000ms, 60000ms);
+    cadence.idle();
+    cadence.reset(1000ms, 4000ms);
+    EXPECT_EQ(cadence.current(), 1000ms);
+    EXPECT_EQ(cadence.idle(), 2000ms);
+    EXPECT_EQ(cadence.idle(), 4000ms);
+    EXPECT_EQ(cadence.idle(), 4000ms);
+}
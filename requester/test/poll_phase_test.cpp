@@ -0,0 +1,90 @@
+#include "requester/poll_phase.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm;
+using namespace std::chrono_literals;
+
+TEST(PollPhases, SpreadsTheSlots)
+{
+    EXPECT_DOUBLE_EQ(PollPhases::fractionOf(0), 0);
+    EXPECT_DOUBLE_EQ(PollPhases::fractionOf(1), 0.5);
+    EXPECT_DOUBLE_EQ(PollPhases::fractionOf(2), 0.25);
+    EXPECT_DOUBLE_EQ(PollPhases::fractionOf(3), 0.75);
+    EXPECT_DOUBLE_EQ(PollPhases::fractionOf(4), 0.125);
+}
+
+TEST(PollPhases, ReusesReleasedSlots)
+{
+    PollPhases phases;
+    auto first = phases.acquire();
+    auto second = phases.acquire();
+    EXPECT_EQ(first.index(), 0);
+    EXPECT_EQ(second.index(), 1);
+    {
+        auto third = phases.acquire();
+        EXPECT_EQ(third.index(), 2);
+        EXPECT_DOUBLE_EQ(third.phase().fraction, 0.25);
+    }
+    auto again = phases.acquire();
+    EXPECT_EQ(again.index(), 2);
+
+    /* A moved lease keeps its slot */
+    auto moved = std::move(second);
+    EXPECT_EQ(moved.index(), 1);
+    EXPECT_EQ(phases.acquire().index(), 3);
+}
+
+TEST(PollPhase, DelayReachesThePhase)
+{
+    PollPhase::Clock::time_point epoch{};
+    PollPhase phase{0.25, epoch};
+
+    EXPECT_EQ(phase.delay(1000ms, epoch), 250ms);
+    EXPECT_EQ(phase.delay(1000ms, epoch + 100ms), 150ms);
+    /* At the phase the poll waits for the next interval */
+    EXPECT_EQ(phase.delay(1000ms, epoch + 250ms), 1000ms);
+    EXPECT_EQ(phase.delay(1000ms, epoch + 5300ms), 950ms);
+
+    PollPhase zero{0, epoch};
+    EXPECT_EQ(zero.delay(1000ms, epoch + 400ms), 600ms);
+    EXPECT_DOUBLE_EQ(phase.shifted(0.875).fraction, 0.125);
+}
+
+TEST(PollPhase, TerminiStartedTogetherDoNotCollide)
+{
+    PollPhases phases;
+    auto now = PollPhase::Clock::now();
+    std::vector<PollPhases::Lease> leases;
+    std::vector<std::chrono::milliseconds> delays;
+    for (int i = 0; i < 4; i++)
+    {
+        leases.emplace_back(phases.acquire());
+        delays.emplace_back(leases.back().phase().delay(1000ms, now));
+    }
+    std::sort(delays.begin(), delays.end());
+    for (size_t i = 1; i < delays.size(); i++)
+    {
+        EXPECT_GE(delays[i] - delays[i - 1], 249ms);
+    }
+}
+
+TEST(PollPhase, TierRoundsDoNotOverlap)
+{
+    EXPECT_EQ(tierRoundOffset(1, 3), 0);
+    for (uint32_t shift = 0; shift < 4; shift++)
+    {
+        for (uint32_t round = 0; round < 64; round++)
+        {
+            int tiers = 0;
+            for (uint32_t rounds : {2u, 4u, 8u})
+            {
+                tiers += round % rounds == tierRoundOffset(rounds, shift);
+            }
+            EXPECT_LE(tiers, 1);
+        }
+    }
+}
@@ -0,0 +1,52 @@
+#include "requester/polling_profile.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace pldm;
+
+constexpr auto hostOff = "xyz.openbmc_project.State.Host.HostState.Off";
+constexpr auto hostRunning =
+    "xyz.openbmc_project.State.Host.HostState.Running";
+constexpr auto hostQuiesced =
+    "xyz.openbmc_project.State.Host.HostState.Quiesced";
+constexpr auto progressPrefix =
+    "xyz.openbmc_project.State.Boot.Progress.ProgressStages.";
+
+TEST(PollingProfile, SelectByHostState)
+{
+    std::string osRunning = std::string(progressPrefix) + "OSRunning";
+    std::string memoryInit = std::string(progressPrefix) + "MemoryInit";
+    std::string unspecified = std::string(progressPrefix) + "Unspecified";
+
+    EXPECT_EQ(selectPollingProfile(hostOff, osRunning), PollingProfile::Idle);
+    EXPECT_EQ(selectPollingProfile(hostQuiesced, osRunning),
+              PollingProfile::Quiesce);
+    EXPECT_EQ(selectPollingProfile(hostRunning, memoryInit),
+              PollingProfile::Boot);
+    EXPECT_EQ(selectPollingProfile(hostRunning, osRunning),
+              PollingProfile::Runtime);
+    /* The host does not report its boot progress */
+    EXPECT_EQ(selectPollingProfile(hostRunning, unspecified),
+              PollingProfile::Runtime);
+    EXPECT_EQ(selectPollingProfile("", ""), PollingProfile::Runtime);
+}
+
+TEST(PollingProfile, Names)
+{
+    EXPECT_EQ(toPollingProfile("boot"), PollingProfile::Boot);
+    EXPECT_EQ(toPollingProfile("quiesce"), PollingProfile::Quiesce);
+    EXPECT_FALSE(toPollingProfile("Boot").has_value());
+    for (size_t i = 0; i < pollingProfileCount; i++)
+    {
+        EXPECT_EQ(toPollingProfile(pollingProfileNames[i]),
+                  static_cast<PollingProfile>(i));
+    }
+}
+
+TEST(PollingProfile, DefaultsMatchTheBuild)
+{
+    PollingProfileSettings settings;
+    EXPECT_EQ(settings.sensorInterval.count(), POLL_SENSOR_TIMER_INTERVAL);
+    EXPECT_EQ(settings.rasInterval.count(), NORMAL_RAS_EVENT_TIMER);
+    EXPECT_EQ(settings.tierScale, 1);
+}
@@ -0,0 +1,55 @@
+#include "requester/priority_timer.hpp"
+
+#include <systemd/sd-event.h>
+
+#include <sdeventplus/event.hpp>
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+using namespace pldm;
+using namespace std::chrono_literals;
+
+TEST(PriorityTimer, DispatchedAheadOfTheNormalSources)
+{
+    auto event = sdeventplus::Event::get_new();
+    std::string order;
+    PriorityTimer normal(event, [&order]() { order += "n"; });
+    PriorityTimer critical(event, [&order]() { order += "c"; }, -10);
+    EXPECT_FALSE(critical.isEnabled());
+
+    normal.restartOnce(1ms);
+    critical.restartOnce(1ms);
+    /* Both are pending once the loop runs */
+    std::this_thread::sleep_for(5ms);
+    for (int i = 0; i < 100 && order.size() < 2; i++)
+    {
+        event.run(10ms);
+    }
+    EXPECT_EQ(order, "cn");
+    EXPECT_FALSE(normal.isEnabled());
+    EXPECT_FALSE(critical.isEnabled());
+}
+
+TEST(PriorityTimer, ExpiresAtTheInterval)
+{
+    auto event = sdeventplus::Event::get_new();
+    int expired = 0;
+    PriorityTimer timer(event, [&expired]() { expired++; },
+                        SD_EVENT_PRIORITY_IMPORTANT);
+
+    timer.restart(1ms);
+    for (int i = 0; i < 100 && expired < 3; i++)
+    {
+        event.run(10ms);
+    }
+    EXPECT_EQ(expired, 3);
+    EXPECT_TRUE(timer.isEnabled());
+
+    timer.setEnabled(false);
+    event.run(5ms);
+    EXPECT_EQ(expired, 3);
+}
@@ -0,0 +1,52 @@
+#include "requester/rtt_estimator.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace pldm::requester;
+using namespace std::chrono_literals;
+
+TEST(RttEstimator, InitialTimeout)
+{
+    RttEstimator estimator(2000ms, 100ms, 4800ms);
+    EXPECT_EQ(estimator.current(), 2000ms);
+    EXPECT_EQ(estimator.smoothed(), 0us);
+}
+
+TEST(RttEstimator, ConvergesToSamples)
+{
+    RttEstimator estimator(2000ms, 10ms, 4800ms);
+    /* First sample: SRTT = R, RTTVAR = R / 2, timeout = 3 * R */
+    estimator.sample(20ms);
+    EXPECT_EQ(estimator.smoothed(), 20ms);
+    EXPECT_EQ(estimator.current(), 60ms);
+
+    /* A steady RTT shrinks the deviation towards the floor */
+    for (int i = 0; i < 50; i++)
+    {
+        estimator.sample(20ms);
+    }
+    EXPECT_EQ(estimator.smoothed(), 20ms);
+    EXPECT_LT(estimator.current(), 25ms);
+    EXPECT_GE(estimator.current(), 20ms);
+}
+
+TEST(RttEstimator, FloorAndCap)
+{
+    RttEstimator estimator(2000ms, 100ms, 1000ms);
+    EXPECT_EQ(estimator.current(), 1000ms);
+    estimator.sample(1ms);
+    EXPECT_EQ(estimator.current(), 100ms);
+    estimator.sample(900ms);
+    EXPECT_EQ(estimator.current(), 1000ms);
+}
+
+TEST(RttEstimator, Backoff)
+{
+    RttEstimator estimator(300ms, 100ms, 1000ms);
+    estimator.backoff();
+    EXPECT_EQ(estimator.current(), 600ms);
+    estimator.backoff();
+    EXPECT_EQ(estimator.current(), 1000ms);
+    estimator.sample(50ms);
+    EXPECT_EQ(estimator.current(), 150ms);
+}
@@ -0,0 +1,89 @@
+#include "requester/sensor_event_coalescer.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace pldm;
+using namespace std::chrono_literals;
+
+namespace
+{
+
+SensorEventCoalescer::Event sensorEvent(uint16_t sensorId, uint8_t state,
+                                        uint32_t reading)
+{
+    return {1, sensorId, state, PLDM_SENSOR_DATA_SIZE_UINT32, reading};
+}
+
+} // namespace
+
+TEST(SensorEventCoalescer, FirstEventPassesThrough)
+{
+    SensorEventCoalescer coalescer(500ms);
+    SensorEventCoalescer::Clock::time_point now{};
+
+    EXPECT_TRUE(coalescer.add(sensorEvent(1, PLDM_SENSOR_NORMAL, 10), now));
+    /* Another sensor has its own window */
+    EXPECT_TRUE(coalescer.add(sensorEvent(2, PLDM_SENSOR_NORMAL, 20), now));
+    EXPECT_EQ(coalescer.coalesced(), 0);
+    EXPECT_EQ(coalescer.nextDeadline(), now + 500ms);
+
+    /* Nothing is held, the windows are forgotten once they end */
+    EXPECT_TRUE(coalescer.expire(now + 500ms).empty());
+    EXPECT_FALSE(coalescer.nextDeadline());
+    EXPECT_TRUE(
+        coalescer.add(sensorEvent(1, PLDM_SENSOR_NORMAL, 11), now + 600ms));
+}
+
+TEST(SensorEventCoalescer, KeepsTheLatestEvent)
+{
+    SensorEventCoalescer coalescer(500ms);
+    SensorEventCoalescer::Clock::time_point now{};
+
+    EXPECT_TRUE(coalescer.add(sensorEvent(1, PLDM_SENSOR_NORMAL, 10), now));
+    for (uint32_t reading = 11; reading < 20; reading++)
+    {
+        EXPECT_FALSE(coalescer.add(sensorEvent(1, PLDM_SENSOR_NORMAL, reading),
+                                   now + 10ms * reading));
+    }
+    EXPECT_EQ(coalescer.coalesced(), 9);
+    EXPECT_TRUE(coalescer.expire(now + 499ms).empty());
+
+    auto released = coalescer.expire(now + 500ms);
+    ASSERT_EQ(released.size(), 1);
+    EXPECT_EQ(released[0], sensorEvent(1, PLDM_SENSOR_NORMAL, 19));
+
+    /* A new window opens at the release */
+    EXPECT_EQ(coalescer.nextDeadline(), now + 1000ms);
+    EXPECT_FALSE(
+        coalescer.add(sensorEvent(1, PLDM_SENSOR_NORMAL, 20), now + 600ms));
+}
+
+TEST(SensorEventCoalescer, KeepsTheMostSevereEvent)
+{
+    SensorEventCoalescer coalescer(500ms);
+    SensorEventCoalescer::Clock::time_point now{};
+
+    EXPECT_TRUE(coalescer.add(sensorEvent(1, PLDM_SENSOR_NORMAL, 10), now));
+    EXPECT_FALSE(coalescer.add(sensorEvent(1, PLDM_SENSOR_UPPERWARNING, 80),
+                               now + 100ms));
+    EXPECT_FALSE(coalescer.add(sensorEvent(1, PLDM_SENSOR_UPPERCRITICAL, 95),
+                               now + 200ms));
+    EXPECT_FALSE(coalescer.add(sensorEvent(1, PLDM_SENSOR_UPPERWARNING, 85),
+                               now + 300ms));
+    EXPECT_FALSE(
+        coalescer.add(sensorEvent(1, PLDM_SENSOR_NORMAL, 50), now + 400ms));
+
+    auto released = coalescer.expire(now + 500ms);
+    ASSERT_EQ(released.size(), 2);
+    EXPECT_EQ(released[0], sensorEvent(1, PLDM_SENSOR_UPPERCRITICAL, 95));
+    EXPECT_EQ(released[1], sensorEvent(1, PLDM_SENSOR_NORMAL, 50));
+}
+
+TEST(SensorEventCoalescer, Severity)
+{
+    EXPECT_EQ(SensorEventCoalescer::severity(PLDM_SENSOR_UNKNOWN), 0);
+    EXPECT_EQ(SensorEventCoalescer::severity(PLDM_SENSOR_NORMAL), 0);
+    EXPECT_EQ(SensorEventCoalescer::severity(PLDM_SENSOR_LOWERWARNING), 1);
+    EXPECT_EQ(SensorEventCoalescer::severity(PLDM_SENSOR_CRITICAL), 2);
+    EXPECT_EQ(SensorEventCoalescer::severity(PLDM_SENSOR_UPPERFATAL), 3);
+}
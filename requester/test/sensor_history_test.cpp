@@ -0,0 +1,68 @@
+#include "sensors/sensor_history.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+
+using namespace pldm::sensor;
+using namespace std::chrono_literals;
+
+TEST(SensorHistory, RingKeepsTheLastReadings)
+{
+    SensorHistory history(3);
+    auto slot = history.allocate();
+    auto start = SensorHistory::Clock::now();
+    for (int i = 1; i <= 5; i++)
+    {
+        history.record(slot, i, start + i * 1s);
+    }
+
+    auto samples = history.samples(slot, 1h, start + 5s);
+    ASSERT_EQ(samples.size(), 3);
+    EXPECT_EQ(samples[0].value, 3);
+    EXPECT_EQ(samples[2].value, 5);
+}
+
+TEST(SensorHistory, AggregateOfAWindow)
+{
+    SensorHistory history(8);
+    auto slot = history.allocate();
+    auto start = SensorHistory::Clock::now();
+    history.record(slot, 100, start);
+    history.record(slot, 10, start + 1s);
+    history.record(slot, std::numeric_limits<double>::quiet_NaN(),
+                   start + 2s);
+    history.record(slot, 30, start + 3s);
+    history.record(slot, 20, start + 4s);
+
+    /* The first reading is out of the window */
+    auto aggregate = history.aggregate(slot, 3s, start + 4s);
+    EXPECT_EQ(aggregate.count, 3);
+    EXPECT_EQ(aggregate.unavailable, 1);
+    EXPECT_EQ(aggregate.min, 10);
+    EXPECT_EQ(aggregate.max, 30);
+    EXPECT_EQ(aggregate.average, 20);
+    EXPECT_EQ(aggregate.latest, 20);
+
+    auto empty = history.aggregate(slot, 1s, start + 1h);
+    EXPECT_EQ(empty.count, 0);
+    EXPECT_TRUE(std::isnan(empty.average));
+}
+
+TEST(SensorHistory, ReleasedSlotIsReused)
+{
+    SensorHistory history(2);
+    auto first = history.allocate();
+    auto second = history.allocate();
+    EXPECT_NE(first, second);
+    history.record(first, 1);
+    history.record(second, 2);
+
+    history.release(first);
+    auto reused = history.allocate();
+    EXPECT_EQ(reused, first);
+    EXPECT_TRUE(history.samples(reused, 1h).empty());
+    ASSERT_EQ(history.samples(second, 1h).size(), 1);
+    EXPECT_EQ(history.samples(second, 1h)[0].value, 2);
+}
@@ -0,0 +1,128 @@
+#include "sensors/sensor_stream.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace pldm::sensor;
+
+namespace
+{
+
+/** @brief Frames sent to each client */
+std::map<int, std::vector<std::vector<uint8_t>>> sent;
+
+SensorStream::SendResult record(int client, std::span<const uint8_t> frame)
+{
+    sent[client].emplace_back(frame.begin(), frame.end());
+    return SensorStream::SendResult::Sent;
+}
+
+template <typename T>
+T read(const std::vector<uint8_t>& frame, size_t offset)
+{
+    T value;
+    std::memcpy(&value, frame.data() + offset, sizeof(T));
+    return value;
+}
+
+std::vector<uint8_t> subscribeFrame(const std::string& prefix)
+{
+    std::vector<uint8_t> frame{static_cast<uint8_t>(StreamFrame::Subscribe)};
+    frame.insert(frame.end(), prefix.begin(), prefix.end());
+    frame.emplace_back(0);
+    return frame;
+}
+
+} // namespace
+
+TEST(SensorStream, InactiveStreamGivesNoId)
+{
+    SensorStream stream;
+    EXPECT_EQ(stream.addSensor("/xyz/openbmc_project/sensors/power/P0"), 0);
+}
+
+TEST(SensorStream, SubscribedReadingsAreCoalesced)
+{
+    sent.clear();
+    SensorStream stream;
+    size_t pendingCalls = 0;
+    stream.start(record, [&pendingCalls]() { pendingCalls++; });
+    auto power = stream.addSensor("/xyz/openbmc_project/sensors/power/P0");
+    auto temp = stream.addSensor("/xyz/openbmc_project/sensors/temperature/T0");
+
+    stream.addClient(5);
+    ASSERT_TRUE(
+        stream.receive(5, subscribeFrame("/xyz/openbmc_project/sensors/power/")));
+    ASSERT_EQ(sent[5].size(), 1);
+    const auto& sensors = sent[5][0];
+    EXPECT_EQ(sensors[0], static_cast<uint8_t>(StreamFrame::Sensors));
+    EXPECT_EQ(read<uint16_t>(sensors, 2), 1);
+    EXPECT_EQ(read<uint32_t>(sensors, 4), power);
+
+    /* Only the last reading of the subscribed sensor is sent */
+    stream.update(power, 100);
+    stream.update(temp, 40);
+    stream.update(power, 120);
+    EXPECT_EQ(pendingCalls, 1);
+    stream.flush();
+    ASSERT_EQ(sent[5].size(), 2);
+    const auto& update = sent[5][1];
+    EXPECT_EQ(update[0], static_cast<uint8_t>(StreamFrame::Update));
+    EXPECT_EQ(read<uint16_t>(update, 2), 1);
+    EXPECT_EQ(read<uint32_t>(update, 16), power);
+    EXPECT_EQ(read<double>(update, 20), 120);
+    EXPECT_EQ(update.size(), 28);
+
+    /* Nothing pending, nothing sent */
+    stream.flush();
+    EXPECT_EQ(sent[5].size(), 2);
+}
+
+TEST(SensorStream, LaterSensorsAndRemovals)
+{
+    sent.clear();
+    SensorStream stream;
+    stream.start(record);
+    stream.addClient(7);
+    ASSERT_TRUE(stream.receive(7, subscribeFrame("/xyz/openbmc_project/")));
+    /* No sensor yet */
+    EXPECT_TRUE(sent[7].empty());
+
+    auto id = stream.addSensor("/xyz/openbmc_project/sensors/power/P1");
+    ASSERT_EQ(sent[7].size(), 1);
+    EXPECT_EQ(sent[7][0][0], static_cast<uint8_t>(StreamFrame::Sensors));
+
+    stream.update(id, 1);
+    stream.removeSensor(id);
+    ASSERT_EQ(sent[7].size(), 2);
+    EXPECT_EQ(sent[7][1][0], static_cast<uint8_t>(StreamFrame::Removed));
+    EXPECT_EQ(read<uint32_t>(sent[7][1], 4), id);
+
+    /* The reading of the removed sensor is dropped */
+    stream.flush();
+    EXPECT_EQ(sent[7].size(), 2);
+}
+
+TEST(SensorStream, GoneClientIsRemoved)
+{
+    SensorStream stream;
+    size_t sends = 0;
+    stream.start([&sends](int, std::span<const uint8_t>) {
+        sends++;
+        return SensorStream::SendResult::Gone;
+    });
+    auto id = stream.addSensor("/xyz/openbmc_project/sensors/power/P2");
+    stream.addClient(3);
+    EXPECT_TRUE(stream.receive(3, subscribeFrame("")));
+    EXPECT_EQ(sends, 1);
+
+    /* The client and its subscription are gone */
+    stream.update(id, 1);
+    stream.flush();
+    EXPECT_EQ(sends, 1);
+    EXPECT_FALSE(stream.receive(3, subscribeFrame("")));
+}
@@ -0,0 +1,86 @@
+#include "requester/string_pool.hpp"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm;
+
+static std::vector<uint8_t> utf16Be(const std::u16string& str)
+{
+    std::vector<uint8_t> data;
+    for (auto unit : str)
+    {
+        data.emplace_back(unit >> 8);
+        data.emplace_back(unit & 0xff);
+    }
+    data.emplace_back(0);
+    data.emplace_back(0);
+    return data;
+}
+
+TEST(StringPool, InternOnce)
+{
+    StringPool pool;
+    std::string name = "CPU_0";
+    auto first = pool.intern(name);
+    auto second = pool.intern(std::string("CPU_0"));
+    EXPECT_EQ(first, "CPU_0");
+    EXPECT_EQ(first.data(), second.data());
+    EXPECT_NE(first.data(), name.data());
+    EXPECT_EQ(pool.intern(""), "");
+    EXPECT_EQ(pool.size(), 2);
+}
+
+TEST(StringPool, Utf16Be)
+{
+    StringPool pool;
+    auto data = utf16Be(u"Aé€\U0001F600");
+    data.emplace_back(0x12);
+    size_t consumed = 0;
+    auto str = pool.internUtf16Be(data, consumed);
+    EXPECT_EQ(str, "A\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80");
+    EXPECT_EQ(consumed, data.size() - 1);
+
+    /* The same name transcoded again is the pooled one */
+    auto again = pool.internUtf16Be(data, consumed);
+    EXPECT_EQ(again.data(), str.data());
+    EXPECT_EQ(pool.intern(std::string(str)).data(), str.data());
+    EXPECT_EQ(pool.size(), 1);
+}
+
+TEST(StringPool, Utf16BeMalformed)
+{
+    StringPool pool;
+    size_t consumed = 0;
+
+    /* An unpaired surrogate is replaced */
+    auto data = utf16Be(u"a");
+    data.insert(data.begin() + 2, {0xd8, 0x00});
+    EXPECT_EQ(pool.internUtf16Be(data, consumed), "a\xef\xbf\xbd");
+    EXPECT_EQ(consumed, data.size());
+
+    /* A name without its NUL unit ends with the data */
+    std::vector<uint8_t> truncated{0x00, 0x41, 0x00, 0x42, 0x00};
+    EXPECT_EQ(pool.internUtf16Be(truncated, consumed), "AB");
+    EXPECT_EQ(consumed, truncated.size());
+
+    EXPECT_EQ(pool.internUtf16Be({}, consumed), "");
+    EXPECT_EQ(consumed, 0);
+}
+
+TEST(StringPool, LargeStringsAndClear)
+{
+    StringPool pool;
+    std::string big(StringPool::chunkSize * 2, 'x');
+    auto small = pool.intern("small");
+    auto large = pool.intern(big);
+    EXPECT_EQ(large, big);
+    EXPECT_EQ(small, "small");
+    EXPECT_EQ(pool.intern("small").data(), small.data());
+
+    pool.clear();
+    EXPECT_EQ(pool.size(), 0);
+    EXPECT_EQ(pool.intern("small"), "small");
+}
@@ -0,0 +1,84 @@
+#include "requester/terminus_cache.hpp"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::terminus;
+
+class TerminusCacheTest : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        char tmpl[] = "/tmp/terminus_cache_test.XXXXXX";
+        dir = mkdtemp(tmpl);
+        path = dir / "terminus_8";
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(dir);
+    }
+
+    std::filesystem::path dir;
+    std::filesystem::path path;
+};
+
+TEST_F(TerminusCacheTest, saveAndLoad)
+{
+    TerminusCache cache;
+    cache.pdrSignature = {1, 2, 3, 4};
+    cache.pdrs.emplace_back(1, std::vector<uint8_t>{0x10, 0x11, 0x12});
+    cache.pdrs.emplace_back(7, std::vector<uint8_t>{});
+    cache.pdrs.emplace_back(9, std::vector<uint8_t>(300, 0xab));
+    cache.fruValid = true;
+    cache.fruChecksum = 0xdeadbeef;
+    cache.fruTable = {0x20, 0x21};
+    ASSERT_TRUE(cache.save(path));
+    EXPECT_FALSE(std::filesystem::exists(path.string() + ".tmp"));
+
+    TerminusCache loaded;
+    ASSERT_TRUE(loaded.load(path));
+    EXPECT_EQ(loaded.pdrSignature, cache.pdrSignature);
+    EXPECT_EQ(loaded.pdrs, cache.pdrs);
+    EXPECT_TRUE(loaded.fruValid);
+    EXPECT_EQ(loaded.fruChecksum, cache.fruChecksum);
+    EXPECT_EQ(loaded.fruTable, cache.fruTable);
+}
+
+TEST_F(TerminusCacheTest, missingFile)
+{
+    TerminusCache loaded;
+    EXPECT_FALSE(loaded.load(path));
+}
+
+TEST_F(TerminusCacheTest, truncatedFile)
+{
+    TerminusCache cache;
+    cache.pdrSignature = {1, 2, 3, 4};
+    cache.pdrs.emplace_back(1, std::vector<uint8_t>(64, 0x10));
+    ASSERT_TRUE(cache.save(path));
+
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    TerminusCache loaded;
+    loaded.pdrSignature = {5};
+    EXPECT_FALSE(loaded.load(path));
+    /* A failed load leaves the cache untouched */
+    EXPECT_EQ(loaded.pdrSignature, std::vector<uint8_t>{5});
+    EXPECT_TRUE(loaded.pdrs.empty());
+}
+
+TEST_F(TerminusCacheTest, badMagic)
+{
+    std::ofstream file(path, std::ios::binary);
+    std::vector<char> garbage(64, 0x5a);
+    file.write(garbage.data(), garbage.size());
+    file.close();
+
+    TerminusCache loaded;
+    EXPECT_FALSE(loaded.load(path));
+}
@@ -0,0 +1,60 @@
+#include "requester/terminus_tuning.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace pldm;
+using namespace std::chrono_literals;
+
+TEST(TerminusTuning, Names)
+{
+    EXPECT_EQ(toTuningKnob("SensorIntervalMs"), TuningKnob::SensorInterval);
+    EXPECT_EQ(toTuningKnob("Retries"), TuningKnob::Retries);
+    EXPECT_FALSE(toTuningKnob("retries").has_value());
+    for (size_t i = 0; i < tuningKnobCount; i++)
+    {
+        EXPECT_EQ(toTuningKnob(tuningKnobNames[i]),
+                  static_cast<TuningKnob>(i));
+    }
+}
+
+TEST(TerminusTuning, Validity)
+{
+    EXPECT_TRUE(isValidTuning(TuningKnob::Retries, 0));
+    EXPECT_TRUE(isValidTuning(TuningKnob::Retries, UINT8_MAX));
+    EXPECT_FALSE(isValidTuning(TuningKnob::Retries, UINT8_MAX + 1));
+    EXPECT_FALSE(isValidTuning(TuningKnob::SensorInterval, 0));
+    EXPECT_TRUE(isValidTuning(TuningKnob::RasInterval, 1));
+    EXPECT_FALSE(isValidTuning(TuningKnob::RasMaxInterval, 3600 * 1000 + 1));
+}
+
+TEST(TerminusTuning, OverridesTheProfile)
+{
+    PollingProfileSettings profile;
+    profile.sensorInterval = 1000ms;
+    profile.rasInterval = 500ms;
+    profile.tierScale = 4;
+
+    TerminusTuning tuning;
+    EXPECT_TRUE(tuning.empty());
+    EXPECT_EQ(tuning.apply(profile), profile);
+    EXPECT_FALSE(tuning.retries());
+
+    tuning.set(TuningKnob::SensorInterval, 250);
+    tuning.set(TuningKnob::SleepBetweenReads, 10);
+    tuning.set(TuningKnob::Retries, 0);
+    EXPECT_FALSE(tuning.empty());
+
+    auto settings = tuning.apply(profile);
+    EXPECT_EQ(settings.sensorInterval, 250ms);
+    EXPECT_EQ(settings.sleepBetweenReads, 10ms);
+    /* The knobs not set keep the profile */
+    EXPECT_EQ(settings.rasInterval, 500ms);
+    EXPECT_EQ(settings.rasMaxInterval, profile.rasMaxInterval);
+    EXPECT_EQ(settings.tierScale, 4);
+    EXPECT_EQ(tuning.retries(), 0);
+
+    tuning.set(TuningKnob::SensorInterval, std::nullopt);
+    tuning.set(TuningKnob::SleepBetweenReads, std::nullopt);
+    tuning.set(TuningKnob::Retries, std::nullopt);
+    EXPECT_TRUE(tuning.empty());
+}
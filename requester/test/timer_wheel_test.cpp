@@ -0,0 +1,83 @@
+#include "requester/timer_wheel.hpp"
+
+#include <sdeventplus/event.hpp>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace pldm::requester;
+using namespace std::chrono_literals;
+
+class TimerWheelTest : public testing::Test
+{
+  protected:
+    TimerWheelTest() :
+        event(sdeventplus::Event::get_default()), wheel(event),
+        start(TimerWheel::Clock::now())
+    {}
+
+    sdeventplus::Event event;
+    TimerWheel wheel;
+    TimerWheel::Clock::time_point start;
+};
+
+TEST_F(TimerWheelTest, FiresOnceDue)
+{
+    int fired = 0;
+    wheel.schedule(100ms, [&] { fired++; });
+    EXPECT_EQ(wheel.size(), 1);
+    wheel.process(start + 50ms);
+    EXPECT_EQ(fired, 0);
+    wheel.process(start + 130ms);
+    EXPECT_EQ(fired, 1);
+    EXPECT_EQ(wheel.size(), 0);
+    wheel.process(start + 300ms);
+    EXPECT_EQ(fired, 1);
+}
+
+TEST_F(TimerWheelTest, Cancel)
+{
+    int fired = 0;
+    auto id = wheel.schedule(100ms, [&] { fired++; });
+    wheel.schedule(200ms, [&] { fired += 10; });
+    wheel.cancel(id);
+    wheel.process(start + 500ms);
+    EXPECT_EQ(fired, 10);
+}
+
+TEST_F(TimerWheelTest, OrderAcrossLevels)
+{
+    /* 5s and 20s are beyond the 2.56s of the lowest level */
+    std::vector<int> order;
+    wheel.schedule(20s, [&] { order.push_back(3); });
+    wheel.schedule(5s, [&] { order.push_back(2); });
+    wheel.schedule(30ms, [&] { order.push_back(1); });
+    for (auto t = 0ms; t <= 21s; t += 100ms)
+    {
+        wheel.process(start + t);
+        if (t < 4900ms)
+        {
+            EXPECT_LE(order.size(), 1);
+        }
+        else if (t >= 5100ms && t < 19900ms)
+        {
+            EXPECT_EQ(order.size(), 2);
+        }
+    }
+    EXPECT_EQ(order, (std::vector<int>{1, 2, 3}));
+}
+
+TEST_F(TimerWheelTest, ScheduleFromCallback)
+{
+    int fired = 0;
+    wheel.schedule(100ms, [&] {
+        fired++;
+        wheel.schedule(100ms, [&] { fired++; });
+    });
+    wheel.process(start + 150ms);
+    EXPECT_EQ(fired, 1);
+    EXPECT_EQ(wheel.size(), 1);
+    wheel.process(start + 400ms);
+    EXPECT_EQ(fired, 2);
+}
@@ -0,0 +1,280 @@
+#pragma once
+
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/utility/timer.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace pldm
+{
+namespace requester
+{
+
+/** @class TimerWheel
+ *
+ *  Hierarchical timing wheel for the retry and expiry timeouts of all the
+ *  outstanding requests of a Handler, driven by a single sd-event timer.
+ *  Three levels of 256 slots cover 2.56s, ~11min and ~46h with the default
+ *  10ms tick. Scheduling and cancelling are O(1), an entry is moved down a
+ *  level when the lower wheel wraps. The sd-event timer is only armed for
+ *  the next non-empty slot or the next wrap, and is off while the wheel is
+ *  empty.
+ */
+class TimerWheel
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+    using Callback = std::function<void()>;
+    /** @brief Handle of a scheduled entry, 0 is never used */
+    using Id = uint64_t;
+
+    static constexpr size_t slotBits = 8;
+    static constexpr size_t numSlots = size_t(1) << slotBits;
+    static constexpr size_t numLevels = 3;
+
+    TimerWheel() = delete;
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    /** @brief Constructor
+     *
+     *  @param[in] event - event loop driving the wheel
+     *  @param[in] tick - resolution of the timeouts
+     */
+    explicit TimerWheel(
+        sdeventplus::Event& event,
+        std::chrono::milliseconds tick = std::chrono::milliseconds(10)) :
+        tick(std::max(tick, std::chrono::milliseconds(1))),
+        start(Clock::now()),
+        timer(event, std::bind(&TimerWheel::onTimer, this))
+    {}
+
+    /** @brief Schedule a callback
+     *
+     *  @param[in] delay - time from now, rounded up to the tick
+     *  @param[in] callback - invoked once from the event loop
+     *
+     *  @return - handle to cancel the entry
+     */
+    Id schedule(std::chrono::microseconds delay, Callback&& callback)
+    {
+        auto nowTick = tickAt(Clock::now());
+        if (entries.empty() && nowTick > currentTick)
+        {
+            reset(nowTick);
+        }
+        auto ticks = static_cast<uint64_t>((delay + tick - Clock::duration(1)) /
+                                           tick);
+        auto id = nextId++;
+        auto expiry = std::max(nowTick, currentTick) +
+                      std::max<uint64_t>(ticks, 1);
+        entries.emplace(id, Entry{expiry, std::move(callback)});
+        insert(id, expiry);
+
+        /* The wheel is visited at each wrap anyway */
+        auto next = std::min(expiry, nextWrap());
+        if (!armedTick || next < armedTick)
+        {
+            armAt(next);
+        }
+        return id;
+    }
+
+    /** @brief Cancel an entry, unknown or fired handles are ignored */
+    void cancel(Id id)
+    {
+        /* The slot keeps the stale handle until it is visited */
+        entries.erase(id);
+    }
+
+    /** @brief Number of scheduled entries */
+    size_t size() const
+    {
+        return entries.size();
+    }
+
+    /** @brief Fire the entries due at a time, called by the sd-event timer
+     *
+     *  @param[in] now - current time
+     */
+    void process(Clock::time_point now)
+    {
+        auto nowTick = tickAt(now);
+        armedTick = 0;
+        while (currentTick < nowTick && !entries.empty())
+        {
+            currentTick++;
+            cascade();
+            fire(levels[0][currentTick & (numSlots - 1)]);
+        }
+        if (entries.empty())
+        {
+            /* Nothing to wait for, jump so an idle wheel costs nothing */
+            if (nowTick > currentTick)
+            {
+                reset(nowTick);
+            }
+            timer.setEnabled(false);
+            return;
+        }
+
+        /* The next non-empty slot of the lowest level, or the next wrap
+         * where the upper levels are cascaded */
+        auto next = nextWrap();
+        for (auto t = currentTick + 1; t < next; t++)
+        {
+            if (!levels[0][t & (numSlots - 1)].empty())
+            {
+                next = t;
+                break;
+            }
+        }
+        armAt(next);
+    }
+
+  private:
+    struct Entry
+    {
+        uint64_t expiry; //!< tick at which the entry fires
+        Callback callback;
+    };
+
+    using Slot = std::vector<Id>;
+    using Level = std::array<Slot, numSlots>;
+
+    uint64_t tickAt(Clock::time_point now) const
+    {
+        return now > start ? static_cast<uint64_t>((now - start) / tick) : 0;
+    }
+
+    uint64_t nextWrap() const
+    {
+        return (currentTick | (numSlots - 1)) + 1;
+    }
+
+    /** @brief Move an empty wheel to a tick, dropping the stale handles */
+    void reset(uint64_t nowTick)
+    {
+        for (auto& level : levels)
+        {
+            for (auto& slot : level)
+            {
+                slot.clear();
+            }
+        }
+        currentTick = nowTick;
+    }
+
+    /** @brief Put an entry into the slot of the level matching its delay */
+    void insert(Id id, uint64_t expiry)
+    {
+        auto delta = expiry > currentTick ? expiry - currentTick : 0;
+        for (size_t i = 0; i < numLevels; i++)
+        {
+            if (delta < (uint64_t(1) << (slotBits * (i + 1))))
+            {
+                auto slot = (std::max(expiry, currentTick) >> (slotBits * i)) &
+                            (numSlots - 1);
+                levels[i][slot].push_back(id);
+                return;
+            }
+        }
+        /* Beyond the top level, park it in the last slot to revisit */
+        auto top = numLevels - 1;
+        auto slot = ((currentTick >> (slotBits * top)) + numSlots - 1) &
+                    (numSlots - 1);
+        levels[top][slot].push_back(id);
+    }
+
+    /** @brief Move the entries of the upper slots starting at this tick down
+     */
+    void cascade()
+    {
+        for (size_t i = 1; i < numLevels; i++)
+        {
+            if (currentTick & ((uint64_t(1) << (slotBits * i)) - 1))
+            {
+                break;
+            }
+            auto& slot =
+                levels[i][(currentTick >> (slotBits * i)) & (numSlots - 1)];
+            Slot moved;
+            moved.swap(slot);
+            for (auto id : moved)
+            {
+                auto it = entries.find(id);
+                if (it != entries.end())
+                {
+                    insert(id, it->second.expiry);
+                }
+            }
+        }
+    }
+
+    /** @brief Invoke the due entries of a slot */
+    void fire(Slot& slot)
+    {
+        if (slot.empty())
+        {
+            return;
+        }
+        Slot due;
+        due.swap(slot);
+        for (auto id : due)
+        {
+            auto it = entries.find(id);
+            if (it == entries.end())
+            {
+                continue;
+            }
+            if (it->second.expiry > currentTick)
+            {
+                /* A later turn of the wheel */
+                slot.push_back(id);
+                continue;
+            }
+            auto callback = std::move(it->second.callback);
+            entries.erase(it);
+            callback();
+        }
+    }
+
+    /** @brief Arm the sd-event timer for a tick */
+    void armAt(uint64_t next)
+    {
+        auto deadline = start + tick * next;
+        auto now = Clock::now();
+        auto remaining = deadline > now
+                             ? std::chrono::duration_cast<
+                                   std::chrono::microseconds>(deadline - now)
+                             : std::chrono::microseconds(0);
+        timer.restartOnce(remaining);
+        armedTick = next;
+    }
+
+    void onTimer()
+    {
+        process(Clock::now());
+    }
+
+    Clock::duration tick;
+    Clock::time_point start;
+    /** @brief Last tick processed */
+    uint64_t currentTick = 0;
+    /** @brief Tick the sd-event timer is armed for, 0 when disarmed */
+    uint64_t armedTick = 0;
+    Id nextId = 1;
+    std::array<Level, numLevels> levels{};
+    std::unordered_map<Id, Entry> entries;
+    sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> timer;
+};
+
+} // namespace requester
+} // namespace pldm
@@ -0,0 +1,224 @@
+#include "requester/tuning.hpp"
+
+#include "common/write_behind.hpp"
+
+#include <nlohmann/json.hpp>
+#include <phosphor-logging/lg2.hpp>
+
+#include <cerrno>
+#include <fstream>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace requester
+{
+
+Tuning::Tuning(sdbusplus::bus::bus& bus, const std::string& path,
+               const std::filesystem::path& persistPath, Changed changed) :
+    persistPath(persistPath),
+    changed(std::move(changed))
+{
+    load();
+
+    vtable.emplace_back(sdbusplus::vtable::start());
+    vtable.emplace_back(sdbusplus::vtable::method("SetKnob", "yst", "",
+                                                  &Tuning::setKnob));
+    vtable.emplace_back(sdbusplus::vtable::method("ResetKnob", "ys", "",
+                                                  &Tuning::resetKnob));
+    vtable.emplace_back(sdbusplus::vtable::method("GetKnobs", "y", "a{st}",
+                                                  &Tuning::getKnobs));
+    vtable.emplace_back(sdbusplus::vtable::end());
+    object = std::make_unique<sdbusplus::server::interface::interface>(
+        bus, path.c_str(), tuningIntf, vtable.data(), this);
+}
+
+const TerminusTuning& Tuning::get(uint8_t eid) const
+{
+    static const TerminusTuning untuned{};
+    auto it = termini.find(eid);
+    return it != termini.end() ? it->second : untuned;
+}
+
+void Tuning::load()
+{
+    if (!std::filesystem::exists(persistPath))
+    {
+        return;
+    }
+    std::ifstream jsonFile(persistPath);
+    auto data = nlohmann::json::parse(jsonFile, nullptr, false);
+    if (data.is_discarded() || !data.is_object())
+    {
+        error("Parsing the tuning file failed, FILE={FILE}", "FILE",
+              persistPath);
+        return;
+    }
+
+    auto entries = data.value("termini", nlohmann::json::object());
+    for (const auto& [eidName, knobs] : entries.items())
+    {
+        int eid = -1;
+        try
+        {
+            eid = std::stoi(eidName);
+        }
+        catch (const std::exception&)
+        {}
+        if (eid < 0 || eid > UINT8_MAX || !knobs.is_object())
+        {
+            error("Invalid tuned terminus {EID} in {FILE}", "EID", eidName,
+                  "FILE", persistPath);
+            continue;
+        }
+
+        TerminusTuning tuning;
+        for (const auto& [name, value] : knobs.items())
+        {
+            auto knob = toTuningKnob(name);
+            if (!knob || !value.is_number_unsigned() ||
+                !isValidTuning(*knob, value.get<uint64_t>()))
+            {
+                error("Invalid knob {KNOB} of EID {EID} in {FILE}", "KNOB",
+                      name, "EID", eid, "FILE", persistPath);
+                continue;
+            }
+            tuning.set(*knob, value.get<uint64_t>());
+        }
+        if (!tuning.empty())
+        {
+            termini[eid] = tuning;
+            info("Loaded the tuned knobs of EID {EID}", "EID", eid);
+        }
+    }
+}
+
+void Tuning::save() const
+{
+    auto entries = nlohmann::json::object();
+    for (const auto& [eid, tuning] : termini)
+    {
+        auto knobs = nlohmann::json::object();
+        for (size_t i = 0; i < tuningKnobCount; i++)
+        {
+            if (auto value = tuning.get(static_cast<TuningKnob>(i)))
+            {
+                knobs[std::string(tuningKnobNames[i])] = *value;
+            }
+        }
+        entries[std::to_string(eid)] = knobs;
+    }
+
+    /* Written behind as a temporary file renamed, a crash while saving
+     * leaves the previous knobs */
+    auto json = nlohmann::json{{"termini", entries}}.dump(4);
+    pldm::utils::persistFile(persistPath,
+                             std::vector<uint8_t>(json.begin(), json.end()),
+                             pldm::utils::Durability::Fsync);
+}
+
+int Tuning::update(sd_bus_message* msg, uint8_t eid, const char* name,
+                   std::optional<uint64_t> value)
+{
+    auto knob = toTuningKnob(name);
+    if (!knob)
+    {
+        return -EINVAL;
+    }
+    if (value && !isValidTuning(*knob, *value))
+    {
+        return -ERANGE;
+    }
+
+    auto& tuning = termini[eid];
+    tuning.set(*knob, value);
+    if (tuning.empty())
+    {
+        termini.erase(eid);
+    }
+    save();
+    if (value)
+    {
+        info("Knob {KNOB} of EID {EID} set to {VALUE}", "KNOB", name, "EID",
+             unsigned(eid), "VALUE", *value);
+    }
+    else
+    {
+        info("Knob {KNOB} of EID {EID} reset", "KNOB", name, "EID",
+             unsigned(eid));
+    }
+    if (changed)
+    {
+        changed(eid);
+    }
+    return sd_bus_reply_method_return(msg, "");
+}
+
+int Tuning::setKnob(sd_bus_message* msg, void* context,
+                    sd_bus_error* /*error*/)
+{
+    uint8_t eid = 0;
+    const char* name = nullptr;
+    uint64_t value = 0;
+    auto rc = sd_bus_message_read(msg, "yst", &eid, &name, &value);
+    if (rc < 0)
+    {
+        return rc;
+    }
+    return static_cast<Tuning*>(context)->update(msg, eid, name, value);
+}
+
+int Tuning::resetKnob(sd_bus_message* msg, void* context,
+                      sd_bus_error* /*error*/)
+{
+    uint8_t eid = 0;
+    const char* name = nullptr;
+    auto rc = sd_bus_message_read(msg, "ys", &eid, &name);
+    if (rc < 0)
+    {
+        return rc;
+    }
+    return static_cast<Tuning*>(context)->update(msg, eid, name,
+                                                 std::nullopt);
+}
+
+int Tuning::getKnobs(sd_bus_message* msg, void* context,
+                     sd_bus_error* /*error*/)
+{
+    uint8_t eid = 0;
+    auto rc = sd_bus_message_read(msg, "y", &eid);
+    if (rc < 0)
+    {
+        return rc;
+    }
+
+    const auto& tuning = static_cast<Tuning*>(context)->get(eid);
+    sd_bus_message* reply = nullptr;
+    rc = sd_bus_message_new_method_return(msg, &reply);
+    if (rc >= 0)
+    {
+        rc = sd_bus_message_open_container(reply, 'a', "{st}");
+    }
+    for (size_t i = 0; rc >= 0 && i < tuningKnobCount; i++)
+    {
+        if (auto value = tuning.get(static_cast<TuningKnob>(i)))
+        {
+            std::string name(tuningKnobNames[i]);
+            rc = sd_bus_message_append(reply, "{st}", name.c_str(), *value);
+        }
+    }
+    if (rc >= 0)
+    {
+        rc = sd_bus_message_close_container(reply);
+    }
+    if (rc >= 0)
+    {
+        rc = sd_bus_send(nullptr, reply, nullptr);
+    }
+    sd_bus_message_unref(reply);
+    return rc < 0 ? rc : 1;
+}
+
+} // namespace requester
+} // namespace pldm
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "requester/terminus_tuning.hpp"
+
+#include <systemd/sd-bus.h>
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/server/interface.hpp>
+#include <sdbusplus/vtable.hpp>
+
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace pldm
+{
+namespace requester
+{
+
+/** @brief D-Bus interface of the runtime tuning of the termini */
+constexpr auto tuningIntf = "xyz.openbmc_project.PLDM.Tuning";
+
+/** @class Tuning
+ *
+ *  Lets the performance knobs of tuningKnobNames be set per terminus at
+ *  runtime, over the methods SetKnob(y eid, s knob, t value),
+ *  ResetKnob(y eid, s knob) and GetKnobs(y eid) -> a{st}, the latter
+ *  returning the knobs set for the endpoint. A knob set takes precedence
+ *  over the polling profile and the build time default, it applies from the
+ *  next polling round or request of the terminus. The knobs are saved to a
+ *  JSON file after each change and loaded at startup:
+ *  {"termini": {"20": {"SensorIntervalMs": 2000, "Retries": 1}}}
+ */
+class Tuning
+{
+  public:
+    /** @brief Called with the EID of a terminus whose knobs changed */
+    using Changed = std::function<void(uint8_t eid)>;
+
+    Tuning() = delete;
+    Tuning(const Tuning&) = delete;
+    Tuning& operator=(const Tuning&) = delete;
+
+    /** @brief Put the tuning on the bus and load the saved knobs
+     *
+     *  @param[in] bus - D-Bus connection
+     *  @param[in] path - object path
+     *  @param[in] persistPath - JSON file of the saved knobs
+     *  @param[in] changed - called when the knobs of a terminus changed
+     */
+    Tuning(sdbusplus::bus::bus& bus, const std::string& path,
+           const std::filesystem::path& persistPath, Changed changed);
+
+    /** @brief Knobs set for a terminus, empty if none */
+    const TerminusTuning& get(uint8_t eid) const;
+
+  private:
+    /** @brief Load the saved knobs, a malformed file is ignored */
+    void load();
+
+    /** @brief Save the knobs, replacing the file atomically */
+    void save() const;
+
+    /** @brief Set or reset a knob of a D-Bus call and apply it
+     *
+     *  @return - 1 once replied, else -errno
+     */
+    int update(sd_bus_message* msg, uint8_t eid, const char* name,
+               std::optional<uint64_t> value);
+
+    /** @brief sd-bus handler of Tuning.SetKnob */
+    static int setKnob(sd_bus_message* msg, void* context,
+                       sd_bus_error* error);
+
+    /** @brief sd-bus handler of Tuning.ResetKnob */
+    static int resetKnob(sd_bus_message* msg, void* context,
+                         sd_bus_error* error);
+
+    /** @brief sd-bus handler of Tuning.GetKnobs */
+    static int getKnobs(sd_bus_message* msg, void* context,
+                        sd_bus_error* error);
+
+    std::filesystem::path persistPath;
+    Changed changed;
+    std::map<uint8_t, TerminusTuning> termini;
+    std::vector<sdbusplus::vtable::vtable_t> vtable;
+    std::unique_ptr<sdbusplus::server::interface::interface> object;
+};
+
+} // namespace requester
+} // namespace pldm
@@ -1,8 +1,12 @@
 #include "sensors/pldm_sensor.hpp"
 
+#include "common/startup_profile.hpp"
 #include "common/utils.hpp"
 #include "sensors/hwmon.hpp"
 
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <cmath>
@@ -87,17 +91,46 @@ PldmSensor::PldmSensor(sdbusplus::bus::bus& bus, const std::string& name,
                        double resolution, double warningHigh, double warningLow,
                        double criticalHigh, double criticalLow) :
     _bus(bus),
-    sensorName(name), baseUnit(baseUnit), unitModifier(unitModifier),
-    offset(offset), resolution(resolution), warningHigh(warningHigh),
-    warningLow(warningLow), criticalHigh(criticalHigh), criticalLow(criticalLow)
-{}
+    sensorPath(name), baseUnit(baseUnit),
+    limits(std::make_unique<Limits>(Limits{warningHigh, warningLow,
+                                           criticalHigh, criticalLow}))
+{
+    /* (raw * resolution + offset) * 10^unitModifier, as one multiply-add */
+    auto modifier = std::pow(10, signed(unitModifier));
+    scale = resolution * modifier;
+    bias = offset * modifier;
+}
 
 /**
  * @brief De-constructs PldmSensor object
  */
 PldmSensor::~PldmSensor()
 {
-    _bus.emit_object_removed(sensorPath.c_str());
+    if (history)
+    {
+        history->release(historySlot);
+    }
+    SensorStream::get().removeSensor(streamId);
+    retract();
+}
+
+void PldmSensor::announce()
+{
+    /* The path is built when the interfaces are created */
+    if (valueInterface && !announced)
+    {
+        valueInterface->emit_object_added();
+        announced = true;
+    }
+}
+
+void PldmSensor::retract()
+{
+    if (announced)
+    {
+        _bus.emit_object_removed(sensorPath.c_str());
+        announced = false;
+    }
 }
 
 /**
@@ -107,50 +140,54 @@ PldmSensor::~PldmSensor()
  *
  * @return - Shared pointer to the object data
  */
-std::optional<ObjectStateData> PldmSensor::createSensor()
+std::optional<ObjectStateData> PldmSensor::createSensor(bool announce)
 {
     Attributes attrs;
-    if (!std::isnan(warningLow))
-    {
-        warningLow = adjustValue(warningLow);
-    }
-    if (!std::isnan(warningHigh))
-    {
-        warningHigh = adjustValue(warningHigh);
-    }
-    if (!std::isnan(criticalLow))
-    {
-        criticalLow = adjustValue(criticalLow);
-    }
-    if (!std::isnan(criticalHigh))
-    {
-        criticalHigh = adjustValue(criticalHigh);
-    }
-    if (!std::isnan(sensorMaxValue))
+    if (!limits)
     {
-        sensorMaxValue = adjustValue(sensorMaxValue);
+        return {};
     }
-    if (!std::isnan(sensorMinValue))
+    /* The limits are only needed to create the interfaces, the thresholds
+     * are held by the threshold interfaces afterwards */
+    auto sensorLimits = std::move(limits);
+    for (auto limit : {&sensorLimits->warningHigh, &sensorLimits->warningLow,
+                       &sensorLimits->criticalHigh, &sensorLimits->criticalLow,
+                       &sensorLimits->maxValue, &sensorLimits->minValue})
     {
-        sensorMinValue = adjustValue(sensorMinValue);
+        if (!std::isnan(*limit))
+        {
+            *limit = adjustValue(*limit);
+        }
     }
     auto type = getAttributes(baseUnit, attrs);
     if (!type)
     {
-        std::cerr << "Failed to find sensor type: " << type
-                  << " Use default type. sensorId " << sensorName << std::endl;
+        lg2::warning("Failed to find sensor type of base unit {UNIT} of "
+                     "sensor {NAME}, use the default type",
+                     "UNIT", unsigned(baseUnit), "NAME", sensorPath);
         return {};
     }
 
-    sensorPath = _root + "/" + getNamespace(attrs) + "/" + sensorName;
+    std::string sensorName = std::move(sensorPath);
+    std::string_view sensorNamespace = getNamespace(attrs);
+    sensorPath.clear();
+    sensorPath.reserve(sensorRoot.size() + sensorNamespace.size() +
+                       sensorName.size() + 2);
+    sensorPath.append(sensorRoot)
+        .append("/")
+        .append(sensorNamespace)
+        .append("/");
+    nameOffset = sensorPath.size();
+    sensorPath.append(sensorName);
 
     double sensorValue = std::numeric_limits<double>::quiet_NaN();
-    ObjectInfo info(&_bus, std::move(sensorPath), InterfaceMap());
+    ObjectInfo info(&_bus, sensorPath, InterfaceMap());
     try
     {
         statusInterface = addStatusInterface(info, true);
-        valueInterface = addValueInterface(info, sensorValue, sensorMaxValue,
-                                           sensorMinValue);
+        valueInterface = addValueInterface(info, sensorValue,
+                                           sensorLimits->maxValue,
+                                           sensorLimits->minValue);
         if (!valueInterface)
         {
             return {};
@@ -161,11 +198,19 @@ std::optional<ObjectStateData> PldmSensor::createSensor()
     {
         return {};
     }
-    warnObject =
-        addThreshold<WarningObject>(info, sensorValue, warningLow, warningHigh);
-    critObject = addThreshold<CriticalObject>(info, sensorValue, criticalLow,
-                                              criticalHigh);
-    valueInterface->emit_object_added();
+    warnObject = addThreshold<WarningObject>(info, sensorValue,
+                                             sensorLimits->warningLow,
+                                             sensorLimits->warningHigh,
+                                             warnState);
+    critObject = addThreshold<CriticalObject>(info, sensorValue,
+                                              sensorLimits->criticalLow,
+                                              sensorLimits->criticalHigh,
+                                              critState);
+    if (announce)
+    {
+        this->announce();
+    }
+    streamId = SensorStream::get().addSensor(sensorPath);
 
     return std::make_pair(sensorName, std::move(info));
 }
@@ -241,42 +286,145 @@ SensorValueType PldmSensor::adjustValue(SensorValueType value)
 
     if constexpr (std::is_same<SensorValueType, double>::value)
     {
-        value =
-            (value * resolution + offset) * std::pow(10, signed(unitModifier));
+        value = value * scale + bias;
     }
 
     return value;
 }
 
+/**
+ * @brief Approximate memory used by the sensor
+ */
+size_t PldmSensor::memoryUsage() const
+{
+    size_t size = sizeof(*this) + sensorPath.capacity();
+    if (limits)
+    {
+        size += sizeof(Limits);
+    }
+    if (valueInterface)
+    {
+        size += sizeof(ValueObject);
+    }
+    if (statusInterface)
+    {
+        size += sizeof(StatusObject);
+    }
+    if (warnObject)
+    {
+        size += sizeof(WarningThreshold);
+    }
+    if (critObject)
+    {
+        size += sizeof(CriticalThreshold);
+    }
+
+    return size;
+}
+
 /**
  * @brief Update sensor interfaces
  */
-void PldmSensor::updateValue(SensorValueType sensorValue)
+void PldmSensor::updateValue(SensorValueType sensorValue, bool deferEmit)
 {
     auto value = adjustValue(sensorValue);
-
-    if (value == lastValue)
+    if (history)
     {
-        return;
+        history->record(historySlot, value);
+    }
+    if (streamId)
+    {
+        SensorStream::get().update(streamId, value);
     }
-    lastValue = value;
-    valueInterface->value(lastValue);
 
-    if (!std::isnan(lastValue))
+    /* Thresholds are evaluated on every sample, with or without publishing */
+    if (!std::isnan(value))
     {
+        auto now = std::chrono::steady_clock::now();
+        if (staleness && lastRead != std::chrono::steady_clock::time_point{})
+        {
+            staleness->observe(now - lastRead);
+        }
+        lastRead = now;
+        lastReadWall = std::chrono::system_clock::now();
+
         if (warnObject)
         {
-            checkThresholds<WarningObject>(warnObject, lastValue);
+            checkThresholds<WarningObject>(*warnObject, warnState, value);
         }
         if (critObject)
         {
-            checkThresholds<CriticalObject>(critObject, lastValue);
+            checkThresholds<CriticalObject>(*critObject, critState, value);
         }
     }
 
+    if (value != lastValue && isPublishDue(value))
+    {
+        lastValue = value;
+        lastPublishTime = std::chrono::steady_clock::now();
+        valueInterface->value(lastValue, true);
+        valueChanged = true;
+        pldm::utils::StartupProfile::get().mark(
+            pldm::utils::StartupProfile::Phase::FirstSensorPublished);
+    }
+
+    if (!deferEmit)
+    {
+        emitPendingChanges();
+    }
+
     return;
 }
 
+/**
+ * @brief Check the deadband and the minimum publish interval
+ */
+bool PldmSensor::isPublishDue(SensorValueType value)
+{
+    /* Always publish the transitions from and to NaN */
+    if (std::isnan(value) || std::isnan(lastValue))
+    {
+        return true;
+    }
+
+    auto band = std::max(publishFilter.deadband,
+                         publishFilter.relativeDeadband * std::abs(lastValue));
+    if (std::abs(value - lastValue) <= band && band > 0)
+    {
+        return false;
+    }
+
+    if (publishFilter.minInterval.count() &&
+        std::chrono::steady_clock::now() - lastPublishTime <
+            publishFilter.minInterval)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Emit the deferred PropertiesChanged signals
+ */
+void PldmSensor::emitPendingChanges()
+{
+    if (valueChanged)
+    {
+        valueChanged = false;
+        sd_bus_emit_properties_changed(_bus.get(), sensorPath.c_str(),
+                                       ValueInterface::interface, "Value",
+                                       nullptr);
+    }
+    if (functionalChanged)
+    {
+        functionalChanged = false;
+        sd_bus_emit_properties_changed(_bus.get(), sensorPath.c_str(),
+                                       StatusInterface::interface,
+                                       "Functional", nullptr);
+    }
+}
+
 } // namespace sensor
 
 } // namespace pldm
\ No newline at end of file
@@ -1,15 +1,21 @@
 #pragma once
 
+#include "common/metrics.hpp"
 #include "common/types.hpp"
 #include "common/utils.hpp"
 #include "libpldmresponder/event_parser.hpp"
 #include "libpldmresponder/pdr_utils.hpp"
 #include "sensors/interface.hpp"
+#include "sensors/sensor_history.hpp"
+#include "sensors/sensor_stream.hpp"
 #include "sensors/thresholds.hpp"
 
+#include <chrono>
 #include <memory>
 #include <optional>
+#include <string_view>
 #include <unordered_set>
+#include <vector>
 
 namespace pldm
 {
@@ -19,6 +25,19 @@ namespace sensor
 
 using namespace pldm::sensor;
 
+/** @struct SensorPublishFilter
+ *  @brief Deadband and rate limit applied before publishing a sensor value
+ *  to D-Bus. A new value is published when it moves more than the larger of
+ *  the absolute and the relative deadband away from the published value and
+ *  the minimum publish interval has elapsed.
+ */
+struct SensorPublishFilter
+{
+    double deadband = 0;         //!< Absolute deadband in sensor units
+    double relativeDeadband = 0; //!< Deadband relative to the published value
+    std::chrono::milliseconds minInterval{0}; //!< Minimum publish interval
+};
+
 /** @class PldmSensor
  *  @brief Sensor object
  *  @details Sensor object to create and modify an associated device's sensor
@@ -57,9 +76,24 @@ class PldmSensor
      * @details After init the sensor data, call createSensor to create the
      * sensor interfaces such as value, functional status, thresholds
      *
+     * @param[in] announce - emit InterfacesAdded at once, else the caller
+     *                       announces the sensor with announce()
+     *
      * @return - Shared pointer to the object data
      */
-    std::optional<ObjectStateData> createSensor();
+    std::optional<ObjectStateData> createSensor(bool announce = true);
+
+    /**
+     * @brief Emit InterfacesAdded for the interfaces of the sensor, once
+     * they are created
+     */
+    void announce();
+
+    /**
+     * @brief Emit InterfacesRemoved for the interfaces of the sensor if they
+     * were announced, the destructor then emits nothing
+     */
+    void retract();
 
     /**
      * @brief Add value interface and value property for sensor
@@ -97,7 +131,8 @@ class PldmSensor
     /**
      * @brief Apply unitModifier to sensor value
      * @details Use unitModifier to modify the raw value from the PLDM
-     * interface.
+     * interface. The resolution, offset and unitModifier are folded into
+     * the scale and bias when the sensor is constructed.
      *
      * @param[in] value - Sensor value
      *
@@ -110,23 +145,43 @@ class PldmSensor
      * @details Update sensor value base on the return value from PLDM
      *
      * @param[in] sensorValue - Sensor value
+     * @param[in] deferEmit - Hold the PropertiesChanged signal until
+     *                        emitPendingChanges is called
      *
      * @return - none
      */
-    void updateValue(SensorValueType sensorValue);
+    void updateValue(SensorValueType sensorValue, bool deferEmit = false);
 
     /**
      * @brief Set sensor functional status
      *
      * @param[in] functional - functional status
+     * @param[in] deferEmit - Hold the PropertiesChanged signal until
+     *                        emitPendingChanges is called
      *
      * @return - none
      */
-    void setFunctionalStatus(bool functional)
+    void setFunctionalStatus(bool functional, bool deferEmit = false)
     {
-        statusInterface->functional(functional);
+        if (statusInterface->functional() != functional)
+        {
+            statusInterface->functional(functional, true);
+            functionalChanged = true;
+        }
+        if (!deferEmit)
+        {
+            emitPendingChanges();
+        }
     }
 
+    /**
+     * @brief Emit one PropertiesChanged signal per interface for the
+     * deferred value and functional status changes
+     *
+     * @return - none
+     */
+    void emitPendingChanges();
+
     /**
      * @brief Get sensor functional status
      *
@@ -137,50 +192,234 @@ class PldmSensor
         return statusInterface->functional();
     }
 
+    /**
+     * @brief Get the published sensor value
+     *
+     * @return - sensor value
+     */
+    SensorValueType getValue()
+    {
+        return lastValue;
+    }
+
     /**
      * @brief Get sensor path
      *
      * @return - sensor path
      */
-    std::string getSensorPath()
+    const std::string& getSensorPath() const
     {
         return sensorPath;
     }
 
+    /**
+     * @brief Get sensor name, the last element of the sensor path
+     *
+     * @return - sensor name
+     */
+    std::string_view getSensorName() const
+    {
+        return std::string_view(sensorPath).substr(nameOffset);
+    }
+
+    /**
+     * @brief Get the approximate memory used by the sensor and its D-Bus
+     * interfaces
+     *
+     * @return - size in bytes
+     */
+    size_t memoryUsage() const;
+
+    /**
+     * @brief Set the deadband and rate limit of the value publishing
+     *
+     * @param[in] filter - Publish filter
+     *
+     * @return - none
+     */
+    void setPublishFilter(const SensorPublishFilter& filter)
+    {
+        publishFilter = filter;
+    }
+
+    /**
+     * @brief Record the readings of the sensor in a history slot, the slot
+     * is given back when the sensor is destroyed
+     *
+     * @param[in] sensorHistory - history of the terminus, outlives the sensor
+     *
+     * @return - none
+     */
+    void attachHistory(SensorHistory& sensorHistory)
+    {
+        if (!history)
+        {
+            history = &sensorHistory;
+            historySlot = history->allocate();
+        }
+    }
+
+    /**
+     * @brief Check if the readings of the sensor are recorded
+     *
+     * @return - true if the sensor has a history slot
+     */
+    bool hasHistory() const
+    {
+        return history != nullptr;
+    }
+
+    /**
+     * @brief Aggregate of the readings of the sensor within a window
+     *
+     * @param[in] window - age of the oldest reading aggregated
+     *
+     * @return - the aggregate, nullopt if the history is not recorded
+     */
+    std::optional<HistoryAggregate>
+        getHistoryAggregate(SensorHistory::Clock::duration window) const
+    {
+        if (!history)
+        {
+            return std::nullopt;
+        }
+        return history->aggregate(historySlot, window);
+    }
+
+    /**
+     * @brief Readings of the sensor within a window, oldest first
+     *
+     * @param[in] window - age of the oldest reading returned
+     *
+     * @return - the readings, nullopt if the history is not recorded
+     */
+    std::optional<std::vector<HistorySample>>
+        getHistorySamples(SensorHistory::Clock::duration window) const
+    {
+        if (!history)
+        {
+            return std::nullopt;
+        }
+        return history->samples(historySlot, window);
+    }
+
+    /**
+     * @brief Record the age of each reading when the next one replaces it
+     *
+     * @param[in] histogram - staleness histogram of the terminus
+     */
+    void setStalenessHistogram(pldm::metrics::Histogram* histogram)
+    {
+        staleness = histogram;
+    }
+
+    /**
+     * @brief Monotonic time of the last successful read, the epoch if the
+     * sensor was never read
+     */
+    std::chrono::steady_clock::time_point lastReadTime() const
+    {
+        return lastRead;
+    }
+
+    /**
+     * @brief Wall clock time of the last successful read, the epoch if the
+     * sensor was never read
+     */
+    std::chrono::system_clock::time_point lastReadWallTime() const
+    {
+        return lastReadWall;
+    }
+
     void initMinMaxValue(double minValue, double maxValue)
     {
-        sensorMinValue = minValue;
-        sensorMaxValue = maxValue;
+        if (limits)
+        {
+            limits->minValue = minValue;
+            limits->maxValue = maxValue;
+        }
 
         return;
     }
 
   private:
-    std::string _root = "/xyz/openbmc_project/sensors";
+    /** @struct Limits
+     *  @brief Thresholds and range of the sensor until its interfaces are
+     *  created
+     */
+    struct Limits
+    {
+        double warningHigh;
+        double warningLow;
+        double criticalHigh;
+        double criticalLow;
+        double maxValue = std::numeric_limits<double>::quiet_NaN();
+        double minValue = std::numeric_limits<double>::quiet_NaN();
+    };
+
+    /** @brief Root of the sensor paths, shared by all the sensors */
+    static constexpr std::string_view sensorRoot =
+        "/xyz/openbmc_project/sensors";
     /** @brief reference of main D-bus interface of pldmd devices */
     sdbusplus::bus::bus& _bus;
-    /** @brief Sensor data fields */
-    std::string sensorName;
+    /** @brief Sensor path, holds the sensor name until the interfaces are
+     *  created
+     */
     std::string sensorPath;
+    /** @brief Offset of the sensor name in the sensor path */
+    uint16_t nameOffset = 0;
+    /** @brief InterfacesAdded was emitted and not yet retracted */
+    bool announced = false;
     uint8_t baseUnit;
-    int8_t unitModifier;
-    double offset;
-    double resolution;
-    double warningHigh;
-    double warningLow;
-    double criticalHigh;
-    double criticalLow;
-    double sensorMaxValue = std::numeric_limits<double>::quiet_NaN();
-    double sensorMinValue = std::numeric_limits<double>::quiet_NaN();
+    /** @brief resolution and offset scaled by the unit modifier */
+    double scale;
+    double bias;
+    /** @brief Released by createSensor */
+    std::unique_ptr<Limits> limits;
     /** @brief Store value interface */
     std::shared_ptr<ValueObject> valueInterface;
     /** @brief Store functional status interface */
     std::shared_ptr<StatusObject> statusInterface;
+    /** @brief Cached warning and critical thresholds, they outlive the
+     *  threshold interfaces which update them
+     */
+    ThresholdState warnState;
+    ThresholdState critState;
     /** @brief Store warning thresholds interface */
-    std::shared_ptr<WarningObject> warnObject;
+    std::shared_ptr<WarningThreshold> warnObject;
     /** @brief Store critical thresholds interface */
-    std::shared_ptr<CriticalObject> critObject;
+    std::shared_ptr<CriticalThreshold> critObject;
     SensorValueType lastValue = std::numeric_limits<double>::quiet_NaN();
+    /** @brief Deadband and rate limit of the value publishing */
+    SensorPublishFilter publishFilter;
+    /** @brief Time of the last published value */
+    std::chrono::steady_clock::time_point lastPublishTime;
+    /** @brief Reading history of the terminus, nullptr if not recorded */
+    SensorHistory* history = nullptr;
+    /** @brief Slot of the sensor in the history */
+    uint32_t historySlot = SensorHistory::npos;
+    /** @brief ID of the sensor in the sensor stream, 0 if not streamed */
+    uint32_t streamId = 0;
+    /** @brief Times of the last reading which was not NaN */
+    std::chrono::steady_clock::time_point lastRead{};
+    std::chrono::system_clock::time_point lastReadWall{};
+    /** @brief Staleness histogram of the terminus, nullptr if not recorded */
+    pldm::metrics::Histogram* staleness = nullptr;
+
+    /**
+     * @brief Check if the new value passes the publish filter
+     *
+     * @param[in] value - adjusted sensor value
+     *
+     * @return - true if the value should be published
+     */
+    bool isPublishDue(SensorValueType value);
+    /** @brief Value changed without emitting the PropertiesChanged signal */
+    bool valueChanged = false;
+    /** @brief Functional changed without emitting the PropertiesChanged
+     *  signal
+     */
+    bool functionalChanged = false;
 };
 
 } // namespace sensor
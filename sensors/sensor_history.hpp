@@ -0,0 +1,212 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace pldm
+{
+
+namespace sensor
+{
+
+/** @struct HistorySample
+ *  @brief One reading of a sensor, NaN when the sensor was unavailable
+ */
+struct HistorySample
+{
+    std::chrono::steady_clock::time_point time;
+    double value;
+};
+
+/** @struct HistoryAggregate
+ *  @brief Aggregate of the readings of a window, the unavailable readings
+ *  are counted apart and left out of the statistics
+ */
+struct HistoryAggregate
+{
+    uint64_t count = 0;       //!< Number of valid readings
+    uint64_t unavailable = 0; //!< Number of NaN readings
+    double min = std::numeric_limits<double>::quiet_NaN();
+    double max = std::numeric_limits<double>::quiet_NaN();
+    double average = std::numeric_limits<double>::quiet_NaN();
+    double latest = std::numeric_limits<double>::quiet_NaN();
+};
+
+/** @class SensorHistory
+ *  @brief Fixed-size ring of the last readings of each sensor of a terminus
+ *  @details The rings of all the sensors are slices of one contiguous arena,
+ *  a sensor gets a slot when it is created and gives it back when it is
+ *  removed, the freed slots are reused before the arena grows. The readings
+ *  are recorded before the publish filter of the sensor, so the aggregates
+ *  see every reading and not only the published values.
+ */
+class SensorHistory
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr uint32_t npos = std::numeric_limits<uint32_t>::max();
+
+    /** @brief Constructor
+     *
+     *  @param[in] depth - number of readings kept per sensor
+     */
+    explicit SensorHistory(size_t depth) : depth(std::max<size_t>(depth, 1)) {}
+
+    /** @brief Number of readings kept per sensor */
+    size_t capacity() const
+    {
+        return depth;
+    }
+
+    /** @brief Get a slot for a sensor, its ring starts empty
+     *
+     *  @return - the slot
+     */
+    uint32_t allocate()
+    {
+        uint32_t slot;
+        if (!freeSlots.empty())
+        {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        }
+        else
+        {
+            slot = static_cast<uint32_t>(rings.size());
+            rings.emplace_back();
+            arena.resize(arena.size() + depth);
+        }
+        rings[slot] = {};
+        return slot;
+    }
+
+    /** @brief Give back the slot of a removed sensor
+     *
+     *  @param[in] slot - slot returned by allocate()
+     */
+    void release(uint32_t slot)
+    {
+        if (slot < rings.size())
+        {
+            rings[slot] = {};
+            freeSlots.emplace_back(slot);
+        }
+    }
+
+    /** @brief Record a reading
+     *
+     *  @param[in] slot - slot of the sensor
+     *  @param[in] value - reading, NaN when unavailable
+     *  @param[in] now - time of the reading
+     */
+    void record(uint32_t slot, double value, Clock::time_point now = Clock::now())
+    {
+        auto& ring = rings[slot];
+        arena[slot * depth + ring.next] = {now, value};
+        ring.next = (ring.next + 1) % depth;
+        ring.size = std::min(ring.size + 1, depth);
+    }
+
+    /** @brief Readings of a sensor within a window, oldest first
+     *
+     *  @param[in] slot - slot of the sensor
+     *  @param[in] window - age of the oldest reading returned
+     *  @param[in] now - current time
+     */
+    std::vector<HistorySample> samples(uint32_t slot, Clock::duration window,
+                                       Clock::time_point now = Clock::now()) const
+    {
+        std::vector<HistorySample> result;
+        forEach(slot, window, now, [&result](const HistorySample& sample) {
+            result.emplace_back(sample);
+        });
+        return result;
+    }
+
+    /** @brief Aggregate of the readings of a sensor within a window
+     *
+     *  @param[in] slot - slot of the sensor
+     *  @param[in] window - age of the oldest reading aggregated
+     *  @param[in] now - current time
+     */
+    HistoryAggregate aggregate(uint32_t slot, Clock::duration window,
+                               Clock::time_point now = Clock::now()) const
+    {
+        HistoryAggregate result;
+        double sum = 0;
+        forEach(slot, window, now, [&](const HistorySample& sample) {
+            if (std::isnan(sample.value))
+            {
+                result.unavailable++;
+                return;
+            }
+            if (!result.count++)
+            {
+                result.min = result.max = sample.value;
+            }
+            result.min = std::min(result.min, sample.value);
+            result.max = std::max(result.max, sample.value);
+            result.latest = sample.value;
+            sum += sample.value;
+        });
+        if (result.count)
+        {
+            result.average = sum / result.count;
+        }
+        return result;
+    }
+
+    /** @brief Memory used by the arena and the rings in bytes */
+    size_t memoryUsage() const
+    {
+        return arena.capacity() * sizeof(HistorySample) +
+               rings.capacity() * sizeof(Ring) +
+               freeSlots.capacity() * sizeof(uint32_t);
+    }
+
+  private:
+    /** @brief Position of the ring of a slot */
+    struct Ring
+    {
+        size_t next = 0; //!< Index of the next reading in the slice
+        size_t size = 0; //!< Number of readings in the slice
+    };
+
+    /** @brief Visit the readings of a window, oldest first */
+    template <typename Func>
+    void forEach(uint32_t slot, Clock::duration window, Clock::time_point now,
+                 Func func) const
+    {
+        if (slot >= rings.size())
+        {
+            return;
+        }
+        const auto& ring = rings[slot];
+        const auto* slice = arena.data() + slot * depth;
+        auto first = (ring.next + depth - ring.size) % depth;
+        for (size_t i = 0; i < ring.size; i++)
+        {
+            const auto& sample = slice[(first + i) % depth];
+            if (now - sample.time <= window)
+            {
+                func(sample);
+            }
+        }
+    }
+
+    size_t depth;
+    /** @brief depth readings per slot, slot after slot */
+    std::vector<HistorySample> arena;
+    std::vector<Ring> rings;
+    std::vector<uint32_t> freeSlots;
+};
+
+} // namespace sensor
+
+} // namespace pldm
@@ -0,0 +1,135 @@
+#include "sensors/sensor_snapshot.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <limits>
+
+namespace pldm
+{
+
+namespace sensor
+{
+
+SensorSnapshot::SensorSnapshot(
+    const std::filesystem::path& path, uint8_t eid,
+    const std::vector<std::pair<uint16_t, uint8_t>>& sensors) :
+    path(path)
+{
+    if (sensors.size() > std::numeric_limits<uint16_t>::max())
+    {
+        std::cerr << "Too many sensors for the snapshot " << path << std::endl;
+        return;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+
+    /* Build the table in a temporary file and rename it, so the readers never
+     * open a partially initialized snapshot */
+    auto tmpPath = path;
+    tmpPath += ".tmp";
+    int fd = open(tmpPath.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC,
+                  0644);
+    if (fd < 0)
+    {
+        std::cerr << "Failed to create the sensor snapshot " << tmpPath
+                  << ", errno=" << errno << std::endl;
+        return;
+    }
+
+    auto size = sizeof(SnapshotHeader) + sensors.size() * sizeof(SnapshotEntry);
+    if (ftruncate(fd, size) < 0)
+    {
+        std::cerr << "Failed to size the sensor snapshot " << tmpPath
+                  << ", errno=" << errno << std::endl;
+        close(fd);
+        unlink(tmpPath.c_str());
+        return;
+    }
+
+    auto addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED)
+    {
+        std::cerr << "Failed to map the sensor snapshot " << tmpPath
+                  << ", errno=" << errno << std::endl;
+        unlink(tmpPath.c_str());
+        return;
+    }
+
+    auto header = static_cast<SnapshotHeader*>(addr);
+    std::memset(header, 0, sizeof(SnapshotHeader));
+    header->magic = snapshotMagic;
+    header->version = snapshotVersion;
+    header->count = static_cast<uint16_t>(sensors.size());
+    header->eid = eid;
+
+    auto table = reinterpret_cast<SnapshotEntry*>(header + 1);
+    for (size_t i = 0; i < sensors.size(); i++)
+    {
+        table[i].sequence = 0;
+        table[i].sensorId = sensors[i].first;
+        table[i].pdrType = sensors[i].second;
+        table[i].functional = 0;
+        table[i].value = std::numeric_limits<double>::quiet_NaN();
+        table[i].timestamp = 0;
+    }
+
+    if (rename(tmpPath.c_str(), path.c_str()) < 0)
+    {
+        std::cerr << "Failed to publish the sensor snapshot " << path
+                  << ", errno=" << errno << std::endl;
+        munmap(addr, size);
+        unlink(tmpPath.c_str());
+        return;
+    }
+
+    mapped = addr;
+    mappedSize = size;
+    entries = table;
+    count = sensors.size();
+}
+
+SensorSnapshot::~SensorSnapshot()
+{
+    if (mapped)
+    {
+        munmap(mapped, mappedSize);
+        unlink(path.c_str());
+    }
+}
+
+void SensorSnapshot::update(size_t index, double value, bool functional)
+{
+    if (index >= count)
+    {
+        return;
+    }
+
+    auto& entry = entries[index];
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    uint64_t now = static_cast<uint64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+
+    std::atomic_ref<uint32_t> sequence(entry.sequence);
+    auto seq = sequence.load(std::memory_order_relaxed);
+    sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::atomic_ref<double>(entry.value).store(value,
+                                               std::memory_order_relaxed);
+    std::atomic_ref<uint64_t>(entry.timestamp)
+        .store(now, std::memory_order_relaxed);
+    std::atomic_ref<uint8_t>(entry.functional)
+        .store(functional, std::memory_order_relaxed);
+    sequence.store(seq + 2, std::memory_order_release);
+}
+
+} // namespace sensor
+
+} // namespace pldm
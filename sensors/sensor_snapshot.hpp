@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <utility>
+#include <vector>
+
+namespace pldm
+{
+
+namespace sensor
+{
+
+/** @brief Magic number of the sensor snapshot file, "PSNP" */
+constexpr uint32_t snapshotMagic = 0x504e5350;
+/** @brief Layout version of the sensor snapshot file */
+constexpr uint16_t snapshotVersion = 1;
+
+/** @struct SnapshotHeader
+ *  @brief Header at offset 0 of the sensor snapshot file
+ */
+struct SnapshotHeader
+{
+    uint32_t magic;      //!< snapshotMagic
+    uint16_t version;    //!< snapshotVersion
+    uint16_t count;      //!< Number of entries following the header
+    uint8_t eid;         //!< MCTP EID of the terminus
+    uint8_t reserved[7]; //!< Reserved, zero
+};
+static_assert(sizeof(SnapshotHeader) == 16);
+
+/** @struct SnapshotEntry
+ *  @brief One sensor of the snapshot, protected by its own sequence lock.
+ *  @details The writer makes the sequence odd before changing the entry and
+ *  even after. A reader copies the entry between two reads of the same even
+ *  sequence, otherwise it retries.
+ */
+struct SnapshotEntry
+{
+    uint32_t sequence;  //!< Sequence lock of the entry
+    uint16_t sensorId;  //!< Sensor or effecter ID
+    uint8_t pdrType;    //!< PDR type of the sensor
+    uint8_t functional; //!< Functional status
+    double value;       //!< Published sensor value, NaN when unavailable
+    uint64_t timestamp; //!< CLOCK_MONOTONIC time of the update in ns
+};
+static_assert(sizeof(SnapshotEntry) == 24);
+
+/** @class SensorSnapshot
+ *  @brief Memory-mapped table of the sensor values of one terminus
+ *  @details Latency-sensitive readers sample the table without D-Bus calls.
+ *  The sensor names and units stay on D-Bus, the entries only carry the
+ *  sensor ID and PDR type to map them.
+ */
+class SensorSnapshot
+{
+  public:
+    SensorSnapshot() = delete;
+    SensorSnapshot(const SensorSnapshot&) = delete;
+    SensorSnapshot& operator=(const SensorSnapshot&) = delete;
+
+    /** @brief Create the snapshot file and map it
+     *
+     *  @param[in] path - path of the snapshot file
+     *  @param[in] eid - MCTP EID of the terminus
+     *  @param[in] sensors - sensor ID and PDR type of each entry, in order
+     */
+    SensorSnapshot(const std::filesystem::path& path, uint8_t eid,
+                   const std::vector<std::pair<uint16_t, uint8_t>>& sensors);
+
+    /** @brief Unmap and remove the snapshot file */
+    ~SensorSnapshot();
+
+    /** @brief Check if the snapshot file is mapped
+     *
+     *  @return - true if mapped
+     */
+    bool isValid() const
+    {
+        return entries != nullptr;
+    }
+
+    /** @brief Update one entry of the snapshot
+     *
+     *  @param[in] index - index of the entry
+     *  @param[in] value - sensor value
+     *  @param[in] functional - functional status
+     *
+     *  @return - none
+     */
+    void update(size_t index, double value, bool functional);
+
+  private:
+    /** @brief Path of the snapshot file */
+    std::filesystem::path path;
+    /** @brief Mapped address of the snapshot file */
+    void* mapped = nullptr;
+    /** @brief Size of the mapping */
+    size_t mappedSize = 0;
+    /** @brief Entries of the mapping */
+    SnapshotEntry* entries = nullptr;
+    /** @brief Number of entries */
+    size_t count = 0;
+};
+
+} // namespace sensor
+
+} // namespace pldm
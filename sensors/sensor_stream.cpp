@@ -0,0 +1,362 @@
+#include "sensors/sensor_stream.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstring>
+
+namespace pldm
+{
+
+namespace sensor
+{
+
+namespace
+{
+
+/** @brief Size of a reading of the Update frame */
+constexpr size_t updateEntrySize = 12;
+
+template <typename T>
+void append(std::vector<uint8_t>& frame, T value)
+{
+    static_assert(std::endian::native == std::endian::little);
+    auto offset = frame.size();
+    frame.resize(offset + sizeof(T));
+    std::memcpy(frame.data() + offset, &value, sizeof(T));
+}
+
+template <typename T>
+void patch(std::vector<uint8_t>& frame, size_t offset, T value)
+{
+    std::memcpy(frame.data() + offset, &value, sizeof(T));
+}
+
+/** @brief Start a frame with its type and an empty count */
+void startFrame(std::vector<uint8_t>& frame, StreamFrame type)
+{
+    frame.clear();
+    append<uint8_t>(frame, static_cast<uint8_t>(type));
+    append<uint8_t>(frame, 0);
+    append<uint16_t>(frame, 0);
+}
+
+} // namespace
+
+SensorStream& SensorStream::get()
+{
+    static SensorStream stream;
+    return stream;
+}
+
+void SensorStream::start(Sender newSender, PendingCallback pending)
+{
+    sender = std::move(newSender);
+    pendingCallback = std::move(pending);
+}
+
+void SensorStream::stop()
+{
+    sender = {};
+    pendingCallback = {};
+    for (auto& [fd, client] : clients)
+    {
+        unsubscribe(client);
+    }
+    clients.clear();
+    for (auto id : pendingIds)
+    {
+        sensors[id].pending = false;
+    }
+    pendingIds.clear();
+}
+
+uint32_t SensorStream::addSensor(std::string_view path)
+{
+    if (!isActive() || path.empty())
+    {
+        return 0;
+    }
+
+    uint32_t id;
+    if (!freeIds.empty())
+    {
+        id = freeIds.back();
+        freeIds.pop_back();
+    }
+    else
+    {
+        id = static_cast<uint32_t>(sensors.size());
+        sensors.emplace_back();
+    }
+    sensors[id] = {};
+    sensors[id].path = path;
+
+    for (auto& [fd, client] : clients)
+    {
+        if (matches(client, path) && subscribe(client, id))
+        {
+            sendSensors(fd, {id});
+        }
+    }
+    reap();
+    return id;
+}
+
+void SensorStream::removeSensor(uint32_t id)
+{
+    if (!id || id >= sensors.size() || sensors[id].path.empty())
+    {
+        return;
+    }
+
+    if (sensors[id].subscribers)
+    {
+        std::vector<uint8_t> frame;
+        for (auto& [fd, client] : clients)
+        {
+            if (id >= client.sensors.size() || !client.sensors[id])
+            {
+                continue;
+            }
+            client.sensors[id] = false;
+            startFrame(frame, StreamFrame::Removed);
+            patch<uint16_t>(frame, 2, 1);
+            append<uint32_t>(frame, id);
+            send(fd, frame);
+        }
+        reap();
+    }
+
+    if (sensors[id].pending)
+    {
+        std::erase(pendingIds, id);
+    }
+    sensors[id] = {};
+    freeIds.emplace_back(id);
+}
+
+void SensorStream::flush()
+{
+    if (pendingIds.empty())
+    {
+        return;
+    }
+
+    auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+                   .count();
+    sequence++;
+    std::vector<uint8_t> frame;
+    for (auto& [fd, client] : clients)
+    {
+        uint16_t count = 0;
+        auto sendFrame = [&]() {
+            if (count)
+            {
+                patch<uint16_t>(frame, 2, count);
+                send(fd, frame);
+            }
+            count = 0;
+        };
+        for (auto id : pendingIds)
+        {
+            if (id >= client.sensors.size() || !client.sensors[id])
+            {
+                continue;
+            }
+            if (!count || frame.size() + updateEntrySize > maxFrameSize ||
+                count == UINT16_MAX)
+            {
+                sendFrame();
+                startFrame(frame, StreamFrame::Update);
+                append<uint32_t>(frame, sequence);
+                append<uint64_t>(frame, static_cast<uint64_t>(now));
+            }
+            append<uint32_t>(frame, id);
+            append<double>(frame, sensors[id].value);
+            count++;
+        }
+        sendFrame();
+    }
+
+    for (auto id : pendingIds)
+    {
+        sensors[id].pending = false;
+    }
+    pendingIds.clear();
+    reap();
+}
+
+void SensorStream::addClient(int fd)
+{
+    clients[fd] = {};
+}
+
+void SensorStream::removeClient(int fd)
+{
+    auto it = clients.find(fd);
+    if (it == clients.end())
+    {
+        return;
+    }
+    unsubscribe(it->second);
+    clients.erase(it);
+}
+
+bool SensorStream::receive(int fd, std::span<const uint8_t> frame)
+{
+    auto it = clients.find(fd);
+    if (it == clients.end() || frame.empty())
+    {
+        return false;
+    }
+    auto& client = it->second;
+
+    switch (static_cast<StreamFrame>(frame[0]))
+    {
+        case StreamFrame::Subscribe:
+        {
+            /* The last prefix may miss its terminator */
+            std::string_view rest(reinterpret_cast<const char*>(frame.data()) +
+                                      1,
+                                  frame.size() - 1);
+            std::vector<std::string> prefixes;
+            while (!rest.empty())
+            {
+                auto end = std::min(rest.find('\0'), rest.size());
+                prefixes.emplace_back(rest.substr(0, end));
+                rest.remove_prefix(std::min(end + 1, rest.size()));
+            }
+            if (prefixes.empty())
+            {
+                return false;
+            }
+
+            std::vector<uint32_t> added;
+            client.prefixes.insert(client.prefixes.end(), prefixes.begin(),
+                                   prefixes.end());
+            for (uint32_t id = 1; id < sensors.size(); id++)
+            {
+                if (!sensors[id].path.empty() &&
+                    matches(client, sensors[id].path) &&
+                    subscribe(client, id))
+                {
+                    added.emplace_back(id);
+                }
+            }
+            sendSensors(fd, added);
+            reap();
+            return true;
+        }
+        case StreamFrame::Unsubscribe:
+            unsubscribe(client);
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool SensorStream::matches(const Client& client, std::string_view path)
+{
+    return std::any_of(client.prefixes.begin(), client.prefixes.end(),
+                       [path](const std::string& prefix) {
+        return path.starts_with(prefix);
+    });
+}
+
+bool SensorStream::subscribe(Client& client, uint32_t id)
+{
+    if (id >= client.sensors.size())
+    {
+        client.sensors.resize(sensors.size(), false);
+    }
+    if (client.sensors[id])
+    {
+        return false;
+    }
+    client.sensors[id] = true;
+    sensors[id].subscribers++;
+    return true;
+}
+
+void SensorStream::unsubscribe(Client& client)
+{
+    for (uint32_t id = 0; id < client.sensors.size(); id++)
+    {
+        if (client.sensors[id])
+        {
+            sensors[id].subscribers--;
+        }
+    }
+    client.sensors.clear();
+    client.prefixes.clear();
+}
+
+void SensorStream::sendSensors(int fd, const std::vector<uint32_t>& ids)
+{
+    std::vector<uint8_t> frame;
+    uint16_t count = 0;
+    auto sendFrame = [&]() {
+        if (count)
+        {
+            patch<uint16_t>(frame, 2, count);
+            send(fd, frame);
+        }
+        count = 0;
+    };
+    for (auto id : ids)
+    {
+        const auto& path = sensors[id].path;
+        auto size = sizeof(uint32_t) + sizeof(uint16_t) + path.size();
+        if (!count || frame.size() + size > maxFrameSize ||
+            count == UINT16_MAX)
+        {
+            sendFrame();
+            startFrame(frame, StreamFrame::Sensors);
+        }
+        append<uint32_t>(frame, id);
+        append<uint16_t>(frame, static_cast<uint16_t>(path.size()));
+        frame.insert(frame.end(), path.begin(), path.end());
+        count++;
+    }
+    sendFrame();
+}
+
+void SensorStream::send(int fd, std::vector<uint8_t>& frame)
+{
+    auto it = clients.find(fd);
+    if (it == clients.end() || it->second.gone || !sender)
+    {
+        return;
+    }
+    switch (sender(fd, frame))
+    {
+        case SendResult::Sent:
+            break;
+        case SendResult::Dropped:
+            dropped++;
+            break;
+        case SendResult::Gone:
+            it->second.gone = true;
+            break;
+    }
+}
+
+void SensorStream::reap()
+{
+    for (auto it = clients.begin(); it != clients.end();)
+    {
+        if (it->second.gone)
+        {
+            unsubscribe(it->second);
+            it = clients.erase(it);
+            continue;
+        }
+        ++it;
+    }
+}
+
+} // namespace sensor
+
+} // namespace pldm
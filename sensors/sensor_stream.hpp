@@ -0,0 +1,203 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace pldm
+{
+
+namespace sensor
+{
+
+/** @brief Frame types of the sensor stream, the frames from the server have
+ *  the top bit set
+ */
+enum class StreamFrame : uint8_t
+{
+    Subscribe = 0x01,   //!< Client: NUL terminated path prefixes
+    Unsubscribe = 0x02, //!< Client: drop all the subscriptions
+    Sensors = 0x81,     //!< Server: u16 count, {u32 id, u16 len, path}
+    Removed = 0x82,     //!< Server: u16 count, {u32 id}
+    Update = 0x83,      //!< Server: u16 count, u32 sequence, u64 time,
+                        //!< {u32 id, f64 value}
+};
+
+/** @class SensorStream
+ *
+ *  Pushes the readings of the subscribed sensors to the clients of the
+ *  sensor stream socket. A client subscribes to the sensors whose D-Bus path
+ *  starts with one of its prefixes, it gets a Sensors frame mapping the path
+ *  of each sensor to a 32-bit ID, including the sensors added later, then the
+ *  readings by ID in Update frames. The readings are coalesced until the end
+ *  of a polling round, an Update frame carries the last reading of each
+ *  sensor which changed or was read again since the previous one.
+ *
+ *  All the fields are little-endian, a frame is one message of a
+ *  SOCK_SEQPACKET socket so the client never parses a partial frame. The
+ *  frames are split at maxFrameSize.
+ *
+ *  Sensor IDs are given only while the socket is served, so the sensors cost
+ *  nothing otherwise.
+ */
+class SensorStream
+{
+  public:
+    /** @brief Result of sending a frame to a client */
+    enum class SendResult
+    {
+        Sent,
+        Dropped, //!< The client did not drain its socket
+        Gone,    //!< The client is removed
+    };
+
+    /** @brief Send a frame to a client */
+    using Sender =
+        std::function<SendResult(int client, std::span<const uint8_t>)>;
+
+    /** @brief Called when the first reading is coalesced after a flush */
+    using PendingCallback = std::function<void()>;
+
+    static constexpr size_t maxFrameSize = 65536;
+
+    /** @brief The sensor stream of pldmd */
+    static SensorStream& get();
+
+    /** @brief Start serving the stream
+     *
+     *  @param[in] sender - sends a frame to a client
+     *  @param[in] pending - called when a reading waits for a flush
+     */
+    void start(Sender sender, PendingCallback pending = {});
+
+    /** @brief Stop serving the stream, the clients are dropped */
+    void stop();
+
+    /** @brief Whether the stream is served */
+    bool isActive() const
+    {
+        return static_cast<bool>(sender);
+    }
+
+    /** @brief Register a sensor
+     *
+     *  @param[in] path - D-Bus path of the sensor
+     *
+     *  @return - ID of the sensor, 0 if the stream is not served
+     */
+    uint32_t addSensor(std::string_view path);
+
+    /** @brief Unregister a sensor, the subscribers get a Removed frame
+     *
+     *  @param[in] id - ID returned by addSensor
+     */
+    void removeSensor(uint32_t id);
+
+    /** @brief Coalesce a reading until the next flush, dropped if no client
+     *         subscribed to the sensor
+     *
+     *  @param[in] id - ID of the sensor
+     *  @param[in] value - reading, NaN while the sensor is unavailable
+     */
+    void update(uint32_t id, double value)
+    {
+        if (id >= sensors.size() || !sensors[id].subscribers)
+        {
+            return;
+        }
+        auto& sensor = sensors[id];
+        sensor.value = value;
+        if (!sensor.pending)
+        {
+            sensor.pending = true;
+            pendingIds.emplace_back(id);
+            if (pendingIds.size() == 1 && pendingCallback)
+            {
+                pendingCallback();
+            }
+        }
+    }
+
+    /** @brief Send the coalesced readings, e.g. at the end of a polling
+     *         round
+     */
+    void flush();
+
+    /** @brief Add a client, it has no subscription yet */
+    void addClient(int client);
+
+    /** @brief Remove a client and its subscriptions */
+    void removeClient(int client);
+
+    /** @brief Handle a frame received from a client
+     *
+     *  @param[in] client - client of the frame
+     *  @param[in] frame - received frame
+     *
+     *  @return - false if the frame is malformed
+     */
+    bool receive(int client, std::span<const uint8_t> frame);
+
+    /** @brief Number of frames not sent because a client was too slow */
+    uint64_t droppedFrames() const
+    {
+        return dropped;
+    }
+
+  private:
+    struct Sensor
+    {
+        std::string path; //!< Empty for a free ID
+        double value = 0;
+        bool pending = false;
+        uint16_t subscribers = 0;
+    };
+
+    struct Client
+    {
+        std::vector<std::string> prefixes;
+        /** @brief Subscribed sensors by ID */
+        std::vector<bool> sensors;
+        /** @brief The client is removed after the current send */
+        bool gone = false;
+    };
+
+    static bool matches(const Client& client, std::string_view path);
+
+    /** @brief Subscribe a client to a sensor
+     *
+     *  @return - true if it was not subscribed
+     */
+    bool subscribe(Client& client, uint32_t id);
+
+    /** @brief Drop the subscriptions of a client */
+    void unsubscribe(Client& client);
+
+    /** @brief Send the Sensors frames of sensors to a client */
+    void sendSensors(int client, const std::vector<uint32_t>& ids);
+
+    /** @brief Send a frame, the client goes away if it cannot take it */
+    void send(int client, std::vector<uint8_t>& frame);
+
+    /** @brief Remove the clients which went away while sending */
+    void reap();
+
+    Sender sender;
+    PendingCallback pendingCallback;
+    /** @brief Sensors by ID, ID 0 is not used */
+    std::vector<Sensor> sensors = std::vector<Sensor>(1);
+    std::vector<uint32_t> freeIds;
+    std::vector<uint32_t> pendingIds;
+    std::map<int, Client> clients;
+    uint32_t sequence = 0;
+    uint64_t dropped = 0;
+};
+
+} // namespace sensor
+
+} // namespace pldm
@@ -5,6 +5,8 @@
 
 #include <any>
 #include <cmath>
+#include <limits>
+#include <memory>
 
 namespace pldm
 {
@@ -14,6 +16,86 @@ namespace sensor
 
 using namespace pldm::sensor;
 
+/** @struct ThresholdState
+ *  @brief Thresholds and alarms of a threshold interface, cached in the
+ *  sensor so a reading is compared without going through the interface. A
+ *  NaN threshold never alarms.
+ */
+struct ThresholdState
+{
+    SensorValueType lo = std::numeric_limits<SensorValueType>::quiet_NaN();
+    SensorValueType hi = std::numeric_limits<SensorValueType>::quiet_NaN();
+    bool alarmLo = false;
+    bool alarmHi = false;
+};
+
+/** @class WarningThreshold
+ *  @brief Warning interface which keeps the cached thresholds in sync when
+ *  they are set, including from D-Bus
+ */
+class WarningThreshold : public WarningObject
+{
+  public:
+    WarningThreshold(sdbusplus::bus::bus& bus, const char* path,
+                     ThresholdState& state) :
+        WarningObject(bus, path, action::defer_emit),
+        state(state)
+    {}
+
+    using WarningInterface::warningHigh;
+    using WarningInterface::warningLow;
+
+    SensorValueType warningLow(SensorValueType value, bool skipSignal) override
+    {
+        state.lo = value;
+        return WarningInterface::warningLow(value, skipSignal);
+    }
+
+    SensorValueType warningHigh(SensorValueType value,
+                                bool skipSignal) override
+    {
+        state.hi = value;
+        return WarningInterface::warningHigh(value, skipSignal);
+    }
+
+  private:
+    ThresholdState& state;
+};
+
+/** @class CriticalThreshold
+ *  @brief Critical interface which keeps the cached thresholds in sync when
+ *  they are set, including from D-Bus
+ */
+class CriticalThreshold : public CriticalObject
+{
+  public:
+    CriticalThreshold(sdbusplus::bus::bus& bus, const char* path,
+                      ThresholdState& state) :
+        CriticalObject(bus, path, action::defer_emit),
+        state(state)
+    {}
+
+    using CriticalInterface::criticalHigh;
+    using CriticalInterface::criticalLow;
+
+    SensorValueType criticalLow(SensorValueType value,
+                                bool skipSignal) override
+    {
+        state.lo = value;
+        return CriticalInterface::criticalLow(value, skipSignal);
+    }
+
+    SensorValueType criticalHigh(SensorValueType value,
+                                 bool skipSignal) override
+    {
+        state.hi = value;
+        return CriticalInterface::criticalHigh(value, skipSignal);
+    }
+
+  private:
+    ThresholdState& state;
+};
+
 /** @class Thresholds
  *  @brief Threshold type traits.
  *
@@ -32,6 +114,7 @@ struct Thresholds
 template <>
 struct Thresholds<WarningObject>
 {
+    using Object = WarningThreshold;
     static constexpr InterfaceType type = InterfaceType::WARN;
     static constexpr const char* envLo = "WARNLO";
     static constexpr const char* envHi = "WARNHI";
@@ -53,6 +136,7 @@ struct Thresholds<WarningObject>
 template <>
 struct Thresholds<CriticalObject>
 {
+    using Object = CriticalThreshold;
     static constexpr InterfaceType type = InterfaceType::CRIT;
     static constexpr const char* envLo = "CRITLO";
     static constexpr const char* envHi = "CRITHI";
@@ -72,52 +156,58 @@ struct Thresholds<CriticalObject>
 
 /** @brief checkThresholds
  *
- *  Compare a sensor reading to threshold values and set the
- *  appropriate alarm property if bounds are exceeded.
+ *  Compare a sensor reading to the cached threshold values and set the
+ *  appropriate alarm property if bounds are crossed. The interface is only
+ *  touched when an alarm changes.
  *
  *  @tparam T - The threshold type.
  *
  *  @param[in] iface - An sdbusplus server threshold instance.
+ *  @param[in] state - The cached thresholds and alarms of iface.
  *  @param[in] value - The sensor reading to compare to thresholds.
  */
 template <typename T>
-void checkThresholds(std::shared_ptr<T>& iface, SensorValueType value)
+void checkThresholds(T& iface, ThresholdState& state, SensorValueType value)
 {
-    auto realIface = std::any_cast<std::shared_ptr<T>>(iface);
-    auto lo = (*realIface.*Thresholds<T>::getLo)();
-    auto hi = (*realIface.*Thresholds<T>::getHi)();
-    auto alarmLowState = (*realIface.*Thresholds<T>::getAlarmLow)();
-    auto alarmHighState = (*realIface.*Thresholds<T>::getAlarmHigh)();
-    (*realIface.*Thresholds<T>::alarmLo)(value <= lo);
-    (*realIface.*Thresholds<T>::alarmHi)(value >= hi);
-    if (alarmLowState != (value <= lo))
+    bool alarmLow = value <= state.lo;
+    bool alarmHigh = value >= state.hi;
+    if ((alarmLow == state.alarmLo) & (alarmHigh == state.alarmHi))
     {
-        if (value <= lo)
+        return;
+    }
+
+    if (alarmLow != state.alarmLo)
+    {
+        state.alarmLo = alarmLow;
+        (iface.*Thresholds<T>::alarmLo)(alarmLow);
+        if (alarmLow)
         {
-            (*realIface.*Thresholds<T>::assertLowSignal)(value);
+            (iface.*Thresholds<T>::assertLowSignal)(value);
         }
         else
         {
-            (*realIface.*Thresholds<T>::deassertLowSignal)(value);
+            (iface.*Thresholds<T>::deassertLowSignal)(value);
         }
     }
-    if (alarmHighState != (value >= hi))
+    if (alarmHigh != state.alarmHi)
     {
-        if (value >= hi)
+        state.alarmHi = alarmHigh;
+        (iface.*Thresholds<T>::alarmHi)(alarmHigh);
+        if (alarmHigh)
         {
-            (*realIface.*Thresholds<T>::assertHighSignal)(value);
+            (iface.*Thresholds<T>::assertHighSignal)(value);
         }
         else
         {
-            (*realIface.*Thresholds<T>::deassertHighSignal)(value);
+            (iface.*Thresholds<T>::deassertHighSignal)(value);
         }
     }
 }
 
 /** @brief addThreshold
  *
- *  Look for a configured threshold value in the environment and
- *  create an sdbusplus server threshold if found.
+ *  Create an sdbusplus server threshold if the sensor has a threshold of
+ *  the type, and cache its thresholds and alarms.
  *
  *  @tparam T - The threshold type.
  *
@@ -125,14 +215,16 @@ void checkThresholds(std::shared_ptr<T>& iface, SensorValueType value)
  *  @param[in] value - The sensor reading.
  *  @param[in] lo - The low threshold.
  *  @param[in] hi - The high threshold.
+ *  @param[out] state - The cached thresholds and alarms, it must outlive
+ *                      the threshold instance.
  */
 template <typename T>
-std::shared_ptr<T> addThreshold(ObjectInfo& info, SensorValueType value,
-                                SensorValueType lo, SensorValueType hi)
+std::shared_ptr<typename Thresholds<T>::Object>
+    addThreshold(ObjectInfo& info, SensorValueType value, SensorValueType lo,
+                 SensorValueType hi, ThresholdState& state)
 {
     auto& objPath = std::get<std::string>(info);
     auto& obj = std::get<InterfaceMap>(info);
-    std::shared_ptr<T> iface;
     auto& bus = *std::get<sdbusplus::bus::bus*>(info);
     auto type = Thresholds<T>::type;
 
@@ -142,51 +234,25 @@ std::shared_ptr<T> addThreshold(ObjectInfo& info, SensorValueType value,
         return nullptr;
     }
 
-    iface =
-        std::make_shared<T>(bus, objPath.c_str(), T::action::defer_emit);
-
+    auto iface = std::make_shared<typename Thresholds<T>::Object>(
+        bus, objPath.c_str(), state);
+    T& base = *iface;
+    state = {(base.*Thresholds<T>::getLo)(), (base.*Thresholds<T>::getHi)(),
+             (base.*Thresholds<T>::getAlarmLow)(),
+             (base.*Thresholds<T>::getAlarmHigh)()};
     if (!std::isnan(lo))
     {
-        (*iface.*Thresholds<T>::setLo)(lo);
-        auto alarmLowState = (*iface.*Thresholds<T>::getAlarmLow)();
-        if (!std::isnan(value))
-        {
-            (*iface.*Thresholds<T>::alarmLo)(value <= lo);
-            if (alarmLowState != (value <= lo))
-            {
-                if (value <= lo)
-                {
-                    (*iface.*Thresholds<T>::assertLowSignal)(value);
-                }
-                else
-                {
-                    (*iface.*Thresholds<T>::deassertLowSignal)(value);
-                }
-            }
-        }
+        (base.*Thresholds<T>::setLo)(lo);
     }
-
     if (!std::isnan(hi))
     {
-        (*iface.*Thresholds<T>::setHi)(hi);
-        auto alarmHighState = (*iface.*Thresholds<T>::getAlarmHigh)();
-        (*iface.*Thresholds<T>::alarmHi)(value >= hi);
-        if (!std::isnan(value))
-        {
-            if (alarmHighState != (value >= hi))
-            {
-                if (value >= hi)
-                {
-                    (*iface.*Thresholds<T>::assertHighSignal)(value);
-                }
-                else
-                {
-                    (*iface.*Thresholds<T>::deassertHighSignal)(value);
-                }
-            }
-        }
+        (base.*Thresholds<T>::setHi)(hi);
+    }
+    if (!std::isnan(value))
+    {
+        checkThresholds<T>(base, state, value);
     }
-    obj[type] = iface;
+    obj[type] = std::static_pointer_cast<T>(iface);
 
     return iface;
 }
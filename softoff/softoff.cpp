@@ -3,6 +3,8 @@
 #include "common/instance_id.hpp"
 #include "common/transport.hpp"
 #include "common/utils.hpp"
+#include "requester/handler.hpp"
+#include "requester/request.hpp"
 
 #include <libpldm/entity.h>
 #include <libpldm/platform.h>
@@ -13,9 +15,7 @@
 #include <sdeventplus/clock.hpp>
 #include <sdeventplus/exception.hpp>
 #include <sdeventplus/source/io.hpp>
-#include <sdeventplus/source/time.hpp>
 
-#include <array>
 #include <iostream>
 
 PHOSPHOR_LOG2_USING;
@@ -24,15 +24,12 @@ namespace pldm
 {
 using namespace sdeventplus;
 using namespace sdeventplus::source;
-constexpr auto clockId = sdeventplus::ClockId::RealTime;
-using Clock = Clock<clockId>;
-using Timer = Time<clockId>;
 
 constexpr pldm::pdr::TerminusID TID = 0; // TID will be implemented later.
 namespace sdbusRule = sdbusplus::bus::match::rules;
 
-SoftPowerOff::SoftPowerOff(sdbusplus::bus_t& bus, sd_event* event) :
-    bus(bus), timer(event)
+SoftPowerOff::SoftPowerOff(sdbusplus::bus_t& bus, sdeventplus::Event& event) :
+    bus(bus), timer(event, nullptr)
 {
     getHostState();
     if (hasError || completed)
@@ -116,37 +113,36 @@ void SoftPowerOff::hostSoftOffComplete(sdbusplus::message_t& msg)
         msgEventState == PLDM_SW_TERM_GRACEFUL_SHUTDOWN)
     {
         // Receive Graceful shutdown completion event message. Disable the timer
-        auto rc = timer.stop();
-        if (rc < 0)
-        {
-            error("PLDM soft off: Failure to STOP the timer. ERRNO={RC}", "RC",
-                  rc);
-        }
+        stopTimer();
 
         // This marks the completion of pldm soft power off.
         completed = true;
     }
 }
 
-int SoftPowerOff::getEffecterID()
+std::vector<std::vector<uint8_t>>
+    SoftPowerOff::findStatePDRs(const char* method, pdr::EntityType entityType)
 {
-    auto& bus = pldm::utils::DBusHandler::getBus();
+    // The entity is logical, so the bit 15 in entity type is set.
+    entityType = entityType | 0x8000;
 
-    // VMM is a logical entity, so the bit 15 in entity type is set.
-    pdr::EntityType entityType = PLDM_ENTITY_VIRTUAL_MACHINE_MANAGER | 0x8000;
+    std::vector<std::vector<uint8_t>> pdrs{};
+    auto findMethod = bus.new_method_call(
+        "xyz.openbmc_project.PLDM", "/xyz/openbmc_project/pldm",
+        "xyz.openbmc_project.PLDM.PDR", method);
+    findMethod.append(TID, entityType,
+                      (uint16_t)PLDM_STATE_SET_SW_TERMINATION_STATUS);
+    auto reply = bus.call(findMethod, dbusTimeout);
+    reply.read(pdrs);
+    return pdrs;
+}
 
+int SoftPowerOff::getEffecterID()
+{
     try
     {
-        std::vector<std::vector<uint8_t>> VMMResponse{};
-        auto VMMMethod = bus.new_method_call(
-            "xyz.openbmc_project.PLDM", "/xyz/openbmc_project/pldm",
-            "xyz.openbmc_project.PLDM.PDR", "FindStateEffecterPDR");
-        VMMMethod.append(TID, entityType,
-                         (uint16_t)PLDM_STATE_SET_SW_TERMINATION_STATUS);
-
-        auto VMMResponseMsg = bus.call(VMMMethod, dbusTimeout);
-
-        VMMResponseMsg.read(VMMResponse);
+        auto VMMResponse = findStatePDRs("FindStateEffecterPDR",
+                                         PLDM_ENTITY_VIRTUAL_MACHINE_MANAGER);
         if (VMMResponse.size() != 0)
         {
             for (auto& rep : VMMResponse)
@@ -175,21 +171,10 @@ int SoftPowerOff::getEffecterID()
 
     // If the Virtual Machine Manager PDRs doesn't exist, go find the System
     // Firmware PDRs.
-    // System Firmware is a logical entity, so the bit 15 in entity type is set
-    entityType = PLDM_ENTITY_SYS_FIRMWARE | 0x8000;
     try
     {
-        std::vector<std::vector<uint8_t>> sysFwResponse{};
-        auto sysFwMethod = bus.new_method_call(
-            "xyz.openbmc_project.PLDM", "/xyz/openbmc_project/pldm",
-            "xyz.openbmc_project.PLDM.PDR", "FindStateEffecterPDR");
-        sysFwMethod.append(TID, entityType,
-                           (uint16_t)PLDM_STATE_SET_SW_TERMINATION_STATUS);
-
-        auto sysFwResponseMsg = bus.call(sysFwMethod, dbusTimeout);
-
-        sysFwResponseMsg.read(sysFwResponse);
-
+        auto sysFwResponse = findStatePDRs("FindStateEffecterPDR",
+                                           PLDM_ENTITY_SYS_FIRMWARE);
         if (sysFwResponse.size() == 0)
         {
             error("No effecter ID has been found that matches the criteria");
@@ -216,29 +201,12 @@ int SoftPowerOff::getEffecterID()
 
 int SoftPowerOff::getSensorInfo()
 {
-    pldm::pdr::EntityType entityType;
-
-    entityType = VMMPdrExist ? PLDM_ENTITY_VIRTUAL_MACHINE_MANAGER
-                             : PLDM_ENTITY_SYS_FIRMWARE;
-
-    // The Virtual machine manager/System firmware is logical entity, so bit 15
-    // need to be set.
-    entityType = entityType | 0x8000;
+    auto entityType = VMMPdrExist ? PLDM_ENTITY_VIRTUAL_MACHINE_MANAGER
+                                  : PLDM_ENTITY_SYS_FIRMWARE;
 
     try
     {
-        auto& bus = pldm::utils::DBusHandler::getBus();
-        std::vector<std::vector<uint8_t>> Response{};
-        auto method = bus.new_method_call(
-            "xyz.openbmc_project.PLDM", "/xyz/openbmc_project/pldm",
-            "xyz.openbmc_project.PLDM.PDR", "FindStateSensorPDR");
-        method.append(TID, entityType,
-                      (uint16_t)PLDM_STATE_SET_SW_TERMINATION_STATUS);
-
-        auto ResponseMsg = bus.call(method, dbusTimeout);
-
-        ResponseMsg.read(Response);
-
+        auto Response = findStatePDRs("FindStateSensorPDR", entityType);
         if (Response.size() == 0)
         {
             error("No sensor PDR has been found that matches the criteria");
@@ -288,26 +256,56 @@ int SoftPowerOff::getSensorInfo()
     return PLDM_SUCCESS;
 }
 
+void SoftPowerOff::processResponse(const pldm_msg* response,
+                                   size_t respMsgLen)
+{
+    if (response == nullptr || !respMsgLen)
+    {
+        error(
+            "PLDM soft off: ERROR! Can't get the response for the PLDM request msg. Time out! Exit the pldm-softpoweroff");
+        hasError = true;
+        return;
+    }
+
+    if (response->payload[0] != PLDM_SUCCESS)
+    {
+        error("Getting the wrong response. PLDM RC = {RC}", "RC",
+              (unsigned)response->payload[0]);
+        hasError = true;
+        return;
+    }
+
+    responseReceived = true;
+
+    // Start Timer
+    using namespace std::chrono;
+    auto timeMicroseconds =
+        duration_cast<microseconds>(seconds(SOFTOFF_TIMEOUT_SECONDS));
+    startTimer(timeMicroseconds);
+    error(
+        "Timer started waiting for host soft off, TIMEOUT_IN_SEC = {TIMEOUT_SEC}",
+        "TIMEOUT_SEC", SOFTOFF_TIMEOUT_SECONDS);
+}
+
 int SoftPowerOff::hostSoftOff(sdeventplus::Event& event)
 {
     constexpr uint8_t effecterCount = 1;
     PldmTransport pldmTransport{};
-    uint8_t instanceID;
-    uint8_t mctpEID;
+    pldm::InstanceIdDb instanceIdDb;
+    pldm::requester::Handler<pldm::requester::Request> handler(
+        &pldmTransport, event, instanceIdDb, false);
 
-    mctpEID = pldm::utils::readHostEID();
+    auto mctpEID = pldm::utils::readHostEID();
     // TODO: fix mapping to work around OpenBMC ecosystem deficiencies
     pldm_tid_t pldmTID = static_cast<pldm_tid_t>(mctpEID);
 
-    std::array<uint8_t, sizeof(pldm_msg_hdr) + sizeof(effecterID) +
-                            sizeof(effecterCount) +
-                            sizeof(set_effecter_state_field)>
-        requestMsg{};
+    pldm::Request requestMsg(sizeof(pldm_msg_hdr) + sizeof(effecterID) +
+                             sizeof(effecterCount) +
+                             sizeof(set_effecter_state_field));
     auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
     set_effecter_state_field stateField{
         PLDM_REQUEST_SET, PLDM_SW_TERM_GRACEFUL_SHUTDOWN_REQUESTED};
-    pldm::InstanceIdDb instanceIdDb;
-    instanceID = instanceIdDb.next(pldmTID);
+    auto instanceID = instanceIdDb.next(pldmTID);
     auto rc = encode_set_state_effecter_states_req(
         instanceID, effecterID, effecterCount, &stateField, request);
     if (rc != PLDM_SUCCESS)
@@ -318,29 +316,9 @@ int SoftPowerOff::hostSoftOff(sdeventplus::Event& event)
         return PLDM_ERROR;
     }
 
-    // Add a timer to the event loop, default 30s.
-    auto timerCallback = [=, this](Timer& /*source*/,
-                                   Timer::TimePoint /*time*/) mutable {
-        if (!responseReceived)
-        {
-            instanceIdDb.free(pldmTID, instanceID);
-            error(
-                "PLDM soft off: ERROR! Can't get the response for the PLDM request msg. Time out! Exit the pldm-softpoweroff");
-            exit(-1);
-        }
-        return;
-    };
-    Timer time(event, (Clock(event).now() + std::chrono::seconds{30}),
-               std::chrono::seconds{1}, std::move(timerCallback));
-
-    // Add a callback to handle EPOLLIN on fd
-    auto callback = [=, &pldmTransport, this](IO& io, int fd,
-                                              uint32_t revents) mutable {
-        if (fd != pldmTransport.getEventSource())
-        {
-            return;
-        }
-
+    // Pass the responses from the host to the requester handler
+    auto callback = [&pldmTransport, &handler, pldmTID,
+                     this](IO& /*io*/, int /*fd*/, uint32_t revents) {
         if (!(revents & EPOLLIN))
         {
             return;
@@ -348,80 +326,73 @@ int SoftPowerOff::hostSoftOff(sdeventplus::Event& event)
 
         void* responseMsg = nullptr;
         size_t responseMsgSize{};
-        pldm_tid_t srcTID = pldmTID;
-
-        auto rc = pldmTransport.recvMsg(pldmTID, responseMsg, responseMsgSize);
+        pldm_tid_t srcTID{};
+        auto rc = pldmTransport.recvMsg(srcTID, responseMsg, responseMsgSize);
         if (rc)
         {
             error("Soft off: failed to recv pldm data. PLDM RC = {RC}", "RC",
                   static_cast<int>(rc));
+            if (rc == PLDM_REQUESTER_RECV_FAIL)
+            {
+                hasError = true;
+            }
             return;
         }
 
         std::unique_ptr<void, decltype(std::free)*> responseMsgPtr{responseMsg,
                                                                    std::free};
-
-        // We've got the response meant for the PLDM request msg that was
-        // sent out
-        io.set_enabled(Enabled::Off);
-        auto response = reinterpret_cast<pldm_msg*>(responseMsgPtr.get());
-
-        if (srcTID != pldmTID ||
-            !pldm_msg_hdr_correlate_response(&request->hdr, &response->hdr))
+        if (srcTID != pldmTID || responseMsgSize < sizeof(pldm_msg_hdr))
         {
-            /* This isn't the response we were looking for */
             return;
         }
 
-        /* We have the right response, release the instance ID and process */
-        io.set_enabled(Enabled::Off);
-        instanceIdDb.free(pldmTID, instanceID);
-
-        if (response->payload[0] != PLDM_SUCCESS)
-        {
-            error("Getting the wrong response. PLDM RC = {RC}", "RC",
-                  (unsigned)response->payload[0]);
-            exit(-1);
-        }
-
-        responseReceived = true;
-
-        // Start Timer
-        using namespace std::chrono;
-        auto timeMicroseconds =
-            duration_cast<microseconds>(seconds(SOFTOFF_TIMEOUT_SECONDS));
-
-        auto ret = startTimer(timeMicroseconds);
-        if (ret < 0)
-        {
-            error(
-                "Failure to start Host soft off wait timer, ERRNO = {RET}. Exit the pldm-softpoweroff",
-                "RET", ret);
-            exit(-1);
-        }
-        else
+        auto response = reinterpret_cast<pldm_msg*>(responseMsgPtr.get());
+        pldm_header_info hdrFields{};
+        if (unpack_pldm_header(&response->hdr, &hdrFields) ||
+            hdrFields.msg_type != PLDM_RESPONSE)
         {
-            error(
-                "Timer started waiting for host soft off, TIMEOUT_IN_SEC = {TIMEOUT_SEC}",
-                "TIMEOUT_SEC", SOFTOFF_TIMEOUT_SECONDS);
+            /* This isn't the response we were looking for */
+            return;
         }
-        return;
+        handler.handleResponse(pldmTID, hdrFields.instance,
+                               hdrFields.pldm_type, hdrFields.command,
+                               response,
+                               responseMsgSize - sizeof(pldm_msg_hdr));
     };
     IO io(event, pldmTransport.getEventSource(), EPOLLIN, std::move(callback));
 
-    // Asynchronously send the PLDM request
-    rc = pldmTransport.sendMsg(pldmTID, requestMsg.data(), requestMsg.size());
-    if (0 > rc)
+    // The handler owns the instance ID from here on, it retries the request
+    // and reports no response once the instance ID expires
+    rc = handler.registerRequest(
+        pldmTID, instanceID, PLDM_PLATFORM, PLDM_SET_STATE_EFFECTER_STATES,
+        std::move(requestMsg),
+        [this](mctp_eid_t /*eid*/, const pldm_msg* response,
+               size_t respMsgLen) { processResponse(response, respMsgLen); });
+    if (rc != PLDM_SUCCESS)
     {
         instanceIdDb.free(pldmTID, instanceID);
-        error(
-            "Failed to send message/receive response. RC = {RC}, errno = {ERR}",
-            "RC", static_cast<int>(rc), "ERR", errno);
+        error("Failed to send the soft off request to the host, RC = {RC}",
+              "RC", static_cast<int>(rc));
         return PLDM_ERROR;
     }
 
+    // The handler doesn't call back when the request can't be sent at all,
+    // give up once the instance ID would have expired
+    sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> responseTimer(
+        event,
+        [this](auto&) {
+        if (!responseReceived)
+        {
+            error("PLDM soft off: No response from the host, giving up");
+            hasError = true;
+        }
+    },
+        std::nullopt);
+    responseTimer.restartOnce(
+        std::chrono::seconds(INSTANCE_ID_EXPIRATION_INTERVAL + 1));
+
     // Time out or soft off complete
-    while (!isCompleted() && !isTimerExpired())
+    while (!isCompleted() && !isTimerExpired() && !isError())
     {
         try
         {
@@ -429,7 +400,6 @@ int SoftPowerOff::hostSoftOff(sdeventplus::Event& event)
         }
         catch (const sdeventplus::SdEventError& e)
         {
-            instanceIdDb.free(pldmTID, instanceID);
             error(
                 "PLDM host soft off: Failure in processing request.ERROR= {ERR_EXCEP}",
                 "ERR_EXCEP", e.what());
@@ -437,11 +407,11 @@ int SoftPowerOff::hostSoftOff(sdeventplus::Event& event)
         }
     }
 
-    return PLDM_SUCCESS;
+    return isError() ? PLDM_ERROR : PLDM_SUCCESS;
 }
 
-int SoftPowerOff::startTimer(const std::chrono::microseconds& usec)
+void SoftPowerOff::startTimer(const std::chrono::microseconds& usec)
 {
-    return timer.start(usec);
+    timer.restartOnce(usec);
 }
 } // namespace pldm
@@ -3,11 +3,16 @@
 #include "common/transport.hpp"
 #include "common/types.hpp"
 
+#include <libpldm/base.h>
+
 #include <sdbusplus/bus.hpp>
 #include <sdbusplus/server.hpp>
 #include <sdbusplus/server/object.hpp>
-#include <sdbusplus/timer.hpp>
+#include <sdeventplus/clock.hpp>
 #include <sdeventplus/event.hpp>
+#include <sdeventplus/utility/timer.hpp>
+
+#include <vector>
 
 namespace pldm
 {
@@ -21,9 +26,9 @@ class SoftPowerOff
     /** @brief Constructs SoftPowerOff object.
      *
      *  @param[in] bus       - system D-Bus handler
-     *  @param[in] event     - sd_event handler
+     *  @param[in] event     - event loop
      */
-    SoftPowerOff(sdbusplus::bus_t& bus, sd_event* event);
+    SoftPowerOff(sdbusplus::bus_t& bus, sdeventplus::Event& event);
 
     /** @brief Is the pldm-softpoweroff has error.
      * if hasError is true, that means the pldm-softpoweroff failed to
@@ -38,7 +43,7 @@ class SoftPowerOff
      */
     inline bool isTimerExpired()
     {
-        return timer.isExpired();
+        return timer.hasExpired();
     }
 
     /** @brief Is the host soft off completed.
@@ -58,6 +63,10 @@ class SoftPowerOff
     /** @brief Send PLDM Set State Effecter States command and
      * wait the host gracefully shutdown.
      *
+     * The request goes through the requester handler of pldmd, which retries
+     * it until the instance ID expires. The wait then ends on the state
+     * sensor event of the host, or on the soft off timeout.
+     *
      *  @param[in] event - The event loop.
      *
      *  @return PLDM_SUCCESS or PLDM_ERROR.
@@ -71,9 +80,9 @@ class SoftPowerOff
 
     /** @brief Stop the timer.
      */
-    inline auto stopTimer()
+    inline void stopTimer()
     {
-        return timer.stop();
+        timer.setEnabled(false);
     }
 
     /** @brief When host soft off completed, stop the timer and
@@ -86,10 +95,29 @@ class SoftPowerOff
     /** @brief Start the timer.
      *
      *  @param[in] usec - Time to wait for the Host to gracefully shutdown.
+     */
+    void startTimer(const std::chrono::microseconds& usec);
+
+    /** @brief Handle the response of the Set State Effecter States request
+     *         and start waiting for the host to shut down
+     *
+     *  @param[in] response - the response, nullptr if none was received
+     *  @param[in] respMsgLen - length of the response payload
+     */
+    void processResponse(const pldm_msg* response, size_t respMsgLen);
+
+    /** @brief Find the PDRs of a logical entity with the software
+     *         termination status state set, through the PDR index of pldmd
+     *
+     *  @param[in] method - FindStateEffecterPDR or FindStateSensorPDR
+     *  @param[in] entityType - the entity type, without the logical bit
+     *
+     *  @return the PDRs found
      *
-     *  @return Success or exception thrown
+     *  @throw sdbusplus::exception_t when the lookup fails
      */
-    int startTimer(const std::chrono::microseconds& usec);
+    std::vector<std::vector<uint8_t>>
+        findStatePDRs(const char* method, pdr::EntityType entityType);
 
     /** @brief Get effecterID from PDRs.
      *
@@ -134,8 +162,8 @@ class SoftPowerOff
     /* @brief sdbusplus handle */
     sdbusplus::bus_t& bus;
 
-    /** @brief Reference to Timer object */
-    phosphor::Timer timer;
+    /** @brief Timer of the wait for the host to shut down */
+    sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> timer;
 
     /** @brief Used to subscribe to dbus pldm StateSensorEvent signal
      * When the host soft off is complete, it sends an platform event message
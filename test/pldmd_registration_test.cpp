@@ -2,7 +2,7 @@
 
 #include <libpldm/base.h>
 
-#include <stdexcept>
+#include <array>
 
 #include <gtest/gtest.h>
 
@@ -44,17 +44,139 @@ TEST(Registration, testSuccess)
     Invoker invoker{};
     invoker.registerHandler(testType, std::make_unique<TestHandler>());
     auto result = invoker.handle(testType, testCmd, nullptr, 0);
-    ASSERT_EQ(result[0], 100);
-    ASSERT_EQ(result[1], 200);
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ((*result)[0], 100);
+    ASSERT_EQ((*result)[1], 200);
 }
 
 TEST(Registration, testFailure)
 {
     Invoker invoker{};
-    ASSERT_THROW(invoker.handle(testType, testCmd, nullptr, 0),
-                 std::out_of_range);
+    EXPECT_FALSE(invoker.handle(testType, testCmd, nullptr, 0).has_value());
     invoker.registerHandler(testType, std::make_unique<TestHandler>());
     uint8_t badCmd = 0xFE;
-    ASSERT_THROW(invoker.handle(testType, badCmd, nullptr, 0),
-                 std::out_of_range);
+    EXPECT_FALSE(invoker.handle(testType, badCmd, nullptr, 0).has_value());
+}
+
+TEST(CommandTable, testFirstRegistrationKept)
+{
+    CommandTable<HandlerFunc> table;
+    EXPECT_EQ(table.find(testCmd), nullptr);
+    EXPECT_TRUE(table.emplace(testCmd, [](const pldm_msg*, size_t) {
+        return Response{1};
+    }));
+    EXPECT_FALSE(table.emplace(testCmd, [](const pldm_msg*, size_t) {
+        return Response{2};
+    }));
+    EXPECT_TRUE(table.emplace(0, [](const pldm_msg*, size_t) {
+        return Response{3};
+    }));
+
+    ASSERT_NE(table.find(testCmd), nullptr);
+    EXPECT_EQ((*table.find(testCmd))(nullptr, 0), Response{1});
+    ASSERT_NE(table.find(0), nullptr);
+    EXPECT_EQ((*table.find(0))(nullptr, 0), Response{3});
+    EXPECT_EQ(table.find(1), nullptr);
+}
+
+class TestAsyncHandler : public CmdHandler
+{
+  public:
+    TestAsyncHandler()
+    {
+        asyncHandlers.emplace(testCmd,
+                              [this](const pldm_msg* /*request*/,
+                                     size_t /*payloadLength*/,
+                                     ResponseSender&& respond) {
+            pending = std::move(respond);
+        });
+    }
+
+    ResponseSender pending;
+};
+
+TEST(Registration, testDeferredResponse)
+{
+    Invoker invoker{};
+    auto handler = std::make_unique<TestAsyncHandler>();
+    auto testHandler = handler.get();
+    invoker.registerHandler(testType, std::move(handler));
+
+    Response response;
+    ASSERT_TRUE(invoker.handleAsync(
+        testType, testCmd, nullptr, 0,
+        [&response](Response&& resp) { response = std::move(resp); }));
+    ASSERT_TRUE(response.empty());
+
+    /* The response is sent once the handler completes */
+    testHandler->pending({100, 200});
+    EXPECT_EQ(response, (Response{100, 200}));
+
+    uint8_t badCmd = 0xFE;
+    EXPECT_FALSE(invoker.handleAsync(testType, badCmd, nullptr, 0,
+                                     [](Response&&) {}));
+    EXPECT_FALSE(invoker.handleAsync(0xFE, testCmd, nullptr, 0,
+                                     [](Response&&) {}));
+}
+
+class TestPrecomputedHandler : public CmdHandler
+{
+  public:
+    TestPrecomputedHandler()
+    {
+        handlers.emplace(testCmd,
+                         [this](const pldm_msg* request, size_t payloadLength) {
+            calls++;
+            Response response(sizeof(pldm_msg_hdr) + 1, 0);
+            auto ptr = reinterpret_cast<pldm_msg*>(response.data());
+            ptr->hdr.instance_id = request->hdr.instance_id;
+            ptr->payload[0] = payloadLength ? request->payload[0] : 0;
+            return response;
+        },
+                         true);
+    }
+
+    size_t calls = 0;
+};
+
+TEST(Registration, testPrecomputedResponse)
+{
+    TestPrecomputedHandler handler;
+    std::array<uint8_t, sizeof(pldm_msg_hdr) + 1> requestMsg{};
+    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+
+    request->hdr.instance_id = 1;
+    request->payload[0] = 0x10;
+    auto response = handler.handle(testCmd, request, 1);
+    ASSERT_TRUE(response.has_value());
+    EXPECT_EQ(handler.calls, 1);
+
+    /* Same payload, the cached response gets the new instance ID */
+    request->hdr.instance_id = 2;
+    response = handler.handle(testCmd, request, 1);
+    ASSERT_TRUE(response.has_value());
+    EXPECT_EQ(handler.calls, 1);
+    auto ptr = reinterpret_cast<const pldm_msg*>(response->data());
+    EXPECT_EQ(ptr->hdr.instance_id, 2);
+    EXPECT_EQ(ptr->payload[0], 0x10);
+
+    /* Another payload is encoded by the handler */
+    request->payload[0] = 0x20;
+    response = handler.handle(testCmd, request, 1);
+    EXPECT_EQ(handler.calls, 2);
+    ptr = reinterpret_cast<const pldm_msg*>(response->data());
+    EXPECT_EQ(ptr->payload[0], 0x20);
+
+    /* Past the cache bound, the handler still answers */
+    for (size_t i = 0; i < CmdHandler::maxPrecomputedPayloads; i++)
+    {
+        request->payload[0] = 0x30 + i;
+        handler.handle(testCmd, request, 1);
+    }
+    size_t calls = handler.calls;
+    request->payload[0] = 0x30 + CmdHandler::maxPrecomputedPayloads - 1;
+    response = handler.handle(testCmd, request, 1);
+    EXPECT_EQ(handler.calls, calls + 1);
+    ptr = reinterpret_cast<const pldm_msg*>(response->data());
+    EXPECT_EQ(ptr->payload[0], request->payload[0]);
 }
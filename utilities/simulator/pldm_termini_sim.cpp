@@ -0,0 +1,634 @@
+#include "sim_terminus.hpp"
+
+#include <libpldm/base.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <CLI/CLI.hpp>
+#include <nlohmann/json.hpp>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/server/interface.hpp>
+#include <sdbusplus/server/manager.hpp>
+#include <sdbusplus/vtable.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/io.hpp>
+#include <sdeventplus/utility/timer.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <queue>
+#include <random>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+using namespace pldm::sim;
+using namespace sdeventplus;
+using namespace sdeventplus::source;
+using Timer = sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>;
+using json = nlohmann::json;
+
+namespace
+{
+
+/** @brief Abstract socket of the mctp-demux-daemon, which libpldm connects
+ *  to */
+constexpr char demuxSocket[] = "\0mctp-mux";
+constexpr uint8_t mctpTypePLDM = 1;
+
+constexpr auto mctpService = "xyz.openbmc_project.MCTP";
+constexpr auto mctpPath = "/xyz/openbmc_project/mctp";
+constexpr auto endpointInterface = "xyz.openbmc_project.MCTP.Endpoint";
+
+/** @struct Options
+ *  @brief Command line of the simulator
+ */
+struct Options
+{
+    size_t termini = 1;
+    uint8_t firstEid = 8;
+    TerminusConfig terminus;
+    double latencyMs = 0;
+    double jitterMs = 0;
+    double loss = 0;
+    double rasRate = 0;
+    double duration = 60;
+    double reportInterval = 10;
+    std::string exec;
+};
+
+/** @struct Frame
+ *  @brief Response or event message waiting for its simulated latency
+ */
+struct Frame
+{
+    Clock::time_point due;
+    uint64_t sequence;
+    uint8_t eid;
+    std::vector<uint8_t> msg;
+
+    bool operator>(const Frame& other) const
+    {
+        return due != other.due ? due > other.due : sequence > other.sequence;
+    }
+};
+
+/** @struct Endpoint
+ *  @brief MCTP D-Bus endpoint of a simulated terminus
+ */
+struct Endpoint
+{
+    uint8_t eid;
+    std::string path;
+    std::unique_ptr<sdbusplus::server::interface::interface> object;
+};
+
+int getEndpointProperty(sd_bus* /*bus*/, const char* /*path*/,
+                        const char* /*interface*/, const char* property,
+                        sd_bus_message* reply, void* context,
+                        sd_bus_error* /*error*/)
+{
+    auto endpoint = static_cast<Endpoint*>(context);
+    if (!std::strcmp(property, "EID"))
+    {
+        return sd_bus_message_append(reply, "y", endpoint->eid);
+    }
+    if (!std::strcmp(property, "SupportedMessageTypes"))
+    {
+        return sd_bus_message_append_array(reply, 'y', &mctpTypePLDM,
+                                           sizeof(mctpTypePLDM));
+    }
+    return -EINVAL;
+}
+
+constexpr sdbusplus::vtable::vtable_t endpointVtable[] = {
+    sdbusplus::vtable::start(),
+    sdbusplus::vtable::property("EID", "y", getEndpointProperty),
+    sdbusplus::vtable::property("SupportedMessageTypes", "ay",
+                                getEndpointProperty),
+    sdbusplus::vtable::end()};
+
+/** @brief Count, mean and percentiles of samples */
+json summarize(std::vector<double> samples)
+{
+    json summary{{"count", samples.size()}};
+    if (samples.empty())
+    {
+        return summary;
+    }
+    std::sort(samples.begin(), samples.end());
+    auto percentile = [&samples](double p) {
+        return samples[std::min(samples.size() - 1,
+                                static_cast<size_t>(p * samples.size()))];
+    };
+    summary["meanMs"] = std::accumulate(samples.begin(), samples.end(), 0.0) /
+                        samples.size();
+    summary["p50Ms"] = percentile(0.50);
+    summary["p99Ms"] = percentile(0.99);
+    summary["maxMs"] = samples.back();
+    return summary;
+}
+
+/** @struct ProcessSample
+ *  @brief CPU time and memory of the daemon
+ */
+struct ProcessSample
+{
+    Clock::time_point time;
+    uint64_t cpuTicks = 0;
+    uint64_t rssKiB = 0;
+    uint64_t hwmKiB = 0;
+};
+
+std::optional<ProcessSample> sampleProcess(pid_t pid)
+{
+    std::ifstream statFile("/proc/" + std::to_string(pid) + "/stat");
+    std::string stat;
+    if (!std::getline(statFile, stat))
+    {
+        return std::nullopt;
+    }
+    ProcessSample sample{};
+    sample.time = Clock::now();
+
+    /* utime and stime are the 14th and 15th fields, the 2nd field is the
+     * command in parentheses and may hold spaces */
+    std::istringstream fields(stat.substr(stat.rfind(')') + 2));
+    std::string field;
+    for (int i = 3; i < 14 && fields >> field; i++)
+    {}
+    uint64_t utime = 0;
+    uint64_t stime = 0;
+    fields >> utime >> stime;
+    sample.cpuTicks = utime + stime;
+
+    std::ifstream statusFile("/proc/" + std::to_string(pid) + "/status");
+    std::string line;
+    while (std::getline(statusFile, line))
+    {
+        std::istringstream value(line.substr(line.find(':') + 1));
+        if (line.starts_with("VmRSS:"))
+        {
+            value >> sample.rssKiB;
+        }
+        else if (line.starts_with("VmHWM:"))
+        {
+            value >> sample.hwmKiB;
+        }
+    }
+    return sample;
+}
+
+/** @brief Find the PID of a pldmd started independently of the simulator */
+pid_t findDaemon()
+{
+    for (const auto& entry : std::filesystem::directory_iterator("/proc"))
+    {
+        std::ifstream comm(entry.path() / "comm");
+        std::string name;
+        if (std::getline(comm, name) && name == "pldmd")
+        {
+            return std::stoi(entry.path().filename().string());
+        }
+    }
+    return -1;
+}
+
+/** @class Simulator
+ *
+ *  Stands in for the mctp-demux-daemon and mctpd: serves the demux socket
+ *  libpldm connects to, publishes an MCTP endpoint per terminus on D-Bus and
+ *  routes the daemon requests to the simulated termini, with the configured
+ *  latency and loss.
+ */
+class Simulator
+{
+  public:
+    Simulator(Event& event, sdbusplus::bus::bus& bus, const Options& options) :
+        event(event), options(options), random(std::random_device{}()),
+        sendTimer(event, [this](Timer&) { flush(); })
+    {
+        listenFd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                          0);
+        if (listenFd < 0)
+        {
+            throw std::system_error(errno, std::generic_category(), "socket");
+        }
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        std::memcpy(addr.sun_path, demuxSocket, sizeof(demuxSocket) - 1);
+        if (bind(listenFd, reinterpret_cast<sockaddr*>(&addr),
+                 offsetof(sockaddr_un, sun_path) + sizeof(demuxSocket) - 1) <
+                0 ||
+            listen(listenFd, SOMAXCONN) < 0)
+        {
+            throw std::system_error(errno, std::generic_category(),
+                                    "mctp-mux socket, is the "
+                                    "mctp-demux-daemon running?");
+        }
+        listenIO = std::make_unique<IO>(event, listenFd, EPOLLIN,
+                                        [this](IO&, int, uint32_t) {
+            accept();
+        });
+
+        for (size_t i = 0; i < options.termini; i++)
+        {
+            uint8_t eid = options.firstEid + i;
+            termini.emplace_back(std::make_unique<Terminus>(eid,
+                                                            options.terminus));
+            instanceIds.emplace_back(0);
+
+            auto endpoint = std::make_unique<Endpoint>();
+            endpoint->eid = eid;
+            endpoint->path = std::string(mctpPath) + "/1/" +
+                             std::to_string(eid);
+            endpoint->object =
+                std::make_unique<sdbusplus::server::interface::interface>(
+                    bus, endpoint->path.c_str(), endpointInterface,
+                    endpointVtable, endpoint.get());
+            endpoints.emplace_back(std::move(endpoint));
+        }
+        bus.request_name(mctpService);
+        for (auto& endpoint : endpoints)
+        {
+            endpoint->object->emit_added();
+        }
+
+        if (options.rasRate > 0)
+        {
+            auto interval = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::duration<double>(1 / options.rasRate));
+            for (size_t i = 0; i < termini.size(); i++)
+            {
+                rasTimers.emplace_back(std::make_unique<Timer>(
+                    event, [this, i](Timer&) { queueEvent(i); }, interval));
+            }
+        }
+    }
+
+    ~Simulator()
+    {
+        clients.clear();
+        listenIO.reset();
+        close(listenFd);
+    }
+
+    /** @brief Report of the termini, as JSON */
+    json report() const
+    {
+        json result = json::array();
+        for (const auto& terminus : termini)
+        {
+            const auto& stats = terminus->getStats();
+            json requests = json::object();
+            for (const auto& [command, count] : stats.requests)
+            {
+                requests[std::to_string(command)] = count;
+            }
+            json entry{{"eid", terminus->getEid()},
+                       {"requests", requests},
+                       {"sensorReads", stats.sensorReads},
+                       {"pollInterval", summarize(stats.pollInterval.samples)},
+                       {"eventsQueued", stats.eventsQueued},
+                       {"eventsAcked", stats.eventsAcked},
+                       {"eventLatency", summarize(stats.eventLatency.samples)}};
+            if (stats.sensorReads)
+            {
+                entry["discoveryMs"] = std::chrono::duration<double, std::milli>(
+                                           stats.firstReading -
+                                           stats.firstRequest)
+                                           .count();
+            }
+            result.emplace_back(std::move(entry));
+        }
+        return result;
+    }
+
+    /** @brief One line of progress */
+    std::string progress() const
+    {
+        size_t discovered = 0;
+        uint64_t reads = 0;
+        uint64_t queued = 0;
+        uint64_t acked = 0;
+        for (const auto& terminus : termini)
+        {
+            const auto& stats = terminus->getStats();
+            discovered += stats.sensorReads ? 1 : 0;
+            reads += stats.sensorReads;
+            queued += stats.eventsQueued;
+            acked += stats.eventsAcked;
+        }
+        return "discovered " + std::to_string(discovered) + "/" +
+               std::to_string(termini.size()) + " termini, " +
+               std::to_string(reads) + " sensor reads, " +
+               std::to_string(acked) + "/" + std::to_string(queued) +
+               " events acknowledged, " + std::to_string(dropped) +
+               " requests dropped";
+    }
+
+  private:
+    /** @struct Client
+     *  @brief Connection of the demux socket
+     */
+    struct Client
+    {
+        int fd;
+        std::optional<uint8_t> type;
+        std::unique_ptr<IO> io;
+
+        ~Client()
+        {
+            io.reset();
+            if (fd >= 0)
+            {
+                close(fd);
+            }
+        }
+    };
+
+    void accept()
+    {
+        int fd = accept4(listenFd, nullptr, nullptr,
+                         SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0)
+        {
+            return;
+        }
+        std::erase_if(clients, [](const auto& c) { return c->fd < 0; });
+        auto client = std::make_unique<Client>();
+        client->fd = fd;
+        client->io = std::make_unique<IO>(event, fd, EPOLLIN,
+                                          [this, fd](IO&, int, uint32_t) {
+            receive(fd);
+        });
+        clients.emplace_back(std::move(client));
+    }
+
+    void receive(int fd)
+    {
+        auto client = std::find_if(clients.begin(), clients.end(),
+                                   [fd](const auto& c) { return c->fd == fd; });
+        if (client == clients.end())
+        {
+            return;
+        }
+
+        auto length = recv(fd, nullptr, 0, MSG_PEEK | MSG_TRUNC);
+        if (length <= 0)
+        {
+            /* The source is not destroyed from its own callback, the
+             * client is removed on the next connection */
+            if (length == 0 || (errno != EAGAIN && errno != EINTR))
+            {
+                (*client)->io->set_enabled(Enabled::Off);
+                close(fd);
+                (*client)->fd = -1;
+            }
+            return;
+        }
+        std::vector<uint8_t> frame(length);
+        if (recv(fd, frame.data(), frame.size(), 0) != length)
+        {
+            return;
+        }
+
+        /* The first byte of a demux client is the MCTP message type it
+         * registers for, then each frame is the EID, the message type and
+         * the message */
+        if (!(*client)->type)
+        {
+            (*client)->type = frame[0];
+            return;
+        }
+        if (frame.size() < 2 + sizeof(pldm_msg_hdr) ||
+            frame[1] != mctpTypePLDM)
+        {
+            return;
+        }
+        uint8_t eid = frame[0];
+        if (eid < options.firstEid ||
+            eid - options.firstEid >= static_cast<int>(termini.size()))
+        {
+            return;
+        }
+        auto& terminus = termini[eid - options.firstEid];
+        auto msg = reinterpret_cast<const pldm_msg*>(frame.data() + 2);
+        if (!msg->hdr.request)
+        {
+            /* Response of the daemon to an event message */
+            return;
+        }
+        if (options.loss > 0 &&
+            std::uniform_real_distribution<double>(0, 1)(random) <
+                options.loss)
+        {
+            dropped++;
+            return;
+        }
+        schedule(eid, terminus->handleRequest(msg, frame.size() - 2 -
+                                                       sizeof(pldm_msg_hdr)));
+    }
+
+    void queueEvent(size_t index)
+    {
+        auto& terminus = termini[index];
+        /* The daemon polls the events once the terminus is discovered */
+        if (!terminus->getStats().sensorReads)
+        {
+            return;
+        }
+        auto& instanceId = instanceIds[index];
+        schedule(terminus->getEid(), terminus->queueEvent(instanceId));
+        instanceId = (instanceId + 1) % (PLDM_INSTANCE_MAX + 1);
+    }
+
+    void schedule(uint8_t eid, std::vector<uint8_t>&& msg)
+    {
+        auto delay = options.latencyMs;
+        if (options.jitterMs > 0)
+        {
+            delay += std::uniform_real_distribution<double>(0, options.jitterMs)(
+                random);
+        }
+        auto due = Clock::now() +
+                   std::chrono::duration_cast<Clock::duration>(
+                       std::chrono::duration<double, std::milli>(delay));
+        pending.push({due, sequence++, eid, std::move(msg)});
+        flush();
+    }
+
+    /** @brief Send the frames which are due, then wait for the next one */
+    void flush()
+    {
+        auto now = Clock::now();
+        while (!pending.empty() && pending.top().due <= now)
+        {
+            const auto& frame = pending.top();
+            std::vector<uint8_t> buffer{frame.eid, mctpTypePLDM};
+            buffer.insert(buffer.end(), frame.msg.begin(), frame.msg.end());
+            for (const auto& client : clients)
+            {
+                if (client->type == mctpTypePLDM)
+                {
+                    send(client->fd, buffer.data(), buffer.size(),
+                         MSG_NOSIGNAL);
+                }
+            }
+            pending.pop();
+        }
+        if (!pending.empty())
+        {
+            sendTimer.restartOnce(
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    pending.top().due - now));
+        }
+    }
+
+    Event& event;
+    const Options& options;
+    std::mt19937 random;
+    int listenFd = -1;
+    std::unique_ptr<IO> listenIO;
+    std::vector<std::unique_ptr<Client>> clients;
+    std::vector<std::unique_ptr<Terminus>> termini;
+    std::vector<uint8_t> instanceIds;
+    std::vector<std::unique_ptr<Endpoint>> endpoints;
+    std::vector<std::unique_ptr<Timer>> rasTimers;
+    std::priority_queue<Frame, std::vector<Frame>, std::greater<>> pending;
+    uint64_t sequence = 0;
+    uint64_t dropped = 0;
+    Timer sendTimer;
+};
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    CLI::App app{"Simulate MCTP PLDM termini to load test pldmd"};
+    Options options;
+    app.add_option("-n,--termini", options.termini, "Number of termini");
+    app.add_option("--first-eid", options.firstEid, "EID of the first terminus");
+    app.add_option("-s,--sensors", options.terminus.sensors,
+                   "Compact numeric sensors of each terminus");
+    app.add_option("-p,--pdrs", options.terminus.pdrs,
+                   "PDRs of each terminus, padded with OEM PDRs");
+    app.add_flag("-b,--batch", options.terminus.batchReads,
+                 "Support the OEM GetSensorReadings");
+    app.add_option("-l,--latency-ms", options.latencyMs, "Response latency");
+    app.add_option("-j,--jitter-ms", options.jitterMs,
+                   "Random latency added to each response");
+    app.add_option("--loss", options.loss,
+                   "Probability of dropping a request")
+        ->check(CLI::Range(0.0, 1.0));
+    app.add_option("-r,--ras-rate", options.rasRate,
+                   "RAS events per second of each terminus");
+    app.add_option("--ras-size", options.terminus.rasEventSize,
+                   "Size of the RAS event data");
+    app.add_option("--ras-part-size", options.terminus.rasPartSize,
+                   "Event data of one poll response")
+        ->check(CLI::PositiveNumber);
+    app.add_option("-d,--duration", options.duration, "Seconds to run");
+    app.add_option("--report-interval", options.reportInterval,
+                   "Seconds between two progress lines");
+    app.add_option("-e,--exec", options.exec,
+                   "Command starting pldmd, else the running pldmd is "
+                   "measured");
+    CLI11_PARSE(app, argc, argv);
+
+    auto event = Event::get_default();
+    auto bus = sdbusplus::bus::new_default();
+    sdbusplus::server::manager_t objManager(bus, mctpPath);
+    bus.attach_event(event.get(), SD_EVENT_PRIORITY_NORMAL);
+
+    std::unique_ptr<Simulator> simulator;
+    try
+    {
+        simulator = std::make_unique<Simulator>(event, bus, options);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Failed to start the simulator, " << e.what() << "\n";
+        return -1;
+    }
+
+    pid_t daemon = -1;
+    if (!options.exec.empty())
+    {
+        daemon = fork();
+        if (daemon == 0)
+        {
+            /* exec, so that the measured PID is the one of the daemon */
+            auto command = "exec " + options.exec;
+            execl("/bin/sh", "sh", "-c", command.c_str(), nullptr);
+            _exit(127);
+        }
+    }
+    auto start = Clock::now();
+
+    std::optional<ProcessSample> first;
+    auto sample = [&]() {
+        if (daemon < 0)
+        {
+            daemon = findDaemon();
+        }
+        auto current = daemon < 0 ? std::nullopt : sampleProcess(daemon);
+        if (!first)
+        {
+            first = current;
+        }
+        return current;
+    };
+    sample();
+
+    Timer reportTimer(
+        event,
+        [&](Timer&) {
+        sample();
+        std::cerr << "pldm-termini-sim: " << simulator->progress() << "\n";
+    },
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::duration<double>(options.reportInterval)));
+    Timer stopTimer(
+        event, [&](Timer&) { event.exit(0); },
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::duration<double>(options.duration)));
+    event.loop();
+
+    json report{{"termini", simulator->report()},
+                {"durationS", std::chrono::duration<double>(Clock::now() -
+                                                            start)
+                                  .count()}};
+    auto last = sample();
+    if (first && last && last->time > first->time)
+    {
+        auto seconds =
+            std::chrono::duration<double>(last->time - first->time).count();
+        report["pldmd"] = {
+            {"pid", daemon},
+            {"cpuPercent", 100.0 * (last->cpuTicks - first->cpuTicks) /
+                               sysconf(_SC_CLK_TCK) / seconds},
+            {"rssKiB", last->rssKiB},
+            {"hwmKiB", last->hwmKiB}};
+    }
+    std::cout << report.dump(2) << std::endl;
+
+    if (!options.exec.empty() && daemon > 0)
+    {
+        kill(daemon, SIGTERM);
+        waitpid(daemon, nullptr, 0);
+    }
+    return 0;
+}
@@ -0,0 +1,546 @@
+#include "sim_terminus.hpp"
+
+#include "requester/cper.hpp"
+#include "requester/oem_sensor_readings.hpp"
+
+#include <endian.h>
+#include <libpldm/utils.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+namespace pldm
+{
+
+namespace sim
+{
+
+namespace
+{
+
+/** @brief PDR type of the filler PDRs, ignored by the daemon */
+constexpr uint8_t oemPdrType = 127;
+
+/** @brief Size of the OEM PDR data after the common header */
+constexpr size_t oemPdrDataSize = 16;
+
+/** @brief Ampere specific CPER section type */
+constexpr Guid ampereSpecific = {
+    0x2826cc9f, 0x448c, 0x4c2b,
+    {0x86, 0xb6, 0xa9, 0x53, 0x94, 0xb7, 0xef, 0x33}};
+
+/** @brief Event IDs which do not identify an event in the poll response */
+constexpr uint16_t noEventId = 0x0000;
+constexpr uint16_t moreEventsId = 0xffff;
+
+void setBit(bitfield8_t* bits, size_t bit)
+{
+    bits[bit / 8].byte |= 1 << (bit % 8);
+}
+
+std::vector<uint8_t> ccOnlyResponse(const pldm_msg* request, uint8_t cc)
+{
+    std::vector<uint8_t> response(sizeof(pldm_msg_hdr) + sizeof(cc));
+    encode_cc_only_resp(request->hdr.instance_id, request->hdr.type,
+                        request->hdr.command, cc,
+                        reinterpret_cast<pldm_msg*>(response.data()));
+    return response;
+}
+
+/** @brief Header of a response to the request */
+std::vector<uint8_t> responseHeader(const pldm_msg* request)
+{
+    std::vector<uint8_t> response(sizeof(pldm_msg_hdr));
+    pldm_header_info header{};
+    header.msg_type = PLDM_RESPONSE;
+    header.instance = request->hdr.instance_id;
+    header.pldm_type = request->hdr.type;
+    header.command = request->hdr.command;
+    pack_pldm_header(&header,
+                     reinterpret_cast<pldm_msg_hdr*>(response.data()));
+    return response;
+}
+
+template <typename T>
+void append(std::vector<uint8_t>& msg, T value)
+{
+    auto bytes = reinterpret_cast<const uint8_t*>(&value);
+    msg.insert(msg.end(), bytes, bytes + sizeof(value));
+}
+
+std::vector<uint8_t> compactNumericSensorPDR(uint8_t eid, uint16_t sensorId)
+{
+    auto name = "SIM" + std::to_string(eid) + "_Temp" +
+                std::to_string(sensorId);
+    std::vector<uint8_t> pdr(
+        offsetof(pldm_compact_numeric_sensor_pdr, sensor_name) + name.size());
+    auto sensor = reinterpret_cast<pldm_compact_numeric_sensor_pdr*>(
+        pdr.data());
+    sensor->hdr.record_handle = sensorId + 1;
+    sensor->hdr.version = 1;
+    sensor->hdr.type = PLDM_COMPACT_NUMERIC_SENSOR_PDR;
+    sensor->hdr.length = pdr.size() - sizeof(pldm_pdr_hdr);
+    sensor->terminus_handle = eid;
+    sensor->sensor_id = sensorId;
+    sensor->entity_type = PLDM_ENTITY_PROC;
+    sensor->entity_instance = 1;
+    sensor->sensor_name_length = name.size();
+    sensor->base_unit = PLDM_SENSOR_UNIT_DEGRESS_C;
+    /* Warning and critical high thresholds */
+    sensor->range_field_support.byte = 0x05;
+    sensor->warning_high = 85;
+    sensor->critical_high = 95;
+    std::memcpy(sensor->sensor_name, name.data(), name.size());
+    return pdr;
+}
+
+std::vector<uint8_t> terminusLocatorPDR(uint8_t eid)
+{
+    std::vector<uint8_t> pdr(sizeof(pldm_terminus_locator_pdr));
+    auto locator = reinterpret_cast<pldm_terminus_locator_pdr*>(pdr.data());
+    locator->hdr.record_handle = 1;
+    locator->hdr.version = 1;
+    locator->hdr.type = PLDM_TERMINUS_LOCATOR_PDR;
+    locator->hdr.length = pdr.size() - sizeof(pldm_pdr_hdr);
+    locator->terminus_handle = eid;
+    locator->validity = PLDM_TL_PDR_VALID;
+    locator->tid = eid;
+    locator->terminus_locator_type = PLDM_TERMINUS_LOCATOR_TYPE_MCTP_EID;
+    locator->terminus_locator_value_size =
+        sizeof(pldm_terminus_locator_type_mctp_eid);
+    auto value = reinterpret_cast<pldm_terminus_locator_type_mctp_eid*>(
+        locator->terminus_locator_value);
+    value->eid = eid;
+    return pdr;
+}
+
+/** @brief CPER record of one Ampere specific section, as the daemon
+ *  decodes the RAS events
+ */
+std::vector<uint8_t> cperEventData(size_t size)
+{
+    constexpr size_t minSize = sizeof(CommonEventData) +
+                               sizeof(CPERRecodHeader) +
+                               sizeof(CPERSectionDescriptor) +
+                               sizeof(AmpereSpecData);
+    std::vector<uint8_t> data(std::max(size, minSize));
+    auto recordSize = data.size() - sizeof(CommonEventData);
+
+    CommonEventData common{};
+    common.formatVersion = 1;
+    common.length = recordSize;
+    std::memcpy(data.data(), &common, sizeof(common));
+
+    CPERRecodHeader header{};
+    std::memcpy(&header.SignatureStart, "CPER", sizeof(header.SignatureStart));
+    header.SectionCount = 1;
+    header.RecordLength = recordSize;
+    std::memcpy(data.data() + sizeof(common), &header, sizeof(header));
+
+    CPERSectionDescriptor section{};
+    section.SectionOffset = sizeof(header) + sizeof(section);
+    section.SectionLength = recordSize - section.SectionOffset;
+    section.SectionType = ampereSpecific;
+    std::memcpy(data.data() + sizeof(common) + sizeof(header), &section,
+                sizeof(section));
+    return data;
+}
+
+} // namespace
+
+Terminus::Terminus(uint8_t eid, const TerminusConfig& config) :
+    eid(eid), config(config), lastReads(config.sensors),
+    eventData(cperEventData(config.rasEventSize))
+{
+    pdrs.emplace_back(terminusLocatorPDR(eid));
+    for (size_t i = 0; i < config.sensors; i++)
+    {
+        pdrs.emplace_back(compactNumericSensorPDR(eid, i + 1));
+    }
+    while (pdrs.size() < config.pdrs)
+    {
+        std::vector<uint8_t> pdr(sizeof(pldm_pdr_hdr) + oemPdrDataSize);
+        auto hdr = reinterpret_cast<pldm_pdr_hdr*>(pdr.data());
+        hdr->version = 1;
+        hdr->type = oemPdrType;
+        hdr->length = oemPdrDataSize;
+        pdrs.emplace_back(std::move(pdr));
+    }
+    for (size_t i = 0; i < pdrs.size(); i++)
+    {
+        reinterpret_cast<pldm_pdr_hdr*>(pdrs[i].data())->record_handle = i + 1;
+    }
+}
+
+std::vector<uint8_t> Terminus::handleRequest(const pldm_msg* request,
+                                             size_t payloadLength)
+{
+    auto now = Clock::now();
+    if (stats.requests.empty())
+    {
+        stats.firstRequest = now;
+    }
+    stats.requests[request->hdr.command]++;
+
+    switch (request->hdr.type)
+    {
+        case PLDM_BASE:
+            switch (request->hdr.command)
+            {
+                case PLDM_GET_PLDM_TYPES:
+                    return getTypes(request);
+                case PLDM_GET_PLDM_COMMANDS:
+                    return getCommands(request, payloadLength);
+                case PLDM_GET_TID:
+                {
+                    std::vector<uint8_t> response(sizeof(pldm_msg_hdr) +
+                                                  PLDM_GET_TID_RESP_BYTES);
+                    encode_get_tid_resp(
+                        request->hdr.instance_id, PLDM_SUCCESS, eid,
+                        reinterpret_cast<pldm_msg*>(response.data()));
+                    return response;
+                }
+            }
+            break;
+        case PLDM_PLATFORM:
+            switch (request->hdr.command)
+            {
+                case PLDM_GET_PDR:
+                    return getPDR(request, payloadLength);
+                case PLDM_SET_EVENT_RECEIVER:
+                    return ccOnlyResponse(request, PLDM_SUCCESS);
+                case PLDM_GET_SENSOR_READING:
+                    return getSensorReading(request, payloadLength);
+                case PLDM_POLL_FOR_PLATFORM_EVENT_MESSAGE:
+                    return pollForEvent(request, payloadLength);
+            }
+            break;
+        case PLDM_OEM:
+            if (config.batchReads &&
+                request->hdr.command ==
+                    pldm::terminus::PLDM_OEM_GET_SENSOR_READINGS)
+            {
+                return getSensorReadings(request, payloadLength);
+            }
+            break;
+    }
+
+    return ccOnlyResponse(request, PLDM_ERROR_UNSUPPORTED_PLDM_CMD);
+}
+
+std::vector<uint8_t> Terminus::getTypes(const pldm_msg* request)
+{
+    bitfield8_t types[PLDM_MAX_TYPES / 8]{};
+    setBit(types, PLDM_BASE);
+    setBit(types, PLDM_PLATFORM);
+    if (config.batchReads)
+    {
+        setBit(types, PLDM_OEM);
+    }
+
+    std::vector<uint8_t> response(sizeof(pldm_msg_hdr) +
+                                  PLDM_GET_TYPES_RESP_BYTES);
+    encode_get_types_resp(request->hdr.instance_id, PLDM_SUCCESS, types,
+                          reinterpret_cast<pldm_msg*>(response.data()));
+    return response;
+}
+
+std::vector<uint8_t> Terminus::getCommands(const pldm_msg* request,
+                                           size_t payloadLength)
+{
+    uint8_t type{};
+    ver32_t version{};
+    if (decode_get_commands_req(request, payloadLength, &type, &version) !=
+        PLDM_SUCCESS)
+    {
+        return ccOnlyResponse(request, PLDM_ERROR_INVALID_DATA);
+    }
+
+    bitfield8_t commands[PLDM_MAX_CMDS_PER_TYPE / 8]{};
+    switch (type)
+    {
+        case PLDM_BASE:
+            for (auto command : {PLDM_GET_TID, PLDM_GET_PLDM_TYPES,
+                                 PLDM_GET_PLDM_COMMANDS})
+            {
+                setBit(commands, command);
+            }
+            break;
+        case PLDM_PLATFORM:
+            for (auto command :
+                 {PLDM_SET_EVENT_RECEIVER, PLDM_GET_SENSOR_READING,
+                  PLDM_POLL_FOR_PLATFORM_EVENT_MESSAGE, PLDM_GET_PDR})
+            {
+                setBit(commands, command);
+            }
+            break;
+        case PLDM_OEM:
+            if (!config.batchReads)
+            {
+                return ccOnlyResponse(request, PLDM_ERROR_INVALID_PLDM_TYPE);
+            }
+            setBit(commands, pldm::terminus::PLDM_OEM_GET_SENSOR_READINGS);
+            break;
+        default:
+            return ccOnlyResponse(request, PLDM_ERROR_INVALID_PLDM_TYPE);
+    }
+
+    std::vector<uint8_t> response(sizeof(pldm_msg_hdr) +
+                                  PLDM_GET_COMMANDS_RESP_BYTES);
+    encode_get_commands_resp(request->hdr.instance_id, PLDM_SUCCESS, commands,
+                             reinterpret_cast<pldm_msg*>(response.data()));
+    return response;
+}
+
+std::vector<uint8_t> Terminus::getPDR(const pldm_msg* request,
+                                      size_t payloadLength)
+{
+    uint32_t recordHandle{};
+    uint32_t dataTransferHandle{};
+    uint8_t transferOpFlag{};
+    uint16_t requestCount{};
+    uint16_t recordChangeNumber{};
+    if (decode_get_pdr_req(request, payloadLength, &recordHandle,
+                           &dataTransferHandle, &transferOpFlag, &requestCount,
+                           &recordChangeNumber) != PLDM_SUCCESS)
+    {
+        return ccOnlyResponse(request, PLDM_ERROR_INVALID_DATA);
+    }
+
+    size_t index = recordHandle ? recordHandle - 1 : 0;
+    if (index >= pdrs.size())
+    {
+        return ccOnlyResponse(request, PLDM_PLATFORM_INVALID_RECORD_HANDLE);
+    }
+    const auto& pdr = pdrs[index];
+    size_t offset = transferOpFlag == PLDM_GET_FIRSTPART ? 0
+                                                         : dataTransferHandle;
+    if (offset >= pdr.size() || !requestCount)
+    {
+        return ccOnlyResponse(request,
+                              PLDM_PLATFORM_INVALID_DATA_TRANSFER_HANDLE);
+    }
+
+    /* The parts are as large as requested, the data transfer handle is the
+     * offset of the next part */
+    size_t count = std::min<size_t>(requestCount, pdr.size() - offset);
+    bool last = offset + count == pdr.size();
+    uint8_t transferFlag = offset ? (last ? PLDM_END : PLDM_MIDDLE)
+                                  : (last ? PLDM_START_AND_END : PLDM_START);
+    uint32_t nextRecordHandle = index + 1 < pdrs.size() ? index + 2 : 0;
+
+    std::vector<uint8_t> response(sizeof(pldm_msg_hdr) +
+                                  PLDM_GET_PDR_MIN_RESP_BYTES + count +
+                                  (transferFlag == PLDM_END ? 1 : 0));
+    encode_get_pdr_resp(request->hdr.instance_id, PLDM_SUCCESS,
+                        nextRecordHandle, last ? 0 : offset + count,
+                        transferFlag, count, pdr.data() + offset,
+                        transferFlag == PLDM_END ? crc8(pdr.data(), pdr.size())
+                                                 : 0,
+                        reinterpret_cast<pldm_msg*>(response.data()));
+    return response;
+}
+
+uint8_t Terminus::readSensor(size_t index)
+{
+    auto now = Clock::now();
+    if (!stats.sensorReads)
+    {
+        stats.firstReading = now;
+    }
+    stats.sensorReads++;
+
+    auto& lastRead = lastReads[index];
+    if (lastRead != Clock::time_point{})
+    {
+        stats.pollInterval.add(now - lastRead);
+    }
+    lastRead = now;
+
+    /* Slowly moving readings under the warning threshold */
+    return 40 + (stats.sensorReads + index) % 16;
+}
+
+std::vector<uint8_t> Terminus::getSensorReading(const pldm_msg* request,
+                                                size_t payloadLength)
+{
+    uint16_t sensorId{};
+    bool8_t rearm{};
+    if (decode_get_sensor_reading_req(request, payloadLength, &sensorId,
+                                      &rearm) != PLDM_SUCCESS)
+    {
+        return ccOnlyResponse(request, PLDM_ERROR_INVALID_DATA);
+    }
+    if (!sensorId || sensorId > config.sensors)
+    {
+        return ccOnlyResponse(request, PLDM_PLATFORM_INVALID_SENSOR_ID);
+    }
+
+    uint8_t reading = readSensor(sensorId - 1);
+    std::vector<uint8_t> response(sizeof(pldm_msg_hdr) +
+                                  PLDM_GET_SENSOR_READING_MIN_RESP_BYTES);
+    encode_get_sensor_reading_resp(
+        request->hdr.instance_id, PLDM_SUCCESS, PLDM_SENSOR_DATA_SIZE_UINT8,
+        PLDM_SENSOR_ENABLED, PLDM_NO_EVENT_GENERATION, PLDM_SENSOR_NORMAL,
+        PLDM_SENSOR_NORMAL, PLDM_SENSOR_NORMAL, &reading,
+        reinterpret_cast<pldm_msg*>(response.data()),
+        PLDM_GET_SENSOR_READING_MIN_RESP_BYTES);
+    return response;
+}
+
+std::vector<uint8_t> Terminus::getSensorReadings(const pldm_msg* request,
+                                                 size_t payloadLength)
+{
+    using namespace pldm::terminus;
+
+    if (!payloadLength)
+    {
+        return ccOnlyResponse(request, PLDM_ERROR_INVALID_LENGTH);
+    }
+    size_t count = request->payload[0];
+    if (!count || count > PLDM_OEM_GET_SENSOR_READINGS_MAX ||
+        payloadLength != oemGetSensorReadingsReqBytes(count))
+    {
+        return ccOnlyResponse(request, PLDM_ERROR_INVALID_LENGTH);
+    }
+
+    auto response = responseHeader(request);
+    append(response, uint8_t{PLDM_SUCCESS});
+    append(response, static_cast<uint8_t>(count));
+    for (size_t i = 0; i < count; i++)
+    {
+        uint16_t sensorId;
+        std::memcpy(&sensorId, request->payload + 1 + i * sizeof(sensorId),
+                    sizeof(sensorId));
+        sensorId = le16toh(sensorId);
+
+        append(response, htole16(sensorId));
+        append(response, uint8_t{PLDM_SENSOR_DATA_SIZE_UINT8});
+        if (!sensorId || sensorId > config.sensors)
+        {
+            append(response, uint8_t{PLDM_SENSOR_UNAVAILABLE});
+            append(response, uint8_t{PLDM_NO_EVENT_GENERATION});
+            append(response, uint8_t{0});
+            continue;
+        }
+        append(response, uint8_t{PLDM_SENSOR_ENABLED});
+        append(response, uint8_t{PLDM_NO_EVENT_GENERATION});
+        append(response, readSensor(sensorId - 1));
+    }
+    return response;
+}
+
+std::vector<uint8_t> Terminus::queueEvent(uint8_t instanceId)
+{
+    auto id = nextEventId++;
+    if (nextEventId == moreEventsId)
+    {
+        nextEventId = 1;
+    }
+    events.push_back({id, Clock::now()});
+    stats.eventsQueued++;
+
+    /* pldmMessagePollEvent: format version, event ID, data transfer
+     * handle */
+    std::vector<uint8_t> eventMsg;
+    append(eventMsg, uint8_t{1});
+    append(eventMsg, htole16(id));
+    append(eventMsg, htole32(uint32_t{id}));
+
+    std::vector<uint8_t> request(sizeof(pldm_msg_hdr) +
+                                 PLDM_PLATFORM_EVENT_MESSAGE_MIN_REQ_BYTES +
+                                 eventMsg.size());
+    encode_platform_event_message_req(
+        instanceId, 1, eid, PLDM_MESSAGE_POLL_EVENT, eventMsg.data(),
+        eventMsg.size(), reinterpret_cast<pldm_msg*>(request.data()),
+        request.size() - sizeof(pldm_msg_hdr));
+    return request;
+}
+
+std::vector<uint8_t> Terminus::pollForEvent(const pldm_msg* request,
+                                            size_t payloadLength)
+{
+    if (payloadLength != PLDM_POLL_FOR_PLATFORM_EVENT_MESSAGE_REQ_BYTES)
+    {
+        return ccOnlyResponse(request, PLDM_ERROR_INVALID_LENGTH);
+    }
+    /* Format version, transfer operation flag, data transfer handle and
+     * event ID to acknowledge */
+    uint8_t operationFlag = request->payload[1];
+    uint32_t dataTransferHandle;
+    std::memcpy(&dataTransferHandle, request->payload + 2,
+                sizeof(dataTransferHandle));
+    dataTransferHandle = le32toh(dataTransferHandle);
+    uint16_t eventIdToAck;
+    std::memcpy(&eventIdToAck, request->payload + 6, sizeof(eventIdToAck));
+    eventIdToAck = le16toh(eventIdToAck);
+
+    auto response = responseHeader(request);
+    append(response, uint8_t{PLDM_SUCCESS});
+    append(response, eid);
+
+    auto event = events.end();
+    if (operationFlag == PLDM_ACKNOWLEDGEMENT_ONLY)
+    {
+        auto acked = std::find_if(events.begin(), events.end(),
+                                  [eventIdToAck](const auto& e) {
+            return e.id == eventIdToAck;
+        });
+        if (acked != events.end())
+        {
+            stats.eventsAcked++;
+            stats.eventLatency.add(Clock::now() - acked->queued);
+            events.erase(acked);
+        }
+    }
+    else if (!events.empty())
+    {
+        /* The first part of an announced event is polled with its ID as
+         * the data transfer handle, the periodic poll takes the oldest */
+        event = std::find_if(events.begin(), events.end(),
+                             [dataTransferHandle](const auto& e) {
+            return e.id == dataTransferHandle;
+        });
+        if (event == events.end() || operationFlag != PLDM_GET_FIRSTPART)
+        {
+            event = events.begin();
+        }
+    }
+
+    if (event == events.end())
+    {
+        append(response, htole16(events.empty() ? noEventId : moreEventsId));
+        return response;
+    }
+
+    size_t offset = operationFlag == PLDM_GET_FIRSTPART ? 0
+                                                        : dataTransferHandle;
+    if (offset >= eventData.size())
+    {
+        return ccOnlyResponse(request,
+                              PLDM_PLATFORM_INVALID_DATA_TRANSFER_HANDLE);
+    }
+    size_t count = std::min(config.rasPartSize, eventData.size() - offset);
+    bool last = offset + count == eventData.size();
+    uint8_t transferFlag = offset ? (last ? PLDM_END : PLDM_MIDDLE)
+                                  : (last ? PLDM_START_AND_END : PLDM_START);
+
+    append(response, htole16(event->id));
+    append(response, htole32(static_cast<uint32_t>(last ? 0 : offset + count)));
+    append(response, transferFlag);
+    append(response, uint8_t{0xfa});
+    append(response, htole32(static_cast<uint32_t>(count)));
+    response.insert(response.end(), eventData.begin() + offset,
+                    eventData.begin() + offset + count);
+    if (transferFlag == PLDM_END)
+    {
+        append(response, htole32(crc32(eventData.data(), eventData.size())));
+    }
+    return response;
+}
+
+} // namespace sim
+
+} // namespace pldm
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <libpldm/base.h>
+#include <libpldm/platform.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <vector>
+
+namespace pldm
+{
+
+namespace sim
+{
+
+using Clock = std::chrono::steady_clock;
+
+/** @struct TerminusConfig
+ *  @brief Shape of a simulated terminus
+ */
+struct TerminusConfig
+{
+    size_t sensors = 32;        //!< Compact numeric sensor PDRs
+    size_t pdrs = 0;            //!< Total PDRs, the extra ones are OEM PDRs
+    bool batchReads = false;    //!< Support the OEM GetSensorReadings
+    size_t rasEventSize = 2048; //!< Size of the RAS event data
+    size_t rasPartSize = 1024;  //!< Event data of one poll response
+};
+
+/** @struct Summary
+ *  @brief Samples of a duration, in milliseconds
+ */
+struct Summary
+{
+    std::vector<double> samples;
+
+    void add(Clock::duration duration)
+    {
+        samples.emplace_back(
+            std::chrono::duration<double, std::milli>(duration).count());
+    }
+};
+
+/** @struct TerminusStats
+ *  @brief What the simulated terminus saw of the daemon
+ */
+struct TerminusStats
+{
+    Clock::time_point firstRequest{};   //!< First request of the daemon
+    Clock::time_point firstReading{};   //!< First sensor read, after discovery
+    std::map<uint8_t, uint64_t> requests; //!< Requests by PLDM command
+    uint64_t sensorReads = 0;
+    uint64_t eventsQueued = 0;
+    uint64_t eventsAcked = 0;
+    /** @brief Time between two reads of the same sensor */
+    Summary pollInterval;
+    /** @brief Time from the event message to the acknowledgement */
+    Summary eventLatency;
+};
+
+/** @class Terminus
+ *
+ *  Answers the discovery, the sensor polling and the RAS event polling of
+ *  the daemon as an MPro terminus does: GetPLDMTypes, GetPLDMCommands,
+ *  GetTID, GetPDR, SetEventReceiver, GetSensorReading, the OEM
+ *  GetSensorReadings and PollForPlatformEventMessage. The RAS events are
+ *  CPER records, announced by a pldmMessagePollEvent.
+ */
+class Terminus
+{
+  public:
+    Terminus() = delete;
+    Terminus(const Terminus&) = delete;
+    Terminus& operator=(const Terminus&) = delete;
+
+    /** @brief Build the PDRs of the terminus
+     *
+     *  @param[in] eid - EID of the terminus, also its TID
+     *  @param[in] config - shape of the terminus
+     */
+    Terminus(uint8_t eid, const TerminusConfig& config);
+
+    /** @brief Answer a request of the daemon
+     *
+     *  @param[in] request - request message
+     *  @param[in] payloadLength - length of the request payload
+     *
+     *  @return - response message
+     */
+    std::vector<uint8_t> handleRequest(const pldm_msg* request,
+                                       size_t payloadLength);
+
+    /** @brief Queue a RAS event
+     *
+     *  @param[in] instanceId - instance ID of the event message
+     *
+     *  @return - PlatformEventMessage request announcing the event
+     */
+    std::vector<uint8_t> queueEvent(uint8_t instanceId);
+
+    /** @brief Get the EID of the terminus */
+    uint8_t getEid() const
+    {
+        return eid;
+    }
+
+    /** @brief Get the statistics of the terminus */
+    const TerminusStats& getStats() const
+    {
+        return stats;
+    }
+
+  private:
+    /** @struct Event
+     *  @brief RAS event waiting to be polled and acknowledged
+     */
+    struct Event
+    {
+        uint16_t id;
+        Clock::time_point queued;
+    };
+
+    std::vector<uint8_t> getTypes(const pldm_msg* request);
+    std::vector<uint8_t> getCommands(const pldm_msg* request,
+                                     size_t payloadLength);
+    std::vector<uint8_t> getPDR(const pldm_msg* request, size_t payloadLength);
+    std::vector<uint8_t> getSensorReading(const pldm_msg* request,
+                                          size_t payloadLength);
+    std::vector<uint8_t> getSensorReadings(const pldm_msg* request,
+                                           size_t payloadLength);
+    std::vector<uint8_t> pollForEvent(const pldm_msg* request,
+                                      size_t payloadLength);
+
+    /** @brief Record a read of a sensor and get its reading
+     *
+     *  @param[in] index - index of the sensor
+     *
+     *  @return - present reading
+     */
+    uint8_t readSensor(size_t index);
+
+    uint8_t eid;
+    TerminusConfig config;
+    /** @brief PDRs, the record handle is the index plus one */
+    std::vector<std::vector<uint8_t>> pdrs;
+    /** @brief Last read of each sensor, the sensor ID is the index plus
+     *  one */
+    std::vector<Clock::time_point> lastReads;
+    /** @brief CPER record sent as the data of every event */
+    std::vector<uint8_t> eventData;
+    std::deque<Event> events;
+    uint16_t nextEventId = 1;
+    TerminusStats stats;
+};
+
+} // namespace sim
+
+} // namespace pldm